@@ -3,7 +3,27 @@
  * \author      Andrii Shylenko
  *
  * \brief
- * Simple 1ms task implementation.
+ * Simple 1ms task implementation, driven by TIM6 update interrupt.
+ * With TASK_TICKLESS, TIM6 period follows the next CANopen deadline instead.
+ * With TASK_REALTIME_ISR, SYNC, RPDO and TPDO (timer thread) run inside TIM6
+ * interrupt and only SDO, EMCY, NMT, HB consumer and EEPROM (mainline thread)
+ * run from task_oneMs(). Mainline code, which accesses OD variables mapped to
+ * PDOs, must then protect them with CO_LOCK_OD().
+ * Communication is reset with node-ID and bit rate from LSS slave, when NMT
+ * reset communication is received or LSS master has assigned node-ID.
+ * Traces (CO_NO_TRACE) are sampled in the timer thread after TPDOs with
+ * timestamp from task_getTimeUs(). With CO_NO_TIME, timestamp is network time
+ * of the TIME object, its local clock is task_getTimeUs() and SYNC edges are
+ * passed from the SYNC callback.
+ * With CO_SYNC_HW_TIMER, SYNC producer is driven by TIM2 channel 1 compare
+ * interrupt, see task_syncTimer(). With CO_SYNC_WINDOW_TIMER, TIM2 channel 2
+ * compare is armed at the SYNC edge and closes the SYNC window. With
+ * CO_HB_HW_TIMER, heartbeat producer is driven by TIM2 channel 3 compare
+ * interrupt, see task_heartbeatTimer().
+ * With CO_TPDO_PRESTAGE, TPDOs staged by application with CO_TPDO_stage() are
+ * released from the SYNC callback.
+ * With CO_RTOS, timer and mainline thread are CMSIS-RTOS2 threads, woken up
+ * from CAN receive interrupt or by their next deadline, see task_rtosStart().
  ******************************************************************************/
 
 /*-----------------------------------------------------------------------------
@@ -12,56 +32,707 @@
 #include "task.h"
 
 #include "can.h"
+#include "tim.h"
+#include "spi.h"
+#include "i2c.h"
+#include "usart.h"
 
 #include "CanOpen.h"
+#include "task_tick.h"
+#include "task_boot.h"
+#include "CO_log.h"
+#if TASK_SYNC_PLL > 0
+#include "task_pll.h"
+#endif
+#if TASK_GOVERNOR > 0
+#include "task_gov.h"
+#endif
 
-/*EEPROM driver is not the part of the demonstration code*/
-//#define CAN_USE_EEPROM
+/*\brief store OD_EEPROM and OD_ROM (0x1010) with CO_eeprom.c, see CO_EE_BACKEND */
+#define CAN_USE_EEPROM
+
+#ifdef CAN_USE_EEPROM
+#include "CO_eeprom.h"
+#endif
+#if (CO_PROFILE > 0) || (CO_PROFILE_PC > 0)
+#include "CO_profile.h"
+#endif
+#if (CO_CAN_STATISTICS > 0) || (CO_CAN_BUSLOAD > 0) || (CO_CAN_TX_LATENCY > 0)
+#include "CO_CANstat.h"
+#endif
+#if CO_CAN_RECORDER > 0
+#include "CO_CANrecorder.h"
+#endif
+#if (CO_TRACE_STREAM > 0) && (CO_NO_TRACE > 0)
+#include "CO_traceStream.h"
+#endif
+#if CO_BENCH > 0
+#include "CO_bench.h"
+#endif
+#if TASK_ECHO > 0
+#include "task_echo.h"
+#endif
+#if TASK_IO_CHANNELS > 0
+#include "task_io.h"
+#endif
+#if CO_GATEWAY > 0
+#include "CO_gatewayUart.h"
+#endif
+#if CO_FW_UPDATE > 0
+#include "CO_fwUpdate.h"
+#endif
+#if CO_DCF > 0
+#include "CO_DCF.h"
+#endif
+#if CO_EDS_STORE > 0
+#include "CO_EDS.h"
+#endif
+#if CO_OD_MIRROR > 0
+#include "CO_ODmirror.h"
+#endif
+#if CO_RTOS > 0
+#include "cmsis_os2.h"
+#endif
 
 /*-----------------------------------------------------------------------------
  * LOCAL (static) DEFINITIONS
  *----------------------------------------------------------------------------*/
 
+/*\brief TIM6 counter runs at 250 kHz (80 MHz / (Prescaler + 1)), TASK_GOVERNOR
+ * keeps the rate at its clock switches */
+#define TASK_TIMER_US_PER_COUNT   4U
+/*\brief TIM6 update period (Period + 1 counts) */
+#define TASK_TIMER_PERIOD_US      1000U
+
+/*\brief peripherals, which are used before the boot-up message. Others are
+ * initialized after it, so they don't delay the boot-up. */
+#if (CO_LOG > 0) || (CO_GATEWAY > 0) || ((CO_TRACE_STREAM > 0) && (CO_NO_TRACE > 0))
+#define TASK_BOOT_USART1_EARLY    1
+#else
+#define TASK_BOOT_USART1_EARLY    0
+#endif
+#if (CO_CAN_RECORDER > 0) || (defined(CAN_USE_EEPROM) && (CO_EE_BACKEND == CO_EE_BACKEND_SPI))
+#define TASK_BOOT_SPI3_EARLY      1
+#else
+#define TASK_BOOT_SPI3_EARLY      0
+#endif
+#if defined(CAN_USE_EEPROM) && (CO_EE_BACKEND == CO_EE_BACKEND_I2C)
+#define TASK_BOOT_I2C1_EARLY      1
+#else
+#define TASK_BOOT_I2C1_EARLY      0
+#endif
+
+/*\brief phases of LSS activate bit timing (CiA 305), device is silent in both */
+#define TASK_LSS_SWITCH_IDLE      0U  /* no bit rate switch */
+#define TASK_LSS_SWITCH_OLD       1U  /* first switch delay, CAN stopped */
+#define TASK_LSS_SWITCH_NEW       2U  /* second switch delay with new bit rate */
+
 static CO_NMT_reset_cmd_t reset;
+/*\brief number of TIM6 update events since task_coldStart() */
+static volatile uint32_t task_timerTicks = 0U;
+/*\brief time of the last TIM6 update event in microseconds */
+static volatile uint32_t task_timerBaseUs = 0U;
+/*\brief value of task_timerTicks, which was processed by task_oneMs() */
+static uint32_t task_processedTicks = 0U;
+/*\brief time of the previous task_oneMs() call in microseconds */
+static uint32_t task_lastTimeUs = 0U;
+/*\brief microseconds not yet passed to CO_process() as whole milliseconds */
+static uint32_t task_remainderUs = 0U;
+#if TASK_REALTIME_ISR > 0
+/*\brief time of the previous task_realTime() call from TIM6 interrupt */
+static uint32_t task_rtLastTimeUs = 0U;
+#endif
+#if (TASK_TICKLESS > 0) || (CO_RTOS > 0)
+/*\brief next CANopen deadline in microseconds after task_lastTimeUs */
+static uint32_t task_nextUs = 0U;
+#endif
+#if TASK_TICKLESS > 0
+/*\brief set, if the CPU was woken up from task_sleep() */
+static volatile bool_t task_wakeUp = false;
+#endif
+#if TASK_SDO_IMMEDIATE > 0
+/*\brief set from CAN receive interrupt, if SDO server has a new request */
+static volatile bool_t task_sdoPending = false;
+#endif
 #ifdef CAN_USE_EEPROM
 static CO_EE_t                     CO_EEO;         /* Eeprom object */
+/*\brief result of CO_EE_init_1(), reported after each communication reset */
+static CO_ReturnError_t task_eeStatus;
+/*\brief OD_EEPROM and both OD_ROM slots must fit into CO_EE_SIZE, else
+ * CO_EE_init_1() fails on every boot. Negative array size, if not. */
+typedef char task_eeSizeCheck[(CO_EE_REQUIRED_SIZE(sizeof(CO_OD_EEPROM), sizeof(CO_OD_ROM)) <= CO_EE_SIZE) ? 1 : -1];
+#endif
+/*\brief node-ID and bit rate for the next communication reset */
+static uint8_t task_nodeId = TASK_NODE_ID;
+static uint16_t task_bitRate = TASK_BIT_RATE;
+#if CO_NO_LSS_SERVER == 1
+/*\brief phase of bit rate switch, one of TASK_LSS_SWITCH_xxx */
+static uint8_t task_lssSwitch = TASK_LSS_SWITCH_IDLE;
+/*\brief switch delay from LSS activate bit timing in milliseconds */
+static uint16_t task_lssDelayMs;
+/*\brief remaining time of the active phase in milliseconds */
+static uint16_t task_lssTimerMs;
+#endif
+#if CO_CAN_BUSLOAD > 0
+/*\brief bus load of CAN1, published in OD 0x2142 */
+static CO_CANbusLoad_t task_busLoad;
+#endif
+#if CO_CAN_RECORDER > 0
+/*\brief CAN1 traffic into external SPI flash, OD 0x2146 and 0x2147 */
+static CO_CANrecorder_t task_recorder;
+#endif
+#if (CO_TRACE_STREAM > 0) && (CO_NO_TRACE > 0)
+/*\brief traces in delta binary format over USART1 */
+static CO_traceStream_t task_traceStream;
+#endif
+#if CO_GATEWAY > 0
+/*\brief CiA 309-3 gateway from host PC over USART1 */
+static CO_gateway_t task_gateway;
+static CO_gatewayUart_t task_gatewayUart;
+#endif
+#if CO_FW_UPDATE > 0
+/*\brief program download into flash, objects 0x1F50 to 0x1F57 */
+static CO_fwUpdate_t task_fwUpdate;
+#endif
+#if (CO_NO_NMT_MASTER == 1) && (CO_NO_SDO_CLIENT == 1)
+/*\brief node-IDs and state of slaves booted by NMT master */
+static const uint8_t task_nmtmNodeIds[] = TASK_NMTM_SLAVES;
+static CO_NMTmasterSlave_t task_nmtmSlaves[sizeof(task_nmtmNodeIds)];
+#endif
+#if CO_DCF > 0
+/*\brief Concise DCF download into 0x1F22 */
+static CO_DCF_t task_dcf;
+#endif
+#if CO_EDS_STORE > 0
+/*\brief device description in 0x1021 */
+static CO_EDS_t task_eds;
+#endif
+#if CO_BENCH > 0
+/*\brief results of the micro-benchmark, read them with debugger */
+static CO_bench_t task_bench;
+#endif
+#if CO_OD_MIRROR > 0
+/*\brief CANopen core part of the mirror */
+static CO_ODmirror_t task_ODmirror;
+#endif
+#if CO_RTOS > 0
+/*\brief thread flag, which wakes up CANopen thread */
+#define TASK_RTOS_FLAG   0x0001U
+#if ((CO_NO_TRACE > 0) && (TASK_TRACE_SAMPLE_HZ == 0)) || (TASK_IO_CHANNELS > 0)
+/*\brief traces and periodic I/O channels are sampled every millisecond */
+#define TASK_RTOS_RT_WAIT_US   TASK_TIMER_PERIOD_US
+#else
+#define TASK_RTOS_RT_WAIT_US   TASK_RTOS_MAX_WAIT_US
+#endif
+/*\brief CANopen threads, NULL until task_rtosStart() */
+static osThreadId_t task_rtosRealTimeId = NULL;
+static osThreadId_t task_rtosMainlineId = NULL;
 #endif
 
 
 /*-----------------------------------------------------------------------------
  * GLOBAL DEFINITIONS
  *----------------------------------------------------------------------------*/
+#if CO_OD_MIRROR > 0
+/*\brief PDO mapped variables for the application core, see CO_ODmirror.h.
+ * Application image places it at the same address with CO_OD_MIRROR_ATTR. */
+CO_OD_MIRROR_ATTR CO_ODmirrorShared_t task_ODmirrorShared;
+#endif
 
 
 /*-----------------------------------------------------------------------------
  * LOCAL FUNCTION PROTOTYPES
  *----------------------------------------------------------------------------*/
+static void task_realTime(uint32_t timeDifference_us, uint32_t *timerNext_us);
+#if CO_NO_SYNC > 0
+static void task_syncReceived(void *object, uint8_t counter);
+#endif
+static void task_commReset(void);
+#if CO_NO_LSS_SERVER == 1
+static bool_t task_lssCheckBitRate(void *object, uint16_t bitRate);
+static void task_lssActivateBitRate(void *object, uint16_t delay);
+#endif
+#if TASK_SDO_IMMEDIATE > 0
+static void task_sdoReceived(void);
+static void task_sdoProcess(void);
+#endif
+#if TASK_STOP2 > 0
+static void task_stop2Init(void);
+static uint32_t task_stop2(uint32_t timeUs);
+#endif
+#if CO_RTOS > 0
+static void task_rtosSignal(osThreadId_t thread);
+static void task_rtosReceived(void *object, uint16_t ident);
+static void task_rtosEmergency(void);
+static uint32_t task_rtosTicks(uint32_t timeUs);
+static void task_rtosPriorities(void);
+static void task_rtosRealTime(void *argument);
+static void task_rtosMainline(void *argument);
+#endif
 
 
 /*-----------------------------------------------------------------------------
  * LOCAL FUNCTIONS
  *----------------------------------------------------------------------------*/
+#if CO_NO_SYNC > 0
+/* \brief SYNC callback, called from CAN receive interrupt, timer thread or TIM2 */
+static void task_syncReceived(void *object, uint8_t counter)
+{
+   uint32_t timeUs = task_getTimeUs();
+#if CO_TPDO_PRESTAGE > 0
+   uint16_t i;
 
+   /* TPDOs staged with CO_TPDO_stage() enter the queue at the SYNC edge */
+   for(i = 0; i < CO_NO_TPDO; i++)
+   {
+      CO_TPDO_syncRelease(CO->TPDO[i], CO->SYNC);
+   }
+#endif
+#if CO_SYNC_WINDOW_TIMER > 0
+   /* TIM2 channel 2 closes the window, see task_syncWindowTimer() */
+   if(OD_synchronousWindowLength != 0U)
+   {
+      TIM2->CCR2 = TIM2->CNT + OD_synchronousWindowLength;
+      TIM2->SR = ~TIM_SR_CC2IF;
+      __HAL_TIM_ENABLE_IT(&htim2, TIM_IT_CC2);
+   }
+#endif
+#if TASK_IO_CHANNELS > 0
+   task_io_sync();
+#endif
+#if CO_NO_TIME > 0
+   CO_TIME_syncEdge(CO->TIME, timeUs);
+#endif
+#if TASK_SYNC_PLL > 0
+   task_pll_sync(CO->SYNC, timeUs, TIM6->CNT * TASK_TIMER_US_PER_COUNT);
+#endif
+   (void)object;
+   task_syncSignal(timeUs, counter);
+}
+#endif
 
-/*-----------------------------------------------------------------------------
- * GLOBAL FUNCTIONS - see descriptions in header file
- *----------------------------------------------------------------------------*/
-void task_coldStart(void)
+
+#if TASK_SDO_IMMEDIATE > 0
+/* \brief SDO server callback, called from CAN receive interrupt */
+static void task_sdoReceived(void)
 {
-   __HAL_DBGMCU_FREEZE_TIM6();
+   task_sdoPending = true;
+}
 
 
-/*------------------------CAN Open stack--------------------------------*/
+/* \brief SDO server processing between task_oneMs() calls, mainline thread */
+static void task_sdoProcess(void)
+{
+   uint8_t i;
+   bool_t NMTisPreOrOperational;
+
+   task_sdoPending = false;
+   NMTisPreOrOperational = (CO->NMT->operatingState == CO_NMT_PRE_OPERATIONAL ||
+                            CO->NMT->operatingState == CO_NMT_OPERATIONAL);
+
+   /* time is passed by task_oneMs(), only protocol is advanced here */
+   for(i = 0U; i < CO_NO_SDO_SERVER_CAN; i++)
+   {
+      CO_SDO_process(CO->SDO[i], NMTisPreOrOperational, 0U, 1000U, NULL);
+
+      /* block upload sends next segment as soon as transmit buffer is free */
+      if(CO->SDO[i]->state == CO_SDO_ST_UPLOAD_BL_SUBBLOCK)
+      {
+         task_sdoPending = true;
+      }
+   }
+}
+#endif
+
+
+#if TASK_STOP2 > 0
+/* \brief LSI clock for LPTIM1 and CAN RX pin edge on EXTI11, at cold start */
+static void task_stop2Init(void)
+{
+   RCC->CSR |= RCC_CSR_LSION;
+   while((RCC->CSR & RCC_CSR_LSIRDY) == 0U)
+   {
+      ;
+   }
+   MODIFY_REG(RCC->CCIPR, RCC_CCIPR_LPTIM1SEL, RCC_CCIPR_LPTIM1SEL_0);
+   __HAL_RCC_LPTIM1_CLK_ENABLE();
+   /* HSI16 after wake-up, it is also the PLL source */
+   __HAL_RCC_WAKEUPSTOP_CLK_CONFIG(RCC_STOP_WAKEUPCLOCK_HSI);
+
+   /* PA11 keeps its CAN alternate function, EXTI sees the pin anyway */
+   __HAL_RCC_SYSCFG_CLK_ENABLE();
+   MODIFY_REG(SYSCFG->EXTICR[2], SYSCFG_EXTICR3_EXTI11, SYSCFG_EXTICR3_EXTI11_PA);
+   EXTI->FTSR1 |= EXTI_FTSR1_FT11;
+   EXTI->RTSR1 &= ~EXTI_RTSR1_RT11;
+}
+
+
+/* \brief stops the CPU in Stop2 mode for up to timeUs, interrupts disabled.
+ * \details Wake-up sources are only pended, with SEVONPEND they end WFE
+ * without an interrupt handler. Returns the stopped time in microseconds. */
+static uint32_t task_stop2(uint32_t timeUs)
+{
+   uint32_t ticks = timeUs * (LSI_VALUE / 1000U) / 1000U;
+   uint32_t count1;
+   uint32_t count2;
+
+   /* LPTIM1 single shot to ticks, ARR may be written only when enabled */
+   LPTIM1->CFGR = 0U;
+   LPTIM1->IER = LPTIM_IER_ARRMIE;
+   LPTIM1->CR = LPTIM_CR_ENABLE;
+   LPTIM1->ARR = ticks;
+   while((LPTIM1->ISR & LPTIM_ISR_ARROK) == 0U)
+   {
+      ;
+   }
+   LPTIM1->ICR = LPTIM_ICR_ARROKCF | LPTIM_ICR_ARRMCF;
+   LPTIM1->CR = LPTIM_CR_ENABLE | LPTIM_CR_SNGSTRT;
+
+   EXTI->PR1 = EXTI_PR1_PIF11;
+   EXTI->IMR1 |= EXTI_IMR1_IM11;
+   NVIC_ClearPendingIRQ(LPTIM1_IRQn);
+   NVIC_ClearPendingIRQ(EXTI15_10_IRQn);
+   SCB->SCR |= SCB_SCR_SEVONPEND_Msk;
+
+   HAL_SuspendTick();
+   HAL_PWREx_EnterSTOP2Mode(PWR_STOPENTRY_WFE);
+   /* woken up with HSI16, PLL must be started again */
+   SystemClock_Config();
+   HAL_ResumeTick();
+
+   SCB->SCR &= ~SCB_SCR_SEVONPEND_Msk;
+   EXTI->IMR1 &= ~EXTI_IMR1_IM11;
+
+   /* counter runs asynchronously, two equal reads are valid */
+   if((LPTIM1->ISR & LPTIM_ISR_ARRM) != 0U)
+   {
+      count1 = ticks;
+   }
+   else
+   {
+      do
+      {
+         count1 = LPTIM1->CNT;
+         count2 = LPTIM1->CNT;
+      } while(count1 != count2);
+   }
+   LPTIM1->ICR = LPTIM_ICR_ARRMCF;
+   LPTIM1->CR = 0U;
+   EXTI->PR1 = EXTI_PR1_PIF11;
+   NVIC_ClearPendingIRQ(LPTIM1_IRQn);
+   NVIC_ClearPendingIRQ(EXTI15_10_IRQn);
+
+   return count1 * 1000U / (LSI_VALUE / 1000U);
+}
+#endif
+
+
+#if CO_RTOS > 0
+/* \brief wakes up CANopen thread, may be called from interrupt */
+static void task_rtosSignal(osThreadId_t thread)
+{
+   if(thread != NULL)
+   {
+      (void)osThreadFlagsSet(thread, TASK_RTOS_FLAG);
+   }
+}
+
+
+/* \brief CAN receive callback, SYNC and PDO range go to the realtime thread */
+static void task_rtosReceived(void *object, uint16_t ident)
+{
+   (void)object;
+
+#if CO_CAN_RX_RING > 0
+   /* frame is still in the ring, realtime thread passes it to CANopen objects */
+   (void)ident;
+   task_rtosSignal(task_rtosRealTimeId);
+#else
+   if(ident == CO_CAN_ID_SYNC || (ident >= CO_CAN_ID_TPDO_1 && ident < CO_CAN_ID_TSDO))
+   {
+      task_rtosSignal(task_rtosRealTimeId);
+   }
+   else
+   {
+      task_rtosSignal(task_rtosMainlineId);
+   }
+#endif
+}
+
+
+/* \brief EMCY callback, emergency message is sent by the mainline thread */
+static void task_rtosEmergency(void)
+{
+   task_rtosSignal(task_rtosMainlineId);
+}
+
+
+/* \brief kernel ticks to wait for a deadline timeUs away, rounded up */
+static uint32_t task_rtosTicks(uint32_t timeUs)
+{
+   if(timeUs > TASK_RTOS_MAX_WAIT_US)
+   {
+      timeUs = TASK_RTOS_MAX_WAIT_US;
+   }
+   return (uint32_t)(((uint64_t)timeUs * osKernelGetTickFreq() + 999999U) / 1000000U);
+}
+
+
+/* \brief interrupts, which call CANopenNode, may call RTOS and are masked by CO_LOCK_xxx() */
+static void task_rtosPriorities(void)
+{
+   HAL_NVIC_SetPriority(CAN1_TX_IRQn, CO_LOCK_CAN_PRIORITY, 0U);
+   HAL_NVIC_SetPriority(CAN1_RX0_IRQn, CO_LOCK_CAN_PRIORITY, 0U);
+   HAL_NVIC_SetPriority(CAN1_RX1_IRQn, CO_LOCK_CAN_PRIORITY, 0U);
+   HAL_NVIC_SetPriority(CAN1_SCE_IRQn, CO_LOCK_CAN_PRIORITY, 0U);
+#if (CO_SYNC_HW_TIMER > 0) || (CO_SYNC_WINDOW_TIMER > 0) || (CO_HB_HW_TIMER > 0)
+   HAL_NVIC_SetPriority(TIM2_IRQn, CO_LOCK_CAN_PRIORITY, 0U);
+#endif
+#if (CO_NO_TRACE > 0) && (TASK_TRACE_SAMPLE_HZ > 0)
+   HAL_NVIC_SetPriority(TIM7_IRQn, CO_LOCK_OD_PRIORITY, 0U);
+#endif
+}
+
+
+/* \brief timer thread, SYNC, RPDO and TPDO until the next PDO deadline */
+static void task_rtosRealTime(void *argument)
+{
+   uint32_t lastTimeUs = task_getTimeUs();
+
+   (void)argument;
+
+   for(;;)
+   {
+      uint32_t timeUs = task_getTimeUs();
+      uint32_t timerNext_us = TASK_RTOS_RT_WAIT_US;
+
+      task_realTime(timeUs - lastTimeUs, &timerNext_us);
+      lastTimeUs = timeUs;
+
+      (void)osThreadFlagsWait(TASK_RTOS_FLAG, osFlagsWaitAny, task_rtosTicks(timerNext_us));
+   }
+}
+
+
+/* \brief mainline thread, task_oneMs() until the next deadline */
+static void task_rtosMainline(void *argument)
+{
+   (void)argument;
+
+   for(;;)
+   {
+      task_oneMs();
+
+      (void)osThreadFlagsWait(TASK_RTOS_FLAG, osFlagsWaitAny, task_rtosTicks(task_nextUs));
+   }
+}
+#endif
+
+
+#if CO_NO_LSS_SERVER == 1
+/* \brief LSS configure bit timing, accept bit rates reachable with current CAN clock */
+static bool_t task_lssCheckBitRate(void *object, uint16_t bitRate)
+{
+   CO_CANbitTiming_t timing;
+
+   (void)object;
+
+   return CO_CANbitTiming(HAL_RCC_GetPCLK1Freq(), bitRate, CO_CAN_SAMPLE_POINT, &timing) == CO_ERROR_NO;
+}
+
+
+/* \brief LSS activate bit timing, new bit rate is set with communication reset
+ * after the first switch delay, see task_oneMs() */
+static void task_lssActivateBitRate(void *object, uint16_t delay)
+{
+   (void)object;
+
+   task_bitRate = CO->LSSslave->pendingBitRate;
+   task_lssDelayMs = delay;
+   task_lssTimerMs = delay;
+   task_lssSwitch = TASK_LSS_SWITCH_OLD;
+   /* stop transmitting at once, also TPDOs from the realtime thread */
+   (void)HAL_CAN_Stop(&hcan1);
+}
+#endif
+
+
+/* \brief initialize CANopen objects and start CAN, TIM6 update interrupt must be disabled */
+static void task_commReset(void)
+{
    CO_ReturnError_t err;
+
    /* CAN module address, NodeID, Bitrate */
    /* We do not use CAN registers directly, so address here is a pointer to the CAN_HandleTypeDef object. */
-   err = CO_init((uint32_t)&hcan1, 2, 250);
+   err = CO_init((uint32_t)&hcan1, task_nodeId, task_bitRate);
 
    if(err != CO_ERROR_NO)
    {
   	 //TODO behavior in a case of the stack error. Currently not defined.
   	 _Error_Handler(0, 0);
    }
+#if CO_OD_MIRROR > 0
+   /* PDO data for the application core */
+   if(CO_ODmirror_init(&task_ODmirror, &task_ODmirrorShared, CO) != CO_ERROR_NO)
+   {
+      _Error_Handler(0, 0);
+   }
+#endif
+#if CO_RTOS > 0
+   /* CAN MSP init has set the CubeMX priorities again */
+   task_rtosPriorities();
+   CO_CANmodule_initRxCallback(CO->CANmodule[0], NULL, task_rtosReceived);
+#endif
+
+#if CO_NO_LSS_SERVER == 1
+   CO_LSSslave_initCheckBitRateCallback(CO->LSSslave, NULL, task_lssCheckBitRate);
+   CO_LSSslave_initActivateBitRateCallback(CO->LSSslave, NULL, task_lssActivateBitRate);
+
+   if(task_nodeId == CO_LSS_NODE_ID_ASSIGNMENT)
+   {
+      /* only LSS slave is active, other objects are not initialized */
+      CO_CANsetNormalMode(CO->CANmodule[0]);
+      reset = CO_RESET_NOT;
+      return;
+   }
+#endif
+
+#ifdef CAN_USE_EEPROM
+   CO_EE_init_2(&CO_EEO, task_eeStatus, CO->SDO[0], CO->em);
+#endif
+#if CO_PROFILE > 0
+   /* cycle statistics of CAN RX, CO_process, PDO and tick stages in OD 0x2140,
+      worst case context in OD 0x214A */
+   CO_profile_init(CO->SDO[0]);
+#endif
+   /* task_oneMs() execution time and jitter in OD 0x2145 */
+   task_tick_init(CO->SDO[0]);
+   /* time from reset to boot-up and operational in OD 0x2149 */
+   task_boot_init(CO->SDO[0]);
+#if TASK_SYNC_PLL > 0
+   /* TIM6 period locked to SYNC, state in OD 0x2148 */
+   task_pll_init(CO->SDO[0], TASK_TIMER_PERIOD_US, TASK_TIMER_US_PER_COUNT * 1000U);
+#endif
+#if TASK_GOVERNOR > 0
+   /* clock profile and its statistics in OD 0x214C */
+   task_gov_init(CO->SDO[0]);
+#endif
+#if CO_PROFILE_PC > 0
+   /* PC sampling control in OD 0x2143, histogram in OD 0x2144 */
+   CO_profilePC_init(CO->SDO[0]);
+#endif
+#if CO_CAN_STATISTICS > 0
+   /* CAN frame, queue and error counters in OD 0x2141 */
+   CO_CANstat_init(CO->CANmodule[0], CO->SDO[0]);
+#endif
+#if CO_CAN_BUSLOAD > 0
+   CO_CANbusLoad_init(&task_busLoad, CO->CANmodule[0], CO->SDO[0]);
+#endif
+#if CO_CAN_TX_LATENCY > 0
+   /* queue to bus latency of the COB-ID selected in OD 0x214B */
+   CO_CANtxLatency_init(CO->CANmodule[0], CO->SDO[0]);
+#endif
+#if CO_CAN_RECORDER > 0
+   /* recording and its log survive communication reset */
+   CO_CANrecorder_init_2(&task_recorder, CO->CANmodule[0], CO->SDO[0]);
+#endif
+#if (CO_TRACE_STREAM > 0) && (CO_NO_TRACE > 0)
+   CO_traceStream_init(&task_traceStream, &huart1, CO->trace, CO_NO_TRACE);
+#endif
+#if CO_FW_UPDATE > 0
+   if(CO_fwUpdate_init(&task_fwUpdate, CO->SDO[0]) != CO_ERROR_NO)
+   {
+      _Error_Handler(0, 0);
+   }
+#endif
+#if CO_DCF > 0
+   if(CO_DCF_init(&task_dcf, CO->SDO[0], task_nodeId) != CO_ERROR_NO)
+   {
+      _Error_Handler(0, 0);
+   }
+#endif
+#if CO_EDS_STORE > 0
+   if(CO_EDS_init(&task_eds, CO->SDO[0], CO_EDS_image, CO_EDS_imageSize) != CO_ERROR_NO)
+   {
+      _Error_Handler(0, 0);
+   }
+#endif
+#if CO_GATEWAY > 0
+   /* gateway shares SDO clients with NMT master */
+   if(CO_gateway_init(&task_gateway, CO, CO->SDOqueue, TASK_NODE_ID,
+                      &task_gatewayUart, CO_gatewayUart_write) != CO_ERROR_NO
+         || CO_gatewayUart_init(&task_gatewayUart, &huart1, &task_gateway) != CO_ERROR_NO)
+   {
+      _Error_Handler(0, 0);
+   }
+#endif
+#if (CO_NO_TRACE > 0) && (TASK_TRACE_POST_TRIGGER > 0)
+   {
+      uint8_t i;
+
+      for(i = 0U; i < CO_NO_TRACE; i++)
+      {
+         (void)CO_trace_setCapture(CO->trace[i], TASK_TRACE_PRE_TRIGGER, TASK_TRACE_POST_TRIGGER);
+      }
+   }
+#endif
+#if (CO_NO_TRACE > 0) && ((TASK_TRACE_COMPRESSION > 0) || (TASK_TRACE_DEADBAND > 0) || (TASK_TRACE_DECIMATION > 1))
+   {
+      uint8_t i;
+
+      for(i = 0U; i < CO_NO_TRACE; i++)
+      {
+         if(CO_trace_setCompression(CO->trace[i], (CO_trace_compression_t)TASK_TRACE_COMPRESSION,
+                                    TASK_TRACE_DEADBAND, TASK_TRACE_DECIMATION) != CO_ERROR_NO)
+         {
+            _Error_Handler(0, 0);
+         }
+      }
+   }
+#endif
+
+#if CO_NO_SYNC > 0
+   /* latch SYNC edge from CAN receive interrupt */
+   CO_SYNC_initCallback(CO->SYNC, NULL, task_syncReceived);
+#endif
+#if CO_NO_TIME > 0
+   /* network time is disciplined TIM6 microsecond time */
+   CO_TIME_initClock(CO->TIME, task_getTimeUs);
+#endif
+#if CO_RTOS > 0
+   CO_EM_initCallback(CO->em, task_rtosEmergency);
+#endif
+#if TASK_ECHO > 0
+   /* RPDO1 to TPDO1 loopback for canopen_loadgen */
+   task_echo_init(CO, TASK_ECHO, task_getTimeUs);
+#endif
+#if TASK_SDO_IMMEDIATE > 0
+   /* advance SDO protocol as soon as request is received */
+   {
+      uint8_t i;
+
+      for(i = 0U; i < CO_NO_SDO_SERVER_CAN; i++)
+      {
+         CO_SDO_initCallback(CO->SDO[i], task_sdoReceived);
+      }
+   }
+#endif
+#if (CO_NO_NMT_MASTER == 1) && (CO_NO_SDO_CLIENT == 1)
+   /* own heartbeat consumer callback must be set before, it is chained */
+   {
+      uint8_t i;
+
+      for(i = 0U; i < sizeof(task_nmtmNodeIds); i++)
+      {
+         task_nmtmSlaves[i].nodeId = task_nmtmNodeIds[i];
+      }
+      if(CO_NMTmaster_initSlaves(CO->NMTmaster, task_nmtmSlaves, sizeof(task_nmtmNodeIds)) != CO_ERROR_NO)
+      {
+         _Error_Handler(0, 0);
+      }
+      CO_NMTmaster_bootNetwork(CO->NMTmaster);
+   }
+#endif
 
    /* start CAN */
    CO_CANsetNormalMode(CO->CANmodule[0]);
@@ -70,35 +741,610 @@ void task_coldStart(void)
 }
 
 
-void task_oneMs(void)
+#if CO_NO_TRACE > 0
+/* \brief sample traced OD variables with microsecond timestamp */
+static void task_traceSample(void)
 {
+#if CO_NO_TIME > 0
+   uint32_t timeUs = CO_TIME_getUs(CO->TIME, task_getTimeUs());
+#else
+   uint32_t timeUs = task_getTimeUs();
+#endif
+   uint8_t i;
 
-    /* CANopen process */
-    reset = CO_process(CO, 1, NULL);
-
-    /* Process EEPROM */
-#ifdef CAN_USE_EEPROM
-          CO_EE_process(&CO_EEO);
+   for(i = 0U; i < CO_NO_TRACE; i++)
+   {
+      CO_trace_process(CO->trace[i], timeUs);
+   }
+}
 #endif
 
+
+/* \brief SYNC, RPDO and TPDO processing, timer thread */
+static void task_realTime(uint32_t timeDifference_us, uint32_t *timerNext_us)
+{
    if(CO->CANmodule[0]->CANnormal)
    {
         bool_t syncWas;
 
+#if CO_CAN_RX_RING > 0
+        /* frames stored by CAN receive interrupt */
+        if(CO_CANrxRingProcess(CO->CANmodule[0], TASK_RX_BATCH) > 0U)
+        {
+#if CO_RTOS > 0
+           /* SDO, NMT and heartbeat are processed by the mainline thread */
+           task_rtosSignal(task_rtosMainlineId);
+#endif
+        }
+#endif
+
         /* Process Sync and read inputs */
-        syncWas = CO_process_SYNC_RPDO(CO, 1000);
+        syncWas = CO_process_SYNC_RPDO(CO, timeDifference_us, timerNext_us);
 
         /* Further I/O or nonblocking application code may go here. */
+#if CO_OD_MIRROR > 0
+        /* received data to the application core, its outputs to OD */
+        CO_ODmirror_process(&task_ODmirror);
+#endif
+#if TASK_IO_CHANNELS > 0
+        /* samples completed by DMA, just before they are sent */
+        task_io_publish();
+#endif
 
         /* Write outputs */
-        CO_process_TPDO(CO, syncWas, 1000);
+        CO_process_TPDO(CO, syncWas, timeDifference_us, timerNext_us);
+#if TASK_IO_CHANNELS > 0
+        /* periodic channels are sampled for the next TPDO */
+        task_io_tick(timeDifference_us);
+#endif
+
+#if (CO_NO_TRACE > 0) && (TASK_TRACE_SAMPLE_HZ == 0)
+        /* sample traced OD variables with microsecond timestamp */
+        task_traceSample();
+#endif
 
         CO_CANpolling_Tx(CO->CANmodule[0]);
+   }
+}
+
+
+/*-----------------------------------------------------------------------------
+ * GLOBAL FUNCTIONS - see descriptions in header file
+ *----------------------------------------------------------------------------*/
+__weak void task_syncSignal(uint32_t timeUs, uint8_t counter)
+{
+   (void)timeUs;
+   (void)counter;
+}
+
+
+#if TASK_IO_CHANNELS > 0
+__weak void task_ioInit(void)
+{
+}
+#endif
 
-        /* verify timer overflow */
-        if(0) {
+
+#if CO_SYNC_HW_TIMER > 0
+void task_syncTimer(void)
+{
+   /* relative to the previous compare, interrupt latency does not accumulate */
+   TIM2->CCR1 += CO_SYNC_timerIsr(CO->SYNC);
+#if CO_RTOS > 0
+   task_rtosSignal(task_rtosRealTimeId);
+#endif
+}
+#endif
+
+
+#if CO_HB_HW_TIMER > 0
+void task_heartbeatTimer(void)
+{
+   /* relative to the previous compare, interrupt latency does not accumulate */
+   TIM2->CCR3 += CO_NMT_HBtimerIsr(CO->NMT);
+}
+#endif
+
+
+#if CO_SYNC_WINDOW_TIMER > 0
+void task_syncWindowTimer(void)
+{
+   /* single shot, armed again by the next SYNC */
+   __HAL_TIM_DISABLE_IT(&htim2, TIM_IT_CC2);
+   CO_SYNC_windowTimerIsr(CO->SYNC);
+}
+#endif
+
+
+/* \brief Cube MX callback for the TIM6 update interrupt */
+void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
+{
+   if(htim->Instance == TIM6)
+   {
+      task_timerBaseUs += (TIM6->ARR + 1U) * TASK_TIMER_US_PER_COUNT;
+      task_timerTicks++;
+#if TASK_TICKLESS > 0
+      /* 1 ms period, until task_sleep() stretches it again */
+      TIM6->ARR = TASK_TIMER_PERIOD_US / TASK_TIMER_US_PER_COUNT - 1U;
+#endif
+#if TASK_SYNC_PLL > 0
+      /* period of the started cycle, ARR has no preload */
+      TIM6->ARR = task_pll_reload() - 1U;
+#endif
+#if TASK_REALTIME_ISR > 0
+      {
+         uint32_t timeUs = task_getTimeUs();
+
+         task_realTime(timeUs - task_rtLastTimeUs, NULL);
+         task_rtLastTimeUs = timeUs;
+
+         /* verify timer overflow, next period already elapsed */
+         if((TIM6->SR & TIM_SR_UIF) != 0U)
+         {
             CO_errorReport(CO->em, CO_EM_ISR_TIMER_OVERFLOW, CO_EMC_SOFTWARE_INTERNAL, 0U);
+         }
+      }
+#endif
+   }
+#if (CO_NO_TRACE > 0) && (TASK_TRACE_SAMPLE_HZ > 0)
+   else if(htim->Instance == TIM7)
+   {
+      if(CO->CANmodule[0]->CANnormal)
+      {
+         task_traceSample();
+      }
+   }
+#endif
+}
+
+
+uint32_t task_getTimeUs(void)
+{
+   uint32_t baseUs;
+   uint32_t counter;
+   uint32_t primask = __get_PRIMASK();
+
+   __disable_irq();
+   baseUs = task_timerBaseUs;
+   counter = TIM6->CNT;
+   if((TIM6->SR & TIM_SR_UIF) != 0U)
+   {
+      /* timer overflowed, but interrupt was not served yet */
+      counter = TIM6->CNT;
+      baseUs += (TIM6->ARR + 1U) * TASK_TIMER_US_PER_COUNT;
+   }
+   __set_PRIMASK(primask);
+
+   return baseUs + counter * TASK_TIMER_US_PER_COUNT;
+}
+
+
+bool_t task_timerElapsed(void)
+{
+#if TASK_TICKLESS > 0
+   return task_wakeUp || (task_getTimeUs() - task_lastTimeUs) >= task_nextUs;
+#else
+   return task_timerTicks != task_processedTicks;
+#endif
+}
+
+
+void task_sleep(void)
+{
+#if TASK_SDO_IMMEDIATE > 0
+   if(task_sdoPending)
+   {
+      task_sdoProcess();
+      return;
+   }
+#endif
+#if TASK_TICKLESS > 0
+   uint32_t elapsedUs;
+   uint32_t counter;
+   uint32_t remaining;
+   uint32_t primask = __get_PRIMASK();
+
+   __disable_irq();
+   elapsedUs = task_getTimeUs() - task_lastTimeUs;
+   counter = TIM6->CNT;
+   /* period may be changed only before the update event is served */
+   if(elapsedUs < task_nextUs && (TIM6->SR & TIM_SR_UIF) == 0U
+#if TASK_SDO_IMMEDIATE > 0
+         && !task_sdoPending
+#endif
+     )
+   {
+      remaining = (task_nextUs - elapsedUs) / TASK_TIMER_US_PER_COUNT;
+      if(remaining > 0xFFFFU - counter)
+      {
+         remaining = 0xFFFFU - counter;
+      }
+#if TASK_STOP2 > 0
+      /* TIM6 has no clock in Stop2, stopped time is added to its base */
+      if(remaining * TASK_TIMER_US_PER_COUNT >= TASK_STOP2_MIN_US
+            && CO->CANmodule[0]->CANtxCount == 0U
+            && (CAN1->TSR & (CAN_TSR_TME0 | CAN_TSR_TME1 | CAN_TSR_TME2))
+               == (CAN_TSR_TME0 | CAN_TSR_TME1 | CAN_TSR_TME2))
+      {
+         task_timerBaseUs += task_stop2(remaining * TASK_TIMER_US_PER_COUNT);
+         task_wakeUp = true;
+      }
+      else
+#endif
+      /* don't stop for less than a few timer counts */
+      if(remaining > 2U)
+      {
+         TIM6->ARR = counter + remaining;
+
+         /* SysTick would wake the CPU every millisecond */
+         HAL_SuspendTick();
+         __DSB();
+         __WFI();
+         HAL_ResumeTick();
+         task_wakeUp = true;
+      }
+   }
+   /* pending interrupt is served here */
+   __set_PRIMASK(primask);
+#endif
+}
+
+
+void task_coldStart(void)
+{
+   uint16_t timerNext_ms = 0xFFFFU;
+
+   __HAL_DBGMCU_FREEZE_TIM6();
+#if TASK_GOVERNOR > 0
+   /* APB dividers of both profiles, before peripherals take their clocks */
+   task_gov_start(1000000U / TASK_TIMER_US_PER_COUNT);
+#endif
+#if TASK_BOOT_USART1_EARLY > 0
+   MX_USART1_UART_Init();
+#endif
+#if TASK_BOOT_SPI3_EARLY > 0
+   MX_SPI3_Init();
+#if TASK_GOVERNOR > 0
+   task_gov_spi(&hspi3);
+#endif
+#endif
+#if TASK_BOOT_I2C1_EARLY > 0
+   MX_I2C1_Init();
+#endif
+#if CO_LOG > 0
+   /* binary log over USART1, CO_LOGx() may be used from now on */
+   CO_log_init(&huart1);
+   CO_LOG0("cold start");
+#endif
+#if TASK_STOP2 > 0
+   task_stop2Init();
+#endif
+
+
+/*------------------------CAN Open stack--------------------------------*/
+#ifdef CAN_USE_EEPROM
+   /* read stored OD variables before CANopen objects are initialized */
+   task_eeStatus = CO_EE_init_1(&CO_EEO, (uint8_t*)&CO_OD_EEPROM, sizeof(CO_OD_EEPROM),
+                                         (uint8_t*)&CO_OD_ROM, sizeof(CO_OD_ROM));
+#endif
+#if CO_CAN_RECORDER > 0
+   CO_CANrecorder_init_1(&task_recorder);
+#endif
+   task_commReset();
+   task_boot_mark(TASK_BOOT_CANOPEN);
+
+   /* boot-up message now, not after the first TIM6 period, NMT state follows
+    * OD_NMTStartup in the same call */
+   if(CO_process(CO, 0U, &timerNext_ms) == CO_RESET_COMM)
+   {
+      reset = CO_RESET_COMM;
+   }
+   task_boot_process(CO->NMT->operatingState);
+
+   /* peripherals, which are not needed for the boot-up */
+#if TASK_BOOT_USART1_EARLY == 0
+   MX_USART1_UART_Init();
+#endif
+#if TASK_BOOT_SPI3_EARLY == 0
+   MX_SPI3_Init();
+#if TASK_GOVERNOR > 0
+   task_gov_spi(&hspi3);
+#endif
+#endif
+#if TASK_BOOT_I2C1_EARLY == 0
+   MX_I2C1_Init();
+#endif
+   task_boot_mark(TASK_BOOT_DEFERRED);
+#if TASK_IO_CHANNELS > 0
+   task_ioInit();
+#endif
+#if CO_BENCH > 0
+   /* stack hot paths, before realtime interrupt uses the same objects */
+   CO_bench_run(&task_bench, CO, TASK_BENCH_ITERATIONS);
+#endif
+
+   /* start 1 ms timer */
+   task_lastTimeUs = task_getTimeUs();
+#if TASK_REALTIME_ISR > 0
+   task_rtLastTimeUs = task_lastTimeUs;
+#endif
+   task_processedTicks = task_timerTicks;
+   if(HAL_TIM_Base_Start_IT(&htim6) != HAL_OK)
+   {
+  	 _Error_Handler(__FILE__, __LINE__);
+   }
+#if (CO_NO_TRACE > 0) && (TASK_TRACE_SAMPLE_HZ > 0)
+   /* hardware timed trace sampling */
+   __HAL_DBGMCU_FREEZE_TIM7();
+   MX_TIM7_Init(TASK_TRACE_SAMPLE_HZ);
+   if(HAL_TIM_Base_Start_IT(&htim7) != HAL_OK)
+   {
+  	 _Error_Handler(__FILE__, __LINE__);
+   }
+#endif
+#if CO_PROFILE_PC > 0
+   /* PC sampling, started and stopped over SDO, timer runs always */
+   __HAL_DBGMCU_FREEZE_TIM16();
+   MX_TIM16_Init(TASK_PC_SAMPLE_HZ);
+   if(HAL_TIM_Base_Start_IT(&htim16) != HAL_OK)
+   {
+  	 _Error_Handler(__FILE__, __LINE__);
+   }
+#endif
+#if (CO_SYNC_HW_TIMER > 0) || (CO_SYNC_WINDOW_TIMER > 0) || (CO_HB_HW_TIMER > 0)
+   /* SYNC producer, window and heartbeat timer */
+   __HAL_DBGMCU_FREEZE_TIM2();
+   MX_TIM2_Init();
+#if CO_SYNC_HW_TIMER > 0
+   if(HAL_TIM_OC_Start_IT(&htim2, TIM_CHANNEL_1) != HAL_OK)
+#else
+   if(HAL_TIM_Base_Start(&htim2) != HAL_OK)
+#endif
+   {
+  	 _Error_Handler(__FILE__, __LINE__);
+   }
+#if CO_HB_HW_TIMER > 0
+   if(HAL_TIM_OC_Start_IT(&htim2, TIM_CHANNEL_3) != HAL_OK)
+   {
+  	 _Error_Handler(__FILE__, __LINE__);
+   }
+#endif
+#endif
+#if CO_RTOS > 0
+   task_rtosPriorities();
+#endif
+}
+
+
+#if CO_RTOS > 0
+void task_rtosStart(void)
+{
+   const osThreadAttr_t realTimeAttr = {
+      .name = "CO_realTime",
+      .priority = TASK_RTOS_RT_PRIORITY,
+      .stack_size = TASK_RTOS_RT_STACK
+   };
+   const osThreadAttr_t mainlineAttr = {
+      .name = "CO_mainline",
+      .priority = TASK_RTOS_MAIN_PRIORITY,
+      .stack_size = TASK_RTOS_MAIN_STACK
+   };
+
+   if(osKernelInitialize() != osOK)
+   {
+  	 _Error_Handler(__FILE__, __LINE__);
+   }
+   task_rtosRealTimeId = osThreadNew(task_rtosRealTime, NULL, &realTimeAttr);
+   task_rtosMainlineId = osThreadNew(task_rtosMainline, NULL, &mainlineAttr);
+   if(task_rtosRealTimeId == NULL || task_rtosMainlineId == NULL)
+   {
+  	 _Error_Handler(__FILE__, __LINE__);
+   }
+
+   (void)osKernelStart();
+   /* not reached, kernel start failed */
+   _Error_Handler(__FILE__, __LINE__);
+}
+#endif
+
+
+void task_oneMs(void)
+{
+    uint32_t timeUs = task_getTimeUs();
+    uint32_t timeDifference_us = timeUs - task_lastTimeUs;
+    uint16_t timeDifference_ms;
+    uint16_t timerNext_ms = 0xFFFFU;
+    uint32_t timerNext_us = 0xFFFFFFFFUL;
+    uint32_t latencyUs = 0U;
+    uint32_t missed = 0U;
+    uint32_t execUs;
+    bool_t overrun;
+#if CO_RTOS > 0
+    int32_t kernelLock;
+#endif
+    CO_PROFILE_BEGIN(profileStart);
+
+#if (TASK_TICKLESS == 0) && (CO_RTOS == 0)
+    /* called once per TIM6 period, started after its update event */
+    latencyUs = timeUs - task_timerBaseUs;
+    if((int32_t)latencyUs < 0)
+    {
+        /* TIM6 update interrupt came after timeUs was read */
+        latencyUs = 0U;
+    }
+    if((task_timerTicks - task_processedTicks) > 1U)
+    {
+        missed = task_timerTicks - task_processedTicks - 1U;
+    }
+#endif
+    task_lastTimeUs = timeUs;
+    task_processedTicks = task_timerTicks;
+#if TASK_TICKLESS > 0
+    task_wakeUp = false;
+#endif
+
+    /* pass measured time, so late calls don't slow down CANopen timers */
+    task_remainderUs += timeDifference_us;
+    timeDifference_ms = (uint16_t)(task_remainderUs / 1000U);
+    task_remainderUs -= (uint32_t)timeDifference_ms * 1000U;
+
+#if TASK_SYNC_PLL > 0
+    /* nominal TIM6 period, if SYNC was lost */
+    task_pll_process(timeUs);
+#endif
+
+#if CO_NO_LSS_SERVER == 1
+    /* CiA 305 switch delay before and after the new bit rate, CANopen is
+     * not processed, so nothing is sent. Communication reset switches. */
+    if(task_lssSwitch != TASK_LSS_SWITCH_IDLE)
+    {
+        if(timeDifference_ms < task_lssTimerMs)
+        {
+            task_lssTimerMs -= timeDifference_ms;
+        }
+        else if(task_lssSwitch == TASK_LSS_SWITCH_OLD)
+        {
+            task_lssSwitch = TASK_LSS_SWITCH_NEW;
+            task_lssTimerMs = task_lssDelayMs;
+            reset = CO_RESET_COMM;
         }
+        else
+        {
+            task_lssSwitch = TASK_LSS_SWITCH_IDLE;
+        }
+        timerNext_ms = task_lssTimerMs;
+    }
+    if(task_lssSwitch == TASK_LSS_SWITCH_IDLE)
+#endif
+    /* CANopen process, LSS callbacks may request reset too */
+    if(CO_process(CO, timeDifference_ms, &timerNext_ms) == CO_RESET_COMM)
+    {
+        reset = CO_RESET_COMM;
     }
+    task_boot_process(CO->NMT->operatingState);
+
+    if(reset == CO_RESET_COMM)
+    {
+#if CO_NO_LSS_SERVER == 1
+        /* node-ID and bit rate configured by LSS master */
+        task_nodeId = CO->LSSslave->pendingNodeID;
+        task_bitRate = CO->LSSslave->pendingBitRate;
+#endif
+        /* timer thread must not run with uninitialized objects */
+        __HAL_TIM_DISABLE_IT(&htim6, TIM_IT_UPDATE);
+#if (CO_NO_TRACE > 0) && (TASK_TRACE_SAMPLE_HZ > 0)
+        __HAL_TIM_DISABLE_IT(&htim7, TIM_IT_UPDATE);
+#endif
+#if CO_SYNC_HW_TIMER > 0
+        __HAL_TIM_DISABLE_IT(&htim2, TIM_IT_CC1);
+#endif
+#if CO_SYNC_WINDOW_TIMER > 0
+        __HAL_TIM_DISABLE_IT(&htim2, TIM_IT_CC2);
+#endif
+#if CO_HB_HW_TIMER > 0
+        __HAL_TIM_DISABLE_IT(&htim2, TIM_IT_CC3);
+#endif
+#if CO_RTOS > 0
+        /* realtime thread must not run with uninitialized objects either */
+        kernelLock = osKernelLock();
+#endif
+        CO_delete((uint32_t)&hcan1);
+        task_commReset();
+#if CO_RTOS > 0
+        (void)osKernelRestoreLock(kernelLock);
+        task_nextUs = 0U;
+#endif
+        __HAL_TIM_ENABLE_IT(&htim6, TIM_IT_UPDATE);
+#if (CO_NO_TRACE > 0) && (TASK_TRACE_SAMPLE_HZ > 0)
+        __HAL_TIM_ENABLE_IT(&htim7, TIM_IT_UPDATE);
+#endif
+#if CO_SYNC_HW_TIMER > 0
+        __HAL_TIM_ENABLE_IT(&htim2, TIM_IT_CC1);
+#endif
+#if CO_HB_HW_TIMER > 0
+        /* compare may have passed during reset, restart 1 ms from now */
+        TIM2->CCR3 = TIM2->CNT + 1000U;
+        TIM2->SR = ~TIM_SR_CC3IF;
+        __HAL_TIM_ENABLE_IT(&htim2, TIM_IT_CC3);
+#endif
+        return;
+    }
+
+    /* Process EEPROM */
+#ifdef CAN_USE_EEPROM
+          CO_EE_process(&CO_EEO);
+#endif
+#if CO_CAN_RECORDER > 0
+    CO_CANrecorder_process(&task_recorder);
+#endif
+
+#if CO_CAN_BUSLOAD > 0
+    CO_CANbusLoad_process(&task_busLoad, timeDifference_ms);
+#if CO_TPDO_ADAPTIVE_INHIBIT > 0
+    {
+       uint16_t i;
+
+       for(i = 0; i < CO_NO_TPDO; i++){
+          CO_TPDO_setInhibitScale(CO->TPDO[i], task_busLoad.inhibitScale);
+       }
+    }
+#endif
+#endif
+#if (CO_TRACE_STREAM > 0) && (CO_NO_TRACE > 0)
+    CO_traceStream_process(&task_traceStream);
+#endif
+#if CO_LOG > 0
+    CO_log_process();
+#endif
+#if CO_FW_UPDATE > 0
+    CO_fwUpdate_process(&task_fwUpdate, timeDifference_ms);
+#endif
+#if CO_GATEWAY > 0
+    CO_gatewayUart_process(&task_gatewayUart);
+#endif
+#if CO_NO_SDO_CLIENT == 1
+    /* SDO transfers of gateway and NMT master */
+    (void)CO_SDOclientQueue_process(CO->SDOqueue, timeDifference_ms,
+                                    TASK_SDO_CLIENT_TIMEOUT_MS, &timerNext_ms);
+#endif
+#if (CO_NO_NMT_MASTER == 1) && (CO_NO_SDO_CLIENT == 1)
+    (void)CO_NMTmaster_process(CO->NMTmaster, timeDifference_ms, &timerNext_ms);
+#endif
+
+#if (TASK_REALTIME_ISR == 0) && (CO_RTOS == 0)
+    task_realTime(timeDifference_us, &timerNext_us);
+#endif
+
+#if (TASK_TICKLESS > 0) || (CO_RTOS > 0)
+    /* milliseconds timers advance only, when whole milliseconds are accumulated */
+    if((uint32_t)timerNext_ms * 1000U > task_remainderUs)
+    {
+        task_nextUs = (uint32_t)timerNext_ms * 1000U - task_remainderUs;
+    }
+    else
+    {
+        task_nextUs = 0U;
+    }
+    if(task_nextUs > timerNext_us)
+    {
+        task_nextUs = timerNext_us;
+    }
+#else
+    (void)timerNext_us;
+#endif
+
+    /* verify tick overrun, info code is execution time in microseconds */
+    execUs = task_getTimeUs() - timeUs;
+    overrun = task_tick_record(latencyUs, execUs, missed);
+    if(overrun)
+    {
+        CO_errorReport(CO->em, CO_EM_ISR_TIMER_OVERFLOW, CO_EMC_SOFTWARE_INTERNAL, execUs);
+        CO_LOG3("tick overrun: exec %u us, latency %u us, missed %u", execUs, latencyUs, missed);
+    }
+#if TASK_GOVERNOR > 0
+    /* all objects are processed, clock may be switched here */
+    task_gov_process(CO, execUs, timeDifference_us, overrun);
+#endif
+    CO_PROFILE_END(CO_PROFILE_ONE_MS, profileStart);
 }
 
@@ -33,11 +33,242 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 /*-----------------------------------------------------------------------------
  * INCLUDE FILES
  *----------------------------------------------------------------------------*/
+#include "CO_driver.h"
 
 
 /*-----------------------------------------------------------------------------
  * EXPORTED DEFINITIONS
  *----------------------------------------------------------------------------*/
+/*\brief If 1, task_sleep() stops the CPU until the next CANopen deadline or
+ * any interrupt (CAN RX, TX complete), instead of waking every millisecond. */
+#ifndef TASK_TICKLESS
+#define TASK_TICKLESS   0
+#endif
+
+/*\brief If 1, SYNC, RPDO and TPDO are processed in TIM6 interrupt (timer
+ * thread, priority below CAN), task_oneMs() processes only the mainline objects.
+ * PDO cycle time then does not depend on SDO or EMCY activity. */
+#ifndef TASK_REALTIME_ISR
+#define TASK_REALTIME_ISR   0
+#endif
+
+/*\brief If 1, SDO server is processed from task_sleep() as soon as a request
+ * is received (CO_SDO_initCallback()), not only once per task_oneMs(). Segmented
+ * and block transfers are then limited by the bus, not by the 1 ms tick. */
+/*\brief If 1, task_sleep() enters Stop2 mode instead of Sleep, if the next
+ * deadline is at least TASK_STOP2_MIN_US away and CAN transmission is idle.
+ * LPTIM1 (LSI) wakes the CPU at the deadline and measures the stop time, a
+ * falling edge on CAN RX pin (PA11, EXTI11) wakes it immediately. bxCAN has
+ * no clock in Stop2, so the frame which wakes the CPU is lost. Needs
+ * TASK_TICKLESS. */
+#ifndef TASK_STOP2
+#define TASK_STOP2   0
+#endif
+#ifndef TASK_STOP2_MIN_US
+#define TASK_STOP2_MIN_US   5000U
+#endif
+
+#ifndef TASK_SDO_IMMEDIATE
+#define TASK_SDO_IMMEDIATE   0
+#endif
+
+/*\brief With CO_CAN_RX_RING, maximum number of received frames passed to the
+ * CANopen objects in one timer thread cycle. Remaining frames wait for the
+ * next cycle, so cycle time stays bounded during bursts. */
+#ifndef TASK_RX_BATCH
+#define TASK_RX_BATCH   CO_CAN_RX_RING
+#endif
+
+/*\brief CANopen node-ID used after power on. 0xFF (CO_LSS_NODE_ID_ASSIGNMENT)
+ * starts the node without node-ID, it then waits for LSS master fastscan. */
+#ifndef TASK_NODE_ID
+#define TASK_NODE_ID   2U
+#endif
+
+/*\brief CAN bit rate in kbit/s used after power on, may be changed by LSS.
+ * 0 detects bit rate of the bus, if CO_CAN_AUTO_BITRATE is enabled. */
+#ifndef TASK_BIT_RATE
+#define TASK_BIT_RATE   250U
+#endif
+
+/*\brief Trace sampling rate in Hz. If 0, traces are sampled in the timer thread
+ * every millisecond. Otherwise TIM7 interrupt samples them, rates above 1 kHz
+ * catch fast transients. Maximum is 100000. */
+#ifndef TASK_TRACE_SAMPLE_HZ
+#define TASK_TRACE_SAMPLE_HZ   0U
+#endif
+
+/*\brief PC sampling rate in Hz of TIM16 interrupt, if CO_PROFILE_PC is enabled.
+ * It is not a multiple of 1 kHz, so samples don't lock to the TIM6 period.
+ * Maximum is 100000. */
+#ifndef TASK_PC_SAMPLE_HZ
+#define TASK_PC_SAMPLE_HZ   997U
+#endif
+
+/*\brief Single shot capture of all traces, see CO_trace_setCapture(). Number of
+ * points kept before the trigger and recorded after it. 0 post-trigger points
+ * is continuous recording. */
+#ifndef TASK_TRACE_PRE_TRIGGER
+#define TASK_TRACE_PRE_TRIGGER   0U
+#endif
+#ifndef TASK_TRACE_POST_TRIGGER
+#define TASK_TRACE_POST_TRIGGER   0U
+#endif
+
+/*\brief Compression of all traces, see CO_trace_setCompression(). Mode is
+ * CO_TRACE_COMPRESS_DEADBAND (0) or CO_TRACE_COMPRESS_SWINGING_DOOR (1),
+ * deadband is in units of the traced variable, decimation 1 takes every
+ * sample. Defaults record every change. */
+#ifndef TASK_TRACE_COMPRESSION
+#define TASK_TRACE_COMPRESSION   0
+#endif
+#ifndef TASK_TRACE_DEADBAND
+#define TASK_TRACE_DEADBAND   0
+#endif
+#ifndef TASK_TRACE_DECIMATION
+#define TASK_TRACE_DECIMATION   1U
+#endif
+
+/*\brief Latency test variant: RPDO1 is echoed into TPDO1 with reception time,
+ * see task_echo.h. 1 (TASK_ECHO_RX_ISR) sends from CAN receive interrupt,
+ * 2 (TASK_ECHO_TPDO) through TPDO processing in the timer thread. */
+#ifndef TASK_ECHO
+#define TASK_ECHO   0U
+#endif
+
+/*\brief Number of DMA acquisition channels, see task_io.h. Application
+ * configures them in task_ioInit(). TASK_IO_SIZE is the largest OD variable
+ * or array of task_io_configureArray(). */
+#ifndef TASK_IO_CHANNELS
+#define TASK_IO_CHANNELS   0U
+#endif
+#ifndef TASK_IO_SIZE
+#define TASK_IO_SIZE   8U
+#endif
+
+/*\brief SDO client timeout of CO->SDOqueue jobs: gateway commands from USART1,
+ * if CO_GATEWAY is enabled, and boot-up of NMT master slaves. Node-ID of
+ * gateway commands without node-ID is TASK_NODE_ID. */
+#ifndef TASK_SDO_CLIENT_TIMEOUT_MS
+#define TASK_SDO_CLIENT_TIMEOUT_MS   500U
+#endif
+
+/*\brief Node-IDs of slaves, which are booted by NMT master after each
+ * communication reset, if CO_NO_NMT_MASTER and CO_NO_SDO_CLIENT are 1 in
+ * CO_OD.h. Identity is not verified and no configuration is downloaded, see
+ * CO_NMTmaster.h. Slaves are booted in parallel by CO_NO_SDO_CLIENT_NMTM + 1
+ * SDO clients. */
+#ifndef TASK_NMTM_SLAVES
+#define TASK_NMTM_SLAVES   {2U, 3U}
+#endif
+
+/*\brief execution time budget of one task_oneMs() call in microseconds. Longer
+ * calls are reported with CO_EM_ISR_TIMER_OVERFLOW and counted in OD 0x2145,
+ * see task_tick.h. TASK_TICK_HIST_BINS histogram bins divide the budget. */
+#ifndef TASK_TICK_BUDGET_US
+#define TASK_TICK_BUDGET_US   1000U
+#endif
+#ifndef TASK_TICK_HIST_BINS
+#define TASK_TICK_HIST_BINS   8U
+#endif
+
+/*\brief TIM6 period and phase follow received SYNC, see task_pll.h. TIM6
+ * update event comes TASK_SYNC_PLL_OFFSET_US after the SYNC edge, so
+ * task_oneMs() runs a fixed time after SYNC on all nodes. PLL is locked with
+ * phase error within TASK_SYNC_PLL_LOCK_US microseconds. */
+#ifndef TASK_SYNC_PLL
+#define TASK_SYNC_PLL   0
+#endif
+#ifndef TASK_SYNC_PLL_OFFSET_US
+#define TASK_SYNC_PLL_OFFSET_US   200U
+#endif
+#ifndef TASK_SYNC_PLL_LOCK_US
+#define TASK_SYNC_PLL_LOCK_US   20
+#endif
+
+/*\brief clock scaling governor, see task_gov.h. While task_oneMs() is short
+ * and SDO server and CAN transmission are idle for TASK_GOV_HOLD_MS, HCLK is
+ * divided by TASK_GOV_DIV (2, 4, 8 or 16). Tick longer than
+ * TASK_GOV_UP_PERMILLE of TASK_TICK_BUDGET_US, overrun or bus activity
+ * restores full speed. APB clocks are SYSCLK / TASK_GOV_DIV in both profiles,
+ * they must be sufficient for TASK_BIT_RATE. I2C1 runs from SYSCLK, SPI3
+ * prescaler is scaled, see task_gov.h. */
+#ifndef TASK_GOVERNOR
+#define TASK_GOVERNOR   0
+#endif
+#ifndef TASK_GOV_DIV
+#define TASK_GOV_DIV   4U
+#endif
+#ifndef TASK_GOV_UP_PERMILLE
+#define TASK_GOV_UP_PERMILLE   500U
+#endif
+#ifndef TASK_GOV_HOLD_MS
+#define TASK_GOV_HOLD_MS   200U
+#endif
+
+/*\brief Repetitions of CO_bench_run() at cold start, if CO_BENCH is enabled */
+#ifndef TASK_BENCH_ITERATIONS
+#define TASK_BENCH_ITERATIONS   100U
+#endif
+
+/*\brief CANopen threads with CO_RTOS, see task_rtosStart(). Application
+ * threads, which must not delay PDOs, should run between the two priorities.
+ * Stack sizes are in bytes. */
+#ifndef TASK_RTOS_RT_PRIORITY
+#define TASK_RTOS_RT_PRIORITY   osPriorityHigh
+#endif
+#ifndef TASK_RTOS_MAIN_PRIORITY
+#define TASK_RTOS_MAIN_PRIORITY   osPriorityBelowNormal
+#endif
+#ifndef TASK_RTOS_RT_STACK
+#define TASK_RTOS_RT_STACK   1024U
+#endif
+#ifndef TASK_RTOS_MAIN_STACK
+#define TASK_RTOS_MAIN_STACK   2048U
+#endif
+
+/*\brief longest wait of CANopen threads in microseconds with CO_RTOS. It
+ * bounds polling of EEPROM, bus load and gateway UART, which have no deadline
+ * of their own. */
+#ifndef TASK_RTOS_MAX_WAIT_US
+#define TASK_RTOS_MAX_WAIT_US   10000U
+#endif
+
+#if (TASK_TRACE_SAMPLE_HZ > 0) && !defined(TIM7)
+#error TASK_TRACE_SAMPLE_HZ needs TIM7
+#endif
+
+#if (CO_PROFILE_PC > 0) && !defined(TIM16)
+#error CO_PROFILE_PC needs TIM16
+#endif
+
+#if (TASK_TICKLESS > 0) && (TASK_REALTIME_ISR > 0)
+#error TASK_TICKLESS and TASK_REALTIME_ISR can not be used together
+#endif
+
+#if (TASK_STOP2 > 0) && (TASK_TICKLESS == 0)
+#error TASK_STOP2 needs TASK_TICKLESS
+#endif
+
+#if (CO_RTOS > 0) && ((TASK_TICKLESS > 0) || (TASK_REALTIME_ISR > 0) || (TASK_SDO_IMMEDIATE > 0))
+#error CO_RTOS threads replace TASK_TICKLESS, TASK_REALTIME_ISR and TASK_SDO_IMMEDIATE
+#endif
+
+#if (TASK_SYNC_PLL > 0) && ((TASK_TICKLESS > 0) || (CO_RTOS > 0))
+#error TASK_SYNC_PLL needs periodic TIM6, without TASK_TICKLESS and CO_RTOS
+#endif
+
+#if (TASK_STOP2 > 0) && ((TASK_TRACE_SAMPLE_HZ > 0) || (CO_SYNC_HW_TIMER > 0) || (CO_SYNC_WINDOW_TIMER > 0) || (CO_HB_HW_TIMER > 0))
+#error TASK_STOP2 stops TIM2 and TIM7, which are used by another option
+#endif
+
+#if (TASK_GOVERNOR > 0) && ((TASK_STOP2 > 0) || (CO_RTOS > 0))
+#error TASK_GOVERNOR needs task_oneMs() loop, SystemClock_Config() after Stop2 resets the dividers
+#endif
+
+#if (TASK_GOVERNOR > 0) && ((TASK_TRACE_SAMPLE_HZ > 0) || (CO_PROFILE_PC > 0) || (CO_SYNC_HW_TIMER > 0) || (CO_SYNC_WINDOW_TIMER > 0) || (CO_HB_HW_TIMER > 0))
+#error TASK_GOVERNOR rescales only TIM6, clock of TIM2, TIM7 and TIM16 changes
+#endif
 
 
 /*-----------------------------------------------------------------------------
@@ -51,4 +282,90 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 void task_coldStart(void);
 void task_oneMs(void);
 
+/*!*****************************************************************************
+ * \brief returns true, if TIM6 period elapsed since the last task_oneMs() call.
+ * \details With TASK_TICKLESS, if the next deadline passed or CPU was woken up.
+ ******************************************************************************/
+bool_t task_timerElapsed(void);
+
+/*!*****************************************************************************
+ * \brief waits for the next task_oneMs() call.
+ * \details With TASK_TICKLESS, TIM6 period is stretched to the nearest deadline
+ * collected from CANopen objects and the CPU sleeps in WFI. Any interrupt wakes
+ * the CPU and the objects are processed with the measured time. Otherwise
+ * function returns immediately.
+ * With TASK_STOP2, longer idle periods are spent in Stop2 mode, system clock
+ * is configured again after wake-up.
+ * With TASK_SDO_IMMEDIATE, pending SDO requests are processed instead of
+ * sleeping.
+ ******************************************************************************/
+void task_sleep(void);
+
+/*!*****************************************************************************
+ * \brief returns time since start in microseconds, 4 us resolution (TIM6).
+ * \details May be called from any context, wraps after 71 minutes.
+ ******************************************************************************/
+uint32_t task_getTimeUs(void);
+
+/*!*****************************************************************************
+ * \brief called at the SYNC edge, when SYNC is received or transmitted.
+ * \details Weak function, may be redefined by application to latch inputs.
+ * Called from CAN receive interrupt (TIM2 interrupt with CO_SYNC_HW_TIMER),
+ * must be short.
+ * \param timeUs task_getTimeUs() at the SYNC edge.
+ * \param counter SYNC counter, zero if not used.
+ ******************************************************************************/
+void task_syncSignal(uint32_t timeUs, uint8_t counter);
+
+#if CO_RTOS > 0
+/*!*****************************************************************************
+ * \brief creates CANopen threads and starts the RTOS kernel, does not return.
+ * \details Called from main() after task_coldStart(), instead of the
+ * task_oneMs() loop. Realtime thread processes SYNC, RPDO and TPDO, mainline
+ * thread runs task_oneMs() for the other objects. Both threads block on thread
+ * flags until the next CANopen deadline. CAN receive interrupt wakes the
+ * realtime thread for SYNC and frames in the PDO identifier range, the mainline
+ * thread for the others, EMCY wakes the mainline thread.
+ * HAL time base must not use SysTick, which belongs to the kernel. CAN, TIM2
+ * and TIM7 interrupts are moved to CO_RTOS_SYSCALL_PRIORITY, DMA interrupts of
+ * task_io channels must be configured the same way.
+ ******************************************************************************/
+void task_rtosStart(void);
+#endif
+
+#if TASK_IO_CHANNELS > 0
+/*!*****************************************************************************
+ * \brief configures I/O acquisition channels with task_io_configure().
+ * \details Weak function, redefined by application. Called once from
+ * task_coldStart() after CANopen is initialized.
+ ******************************************************************************/
+void task_ioInit(void);
+#endif
+
+#if CO_SYNC_HW_TIMER > 0
+/*!*****************************************************************************
+ * \brief transmits SYNC with CO_SYNC_timerIsr(), called from TIM2_IRQHandler().
+ * \details TIM2 channel 1 compare is advanced by the returned period.
+ ******************************************************************************/
+void task_syncTimer(void);
+#endif
+
+#if CO_SYNC_WINDOW_TIMER > 0
+/*!*****************************************************************************
+ * \brief closes SYNC window with CO_SYNC_windowTimerIsr(), called from
+ * TIM2_IRQHandler().
+ * \details TIM2 channel 2 compare is armed at the SYNC edge in SYNC callback.
+ ******************************************************************************/
+void task_syncWindowTimer(void);
+#endif
+
+#if CO_HB_HW_TIMER > 0
+/*!*****************************************************************************
+ * \brief transmits heartbeat with CO_NMT_HBtimerIsr(), called from
+ * TIM2_IRQHandler().
+ * \details TIM2 channel 3 compare is advanced by the returned period.
+ ******************************************************************************/
+void task_heartbeatTimer(void);
+#endif
+
 #endif /* SCHEDULER_TASK_H_ */
@@ -0,0 +1,131 @@
+/*!*****************************************************************************
+ * \file        task_boot.c
+ *
+ * \brief
+ * Boot phase markers, see task_boot.h.
+ ******************************************************************************/
+
+/*-----------------------------------------------------------------------------
+ * INCLUDE SECTION
+ *----------------------------------------------------------------------------*/
+#include "task_boot.h"
+#include "CO_OD.h"
+
+/*-----------------------------------------------------------------------------
+ * LOCAL (static) DEFINITIONS
+ *----------------------------------------------------------------------------*/
+/*\brief microseconds after the start of main(), 0 if phase was not reached */
+static uint32_t task_bootUs[TASK_BOOT_PHASES];
+/*\brief microseconds counted up to task_bootCycles */
+static uint32_t task_bootElapsedUs = 0U;
+/*\brief DWT cycle counter at the last update */
+static uint32_t task_bootCycles = 0U;
+/*\brief core clock in MHz since the last update */
+static uint32_t task_bootMHz = 4U;
+
+
+/*-----------------------------------------------------------------------------
+ * LOCAL FUNCTION PROTOTYPES
+ *----------------------------------------------------------------------------*/
+static uint32_t task_bootNow(void);
+#ifdef ODL_bootTime_arrayLength
+static CO_SDO_abortCode_t task_bootODF(CO_ODF_arg_t *ODF_arg);
+#endif
+
+
+/*-----------------------------------------------------------------------------
+ * LOCAL FUNCTIONS
+ *----------------------------------------------------------------------------*/
+/* \brief microseconds after the start of main() */
+static uint32_t task_bootNow(void)
+{
+   uint32_t cycles = DWT->CYCCNT;
+
+   /* interval ran at the clock of its beginning, SystemClock_Config() changes it */
+   task_bootElapsedUs += (cycles - task_bootCycles) / task_bootMHz;
+   task_bootCycles = cycles;
+   task_bootMHz = SystemCoreClock / 1000000U;
+   if(task_bootMHz == 0U)
+   {
+      task_bootMHz = 1U;
+   }
+
+   return task_bootElapsedUs;
+}
+
+
+#ifdef ODL_bootTime_arrayLength
+#if ODL_bootTime_arrayLength != TASK_BOOT_PHASES
+#error OD 0x2149 must have TASK_BOOT_PHASES sub-indexes
+#endif
+
+/* \brief function for accessing _boot time_ (index 0x2149) from SDO server */
+static CO_SDO_abortCode_t task_bootODF(CO_ODF_arg_t *ODF_arg)
+{
+   if(ODF_arg->reading && (ODF_arg->subIndex > 0U))
+   {
+      CO_setUint32(ODF_arg->data, task_bootUs[ODF_arg->subIndex - 1U]);
+   }
+
+   return CO_SDO_AB_NONE;
+}
+#endif
+
+
+/*-----------------------------------------------------------------------------
+ * GLOBAL FUNCTIONS
+ *----------------------------------------------------------------------------*/
+void task_boot_start(void)
+{
+   CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+   DWT->CYCCNT = 0U;
+   DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+   task_bootCycles = 0U;
+   task_bootElapsedUs = 0U;
+   (void)task_bootNow();
+}
+
+
+void task_boot_mark(task_bootPhase_t phase)
+{
+   uint32_t timeUs = task_bootNow();
+
+   if(((uint32_t)phase < TASK_BOOT_PHASES) && (task_bootUs[phase] == 0U))
+   {
+      /* 0 means not reached */
+      task_bootUs[phase] = (timeUs != 0U) ? timeUs : 1U;
+   }
+}
+
+
+void task_boot_process(uint8_t NMTstate)
+{
+   if(task_bootUs[TASK_BOOT_OPERATIONAL] != 0U)
+   {
+      return;
+   }
+
+   if(NMTstate != (uint8_t)CO_NMT_INITIALIZING)
+   {
+      task_boot_mark(TASK_BOOT_BOOTUP);
+   }
+   if(NMTstate == (uint8_t)CO_NMT_OPERATIONAL)
+   {
+      task_boot_mark(TASK_BOOT_OPERATIONAL);
+   }
+   else
+   {
+      /* keep counting, cycle counter wraps in 53 s at 80 MHz */
+      (void)task_bootNow();
+   }
+}
+
+
+void task_boot_init(CO_SDO_t *SDO)
+{
+#ifdef ODL_bootTime_arrayLength
+   CO_OD_configure(SDO, TASK_BOOT_OD_INDEX, task_bootODF, NULL, 0, 0U);
+#else
+   (void)SDO;
+#endif
+}
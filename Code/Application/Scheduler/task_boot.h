@@ -0,0 +1,88 @@
+/*!*****************************************************************************
+ * \file        task_boot.h
+ *
+ * \brief
+ * Time from reset to boot-up message and to NMT operational.
+ *
+ * main() calls task_boot_start() first and task_boot_mark() after each step
+ * of the startup sequence, task_coldStart() and task_oneMs() pass the NMT
+ * state to task_boot_process(). Time is counted with the DWT cycle counter
+ * from the start of main(), each interval at the core clock valid at its
+ * beginning (SystemCoreClock), so the MSI part before SystemClock_Config()
+ * is counted correctly too. Reset and startup code before main() are not
+ * included.
+ *
+ * If OD contains UNSIGNED32 array 0x2149 (ODL_bootTime_arrayLength), it is
+ * served by task_boot_init(), microseconds after the start of main(), 0 if
+ * the phase was not reached yet:
+ *  - 1: HAL_Init() finished,
+ *  - 2: SystemClock_Config() finished,
+ *  - 3: CAN peripheral and TIM6 initialized,
+ *  - 4: CANopen initialized, CAN in normal mode,
+ *  - 5: boot-up message sent,
+ *  - 6: NMT operational,
+ *  - 7: peripherals deferred after boot-up initialized.
+ * Times are kept over communication reset.
+ ******************************************************************************/
+#ifndef SCHEDULER_TASK_BOOT_H_
+#define SCHEDULER_TASK_BOOT_H_
+
+/*-----------------------------------------------------------------------------
+ * INCLUDE FILES
+ *----------------------------------------------------------------------------*/
+#include "CANopen.h"
+#include "task.h"
+
+
+/*-----------------------------------------------------------------------------
+ * EXPORTED DEFINITIONS
+ *----------------------------------------------------------------------------*/
+/*\brief OD index of boot times */
+#define TASK_BOOT_OD_INDEX   0x2149U
+/*\brief number of boot phases */
+#define TASK_BOOT_PHASES     7
+
+/*\brief boot phase, OD sub-index is phase + 1 */
+typedef enum
+{
+   TASK_BOOT_HAL = 0,         /*!< HAL_Init() finished */
+   TASK_BOOT_CLOCK = 1,       /*!< SystemClock_Config() finished */
+   TASK_BOOT_PERIPH = 2,      /*!< CAN peripheral and TIM6 initialized */
+   TASK_BOOT_CANOPEN = 3,     /*!< CO_init() finished, CAN in normal mode */
+   TASK_BOOT_BOOTUP = 4,      /*!< boot-up message sent */
+   TASK_BOOT_OPERATIONAL = 5, /*!< NMT operational */
+   TASK_BOOT_DEFERRED = 6     /*!< deferred peripherals initialized */
+} task_bootPhase_t;
+
+
+/*-----------------------------------------------------------------------------
+ * EXPORTED FUNCTIONS
+ *----------------------------------------------------------------------------*/
+/*!*****************************************************************************
+ * \brief starts the DWT cycle counter, time 0 of all phases.
+ * \details Must be the first call in main(), before HAL_Init().
+ ******************************************************************************/
+void task_boot_start(void);
+
+/*!*****************************************************************************
+ * \brief records time of the phase, if it was not reached before.
+ ******************************************************************************/
+void task_boot_mark(task_bootPhase_t phase);
+
+/*!*****************************************************************************
+ * \brief records boot-up and operational phases from NMT state.
+ * \details Must be called after each CO_process(), returns immediately after
+ * NMT operational was reached. Calls at least every few seconds keep the
+ * cycle counter from wrapping between two calls.
+ * \param NMTstate NMT operating state of this node.
+ ******************************************************************************/
+void task_boot_process(uint8_t NMTstate);
+
+/*!*****************************************************************************
+ * \brief serves OD object 0x2149.
+ * \details Must be called after each CO_init(), times are kept.
+ * \param SDO SDO server object.
+ ******************************************************************************/
+void task_boot_init(CO_SDO_t *SDO);
+
+#endif /* SCHEDULER_TASK_BOOT_H_ */
@@ -0,0 +1,88 @@
+/*!*****************************************************************************
+ * \file        task_echo.c
+ *
+ * \brief
+ * RPDO to TPDO echo for bus latency measurement. RPDO1 is copied into the
+ * Object Dictionary and immediately echoed in TPDO1 with reception time, so
+ * host side generator measures turnaround of the stack under bus load.
+ ******************************************************************************/
+
+/*-----------------------------------------------------------------------------
+ * INCLUDE SECTION
+ *----------------------------------------------------------------------------*/
+#include "task_echo.h"
+#include "CO_OD.h"
+
+/*-----------------------------------------------------------------------------
+ * LOCAL (static) DEFINITIONS
+ *----------------------------------------------------------------------------*/
+static CO_t *task_echoCO = NULL;
+static uint8_t task_echoMode = 0U;
+static uint32_t (*task_echoGetTimeUs)(void) = NULL;
+static volatile uint32_t task_echoCount = 0U;
+
+
+/*-----------------------------------------------------------------------------
+ * LOCAL FUNCTION PROTOTYPES
+ *----------------------------------------------------------------------------*/
+static void task_echoReceived(void *object);
+
+
+/*-----------------------------------------------------------------------------
+ * LOCAL FUNCTIONS
+ *----------------------------------------------------------------------------*/
+/* \brief RPDO1 data is in OD: in CAN receive interrupt with TASK_ECHO_RX_ISR,
+ * in CO_RPDO_process() of the timer thread with TASK_ECHO_TPDO */
+static void task_echoReceived(void *object)
+{
+   CO_TPDO_t *TPDO = task_echoCO->TPDO[0];
+   uint32_t timeUs = task_echoGetTimeUs();
+   uint8_t i;
+
+   (void)object;
+
+   CO_LOCK_OD();
+   for(i = 0U; i < 4U; i++)
+   {
+      OD_readInput8Bit[i] = OD_writeOutput8Bit[i];
+   }
+   CO_memcpySwap4(&OD_readInput8Bit[4], &timeUs);
+   CO_UNLOCK_OD();
+
+   if(task_echoMode == TASK_ECHO_RX_ISR)
+   {
+      if(TPDO->valid && *TPDO->operatingState == CO_NMT_OPERATIONAL)
+      {
+         (void)CO_TPDOsend(TPDO);
+      }
+   }
+   else
+   {
+      TPDO->sendRequest = 1U;
+   }
+   task_echoCount++;
+}
+
+
+/*-----------------------------------------------------------------------------
+ * GLOBAL FUNCTIONS
+ *----------------------------------------------------------------------------*/
+void task_echo_init(CO_t *co, uint8_t mode, uint32_t (*getTimeUs)(void))
+{
+   task_echoCO = co;
+   task_echoMode = mode;
+   task_echoGetTimeUs = getTimeUs;
+   task_echoCount = 0U;
+
+   if(mode != 0U)
+   {
+      CO_RPDO_initCallback(co->RPDO[0], (mode == TASK_ECHO_RX_ISR) ? true : false,
+                           NULL, task_echoReceived);
+   }
+}
+
+
+uint32_t task_echo_getCount(void)
+{
+   return task_echoCount;
+}
@@ -0,0 +1,45 @@
+/*!*****************************************************************************
+ * \file        task_echo.h
+ *
+ * \brief
+ * RPDO to TPDO echo for bus latency measurement, see TASK_ECHO.
+ ******************************************************************************/
+#ifndef SCHEDULER_TASK_ECHO_H_
+#define SCHEDULER_TASK_ECHO_H_
+
+/*-----------------------------------------------------------------------------
+ * INCLUDE FILES
+ *----------------------------------------------------------------------------*/
+#include "CANopen.h"
+
+
+/*-----------------------------------------------------------------------------
+ * EXPORTED DEFINITIONS
+ *----------------------------------------------------------------------------*/
+/*\brief echo is sent from CAN receive interrupt, inhibit time is bypassed */
+#define TASK_ECHO_RX_ISR   1U
+/*\brief echo is sent by CO_process_TPDO() in the next timer thread cycle */
+#define TASK_ECHO_TPDO     2U
+
+
+/*-----------------------------------------------------------------------------
+ * EXPORTED FUNCTIONS
+ *----------------------------------------------------------------------------*/
+/*!*****************************************************************************
+ * \brief echoes RPDO1 (OD 0x6200) into TPDO1 (OD 0x6000).
+ * \details Bytes 0..3 of 0x6200 are copied to 0x6000, bytes 4..7 of 0x6000 get
+ * the little-endian time of RPDO reception in microseconds. Host tool
+ * canopen_loadgen maps all 8 bytes of both PDOs and sets inhibit time to 0.
+ * Must be called after each CO_init().
+ * \param co CANopen object.
+ * \param mode TASK_ECHO_RX_ISR or TASK_ECHO_TPDO, 0 disables echo.
+ * \param getTimeUs function, which returns time in microseconds.
+ ******************************************************************************/
+void task_echo_init(CO_t *co, uint8_t mode, uint32_t (*getTimeUs)(void));
+
+/*!*****************************************************************************
+ * \brief returns number of echoed RPDOs since task_echo_init().
+ ******************************************************************************/
+uint32_t task_echo_getCount(void);
+
+#endif /* SCHEDULER_TASK_ECHO_H_ */
@@ -0,0 +1,267 @@
+/*!*****************************************************************************
+ * \file        task_gov.c
+ *
+ * \brief
+ * Clock scaling governor. AHB divider follows load of task_oneMs(), APB
+ * clocks stay the same, see task_gov.h.
+ ******************************************************************************/
+
+/*-----------------------------------------------------------------------------
+ * INCLUDE SECTION
+ *----------------------------------------------------------------------------*/
+#include "task_gov.h"
+#include "CO_OD.h"
+
+/*-----------------------------------------------------------------------------
+ * LOCAL (static) DEFINITIONS
+ *----------------------------------------------------------------------------*/
+/*\brief AHB divider of the low speed profile, APB dividers of the full
+ * speed profile and log2 of TASK_GOV_DIV */
+#if TASK_GOV_DIV == 2
+#define TASK_GOV_HPRE   RCC_CFGR_HPRE_DIV2
+#define TASK_GOV_PPRE   (RCC_CFGR_PPRE1_DIV2 | RCC_CFGR_PPRE2_DIV2)
+#define TASK_GOV_SHIFT  1U
+#elif TASK_GOV_DIV == 4
+#define TASK_GOV_HPRE   RCC_CFGR_HPRE_DIV4
+#define TASK_GOV_PPRE   (RCC_CFGR_PPRE1_DIV4 | RCC_CFGR_PPRE2_DIV4)
+#define TASK_GOV_SHIFT  2U
+#elif TASK_GOV_DIV == 8
+#define TASK_GOV_HPRE   RCC_CFGR_HPRE_DIV8
+#define TASK_GOV_PPRE   (RCC_CFGR_PPRE1_DIV8 | RCC_CFGR_PPRE2_DIV8)
+#define TASK_GOV_SHIFT  3U
+#elif TASK_GOV_DIV == 16
+#define TASK_GOV_HPRE   RCC_CFGR_HPRE_DIV16
+#define TASK_GOV_PPRE   (RCC_CFGR_PPRE1_DIV16 | RCC_CFGR_PPRE2_DIV16)
+#define TASK_GOV_SHIFT  4U
+#else
+#error TASK_GOV_DIV must be 2, 4, 8 or 16
+#endif
+
+/*\brief HCLK per flash wait state in range 1 of the voltage regulator */
+#define TASK_GOV_HZ_PER_WS   16000000U
+
+typedef struct
+{
+   task_govProfile_t profile;
+   uint32_t timerHz;      /*!< TIM6 count rate */
+   uint32_t fullLatency;  /*!< flash wait states at full speed */
+   uint32_t lowLatency;   /*!< flash wait states at low speed */
+   uint32_t holdUs;       /*!< time at full speed without activity */
+   uint32_t peakExecUs;   /*!< longest task_oneMs() within holdUs */
+   uint32_t remainderUs;  /*!< part of millisecond not added to statistics */
+   uint32_t switches;
+   uint32_t lowMs;
+   uint32_t fullMs;
+} task_gov_t;
+
+static task_gov_t task_gov;
+
+
+/*-----------------------------------------------------------------------------
+ * LOCAL FUNCTION PROTOTYPES
+ *----------------------------------------------------------------------------*/
+static uint32_t task_govLatency(uint32_t hclkHz);
+static void task_govApply(task_govProfile_t profile);
+#ifdef ODL_governor_arrayLength
+static CO_SDO_abortCode_t task_govODF(CO_ODF_arg_t *ODF_arg);
+#endif
+
+
+/*-----------------------------------------------------------------------------
+ * LOCAL FUNCTIONS
+ *----------------------------------------------------------------------------*/
+/* \brief flash wait states for HCLK, limited to FLASH_LATENCY_4 */
+static uint32_t task_govLatency(uint32_t hclkHz)
+{
+   uint32_t latency = (hclkHz - 1U) / TASK_GOV_HZ_PER_WS;
+
+   return (latency > FLASH_LATENCY_4) ? FLASH_LATENCY_4 : latency;
+}
+
+
+/* \brief switches AHB and APB dividers, TIM6 keeps its count rate and value */
+static void task_govApply(task_govProfile_t profile)
+{
+   uint32_t primask = __get_PRIMASK();
+   uint32_t cfgr = (profile == TASK_GOV_LOW) ? TASK_GOV_HPRE : TASK_GOV_PPRE;
+   uint32_t latency = (profile == TASK_GOV_LOW) ? task_gov.lowLatency : task_gov.fullLatency;
+   uint32_t timerHz;
+   uint32_t counter;
+
+   __disable_irq();
+   counter = TIM6->CNT;
+
+   /* more wait states before HCLK rises */
+   if(latency > __HAL_FLASH_GET_LATENCY())
+   {
+      __HAL_FLASH_SET_LATENCY(latency);
+      while(__HAL_FLASH_GET_LATENCY() != latency)
+      {
+         ;//wait
+      }
+   }
+   /* one store, PCLK1 and PCLK2 don't change */
+   MODIFY_REG(RCC->CFGR, RCC_CFGR_HPRE | RCC_CFGR_PPRE1 | RCC_CFGR_PPRE2, cfgr);
+   if(latency < __HAL_FLASH_GET_LATENCY())
+   {
+      __HAL_FLASH_SET_LATENCY(latency);
+   }
+   SystemCoreClockUpdate();
+
+   /* APB1 timer clock is twice PCLK1, if APB1 is divided. Prescaler is loaded
+    * by update event without interrupt, then counter is restored. */
+   timerHz = HAL_RCC_GetPCLK1Freq();
+   if((RCC->CFGR & RCC_CFGR_PPRE1) != RCC_CFGR_PPRE1_DIV1)
+   {
+      timerHz *= 2U;
+   }
+   TIM6->PSC = timerHz / task_gov.timerHz - 1U;
+   TIM6->CR1 |= TIM_CR1_URS;
+   TIM6->EGR = TIM_EGR_UG;
+   TIM6->CNT = counter;
+   TIM6->CR1 &= ~TIM_CR1_URS;
+
+   (void)HAL_SYSTICK_Config(SystemCoreClock / 1000U);
+   task_gov.profile = profile;
+   __set_PRIMASK(primask);
+}
+
+
+#ifdef ODL_governor_arrayLength
+#if ODL_governor_arrayLength != 4
+#error OD 0x214C must have 4 sub-indexes
+#endif
+
+/* \brief function for accessing _governor_ (index 0x214C) from SDO server */
+static CO_SDO_abortCode_t task_govODF(CO_ODF_arg_t *ODF_arg)
+{
+   uint32_t value;
+
+   if(ODF_arg->subIndex == 0U)
+   {
+      return CO_SDO_AB_NONE;
+   }
+
+   if(!ODF_arg->reading)
+   {
+      task_gov.switches = 0U;
+      task_gov.lowMs = 0U;
+      task_gov.fullMs = 0U;
+      return CO_SDO_AB_NONE;
+   }
+
+   switch(ODF_arg->subIndex)
+   {
+      case 1U:  value = (uint32_t)task_gov.profile;  break;
+      case 2U:  value = task_gov.switches;           break;
+      case 3U:  value = task_gov.lowMs;              break;
+      default:  value = task_gov.fullMs;             break;
+   }
+   CO_setUint32(ODF_arg->data, value);
+
+   return CO_SDO_AB_NONE;
+}
+#endif
+
+
+/*-----------------------------------------------------------------------------
+ * GLOBAL FUNCTIONS
+ *----------------------------------------------------------------------------*/
+void task_gov_start(uint32_t timerHz)
+{
+   SystemCoreClockUpdate();
+   task_gov.timerHz = timerHz;
+   task_gov.fullLatency = task_govLatency(SystemCoreClock);
+   task_gov.lowLatency = task_govLatency(SystemCoreClock / TASK_GOV_DIV);
+   task_govApply(TASK_GOV_FULL);
+   /* I2C1 timing from Cube MX is calculated for 80 MHz, SYSCLK doesn't change */
+   __HAL_RCC_I2C1_CONFIG(RCC_I2C1CLKSOURCE_SYSCLK);
+}
+
+
+void task_gov_spi(SPI_HandleTypeDef *hspi)
+{
+   uint32_t br = (hspi->Instance->CR1 & SPI_CR1_BR) >> SPI_CR1_BR_Pos;
+
+   /* BR divides PCLK by 2^(BR + 1), PCLK is TASK_GOV_DIV times slower */
+   br = (br > TASK_GOV_SHIFT) ? (br - TASK_GOV_SHIFT) : 0U;
+   hspi->Init.BaudRatePrescaler = br << SPI_CR1_BR_Pos;
+   MODIFY_REG(hspi->Instance->CR1, SPI_CR1_BR, hspi->Init.BaudRatePrescaler);
+}
+
+
+void task_gov_init(CO_SDO_t *SDO)
+{
+#ifdef ODL_governor_arrayLength
+   CO_OD_configure(SDO, TASK_GOV_OD_INDEX, task_govODF, NULL, 0, 0U);
+#else
+   (void)SDO;
+#endif
+}
+
+
+void task_gov_process(CO_t *co, uint32_t execUs, uint32_t periodUs, bool_t overrun)
+{
+   bool_t busy = (co->SDO[0]->state != CO_SDO_ST_IDLE) || (co->CANmodule[0]->CANtxCount > 0U);
+   task_govProfile_t profile = task_gov.profile;
+
+   task_gov.remainderUs += periodUs;
+   if(profile == TASK_GOV_LOW)
+   {
+      task_gov.lowMs += task_gov.remainderUs / 1000U;
+   }
+   else
+   {
+      task_gov.fullMs += task_gov.remainderUs / 1000U;
+   }
+   task_gov.remainderUs %= 1000U;
+
+   if(profile == TASK_GOV_LOW)
+   {
+      /* load arrived, the next tick runs at full speed */
+      if(busy || overrun || ((execUs * 1000U) > (TASK_TICK_BUDGET_US * TASK_GOV_UP_PERMILLE)))
+      {
+         profile = TASK_GOV_FULL;
+      }
+   }
+   else if(busy)
+   {
+      task_gov.holdUs = 0U;
+      task_gov.peakExecUs = 0U;
+   }
+   else
+   {
+      if(execUs > task_gov.peakExecUs)
+      {
+         task_gov.peakExecUs = execUs;
+      }
+      task_gov.holdUs += periodUs;
+      if(task_gov.holdUs >= (TASK_GOV_HOLD_MS * 1000U))
+      {
+         /* the longest tick of the window fits at low speed too */
+         if((task_gov.peakExecUs * TASK_GOV_DIV * 1000U) <= (TASK_TICK_BUDGET_US * TASK_GOV_UP_PERMILLE))
+         {
+            profile = TASK_GOV_LOW;
+         }
+         task_gov.holdUs = 0U;
+         task_gov.peakExecUs = 0U;
+      }
+   }
+
+   if(profile != task_gov.profile)
+   {
+      task_govApply(profile);
+      task_gov.switches++;
+      task_gov.holdUs = 0U;
+      task_gov.peakExecUs = 0U;
+#if CO_CAN_TX_LATENCY > 0
+      co->CANmodule[0]->txLatencyCyclesPerUs = (SystemCoreClock >= 1000000U) ? (SystemCoreClock / 1000000U) : 1U;
+#endif
+   }
+}
+
+
+task_govProfile_t task_gov_profile(void)
+{
+   return task_gov.profile;
+}
@@ -0,0 +1,109 @@
+/*!*****************************************************************************
+ * \file        task_gov.h
+ *
+ * \brief
+ * Clock scaling governor, see TASK_GOVERNOR.
+ *
+ * PLL keeps SYSCLK at its SystemClock_Config() frequency, governor changes
+ * only the AHB divider. In the full speed profile HCLK equals SYSCLK and APB1
+ * and APB2 are divided by TASK_GOV_DIV, in the low speed profile HCLK is
+ * divided by TASK_GOV_DIV and APB1 and APB2 are not divided. All dividers are
+ * written with one store, so PCLK1 and PCLK2 are the same in both profiles:
+ * CAN bit timing, USART baud rate, I2C and SPI clocks don't change and CAN
+ * stays on the bus. CO_CANmodule_init() calculates bit timing from PCLK1, so
+ * task_gov_start() must be called before CAN and the other peripherals are
+ * initialized. I2C1 timing and SPI3 prescaler from Cube MX assume PCLK of
+ * SYSCLK: task_gov_start() switches I2C1 kernel clock to SYSCLK, which is
+ * the same in both profiles, and task_gov_spi() divides SPI prescaler by
+ * TASK_GOV_DIV after each MX_SPI3_Init(). USART1 baud rate is calculated by
+ * HAL from PCLK2 at its init.
+ *
+ * APB timer clock is twice PCLK, if APB is divided, so TIM6 prescaler is
+ * calculated again at each switch and TIM6 keeps its count rate. Flash wait
+ * states follow HCLK, SysTick is configured again. DWT cycle counter counts
+ * HCLK, so DWT time stamps of CO_log and CO_profile are in cycles of the
+ * profile, which was active.
+ *
+ * task_gov_process() is called at the end of task_oneMs(), which is the safe
+ * point for switching. Low speed profile switches to full speed at once, if
+ * task_oneMs() took more than TASK_GOV_UP_PERMILLE of TASK_TICK_BUDGET_US,
+ * overran, SDO server is busy or CAN transmit queue is not empty. Full speed
+ * profile switches to low speed after TASK_GOV_HOLD_MS without SDO transfer
+ * and transmit backlog, if the longest task_oneMs() within that time, scaled
+ * by TASK_GOV_DIV, is below TASK_GOV_UP_PERMILLE too. So SYNC bursts, which
+ * repeat within TASK_GOV_HOLD_MS, keep the full speed.
+ *
+ * If OD contains UNSIGNED32 array 0x214C (ODL_governor_arrayLength), it is
+ * served by task_gov_init():
+ *  - 1: active profile, 0 full speed, 1 low speed,
+ *  - 2: number of switches,
+ *  - 3: milliseconds in the low speed profile,
+ *  - 4: milliseconds in the full speed profile.
+ * Writing any sub-index resets 2 to 4.
+ ******************************************************************************/
+#ifndef SCHEDULER_TASK_GOV_H_
+#define SCHEDULER_TASK_GOV_H_
+
+/*-----------------------------------------------------------------------------
+ * INCLUDE FILES
+ *----------------------------------------------------------------------------*/
+#include "CANopen.h"
+#include "task.h"
+
+
+/*-----------------------------------------------------------------------------
+ * EXPORTED DEFINITIONS
+ *----------------------------------------------------------------------------*/
+/*\brief OD index of governor statistics */
+#define TASK_GOV_OD_INDEX   0x214CU
+
+/*\brief clock profile */
+typedef enum
+{
+   TASK_GOV_FULL = 0,   /*!< HCLK is SYSCLK */
+   TASK_GOV_LOW = 1     /*!< HCLK is SYSCLK / TASK_GOV_DIV */
+} task_govProfile_t;
+
+
+/*-----------------------------------------------------------------------------
+ * EXPORTED FUNCTIONS
+ *----------------------------------------------------------------------------*/
+/*!*****************************************************************************
+ * \brief switches to the full speed profile at cold start.
+ * \details Must be called after SystemClock_Config() and MX_TIM6_Init(),
+ * before other peripherals are initialized and before TIM6 is started.
+ * \param timerHz TIM6 count rate.
+ ******************************************************************************/
+void task_gov_start(uint32_t timerHz);
+
+/*!*****************************************************************************
+ * \brief keeps SPI clock of Cube MX, which assumes PCLK of SYSCLK.
+ * \details Must be called after MX_SPI3_Init(), SPI must be disabled.
+ * \param hspi SPI handle, BaudRatePrescaler is divided by TASK_GOV_DIV
+ * (limited to 2).
+ ******************************************************************************/
+void task_gov_spi(SPI_HandleTypeDef *hspi);
+
+/*!*****************************************************************************
+ * \brief serves OD object 0x214C.
+ * \details Must be called after each CO_init(), profile and statistics are kept.
+ * \param SDO SDO server object.
+ ******************************************************************************/
+void task_gov_init(CO_SDO_t *SDO);
+
+/*!*****************************************************************************
+ * \brief selects the clock profile, called at the end of task_oneMs().
+ * \param co CANopen object, its SDO server and transmit queue are checked,
+ * DWT cycles per microsecond of CO_CAN_TX_LATENCY are updated.
+ * \param execUs execution time of task_oneMs().
+ * \param periodUs time since the previous task_oneMs().
+ * \param overrun task_oneMs() was an overrun, see task_tick_record().
+ ******************************************************************************/
+void task_gov_process(CO_t *co, uint32_t execUs, uint32_t periodUs, bool_t overrun);
+
+/*!*****************************************************************************
+ * \brief returns the active clock profile.
+ ******************************************************************************/
+task_govProfile_t task_gov_profile(void);
+
+#endif /* SCHEDULER_TASK_GOV_H_ */
@@ -0,0 +1,407 @@
+/*!*****************************************************************************
+ * \file        task_io.c
+ *
+ * \brief
+ * DMA driven acquisition of application inputs into mapped OD variables.
+ * Each channel has two buffers: DMA fills buffer _fill_, the other one holds
+ * the last complete sample until task_io_publish() copies it into the OD,
+ * optionally scaled with task_ioScale().
+ ******************************************************************************/
+
+/*-----------------------------------------------------------------------------
+ * INCLUDE SECTION
+ *----------------------------------------------------------------------------*/
+#include <string.h>
+#include "task_io.h"
+#include "CO_eeprom.h"
+
+#if TASK_IO_CHANNELS > 0
+
+#if (CO_EE_BACKEND == CO_EE_BACKEND_SPI) && (CO_EE_DMA > 0)
+#error SPI DMA callbacks are used by CO_eeprom, disable CO_EE_DMA or TASK_IO_CHANNELS
+#endif
+
+/*-----------------------------------------------------------------------------
+ * LOCAL (static) DEFINITIONS
+ *----------------------------------------------------------------------------*/
+typedef struct
+{
+   task_io_start_t start;
+   void           *object;
+   CO_t           *co;
+   uint8_t        *odData;
+   uint16_t        index;
+   uint16_t        size;
+   uint8_t         trigger;
+   uint16_t        period;
+   /*\brief microseconds since the last TASK_IO_TICK start */
+   uint32_t        timerUs;
+   uint8_t         buffer[2][TASK_IO_SIZE];
+   /*\brief buffer written by the running or next transfer */
+   volatile uint8_t fill;
+   volatile bool_t busy;
+   /*\brief buffer fill ^ 1 holds a sample, which is not published yet */
+   volatile bool_t ready;
+   volatile uint32_t overruns;
+   /*\brief from task_io_setScale(), NULL for plain copy */
+   const task_io_scale_t *scale;
+   uint8_t         shift;
+} task_io_channel_t;
+
+static task_io_channel_t task_ioChannels[TASK_IO_CHANNELS];
+
+
+/*-----------------------------------------------------------------------------
+ * LOCAL FUNCTION PROTOTYPES
+ *----------------------------------------------------------------------------*/
+static CO_ReturnError_t task_ioSetup(uint8_t channel, CO_t *co, uint16_t index,
+                                     uint8_t *data, uint16_t size, uint8_t trigger,
+                                     uint16_t period, task_io_start_t start, void *object);
+static void task_ioStart(task_io_channel_t *ch);
+static void task_ioScale(uint8_t *dst, const uint8_t *src, const task_io_scale_t *scale,
+                         uint8_t shift, uint16_t size);
+static void task_ioSpiDone(SPI_HandleTypeDef *hspi, bool_t ok);
+
+
+/*-----------------------------------------------------------------------------
+ * LOCAL FUNCTIONS
+ *----------------------------------------------------------------------------*/
+/* \brief common part of task_io_configure() and task_io_configureArray() */
+static CO_ReturnError_t task_ioSetup(uint8_t channel, CO_t *co, uint16_t index,
+                                     uint8_t *data, uint16_t size, uint8_t trigger,
+                                     uint16_t period, task_io_start_t start, void *object)
+{
+   task_io_channel_t *ch = &task_ioChannels[channel];
+
+   if(size == 0U || size > TASK_IO_SIZE || data == NULL)
+   {
+      return CO_ERROR_ILLEGAL_ARGUMENT;
+   }
+
+   ch->trigger = 0U;
+   ch->start = start;
+   ch->object = object;
+   ch->co = co;
+   ch->odData = data;
+   ch->index = index;
+   ch->size = size;
+   ch->period = period;
+   ch->timerUs = 0U;
+   ch->fill = 0U;
+   ch->busy = false;
+   ch->ready = false;
+   ch->overruns = 0U;
+   ch->scale = NULL;
+   ch->shift = 0U;
+   ch->trigger = trigger;
+
+   return CO_ERROR_NO;
+}
+
+
+/* \brief starts transfer into buffer _fill_, skips it if previous is running */
+static void task_ioStart(task_io_channel_t *ch)
+{
+   uint32_t primask = __get_PRIMASK();
+   bool_t busy;
+
+   __disable_irq();
+   busy = ch->busy;
+   ch->busy = true;
+   __set_PRIMASK(primask);
+
+   if(busy)
+   {
+      ch->overruns++;
+   }
+   else if(!ch->start(ch->object, ch->buffer[ch->fill], ch->size))
+   {
+      ch->busy = false;
+      ch->overruns++;
+   }
+   else
+   {
+      ;//do nothing
+   }
+}
+
+
+/* \brief converts _size_ bytes of INTEGER16 samples from _src_ into _dst_, see
+ * task_io_setScale(). Pairs of samples are processed in one word: SMLAD
+ * multiplies the lane, which is not masked out, and adds rounding, SSAT limits
+ * both results, PKHBT packs them and QADD16 adds both offsets with saturation.
+ * Words are accessed with memcpy(), which is a single LDR/STR on Cortex-M4, as
+ * OD arrays of INTEGER16 may be halfword aligned only. */
+static void task_ioScale(uint8_t *dst, const uint8_t *src, const task_io_scale_t *scale,
+                         uint8_t shift, uint16_t size)
+{
+   uint32_t round = (shift > 0U) ? (1UL << (shift - 1U)) : 0U;
+   uint16_t n = size / 2U;
+   uint16_t i;
+
+   for(i = 0U; (i + 1U) < n; i += 2U)
+   {
+      uint32_t raw, gain, offset;
+      int32_t lo, hi;
+
+      memcpy(&raw, &src[i * 2U], 4U);
+      memcpy(&gain, &scale->gain[i], 4U);
+      memcpy(&offset, &scale->offset[i], 4U);
+      lo = (int32_t)__SMLAD(raw & 0x0000FFFFU, gain, round);
+      hi = (int32_t)__SMLAD(raw & 0xFFFF0000U, gain, round);
+      lo = (int32_t)__SSAT(lo >> shift, 16);
+      hi = (int32_t)__SSAT(hi >> shift, 16);
+      raw = __QADD16(__PKHBT(lo, hi, 16), offset);
+      memcpy(&dst[i * 2U], &raw, 4U);
+   }
+   if(i < n)
+   {
+      /* odd last sample */
+      int16_t sample;
+      int32_t value;
+
+      memcpy(&sample, &src[i * 2U], 2U);
+      value = (int32_t)__SSAT(((int32_t)sample * scale->gain[i] + (int32_t)round) >> shift, 16);
+      sample = (int16_t)__SSAT(value + scale->offset[i], 16);
+      memcpy(&dst[i * 2U], &sample, 2U);
+   }
+}
+
+
+/* \brief end of task_io_spiStart() transfer on _hspi_ */
+static void task_ioSpiDone(SPI_HandleTypeDef *hspi, bool_t ok)
+{
+   uint8_t i;
+
+   for(i = 0U; i < TASK_IO_CHANNELS; i++)
+   {
+      task_io_channel_t *ch = &task_ioChannels[i];
+
+      if(ch->busy && ch->start == task_io_spiStart
+            && ((task_io_spi_t*)ch->object)->hspi == hspi)
+      {
+         task_io_spi_t *spi = (task_io_spi_t*)ch->object;
+
+         HAL_GPIO_WritePin(spi->csPort, spi->csPin, GPIO_PIN_SET);
+         task_io_done(spi, ok);
+         break;
+      }
+   }
+}
+
+
+/*-----------------------------------------------------------------------------
+ * GLOBAL FUNCTIONS - see descriptions in header file
+ *----------------------------------------------------------------------------*/
+CO_ReturnError_t task_io_configure(uint8_t channel, CO_t *co, uint16_t index,
+                                   uint8_t subIndex, uint8_t trigger, uint16_t period,
+                                   task_io_start_t start, void *object)
+{
+   uint16_t entryNo;
+
+   if(channel >= TASK_IO_CHANNELS || co == NULL || start == NULL
+         || (trigger != TASK_IO_SYNC && trigger != TASK_IO_TICK))
+   {
+      return CO_ERROR_ILLEGAL_ARGUMENT;
+   }
+
+   entryNo = CO_OD_find(co->SDO[0], index);
+   if(entryNo == 0xFFFFU || subIndex > co->SDO[0]->OD[entryNo].maxSubIndex)
+   {
+      return CO_ERROR_ILLEGAL_ARGUMENT;
+   }
+
+   return task_ioSetup(channel, co, index,
+                       (uint8_t*)CO_OD_getDataPointer(co->SDO[0], entryNo, subIndex),
+                       CO_OD_getLength(co->SDO[0], entryNo, subIndex),
+                       trigger, period, start, object);
+}
+
+
+CO_ReturnError_t task_io_configureArray(uint8_t channel, CO_t *co, uint16_t index,
+                                        uint8_t trigger, uint16_t period,
+                                        task_io_start_t start, void *object)
+{
+   uint16_t entryNo;
+   uint16_t length;
+   uint8_t *data;
+   uint8_t sub;
+
+   if(channel >= TASK_IO_CHANNELS || co == NULL || start == NULL
+         || (trigger != TASK_IO_SYNC && trigger != TASK_IO_TICK))
+   {
+      return CO_ERROR_ILLEGAL_ARGUMENT;
+   }
+
+   entryNo = CO_OD_find(co->SDO[0], index);
+   if(entryNo == 0xFFFFU || co->SDO[0]->OD[entryNo].maxSubIndex == 0U)
+   {
+      return CO_ERROR_ILLEGAL_ARGUMENT;
+   }
+   data = (uint8_t*)CO_OD_getDataPointer(co->SDO[0], entryNo, 1U);
+   length = CO_OD_getLength(co->SDO[0], entryNo, 1U);
+
+   /* members must follow each other, DMA fills them in one transfer */
+   for(sub = 2U; sub <= co->SDO[0]->OD[entryNo].maxSubIndex; sub++)
+   {
+      if(CO_OD_getLength(co->SDO[0], entryNo, sub) != length
+            || (uint8_t*)CO_OD_getDataPointer(co->SDO[0], entryNo, sub) != &data[(sub - 1U) * length])
+      {
+         return CO_ERROR_ILLEGAL_ARGUMENT;
+      }
+   }
+
+   return task_ioSetup(channel, co, index, data,
+                       (uint16_t)(length * co->SDO[0]->OD[entryNo].maxSubIndex),
+                       trigger, period, start, object);
+}
+
+
+CO_ReturnError_t task_io_setScale(uint8_t channel, const task_io_scale_t *scale, uint8_t shift)
+{
+   task_io_channel_t *ch;
+
+   if(channel >= TASK_IO_CHANNELS || shift > 15U)
+   {
+      return CO_ERROR_ILLEGAL_ARGUMENT;
+   }
+   ch = &task_ioChannels[channel];
+   if(ch->trigger == 0U || (ch->size & 1U) != 0U)
+   {
+      return CO_ERROR_ILLEGAL_ARGUMENT;
+   }
+
+   /* task_io_publish() runs in timer thread */
+   CO_LOCK_OD();
+   ch->scale = scale;
+   ch->shift = shift;
+   CO_UNLOCK_OD();
+
+   return CO_ERROR_NO;
+}
+
+
+void task_io_sync(void)
+{
+   uint8_t i;
+
+   for(i = 0U; i < TASK_IO_CHANNELS; i++)
+   {
+      if(task_ioChannels[i].trigger == TASK_IO_SYNC)
+      {
+         task_ioStart(&task_ioChannels[i]);
+      }
+   }
+}
+
+
+void task_io_tick(uint32_t timeDifference_us)
+{
+   uint8_t i;
+
+   for(i = 0U; i < TASK_IO_CHANNELS; i++)
+   {
+      task_io_channel_t *ch = &task_ioChannels[i];
+
+      if(ch->trigger == TASK_IO_TICK)
+      {
+         ch->timerUs += timeDifference_us;
+         if(ch->timerUs >= (uint32_t)ch->period * 1000U)
+         {
+            ch->timerUs = 0U;
+            task_ioStart(ch);
+         }
+      }
+   }
+}
+
+
+void task_io_publish(void)
+{
+   uint8_t i;
+
+   for(i = 0U; i < TASK_IO_CHANNELS; i++)
+   {
+      task_io_channel_t *ch = &task_ioChannels[i];
+
+      if(ch->ready)
+      {
+         /* task_io_done() can not swap the buffers inside the lock */
+         CO_LOCK_OD();
+         ch->ready = false;
+         if(ch->scale != NULL)
+         {
+            task_ioScale(ch->odData, ch->buffer[ch->fill ^ 1U], ch->scale, ch->shift, ch->size);
+         }
+         else
+         {
+            memcpy(ch->odData, ch->buffer[ch->fill ^ 1U], ch->size);
+         }
+         CO_UNLOCK_OD();
+#if CO_TPDO_DIRTY_FLAGS > 0
+         CO_TPDOmarkDirty(ch->co->SDO[0], ch->index);
+#endif
+      }
+   }
+}
+
+
+void task_io_done(void *object, bool_t ok)
+{
+   uint8_t i;
+
+   for(i = 0U; i < TASK_IO_CHANNELS; i++)
+   {
+      task_io_channel_t *ch = &task_ioChannels[i];
+
+      if(ch->busy && ch->object == object)
+      {
+         if(ok)
+         {
+            ch->fill ^= 1U;
+            ch->ready = true;
+         }
+         else
+         {
+            ch->overruns++;
+         }
+         ch->busy = false;
+         break;
+      }
+   }
+}
+
+
+bool_t task_io_spiStart(void *object, uint8_t *data, uint16_t size)
+{
+   task_io_spi_t *spi = (task_io_spi_t*)object;
+
+   HAL_GPIO_WritePin(spi->csPort, spi->csPin, GPIO_PIN_RESET);
+   if(HAL_SPI_TransmitReceive_DMA(spi->hspi, (uint8_t*)spi->command, data, size) != HAL_OK)
+   {
+      HAL_GPIO_WritePin(spi->csPort, spi->csPin, GPIO_PIN_SET);
+      return false;
+   }
+   return true;
+}
+
+
+uint32_t task_io_getOverruns(uint8_t channel)
+{
+   return (channel < TASK_IO_CHANNELS) ? task_ioChannels[channel].overruns : 0U;
+}
+
+
+/* \brief Cube MX callbacks for SPI DMA transfers of task_io_spiStart() */
+void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+   task_ioSpiDone(hspi, true);
+}
+
+
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi)
+{
+   task_ioSpiDone(hspi, false);
+}
+
+#endif /* TASK_IO_CHANNELS > 0 */
@@ -0,0 +1,144 @@
+/*!*****************************************************************************
+ * \file        task_io.h
+ *
+ * \brief
+ * DMA driven acquisition of application inputs into mapped OD variables, see
+ * TASK_IO_CHANNELS.
+ *
+ * Each channel starts a DMA transfer (SPI, I2C, ADC) at the SYNC edge or
+ * periodically in the timer thread. Transfer fills one of two channel buffers
+ * while the other one holds the last complete sample. task_io_publish() copies
+ * the complete buffer into the OD variable with one block copy, just before
+ * TPDOs are built, so there is no per-sample work in the CPU and the TPDO
+ * never sees a half written value.
+ *
+ * Channel of INTEGER16 samples, usually an OD array configured with
+ * task_io_configureArray(), may be converted into engineering units on the
+ * way, see task_io_setScale(). Conversion runs in task_io_publish() over the
+ * whole channel with Cortex-M4 SIMD instructions, two samples per step.
+ ******************************************************************************/
+#ifndef SCHEDULER_TASK_IO_H_
+#define SCHEDULER_TASK_IO_H_
+
+/*-----------------------------------------------------------------------------
+ * INCLUDE FILES
+ *----------------------------------------------------------------------------*/
+#include "CANopen.h"
+#include "task.h"
+
+
+/*-----------------------------------------------------------------------------
+ * EXPORTED DEFINITIONS
+ *----------------------------------------------------------------------------*/
+/*\brief channel is started from SYNC callback, at the SYNC edge */
+#define TASK_IO_SYNC   1U
+/*\brief channel is started by task_io_tick() every _period_ milliseconds */
+#define TASK_IO_TICK   2U
+
+/*\brief starts DMA transfer of _size_ bytes into _data_, returns false if
+ * the transfer could not be started. Called from interrupt or timer thread.
+ * Transfer end must be reported with task_io_done(). */
+typedef bool_t (*task_io_start_t)(void *object, uint8_t *data, uint16_t size);
+
+/*\brief SPI device for task_io_spiStart(), chip select is active low */
+typedef struct
+{
+   SPI_HandleTypeDef *hspi;
+   GPIO_TypeDef      *csPort;
+   uint16_t           csPin;
+   /*\brief bytes clocked out during the transfer, channel size long */
+   const uint8_t     *command;
+} task_io_spi_t;
+
+/*\brief calibration of INTEGER16 samples for task_io_setScale(), one gain
+ * and offset per sample. */
+typedef struct
+{
+   int16_t gain[TASK_IO_SIZE / 2U];
+   int16_t offset[TASK_IO_SIZE / 2U];
+} task_io_scale_t;
+
+
+/*-----------------------------------------------------------------------------
+ * EXPORTED FUNCTIONS
+ *----------------------------------------------------------------------------*/
+/*!*****************************************************************************
+ * \brief configures acquisition channel into OD variable index, subIndex.
+ * \details Called from task_ioInit(). Size of the transfer is the variable
+ * length, maximum TASK_IO_SIZE bytes.
+ * \param channel channel number, 0 to TASK_IO_CHANNELS - 1.
+ * \param co CANopen object.
+ * \param index, subIndex OD variable, usually mapped to a TPDO.
+ * \param trigger TASK_IO_SYNC or TASK_IO_TICK.
+ * \param period period in milliseconds for TASK_IO_TICK.
+ * \param start function, which starts the transfer, e.g. task_io_spiStart().
+ * \param object passed to _start_, e.g. task_io_spi_t.
+ * \return CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ ******************************************************************************/
+CO_ReturnError_t task_io_configure(uint8_t channel, CO_t *co, uint16_t index,
+                                   uint8_t subIndex, uint8_t trigger, uint16_t period,
+                                   task_io_start_t start, void *object);
+
+/*!*****************************************************************************
+ * \brief configures acquisition channel into all members of OD array _index_.
+ * \details Same as task_io_configure(), but the transfer fills sub-indexes
+ * 1 to maximum sub-index, which must be equally long and contiguous in
+ * memory. Size of the transfer is the array length, maximum TASK_IO_SIZE.
+ * \return CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ ******************************************************************************/
+CO_ReturnError_t task_io_configureArray(uint8_t channel, CO_t *co, uint16_t index,
+                                        uint8_t trigger, uint16_t period,
+                                        task_io_start_t start, void *object);
+
+/*!*****************************************************************************
+ * \brief converts samples of the channel into engineering units.
+ * \details Channel holds little endian INTEGER16 samples. task_io_publish()
+ * then stores each sample as
+ *    out = sat16(sat16((raw * gain + round) >> shift) + offset)
+ * where round is half of the last bit. Must be called after configuration.
+ * \param channel configured channel with even size.
+ * \param scale gain and offset for each sample, kept by the caller, NULL
+ * switches conversion off.
+ * \param shift fractional bits of gain, 0 to 15.
+ * \return CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ ******************************************************************************/
+CO_ReturnError_t task_io_setScale(uint8_t channel, const task_io_scale_t *scale, uint8_t shift);
+
+/*!*****************************************************************************
+ * \brief starts all channels with TASK_IO_SYNC, called from SYNC callback.
+ ******************************************************************************/
+void task_io_sync(void);
+
+/*!*****************************************************************************
+ * \brief starts TASK_IO_TICK channels, whose period elapsed, timer thread.
+ * \param timeDifference_us time since the previous call.
+ ******************************************************************************/
+void task_io_tick(uint32_t timeDifference_us);
+
+/*!*****************************************************************************
+ * \brief copies completed samples into OD variables, timer thread before
+ * CO_process_TPDO().
+ ******************************************************************************/
+void task_io_publish(void);
+
+/*!*****************************************************************************
+ * \brief reports end of transfer of _object_, called from DMA or peripheral
+ * interrupt.
+ * \param object same as in task_io_configure().
+ * \param ok false, if transfer failed, buffer is then not published.
+ ******************************************************************************/
+void task_io_done(void *object, bool_t ok);
+
+/*!*****************************************************************************
+ * \brief task_io_start_t for task_io_spi_t, full duplex SPI DMA transfer.
+ * \details HAL_SPI_TxRxCpltCallback() in task_io.c ends the transfer.
+ ******************************************************************************/
+bool_t task_io_spiStart(void *object, uint8_t *data, uint16_t size);
+
+/*!*****************************************************************************
+ * \brief returns number of triggers, which were skipped, because the previous
+ * transfer of the channel was not finished or failed.
+ ******************************************************************************/
+uint32_t task_io_getOverruns(uint8_t channel);
+
+#endif /* SCHEDULER_TASK_IO_H_ */
@@ -0,0 +1,276 @@
+/*!*****************************************************************************
+ * \file        task_pll.c
+ *
+ * \brief
+ * Software PLL, which locks TIM6 period and phase to the received SYNC.
+ ******************************************************************************/
+
+/*-----------------------------------------------------------------------------
+ * INCLUDE SECTION
+ *----------------------------------------------------------------------------*/
+#include "task_pll.h"
+#include "CO_OD.h"
+
+/*-----------------------------------------------------------------------------
+ * LOCAL (static) DEFINITIONS
+ *----------------------------------------------------------------------------*/
+/*\brief SYNC period may differ from whole ticks by 1/TASK_PLL_TOLERANCE */
+#define TASK_PLL_TOLERANCE   50U
+/*\brief tick period may differ from nominal by 1/TASK_PLL_RANGE */
+#define TASK_PLL_RANGE       100U
+/*\brief SYNCs within TASK_SYNC_PLL_LOCK_US, which lock the PLL */
+#define TASK_PLL_LOCK_COUNT  8U
+/*\brief SYNC periods without SYNC, which return to the nominal period */
+#define TASK_PLL_TIMEOUT     2U
+
+#if CO_NO_SYNC == 0
+#error TASK_SYNC_PLL needs SYNC object
+#endif
+
+/*\brief PLL variables */
+typedef struct
+{
+   uint32_t nominalUs;        /*!< tick period without SYNC */
+   uint32_t nsPerCount;       /*!< TIM6 count */
+   volatile uint32_t periodNs;/*!< tick period used by task_pll_reload() */
+   uint32_t fractionNs;       /*!< part of the period not yet applied as count */
+   uint32_t freqNs;           /*!< tick period from measured SYNC period */
+   volatile uint32_t lastSyncUs; /*!< task_getTimeUs() of the last SYNC */
+#if CO_CAN_TIMESTAMP > 0
+   uint16_t lastStamp;        /*!< receive timestamp of the last SYNC */
+#endif
+   uint32_t syncPeriodUs;     /*!< measured SYNC period */
+   int32_t phaseErrorUs;      /*!< phase error at the last SYNC */
+   uint32_t lockLosses;       /*!< transitions from locked */
+   uint8_t inLock;            /*!< consecutive SYNCs within TASK_SYNC_PLL_LOCK_US */
+   bool_t seen;               /*!< lastSyncUs is valid */
+   volatile task_pllState_t state;
+} task_pll_t;
+
+static task_pll_t task_pll;
+
+
+/*-----------------------------------------------------------------------------
+ * LOCAL FUNCTION PROTOTYPES
+ *----------------------------------------------------------------------------*/
+static void task_pll_free(void);
+#ifdef ODL_SYNCPLL_arrayLength
+static CO_SDO_abortCode_t task_pllODF(CO_ODF_arg_t *ODF_arg);
+#endif
+
+
+/*-----------------------------------------------------------------------------
+ * LOCAL FUNCTIONS
+ *----------------------------------------------------------------------------*/
+/* \brief nominal period, interrupts must be disabled */
+static void task_pll_free(void)
+{
+   if(task_pll.state == TASK_PLL_LOCKED)
+   {
+      task_pll.lockLosses++;
+   }
+   task_pll.state = TASK_PLL_FREE;
+   task_pll.periodNs = task_pll.nominalUs * 1000U;
+   task_pll.inLock = 0U;
+   task_pll.seen = false;
+}
+
+
+#ifdef ODL_SYNCPLL_arrayLength
+#if ODL_SYNCPLL_arrayLength != 5
+#error OD 0x2148 must have 5 sub-indexes
+#endif
+
+/* \brief function for accessing _SYNC PLL_ (index 0x2148) from SDO server */
+static CO_SDO_abortCode_t task_pllODF(CO_ODF_arg_t *ODF_arg)
+{
+   uint32_t value;
+
+   if(ODF_arg->subIndex == 0U)
+   {
+      return CO_SDO_AB_NONE;
+   }
+
+   if(!ODF_arg->reading)
+   {
+      task_pll.lockLosses = 0U;
+      return CO_SDO_AB_NONE;
+   }
+
+   switch(ODF_arg->subIndex)
+   {
+      case 1U:  value = (uint32_t)task_pll.state;         break;
+      case 2U:  value = (uint32_t)task_pll.phaseErrorUs;  break;
+      case 3U:  value = task_pll.periodNs;                break;
+      case 4U:  value = task_pll.syncPeriodUs;            break;
+      default:  value = task_pll.lockLosses;              break;
+   }
+   CO_setUint32(ODF_arg->data, value);
+
+   return CO_SDO_AB_NONE;
+}
+#endif
+
+
+/*-----------------------------------------------------------------------------
+ * GLOBAL FUNCTIONS
+ *----------------------------------------------------------------------------*/
+void task_pll_init(CO_SDO_t *SDO, uint32_t nominalUs, uint32_t nsPerCount)
+{
+   task_pll.nominalUs = nominalUs;
+   task_pll.nsPerCount = nsPerCount;
+   task_pll.fractionNs = 0U;
+   task_pll_free();
+
+#ifdef ODL_SYNCPLL_arrayLength
+   CO_OD_configure(SDO, TASK_PLL_OD_INDEX, task_pllODF, NULL, 0, 0U);
+#else
+   (void)SDO;
+#endif
+}
+
+
+void task_pll_sync(const CO_SYNC_t *SYNC, uint32_t timeUs, uint32_t phaseUs)
+{
+   uint32_t periodUs = timeUs - task_pll.lastSyncUs;
+   uint32_t ticks;
+   uint32_t wholeUs;
+   uint32_t measNs;
+   uint32_t halfUs = task_pll.nominalUs / 2U;
+   int32_t error;
+   int32_t periodNs;
+   int32_t rangeNs;
+   bool_t seen = task_pll.seen;
+
+   if(SYNC->isProducer)
+   {
+      return;
+   }
+
+#if CO_CAN_TIMESTAMP > 0
+   if(seen)
+   {
+      /* receive timestamps have no interrupt latency, but wrap after 65536
+       * bit times, so they must agree with task_getTimeUs() */
+      uint32_t stampUs = CO_CANtimestampDiff_us(SYNC->CANdevRx, task_pll.lastStamp, SYNC->CANrxTimestamp);
+
+      if((stampUs + halfUs) >= periodUs && stampUs <= (periodUs + halfUs))
+      {
+         periodUs = stampUs;
+      }
+   }
+   task_pll.lastStamp = SYNC->CANrxTimestamp;
+#endif
+   task_pll.lastSyncUs = timeUs;
+   task_pll.seen = true;
+   if(!seen)
+   {
+      return;
+   }
+
+   /* lost SYNC gives multiple period, frequency is still right */
+   ticks = (periodUs + halfUs) / task_pll.nominalUs;
+   wholeUs = ticks * task_pll.nominalUs;
+   if(ticks == 0U || ticks > 255U
+      || (periodUs > wholeUs ? periodUs - wholeUs : wholeUs - periodUs) > wholeUs / TASK_PLL_TOLERANCE)
+   {
+      task_pll_free();
+      task_pll.lastSyncUs = timeUs;
+      task_pll.seen = true;
+      return;
+   }
+   task_pll.syncPeriodUs = periodUs;
+
+   /* frequency, filtered tick period from SYNC period */
+   measNs = (periodUs * 1000U) / ticks;
+   if(task_pll.state == TASK_PLL_FREE)
+   {
+      task_pll.freqNs = measNs;
+      task_pll.state = TASK_PLL_TRACKING;
+   }
+   else
+   {
+      task_pll.freqNs += (uint32_t)(((int32_t)(measNs - task_pll.freqNs)) / 8);
+   }
+
+   /* phase, TIM6 update must be TASK_SYNC_PLL_OFFSET_US after SYNC edge,
+    * positive error is early update */
+   error = (int32_t)((phaseUs + TASK_SYNC_PLL_OFFSET_US) % task_pll.nominalUs);
+   if(error >= (int32_t)halfUs)
+   {
+      error -= (int32_t)task_pll.nominalUs;
+   }
+   task_pll.phaseErrorUs = error;
+
+   /* half of the phase error during the next SYNC period */
+   periodNs = (int32_t)task_pll.freqNs + (error * 1000) / (int32_t)(2U * ticks);
+   rangeNs = (int32_t)(task_pll.nominalUs * 1000U / TASK_PLL_RANGE);
+   if(periodNs > (int32_t)(task_pll.nominalUs * 1000U) + rangeNs)
+   {
+      periodNs = (int32_t)(task_pll.nominalUs * 1000U) + rangeNs;
+   }
+   else if(periodNs < (int32_t)(task_pll.nominalUs * 1000U) - rangeNs)
+   {
+      periodNs = (int32_t)(task_pll.nominalUs * 1000U) - rangeNs;
+   }
+   task_pll.periodNs = (uint32_t)periodNs;
+
+   if(error <= TASK_SYNC_PLL_LOCK_US && error >= -TASK_SYNC_PLL_LOCK_US)
+   {
+      if(task_pll.inLock < TASK_PLL_LOCK_COUNT)
+      {
+         task_pll.inLock++;
+      }
+      if(task_pll.inLock >= TASK_PLL_LOCK_COUNT)
+      {
+         task_pll.state = TASK_PLL_LOCKED;
+      }
+   }
+   else
+   {
+      if(task_pll.state == TASK_PLL_LOCKED)
+      {
+         task_pll.lockLosses++;
+      }
+      task_pll.inLock = 0U;
+      task_pll.state = TASK_PLL_TRACKING;
+   }
+}
+
+
+uint32_t task_pll_reload(void)
+{
+   uint32_t counts;
+
+   task_pll.fractionNs += task_pll.periodNs;
+   counts = task_pll.fractionNs / task_pll.nsPerCount;
+   task_pll.fractionNs -= counts * task_pll.nsPerCount;
+
+   return counts;
+}
+
+
+void task_pll_process(uint32_t timeUs)
+{
+   uint32_t primask;
+
+   if(task_pll.state == TASK_PLL_FREE)
+   {
+      return;
+   }
+
+   primask = __get_PRIMASK();
+   __disable_irq();
+   if((timeUs - task_pll.lastSyncUs) > (TASK_PLL_TIMEOUT * task_pll.syncPeriodUs + task_pll.nominalUs)
+      && (int32_t)(timeUs - task_pll.lastSyncUs) > 0)
+   {
+      task_pll_free();
+   }
+   __set_PRIMASK(primask);
+}
+
+
+task_pllState_t task_pll_state(void)
+{
+   return task_pll.state;
+}
@@ -0,0 +1,92 @@
+/*!*****************************************************************************
+ * \file        task_pll.h
+ *
+ * \brief
+ * SYNC locked TIM6 period, see TASK_SYNC_PLL.
+ *
+ * task_syncReceived() passes each received SYNC to task_pll_sync() with the
+ * TIM6 phase at the SYNC edge. SYNC period is measured from CAN receive
+ * timestamps (CO_CAN_TIMESTAMP) or from task_getTimeUs() and divided by the
+ * nearest whole number of ticks. This frequency is filtered and half of the
+ * phase error is added over the next SYNC period, so TIM6 update event (and
+ * task_oneMs()) follows the SYNC edge by TASK_SYNC_PLL_OFFSET_US. TIM6 counts
+ * are whole, so task_pll_reload() dithers the period between neighbouring
+ * counts. Period is limited to +-1 % of the nominal tick.
+ *
+ * SYNC period, which is not a multiple of the tick within 2 %, or SYNC
+ * timeout (two SYNC periods) return TIM6 to the nominal period. Produced SYNC
+ * is ignored.
+ *
+ * If OD contains UNSIGNED32 array 0x2148 (ODL_SYNCPLL_arrayLength), it is
+ * served by task_pll_init():
+ *  - 1: state, 0 free running, 1 tracking, 2 locked,
+ *  - 2: phase error at the last SYNC in microseconds (INTEGER32),
+ *  - 3: tick period in nanoseconds,
+ *  - 4: measured SYNC period in microseconds,
+ *  - 5: number of lost locks, writing any sub-index resets it.
+ ******************************************************************************/
+#ifndef SCHEDULER_TASK_PLL_H_
+#define SCHEDULER_TASK_PLL_H_
+
+/*-----------------------------------------------------------------------------
+ * INCLUDE FILES
+ *----------------------------------------------------------------------------*/
+#include "CANopen.h"
+#include "task.h"
+
+
+/*-----------------------------------------------------------------------------
+ * EXPORTED DEFINITIONS
+ *----------------------------------------------------------------------------*/
+/*\brief OD index of PLL state */
+#define TASK_PLL_OD_INDEX   0x2148U
+
+/*\brief state of the PLL */
+typedef enum
+{
+   TASK_PLL_FREE = 0,      /*!< nominal period, no SYNC */
+   TASK_PLL_TRACKING = 1,  /*!< period follows SYNC, phase error above TASK_SYNC_PLL_LOCK_US */
+   TASK_PLL_LOCKED = 2     /*!< phase error within TASK_SYNC_PLL_LOCK_US for 8 SYNCs */
+} task_pllState_t;
+
+
+/*-----------------------------------------------------------------------------
+ * EXPORTED FUNCTIONS
+ *----------------------------------------------------------------------------*/
+/*!*****************************************************************************
+ * \brief returns to the nominal period and serves OD object 0x2148.
+ * \details Must be called after each CO_init() with TIM6 update interrupt
+ * disabled.
+ * \param SDO SDO server object.
+ * \param nominalUs tick period without SYNC.
+ * \param nsPerCount TIM6 count in nanoseconds.
+ ******************************************************************************/
+void task_pll_init(CO_SDO_t *SDO, uint32_t nominalUs, uint32_t nsPerCount);
+
+/*!*****************************************************************************
+ * \brief passes SYNC edge, called from SYNC callback.
+ * \param SYNC SYNC object, its receive timestamp is used with CO_CAN_TIMESTAMP.
+ * \param timeUs task_getTimeUs() at the SYNC edge.
+ * \param phaseUs time since the last TIM6 update event at the SYNC edge.
+ ******************************************************************************/
+void task_pll_sync(const CO_SYNC_t *SYNC, uint32_t timeUs, uint32_t phaseUs);
+
+/*!*****************************************************************************
+ * \brief returns TIM6 counts of the started period.
+ * \details Called from TIM6 update interrupt, result minus one is written
+ * into ARR (no preload).
+ ******************************************************************************/
+uint32_t task_pll_reload(void);
+
+/*!*****************************************************************************
+ * \brief returns to the nominal period, if SYNC was lost.
+ * \param timeUs task_getTimeUs().
+ ******************************************************************************/
+void task_pll_process(uint32_t timeUs);
+
+/*!*****************************************************************************
+ * \brief returns state of the PLL.
+ ******************************************************************************/
+task_pllState_t task_pll_state(void);
+
+#endif /* SCHEDULER_TASK_PLL_H_ */
@@ -0,0 +1,127 @@
+/*!*****************************************************************************
+ * \file        task_tick.c
+ *
+ * \brief
+ * Execution time and start jitter of task_oneMs(). Worst case and histogram
+ * show, how much of the 1 ms budget is left for additional application load.
+ ******************************************************************************/
+
+/*-----------------------------------------------------------------------------
+ * INCLUDE SECTION
+ *----------------------------------------------------------------------------*/
+#include <string.h>
+#include "task_tick.h"
+#include "CO_OD.h"
+
+/*-----------------------------------------------------------------------------
+ * LOCAL (static) DEFINITIONS
+ *----------------------------------------------------------------------------*/
+/*\brief OD sub-indexes before the histogram */
+#define TASK_TICK_OD_VALUES   5U
+/*\brief width of one histogram bin in microseconds */
+#define TASK_TICK_BIN_US      (TASK_TICK_BUDGET_US / TASK_TICK_HIST_BINS)
+
+#if TASK_TICK_BIN_US == 0
+#error TASK_TICK_BUDGET_US must be at least TASK_TICK_HIST_BINS
+#endif
+
+static task_tickStat_t task_tickStat;
+
+
+/*-----------------------------------------------------------------------------
+ * LOCAL FUNCTION PROTOTYPES
+ *----------------------------------------------------------------------------*/
+#ifdef ODL_tickStatistics_arrayLength
+static CO_SDO_abortCode_t task_tickODF(CO_ODF_arg_t *ODF_arg);
+#endif
+
+
+/*-----------------------------------------------------------------------------
+ * LOCAL FUNCTIONS
+ *----------------------------------------------------------------------------*/
+#ifdef ODL_tickStatistics_arrayLength
+#if ODL_tickStatistics_arrayLength != (5 + TASK_TICK_HIST_BINS)
+#error OD 0x2145 must have 5 + TASK_TICK_HIST_BINS sub-indexes
+#endif
+
+/* \brief function for accessing _tick statistics_ (index 0x2145) from SDO server */
+static CO_SDO_abortCode_t task_tickODF(CO_ODF_arg_t *ODF_arg)
+{
+   uint8_t n = ODF_arg->subIndex;
+   uint32_t value;
+
+   if(n == 0U)
+   {
+      return CO_SDO_AB_NONE;
+   }
+
+   if(!ODF_arg->reading)
+   {
+      task_tick_reset();
+      return CO_SDO_AB_NONE;
+   }
+
+   switch(n)
+   {
+      case 1U:  value = task_tickStat.ticks;         break;
+      case 2U:  value = task_tickStat.overruns;      break;
+      case 3U:  value = task_tickStat.missed;        break;
+      case 4U:  value = task_tickStat.maxExecUs;     break;
+      case 5U:  value = task_tickStat.maxLatencyUs;  break;
+      default:  value = task_tickStat.hist[n - 1U - TASK_TICK_OD_VALUES];  break;
+   }
+   CO_setUint32(ODF_arg->data, value);
+
+   return CO_SDO_AB_NONE;
+}
+#endif
+
+
+/*-----------------------------------------------------------------------------
+ * GLOBAL FUNCTIONS
+ *----------------------------------------------------------------------------*/
+void task_tick_init(CO_SDO_t *SDO)
+{
+#ifdef ODL_tickStatistics_arrayLength
+   CO_OD_configure(SDO, TASK_TICK_OD_INDEX, task_tickODF, NULL, 0, 0U);
+#else
+   (void)SDO;
+#endif
+}
+
+
+bool_t task_tick_record(uint32_t latencyUs, uint32_t execUs, uint32_t missed)
+{
+   uint32_t bin = execUs / TASK_TICK_BIN_US;
+   bool_t overrun = (execUs > TASK_TICK_BUDGET_US) || (missed > 0U);
+
+   task_tickStat.ticks++;
+   task_tickStat.missed += missed;
+   if(overrun)
+   {
+      task_tickStat.overruns++;
+   }
+   if(execUs > task_tickStat.maxExecUs)
+   {
+      task_tickStat.maxExecUs = execUs;
+   }
+   if(latencyUs > task_tickStat.maxLatencyUs)
+   {
+      task_tickStat.maxLatencyUs = latencyUs;
+   }
+   task_tickStat.hist[(bin < TASK_TICK_HIST_BINS) ? bin : (TASK_TICK_HIST_BINS - 1U)]++;
+
+   return overrun;
+}
+
+
+void task_tick_get(task_tickStat_t *stat)
+{
+   *stat = task_tickStat;
+}
+
+
+void task_tick_reset(void)
+{
+   (void)memset(&task_tickStat, 0, sizeof(task_tickStat));
+}
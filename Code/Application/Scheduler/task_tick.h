@@ -0,0 +1,83 @@
+/*!*****************************************************************************
+ * \file        task_tick.h
+ *
+ * \brief
+ * Execution time and start jitter of task_oneMs(), see TASK_TICK_BUDGET_US.
+ *
+ * task_oneMs() passes each call to task_tick_record(): delay of its start
+ * after the TIM6 update event, its execution time and TIM6 periods, which
+ * elapsed without a call. Execution time is counted into a histogram of
+ * TASK_TICK_HIST_BINS bins of TASK_TICK_BUDGET_US / TASK_TICK_HIST_BINS
+ * microseconds, the last bin counts longer calls too.
+ *
+ * If OD contains UNSIGNED32 array 0x2145 (ODL_tickStatistics_arrayLength),
+ * it is served by task_tick_init():
+ *  - 1: recorded calls,
+ *  - 2: overruns, calls above budget or with missed TIM6 periods,
+ *  - 3: missed TIM6 periods,
+ *  - 4: worst execution time in microseconds,
+ *  - 5: worst start delay after TIM6 update in microseconds,
+ *  - 6 and up: execution time histogram.
+ * Writing any sub-index resets statistics.
+ *
+ * Statistics are written and served in mainline only, SDO server runs from
+ * task_oneMs() too, so no locking is needed.
+ ******************************************************************************/
+#ifndef SCHEDULER_TASK_TICK_H_
+#define SCHEDULER_TASK_TICK_H_
+
+/*-----------------------------------------------------------------------------
+ * INCLUDE FILES
+ *----------------------------------------------------------------------------*/
+#include "CANopen.h"
+#include "task.h"
+
+
+/*-----------------------------------------------------------------------------
+ * EXPORTED DEFINITIONS
+ *----------------------------------------------------------------------------*/
+/*\brief OD index of tick statistics */
+#define TASK_TICK_OD_INDEX   0x2145U
+
+/*\brief statistics of task_oneMs() calls */
+typedef struct
+{
+   uint32_t ticks;
+   uint32_t overruns;
+   uint32_t missed;
+   uint32_t maxExecUs;
+   uint32_t maxLatencyUs;
+   uint32_t hist[TASK_TICK_HIST_BINS];
+} task_tickStat_t;
+
+
+/*-----------------------------------------------------------------------------
+ * EXPORTED FUNCTIONS
+ *----------------------------------------------------------------------------*/
+/*!*****************************************************************************
+ * \brief serves OD object 0x2145.
+ * \details Must be called after each CO_init(), statistics are kept.
+ * \param SDO SDO server object.
+ ******************************************************************************/
+void task_tick_init(CO_SDO_t *SDO);
+
+/*!*****************************************************************************
+ * \brief records one task_oneMs() call.
+ * \param latencyUs start of the call after the TIM6 update event.
+ * \param execUs execution time of the call.
+ * \param missed TIM6 periods elapsed since the previous call without a call.
+ * \return true, if the call is an overrun.
+ ******************************************************************************/
+bool_t task_tick_record(uint32_t latencyUs, uint32_t execUs, uint32_t missed);
+
+/*!*****************************************************************************
+ * \brief copies statistics into _stat_.
+ ******************************************************************************/
+void task_tick_get(task_tickStat_t *stat);
+
+/*!*****************************************************************************
+ * \brief resets statistics.
+ ******************************************************************************/
+void task_tick_reset(void);
+
+#endif /* SCHEDULER_TASK_TICK_H_ */
@@ -0,0 +1,591 @@
+/*
+ * Compressed device description for object 0x1021, see CO_EDS.h.
+ *
+ * This file was automatically generated from IO.eds by tools/edszip.py.
+ * DON'T EDIT THIS FILE MANUALLY !!!!
+ */
+
+
+#include "CO_EDS.h"
+
+#if CO_EDS_STORE > 0
+
+/* 68782 bytes, 9140 bytes compressed */
+const uint8_t CO_EDS_image[] = {
+    0x45, 0x5A, 0x01, 0x0A, 0xAE, 0x0C, 0x01, 0x00, 0xFF, 0x0A, 0x3B, 0x20, 0x43, 0x41, 0x4E, 0x6F,
+    0x70, 0xFF, 0x65, 0x6E, 0x20, 0x45, 0x6C, 0x65, 0x63, 0x74, 0xFF, 0x72, 0x6F, 0x6E, 0x69, 0x63,
+    0x20, 0x44, 0x61, 0xFF, 0x74, 0x61, 0x20, 0x53, 0x68, 0x65, 0x65, 0x74, 0xFE, 0x1F, 0x00, 0x46,
+    0x69, 0x6C, 0x65, 0x20, 0x77, 0x61, 0xFF, 0x73, 0x20, 0x61, 0x75, 0x74, 0x6F, 0x6D, 0x61, 0xFF,
+    0x74, 0x69, 0x63, 0x61, 0x6C, 0x6C, 0x79, 0x20, 0xFF, 0x67, 0x65, 0x6E, 0x65, 0x72, 0x61, 0x74,
+    0x65, 0xEF, 0x64, 0x20, 0x62, 0x79, 0x43, 0x50, 0x4E, 0x6F, 0x64, 0xDF, 0x65, 0x20, 0x4F, 0x62,
+    0x6A, 0x48, 0x00, 0x20, 0x44, 0xFF, 0x69, 0x63, 0x74, 0x69, 0x6F, 0x6E, 0x61, 0x72, 0xFF, 0x79,
+    0x20, 0x45, 0x64, 0x69, 0x74, 0x6F, 0x72, 0xFE, 0x4A, 0x00, 0x53, 0x65, 0x65, 0x20, 0x68, 0x74,
+    0x74, 0x7F, 0x70, 0x3A, 0x2F, 0x2F, 0x63, 0x61, 0x6E, 0x31, 0x10, 0xFD, 0x6E, 0x31, 0x00, 0x2E,
+    0x73, 0x6F, 0x75, 0x72, 0x63, 0xFF, 0x65, 0x66, 0x6F, 0x72, 0x67, 0x65, 0x2E, 0x6E, 0x7F, 0x65,
+    0x74, 0x2F, 0x0A, 0x0A, 0x0A, 0x5B, 0x75, 0x10, 0xBF, 0x49, 0x6E, 0x66, 0x6F, 0x5D, 0x0A, 0x09,
+    0x10, 0x4E, 0xFF, 0x61, 0x6D, 0x65, 0x3D, 0x49, 0x4F, 0x20, 0x45, 0xBF, 0x78, 0x61, 0x6D, 0x70,
+    0x6C, 0x65, 0x13, 0x20, 0x56, 0xB7, 0x65, 0x72, 0x73, 0x60, 0x00, 0x3D, 0x2D, 0x0D, 0x20, 0x52,
+    0xF7, 0x65, 0x76, 0x69, 0x0E, 0x20, 0x30, 0x0A, 0x45, 0x44, 0xFD, 0x53, 0x1B, 0x50, 0x34, 0x2E,
+    0x30, 0x0A, 0x44, 0x65, 0xDF, 0x73, 0x63, 0x72, 0x69, 0x70, 0x8C, 0x10, 0x3D, 0x4F, 0xD2, 0xE8,
+    0x10, 0x53, 0x6E, 0x20, 0xF7, 0x60, 0x69, 0x51, 0x10, 0x6D, 0x65, 0xFB, 0x6E, 0x74, 0xDA, 0x00,
+    0x6F, 0x6E, 0x0A, 0x43, 0x72, 0xED, 0x65, 0x08, 0x20, 0x54, 0x69, 0x72, 0x00, 0x31, 0x37, 0x3A,
+    0x9F, 0x32, 0x34, 0x3A, 0x34, 0x33, 0x15, 0x60, 0x19, 0x01, 0x65, 0xFF, 0x3D, 0x32, 0x30, 0x31,
+    0x36, 0x2D, 0x30, 0x33, 0xF7, 0x2D, 0x32, 0x35, 0x17, 0x30, 0x65, 0x64, 0x42, 0x79, 0x57, 0x3D,
+    0x4A, 0x50, 0xB6, 0x10, 0x44, 0x86, 0x00, 0x63, 0xB8, 0x40, 0x3F, 0x56, 0x65, 0x6E, 0x64, 0x6F,
+    0x72, 0xBA, 0x20, 0x1F, 0x81, 0xBE, 0x16, 0x50, 0x75, 0x6D, 0x62, 0x65, 0x72, 0xAD, 0x00, 0x50,
+    0x3F, 0x72, 0x6F, 0x64, 0x75, 0x63, 0x74, 0x26, 0xE0, 0x17, 0x50, 0xF8, 0x27, 0x50, 0xE0, 0x50,
+    0x10, 0x60, 0x4F, 0x72, 0x64, 0x65, 0x72, 0xF9, 0x43, 0x2A, 0x00, 0x0B, 0x00, 0x42, 0x61, 0x75,
+    0x64, 0x52, 0xBE, 0x88, 0x00, 0x5F, 0x31, 0x30, 0x3D, 0x31, 0x0D, 0x70, 0x32, 0x3A, 0x0D, 0xA0,
+    0x35, 0x0D, 0xA0, 0x31, 0x32, 0x35, 0x2A, 0xA0, 0x1D, 0xB0, 0x6B, 0x35, 0x30, 0x0E, 0xA0, 0x38,
+    0x0E, 0xB0, 0x31, 0x30, 0x0F, 0x20, 0xFD, 0x53, 0x3A, 0x21, 0x42, 0x6F, 0x6F, 0x74, 0x55, 0x70,
+    0xCF, 0x4D, 0x61, 0x73, 0x74, 0x96, 0x20, 0x14, 0x90, 0x53, 0x6C, 0xFB, 0x61, 0x76, 0x44, 0x01,
+    0x0A, 0x47, 0x72, 0x61, 0x6E, 0xFF, 0x75, 0x6C, 0x61, 0x72, 0x69, 0x74, 0x79, 0x3D, 0xFF, 0x38,
+    0x0A, 0x44, 0x79, 0x6E, 0x61, 0x6D, 0x69, 0xFF, 0x63, 0x43, 0x68, 0x61, 0x6E, 0x6E, 0x65, 0x6C,
+    0x7F, 0x73, 0x53, 0x75, 0x70, 0x70, 0x6F, 0x72, 0x44, 0x01, 0xFE, 0x3C, 0x00, 0x47, 0x72, 0x6F,
+    0x75, 0x70, 0x4D, 0x65, 0x7F, 0x73, 0x73, 0x61, 0x67, 0x69, 0x6E, 0x67, 0x10, 0x00, 0xFF, 0x4E,
+    0x72, 0x4F, 0x66, 0x52, 0x58, 0x50, 0x44, 0xD7, 0x4F, 0x3D, 0x34, 0x0B, 0x20, 0x54, 0x0B, 0x40,
+    0x4C, 0x53, 0x73, 0x53, 0x5F, 0x38, 0x90, 0x7A, 0x01, 0x43, 0x6F, 0x6D, 0xC5, 0x11, 0xFF, 0x73,
+    0x5D, 0x0A, 0x4C, 0x69, 0x6E, 0x65, 0x73, 0x1B, 0x3D, 0x35, 0x07, 0x20, 0x31, 0x3D, 0x0E, 0x02,
+    0xC3, 0x32, 0x60, 0x02, 0x92, 0xF4, 0x61, 0x64, 0xA7, 0x21, 0x21, 0x20, 0x32, 0x15, 0xF2, 0x12,
+    0x28, 0x10, 0x33, 0x7F, 0x3D, 0x53, 0x74, 0x61, 0x63, 0x6B, 0x20, 0x5C, 0x42, 0x7F, 0x3A, 0x20,
+    0x56, 0x33, 0x2E, 0x30, 0x30, 0x1A, 0x20, 0xD7, 0x34, 0x3D, 0x47, 0x0E, 0xF3, 0x1F, 0x6C, 0x37,
+    0x00, 0x35, 0x3D, 0x7E, 0x0E, 0xF3, 0x15, 0x44, 0x75, 0x6D, 0x6D, 0x79, 0x55, 0x16, 0x01, 0x27,
+    0x65, 0x5D, 0x0A, 0x0B, 0x20, 0x81, 0x01, 0x31, 0xF7, 0x00, 0x0B, 0x50, 0x29, 0x32, 0x65, 0x01,
+    0x0B, 0x50, 0x33, 0x0B, 0x80, 0x34, 0x0B, 0x80, 0xEF, 0x11, 0xCA, 0x0B, 0x50, 0x36, 0x0B, 0x80,
+    0x37, 0x0B, 0x00, 0x62, 0x00, 0x4D, 0x61, 0x17, 0x6E, 0x64, 0x61, 0x98, 0x00, 0x79, 0xB1, 0x30,
+    0x47, 0x01, 0x60, 0x61, 0xAE, 0x11, 0x40, 0x3D, 0x33, 0x0A, 0x73, 0x00, 0x78, 0xFD, 0x11, 0x0A,
+    0xDD, 0x32, 0x08, 0x30, 0x31, 0x0A, 0x33, 0x08, 0x20, 0x31, 0x38, 0xDA, 0x42, 0x10, 0x4F, 0x65,
+    0x23, 0x61, 0x6C, 0x41, 0xF0, 0x08, 0x34, 0x39, 0xEA, 0x42, 0x50, 0x32, 0x42, 0x50, 0x33, 0x42,
+    0x40, 0x30, 0x35, 0x0A, 0xDD, 0x34, 0x08, 0x30, 0x36, 0x0A, 0x35, 0x08, 0x30, 0x37, 0x0A, 0xDD,
+    0x36, 0x08, 0x30, 0x38, 0x0A, 0x37, 0x08, 0x30, 0x39, 0x0A, 0xDD, 0x38, 0x08, 0x30, 0x41, 0x0A,
+    0x39, 0x78, 0x30, 0x30, 0x0A, 0xDC, 0xF3, 0x02, 0x09, 0x20, 0x31, 0x0A, 0x31, 0x5B, 0x30, 0x31,
+    0x32, 0xCB, 0x0A, 0x31, 0x5C, 0x30, 0x31, 0xB1, 0x00, 0xA0, 0x40, 0x34, 0x0A, 0xBD, 0x31, 0x5E,
+    0x30, 0x31, 0x35, 0x0A, 0x31, 0x5F, 0x30, 0x31, 0xF7, 0x36, 0x0A, 0x31, 0x60, 0x30, 0x31, 0x37,
+    0x0A, 0x31, 0x92, 0x61, 0x30, 0x31, 0xA0, 0x00, 0x62, 0x30, 0x32, 0x4F, 0x00, 0x63, 0x30, 0x32,
+    0xBC, 0xAB, 0x00, 0x63, 0x30, 0x32, 0x39, 0x0A, 0x32, 0x63, 0x20, 0x32, 0xA4, 0x02, 0x11, 0x63,
+    0x20, 0x34, 0x09, 0x10, 0x63, 0x20, 0x34, 0x0D, 0x01, 0x32, 0x52, 0x63, 0x20, 0x34, 0xDD, 0x10,
+    0x63, 0x20, 0x34, 0xDE, 0x00, 0x32, 0x63, 0x20, 0x49, 0x36, 0x27, 0x10, 0x63, 0x20, 0x36, 0x27,
+    0x10, 0x63, 0x20, 0x36, 0x27, 0x10, 0x62, 0x63, 0x20, 0x36, 0x06, 0x11, 0x63, 0x20, 0x6A, 0x03,
+    0x0A, 0x33, 0x63, 0x20, 0xA9, 0x38, 0x5D, 0x11, 0x63, 0x20, 0x38, 0x27, 0x00, 0x33, 0x63, 0x20,
+    0x38, 0x24, 0x27, 0x10, 0x63, 0x20, 0x41, 0x27, 0x10, 0x63, 0x20, 0x41, 0x27, 0x10, 0x63, 0x20,
+    0x49, 0x41, 0x27, 0x10, 0x63, 0x20, 0x41, 0x27, 0x10, 0x63, 0x20, 0x46, 0xBD, 0x00, 0x7D, 0x33,
+    0x63, 0x20, 0x46, 0x35, 0x30, 0x0A, 0x34, 0x63, 0x20, 0xDF, 0x46, 0x35, 0x31, 0x0A, 0x34, 0x63,
+    0x20, 0x46, 0x35, 0xF7, 0x36, 0x0A, 0x34, 0x63, 0x20, 0x46, 0x35, 0x37, 0x0A, 0xCD, 0x34, 0x63,
+    0x20, 0x46, 0x38, 0x27, 0x00, 0x63, 0x20, 0x46, 0x41, 0x0C, 0x09, 0x00, 0x63, 0x20, 0x46, 0x44,
+    0x09, 0x00, 0x63, 0x10, 0xC6, 0x00, 0x09, 0x00, 0xAA, 0x63, 0x10, 0x36, 0x03, 0x11, 0x34, 0x63,
+    0x10, 0x36, 0xF9, 0x10, 0x34, 0xE6, 0x63, 0x10, 0x36, 0x34, 0x85, 0x01, 0x4B, 0x32, 0x75, 0x66,
+    0x61, 0x3F, 0x63, 0x74, 0x75, 0x72, 0x65, 0x72, 0x4E, 0xF2, 0x09, 0xA7, 0x01, 0x82, 0x34, 0x00,
+    0x32, 0xCE, 0x01, 0x0C, 0x22, 0x08, 0x00, 0x4F, 0x32, 0x08, 0x00, 0x32, 0x24, 0x0C, 0x22, 0x08,
+    0x00, 0x33, 0x0C, 0x22, 0x08, 0x00, 0x34, 0x0C, 0x22, 0x08, 0x00, 0x49, 0x36, 0x0C, 0x22, 0x08,
+    0x00, 0x37, 0x0C, 0x22, 0x08, 0x00, 0x38, 0x0C, 0x22, 0x18, 0x08, 0x00, 0xBC, 0x01, 0xE0, 0x10,
+    0x32, 0x31, 0x16, 0x12, 0x5B, 0x30, 0x16, 0x12, 0x48, 0x5C, 0x30, 0x16, 0x12, 0x5D, 0x30, 0x32,
+    0x1D, 0x00, 0x5E, 0x30, 0x33, 0x09, 0x00, 0x92, 0x5F, 0x30, 0x34, 0x09, 0x00, 0x60, 0x30, 0x34,
+    0x31, 0x00, 0x61, 0x30, 0x34, 0x64, 0x31, 0x00, 0x62, 0x30, 0x34, 0x48, 0x02, 0x63, 0x30, 0x34,
+    0x34, 0x0C, 0x32, 0x92, 0x09, 0x00, 0x35, 0x0C, 0x32, 0x09, 0x00, 0x36, 0x0C, 0x32, 0x09, 0x00,
+    0x37, 0x84, 0x0C, 0x32, 0x09, 0x00, 0x38, 0x0C, 0x32, 0x09, 0x00, 0x34, 0x02, 0x63, 0x40, 0x41,
+    0xA4, 0x0C, 0x32, 0x09, 0x00, 0x42, 0x0C, 0x32, 0x09, 0x00, 0x43, 0x0C, 0x32, 0x32, 0x09, 0x33,
+    0x16, 0x12, 0x63, 0x20, 0x33, 0xC6, 0x11, 0x63, 0x20, 0x5C, 0x12, 0x0C, 0x22, 0xC8, 0x09, 0x00,
+    0x0C, 0x42, 0x09, 0x00, 0x32, 0x61, 0x01, 0x84, 0x13, 0x5D, 0x0A, 0xFF, 0x50, 0x61, 0x72, 0x61,
+    0x6D, 0x65, 0x74, 0x65, 0xFB, 0x72, 0x4E, 0x06, 0x00, 0x3D, 0x44, 0x65, 0x76, 0x69, 0xFF, 0x63,
+    0x65, 0x20, 0x74, 0x79, 0x70, 0x65, 0x0A, 0xFA, 0x63, 0x31, 0x54, 0x0A, 0x00, 0x3D, 0x37, 0x0A,
+    0x44, 0x61, 0xDB, 0x74, 0x61, 0x0A, 0x20, 0x30, 0x78, 0xEF, 0x13, 0x0A, 0x41, 0xDF, 0x63, 0x63,
+    0x65, 0x73, 0x73, 0x11, 0x20, 0x72, 0x6F, 0xFF, 0x0A, 0x50, 0x44, 0x4F, 0x4D, 0x61, 0x70, 0x70,
+    0xFF, 0x69, 0x6E, 0x67, 0x3D, 0x30, 0x0A, 0x44, 0x65, 0xFF, 0x66, 0x61, 0x75, 0x6C, 0x74, 0x56,
+    0x61, 0x6C, 0xD1, 0x75, 0x2E, 0x40, 0x00, 0x20, 0x71, 0x30, 0x31, 0x71, 0xD0, 0x45, 0x72, 0xFF,
+    0x72, 0x6F, 0x72, 0x20, 0x72, 0x65, 0x67, 0x69, 0x29, 0x73, 0x12, 0x00, 0x74, 0xF0, 0x0A, 0x35,
+    0x74, 0xF0, 0x08, 0x31, 0x74, 0xC0, 0x6B, 0x30, 0xF9, 0x32, 0x6B, 0xD0, 0x53, 0x92, 0x20, 0x73,
+    0x74, 0x61, 0x74, 0xA3, 0x75, 0x73, 0x79, 0xF0, 0x13, 0xEE, 0xF0, 0x09, 0x79, 0xF0, 0x04, 0x33,
+    0x79, 0xD0, 0x50, 0xFF, 0x72, 0x65, 0x2D, 0x64, 0x65, 0x66, 0x69, 0x6E, 0xEF, 0x65, 0x64, 0x20,
+    0x65, 0xF1, 0x20, 0x66, 0x69, 0x65, 0xEB, 0x6C, 0x64, 0x74, 0x90, 0x38, 0xDD, 0x02, 0x62, 0x4E,
+    0x75, 0xBF, 0x6D, 0x62, 0x65, 0x72, 0x3D, 0x39, 0x46, 0x40, 0x73, 0x73, 0x75, 0x62, 0xA2, 0xE1,
+    0x22, 0x30, 0x20, 0x6F, 0x66, 0x48, 0x30, 0xC5, 0x73, 0x32, 0xF1, 0x18, 0x77, 0xA7, 0xF1, 0x0A,
+    0x71, 0x70, 0xA2, 0xE1, 0x53, 0x74, 0x1F, 0x61, 0x6E, 0x64, 0x61, 0x72, 0xB9, 0xF0, 0x07, 0x1D,
+    0xF2, 0x29, 0x75, 0x70, 0x50, 0xAC, 0xE1, 0x75, 0xF0, 0x53, 0xA8, 0xE1, 0x75, 0xF0, 0x53, 0x34,
+    0x75, 0xF0, 0x63, 0x35, 0x75, 0xF0, 0x63, 0x95, 0x36, 0x75, 0xF0, 0x63, 0x37, 0x75, 0xF0, 0x63,
+    0x38, 0x75, 0xF0, 0x5F, 0xD3, 0xE1, 0x43, 0xFF, 0x4F, 0x42, 0x2D, 0x49, 0x44, 0x20, 0x53, 0x59,
+    0xEF, 0x4E, 0x43, 0x20, 0x6D, 0x49, 0x00, 0x61, 0x67, 0x65, 0x22, 0x70, 0xF0, 0x18, 0x77, 0x70,
+    0xF0, 0x0A, 0x2E, 0x10, 0x00, 0x00, 0x38, 0x79, 0x40, 0xD7, 0xE1, 0xFF, 0x43, 0x6F, 0x6D, 0x6D,
+    0x75, 0x6E, 0x69, 0x63, 0xFF, 0x61, 0x74, 0x69, 0x6F, 0x6E, 0x20, 0x63, 0x79, 0xFF, 0x63, 0x6C,
+    0x65, 0x20, 0x70, 0x65, 0x72, 0x69, 0xE1, 0x6F, 0xF1, 0xF0, 0x19, 0x80, 0xF0, 0x0B, 0x77, 0x30,
+    0xD9, 0xF1, 0x00, 0x79, 0x6E, 0x63, 0xFF, 0x68, 0x72, 0x6F, 0x6E, 0x6F, 0x75, 0x73, 0x20, 0xFF,
+    0x77, 0x69, 0x6E, 0x64, 0x6F, 0x77, 0x20, 0x6C, 0x9F, 0x65, 0x6E, 0x67, 0x74, 0x68, 0x76, 0xF0,
+    0x3B, 0xDA, 0xE1, 0x4D, 0xFF, 0x61, 0x6E, 0x75, 0x66, 0x61, 0x63, 0x74, 0x75, 0xFF, 0x72, 0x65,
+    0x72, 0x20, 0x64, 0x65, 0x76, 0x69, 0x4F, 0x63, 0x65, 0x20, 0x6E, 0x18, 0x00, 0x75, 0xF0, 0x0A,
+    0x39, 0x75, 0x90, 0xDF, 0x63, 0x6F, 0x6E, 0x73, 0x74, 0x78, 0xF0, 0x09, 0x43, 0x41, 0xFF, 0x4E,
+    0x6F, 0x70, 0x65, 0x6E, 0x4E, 0x6F, 0x64, 0xD5, 0x65, 0x82, 0x30, 0x39, 0x82, 0xF0, 0x0B, 0x68,
+    0x66, 0x02, 0x77, 0x61, 0x7F, 0x72, 0x65, 0x20, 0x76, 0x65, 0x72, 0x73, 0x81, 0x01, 0xAE, 0x87,
+    0xF0, 0x37, 0x33, 0x2E, 0x30, 0x03, 0x41, 0x41, 0x80, 0xF0, 0x0B, 0x73, 0xB7, 0x6F, 0x66, 0x74,
+    0x80, 0xF0, 0x4C, 0x31, 0x30, 0x5F, 0xF3, 0x00, 0x6F, 0xEA, 0x70, 0x00, 0x70, 0x13, 0x50, 0x73,
+    0x73, 0x90, 0x38, 0x0A, 0x53, 0xFF, 0x75, 0x62, 0x4E, 0x75, 0x6D, 0x62, 0x65, 0x72, 0xE3, 0x3D,
+    0x32, 0x3F, 0x40, 0xA3, 0x03, 0x43, 0xE0, 0x6D, 0x61, 0x78, 0xB5, 0x20, 0x17, 0x00, 0x2D, 0x3A,
+    0x02, 0x65, 0x78, 0xB4, 0xF0, 0x0A, 0x35, 0xEA, 0x9C, 0xF3, 0x17, 0x31, 0x6E, 0x70, 0x31, 0x6E,
+    0xD0, 0x73, 0x61, 0x76, 0x9F, 0x65, 0x20, 0x61, 0x6C, 0x6C, 0xB5, 0xF0, 0x05, 0xA0, 0xF3, 0x30,
+    0x30, 0xB9, 0x33, 0x7D, 0x30, 0x79, 0xE0, 0x52, 0x65, 0x73, 0x2E, 0x21, 0x64, 0x44, 0x35, 0x30,
+    0x36, 0xF1, 0x18, 0x31, 0x36, 0xF1, 0x5C, 0x6E, 0x10, 0xBC, 0xE0, 0x72, 0xBC, 0x40, 0xD0, 0x39,
+    0x11, 0xC0, 0xF0, 0x0C, 0x41, 0xF1, 0x31, 0x88, 0x40, 0x32, 0x84, 0xD0, 0x43, 0x4F, 0xFF, 0x42,
+    0x2D, 0x49, 0x44, 0x20, 0x74, 0x69, 0x6D, 0x7F, 0x65, 0x20, 0x73, 0x74, 0x61, 0x6D, 0x70, 0x77,
+    0xF0, 0x36, 0xE9, 0x38, 0x75, 0x20, 0xE6, 0x52, 0x33, 0x77, 0xD0, 0x48, 0x69, 0x67, 0x7B, 0x68,
+    0x20, 0x01, 0x01, 0x6F, 0x6C, 0x75, 0x74, 0x59, 0x03, 0xA4, 0x80, 0xF0, 0x23, 0x78, 0xA1, 0x31,
+    0x80, 0xC0, 0x77, 0x30, 0x34, 0xEF, 0xF0, 0x05, 0x45, 0xE7, 0x4D, 0x43, 0x59, 0x68, 0xF0, 0x25,
+    0xE9, 0xC0, 0x24, 0x4E, 0x4F, 0x9F, 0x44, 0x45, 0x49, 0x44, 0x2B, 0xF1, 0x10, 0x73, 0x30, 0x35,
+    0xFE, 0x73, 0xD0, 0x69, 0x6E, 0x68, 0x69, 0x62, 0x69, 0x74, 0xA4, 0xE3, 0x30, 0x79, 0xF0, 0x0E,
+    0x36, 0x63, 0xF1, 0x17, 0x5C, 0x61, 0x36, 0xE4, 0xE0, 0x6F, 0xFF, 0x6E, 0x73, 0x75, 0x6D, 0x65,
+    0x72, 0x20, 0x68, 0x7F, 0x65, 0x61, 0x72, 0x74, 0x62, 0x65, 0x61, 0x7B, 0x30, 0x12, 0x13, 0xF3,
+    0x06, 0x35, 0x46, 0x40, 0x13, 0xF3, 0x55, 0x34, 0x6E, 0x70, 0x13, 0xE3, 0xB9, 0xF0, 0x11, 0x00,
+    0x0C, 0xF3, 0x31, 0x37, 0x51, 0x81, 0x00, 0x10, 0xF3, 0x00, 0x81, 0xF0, 0x5E, 0x1A, 0xE3, 0x81,
+    0xF0, 0x5F, 0x24, 0xF3, 0x00, 0xFA, 0x81, 0xF0, 0x5A, 0x37, 0x7D, 0xD0, 0x50, 0x72, 0x6F, 0x64,
+    0x75, 0xD1, 0x63, 0x7D, 0xF0, 0x1B, 0x34, 0xF3, 0x1B, 0x77, 0x40, 0x38, 0x77, 0xD0, 0x49, 0x64,
+    0xBF, 0x65, 0x6E, 0x74, 0x69, 0x74, 0x79, 0x68, 0x90, 0x39, 0xE2, 0x26, 0xF3, 0x00, 0x38, 0x26,
+    0xF3, 0x5C, 0x6E, 0x10, 0x26, 0xE3, 0x56, 0x65, 0x6E, 0x3F, 0x64, 0x6F, 0x72, 0x2D, 0x49, 0x44,
+    0x92, 0xF1, 0x18, 0x6A, 0xF0, 0x0A, 0xF0, 0x92, 0xD1, 0x73, 0x10, 0x18, 0xE3, 0x96, 0x31, 0x74,
+    0x20, 0x63, 0x6F, 0xF1, 0x64, 0x09, 0xF2, 0x19, 0x76, 0xF0, 0x1E, 0x0D, 0xE3, 0x52, 0x65, 0x76,
+    0x69, 0x3F, 0x73, 0x69, 0x6F, 0x6E, 0x20, 0x6E, 0x85, 0x21, 0x79, 0xF0, 0x48, 0x7E, 0x05, 0xE3,
+    0x53, 0x65, 0x72, 0x69, 0x61, 0x6C, 0x77, 0xF0, 0x4B, 0xFD, 0x39, 0x73, 0xE0, 0x79, 0x6E, 0x63,
+    0x68, 0x72, 0x6F, 0x6F, 0x6E, 0x6F, 0x75, 0x73, 0x68, 0x01, 0x75, 0x6E, 0x17, 0x00, 0xFF, 0x20,
+    0x6F, 0x76, 0x65, 0x72, 0x66, 0x6C, 0x6F, 0x87, 0x77, 0x20, 0x76, 0x43, 0x10, 0x5C, 0xF2, 0x18,
+    0x84, 0xF3, 0x0B, 0x7F, 0x20, 0x32, 0xFE, 0x58, 0xE2, 0x53, 0x74, 0x6F, 0x72, 0x65, 0x20, 0x45,
+    0x0B, 0x44, 0x53, 0x66, 0xF0, 0x0A, 0x46, 0xEF, 0xF0, 0x0A, 0x57, 0x20, 0x3C, 0xE2, 0x57, 0x10,
+    0xFF, 0x61, 0x67, 0x65, 0x20, 0x66, 0x6F, 0x72, 0x6D, 0xE3, 0x61, 0x74, 0x20, 0xF3, 0x34, 0x6B,
+    0x40, 0x43, 0xE1, 0x45, 0x72, 0x72, 0xFF, 0x6F, 0x72, 0x20, 0x62, 0x65, 0x68, 0x61, 0x76, 0x2B,
+    0x69, 0x6F, 0xB8, 0xA1, 0x38, 0xCD, 0x83, 0x37, 0x3D, 0x40, 0xCD, 0xF3, 0x55, 0xF9, 0x36, 0x6E,
+    0x70, 0x74, 0xE1, 0x43, 0x6F, 0x6D, 0x6D, 0x75, 0x1F, 0x6E, 0x69, 0x63, 0x61, 0x74, 0xE7, 0x02,
+    0xDF, 0xF1, 0x35, 0x2E, 0x00, 0x78, 0x71, 0x70, 0x8E, 0xE1, 0x71, 0xA0, 0x20, 0x6F, 0x74, 0x68,
+    0xE0, 0xF2, 0x0C, 0xF8, 0x77, 0xF0, 0x26, 0xCC, 0xE3, 0x77, 0xB0, 0x70, 0x61, 0x73, 0x73, 0x69,
+    0x9D, 0x76, 0xD1, 0xF2, 0x36, 0x78, 0x30, 0x31, 0x79, 0x70, 0xCC, 0xE3, 0x47, 0xAB, 0x65, 0x6E,
+    0xCE, 0x03, 0x63, 0xE5, 0xF0, 0x42, 0x35, 0x6B, 0xD0, 0x44, 0xFF, 0x65, 0x76, 0x69, 0x63, 0x65,
+    0x20, 0x70, 0x72, 0x4F, 0x6F, 0x66, 0x69, 0x6C, 0xDE, 0xF0, 0x38, 0x72, 0x80, 0x36, 0x72, 0xD0,
+    0xFF, 0x4D, 0x61, 0x6E, 0x75, 0x66, 0x61, 0x63, 0x74, 0xFF, 0x75, 0x72, 0x65, 0x72, 0x20, 0x73,
+    0x70, 0x65, 0xB7, 0x63, 0x69, 0x66, 0xEC, 0xF0, 0x3E, 0x32, 0x30, 0x27, 0xE3, 0x53, 0x7F, 0x44,
+    0x4F, 0x20, 0x73, 0x65, 0x72, 0x76, 0x73, 0x00, 0x29, 0x70, 0x18, 0x50, 0x74, 0x90, 0x39, 0x6F,
+    0x83, 0x33, 0x43, 0x40, 0x6F, 0xF3, 0x55, 0xF9, 0x32, 0x6E, 0x70, 0x6F, 0xF3, 0x00, 0x4F, 0x42,
+    0x2D, 0x49, 0x44, 0xFF, 0x20, 0x63, 0x6C, 0x69, 0x65, 0x6E, 0x74, 0x20, 0xD3, 0x74, 0x6F, 0xC3,
+    0x40, 0x78, 0xF0, 0x0A, 0x37, 0x78, 0xF0, 0x17, 0x24, 0x4E, 0xFF, 0x4F, 0x44, 0x45, 0x49, 0x44,
+    0x2B, 0x30, 0x78, 0x01, 0x36, 0x37, 0x61, 0x82, 0xF3, 0x03, 0x84, 0x30, 0x3E, 0x41, 0x84, 0x00,
+    0x8E, 0x30, 0x84, 0xF0, 0x3E, 0xAB, 0x35, 0x38, 0x84, 0x20, 0x34, 0xBC, 0xF1, 0x00, 0x52, 0x3E,
+    0x00, 0x20, 0x81, 0x63, 0x90, 0xC3, 0xC4, 0xF1, 0x12, 0x4B, 0x00, 0xC4, 0xF1, 0x5A, 0x6E, 0x30,
+    0xC4, 0xF1, 0x06, 0x75, 0x7F, 0x73, 0x65, 0x64, 0x20, 0x62, 0x79, 0x20, 0xCD, 0x10, 0xC0, 0x3B,
+    0xF1, 0x18, 0xEF, 0xF2, 0x0A, 0x3B, 0x71, 0xB9, 0x01, 0x80, 0x70, 0xC0, 0xE1, 0x74, 0x72, 0x7F,
+    0x61, 0x6E, 0x73, 0x6D, 0x69, 0x73, 0x73, 0x39, 0x11, 0x39, 0x74, 0x56, 0x00, 0x6E, 0xF3, 0x34,
+    0x32, 0x35, 0x35, 0x74, 0x30, 0xF1, 0xE0, 0x22, 0xB0, 0xF1, 0x29, 0x31, 0xB0, 0xF1, 0x5C, 0x6E,
+    0x10, 0xB0, 0xF1, 0x62, 0x33, 0xB0, 0x51, 0x80, 0x10, 0x22, 0xB0, 0xF1, 0x58, 0x34, 0x74, 0x30,
+    0x70, 0xE0, 0xB0, 0xF1, 0x29, 0x32, 0xB0, 0xF1, 0x5C, 0x6E, 0x10, 0x50, 0xB0, 0xF1, 0x62, 0x5A,
+    0x03, 0x80, 0x70, 0xB0, 0xF1, 0x5F, 0x33, 0xB0, 0xF1, 0x39, 0x33, 0xB0, 0xF1, 0x5C, 0xC4, 0x6E,
+    0x10, 0xB0, 0xF1, 0x62, 0x35, 0xB0, 0x51, 0x80, 0x10, 0xB0, 0xF1, 0x5D, 0x36, 0x30, 0x24, 0x60,
+    0xE1, 0xB0, 0x21, 0x6D, 0x35, 0x30, 0xAA, 0xF1, 0x10, 0x39, 0x45, 0x40, 0xAA, 0xF1, 0x02, 0x4E,
+    0x22, 0x30, 0x20, 0x6F, 0x66, 0x4E, 0x20, 0x40, 0x01, 0x6F, 0x43, 0x20, 0x61, 0x73, 0xC1, 0xF0,
+    0x35, 0x79, 0x70, 0xB5, 0xE1, 0x6F, 0xA0, 0x20, 0x31, 0xB1, 0xF1, 0x34, 0xEF, 0x30, 0x78, 0x36,
+    0x32, 0x30, 0x00, 0x31, 0x30, 0x38, 0x28, 0x79, 0x70, 0xAE, 0xE1, 0x79, 0xB0, 0x32, 0x79, 0xF0,
+    0x3B, 0x32, 0x79, 0x90, 0x68, 0xE3, 0x42, 0x79, 0xB0, 0x33, 0x79, 0xF0, 0x36, 0x2E, 0x00, 0x00,
+    0x20, 0x79, 0x70, 0x34, 0x79, 0xF0, 0x0C, 0x55, 0x34, 0x79, 0xF0, 0x48, 0x35, 0x79, 0xF0, 0x0C,
+    0x35, 0x79, 0xF0, 0x48, 0x36, 0x79, 0xF0, 0x0C, 0x55, 0x36, 0x79, 0xF0, 0x48, 0x37, 0x79, 0xF0,
+    0x0C, 0x37, 0x79, 0xF0, 0x48, 0x38, 0x79, 0xF0, 0x0C, 0x29, 0x38, 0x79, 0xF0, 0x44, 0xCB, 0xE3,
+    0x52, 0x3B, 0x00, 0x20, 0x7A, 0x10, 0x3C, 0x00, 0xF3, 0x20, 0x70, 0x1A, 0x50, 0x7C, 0x90, 0x39,
+    0x0A, 0x53, 0x75, 0x7F, 0x62, 0x4E, 0x75, 0x6D, 0x62, 0x65, 0x72, 0x0B, 0x00, 0xE4, 0x45, 0x30,
+    0xBF, 0x00, 0x30, 0x49, 0xD0, 0x22, 0x30, 0x20, 0x6F, 0x66, 0x14, 0x4E, 0x20, 0xC9, 0x60, 0x73,
+    0xC8, 0xF0, 0x0A, 0x35, 0xC8, 0xF0, 0x18, 0x79, 0x70, 0xC3, 0xE0, 0x52, 0x39, 0xB1, 0x31, 0x39,
+    0xF1, 0x45, 0x79, 0x00, 0x32, 0x79, 0xF0, 0x0C, 0x32, 0x79, 0xF0, 0x48, 0x55, 0x33, 0x79, 0xF0,
+    0x0C, 0x33, 0x79, 0xF0, 0x48, 0x34, 0x79, 0xF0, 0x0C, 0x34, 0x79, 0xF0, 0x48, 0x55, 0x35, 0x79,
+    0xF0, 0x0C, 0x35, 0x79, 0xF0, 0x48, 0x36, 0x79, 0xF0, 0x0C, 0x36, 0x79, 0xF0, 0x48, 0x55, 0x37,
+    0x79, 0xF0, 0x0C, 0x37, 0x79, 0xF0, 0x48, 0x38, 0x79, 0xF0, 0x0C, 0x38, 0x79, 0xF0, 0x44, 0xCA,
+    0x51, 0xE3, 0x52, 0x3B, 0x00, 0x20, 0x7A, 0x10, 0x3C, 0x00, 0x20, 0x70, 0xFC, 0x1A, 0x50, 0x7C,
+    0x90, 0x39, 0x0A, 0x53, 0x75, 0x62, 0x4E, 0x1F, 0x75, 0x6D, 0x62, 0x65, 0x72, 0x0B, 0x00, 0x45,
+    0x30, 0xBF, 0x00, 0x39, 0x30, 0x49, 0xD0, 0x22, 0x30, 0x20, 0x6F, 0x66, 0x4E, 0x20, 0xC9, 0x60,
+    0xA5, 0x73, 0xC8, 0xF0, 0x0A, 0x35, 0xC8, 0xF0, 0x18, 0x79, 0x70, 0x31, 0x39, 0xF1, 0x0C, 0x31,
+    0x50, 0x39, 0xF1, 0x45, 0x79, 0x00, 0x3D, 0xE1, 0x79, 0xB0, 0x32, 0x79, 0xF0, 0x48, 0x33, 0x79,
+    0xF0, 0x0C, 0x55, 0x33, 0x79, 0xF0, 0x48, 0x34, 0x79, 0xF0, 0x0C, 0x34, 0x79, 0xF0, 0x48, 0x35,
+    0x79, 0xF0, 0x0C, 0x55, 0x35, 0x79, 0xF0, 0x48, 0x36, 0x79, 0xF0, 0x0C, 0x36, 0x79, 0xF0, 0x48,
+    0x37, 0x79, 0xF0, 0x0C, 0x95, 0x37, 0x79, 0xF0, 0x48, 0x38, 0x79, 0xF0, 0x0C, 0x38, 0x79, 0xF0,
+    0x44, 0xD7, 0xE2, 0x52, 0x32, 0x3B, 0x00, 0x20, 0x7A, 0x10, 0x3C, 0x00, 0x20, 0x70, 0x1A, 0x50,
+    0x7C, 0x90, 0xFF, 0x39, 0x0A, 0x53, 0x75, 0x62, 0x4E, 0x75, 0x6D, 0x47, 0x62, 0x65, 0x72, 0x0B,
+    0x00, 0x45, 0x30, 0xBF, 0x00, 0x30, 0x49, 0xD0, 0x4E, 0x22, 0x30, 0x20, 0x6F, 0x66, 0x4E, 0x20,
+    0xC9, 0x60, 0x73, 0xC8, 0xF0, 0x0A, 0x29, 0x35, 0xC8, 0xF0, 0x18, 0x79, 0x70, 0x31, 0x39, 0xF1,
+    0x0C, 0x31, 0x39, 0xF1, 0x45, 0x79, 0x00, 0x45, 0x32, 0x79, 0xF0, 0x0C, 0x32, 0x79, 0xF0, 0x48,
+    0xB7, 0xE1, 0x79, 0xB0, 0x33, 0x79, 0xF0, 0x48, 0x55, 0x34, 0x79, 0xF0, 0x0C, 0x34, 0x79, 0xF0,
+    0x48, 0x35, 0x79, 0xF0, 0x0C, 0x35, 0x79, 0xF0, 0x48, 0x55, 0x36, 0x79, 0xF0, 0x0C, 0x36, 0x79,
+    0xF0, 0x48, 0x37, 0x79, 0xF0, 0x0C, 0x37, 0x79, 0xF0, 0x48, 0x75, 0x38, 0x79, 0xF0, 0x0C, 0x38,
+    0x79, 0xF0, 0x42, 0x38, 0x30, 0x30, 0x75, 0xD0, 0xFD, 0x54, 0x3B, 0x00, 0x20, 0x63, 0x6F, 0x6D,
+    0x6D, 0x75, 0xFF, 0x6E, 0x69, 0x63, 0x61, 0x74, 0x69, 0x6F, 0x6E, 0xF3, 0x20, 0x70, 0x20, 0x50,
+    0x82, 0x90, 0x39, 0x0A, 0x53, 0x75, 0x7F, 0x62, 0x4E, 0x75, 0x6D, 0x62, 0x65, 0x72, 0x8E, 0x00,
+    0x78, 0x4B, 0x30, 0xC5, 0x00, 0x4F, 0xE0, 0x6D, 0x61, 0x78, 0x20, 0x17, 0x00, 0xBF, 0x2D, 0x69,
+    0x6E, 0x64, 0x65, 0x78, 0xC3, 0xF0, 0x0A, 0x35, 0xAA, 0xC3, 0xA0, 0x6F, 0xC3, 0xF0, 0x09, 0x36,
+    0x6E, 0x70, 0x31, 0x6E, 0xD0, 0x43, 0xFF, 0x4F, 0x42, 0x2D, 0x49, 0x44, 0x20, 0x75, 0x73, 0xCE,
+    0x39, 0x01, 0x62, 0x79, 0x20, 0xCD, 0x10, 0x38, 0xF1, 0x34, 0x24, 0x4E, 0xFF, 0x4F, 0x44, 0x45,
+    0x49, 0x44, 0x2B, 0x30, 0x78, 0xF4, 0x7A, 0x00, 0x80, 0x70, 0x32, 0x80, 0xD0, 0x74, 0x72, 0x61,
+    0x6E, 0x5F, 0x73, 0x6D, 0x69, 0x73, 0x73, 0x39, 0x11, 0x74, 0x56, 0x00, 0x5C, 0xF3, 0xF0, 0x18,
+    0x7E, 0xF0, 0x0A, 0x32, 0x35, 0x35, 0x74, 0x70, 0x33, 0x74, 0xD0, 0xFF, 0x69, 0x6E, 0x68, 0x69,
+    0x62, 0x69, 0x74, 0x20, 0x57, 0x74, 0x69, 0x6D, 0x6F, 0xF0, 0x0B, 0x36, 0x6F, 0xF0, 0x17, 0x31,
+    0x20, 0x62, 0xD2, 0x6F, 0x00, 0x34, 0x6F, 0xD0, 0x1F, 0x02, 0x70, 0x1B, 0x02, 0x62, 0x69, 0xFF,
+    0x6C, 0x69, 0x74, 0x79, 0x20, 0x65, 0x6E, 0x74, 0xD3, 0x72, 0x79, 0xE6, 0xF0, 0x34, 0x74, 0x80,
+    0x35, 0x74, 0xD0, 0x65, 0x76, 0xA0, 0x68, 0x00, 0xE2, 0x20, 0x88, 0xA2, 0xE3, 0xF0, 0x28, 0x6C,
+    0x80, 0x36, 0x6C, 0xD0, 0x53, 0xFF, 0x59, 0x4E, 0x43, 0x20, 0x73, 0x74, 0x61, 0x72, 0x87, 0x74,
+    0x20, 0x76, 0x2C, 0x10, 0xDE, 0xF0, 0x3B, 0xB5, 0xE2, 0x74, 0xF3, 0x29, 0x31, 0x88, 0x74, 0xF3,
+    0x5C, 0x6E, 0x10, 0x74, 0xF3, 0x62, 0x32, 0x74, 0x53, 0x80, 0x10, 0x74, 0xF3, 0x58, 0x34, 0x00,
+    0x74, 0x70, 0x74, 0xF3, 0x51, 0xE2, 0x80, 0x72, 0xF3, 0x5F, 0x74, 0x10, 0x72, 0xF3, 0x57, 0x6C,
+    0x10, 0x72, 0xF3, 0x5C, 0x44, 0x32, 0xE2, 0x72, 0xF3, 0x29, 0x32, 0x72, 0xF3, 0x5C, 0x6E, 0x10,
+    0x72, 0xF3, 0x62, 0x33, 0x72, 0x53, 0x00, 0x80, 0x10, 0x72, 0xF3, 0x5F, 0x74, 0x10, 0x72, 0xF3,
+    0x58, 0x6D, 0x10, 0x72, 0xF3, 0x5F, 0x74, 0x10, 0x72, 0xF3, 0x57, 0x10, 0x6C, 0x10, 0x72, 0xF3,
+    0x5C, 0xBD, 0xE1, 0x72, 0xF3, 0x29, 0x33, 0x72, 0xF3, 0x5C, 0x6E, 0x10, 0x72, 0xF3, 0x62, 0x01,
+    0x34, 0x72, 0x53, 0x80, 0x10, 0x72, 0xF3, 0x5F, 0x74, 0x10, 0x72, 0xF3, 0x58, 0x6D, 0x10, 0x72,
+    0xF3, 0x5F, 0x30, 0x74, 0x10, 0x72, 0xF3, 0x57, 0x6C, 0x10, 0x72, 0xF3, 0x5A, 0x41, 0x30, 0x22,
+    0xE3, 0x72, 0x23, 0x89, 0x6D, 0x33, 0x30, 0x6C, 0xF3, 0x10, 0x39, 0x45, 0x40, 0x6C, 0xF3, 0x02,
+    0x22, 0x30, 0x20, 0x53, 0x6F, 0x66, 0x4E, 0x20, 0x02, 0x03, 0x6F, 0x43, 0x20, 0x73, 0x83, 0xF2,
+    0x35, 0xD8, 0x79, 0x70, 0x77, 0xE3, 0x6F, 0xA0, 0x20, 0x31, 0x73, 0xF3, 0x34, 0x30, 0x78, 0x3D,
+    0x36, 0x2F, 0x00, 0x30, 0x31, 0x30, 0x38, 0x79, 0x70, 0x70, 0xE3, 0x8A, 0x79, 0xB0, 0x32, 0x79,
+    0xF0, 0x3B, 0x32, 0x79, 0x90, 0x75, 0xE3, 0x79, 0xB0, 0x33, 0x40, 0x79, 0xF0, 0x36, 0x78, 0x10,
+    0x00, 0x10, 0x79, 0x70, 0x81, 0xE3, 0x79, 0xB0, 0x34, 0x79, 0xF0, 0x48, 0x44, 0x86, 0xE3, 0x79,
+    0xB0, 0x35, 0x79, 0xF0, 0x48, 0x93, 0xE3, 0x79, 0xB0, 0x36, 0x79, 0xF0, 0x48, 0x55, 0x37, 0x79,
+    0xF0, 0x0C, 0x37, 0x79, 0xF0, 0x48, 0x38, 0x79, 0xF0, 0x0C, 0x38, 0x79, 0xF0, 0x44, 0xCA, 0xCB,
+    0xE3, 0x54, 0x3B, 0x00, 0x20, 0x7A, 0x10, 0x3C, 0x00, 0x20, 0x70, 0xFC, 0x1A, 0x50, 0x7C, 0x90,
+    0x39, 0x0A, 0x53, 0x75, 0x62, 0x4E, 0x1F, 0x75, 0x6D, 0x62, 0x65, 0x72, 0x0B, 0x00, 0x45, 0x30,
+    0xBF, 0x00, 0x39, 0x30, 0x49, 0xD0, 0x22, 0x30, 0x20, 0x6F, 0x66, 0x4E, 0x20, 0xC9, 0x60, 0x85,
+    0x73, 0xC8, 0xF0, 0x0A, 0x35, 0xC8, 0xF0, 0x18, 0x79, 0x70, 0xC3, 0xE0, 0x39, 0xB1, 0x31, 0x54,
+    0x39, 0xF1, 0x45, 0x79, 0x00, 0x32, 0x79, 0xF0, 0x0C, 0x32, 0x79, 0xF0, 0x48, 0x33, 0x79, 0xF0,
+    0x0C, 0x55, 0x33, 0x79, 0xF0, 0x48, 0x34, 0x79, 0xF0, 0x0C, 0x34, 0x79, 0xF0, 0x48, 0x35, 0x79,
+    0xF0, 0x0C, 0x55, 0x35, 0x79, 0xF0, 0x48, 0x36, 0x79, 0xF0, 0x0C, 0x36, 0x79, 0xF0, 0x48, 0x37,
+    0x79, 0xF0, 0x0C, 0x95, 0x37, 0x79, 0xF0, 0x48, 0x38, 0x79, 0xF0, 0x0C, 0x38, 0x79, 0xF0, 0x44,
+    0x51, 0xE3, 0x54, 0x32, 0x3B, 0x00, 0x20, 0x7A, 0x10, 0x3C, 0x00, 0x20, 0x70, 0x1A, 0x50, 0x7C,
+    0x90, 0xFF, 0x39, 0x0A, 0x53, 0x75, 0x62, 0x4E, 0x75, 0x6D, 0x47, 0x62, 0x65, 0x72, 0x0B, 0x00,
+    0x45, 0x30, 0xBF, 0x00, 0x30, 0x49, 0xD0, 0x4E, 0x22, 0x30, 0x20, 0x6F, 0x66, 0x4E, 0x20, 0xC9,
+    0x60, 0x73, 0xC8, 0xF0, 0x0A, 0x29, 0x35, 0xC8, 0xF0, 0x18, 0x79, 0x70, 0x31, 0x39, 0xF1, 0x0C,
+    0x31, 0x39, 0xF1, 0x45, 0x79, 0x00, 0x54, 0x3D, 0xE1, 0x79, 0xB0, 0x32, 0x79, 0xF0, 0x48, 0x33,
+    0x79, 0xF0, 0x0C, 0x33, 0x79, 0xF0, 0x48, 0x55, 0x34, 0x79, 0xF0, 0x0C, 0x34, 0x79, 0xF0, 0x48,
+    0x35, 0x79, 0xF0, 0x0C, 0x35, 0x79, 0xF0, 0x48, 0x55, 0x36, 0x79, 0xF0, 0x0C, 0x36, 0x79, 0xF0,
+    0x48, 0x37, 0x79, 0xF0, 0x0C, 0x37, 0x79, 0xF0, 0x48, 0xA5, 0x38, 0x79, 0xF0, 0x0C, 0x38, 0x79,
+    0xF0, 0x44, 0xD7, 0xE2, 0x54, 0x3B, 0x00, 0x20, 0xCC, 0x7A, 0x10, 0x3C, 0x00, 0x20, 0x70, 0x1A,
+    0x50, 0x7C, 0x90, 0x39, 0x0A, 0xFF, 0x53, 0x75, 0x62, 0x4E, 0x75, 0x6D, 0x62, 0x65, 0x91, 0x72,
+    0x0B, 0x00, 0x45, 0x30, 0xBF, 0x00, 0x30, 0x49, 0xD0, 0x22, 0x30, 0x20, 0x53, 0x6F, 0x66, 0x4E,
+    0x20, 0xC9, 0x60, 0x73, 0xC8, 0xF0, 0x0A, 0x35, 0xC8, 0xF0, 0x18, 0x4A, 0x79, 0x70, 0x31, 0x39,
+    0xF1, 0x0C, 0x31, 0x39, 0xF1, 0x45, 0x79, 0x00, 0x32, 0x79, 0xF0, 0x0C, 0x51, 0x32, 0x79, 0xF0,
+    0x48, 0xB7, 0xE1, 0x79, 0xB0, 0x33, 0x79, 0xF0, 0x48, 0x34, 0x79, 0xF0, 0x0C, 0x55, 0x34, 0x79,
+    0xF0, 0x48, 0x35, 0x79, 0xF0, 0x0C, 0x35, 0x79, 0xF0, 0x48, 0x36, 0x79, 0xF0, 0x0C, 0x55, 0x36,
+    0x79, 0xF0, 0x48, 0x37, 0x79, 0xF0, 0x0C, 0x37, 0x79, 0xF0, 0x48, 0x38, 0x79, 0xF0, 0x0C, 0xED,
+    0x38, 0x79, 0xF0, 0x42, 0x46, 0x32, 0x51, 0xE3, 0x43, 0x6F, 0x6E, 0xFF, 0x63, 0x69, 0x73, 0x65,
+    0x20, 0x44, 0x43, 0x46, 0xFE, 0x71, 0x90, 0x38, 0x0A, 0x53, 0x75, 0x62, 0x4E, 0x75, 0xFF, 0x6D,
+    0x62, 0x65, 0x72, 0x3D, 0x31, 0x32, 0x38, 0xB4, 0x3C, 0x40, 0xB6, 0x00, 0x30, 0xB6, 0xF0, 0x00,
+    0x78, 0x20, 0x17, 0x00, 0x2D, 0x5F, 0x69, 0x6E, 0x64, 0x65, 0x78, 0xB4, 0xF0, 0x0A, 0x35, 0xB4,
+    0xA0, 0x5D, 0x6F, 0xB4, 0xF0, 0x09, 0x31, 0x32, 0x37, 0x70, 0x70, 0x31, 0x70, 0xD0, 0xBF, 0x4E,
+    0x6F, 0x64, 0x65, 0x20, 0x31, 0x69, 0xF0, 0x0A, 0x46, 0x42, 0x69, 0x90, 0x77, 0x69, 0xC0, 0x58,
+    0x60, 0x0A, 0xE1, 0x58, 0x20, 0x32, 0x58, 0xF0, 0x30, 0x55, 0x33, 0x58, 0xF0, 0x03, 0x33, 0x58,
+    0xF0, 0x30, 0x34, 0x58, 0xF0, 0x03, 0x34, 0x58, 0xF0, 0x30, 0x00, 0xF9, 0xE3, 0x58, 0x20, 0xF0,
+    0xF3, 0x0B, 0x58, 0xF0, 0x14, 0xD8, 0xE3, 0x58, 0x20, 0xCF, 0xF3, 0x0B, 0x58, 0xF0, 0x14, 0x00,
+    0xB7, 0xE3, 0x58, 0x20, 0xAE, 0xF3, 0x0B, 0x58, 0xF0, 0x14, 0x96, 0xE3, 0x58, 0x20, 0x8D, 0xF3,
+    0x0B, 0x58, 0xF0, 0x14, 0x55, 0x39, 0x58, 0xF0, 0x03, 0x39, 0x58, 0xF0, 0x30, 0x41, 0x20, 0xF3,
+    0x04, 0x30, 0x59, 0xF0, 0x30, 0x49, 0x42, 0x59, 0xF0, 0x04, 0x7B, 0xF3, 0x31, 0x43, 0x59, 0xF0,
+    0x04, 0x7C, 0xF3, 0x31, 0x44, 0x59, 0xF0, 0x04, 0x92, 0x7D, 0xF3, 0x31, 0x45, 0x59, 0xF0, 0x04,
+    0x7E, 0xF3, 0x31, 0x46, 0x59, 0xF0, 0x04, 0x7F, 0xF3, 0x31, 0x31, 0x99, 0x30, 0x5A, 0xF0, 0x04,
+    0x81, 0xF3, 0x31, 0x31, 0x31, 0x5A, 0xF0, 0x04, 0x83, 0xF3, 0x31, 0x31, 0x99, 0x32, 0x5A, 0xF0,
+    0x04, 0x85, 0xF3, 0x31, 0x31, 0x33, 0x5A, 0xF0, 0x04, 0x87, 0xF3, 0x31, 0x31, 0x35, 0x34, 0x5A,
+    0xF0, 0x03, 0x32, 0x88, 0xF3, 0x31, 0x31, 0x35, 0x5A, 0xF0, 0x04, 0x89, 0xF3, 0x31, 0x33, 0x31,
+    0x36, 0x5A, 0xF0, 0x04, 0x8A, 0xF3, 0x31, 0x31, 0x37, 0x5A, 0xF0, 0x04, 0x8B, 0xF3, 0x31, 0x33,
+    0x31, 0x38, 0x5A, 0xF0, 0x04, 0x8C, 0xF3, 0x31, 0x31, 0x39, 0x5A, 0xF0, 0x04, 0x8D, 0xF3, 0x32,
+    0x49, 0x41, 0x5A, 0xF0, 0x04, 0x8D, 0xF3, 0x32, 0x42, 0x5A, 0xF0, 0x04, 0x8D, 0xF3, 0x32, 0x43,
+    0x5A, 0xF0, 0x04, 0x52, 0x8D, 0xF3, 0x32, 0x44, 0x5A, 0xF0, 0x04, 0x8D, 0xF3, 0x32, 0x45, 0x5A,
+    0xF0, 0x03, 0x33, 0x8D, 0xF3, 0x32, 0x99, 0x46, 0x5A, 0xF0, 0x04, 0x8D, 0xF3, 0x31, 0x32, 0x30,
+    0x5A, 0xF0, 0x04, 0x8D, 0xF3, 0x31, 0x32, 0x99, 0x31, 0x5A, 0xF0, 0x04, 0x8D, 0xF3, 0x31, 0x32,
+    0x32, 0x5A, 0xF0, 0x04, 0x8D, 0xF3, 0x31, 0x32, 0x99, 0x33, 0x5A, 0xF0, 0x04, 0x8D, 0xF3, 0x31,
+    0x32, 0x34, 0x5A, 0xF0, 0x04, 0x8D, 0xF3, 0x31, 0x32, 0x99, 0x35, 0x5A, 0xF0, 0x04, 0x8D, 0xF3,
+    0x31, 0x32, 0x36, 0x5A, 0xF0, 0x04, 0x8D, 0xF3, 0x31, 0x32, 0x59, 0x37, 0x5A, 0xF0, 0x04, 0x8D,
+    0xF3, 0x31, 0x32, 0x38, 0x5A, 0xF0, 0x03, 0x34, 0x8D, 0xF3, 0x31, 0x93, 0x32, 0x39, 0x5A, 0xF0,
+    0x04, 0x8D, 0xF3, 0x32, 0x41, 0x5A, 0xF0, 0x04, 0x8D, 0xF3, 0x32, 0x42, 0x24, 0x5A, 0xF0, 0x04,
+    0x8D, 0xF3, 0x32, 0x43, 0x5A, 0xF0, 0x04, 0x8D, 0xF3, 0x32, 0x44, 0x5A, 0xF0, 0x04, 0x8D, 0xF3,
+    0x32, 0xC9, 0x45, 0x5A, 0xF0, 0x04, 0x8D, 0xF3, 0x32, 0x46, 0x5A, 0xF0, 0x04, 0x8D, 0xF3, 0x31,
+    0x33, 0x30, 0xCC, 0x5A, 0xF0, 0x04, 0x8D, 0xF3, 0x31, 0x33, 0x31, 0x5A, 0xF0, 0x04, 0x8D, 0xF3,
+    0x31, 0x33, 0x32, 0x9A, 0x5A, 0xF0, 0x03, 0x35, 0x8D, 0xF3, 0x31, 0x33, 0x33, 0x5A, 0xF0, 0x04,
+    0x8D, 0xF3, 0x31, 0x33, 0x99, 0x34, 0x5A, 0xF0, 0x04, 0x8D, 0xF3, 0x31, 0x33, 0x35, 0x5A, 0xF0,
+    0x04, 0x8D, 0xF3, 0x31, 0x33, 0x99, 0x36, 0x5A, 0xF0, 0x04, 0x8D, 0xF3, 0x31, 0x33, 0x37, 0x5A,
+    0xF0, 0x04, 0x8D, 0xF3, 0x31, 0x33, 0x99, 0x38, 0x5A, 0xF0, 0x04, 0x8D, 0xF3, 0x31, 0x33, 0x39,
+    0x5A, 0xF0, 0x04, 0x8D, 0xF3, 0x32, 0x41, 0xA4, 0x5A, 0xF0, 0x04, 0x8D, 0xF3, 0x32, 0x42, 0x5A,
+    0xF0, 0x04, 0x8D, 0xF3, 0x32, 0x43, 0x5A, 0xF0, 0x03, 0x36, 0x92, 0x8D, 0xF3, 0x32, 0x44, 0x5A,
+    0xF0, 0x04, 0x8D, 0xF3, 0x32, 0x45, 0x5A, 0xF0, 0x04, 0x8D, 0xF3, 0x32, 0x46, 0xCC, 0x5A, 0xF0,
+    0x04, 0x8D, 0xF3, 0x31, 0x34, 0x30, 0x5A, 0xF0, 0x04, 0x8D, 0xF3, 0x31, 0x34, 0x31, 0xCC, 0x5A,
+    0xF0, 0x04, 0x8D, 0xF3, 0x31, 0x34, 0x32, 0x5A, 0xF0, 0x04, 0x8D, 0xF3, 0x31, 0x34, 0x33, 0xCC,
+    0x5A, 0xF0, 0x04, 0x8D, 0xF3, 0x31, 0x34, 0x34, 0x5A, 0xF0, 0x04, 0x8D, 0xF3, 0x31, 0x34, 0x35,
+    0xAC, 0x5A, 0xF0, 0x04, 0x8D, 0xF3, 0x31, 0x34, 0x36, 0x5A, 0xF0, 0x03, 0x37, 0x8D, 0xF3, 0x31,
+    0x34, 0x99, 0x37, 0x5A, 0xF0, 0x04, 0x8D, 0xF3, 0x31, 0x34, 0x38, 0x5A, 0xF0, 0x04, 0x8D, 0xF3,
+    0x31, 0x34, 0x49, 0x39, 0x5A, 0xF0, 0x04, 0x8D, 0xF3, 0x32, 0x41, 0x5A, 0xF0, 0x04, 0x8D, 0xF3,
+    0x32, 0x42, 0x5A, 0xF0, 0x04, 0x92, 0x8D, 0xF3, 0x32, 0x43, 0x5A, 0xF0, 0x04, 0x8D, 0xF3, 0x32,
+    0x44, 0x5A, 0xF0, 0x04, 0x8D, 0xF3, 0x32, 0x45, 0x64, 0x5A, 0xF0, 0x04, 0x8D, 0xF3, 0x32, 0x46,
+    0x5A, 0xF0, 0x04, 0x8D, 0xF3, 0x31, 0x35, 0x30, 0x5A, 0xF0, 0x03, 0xCD, 0x38, 0x8D, 0xF3, 0x31,
+    0x35, 0x31, 0x5A, 0xF0, 0x04, 0x8D, 0xF3, 0x31, 0x35, 0x32, 0xCC, 0x5A, 0xF0, 0x04, 0x8D, 0xF3,
+    0x31, 0x35, 0x33, 0x5A, 0xF0, 0x04, 0x8D, 0xF3, 0x31, 0x35, 0x34, 0xCC, 0x5A, 0xF0, 0x04, 0x8D,
+    0xF3, 0x31, 0x35, 0x35, 0x5A, 0xF0, 0x04, 0x8D, 0xF3, 0x31, 0x35, 0x36, 0xCC, 0x5A, 0xF0, 0x04,
+    0x8D, 0xF3, 0x31, 0x35, 0x37, 0x5A, 0xF0, 0x04, 0x8D, 0xF3, 0x31, 0x35, 0x38, 0x4C, 0x5A, 0xF0,
+    0x04, 0x8D, 0xF3, 0x31, 0x35, 0x39, 0x5A, 0xF0, 0x04, 0x8D, 0xF3, 0x32, 0x41, 0x5A, 0xF0, 0x03,
+    0x25, 0x39, 0x8D, 0xF3, 0x32, 0x42, 0x5A, 0xF0, 0x04, 0x8D, 0xF3, 0x32, 0x43, 0x5A, 0xF0, 0x04,
+    0x8D, 0xF3, 0x32, 0x49, 0x44, 0x5A, 0xF0, 0x04, 0x8D, 0xF3, 0x32, 0x45, 0x5A, 0xF0, 0x04, 0x8D,
+    0xF3, 0x32, 0x46, 0x5A, 0xF0, 0x04, 0x66, 0x8D, 0xF3, 0x31, 0x36, 0x30, 0x5A, 0xF0, 0x04, 0x8D,
+    0xF3, 0x31, 0x36, 0x31, 0x5A, 0xF0, 0x04, 0x66, 0x8D, 0xF3, 0x31, 0x36, 0x32, 0x5A, 0xF0, 0x04,
+    0x8D, 0xF3, 0x31, 0x36, 0x33, 0x5A, 0xF0, 0x04, 0xB6, 0x8D, 0xF3, 0x31, 0x36, 0x34, 0x5A, 0xF0,
+    0x03, 0x31, 0x30, 0x8E, 0xF3, 0x31, 0x36, 0x99, 0x35, 0x5B, 0xF0, 0x05, 0x8F, 0xF3, 0x31, 0x36,
+    0x36, 0x5B, 0xF0, 0x05, 0x90, 0xF3, 0x31, 0x36, 0x99, 0x37, 0x5B, 0xF0, 0x05, 0x91, 0xF3, 0x31,
+    0x36, 0x38, 0x5B, 0xF0, 0x05, 0x92, 0xF3, 0x31, 0x36, 0x49, 0x39, 0x5B, 0xF0, 0x05, 0x93, 0xF3,
+    0x32, 0x41, 0x5B, 0xF0, 0x05, 0x94, 0xF3, 0x32, 0x42, 0x5B, 0xF0, 0x05, 0x92, 0x95, 0xF3, 0x32,
+    0x43, 0x5B, 0xF0, 0x05, 0x96, 0xF3, 0x32, 0x44, 0x5B, 0xF0, 0x05, 0x97, 0xF3, 0x32, 0x45, 0xCA,
+    0x5B, 0xF0, 0x04, 0x31, 0x97, 0xF3, 0x32, 0x46, 0x5B, 0xF0, 0x05, 0x97, 0xF3, 0x31, 0x37, 0x30,
+    0xCC, 0x5B, 0xF0, 0x05, 0x97, 0xF3, 0x31, 0x37, 0x31, 0x5B, 0xF0, 0x05, 0x97, 0xF3, 0x31, 0x37,
+    0x32, 0xCC, 0x5B, 0xF0, 0x05, 0x97, 0xF3, 0x31, 0x37, 0x33, 0x5B, 0xF0, 0x05, 0x97, 0xF3, 0x31,
+    0x37, 0x34, 0xCC, 0x5B, 0xF0, 0x05, 0x97, 0xF3, 0x31, 0x37, 0x35, 0x5B, 0xF0, 0x05, 0x97, 0xF3,
+    0x31, 0x37, 0x36, 0xCC, 0x5B, 0xF0, 0x05, 0x97, 0xF3, 0x31, 0x37, 0x37, 0x5B, 0xF0, 0x05, 0x97,
+    0xF3, 0x31, 0x37, 0x38, 0x9A, 0x5B, 0xF0, 0x04, 0x32, 0x97, 0xF3, 0x31, 0x37, 0x39, 0x5B, 0xF0,
+    0x05, 0x97, 0xF3, 0x32, 0x41, 0x24, 0x5B, 0xF0, 0x05, 0x97, 0xF3, 0x32, 0x42, 0x5B, 0xF0, 0x05,
+    0x97, 0xF3, 0x32, 0x43, 0x5B, 0xF0, 0x05, 0x97, 0xF3, 0x32, 0x49, 0x44, 0x5B, 0xF0, 0x05, 0x97,
+    0xF3, 0x32, 0x45, 0x5B, 0xF0, 0x05, 0x97, 0xF3, 0x32, 0x46, 0x5B, 0xF0, 0x05, 0xF6, 0x97, 0xF3,
+    0x2C, 0x35, 0x30, 0x56, 0xD0, 0x50, 0x72, 0x6F, 0x67, 0xE6, 0x0F, 0x00, 0x20, 0x64, 0x48, 0x00,
+    0x5A, 0x90, 0x38, 0x0A, 0x53, 0xFF, 0x75, 0x62, 0x4E, 0x75, 0x6D, 0x62, 0x65, 0x72, 0xE3, 0x3D,
+    0x32, 0x3B, 0x40, 0x97, 0x00, 0x3F, 0xE0, 0x6D, 0x61, 0x78, 0xFD, 0x20, 0x17, 0x00, 0x2D, 0x69,
+    0x6E, 0x64, 0x65, 0x78, 0xEA, 0x9B, 0xF0, 0x0A, 0x35, 0x9B, 0x90, 0x72, 0x9B, 0xC0, 0x44, 0x65,
+    0x66, 0xFF, 0x61, 0x75, 0x6C, 0x74, 0x56, 0x61, 0x6C, 0x75, 0x57, 0x65, 0x3D, 0x31, 0x6E, 0x70,
+    0x31, 0xAE, 0xF0, 0x06, 0x6E, 0x99, 0x20, 0xF5, 0x20, 0x35, 0xF3, 0x2C, 0x35, 0x5E, 0xF0, 0x07,
+    0x63, 0x6F, 0x6E, 0x74, 0x17, 0x72, 0x6F, 0x6C, 0x10, 0xF1, 0x0D, 0x31, 0x10, 0xF1, 0x5C, 0x6E,
+    0x10, 0x10, 0xF1, 0x2B, 0xEA, 0x71, 0xB0, 0x77, 0x71, 0xF0, 0x10, 0x36, 0x6D, 0xF0, 0x06, 0x73,
+    0x6F, 0x66, 0xFF, 0x74, 0x77, 0x61, 0x72, 0x65, 0x20, 0x69, 0x64, 0xFF, 0x65, 0x6E, 0x74, 0x69,
+    0x66, 0x69, 0x63, 0x61, 0x2F, 0x74, 0x69, 0x6F, 0x6E, 0x2F, 0xF1, 0x0D, 0x36, 0x2F, 0xF1, 0x5C,
+    0x6E, 0x10, 0xD2, 0x2F, 0xF1, 0x2B, 0x37, 0x71, 0xF0, 0x17, 0x4F, 0x42, 0x37, 0x6D, 0xD0, 0x46,
+    0x6C, 0xFF, 0x61, 0x73, 0x68, 0x20, 0x73, 0x74, 0x61, 0x74, 0x8B, 0x75, 0x73, 0x2B, 0xF1, 0x1C,
+    0x37, 0x2B, 0xF1, 0x5C, 0x6E, 0x10, 0x2B, 0xF1, 0x5B, 0x38, 0xEE, 0xDC, 0xE0, 0x4E, 0x4D, 0x54,
+    0x29, 0x11, 0x72, 0x74, 0x75, 0x41, 0x70, 0x68, 0xF0, 0x18, 0xC4, 0xF2, 0x0A, 0x2E, 0x20, 0x00,
+    0x20, 0x71, 0x20, 0x41, 0x71, 0xE0, 0x7E, 0x65, 0x30, 0x20, 0x73, 0x63, 0x61, 0x6E, 0x6E, 0xDF,
+    0x00, 0x2F, 0x6C, 0x69, 0x73, 0x74, 0x95, 0xF1, 0x06, 0x39, 0x42, 0x40, 0x95, 0xF1, 0x55, 0x09,
+    0x38, 0x6E, 0x70, 0x95, 0xE1, 0x53, 0xAE, 0x00, 0x8B, 0xF1, 0x1A, 0x22, 0xF1, 0x0B, 0x67, 0x70,
+    0x55, 0x32, 0x67, 0xF0, 0x03, 0x32, 0x67, 0xF0, 0x3F, 0x33, 0x67, 0xF0, 0x03, 0x33, 0x67, 0xF0,
+    0x3F, 0x55, 0x34, 0x67, 0xF0, 0x03, 0x34, 0x67, 0xF0, 0x3F, 0x35, 0x67, 0xF0, 0x03, 0x35, 0x67,
+    0xF0, 0x3F, 0x55, 0x36, 0x67, 0xF0, 0x03, 0x36, 0x67, 0xF0, 0x3F, 0x37, 0x67, 0xF0, 0x03, 0x37,
+    0x67, 0xF0, 0x3F, 0xD5, 0x38, 0x67, 0xF0, 0x03, 0x38, 0x67, 0xF0, 0x3A, 0x44, 0xF1, 0xF3, 0x06,
+    0x64, 0x69, 0x3F, 0x73, 0x70, 0x61, 0x74, 0x63, 0x68, 0x39, 0x00, 0xF5, 0xF3, 0x11, 0x91, 0x44,
+    0xF5, 0xF3, 0x5C, 0x6E, 0x20, 0xF5, 0xE3, 0x44, 0xB2, 0x40, 0xF9, 0xF3, 0x0B, 0x31, 0x01, 0x42,
+    0x21, 0xF1, 0x1F, 0xF9, 0xF3, 0x02, 0x6B, 0x60, 0xFD, 0xF3, 0x0A, 0x6B, 0xF0, 0x24, 0xFD, 0xE3,
+    0x6B, 0x60, 0x55, 0x33, 0x6B, 0xF0, 0x3F, 0x34, 0x6B, 0xF0, 0x07, 0x34, 0x6B, 0xF0, 0x3F, 0x35,
+    0x6B, 0xF0, 0x07, 0x55, 0x35, 0x6B, 0xF0, 0x3F, 0x36, 0x6B, 0xF0, 0x07, 0x36, 0x6B, 0xF0, 0x3F,
+    0x37, 0x6B, 0xF0, 0x07, 0xD5, 0x37, 0x6B, 0xF0, 0x3F, 0x38, 0x6B, 0xF0, 0x07, 0x38, 0x6B, 0xF0,
+    0x38, 0x32, 0x31, 0xFD, 0x30, 0xCA, 0xE3, 0x45, 0x72, 0x72, 0x6F, 0x72, 0x20, 0xFF, 0x73, 0x74,
+    0x61, 0x74, 0x75, 0x73, 0x20, 0x62, 0x57, 0x69, 0x74, 0x73, 0xCE, 0xF3, 0x0A, 0x41, 0xCE, 0xF3,
+    0x08, 0x31, 0x6E, 0xC0, 0xF8, 0x00, 0xF0, 0x01, 0x81, 0x30, 0xDD, 0xE3, 0x43, 0x41, 0x4E, 0x20,
+    0x6E, 0xBF, 0x6F, 0x64, 0x65, 0x20, 0x49, 0x44, 0x7B, 0xF0, 0x0A, 0x35, 0x86, 0xEA, 0xF0, 0x18,
+    0x78, 0x33, 0x6B, 0x40, 0xDD, 0xE3, 0x6B, 0x10, 0xE4, 0x00, 0x20, 0xAF, 0x72, 0x61, 0x74, 0x65,
+    0x6C, 0xF0, 0x0A, 0x36, 0x6C, 0xF0, 0x17, 0x32, 0xF9, 0x35, 0x6B, 0x40, 0xDD, 0xE3, 0x53, 0x59,
+    0x4E, 0x43, 0x20, 0x0F, 0x63, 0x6F, 0x75, 0x6E, 0x10, 0x00, 0x6B, 0xF0, 0x34, 0x69, 0x40, 0xDB,
+    0xE3, 0x0E, 0x69, 0x20, 0x74, 0x69, 0x6D, 0xD2, 0xF0, 0x19, 0xBB, 0xA1, 0x66, 0xF0, 0x04, 0x6A,
+    0xE3, 0xFF, 0x50, 0x6F, 0x77, 0x65, 0x72, 0x2D, 0x6F, 0x6E, 0xF2, 0xD4, 0xF0, 0x12, 0x37, 0x6D,
+    0xF0, 0x1E, 0x6C, 0xE3, 0x50, 0x65, 0x72, 0x66, 0xBF, 0x6F, 0x72, 0x6D, 0x61, 0x6E, 0x63, 0xD6,
+    0xA0, 0x38, 0xFF, 0x0A, 0x53, 0x75, 0x62, 0x4E, 0x75, 0x6D, 0x62, 0x8F, 0x65, 0x72, 0x3D, 0x36,
+    0x3A, 0x40, 0x3F, 0x03, 0xD7, 0xE2, 0x6D, 0xF7, 0x61, 0x78, 0x20, 0x17, 0x00, 0x2D, 0x69, 0x6E,
+    0x64, 0x93, 0x65, 0x78, 0x57, 0xF2, 0x18, 0xA9, 0xF0, 0x0A, 0x35, 0x6E, 0x70, 0xC4, 0xE2, 0x63,
+    0xFF, 0x79, 0x63, 0x6C, 0x65, 0x73, 0x20, 0x70, 0x65, 0x3E, 0x4B, 0x03, 0x65, 0x63, 0x6F, 0x6E,
+    0x64, 0xF1, 0xF1, 0x19, 0xF2, 0xA1, 0xC0, 0x47, 0xC3, 0xB1, 0x03, 0x20, 0x51, 0x76, 0x00, 0xCF,
+    0xE2, 0xF4, 0x11, 0x72, 0x20, 0x00, 0x7C, 0x20, 0x00, 0xF2, 0x1D, 0x75, 0xF0, 0x0B, 0x72, 0x80,
+    0xD6, 0xE2, 0x72, 0x90, 0x64, 0x11, 0x76, 0xF0, 0x44, 0x4E, 0xE3, 0xE2, 0x6D, 0x61, 0x69, 0x78,
+    0x02, 0xE8, 0xF0, 0x49, 0x35, 0x71, 0xF0, 0x09, 0xBA, 0xE7, 0xF0, 0x44, 0x38, 0x71, 0xD0, 0x54,
+    0x65, 0x6D, 0x40, 0x02, 0x61, 0x97, 0x74, 0x75, 0x72, 0xF2, 0xF2, 0x07, 0x32, 0x3A, 0x40, 0xF2,
+    0xF2, 0x55, 0x31, 0xB8, 0x6E, 0x70, 0xF2, 0xE2, 0x1F, 0x21, 0x50, 0x43, 0x42, 0x69, 0xF0, 0x0A,
+    0x33, 0xF4, 0x69, 0xF0, 0x08, 0x13, 0xF1, 0x04, 0x39, 0x65, 0xD0, 0x56, 0x6F, 0x6C, 0x74, 0x0B,
+    0x61, 0x67, 0x0F, 0xF1, 0x0E, 0x39, 0x0F, 0xF1, 0x5C, 0x6E, 0x10, 0x0F, 0xF1, 0x07, 0x73, 0x00,
+    0xAF, 0x70, 0x70, 0x6C, 0x79, 0x16, 0xF1, 0x3A, 0x31, 0xDB, 0xE0, 0x56, 0xDF, 0x61, 0x72, 0x69,
+    0x61, 0x62, 0x9A, 0x02, 0x49, 0x6E, 0x37, 0x74, 0x33, 0x32, 0x1D, 0xF1, 0x06, 0x31, 0x37, 0x3E,
+    0x40, 0x1E, 0xF1, 0x56, 0x49, 0x36, 0x6F, 0x70, 0x1F, 0xE1, 0x69, 0xA9, 0xD0, 0x67, 0xD0, 0x34,
+    0x41, 0xF3, 0x1E, 0xAA, 0x67, 0x20, 0x32, 0x67, 0xF0, 0x55, 0x33, 0x67, 0xF0, 0x55, 0x34, 0x67,
+    0xF0, 0x55, 0x35, 0xAA, 0x67, 0xF0, 0x55, 0x36, 0x67, 0xF0, 0x55, 0x37, 0x67, 0xF0, 0x55, 0x38,
+    0x67, 0xF0, 0x55, 0x39, 0xAA, 0x67, 0xF0, 0x55, 0x41, 0x67, 0xF0, 0x55, 0x42, 0x67, 0xF0, 0x55,
+    0x43, 0x67, 0xF0, 0x55, 0x44, 0x6A, 0x67, 0xF0, 0x55, 0x45, 0x67, 0xF0, 0x55, 0x46, 0x67, 0xF0,
+    0x55, 0x31, 0x30, 0x68, 0xF0, 0x51, 0xFD, 0x31, 0x63, 0xD0, 0x56, 0x61, 0x72, 0x69, 0x61, 0x62,
+    0xFF, 0x6C, 0x65, 0x20, 0x52, 0x4F, 0x4D, 0x20, 0x49, 0xFE, 0x70, 0xD0, 0x38, 0x0A, 0x53, 0x75,
+    0x62, 0x4E, 0x75, 0x7F, 0x6D, 0x62, 0x65, 0x72, 0x3D, 0x31, 0x37, 0x42, 0x40, 0xBC, 0xAB, 0x00,
+    0xAA, 0xE0, 0x6D, 0x61, 0x78, 0x20, 0x17, 0x00, 0x2D, 0x5F, 0x69, 0x6E, 0x64, 0x65, 0x78, 0xB2,
+    0xF0, 0x0A, 0x35, 0xB2, 0xA0, 0x35, 0x6F, 0xB1, 0x90, 0x30, 0xB1, 0xB0, 0x31, 0x36, 0x6F, 0x70,
+    0xB6, 0xE0, 0x4A, 0x1A, 0xF1, 0x3A, 0x31, 0x67, 0x70, 0x32, 0x82, 0xF1, 0x52, 0x67, 0x00, 0x33,
+    0x67, 0xF0, 0x55, 0x55, 0x34, 0x67, 0xF0, 0x55, 0x35, 0x67, 0xF0, 0x55, 0x36, 0x67, 0xF0, 0x55,
+    0x37, 0x67, 0xF0, 0x55, 0x55, 0x38, 0x67, 0xF0, 0x55, 0x39, 0x67, 0xF0, 0x55, 0x41, 0x67, 0xF0,
+    0x55, 0x42, 0x67, 0xF0, 0x55, 0x55, 0x43, 0x67, 0xF0, 0x55, 0x44, 0x67, 0xF0, 0x55, 0x45, 0x67,
+    0xF0, 0x55, 0x46, 0x67, 0xF0, 0x55, 0xEB, 0x31, 0x30, 0x68, 0xF0, 0x51, 0x32, 0x63, 0xD0, 0x56,
+    0x61, 0x72, 0xFF, 0x69, 0x61, 0x62, 0x6C, 0x65, 0x20, 0x4E, 0x56, 0xFB, 0x20, 0x49, 0x6F, 0xD0,
+    0x38, 0x0A, 0x53, 0x75, 0x62, 0xFF, 0x4E, 0x75, 0x6D, 0x62, 0x65, 0x72, 0x3D, 0x31, 0xF1, 0x37,
+    0x41, 0x40, 0xAA, 0x00, 0xA9, 0xE0, 0x6D, 0x61, 0x78, 0x20, 0x7E, 0x17, 0x00, 0x2D, 0x69, 0x6E,
+    0x64, 0x65, 0x78, 0xB1, 0xF0, 0x0A, 0xD5, 0x35, 0xB1, 0xA0, 0x6F, 0xB0, 0x90, 0x30, 0xB0, 0xB0,
+    0x31, 0x36, 0x0A, 0x6F, 0x70, 0x31, 0x19, 0xF1, 0x4A, 0x31, 0x67, 0x70, 0x1D, 0xE1, 0x81, 0xF1,
+    0x42, 0x67, 0x00, 0x55, 0x33, 0x67, 0xF0, 0x55, 0x34, 0x67, 0xF0, 0x55, 0x35, 0x67, 0xF0, 0x55,
+    0x36, 0x67, 0xF0, 0x55, 0x55, 0x37, 0x67, 0xF0, 0x55, 0x38, 0x67, 0xF0, 0x55, 0x39, 0x67, 0xF0,
+    0x55, 0x41, 0x67, 0xF0, 0x55, 0x55, 0x42, 0x67, 0xF0, 0x55, 0x43, 0x67, 0xF0, 0x55, 0x44, 0x67,
+    0xF0, 0x55, 0x45, 0x67, 0xF0, 0x55, 0xAD, 0x46, 0x67, 0xF0, 0x55, 0x31, 0x30, 0x68, 0xF0, 0x50,
+    0x32, 0x63, 0xE0, 0x74, 0x7F, 0x65, 0x73, 0x74, 0x20, 0x76, 0x61, 0x72, 0x66, 0x90, 0xFF, 0x39,
+    0x0A, 0x53, 0x75, 0x62, 0x4E, 0x75, 0x6D, 0x1F, 0x62, 0x65, 0x72, 0x3D, 0x36, 0x37, 0x40, 0xA0,
+    0x00, 0x3B, 0xE0, 0xEF, 0x6D, 0x61, 0x78, 0x20, 0x17, 0x00, 0x2D, 0x69, 0x6E, 0x57, 0x64, 0x65,
+    0x78, 0xA7, 0xF0, 0x0A, 0x35, 0xA7, 0xA0, 0x6F, 0xA6, 0x90, 0xD5, 0x30, 0xA6, 0xB0, 0x35, 0x6E,
+    0x70, 0x31, 0x6E, 0xD0, 0x49, 0x36, 0xE5, 0x34, 0x64, 0xF0, 0x09, 0x31, 0x64, 0xB0, 0x0C, 0xF1,
+    0x0C, 0x78, 0x31, 0x32, 0xFF, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0xFF, 0x41, 0x42,
+    0x43, 0x44, 0x45, 0x46, 0x4C, 0x4C, 0x2A, 0x78, 0x70, 0x32, 0x78, 0xD0, 0x55, 0x78, 0xF0, 0x0C,
+    0x42, 0x78, 0xF0, 0x1A, 0x77, 0xC0, 0x55, 0x31, 0x78, 0x90, 0x33, 0x78, 0xD0, 0x52, 0xFE, 0xF1,
+    0x0C, 0x38, 0x78, 0xF0, 0x18, 0x27, 0x31, 0x32, 0x2E, 0x78, 0x00, 0x6A, 0x70, 0x34, 0x6A, 0xE0,
+    0xE3, 0xF0, 0x0C, 0x49, 0x31, 0x6A, 0xF0, 0x18, 0xDF, 0x00, 0x2E, 0xE0, 0x00, 0x6B, 0x70, 0x35,
+    0x6B, 0xD0, 0xBF, 0x64, 0x6F, 0x6D, 0x61, 0x69, 0x6E, 0xD9, 0xF0, 0x0A, 0x46, 0xE8, 0x6E, 0xB0,
+    0x30, 0xF2, 0x09, 0xD7, 0x32, 0x33, 0x9B, 0xE2, 0x54, 0x69, 0x6D, 0x25, 0x65, 0xD3, 0xF2, 0x06,
+    0x34, 0x33, 0x40, 0xD3, 0xF2, 0x55, 0x33, 0x6E, 0x70, 0xD3, 0xE2, 0xA7, 0x53, 0x74, 0x72, 0x31,
+    0x00, 0x67, 0xF0, 0x0A, 0x39, 0x67, 0xF0, 0x17, 0x2D, 0xF1, 0x20, 0x00, 0xF0, 0x0A, 0x84, 0x70,
+    0xDF, 0xE2, 0x45, 0x70, 0x6F, 0x63, 0xF7, 0x68, 0x20, 0x74, 0x31, 0x01, 0x20, 0x62, 0x61, 0x73,
+    0x0F, 0x65, 0x20, 0x6D, 0x73, 0xEE, 0xF2, 0x19, 0x9B, 0xF1, 0x11, 0xDA, 0xF2, 0x02, 0x73, 0x80,
+    0xBF, 0x6F, 0x66, 0x66, 0x73, 0x65, 0x74, 0x75, 0xF0, 0x0C, 0x30, 0xE9, 0x37, 0x64, 0xF3, 0x19,
+    0x76, 0x20, 0x34, 0xDA, 0xE1, 0x50, 0x72, 0x6F, 0xD7, 0x66, 0x69, 0x6C, 0x15, 0xA2, 0x38, 0x15,
+    0x82, 0x32, 0x31, 0xE4, 0x37, 0x40, 0x16, 0xF2, 0x55, 0x32, 0xA7, 0x50, 0x17, 0xF2, 0x02, 0x43,
+    0x6F, 0x75, 0x0D, 0x6E, 0x0B, 0x00, 0x20, 0x31, 0x13, 0xF1, 0x19, 0x89, 0xF1, 0x0F, 0x6A, 0x20,
+    0xFD, 0xE1, 0xA2, 0x6A, 0x50, 0x32, 0x6A, 0xF0, 0x3F, 0xF4, 0xE1, 0x6A, 0x50, 0x33, 0x6A, 0xF0,
+    0x3F, 0x34, 0xAA, 0x6A, 0xF0, 0x06, 0x34, 0x6A, 0xF0, 0x3F, 0x35, 0x6A, 0xF0, 0x06, 0x35, 0x6A,
+    0xF0, 0x3F, 0x36, 0xAA, 0x6A, 0xF0, 0x06, 0x36, 0x6A, 0xF0, 0x3F, 0x37, 0x6A, 0xF0, 0x06, 0x37,
+    0x6A, 0xF0, 0x3F, 0x38, 0xAA, 0x6A, 0xF0, 0x06, 0x38, 0x6A, 0xF0, 0x3F, 0x39, 0x6A, 0xF0, 0x06,
+    0x39, 0x6A, 0xF0, 0x3F, 0x41, 0xAA, 0xC2, 0xF3, 0x07, 0x30, 0x6B, 0xF0, 0x3F, 0x42, 0x6B, 0xF0,
+    0x07, 0x31, 0x6B, 0xF0, 0x3F, 0x43, 0xAA, 0x6B, 0xF0, 0x07, 0x32, 0x6B, 0xF0, 0x3F, 0x44, 0x6B,
+    0xF0, 0x07, 0x33, 0x6B, 0xF0, 0x3F, 0x45, 0xAA, 0x6B, 0xF0, 0x07, 0x34, 0x6B, 0xF0, 0x3F, 0x46,
+    0x6B, 0xF0, 0x07, 0x35, 0x6B, 0xF0, 0x3F, 0x31, 0x55, 0x30, 0x6C, 0xF0, 0x07, 0x36, 0x6C, 0xF0,
+    0x40, 0x31, 0x6C, 0xF0, 0x07, 0x37, 0x6C, 0xF0, 0x40, 0x55, 0x32, 0x6C, 0xF0, 0x07, 0x38, 0x6C,
+    0xF0, 0x40, 0x33, 0x6C, 0xF0, 0x07, 0x39, 0x6C, 0xF0, 0x40, 0xCD, 0x34, 0x6C, 0xF0, 0x06, 0x32,
+    0x30, 0x6C, 0xF0, 0x3B, 0xAE, 0xF1, 0x00, 0x41, 0x4E, 0xFF, 0x20, 0x73, 0x74, 0x61, 0x74, 0x69,
+    0x73, 0x74, 0xF7, 0x69, 0x63, 0x73, 0x6B, 0x90, 0x38, 0x0A, 0x53, 0x75, 0xFF, 0x62, 0x4E, 0x75,
+    0x6D, 0x62, 0x65, 0x72, 0x3D, 0xE3, 0x31, 0x31, 0x3E, 0x40, 0xAB, 0x00, 0x5E, 0xE2, 0x6D, 0x61,
+    0x78, 0xFD, 0x20, 0x17, 0x00, 0x2D, 0x69, 0x6E, 0x64, 0x65, 0x78, 0x2A, 0xAD, 0xF0, 0x0A, 0x35,
+    0xAD, 0xA0, 0x6F, 0xAD, 0xF0, 0x09, 0x31, 0xAE, 0x50, 0x1B, 0x11, 0x90, 0x87, 0xF1, 0x07, 0x19,
+    0xF1, 0x3C, 0x6A, 0x00, 0x5F, 0xF2, 0x07, 0x32, 0x6A, 0xF0, 0x3F, 0x5D, 0xF2, 0x07, 0x33, 0x54,
+    0x6A, 0xF0, 0x3F, 0x5B, 0xF2, 0x07, 0x34, 0x6A, 0xF0, 0x3F, 0x35, 0x6A, 0xF0, 0x06, 0x35, 0x6A,
+    0xF0, 0x3F, 0x55, 0x36, 0x6A, 0xF0, 0x06, 0x36, 0x6A, 0xF0, 0x3F, 0x37, 0x6A, 0xF0, 0x06, 0x37,
+    0x6A, 0xF0, 0x3F, 0x55, 0x38, 0x6A, 0xF0, 0x06, 0x38, 0x6A, 0xF0, 0x3F, 0x39, 0x6A, 0xF0, 0x06,
+    0x39, 0x6A, 0xF0, 0x3F, 0xE5, 0x41, 0xC2, 0xF3, 0x07, 0x30, 0x6B, 0xF0, 0x3B, 0xBF, 0xE3, 0x42,
+    0x75, 0x73, 0xDF, 0x20, 0x6C, 0x6F, 0x61, 0x64, 0x65, 0x90, 0x38, 0x0A, 0xFF, 0x53, 0x75, 0x62,
+    0x4E, 0x75, 0x6D, 0x62, 0x65, 0xA7, 0x72, 0x3D, 0x34, 0x37, 0x40, 0xA3, 0x00, 0x30, 0x3B, 0xD0,
+    0x6D, 0xF7, 0x61, 0x78, 0x20, 0x17, 0x00, 0x2D, 0x69, 0x6E, 0x64, 0xAB, 0x65, 0x78, 0xA6, 0xF0,
+    0x0A, 0x35, 0xA6, 0xA0, 0x6F, 0xA6, 0xF0, 0x09, 0x33, 0x6A, 0x6E, 0x70, 0x31, 0x6E, 0xD0, 0x4C,
+    0xA6, 0x00, 0x20, 0x31, 0x67, 0xF0, 0x0A, 0x15, 0x36, 0x0E, 0xB1, 0x72, 0x68, 0x90, 0x31, 0x0F,
+    0xF1, 0x04, 0x68, 0x00, 0x13, 0xE1, 0x2A, 0x68, 0x20, 0x32, 0x68, 0xF0, 0x40, 0x33, 0x68, 0xF0,
+    0x03, 0x33, 0x68, 0xF0, 0x3C, 0x64, 0xE0, 0xFF, 0x50, 0x43, 0x20, 0x73, 0x61, 0x6D, 0x70, 0x6C,
+    0x04, 0x32, 0x00, 0xE4, 0xF1, 0x06, 0x35, 0x3A, 0x40, 0xE4, 0xF1, 0x55, 0x53, 0x42, 0x6E, 0x10,
+    0xE4, 0xE1, 0x00, 0xF7, 0x62, 0xF6, 0xF2, 0x3B, 0x6A, 0x10, 0xE6, 0xE1, 0x6A, 0x50, 0xE9, 0xF1,
+    0x0B, 0x6A, 0xF0, 0x23, 0x83, 0xE1, 0x28, 0x6A, 0x50, 0xEB, 0xF1, 0x0B, 0x6A, 0xF0, 0x23, 0x34,
+    0x6A, 0xF0, 0x06, 0x34, 0x6A, 0xF0, 0x3B, 0x66, 0xE0, 0x7E, 0x55, 0x02, 0x68, 0x69, 0x73, 0x74,
+    0x6F, 0x67, 0x14, 0x00, 0xD2, 0x69, 0xF0, 0x0A, 0x46, 0x15, 0xF2, 0x0A, 0x5A, 0x20, 0x35, 0x5A,
+    0xD0, 0x54, 0x69, 0x7F, 0x63, 0x6B, 0x20, 0x73, 0x74, 0x61, 0x74, 0x5F, 0x00, 0x57, 0x69, 0x63,
+    0x73, 0xB4, 0xF2, 0x06, 0x31, 0x46, 0x42, 0x35, 0xB5, 0xF2, 0x55, 0x03, 0x31, 0x33, 0x6F, 0x70,
+    0xB6, 0xF2, 0x55, 0x6A, 0x10, 0xB6, 0xF2, 0x55, 0x6A, 0x10, 0xB6, 0xF2, 0x55, 0xA0, 0x6A, 0x10,
+    0xB6, 0xF2, 0x55, 0x6A, 0x10, 0x5F, 0xE2, 0x6A, 0x50, 0x35, 0x6A, 0xF0, 0x3F, 0x36, 0xAA, 0x6A,
+    0xF0, 0x06, 0x36, 0x6A, 0xF0, 0x3F, 0x37, 0x6A, 0xF0, 0x06, 0x37, 0x6A, 0xF0, 0x3F, 0x38, 0xAA,
+    0x6A, 0xF0, 0x06, 0x38, 0x6A, 0xF0, 0x3F, 0x39, 0x6A, 0xF0, 0x06, 0x39, 0x6A, 0xF0, 0x3F, 0x41,
+    0xAA, 0xC2, 0xF3, 0x07, 0x30, 0x6B, 0xF0, 0x3F, 0x42, 0x6B, 0xF0, 0x07, 0x31, 0x6B, 0xF0, 0x3F,
+    0x43, 0x2A, 0x6B, 0xF0, 0x07, 0x32, 0x6B, 0xF0, 0x3F, 0x44, 0x6B, 0xF0, 0x07, 0x33, 0x6B, 0xF0,
+    0x3B, 0x57, 0xF3, 0x00, 0xFF, 0x41, 0x4E, 0x20, 0x72, 0x65, 0x63, 0x6F, 0x72, 0xF7, 0x64, 0x65,
+    0x72, 0x69, 0x90, 0x38, 0x0A, 0x53, 0x75, 0xFF, 0x62, 0x4E, 0x75, 0x6D, 0x62, 0x65, 0x72, 0x3D,
+    0xE8, 0x5B, 0x01, 0x3C, 0x30, 0xA8, 0x00, 0x30, 0x40, 0xD0, 0x6D, 0x61, 0x78, 0xFD, 0x20, 0x17,
+    0x00, 0x2D, 0x69, 0x6E, 0x64, 0x65, 0x78, 0x8A, 0xAB, 0xF0, 0x0A, 0x35, 0xAB, 0xA0, 0x6F, 0xAB,
+    0xF0, 0x09, 0x37, 0x02, 0x6F, 0x60, 0x31, 0x24, 0x6F, 0xD0, 0x0D, 0x60, 0x20, 0xF1, 0xF1, 0x3C,
+    0x6C, 0x10, 0x32, 0x6C, 0xF0, 0x08, 0xF2, 0xF1, 0x3C, 0xA2, 0x6C, 0x10, 0x33, 0x6C, 0xF0, 0x08,
+    0xF3, 0xF1, 0x3D, 0x6C, 0x00, 0x34, 0x6C, 0xF0, 0x08, 0x34, 0x8A, 0x6C, 0xF0, 0x3F, 0x35, 0x6C,
+    0xF0, 0x08, 0x35, 0x6C, 0xF0, 0x3F, 0xD1, 0xE2, 0x6C, 0x70, 0x36, 0xAA, 0x6C, 0xF0, 0x3F, 0x37,
+    0x6C, 0xF0, 0x08, 0x37, 0x6C, 0xF0, 0x3F, 0x38, 0x6C, 0xF0, 0x08, 0x38, 0xAA, 0x6C, 0xF0, 0x3F,
+    0x39, 0x6C, 0xF0, 0x08, 0x39, 0x6C, 0xF0, 0x3F, 0x41, 0xD4, 0xF3, 0x09, 0x30, 0xFC, 0x6D, 0xF0,
+    0x3B, 0xB0, 0xE1, 0x43, 0x41, 0x4E, 0x20, 0x72, 0x65, 0x2F, 0x63, 0x6F, 0x72, 0x64, 0x6C, 0x00,
+    0x64, 0x5C, 0x00, 0x6E, 0xF0, 0x0A, 0xC5, 0x46, 0x6E, 0xA0, 0x6F, 0x6E, 0xB0, 0x5F, 0x20, 0xA3,
+    0xE1, 0x53, 0x59, 0xBF, 0x4E, 0x43, 0x20, 0x50, 0x4C, 0x4C, 0x56, 0x90, 0x38, 0xFF, 0x0A, 0x53,
+    0x75, 0x62, 0x4E, 0x75, 0x6D, 0x62, 0x4F, 0x65, 0x72, 0x3D, 0x36, 0x37, 0x40, 0x05, 0x01, 0x30,
+    0x3B, 0xD0, 0xEF, 0x6D, 0x61, 0x78, 0x20, 0x17, 0x00, 0x2D, 0x69, 0x6E, 0x97, 0x64, 0x65, 0x78,
+    0x97, 0xF0, 0x0A, 0x35, 0x97, 0xF0, 0x0A, 0x06, 0xA1, 0x35, 0xA2, 0x6E, 0x70, 0x31, 0x74, 0xF1,
+    0x09, 0x73, 0xF1, 0x3B, 0x6C, 0x10, 0x32, 0x6C, 0xF0, 0x08, 0x32, 0xAA, 0x6C, 0xF0, 0x3F, 0x33,
+    0x6C, 0xF0, 0x08, 0x33, 0x6C, 0xF0, 0x3F, 0x34, 0x6C, 0xF0, 0x08, 0x34, 0xCA, 0x6C, 0xF0, 0x3F,
+    0x35, 0x6C, 0xF0, 0x08, 0x35, 0x6C, 0xF0, 0x3B, 0xFE, 0xE3, 0x42, 0x6F, 0x7F, 0x6F, 0x74, 0x20,
+    0x74, 0x69, 0x6D, 0x65, 0xC8, 0xF2, 0x06, 0x49, 0x38, 0x38, 0x40, 0xC8, 0xF2, 0x55, 0x37, 0x6E,
+    0x70, 0xC8, 0xE2, 0x54, 0xA6, 0x00, 0x00, 0xC3, 0xF2, 0x1A, 0x67, 0xF0, 0x0A, 0x0F, 0x51, 0xC3,
+    0xF2, 0x02, 0x67, 0x20, 0xBE, 0xF2, 0x19, 0x67, 0xF0, 0x15, 0xBE, 0xE2, 0x00, 0x67, 0x20, 0xB9,
+    0xF2, 0x19, 0x67, 0xF0, 0x15, 0xB9, 0xE2, 0x67, 0x20, 0xB4, 0xF2, 0x19, 0x67, 0xF0, 0x15, 0xB4,
+    0xE2, 0xA8, 0x67, 0x20, 0xAF, 0xF2, 0x19, 0x67, 0xF0, 0x15, 0x36, 0x67, 0xF0, 0x03, 0x36, 0x67,
+    0xF0, 0x3F, 0x37, 0xEA, 0x67, 0xF0, 0x03, 0x37, 0x67, 0xF0, 0x3B, 0x41, 0x63, 0xD0, 0x57, 0x6F,
+    0x72, 0xBF, 0x73, 0x74, 0x20, 0x63, 0x61, 0x73, 0x80, 0xF3, 0x07, 0x32, 0x49, 0x31, 0x3A, 0x40,
+    0x81, 0xF3, 0x55, 0x32, 0xAA, 0x50, 0x82, 0xF3, 0x32, 0x77, 0x12, 0xF1, 0x11, 0x00, 0x82, 0xF3,
+    0x32, 0x67, 0xF0, 0x15, 0x82, 0xF3, 0x2F, 0x67, 0xF0, 0x15, 0x82, 0xF3, 0x2F, 0x67, 0xF0, 0x15,
+    0x82, 0xF3, 0x2F, 0x67, 0xF0, 0x15, 0x50, 0x82, 0xF3, 0x2F, 0x67, 0xF0, 0x15, 0x82, 0xF3, 0x2F,
+    0x67, 0xF0, 0x15, 0x38, 0x67, 0xF0, 0x03, 0x38, 0x67, 0xF0, 0x3F, 0x55, 0x39, 0x67, 0xF0, 0x03,
+    0x39, 0x67, 0xF0, 0x3F, 0x41, 0xA7, 0xF3, 0x04, 0x30, 0x68, 0xF0, 0x3F, 0x55, 0x42, 0x68, 0xF0,
+    0x04, 0x31, 0x68, 0xF0, 0x3F, 0x43, 0x68, 0xF0, 0x04, 0x32, 0x68, 0xF0, 0x3F, 0x55, 0x44, 0x68,
+    0xF0, 0x04, 0x33, 0x68, 0xF0, 0x3F, 0x45, 0x68, 0xF0, 0x04, 0x34, 0x68, 0xF0, 0x3F, 0xB5, 0x46,
+    0x68, 0xF0, 0x04, 0x35, 0x68, 0xF0, 0x3F, 0x31, 0x30, 0x69, 0xF0, 0x04, 0x36, 0xAA, 0x69, 0xF0,
+    0x40, 0x31, 0x69, 0xF0, 0x04, 0x37, 0x69, 0xF0, 0x40, 0x32, 0x69, 0xF0, 0x04, 0x38, 0xAA, 0x69,
+    0xF0, 0x40, 0x33, 0x69, 0xF0, 0x04, 0x39, 0x69, 0xF0, 0x40, 0x34, 0x69, 0xF0, 0x03, 0x32, 0xF5,
+    0x30, 0x69, 0xF0, 0x3B, 0x42, 0x64, 0xE0, 0x58, 0x20, 0x6C, 0x61, 0xDF, 0x74, 0x65, 0x6E, 0x63,
+    0x79, 0x67, 0x90, 0x38, 0x0A, 0xFF, 0x53, 0x75, 0x62, 0x4E, 0x75, 0x6D, 0x62, 0x65, 0xC3, 0x72,
+    0x3D, 0x65, 0x03, 0x3A, 0x30, 0xA4, 0x00, 0x4B, 0xE2, 0x6D, 0x61, 0xFB, 0x78, 0x20, 0x17, 0x00,
+    0x2D, 0x69, 0x6E, 0x64, 0x65, 0xD5, 0x78, 0xA9, 0xF0, 0x0A, 0x35, 0xA9, 0xA0, 0x6F, 0xA9, 0xF0,
+    0x09, 0x31, 0x32, 0x18, 0x6F, 0x70, 0x51, 0xE2, 0x0D, 0x60, 0x20, 0x31, 0x17, 0xF1, 0x3C, 0x6C,
+    0x00, 0x54, 0xE2, 0x22, 0x6C, 0x70, 0x32, 0x6C, 0xF0, 0x3F, 0x57, 0xE2, 0x6C, 0x70, 0x33, 0x6C,
+    0xF0, 0x3F, 0x5A, 0xE2, 0xAA, 0x6C, 0x70, 0x34, 0x6C, 0xF0, 0x3F, 0x35, 0x6C, 0xF0, 0x08, 0x35,
+    0x6C, 0xF0, 0x3F, 0x36, 0xAA, 0x6C, 0xF0, 0x08, 0x36, 0x6C, 0xF0, 0x3F, 0x37, 0x6C, 0xF0, 0x08,
+    0x37, 0x6C, 0xF0, 0x3F, 0x38, 0xAA, 0x6C, 0xF0, 0x08, 0x38, 0x6C, 0xF0, 0x3F, 0x39, 0x6C, 0xF0,
+    0x08, 0x39, 0x6C, 0xF0, 0x3F, 0x41, 0xAA, 0xD4, 0xF3, 0x09, 0x30, 0x6D, 0xF0, 0x3F, 0x42, 0x6D,
+    0xF0, 0x09, 0x31, 0x6D, 0xF0, 0x3F, 0x43, 0xF2, 0x6D, 0xF0, 0x09, 0x32, 0x6D, 0xF0, 0x3B, 0x69,
+    0xE0, 0x47, 0x6F, 0x76, 0x65, 0xEF, 0x72, 0x6E, 0x6F, 0x72, 0x65, 0x90, 0x38, 0x0A, 0x53, 0xFF,
+    0x75, 0x62, 0x4E, 0x75, 0x6D, 0x62, 0x65, 0x72, 0xD3, 0x3D, 0x35, 0x37, 0x40, 0xA5, 0x00, 0x30,
+    0x3B, 0xD0, 0x6D, 0x61, 0xFB, 0x78, 0x20, 0x17, 0x00, 0x2D, 0x69, 0x6E, 0x64, 0x65, 0x55, 0x78,
+    0xA6, 0xF0, 0x0A, 0x35, 0xA6, 0xA0, 0x6F, 0xA6, 0xF0, 0x09, 0x34, 0x6E, 0x70, 0x11, 0x31, 0x14,
+    0xF1, 0x09, 0x13, 0xF1, 0x3C, 0x6C, 0x00, 0x32, 0x6C, 0xF0, 0x08, 0x80, 0xF1, 0x3D, 0x6C, 0x00,
+    0x55, 0x33, 0x6C, 0xF0, 0x08, 0x33, 0x6C, 0xF0, 0x3F, 0x34, 0x6C, 0xF0, 0x08, 0x34, 0x6C, 0xF0,
+    0x39, 0xFB, 0x33, 0x30, 0xAF, 0xE1, 0x54, 0x72, 0x61, 0x63, 0x65, 0x7F, 0x20, 0x63, 0x6F, 0x6E,
+    0x66, 0x69, 0x67, 0x69, 0x90, 0x25, 0x39, 0x5E, 0x82, 0x39, 0x3B, 0x40, 0x5E, 0xF2, 0x55, 0x38,
+    0x6E, 0x70, 0xAE, 0xE0, 0x6F, 0x53, 0x69, 0x7A, 0x65, 0x10, 0xF1, 0x34, 0x31, 0x30, 0x12, 0x51,
+    0xFE, 0x59, 0xF2, 0x02, 0x41, 0x78, 0x69, 0x73, 0x20, 0x6E, 0x6F, 0x40, 0xD0, 0xF0, 0x18, 0x6A,
+    0xF0, 0x0B, 0x68, 0x70, 0x55, 0xE2, 0x04, 0x10, 0x65, 0xF0, 0x0A, 0x39, 0x65, 0xF0, 0x17, 0xC6,
+    0xC9, 0x21, 0x31, 0x20, 0x00, 0xF0, 0x05, 0x82, 0x70, 0x6B, 0xE2, 0x43, 0x6F, 0x77, 0x6C, 0x6F,
+    0x72, 0x83, 0xF0, 0x34, 0x72, 0x65, 0x64, 0x79, 0xF0, 0x09, 0xB1, 0x35, 0x79, 0xD0, 0x45, 0x00,
+    0xDD, 0xF2, 0x35, 0x78, 0x36, 0x2F, 0x00, 0x30, 0xEB, 0x31, 0x30, 0x3B, 0x82, 0x36, 0x6D, 0xD0,
+    0x46, 0x6F, 0x72, 0xD7, 0x6D, 0x61, 0x74, 0xD2, 0xF1, 0x3F, 0x37, 0x52, 0xF3, 0x00, 0x69, 0x67,
+    0xA3, 0x67, 0x65, 0x51, 0xF1, 0x0B, 0x68, 0xF0, 0x18, 0xA4, 0x82, 0x38, 0x68, 0xE0, 0x68, 0x7F,
+    0x72, 0x65, 0x73, 0x68, 0x6F, 0x6C, 0x64, 0x6A, 0xF0, 0x0A, 0xF1, 0x34, 0x6A, 0xF0, 0x1E, 0x0B,
+    0xE3, 0x58, 0x22, 0x20, 0x63, 0x6F, 0x6E, 0xF7, 0x66, 0x69, 0x67, 0x69, 0x90, 0x39, 0x0A, 0x53,
+    0x75, 0x7F, 0x62, 0x4E, 0x75, 0x6D, 0x62, 0x65, 0x72, 0x0B, 0x00, 0xF4, 0x3B, 0x30, 0xA6, 0x00,
+    0x30, 0x3F, 0xD0, 0x6D, 0x61, 0x78, 0x20, 0x7E, 0x17, 0x00, 0x2D, 0x69, 0x6E, 0x64, 0x65, 0x78,
+    0x15, 0xF1, 0x18, 0xD1, 0x6F, 0xAA, 0xF0, 0x09, 0xE6, 0x41, 0x6E, 0x10, 0x31, 0x6E, 0xD0, 0x53,
+    0x69, 0xE1, 0x7A, 0x51, 0xF3, 0x0B, 0x55, 0xF2, 0x19, 0x65, 0x70, 0x14, 0xE1, 0x41, 0x78, 0x69,
+    0x4F, 0x73, 0x20, 0x6E, 0x6F, 0xE4, 0xF1, 0x3B, 0x68, 0x10, 0x33, 0x68, 0xD0, 0x88, 0x04, 0x10,
+    0x9C, 0xF3, 0x34, 0xC7, 0x21, 0x32, 0x9F, 0xE3, 0xA6, 0xA3, 0x82, 0x10, 0x34, 0x9E, 0x82, 0xD0,
+    0x43, 0x6F, 0x6C, 0x6F, 0xCE, 0xF2, 0x0B, 0x83, 0xF0, 0x18, 0x67, 0x2F, 0x72, 0x65, 0x65, 0x6E,
+    0x79, 0xF0, 0x07, 0x35, 0x79, 0xD0, 0x45, 0x00, 0xD0, 0xCA, 0xF1, 0x35, 0x2E, 0x10, 0x00, 0x20,
+    0x6D, 0x70, 0x36, 0x6D, 0xD0, 0x46, 0x6F, 0xAF, 0x72, 0x6D, 0x61, 0x74, 0xD2, 0xF1, 0x3F, 0x37,
+    0x50, 0xF3, 0x00, 0x69, 0xA7, 0x67, 0x67, 0x65, 0x51, 0xF1, 0x0B, 0x68, 0xF0, 0x23, 0x38, 0x68,
+    0xE0, 0x68, 0x7F, 0x72, 0x65, 0x73, 0x68, 0x6F, 0x6C, 0x64, 0x6A, 0xF0, 0x0A, 0xCD, 0x34, 0x6A,
+    0xF0, 0x1C, 0x34, 0x30, 0xE0, 0xE3, 0x58, 0x22, 0x20, 0x65, 0x8F, 0x6E, 0x61, 0x62, 0x6C, 0xAA,
+    0xF2, 0x0B, 0xD4, 0xC0, 0x6A, 0xA0, 0x31, 0xF0, 0x6A, 0xF0, 0x03, 0xDC, 0xE3, 0x6A, 0x20, 0x63,
+    0x90, 0x39, 0x0A, 0x53, 0x75, 0x7F, 0x62, 0x4E, 0x75, 0x6D, 0x62, 0x65, 0x72, 0x6F, 0x00, 0x78,
+    0x34, 0x30, 0x0A, 0x01, 0xA3, 0xE0, 0x6D, 0x61, 0x78, 0x20, 0x17, 0x00, 0xBF, 0x2D, 0x69, 0x6E,
+    0x64, 0x65, 0x78, 0xA4, 0xF0, 0x18, 0x6F, 0x72, 0x0E, 0xF1, 0x09, 0x36, 0x6E, 0x70, 0xA7, 0xE0,
+    0x53, 0x69, 0x7A, 0x0A, 0xF1, 0x0B, 0x08, 0xB9, 0xC2, 0x0A, 0xF1, 0x12, 0x66, 0x00, 0x32, 0x66,
+    0xD0, 0x21, 0x20, 0xDC, 0xF1, 0x19, 0x67, 0xF0, 0x15, 0x2D, 0x33, 0x87, 0xE3, 0x69, 0x6E, 0x65,
+    0xF0, 0x40, 0x34, 0xED, 0xF3, 0x00, 0x99, 0xF1, 0x0B, 0xBA, 0x65, 0xF0, 0x24, 0x35, 0x65, 0xD0,
+    0x50, 0x6C, 0x6F, 0xE3, 0xF3, 0x0B, 0x46, 0xF4, 0x00, 0xF2, 0x17, 0x65, 0x80, 0x36, 0xE3, 0xF3,
+    0x05, 0x20, 0x74, 0x69, 0x6D, 0x08, 0x08, 0xF2, 0x3D, 0x04, 0xE2, 0x13, 0xF3, 0x12, 0x32, 0x13,
+    0xF3, 0x5C, 0x6E, 0x10, 0x13, 0xF3, 0x51, 0x66, 0x10, 0x00, 0x13, 0xF3, 0x52, 0x67, 0x10, 0x13,
+    0xF3, 0x50, 0x65, 0x10, 0x13, 0xF3, 0x50, 0x65, 0x10, 0x13, 0xF3, 0x50, 0x65, 0x10, 0xF2, 0x13,
+    0xF3, 0x56, 0x36, 0x32, 0x00, 0x6A, 0xD0, 0x52, 0x65, 0x61, 0x64, 0xFF, 0x20, 0x69, 0x6E, 0x70,
+    0x75, 0x74, 0x20, 0x38, 0x57, 0x20, 0x62, 0x69, 0xDC, 0xA0, 0x38, 0x1E, 0x83, 0x39, 0x3F, 0x40,
+    0x12, 0x1E, 0xF3, 0x55, 0x38, 0x6E, 0x70, 0x1E, 0xE3, 0x49, 0xAD, 0x10, 0x66, 0xF0, 0x25, 0x15,
+    0xD1, 0x00, 0x2E, 0x00, 0x69, 0x70, 0x21, 0xE3, 0x69, 0xF0, 0x47, 0x23, 0xE3, 0x69, 0xF0, 0x47,
+    0x27, 0xE3, 0x69, 0xF0, 0x47, 0x50, 0x2B, 0xE3, 0x69, 0xF0, 0x47, 0x2F, 0xE3, 0x69, 0xF0, 0x47,
+    0x37, 0x69, 0xF0, 0x57, 0x38, 0x69, 0xF0, 0x51, 0xFD, 0x32, 0xFE, 0xF3, 0x00, 0x57, 0x72, 0x69,
+    0x74, 0x65, 0x20, 0xF7, 0x6F, 0x75, 0x74, 0x6C, 0x00, 0x20, 0x38, 0x20, 0x62, 0xFD, 0x69, 0x72,
+    0xA0, 0x38, 0x0A, 0x53, 0x75, 0x62, 0x4E, 0x7F, 0x75, 0x6D, 0x62, 0x65, 0x72, 0x3D, 0x39, 0x41,
+    0x40, 0xBC, 0xAB, 0x00, 0x45, 0xE0, 0x6D, 0x61, 0x78, 0x20, 0x17, 0x00, 0x2D, 0x5F, 0x69, 0x6E,
+    0x64, 0x65, 0x78, 0xB3, 0xF0, 0x25, 0x30, 0xB3, 0xB0, 0x95, 0x38, 0x6E, 0x70, 0x31, 0x6E, 0xD0,
+    0x4F, 0xAE, 0x20, 0x67, 0xF0, 0x18, 0x77, 0xA9, 0x77, 0x1C, 0xF1, 0x14, 0x6B, 0x00, 0x32, 0x6B,
+    0xF0, 0x59, 0x33, 0x6B, 0xF0, 0x59, 0x34, 0xAA, 0x6B, 0xF0, 0x59, 0x35, 0x6B, 0xF0, 0x59, 0x36,
+    0x6B, 0xF0, 0x59, 0x37, 0x6B, 0xF0, 0x59, 0x38, 0xF6, 0x6B, 0xF0, 0x53, 0x34, 0x30, 0x5B, 0xE3,
+    0x52, 0x65, 0x61, 0x64, 0xFF, 0x20, 0x61, 0x6E, 0x61, 0x6C, 0x6F, 0x67, 0x75, 0xEF, 0x65, 0x20,
+    0x69, 0x6E, 0x74, 0x00, 0x20, 0x31, 0x36, 0xF7, 0x20, 0x62, 0x69, 0x7B, 0xA0, 0x38, 0x0A, 0x53,
+    0x75, 0xFF, 0x62, 0x4E, 0x75, 0x6D, 0x62, 0x65, 0x72, 0x3D, 0xD3, 0x31, 0x33, 0x4A, 0x40, 0xB6,
+    0x00, 0x30, 0x4E, 0xD0, 0x6D, 0x61, 0xFB, 0x78, 0x20, 0x17, 0x00, 0x2D, 0x69, 0x6E, 0x64, 0x65,
+    0xD5, 0x78, 0xBD, 0xF0, 0x18, 0x6F, 0xBC, 0x90, 0x30, 0xBC, 0xB0, 0x31, 0x32, 0x24, 0x6F, 0x70,
+    0xBE, 0xE0, 0x49, 0xB0, 0x10, 0x67, 0xF0, 0x0A, 0x33, 0x67, 0xF0, 0x08, 0x24, 0xD1, 0xAA, 0x66,
+    0x70, 0x32, 0x66, 0xF0, 0x54, 0x33, 0x66, 0xF0, 0x54, 0x34, 0x66, 0xF0, 0x54, 0x35, 0x82, 0x66,
+    0xF0, 0x54, 0x36, 0x66, 0xF0, 0x54, 0xFC, 0xE3, 0x66, 0xF0, 0x44, 0xF7, 0xE3, 0x66, 0xF0, 0x44,
+    0x39, 0xAA, 0x66, 0xF0, 0x54, 0x41, 0x66, 0xF0, 0x54, 0x42, 0x66, 0xF0, 0x54, 0x43, 0x66, 0xF0,
+    0x4F, 0x31, 0xFD, 0x31, 0x62, 0xD0, 0x57, 0x72, 0x69, 0x74, 0x65, 0x20, 0xFF, 0x61, 0x6E, 0x61,
+    0x6C, 0x6F, 0x67, 0x75, 0x65, 0xEF, 0x20, 0x6F, 0x75, 0x74, 0x72, 0x00, 0x20, 0x31, 0x36, 0xF7,
+    0x20, 0x62, 0x69, 0x79, 0xA0, 0x38, 0x0A, 0x53, 0x75, 0xFF, 0x62, 0x4E, 0x75, 0x6D, 0x62, 0x65,
+    0x72, 0x3D, 0xE9, 0x39, 0x4B, 0x40, 0xB2, 0x00, 0x30, 0x4F, 0xD0, 0x6D, 0x61, 0x78, 0xFD, 0x20,
+    0x17, 0x00, 0x2D, 0x69, 0x6E, 0x64, 0x65, 0x78, 0x2A, 0xBA, 0xF0, 0x0A, 0x35, 0xBA, 0xF0, 0x08,
+    0x30, 0xBA, 0xB0, 0x38, 0x6E, 0x70, 0xBE, 0xE0, 0x99, 0x4F, 0xAF, 0x20, 0x22, 0xF1, 0x18, 0x77,
+    0x77, 0x23, 0xF1, 0x11, 0x68, 0x00, 0x32, 0xAA, 0x68, 0xF0, 0x56, 0x33, 0x68, 0xF0, 0x56, 0x34,
+    0x68, 0xF0, 0x56, 0x35, 0x68, 0xF0, 0x56, 0x36, 0x0A, 0x68, 0xF0, 0x56, 0x37, 0x68, 0xF0, 0x56,
+    0x38, 0x68, 0xF0, 0x4D,
+};
+
+const uint32_t CO_EDS_imageSize = sizeof(CO_EDS_image);
+
+#endif
@@ -68,6 +68,10 @@ struct sCO_OD_RAM CO_OD_RAM = {
 /*1003*/ {0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L},
 /*1010*/ {0x3L},
 /*1011*/ {0x1L},
+/*1013*/ 0x0L,
+/*1F51*/ {0x1},
+/*1F56*/ {0x0L},
+/*1F57*/ {0x0L},
 /*2100*/ {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
 /*2103*/ 0x0,
 /*2104*/ 0x0,
@@ -77,6 +81,20 @@ struct sCO_OD_RAM CO_OD_RAM = {
 /*2110*/ {0L, 0L, 0L, 0L, 0L, 0L, 0L, 0L, 0L, 0L, 0L, 0L, 0L, 0L, 0L, 0L},
 /*2120*/ {0x5, 0x1234567890ABCDEFLL, 0x234567890ABCDEF1LL, 12.345, 456.789, 0},
 /*2130*/ {0x3, {'-', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' '}, 0, 0x0L},
+/*2140*/ {0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L},
+/*2141*/ {0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L},
+/*2142*/ {0x0, 0x0, 0x0},
+/*2143*/ {0x0L, 0x0L, 0x0L, 0x0L},
+/*2145*/ {0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L},
+/*2146*/ {0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L},
+/*2148*/ {0x0L, 0x0L, 0x0L, 0x0L, 0x0L},
+/*2149*/ {0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L},
+/*214A*/ {0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L},
+/*214B*/ {0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L},
+/*214C*/ {0x0L, 0x0L, 0x0L, 0x0L},
+/*2400*/ 0x0,
+/*2401*/{{0x6, 0x0L, 0L, 0L, 0L, 0, 0x0L},
+/*2402*/ {0x6, 0x0L, 0L, 0L, 0L, 0, 0x0L}},
 /*6000*/ {0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0},
 /*6200*/ {0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0},
 /*6401*/ {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
@@ -97,22 +115,29 @@ struct sCO_OD_EEPROM CO_OD_EEPROM = {
 };
 
 
+/***** Definition for constant variables **************************************/
+const struct sCO_OD_FLASH CO_OD_FLASH = {    //read-only, not copied to RAM
+/*1000*/ 0x0L,
+/*1008*/ {'C', 'A', 'N', 'o', 'p', 'e', 'n', 'N', 'o', 'd', 'e'},
+/*1009*/ {'3', '.', '0', '0'},
+/*100A*/ {'3', '.', '0', '0'},
+/*1018*/ {0x4, 0x0L, 0x0L, 0x0L, 0x0L},
+/*1022*/ 0x0,
+};
+
+
 /***** Definition for ROM variables *******************************************/
-   struct sCO_OD_ROM CO_OD_ROM = {    //constant variables, stored in flash
+   struct sCO_OD_ROM CO_OD_ROM = {    //configuration, stored in eeprom
            CO_OD_FIRST_LAST_WORD,
 
-/*1000*/ 0x0L,
 /*1005*/ 0x80L,
 /*1006*/ 0x0L,
 /*1007*/ 0x0L,
-/*1008*/ {'C', 'A', 'N', 'o', 'p', 'e', 'n', 'N', 'o', 'd', 'e'},
-/*1009*/ {'3', '.', '0', '0'},
-/*100A*/ {'3', '.', '0', '0'},
+/*1012*/ 0x80000100L,
 /*1014*/ 0x80L,
 /*1015*/ 0x64,
 /*1016*/ {0x0L, 0x0L, 0x0L, 0x0L},
 /*1017*/ 0x3E8,
-/*1018*/ {0x4, 0x0L, 0x0L, 0x0L, 0x0L},
 /*1019*/ 0x0,
 /*1029*/ {0x0, 0x0, 0x1, 0x0, 0x0, 0x0},
 /*1200*/{{0x2, 0x600L, 0x580L}},
@@ -133,9 +158,13 @@ struct sCO_OD_EEPROM CO_OD_EEPROM = {
 /*1A02*/ {0x0, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L},
 /*1A03*/ {0x0, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L}},
 /*1F80*/ 0x0L,
+/*1FA0*/ {0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L},
+/*1FD0*/ {0x0LL, 0x0LL, 0x0LL, 0x0LL, 0x0LL, 0x0LL, 0x0LL, 0x0LL},
 /*2101*/ 0x30,
 /*2102*/ 0xFA,
 /*2111*/ {1L, 0L, 0L, 0L, 0L, 0L, 0L, 0L, 0L, 0L, 0L, 0L, 0L, 0L, 0L, 0L},
+/*2301*/{{0x8, 0x200L, 0x1, {'I', 'n', 'p', 'u', 't', 's', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' '}, {'r', 'e', 'd', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' '}, 0x60000108L, 0x7, 0x0, 0L},
+/*2302*/ {0x8, 0x200L, 0x1, {'B', 'u', 's', 'L', 'o', 'a', 'd', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' '}, {'g', 'r', 'e', 'e', 'n', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' '}, 0x21420210L, 0x7, 0x0, 0L}},
 
            CO_OD_FIRST_LAST_WORD
 };
@@ -145,11 +174,11 @@ struct sCO_OD_EEPROM CO_OD_EEPROM = {
    STRUCTURES FOR RECORD TYPE OBJECTS
 *******************************************************************************/
 /*0x1018*/ const CO_OD_entryRecord_t OD_record1018[5] = {
-           {(void*)&CO_OD_ROM.identity.maxSubIndex, 0x05,  1},
-           {(void*)&CO_OD_ROM.identity.vendorID, 0x85,  4},
-           {(void*)&CO_OD_ROM.identity.productCode, 0x85,  4},
-           {(void*)&CO_OD_ROM.identity.revisionNumber, 0x85,  4},
-           {(void*)&CO_OD_ROM.identity.serialNumber, 0x85,  4}};
+           {(void*)&CO_OD_FLASH.identity.maxSubIndex, 0x05,  1},
+           {(void*)&CO_OD_FLASH.identity.vendorID, 0x85,  4},
+           {(void*)&CO_OD_FLASH.identity.productCode, 0x85,  4},
+           {(void*)&CO_OD_FLASH.identity.revisionNumber, 0x85,  4},
+           {(void*)&CO_OD_FLASH.identity.serialNumber, 0x85,  4}};
 /*0x1200*/ const CO_OD_entryRecord_t OD_record1200[3] = {
            {(void*)&CO_OD_ROM.SDOServerParameter[0].maxSubIndex, 0x05,  1},
            {(void*)&CO_OD_ROM.SDOServerParameter[0].COB_IDClientToServer, 0x85,  4},
@@ -294,30 +323,70 @@ struct sCO_OD_EEPROM CO_OD_EEPROM = {
            {(void*)&CO_OD_RAM.time.string[0], 0x06, 30},
            {(void*)&CO_OD_RAM.time.epochTimeBaseMs, 0x8E,  8},
            {(void*)&CO_OD_RAM.time.epochTimeOffsetMs, 0xBE,  4}};
+/*0x2301*/ const CO_OD_entryRecord_t OD_record2301[9] = {
+           {(void*)&CO_OD_ROM.traceConfig[0].maxSubIndex, 0x05,  1},
+           {(void*)&CO_OD_ROM.traceConfig[0].size, 0x8D,  4},
+           {(void*)&CO_OD_ROM.traceConfig[0].axisNo, 0x0D,  1},
+           {(void*)&CO_OD_ROM.traceConfig[0].name[0], 0x0D, 30},
+           {(void*)&CO_OD_ROM.traceConfig[0].color[0], 0x0D, 20},
+           {(void*)&CO_OD_ROM.traceConfig[0].map, 0x8D,  4},
+           {(void*)&CO_OD_ROM.traceConfig[0].format, 0x0D,  1},
+           {(void*)&CO_OD_ROM.traceConfig[0].trigger, 0x0D,  1},
+           {(void*)&CO_OD_ROM.traceConfig[0].threshold, 0x8D,  4}};
+/*0x2302*/ const CO_OD_entryRecord_t OD_record2302[9] = {
+           {(void*)&CO_OD_ROM.traceConfig[1].maxSubIndex, 0x05,  1},
+           {(void*)&CO_OD_ROM.traceConfig[1].size, 0x8D,  4},
+           {(void*)&CO_OD_ROM.traceConfig[1].axisNo, 0x0D,  1},
+           {(void*)&CO_OD_ROM.traceConfig[1].name[0], 0x0D, 30},
+           {(void*)&CO_OD_ROM.traceConfig[1].color[0], 0x0D, 20},
+           {(void*)&CO_OD_ROM.traceConfig[1].map, 0x8D,  4},
+           {(void*)&CO_OD_ROM.traceConfig[1].format, 0x0D,  1},
+           {(void*)&CO_OD_ROM.traceConfig[1].trigger, 0x0D,  1},
+           {(void*)&CO_OD_ROM.traceConfig[1].threshold, 0x8D,  4}};
+/*0x2401*/ const CO_OD_entryRecord_t OD_record2401[7] = {
+           {(void*)&CO_OD_RAM.trace[0].maxSubIndex, 0x06,  1},
+           {(void*)&CO_OD_RAM.trace[0].size, 0xBE,  4},
+           {(void*)&CO_OD_RAM.trace[0].value, 0xA6,  4},
+           {(void*)&CO_OD_RAM.trace[0].min, 0xBE,  4},
+           {(void*)&CO_OD_RAM.trace[0].max, 0xBE,  4},
+           {0, 0x06,  0},
+           {(void*)&CO_OD_RAM.trace[0].triggerTime, 0xBE,  4}};
+/*0x2402*/ const CO_OD_entryRecord_t OD_record2402[7] = {
+           {(void*)&CO_OD_RAM.trace[1].maxSubIndex, 0x06,  1},
+           {(void*)&CO_OD_RAM.trace[1].size, 0xBE,  4},
+           {(void*)&CO_OD_RAM.trace[1].value, 0xA6,  4},
+           {(void*)&CO_OD_RAM.trace[1].min, 0xBE,  4},
+           {(void*)&CO_OD_RAM.trace[1].max, 0xBE,  4},
+           {0, 0x06,  0},
+           {(void*)&CO_OD_RAM.trace[1].triggerTime, 0xBE,  4}};
 
 
 /*******************************************************************************
    OBJECT DICTIONARY
 *******************************************************************************/
 const CO_OD_entry_t CO_OD[CO_OD_NoOfElements] = {
-{0x1000, 0x00, 0x85,  4, (void*)&CO_OD_ROM.deviceType},
+{0x1000, 0x00, 0x85,  4, (void*)&CO_OD_FLASH.deviceType},
 {0x1001, 0x00, 0x36,  1, (void*)&CO_OD_RAM.errorRegister},
 {0x1002, 0x00, 0xB6,  4, (void*)&CO_OD_RAM.manufacturerStatusRegister},
 {0x1003, 0x08, 0x8E,  4, (void*)&CO_OD_RAM.preDefinedErrorField[0]},
 {0x1005, 0x00, 0x8D,  4, (void*)&CO_OD_ROM.COB_ID_SYNCMessage},
 {0x1006, 0x00, 0x8D,  4, (void*)&CO_OD_ROM.communicationCyclePeriod},
 {0x1007, 0x00, 0x8D,  4, (void*)&CO_OD_ROM.synchronousWindowLength},
-{0x1008, 0x00, 0x05, 11, (void*)&CO_OD_ROM.manufacturerDeviceName[0]},
-{0x1009, 0x00, 0x05,  4, (void*)&CO_OD_ROM.manufacturerHardwareVersion[0]},
-{0x100A, 0x00, 0x05,  4, (void*)&CO_OD_ROM.manufacturerSoftwareVersion[0]},
+{0x1008, 0x00, 0x05, 11, (void*)&CO_OD_FLASH.manufacturerDeviceName[0]},
+{0x1009, 0x00, 0x05,  4, (void*)&CO_OD_FLASH.manufacturerHardwareVersion[0]},
+{0x100A, 0x00, 0x05,  4, (void*)&CO_OD_FLASH.manufacturerSoftwareVersion[0]},
 {0x1010, 0x01, 0x8E,  4, (void*)&CO_OD_RAM.storeParameters[0]},
 {0x1011, 0x01, 0x8E,  4, (void*)&CO_OD_RAM.restoreDefaultParameters[0]},
+{0x1012, 0x00, 0x8D,  4, (void*)&CO_OD_ROM.COB_ID_TIME},
+{0x1013, 0x00, 0xA6,  4, (void*)&CO_OD_RAM.highResolutionTimeStamp},
 {0x1014, 0x00, 0x85,  4, (void*)&CO_OD_ROM.COB_ID_EMCY},
 {0x1015, 0x00, 0x8D,  2, (void*)&CO_OD_ROM.inhibitTimeEMCY},
 {0x1016, 0x04, 0x8D,  4, (void*)&CO_OD_ROM.consumerHeartbeatTime[0]},
 {0x1017, 0x00, 0x8D,  2, (void*)&CO_OD_ROM.producerHeartbeatTime},
 {0x1018, 0x04, 0x00,  0, (void*)&OD_record1018},
 {0x1019, 0x00, 0x0D,  1, (void*)&CO_OD_ROM.synchronousCounterOverflowValue},
+{0x1021, 0x00, 0x06,  0, 0},
+{0x1022, 0x00, 0x05,  1, (void*)&CO_OD_FLASH.storageFormat},
 {0x1029, 0x06, 0x0D,  1, (void*)&CO_OD_ROM.errorBehavior[0]},
 {0x1200, 0x02, 0x00,  0, (void*)&OD_record1200},
 {0x1400, 0x02, 0x00,  0, (void*)&OD_record1400},
@@ -336,7 +405,14 @@ const CO_OD_entry_t CO_OD[CO_OD_NoOfElements] = {
 {0x1A01, 0x08, 0x00,  0, (void*)&OD_record1A01},
 {0x1A02, 0x08, 0x00,  0, (void*)&OD_record1A02},
 {0x1A03, 0x08, 0x00,  0, (void*)&OD_record1A03},
+{0x1F22, 0x7F, 0x0A,  0, 0},
+{0x1F50, 0x01, 0x0A,  0, 0},
+{0x1F51, 0x01, 0x0E,  1, (void*)&CO_OD_RAM.programControl[0]},
+{0x1F56, 0x01, 0x86,  4, (void*)&CO_OD_RAM.programSoftwareIdentification[0]},
+{0x1F57, 0x01, 0x86,  4, (void*)&CO_OD_RAM.flashStatusIdentification[0]},
 {0x1F80, 0x00, 0x8D,  4, (void*)&CO_OD_ROM.NMTStartup},
+{0x1FA0, 0x08, 0x8D,  4, (void*)&CO_OD_ROM.objectScannerList[0]},
+{0x1FD0, 0x08, 0x8D,  8, (void*)&CO_OD_ROM.objectDispatchingList[0]},
 {0x2100, 0x00, 0x36, 10, (void*)&CO_OD_RAM.errorStatusBits[0]},
 {0x2101, 0x00, 0x0D,  1, (void*)&CO_OD_ROM.CANNodeID},
 {0x2102, 0x00, 0x8D,  2, (void*)&CO_OD_ROM.CANBitRate},
@@ -351,6 +427,24 @@ const CO_OD_entry_t CO_OD[CO_OD_NoOfElements] = {
 {0x2112, 0x10, 0xFF,  4, (void*)&CO_OD_EEPROM.variableNVInt32[0]},
 {0x2120, 0x05, 0x00,  0, (void*)&OD_record2120},
 {0x2130, 0x03, 0x00,  0, (void*)&OD_record2130},
+{0x2140, 0x14, 0x8E,  4, (void*)&CO_OD_RAM.profile[0]},
+{0x2141, 0x0A, 0x8E,  4, (void*)&CO_OD_RAM.CANstatistics[0]},
+{0x2142, 0x03, 0xAE,  2, (void*)&CO_OD_RAM.busLoad[0]},
+{0x2143, 0x04, 0x8E,  4, (void*)&CO_OD_RAM.PCSampling[0]},
+{0x2144, 0x00, 0x06,  0, 0},
+{0x2145, 0x0D, 0x8E,  4, (void*)&CO_OD_RAM.tickStatistics[0]},
+{0x2146, 0x0A, 0x8E,  4, (void*)&CO_OD_RAM.CANrecorder[0]},
+{0x2147, 0x00, 0x06,  0, 0},
+{0x2148, 0x05, 0x8E,  4, (void*)&CO_OD_RAM.SYNCPLL[0]},
+{0x2149, 0x07, 0x86,  4, (void*)&CO_OD_RAM.bootTime[0]},
+{0x214A, 0x14, 0x8E,  4, (void*)&CO_OD_RAM.worstCase[0]},
+{0x214B, 0x0C, 0x8E,  4, (void*)&CO_OD_RAM.txLatency[0]},
+{0x214C, 0x04, 0x8E,  4, (void*)&CO_OD_RAM.governor[0]},
+{0x2301, 0x08, 0x00,  0, (void*)&OD_record2301},
+{0x2302, 0x08, 0x00,  0, (void*)&OD_record2302},
+{0x2400, 0x00, 0x3E,  1, (void*)&CO_OD_RAM.traceEnable},
+{0x2401, 0x06, 0x00,  0, (void*)&OD_record2401},
+{0x2402, 0x06, 0x00,  0, (void*)&OD_record2402},
 {0x6000, 0x08, 0x76,  1, (void*)&CO_OD_RAM.readInput8Bit[0]},
 {0x6200, 0x08, 0x3E,  1, (void*)&CO_OD_RAM.writeOutput8Bit[0]},
 {0x6401, 0x0C, 0xB6,  2, (void*)&CO_OD_RAM.readAnalogueInput16Bit[0]},
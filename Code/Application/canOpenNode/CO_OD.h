@@ -109,13 +109,16 @@
    #define CO_NO_RPDO                     4   //Associated objects: 1400, 1401, 1402, 1403, 1600, 1601, 1602, 1603
    #define CO_NO_TPDO                     4   //Associated objects: 1800, 1801, 1802, 1803, 1A00, 1A01, 1A02, 1A03
    #define CO_NO_NMT_MASTER               0   
-   #define CO_NO_TRACE                    0   
+   #define CO_NO_TRACE                    2   //Associated objects: 2301, 2302, 2400, 2401, 2402
+   #define CO_NO_LSS_SERVER               1   
+   #define CO_NO_LSS_CLIENT               0   
+   #define CO_NO_TIME                     1   //Associated objects: 1012, 1013
 
 
 /*******************************************************************************
    OBJECT DICTIONARY
 *******************************************************************************/
-   #define CO_OD_NoOfElements             55
+   #define CO_OD_NoOfElements             84
 
 
 /*******************************************************************************
@@ -191,6 +194,28 @@
                UNSIGNED32     epochTimeOffsetMs;
                }              OD_time_t;
 
+/*2301[2]   */ typedef struct{
+               UNSIGNED8      maxSubIndex;
+               UNSIGNED32     size;
+               UNSIGNED8      axisNo;
+               VISIBLE_STRING name[30];
+               VISIBLE_STRING color[20];
+               UNSIGNED32     map;
+               UNSIGNED8      format;
+               UNSIGNED8      trigger;
+               INTEGER32      threshold;
+               }              OD_traceConfig_t;
+
+/*2401[2]   */ typedef struct{
+               UNSIGNED8      maxSubIndex;
+               UNSIGNED32     size;
+               INTEGER32      value;
+               INTEGER32      min;
+               INTEGER32      max;
+               DOMAIN         plot;
+               UNSIGNED32     triggerTime;
+               }              OD_trace_t;
+
 
 /*******************************************************************************
    STRUCTURES FOR VARIABLES IN DIFFERENT MEMORY LOCATIONS
@@ -206,6 +231,10 @@ struct sCO_OD_RAM{
 /*1003      */ UNSIGNED32     preDefinedErrorField[8];
 /*1010      */ UNSIGNED32     storeParameters[1];
 /*1011      */ UNSIGNED32     restoreDefaultParameters[1];
+/*1013      */ UNSIGNED32     highResolutionTimeStamp;
+/*1F51      */ UNSIGNED8      programControl[1];
+/*1F56      */ UNSIGNED32     programSoftwareIdentification[1];
+/*1F57      */ UNSIGNED32     flashStatusIdentification[1];
 /*2100      */ OCTET_STRING   errorStatusBits[10];
 /*2103      */ UNSIGNED16     SYNCCounter;
 /*2104      */ UNSIGNED16     SYNCTime;
@@ -215,6 +244,19 @@ struct sCO_OD_RAM{
 /*2110      */ INTEGER32      variableInt32[16];
 /*2120      */ OD_testVar_t   testVar;
 /*2130      */ OD_time_t      time;
+/*2140      */ UNSIGNED32     profile[20];
+/*2141      */ UNSIGNED32     CANstatistics[10];
+/*2142      */ UNSIGNED16     busLoad[3];
+/*2143      */ UNSIGNED32     PCSampling[4];
+/*2145      */ UNSIGNED32     tickStatistics[13];
+/*2146      */ UNSIGNED32     CANrecorder[10];
+/*2148      */ UNSIGNED32     SYNCPLL[5];
+/*2149      */ UNSIGNED32     bootTime[7];
+/*214A      */ UNSIGNED32     worstCase[20];
+/*214B      */ UNSIGNED32     txLatency[12];
+/*214C      */ UNSIGNED32     governor[4];
+/*2400      */ UNSIGNED8      traceEnable;
+/*2401[2]   */ OD_trace_t     trace[2];
 /*6000      */ UNSIGNED8      readInput8Bit[8];
 /*6200      */ UNSIGNED8      writeOutput8Bit[8];
 /*6401      */ INTEGER16      readAnalogueInput16Bit[12];
@@ -234,22 +276,30 @@ struct sCO_OD_EEPROM{
 };
 
 
+/***** Structure for constant variables **************************************/
+/* Read-only entries, which are never written or stored. They stay in flash. */
+struct sCO_OD_FLASH{
+/*1000      */ UNSIGNED32     deviceType;
+/*1008      */ VISIBLE_STRING manufacturerDeviceName[11];
+/*1009      */ VISIBLE_STRING manufacturerHardwareVersion[4];
+/*100A      */ VISIBLE_STRING manufacturerSoftwareVersion[4];
+/*1018      */ OD_identity_t  identity;
+/*1022      */ UNSIGNED8      storageFormat;
+};
+
+
 /***** Structure for ROM variables ********************************************/
 struct sCO_OD_ROM{
                UNSIGNED32     FirstWord;
 
-/*1000      */ UNSIGNED32     deviceType;
 /*1005      */ UNSIGNED32     COB_ID_SYNCMessage;
 /*1006      */ UNSIGNED32     communicationCyclePeriod;
 /*1007      */ UNSIGNED32     synchronousWindowLength;
-/*1008      */ VISIBLE_STRING manufacturerDeviceName[11];
-/*1009      */ VISIBLE_STRING manufacturerHardwareVersion[4];
-/*100A      */ VISIBLE_STRING manufacturerSoftwareVersion[4];
+/*1012      */ UNSIGNED32     COB_ID_TIME;
 /*1014      */ UNSIGNED32     COB_ID_EMCY;
 /*1015      */ UNSIGNED16     inhibitTimeEMCY;
 /*1016      */ UNSIGNED32     consumerHeartbeatTime[4];
 /*1017      */ UNSIGNED16     producerHeartbeatTime;
-/*1018      */ OD_identity_t  identity;
 /*1019      */ UNSIGNED8      synchronousCounterOverflowValue;
 /*1029      */ UNSIGNED8      errorBehavior[6];
 /*1200[1]   */ OD_SDOServerParameter_t SDOServerParameter[1];
@@ -258,9 +308,12 @@ struct sCO_OD_ROM{
 /*1800[4]   */ OD_TPDOCommunicationParameter_t TPDOCommunicationParameter[4];
 /*1A00[4]   */ OD_TPDOMappingParameter_t TPDOMappingParameter[4];
 /*1F80      */ UNSIGNED32     NMTStartup;
+/*1FA0      */ UNSIGNED32     objectScannerList[8];
+/*1FD0      */ UNSIGNED64     objectDispatchingList[8];
 /*2101      */ UNSIGNED8      CANNodeID;
 /*2102      */ UNSIGNED16     CANBitRate;
 /*2111      */ INTEGER32      variableROMInt32[16];
+/*2301[2]   */ OD_traceConfig_t traceConfig[2];
 
                UNSIGNED32     LastWord;
 };
@@ -273,12 +326,14 @@ extern struct sCO_OD_EEPROM CO_OD_EEPROM;
 
 extern struct sCO_OD_ROM CO_OD_ROM;
 
+extern const struct sCO_OD_FLASH CO_OD_FLASH;
+
 
 /*******************************************************************************
    ALIASES FOR OBJECT DICTIONARY VARIABLES
 *******************************************************************************/
 /*1000, Data Type: UNSIGNED32 */
-      #define OD_deviceType                              CO_OD_ROM.deviceType
+      #define OD_deviceType                              CO_OD_FLASH.deviceType
 
 /*1001, Data Type: UNSIGNED8 */
       #define OD_errorRegister                           CO_OD_RAM.errorRegister
@@ -300,15 +355,15 @@ extern struct sCO_OD_ROM CO_OD_ROM;
       #define OD_synchronousWindowLength                 CO_OD_ROM.synchronousWindowLength
 
 /*1008, Data Type: VISIBLE_STRING, Array[11] */
-      #define OD_manufacturerDeviceName                  CO_OD_ROM.manufacturerDeviceName
+      #define OD_manufacturerDeviceName                  CO_OD_FLASH.manufacturerDeviceName
       #define ODL_manufacturerDeviceName_stringLength    11
 
 /*1009, Data Type: VISIBLE_STRING, Array[4] */
-      #define OD_manufacturerHardwareVersion             CO_OD_ROM.manufacturerHardwareVersion
+      #define OD_manufacturerHardwareVersion             CO_OD_FLASH.manufacturerHardwareVersion
       #define ODL_manufacturerHardwareVersion_stringLength 4
 
 /*100A, Data Type: VISIBLE_STRING, Array[4] */
-      #define OD_manufacturerSoftwareVersion             CO_OD_ROM.manufacturerSoftwareVersion
+      #define OD_manufacturerSoftwareVersion             CO_OD_FLASH.manufacturerSoftwareVersion
       #define ODL_manufacturerSoftwareVersion_stringLength 4
 
 /*1010, Data Type: UNSIGNED32, Array[1] */
@@ -321,6 +376,12 @@ extern struct sCO_OD_ROM CO_OD_ROM;
       #define ODL_restoreDefaultParameters_arrayLength   1
       #define ODA_restoreDefaultParameters_restoreAllDefaultParameters 0
 
+/*1012, Data Type: UNSIGNED32 */
+      #define OD_COB_ID_TIME                             CO_OD_ROM.COB_ID_TIME
+
+/*1013, Data Type: UNSIGNED32 */
+      #define OD_highResolutionTimeStamp                 CO_OD_RAM.highResolutionTimeStamp
+
 /*1014, Data Type: UNSIGNED32 */
       #define OD_COB_ID_EMCY                             CO_OD_ROM.COB_ID_EMCY
 
@@ -335,11 +396,14 @@ extern struct sCO_OD_ROM CO_OD_ROM;
       #define OD_producerHeartbeatTime                   CO_OD_ROM.producerHeartbeatTime
 
 /*1018, Data Type: OD_identity_t */
-      #define OD_identity                                CO_OD_ROM.identity
+      #define OD_identity                                CO_OD_FLASH.identity
 
 /*1019, Data Type: UNSIGNED8 */
       #define OD_synchronousCounterOverflowValue         CO_OD_ROM.synchronousCounterOverflowValue
 
+/*1022, Data Type: UNSIGNED8 */
+      #define OD_storageFormat                           CO_OD_FLASH.storageFormat
+
 /*1029, Data Type: UNSIGNED8, Array[6] */
       #define OD_errorBehavior                           CO_OD_ROM.errorBehavior
       #define ODL_errorBehavior_arrayLength              6
@@ -365,9 +429,32 @@ extern struct sCO_OD_ROM CO_OD_ROM;
 /*1A00[4], Data Type: OD_TPDOMappingParameter_t, Array[4] */
       #define OD_TPDOMappingParameter                    CO_OD_ROM.TPDOMappingParameter
 
+/*1F50, Data Type: DOMAIN, Array[1] */
+      #define ODL_programData_arrayLength                1
+
+/*1F51, Data Type: UNSIGNED8, Array[1] */
+      #define OD_programControl                          CO_OD_RAM.programControl
+      #define ODL_programControl_arrayLength             1
+
+/*1F56, Data Type: UNSIGNED32, Array[1] */
+      #define OD_programSoftwareIdentification           CO_OD_RAM.programSoftwareIdentification
+      #define ODL_programSoftwareIdentification_arrayLength 1
+
+/*1F57, Data Type: UNSIGNED32, Array[1] */
+      #define OD_flashStatusIdentification               CO_OD_RAM.flashStatusIdentification
+      #define ODL_flashStatusIdentification_arrayLength  1
+
 /*1F80, Data Type: UNSIGNED32 */
       #define OD_NMTStartup                              CO_OD_ROM.NMTStartup
 
+/*1FA0, Data Type: UNSIGNED32, Array[8] */
+      #define OD_objectScannerList                       CO_OD_ROM.objectScannerList
+      #define ODL_objectScannerList_arrayLength          8
+
+/*1FD0, Data Type: UNSIGNED64, Array[8] */
+      #define OD_objectDispatchingList                   CO_OD_ROM.objectDispatchingList
+      #define ODL_objectDispatchingList_arrayLength      8
+
 /*2100, Data Type: OCTET_STRING, Array[10] */
       #define OD_errorStatusBits                         CO_OD_RAM.errorStatusBits
       #define ODL_errorStatusBits_stringLength           10
@@ -424,6 +511,59 @@ extern struct sCO_OD_ROM CO_OD_ROM;
 /*2130, Data Type: OD_time_t */
       #define OD_time                                    CO_OD_RAM.time
 
+/*2140, Data Type: UNSIGNED32, Array[20] */
+      #define OD_profile                                 CO_OD_RAM.profile
+      #define ODL_profile_arrayLength                    20
+
+/*2141, Data Type: UNSIGNED32, Array[10] */
+      #define OD_CANstatistics                           CO_OD_RAM.CANstatistics
+      #define ODL_CANstatistics_arrayLength              10
+
+/*2142, Data Type: UNSIGNED16, Array[3] */
+      #define OD_busLoad                                 CO_OD_RAM.busLoad
+      #define ODL_busLoad_arrayLength                    3
+
+/*2143, Data Type: UNSIGNED32, Array[4] */
+      #define OD_PCSampling                              CO_OD_RAM.PCSampling
+      #define ODL_PCSampling_arrayLength                 4
+
+/*2145, Data Type: UNSIGNED32, Array[13] */
+      #define OD_tickStatistics                          CO_OD_RAM.tickStatistics
+      #define ODL_tickStatistics_arrayLength             13
+
+/*2146, Data Type: UNSIGNED32, Array[10] */
+      #define OD_CANrecorder                             CO_OD_RAM.CANrecorder
+      #define ODL_CANrecorder_arrayLength                10
+
+/*2148, Data Type: UNSIGNED32, Array[5] */
+      #define OD_SYNCPLL                                 CO_OD_RAM.SYNCPLL
+      #define ODL_SYNCPLL_arrayLength                    5
+
+/*2149, Data Type: UNSIGNED32, Array[7] */
+      #define OD_bootTime                                CO_OD_RAM.bootTime
+      #define ODL_bootTime_arrayLength                   7
+
+/*214A, Data Type: UNSIGNED32, Array[20] */
+      #define OD_worstCase                               CO_OD_RAM.worstCase
+      #define ODL_worstCase_arrayLength                  20
+
+/*214B, Data Type: UNSIGNED32, Array[12] */
+      #define OD_txLatency                               CO_OD_RAM.txLatency
+      #define ODL_txLatency_arrayLength                  12
+
+/*214C, Data Type: UNSIGNED32, Array[4] */
+      #define OD_governor                                CO_OD_RAM.governor
+      #define ODL_governor_arrayLength                   4
+
+/*2301[2], Data Type: OD_traceConfig_t, Array[2] */
+      #define OD_traceConfig                             CO_OD_ROM.traceConfig
+
+/*2400, Data Type: UNSIGNED8 */
+      #define OD_traceEnable                             CO_OD_RAM.traceEnable
+
+/*2401[2], Data Type: OD_trace_t, Array[2] */
+      #define OD_trace                                   CO_OD_RAM.trace
+
 /*6000, Data Type: UNSIGNED8, Array[8] */
       #define OD_readInput8Bit                           CO_OD_RAM.readInput8Bit
       #define ODL_readInput8Bit_arrayLength              8
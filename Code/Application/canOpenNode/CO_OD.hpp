@@ -0,0 +1,439 @@
+/*
+ * Typed C++ access to CANopen Object Dictionary, see CO_ODtyped.hpp.
+ *
+ * This file was automatically generated from CO_OD.c by tools/odcpp.py.
+ * DON'T EDIT THIS FILE MANUALLY !!!!
+ */
+
+
+#ifndef CO_OD_HPP
+#define CO_OD_HPP
+
+extern "C" {
+#include "CO_OD.h"
+}
+#include "CO_ODtyped.hpp"
+
+CO_OD_ENTRY(0x1000, 0x00, 0x85, CO_OD_FLASH.deviceType)
+CO_OD_ENTRY(0x1001, 0x00, 0x36, CO_OD_RAM.errorRegister)
+CO_OD_ENTRY(0x1002, 0x00, 0xB6, CO_OD_RAM.manufacturerStatusRegister)
+CO_OD_ENTRY(0x1003, 0x01, 0x8E, CO_OD_RAM.preDefinedErrorField[0])
+CO_OD_ENTRY(0x1003, 0x02, 0x8E, CO_OD_RAM.preDefinedErrorField[1])
+CO_OD_ENTRY(0x1003, 0x03, 0x8E, CO_OD_RAM.preDefinedErrorField[2])
+CO_OD_ENTRY(0x1003, 0x04, 0x8E, CO_OD_RAM.preDefinedErrorField[3])
+CO_OD_ENTRY(0x1003, 0x05, 0x8E, CO_OD_RAM.preDefinedErrorField[4])
+CO_OD_ENTRY(0x1003, 0x06, 0x8E, CO_OD_RAM.preDefinedErrorField[5])
+CO_OD_ENTRY(0x1003, 0x07, 0x8E, CO_OD_RAM.preDefinedErrorField[6])
+CO_OD_ENTRY(0x1003, 0x08, 0x8E, CO_OD_RAM.preDefinedErrorField[7])
+CO_OD_ENTRY(0x1005, 0x00, 0x8D, CO_OD_ROM.COB_ID_SYNCMessage)
+CO_OD_ENTRY(0x1006, 0x00, 0x8D, CO_OD_ROM.communicationCyclePeriod)
+CO_OD_ENTRY(0x1007, 0x00, 0x8D, CO_OD_ROM.synchronousWindowLength)
+CO_OD_ENTRY(0x1008, 0x00, 0x05, CO_OD_FLASH.manufacturerDeviceName)
+CO_OD_ENTRY(0x1009, 0x00, 0x05, CO_OD_FLASH.manufacturerHardwareVersion)
+CO_OD_ENTRY(0x100A, 0x00, 0x05, CO_OD_FLASH.manufacturerSoftwareVersion)
+CO_OD_ENTRY(0x1010, 0x01, 0x8E, CO_OD_RAM.storeParameters[0])
+CO_OD_ENTRY(0x1011, 0x01, 0x8E, CO_OD_RAM.restoreDefaultParameters[0])
+CO_OD_ENTRY(0x1012, 0x00, 0x8D, CO_OD_ROM.COB_ID_TIME)
+CO_OD_ENTRY(0x1013, 0x00, 0xA6, CO_OD_RAM.highResolutionTimeStamp)
+CO_OD_ENTRY(0x1014, 0x00, 0x85, CO_OD_ROM.COB_ID_EMCY)
+CO_OD_ENTRY(0x1015, 0x00, 0x8D, CO_OD_ROM.inhibitTimeEMCY)
+CO_OD_ENTRY(0x1016, 0x01, 0x8D, CO_OD_ROM.consumerHeartbeatTime[0])
+CO_OD_ENTRY(0x1016, 0x02, 0x8D, CO_OD_ROM.consumerHeartbeatTime[1])
+CO_OD_ENTRY(0x1016, 0x03, 0x8D, CO_OD_ROM.consumerHeartbeatTime[2])
+CO_OD_ENTRY(0x1016, 0x04, 0x8D, CO_OD_ROM.consumerHeartbeatTime[3])
+CO_OD_ENTRY(0x1017, 0x00, 0x8D, CO_OD_ROM.producerHeartbeatTime)
+CO_OD_ENTRY(0x1018, 0x00, 0x05, CO_OD_FLASH.identity.maxSubIndex)
+CO_OD_ENTRY(0x1018, 0x01, 0x85, CO_OD_FLASH.identity.vendorID)
+CO_OD_ENTRY(0x1018, 0x02, 0x85, CO_OD_FLASH.identity.productCode)
+CO_OD_ENTRY(0x1018, 0x03, 0x85, CO_OD_FLASH.identity.revisionNumber)
+CO_OD_ENTRY(0x1018, 0x04, 0x85, CO_OD_FLASH.identity.serialNumber)
+CO_OD_ENTRY(0x1019, 0x00, 0x0D, CO_OD_ROM.synchronousCounterOverflowValue)
+CO_OD_ENTRY(0x1022, 0x00, 0x05, CO_OD_FLASH.storageFormat)
+CO_OD_ENTRY(0x1029, 0x01, 0x0D, CO_OD_ROM.errorBehavior[0])
+CO_OD_ENTRY(0x1029, 0x02, 0x0D, CO_OD_ROM.errorBehavior[1])
+CO_OD_ENTRY(0x1029, 0x03, 0x0D, CO_OD_ROM.errorBehavior[2])
+CO_OD_ENTRY(0x1029, 0x04, 0x0D, CO_OD_ROM.errorBehavior[3])
+CO_OD_ENTRY(0x1029, 0x05, 0x0D, CO_OD_ROM.errorBehavior[4])
+CO_OD_ENTRY(0x1029, 0x06, 0x0D, CO_OD_ROM.errorBehavior[5])
+CO_OD_ENTRY(0x1200, 0x00, 0x05, CO_OD_ROM.SDOServerParameter[0].maxSubIndex)
+CO_OD_ENTRY(0x1200, 0x01, 0x85, CO_OD_ROM.SDOServerParameter[0].COB_IDClientToServer)
+CO_OD_ENTRY(0x1200, 0x02, 0x85, CO_OD_ROM.SDOServerParameter[0].COB_IDServerToClient)
+CO_OD_ENTRY(0x1400, 0x00, 0x05, CO_OD_ROM.RPDOCommunicationParameter[0].maxSubIndex)
+CO_OD_ENTRY(0x1400, 0x01, 0x8D, CO_OD_ROM.RPDOCommunicationParameter[0].COB_IDUsedByRPDO)
+CO_OD_ENTRY(0x1400, 0x02, 0x0D, CO_OD_ROM.RPDOCommunicationParameter[0].transmissionType)
+CO_OD_ENTRY(0x1401, 0x00, 0x05, CO_OD_ROM.RPDOCommunicationParameter[1].maxSubIndex)
+CO_OD_ENTRY(0x1401, 0x01, 0x8D, CO_OD_ROM.RPDOCommunicationParameter[1].COB_IDUsedByRPDO)
+CO_OD_ENTRY(0x1401, 0x02, 0x0D, CO_OD_ROM.RPDOCommunicationParameter[1].transmissionType)
+CO_OD_ENTRY(0x1402, 0x00, 0x05, CO_OD_ROM.RPDOCommunicationParameter[2].maxSubIndex)
+CO_OD_ENTRY(0x1402, 0x01, 0x8D, CO_OD_ROM.RPDOCommunicationParameter[2].COB_IDUsedByRPDO)
+CO_OD_ENTRY(0x1402, 0x02, 0x0D, CO_OD_ROM.RPDOCommunicationParameter[2].transmissionType)
+CO_OD_ENTRY(0x1403, 0x00, 0x05, CO_OD_ROM.RPDOCommunicationParameter[3].maxSubIndex)
+CO_OD_ENTRY(0x1403, 0x01, 0x8D, CO_OD_ROM.RPDOCommunicationParameter[3].COB_IDUsedByRPDO)
+CO_OD_ENTRY(0x1403, 0x02, 0x0D, CO_OD_ROM.RPDOCommunicationParameter[3].transmissionType)
+CO_OD_ENTRY(0x1600, 0x00, 0x0D, CO_OD_ROM.RPDOMappingParameter[0].numberOfMappedObjects)
+CO_OD_ENTRY(0x1600, 0x01, 0x8D, CO_OD_ROM.RPDOMappingParameter[0].mappedObject1)
+CO_OD_ENTRY(0x1600, 0x02, 0x8D, CO_OD_ROM.RPDOMappingParameter[0].mappedObject2)
+CO_OD_ENTRY(0x1600, 0x03, 0x8D, CO_OD_ROM.RPDOMappingParameter[0].mappedObject3)
+CO_OD_ENTRY(0x1600, 0x04, 0x8D, CO_OD_ROM.RPDOMappingParameter[0].mappedObject4)
+CO_OD_ENTRY(0x1600, 0x05, 0x8D, CO_OD_ROM.RPDOMappingParameter[0].mappedObject5)
+CO_OD_ENTRY(0x1600, 0x06, 0x8D, CO_OD_ROM.RPDOMappingParameter[0].mappedObject6)
+CO_OD_ENTRY(0x1600, 0x07, 0x8D, CO_OD_ROM.RPDOMappingParameter[0].mappedObject7)
+CO_OD_ENTRY(0x1600, 0x08, 0x8D, CO_OD_ROM.RPDOMappingParameter[0].mappedObject8)
+CO_OD_ENTRY(0x1601, 0x00, 0x0D, CO_OD_ROM.RPDOMappingParameter[1].numberOfMappedObjects)
+CO_OD_ENTRY(0x1601, 0x01, 0x8D, CO_OD_ROM.RPDOMappingParameter[1].mappedObject1)
+CO_OD_ENTRY(0x1601, 0x02, 0x8D, CO_OD_ROM.RPDOMappingParameter[1].mappedObject2)
+CO_OD_ENTRY(0x1601, 0x03, 0x8D, CO_OD_ROM.RPDOMappingParameter[1].mappedObject3)
+CO_OD_ENTRY(0x1601, 0x04, 0x8D, CO_OD_ROM.RPDOMappingParameter[1].mappedObject4)
+CO_OD_ENTRY(0x1601, 0x05, 0x8D, CO_OD_ROM.RPDOMappingParameter[1].mappedObject5)
+CO_OD_ENTRY(0x1601, 0x06, 0x8D, CO_OD_ROM.RPDOMappingParameter[1].mappedObject6)
+CO_OD_ENTRY(0x1601, 0x07, 0x8D, CO_OD_ROM.RPDOMappingParameter[1].mappedObject7)
+CO_OD_ENTRY(0x1601, 0x08, 0x8D, CO_OD_ROM.RPDOMappingParameter[1].mappedObject8)
+CO_OD_ENTRY(0x1602, 0x00, 0x0D, CO_OD_ROM.RPDOMappingParameter[2].numberOfMappedObjects)
+CO_OD_ENTRY(0x1602, 0x01, 0x8D, CO_OD_ROM.RPDOMappingParameter[2].mappedObject1)
+CO_OD_ENTRY(0x1602, 0x02, 0x8D, CO_OD_ROM.RPDOMappingParameter[2].mappedObject2)
+CO_OD_ENTRY(0x1602, 0x03, 0x8D, CO_OD_ROM.RPDOMappingParameter[2].mappedObject3)
+CO_OD_ENTRY(0x1602, 0x04, 0x8D, CO_OD_ROM.RPDOMappingParameter[2].mappedObject4)
+CO_OD_ENTRY(0x1602, 0x05, 0x8D, CO_OD_ROM.RPDOMappingParameter[2].mappedObject5)
+CO_OD_ENTRY(0x1602, 0x06, 0x8D, CO_OD_ROM.RPDOMappingParameter[2].mappedObject6)
+CO_OD_ENTRY(0x1602, 0x07, 0x8D, CO_OD_ROM.RPDOMappingParameter[2].mappedObject7)
+CO_OD_ENTRY(0x1602, 0x08, 0x8D, CO_OD_ROM.RPDOMappingParameter[2].mappedObject8)
+CO_OD_ENTRY(0x1603, 0x00, 0x0D, CO_OD_ROM.RPDOMappingParameter[3].numberOfMappedObjects)
+CO_OD_ENTRY(0x1603, 0x01, 0x8D, CO_OD_ROM.RPDOMappingParameter[3].mappedObject1)
+CO_OD_ENTRY(0x1603, 0x02, 0x8D, CO_OD_ROM.RPDOMappingParameter[3].mappedObject2)
+CO_OD_ENTRY(0x1603, 0x03, 0x8D, CO_OD_ROM.RPDOMappingParameter[3].mappedObject3)
+CO_OD_ENTRY(0x1603, 0x04, 0x8D, CO_OD_ROM.RPDOMappingParameter[3].mappedObject4)
+CO_OD_ENTRY(0x1603, 0x05, 0x8D, CO_OD_ROM.RPDOMappingParameter[3].mappedObject5)
+CO_OD_ENTRY(0x1603, 0x06, 0x8D, CO_OD_ROM.RPDOMappingParameter[3].mappedObject6)
+CO_OD_ENTRY(0x1603, 0x07, 0x8D, CO_OD_ROM.RPDOMappingParameter[3].mappedObject7)
+CO_OD_ENTRY(0x1603, 0x08, 0x8D, CO_OD_ROM.RPDOMappingParameter[3].mappedObject8)
+CO_OD_ENTRY(0x1800, 0x00, 0x05, CO_OD_ROM.TPDOCommunicationParameter[0].maxSubIndex)
+CO_OD_ENTRY(0x1800, 0x01, 0x8D, CO_OD_ROM.TPDOCommunicationParameter[0].COB_IDUsedByTPDO)
+CO_OD_ENTRY(0x1800, 0x02, 0x0D, CO_OD_ROM.TPDOCommunicationParameter[0].transmissionType)
+CO_OD_ENTRY(0x1800, 0x03, 0x8D, CO_OD_ROM.TPDOCommunicationParameter[0].inhibitTime)
+CO_OD_ENTRY(0x1800, 0x04, 0x0D, CO_OD_ROM.TPDOCommunicationParameter[0].compatibilityEntry)
+CO_OD_ENTRY(0x1800, 0x05, 0x8D, CO_OD_ROM.TPDOCommunicationParameter[0].eventTimer)
+CO_OD_ENTRY(0x1800, 0x06, 0x0D, CO_OD_ROM.TPDOCommunicationParameter[0].SYNCStartValue)
+CO_OD_ENTRY(0x1801, 0x00, 0x05, CO_OD_ROM.TPDOCommunicationParameter[1].maxSubIndex)
+CO_OD_ENTRY(0x1801, 0x01, 0x8D, CO_OD_ROM.TPDOCommunicationParameter[1].COB_IDUsedByTPDO)
+CO_OD_ENTRY(0x1801, 0x02, 0x0D, CO_OD_ROM.TPDOCommunicationParameter[1].transmissionType)
+CO_OD_ENTRY(0x1801, 0x03, 0x8D, CO_OD_ROM.TPDOCommunicationParameter[1].inhibitTime)
+CO_OD_ENTRY(0x1801, 0x04, 0x0D, CO_OD_ROM.TPDOCommunicationParameter[1].compatibilityEntry)
+CO_OD_ENTRY(0x1801, 0x05, 0x8D, CO_OD_ROM.TPDOCommunicationParameter[1].eventTimer)
+CO_OD_ENTRY(0x1801, 0x06, 0x0D, CO_OD_ROM.TPDOCommunicationParameter[1].SYNCStartValue)
+CO_OD_ENTRY(0x1802, 0x00, 0x05, CO_OD_ROM.TPDOCommunicationParameter[2].maxSubIndex)
+CO_OD_ENTRY(0x1802, 0x01, 0x8D, CO_OD_ROM.TPDOCommunicationParameter[2].COB_IDUsedByTPDO)
+CO_OD_ENTRY(0x1802, 0x02, 0x0D, CO_OD_ROM.TPDOCommunicationParameter[2].transmissionType)
+CO_OD_ENTRY(0x1802, 0x03, 0x8D, CO_OD_ROM.TPDOCommunicationParameter[2].inhibitTime)
+CO_OD_ENTRY(0x1802, 0x04, 0x0D, CO_OD_ROM.TPDOCommunicationParameter[2].compatibilityEntry)
+CO_OD_ENTRY(0x1802, 0x05, 0x8D, CO_OD_ROM.TPDOCommunicationParameter[2].eventTimer)
+CO_OD_ENTRY(0x1802, 0x06, 0x0D, CO_OD_ROM.TPDOCommunicationParameter[2].SYNCStartValue)
+CO_OD_ENTRY(0x1803, 0x00, 0x05, CO_OD_ROM.TPDOCommunicationParameter[3].maxSubIndex)
+CO_OD_ENTRY(0x1803, 0x01, 0x8D, CO_OD_ROM.TPDOCommunicationParameter[3].COB_IDUsedByTPDO)
+CO_OD_ENTRY(0x1803, 0x02, 0x0D, CO_OD_ROM.TPDOCommunicationParameter[3].transmissionType)
+CO_OD_ENTRY(0x1803, 0x03, 0x8D, CO_OD_ROM.TPDOCommunicationParameter[3].inhibitTime)
+CO_OD_ENTRY(0x1803, 0x04, 0x0D, CO_OD_ROM.TPDOCommunicationParameter[3].compatibilityEntry)
+CO_OD_ENTRY(0x1803, 0x05, 0x8D, CO_OD_ROM.TPDOCommunicationParameter[3].eventTimer)
+CO_OD_ENTRY(0x1803, 0x06, 0x0D, CO_OD_ROM.TPDOCommunicationParameter[3].SYNCStartValue)
+CO_OD_ENTRY(0x1A00, 0x00, 0x0D, CO_OD_ROM.TPDOMappingParameter[0].numberOfMappedObjects)
+CO_OD_ENTRY(0x1A00, 0x01, 0x8D, CO_OD_ROM.TPDOMappingParameter[0].mappedObject1)
+CO_OD_ENTRY(0x1A00, 0x02, 0x8D, CO_OD_ROM.TPDOMappingParameter[0].mappedObject2)
+CO_OD_ENTRY(0x1A00, 0x03, 0x8D, CO_OD_ROM.TPDOMappingParameter[0].mappedObject3)
+CO_OD_ENTRY(0x1A00, 0x04, 0x8D, CO_OD_ROM.TPDOMappingParameter[0].mappedObject4)
+CO_OD_ENTRY(0x1A00, 0x05, 0x8D, CO_OD_ROM.TPDOMappingParameter[0].mappedObject5)
+CO_OD_ENTRY(0x1A00, 0x06, 0x8D, CO_OD_ROM.TPDOMappingParameter[0].mappedObject6)
+CO_OD_ENTRY(0x1A00, 0x07, 0x8D, CO_OD_ROM.TPDOMappingParameter[0].mappedObject7)
+CO_OD_ENTRY(0x1A00, 0x08, 0x8D, CO_OD_ROM.TPDOMappingParameter[0].mappedObject8)
+CO_OD_ENTRY(0x1A01, 0x00, 0x0D, CO_OD_ROM.TPDOMappingParameter[1].numberOfMappedObjects)
+CO_OD_ENTRY(0x1A01, 0x01, 0x8D, CO_OD_ROM.TPDOMappingParameter[1].mappedObject1)
+CO_OD_ENTRY(0x1A01, 0x02, 0x8D, CO_OD_ROM.TPDOMappingParameter[1].mappedObject2)
+CO_OD_ENTRY(0x1A01, 0x03, 0x8D, CO_OD_ROM.TPDOMappingParameter[1].mappedObject3)
+CO_OD_ENTRY(0x1A01, 0x04, 0x8D, CO_OD_ROM.TPDOMappingParameter[1].mappedObject4)
+CO_OD_ENTRY(0x1A01, 0x05, 0x8D, CO_OD_ROM.TPDOMappingParameter[1].mappedObject5)
+CO_OD_ENTRY(0x1A01, 0x06, 0x8D, CO_OD_ROM.TPDOMappingParameter[1].mappedObject6)
+CO_OD_ENTRY(0x1A01, 0x07, 0x8D, CO_OD_ROM.TPDOMappingParameter[1].mappedObject7)
+CO_OD_ENTRY(0x1A01, 0x08, 0x8D, CO_OD_ROM.TPDOMappingParameter[1].mappedObject8)
+CO_OD_ENTRY(0x1A02, 0x00, 0x0D, CO_OD_ROM.TPDOMappingParameter[2].numberOfMappedObjects)
+CO_OD_ENTRY(0x1A02, 0x01, 0x8D, CO_OD_ROM.TPDOMappingParameter[2].mappedObject1)
+CO_OD_ENTRY(0x1A02, 0x02, 0x8D, CO_OD_ROM.TPDOMappingParameter[2].mappedObject2)
+CO_OD_ENTRY(0x1A02, 0x03, 0x8D, CO_OD_ROM.TPDOMappingParameter[2].mappedObject3)
+CO_OD_ENTRY(0x1A02, 0x04, 0x8D, CO_OD_ROM.TPDOMappingParameter[2].mappedObject4)
+CO_OD_ENTRY(0x1A02, 0x05, 0x8D, CO_OD_ROM.TPDOMappingParameter[2].mappedObject5)
+CO_OD_ENTRY(0x1A02, 0x06, 0x8D, CO_OD_ROM.TPDOMappingParameter[2].mappedObject6)
+CO_OD_ENTRY(0x1A02, 0x07, 0x8D, CO_OD_ROM.TPDOMappingParameter[2].mappedObject7)
+CO_OD_ENTRY(0x1A02, 0x08, 0x8D, CO_OD_ROM.TPDOMappingParameter[2].mappedObject8)
+CO_OD_ENTRY(0x1A03, 0x00, 0x0D, CO_OD_ROM.TPDOMappingParameter[3].numberOfMappedObjects)
+CO_OD_ENTRY(0x1A03, 0x01, 0x8D, CO_OD_ROM.TPDOMappingParameter[3].mappedObject1)
+CO_OD_ENTRY(0x1A03, 0x02, 0x8D, CO_OD_ROM.TPDOMappingParameter[3].mappedObject2)
+CO_OD_ENTRY(0x1A03, 0x03, 0x8D, CO_OD_ROM.TPDOMappingParameter[3].mappedObject3)
+CO_OD_ENTRY(0x1A03, 0x04, 0x8D, CO_OD_ROM.TPDOMappingParameter[3].mappedObject4)
+CO_OD_ENTRY(0x1A03, 0x05, 0x8D, CO_OD_ROM.TPDOMappingParameter[3].mappedObject5)
+CO_OD_ENTRY(0x1A03, 0x06, 0x8D, CO_OD_ROM.TPDOMappingParameter[3].mappedObject6)
+CO_OD_ENTRY(0x1A03, 0x07, 0x8D, CO_OD_ROM.TPDOMappingParameter[3].mappedObject7)
+CO_OD_ENTRY(0x1A03, 0x08, 0x8D, CO_OD_ROM.TPDOMappingParameter[3].mappedObject8)
+CO_OD_ENTRY(0x1F51, 0x01, 0x0E, CO_OD_RAM.programControl[0])
+CO_OD_ENTRY(0x1F56, 0x01, 0x86, CO_OD_RAM.programSoftwareIdentification[0])
+CO_OD_ENTRY(0x1F57, 0x01, 0x86, CO_OD_RAM.flashStatusIdentification[0])
+CO_OD_ENTRY(0x1F80, 0x00, 0x8D, CO_OD_ROM.NMTStartup)
+CO_OD_ENTRY(0x1FA0, 0x01, 0x8D, CO_OD_ROM.objectScannerList[0])
+CO_OD_ENTRY(0x1FA0, 0x02, 0x8D, CO_OD_ROM.objectScannerList[1])
+CO_OD_ENTRY(0x1FA0, 0x03, 0x8D, CO_OD_ROM.objectScannerList[2])
+CO_OD_ENTRY(0x1FA0, 0x04, 0x8D, CO_OD_ROM.objectScannerList[3])
+CO_OD_ENTRY(0x1FA0, 0x05, 0x8D, CO_OD_ROM.objectScannerList[4])
+CO_OD_ENTRY(0x1FA0, 0x06, 0x8D, CO_OD_ROM.objectScannerList[5])
+CO_OD_ENTRY(0x1FA0, 0x07, 0x8D, CO_OD_ROM.objectScannerList[6])
+CO_OD_ENTRY(0x1FA0, 0x08, 0x8D, CO_OD_ROM.objectScannerList[7])
+CO_OD_ENTRY(0x1FD0, 0x01, 0x8D, CO_OD_ROM.objectDispatchingList[0])
+CO_OD_ENTRY(0x1FD0, 0x02, 0x8D, CO_OD_ROM.objectDispatchingList[1])
+CO_OD_ENTRY(0x1FD0, 0x03, 0x8D, CO_OD_ROM.objectDispatchingList[2])
+CO_OD_ENTRY(0x1FD0, 0x04, 0x8D, CO_OD_ROM.objectDispatchingList[3])
+CO_OD_ENTRY(0x1FD0, 0x05, 0x8D, CO_OD_ROM.objectDispatchingList[4])
+CO_OD_ENTRY(0x1FD0, 0x06, 0x8D, CO_OD_ROM.objectDispatchingList[5])
+CO_OD_ENTRY(0x1FD0, 0x07, 0x8D, CO_OD_ROM.objectDispatchingList[6])
+CO_OD_ENTRY(0x1FD0, 0x08, 0x8D, CO_OD_ROM.objectDispatchingList[7])
+CO_OD_ENTRY(0x2100, 0x00, 0x36, CO_OD_RAM.errorStatusBits)
+CO_OD_ENTRY(0x2101, 0x00, 0x0D, CO_OD_ROM.CANNodeID)
+CO_OD_ENTRY(0x2102, 0x00, 0x8D, CO_OD_ROM.CANBitRate)
+CO_OD_ENTRY(0x2103, 0x00, 0x8E, CO_OD_RAM.SYNCCounter)
+CO_OD_ENTRY(0x2104, 0x00, 0x86, CO_OD_RAM.SYNCTime)
+CO_OD_ENTRY(0x2106, 0x00, 0x87, CO_OD_EEPROM.powerOnCounter)
+CO_OD_ENTRY(0x2107, 0x01, 0xBE, CO_OD_RAM.performance[0])
+CO_OD_ENTRY(0x2107, 0x02, 0xBE, CO_OD_RAM.performance[1])
+CO_OD_ENTRY(0x2107, 0x03, 0xBE, CO_OD_RAM.performance[2])
+CO_OD_ENTRY(0x2107, 0x04, 0xBE, CO_OD_RAM.performance[3])
+CO_OD_ENTRY(0x2107, 0x05, 0xBE, CO_OD_RAM.performance[4])
+CO_OD_ENTRY(0x2108, 0x01, 0xB6, CO_OD_RAM.temperature[0])
+CO_OD_ENTRY(0x2109, 0x01, 0xB6, CO_OD_RAM.voltage[0])
+CO_OD_ENTRY(0x2110, 0x01, 0xFE, CO_OD_RAM.variableInt32[0])
+CO_OD_ENTRY(0x2110, 0x02, 0xFE, CO_OD_RAM.variableInt32[1])
+CO_OD_ENTRY(0x2110, 0x03, 0xFE, CO_OD_RAM.variableInt32[2])
+CO_OD_ENTRY(0x2110, 0x04, 0xFE, CO_OD_RAM.variableInt32[3])
+CO_OD_ENTRY(0x2110, 0x05, 0xFE, CO_OD_RAM.variableInt32[4])
+CO_OD_ENTRY(0x2110, 0x06, 0xFE, CO_OD_RAM.variableInt32[5])
+CO_OD_ENTRY(0x2110, 0x07, 0xFE, CO_OD_RAM.variableInt32[6])
+CO_OD_ENTRY(0x2110, 0x08, 0xFE, CO_OD_RAM.variableInt32[7])
+CO_OD_ENTRY(0x2110, 0x09, 0xFE, CO_OD_RAM.variableInt32[8])
+CO_OD_ENTRY(0x2110, 0x0A, 0xFE, CO_OD_RAM.variableInt32[9])
+CO_OD_ENTRY(0x2110, 0x0B, 0xFE, CO_OD_RAM.variableInt32[10])
+CO_OD_ENTRY(0x2110, 0x0C, 0xFE, CO_OD_RAM.variableInt32[11])
+CO_OD_ENTRY(0x2110, 0x0D, 0xFE, CO_OD_RAM.variableInt32[12])
+CO_OD_ENTRY(0x2110, 0x0E, 0xFE, CO_OD_RAM.variableInt32[13])
+CO_OD_ENTRY(0x2110, 0x0F, 0xFE, CO_OD_RAM.variableInt32[14])
+CO_OD_ENTRY(0x2110, 0x10, 0xFE, CO_OD_RAM.variableInt32[15])
+CO_OD_ENTRY(0x2111, 0x01, 0xFD, CO_OD_ROM.variableROMInt32[0])
+CO_OD_ENTRY(0x2111, 0x02, 0xFD, CO_OD_ROM.variableROMInt32[1])
+CO_OD_ENTRY(0x2111, 0x03, 0xFD, CO_OD_ROM.variableROMInt32[2])
+CO_OD_ENTRY(0x2111, 0x04, 0xFD, CO_OD_ROM.variableROMInt32[3])
+CO_OD_ENTRY(0x2111, 0x05, 0xFD, CO_OD_ROM.variableROMInt32[4])
+CO_OD_ENTRY(0x2111, 0x06, 0xFD, CO_OD_ROM.variableROMInt32[5])
+CO_OD_ENTRY(0x2111, 0x07, 0xFD, CO_OD_ROM.variableROMInt32[6])
+CO_OD_ENTRY(0x2111, 0x08, 0xFD, CO_OD_ROM.variableROMInt32[7])
+CO_OD_ENTRY(0x2111, 0x09, 0xFD, CO_OD_ROM.variableROMInt32[8])
+CO_OD_ENTRY(0x2111, 0x0A, 0xFD, CO_OD_ROM.variableROMInt32[9])
+CO_OD_ENTRY(0x2111, 0x0B, 0xFD, CO_OD_ROM.variableROMInt32[10])
+CO_OD_ENTRY(0x2111, 0x0C, 0xFD, CO_OD_ROM.variableROMInt32[11])
+CO_OD_ENTRY(0x2111, 0x0D, 0xFD, CO_OD_ROM.variableROMInt32[12])
+CO_OD_ENTRY(0x2111, 0x0E, 0xFD, CO_OD_ROM.variableROMInt32[13])
+CO_OD_ENTRY(0x2111, 0x0F, 0xFD, CO_OD_ROM.variableROMInt32[14])
+CO_OD_ENTRY(0x2111, 0x10, 0xFD, CO_OD_ROM.variableROMInt32[15])
+CO_OD_ENTRY(0x2112, 0x01, 0xFF, CO_OD_EEPROM.variableNVInt32[0])
+CO_OD_ENTRY(0x2112, 0x02, 0xFF, CO_OD_EEPROM.variableNVInt32[1])
+CO_OD_ENTRY(0x2112, 0x03, 0xFF, CO_OD_EEPROM.variableNVInt32[2])
+CO_OD_ENTRY(0x2112, 0x04, 0xFF, CO_OD_EEPROM.variableNVInt32[3])
+CO_OD_ENTRY(0x2112, 0x05, 0xFF, CO_OD_EEPROM.variableNVInt32[4])
+CO_OD_ENTRY(0x2112, 0x06, 0xFF, CO_OD_EEPROM.variableNVInt32[5])
+CO_OD_ENTRY(0x2112, 0x07, 0xFF, CO_OD_EEPROM.variableNVInt32[6])
+CO_OD_ENTRY(0x2112, 0x08, 0xFF, CO_OD_EEPROM.variableNVInt32[7])
+CO_OD_ENTRY(0x2112, 0x09, 0xFF, CO_OD_EEPROM.variableNVInt32[8])
+CO_OD_ENTRY(0x2112, 0x0A, 0xFF, CO_OD_EEPROM.variableNVInt32[9])
+CO_OD_ENTRY(0x2112, 0x0B, 0xFF, CO_OD_EEPROM.variableNVInt32[10])
+CO_OD_ENTRY(0x2112, 0x0C, 0xFF, CO_OD_EEPROM.variableNVInt32[11])
+CO_OD_ENTRY(0x2112, 0x0D, 0xFF, CO_OD_EEPROM.variableNVInt32[12])
+CO_OD_ENTRY(0x2112, 0x0E, 0xFF, CO_OD_EEPROM.variableNVInt32[13])
+CO_OD_ENTRY(0x2112, 0x0F, 0xFF, CO_OD_EEPROM.variableNVInt32[14])
+CO_OD_ENTRY(0x2112, 0x10, 0xFF, CO_OD_EEPROM.variableNVInt32[15])
+CO_OD_ENTRY(0x2120, 0x00, 0x06, CO_OD_RAM.testVar.maxSubIndex)
+CO_OD_ENTRY(0x2120, 0x01, 0xBE, CO_OD_RAM.testVar.I64)
+CO_OD_ENTRY(0x2120, 0x02, 0xBE, CO_OD_RAM.testVar.U64)
+CO_OD_ENTRY(0x2120, 0x03, 0xBE, CO_OD_RAM.testVar.R32)
+CO_OD_ENTRY(0x2120, 0x04, 0xBE, CO_OD_RAM.testVar.R64)
+CO_OD_ENTRY(0x2130, 0x00, 0x06, CO_OD_RAM.time.maxSubIndex)
+CO_OD_ENTRY(0x2130, 0x01, 0x06, CO_OD_RAM.time.string[0])
+CO_OD_ENTRY(0x2130, 0x02, 0x8E, CO_OD_RAM.time.epochTimeBaseMs)
+CO_OD_ENTRY(0x2130, 0x03, 0xBE, CO_OD_RAM.time.epochTimeOffsetMs)
+CO_OD_ENTRY(0x2140, 0x01, 0x8E, CO_OD_RAM.profile[0])
+CO_OD_ENTRY(0x2140, 0x02, 0x8E, CO_OD_RAM.profile[1])
+CO_OD_ENTRY(0x2140, 0x03, 0x8E, CO_OD_RAM.profile[2])
+CO_OD_ENTRY(0x2140, 0x04, 0x8E, CO_OD_RAM.profile[3])
+CO_OD_ENTRY(0x2140, 0x05, 0x8E, CO_OD_RAM.profile[4])
+CO_OD_ENTRY(0x2140, 0x06, 0x8E, CO_OD_RAM.profile[5])
+CO_OD_ENTRY(0x2140, 0x07, 0x8E, CO_OD_RAM.profile[6])
+CO_OD_ENTRY(0x2140, 0x08, 0x8E, CO_OD_RAM.profile[7])
+CO_OD_ENTRY(0x2140, 0x09, 0x8E, CO_OD_RAM.profile[8])
+CO_OD_ENTRY(0x2140, 0x0A, 0x8E, CO_OD_RAM.profile[9])
+CO_OD_ENTRY(0x2140, 0x0B, 0x8E, CO_OD_RAM.profile[10])
+CO_OD_ENTRY(0x2140, 0x0C, 0x8E, CO_OD_RAM.profile[11])
+CO_OD_ENTRY(0x2140, 0x0D, 0x8E, CO_OD_RAM.profile[12])
+CO_OD_ENTRY(0x2140, 0x0E, 0x8E, CO_OD_RAM.profile[13])
+CO_OD_ENTRY(0x2140, 0x0F, 0x8E, CO_OD_RAM.profile[14])
+CO_OD_ENTRY(0x2140, 0x10, 0x8E, CO_OD_RAM.profile[15])
+CO_OD_ENTRY(0x2140, 0x11, 0x8E, CO_OD_RAM.profile[16])
+CO_OD_ENTRY(0x2140, 0x12, 0x8E, CO_OD_RAM.profile[17])
+CO_OD_ENTRY(0x2140, 0x13, 0x8E, CO_OD_RAM.profile[18])
+CO_OD_ENTRY(0x2140, 0x14, 0x8E, CO_OD_RAM.profile[19])
+CO_OD_ENTRY(0x2141, 0x01, 0x8E, CO_OD_RAM.CANstatistics[0])
+CO_OD_ENTRY(0x2141, 0x02, 0x8E, CO_OD_RAM.CANstatistics[1])
+CO_OD_ENTRY(0x2141, 0x03, 0x8E, CO_OD_RAM.CANstatistics[2])
+CO_OD_ENTRY(0x2141, 0x04, 0x8E, CO_OD_RAM.CANstatistics[3])
+CO_OD_ENTRY(0x2141, 0x05, 0x8E, CO_OD_RAM.CANstatistics[4])
+CO_OD_ENTRY(0x2141, 0x06, 0x8E, CO_OD_RAM.CANstatistics[5])
+CO_OD_ENTRY(0x2141, 0x07, 0x8E, CO_OD_RAM.CANstatistics[6])
+CO_OD_ENTRY(0x2141, 0x08, 0x8E, CO_OD_RAM.CANstatistics[7])
+CO_OD_ENTRY(0x2141, 0x09, 0x8E, CO_OD_RAM.CANstatistics[8])
+CO_OD_ENTRY(0x2141, 0x0A, 0x8E, CO_OD_RAM.CANstatistics[9])
+CO_OD_ENTRY(0x2142, 0x01, 0xAE, CO_OD_RAM.busLoad[0])
+CO_OD_ENTRY(0x2142, 0x02, 0xAE, CO_OD_RAM.busLoad[1])
+CO_OD_ENTRY(0x2142, 0x03, 0xAE, CO_OD_RAM.busLoad[2])
+CO_OD_ENTRY(0x2143, 0x01, 0x8E, CO_OD_RAM.PCSampling[0])
+CO_OD_ENTRY(0x2143, 0x02, 0x8E, CO_OD_RAM.PCSampling[1])
+CO_OD_ENTRY(0x2143, 0x03, 0x8E, CO_OD_RAM.PCSampling[2])
+CO_OD_ENTRY(0x2143, 0x04, 0x8E, CO_OD_RAM.PCSampling[3])
+CO_OD_ENTRY(0x2145, 0x01, 0x8E, CO_OD_RAM.tickStatistics[0])
+CO_OD_ENTRY(0x2145, 0x02, 0x8E, CO_OD_RAM.tickStatistics[1])
+CO_OD_ENTRY(0x2145, 0x03, 0x8E, CO_OD_RAM.tickStatistics[2])
+CO_OD_ENTRY(0x2145, 0x04, 0x8E, CO_OD_RAM.tickStatistics[3])
+CO_OD_ENTRY(0x2145, 0x05, 0x8E, CO_OD_RAM.tickStatistics[4])
+CO_OD_ENTRY(0x2145, 0x06, 0x8E, CO_OD_RAM.tickStatistics[5])
+CO_OD_ENTRY(0x2145, 0x07, 0x8E, CO_OD_RAM.tickStatistics[6])
+CO_OD_ENTRY(0x2145, 0x08, 0x8E, CO_OD_RAM.tickStatistics[7])
+CO_OD_ENTRY(0x2145, 0x09, 0x8E, CO_OD_RAM.tickStatistics[8])
+CO_OD_ENTRY(0x2145, 0x0A, 0x8E, CO_OD_RAM.tickStatistics[9])
+CO_OD_ENTRY(0x2145, 0x0B, 0x8E, CO_OD_RAM.tickStatistics[10])
+CO_OD_ENTRY(0x2145, 0x0C, 0x8E, CO_OD_RAM.tickStatistics[11])
+CO_OD_ENTRY(0x2145, 0x0D, 0x8E, CO_OD_RAM.tickStatistics[12])
+CO_OD_ENTRY(0x2146, 0x01, 0x8E, CO_OD_RAM.CANrecorder[0])
+CO_OD_ENTRY(0x2146, 0x02, 0x8E, CO_OD_RAM.CANrecorder[1])
+CO_OD_ENTRY(0x2146, 0x03, 0x8E, CO_OD_RAM.CANrecorder[2])
+CO_OD_ENTRY(0x2146, 0x04, 0x8E, CO_OD_RAM.CANrecorder[3])
+CO_OD_ENTRY(0x2146, 0x05, 0x8E, CO_OD_RAM.CANrecorder[4])
+CO_OD_ENTRY(0x2146, 0x06, 0x8E, CO_OD_RAM.CANrecorder[5])
+CO_OD_ENTRY(0x2146, 0x07, 0x8E, CO_OD_RAM.CANrecorder[6])
+CO_OD_ENTRY(0x2146, 0x08, 0x8E, CO_OD_RAM.CANrecorder[7])
+CO_OD_ENTRY(0x2146, 0x09, 0x8E, CO_OD_RAM.CANrecorder[8])
+CO_OD_ENTRY(0x2146, 0x0A, 0x8E, CO_OD_RAM.CANrecorder[9])
+CO_OD_ENTRY(0x2148, 0x01, 0x8E, CO_OD_RAM.SYNCPLL[0])
+CO_OD_ENTRY(0x2148, 0x02, 0x8E, CO_OD_RAM.SYNCPLL[1])
+CO_OD_ENTRY(0x2148, 0x03, 0x8E, CO_OD_RAM.SYNCPLL[2])
+CO_OD_ENTRY(0x2148, 0x04, 0x8E, CO_OD_RAM.SYNCPLL[3])
+CO_OD_ENTRY(0x2148, 0x05, 0x8E, CO_OD_RAM.SYNCPLL[4])
+CO_OD_ENTRY(0x2149, 0x01, 0x86, CO_OD_RAM.bootTime[0])
+CO_OD_ENTRY(0x2149, 0x02, 0x86, CO_OD_RAM.bootTime[1])
+CO_OD_ENTRY(0x2149, 0x03, 0x86, CO_OD_RAM.bootTime[2])
+CO_OD_ENTRY(0x2149, 0x04, 0x86, CO_OD_RAM.bootTime[3])
+CO_OD_ENTRY(0x2149, 0x05, 0x86, CO_OD_RAM.bootTime[4])
+CO_OD_ENTRY(0x2149, 0x06, 0x86, CO_OD_RAM.bootTime[5])
+CO_OD_ENTRY(0x2149, 0x07, 0x86, CO_OD_RAM.bootTime[6])
+CO_OD_ENTRY(0x214A, 0x01, 0x8E, CO_OD_RAM.worstCase[0])
+CO_OD_ENTRY(0x214A, 0x02, 0x8E, CO_OD_RAM.worstCase[1])
+CO_OD_ENTRY(0x214A, 0x03, 0x8E, CO_OD_RAM.worstCase[2])
+CO_OD_ENTRY(0x214A, 0x04, 0x8E, CO_OD_RAM.worstCase[3])
+CO_OD_ENTRY(0x214A, 0x05, 0x8E, CO_OD_RAM.worstCase[4])
+CO_OD_ENTRY(0x214A, 0x06, 0x8E, CO_OD_RAM.worstCase[5])
+CO_OD_ENTRY(0x214A, 0x07, 0x8E, CO_OD_RAM.worstCase[6])
+CO_OD_ENTRY(0x214A, 0x08, 0x8E, CO_OD_RAM.worstCase[7])
+CO_OD_ENTRY(0x214A, 0x09, 0x8E, CO_OD_RAM.worstCase[8])
+CO_OD_ENTRY(0x214A, 0x0A, 0x8E, CO_OD_RAM.worstCase[9])
+CO_OD_ENTRY(0x214A, 0x0B, 0x8E, CO_OD_RAM.worstCase[10])
+CO_OD_ENTRY(0x214A, 0x0C, 0x8E, CO_OD_RAM.worstCase[11])
+CO_OD_ENTRY(0x214A, 0x0D, 0x8E, CO_OD_RAM.worstCase[12])
+CO_OD_ENTRY(0x214A, 0x0E, 0x8E, CO_OD_RAM.worstCase[13])
+CO_OD_ENTRY(0x214A, 0x0F, 0x8E, CO_OD_RAM.worstCase[14])
+CO_OD_ENTRY(0x214A, 0x10, 0x8E, CO_OD_RAM.worstCase[15])
+CO_OD_ENTRY(0x214A, 0x11, 0x8E, CO_OD_RAM.worstCase[16])
+CO_OD_ENTRY(0x214A, 0x12, 0x8E, CO_OD_RAM.worstCase[17])
+CO_OD_ENTRY(0x214A, 0x13, 0x8E, CO_OD_RAM.worstCase[18])
+CO_OD_ENTRY(0x214A, 0x14, 0x8E, CO_OD_RAM.worstCase[19])
+CO_OD_ENTRY(0x214B, 0x01, 0x8E, CO_OD_RAM.txLatency[0])
+CO_OD_ENTRY(0x214B, 0x02, 0x8E, CO_OD_RAM.txLatency[1])
+CO_OD_ENTRY(0x214B, 0x03, 0x8E, CO_OD_RAM.txLatency[2])
+CO_OD_ENTRY(0x214B, 0x04, 0x8E, CO_OD_RAM.txLatency[3])
+CO_OD_ENTRY(0x214B, 0x05, 0x8E, CO_OD_RAM.txLatency[4])
+CO_OD_ENTRY(0x214B, 0x06, 0x8E, CO_OD_RAM.txLatency[5])
+CO_OD_ENTRY(0x214B, 0x07, 0x8E, CO_OD_RAM.txLatency[6])
+CO_OD_ENTRY(0x214B, 0x08, 0x8E, CO_OD_RAM.txLatency[7])
+CO_OD_ENTRY(0x214B, 0x09, 0x8E, CO_OD_RAM.txLatency[8])
+CO_OD_ENTRY(0x214B, 0x0A, 0x8E, CO_OD_RAM.txLatency[9])
+CO_OD_ENTRY(0x214B, 0x0B, 0x8E, CO_OD_RAM.txLatency[10])
+CO_OD_ENTRY(0x214B, 0x0C, 0x8E, CO_OD_RAM.txLatency[11])
+CO_OD_ENTRY(0x214C, 0x01, 0x8E, CO_OD_RAM.governor[0])
+CO_OD_ENTRY(0x214C, 0x02, 0x8E, CO_OD_RAM.governor[1])
+CO_OD_ENTRY(0x214C, 0x03, 0x8E, CO_OD_RAM.governor[2])
+CO_OD_ENTRY(0x214C, 0x04, 0x8E, CO_OD_RAM.governor[3])
+CO_OD_ENTRY(0x2301, 0x00, 0x05, CO_OD_ROM.traceConfig[0].maxSubIndex)
+CO_OD_ENTRY(0x2301, 0x01, 0x8D, CO_OD_ROM.traceConfig[0].size)
+CO_OD_ENTRY(0x2301, 0x02, 0x0D, CO_OD_ROM.traceConfig[0].axisNo)
+CO_OD_ENTRY(0x2301, 0x03, 0x0D, CO_OD_ROM.traceConfig[0].name[0])
+CO_OD_ENTRY(0x2301, 0x04, 0x0D, CO_OD_ROM.traceConfig[0].color[0])
+CO_OD_ENTRY(0x2301, 0x05, 0x8D, CO_OD_ROM.traceConfig[0].map)
+CO_OD_ENTRY(0x2301, 0x06, 0x0D, CO_OD_ROM.traceConfig[0].format)
+CO_OD_ENTRY(0x2301, 0x07, 0x0D, CO_OD_ROM.traceConfig[0].trigger)
+CO_OD_ENTRY(0x2301, 0x08, 0x8D, CO_OD_ROM.traceConfig[0].threshold)
+CO_OD_ENTRY(0x2302, 0x00, 0x05, CO_OD_ROM.traceConfig[1].maxSubIndex)
+CO_OD_ENTRY(0x2302, 0x01, 0x8D, CO_OD_ROM.traceConfig[1].size)
+CO_OD_ENTRY(0x2302, 0x02, 0x0D, CO_OD_ROM.traceConfig[1].axisNo)
+CO_OD_ENTRY(0x2302, 0x03, 0x0D, CO_OD_ROM.traceConfig[1].name[0])
+CO_OD_ENTRY(0x2302, 0x04, 0x0D, CO_OD_ROM.traceConfig[1].color[0])
+CO_OD_ENTRY(0x2302, 0x05, 0x8D, CO_OD_ROM.traceConfig[1].map)
+CO_OD_ENTRY(0x2302, 0x06, 0x0D, CO_OD_ROM.traceConfig[1].format)
+CO_OD_ENTRY(0x2302, 0x07, 0x0D, CO_OD_ROM.traceConfig[1].trigger)
+CO_OD_ENTRY(0x2302, 0x08, 0x8D, CO_OD_ROM.traceConfig[1].threshold)
+CO_OD_ENTRY(0x2400, 0x00, 0x3E, CO_OD_RAM.traceEnable)
+CO_OD_ENTRY(0x2401, 0x00, 0x06, CO_OD_RAM.trace[0].maxSubIndex)
+CO_OD_ENTRY(0x2401, 0x01, 0xBE, CO_OD_RAM.trace[0].size)
+CO_OD_ENTRY(0x2401, 0x02, 0xA6, CO_OD_RAM.trace[0].value)
+CO_OD_ENTRY(0x2401, 0x03, 0xBE, CO_OD_RAM.trace[0].min)
+CO_OD_ENTRY(0x2401, 0x04, 0xBE, CO_OD_RAM.trace[0].max)
+CO_OD_ENTRY(0x2401, 0x06, 0xBE, CO_OD_RAM.trace[0].triggerTime)
+CO_OD_ENTRY(0x2402, 0x00, 0x06, CO_OD_RAM.trace[1].maxSubIndex)
+CO_OD_ENTRY(0x2402, 0x01, 0xBE, CO_OD_RAM.trace[1].size)
+CO_OD_ENTRY(0x2402, 0x02, 0xA6, CO_OD_RAM.trace[1].value)
+CO_OD_ENTRY(0x2402, 0x03, 0xBE, CO_OD_RAM.trace[1].min)
+CO_OD_ENTRY(0x2402, 0x04, 0xBE, CO_OD_RAM.trace[1].max)
+CO_OD_ENTRY(0x2402, 0x06, 0xBE, CO_OD_RAM.trace[1].triggerTime)
+CO_OD_ENTRY(0x6000, 0x01, 0x76, CO_OD_RAM.readInput8Bit[0])
+CO_OD_ENTRY(0x6000, 0x02, 0x76, CO_OD_RAM.readInput8Bit[1])
+CO_OD_ENTRY(0x6000, 0x03, 0x76, CO_OD_RAM.readInput8Bit[2])
+CO_OD_ENTRY(0x6000, 0x04, 0x76, CO_OD_RAM.readInput8Bit[3])
+CO_OD_ENTRY(0x6000, 0x05, 0x76, CO_OD_RAM.readInput8Bit[4])
+CO_OD_ENTRY(0x6000, 0x06, 0x76, CO_OD_RAM.readInput8Bit[5])
+CO_OD_ENTRY(0x6000, 0x07, 0x76, CO_OD_RAM.readInput8Bit[6])
+CO_OD_ENTRY(0x6000, 0x08, 0x76, CO_OD_RAM.readInput8Bit[7])
+CO_OD_ENTRY(0x6200, 0x01, 0x3E, CO_OD_RAM.writeOutput8Bit[0])
+CO_OD_ENTRY(0x6200, 0x02, 0x3E, CO_OD_RAM.writeOutput8Bit[1])
+CO_OD_ENTRY(0x6200, 0x03, 0x3E, CO_OD_RAM.writeOutput8Bit[2])
+CO_OD_ENTRY(0x6200, 0x04, 0x3E, CO_OD_RAM.writeOutput8Bit[3])
+CO_OD_ENTRY(0x6200, 0x05, 0x3E, CO_OD_RAM.writeOutput8Bit[4])
+CO_OD_ENTRY(0x6200, 0x06, 0x3E, CO_OD_RAM.writeOutput8Bit[5])
+CO_OD_ENTRY(0x6200, 0x07, 0x3E, CO_OD_RAM.writeOutput8Bit[6])
+CO_OD_ENTRY(0x6200, 0x08, 0x3E, CO_OD_RAM.writeOutput8Bit[7])
+CO_OD_ENTRY(0x6401, 0x01, 0xB6, CO_OD_RAM.readAnalogueInput16Bit[0])
+CO_OD_ENTRY(0x6401, 0x02, 0xB6, CO_OD_RAM.readAnalogueInput16Bit[1])
+CO_OD_ENTRY(0x6401, 0x03, 0xB6, CO_OD_RAM.readAnalogueInput16Bit[2])
+CO_OD_ENTRY(0x6401, 0x04, 0xB6, CO_OD_RAM.readAnalogueInput16Bit[3])
+CO_OD_ENTRY(0x6401, 0x05, 0xB6, CO_OD_RAM.readAnalogueInput16Bit[4])
+CO_OD_ENTRY(0x6401, 0x06, 0xB6, CO_OD_RAM.readAnalogueInput16Bit[5])
+CO_OD_ENTRY(0x6401, 0x07, 0xB6, CO_OD_RAM.readAnalogueInput16Bit[6])
+CO_OD_ENTRY(0x6401, 0x08, 0xB6, CO_OD_RAM.readAnalogueInput16Bit[7])
+CO_OD_ENTRY(0x6401, 0x09, 0xB6, CO_OD_RAM.readAnalogueInput16Bit[8])
+CO_OD_ENTRY(0x6401, 0x0A, 0xB6, CO_OD_RAM.readAnalogueInput16Bit[9])
+CO_OD_ENTRY(0x6401, 0x0B, 0xB6, CO_OD_RAM.readAnalogueInput16Bit[10])
+CO_OD_ENTRY(0x6401, 0x0C, 0xB6, CO_OD_RAM.readAnalogueInput16Bit[11])
+CO_OD_ENTRY(0x6411, 0x01, 0xBE, CO_OD_RAM.writeAnalogueOutput16Bit[0])
+CO_OD_ENTRY(0x6411, 0x02, 0xBE, CO_OD_RAM.writeAnalogueOutput16Bit[1])
+CO_OD_ENTRY(0x6411, 0x03, 0xBE, CO_OD_RAM.writeAnalogueOutput16Bit[2])
+CO_OD_ENTRY(0x6411, 0x04, 0xBE, CO_OD_RAM.writeAnalogueOutput16Bit[3])
+CO_OD_ENTRY(0x6411, 0x05, 0xBE, CO_OD_RAM.writeAnalogueOutput16Bit[4])
+CO_OD_ENTRY(0x6411, 0x06, 0xBE, CO_OD_RAM.writeAnalogueOutput16Bit[5])
+CO_OD_ENTRY(0x6411, 0x07, 0xBE, CO_OD_RAM.writeAnalogueOutput16Bit[6])
+CO_OD_ENTRY(0x6411, 0x08, 0xBE, CO_OD_RAM.writeAnalogueOutput16Bit[7])
+
+#endif /* CO_OD_HPP */
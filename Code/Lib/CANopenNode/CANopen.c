@@ -65,20 +65,29 @@
 
 /* Global variables ***********************************************************/
     extern const CO_OD_entry_t CO_OD[CO_OD_NoOfElements];  /* Object Dictionary array */
-    static CO_t COO;
+    static CO_t COO[CO_NO_INSTANCES];
     CO_t *CO = NULL;
+    CO_t *CO_instances[CO_NO_INSTANCES];
 
+    /* Object Dictionary from CO_OD.h, used by CO_init() */
+    static const CO_ODconfig_t CO_ODdefault = CO_OD_CONFIG(CO_OD);
+
+#ifndef CO_USE_GLOBALS
     static CO_CANrx_t          *CO_CANmodule_rxArray0;
     static CO_CANtx_t          *CO_CANmodule_txArray0;
-    static CO_OD_extension_t   *CO_SDO_ODExtensions;
-    static CO_HBconsNode_t     *CO_HBcons_monitoredNodes;
+#endif
 #if CO_NO_TRACE > 0
+    /* trace is used by CANopen device 0 only */
     static uint32_t            *CO_traceTimeBuffers[CO_NO_TRACE];
     static int32_t             *CO_traceValueBuffers[CO_NO_TRACE];
+    static uint32_t             CO_traceBufferSize[CO_NO_TRACE];
   #ifdef CO_USE_GLOBALS
   #ifndef CO_TRACE_BUFFER_SIZE_FIXED
     #define CO_TRACE_BUFFER_SIZE_FIXED 100
   #endif
+  #ifndef CO_TRACE_BUFFER_ATTR
+    #define CO_TRACE_BUFFER_ATTR
+  #endif
   #endif
 #endif
 
@@ -86,81 +95,164 @@
 /* Verify features from CO_OD *************************************************/
     /* generate error, if features are not correctly configured for this project */
     #if        CO_NO_NMT_MASTER                           >  1     \
-            || CO_NO_SYNC                                 != 1     \
+            || CO_NO_SYNC                                 >  1     \
             || CO_NO_EMERGENCY                            != 1     \
             || CO_NO_SDO_SERVER                           == 0     \
             || (CO_NO_SDO_CLIENT != 0 && CO_NO_SDO_CLIENT != 1)    \
             || (CO_NO_RPDO < 1 || CO_NO_RPDO > 0x200)              \
             || (CO_NO_TPDO < 1 || CO_NO_TPDO > 0x200)              \
-            || ODL_consumerHeartbeatTime_arrayLength      == 0     \
-            || ODL_errorStatusBits_stringLength           < 10
+            || ODL_errorStatusBits_stringLength           < 10     \
+            || (CO_NO_LSS_SERVER != 0 && CO_NO_LSS_SERVER != 1)    \
+            || (CO_NO_LSS_CLIENT != 0 && CO_NO_LSS_CLIENT != 1)    \
+            || (CO_NO_EM_CONS != 0 && CO_NO_EM_CONS != 1)         \
+            || (CO_NO_TIME != 0 && CO_NO_TIME != 1)               \
+            || CO_NO_INSTANCES < 1 || CO_NO_INSTANCES > 127
         #error Features from CO_OD.h file are not corectly configured for this project!
     #endif
+    #if CO_NO_SYNC == 0 && (CO_SYNC_HW_TIMER > 0 || CO_SYNC_WINDOW_TIMER > 0)
+        #error CO_SYNC_HW_TIMER and CO_SYNC_WINDOW_TIMER require SYNC object!
+    #endif
+    #if CO_NO_INSTANCES > 1 && !defined CO_USE_GLOBALS
+        #error CO_NO_INSTANCES above 1 requires CO_USE_GLOBALS!
+    #endif
+
+    /* Compile time assertion, fails with negative array size if expr is false */
+    #define CO_STATIC_ASSERT(expr, msg) CO_STATIC_ASSERT_(expr, msg, __LINE__)
+    #define CO_STATIC_ASSERT_(expr, msg, line) CO_STATIC_ASSERT__(expr, msg, line)
+    #define CO_STATIC_ASSERT__(expr, msg, line) \
+        typedef char CO_static_assert_##msg##_##line[(expr) ? 1 : -1]
+
+    /* Object Dictionary records must match stack structures, which are
+     * accessed directly by the stack (no runtime check in CO_init). */
+    CO_STATIC_ASSERT(sizeof(OD_TPDOCommunicationParameter_t) == sizeof(CO_TPDOCommPar_t), TPDOCommPar);
+    CO_STATIC_ASSERT(sizeof(OD_TPDOMappingParameter_t) == sizeof(CO_TPDOMapPar_t), TPDOMapPar);
+    CO_STATIC_ASSERT(sizeof(OD_RPDOCommunicationParameter_t) == sizeof(CO_RPDOCommPar_t), RPDOCommPar);
+    CO_STATIC_ASSERT(sizeof(OD_RPDOMappingParameter_t) == sizeof(CO_RPDOMapPar_t), RPDOMapPar);
+#if CO_NO_SDO_CLIENT == 1
+    CO_STATIC_ASSERT(sizeof(OD_SDOClientParameter_t) == sizeof(CO_SDOclientPar_t), SDOclientPar);
+#endif
 
+    /* Object Dictionary must have parameters for each configured PDO */
+    CO_STATIC_ASSERT(sizeof(OD_RPDOCommunicationParameter) == CO_NO_RPDO * sizeof(CO_RPDOCommPar_t), RPDOCommParCount);
+    CO_STATIC_ASSERT(sizeof(OD_RPDOMappingParameter) == CO_NO_RPDO * sizeof(CO_RPDOMapPar_t), RPDOMapParCount);
+    CO_STATIC_ASSERT(sizeof(OD_TPDOCommunicationParameter) == CO_NO_TPDO * sizeof(CO_TPDOCommPar_t), TPDOCommParCount);
+    CO_STATIC_ASSERT(sizeof(OD_TPDOMappingParameter) == CO_NO_TPDO * sizeof(CO_TPDOMapPar_t), TPDOMapParCount);
 
-/* Indexes for CANopenNode message objects ************************************/
-    #ifdef ODL_consumerHeartbeatTime_arrayLength
-        #define CO_NO_HB_CONS   ODL_consumerHeartbeatTime_arrayLength
-    #else
-        #define CO_NO_HB_CONS   0
-    #endif
 
+/* Indexes for CANopenNode message objects ************************************/
+#if CO_HB_CONS_RANGE > 0 && CO_NO_HB_CONS > 0
+    #define CO_NO_HB_CONS_RX   1                                      /*  one receive buffer for all heartbeats */
+#else
+    #define CO_NO_HB_CONS_RX   CO_NO_HB_CONS
+#endif
     #define CO_RXCAN_NMT       0                                      /*  index for NMT message */
     #define CO_RXCAN_SYNC      1                                      /*  index for SYNC message */
     #define CO_RXCAN_RPDO     (CO_RXCAN_SYNC+CO_NO_SYNC)              /*  start index for RPDO messages */
     #define CO_RXCAN_SDO_SRV  (CO_RXCAN_RPDO+CO_NO_RPDO)              /*  start index for SDO server message (request) */
-    #define CO_RXCAN_SDO_CLI  (CO_RXCAN_SDO_SRV+CO_NO_SDO_SERVER)     /*  start index for SDO client message (response) */
+    #define CO_RXCAN_SDO_CLI  (CO_RXCAN_SDO_SRV+CO_NO_SDO_SERVER_CAN) /*  start index for SDO client message (response) */
     #define CO_RXCAN_CONS_HB  (CO_RXCAN_SDO_CLI+CO_NO_SDO_CLIENT)     /*  start index for Heartbeat Consumer messages */
+    #define CO_RXCAN_LSS      (CO_RXCAN_CONS_HB+CO_NO_HB_CONS_RX)     /*  index for LSS slave message (request) */
+    #define CO_RXCAN_LSS_M    (CO_RXCAN_LSS+CO_NO_LSS_SERVER)         /*  index for LSS master message (response) */
+    #define CO_RXCAN_EM_CONS  (CO_RXCAN_LSS_M+CO_NO_LSS_CLIENT)       /*  index for Emergency consumer messages, after SYNC */
+    #define CO_RXCAN_TIME     (CO_RXCAN_EM_CONS+CO_NO_EM_CONS)        /*  index for TIME message */
+    #define CO_RXCAN_SDO_CLI_M (CO_RXCAN_TIME+CO_NO_TIME)             /*  start index for SDO clients of NMT master (response) */
     /* total number of received CAN messages */
-    #define CO_RXCAN_NO_MSGS (1+CO_NO_SYNC+CO_NO_RPDO+CO_NO_SDO_SERVER+CO_NO_SDO_CLIENT+CO_NO_HB_CONS)
+    #define CO_RXCAN_NO_MSGS (1+CO_NO_SYNC+CO_NO_RPDO+CO_NO_SDO_SERVER_CAN+CO_NO_SDO_CLIENT+CO_NO_HB_CONS_RX+CO_NO_LSS_SERVER+CO_NO_LSS_CLIENT+CO_NO_EM_CONS+CO_NO_TIME+CO_NO_SDO_CLIENT_NMTM)
 
     #define CO_TXCAN_NMT       0                                      /*  index for NMT master message */
     #define CO_TXCAN_SYNC      CO_TXCAN_NMT+CO_NO_NMT_MASTER          /*  index for SYNC message */
     #define CO_TXCAN_EMERG    (CO_TXCAN_SYNC+CO_NO_SYNC)              /*  index for Emergency message */
     #define CO_TXCAN_TPDO     (CO_TXCAN_EMERG+CO_NO_EMERGENCY)        /*  start index for TPDO messages */
     #define CO_TXCAN_SDO_SRV  (CO_TXCAN_TPDO+CO_NO_TPDO)              /*  start index for SDO server message (response) */
-    #define CO_TXCAN_SDO_CLI  (CO_TXCAN_SDO_SRV+CO_NO_SDO_SERVER)     /*  start index for SDO client message (request) */
+    #define CO_TXCAN_SDO_CLI  (CO_TXCAN_SDO_SRV+CO_NO_SDO_SERVER_CAN) /*  start index for SDO client message (request) */
     #define CO_TXCAN_HB       (CO_TXCAN_SDO_CLI+CO_NO_SDO_CLIENT)     /*  index for Heartbeat message */
+    #define CO_TXCAN_LSS      (CO_TXCAN_HB+1)                         /*  index for LSS slave message (response) */
+    #define CO_TXCAN_LSS_M    (CO_TXCAN_LSS+CO_NO_LSS_SERVER)         /*  index for LSS master message (request) */
+    #define CO_TXCAN_TIME     (CO_TXCAN_LSS_M+CO_NO_LSS_CLIENT)       /*  index for TIME message */
+    #define CO_TXCAN_SDO_CLI_M (CO_TXCAN_TIME+CO_NO_TIME)             /*  start index for SDO clients of NMT master (request) */
     /* total number of transmitted CAN messages */
-    #define CO_TXCAN_NO_MSGS (CO_NO_NMT_MASTER+CO_NO_SYNC+CO_NO_EMERGENCY+CO_NO_TPDO+CO_NO_SDO_SERVER+CO_NO_SDO_CLIENT+1)
+    #define CO_TXCAN_NO_MSGS (CO_NO_NMT_MASTER+CO_NO_SYNC+CO_NO_EMERGENCY+CO_NO_TPDO+CO_NO_SDO_SERVER_CAN+CO_NO_SDO_CLIENT+1+CO_NO_LSS_SERVER+CO_NO_LSS_CLIENT+CO_NO_TIME+CO_NO_SDO_CLIENT_NMTM)
+
+    /* many TPDOs need more words in CAN driver transmit queue */
+    #if CO_TXCAN_NO_MSGS > (CO_CAN_TX_PENDING_WORDS * 32)
+        #error CO_CAN_TX_PENDING_WORDS is too small for CO_NO_TPDO!
+    #endif
 
 
 #ifdef CO_USE_GLOBALS
-    static CO_CANmodule_t       COO_CANmodule;
-    static CO_CANrx_t           COO_CANmodule_rxArray0[CO_RXCAN_NO_MSGS];
-    static CO_CANtx_t           COO_CANmodule_txArray0[CO_TXCAN_NO_MSGS];
-    static CO_SDO_t             COO_SDO[CO_NO_SDO_SERVER];
-    static CO_OD_extension_t    COO_SDO_ODExtensions[CO_OD_NoOfElements];
-    static CO_EM_t              COO_EM;
-    static CO_EMpr_t            COO_EMpr;
-    static CO_NMT_t             COO_NMT;
-    static CO_SYNC_t            COO_SYNC;
-    static CO_RPDO_t            COO_RPDO[CO_NO_RPDO];
-    static CO_TPDO_t            COO_TPDO[CO_NO_TPDO];
-    static CO_HBconsumer_t      COO_HBcons;
-    static CO_HBconsNode_t      COO_HBcons_monitoredNodes[CO_NO_HB_CONS];
+  /* Section of objects used by CAN interrupt and timer thread, for example
+   * zero wait state RAM. Default is .bss */
+  #ifndef CO_ATTR_HOT
+    #define CO_ATTR_HOT
+  #endif
+    /* CANopen devices on one CAN module use consecutive slices of its arrays */
+    static CO_CANmodule_t       COO_CANmodule[CO_NO_INSTANCES] CO_ATTR_HOT;
+    static CO_CANrx_t           COO_CANmodule_rxArray0[CO_NO_INSTANCES * CO_RXCAN_NO_MSGS] CO_ATTR_HOT;
+    static CO_CANtx_t           COO_CANmodule_txArray0[CO_NO_INSTANCES * CO_TXCAN_NO_MSGS] CO_ATTR_HOT;
+    static CO_SDO_t             COO_SDO[CO_NO_INSTANCES][CO_NO_SDO_SERVER];
+    static CO_OD_extension_t    COO_SDO_ODExtensions[CO_NO_INSTANCES][CO_OD_NoOfElements];
+  #if CO_SDO_BUFFER_POOL > 0
+    static CO_SDObufferPool_t   COO_SDO_bufferPool[CO_NO_INSTANCES];
+  #endif
+  #if CO_OD_NOTIFY > 0
+    static CO_ODnotify_t        COO_ODnotify[CO_NO_INSTANCES];
+  #endif
+    static CO_EM_t              COO_EM[CO_NO_INSTANCES];
+    static CO_EMpr_t            COO_EMpr[CO_NO_INSTANCES];
+    static CO_NMT_t             COO_NMT[CO_NO_INSTANCES];
+  #if CO_NO_SYNC == 1
+    static CO_SYNC_t            COO_SYNC[CO_NO_INSTANCES] CO_ATTR_HOT;
+  #endif
+    static CO_RPDO_t            COO_RPDO[CO_NO_INSTANCES][CO_NO_RPDO] CO_ATTR_HOT;
+    static CO_TPDO_t            COO_TPDO[CO_NO_INSTANCES][CO_NO_TPDO] CO_ATTR_HOT;
+  #if CO_TPDO_CALENDAR > 0
+    static CO_TPDOcalendar_t    COO_TPDOcal[CO_NO_INSTANCES];
+    static CO_TPDO_t           *COO_TPDOcalHeap[CO_NO_INSTANCES][CO_NO_TPDO];
+  #endif
+  #if CO_NO_HB_CONS > 0
+    static CO_HBconsumer_t      COO_HBcons[CO_NO_INSTANCES];
+    static CO_HBconsNode_t      COO_HBcons_monitoredNodes[CO_NO_INSTANCES][CO_NO_HB_CONS];
+  #endif
 #if CO_NO_SDO_CLIENT == 1
-    static CO_SDOclient_t       COO_SDOclient;
+    static CO_SDOclient_t       COO_SDOclient[CO_NO_INSTANCES];
+    static CO_SDOclientQueue_t  COO_SDOqueue[CO_NO_INSTANCES];
+#endif
+#if CO_NO_SDO_CLIENT_NMTM > 0
+    static CO_SDOclient_t       COO_SDOclientNMTM[CO_NO_INSTANCES][CO_NO_SDO_CLIENT_NMTM];
+    static CO_SDOclientPar_t    COO_SDOclientParNMTM[CO_NO_INSTANCES][CO_NO_SDO_CLIENT_NMTM];
+#endif
+#if CO_NO_NMT_MASTER == 1 && CO_NO_SDO_CLIENT == 1
+    static CO_NMTmaster_t       COO_NMTmaster[CO_NO_INSTANCES];
 #endif
 #if CO_NO_TRACE > 0
     static CO_trace_t           COO_trace[CO_NO_TRACE];
-    static uint32_t             COO_traceTimeBuffers[CO_NO_TRACE][CO_TRACE_BUFFER_SIZE_FIXED];
-    static int32_t              COO_traceValueBuffers[CO_NO_TRACE][CO_TRACE_BUFFER_SIZE_FIXED];
+    static uint32_t             COO_traceTimeBuffers[CO_NO_TRACE][CO_TRACE_BUFFER_SIZE_FIXED] CO_TRACE_BUFFER_ATTR;
+    static int32_t              COO_traceValueBuffers[CO_NO_TRACE][CO_TRACE_BUFFER_SIZE_FIXED] CO_TRACE_BUFFER_ATTR;
+#endif
+#if CO_NO_LSS_SERVER == 1
+    static CO_LSSslave_t        COO_LSSslave[CO_NO_INSTANCES];
+#endif
+#if CO_NO_LSS_CLIENT == 1
+    static CO_LSSmaster_t       COO_LSSmaster[CO_NO_INSTANCES];
+#endif
+#if CO_NO_EM_CONS == 1
+    static CO_EMconsumer_t      COO_EMcons[CO_NO_INSTANCES];
+#endif
+#if CO_NO_TIME == 1
+    static CO_TIME_t            COO_TIME[CO_NO_INSTANCES];
 #endif
 #endif
 
 
 /* Helper function for NMT master *********************************************/
 #if CO_NO_NMT_MASTER == 1
-    CO_CANtx_t *NMTM_txBuff = 0;
-
     uint8_t CO_sendNMTcommand(CO_t *CO, uint8_t command, uint8_t nodeID){
-        if(NMTM_txBuff == 0){
+        if(CO->NMTM_txBuff == 0){
             /* error, CO_CANtxBufferInit() was not called for this buffer. */
             return CO_ERROR_TX_UNCONFIGURED; /* -11 */
         }
-        NMTM_txBuff->data[0] = command;
-        NMTM_txBuff->data[1] = nodeID;
+        CO->NMTM_txBuff->data[0] = command;
+        CO->NMTM_txBuff->data[1] = nodeID;
 
         /* Apply NMT command also to this node, if set so. */
         if(nodeID == 0 || nodeID == CO->NMT->nodeId){
@@ -185,102 +277,138 @@
             }
         }
 
-        return CO_CANsend(CO->CANmodule[0], NMTM_txBuff); /* 0 = success */
+        return CO_CANsend(CO->CANmodule[0], CO->NMTM_txBuff); /* 0 = success */
     }
 #endif
 
 
-/******************************************************************************/
-CO_ReturnError_t CO_init(
-        int32_t                 CANbaseAddress,
-        uint8_t                 nodeId,
-        uint16_t                bitRate)
-{
-
+/* Assign or allocate objects of CANopen device *******************************/
+static CO_ReturnError_t CO_new(uint8_t instance){
+    CO_t *co = &COO[instance];
     int16_t i;
-    CO_ReturnError_t err;
 #ifndef CO_USE_GLOBALS
     uint16_t errCnt;
 #endif
-#if CO_NO_TRACE > 0
-    uint32_t CO_traceBufferSize[CO_NO_TRACE];
-#endif
-
-    /* Verify parameters from CO_OD */
-    if(   sizeof(OD_TPDOCommunicationParameter_t) != sizeof(CO_TPDOCommPar_t)
-       || sizeof(OD_TPDOMappingParameter_t) != sizeof(CO_TPDOMapPar_t)
-       || sizeof(OD_RPDOCommunicationParameter_t) != sizeof(CO_RPDOCommPar_t)
-       || sizeof(OD_RPDOMappingParameter_t) != sizeof(CO_RPDOMapPar_t))
-    {
-        return CO_ERROR_PARAMETERS;
-    }
-
-    #if CO_NO_SDO_CLIENT == 1
-    if(sizeof(OD_SDOClientParameter_t) != sizeof(CO_SDOclientPar_t)){
-        return CO_ERROR_PARAMETERS;
-    }
-    #endif
 
+    /* Parameters from CO_OD are verified at compile time, see CO_STATIC_ASSERT */
+    CO_instances[instance] = co;
+    CO = CO_instances[0];
 
-    /* Initialize CANopen object */
 #ifdef CO_USE_GLOBALS
-    CO = &COO;
-
-    CO->CANmodule[0]                    = &COO_CANmodule;
-    CO_CANmodule_rxArray0               = &COO_CANmodule_rxArray0[0];
-    CO_CANmodule_txArray0               = &COO_CANmodule_txArray0[0];
     for(i=0; i<CO_NO_SDO_SERVER; i++)
-        CO->SDO[i]                      = &COO_SDO[i];
-    CO_SDO_ODExtensions                 = &COO_SDO_ODExtensions[0];
-    CO->em                              = &COO_EM;
-    CO->emPr                            = &COO_EMpr;
-    CO->NMT                             = &COO_NMT;
-    CO->SYNC                            = &COO_SYNC;
+        co->SDO[i]                      = &COO_SDO[instance][i];
+    co->ODExtensions                    = &COO_SDO_ODExtensions[instance][0];
+  #if CO_SDO_BUFFER_POOL > 0
+    co->SDObufferPool                   = &COO_SDO_bufferPool[instance];
+  #endif
+  #if CO_OD_NOTIFY > 0
+    co->ODnotify                        = &COO_ODnotify[instance];
+  #endif
+    co->em                              = &COO_EM[instance];
+    co->emPr                            = &COO_EMpr[instance];
+    co->NMT                             = &COO_NMT[instance];
+  #if CO_NO_SYNC == 1
+    co->SYNC                            = &COO_SYNC[instance];
+  #else
+    co->SYNC                            = NULL;
+  #endif
     for(i=0; i<CO_NO_RPDO; i++)
-        CO->RPDO[i]                     = &COO_RPDO[i];
+        co->RPDO[i]                     = &COO_RPDO[instance][i];
     for(i=0; i<CO_NO_TPDO; i++)
-        CO->TPDO[i]                     = &COO_TPDO[i];
-    CO->HBcons                          = &COO_HBcons;
-    CO_HBcons_monitoredNodes            = &COO_HBcons_monitoredNodes[0];
+        co->TPDO[i]                     = &COO_TPDO[instance][i];
+  #if CO_TPDO_CALENDAR > 0
+    co->TPDOcal                         = &COO_TPDOcal[instance];
+  #endif
+  #if CO_NO_HB_CONS > 0
+    co->HBcons                          = &COO_HBcons[instance];
+    co->HBconsNodes                     = &COO_HBcons_monitoredNodes[instance][0];
+  #else
+    co->HBcons                          = NULL;
+    co->HBconsNodes                     = NULL;
+  #endif
   #if CO_NO_SDO_CLIENT == 1
-    CO->SDOclient                       = &COO_SDOclient;
+    co->SDOclient                       = &COO_SDOclient[instance];
+    co->SDOqueue                        = &COO_SDOqueue[instance];
+  #endif
+  #if CO_NO_SDO_CLIENT_NMTM > 0
+    for(i=0; i<CO_NO_SDO_CLIENT_NMTM; i++)
+        co->SDOqueueClients[1+i]        = &COO_SDOclientNMTM[instance][i];
+    co->SDOclientParNMTM                = &COO_SDOclientParNMTM[instance][0];
+  #endif
+  #if CO_NO_NMT_MASTER == 1 && CO_NO_SDO_CLIENT == 1
+    co->NMTmaster                       = &COO_NMTmaster[instance];
   #endif
   #if CO_NO_TRACE > 0
-    for(i=0; i<CO_NO_TRACE; i++) {
-        CO->trace[i]                    = &COO_trace[i];
+    for(i=0; i<CO_NO_TRACE && instance==0; i++) {
+        co->trace[i]                    = &COO_trace[i];
         CO_traceTimeBuffers[i]          = &COO_traceTimeBuffers[i][0];
         CO_traceValueBuffers[i]         = &COO_traceValueBuffers[i][0];
         CO_traceBufferSize[i]           = CO_TRACE_BUFFER_SIZE_FIXED;
     }
   #endif
+  #if CO_NO_LSS_SERVER == 1
+    co->LSSslave                        = &COO_LSSslave[instance];
+  #endif
+  #if CO_NO_LSS_CLIENT == 1
+    co->LSSmaster                       = &COO_LSSmaster[instance];
+  #endif
+  #if CO_NO_EM_CONS == 1
+    co->emCons                          = &COO_EMcons[instance];
+  #endif
+  #if CO_NO_TIME == 1
+    co->TIME                            = &COO_TIME[instance];
+  #endif
 #else
-    if(CO == NULL){    /* Use malloc only once */
-        CO = &COO;
-        CO->CANmodule[0]                    = (CO_CANmodule_t *)    calloc(1, sizeof(CO_CANmodule_t));
+    if(co->CANmodule[0] == NULL){    /* Use malloc only once */
+        co->CANmodule[0]                    = (CO_CANmodule_t *)    calloc(1, sizeof(CO_CANmodule_t));
         CO_CANmodule_rxArray0               = (CO_CANrx_t *)        calloc(CO_RXCAN_NO_MSGS, sizeof(CO_CANrx_t));
         CO_CANmodule_txArray0               = (CO_CANtx_t *)        calloc(CO_TXCAN_NO_MSGS, sizeof(CO_CANtx_t));
         for(i=0; i<CO_NO_SDO_SERVER; i++){
-            CO->SDO[i]                      = (CO_SDO_t *)          calloc(1, sizeof(CO_SDO_t));
+            co->SDO[i]                      = (CO_SDO_t *)          calloc(1, sizeof(CO_SDO_t));
         }
-        CO_SDO_ODExtensions                 = (CO_OD_extension_t*)  calloc(CO_OD_NoOfElements, sizeof(CO_OD_extension_t));
-        CO->em                              = (CO_EM_t *)           calloc(1, sizeof(CO_EM_t));
-        CO->emPr                            = (CO_EMpr_t *)         calloc(1, sizeof(CO_EMpr_t));
-        CO->NMT                             = (CO_NMT_t *)          calloc(1, sizeof(CO_NMT_t));
-        CO->SYNC                            = (CO_SYNC_t *)         calloc(1, sizeof(CO_SYNC_t));
+        co->ODExtensions                    = (CO_OD_extension_t*)  calloc(CO_OD_NoOfElements, sizeof(CO_OD_extension_t));
+      #if CO_SDO_BUFFER_POOL > 0
+        co->SDObufferPool                   = (CO_SDObufferPool_t*) calloc(1, sizeof(CO_SDObufferPool_t));
+      #endif
+      #if CO_OD_NOTIFY > 0
+        co->ODnotify                        = (CO_ODnotify_t*)      calloc(1, sizeof(CO_ODnotify_t));
+      #endif
+        co->em                              = (CO_EM_t *)           calloc(1, sizeof(CO_EM_t));
+        co->emPr                            = (CO_EMpr_t *)         calloc(1, sizeof(CO_EMpr_t));
+        co->NMT                             = (CO_NMT_t *)          calloc(1, sizeof(CO_NMT_t));
+      #if CO_NO_SYNC == 1
+        co->SYNC                            = (CO_SYNC_t *)         calloc(1, sizeof(CO_SYNC_t));
+      #endif
         for(i=0; i<CO_NO_RPDO; i++){
-            CO->RPDO[i]                     = (CO_RPDO_t *)         calloc(1, sizeof(CO_RPDO_t));
+            co->RPDO[i]                     = (CO_RPDO_t *)         calloc(1, sizeof(CO_RPDO_t));
         }
         for(i=0; i<CO_NO_TPDO; i++){
-            CO->TPDO[i]                     = (CO_TPDO_t *)         calloc(1, sizeof(CO_TPDO_t));
+            co->TPDO[i]                     = (CO_TPDO_t *)         calloc(1, sizeof(CO_TPDO_t));
         }
-        CO->HBcons                          = (CO_HBconsumer_t *)   calloc(1, sizeof(CO_HBconsumer_t));
-        CO_HBcons_monitoredNodes            = (CO_HBconsNode_t *)   calloc(CO_NO_HB_CONS, sizeof(CO_HBconsNode_t));
+      #if CO_TPDO_CALENDAR > 0
+        /* heap follows the calendar object */
+        co->TPDOcal                         = (CO_TPDOcalendar_t *) calloc(1, sizeof(CO_TPDOcalendar_t) + CO_NO_TPDO * sizeof(CO_TPDO_t *));
+      #endif
+      #if CO_NO_HB_CONS > 0
+        co->HBcons                          = (CO_HBconsumer_t *)   calloc(1, sizeof(CO_HBconsumer_t));
+        co->HBconsNodes                     = (CO_HBconsNode_t *)   calloc(CO_NO_HB_CONS, sizeof(CO_HBconsNode_t));
+      #endif
       #if CO_NO_SDO_CLIENT == 1
-        CO->SDOclient                       = (CO_SDOclient_t *)    calloc(1, sizeof(CO_SDOclient_t));
+        co->SDOclient                       = (CO_SDOclient_t *)    calloc(1, sizeof(CO_SDOclient_t));
+        co->SDOqueue                        = (CO_SDOclientQueue_t *) calloc(1, sizeof(CO_SDOclientQueue_t));
+      #endif
+      #if CO_NO_SDO_CLIENT_NMTM > 0
+        for(i=0; i<CO_NO_SDO_CLIENT_NMTM; i++){
+            co->SDOqueueClients[1+i]        = (CO_SDOclient_t *)    calloc(1, sizeof(CO_SDOclient_t));
+        }
+        co->SDOclientParNMTM                = (CO_SDOclientPar_t *) calloc(CO_NO_SDO_CLIENT_NMTM, sizeof(CO_SDOclientPar_t));
+      #endif
+      #if CO_NO_NMT_MASTER == 1 && CO_NO_SDO_CLIENT == 1
+        co->NMTmaster                       = (CO_NMTmaster_t *)    calloc(1, sizeof(CO_NMTmaster_t));
       #endif
       #if CO_NO_TRACE > 0
         for(i=0; i<CO_NO_TRACE; i++) {
-            CO->trace[i]                    = (CO_trace_t *)        calloc(1, sizeof(CO_trace_t));
+            co->trace[i]                    = (CO_trace_t *)        calloc(1, sizeof(CO_trace_t));
             CO_traceTimeBuffers[i]          = (uint32_t *)          calloc(OD_traceConfig[i].size, sizeof(uint32_t));
             CO_traceValueBuffers[i]         = (int32_t *)           calloc(OD_traceConfig[i].size, sizeof(int32_t));
             if(CO_traceTimeBuffers[i] != NULL && CO_traceValueBuffers[i] != NULL) {
@@ -290,6 +418,18 @@ CO_ReturnError_t CO_init(
             }
         }
       #endif
+      #if CO_NO_LSS_SERVER == 1
+        co->LSSslave                        = (CO_LSSslave_t *)     calloc(1, sizeof(CO_LSSslave_t));
+      #endif
+      #if CO_NO_LSS_CLIENT == 1
+        co->LSSmaster                       = (CO_LSSmaster_t *)    calloc(1, sizeof(CO_LSSmaster_t));
+      #endif
+      #if CO_NO_EM_CONS == 1
+        co->emCons                          = (CO_EMconsumer_t *)   calloc(1, sizeof(CO_EMconsumer_t));
+      #endif
+      #if CO_NO_TIME == 1
+        co->TIME                            = (CO_TIME_t *)         calloc(1, sizeof(CO_TIME_t));
+      #endif
     }
 
     CO_memoryUsed = sizeof(CO_CANmodule_t)
@@ -297,16 +437,48 @@ CO_ReturnError_t CO_init(
                   + sizeof(CO_CANtx_t) * CO_TXCAN_NO_MSGS
                   + sizeof(CO_SDO_t) * CO_NO_SDO_SERVER
                   + sizeof(CO_OD_extension_t) * CO_OD_NoOfElements
+  #if CO_SDO_BUFFER_POOL > 0
+                  + sizeof(CO_SDObufferPool_t)
+  #endif
+  #if CO_OD_NOTIFY > 0
+                  + sizeof(CO_ODnotify_t)
+  #endif
                   + sizeof(CO_EM_t)
                   + sizeof(CO_EMpr_t)
                   + sizeof(CO_NMT_t)
+  #if CO_NO_SYNC == 1
                   + sizeof(CO_SYNC_t)
+  #endif
                   + sizeof(CO_RPDO_t) * CO_NO_RPDO
                   + sizeof(CO_TPDO_t) * CO_NO_TPDO
+  #if CO_TPDO_CALENDAR > 0
+                  + sizeof(CO_TPDOcalendar_t) + sizeof(CO_TPDO_t *) * CO_NO_TPDO
+  #endif
+  #if CO_NO_HB_CONS > 0
                   + sizeof(CO_HBconsumer_t)
                   + sizeof(CO_HBconsNode_t) * CO_NO_HB_CONS
+  #endif
   #if CO_NO_SDO_CLIENT == 1
                   + sizeof(CO_SDOclient_t)
+                  + sizeof(CO_SDOclientQueue_t)
+  #endif
+  #if CO_NO_SDO_CLIENT_NMTM > 0
+                  + (sizeof(CO_SDOclient_t) + sizeof(CO_SDOclientPar_t)) * CO_NO_SDO_CLIENT_NMTM
+  #endif
+  #if CO_NO_NMT_MASTER == 1 && CO_NO_SDO_CLIENT == 1
+                  + sizeof(CO_NMTmaster_t)
+  #endif
+  #if CO_NO_LSS_SERVER == 1
+                  + sizeof(CO_LSSslave_t)
+  #endif
+  #if CO_NO_LSS_CLIENT == 1
+                  + sizeof(CO_LSSmaster_t)
+  #endif
+  #if CO_NO_EM_CONS == 1
+                  + sizeof(CO_EMconsumer_t)
+  #endif
+  #if CO_NO_TIME == 1
+                  + sizeof(CO_TIME_t)
   #endif
                   + 0;
   #if CO_NO_TRACE > 0
@@ -317,61 +489,244 @@ CO_ReturnError_t CO_init(
   #endif
 
     errCnt = 0;
-    if(CO->CANmodule[0]                 == NULL) errCnt++;
+    if(co->CANmodule[0]                 == NULL) errCnt++;
     if(CO_CANmodule_rxArray0            == NULL) errCnt++;
     if(CO_CANmodule_txArray0            == NULL) errCnt++;
     for(i=0; i<CO_NO_SDO_SERVER; i++){
-        if(CO->SDO[i]                   == NULL) errCnt++;
+        if(co->SDO[i]                   == NULL) errCnt++;
     }
-    if(CO_SDO_ODExtensions              == NULL) errCnt++;
-    if(CO->em                           == NULL) errCnt++;
-    if(CO->emPr                         == NULL) errCnt++;
-    if(CO->NMT                          == NULL) errCnt++;
-    if(CO->SYNC                         == NULL) errCnt++;
+    if(co->ODExtensions                 == NULL) errCnt++;
+  #if CO_SDO_BUFFER_POOL > 0
+    if(co->SDObufferPool                == NULL) errCnt++;
+  #endif
+  #if CO_OD_NOTIFY > 0
+    if(co->ODnotify                     == NULL) errCnt++;
+  #endif
+    if(co->em                           == NULL) errCnt++;
+    if(co->emPr                         == NULL) errCnt++;
+    if(co->NMT                          == NULL) errCnt++;
+  #if CO_NO_SYNC == 1
+    if(co->SYNC                         == NULL) errCnt++;
+  #endif
     for(i=0; i<CO_NO_RPDO; i++){
-        if(CO->RPDO[i]                  == NULL) errCnt++;
+        if(co->RPDO[i]                  == NULL) errCnt++;
     }
     for(i=0; i<CO_NO_TPDO; i++){
-        if(CO->TPDO[i]                  == NULL) errCnt++;
+        if(co->TPDO[i]                  == NULL) errCnt++;
     }
-    if(CO->HBcons                       == NULL) errCnt++;
-    if(CO_HBcons_monitoredNodes         == NULL) errCnt++;
+  #if CO_TPDO_CALENDAR > 0
+    if(co->TPDOcal                      == NULL) errCnt++;
+  #endif
+  #if CO_NO_HB_CONS > 0
+    if(co->HBcons                       == NULL) errCnt++;
+    if(co->HBconsNodes                  == NULL) errCnt++;
+  #endif
   #if CO_NO_SDO_CLIENT == 1
-    if(CO->SDOclient                    == NULL) errCnt++;
+    if(co->SDOclient                    == NULL) errCnt++;
+    if(co->SDOqueue                     == NULL) errCnt++;
+  #endif
+  #if CO_NO_SDO_CLIENT_NMTM > 0
+    for(i=0; i<CO_NO_SDO_CLIENT_NMTM; i++){
+        if(co->SDOqueueClients[1+i]     == NULL) errCnt++;
+    }
+    if(co->SDOclientParNMTM             == NULL) errCnt++;
+  #endif
+  #if CO_NO_NMT_MASTER == 1 && CO_NO_SDO_CLIENT == 1
+    if(co->NMTmaster                    == NULL) errCnt++;
   #endif
   #if CO_NO_TRACE > 0
     for(i=0; i<CO_NO_TRACE; i++) {
-        if(CO->trace[i]                 == NULL) errCnt++;
+        if(co->trace[i]                 == NULL) errCnt++;
     }
   #endif
+  #if CO_NO_LSS_SERVER == 1
+    if(co->LSSslave                     == NULL) errCnt++;
+  #endif
+  #if CO_NO_LSS_CLIENT == 1
+    if(co->LSSmaster                    == NULL) errCnt++;
+  #endif
+  #if CO_NO_EM_CONS == 1
+    if(co->emCons                       == NULL) errCnt++;
+  #endif
+  #if CO_NO_TIME == 1
+    if(co->TIME                         == NULL) errCnt++;
+  #endif
 
     if(errCnt != 0) return CO_ERROR_OUT_OF_MEMORY;
 #endif
 
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_initCAN(
+        uint8_t                 instance,
+        uint8_t                 count,
+        int32_t                 CANbaseAddress,
+        uint16_t                bitRate)
+{
+    CO_CANmodule_t *CANmodule;
+    CO_CANrx_t *rxArray;
+    CO_CANtx_t *txArray;
+    CO_ReturnError_t err;
+    uint8_t i;
+
+    if(count == 0 || count > CO_NO_INSTANCES || instance > CO_NO_INSTANCES - count){
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    for(i=0; i<count; i++){
+        err = CO_new(instance + i);
+        if(err){return err;}
+    }
 
-    CO->CANmodule[0]->CANnormal = false;
+#ifdef CO_USE_GLOBALS
+    CANmodule = &COO_CANmodule[instance];
+    rxArray = &COO_CANmodule_rxArray0[instance * CO_RXCAN_NO_MSGS];
+    txArray = &COO_CANmodule_txArray0[instance * CO_TXCAN_NO_MSGS];
+#else
+    CANmodule = COO[0].CANmodule[0];
+    rxArray = CO_CANmodule_rxArray0;
+    txArray = CO_CANmodule_txArray0;
+#endif
+
+    /* each device uses own slice of the module buffers */
+    for(i=0; i<count; i++){
+        CO_t *co = CO_instances[instance + i];
+
+        co->CANmodule[0] = CANmodule;
+        co->CANrxIdx = i * CO_RXCAN_NO_MSGS;
+        co->CANtxIdx = i * CO_TXCAN_NO_MSGS;
+    }
+
+    CANmodule->CANnormal = false;
     CO_CANsetConfigurationMode(CANbaseAddress);
 
+    err = CO_CANmodule_init(
+            CANmodule,
+            CANbaseAddress,
+            rxArray,
+            count * CO_RXCAN_NO_MSGS,
+            txArray,
+            count * CO_TXCAN_NO_MSGS,
+            bitRate);
+
+    if(err == CO_ERROR_NO && count > 1){
+        err = CO_CANmodule_setRxSlice(CANmodule, CO_RXCAN_NO_MSGS);
+    }
+
+    return err;
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_initInstance(
+        uint8_t                 instance,
+        const CO_ODconfig_t    *ODconfig,
+        uint8_t                 nodeId)
+{
+    CO_t *co;
+    const CO_ODconfig_t *od;
+    CO_CANmodule_t *CANmodule;
+    uint16_t rx, tx;
+    int16_t i;
+    CO_ReturnError_t err;
+
+    if(instance >= CO_NO_INSTANCES || CO_instances[instance] == NULL){
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
     /* Verify CANopen Node-ID */
+#if CO_NO_LSS_SERVER == 1
+    if((nodeId<1 || nodeId>127) && nodeId != CO_LSS_NODE_ID_ASSIGNMENT)
+#else
     if(nodeId<1 || nodeId>127)
+#endif
     {
-        CO_delete(CANbaseAddress);
         return CO_ERROR_PARAMETERS;
     }
 
+    co = CO_instances[instance];
+    od = (ODconfig != NULL) ? ODconfig : &CO_ODdefault;
+    co->ODconfig = od;
+    co->timer50ms = 0;
+    CANmodule = co->CANmodule[0];
+    rx = co->CANrxIdx;
+    tx = co->CANtxIdx;
 
-    err = CO_CANmodule_init(
-            CO->CANmodule[0],
-            CANbaseAddress,
-            CO_CANmodule_rxArray0,
-            CO_RXCAN_NO_MSGS,
-            CO_CANmodule_txArray0,
-            CO_TXCAN_NO_MSGS,
-            bitRate);
 
-    if(err){CO_delete(CANbaseAddress); return err;}
+#if CO_NO_LSS_SERVER == 1
+    {
+        CO_LSS_address_t lssAddress;
+        lssAddress.identity.vendorID = od->identity->vendorID;
+        lssAddress.identity.productCode = od->identity->productCode;
+        lssAddress.identity.revisionNumber = od->identity->revisionNumber;
+        lssAddress.identity.serialNumber = od->identity->serialNumber;
+
+        err = CO_LSSslave_init(
+                co->LSSslave,
+               &lssAddress,
+                CANmodule->CANbitRate,
+                nodeId,
+                CANmodule,
+                rx + CO_RXCAN_LSS,
+                CO_CAN_ID_LSS_CLI,
+                CANmodule,
+                tx + CO_TXCAN_LSS,
+                CO_CAN_ID_LSS_SRV);
+    }
 
-    for (i=0; i<CO_NO_SDO_SERVER; i++)
+    if(err){return err;}
+#endif
+
+
+#if CO_NO_LSS_CLIENT == 1
+    err = CO_LSSmaster_init(
+            co->LSSmaster,
+            10,
+            CANmodule,
+            rx + CO_RXCAN_LSS_M,
+            CO_CAN_ID_LSS_SRV,
+            CANmodule,
+            tx + CO_TXCAN_LSS_M,
+            CO_CAN_ID_LSS_CLI);
+
+    if(err){return err;}
+#endif
+
+
+#if CO_NO_LSS_SERVER == 1
+    /* Without node-ID only LSS slave is active */
+    if(nodeId == CO_LSS_NODE_ID_ASSIGNMENT){
+        return CO_ERROR_NO;
+    }
+#endif
+
+#if CO_NO_SDO_SERVER_CAN == 0
+    /* SDO server without CAN channel only holds Object Dictionary */
+    err = CO_SDO_init(
+            co->SDO[0],
+            0,
+            0,
+            0,
+            NULL,
+            od->OD,
+            CO_OD_NoOfElements,
+            co->ODExtensions,
+            nodeId,
+            NULL,
+            0,
+            NULL,
+            0);
+  #if CO_SDO_BUFFER_POOL > 0
+    CO_SDO_initBufferPool(co->SDO[0], co->SDObufferPool);
+  #endif
+  #if CO_OD_NOTIFY > 0
+    CO_SDO_initNotify(co->SDO[0], co->ODnotify);
+  #endif
+#endif
+    for (i=0; i<CO_NO_SDO_SERVER_CAN; i++)
     {
         uint32_t COB_IDClientToServer;
         uint32_t COB_IDServerToClient;
@@ -380,64 +735,70 @@ CO_ReturnError_t CO_init(
             COB_IDClientToServer = CO_CAN_ID_RSDO + nodeId;
             COB_IDServerToClient = CO_CAN_ID_TSDO + nodeId;
         }else{
-            COB_IDClientToServer = OD_SDOServerParameter[i].COB_IDClientToServer;
-            COB_IDServerToClient = OD_SDOServerParameter[i].COB_IDServerToClient;
+            COB_IDClientToServer = od->SDOServerParameter[i].COB_IDClientToServer;
+            COB_IDServerToClient = od->SDOServerParameter[i].COB_IDServerToClient;
         }
 
         err = CO_SDO_init(
-                CO->SDO[i],
+                co->SDO[i],
                 COB_IDClientToServer,
                 COB_IDServerToClient,
                 OD_H1200_SDO_SERVER_PARAM+i,
-                i==0 ? 0 : CO->SDO[0],
-               &CO_OD[0],
+                i==0 ? 0 : co->SDO[0],
+                od->OD,
                 CO_OD_NoOfElements,
-                CO_SDO_ODExtensions,
+                co->ODExtensions,
                 nodeId,
-                CO->CANmodule[0],
-                CO_RXCAN_SDO_SRV+i,
-                CO->CANmodule[0],
-                CO_TXCAN_SDO_SRV+i);
+                CANmodule,
+                rx + CO_RXCAN_SDO_SRV+i,
+                CANmodule,
+                tx + CO_TXCAN_SDO_SRV+i);
+#if CO_SDO_BUFFER_POOL > 0
+        CO_SDO_initBufferPool(co->SDO[i], co->SDObufferPool);
+#endif
+#if CO_OD_NOTIFY > 0
+        CO_SDO_initNotify(co->SDO[i], co->ODnotify);
+#endif
     }
 
-    if(err){CO_delete(CANbaseAddress); return err;}
+    if(err){return err;}
 
 
     err = CO_EM_init(
-            CO->em,
-            CO->emPr,
-            CO->SDO[0],
-           &OD_errorStatusBits[0],
+            co->em,
+            co->emPr,
+            co->SDO[0],
+            od->errorStatusBits,
             ODL_errorStatusBits_stringLength,
-           &OD_errorRegister,
-           &OD_preDefinedErrorField[0],
+            od->errorRegister,
+            od->preDefinedErrorField,
             ODL_preDefinedErrorField_arrayLength,
-            CO->CANmodule[0],
-            CO_TXCAN_EMERG,
+            CANmodule,
+            tx + CO_TXCAN_EMERG,
             CO_CAN_ID_EMERGENCY + nodeId);
 
-    if(err){CO_delete(CANbaseAddress); return err;}
+    if(err){return err;}
 
 
     err = CO_NMT_init(
-            CO->NMT,
-            CO->emPr,
+            co->NMT,
+            co->emPr,
             nodeId,
             500,
-            CO->CANmodule[0],
-            CO_RXCAN_NMT,
+            CANmodule,
+            rx + CO_RXCAN_NMT,
             CO_CAN_ID_NMT_SERVICE,
-            CO->CANmodule[0],
-            CO_TXCAN_HB,
+            CANmodule,
+            tx + CO_TXCAN_HB,
             CO_CAN_ID_HEARTBEAT + nodeId);
 
-    if(err){CO_delete(CANbaseAddress); return err;}
+    if(err){return err;}
 
 
 #if CO_NO_NMT_MASTER == 1
-    NMTM_txBuff = CO_CANtxBufferInit(/* return pointer to 8-byte CAN data buffer, which should be populated */
-            CO->CANmodule[0], /* pointer to CAN module used for sending this message */
-            CO_TXCAN_NMT,     /* index of specific buffer inside CAN module */
+    co->NMTM_txBuff = CO_CANtxBufferInit(/* return pointer to 8-byte CAN data buffer, which should be populated */
+            CANmodule,        /* pointer to CAN module used for sending this message */
+            tx + CO_TXCAN_NMT,/* index of specific buffer inside CAN module */
             0x0000,           /* CAN identifier */
             0,                /* rtr */
             2,                /* number of data bytes */
@@ -445,98 +806,180 @@ CO_ReturnError_t CO_init(
 #endif
 
 
+#if CO_NO_SYNC == 1
     err = CO_SYNC_init(
-            CO->SYNC,
-            CO->em,
-            CO->SDO[0],
-           &CO->NMT->operatingState,
-            OD_COB_ID_SYNCMessage,
-            OD_communicationCyclePeriod,
-            OD_synchronousCounterOverflowValue,
-            CO->CANmodule[0],
-            CO_RXCAN_SYNC,
-            CO->CANmodule[0],
-            CO_TXCAN_SYNC);
-
-    if(err){CO_delete(CANbaseAddress); return err;}
+            co->SYNC,
+            co->em,
+            co->SDO[0],
+           &co->NMT->operatingState,
+           *od->COB_ID_SYNCMessage,
+           *od->communicationCyclePeriod,
+           *od->synchronousCounterOverflowValue,
+            CANmodule,
+            rx + CO_RXCAN_SYNC,
+            CANmodule,
+            tx + CO_TXCAN_SYNC);
+
+    if(err){return err;}
+#endif
 
 
     for(i=0; i<CO_NO_RPDO; i++){
-        CO_CANmodule_t *CANdevRx = CO->CANmodule[0];
-        uint16_t CANdevRxIdx = CO_RXCAN_RPDO + i;
+        CO_CANmodule_t *CANdevRx = CANmodule;
+        uint16_t CANdevRxIdx = rx + CO_RXCAN_RPDO + i;
 
         err = CO_RPDO_init(
-                CO->RPDO[i],
-                CO->em,
-                CO->SDO[0],
-                CO->SYNC,
-               &CO->NMT->operatingState,
+                co->RPDO[i],
+                co->em,
+                co->SDO[0],
+                co->SYNC,
+               &co->NMT->operatingState,
                 nodeId,
                 ((i<4) ? (CO_CAN_ID_RPDO_1+i*0x100) : 0),
                 0,
-                (CO_RPDOCommPar_t*) &OD_RPDOCommunicationParameter[i],
-                (CO_RPDOMapPar_t*) &OD_RPDOMappingParameter[i],
+               &od->RPDOCommunicationParameter[i],
+               &od->RPDOMappingParameter[i],
                 OD_H1400_RXPDO_1_PARAM+i,
                 OD_H1600_RXPDO_1_MAPPING+i,
                 CANdevRx,
                 CANdevRxIdx);
 
-        if(err){CO_delete(CANbaseAddress); return err;}
+        if(err){return err;}
     }
 
 
+#if CO_TPDO_CALENDAR > 0
+  #ifdef CO_USE_GLOBALS
+    err = CO_TPDOcalendar_init(co->TPDOcal, &COO_TPDOcalHeap[instance][0], CO_NO_TPDO);
+  #else
+    err = CO_TPDOcalendar_init(co->TPDOcal, (CO_TPDO_t **)(co->TPDOcal + 1), CO_NO_TPDO);
+  #endif
+
+    if(err){return err;}
+#endif
+
+
     for(i=0; i<CO_NO_TPDO; i++){
         err = CO_TPDO_init(
-                CO->TPDO[i],
-                CO->em,
-                CO->SDO[0],
-               &CO->NMT->operatingState,
+                co->TPDO[i],
+                co->em,
+                co->SDO[0],
+               &co->NMT->operatingState,
                 nodeId,
                 ((i<4) ? (CO_CAN_ID_TPDO_1+i*0x100) : 0),
                 0,
-                (CO_TPDOCommPar_t*) &OD_TPDOCommunicationParameter[i],
-                (CO_TPDOMapPar_t*) &OD_TPDOMappingParameter[i],
+               &od->TPDOCommunicationParameter[i],
+               &od->TPDOMappingParameter[i],
                 OD_H1800_TXPDO_1_PARAM+i,
                 OD_H1A00_TXPDO_1_MAPPING+i,
-                CO->CANmodule[0],
-                CO_TXCAN_TPDO+i);
+                CANmodule,
+                tx + CO_TXCAN_TPDO+i);
 
-        if(err){CO_delete(CANbaseAddress); return err;}
+        if(err){return err;}
     }
 
 
+#if CO_NO_HB_CONS > 0
     err = CO_HBconsumer_init(
-            CO->HBcons,
-            CO->em,
-            CO->SDO[0],
-           &OD_consumerHeartbeatTime[0],
-            CO_HBcons_monitoredNodes,
+            co->HBcons,
+            co->em,
+            co->SDO[0],
+            od->consumerHeartbeatTime,
+            co->HBconsNodes,
             CO_NO_HB_CONS,
-            CO->CANmodule[0],
-            CO_RXCAN_CONS_HB);
+            CANmodule,
+            rx + CO_RXCAN_CONS_HB);
+
+    if(err){return err;}
+#endif
 
-    if(err){CO_delete(CANbaseAddress); return err;}
+
+#if CO_NO_EM_CONS == 1
+    err = CO_EMconsumer_init(
+            co->emCons,
+            CANmodule,
+            rx + CO_RXCAN_EM_CONS);
+
+    if(err){return err;}
+#endif
+
+
+#if CO_NO_TIME == 1
+    err = CO_TIME_init(
+            co->TIME,
+            co->SDO[0],
+           &co->NMT->operatingState,
+           *od->COB_ID_TIME,
+            od->highResolutionTimeStamp,
+            CANmodule,
+            rx + CO_RXCAN_TIME,
+            CANmodule,
+            tx + CO_TXCAN_TIME);
+
+    if(err){return err;}
+#endif
 
 
 #if CO_NO_SDO_CLIENT == 1
     err = CO_SDOclient_init(
-            CO->SDOclient,
-            CO->SDO[0],
-            (CO_SDOclientPar_t*) &OD_SDOClientParameter[0],
-            CO->CANmodule[0],
-            CO_RXCAN_SDO_CLI,
-            CO->CANmodule[0],
-            CO_TXCAN_SDO_CLI);
+            co->SDOclient,
+            co->SDO[0],
+            od->SDOClientParameter,
+            CANmodule,
+            rx + CO_RXCAN_SDO_CLI,
+            CANmodule,
+            tx + CO_TXCAN_SDO_CLI);
+
+    if(err){return err;}
+
+    /* Additional clients of the NMT master are not configurable from the
+     * Object Dictionary, they share the queue with 0x1280 client. */
+    co->SDOqueueClients[0] = co->SDOclient;
+  #if CO_NO_SDO_CLIENT_NMTM > 0
+    for(i=0; i<CO_NO_SDO_CLIENT_NMTM; i++){
+        co->SDOclientParNMTM[i].maxSubIndex = 3;
+        err = CO_SDOclient_init(
+                co->SDOqueueClients[1+i],
+                co->SDO[0],
+               &co->SDOclientParNMTM[i],
+                CANmodule,
+                rx + CO_RXCAN_SDO_CLI_M+i,
+                CANmodule,
+                tx + CO_TXCAN_SDO_CLI_M+i);
+
+        if(err){return err;}
+    }
+  #endif
+
+    err = CO_SDOclientQueue_init(
+            co->SDOqueue,
+            co->SDOqueueClients,
+            1 + CO_NO_SDO_CLIENT_NMTM);
 
-    if(err){CO_delete(CANbaseAddress); return err;}
+    if(err){return err;}
+#endif
+
+
+#if CO_NO_NMT_MASTER == 1 && CO_NO_SDO_CLIENT == 1
+    /* Slaves are added by application with CO_NMTmaster_initSlaves() */
+    err = CO_NMTmaster_init(
+            co->NMTmaster,
+            NULL,
+            0,
+            co->HBcons,
+            co->SDOqueue,
+            CANmodule,
+            tx + CO_TXCAN_NMT);
+
+    if(err){return err;}
 #endif
 
 
 #if CO_NO_TRACE > 0
-    for(i=0; i<CO_NO_TRACE; i++) {
+    for(i=0; i<CO_NO_TRACE && instance==0; i++) {
         CO_trace_init(
-            CO->trace[i],
-            CO->SDO[0],
+            co->trace[i],
+            co->SDO[0],
             OD_traceConfig[i].axisNo,
             CO_traceTimeBuffers[i],
             CO_traceValueBuffers[i],
@@ -559,6 +1002,26 @@ CO_ReturnError_t CO_init(
 }
 
 
+/******************************************************************************/
+CO_ReturnError_t CO_init(
+        int32_t                 CANbaseAddress,
+        uint8_t                 nodeId,
+        uint16_t                bitRate)
+{
+    CO_ReturnError_t err;
+
+    err = CO_initCAN(0, 1, CANbaseAddress, bitRate);
+    if(err == CO_ERROR_OUT_OF_MEMORY){return err;}
+
+    if(err == CO_ERROR_NO){
+        err = CO_initInstance(0, NULL, nodeId);
+    }
+
+    if(err){CO_delete(CANbaseAddress);}
+    return err;
+}
+
+
 /******************************************************************************/
 void CO_delete(int32_t CANbaseAddress){
 #ifndef CO_USE_GLOBALS
@@ -569,6 +1032,18 @@ void CO_delete(int32_t CANbaseAddress){
     CO_CANmodule_disable(CO->CANmodule[0]);
 
 #ifndef CO_USE_GLOBALS
+  #if CO_NO_TIME == 1
+    free(CO->TIME);
+  #endif
+  #if CO_NO_EM_CONS == 1
+    free(CO->emCons);
+  #endif
+  #if CO_NO_LSS_CLIENT == 1
+    free(CO->LSSmaster);
+  #endif
+  #if CO_NO_LSS_SERVER == 1
+    free(CO->LSSslave);
+  #endif
   #if CO_NO_TRACE > 0
       for(i=0; i<CO_NO_TRACE; i++) {
           free(CO->trace[i]);
@@ -576,28 +1051,53 @@ void CO_delete(int32_t CANbaseAddress){
           free(CO_traceValueBuffers[i]);
       }
   #endif
+  #if CO_NO_NMT_MASTER == 1 && CO_NO_SDO_CLIENT == 1
+    free(CO->NMTmaster);
+  #endif
+  #if CO_NO_SDO_CLIENT_NMTM > 0
+    free(CO->SDOclientParNMTM);
+    for(i=0; i<CO_NO_SDO_CLIENT_NMTM; i++){
+        free(CO->SDOqueueClients[1+i]);
+    }
+  #endif
   #if CO_NO_SDO_CLIENT == 1
+    free(CO->SDOqueue);
     free(CO->SDOclient);
   #endif
-    free(CO_HBcons_monitoredNodes);
+  #if CO_NO_HB_CONS > 0
+    free(CO->HBconsNodes);
     free(CO->HBcons);
+  #endif
     for(i=0; i<CO_NO_RPDO; i++){
         free(CO->RPDO[i]);
     }
     for(i=0; i<CO_NO_TPDO; i++){
         free(CO->TPDO[i]);
     }
+  #if CO_TPDO_CALENDAR > 0
+    free(CO->TPDOcal);
+  #endif
+  #if CO_NO_SYNC == 1
     free(CO->SYNC);
+  #endif
     free(CO->NMT);
     free(CO->emPr);
     free(CO->em);
-    free(CO_SDO_ODExtensions);
+    free(CO->ODExtensions);
+  #if CO_SDO_BUFFER_POOL > 0
+    free(CO->SDObufferPool);
+  #endif
+  #if CO_OD_NOTIFY > 0
+    free(CO->ODnotify);
+  #endif
     for(i=0; i<CO_NO_SDO_SERVER; i++){
         free(CO->SDO[i]);
     }
     free(CO_CANmodule_txArray0);
     free(CO_CANmodule_rxArray0);
     free(CO->CANmodule[0]);
+    CO->CANmodule[0] = NULL;
+    CO_instances[0] = NULL;
     CO = NULL;
 #endif
 }
@@ -612,14 +1112,24 @@ CO_NMT_reset_cmd_t CO_process(
     uint8_t i;
     bool_t NMTisPreOrOperational = false;
     CO_NMT_reset_cmd_t reset = CO_RESET_NOT;
-    static uint16_t ms50 = 0;
+    CO_PROFILE_BEGIN(profileStart);
+
+#if CO_NO_LSS_SERVER == 1
+    if(CO_LSSslave_process(CO->LSSslave)){
+        reset = CO_RESET_COMM;
+    }
+    if(CO->LSSslave->activeNodeID == CO_LSS_NODE_ID_ASSIGNMENT){
+        /* Other objects are not initialized */
+        return reset;
+    }
+#endif
 
     if(CO->NMT->operatingState == CO_NMT_PRE_OPERATIONAL || CO->NMT->operatingState == CO_NMT_OPERATIONAL)
         NMTisPreOrOperational = true;
 
-    ms50 += timeDifference_ms;
-    if(ms50 >= 50){
-        ms50 -= 50;
+    CO->timer50ms += timeDifference_ms;
+    if(CO->timer50ms >= 50){
+        CO->timer50ms -= 50;
         CO_NMT_blinkingProcess50ms(CO->NMT);
     }
     if(timerNext_ms != NULL){
@@ -629,7 +1139,7 @@ CO_NMT_reset_cmd_t CO_process(
     }
 
 
-    for(i=0; i<CO_NO_SDO_SERVER; i++){
+    for(i=0; i<CO_NO_SDO_SERVER_CAN; i++){
         CO_SDO_process(
                 CO->SDO[i],
                 NMTisPreOrOperational,
@@ -638,28 +1148,45 @@ CO_NMT_reset_cmd_t CO_process(
                 timerNext_ms);
     }
 
+#if CO_OD_NOTIFY > 0
+    CO_ODnotify_process(CO->ODnotify);
+#endif
+
     CO_EM_process(
             CO->emPr,
             NMTisPreOrOperational,
             timeDifference_ms * 10,
-            OD_inhibitTimeEMCY);
+            *CO->ODconfig->inhibitTimeEMCY,
+            timerNext_ms);
 
 
     reset = CO_NMT_process(
             CO->NMT,
             timeDifference_ms,
-            OD_producerHeartbeatTime,
-            OD_NMTStartup,
-            OD_errorRegister,
-            OD_errorBehavior,
+            *CO->ODconfig->producerHeartbeatTime,
+            *CO->ODconfig->NMTStartup,
+            *CO->ODconfig->errorRegister,
+            CO->ODconfig->errorBehavior,
             timerNext_ms);
 
 
+#if CO_NO_HB_CONS > 0
     CO_HBconsumer_process(
             CO->HBcons,
             NMTisPreOrOperational,
-            timeDifference_ms);
+            timeDifference_ms,
+            timerNext_ms);
+#endif
+
+#if CO_NO_EM_CONS == 1
+    CO_EMconsumer_process(CO->emCons);
+#endif
 
+#if CO_NO_TIME == 1
+    CO_TIME_process(CO->TIME, timeDifference_ms);
+#endif
+
+    CO_PROFILE_END(CO_PROFILE_PROCESS, profileStart);
     return reset;
 }
 
@@ -667,12 +1194,21 @@ CO_NMT_reset_cmd_t CO_process(
 /******************************************************************************/
 bool_t CO_process_SYNC_RPDO(
         CO_t                   *CO,
-        uint32_t                timeDifference_us)
+        uint32_t                timeDifference_us,
+        uint32_t               *timerNext_us)
 {
     int16_t i;
     bool_t syncWas = false;
+    CO_PROFILE_BEGIN(profileStart);
+
+#if CO_NO_LSS_SERVER == 1
+    if(CO->LSSslave->activeNodeID == CO_LSS_NODE_ID_ASSIGNMENT){
+        return false;
+    }
+#endif
 
-    switch(CO_SYNC_process(CO->SYNC, timeDifference_us, OD_synchronousWindowLength)){
+#if CO_NO_SYNC == 1
+    switch(CO_SYNC_process(CO->SYNC, timeDifference_us, *CO->ODconfig->synchronousWindowLength, timerNext_us)){
         case 1:     //immediately after the SYNC message
             syncWas = true;
             break;
@@ -680,11 +1216,13 @@ bool_t CO_process_SYNC_RPDO(
             CO_CANclearPendingSyncPDOs(CO->CANmodule[0]);
             break;
     }
+#endif
 
     for(i=0; i<CO_NO_RPDO; i++){
         CO_RPDO_process(CO->RPDO[i], syncWas);
     }
 
+    CO_PROFILE_END(CO_PROFILE_SYNC_RPDO, profileStart);
     return syncWas;
 }
 
@@ -693,13 +1231,59 @@ bool_t CO_process_SYNC_RPDO(
 void CO_process_TPDO(
         CO_t                   *CO,
         bool_t                  syncWas,
-        uint32_t                timeDifference_us)
+        uint32_t                timeDifference_us,
+        uint32_t               *timerNext_us)
 {
     int16_t i;
+#if CO_TPDO_DIRTY_FLAGS > 0
+    uint32_t dirty;
+#endif
+    CO_PROFILE_BEGIN(profileStart);
+
+#if CO_NO_LSS_SERVER == 1
+    if(CO->LSSslave->activeNodeID == CO_LSS_NODE_ID_ASSIGNMENT){
+        return;
+    }
+#endif
+
+#if CO_TPDO_DIRTY_FLAGS > 0
+    /* take TPDOs with written mapped variables */
+    CO_LOCK_OD();
+    dirty = *CO->SDO[0]->pTPDOdirty;
+    *CO->SDO[0]->pTPDOdirty = 0U;
+    CO_UNLOCK_OD();
+#endif
+
+#if CO_TPDO_CALENDAR > 0
+    CO_TPDOcalendar_tick(CO->TPDOcal, timeDifference_us);
+#endif
 
     /* Verify PDO Change Of State and process PDOs */
     for(i=0; i<CO_NO_TPDO; i++){
-        if(!CO->TPDO[i]->sendRequest) CO->TPDO[i]->sendRequest = CO_TPDOisCOS(CO->TPDO[i]);
-        CO_TPDO_process(CO->TPDO[i], CO->SYNC, syncWas, timeDifference_us);
+        CO_TPDO_t *TPDO = CO->TPDO[i];
+
+#if CO_TPDO_DIRTY_FLAGS > 0
+        if(!TPDO->sendRequest && (TPDO->dirtyBit == 0U || (dirty & TPDO->dirtyBit)))
+#else
+        if(!TPDO->sendRequest)
+#endif
+            TPDO->sendRequest = CO_TPDOisCOS(TPDO);
+#if CO_TPDO_CALENDAR > 0
+        /* event driven TPDOs are sent by calendar, when due */
+        if(TPDO->transmissionType >= 253){
+            CO_TPDOcalendar_update(CO->TPDOcal, TPDO);
+            continue;
+        }
+        if(TPDO->calPos != CO_TPDO_CAL_NONE){
+            CO_TPDOcalendar_update(CO->TPDOcal, TPDO);
+        }
+#endif
+        CO_TPDO_process(TPDO, CO->SYNC, syncWas, timeDifference_us, timerNext_us);
     }
+
+#if CO_TPDO_CALENDAR > 0
+    CO_TPDOcalendar_process(CO->TPDOcal, timerNext_us);
+#endif
+
+    CO_PROFILE_END(CO_PROFILE_TPDO, profileStart);
 }
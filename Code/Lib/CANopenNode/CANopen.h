@@ -86,9 +86,82 @@ extern "C" {
 #if CO_NO_SDO_CLIENT == 1
     #include "CO_SDOmaster.h"
 #endif
+#if CO_NO_NMT_MASTER == 1 && CO_NO_SDO_CLIENT == 1
+    #include "CO_NMTmaster.h"
+#endif
 #if CO_NO_TRACE > 0
     #include "CO_trace.h"
 #endif
+/**
+ * SDO clients without Object Dictionary parameters, which boot slaves of
+ * @ref CO_NMTmaster in parallel with 0x1280 client. Used only, if
+ * CO_NO_NMT_MASTER and CO_NO_SDO_CLIENT are 1. May be set in CO_OD.h.
+ */
+#ifndef CO_NO_SDO_CLIENT_NMTM
+    #define CO_NO_SDO_CLIENT_NMTM 3
+#endif
+#if CO_NO_NMT_MASTER != 1 || CO_NO_SDO_CLIENT != 1
+    #undef CO_NO_SDO_CLIENT_NMTM
+    #define CO_NO_SDO_CLIENT_NMTM 0
+#endif
+
+/** LSS slave, see @ref CO_LSSslave. May be set in CO_OD.h. */
+#ifndef CO_NO_LSS_SERVER
+    #define CO_NO_LSS_SERVER    0
+#endif
+/** LSS master, see @ref CO_LSSmaster. May be set in CO_OD.h. */
+#ifndef CO_NO_LSS_CLIENT
+    #define CO_NO_LSS_CLIENT    0
+#endif
+#if CO_NO_LSS_SERVER == 1 || CO_NO_LSS_CLIENT == 1
+    #include "CO_LSS.h"
+#endif
+
+/* Services removed by the product profile, see CO_PRUNE_SYNC in CO_driver.h */
+#if CO_PRUNE_SYNC > 0
+    #undef CO_NO_SYNC
+    #define CO_NO_SYNC          0
+#endif
+/** Heartbeat consumer channels, from size of array 0x1016 in CO_OD.h. */
+#if CO_PRUNE_HB_CONS > 0 || !defined ODL_consumerHeartbeatTime_arrayLength
+    #define CO_NO_HB_CONS       0
+#else
+    #define CO_NO_HB_CONS       ODL_consumerHeartbeatTime_arrayLength
+#endif
+/** SDO servers with CAN channel, CO_NO_SDO_SERVER objects hold OD anyway. */
+#if CO_PRUNE_SDO_SERVER > 0
+    #define CO_NO_SDO_SERVER_CAN 0
+#else
+    #define CO_NO_SDO_SERVER_CAN CO_NO_SDO_SERVER
+#endif
+#if CO_NO_LSS_SERVER == 1
+    #include "CO_LSSslave.h"
+#endif
+#if CO_NO_LSS_CLIENT == 1
+    #include "CO_LSSmaster.h"
+#endif
+/** Emergency consumer, see @ref CO_EMconsumer. May be set in CO_OD.h. */
+#ifndef CO_NO_EM_CONS
+    #define CO_NO_EM_CONS       0
+#endif
+#if CO_NO_EM_CONS == 1
+    #include "CO_EMconsumer.h"
+#endif
+/** TIME producer and consumer, see @ref CO_TIME. May be set in CO_OD.h. */
+#ifndef CO_NO_TIME
+    #define CO_NO_TIME          0
+#endif
+#if CO_NO_TIME == 1
+    #include "CO_TIME.h"
+#endif
+/**
+ * Number of CANopen devices in one program, each with own Object Dictionary
+ * and node-ID, see CO_initCAN() and CO_initInstance(). May be set in CO_OD.h.
+ * Values above 1 require CO_USE_GLOBALS.
+ */
+#ifndef CO_NO_INSTANCES
+    #define CO_NO_INSTANCES     1
+#endif
 
 
 /**
@@ -118,31 +191,159 @@ typedef enum{
 }CO_Default_CAN_ID_t;
 
 
+/**
+ * Object Dictionary of one CANopen device, see CO_initInstance().
+ *
+ * Pointers to Object Dictionary variables, which are used directly by
+ * CANopen.c. Object counts (CO_NO_RPDO, CO_OD_NoOfElements, ...) are common to
+ * all devices, so additional Object Dictionary is a copy of CO_OD.c with
+ * renamed CO_OD_RAM, CO_OD_ROM, CO_OD_EEPROM and CO_OD arrays. It is then
+ * described at the end of its file with:
+ *
+ * @code
+#define CO_OD_RAM       CO_OD_RAM_2
+#define CO_OD_ROM       CO_OD_ROM_2
+#define CO_OD_EEPROM    CO_OD_EEPROM_2
+const CO_ODconfig_t CO_ODconfig_2 = CO_OD_CONFIG(CO_OD_2);
+ * @endcode
+ */
+typedef struct{
+    const CO_OD_entry_t *OD;            /**< Object Dictionary array, CO_OD_NoOfElements long */
+    uint8_t            *errorRegister;  /**< 0x1001 */
+    uint8_t            *errorStatusBits;/**< 0x2100, ODL_errorStatusBits_stringLength long */
+    uint32_t           *preDefinedErrorField;/**< 0x1003, ODL_preDefinedErrorField_arrayLength long */
+    uint32_t           *COB_ID_SYNCMessage;/**< 0x1005 */
+    uint32_t           *communicationCyclePeriod;/**< 0x1006 */
+    uint32_t           *synchronousWindowLength;/**< 0x1007 */
+    uint16_t           *inhibitTimeEMCY;/**< 0x1015 */
+    uint32_t           *consumerHeartbeatTime;/**< 0x1016 */
+    uint16_t           *producerHeartbeatTime;/**< 0x1017 */
+    const OD_identity_t *identity;      /**< 0x1018 */
+    uint8_t            *synchronousCounterOverflowValue;/**< 0x1019 */
+    uint8_t            *errorBehavior;  /**< 0x1029 */
+    OD_SDOServerParameter_t *SDOServerParameter;/**< 0x1200, CO_NO_SDO_SERVER long */
+    CO_RPDOCommPar_t   *RPDOCommunicationParameter;/**< 0x1400, CO_NO_RPDO long */
+    CO_RPDOMapPar_t    *RPDOMappingParameter;/**< 0x1600, CO_NO_RPDO long */
+    CO_TPDOCommPar_t   *TPDOCommunicationParameter;/**< 0x1800, CO_NO_TPDO long */
+    CO_TPDOMapPar_t    *TPDOMappingParameter;/**< 0x1A00, CO_NO_TPDO long */
+    uint32_t           *NMTStartup;     /**< 0x1F80 */
+#if CO_NO_SDO_CLIENT == 1
+    CO_SDOclientPar_t  *SDOClientParameter;/**< 0x1280 */
+#endif
+#if CO_NO_TIME == 1
+    uint32_t           *COB_ID_TIME;    /**< 0x1012 */
+    uint32_t           *highResolutionTimeStamp;/**< 0x1013 */
+#endif
+}CO_ODconfig_t;
+
+#if CO_NO_SDO_CLIENT == 1
+    #define CO_OD_CONFIG_SDO_CLIENT_ , (CO_SDOclientPar_t*) &OD_SDOClientParameter[0]
+#else
+    #define CO_OD_CONFIG_SDO_CLIENT_
+#endif
+#if CO_NO_TIME == 1
+    #define CO_OD_CONFIG_TIME_ , &OD_COB_ID_TIME, &OD_highResolutionTimeStamp
+#else
+    #define CO_OD_CONFIG_TIME_
+#endif
+/**
+ * Initializer of #CO_ODconfig_t from OD_xxx macros of CO_OD.h.
+ *
+ * @param table Object Dictionary array, CO_OD for the default one.
+ */
+#define CO_OD_CONFIG(table) {                                               \
+        &(table)[0],                                                        \
+        &OD_errorRegister,                                                  \
+        &OD_errorStatusBits[0],                                             \
+        &OD_preDefinedErrorField[0],                                        \
+        &OD_COB_ID_SYNCMessage,                                             \
+        &OD_communicationCyclePeriod,                                       \
+        &OD_synchronousWindowLength,                                        \
+        &OD_inhibitTimeEMCY,                                                \
+        &OD_consumerHeartbeatTime[0],                                       \
+        &OD_producerHeartbeatTime,                                          \
+        &OD_identity,                                                       \
+        &OD_synchronousCounterOverflowValue,                                \
+        &OD_errorBehavior[0],                                               \
+        &OD_SDOServerParameter[0],                                          \
+        (CO_RPDOCommPar_t*) &OD_RPDOCommunicationParameter[0],              \
+        (CO_RPDOMapPar_t*) &OD_RPDOMappingParameter[0],                     \
+        (CO_TPDOCommPar_t*) &OD_TPDOCommunicationParameter[0],              \
+        (CO_TPDOMapPar_t*) &OD_TPDOMappingParameter[0],                     \
+        &OD_NMTStartup                                                      \
+        CO_OD_CONFIG_SDO_CLIENT_                                            \
+        CO_OD_CONFIG_TIME_                                                  \
+    }
+
+
 /**
  * CANopen stack object combines pointers to all CANopen objects.
  */
 typedef struct{
-    CO_CANmodule_t     *CANmodule[1];   /**< CAN module objects */
+    CO_CANmodule_t     *CANmodule[1];   /**< CAN module objects, may be shared with other devices */
     CO_SDO_t           *SDO[CO_NO_SDO_SERVER]; /**< SDO object */
     CO_EM_t            *em;             /**< Emergency report object */
     CO_EMpr_t          *emPr;           /**< Emergency process object */
     CO_NMT_t           *NMT;            /**< NMT object */
-    CO_SYNC_t          *SYNC;           /**< SYNC object */
+    CO_SYNC_t          *SYNC;           /**< SYNC object, NULL if CO_NO_SYNC is 0 */
     CO_RPDO_t          *RPDO[CO_NO_RPDO];/**< RPDO objects */
     CO_TPDO_t          *TPDO[CO_NO_TPDO];/**< TPDO objects */
-    CO_HBconsumer_t    *HBcons;         /**<  Heartbeat consumer object*/
+#if CO_TPDO_CALENDAR > 0
+    CO_TPDOcalendar_t  *TPDOcal;        /**< Deadline calendar of event driven TPDOs */
+#endif
+    CO_HBconsumer_t    *HBcons;         /**<  Heartbeat consumer object, NULL if CO_NO_HB_CONS is 0 */
 #if CO_NO_SDO_CLIENT == 1
     CO_SDOclient_t     *SDOclient;      /**< SDO client object */
+    CO_SDOclientQueue_t *SDOqueue;      /**< Jobs for SDOclient and CO_NO_SDO_CLIENT_NMTM clients, see CO_SDOclientQueue_submit() */
+#endif
+#if CO_NO_NMT_MASTER == 1 && CO_NO_SDO_CLIENT == 1
+    CO_NMTmaster_t     *NMTmaster;      /**< NMT master, slaves are set by CO_NMTmaster_initSlaves() */
 #endif
 #if CO_NO_TRACE > 0
     CO_trace_t         *trace[CO_NO_TRACE]; /**< Trace object for monitoring variables */
 #endif
+#if CO_NO_LSS_SERVER == 1
+    CO_LSSslave_t      *LSSslave;       /**< LSS slave object */
+#endif
+#if CO_NO_LSS_CLIENT == 1
+    CO_LSSmaster_t     *LSSmaster;      /**< LSS master object */
+#endif
+#if CO_NO_EM_CONS == 1
+    CO_EMconsumer_t    *emCons;         /**< Emergency consumer object */
+#endif
+#if CO_NO_TIME == 1
+    CO_TIME_t          *TIME;           /**< TIME object */
+#endif
+    const CO_ODconfig_t *ODconfig;      /**< Object Dictionary, from CO_initInstance() */
+    CO_OD_extension_t  *ODExtensions;   /**< Internal, CO_OD_NoOfElements long */
+#if CO_SDO_BUFFER_POOL > 0
+    CO_SDObufferPool_t *SDObufferPool;  /**< Internal, shared by SDO servers */
+#endif
+#if CO_OD_NOTIFY > 0
+    CO_ODnotify_t      *ODnotify;       /**< Internal, shared by SDO servers, see CO_OD_subscribe() */
+#endif
+    CO_HBconsNode_t    *HBconsNodes;    /**< Internal, monitored nodes of HBcons */
+#if CO_NO_NMT_MASTER == 1
+    CO_CANtx_t         *NMTM_txBuff;    /**< Internal, NMT master message */
+#endif
+#if CO_NO_SDO_CLIENT == 1
+    CO_SDOclient_t     *SDOqueueClients[1 + CO_NO_SDO_CLIENT_NMTM]; /**< Internal, clients of SDOqueue */
+#endif
+#if CO_NO_SDO_CLIENT_NMTM > 0
+    CO_SDOclientPar_t  *SDOclientParNMTM; /**< Internal, parameters of SDOqueueClients without Object Dictionary */
+#endif
+    uint16_t            CANrxIdx;       /**< Internal, first rxArray buffer of this device in CANmodule */
+    uint16_t            CANtxIdx;       /**< Internal, first txArray buffer of this device in CANmodule */
+    uint16_t            timer50ms;      /**< Internal, NMT LED blinking timer in CO_process() */
 }CO_t;
 
 
-/** CANopen object */
+/** CANopen object, CANopen device 0 */
     extern CO_t *CO;
 
+/** CANopen devices, set by CO_initCAN(), CO_instances[0] is CO */
+    extern CO_t *CO_instances[CO_NO_INSTANCES];
+
 
 /**
  * Function CO_sendNMTcommand() is simple function, which sends CANopen message.
@@ -162,14 +363,66 @@ typedef struct{
 #endif
 
 
+/**
+ * Initialize CAN module for CANopen devices.
+ *
+ * CANopen devices _instance_ to _instance_ + _count_ - 1 share the CAN module,
+ * each uses own slice of its receive and transmit buffers. Function must be
+ * called before CO_initInstance() of these devices and again after
+ * CO_CANmodule_disable(). Transmit buffers of all the devices must fit into
+ * CO_CAN_TX_PENDING_WORDS. SYNC window of one device clears pending
+ * synchronous TPDOs of the whole module, so devices on one module should use
+ * the same SYNC producer.
+ *
+ * @param instance First CANopen device, 0 ... CO_NO_INSTANCES - 1.
+ * @param count Number of CANopen devices on this module.
+ * @param CANbaseAddress Address of the CAN module, passed to CO_CANmodule_init().
+ * @param bitRate CAN bit rate in kbit/s, passed to CO_CANmodule_init().
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO, CO_ERROR_ILLEGAL_ARGUMENT,
+ * CO_ERROR_OUT_OF_MEMORY, CO_ERROR_ILLEGAL_BAUDRATE
+ */
+CO_ReturnError_t CO_initCAN(
+        uint8_t                 instance,
+        uint8_t                 count,
+        int32_t                 CANbaseAddress,
+        uint16_t                bitRate);
+
+
+/**
+ * Initialize CANopen objects of one CANopen device.
+ *
+ * Function must be called in the communication reset section of the device,
+ * after CO_initCAN(). Other devices on the same CAN module are not affected.
+ * Trace objects (CO_NO_TRACE) are initialized for device 0 only.
+ *
+ * @param instance CANopen device, 0 ... CO_NO_INSTANCES - 1.
+ * @param ODconfig Object Dictionary of the device, see #CO_ODconfig_t. NULL
+ * for the default CO_OD. Must stay valid while the device is used.
+ * @param nodeId Node ID of the device, same as in CO_init().
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO, CO_ERROR_ILLEGAL_ARGUMENT,
+ * CO_ERROR_PARAMETERS
+ */
+CO_ReturnError_t CO_initInstance(
+        uint8_t                 instance,
+        const CO_ODconfig_t    *ODconfig,
+        uint8_t                 nodeId);
+
+
 /**
  * Initialize CANopen stack.
  *
- * Function must be called in the communication reset section.
+ * Function must be called in the communication reset section. It initializes
+ * CANopen device 0 with the default Object Dictionary alone on the CAN module,
+ * same as CO_initCAN(0, 1, ...) and CO_initInstance(0, NULL, ...).
  *
  * @param CANbaseAddress Address of the CAN module, passed to CO_CANmodule_init().
- * @param nodeId Node ID of the CANopen device (1 ... 127).
- * @param nodeId CAN bit rate.
+ * @param nodeId Node ID of the CANopen device (1 ... 127). If CO_NO_LSS_SERVER
+ * is 1, it may also be #CO_LSS_NODE_ID_ASSIGNMENT. Then only CAN module and
+ * LSS slave are initialized and node waits for node-ID from LSS master.
+ * @param bitRate CAN bit rate in kbit/s, passed to CO_CANmodule_init(), 0 for
+ * automatic detection with CO_CAN_AUTO_BITRATE.
  *
  * @return #CO_ReturnError_t: CO_ERROR_NO, CO_ERROR_ILLEGAL_ARGUMENT,
  * CO_ERROR_OUT_OF_MEMORY, CO_ERROR_ILLEGAL_BAUDRATE
@@ -203,7 +456,8 @@ void CO_delete(int32_t CANbaseAddress);
  *        to process, delay should be suspended and this function should be
  *        called immediately. Parameter is ignored if NULL.
  *
- * @return #CO_NMT_reset_cmd_t from CO_NMT_process().
+ * @return #CO_NMT_reset_cmd_t from CO_NMT_process(). CO_RESET_COMM also, if
+ *         node without node-ID got node-ID from LSS master.
  */
 CO_NMT_reset_cmd_t CO_process(
         CO_t                   *CO,
@@ -219,12 +473,16 @@ CO_NMT_reset_cmd_t CO_process(
  *
  * @param CO This object.
  * @param timeDifference_us Time difference from previous function call in [microseconds].
+ * @param timerNext_us Return value - info to OS - maximum delay after function
+ *        should be called next time in [microseconds]. Initial value must be
+ *        set by caller, output will be equal or lower. Parameter is ignored if NULL.
  *
  * @return True, if CANopen SYNC message was just received or transmitted.
  */
 bool_t CO_process_SYNC_RPDO(
         CO_t                   *CO,
-        uint32_t                timeDifference_us);
+        uint32_t                timeDifference_us,
+        uint32_t               *timerNext_us);
 
 
 /**
@@ -236,11 +494,13 @@ bool_t CO_process_SYNC_RPDO(
  * @param CO This object.
  * @param syncWas True, if CANopen SYNC message was just received or transmitted.
  * @param timeDifference_us Time difference from previous function call in [microseconds].
+ * @param timerNext_us Return value - info to OS - see CO_process_SYNC_RPDO().
  */
 void CO_process_TPDO(
         CO_t                   *CO,
         bool_t                  syncWas,
-        uint32_t                timeDifference_us);
+        uint32_t                timeDifference_us,
+        uint32_t               *timerNext_us);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,460 @@
+/*
+ * Object Dictionary mirror for an application on another core.
+ *
+ * @file        CO_ODmirror.c
+ * @ingroup     CO_ODmirror
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * CANopenNode is free and open source software: you can redistribute
+ * it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Following clarification and special exception to the GNU General Public
+ * License is included to the distribution terms of CANopenNode:
+ *
+ * Linking this library statically or dynamically with other modules is
+ * making a combined work based on this library. Thus, the terms and
+ * conditions of the GNU General Public License cover the whole combination.
+ *
+ * As a special exception, the copyright holders of this library give
+ * you permission to link this library with independent modules to
+ * produce an executable, regardless of the license terms of these
+ * independent modules, and to copy and distribute the resulting
+ * executable under terms of your choice, provided that you also meet,
+ * for each linked independent module, the terms and conditions of the
+ * license of that module. An independent module is a module which is
+ * not derived from or based on this library. If you modify this
+ * library, you may extend this exception to your version of the
+ * library, but you are not obliged to do so. If you do not wish
+ * to do so, delete this exception statement from your version.
+ */
+
+
+
+#include "CO_ODmirror.h"
+#include <string.h>
+
+#if CO_OD_MIRROR > 0
+
+/* Dummy entries (data types) in mapping are not variables */
+#define CO_OD_MIRROR_FIRST_INDEX    0x0020U
+
+
+/*
+ * Write data of one slot, caller is its only writer.
+ */
+static void CO_ODmirror_slotWrite(CO_ODmirrorSlot_t *slot, const uint8_t *data, uint8_t length){
+    uint32_t seq = slot->seq;
+
+    slot->seq = seq + 1U;
+    CO_MEMORY_BARRIER();
+    memcpy(slot->data, data, length);
+    CO_MEMORY_BARRIER();
+    slot->seq = seq + 2U;
+}
+
+
+/*
+ * Consistent copy of one slot. Returns false, if writer did not finish.
+ */
+static bool_t CO_ODmirror_slotRead(const CO_ODmirrorSlot_t *slot, CO_ODmirrorSlot_t *copy){
+    uint8_t i;
+
+    for(i = 0U; i < CO_OD_MIRROR_RETRIES; i++){
+        uint32_t seq = slot->seq;
+
+        if((seq & 1U) == 0U){
+            CO_MEMORY_BARRIER();
+            copy->mapSeq = slot->mapSeq;
+            copy->mask = slot->mask;
+            memcpy(copy->data, slot->data, sizeof(copy->data));
+            CO_MEMORY_BARRIER();
+            if(slot->seq == seq){
+                copy->seq = seq;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+
+/*
+ * Find mapped variable. Returns false, if it is not mapped or table is being
+ * rebuilt. mapSeq is the table version of the entry.
+ */
+static bool_t CO_ODmirror_find(
+        const CO_ODmirrorShared_t *shared,
+        uint16_t                index,
+        uint8_t                 subIndex,
+        CO_ODmirrorEntry_t     *entry,
+        uint32_t               *mapSeq)
+{
+    uint8_t retry;
+
+    for(retry = 0U; retry < CO_OD_MIRROR_RETRIES; retry++){
+        uint32_t seq = shared->mapSeq;
+        bool_t found = false;
+        uint16_t i;
+
+        if((seq & 1U) != 0U){
+            continue;
+        }
+        CO_MEMORY_BARRIER();
+        for(i = 0U; i < shared->entryCount && i < CO_OD_MIRROR_ENTRIES; i++){
+            if(shared->entry[i].index == index && shared->entry[i].subIndex == subIndex){
+                *entry = shared->entry[i];
+                found = true;
+                break;
+            }
+        }
+        CO_MEMORY_BARRIER();
+        if(shared->mapSeq == seq){
+            *mapSeq = seq;
+            return found;
+        }
+    }
+    return false;
+}
+
+
+/*
+ * Compare (write false) or write table entries of one PDO. Returns true, if
+ * table differs.
+ */
+static bool_t CO_ODmirror_mapPDO(
+        CO_ODmirrorShared_t    *shared,
+        uint16_t               *count,
+        const uint32_t         *pMap,
+        uint8_t                 noOfMappedObjects,
+        uint8_t                 pdo,
+        bool_t                  write)
+{
+    bool_t differs = false;
+    uint8_t offset = 0U;
+    uint8_t i;
+
+    for(i = 0U; i < noOfMappedObjects && i < 8U; i++){
+        CO_ODmirrorEntry_t entry;
+        uint32_t map = pMap[i];
+
+        entry.index = (uint16_t)(map >> 16);
+        entry.subIndex = (uint8_t)(map >> 8);
+        entry.length = (uint8_t)((map & 0xFFU) >> 3);
+        entry.pdo = pdo;
+        entry.offset = offset;
+        offset += entry.length;
+
+        if(entry.index < CO_OD_MIRROR_FIRST_INDEX){
+            continue;
+        }
+        if(*count >= CO_OD_MIRROR_ENTRIES){
+            if(write){
+                shared->overflow = true;
+            }
+            continue;
+        }
+        if(write){
+            shared->entry[*count] = entry;
+        }
+        else if(memcmp(&shared->entry[*count], &entry, sizeof(entry)) != 0){
+            differs = true;
+        }
+        (*count)++;
+    }
+    return differs;
+}
+
+
+/*
+ * Compare (write false) or write the table of mapped variables of valid PDOs.
+ */
+static bool_t CO_ODmirror_mapAll(CO_ODmirror_t *mirror, bool_t write){
+    CO_ODmirrorShared_t *shared = mirror->shared;
+    CO_t *CO = mirror->CO;
+    uint16_t count = 0U;
+    bool_t differs = false;
+    uint16_t i;
+
+    if(write){
+        shared->overflow = false;
+    }
+    for(i = 0U; i < CO_NO_RPDO; i++){
+        const CO_RPDO_t *RPDO = CO->RPDO[i];
+
+        if(RPDO->valid){
+            differs |= CO_ODmirror_mapPDO(shared, &count, &RPDO->RPDOMapPar->mappedObject1,
+                                          RPDO->RPDOMapPar->numberOfMappedObjects,
+                                          (uint8_t)i, write);
+        }
+    }
+    for(i = 0U; i < CO_NO_TPDO; i++){
+        const CO_TPDO_t *TPDO = CO->TPDO[i];
+
+        if(TPDO->valid){
+            differs |= CO_ODmirror_mapPDO(shared, &count, &TPDO->TPDOMapPar->mappedObject1,
+                                          TPDO->TPDOMapPar->numberOfMappedObjects,
+                                          (uint8_t)i | CO_OD_MIRROR_TPDO, write);
+        }
+    }
+    if(write){
+        shared->entryCount = count;
+    }
+    return differs || count != shared->entryCount;
+}
+
+
+/*
+ * Rebuild the table, if mapping has changed. Table version changes only
+ * then, so TPDO data written by application stay valid otherwise.
+ */
+static void CO_ODmirror_map(CO_ODmirror_t *mirror){
+    CO_ODmirrorShared_t *shared = mirror->shared;
+
+    if(CO_ODmirror_mapAll(mirror, false)){
+        shared->mapSeq++;
+        CO_MEMORY_BARRIER();
+        (void)CO_ODmirror_mapAll(mirror, true);
+        CO_MEMORY_BARRIER();
+        shared->mapSeq++;
+    }
+}
+
+
+/*
+ * Publish RPDO variables, all or only changed ones.
+ */
+static void CO_ODmirror_publish(CO_ODmirror_t *mirror, bool_t all){
+    CO_ODmirrorShared_t *shared = mirror->shared;
+    bool_t changed = false;
+    uint16_t i;
+
+    for(i = 0U; i < CO_NO_RPDO; i++){
+        const CO_RPDO_t *RPDO = mirror->CO->RPDO[i];
+        uint8_t data[CO_PDO_MAX_SIZE];
+        uint8_t j;
+
+        if(!RPDO->valid){
+            continue;
+        }
+        CO_LOCK_OD();
+        for(j = 0U; j < RPDO->copyRunCount; j++){
+            const CO_PDOcopyRun_t *run = &RPDO->copyRun[j];
+
+            memcpy(&data[run->offset], run->pData, run->length);
+        }
+        CO_UNLOCK_OD();
+
+        if(all || memcmp(shared->rpdo[i].data, data, RPDO->dataLength) != 0){
+            CO_ODmirror_slotWrite(&shared->rpdo[i], data, RPDO->dataLength);
+            changed = true;
+        }
+    }
+
+    if(changed){
+        CO_MEMORY_BARRIER();
+        shared->rxDoorbell++;
+        CO_OD_MIRROR_SIGNAL(CO_OD_MIRROR_RX);
+    }
+}
+
+
+/*
+ * Copy bytes written by application into OD variables of one TPDO.
+ */
+static void CO_ODmirror_apply(CO_ODmirror_t *mirror, CO_TPDO_t *TPDO, const CO_ODmirrorSlot_t *copy){
+    uint8_t i;
+
+    CO_LOCK_OD();
+    for(i = 0U; i < TPDO->copyRunCount; i++){
+        const CO_PDOcopyRun_t *run = &TPDO->copyRun[i];
+        uint8_t j;
+
+        for(j = 0U; j < run->length; j++){
+            uint8_t pos = run->offset + j;
+
+            if((copy->mask >> pos) & 1U){
+                run->pData[j] = copy->data[pos];
+            }
+        }
+    }
+#if CO_TPDO_DIRTY_FLAGS > 0
+    *mirror->CO->SDO[0]->pTPDOdirty |= TPDO->dirtyBit;
+#else
+    (void)mirror;
+#endif
+    CO_UNLOCK_OD();
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_ODmirror_init(
+        CO_ODmirror_t          *mirror,
+        CO_ODmirrorShared_t    *shared,
+        CO_t                   *CO)
+{
+    uint16_t i;
+
+    /* verify arguments */
+    if(mirror==NULL || shared==NULL || CO==NULL){
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    mirror->shared = shared;
+    mirror->CO = CO;
+    mirror->NMTstate = CO->NMT->operatingState;
+    /* take TPDO data, which application wrote before */
+    mirror->txDoorbell = shared->txDoorbell - 1U;
+    for(i = 0U; i < CO_NO_TPDO; i++){
+        mirror->txSeq[i] = 0U;
+    }
+
+#if CO_NO_LSS_SERVER == 1
+    /* PDOs are not initialized without node-ID */
+    if(CO->LSSslave->activeNodeID == CO_LSS_NODE_ID_ASSIGNMENT){
+        return CO_ERROR_NO;
+    }
+#endif
+    CO_ODmirror_map(mirror);
+    CO_ODmirror_publish(mirror, true);
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+void CO_ODmirror_process(CO_ODmirror_t *mirror){
+    CO_ODmirrorShared_t *shared = mirror->shared;
+    uint8_t NMTstate = mirror->CO->NMT->operatingState;
+    uint32_t doorbell;
+
+#if CO_NO_LSS_SERVER == 1
+    if(mirror->CO->LSSslave->activeNodeID == CO_LSS_NODE_ID_ASSIGNMENT){
+        return;
+    }
+#endif
+
+    /* mapping may have changed outside of NMT operational */
+    if(NMTstate == CO_NMT_OPERATIONAL && mirror->NMTstate != CO_NMT_OPERATIONAL){
+        CO_ODmirror_map(mirror);
+    }
+    mirror->NMTstate = NMTstate;
+
+    CO_ODmirror_publish(mirror, false);
+
+    /* TPDO data from application */
+    doorbell = shared->txDoorbell;
+    if(doorbell != mirror->txDoorbell){
+        bool_t pending = false;
+        uint16_t i;
+
+        CO_MEMORY_BARRIER();
+        for(i = 0U; i < CO_NO_TPDO; i++){
+            CO_ODmirrorSlot_t copy;
+
+            if(shared->tpdo[i].seq == mirror->txSeq[i]){
+                continue;
+            }
+            if(!CO_ODmirror_slotRead(&shared->tpdo[i], &copy)){
+                /* application is writing, try again in the next call */
+                pending = true;
+                continue;
+            }
+            /* bytes of an older mapping are ignored */
+            if(copy.mapSeq == shared->mapSeq && mirror->CO->TPDO[i]->valid){
+                CO_ODmirror_apply(mirror, mirror->CO->TPDO[i], &copy);
+            }
+            mirror->txSeq[i] = copy.seq;
+        }
+        if(!pending){
+            mirror->txDoorbell = doorbell;
+        }
+    }
+}
+
+
+/******************************************************************************/
+bool_t CO_ODmirror_read(
+        const CO_ODmirrorShared_t *shared,
+        uint16_t                index,
+        uint8_t                 subIndex,
+        void                   *buf,
+        uint8_t                 length)
+{
+    CO_ODmirrorEntry_t entry;
+    CO_ODmirrorSlot_t copy;
+    const CO_ODmirrorSlot_t *slot;
+    uint32_t mapSeq;
+    uint8_t pdo;
+
+    if(shared==NULL || buf==NULL ||
+       !CO_ODmirror_find(shared, index, subIndex, &entry, &mapSeq) || entry.length != length){
+        return false;
+    }
+
+    pdo = entry.pdo & (uint8_t)~CO_OD_MIRROR_TPDO;
+    slot = ((entry.pdo & CO_OD_MIRROR_TPDO) != 0U) ? &shared->tpdo[pdo] : &shared->rpdo[pdo];
+    if(!CO_ODmirror_slotRead(slot, &copy)){
+        return false;
+    }
+    memcpy(buf, &copy.data[entry.offset], length);
+
+    return true;
+}
+
+
+/******************************************************************************/
+bool_t CO_ODmirror_write(
+        CO_ODmirrorShared_t    *shared,
+        uint16_t                index,
+        uint8_t                 subIndex,
+        const void             *buf,
+        uint8_t                 length)
+{
+    CO_ODmirrorEntry_t entry;
+    CO_ODmirrorSlot_t *slot;
+    uint32_t mapSeq;
+    uint32_t seq;
+    uint8_t i;
+
+    if(shared==NULL || buf==NULL ||
+       !CO_ODmirror_find(shared, index, subIndex, &entry, &mapSeq) ||
+       entry.length != length || (entry.pdo & CO_OD_MIRROR_TPDO) == 0U){
+        return false;
+    }
+
+    slot = &shared->tpdo[entry.pdo & (uint8_t)~CO_OD_MIRROR_TPDO];
+    seq = slot->seq;
+    slot->seq = seq + 1U;
+    CO_MEMORY_BARRIER();
+    if(slot->mapSeq != mapSeq){
+        /* bytes written for an older mapping are not valid any more */
+        slot->mapSeq = mapSeq;
+        slot->mask = 0U;
+    }
+    memcpy(&slot->data[entry.offset], buf, length);
+    for(i = 0U; i < length; i++){
+        slot->mask |= (uint64_t)1U << (entry.offset + i);
+    }
+    CO_MEMORY_BARRIER();
+    slot->seq = seq + 2U;
+
+    shared->txDoorbell++;
+    CO_OD_MIRROR_SIGNAL(CO_OD_MIRROR_TX);
+
+    return true;
+}
+
+#endif /* CO_OD_MIRROR > 0 */
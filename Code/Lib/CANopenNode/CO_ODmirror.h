@@ -0,0 +1,255 @@
+/**
+ * Object Dictionary mirror for an application on another core.
+ *
+ * @file        CO_ODmirror.h
+ * @ingroup     CO_ODmirror
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * CANopenNode is free and open source software: you can redistribute
+ * it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Following clarification and special exception to the GNU General Public
+ * License is included to the distribution terms of CANopenNode:
+ *
+ * Linking this library statically or dynamically with other modules is
+ * making a combined work based on this library. Thus, the terms and
+ * conditions of the GNU General Public License cover the whole combination.
+ *
+ * As a special exception, the copyright holders of this library give
+ * you permission to link this library with independent modules to
+ * produce an executable, regardless of the license terms of these
+ * independent modules, and to copy and distribute the resulting
+ * executable under terms of your choice, provided that you also meet,
+ * for each linked independent module, the terms and conditions of the
+ * license of that module. An independent module is a module which is
+ * not derived from or based on this library. If you modify this
+ * library, you may extend this exception to your version of the
+ * library, but you are not obliged to do so. If you do not wish
+ * to do so, delete this exception statement from your version.
+ */
+
+
+
+#ifndef CO_OD_MIRROR_H
+#define CO_OD_MIRROR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "CANopen.h"
+
+
+/**
+ * @defgroup CO_ODmirror Object Dictionary mirror
+ * @ingroup CO_CANopen
+ * @{
+ *
+ * PDO mapped variables for an application, which runs on another core.
+ *
+ * Stack and CAN driver run alone on one core, so application code on the
+ * other core never delays CAN reception or PDO timing. Cores exchange data
+ * only through CO_ODmirrorShared_t, placed with #CO_OD_MIRROR_ATTR in memory,
+ * which both cores see at the same address without data cache. No lock is
+ * shared between cores, each part of the mirror has a single writer:
+ *  - CANopen core publishes variables mapped to RPDOs into _rpdo_ slots in
+ *    PDO layout, after CO_process_SYNC_RPDO(), and increments _rxDoorbell_.
+ *  - Application core writes variables mapped to TPDOs into _tpdo_ slots and
+ *    increments _txDoorbell_. CANopen core copies written bytes into the
+ *    Object Dictionary before CO_process_TPDO(), so change of state and
+ *    event timers of TPDOs work as for a local application.
+ *  - CANopen core builds table of mapped variables (index, subindex, PDO and
+ *    offset) after CO_init() and whenever NMT state becomes operational, PDO
+ *    mapping can only change outside of it.
+ *
+ * Each slot and the table are sequence locks: writer makes the counter odd,
+ * copies data, and makes it even again. Reader copies data between two reads
+ * of an even, equal counter and retries otherwise, #CO_OD_MIRROR_RETRIES
+ * times. Latency from CAN reception to the application core is therefore
+ * one CO_process_SYNC_RPDO() call plus the doorbell, from the application to
+ * the Object Dictionary one CO_ODmirror_process() call.
+ *
+ * CO_ODmirror_process() and CO_ODmirror_init() run on the CANopen core,
+ * CO_ODmirror_read() and CO_ODmirror_write() on the application core. They
+ * use only the shared structure, so CO_ODmirror.c is linked into both images.
+ * #CO_OD_MIRROR_SIGNAL() rings the doorbell of the other core.
+ */
+
+
+/** Retries of a reader, which meets a writer */
+#ifndef CO_OD_MIRROR_RETRIES
+#define CO_OD_MIRROR_RETRIES    16U
+#endif
+
+/** Direction for CO_OD_MIRROR_SIGNAL(): RPDO data published for application */
+#define CO_OD_MIRROR_RX         0U
+/** Direction for CO_OD_MIRROR_SIGNAL(): TPDO data written by application */
+#define CO_OD_MIRROR_TX         1U
+
+/** Flag in CO_ODmirrorEntry_t _pdo_ for a TPDO */
+#define CO_OD_MIRROR_TPDO       0x80U
+
+#if CO_PDO_MAX_SIZE > 64
+#error CO_OD_MIRROR supports PDO data up to 64 bytes
+#endif
+
+
+/**
+ * One mapped variable in the mirror.
+ */
+typedef struct{
+    uint16_t            index;          /**< Index of mapped object */
+    uint8_t             subIndex;       /**< Subindex of mapped object */
+    uint8_t             length;         /**< Length in bytes */
+    uint8_t             pdo;            /**< PDO number, 0 based, CO_OD_MIRROR_TPDO for TPDO */
+    uint8_t             offset;         /**< Position in PDO data */
+}CO_ODmirrorEntry_t;
+
+
+/**
+ * Data of one PDO in the mirror.
+ */
+typedef struct{
+    /** Sequence counter, odd while writer copies data */
+    volatile uint32_t   seq;
+    /** TPDO: _mapSeq_ of the table, for which _mask_ is valid */
+    uint32_t            mapSeq;
+    /** TPDO: bit n is set, if application wrote byte n of data */
+    uint64_t            mask;
+    /** Mapped variables in PDO layout */
+    uint8_t             data[CO_PDO_MAX_SIZE];
+}CO_ODmirrorSlot_t;
+
+
+/**
+ * Mirror in memory shared by both cores.
+ */
+typedef struct{
+    /** Sequence counter of the table, odd while CANopen core builds it */
+    volatile uint32_t   mapSeq;
+    /** Number of used entry */
+    uint16_t            entryCount;
+    /** True, if not all mapped variables fit into entry */
+    bool_t              overflow;
+    /** Mapped variables of valid PDOs */
+    CO_ODmirrorEntry_t  entry[CO_OD_MIRROR_ENTRIES];
+    /** Incremented by CANopen core after RPDO data were published */
+    volatile uint32_t   rxDoorbell;
+    /** Incremented by application core after TPDO data were written */
+    volatile uint32_t   txDoorbell;
+    /** RPDO data, written by CANopen core */
+    CO_ODmirrorSlot_t   rpdo[CO_NO_RPDO];
+    /** TPDO data, written by application core */
+    CO_ODmirrorSlot_t   tpdo[CO_NO_TPDO];
+}CO_ODmirrorShared_t;
+
+
+/**
+ * Mirror object of the CANopen core.
+ */
+typedef struct{
+    CO_ODmirrorShared_t *shared;        /**< From CO_ODmirror_init() */
+    CO_t               *CO;             /**< From CO_ODmirror_init() */
+    uint8_t             NMTstate;       /**< From the previous CO_ODmirror_process() */
+    uint32_t            txDoorbell;     /**< Last processed _txDoorbell_ */
+    uint32_t            txSeq[CO_NO_TPDO]; /**< Last processed _seq_ of TPDO slots */
+}CO_ODmirror_t;
+
+
+/**
+ * Initialize mirror on the CANopen core.
+ *
+ * Function must be called after each CO_init(). It builds table of mapped
+ * variables and publishes current values of RPDO variables. TPDO slots are
+ * not touched, application core owns them. Shared part must be zero at power
+ * on, cleared by the core, which starts first, before the other one runs.
+ *
+ * @param mirror This object will be initialized.
+ * @param shared Shared part, placed with #CO_OD_MIRROR_ATTR.
+ * @param CO CANopen object.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_ODmirror_init(
+        CO_ODmirror_t          *mirror,
+        CO_ODmirrorShared_t    *shared,
+        CO_t                   *CO);
+
+
+/**
+ * Exchange PDO data with the application core.
+ *
+ * Function must be called on the CANopen core between CO_process_SYNC_RPDO()
+ * and CO_process_TPDO(). It publishes changed RPDO variables and copies
+ * TPDO variables written by application into the Object Dictionary.
+ *
+ * @param mirror This object.
+ */
+void CO_ODmirror_process(CO_ODmirror_t *mirror);
+
+
+/**
+ * Read mapped variable on the application core.
+ *
+ * Variables mapped to RPDOs are received values, variables mapped to TPDOs
+ * are values last written by CO_ODmirror_write().
+ *
+ * @param shared Shared part of the mirror.
+ * @param index Index of mapped object.
+ * @param subIndex Subindex of mapped object.
+ * @param buf Buffer for value in CANopen (little endian) byte order.
+ * @param length Length of the buffer, must be equal to mapped length.
+ *
+ * @return True, if value was read. False, if variable is not mapped or
+ * writer did not finish within #CO_OD_MIRROR_RETRIES.
+ */
+bool_t CO_ODmirror_read(
+        const CO_ODmirrorShared_t *shared,
+        uint16_t                index,
+        uint8_t                 subIndex,
+        void                   *buf,
+        uint8_t                 length);
+
+
+/**
+ * Write variable mapped to TPDO on the application core.
+ *
+ * Value is written into the Object Dictionary by the next
+ * CO_ODmirror_process() on the CANopen core.
+ *
+ * @param shared Shared part of the mirror.
+ * @param index Index of mapped object.
+ * @param subIndex Subindex of mapped object.
+ * @param buf Value in CANopen (little endian) byte order.
+ * @param length Length of the value, must be equal to mapped length.
+ *
+ * @return True, if value was written. False, if variable is not mapped to
+ * a TPDO or table is being rebuilt.
+ */
+bool_t CO_ODmirror_write(
+        CO_ODmirrorShared_t    *shared,
+        uint16_t                index,
+        uint8_t                 subIndex,
+        const void             *buf,
+        uint8_t                 length);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif
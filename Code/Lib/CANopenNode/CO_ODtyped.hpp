@@ -0,0 +1,160 @@
+/**
+ * Typed C++ access to CANopen Object Dictionary.
+ *
+ * @file        CO_ODtyped.hpp
+ * @ingroup     CO_ODtyped
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * CANopenNode is free and open source software: you can redistribute
+ * it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Following clarification and special exception to the GNU General Public
+ * License is included to the distribution terms of CANopenNode:
+ *
+ * Linking this library statically or dynamically with other modules is
+ * making a combined work based on this library. Thus, the terms and
+ * conditions of the GNU General Public License cover the whole combination.
+ *
+ * As a special exception, the copyright holders of this library give
+ * you permission to link this library with independent modules to
+ * produce an executable, regardless of the license terms of these
+ * independent modules, and to copy and distribute the resulting
+ * executable under terms of your choice, provided that you also meet,
+ * for each linked independent module, the terms and conditions of the
+ * license of that module. An independent module is a module which is
+ * not derived from or based on this library. If you modify this
+ * library, you may extend this exception to your version of the
+ * library, but you are not obliged to do so. If you do not wish
+ * to do so, delete this exception statement from your version.
+ */
+
+
+#ifndef CO_ODTYPED_HPP
+#define CO_ODTYPED_HPP
+
+#include <stdint.h>
+#include <type_traits>
+
+
+/**
+ * @defgroup CO_ODtyped Typed Object Dictionary
+ * @ingroup CO_CANopen
+ * @{
+ *
+ * Header-only C++ layer over generated CO_OD.h.
+ *
+ * Each OD variable is described by specialization of CO::ODentry, keyed by
+ * index and subindex. It is generated from CO_OD.c into CO_OD.hpp by
+ * tools/odcpp.py, which includes this file. Access functions are inline and
+ * resolve to the same struct member access as OD_xxx macros, for example
+ * CO::get<0x1017, 0>() is CO_OD_ROM.producerHeartbeatTime. Unknown
+ * index/subindex does not compile, the same as access, which is not allowed
+ * by attribute of the variable:
+ *
+ * \code{.cpp}
+ * #include "CO_OD.hpp"
+ *
+ * uint16_t hb = CO::get<0x1017, 0>();        // SDO readable
+ * CO::tpdo<0x6401, 1>(adcValue);             // TPDO mappable input
+ * uint8_t out = CO::rpdo<0x6200, 1>();       // RPDO mappable output
+ * CO::set<0x1000, 0>(5);                     // error: not SDO writeable
+ * \endcode
+ *
+ * CO::ref() gives unrestricted reference, the same as raw access. Locking
+ * rules of CO_LOCK_OD() or #CO_OD_ATOMIC stay the same as for C code.
+ */
+
+namespace CO {
+
+/** Attribute bits of OD variable, the same as #CO_SDO_OD_attributes_t */
+enum ODattribute : uint16_t {
+    ODA_MEM_ROM         = 0x0001U,
+    ODA_MEM_RAM         = 0x0002U,
+    ODA_MEM_EEPROM      = 0x0003U,
+    ODA_READABLE        = 0x0004U,
+    ODA_WRITEABLE       = 0x0008U,
+    ODA_RPDO_MAPABLE    = 0x0010U,
+    ODA_TPDO_MAPABLE    = 0x0020U,
+    ODA_TPDO_DETECT_COS = 0x0040U,
+    ODA_MB_VALUE        = 0x0080U
+};
+
+/**
+ * OD variable at _Index_, _SubIndex_. Specializations, generated in
+ * CO_OD.hpp, provide:
+ *  - type: type of the variable,
+ *  - attribute: #CO_SDO_OD_attributes_t from CO_OD.c,
+ *  - ref(): reference to the variable.
+ */
+template<uint16_t Index, uint8_t SubIndex> struct ODentry;
+
+/** True, if attribute of OD variable has all _bits_ */
+template<uint16_t Index, uint8_t SubIndex>
+constexpr bool ODhas(uint16_t bits) {
+    return (ODentry<Index, SubIndex>::attribute & bits) == bits;
+}
+
+/** Unrestricted reference to OD variable */
+template<uint16_t Index, uint8_t SubIndex>
+inline typename ODentry<Index, SubIndex>::type &ref() {
+    return ODentry<Index, SubIndex>::ref();
+}
+
+/** Read OD variable, which is readable by SDO */
+template<uint16_t Index, uint8_t SubIndex>
+inline const typename ODentry<Index, SubIndex>::type &get() {
+    static_assert(ODhas<Index, SubIndex>(ODA_READABLE), "OD variable is not readable");
+    return ODentry<Index, SubIndex>::ref();
+}
+
+/** Write OD variable, which is writeable by SDO */
+template<uint16_t Index, uint8_t SubIndex>
+inline void set(const typename ODentry<Index, SubIndex>::type &value) {
+    static_assert(ODhas<Index, SubIndex>(ODA_WRITEABLE), "OD variable is not writeable");
+    ODentry<Index, SubIndex>::ref() = value;
+}
+
+/** Read OD variable, which is written by RPDO */
+template<uint16_t Index, uint8_t SubIndex>
+inline const typename ODentry<Index, SubIndex>::type &rpdo() {
+    static_assert(ODhas<Index, SubIndex>(ODA_RPDO_MAPABLE), "OD variable is not RPDO mappable");
+    return ODentry<Index, SubIndex>::ref();
+}
+
+/** Write OD variable, which is sent by TPDO */
+template<uint16_t Index, uint8_t SubIndex>
+inline void tpdo(const typename ODentry<Index, SubIndex>::type &value) {
+    static_assert(ODhas<Index, SubIndex>(ODA_TPDO_MAPABLE), "OD variable is not TPDO mappable");
+    ODentry<Index, SubIndex>::ref() = value;
+}
+
+} /* namespace CO */
+
+
+/**
+ * Define CO::ODentry for OD variable _var_, used by generated CO_OD.hpp.
+ */
+#define CO_OD_ENTRY(index, subIndex, attr, var)                                \
+    namespace CO {                                                             \
+    template<> struct ODentry<index, subIndex> {                               \
+        typedef std::remove_reference<decltype((var))>::type type;            \
+        static constexpr uint16_t attribute = attr;                            \
+        static inline type &ref() { return var; }                              \
+    };                                                                         \
+    }
+
+/** @} */
+#endif /* CO_ODTYPED_HPP */
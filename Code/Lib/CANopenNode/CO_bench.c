@@ -0,0 +1,411 @@
+/*
+ * Micro-benchmark of CANopenNode hot paths.
+ *
+ * @file        CO_bench.c
+ * @ingroup     CO_bench
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * CANopenNode is free and open source software: you can redistribute
+ * it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Following clarification and special exception to the GNU General Public
+ * License is included to the distribution terms of CANopenNode:
+ *
+ * Linking this library statically or dynamically with other modules is
+ * making a combined work based on this library. Thus, the terms and
+ * conditions of the GNU General Public License cover the whole combination.
+ *
+ * As a special exception, the copyright holders of this library give
+ * you permission to link this library with independent modules to
+ * produce an executable, regardless of the license terms of these
+ * independent modules, and to copy and distribute the resulting
+ * executable under terms of your choice, provided that you also meet,
+ * for each linked independent module, the terms and conditions of the
+ * license of that module. An independent module is a module which is
+ * not derived from or based on this library. If you modify this
+ * library, you may extend this exception to your version of the
+ * library, but you are not obliged to do so. If you do not wish
+ * to do so, delete this exception statement from your version.
+ */
+
+
+#include "CO_bench.h"
+#include "crc16-ccitt.h"
+#include <string.h>
+
+#if CO_BENCH > 0
+
+static const char *const CO_bench_names[CO_BENCH_ITEMS] = {
+    "CO_OD_find",
+    "RPDO receive",
+    "CO_RPDO_process",
+    "CO_TPDOisCOS",
+    "CO_TPDOsend",
+    "SDO segmented upload",
+    "SDO block upload",
+    "crc16_ccitt"
+};
+
+static uint8_t CO_bench_crcData[CO_BENCH_CRC_LENGTH];
+
+
+/*
+ * Add one measurement to the statistics.
+ */
+static void CO_bench_record(CO_bench_stat_t *stat, uint32_t time){
+    stat->count++;
+    stat->sum += time;
+    if(time < stat->min){
+        stat->min = time;
+    }
+    if(time > stat->max){
+        stat->max = time;
+    }
+}
+
+
+/*
+ * Find reception buffer of the object, registered with CO_CANrxBufferInit().
+ */
+static CO_CANrx_t *CO_bench_findRx(CO_CANmodule_t *CANmodule, const void *object){
+    uint16_t i;
+
+    for(i = 0U; i < CANmodule->rxSize; i++){
+        if(CANmodule->rxArray[i].object == object && CANmodule->rxArray[i].pFunct != NULL){
+            return &CANmodule->rxArray[i];
+        }
+    }
+    return NULL;
+}
+
+
+/*
+ * Wait, until transmit buffer is sent by CAN module. Return false on timeout.
+ */
+static bool_t CO_bench_waitTx(const CO_CANtx_t *buffer){
+    uint32_t polls = 0U;
+
+    while(buffer->bufferFull){
+        if(++polls > CO_BENCH_TX_TIMEOUT){
+            return false;
+        }
+    }
+    return true;
+}
+
+
+/*
+ * Pass client request to SDO server, if not NULL, and process it, until
+ * request is consumed. Time of CO_SDO_process() calls is added to _time_.
+ */
+static bool_t CO_bench_sdoStep(
+        CO_SDO_t               *SDO,
+        CO_CANrx_t             *rx,
+        const uint8_t          *request,
+        uint32_t               *time)
+{
+    if(request != NULL){
+        CO_CANrxMsg_t msg;
+
+        memset(&msg, 0, sizeof(msg));
+        msg.DLC = 8U;
+        memcpy(msg.data, request, 8U);
+        rx->pFunct(rx->object, &msg);
+    }
+
+    do{
+        uint32_t start;
+
+        if(!CO_bench_waitTx(SDO->CANtxBuff)){
+            return false;
+        }
+        start = CO_BENCH_TIME();
+        if(CO_SDO_process(SDO, true, 0U, 1000U, NULL) < 0){
+            return false;
+        }
+        *time += CO_BENCH_TIME() - start;
+    }while(SDO->CANrxNew);
+
+    return true;
+}
+
+
+/*
+ * Abort unfinished transfer from client side.
+ */
+static void CO_bench_sdoAbort(CO_SDO_t *SDO, CO_CANrx_t *rx){
+    static const uint8_t req[8] = {0x80U, 0U, 0U, 0U, 0U, 0U, 0U, 0U};
+    uint32_t time = 0U;
+
+    if(SDO->state != CO_SDO_ST_IDLE){
+        SDO->CANrxNew = false;
+        (void)CO_bench_sdoStep(SDO, rx, req, &time);
+    }
+}
+
+
+/*
+ * OD function of the uploaded domain, generates CO_BENCH_SDO_LENGTH bytes.
+ */
+static CO_SDO_abortCode_t CO_bench_sdoDomain(CO_ODF_arg_t *ODF_arg){
+    uint32_t rest = CO_BENCH_SDO_LENGTH - ODF_arg->offset;
+    uint16_t i;
+
+    if(!ODF_arg->reading){
+        return CO_SDO_AB_READONLY;
+    }
+    if(ODF_arg->firstSegment){
+        ODF_arg->dataLengthTotal = CO_BENCH_SDO_LENGTH;
+    }
+    ODF_arg->lastSegment = (rest <= ODF_arg->dataLength) ? true : false;
+    if(ODF_arg->lastSegment){
+        ODF_arg->dataLength = (uint16_t)rest;
+    }
+    for(i = 0U; i < ODF_arg->dataLength; i++){
+        ODF_arg->data[i] = (uint8_t)(ODF_arg->offset + i);
+    }
+    return CO_SDO_AB_NONE;
+}
+
+
+/*
+ * Segmented SDO upload of CO_BENCH_SDO_INDEX. Return number of bytes or 0.
+ */
+static uint32_t CO_bench_sdoSegmented(CO_SDO_t *SDO, CO_CANrx_t *rx, uint32_t *time){
+    uint8_t req[8] = {0x40U, (uint8_t)CO_BENCH_SDO_INDEX, (uint8_t)(CO_BENCH_SDO_INDEX >> 8),
+                      CO_BENCH_SDO_SUBINDEX, 0U, 0U, 0U, 0U};
+    uint32_t bytes = 0U;
+    uint8_t toggle = 0U;
+
+    if(!CO_bench_sdoStep(SDO, rx, req, time) || (SDO->CANtxBuff->data[0] & 0xE0U) != 0x40U){
+        return 0U;
+    }
+    if((SDO->CANtxBuff->data[0] & 0x02U) != 0U){
+        /* expedited response */
+        return ((SDO->CANtxBuff->data[0] & 0x01U) != 0U) ? (4U - ((SDO->CANtxBuff->data[0] >> 2) & 0x03U)) : 4U;
+    }
+
+    memset(req, 0, sizeof(req));
+    do{
+        req[0] = 0x60U | toggle;
+        toggle ^= 0x10U;
+        if(!CO_bench_sdoStep(SDO, rx, req, time) || (SDO->CANtxBuff->data[0] & 0xE0U) != 0x00U){
+            return 0U;
+        }
+        bytes += 7U - ((SDO->CANtxBuff->data[0] >> 1) & 0x07U);
+    }while((SDO->CANtxBuff->data[0] & 0x01U) == 0U);
+
+    return bytes;
+}
+
+
+/*
+ * Block SDO upload of CO_BENCH_SDO_INDEX with CRC, sub-blocks of up to 127
+ * segments. Return number of bytes or 0.
+ */
+static uint32_t CO_bench_sdoBlock(CO_SDO_t *SDO, CO_CANrx_t *rx, uint32_t *time){
+    uint8_t req[8] = {0xA4U, (uint8_t)CO_BENCH_SDO_INDEX, (uint8_t)(CO_BENCH_SDO_INDEX >> 8),
+                      CO_BENCH_SDO_SUBINDEX, 127U, 0U, 0U, 0U};
+    uint32_t bytes = 0U;
+
+    /* initiate, protocol switch threshold 0 */
+    if(!CO_bench_sdoStep(SDO, rx, req, time) || (SDO->CANtxBuff->data[0] & 0xF9U) != 0xC0U){
+        return 0U;
+    }
+
+    /* start, then sub-blocks, each acknowledged by the client */
+    memset(req, 0, sizeof(req));
+    req[0] = 0xA3U;
+    if(!CO_bench_sdoStep(SDO, rx, req, time)){
+        return 0U;
+    }
+    for(;;){
+        while(SDO->sequence < SDO->blksize && !SDO->endOfTransfer){
+            if(!CO_bench_sdoStep(SDO, rx, NULL, time)){
+                return 0U;
+            }
+        }
+
+        req[0] = 0xA2U;
+        req[1] = SDO->sequence;
+        req[2] = 127U;
+        if(SDO->endOfTransfer){
+            bytes += (uint32_t)(SDO->sequence - 1U) * 7U + SDO->lastLen;
+            break;
+        }
+        bytes += (uint32_t)SDO->sequence * 7U;
+
+        /* server continues with the first segment of the next sub-block */
+        if(!CO_bench_sdoStep(SDO, rx, req, time) || SDO->state != CO_SDO_ST_UPLOAD_BL_SUBBLOCK){
+            return 0U;
+        }
+    }
+
+    /* acknowledge last sub-block, server responds with end */
+    if(!CO_bench_sdoStep(SDO, rx, req, time) || (SDO->CANtxBuff->data[0] & 0xE3U) != 0xC1U){
+        return 0U;
+    }
+
+    /* end */
+    memset(req, 0, sizeof(req));
+    req[0] = 0xA1U;
+    if(!CO_bench_sdoStep(SDO, rx, req, time) || SDO->state != CO_SDO_ST_IDLE){
+        return 0U;
+    }
+
+    return bytes;
+}
+
+
+/*
+ * PDO items, NMT state must be operational.
+ */
+static void CO_bench_pdo(CO_bench_t *bench, CO_t *co){
+    uint16_t i;
+
+    for(i = 0U; i < CO_NO_RPDO; i++){
+        CO_RPDO_t *RPDO = co->RPDO[i];
+        CO_CANrx_t *rx = CO_bench_findRx(co->CANmodule[0], RPDO);
+        CO_CANrxMsg_t msg;
+        uint32_t start;
+
+        if(!RPDO->valid || rx == NULL){
+            continue;
+        }
+
+        memset(&msg, 0, sizeof(msg));
+        msg.DLC = 8U;
+        msg.data[0] = (uint8_t)i;
+
+        start = CO_BENCH_TIME();
+        rx->pFunct(rx->object, &msg);
+        CO_bench_record(&bench->stat[CO_BENCH_RPDO_RECEIVE], CO_BENCH_TIME() - start);
+
+        start = CO_BENCH_TIME();
+        CO_RPDO_process(RPDO, true);
+        CO_bench_record(&bench->stat[CO_BENCH_RPDO_PROCESS], CO_BENCH_TIME() - start);
+    }
+
+    for(i = 0U; i < CO_NO_TPDO; i++){
+        CO_TPDO_t *TPDO = co->TPDO[i];
+        uint32_t start;
+
+        if(!TPDO->valid){
+            continue;
+        }
+
+        start = CO_BENCH_TIME();
+        (void)CO_TPDOisCOS(TPDO);
+        CO_bench_record(&bench->stat[CO_BENCH_TPDO_IS_COS], CO_BENCH_TIME() - start);
+
+        if(!CO_bench_waitTx(TPDO->CANtxBuff)){
+            bench->errors++;
+            continue;
+        }
+        start = CO_BENCH_TIME();
+        (void)CO_TPDOsend(TPDO);
+        CO_bench_record(&bench->stat[CO_BENCH_TPDO_SEND], CO_BENCH_TIME() - start);
+    }
+}
+
+
+/******************************************************************************/
+void CO_bench_run(CO_bench_t *bench, CO_t *co, uint16_t iterations){
+    CO_SDO_t *SDO = co->SDO[0];
+    CO_CANrx_t *sdoRx = CO_bench_findRx(co->CANmodule[0], SDO);
+    uint16_t sdoEntry = CO_OD_find(SDO, CO_BENCH_SDO_INDEX);
+    CO_OD_extension_t sdoExt;
+    uint8_t operatingState = co->NMT->operatingState;
+    uint16_t it;
+    uint32_t i;
+
+    memset(bench, 0, sizeof(*bench));
+    for(i = 0U; i < (uint32_t)CO_BENCH_ITEMS; i++){
+        bench->stat[i].min = 0xFFFFFFFFUL;
+    }
+    for(i = 0U; i < CO_BENCH_CRC_LENGTH; i++){
+        CO_bench_crcData[i] = (uint8_t)(i * 7U + 1U);
+    }
+
+    /* serve the domain by own OD function, restored at the end */
+    if(sdoEntry == 0xFFFFU || SDO->ODExtensions == NULL){
+        sdoRx = NULL;
+    }
+    else{
+        sdoExt = SDO->ODExtensions[sdoEntry];
+        SDO->ODExtensions[sdoEntry].pODFunc = CO_bench_sdoDomain;
+        SDO->ODExtensions[sdoEntry].object = NULL;
+    }
+
+    CO_BENCH_TIME_INIT();
+
+    for(it = 0U; it < iterations; it++){
+        uint32_t start, time, bytes;
+
+        /* Object Dictionary search */
+        for(i = 0U; i < SDO->ODSize; i++){
+            start = CO_BENCH_TIME();
+            (void)CO_OD_find(SDO, SDO->OD[i].index);
+            CO_bench_record(&bench->stat[CO_BENCH_OD_FIND], CO_BENCH_TIME() - start);
+        }
+
+        /* PDOs */
+        co->NMT->operatingState = CO_NMT_OPERATIONAL;
+        CO_bench_pdo(bench, co);
+        co->NMT->operatingState = operatingState;
+
+        /* SDO upload */
+        if(sdoRx != NULL){
+            time = 0U;
+            bytes = CO_bench_sdoSegmented(SDO, sdoRx, &time);
+            if(bytes == CO_BENCH_SDO_LENGTH){
+                CO_bench_record(&bench->stat[CO_BENCH_SDO_SEGMENTED], time);
+                bench->sdoBytes = bytes;
+            }
+            else{
+                bench->errors++;
+            }
+            CO_bench_sdoAbort(SDO, sdoRx);
+
+            time = 0U;
+            bytes = CO_bench_sdoBlock(SDO, sdoRx, &time);
+            if(bytes == CO_BENCH_SDO_LENGTH){
+                CO_bench_record(&bench->stat[CO_BENCH_SDO_BLOCK], time);
+            }
+            else{
+                bench->errors++;
+            }
+            CO_bench_sdoAbort(SDO, sdoRx);
+        }
+
+        /* CRC */
+        start = CO_BENCH_TIME();
+        (void)crc16_ccitt(CO_bench_crcData, CO_BENCH_CRC_LENGTH, 0U);
+        CO_bench_record(&bench->stat[CO_BENCH_CRC16], CO_BENCH_TIME() - start);
+    }
+
+    if(sdoRx != NULL){
+        SDO->ODExtensions[sdoEntry] = sdoExt;
+    }
+}
+
+
+/******************************************************************************/
+const char *CO_bench_name(CO_bench_item_t item){
+    return ((uint32_t)item < (uint32_t)CO_BENCH_ITEMS) ? CO_bench_names[item] : "";
+}
+
+#endif /* CO_BENCH > 0 */
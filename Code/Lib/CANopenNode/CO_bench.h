@@ -0,0 +1,177 @@
+/**
+ * Micro-benchmark of CANopenNode hot paths.
+ *
+ * @file        CO_bench.h
+ * @ingroup     CO_bench
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * CANopenNode is free and open source software: you can redistribute
+ * it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Following clarification and special exception to the GNU General Public
+ * License is included to the distribution terms of CANopenNode:
+ *
+ * Linking this library statically or dynamically with other modules is
+ * making a combined work based on this library. Thus, the terms and
+ * conditions of the GNU General Public License cover the whole combination.
+ *
+ * As a special exception, the copyright holders of this library give
+ * you permission to link this library with independent modules to
+ * produce an executable, regardless of the license terms of these
+ * independent modules, and to copy and distribute the resulting
+ * executable under terms of your choice, provided that you also meet,
+ * for each linked independent module, the terms and conditions of the
+ * license of that module. An independent module is a module which is
+ * not derived from or based on this library. If you modify this
+ * library, you may extend this exception to your version of the
+ * library, but you are not obliged to do so. If you do not wish
+ * to do so, delete this exception statement from your version.
+ */
+
+
+#ifndef CO_BENCH_H
+#define CO_BENCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "CANopen.h"
+
+
+/**
+ * @defgroup CO_bench Benchmark
+ * @ingroup CO_CANopen
+ * @{
+ *
+ * Micro-benchmark of CANopenNode hot paths.
+ *
+ * CO_bench_run() calls stack functions directly with synthetic messages, so
+ * the same code runs on the target and in the socketCAN host build:
+ *  - CO_OD_find() for each entry of the Object Dictionary,
+ *  - RPDO reception callback, as called from CAN receive interrupt, and
+ *    CO_RPDO_process() for each valid RPDO,
+ *  - CO_TPDOisCOS() and CO_TPDOsend() for each valid TPDO,
+ *  - segmented and block SDO upload of #CO_BENCH_SDO_LENGTH bytes from
+ *    domain #CO_BENCH_SDO_INDEX, driven by client requests passed to SDO
+ *    reception callback. Block upload runs in sub-blocks of 127 segments.
+ *    CO_bench_run() serves the domain with own OD function, installed only
+ *    for the measurement,
+ *  - crc16_ccitt() on #CO_BENCH_CRC_LENGTH bytes.
+ *
+ * Time is read with CO_BENCH_TIME() from CO_driver.h, DWT cycles on STM32,
+ * nanoseconds on host. Dispatch of CAN frames from hardware FIFO to reception
+ * callbacks is not included, see CO_PROFILE for that.
+ *
+ * Benchmark must run in NMT pre-operational state, before application uses
+ * the Object Dictionary: it switches NMT state to operational for the PDO
+ * items, overwrites variables mapped to RPDOs and transmits TPDOs and SDO
+ * responses. Number of PDOs is the one of the linked Object Dictionary.
+ * Measurement is not locked against interrupts, _max_ includes their time.
+ */
+
+/** Domain object used for SDO upload, default is testVar.domain */
+#ifndef CO_BENCH_SDO_INDEX
+#define CO_BENCH_SDO_INDEX          0x2120U
+#endif
+/** Subindex of #CO_BENCH_SDO_INDEX */
+#ifndef CO_BENCH_SDO_SUBINDEX
+#define CO_BENCH_SDO_SUBINDEX       5U
+#endif
+/** Length of uploaded domain, spans several SDO buffers */
+#ifndef CO_BENCH_SDO_LENGTH
+#define CO_BENCH_SDO_LENGTH         (4UL * CO_SDO_BUFFER_SIZE)
+#endif
+/** Data length for crc16_ccitt() */
+#ifndef CO_BENCH_CRC_LENGTH
+#define CO_BENCH_CRC_LENGTH         256U
+#endif
+/** Number of polls for free CAN transmit buffer, before item is aborted */
+#ifndef CO_BENCH_TX_TIMEOUT
+#define CO_BENCH_TX_TIMEOUT         100000UL
+#endif
+
+
+/**
+ * Measured items.
+ */
+typedef enum{
+    CO_BENCH_OD_FIND            = 0,    /**< CO_OD_find(), one call */
+    CO_BENCH_RPDO_RECEIVE       = 1,    /**< RPDO reception callback, one message */
+    CO_BENCH_RPDO_PROCESS       = 2,    /**< CO_RPDO_process(), one RPDO with new message */
+    CO_BENCH_TPDO_IS_COS        = 3,    /**< CO_TPDOisCOS(), one TPDO */
+    CO_BENCH_TPDO_SEND          = 4,    /**< CO_TPDOsend(), one TPDO */
+    CO_BENCH_SDO_SEGMENTED      = 5,    /**< CO_SDO_process() calls of one segmented upload */
+    CO_BENCH_SDO_BLOCK          = 6,    /**< CO_SDO_process() calls of one block upload */
+    CO_BENCH_CRC16              = 7,    /**< crc16_ccitt() on #CO_BENCH_CRC_LENGTH bytes */
+    CO_BENCH_ITEMS              = 8     /**< Number of items */
+}CO_bench_item_t;
+
+
+/**
+ * Result of one item.
+ */
+typedef struct{
+    uint32_t            count;      /**< Number of measurements, 0 if item was not run */
+    uint32_t            min;        /**< Minimum time, 0xFFFFFFFF if count is 0 */
+    uint32_t            max;        /**< Maximum time */
+    uint64_t            sum;        /**< Sum of time of all measurements */
+}CO_bench_stat_t;
+
+
+/**
+ * Benchmark results.
+ */
+typedef struct{
+    /** Statistics of each #CO_bench_item_t in CO_BENCH_TIME_UNIT */
+    CO_bench_stat_t     stat[CO_BENCH_ITEMS];
+    /** Bytes of one SDO upload, throughput is sdoBytes / average time */
+    uint32_t            sdoBytes;
+    /** Number of failed SDO transfers or aborted items (transmit timeout) */
+    uint32_t            errors;
+}CO_bench_t;
+
+
+/**
+ * Run all items.
+ *
+ * Function blocks, until all items are measured _iterations_ times. It must
+ * be called from mainline after CO_init() and CO_CANsetNormalMode(), without
+ * concurrent CO_process(), see @ref CO_bench.
+ *
+ * @param bench Results, cleared first.
+ * @param co CANopen object.
+ * @param iterations Number of repetitions of each item.
+ */
+void CO_bench_run(CO_bench_t *bench, CO_t *co, uint16_t iterations);
+
+
+/**
+ * Get name of the item, for printing results.
+ *
+ * @param item Measured item.
+ *
+ * @return Constant string.
+ */
+const char *CO_bench_name(CO_bench_item_t item);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif
@@ -0,0 +1,273 @@
+/*
+ * CANopen Concise DCF (object 0x1F22), configuration of many objects with one
+ * SDO transfer.
+ *
+ * @file        CO_DCF.c
+ * @ingroup     CO_DCF
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * CANopenNode is free and open source software: you can redistribute
+ * it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Following clarification and special exception to the GNU General Public
+ * License is included to the distribution terms of CANopenNode:
+ *
+ * Linking this library statically or dynamically with other modules is
+ * making a combined work based on this library. Thus, the terms and
+ * conditions of the GNU General Public License cover the whole combination.
+ *
+ * As a special exception, the copyright holders of this library give
+ * you permission to link this library with independent modules to
+ * produce an executable, regardless of the license terms of these
+ * independent modules, and to copy and distribute the resulting
+ * executable under terms of your choice, provided that you also meet,
+ * for each linked independent module, the terms and conditions of the
+ * license of that module. An independent module is a module which is
+ * not derived from or based on this library. If you modify this
+ * library, you may extend this exception to your version of the
+ * library, but you are not obliged to do so. If you do not wish
+ * to do so, delete this exception statement from your version.
+ */
+
+
+#include "CO_DCF.h"
+#include <string.h>
+
+#if CO_DCF > 0
+
+#if CO_DCF_VALUE_SIZE > CO_SDO_BUFFER_SIZE
+#error CO_DCF_VALUE_SIZE must not exceed CO_SDO_BUFFER_SIZE
+#endif
+
+/* Parser states */
+#define CO_DCF_ST_COUNT         0U  /* Number of entries */
+#define CO_DCF_ST_HEADER        1U  /* Index, subIndex and size of entry */
+#define CO_DCF_ST_VALUE         2U  /* Value of entry */
+#define CO_DCF_ST_DONE          3U  /* All entries parsed */
+
+
+/*
+ * Write the current entry into Object Dictionary through the SDO download
+ * path. SDO->ODF_arg belongs to the running transfer of 0x1F22, so it is
+ * saved and restored.
+ */
+static uint32_t CO_DCF_apply(CO_DCF_t *dcf){
+    CO_SDO_t *SDO = dcf->SDO;
+    CO_ODF_arg_t ODF_arg = SDO->ODF_arg;
+    uint16_t entryNo = SDO->entryNo;
+    uint32_t abortCode;
+
+    if(dcf->index == CO_DCF_OD_INDEX){
+        abortCode = CO_SDO_AB_PRAM_INCOMPAT;
+    }
+    else{
+        abortCode = CO_SDO_initTransfer(SDO, dcf->index, dcf->subIndex);
+        if(abortCode == 0U){
+            SDO->ODF_arg.data = dcf->value;
+            abortCode = CO_SDO_writeOD(SDO, (uint16_t)dcf->size);
+        }
+        if(abortCode == CO_SDO_AB_PENDING){
+            /* entry can not be deferred, rest of the DCF follows */
+            abortCode = CO_SDO_AB_DEVICE_INCOMPAT;
+        }
+    }
+
+    SDO->ODF_arg = ODF_arg;
+    SDO->entryNo = entryNo;
+
+    if(abortCode != 0U){
+        dcf->errorIndex = dcf->index;
+        dcf->errorSubIndex = dcf->subIndex;
+        dcf->state = CO_DCF_ST_DONE;
+        return abortCode;
+    }
+
+    dcf->applied++;
+    dcf->fill = 0U;
+    dcf->state = (--dcf->entries > 0U) ? CO_DCF_ST_HEADER : CO_DCF_ST_DONE;
+    return 0U;
+}
+
+
+/*
+ * Function for accessing _Concise DCF_ (index 0x1F22) from SDO server.
+ * Called for each filled SDO buffer of the download.
+ */
+static CO_SDO_abortCode_t CO_ODF_DCF(CO_ODF_arg_t *ODF_arg){
+    CO_DCF_t *dcf = (CO_DCF_t*)ODF_arg->object;
+    const uint8_t *data = ODF_arg->data;
+    uint16_t length = ODF_arg->dataLength;
+    bool_t lastSegment = ODF_arg->lastSegment;
+    uint32_t abortCode;
+    uint32_t n;
+
+    if(ODF_arg->subIndex == 0U){
+        return CO_SDO_AB_NONE;
+    }
+    if(ODF_arg->reading){
+        return CO_SDO_AB_WRITEONLY;
+    }
+    if(ODF_arg->subIndex != dcf->nodeId){
+        return CO_SDO_AB_DATA_LOC_CTRL;
+    }
+
+    if(ODF_arg->firstSegment){
+        dcf->state = CO_DCF_ST_COUNT;
+        dcf->fill = 0U;
+        dcf->applied = 0U;
+        dcf->errorIndex = 0U;
+        dcf->errorSubIndex = 0U;
+    }
+
+    while(length > 0U){
+        switch(dcf->state){
+            case CO_DCF_ST_COUNT:
+                dcf->header[dcf->fill++] = *data++;
+                length--;
+                if(dcf->fill == 4U){
+                    dcf->entries = CO_getUint32(dcf->header);
+                    dcf->fill = 0U;
+                    dcf->state = (dcf->entries > 0U) ? CO_DCF_ST_HEADER : CO_DCF_ST_DONE;
+                }
+                break;
+
+            case CO_DCF_ST_HEADER:
+                dcf->header[dcf->fill++] = *data++;
+                length--;
+                if(dcf->fill == CO_DCF_ENTRY_HEADER){
+                    dcf->index = CO_getUint16(&dcf->header[0]);
+                    dcf->subIndex = dcf->header[2];
+                    dcf->size = CO_getUint32(&dcf->header[3]);
+                    dcf->fill = 0U;
+                    if(dcf->size > CO_DCF_VALUE_SIZE){
+                        dcf->errorIndex = dcf->index;
+                        dcf->errorSubIndex = dcf->subIndex;
+                        dcf->state = CO_DCF_ST_DONE;
+                        return CO_SDO_AB_OUT_OF_MEM;
+                    }
+                    dcf->state = CO_DCF_ST_VALUE;
+                    if(dcf->size == 0U){
+                        abortCode = CO_DCF_apply(dcf);
+                        if(abortCode != 0U){
+                            return (CO_SDO_abortCode_t)abortCode;
+                        }
+                    }
+                }
+                break;
+
+            case CO_DCF_ST_VALUE:
+                n = dcf->size - dcf->fill;
+                if(n > length){
+                    n = length;
+                }
+                memcpy(&dcf->value[dcf->fill], data, n);
+                dcf->fill += n;
+                data += n;
+                length -= (uint16_t)n;
+                if(dcf->fill == dcf->size){
+                    abortCode = CO_DCF_apply(dcf);
+                    if(abortCode != 0U){
+                        return (CO_SDO_abortCode_t)abortCode;
+                    }
+                }
+                break;
+
+            default:
+                /* data after the last entry */
+                return CO_SDO_AB_DATA_LONG;
+        }
+    }
+
+    if(lastSegment && dcf->state != CO_DCF_ST_DONE){
+        return CO_SDO_AB_DATA_SHORT;
+    }
+
+    return CO_SDO_AB_NONE;
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_DCF_init(CO_DCF_t *dcf, CO_SDO_t *SDO, uint8_t nodeId){
+    if(dcf == NULL || SDO == NULL || nodeId < 1U || nodeId > 127U){
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    dcf->SDO = SDO;
+    dcf->nodeId = nodeId;
+    dcf->state = CO_DCF_ST_DONE;
+    dcf->entries = 0U;
+    dcf->fill = 0U;
+    dcf->applied = 0U;
+    dcf->errorIndex = 0U;
+    dcf->errorSubIndex = 0U;
+
+    CO_OD_configure(SDO, CO_DCF_OD_INDEX, CO_ODF_DCF, (void*)dcf, 0, 0U);
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_DCFbuilder_init(CO_DCFbuilder_t *builder, uint8_t *buf, uint32_t bufSize){
+    if(builder == NULL || buf == NULL || bufSize < 4U){
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    builder->buf = buf;
+    builder->bufSize = bufSize;
+    builder->length = 4U;
+    builder->entries = 0U;
+    CO_setUint32(buf, 0U);
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+bool_t CO_DCFbuilder_add(CO_DCFbuilder_t *builder, uint16_t index, uint8_t subIndex,
+                         const void *data, uint32_t size)
+{
+    uint8_t *entry = &builder->buf[builder->length];
+
+    if(size > (builder->bufSize - builder->length) ||
+       (builder->bufSize - builder->length - size) < CO_DCF_ENTRY_HEADER)
+    {
+        return false;
+    }
+
+    CO_setUint16(&entry[0], index);
+    entry[2] = subIndex;
+    CO_setUint32(&entry[3], size);
+    memcpy(&entry[CO_DCF_ENTRY_HEADER], data, size);
+    builder->length += CO_DCF_ENTRY_HEADER + size;
+    CO_setUint32(builder->buf, ++builder->entries);
+
+    return true;
+}
+
+
+/******************************************************************************/
+void CO_DCFbuilder_job(CO_DCFbuilder_t *builder, CO_SDOclientJob_t *job, uint8_t nodeId){
+    job->nodeId = nodeId;
+    job->index = CO_DCF_OD_INDEX;
+    job->subIndex = nodeId;
+    job->upload = false;
+    job->blockEnable = true;
+    job->data = builder->buf;
+    job->dataSize = builder->length;
+}
+
+#endif /* CO_DCF > 0 */
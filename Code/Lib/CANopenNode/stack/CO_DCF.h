@@ -0,0 +1,226 @@
+/**
+ * CANopen Concise DCF (object 0x1F22), configuration of many objects with one
+ * SDO transfer.
+ *
+ * @file        CO_DCF.h
+ * @ingroup     CO_DCF
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * CANopenNode is free and open source software: you can redistribute
+ * it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Following clarification and special exception to the GNU General Public
+ * License is included to the distribution terms of CANopenNode:
+ *
+ * Linking this library statically or dynamically with other modules is
+ * making a combined work based on this library. Thus, the terms and
+ * conditions of the GNU General Public License cover the whole combination.
+ *
+ * As a special exception, the copyright holders of this library give
+ * you permission to link this library with independent modules to
+ * produce an executable, regardless of the license terms of these
+ * independent modules, and to copy and distribute the resulting
+ * executable under terms of your choice, provided that you also meet,
+ * for each linked independent module, the terms and conditions of the
+ * license of that module. An independent module is a module which is
+ * not derived from or based on this library. If you modify this
+ * library, you may extend this exception to your version of the
+ * library, but you are not obliged to do so. If you do not wish
+ * to do so, delete this exception statement from your version.
+ */
+
+
+#ifndef CO_DCF_H
+#define CO_DCF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "CO_driver.h"
+#include "CO_SDO.h"
+#include "CO_SDOmaster.h"
+
+#if CO_DCF > 0
+
+/**
+ * @defgroup CO_DCF Concise DCF
+ * @ingroup CO_CANopen
+ * @{
+ *
+ * Concise device configuration file according to CiA 302-3.
+ *
+ * Configuration of a node with separate SDO writes costs one request and
+ * response and at least one CO_SDO_process() cycle for each object. Concise
+ * DCF carries all of them in one DOMAIN, which the master sends with one SDO
+ * block download into 0x1F22,_nodeId_ of the node:
+ *
+ *     UNSIGNED32 number of entries
+ *     entry:  UNSIGNED16 index, UNSIGNED8 subIndex, UNSIGNED32 size, size bytes of data
+ *
+ * All values are little endian. Server parses the domain segment by segment,
+ * entries may cross segment boundaries, and writes each entry through the
+ * same path as SDO download (CO_SDO_initTransfer(), CO_SDO_writeOD()), so
+ * attributes, lengths and OD functions (PDO, SYNC, heartbeat parameters) are
+ * verified as usual. The first failing entry aborts the transfer with its
+ * abort code, its index and subIndex are kept in _errorIndex_ and
+ * _errorSubIndex_. Entries before it stay written.
+ *
+ * Master builds the domain with CO_DCFbuilder_t and sends it with a job of
+ * SDO client queue, see CO_DCFbuilder_job().
+ *
+ * Object dictionary must contain 0x1F22 as an array of DOMAIN with 127
+ * sub-indexes, for example {0x1F22, 0x7F, 0x0A, 0, 0}. Only sub-index of own
+ * node-ID is accepted, storage of DCFs for other nodes is not supported.
+ */
+
+
+/** OD index of Concise DCF */
+#define CO_DCF_OD_INDEX         0x1F22U
+
+/** Size of entry header: index, subIndex and size */
+#define CO_DCF_ENTRY_HEADER     7U
+
+/** Largest value of one entry in bytes */
+#ifndef CO_DCF_VALUE_SIZE
+#define CO_DCF_VALUE_SIZE       32U
+#endif
+
+
+/**
+ * Concise DCF server object.
+ */
+typedef struct{
+    CO_SDO_t           *SDO;            /**< From CO_DCF_init() */
+    uint8_t             nodeId;         /**< From CO_DCF_init() */
+    uint8_t             state;          /**< Parser state, CO_DCF_ST_xxx in CO_DCF.c */
+    uint32_t            entries;        /**< Entries not parsed yet */
+    uint32_t            fill;           /**< Bytes collected in header or value */
+    uint8_t             header[CO_DCF_ENTRY_HEADER]; /**< Number of entries or entry header */
+    uint16_t            index;          /**< Index of the current entry */
+    uint8_t             subIndex;       /**< SubIndex of the current entry */
+    uint32_t            size;           /**< Size of the current entry */
+    uint8_t             value[CO_DCF_VALUE_SIZE]; /**< Value of the current entry */
+    uint32_t            applied;        /**< Entries written by the last transfer */
+    uint16_t            errorIndex;     /**< Index of the entry, which failed, 0 if none */
+    uint8_t             errorSubIndex;  /**< SubIndex of the entry, which failed */
+}CO_DCF_t;
+
+
+/**
+ * Concise DCF builder on master side.
+ */
+typedef struct{
+    uint8_t            *buf;            /**< From CO_DCFbuilder_init() */
+    uint32_t            bufSize;        /**< From CO_DCFbuilder_init() */
+    uint32_t            length;         /**< Bytes used in buf */
+    uint32_t            entries;        /**< Number of entries added */
+}CO_DCFbuilder_t;
+
+
+/**
+ * Initialize Concise DCF server and serve OD object 0x1F22.
+ *
+ * Function must be called in the communication reset section, after
+ * CO_init().
+ *
+ * @param dcf This object will be initialized.
+ * @param SDO SDO server object.
+ * @param nodeId Node-ID of this node.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_DCF_init(CO_DCF_t *dcf, CO_SDO_t *SDO, uint8_t nodeId);
+
+
+/**
+ * Initialize Concise DCF builder.
+ *
+ * @param builder This object will be initialized.
+ * @param buf Buffer for the domain, must stay valid until the job finishes.
+ * @param bufSize Size of buf, 4 bytes plus 7 bytes and value of each entry.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_DCFbuilder_init(CO_DCFbuilder_t *builder, uint8_t *buf, uint32_t bufSize);
+
+
+/**
+ * Add one entry to Concise DCF.
+ *
+ * @param builder This object.
+ * @param index Index of object in remote node.
+ * @param subIndex SubIndex of object in remote node.
+ * @param data Value, little endian.
+ * @param size Size of value in bytes.
+ *
+ * @return false, if entry does not fit into the buffer.
+ */
+bool_t CO_DCFbuilder_add(CO_DCFbuilder_t *builder, uint16_t index, uint8_t subIndex,
+                         const void *data, uint32_t size);
+
+
+/**
+ * Add UNSIGNED8 entry, see CO_DCFbuilder_add().
+ */
+static inline bool_t CO_DCFbuilder_addU8(CO_DCFbuilder_t *builder, uint16_t index, uint8_t subIndex, uint8_t value){
+    return CO_DCFbuilder_add(builder, index, subIndex, &value, 1U);
+}
+
+
+/**
+ * Add UNSIGNED16 entry, see CO_DCFbuilder_add().
+ */
+static inline bool_t CO_DCFbuilder_addU16(CO_DCFbuilder_t *builder, uint16_t index, uint8_t subIndex, uint16_t value){
+    uint8_t data[2];
+
+    CO_setUint16(data, value);
+    return CO_DCFbuilder_add(builder, index, subIndex, data, 2U);
+}
+
+
+/**
+ * Add UNSIGNED32 entry, see CO_DCFbuilder_add().
+ */
+static inline bool_t CO_DCFbuilder_addU32(CO_DCFbuilder_t *builder, uint16_t index, uint8_t subIndex, uint32_t value){
+    uint8_t data[4];
+
+    CO_setUint32(data, value);
+    return CO_DCFbuilder_add(builder, index, subIndex, data, 4U);
+}
+
+
+/**
+ * Prepare SDO client job, which downloads the Concise DCF into a node.
+ *
+ * Function fills members of _job_ from _nodeId_ to _dataSize_, application
+ * sets _object_ and _pFunctDone_ and passes the job to
+ * CO_SDOclientQueue_submit(). Block transfer is requested.
+ *
+ * @param builder This object, entries must not be added until the job finishes.
+ * @param job SDO client job.
+ * @param nodeId Node-ID of the configured node, 1..127.
+ */
+void CO_DCFbuilder_job(CO_DCFbuilder_t *builder, CO_SDOclientJob_t *job, uint8_t nodeId);
+
+/** @} */
+#endif /* CO_DCF > 0 */
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif
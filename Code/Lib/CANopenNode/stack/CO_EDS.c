@@ -0,0 +1,201 @@
+/*
+ * CANopen Store EDS (objects 0x1021 and 0x1022), device description served
+ * from compressed image in flash.
+ *
+ * @file        CO_EDS.c
+ * @ingroup     CO_EDS
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * CANopenNode is free and open source software: you can redistribute
+ * it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Following clarification and special exception to the GNU General Public
+ * License is included to the distribution terms of CANopenNode:
+ *
+ * Linking this library statically or dynamically with other modules is
+ * making a combined work based on this library. Thus, the terms and
+ * conditions of the GNU General Public License cover the whole combination.
+ *
+ * As a special exception, the copyright holders of this library give
+ * you permission to link this library with independent modules to
+ * produce an executable, regardless of the license terms of these
+ * independent modules, and to copy and distribute the resulting
+ * executable under terms of your choice, provided that you also meet,
+ * for each linked independent module, the terms and conditions of the
+ * license of that module. An independent module is a module which is
+ * not derived from or based on this library. If you modify this
+ * library, you may extend this exception to your version of the
+ * library, but you are not obliged to do so. If you do not wish
+ * to do so, delete this exception statement from your version.
+ */
+
+
+#include "CO_EDS.h"
+
+#if CO_EDS_STORE > 0
+
+#if (CO_EDS_WINDOW & (CO_EDS_WINDOW - 1U)) != 0
+#error CO_EDS_WINDOW must be power of two
+#endif
+
+/* Match with length field 15 has one more byte of length */
+#define CO_EDS_MIN_MATCH        3U
+#define CO_EDS_LONG_MATCH       18U
+
+
+/*
+ * Decompress next _length_ bytes of the file into _buf_. Decoder state is kept
+ * in _eds_, so match may continue in the next call. Returns false, if image is
+ * corrupt.
+ */
+static bool_t CO_EDS_inflate(CO_EDS_t *eds, uint8_t *buf, uint16_t length){
+    const uint8_t *image = eds->image;
+    uint32_t pos = eds->pos;
+    uint32_t head = eds->head;
+    bool_t ret = true;
+
+    while(length > 0U){
+        uint8_t c;
+
+        if(eds->matchLength == 0U){
+            if(eds->controlBits == 0U){
+                if(pos >= eds->imageSize){
+                    ret = false;
+                    break;
+                }
+                eds->control = image[pos++];
+                eds->controlBits = 8U;
+            }
+            eds->controlBits--;
+
+            if((eds->control & 0x01U) != 0U){
+                /* literal */
+                eds->control >>= 1;
+                if(pos >= eds->imageSize){
+                    ret = false;
+                    break;
+                }
+                c = image[pos++];
+                eds->window[head & (CO_EDS_WINDOW - 1U)] = c;
+                head++;
+                *buf++ = c;
+                length--;
+                continue;
+            }
+            eds->control >>= 1;
+
+            /* match: distance - 1 and length - 3, 12 and 4 bits */
+            if((pos + 2U) > eds->imageSize){
+                ret = false;
+                break;
+            }
+            eds->distance = ((uint32_t)image[pos] | ((uint32_t)(image[pos + 1U] & 0x0FU) << 8)) + 1U;
+            eds->matchLength = (uint16_t)((image[pos + 1U] >> 4) + CO_EDS_MIN_MATCH);
+            pos += 2U;
+            if(eds->matchLength == CO_EDS_LONG_MATCH){
+                if(pos >= eds->imageSize){
+                    ret = false;
+                    break;
+                }
+                eds->matchLength += image[pos++];
+            }
+            if(eds->distance > eds->windowSize || eds->distance > head){
+                ret = false;
+                break;
+            }
+        }
+
+        c = eds->window[(head - eds->distance) & (CO_EDS_WINDOW - 1U)];
+        eds->window[head & (CO_EDS_WINDOW - 1U)] = c;
+        head++;
+        eds->matchLength--;
+        *buf++ = c;
+        length--;
+    }
+
+    eds->pos = pos;
+    eds->head = head;
+    return ret;
+}
+
+
+/*
+ * Function for accessing _Store EDS_ (index 0x1021) from SDO server.
+ * Called for each SDO buffer of the upload.
+ */
+static CO_SDO_abortCode_t CO_ODF_EDS(CO_ODF_arg_t *ODF_arg){
+    CO_EDS_t *eds = (CO_EDS_t*)ODF_arg->object;
+    uint32_t remaining;
+
+    if(!ODF_arg->reading){
+        return CO_SDO_AB_READONLY;
+    }
+
+    if(ODF_arg->firstSegment){
+        eds->pos = CO_EDS_HEADER_SIZE;
+        eds->head = 0U;
+        eds->matchLength = 0U;
+        eds->controlBits = 0U;
+        ODF_arg->dataLengthTotal = eds->size;
+    }
+
+    remaining = eds->size - ODF_arg->offset;
+    if(remaining <= ODF_arg->dataLength){
+        ODF_arg->dataLength = (uint16_t)remaining;
+        ODF_arg->lastSegment = true;
+    }
+    else{
+        ODF_arg->lastSegment = false;
+    }
+
+    if(!CO_EDS_inflate(eds, ODF_arg->data, ODF_arg->dataLength)){
+        return CO_SDO_AB_DATA_OD;
+    }
+
+    return CO_SDO_AB_NONE;
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_EDS_init(CO_EDS_t *eds, CO_SDO_t *SDO, const uint8_t *image, uint32_t imageSize){
+    if(eds == NULL || SDO == NULL || image == NULL){
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    if(imageSize <= CO_EDS_HEADER_SIZE || image[0] != 'E' || image[1] != 'Z' ||
+       image[2] != 1U || image[3] > 12U || (1UL << image[3]) > CO_EDS_WINDOW ||
+       CO_getUint32(&image[4]) == 0U)
+    {
+        return CO_ERROR_DATA_CORRUPT;
+    }
+
+    eds->image = image;
+    eds->imageSize = imageSize;
+    eds->size = CO_getUint32(&image[4]);
+    eds->windowSize = 1UL << image[3];
+    eds->pos = CO_EDS_HEADER_SIZE;
+    eds->head = 0U;
+    eds->distance = 0U;
+    eds->matchLength = 0U;
+    eds->control = 0U;
+    eds->controlBits = 0U;
+
+    CO_OD_configure(SDO, CO_EDS_OD_INDEX, CO_ODF_EDS, (void*)eds, 0, 0U);
+
+    return CO_ERROR_NO;
+}
+
+#endif /* CO_EDS_STORE > 0 */
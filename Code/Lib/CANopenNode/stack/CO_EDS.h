@@ -0,0 +1,149 @@
+/**
+ * CANopen Store EDS (objects 0x1021 and 0x1022), device description served
+ * from compressed image in flash.
+ *
+ * @file        CO_EDS.h
+ * @ingroup     CO_EDS
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * CANopenNode is free and open source software: you can redistribute
+ * it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Following clarification and special exception to the GNU General Public
+ * License is included to the distribution terms of CANopenNode:
+ *
+ * Linking this library statically or dynamically with other modules is
+ * making a combined work based on this library. Thus, the terms and
+ * conditions of the GNU General Public License cover the whole combination.
+ *
+ * As a special exception, the copyright holders of this library give
+ * you permission to link this library with independent modules to
+ * produce an executable, regardless of the license terms of these
+ * independent modules, and to copy and distribute the resulting
+ * executable under terms of your choice, provided that you also meet,
+ * for each linked independent module, the terms and conditions of the
+ * license of that module. An independent module is a module which is
+ * not derived from or based on this library. If you modify this
+ * library, you may extend this exception to your version of the
+ * library, but you are not obliged to do so. If you do not wish
+ * to do so, delete this exception statement from your version.
+ */
+
+
+#ifndef CO_EDS_H
+#define CO_EDS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "CO_driver.h"
+#include "CO_SDO.h"
+
+#if CO_EDS_STORE > 0
+
+/**
+ * @defgroup CO_EDS Store EDS
+ * @ingroup CO_CANopen
+ * @{
+ *
+ * Device description (EDS or XDD) read from the device according to CiA 301.
+ *
+ * Commissioning tool reads the whole file with one SDO upload of 0x1021,
+ * preferably block upload, instead of scanning the Object Dictionary entry by
+ * entry. File is linked into flash as LZSS compressed image, produced by
+ * tools/edszip.py:
+ *
+ *     edszip.py IO.eds CO_EDS_image.c
+ *
+ * EDS must describe the Object Dictionary of the application (CO_OD.c), not
+ * the stack example. tools/edscheck.py compares both, the host build of
+ * socketCAN runs it.
+ *
+ * Generated C file defines CO_EDS_image and CO_EDS_imageSize. Image is
+ * decompressed on the fly by Object Dictionary function of 0x1021, each call
+ * fills the SDO buffer, so RAM cost is the window of #CO_EDS_WINDOW bytes.
+ * Size of the file is sent in upload initiate. 0x1022 (storage format) is
+ * constant 0, the client receives the uncompressed ASCII file.
+ *
+ * Object dictionary must contain 0x1021 as read-only DOMAIN, for example
+ * {0x1021, 0x00, 0x06, 0, 0}, and 0x1022 as UNSIGNED8. Only one transfer of
+ * 0x1021 may run at a time.
+ */
+
+
+/** OD index of Store EDS */
+#define CO_EDS_OD_INDEX         0x1021U
+
+/** Size of image header: "EZ", version, window bits, file size */
+#define CO_EDS_HEADER_SIZE      8U
+
+/** Decompression window in bytes, power of two, at least window of the image */
+#ifndef CO_EDS_WINDOW
+#define CO_EDS_WINDOW           1024U
+#endif
+
+
+/**
+ * Store EDS object.
+ */
+typedef struct{
+    const uint8_t      *image;          /**< From CO_EDS_init() */
+    uint32_t            imageSize;      /**< From CO_EDS_init() */
+    uint32_t            size;           /**< Size of the file, from image header */
+    uint32_t            windowSize;     /**< Window of the image, from image header */
+    uint32_t            pos;            /**< Next byte of the image */
+    uint32_t            head;           /**< Bytes decompressed by the current transfer */
+    uint32_t            distance;       /**< Distance of the current match */
+    uint16_t            matchLength;    /**< Bytes of the current match, which are not copied yet */
+    uint8_t             control;        /**< Rest of the current control byte */
+    uint8_t             controlBits;    /**< Items left in the current control byte */
+    uint8_t             window[CO_EDS_WINDOW]; /**< Last decompressed bytes */
+}CO_EDS_t;
+
+
+/** Compressed image, defined by the file generated with tools/edszip.py */
+extern const uint8_t CO_EDS_image[];
+
+/** Size of CO_EDS_image in bytes */
+extern const uint32_t CO_EDS_imageSize;
+
+
+/**
+ * Initialize Store EDS and serve OD object 0x1021.
+ *
+ * Function must be called in the communication reset section, after
+ * CO_init().
+ *
+ * @param eds This object will be initialized.
+ * @param SDO SDO server object.
+ * @param image Compressed image, CO_EDS_image.
+ * @param imageSize Size of image, CO_EDS_imageSize.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO, CO_ERROR_ILLEGAL_ARGUMENT or
+ * CO_ERROR_DATA_CORRUPT, if image header is not valid or its window is larger
+ * than #CO_EDS_WINDOW.
+ */
+CO_ReturnError_t CO_EDS_init(CO_EDS_t *eds, CO_SDO_t *SDO, const uint8_t *image, uint32_t imageSize);
+
+/** @} */
+#endif /* CO_EDS_STORE > 0 */
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif
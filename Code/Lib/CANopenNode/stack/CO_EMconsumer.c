@@ -0,0 +1,196 @@
+/*
+ * CANopen Emergency consumer with per-node error state.
+ *
+ * @file        CO_EMconsumer.c
+ * @ingroup     CO_EMconsumer
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * CANopenNode is free and open source software: you can redistribute
+ * it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Following clarification and special exception to the GNU General Public
+ * License is included to the distribution terms of CANopenNode:
+ *
+ * Linking this library statically or dynamically with other modules is
+ * making a combined work based on this library. Thus, the terms and
+ * conditions of the GNU General Public License cover the whole combination.
+ *
+ * As a special exception, the copyright holders of this library give
+ * you permission to link this library with independent modules to
+ * produce an executable, regardless of the license terms of these
+ * independent modules, and to copy and distribute the resulting
+ * executable under terms of your choice, provided that you also meet,
+ * for each linked independent module, the terms and conditions of the
+ * license of that module. An independent module is a module which is
+ * not derived from or based on this library. If you modify this
+ * library, you may extend this exception to your version of the
+ * library, but you are not obliged to do so. If you do not wish
+ * to do so, delete this exception statement from your version.
+ */
+
+
+#include <string.h>
+
+#include "CO_driver.h"
+#include "CO_SDO.h"
+#include "CO_EMconsumer.h"
+
+
+/* Emergency identifier of node-ID 1 */
+#define CO_EMC_CAN_ID           0x081U
+
+
+/*
+ * Read received message from CAN module.
+ *
+ * Function will be called (by CAN receive interrupt) every time, when CAN
+ * message with identifier 0x081 to 0x0FF will be received. Offset is
+ * node-ID - 1.
+ */
+static void CO_EMcons_receive(void *object, const CO_CANrxMsg_t *msg, uint16_t offset){
+    CO_EMconsumer_t *emCons = (CO_EMconsumer_t*)object;
+    uint8_t nodeId = (uint8_t)(offset + 1U);
+
+    if(msg->DLC == 8U){
+        CO_EMconsNode_t *node = &emCons->nodes[nodeId - 1U];
+        uint16_t errorCode = CO_getUint16(&msg->data[0]);
+
+        emCons->rxCount++;
+        if(errorCode != 0U && node->count < 0xFFFFU){
+            node->count++;
+        }
+        if(errorCode != node->errorCode || msg->data[2] != node->errorRegister){
+            emCons->changed[nodeId >> 5] |= 1UL << (nodeId & 0x1FU);
+            if(emCons->pFunctSignal != NULL){
+                emCons->pFunctSignal();
+            }
+        }
+        node->errorCode = errorCode;
+        node->errorRegister = msg->data[2];
+        node->errorBit = msg->data[3];
+        node->infoCode = CO_getUint32(&msg->data[4]);
+    }
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_EMconsumer_init(
+        CO_EMconsumer_t        *emCons,
+        CO_CANmodule_t         *CANdevRx,
+        uint16_t                CANdevRxIdx)
+{
+    /* verify arguments */
+    if(emCons==NULL || CANdevRx==NULL){
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    memset(emCons->nodes, 0, sizeof(emCons->nodes));
+    emCons->changed[0] = 0U;
+    emCons->changed[1] = 0U;
+    emCons->changed[2] = 0U;
+    emCons->changed[3] = 0U;
+    emCons->rxCount = 0U;
+    emCons->pFunctChange = NULL;
+    emCons->functChangeObject = NULL;
+    emCons->pFunctSignal = NULL;
+
+    /* one buffer with mask for all nodes */
+    return CO_CANrxBufferInitRange(
+            CANdevRx,               /* CAN device */
+            CANdevRxIdx,            /* rx buffer index */
+            &emCons->CANrxRange,    /* range, passes offset to receive function */
+            CO_EMC_CAN_ID,          /* CAN identifier of the first node */
+            CO_EM_CONS_NODES,       /* number of identifiers */
+            (void*)emCons,          /* object passed to receive function */
+            CO_EMcons_receive);     /* this function will process received message */
+}
+
+
+/******************************************************************************/
+void CO_EMconsumer_initCallback(
+        CO_EMconsumer_t        *emCons,
+        void                   *object,
+        void                  (*pFunctChange)(void *object, uint8_t nodeId, const CO_EMconsNode_t *node))
+{
+    if(emCons != NULL){
+        emCons->functChangeObject = object;
+        emCons->pFunctChange = pFunctChange;
+    }
+}
+
+
+/******************************************************************************/
+void CO_EMconsumer_initCallbackSignal(
+        CO_EMconsumer_t        *emCons,
+        void                  (*pFunctSignal)(void))
+{
+    if(emCons != NULL){
+        emCons->pFunctSignal = pFunctSignal;
+    }
+}
+
+
+/******************************************************************************/
+bool_t CO_EMconsumer_getNode(
+        CO_EMconsumer_t        *emCons,
+        uint8_t                 nodeId,
+        CO_EMconsNode_t        *node)
+{
+    if(emCons == NULL || node == NULL || nodeId < 1U || nodeId > CO_EM_CONS_NODES){
+        return false;
+    }
+
+    /* receive function writes the entry in CAN receive thread */
+    CO_LOCK_EMCY();
+    *node = emCons->nodes[nodeId - 1U];
+    CO_UNLOCK_EMCY();
+
+    return true;
+}
+
+
+/******************************************************************************/
+void CO_EMconsumer_process(CO_EMconsumer_t *emCons){
+    uint8_t w;
+
+    for(w = 0U; w < 4U; w++){
+        uint32_t changed;
+
+        if(emCons->changed[w] == 0U){
+            continue;
+        }
+        CO_LOCK_EMCY();
+        changed = emCons->changed[w];
+        emCons->changed[w] = 0U;
+        CO_UNLOCK_EMCY();
+
+        while(changed != 0U){
+            uint8_t bit = 0U;
+            uint8_t nodeId;
+            CO_EMconsNode_t node;
+
+            while((changed & (1UL << bit)) == 0U){
+                bit++;
+            }
+            changed &= ~(1UL << bit);
+            nodeId = (uint8_t)((w << 5) + bit);
+
+            if(emCons->pFunctChange != NULL && CO_EMconsumer_getNode(emCons, nodeId, &node)){
+                emCons->pFunctChange(emCons->functChangeObject, nodeId, &node);
+            }
+        }
+    }
+}
@@ -0,0 +1,203 @@
+/**
+ * CANopen Emergency consumer with per-node error state.
+ *
+ * @file        CO_EMconsumer.h
+ * @ingroup     CO_EMconsumer
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * CANopenNode is free and open source software: you can redistribute
+ * it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Following clarification and special exception to the GNU General Public
+ * License is included to the distribution terms of CANopenNode:
+ *
+ * Linking this library statically or dynamically with other modules is
+ * making a combined work based on this library. Thus, the terms and
+ * conditions of the GNU General Public License cover the whole combination.
+ *
+ * As a special exception, the copyright holders of this library give
+ * you permission to link this library with independent modules to
+ * produce an executable, regardless of the license terms of these
+ * independent modules, and to copy and distribute the resulting
+ * executable under terms of your choice, provided that you also meet,
+ * for each linked independent module, the terms and conditions of the
+ * license of that module. An independent module is a module which is
+ * not derived from or based on this library. If you modify this
+ * library, you may extend this exception to your version of the
+ * library, but you are not obliged to do so. If you do not wish
+ * to do so, delete this exception statement from your version.
+ */
+
+
+#ifndef CO_EM_CONSUMER_H
+#define CO_EM_CONSUMER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_EMconsumer Emergency consumer
+ * @ingroup CO_CANopen
+ * @{
+ *
+ * CANopen Emergency consumer for master devices.
+ *
+ * One CAN receive buffer with mask (CO_CANrxBufferInitRange()) accepts
+ * emergency messages of all nodes, identifiers 0x081 to 0x0FF, and passes the
+ * node offset to the receive function. SYNC (0x080) has lower buffer index in
+ * CANopen.c, so receive dispatch gives it to SYNC. Receive function runs in
+ * CAN receive thread and only updates the entry of the node: error code,
+ * error register, manufacturer specific bytes and counter. If error code or
+ * error register has changed, node is marked in a bit field.
+ * CO_EMconsumer_process() then calls the application callback once per
+ * changed node, so work per frame is constant and application does not parse
+ * emergency messages. Several changes of the same node between two calls are
+ * reported once, with the latest state.
+ *
+ * Bytes 3 to 7 are manufacturer specific. CANopenNode devices send error
+ * status bit in byte 3 and 32-bit info code in bytes 4 to 7, they are stored
+ * so.
+ */
+
+
+/**
+ * Highest node-ID monitored by Emergency consumer.
+ */
+#define CO_EM_CONS_NODES        127U
+
+
+/**
+ * Latest emergency state of one node.
+ */
+typedef struct{
+    /** Emergency error code of the latest message, 0 after error reset */
+    uint16_t            errorCode;
+    /** Error register (0x1001) of the node from the latest message */
+    uint8_t             errorRegister;
+    /** Byte 3, error status bit for CANopenNode devices */
+    uint8_t             errorBit;
+    /** Bytes 4 to 7, info code for CANopenNode devices */
+    uint32_t            infoCode;
+    /** Number of messages with error code other than 0, saturates at 0xFFFF */
+    uint16_t            count;
+}CO_EMconsNode_t;
+
+
+/**
+ * Emergency consumer object.
+ */
+typedef struct{
+    /** State of node-ID 1 to CO_EM_CONS_NODES, index is node-ID - 1 */
+    CO_EMconsNode_t     nodes[CO_EM_CONS_NODES];
+    /** Nodes, which changed since CO_EMconsumer_process(), bit per node-ID */
+    volatile uint32_t   changed[4];
+    /** Number of received emergency messages */
+    volatile uint32_t   rxCount;
+    /** From CO_EMconsumer_initCallback() or NULL */
+    void              (*pFunctChange)(void *object, uint8_t nodeId, const CO_EMconsNode_t *node);
+    /** From CO_EMconsumer_initCallback() */
+    void               *functChangeObject;
+    /** From CO_EMconsumer_initCallbackSignal() or NULL */
+    void              (*pFunctSignal)(void);
+    /** Receive buffer for identifiers 0x081 to 0x0FF */
+    CO_CANrxRange_t     CANrxRange;
+}CO_EMconsumer_t;
+
+
+/**
+ * Initialize Emergency consumer object.
+ *
+ * Function must be called in the communication reset section. State of all
+ * nodes is cleared.
+ *
+ * @param emCons This object will be initialized.
+ * @param CANdevRx CAN device for emergency reception.
+ * @param CANdevRxIdx Index of receive buffer in the above CAN device. Must be
+ * higher than index of SYNC receive buffer.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_EMconsumer_init(
+        CO_EMconsumer_t        *emCons,
+        CO_CANmodule_t         *CANdevRx,
+        uint16_t                CANdevRxIdx);
+
+
+/**
+ * Initialize Emergency consumer callback function.
+ *
+ * Function initializes optional callback function, which is called from
+ * CO_EMconsumer_process(), when error code or error register of the node
+ * changes.
+ *
+ * @param emCons This object.
+ * @param object Pointer to object, which will be passed to pFunctChange(). Can be NULL.
+ * @param pFunctChange Pointer to the callback function. Not called if NULL.
+ * _node_ is a copy of the latest state, valid during the call.
+ */
+void CO_EMconsumer_initCallback(
+        CO_EMconsumer_t        *emCons,
+        void                   *object,
+        void                  (*pFunctChange)(void *object, uint8_t nodeId, const CO_EMconsNode_t *node));
+
+
+/**
+ * Initialize Emergency consumer signal function.
+ *
+ * Function initializes optional callback function, which is called from CAN
+ * receive thread, when node state changes. Function may wake up external task,
+ * which calls CO_EMconsumer_process().
+ *
+ * @param emCons This object.
+ * @param pFunctSignal Pointer to the callback function. Not called if NULL.
+ */
+void CO_EMconsumer_initCallbackSignal(
+        CO_EMconsumer_t        *emCons,
+        void                  (*pFunctSignal)(void));
+
+
+/**
+ * Get copy of the latest emergency state of the node.
+ *
+ * @param emCons This object.
+ * @param nodeId Node-ID 1 to #CO_EM_CONS_NODES.
+ * @param node Copy of the state.
+ *
+ * @return False, if nodeId is out of range.
+ */
+bool_t CO_EMconsumer_getNode(
+        CO_EMconsumer_t        *emCons,
+        uint8_t                 nodeId,
+        CO_EMconsNode_t        *node);
+
+
+/**
+ * Process Emergency consumer object.
+ *
+ * Function is called from CO_process(). It calls pFunctChange() for each
+ * node, which changed since the previous call.
+ *
+ * @param emCons This object.
+ */
+void CO_EMconsumer_process(CO_EMconsumer_t *emCons);
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+/** @} */
+#endif
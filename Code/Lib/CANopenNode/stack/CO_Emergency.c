@@ -74,7 +74,12 @@ static CO_SDO_abortCode_t CO_ODF_1003(CO_ODF_arg_t *ODF_arg){
             ret = CO_SDO_AB_NO_DATA;
         }
         else{
-            ret = CO_SDO_AB_NONE;
+            /* subIndex 1 is the newest error, preDefErr is a ring */
+            uint8_t age = ODF_arg->subIndex - 1U;
+            uint8_t i = (emPr->preDefErrHead >= age) ? (emPr->preDefErrHead - age)
+                      : (emPr->preDefErrHead + emPr->preDefErrSize - age);
+
+            CO_memcpy(ODF_arg->data, (uint8_t*)&emPr->preDefErr[i], 4U);
         }
     }
     else{
@@ -140,27 +145,51 @@ CO_ReturnError_t CO_EM_init(
         errorStatusBitsSize<6U || errorRegister==NULL || preDefErr==NULL || CANdev==NULL){
         return CO_ERROR_ILLEGAL_ARGUMENT;
     }
+#if CO_EM_BITSET > 0
+    if(errorStatusBitsSize > (4U * CO_EM_STATUS_WORDS)){
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+#endif
 
     /* Configure object variables */
     em->errorStatusBits         = errorStatusBits;
     em->errorStatusBitsSize     = errorStatusBitsSize;
+#if CO_EM_LOCK_FREE > 0
+    em->bufWrite                = 0U;
+    em->bufRead                 = 0U;
+    em->bufOverflow             = 0U;
+    for(i=0U; i<CO_EM_INTERNAL_BUFFER_SIZE; i++){
+        em->bufReady[i] = 0U;
+    }
+#else
     em->bufEnd                  = em->buf + (CO_EM_INTERNAL_BUFFER_SIZE * 8);
     em->bufWritePtr             = em->buf;
     em->bufReadPtr              = em->buf;
     em->bufFull                 = 0U;
+#endif
     em->wrongErrorReport        = 0U;
     em->pFunctSignal            = NULL;
+#if CO_EM_PRIORITY_QUEUE > 0
+    em->pendingCount            = 0U;
+#endif
     emPr->em                    = em;
     emPr->errorRegister         = errorRegister;
     emPr->preDefErr             = preDefErr;
     emPr->preDefErrSize         = preDefErrSize;
     emPr->preDefErrNoOfErrors   = 0U;
+    emPr->preDefErrHead         = 0U;
     emPr->inhibitEmTimer        = 0U;
 
     /* clear error status bits */
     for(i=0U; i<errorStatusBitsSize; i++){
         em->errorStatusBits[i] = 0U;
     }
+#if CO_EM_BITSET > 0
+    for(i=0U; i<CO_EM_STATUS_WORDS; i++){
+        em->statusWords[i] = 0U;
+    }
+    em->statusChanged = 0U;
+#endif
 
     /* Configure Object dictionary entry at index 0x1003 and 0x1014 */
     CO_OD_configure(SDO, OD_H1003_PREDEF_ERR_FIELD, CO_ODF_1003, (void*)emPr, 0, 0U);
@@ -175,7 +204,7 @@ CO_ReturnError_t CO_EM_init(
             CANidTxEM,          /* CAN identifier */
             0,                  /* rtr */
             8U,                  /* number of data bytes */
-            0);                 /* synchronous message flag bit */
+            CO_CAN_TX_FLAG_CRITICAL); /* EMCY may use reserved mailbox */
 
     return CO_ERROR_NO;
 }
@@ -192,12 +221,245 @@ void CO_EM_initCallback(
 }
 
 
+#if CO_EM_LOCK_FREE > 0
+#define CO_EM_BUF_SLOT(cnt)     ((uint8_t)((cnt) % CO_EM_INTERNAL_BUFFER_SIZE))
+#define CO_EM_BUF_NEXT(cnt)     ((uint8_t)(((cnt) + 1U) % (2U * CO_EM_INTERNAL_BUFFER_SIZE)))
+#endif
+
+
+/*
+ * Write message into internal buffer. Called by producers from any thread.
+ *
+ * @return false, if buffer is full. Overflow is then indicated.
+ */
+static bool_t CO_EM_bufPut(CO_EM_t *em, const uint8_t msg[]){
+#if CO_EM_LOCK_FREE > 0
+    uint8_t cnt;
+
+    /* reserve slot, messages in buffer are counted modulo 2*size */
+    do{
+        cnt = em->bufWrite;
+        if(((cnt + (2U * CO_EM_INTERNAL_BUFFER_SIZE) - em->bufRead) %
+            (2U * CO_EM_INTERNAL_BUFFER_SIZE)) >= CO_EM_INTERNAL_BUFFER_SIZE)
+        {
+            em->bufOverflow = 1U;
+            return false;
+        }
+    }while(!CO_atomicCompareExchange8(&em->bufWrite, cnt, CO_EM_BUF_NEXT(cnt)));
+
+    /* fill slot, then publish it to consumer */
+    CO_memcpy(&em->buf[CO_EM_BUF_SLOT(cnt) * 8U], msg, 8U);
+    CO_MEMORY_BARRIER();
+    em->bufReady[CO_EM_BUF_SLOT(cnt)] = 1U;
+    return true;
+#else
+    bool_t ret = true;
+
+    CO_LOCK_EMCY();
+    if(em->bufFull){
+        /* set overflow */
+        em->bufFull = 2U;
+        ret = false;
+    }
+    else{
+        /* copy data to the buffer, increment writePtr and verify buffer full */
+        CO_memcpy(em->bufWritePtr, msg, 8U);
+        em->bufWritePtr += 8;
+
+        if(em->bufWritePtr == em->bufEnd) em->bufWritePtr = em->buf;
+        if(em->bufWritePtr == em->bufReadPtr) em->bufFull = 1U;
+    }
+    CO_UNLOCK_EMCY();
+    return ret;
+#endif
+}
+
+
+/*
+ * Oldest message in internal buffer or NULL. Called by CO_EM_process().
+ */
+static uint8_t *CO_EM_bufPeek(CO_EM_t *em){
+#if CO_EM_LOCK_FREE > 0
+    uint8_t slot = CO_EM_BUF_SLOT(em->bufRead);
+
+    /* slot may be reserved, but not written yet */
+    if(em->bufRead == em->bufWrite || em->bufReady[slot] == 0U){
+        return NULL;
+    }
+    CO_MEMORY_BARRIER();
+    return &em->buf[slot * 8U];
+#else
+    return (em->bufReadPtr != em->bufWritePtr || em->bufFull) ? em->bufReadPtr : NULL;
+#endif
+}
+
+
+/*
+ * Release oldest message from internal buffer. Called by CO_EM_process().
+ *
+ * @return true, if messages were lost because of full buffer.
+ */
+static bool_t CO_EM_bufPop(CO_EM_t *em){
+#if CO_EM_LOCK_FREE > 0
+    em->bufReady[CO_EM_BUF_SLOT(em->bufRead)] = 0U;
+    CO_MEMORY_BARRIER();
+    em->bufRead = CO_EM_BUF_NEXT(em->bufRead);
+    return (CO_atomicExchange8(&em->bufOverflow, 0U) != 0U) ? true : false;
+#else
+    bool_t overflow;
+
+    CO_LOCK_EMCY();
+    em->bufReadPtr += 8;
+    if(em->bufReadPtr == em->bufEnd){
+        em->bufReadPtr = em->buf;
+    }
+    overflow = (em->bufFull == 2U) ? true : false;
+    em->bufFull = 0U;
+    CO_UNLOCK_EMCY();
+    return overflow;
+#endif
+}
+
+
+#if CO_EM_PRIORITY_QUEUE > 0
+/*
+ * Remove message from pending list, keep order of others.
+ */
+static void CO_EM_pendingRemove(CO_EM_t *em, uint8_t index){
+    em->pendingCount--;
+    for(; index<em->pendingCount; index++){
+        CO_memcpy(em->pending[index], em->pending[index+1U], 8U);
+    }
+}
+
+
+/*
+ * Move messages from internal buffer into pending list. Message with the same
+ * error status bit and the same kind (report or reset) updates the pending one,
+ * newer pending message of opposite kind is then obsolete.
+ */
+static void CO_EM_pendingFill(CO_EM_t *em){
+    const uint8_t *msg;
+    bool_t overflow = false;
+
+    while((msg = CO_EM_bufPeek(em)) != NULL){
+        bool_t reset = (msg[0] == 0U && msg[1] == 0U) ? true : false;
+        uint8_t i, found = em->pendingCount;
+
+        for(i=0U; i<em->pendingCount; i++){
+            const uint8_t *p = em->pending[i];
+            bool_t pReset = (p[0] == 0U && p[1] == 0U) ? true : false;
+
+            if(p[3] == msg[3] && pReset == reset){
+                found = i;
+                break;
+            }
+        }
+
+        if(found < em->pendingCount){
+            for(i=em->pendingCount; i>(found+1U); i--){
+                if(em->pending[i-1U][3] == msg[3]){
+                    CO_EM_pendingRemove(em, i-1U);
+                }
+            }
+        }
+        else if(em->pendingCount >= CO_EM_INTERNAL_BUFFER_SIZE){
+            /* no space, leave the rest in buffer */
+            break;
+        }
+        else{
+            em->pendingCount++;
+        }
+        CO_memcpy(em->pending[found], msg, 8U);
+
+        if(CO_EM_bufPop(em)){
+            overflow = true;
+        }
+    }
+
+    if(overflow){
+        CO_errorReport(em, CO_EM_EMERGENCY_BUFFER_FULL, CO_EMC_GENERIC, 0U);
+    }
+}
+
+
+/*
+ * Index of the next message to send: highest priority, oldest first.
+ */
+static uint8_t CO_EM_pendingNext(CO_EM_t *em){
+    uint8_t i, next = 0U;
+
+    for(i=1U; i<em->pendingCount; i++){
+        if(CO_EM_PRIORITY(em->pending[i][3]) > CO_EM_PRIORITY(em->pending[next][3])){
+            next = i;
+        }
+    }
+    return next;
+}
+#endif
+
+
+#if CO_EM_BITSET > 0
+/*
+ * Set error status bit in the bitset. Called from any thread.
+ *
+ * @return true, if bit was already set.
+ */
+static bool_t CO_EM_statusSet(CO_EM_t *em, const uint8_t errorBit){
+    volatile uint32_t *word = &em->statusWords[errorBit >> 5];
+    uint32_t mask = 1UL << (errorBit & 0x1FU);
+    uint32_t old;
+
+    /* NO_ERROR is never set */
+    if(errorBit == CO_EM_NO_ERROR){
+        return false;
+    }
+#if CO_EM_LOCK_FREE > 0
+    old = CO_atomicFetchOr32(word, mask);
+#else
+    old = *word;
+    *word = old | mask;
+#endif
+    if((old & mask) != 0U){
+        return true;
+    }
+    em->statusChanged = 1U;
+    return false;
+}
+
+
+/*
+ * Clear error status bit in the bitset. Called from any thread.
+ *
+ * @return true, if bit was set.
+ */
+static bool_t CO_EM_statusClear(CO_EM_t *em, const uint8_t errorBit){
+    volatile uint32_t *word = &em->statusWords[errorBit >> 5];
+    uint32_t mask = 1UL << (errorBit & 0x1FU);
+    uint32_t old;
+
+#if CO_EM_LOCK_FREE > 0
+    old = CO_atomicFetchAnd32(word, ~mask);
+#else
+    old = *word;
+    *word = old & ~mask;
+#endif
+    if((old & mask) == 0U){
+        return false;
+    }
+    em->statusChanged = 1U;
+    return true;
+}
+#endif
+
+
 /******************************************************************************/
 void CO_EM_process(
         CO_EMpr_t              *emPr,
         bool_t                  NMTisPreOrOperational,
         uint16_t                timeDifference_100us,
-        uint16_t                emInhTime)
+        uint16_t                emInhTime,
+        uint16_t               *timerNext_ms)
 {
 
     CO_EM_t *em = emPr->em;
@@ -212,6 +474,20 @@ void CO_EM_process(
 
 
     /* calculate Error register */
+#if CO_EM_BITSET > 0
+    /* copy of the bitset in Object Dictionary */
+    if(em->statusChanged != 0U){
+        uint8_t i;
+
+        em->statusChanged = 0U;
+        CO_MEMORY_BARRIER();
+        for(i=0U; i<em->errorStatusBitsSize; i++){
+            em->errorStatusBits[i] = (uint8_t)(em->statusWords[i >> 2] >> ((i & 3U) << 3));
+        }
+    }
+    errorRegister = (((em->statusWords[0] & CO_EM_REG_COMM_MASK0) != 0U) ? CO_ERR_REG_COMM_ERR : 0U)
+                  | (((em->statusWords[1] & CO_EM_REG_GENERIC_MASK1) != 0U) ? CO_ERR_REG_GENERIC_ERR : 0U);
+#else
     errorRegister = 0U;
     /* generic error */
     if(em->errorStatusBits[5]){
@@ -221,6 +497,7 @@ void CO_EM_process(
     if(em->errorStatusBits[2] || em->errorStatusBits[3]){
         errorRegister |= CO_ERR_REG_COMM_ERR;
     }
+#endif
     *emPr->errorRegister = (*emPr->errorRegister & 0xEEU) | errorRegister;
 
     /* inhibit time */
@@ -228,52 +505,84 @@ void CO_EM_process(
         emPr->inhibitEmTimer += timeDifference_100us;
     }
 
-    /* send Emergency message. */
-    if(     NMTisPreOrOperational &&
+#if CO_EM_PRIORITY_QUEUE > 0
+    CO_EM_pendingFill(em);
+#endif
+
+    /* send Emergency messages, as many as inhibit time and CAN buffer allow:
+     * all queued with zero inhibit time, else one per inhibit time. */
+    while(  NMTisPreOrOperational &&
             !emPr->CANtxBuff->bufferFull &&
-            emPr->inhibitEmTimer >= emInhTime &&
-            (em->bufReadPtr != em->bufWritePtr || em->bufFull))
+            emPr->inhibitEmTimer >= emInhTime)
     {
+        uint8_t *msg;
         uint32_t preDEF;    /* preDefinedErrorField */
-        
+#if CO_EM_PRIORITY_QUEUE > 0
+        uint8_t next;
+
+        if(em->pendingCount == 0U){
+            break;
+        }
+        next = CO_EM_pendingNext(em);
+        msg = em->pending[next];
+#else
+        msg = CO_EM_bufPeek(em);
+        if(msg == NULL){
+            break;
+        }
+#endif
+
         /* add error register */
-        em->bufReadPtr[2] = *emPr->errorRegister;
+        msg[2] = *emPr->errorRegister;
 
         /* copy data to CAN emergency message */
-        CO_memcpy(emPr->CANtxBuff->data, em->bufReadPtr, 8U);
-        CO_memcpy((uint8_t*)&preDEF, em->bufReadPtr, 4U);
-        em->bufReadPtr += 8;
-
-        /* Update read buffer pointer and reset inhibit timer */
-        if(em->bufReadPtr == em->bufEnd){
-            em->bufReadPtr = em->buf;
-        }
+        CO_memcpy(emPr->CANtxBuff->data, msg, 8U);
+        CO_memcpy((uint8_t*)&preDEF, msg, 4U);
         emPr->inhibitEmTimer = 0U;
 
-        /* verify message buffer overflow, then clear full flag */
-        if(em->bufFull == 2U){
-            em->bufFull = 0U;    /* will be updated below */
+        /* release message, verify message buffer overflow */
+#if CO_EM_PRIORITY_QUEUE > 0
+        CO_EM_pendingRemove(em, next);
+        CO_EM_pendingFill(em);
+#else
+        if(CO_EM_bufPop(em)){
             CO_errorReport(em, CO_EM_EMERGENCY_BUFFER_FULL, CO_EMC_GENERIC, 0U);
         }
-        else{
-            em->bufFull = 0;
-        }
+#endif
 
-        /* write to 'pre-defined error field' (object dictionary, index 0x1003) */
-        if(emPr->preDefErr){
-            uint8_t i;
+        /* write to 'pre-defined error field' (object dictionary, index 0x1003),
+         * newest error overwrites the oldest one in the ring */
+        if(emPr->preDefErrSize > 0U){
+            uint8_t head = emPr->preDefErrHead + 1U;
 
-            if(emPr->preDefErrNoOfErrors < emPr->preDefErrSize)
+            if(head >= emPr->preDefErrSize){
+                head = 0U;
+            }
+            emPr->preDefErr[head] = preDEF;
+            emPr->preDefErrHead = head;
+            if(emPr->preDefErrNoOfErrors < emPr->preDefErrSize){
                 emPr->preDefErrNoOfErrors++;
-            for(i=emPr->preDefErrNoOfErrors-1; i>0; i--)
-                emPr->preDefErr[i] = emPr->preDefErr[i-1];
-            emPr->preDefErr[0] = preDEF;
+            }
         }
 
         /* send CAN message */
         CO_CANsend(emPr->CANdev, emPr->CANtxBuff);
     }
 
+    /* Calculate, when next Emergency may be send and lower timerNext_ms if necessary. */
+    if(timerNext_ms != NULL && emPr->inhibitEmTimer < emInhTime &&
+#if CO_EM_PRIORITY_QUEUE > 0
+            em->pendingCount > 0U)
+#else
+            CO_EM_bufPeek(em) != NULL)
+#endif
+    {
+        uint16_t diff = (emInhTime - emPr->inhibitEmTimer + 9U) / 10U;
+        if(*timerNext_ms > diff){
+            *timerNext_ms = diff;
+        }
+    }
+
     return;
 }
 
@@ -281,8 +590,10 @@ void CO_EM_process(
 /******************************************************************************/
 void CO_errorReport(CO_EM_t *em, const uint8_t errorBit, const uint16_t errorCode, const uint32_t infoCode){
     uint8_t index = errorBit >> 3;
+#if CO_EM_BITSET == 0
     uint8_t bitmask = 1 << (errorBit & 0x7);
     uint8_t *errorStatusBits = 0;
+#endif
     bool_t sendEmergency = true;
 
     if(em == NULL){
@@ -293,43 +604,49 @@ void CO_errorReport(CO_EM_t *em, const uint8_t errorBit, const uint16_t errorCod
         em->wrongErrorReport = errorBit;
         sendEmergency = false;
     }
+#if CO_EM_BITSET > 0
+    /* set error bit (any error except NO_ERROR), if error was already
+     * reported, do nothing */
+    else if(CO_EM_statusSet(em, errorBit)){
+        sendEmergency = false;
+    }
+#else
     else{
         errorStatusBits = &em->errorStatusBits[index];
+#if CO_EM_LOCK_FREE > 0
+        /* set error bit (any error except NO_ERROR), if error was already
+         * reported, do nothing */
+        if(errorBit && (CO_atomicFetchOr8(errorStatusBits, bitmask) & bitmask) != 0){
+            sendEmergency = false;
+        }
+#else
         /* if error was already reported, do nothing */
         if((*errorStatusBits & bitmask) != 0){
             sendEmergency = false;
         }
+#endif
     }
+#endif
 
     if(sendEmergency){
+        uint8_t bufCopy[8];
+
+#if (CO_EM_LOCK_FREE == 0) && (CO_EM_BITSET == 0)
         /* set error bit */
         if(errorBit){
             /* any error except NO_ERROR */
             *errorStatusBits |= bitmask;
         }
+#endif
 
-        /* verify buffer full, set overflow */
-        if(em->bufFull){
-            em->bufFull = 2;
-        }
-        else{
-            uint8_t bufCopy[8];
-
-            /* prepare data for emergency message */
-            CO_memcpySwap2(&bufCopy[0], &errorCode);
-            bufCopy[2] = 0; /* error register will be set later */
-            bufCopy[3] = errorBit;
-            CO_memcpySwap4(&bufCopy[4], &infoCode);
-
-            /* copy data to the buffer, increment writePtr and verify buffer full */
-            CO_LOCK_EMCY();
-            CO_memcpy(em->bufWritePtr, &bufCopy[0], 8);
-            em->bufWritePtr += 8;
-
-            if(em->bufWritePtr == em->bufEnd) em->bufWritePtr = em->buf;
-            if(em->bufWritePtr == em->bufReadPtr) em->bufFull = 1;
-            CO_UNLOCK_EMCY();
+        /* prepare data for emergency message */
+        CO_memcpySwap2(&bufCopy[0], &errorCode);
+        bufCopy[2] = 0; /* error register will be set later */
+        bufCopy[3] = errorBit;
+        CO_memcpySwap4(&bufCopy[4], &infoCode);
 
+        /* copy data to the buffer, set overflow if full */
+        if(CO_EM_bufPut(em, bufCopy)){
             /* Optional signal to RTOS, which can resume task, which handles CO_EM_process */
             if(em->pFunctSignal != NULL) {
                 em->pFunctSignal();
@@ -342,8 +659,10 @@ void CO_errorReport(CO_EM_t *em, const uint8_t errorBit, const uint16_t errorCod
 /******************************************************************************/
 void CO_errorReset(CO_EM_t *em, const uint8_t errorBit, const uint32_t infoCode){
     uint8_t index = errorBit >> 3;
+#if CO_EM_BITSET == 0
     uint8_t bitmask = 1 << (errorBit & 0x7);
     uint8_t *errorStatusBits = 0;
+#endif
     bool_t sendEmergency = true;
 
     if(em == NULL){
@@ -354,41 +673,45 @@ void CO_errorReset(CO_EM_t *em, const uint8_t errorBit, const uint32_t infoCode)
         em->wrongErrorReport = errorBit;
         sendEmergency = false;
     }
+#if CO_EM_BITSET > 0
+    /* erase error bit, if error was allready cleared, do nothing */
+    else if(!CO_EM_statusClear(em, errorBit)){
+        sendEmergency = false;
+    }
+#else
     else{
         errorStatusBits = &em->errorStatusBits[index];
+#if CO_EM_LOCK_FREE > 0
+        /* erase error bit, if error was allready cleared, do nothing */
+        if((CO_atomicFetchAnd8(errorStatusBits, (uint8_t)~bitmask) & bitmask) == 0){
+            sendEmergency = false;
+        }
+#else
         /* if error was allready cleared, do nothing */
         if((*errorStatusBits & bitmask) == 0){
             sendEmergency = false;
         }
+#endif
     }
+#endif
 
     if(sendEmergency){
+        uint8_t bufCopy[8];
+
+#if (CO_EM_LOCK_FREE == 0) && (CO_EM_BITSET == 0)
         /* erase error bit */
         *errorStatusBits &= ~bitmask;
+#endif
 
-        /* verify buffer full */
-        if(em->bufFull){
-            em->bufFull = 2;
-        }
-        else{
-            uint8_t bufCopy[8];
-
-            /* prepare data for emergency message */
-            bufCopy[0] = 0;
-            bufCopy[1] = 0;
-            bufCopy[2] = 0; /* error register will be set later */
-            bufCopy[3] = errorBit;
-            CO_memcpySwap4(&bufCopy[4], &infoCode);
-
-            /* copy data to the buffer, increment writePtr and verify buffer full */
-            CO_LOCK_EMCY();
-            CO_memcpy(em->bufWritePtr, &bufCopy[0], 8);
-            em->bufWritePtr += 8;
-
-            if(em->bufWritePtr == em->bufEnd) em->bufWritePtr = em->buf;
-            if(em->bufWritePtr == em->bufReadPtr) em->bufFull = 1;
-            CO_UNLOCK_EMCY();
+        /* prepare data for emergency message */
+        bufCopy[0] = 0;
+        bufCopy[1] = 0;
+        bufCopy[2] = 0; /* error register will be set later */
+        bufCopy[3] = errorBit;
+        CO_memcpySwap4(&bufCopy[4], &infoCode);
 
+        /* copy data to the buffer, set overflow if full */
+        if(CO_EM_bufPut(em, bufCopy)){
             /* Optional signal to RTOS, which can resume task, which handles CO_EM_process */
             if(em->pFunctSignal != NULL) {
                 em->pFunctSignal();
@@ -401,14 +724,24 @@ void CO_errorReset(CO_EM_t *em, const uint8_t errorBit, const uint32_t infoCode)
 /******************************************************************************/
 bool_t CO_isError(CO_EM_t *em, const uint8_t errorBit){
     uint8_t index = errorBit >> 3;
+#if CO_EM_BITSET == 0
     uint8_t bitmask = 1 << (errorBit & 0x7);
+#endif
     bool_t ret = false;
 
+#if CO_EM_BITSET > 0
+    if(em != NULL && index < em->errorStatusBitsSize){
+        if(((em->statusWords[errorBit >> 5] >> (errorBit & 0x1FU)) & 1U) != 0U){
+            ret = true;
+        }
+    }
+#else
     if(em != NULL && index < em->errorStatusBitsSize){
         if((em->errorStatusBits[index] & bitmask) != 0){
             ret = true;
         }
     }
+#endif
 
     return ret;
 }
@@ -224,7 +224,7 @@ typedef enum{
 #define CO_EM_CAN_RXB_OVERFLOW          0x13U /**< 0x13, communication, critical, CAN module receive buffer has overflowed */
 #define CO_EM_CAN_TX_OVERFLOW           0x14U /**< 0x14, communication, critical, CAN transmit buffer has overflowed */
 #define CO_EM_TPDO_OUTSIDE_WINDOW       0x15U /**< 0x15, communication, critical, TPDO is outside SYNC window */
-#define CO_EM_16_unused                 0x16U /**< 0x16, (unused) */
+#define CO_EM_CAN_RX_STORM              0x16U /**< 0x16, communication, critical, Received identifier exceeded its rate and was blocked */
 #define CO_EM_17_unused                 0x17U /**< 0x17, (unused) */
 #define CO_EM_SYNC_TIME_OUT             0x18U /**< 0x18, communication, critical, SYNC message timeout */
 #define CO_EM_SYNC_LENGTH               0x19U /**< 0x19, communication, critical, Unexpected SYNC data length */
@@ -265,6 +265,34 @@ typedef enum{
 #define CO_EM_INTERNAL_BUFFER_SIZE      10
 
 
+/**
+ * Priority of emergency message for CO_EM_PRIORITY_QUEUE, higher is sent first.
+ * Default: critical error status bits are 1, informative are 0. Reset of error
+ * has the same priority as report.
+ */
+#ifndef CO_EM_PRIORITY
+#define CO_EM_PRIORITY(errorBit) \
+    ((((errorBit) >= 0x10U && (errorBit) <= 0x1FU) || \
+      ((errorBit) >= 0x28U && (errorBit) <= 0x2FU)) ? 1U : 0U)
+#endif
+
+
+/**
+ * Number of 32-bit words of error status bitset, see CO_EM_BITSET. Default
+ * covers all error status bits 0x00 to 0xFF.
+ */
+#ifndef CO_EM_STATUS_WORDS
+#define CO_EM_STATUS_WORDS              8U
+#endif
+
+/**
+ * Error status bits, which set bits of the error register, as masks of the
+ * first two words of the bitset, see CO_EM_BITSET.
+ */
+#define CO_EM_REG_COMM_MASK0            0xFFFF0000UL /**< 0x10..0x1F: CO_ERR_REG_COMM_ERR */
+#define CO_EM_REG_GENERIC_MASK1         0x0000FF00UL /**< 0x28..0x2F: CO_ERR_REG_GENERIC_ERR */
+
+
 /**
  * Emergerncy object for CO_errorReport(). It contains error buffer, to which new emergency
  * messages are written, when CO_errorReport() is called. This object is included in
@@ -273,14 +301,35 @@ typedef enum{
 typedef struct{
     uint8_t            *errorStatusBits;/**< From CO_EM_init() */
     uint8_t             errorStatusBitsSize;/**< From CO_EM_init() */
+#if CO_EM_BITSET > 0
+    /** Error status bits, bit n of the bitset is bit (n % 32) of word n / 32.
+     * errorStatusBits is a copy, updated by CO_EM_process(). */
+    volatile uint32_t   statusWords[CO_EM_STATUS_WORDS];
+    /** statusWords were changed since the last copy */
+    volatile uint8_t    statusChanged;
+#endif
     /** Internal buffer for storing unsent emergency messages.*/
     uint8_t             buf[CO_EM_INTERNAL_BUFFER_SIZE * 8];
+#if CO_EM_LOCK_FREE > 0
+    /** Reserve counter of producers, 0 to 2*CO_EM_INTERNAL_BUFFER_SIZE-1 */
+    volatile uint8_t    bufWrite;
+    volatile uint8_t    bufRead;        /**< Read counter of CO_EM_process(), same range */
+    /** Message in slot is written completely */
+    volatile uint8_t    bufReady[CO_EM_INTERNAL_BUFFER_SIZE];
+    volatile uint8_t    bufOverflow;    /**< Message was lost, because buffer was full */
+#else
     uint8_t            *bufEnd;         /**< End+1 address of the above buffer */
     uint8_t            *bufWritePtr;    /**< Write pointer in the above buffer */
     uint8_t            *bufReadPtr;     /**< Read pointer in the above buffer */
     uint8_t             bufFull;        /**< True if above buffer is full */
+#endif
     uint8_t             wrongErrorReport;/**< Error in arguments to CO_errorReport() */
     void              (*pFunctSignal)(void);/**< From CO_EM_initCallback() or NULL */
+#if CO_EM_PRIORITY_QUEUE > 0
+    /** Messages moved from buf by CO_EM_process(), in order of arrival */
+    uint8_t             pending[CO_EM_INTERNAL_BUFFER_SIZE][8];
+    uint8_t             pendingCount;   /**< Number of messages in pending */
+#endif
 }CO_EM_t;
 
 
@@ -346,9 +395,12 @@ bool_t CO_isError(CO_EM_t *em, const uint8_t errorBit);
  */
 typedef struct{
     uint8_t            *errorRegister;  /**< From CO_EM_init() */
-    uint32_t           *preDefErr;      /**< From CO_EM_init() */
+    /** From CO_EM_init(). Ring, the newest error is at preDefErrHead, older
+     * ones at lower indexes. CO_ODF_1003() returns them in CANopen order. */
+    uint32_t           *preDefErr;
     uint8_t             preDefErrSize;  /**< From CO_EM_init() */
     uint8_t             preDefErrNoOfErrors;/**< Number of active errors in preDefErr */
+    uint8_t             preDefErrHead;  /**< Index of the newest error in preDefErr */
     uint16_t            inhibitEmTimer; /**< Internal timer for emergency message */
     CO_EM_t            *em;             /**< CO_EM_t sub object is included here */
     CO_CANmodule_t     *CANdev;         /**< From CO_EM_init() */
@@ -367,7 +419,8 @@ typedef struct{
  * @param SDO SDO server object.
  * @param errorStatusBits Pointer to _Error Status Bits_ array from Object Dictionary
  * (manufacturer specific section). See @ref CO_EM_errorStatusBits.
- * @param errorStatusBitsSize Total size of the above array. Must be >= 6.
+ * @param errorStatusBitsSize Total size of the above array. Must be >= 6 and,
+ * with CO_EM_BITSET, <= 4 * CO_EM_STATUS_WORDS.
  * @param errorRegister Pointer to _Error Register_ (Object dictionary, index 0x1001).
  * @param preDefErr Pointer to _Pre defined error field_ array from Object
  * dictionary, index 0x1003.
@@ -411,19 +464,23 @@ void CO_EM_initCallback(
  * Process Error control and Emergency object.
  *
  * Function must be called cyclically. It verifies some communication errors,
- * calculates bit 0 and bit 4 from _Error register_ and sends emergency message
- * if necessary.
+ * calculates bit 0 and bit 4 from _Error register_ and sends emergency messages
+ * if necessary. With zero _Inhibit time EMCY_ all queued messages are sent in
+ * one call, while CAN transmit buffer is free. Otherwise one message is sent
+ * per inhibit time.
  *
  * @param emPr This object.
  * @param NMTisPreOrOperational True if this node is NMT_PRE_OPERATIONAL or NMT_OPERATIONAL.
  * @param timeDifference_100us Time difference from previous function call in [100 * microseconds].
  * @param emInhTime _Inhibit time EMCY_ (object dictionary, index 0x1015).
+ * @param timerNext_ms Return value - info to OS - see CO_process().
  */
 void CO_EM_process(
         CO_EMpr_t              *emPr,
         bool_t                  NMTisPreOrOperational,
         uint16_t                timeDifference_100us,
-        uint16_t                emInhTime);
+        uint16_t                emInhTime,
+        uint16_t               *timerNext_ms);
 
 
 #endif
@@ -50,6 +50,17 @@
 #include "CO_NMT_Heartbeat.h"
 #include "CO_HBconsumer.h"
 
+#if CO_HB_TIMER_WHEEL > 0
+#if CO_HB_WHEEL_SIZE > 128U || (CO_HB_WHEEL_SIZE & (CO_HB_WHEEL_SIZE - 1U)) != 0U
+#error CO_HB_WHEEL_SIZE must be power of 2, 128 or less
+#endif
+#if CO_HB_EVENT_QUEUE_SIZE > 256U || (CO_HB_EVENT_QUEUE_SIZE & (CO_HB_EVENT_QUEUE_SIZE - 1U)) != 0U
+#error CO_HB_EVENT_QUEUE_SIZE must be power of 2, 256 or less
+#endif
+
+#define CO_HB_SLOT(time_ms)     ((uint8_t)((time_ms) & (CO_HB_WHEEL_SIZE - 1U)))
+#endif
+
 /*
  * Read received message from CAN module.
  *
@@ -65,9 +76,113 @@ static void CO_HBcons_receive(void *object, const CO_CANrxMsg_t *msg){
 
     /* verify message length */
     if(msg->DLC == 1){
+#if CO_HB_TIMER_WHEEL > 0
+        CO_HBconsumer_t *HBcons = (CO_HBconsumer_t*) HBconsNode->HBcons;
+        uint8_t NMTstate = msg->data[0];
+        bool_t changed = (NMTstate != HBconsNode->NMTstate || NMTstate == 0U ||
+                          !HBconsNode->monStarted) ? true : false;
+
+        /* reschedule node: its deadline is calculated from reception time */
+        HBconsNode->rxTime_ms = HBcons->now_ms;
+        HBconsNode->NMTstate = NMTstate;
+        HBconsNode->CANrxNew = true;
+
+        /* pass state change to CO_HBconsumer_process(), node is queued once */
+        if(changed && !HBconsNode->eventPending && HBconsNode->time != 0U){
+            HBconsNode->eventPending = true;
+            HBcons->events[HBcons->eventHead & (CO_HB_EVENT_QUEUE_SIZE - 1U)] = HBconsNode->index;
+            CO_MEMORY_BARRIER();
+            HBcons->eventHead++;
+        }
+#else
         /* copy data and set 'new message' flag. */
         HBconsNode->NMTstate = msg->data[0];
         HBconsNode->CANrxNew = true;
+#endif
+    }
+}
+
+
+#if CO_HB_CONS_RANGE > 0
+/*
+ * Read received message from common receive buffer of all heartbeats.
+ *
+ * Offset is node ID of the sender, message is passed to its monitored node.
+ */
+static void CO_HBcons_receiveRange(void *object, const CO_CANrxMsg_t *msg, uint16_t offset){
+    CO_HBconsumer_t *HBcons = (CO_HBconsumer_t*) object;
+    uint8_t idx = HBcons->nodeIndex[offset & 0x7FU];
+
+    if(idx < HBcons->numberOfMonitoredNodes){
+        CO_HBcons_receive((void*)&HBcons->monitoredNodes[idx], msg);
+    }
+}
+#endif
+
+
+#if CO_HB_TIMER_WHEEL > 0
+/*
+ * Put node into timer wheel slot of its deadline.
+ */
+static void CO_HBcons_wheelInsert(CO_HBconsumer_t *HBcons, CO_HBconsNode_t *node, uint32_t deadline_ms){
+    uint8_t slot = CO_HB_SLOT(deadline_ms);
+
+    node->wheelSlot = slot;
+    node->wheelNext = HBcons->wheel[slot];
+    HBcons->wheel[slot] = node->index;
+}
+
+
+/*
+ * Remove node from timer wheel, if it is there.
+ */
+static void CO_HBcons_wheelRemove(CO_HBconsumer_t *HBcons, CO_HBconsNode_t *node){
+    if(node->wheelSlot != CO_HB_NODE_NONE){
+        uint8_t *link = &HBcons->wheel[node->wheelSlot];
+
+        while(*link != CO_HB_NODE_NONE){
+            if(*link == node->index){
+                *link = node->wheelNext;
+                break;
+            }
+            link = &HBcons->monitoredNodes[*link].wheelNext;
+        }
+        node->wheelSlot = CO_HB_NODE_NONE;
+        node->wheelNext = CO_HB_NODE_NONE;
+    }
+}
+#endif
+
+
+/*
+ * Update processed NMT state of monitored node, count and bitmap of operational
+ * nodes and inform application about the change.
+ */
+static void CO_HBcons_setState(
+        CO_HBconsumer_t        *HBcons,
+        CO_HBconsNode_t        *node,
+        uint8_t                 NMTstate,
+        CO_HBconsumer_event_t   event)
+{
+    uint8_t NMTstatePrev = node->NMTstateSeen;
+    uint32_t bit = 1UL << (node->nodeId & 0x1FU);
+    uint8_t word = (node->nodeId >> 5) & 0x03U;
+
+    if(NMTstatePrev == (uint8_t)CO_NMT_OPERATIONAL){
+        HBcons->operationalCount--;
+        HBcons->operationalNodes[word] &= ~bit;
+    }
+    if(NMTstate == (uint8_t)CO_NMT_OPERATIONAL){
+        HBcons->operationalCount++;
+        HBcons->operationalNodes[word] |= bit;
+    }
+    node->NMTstateSeen = NMTstate;
+
+    if(HBcons->pFunctChanged != NULL && node->nodeId != 0U &&
+       (NMTstate != NMTstatePrev || event == CO_HBCONS_BOOTUP))
+    {
+        HBcons->pFunctChanged(HBcons->functChangedObject, node->nodeId,
+                              (uint8_t)(node - HBcons->monitoredNodes), event, NMTstate);
     }
 }
 
@@ -88,6 +203,19 @@ static void CO_HBcons_monitoredNodeConfig(
 
     NodeID = (uint16_t)((HBconsTime>>16)&0xFF);
     monitoredNode = &HBcons->monitoredNodes[idx];
+#if CO_HB_TIMER_WHEEL > 0
+    /* stop monitoring of previous configuration */
+    CO_HBcons_wheelRemove(HBcons, monitoredNode);
+#endif
+    if(monitoredNode->time != 0U){
+        CO_HBcons_setState(HBcons, monitoredNode, 0U, CO_HBCONS_STATE_CHANGED);
+        HBcons->monitoredCount--;
+    }
+#if CO_HB_CONS_RANGE > 0
+    if(monitoredNode->nodeId != 0U){
+        HBcons->nodeIndex[monitoredNode->nodeId & 0x7FU] = CO_HB_NODE_NONE;
+    }
+#endif
     monitoredNode->time = (uint16_t)HBconsTime;
     monitoredNode->NMTstate = 0;
     monitoredNode->monStarted = false;
@@ -100,7 +228,18 @@ static void CO_HBcons_monitoredNodeConfig(
         COB_ID = 0;
         monitoredNode->time = 0;
     }
+    monitoredNode->nodeId = (monitoredNode->time != 0U) ? (uint8_t)NodeID : 0U;
+    if(monitoredNode->time != 0U){
+        HBcons->monitoredCount++;
+    }
 
+#if CO_HB_CONS_RANGE > 0
+    /* common receive buffer passes messages from this node ID to this node */
+    (void)COB_ID;
+    if(monitoredNode->nodeId != 0U){
+        HBcons->nodeIndex[monitoredNode->nodeId & 0x7FU] = idx;
+    }
+#else
     /* configure Heartbeat consumer CAN reception */
     CO_CANrxBufferInit(
             HBcons->CANdevRx,
@@ -110,6 +249,7 @@ static void CO_HBcons_monitoredNodeConfig(
             0,
             (void*)&HBcons->monitoredNodes[idx],
             CO_HBcons_receive);
+#endif
 }
 
 
@@ -190,6 +330,59 @@ CO_ReturnError_t CO_HBconsumer_init(
     HBcons->allMonitoredOperational = 0;
     HBcons->CANdevRx = CANdevRx;
     HBcons->CANdevRxIdxStart = CANdevRxIdxStart;
+    HBcons->monitoredCount = 0U;
+    HBcons->operationalCount = 0U;
+    HBcons->pFunctChanged = NULL;
+    HBcons->functChangedObject = NULL;
+    for(i=0U; i<4U; i++){
+        HBcons->operationalNodes[i] = 0U;
+    }
+    for(i=0U; i<numberOfMonitoredNodes; i++){
+        monitoredNodes[i].time = 0U;
+        monitoredNodes[i].nodeId = 0U;
+        monitoredNodes[i].NMTstateSeen = 0U;
+    }
+#if CO_HB_TIMER_WHEEL > 0
+    if(numberOfMonitoredNodes >= CO_HB_EVENT_QUEUE_SIZE){
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+    HBcons->now_ms = 0U;
+    for(i=0U; i<CO_HB_WHEEL_SIZE; i++){
+        HBcons->wheel[i] = CO_HB_NODE_NONE;
+    }
+    HBcons->eventHead = 0U;
+    HBcons->eventTail = 0U;
+    HBcons->NMTwasPreOrOperational = false;
+    for(i=0U; i<numberOfMonitoredNodes; i++){
+        CO_HBconsNode_t *node = &monitoredNodes[i];
+
+        node->HBcons = (void*)HBcons;
+        node->index = i;
+        node->eventPending = false;
+        node->CANrxNew = false;
+        node->wheelSlot = CO_HB_NODE_NONE;
+        node->wheelNext = CO_HB_NODE_NONE;
+    }
+#endif
+#if CO_HB_CONS_RANGE > 0
+    for(i=0U; i<128U; i++){
+        HBcons->nodeIndex[i] = CO_HB_NODE_NONE;
+    }
+    if(numberOfMonitoredNodes > 0U){
+        CO_ReturnError_t err = CO_CANrxBufferInitRange(
+                CANdevRx,
+                CANdevRxIdxStart,
+                &HBcons->CANrxRange,
+                0x700,
+                128,
+                (void*)HBcons,
+                CO_HBcons_receiveRange);
+
+        if(err != CO_ERROR_NO){
+            return err;
+        }
+    }
+#endif
 
     for(i=0; i<HBcons->numberOfMonitoredNodes; i++)
         CO_HBcons_monitoredNodeConfig(HBcons, i, HBcons->HBconsTime[i]);
@@ -201,11 +394,148 @@ CO_ReturnError_t CO_HBconsumer_init(
 }
 
 
+/******************************************************************************/
+void CO_HBconsumer_initCallback(
+        CO_HBconsumer_t        *HBcons,
+        void                   *object,
+        void                  (*pFunctChanged)(void *object, uint8_t nodeId, uint8_t idx,
+                                               CO_HBconsumer_event_t event, uint8_t NMTstate))
+{
+    if(HBcons != NULL){
+        HBcons->functChangedObject = object;
+        HBcons->pFunctChanged = pFunctChanged;
+    }
+}
+
+
+/******************************************************************************/
+bool_t CO_HBconsumer_allOperational(
+        const CO_HBconsumer_t  *HBcons,
+        const uint32_t          mask[4])
+{
+    uint8_t i;
+
+    for(i=0U; i<4U; i++){
+        if((HBcons->operationalNodes[i] & mask[i]) != mask[i]){
+            return false;
+        }
+    }
+    return true;
+}
+
+
+#if CO_HB_TIMER_WHEEL > 0
+/******************************************************************************/
+void CO_HBconsumer_process(
+        CO_HBconsumer_t        *HBcons,
+        bool_t                  NMTisPreOrOperational,
+        uint16_t                timeDifference_ms,
+        uint16_t               *timerNext_ms)
+{
+    uint8_t i;
+    uint32_t now_ms, ticks;
+
+    if(!NMTisPreOrOperational){
+        /* not in (pre)operational state, stop all monitoring once */
+        if(HBcons->NMTwasPreOrOperational){
+            for(i=0U; i<HBcons->numberOfMonitoredNodes; i++){
+                CO_HBconsNode_t *node = &HBcons->monitoredNodes[i];
+
+                CO_HBcons_wheelRemove(HBcons, node);
+                CO_HBcons_setState(HBcons, node, 0U, CO_HBCONS_STATE_CHANGED);
+                node->NMTstate = 0;
+                node->CANrxNew = false;
+                node->monStarted = false;
+            }
+            HBcons->NMTwasPreOrOperational = false;
+        }
+        HBcons->allMonitoredOperational = 0;
+        return;
+    }
+    HBcons->NMTwasPreOrOperational = true;
+
+    /* process nodes with changed NMT state */
+    while(HBcons->eventTail != HBcons->eventHead){
+        CO_HBconsNode_t *node;
+        CO_HBconsumer_event_t event;
+
+        CO_MEMORY_BARRIER();
+        node = &HBcons->monitoredNodes[HBcons->events[HBcons->eventTail & (CO_HB_EVENT_QUEUE_SIZE - 1U)]];
+        HBcons->eventTail++;
+        node->eventPending = false;
+        node->CANrxNew = false;
+
+        if(node->time == 0U){
+            continue;
+        }
+        event = CO_HBCONS_STATE_CHANGED;
+        if(node->NMTstate != 0U){
+            /* not a bootup message, start monitoring */
+            node->monStarted = true;
+            if(node->wheelSlot == CO_HB_NODE_NONE){
+                CO_HBcons_wheelInsert(HBcons, node, node->rxTime_ms + node->time);
+            }
+        }
+        else if(node->monStarted){
+            /* there was a bootup message */
+            CO_errorReport(HBcons->em, CO_EM_HB_CONSUMER_REMOTE_RESET, CO_EMC_HEARTBEAT, node->index);
+            event = CO_HBCONS_BOOTUP;
+        }
+        CO_HBcons_setState(HBcons, node, node->NMTstate, event);
+    }
+
+    /* verify deadlines in expired slots, all slots after long pause */
+    now_ms = HBcons->now_ms;
+    ticks = (timeDifference_ms < CO_HB_WHEEL_SIZE) ? timeDifference_ms : CO_HB_WHEEL_SIZE;
+    HBcons->now_ms = now_ms + timeDifference_ms;
+    now_ms += timeDifference_ms - ticks;
+    for(; ticks > 0U; ticks--){
+        uint8_t slot = CO_HB_SLOT(++now_ms);
+        uint8_t idx = HBcons->wheel[slot];
+
+        HBcons->wheel[slot] = CO_HB_NODE_NONE;
+        while(idx != CO_HB_NODE_NONE){
+            CO_HBconsNode_t *node = &HBcons->monitoredNodes[idx];
+            uint32_t deadline_ms = node->rxTime_ms + node->time;
+
+            idx = node->wheelNext;
+            node->wheelSlot = CO_HB_NODE_NONE;
+            node->wheelNext = CO_HB_NODE_NONE;
+            if((int32_t)(deadline_ms - HBcons->now_ms) > 0){
+                /* heartbeat was received, deadline is later */
+                CO_HBcons_wheelInsert(HBcons, node, deadline_ms);
+            }
+            else{
+                /* timeout, node is scheduled again by next reception */
+                CO_errorReport(HBcons->em, CO_EM_HEARTBEAT_CONSUMER, CO_EMC_HEARTBEAT, node->index);
+                node->NMTstate = 0;
+                CO_HBcons_setState(HBcons, node, 0U, CO_HBCONS_TIMEOUT);
+            }
+        }
+    }
+
+    /* Calculate, when the next slot expires and lower timerNext_ms if necessary. */
+    if(timerNext_ms != NULL){
+        uint16_t diff;
+
+        for(diff=1U; diff<*timerNext_ms && diff<=CO_HB_WHEEL_SIZE; diff++){
+            if(HBcons->wheel[CO_HB_SLOT(HBcons->now_ms + diff)] != CO_HB_NODE_NONE){
+                *timerNext_ms = diff;
+                break;
+            }
+        }
+    }
+
+    HBcons->allMonitoredOperational =
+        (HBcons->operationalCount == HBcons->monitoredCount) ? 5U : 0U;
+}
+#else
 /******************************************************************************/
 void CO_HBconsumer_process(
         CO_HBconsumer_t        *HBcons,
         bool_t                  NMTisPreOrOperational,
-        uint16_t                timeDifference_ms)
+        uint16_t                timeDifference_ms,
+        uint16_t               *timerNext_ms)
 {
     uint8_t i;
     uint8_t AllMonitoredOperationalCopy;
@@ -217,6 +547,8 @@ void CO_HBconsumer_process(
     if(NMTisPreOrOperational){
         for(i=0; i<HBcons->numberOfMonitoredNodes; i++){
             if(monitoredNode->time){/* is node monitored */
+                CO_HBconsumer_event_t event = CO_HBCONS_STATE_CHANGED;
+
                 /* Verify if new Consumer Heartbeat message received */
                 if(monitoredNode->CANrxNew){
                     if(monitoredNode->NMTstate){
@@ -225,6 +557,9 @@ void CO_HBconsumer_process(
                         monitoredNode->timeoutTimer = 0;  /* reset timer */
                         timeDifference_ms = 0;
                     }
+                    else if(monitoredNode->monStarted){
+                        event = CO_HBCONS_BOOTUP;
+                    }
                     monitoredNode->CANrxNew = false;
                 }
                 /* Verify timeout */
@@ -234,12 +569,22 @@ void CO_HBconsumer_process(
                     if(monitoredNode->timeoutTimer >= monitoredNode->time){
                         CO_errorReport(HBcons->em, CO_EM_HEARTBEAT_CONSUMER, CO_EMC_HEARTBEAT, i);
                         monitoredNode->NMTstate = 0;
+                        if(event != CO_HBCONS_BOOTUP) event = CO_HBCONS_TIMEOUT;
                     }
                     else if(monitoredNode->NMTstate == 0){
                         /* there was a bootup message */
                         CO_errorReport(HBcons->em, CO_EM_HB_CONSUMER_REMOTE_RESET, CO_EMC_HEARTBEAT, i);
                     }
+
+                    /* Calculate, when timeout expires and lower timerNext_ms if necessary. */
+                    if(timerNext_ms != NULL && monitoredNode->timeoutTimer < monitoredNode->time){
+                        uint16_t diff = monitoredNode->time - monitoredNode->timeoutTimer;
+                        if(*timerNext_ms > diff){
+                            *timerNext_ms = diff;
+                        }
+                    }
                 }
+                CO_HBcons_setState(HBcons, monitoredNode, monitoredNode->NMTstate, event);
                 if(monitoredNode->NMTstate != CO_NMT_OPERATIONAL)
                     AllMonitoredOperationalCopy = 0;
             }
@@ -248,6 +593,7 @@ void CO_HBconsumer_process(
     }
     else{ /* not in (pre)operational state */
         for(i=0; i<HBcons->numberOfMonitoredNodes; i++){
+            CO_HBcons_setState(HBcons, monitoredNode, 0U, CO_HBCONS_STATE_CHANGED);
             monitoredNode->NMTstate = 0;
             monitoredNode->CANrxNew = false;
             monitoredNode->monStarted = false;
@@ -257,3 +603,4 @@ void CO_HBconsumer_process(
     }
     HBcons->allMonitoredOperational = AllMonitoredOperationalCopy;
 }
+#endif
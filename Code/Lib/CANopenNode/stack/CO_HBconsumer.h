@@ -64,10 +64,53 @@ extern "C" {
  * variable _allMonitoredOperational_ inside CO_HBconsumer_t is set to true.
  * Monitoring starts after the reception of the first HeartBeat (not bootup).
  *
+ * With #CO_HB_TIMER_WHEEL, monitored nodes are kept in a timer wheel of
+ * #CO_HB_WHEEL_SIZE slots with 1 ms resolution. Node lives in the slot of its
+ * deadline (last reception + consumer time). CO_HBcons_receive() only stores
+ * reception time; when the slot expires, node with newer reception is moved
+ * to its new slot, otherwise timeout is reported. Node with longer consumer
+ * time than wheel size is visited once per wheel revolution. Reception with
+ * changed NMT state is put into event queue and processed by the next
+ * CO_HBconsumer_process() call.
+ *
+ * State of remote nodes is also kept in _operationalNodes_ bitmap inside
+ * CO_HBconsumer_t (bit n is set, if node with ID n is NMT operational), see
+ * CO_HBconsumer_allOperational(). Application may be notified about changes
+ * with CO_HBconsumer_initCallback().
+ *
+ * With #CO_HB_CONS_RANGE, all heartbeat identifiers 0x701..0x77F are received
+ * by one receive buffer (CO_CANrxBufferInitRange()), so consumer uses a single
+ * hardware filter regardless of the number of monitored nodes. Node ID from
+ * the received identifier is translated to the monitored node by _nodeIndex_.
+ *
  * @see  @ref CO_NMT_Heartbeat
  */
 
 
+/**
+ * Event for CO_HBconsumer_initCallback().
+ */
+typedef enum{
+    CO_HBCONS_STATE_CHANGED = 0,        /**< NMT state of remote node changed (e.g. went operational) */
+    CO_HBCONS_BOOTUP        = 1,        /**< Boot-up message received from started node */
+    CO_HBCONS_TIMEOUT       = 2         /**< Heartbeat timeout, NMT state is now 0 */
+}CO_HBconsumer_event_t;
+
+
+/** Number of timer wheel slots (1 ms each), power of 2 */
+#ifndef CO_HB_WHEEL_SIZE
+#define CO_HB_WHEEL_SIZE        128U
+#endif
+
+/** Size of event queue, power of 2, more than number of monitored nodes */
+#ifndef CO_HB_EVENT_QUEUE_SIZE
+#define CO_HB_EVENT_QUEUE_SIZE  128U
+#endif
+
+/** Index value for empty timer wheel slot or end of node list */
+#define CO_HB_NODE_NONE         0xFFU
+
+
 /**
  * One monitored node inside CO_HBconsumer_t.
  */
@@ -77,6 +120,16 @@ typedef struct{
     uint16_t            timeoutTimer;   /**< Time since last heartbeat received */
     uint16_t            time;           /**< Consumer heartbeat time from OD */
     bool_t              CANrxNew;       /**< True if new Heartbeat message received from the CAN bus */
+    uint8_t             nodeId;         /**< Node ID from OD, 0 if not monitored */
+    uint8_t             NMTstateSeen;   /**< NMTstate as last processed by CO_HBconsumer_process() */
+#if CO_HB_TIMER_WHEEL > 0
+    void               *HBcons;         /**< CO_HBconsumer_t, which contains this node */
+    uint8_t             index;          /**< Index of this node in monitoredNodes */
+    volatile bool_t     eventPending;   /**< Node is in event queue */
+    volatile uint32_t   rxTime_ms;      /**< CO_HBconsumer_t now_ms at last reception */
+    uint8_t             wheelSlot;      /**< Timer wheel slot or CO_HB_NODE_NONE */
+    uint8_t             wheelNext;      /**< Next node in the same slot or CO_HB_NODE_NONE */
+#endif
 }CO_HBconsNode_t;
 
 
@@ -96,6 +149,28 @@ typedef struct{
     uint8_t             allMonitoredOperational;
     CO_CANmodule_t     *CANdevRx;       /**< From CO_HBconsumer_init() */
     uint16_t            CANdevRxIdxStart; /**< From CO_HBconsumer_init() */
+    /** Bit (nodeId & 0x1F) in word (nodeId >> 5) is set, if monitored node is
+        NMT operational. Can be read by the application */
+    uint32_t            operationalNodes[4];
+    uint8_t             monitoredCount; /**< Number of monitored nodes */
+    uint8_t             operationalCount; /**< Number of monitored nodes in NMT operational */
+    /** From CO_HBconsumer_initCallback() or NULL */
+    void              (*pFunctChanged)(void *object, uint8_t nodeId, uint8_t idx,
+                                       CO_HBconsumer_event_t event, uint8_t NMTstate);
+    void               *functChangedObject; /**< From CO_HBconsumer_initCallback() */
+#if CO_HB_TIMER_WHEEL > 0
+    volatile uint32_t   now_ms;         /**< Time, sum of timeDifference_ms */
+    uint8_t             wheel[CO_HB_WHEEL_SIZE]; /**< First node in each slot */
+    uint8_t             events[CO_HB_EVENT_QUEUE_SIZE]; /**< Nodes with new NMT state */
+    volatile uint8_t    eventHead;      /**< Written by CO_HBcons_receive() */
+    uint8_t             eventTail;      /**< Read by CO_HBconsumer_process() */
+    bool_t              NMTwasPreOrOperational; /**< From previous CO_HBconsumer_process() */
+#endif
+#if CO_HB_CONS_RANGE > 0
+    CO_CANrxRange_t     CANrxRange;     /**< Receive buffer for identifiers 0x700..0x77F */
+    /** Index in monitoredNodes for each node ID or CO_HB_NODE_NONE */
+    uint8_t             nodeIndex[128];
+#endif
 }CO_HBconsumer_t;
 
 
@@ -114,9 +189,12 @@ typedef struct{
  * @param numberOfMonitoredNodes Total size of the above arrays.
  * @param CANdevRx CAN device for Heartbeat reception.
  * @param CANdevRxIdxStart Starting index of receive buffer in the above CAN device.
- * Number of used indexes is equal to numberOfMonitoredNodes.
+ * Number of used indexes is equal to numberOfMonitoredNodes (one with
+ * #CO_HB_CONS_RANGE).
  *
- * @return #CO_ReturnError_t CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ * @return #CO_ReturnError_t CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT (with
+ * #CO_HB_TIMER_WHEEL also, if numberOfMonitoredNodes is not less than
+ * #CO_HB_EVENT_QUEUE_SIZE).
  */
 CO_ReturnError_t CO_HBconsumer_init(
         CO_HBconsumer_t        *HBcons,
@@ -129,6 +207,40 @@ CO_ReturnError_t CO_HBconsumer_init(
         uint16_t                CANdevRxIdxStart);
 
 
+/**
+ * Initialize Heartbeat consumer callback function.
+ *
+ * Function initializes optional callback function, which is called from
+ * CO_HBconsumer_process() (mainline thread), when NMT state of monitored node
+ * changes, boot-up is received or heartbeat times out. _operationalNodes_ is
+ * already updated at the time of the call.
+ *
+ * @param HBcons This object.
+ * @param object Pointer to object, which will be passed to pFunctChanged(). Can be NULL.
+ * @param pFunctChanged Pointer to the callback function. Not called if NULL.
+ * Arguments are node ID, index in _Consumer Heartbeat Time_ (0 based), event
+ * and new NMT state of remote node.
+ */
+void CO_HBconsumer_initCallback(
+        CO_HBconsumer_t        *HBcons,
+        void                   *object,
+        void                  (*pFunctChanged)(void *object, uint8_t nodeId, uint8_t idx,
+                                               CO_HBconsumer_event_t event, uint8_t NMTstate));
+
+
+/**
+ * Check, if all nodes from the mask are NMT operational.
+ *
+ * @param HBcons This object.
+ * @param mask 128-bit mask of node IDs, same format as _operationalNodes_.
+ *
+ * @return True, if all nodes from the mask are monitored and NMT operational.
+ */
+bool_t CO_HBconsumer_allOperational(
+        const CO_HBconsumer_t  *HBcons,
+        const uint32_t          mask[4]);
+
+
 /**
  * Process Heartbeat consumer object.
  *
@@ -137,11 +249,13 @@ CO_ReturnError_t CO_HBconsumer_init(
  * @param HBcons This object.
  * @param NMTisPreOrOperational True if this node is NMT_PRE_OPERATIONAL or NMT_OPERATIONAL.
  * @param timeDifference_ms Time difference from previous function call in [milliseconds].
+ * @param timerNext_ms Return value - info to OS - see CO_process().
  */
 void CO_HBconsumer_process(
         CO_HBconsumer_t        *HBcons,
         bool_t                  NMTisPreOrOperational,
-        uint16_t                timeDifference_ms);
+        uint16_t                timeDifference_ms,
+        uint16_t               *timerNext_ms);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,176 @@
+/**
+ * CANopen Layer Setting Services protocol (common).
+ *
+ * @file        CO_LSS.h
+ * @ingroup     CO_LSS
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * CANopenNode is free and open source software: you can redistribute
+ * it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Following clarification and special exception to the GNU General Public
+ * License is included to the distribution terms of CANopenNode:
+ *
+ * Linking this library statically or dynamically with other modules is
+ * making a combined work based on this library. Thus, the terms and
+ * conditions of the GNU General Public License cover the whole combination.
+ *
+ * As a special exception, the copyright holders of this library give
+ * you permission to link this library with independent modules to
+ * produce an executable, regardless of the license terms of these
+ * independent modules, and to copy and distribute the resulting
+ * executable under terms of your choice, provided that you also meet,
+ * for each linked independent module, the terms and conditions of the
+ * license of that module. An independent module is a module which is
+ * not derived from or based on this library. If you modify this
+ * library, you may extend this exception to your version of the
+ * library, but you are not obliged to do so. If you do not wish
+ * to do so, delete this exception statement from your version.
+ */
+
+
+#ifndef CO_LSS_H
+#define CO_LSS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_LSS LSS
+ * @ingroup CO_CANopen
+ * @{
+ *
+ * CANopen Layer Setting Services protocol (CiA 305).
+ *
+ * LSS master configures node-ID and bit rate of LSS slaves, which are
+ * identified by their LSS address (identity object 0x1018). Slave without
+ * valid node-ID (#CO_LSS_NODE_ID_ASSIGNMENT) takes part in the _fastscan_,
+ * where master finds its LSS address bit by bit, 32 exchanges for each
+ * unknown part of the address. Many identical devices on the network can
+ * this way get node-IDs without any configuration per unit.
+ *
+ * ###LSS message contents:
+ *
+ *   Byte | Description
+ *   -----|-----------------------------------------------------------
+ *     0  | #CO_LSS_cs_t
+ *   1..7 | Service specific data, little-endian
+ *
+ * Master sends on 0x7E5, slaves respond on 0x7E4.
+ *
+ * @see @ref CO_LSSslave, @ref CO_LSSmaster
+ */
+
+
+/** CAN identifier of LSS slave response */
+#define CO_CAN_ID_LSS_SRV           0x7E4U
+/** CAN identifier of LSS master request */
+#define CO_CAN_ID_LSS_CLI           0x7E5U
+
+/** Invalid node-ID, node-ID must be assigned by LSS master */
+#define CO_LSS_NODE_ID_ASSIGNMENT   0xFFU
+
+/** Valid node-ID 1..127 */
+#define CO_LSS_NODE_ID_VALID(nodeId) ((nodeId) >= 1U && (nodeId) <= 0x7FU)
+
+
+/**
+ * LSS command specifiers.
+ */
+typedef enum{
+    CO_LSS_SWITCH_STATE_GLOBAL      = 0x04U,    /**< Switch state global */
+    CO_LSS_SWITCH_STATE_SEL_VENDOR  = 0x40U,    /**< Switch state selective, vendor ID */
+    CO_LSS_SWITCH_STATE_SEL_PRODUCT = 0x41U,    /**< Switch state selective, product code */
+    CO_LSS_SWITCH_STATE_SEL_REV     = 0x42U,    /**< Switch state selective, revision number */
+    CO_LSS_SWITCH_STATE_SEL_SERIAL  = 0x43U,    /**< Switch state selective, serial number */
+    CO_LSS_SWITCH_STATE_SEL         = 0x44U,    /**< Switch state selective, slave response */
+    CO_LSS_CFG_NODE_ID              = 0x11U,    /**< Configure node-ID */
+    CO_LSS_CFG_BIT_TIMING           = 0x13U,    /**< Configure bit timing parameter */
+    CO_LSS_CFG_ACTIVATE_BIT_TIMING  = 0x15U,    /**< Activate bit timing parameter */
+    CO_LSS_CFG_STORE                = 0x17U,    /**< Store configuration */
+    CO_LSS_IDENT_NON_CONFIG         = 0x4CU,    /**< Identify non-configured remote slave */
+    CO_LSS_IDENT_SLAVE              = 0x4FU,    /**< Identify slave, slave response */
+    CO_LSS_IDENT_NON_CONFIG_SLAVE   = 0x50U,    /**< Identify non-configured slave, slave response */
+    CO_LSS_IDENT_FASTSCAN           = 0x51U,    /**< Fastscan */
+    CO_LSS_INQUIRE_VENDOR           = 0x5AU,    /**< Inquire identity vendor ID */
+    CO_LSS_INQUIRE_PRODUCT          = 0x5BU,    /**< Inquire identity product code */
+    CO_LSS_INQUIRE_REV              = 0x5CU,    /**< Inquire identity revision number */
+    CO_LSS_INQUIRE_SERIAL           = 0x5DU,    /**< Inquire identity serial number */
+    CO_LSS_INQUIRE_NODE_ID          = 0x5EU     /**< Inquire node-ID */
+}CO_LSS_cs_t;
+
+
+/**
+ * LSS state of the slave.
+ */
+typedef enum{
+    CO_LSS_STATE_WAITING            = 0U,       /**< Waiting state, default */
+    CO_LSS_STATE_CONFIGURATION      = 1U        /**< Configuration state */
+}CO_LSS_state_t;
+
+
+/**
+ * Error codes of configuration services.
+ */
+typedef enum{
+    CO_LSS_CFG_SUCCESS              = 0U,       /**< Protocol successfully completed */
+    CO_LSS_CFG_OUT_OF_RANGE         = 1U,       /**< Node-ID or bit rate out of range / not supported */
+    CO_LSS_CFG_STORE_ACCESS_ERROR   = 2U,       /**< Storage media access error */
+    CO_LSS_CFG_MANUFACTURER         = 0xFFU     /**< Manufacturer specific error */
+}CO_LSS_cfgError_t;
+
+
+/** Fastscan: BitChecked for reset of LSS slaves fastscan state */
+#define CO_LSS_FASTSCAN_CONFIRM     0x80U
+/** Fastscan: highest BitChecked */
+#define CO_LSS_FASTSCAN_BIT31       0x1FU
+/** Fastscan: LSSSub for vendor ID, product code, revision and serial number */
+#define CO_LSS_FASTSCAN_VENDOR_ID   0U
+#define CO_LSS_FASTSCAN_PRODUCT     1U
+#define CO_LSS_FASTSCAN_REV         2U
+#define CO_LSS_FASTSCAN_SERIAL      3U
+
+
+/**
+ * LSS address, the same as in identity object 0x1018.
+ */
+typedef union{
+    uint32_t            addr[4];        /**< Indexed by CO_LSS_FASTSCAN_VENDOR_ID .. CO_LSS_FASTSCAN_SERIAL */
+    struct{
+        uint32_t        vendorID;       /**< Vendor ID */
+        uint32_t        productCode;    /**< Product code */
+        uint32_t        revisionNumber; /**< Revision number */
+        uint32_t        serialNumber;   /**< Serial number */
+    }identity;                          /**< Named parts of LSS address */
+}CO_LSS_address_t;
+
+
+/** Number of entries in CO_LSS_bitTimingTable */
+#define CO_LSS_BIT_TIMING_COUNT     10U
+
+/**
+ * Bit rate in kbit/s for table index of configure bit timing service, 0 for
+ * reserved / automatic bit rate detection.
+ */
+extern const uint16_t CO_LSS_bitTimingTable[CO_LSS_BIT_TIMING_COUNT];
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+/** @} */
+#endif
@@ -0,0 +1,497 @@
+/*
+ * CANopen Layer Setting Service - master protocol.
+ *
+ * @file        CO_LSSmaster.c
+ * @ingroup     CO_LSSmaster
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * CANopenNode is free and open source software: you can redistribute
+ * it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Following clarification and special exception to the GNU General Public
+ * License is included to the distribution terms of CANopenNode:
+ *
+ * Linking this library statically or dynamically with other modules is
+ * making a combined work based on this library. Thus, the terms and
+ * conditions of the GNU General Public License cover the whole combination.
+ *
+ * As a special exception, the copyright holders of this library give
+ * you permission to link this library with independent modules to
+ * produce an executable, regardless of the license terms of these
+ * independent modules, and to copy and distribute the resulting
+ * executable under terms of your choice, provided that you also meet,
+ * for each linked independent module, the terms and conditions of the
+ * license of that module. An independent module is a module which is
+ * not derived from or based on this library. If you modify this
+ * library, you may extend this exception to your version of the
+ * library, but you are not obliged to do so. If you do not wish
+ * to do so, delete this exception statement from your version.
+ */
+
+
+#include "CO_driver.h"
+#include "CO_SDO.h"
+#include "CO_LSS.h"
+#include "CO_LSSmaster.h"
+
+
+/* Active service, CO_LSSmaster_t command */
+#define LSSM_CMD_IDLE           0U
+#define LSSM_CMD_SELECT         1U
+#define LSSM_CMD_CFG            2U
+#define LSSM_CMD_FASTSCAN       3U
+
+/* Fastscan states, CO_LSSmaster_t state */
+#define LSSM_FS_CHECK           0U
+#define LSSM_FS_CHECK_DRAIN     1U
+#define LSSM_FS_SCAN            2U
+#define LSSM_FS_VERIFY          3U
+
+
+/*
+ * Read received message from CAN module.
+ *
+ * Function will be called (by CAN receive interrupt) every time, when CAN
+ * message with correct identifier will be received. For more information and
+ * description of parameters see file CO_driver.h.
+ */
+static void CO_LSSmaster_receive(void *object, const CO_CANrxMsg_t *msg);
+static void CO_LSSmaster_receive(void *object, const CO_CANrxMsg_t *msg){
+    CO_LSSmaster_t *LSSmaster;
+
+    LSSmaster = (CO_LSSmaster_t*)object;   /* this is the correct pointer type of the first argument */
+
+    /* verify message length and message overflow (previous message was not processed yet) */
+    if(msg->DLC == 8 && !LSSmaster->CANrxNew && LSSmaster->command != LSSM_CMD_IDLE){
+        uint8_t i;
+
+        /* copy data and set 'new message' flag */
+        for(i=0; i<8; i++) LSSmaster->CANrxData[i] = msg->data[i];
+        LSSmaster->CANrxNew = true;
+
+        /* Optional signal to RTOS, which can resume task, which handles LSS master. */
+        if(LSSmaster->pFunctSignal != NULL) {
+            LSSmaster->pFunctSignal();
+        }
+    }
+}
+
+
+/*
+ * Send LSS request, cs and 7 bytes of data, and restart response timer.
+ */
+static void CO_LSSmaster_send(CO_LSSmaster_t *LSSmaster, uint8_t cs, const uint8_t *data){
+    uint8_t i;
+
+    LSSmaster->TXbuff->data[0] = cs;
+    for(i=1U; i<8U; i++){
+        LSSmaster->TXbuff->data[i] = (data != NULL) ? data[i-1U] : 0U;
+    }
+    LSSmaster->timer = 0U;
+    LSSmaster->CANrxNew = false;
+    CO_CANsend(LSSmaster->CANdevTx, LSSmaster->TXbuff);
+}
+
+
+/*
+ * Wait for slave response with command specifier cs.
+ *
+ * @return CO_LSSmaster_OK (response is in CANrxData, CANrxNew is still set),
+ * CO_LSSmaster_WAIT_SLAVE or CO_LSSmaster_TIMEOUT.
+ */
+static CO_LSSmaster_return_t CO_LSSmaster_wait(CO_LSSmaster_t *LSSmaster, uint16_t timeDifference_ms, uint8_t cs){
+    if(LSSmaster->CANrxNew){
+        if(LSSmaster->CANrxData[0] == cs){
+            return CO_LSSmaster_OK;
+        }
+        /* unexpected response */
+        LSSmaster->CANrxNew = false;
+    }
+    LSSmaster->timer += timeDifference_ms;
+    if(LSSmaster->timer >= LSSmaster->timeout_ms){
+        return CO_LSSmaster_TIMEOUT;
+    }
+    return CO_LSSmaster_WAIT_SLAVE;
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_LSSmaster_init(
+        CO_LSSmaster_t         *LSSmaster,
+        uint16_t                timeout_ms,
+        CO_CANmodule_t         *CANdevRx,
+        uint16_t                CANdevRxIdx,
+        uint16_t                CANidLssSlave,
+        CO_CANmodule_t         *CANdevTx,
+        uint16_t                CANdevTxIdx,
+        uint16_t                CANidLssMaster)
+{
+    /* verify arguments */
+    if(LSSmaster==NULL || CANdevRx==NULL || CANdevTx==NULL){
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    /* Configure object variables */
+    LSSmaster->timeout_ms = timeout_ms;
+    LSSmaster->command = LSSM_CMD_IDLE;
+    LSSmaster->state = 0U;
+    LSSmaster->timer = 0U;
+    LSSmaster->CANrxNew = false;
+    LSSmaster->pFunctSignal = NULL;
+
+    /* configure LSS CAN reception */
+    CO_CANrxBufferInit(
+            CANdevRx,               /* CAN device */
+            CANdevRxIdx,            /* rx buffer index */
+            CANidLssSlave,          /* CAN identifier */
+            0x7FF,                  /* mask */
+            0,                      /* rtr */
+            (void*)LSSmaster,       /* object passed to receive function */
+            CO_LSSmaster_receive);  /* this function will process received message */
+
+    /* configure LSS CAN transmission */
+    LSSmaster->CANdevTx = CANdevTx;
+    LSSmaster->TXbuff = CO_CANtxBufferInit(
+            CANdevTx,               /* CAN device */
+            CANdevTxIdx,            /* index of specific buffer inside CAN module */
+            CANidLssMaster,         /* CAN identifier */
+            0,                      /* rtr */
+            8,                      /* number of data bytes */
+            0);                     /* synchronous message flag bit */
+
+    if(LSSmaster->TXbuff == NULL){
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+void CO_LSSmaster_initCallback(
+        CO_LSSmaster_t         *LSSmaster,
+        void                  (*pFunctSignal)(void))
+{
+    if(LSSmaster != NULL){
+        LSSmaster->pFunctSignal = pFunctSignal;
+    }
+}
+
+
+/******************************************************************************/
+CO_LSSmaster_return_t CO_LSSmaster_switchStateSelect(
+        CO_LSSmaster_t         *LSSmaster,
+        uint16_t                timeDifference_ms,
+        const CO_LSS_address_t *lssAddress)
+{
+    CO_LSSmaster_return_t ret;
+
+    if(LSSmaster->command == LSSM_CMD_IDLE){
+        if(LSSmaster->TXbuff->bufferFull){
+            return CO_LSSmaster_INVALID_STATE;
+        }
+        if(lssAddress == NULL){
+            uint8_t data[7] = {(uint8_t)CO_LSS_STATE_CONFIGURATION, 0, 0, 0, 0, 0, 0};
+
+            CO_LSSmaster_send(LSSmaster, CO_LSS_SWITCH_STATE_GLOBAL, data);
+            return CO_LSSmaster_OK;
+        }
+        LSSmaster->command = LSSM_CMD_SELECT;
+        LSSmaster->selectStep = 0U;
+    }
+    else if(LSSmaster->command != LSSM_CMD_SELECT){
+        return CO_LSSmaster_INVALID_STATE;
+    }
+
+    /* four requests share one transmit buffer */
+    while(LSSmaster->selectStep < 4U){
+        uint8_t data[7] = {0, 0, 0, 0, 0, 0, 0};
+
+        if(LSSmaster->TXbuff->bufferFull){
+            return CO_LSSmaster_WAIT_SLAVE;
+        }
+        CO_setUint32(&data[0], lssAddress->addr[LSSmaster->selectStep]);
+        CO_LSSmaster_send(LSSmaster, (uint8_t)(CO_LSS_SWITCH_STATE_SEL_VENDOR + LSSmaster->selectStep), data);
+        LSSmaster->selectStep++;
+        if(LSSmaster->selectStep == 4U){
+            return CO_LSSmaster_WAIT_SLAVE;
+        }
+    }
+
+    ret = CO_LSSmaster_wait(LSSmaster, timeDifference_ms, CO_LSS_SWITCH_STATE_SEL);
+    if(ret != CO_LSSmaster_WAIT_SLAVE){
+        LSSmaster->CANrxNew = false;
+        LSSmaster->command = LSSM_CMD_IDLE;
+    }
+    return ret;
+}
+
+
+/******************************************************************************/
+CO_LSSmaster_return_t CO_LSSmaster_switchStateDeselect(CO_LSSmaster_t *LSSmaster){
+    uint8_t data[7] = {(uint8_t)CO_LSS_STATE_WAITING, 0, 0, 0, 0, 0, 0};
+
+    if(LSSmaster->command != LSSM_CMD_IDLE || LSSmaster->TXbuff->bufferFull){
+        return CO_LSSmaster_INVALID_STATE;
+    }
+    CO_LSSmaster_send(LSSmaster, CO_LSS_SWITCH_STATE_GLOBAL, data);
+    return CO_LSSmaster_OK;
+}
+
+
+/*
+ * Configuration service with response: send request on the first call, then
+ * wait for response and evaluate error code.
+ */
+static CO_LSSmaster_return_t CO_LSSmaster_configure(
+        CO_LSSmaster_t         *LSSmaster,
+        uint16_t                timeDifference_ms,
+        uint8_t                 cs,
+        const uint8_t          *data)
+{
+    CO_LSSmaster_return_t ret;
+
+    if(LSSmaster->command == LSSM_CMD_IDLE){
+        if(LSSmaster->TXbuff->bufferFull){
+            return CO_LSSmaster_INVALID_STATE;
+        }
+        LSSmaster->command = LSSM_CMD_CFG;
+        LSSmaster->state = cs;
+        CO_LSSmaster_send(LSSmaster, cs, data);
+        return CO_LSSmaster_WAIT_SLAVE;
+    }
+    if(LSSmaster->command != LSSM_CMD_CFG || LSSmaster->state != cs){
+        return CO_LSSmaster_INVALID_STATE;
+    }
+
+    ret = CO_LSSmaster_wait(LSSmaster, timeDifference_ms, cs);
+    if(ret == CO_LSSmaster_OK){
+        switch(LSSmaster->CANrxData[1]){
+            case CO_LSS_CFG_SUCCESS:        ret = CO_LSSmaster_OK;                  break;
+            case CO_LSS_CFG_OUT_OF_RANGE:   ret = CO_LSSmaster_OK_ILLEGAL_ARGUMENT; break;
+            default:                        ret = CO_LSSmaster_OK_MANUFACTURER;     break;
+        }
+    }
+    if(ret != CO_LSSmaster_WAIT_SLAVE){
+        LSSmaster->CANrxNew = false;
+        LSSmaster->command = LSSM_CMD_IDLE;
+    }
+    return ret;
+}
+
+
+/******************************************************************************/
+CO_LSSmaster_return_t CO_LSSmaster_configureNodeId(
+        CO_LSSmaster_t         *LSSmaster,
+        uint16_t                timeDifference_ms,
+        uint8_t                 nodeId)
+{
+    uint8_t data[7] = {0, 0, 0, 0, 0, 0, 0};
+
+    if(!CO_LSS_NODE_ID_VALID(nodeId) && nodeId != CO_LSS_NODE_ID_ASSIGNMENT){
+        return CO_LSSmaster_ILLEGAL_ARGUMENT;
+    }
+    data[0] = nodeId;
+    return CO_LSSmaster_configure(LSSmaster, timeDifference_ms, CO_LSS_CFG_NODE_ID, data);
+}
+
+
+/******************************************************************************/
+CO_LSSmaster_return_t CO_LSSmaster_configureBitTiming(
+        CO_LSSmaster_t         *LSSmaster,
+        uint16_t                timeDifference_ms,
+        uint16_t                bitRate)
+{
+    uint8_t data[7] = {0, 0, 0, 0, 0, 0, 0};
+    uint8_t i;
+
+    for(i=0U; i<CO_LSS_BIT_TIMING_COUNT && (bitRate == 0U || CO_LSS_bitTimingTable[i] != bitRate); i++);
+    if(i == CO_LSS_BIT_TIMING_COUNT){
+        return CO_LSSmaster_ILLEGAL_ARGUMENT;
+    }
+    data[0] = 0U;   /* table selector: CiA 305 bit timing table */
+    data[1] = i;
+    return CO_LSSmaster_configure(LSSmaster, timeDifference_ms, CO_LSS_CFG_BIT_TIMING, data);
+}
+
+
+/******************************************************************************/
+CO_LSSmaster_return_t CO_LSSmaster_configureStore(
+        CO_LSSmaster_t         *LSSmaster,
+        uint16_t                timeDifference_ms)
+{
+    return CO_LSSmaster_configure(LSSmaster, timeDifference_ms, CO_LSS_CFG_STORE, NULL);
+}
+
+
+/******************************************************************************/
+CO_LSSmaster_return_t CO_LSSmaster_activateBit(
+        CO_LSSmaster_t         *LSSmaster,
+        uint16_t                switchDelay_ms)
+{
+    uint8_t data[7] = {0, 0, 0, 0, 0, 0, 0};
+
+    if(LSSmaster->command != LSSM_CMD_IDLE || LSSmaster->TXbuff->bufferFull){
+        return CO_LSSmaster_INVALID_STATE;
+    }
+    data[0] = (uint8_t)switchDelay_ms;
+    data[1] = (uint8_t)(switchDelay_ms >> 8);
+    CO_LSSmaster_send(LSSmaster, CO_LSS_CFG_ACTIVATE_BIT_TIMING, data);
+    return CO_LSSmaster_OK;
+}
+
+
+/*
+ * Send fastscan request.
+ */
+static void CO_LSSmaster_fsSend(
+        CO_LSSmaster_t         *LSSmaster,
+        uint32_t                idNumber,
+        uint8_t                 bitCheck,
+        uint8_t                 lssSub,
+        uint8_t                 lssNext)
+{
+    uint8_t data[7];
+
+    CO_setUint32(&data[0], idNumber);
+    data[4] = bitCheck;
+    data[5] = lssSub;
+    data[6] = lssNext;
+    CO_LSSmaster_send(LSSmaster, CO_LSS_IDENT_FASTSCAN, data);
+}
+
+
+/*
+ * Start fastscan of the next part of LSS address.
+ */
+static void CO_LSSmaster_fsPart(CO_LSSmaster_t *LSSmaster, const CO_LSSmaster_fastscan_t *fastscan){
+    uint8_t sub = LSSmaster->fsSub;
+
+    if(fastscan->scan[sub] == CO_LSSmaster_FS_MATCH){
+        /* known value, verify it directly */
+        LSSmaster->fsIdNumber = fastscan->match.addr[sub];
+        LSSmaster->state = LSSM_FS_VERIFY;
+        CO_LSSmaster_fsSend(LSSmaster, LSSmaster->fsIdNumber, 0U, sub, (sub + 1U) & 0x03U);
+    }
+    else{
+        /* start with the most significant bit, which is tested as zero */
+        LSSmaster->fsIdNumber = 0U;
+        LSSmaster->fsBit = CO_LSS_FASTSCAN_BIT31;
+        LSSmaster->state = LSSM_FS_SCAN;
+        CO_LSSmaster_fsSend(LSSmaster, 0U, CO_LSS_FASTSCAN_BIT31, sub, sub);
+    }
+}
+
+
+/******************************************************************************/
+CO_LSSmaster_return_t CO_LSSmaster_identifyFastscan(
+        CO_LSSmaster_t         *LSSmaster,
+        uint16_t                timeDifference_ms,
+        CO_LSSmaster_fastscan_t *fastscan)
+{
+    CO_LSSmaster_return_t ret;
+    CO_LSSmaster_return_t result = CO_LSSmaster_WAIT_SLAVE;
+
+    if(fastscan == NULL){
+        return CO_LSSmaster_ILLEGAL_ARGUMENT;
+    }
+    if(LSSmaster->command == LSSM_CMD_IDLE){
+        if(LSSmaster->TXbuff->bufferFull){
+            return CO_LSSmaster_INVALID_STATE;
+        }
+        /* all slaves without node-ID reset their fastscan state and respond */
+        LSSmaster->command = LSSM_CMD_FASTSCAN;
+        LSSmaster->state = LSSM_FS_CHECK;
+        LSSmaster->fsSub = CO_LSS_FASTSCAN_VENDOR_ID;
+        CO_LSSmaster_fsSend(LSSmaster, 0U, CO_LSS_FASTSCAN_CONFIRM, 0U, 0U);
+        return CO_LSSmaster_WAIT_SLAVE;
+    }
+    if(LSSmaster->command != LSSM_CMD_FASTSCAN){
+        return CO_LSSmaster_INVALID_STATE;
+    }
+
+    ret = CO_LSSmaster_wait(LSSmaster, timeDifference_ms, CO_LSS_IDENT_SLAVE);
+
+    switch(LSSmaster->state){
+        case LSSM_FS_CHECK:
+            /* Many slaves respond, wait whole timeout, so responses
+             * do not interfere with the scan. */
+            if(ret == CO_LSSmaster_OK){
+                LSSmaster->state = LSSM_FS_CHECK_DRAIN;
+                LSSmaster->CANrxNew = false;
+            }
+            else if(ret == CO_LSSmaster_TIMEOUT){
+                result = CO_LSSmaster_SCAN_NOACK;
+            }
+            break;
+
+        case LSSM_FS_CHECK_DRAIN:
+            LSSmaster->CANrxNew = false;
+            if(ret == CO_LSSmaster_TIMEOUT){
+                CO_LSSmaster_fsPart(LSSmaster, fastscan);
+            }
+            break;
+
+        case LSSM_FS_SCAN:
+            if(ret == CO_LSSmaster_WAIT_SLAVE){
+                break;
+            }
+            /* response: some slave has zero in checked bit, else one */
+            if(ret == CO_LSSmaster_TIMEOUT){
+                LSSmaster->fsIdNumber |= 1UL << LSSmaster->fsBit;
+            }
+            if(LSSmaster->fsBit == 0U){
+                LSSmaster->state = LSSM_FS_VERIFY;
+                CO_LSSmaster_fsSend(LSSmaster, LSSmaster->fsIdNumber, 0U,
+                                    LSSmaster->fsSub, (LSSmaster->fsSub + 1U) & 0x03U);
+            }
+            else{
+                LSSmaster->fsBit--;
+                CO_LSSmaster_fsSend(LSSmaster, LSSmaster->fsIdNumber, LSSmaster->fsBit,
+                                    LSSmaster->fsSub, LSSmaster->fsSub);
+            }
+            break;
+
+        case LSSM_FS_VERIFY:
+            if(ret == CO_LSSmaster_TIMEOUT){
+                result = (fastscan->scan[LSSmaster->fsSub] == CO_LSSmaster_FS_MATCH &&
+                          LSSmaster->fsSub == CO_LSS_FASTSCAN_VENDOR_ID) ?
+                         CO_LSSmaster_SCAN_NOACK : CO_LSSmaster_SCAN_FAILED;
+            }
+            else if(ret == CO_LSSmaster_OK){
+                fastscan->found.addr[LSSmaster->fsSub] = LSSmaster->fsIdNumber;
+                if(LSSmaster->fsSub == CO_LSS_FASTSCAN_SERIAL){
+                    /* slave is in configuration state */
+                    result = CO_LSSmaster_OK;
+                }
+                else{
+                    LSSmaster->fsSub++;
+                    CO_LSSmaster_fsPart(LSSmaster, fastscan);
+                }
+            }
+            break;
+
+        default:
+            result = CO_LSSmaster_SCAN_FAILED;
+            break;
+    }
+
+    if(result != CO_LSSmaster_WAIT_SLAVE){
+        LSSmaster->CANrxNew = false;
+        LSSmaster->command = LSSM_CMD_IDLE;
+    }
+    return result;
+}
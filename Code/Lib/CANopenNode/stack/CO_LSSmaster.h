@@ -0,0 +1,305 @@
+/**
+ * CANopen Layer Setting Service - master protocol.
+ *
+ * @file        CO_LSSmaster.h
+ * @ingroup     CO_LSSmaster
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * CANopenNode is free and open source software: you can redistribute
+ * it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Following clarification and special exception to the GNU General Public
+ * License is included to the distribution terms of CANopenNode:
+ *
+ * Linking this library statically or dynamically with other modules is
+ * making a combined work based on this library. Thus, the terms and
+ * conditions of the GNU General Public License cover the whole combination.
+ *
+ * As a special exception, the copyright holders of this library give
+ * you permission to link this library with independent modules to
+ * produce an executable, regardless of the license terms of these
+ * independent modules, and to copy and distribute the resulting
+ * executable under terms of your choice, provided that you also meet,
+ * for each linked independent module, the terms and conditions of the
+ * license of that module. An independent module is a module which is
+ * not derived from or based on this library. If you modify this
+ * library, you may extend this exception to your version of the
+ * library, but you are not obliged to do so. If you do not wish
+ * to do so, delete this exception statement from your version.
+ */
+
+
+#ifndef CO_LSS_MASTER_H
+#define CO_LSS_MASTER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_LSSmaster LSS Master
+ * @ingroup CO_CANopen
+ * @{
+ *
+ * CANopen Layer Setting Service - master protocol.
+ *
+ * All functions are non-blocking. Function, which waits for a slave
+ * response, returns #CO_LSSmaster_WAIT_SLAVE and must be called again with
+ * the same arguments, until it returns other value. Only one service can be
+ * active at a time.
+ *
+ * Node-ID assignment to all devices without node-ID:
+ *  1. CO_LSSmaster_identifyFastscan() finds one device and switches it into
+ *     LSS configuration state. #CO_LSSmaster_SCAN_NOACK means, there are no
+ *     more devices without node-ID.
+ *  2. CO_LSSmaster_configureNodeId() and optionally
+ *     CO_LSSmaster_configureStore().
+ *  3. CO_LSSmaster_switchStateDeselect(), device starts with the new node-ID
+ *     and does not take part in the next fastscan.
+ *
+ * With known vendor ID and product code (#CO_LSSmaster_FS_MATCH), fastscan
+ * needs 3 + 2 * 33 exchanges per device. Exchange, which is not answered,
+ * lasts _timeout_ms_.
+ */
+
+
+/**
+ * Return values of LSS master functions.
+ */
+typedef enum{
+    CO_LSSmaster_WAIT_SLAVE          = 1,   /**< No response yet, call function again */
+    CO_LSSmaster_OK                  = 0,   /**< Success, end of communication */
+    CO_LSSmaster_TIMEOUT             = -1,  /**< No response received */
+    CO_LSSmaster_ILLEGAL_ARGUMENT    = -2,  /**< Invalid argument */
+    CO_LSSmaster_INVALID_STATE       = -3,  /**< Other service is active */
+    CO_LSSmaster_SCAN_NOACK          = -4,  /**< No slave answered fastscan */
+    CO_LSSmaster_SCAN_FAILED         = -5,  /**< Fastscan was not finished, slave was lost */
+    CO_LSSmaster_OK_ILLEGAL_ARGUMENT = -6,  /**< Slave responded with "out of range" or "not supported" */
+    CO_LSSmaster_OK_MANUFACTURER     = -7   /**< Slave responded with storage or manufacturer specific error */
+}CO_LSSmaster_return_t;
+
+
+/**
+ * Fastscan type of one part of LSS address.
+ */
+typedef enum{
+    CO_LSSmaster_FS_SCAN             = 0,   /**< Part is scanned bit by bit */
+    CO_LSSmaster_FS_MATCH            = 1    /**< Part is known, value from _match_ is verified */
+}CO_LSSmaster_scantype_t;
+
+
+/**
+ * Parameters and result of CO_LSSmaster_identifyFastscan().
+ */
+typedef struct{
+    /** Scan type for vendor ID, product code, revision and serial number */
+    CO_LSSmaster_scantype_t scan[4];
+    /** Known parts of LSS address for #CO_LSSmaster_FS_MATCH */
+    CO_LSS_address_t    match;
+    /** LSS address of the found slave */
+    CO_LSS_address_t    found;
+}CO_LSSmaster_fastscan_t;
+
+
+/**
+ * LSS master object.
+ */
+typedef struct{
+    /** Time to wait for slave response. Set in CO_LSSmaster_init(), can be
+    changed by application. */
+    uint16_t            timeout_ms;
+    /** Active service or 0 */
+    uint8_t             command;
+    /** Internal state of the active service */
+    uint8_t             state;
+    /** Time since the last request */
+    uint16_t            timer;
+    /** Fastscan: part of LSS address */
+    uint8_t             fsSub;
+    /** Fastscan: checked bit */
+    uint8_t             fsBit;
+    /** Fastscan: found bits of current part */
+    uint32_t            fsIdNumber;
+    /** Switch state selective: next part of LSS address to be sent */
+    uint8_t             selectStep;
+    /** Flag indicates, if new LSS message received from CAN bus */
+    volatile bool_t     CANrxNew;
+    /** 8 data bytes of the received message */
+    uint8_t             CANrxData[8];
+    /** From CO_LSSmaster_initCallback() or NULL */
+    void              (*pFunctSignal)(void);
+    /** From CO_LSSmaster_init() */
+    CO_CANmodule_t     *CANdevTx;
+    /** CAN transmit buffer inside CANdevTx for CAN tx message */
+    CO_CANtx_t         *TXbuff;
+}CO_LSSmaster_t;
+
+
+/**
+ * Initialize LSS master object.
+ *
+ * Function must be called in the communication reset section.
+ *
+ * @param LSSmaster This object will be initialized.
+ * @param timeout_ms Time to wait for slave response, 10 ms or more is typical.
+ * @param CANdevRx CAN device for LSS master reception.
+ * @param CANdevRxIdx Index of receive buffer in the above CAN device.
+ * @param CANidLssSlave COB ID for reception, #CO_CAN_ID_LSS_SRV.
+ * @param CANdevTx CAN device for LSS master transmission.
+ * @param CANdevTxIdx Index of transmit buffer in the above CAN device.
+ * @param CANidLssMaster COB ID for transmission, #CO_CAN_ID_LSS_CLI.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_LSSmaster_init(
+        CO_LSSmaster_t         *LSSmaster,
+        uint16_t                timeout_ms,
+        CO_CANmodule_t         *CANdevRx,
+        uint16_t                CANdevRxIdx,
+        uint16_t                CANidLssSlave,
+        CO_CANmodule_t         *CANdevTx,
+        uint16_t                CANdevTxIdx,
+        uint16_t                CANidLssMaster);
+
+
+/**
+ * Initialize LSSmasterRx callback function.
+ *
+ * Function initializes optional callback function, which is called after new
+ * message is received from the CAN bus. Function may wake up external task,
+ * which processes LSS master.
+ *
+ * @param LSSmaster This object.
+ * @param pFunctSignal Pointer to the callback function. Not called if NULL.
+ */
+void CO_LSSmaster_initCallback(
+        CO_LSSmaster_t         *LSSmaster,
+        void                  (*pFunctSignal)(void));
+
+
+/**
+ * Switch LSS slave(s) into configuration state.
+ *
+ * @param LSSmaster This object.
+ * @param timeDifference_ms Time difference from previous function call in [milliseconds].
+ * @param lssAddress LSS address of the slave, which is selected. If NULL, all
+ * slaves are switched (switch state global) and there is no response.
+ *
+ * @return #CO_LSSmaster_return_t: WAIT_SLAVE, OK, TIMEOUT, INVALID_STATE.
+ */
+CO_LSSmaster_return_t CO_LSSmaster_switchStateSelect(
+        CO_LSSmaster_t         *LSSmaster,
+        uint16_t                timeDifference_ms,
+        const CO_LSS_address_t *lssAddress);
+
+
+/**
+ * Switch all LSS slaves into waiting state (switch state global).
+ *
+ * Slave without node-ID, which got node-ID, resets communication.
+ *
+ * @param LSSmaster This object.
+ *
+ * @return #CO_LSSmaster_return_t: OK, INVALID_STATE.
+ */
+CO_LSSmaster_return_t CO_LSSmaster_switchStateDeselect(CO_LSSmaster_t *LSSmaster);
+
+
+/**
+ * Configure node-ID of the slave in configuration state.
+ *
+ * @param LSSmaster This object.
+ * @param timeDifference_ms Time difference from previous function call in [milliseconds].
+ * @param nodeId Node-ID 1..127 or #CO_LSS_NODE_ID_ASSIGNMENT.
+ *
+ * @return #CO_LSSmaster_return_t: WAIT_SLAVE, OK, TIMEOUT, ILLEGAL_ARGUMENT,
+ * INVALID_STATE, OK_ILLEGAL_ARGUMENT, OK_MANUFACTURER.
+ */
+CO_LSSmaster_return_t CO_LSSmaster_configureNodeId(
+        CO_LSSmaster_t         *LSSmaster,
+        uint16_t                timeDifference_ms,
+        uint8_t                 nodeId);
+
+
+/**
+ * Configure bit rate of the slave in configuration state.
+ *
+ * @param LSSmaster This object.
+ * @param timeDifference_ms Time difference from previous function call in [milliseconds].
+ * @param bitRate Bit rate in kbit/s, from CO_LSS_bitTimingTable.
+ *
+ * @return #CO_LSSmaster_return_t: WAIT_SLAVE, OK, TIMEOUT, ILLEGAL_ARGUMENT,
+ * INVALID_STATE, OK_ILLEGAL_ARGUMENT, OK_MANUFACTURER.
+ */
+CO_LSSmaster_return_t CO_LSSmaster_configureBitTiming(
+        CO_LSSmaster_t         *LSSmaster,
+        uint16_t                timeDifference_ms,
+        uint16_t                bitRate);
+
+
+/**
+ * Store configuration of the slave in configuration state.
+ *
+ * @param LSSmaster This object.
+ * @param timeDifference_ms Time difference from previous function call in [milliseconds].
+ *
+ * @return #CO_LSSmaster_return_t: WAIT_SLAVE, OK, TIMEOUT, INVALID_STATE,
+ * OK_ILLEGAL_ARGUMENT, OK_MANUFACTURER.
+ */
+CO_LSSmaster_return_t CO_LSSmaster_configureStore(
+        CO_LSSmaster_t         *LSSmaster,
+        uint16_t                timeDifference_ms);
+
+
+/**
+ * Activate bit rate of all slaves in configuration state.
+ *
+ * Master must switch its own bit rate after switchDelay_ms and wait
+ * switchDelay_ms more before it transmits again.
+ *
+ * @param LSSmaster This object.
+ * @param switchDelay_ms Delay before and after bit rate switch.
+ *
+ * @return #CO_LSSmaster_return_t: OK, INVALID_STATE.
+ */
+CO_LSSmaster_return_t CO_LSSmaster_activateBit(
+        CO_LSSmaster_t         *LSSmaster,
+        uint16_t                switchDelay_ms);
+
+
+/**
+ * Find one LSS slave without node-ID with fastscan.
+ *
+ * Found slave is in LSS configuration state, other slaves are in waiting state.
+ *
+ * @param LSSmaster This object.
+ * @param timeDifference_ms Time difference from previous function call in [milliseconds].
+ * @param fastscan Scan parameters and result.
+ *
+ * @return #CO_LSSmaster_return_t: WAIT_SLAVE, OK, ILLEGAL_ARGUMENT,
+ * INVALID_STATE, SCAN_NOACK, SCAN_FAILED.
+ */
+CO_LSSmaster_return_t CO_LSSmaster_identifyFastscan(
+        CO_LSSmaster_t         *LSSmaster,
+        uint16_t                timeDifference_ms,
+        CO_LSSmaster_fastscan_t *fastscan);
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+/** @} */
+#endif
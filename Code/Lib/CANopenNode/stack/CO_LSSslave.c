@@ -0,0 +1,394 @@
+/*
+ * CANopen Layer Setting Service - slave protocol.
+ *
+ * @file        CO_LSSslave.c
+ * @ingroup     CO_LSSslave
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * CANopenNode is free and open source software: you can redistribute
+ * it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Following clarification and special exception to the GNU General Public
+ * License is included to the distribution terms of CANopenNode:
+ *
+ * Linking this library statically or dynamically with other modules is
+ * making a combined work based on this library. Thus, the terms and
+ * conditions of the GNU General Public License cover the whole combination.
+ *
+ * As a special exception, the copyright holders of this library give
+ * you permission to link this library with independent modules to
+ * produce an executable, regardless of the license terms of these
+ * independent modules, and to copy and distribute the resulting
+ * executable under terms of your choice, provided that you also meet,
+ * for each linked independent module, the terms and conditions of the
+ * license of that module. An independent module is a module which is
+ * not derived from or based on this library. If you modify this
+ * library, you may extend this exception to your version of the
+ * library, but you are not obliged to do so. If you do not wish
+ * to do so, delete this exception statement from your version.
+ */
+
+
+#include "CO_driver.h"
+#include "CO_SDO.h"
+#include "CO_LSS.h"
+#include "CO_LSSslave.h"
+
+
+/* Bit rates from CiA 305, table index 0 */
+const uint16_t CO_LSS_bitTimingTable[CO_LSS_BIT_TIMING_COUNT] = {
+    1000U, 800U, 500U, 250U, 125U, 0U, 50U, 20U, 10U, 0U
+};
+
+
+/*
+ * Read received message from CAN module.
+ *
+ * Function will be called (by CAN receive interrupt) every time, when CAN
+ * message with correct identifier will be received. For more information and
+ * description of parameters see file CO_driver.h.
+ */
+static void CO_LSSslave_receive(void *object, const CO_CANrxMsg_t *msg);
+static void CO_LSSslave_receive(void *object, const CO_CANrxMsg_t *msg){
+    CO_LSSslave_t *LSSslave;
+
+    LSSslave = (CO_LSSslave_t*)object;   /* this is the correct pointer type of the first argument */
+
+    /* verify message length and message overflow (previous message was not processed yet) */
+    if(msg->DLC == 8 && !LSSslave->CANrxNew){
+        uint8_t i;
+
+        /* copy data and set 'new message' flag */
+        for(i=0; i<8; i++) LSSslave->CANrxData[i] = msg->data[i];
+        LSSslave->CANrxNew = true;
+
+        /* Optional signal to RTOS, which can resume task, which handles LSS slave. */
+        if(LSSslave->pFunctSignal != NULL) {
+            LSSslave->pFunctSignal();
+        }
+    }
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_LSSslave_init(
+        CO_LSSslave_t          *LSSslave,
+        const CO_LSS_address_t *lssAddress,
+        uint16_t                activeBitRate,
+        uint8_t                 activeNodeID,
+        CO_CANmodule_t         *CANdevRx,
+        uint16_t                CANdevRxIdx,
+        uint16_t                CANidLssMaster,
+        CO_CANmodule_t         *CANdevTx,
+        uint16_t                CANdevTxIdx,
+        uint16_t                CANidLssSlave)
+{
+    uint8_t i;
+
+    /* verify arguments */
+    if(LSSslave==NULL || lssAddress==NULL || CANdevRx==NULL || CANdevTx==NULL ||
+       (!CO_LSS_NODE_ID_VALID(activeNodeID) && activeNodeID != CO_LSS_NODE_ID_ASSIGNMENT)){
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    /* Configure object variables */
+    LSSslave->lssAddress = *lssAddress;
+    LSSslave->lssState = CO_LSS_STATE_WAITING;
+    for(i=0U; i<4U; i++){
+        LSSslave->lssSelect.addr[i] = 0U;
+    }
+    LSSslave->fastscanPos = CO_LSS_FASTSCAN_VENDOR_ID;
+    LSSslave->pendingBitRate = activeBitRate;
+    LSSslave->pendingNodeID = activeNodeID;
+    LSSslave->activeNodeID = activeNodeID;
+    LSSslave->CANrxNew = false;
+    LSSslave->pFunctSignal = NULL;
+    LSSslave->pFunctCheckBitRate = NULL;
+    LSSslave->functCheckBitRateObject = NULL;
+    LSSslave->pFunctActivateBitRate = NULL;
+    LSSslave->functActivateBitRateObject = NULL;
+    LSSslave->pFunctCfgStore = NULL;
+    LSSslave->functCfgStoreObject = NULL;
+
+    /* configure LSS CAN reception */
+    CO_CANrxBufferInit(
+            CANdevRx,               /* CAN device */
+            CANdevRxIdx,            /* rx buffer index */
+            CANidLssMaster,         /* CAN identifier */
+            0x7FF,                  /* mask */
+            0,                      /* rtr */
+            (void*)LSSslave,        /* object passed to receive function */
+            CO_LSSslave_receive);   /* this function will process received message */
+
+    /* configure LSS CAN transmission */
+    LSSslave->CANdevTx = CANdevTx;
+    LSSslave->TXbuff = CO_CANtxBufferInit(
+            CANdevTx,               /* CAN device */
+            CANdevTxIdx,            /* index of specific buffer inside CAN module */
+            CANidLssSlave,          /* CAN identifier */
+            0,                      /* rtr */
+            8,                      /* number of data bytes */
+            0);                     /* synchronous message flag bit */
+
+    if(LSSslave->TXbuff == NULL){
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+void CO_LSSslave_initCallback(
+        CO_LSSslave_t          *LSSslave,
+        void                  (*pFunctSignal)(void))
+{
+    if(LSSslave != NULL){
+        LSSslave->pFunctSignal = pFunctSignal;
+    }
+}
+
+
+/******************************************************************************/
+void CO_LSSslave_initCheckBitRateCallback(
+        CO_LSSslave_t          *LSSslave,
+        void                   *object,
+        bool_t                (*pFunctCheckBitRate)(void *object, uint16_t bitRate))
+{
+    if(LSSslave != NULL){
+        LSSslave->functCheckBitRateObject = object;
+        LSSslave->pFunctCheckBitRate = pFunctCheckBitRate;
+    }
+}
+
+
+/******************************************************************************/
+void CO_LSSslave_initActivateBitRateCallback(
+        CO_LSSslave_t          *LSSslave,
+        void                   *object,
+        void                  (*pFunctActivateBitRate)(void *object, uint16_t delay))
+{
+    if(LSSslave != NULL){
+        LSSslave->functActivateBitRateObject = object;
+        LSSslave->pFunctActivateBitRate = pFunctActivateBitRate;
+    }
+}
+
+
+/******************************************************************************/
+void CO_LSSslave_initCfgStoreCallback(
+        CO_LSSslave_t          *LSSslave,
+        void                   *object,
+        bool_t                (*pFunctCfgStore)(void *object, uint8_t nodeId, uint16_t bitRate))
+{
+    if(LSSslave != NULL){
+        LSSslave->functCfgStoreObject = object;
+        LSSslave->pFunctCfgStore = pFunctCfgStore;
+    }
+}
+
+
+/*
+ * Process fastscan request, see CiA 305.
+ *
+ * @return true, if slave must respond.
+ */
+static bool_t CO_LSSslave_fastscan(CO_LSSslave_t *LSSslave, const uint8_t *data){
+    uint32_t idNumber = CO_getUint32(&data[1]);
+    uint8_t bitCheck = data[5];
+    uint8_t lssSub = data[6];
+    uint8_t lssNext = data[7];
+
+    /* fastscan is only active on unconfigured nodes in waiting state */
+    if(LSSslave->pendingNodeID != CO_LSS_NODE_ID_ASSIGNMENT ||
+       LSSslave->lssState != CO_LSS_STATE_WAITING ||
+       lssSub > CO_LSS_FASTSCAN_SERIAL || lssNext > CO_LSS_FASTSCAN_SERIAL){
+        return false;
+    }
+
+    if(bitCheck == CO_LSS_FASTSCAN_CONFIRM){
+        /* master starts new scan */
+        LSSslave->fastscanPos = CO_LSS_FASTSCAN_VENDOR_ID;
+        return true;
+    }
+    if(bitCheck > CO_LSS_FASTSCAN_BIT31 || LSSslave->fastscanPos != lssSub){
+        return false;
+    }
+    if(((LSSslave->lssAddress.addr[lssSub] ^ idNumber) & (0xFFFFFFFFUL << bitCheck)) != 0U){
+        return false;
+    }
+    if(bitCheck == 0U){
+        /* part of the LSS address is complete, all parts after wrap around */
+        if(lssNext < lssSub){
+            LSSslave->lssState = CO_LSS_STATE_CONFIGURATION;
+        }
+        LSSslave->fastscanPos = lssNext;
+    }
+    return true;
+}
+
+
+/******************************************************************************/
+bool_t CO_LSSslave_process(CO_LSSslave_t *LSSslave){
+    const uint8_t *data = LSSslave->CANrxData;
+    uint8_t *tx = LSSslave->TXbuff->data;
+    bool_t respond = false;
+    bool_t resetCommunication = false;
+    bool_t configuration;
+    uint8_t i;
+
+    if(!LSSslave->CANrxNew){
+        return false;
+    }
+
+    configuration = (LSSslave->lssState == CO_LSS_STATE_CONFIGURATION) ? true : false;
+    for(i=0U; i<8U; i++) tx[i] = 0U;
+    tx[0] = data[0];
+
+    switch(data[0]){
+        case CO_LSS_SWITCH_STATE_GLOBAL:
+            if(data[1] == (uint8_t)CO_LSS_STATE_CONFIGURATION){
+                LSSslave->lssState = CO_LSS_STATE_CONFIGURATION;
+            }
+            else if(data[1] == (uint8_t)CO_LSS_STATE_WAITING){
+                /* device without node-ID starts with the new one */
+                if(configuration && LSSslave->activeNodeID == CO_LSS_NODE_ID_ASSIGNMENT &&
+                   LSSslave->pendingNodeID != CO_LSS_NODE_ID_ASSIGNMENT){
+                    resetCommunication = true;
+                }
+                LSSslave->lssState = CO_LSS_STATE_WAITING;
+                for(i=0U; i<4U; i++){
+                    LSSslave->lssSelect.addr[i] = 0U;
+                }
+            }
+            break;
+
+        case CO_LSS_SWITCH_STATE_SEL_VENDOR:
+        case CO_LSS_SWITCH_STATE_SEL_PRODUCT:
+        case CO_LSS_SWITCH_STATE_SEL_REV:
+        case CO_LSS_SWITCH_STATE_SEL_SERIAL:
+            if(!configuration){
+                LSSslave->lssSelect.addr[data[0] - CO_LSS_SWITCH_STATE_SEL_VENDOR] = CO_getUint32(&data[1]);
+                if(data[0] == CO_LSS_SWITCH_STATE_SEL_SERIAL){
+                    for(i=0U; i<4U && LSSslave->lssSelect.addr[i] == LSSslave->lssAddress.addr[i]; i++);
+                    if(i == 4U){
+                        LSSslave->lssState = CO_LSS_STATE_CONFIGURATION;
+                        tx[0] = CO_LSS_SWITCH_STATE_SEL;
+                        respond = true;
+                    }
+                }
+            }
+            break;
+
+        case CO_LSS_CFG_NODE_ID:
+            if(configuration){
+                if(CO_LSS_NODE_ID_VALID(data[1]) || data[1] == CO_LSS_NODE_ID_ASSIGNMENT){
+                    LSSslave->pendingNodeID = data[1];
+                    tx[1] = CO_LSS_CFG_SUCCESS;
+                }
+                else{
+                    tx[1] = CO_LSS_CFG_OUT_OF_RANGE;
+                }
+                respond = true;
+            }
+            break;
+
+        case CO_LSS_CFG_BIT_TIMING:
+            if(configuration){
+                uint16_t bitRate = (data[1] == 0U && data[2] < CO_LSS_BIT_TIMING_COUNT) ?
+                                   CO_LSS_bitTimingTable[data[2]] : 0U;
+
+                if(bitRate != 0U && LSSslave->pFunctCheckBitRate != NULL &&
+                   LSSslave->pFunctCheckBitRate(LSSslave->functCheckBitRateObject, bitRate)){
+                    LSSslave->pendingBitRate = bitRate;
+                    tx[1] = CO_LSS_CFG_SUCCESS;
+                }
+                else{
+                    tx[1] = CO_LSS_CFG_OUT_OF_RANGE;
+                }
+                respond = true;
+            }
+            break;
+
+        case CO_LSS_CFG_ACTIVATE_BIT_TIMING:
+            if(configuration && LSSslave->pFunctActivateBitRate != NULL){
+                LSSslave->pFunctActivateBitRate(LSSslave->functActivateBitRateObject,
+                                                CO_getUint16(&data[1]));
+            }
+            break;
+
+        case CO_LSS_CFG_STORE:
+            if(configuration){
+                if(LSSslave->pFunctCfgStore == NULL){
+                    tx[1] = CO_LSS_CFG_OUT_OF_RANGE;
+                }
+                else if(!LSSslave->pFunctCfgStore(LSSslave->functCfgStoreObject,
+                                                  LSSslave->pendingNodeID,
+                                                  LSSslave->pendingBitRate)){
+                    tx[1] = CO_LSS_CFG_STORE_ACCESS_ERROR;
+                }
+                else{
+                    tx[1] = CO_LSS_CFG_SUCCESS;
+                }
+                respond = true;
+            }
+            break;
+
+        case CO_LSS_INQUIRE_VENDOR:
+        case CO_LSS_INQUIRE_PRODUCT:
+        case CO_LSS_INQUIRE_REV:
+        case CO_LSS_INQUIRE_SERIAL:
+            if(configuration){
+                CO_setUint32(&tx[1], LSSslave->lssAddress.addr[data[0] - CO_LSS_INQUIRE_VENDOR]);
+                respond = true;
+            }
+            break;
+
+        case CO_LSS_INQUIRE_NODE_ID:
+            if(configuration){
+                tx[1] = LSSslave->activeNodeID;
+                respond = true;
+            }
+            break;
+
+        case CO_LSS_IDENT_NON_CONFIG:
+            if(LSSslave->activeNodeID == CO_LSS_NODE_ID_ASSIGNMENT &&
+               LSSslave->pendingNodeID == CO_LSS_NODE_ID_ASSIGNMENT){
+                tx[0] = CO_LSS_IDENT_NON_CONFIG_SLAVE;
+                respond = true;
+            }
+            break;
+
+        case CO_LSS_IDENT_FASTSCAN:
+            if(CO_LSSslave_fastscan(LSSslave, data)){
+                tx[0] = CO_LSS_IDENT_SLAVE;
+                respond = true;
+            }
+            break;
+
+        default:
+            /* unknown or not supported command, no response */
+            break;
+    }
+
+    if(respond){
+        CO_CANsend(LSSslave->CANdevTx, LSSslave->TXbuff);
+    }
+
+    LSSslave->CANrxNew = false;
+
+    return resetCommunication;
+}
@@ -0,0 +1,245 @@
+/**
+ * CANopen Layer Setting Service - slave protocol.
+ *
+ * @file        CO_LSSslave.h
+ * @ingroup     CO_LSSslave
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * CANopenNode is free and open source software: you can redistribute
+ * it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Following clarification and special exception to the GNU General Public
+ * License is included to the distribution terms of CANopenNode:
+ *
+ * Linking this library statically or dynamically with other modules is
+ * making a combined work based on this library. Thus, the terms and
+ * conditions of the GNU General Public License cover the whole combination.
+ *
+ * As a special exception, the copyright holders of this library give
+ * you permission to link this library with independent modules to
+ * produce an executable, regardless of the license terms of these
+ * independent modules, and to copy and distribute the resulting
+ * executable under terms of your choice, provided that you also meet,
+ * for each linked independent module, the terms and conditions of the
+ * license of that module. An independent module is a module which is
+ * not derived from or based on this library. If you modify this
+ * library, you may extend this exception to your version of the
+ * library, but you are not obliged to do so. If you do not wish
+ * to do so, delete this exception statement from your version.
+ */
+
+
+#ifndef CO_LSS_SLAVE_H
+#define CO_LSS_SLAVE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_LSSslave LSS Slave
+ * @ingroup CO_CANopen
+ * @{
+ *
+ * CANopen Layer Setting Service - slave protocol.
+ *
+ * LSS slave is initialized with node-ID and bit rate used by the device. If
+ * device has no node-ID, CO_init() is called with #CO_LSS_NODE_ID_ASSIGNMENT,
+ * then only CAN module and LSS slave are active, device takes part in the LSS
+ * fastscan and waits for node-ID from LSS master.
+ *
+ * Implemented services:
+ *  - switch state global and selective,
+ *  - configure node-ID, bit timing, activate bit timing and store configuration,
+ *  - inquire identity and node-ID,
+ *  - identify non-configured remote slave and fastscan.
+ *
+ * Received messages are copied in CAN receive interrupt and processed by
+ * CO_LSSslave_process() in mainline thread. Fastscan response time therefore
+ * depends on the call interval of CO_process(); CO_LSSslave_initCallback()
+ * may be used to wake up the mainline task.
+ *
+ * Node-ID and bit rate configured by LSS master are _pending_ values. They
+ * become active after next reset communication (CO_init() is called with
+ * them by application). Device without valid node-ID resets communication
+ * automatically, when it gets node-ID and master switches it back to waiting
+ * state.
+ */
+
+
+/**
+ * LSS slave object.
+ */
+typedef struct{
+    /** From CO_LSSslave_init() */
+    CO_LSS_address_t    lssAddress;
+    /** LSS state, #CO_LSS_state_t */
+    CO_LSS_state_t      lssState;
+    /** Parts of LSS address received in switch state selective */
+    CO_LSS_address_t    lssSelect;
+    /** Next part of LSS address expected in fastscan */
+    uint8_t             fastscanPos;
+    /** Bit rate, which will be used after reset communication */
+    uint16_t            pendingBitRate;
+    /** Node-ID, which will be used after reset communication */
+    uint8_t             pendingNodeID;
+    /** Node-ID in use, from CO_LSSslave_init() */
+    uint8_t             activeNodeID;
+    /** Flag indicates, if new LSS message received from CAN bus */
+    volatile bool_t     CANrxNew;
+    /** 8 data bytes of the received message */
+    uint8_t             CANrxData[8];
+    /** From CO_LSSslave_initCallback() or NULL */
+    void              (*pFunctSignal)(void);
+    /** From CO_LSSslave_initCheckBitRateCallback() or NULL */
+    bool_t            (*pFunctCheckBitRate)(void *object, uint16_t bitRate);
+    /** From CO_LSSslave_initCheckBitRateCallback() */
+    void               *functCheckBitRateObject;
+    /** From CO_LSSslave_initActivateBitRateCallback() or NULL */
+    void              (*pFunctActivateBitRate)(void *object, uint16_t delay);
+    /** From CO_LSSslave_initActivateBitRateCallback() */
+    void               *functActivateBitRateObject;
+    /** From CO_LSSslave_initCfgStoreCallback() or NULL */
+    bool_t            (*pFunctCfgStore)(void *object, uint8_t nodeId, uint16_t bitRate);
+    /** From CO_LSSslave_initCfgStoreCallback() */
+    void               *functCfgStoreObject;
+    /** From CO_LSSslave_init() */
+    CO_CANmodule_t     *CANdevTx;
+    /** CAN transmit buffer inside CANdevTx for CAN tx message */
+    CO_CANtx_t         *TXbuff;
+}CO_LSSslave_t;
+
+
+/**
+ * Initialize LSS slave object.
+ *
+ * Function must be called in the communication reset section, before other
+ * CANopen objects, which use node-ID.
+ *
+ * @param LSSslave This object will be initialized.
+ * @param lssAddress LSS address of this device, usually from OD object 0x1018.
+ * @param activeBitRate Bit rate used by CAN module in kbit/s.
+ * @param activeNodeID Node-ID used by the device or #CO_LSS_NODE_ID_ASSIGNMENT.
+ * @param CANdevRx CAN device for LSS slave reception.
+ * @param CANdevRxIdx Index of receive buffer in the above CAN device.
+ * @param CANidLssMaster COB ID for reception, #CO_CAN_ID_LSS_CLI.
+ * @param CANdevTx CAN device for LSS slave transmission.
+ * @param CANdevTxIdx Index of transmit buffer in the above CAN device.
+ * @param CANidLssSlave COB ID for transmission, #CO_CAN_ID_LSS_SRV.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_LSSslave_init(
+        CO_LSSslave_t          *LSSslave,
+        const CO_LSS_address_t *lssAddress,
+        uint16_t                activeBitRate,
+        uint8_t                 activeNodeID,
+        CO_CANmodule_t         *CANdevRx,
+        uint16_t                CANdevRxIdx,
+        uint16_t                CANidLssMaster,
+        CO_CANmodule_t         *CANdevTx,
+        uint16_t                CANdevTxIdx,
+        uint16_t                CANidLssSlave);
+
+
+/**
+ * Initialize LSSslaveRx callback function.
+ *
+ * Function initializes optional callback function, which is called after new
+ * message is received from the CAN bus. Function may wake up external task,
+ * which processes mainline CANopen functions.
+ *
+ * @param LSSslave This object.
+ * @param pFunctSignal Pointer to the callback function. Not called if NULL.
+ */
+void CO_LSSslave_initCallback(
+        CO_LSSslave_t          *LSSslave,
+        void                  (*pFunctSignal)(void));
+
+
+/**
+ * Initialize verify bit rate callback function.
+ *
+ * Function is called from CO_LSSslave_process(), when master configures new
+ * bit rate. If callback is not set, configure bit timing is not supported.
+ *
+ * @param LSSslave This object.
+ * @param object Pointer to object, which will be passed to pFunctCheckBitRate(). Can be NULL.
+ * @param pFunctCheckBitRate Pointer to the callback function, returns true, if
+ * bit rate in kbit/s is supported by the CAN module.
+ */
+void CO_LSSslave_initCheckBitRateCallback(
+        CO_LSSslave_t          *LSSslave,
+        void                   *object,
+        bool_t                (*pFunctCheckBitRate)(void *object, uint16_t bitRate));
+
+
+/**
+ * Initialize activate bit rate callback function.
+ *
+ * Function is called from CO_LSSslave_process(), when master activates
+ * pending bit rate. Application must stop CAN transmission for _delay_
+ * milliseconds, reinitialize CAN module with _pendingBitRate_ and wait
+ * _delay_ milliseconds more before transmitting again, for example with
+ * reset communication.
+ *
+ * @param LSSslave This object.
+ * @param object Pointer to object, which will be passed to pFunctActivateBitRate(). Can be NULL.
+ * @param pFunctActivateBitRate Pointer to the callback function. Not called if NULL.
+ */
+void CO_LSSslave_initActivateBitRateCallback(
+        CO_LSSslave_t          *LSSslave,
+        void                   *object,
+        void                  (*pFunctActivateBitRate)(void *object, uint16_t delay));
+
+
+/**
+ * Initialize store configuration callback function.
+ *
+ * Function is called from CO_LSSslave_process(), when master requests to
+ * store pending node-ID and bit rate into non-volatile memory. If callback is
+ * not set, store configuration is not supported.
+ *
+ * @param LSSslave This object.
+ * @param object Pointer to object, which will be passed to pFunctCfgStore(). Can be NULL.
+ * @param pFunctCfgStore Pointer to the callback function, returns false on
+ * storage error.
+ */
+void CO_LSSslave_initCfgStoreCallback(
+        CO_LSSslave_t          *LSSslave,
+        void                   *object,
+        bool_t                (*pFunctCfgStore)(void *object, uint8_t nodeId, uint16_t bitRate));
+
+
+/**
+ * Process LSS slave object.
+ *
+ * Function must be called cyclically in all NMT states.
+ *
+ * @param LSSslave This object.
+ *
+ * @return True, if communication must be reset, because device without valid
+ * node-ID got node-ID from LSS master. Application then calls CO_init() with
+ * _pendingNodeID_ and _pendingBitRate_.
+ */
+bool_t CO_LSSslave_process(CO_LSSslave_t *LSSslave);
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+/** @} */
+#endif
@@ -131,6 +131,11 @@ CO_ReturnError_t CO_NMT_init(
     NMT->HBproducerTimer        = 0xFFFF;
     NMT->emPr                   = emPr;
     NMT->pFunctNMT              = NULL;
+#if CO_HB_HW_TIMER > 0
+    NMT->HBtimeHw               = 0U;
+    NMT->HBtimerStarted         = false;
+    NMT->HBtxOverflow           = false;
+#endif
 
     /* configure NMT CAN reception */
     CO_CANrxBufferInit(
@@ -150,7 +155,7 @@ CO_ReturnError_t CO_NMT_init(
             CANidTxHB,          /* CAN identifier */
             0,                  /* rtr */
             1,                  /* number of data bytes */
-            0);                 /* synchronous message flag bit */
+            CO_CAN_TX_FLAG_CRITICAL); /* heartbeat may use reserved mailbox */
 
     return CO_ERROR_NO;
 }
@@ -219,7 +224,18 @@ CO_NMT_reset_cmd_t CO_NMT_process(
 
     uint8_t currentOperatingState = NMT->operatingState;
 
+#if CO_HB_HW_TIMER > 0
+    /* periodic heartbeat is produced by CO_NMT_HBtimerIsr(), HBproducerTimer
+     * only holds the boot-up and the heartbeat after lost operational state */
+    (void)timeDifference_ms;
+    NMT->HBtimeHw = HBtime;
+    if(NMT->HBtxOverflow){
+        NMT->HBtxOverflow = false;
+        CO_errorReport(NMT->emPr->em, CO_EM_CAN_TX_OVERFLOW, CO_EMC_CAN_OVERRUN, NMT->HB_TXbuff->ident);
+    }
+#else
     NMT->HBproducerTimer += timeDifference_ms;
+#endif
 
     /* Heartbeat producer message & Bootup message */
     if((HBtime != 0 && NMT->HBproducerTimer >= HBtime) || NMT->operatingState == CO_NMT_INITIALIZING){
@@ -242,6 +258,11 @@ CO_NMT_reset_cmd_t CO_NMT_process(
 
 
     /* Calculate, when next Heartbeat needs to be send and lower timerNext_ms if necessary. */
+#if CO_HB_HW_TIMER > 0
+    if(HBtime != 0 && timerNext_ms != NULL && NMT->HBproducerTimer >= HBtime){
+        *timerNext_ms = 0;
+    }
+#else
     if(HBtime != 0 && timerNext_ms != NULL){
         if(NMT->HBproducerTimer < HBtime){
             uint16_t diff = HBtime - NMT->HBproducerTimer;
@@ -252,6 +273,7 @@ CO_NMT_reset_cmd_t CO_NMT_process(
             *timerNext_ms = 0;
         }
     }
+#endif
 
 
     /* CAN passive flag */
@@ -346,6 +368,35 @@ CO_NMT_reset_cmd_t CO_NMT_process(
 }
 
 
+#if CO_HB_HW_TIMER > 0
+/******************************************************************************/
+CO_RAMFUNC uint32_t CO_NMT_HBtimerIsr(CO_NMT_t *NMT){
+    uint16_t HBtime = NMT->HBtimeHw;
+
+    if(HBtime == 0U || NMT->operatingState == CO_NMT_INITIALIZING){
+        NMT->HBtimerStarted = false;
+        return 1000U;
+    }
+
+    /* boot-up was sent by CO_NMT_process(), the first heartbeat follows it
+     * after firstHBTime, same as without hardware timer */
+    if(!NMT->HBtimerStarted){
+        NMT->HBtimerStarted = true;
+        if(NMT->firstHBTime != 0U){
+            return (uint32_t)((NMT->firstHBTime < HBtime) ? NMT->firstHBTime : HBtime) * 1000U;
+        }
+    }
+
+    NMT->HB_TXbuff->data[0] = NMT->operatingState;
+    if(CO_CANsendReserved(NMT->HB_CANdev, NMT->HB_TXbuff) != CO_ERROR_NO){
+        NMT->HBtxOverflow = true;
+    }
+
+    return (uint32_t)HBtime * 1000U;
+}
+#endif
+
+
 /******************************************************************************/
 CO_NMT_internalState_t CO_NMT_getInternalState(
         CO_NMT_t               *NMT)
@@ -80,6 +80,16 @@ extern "C" {
  *   -----|-----------------------------------------------------------
  *     0  | #CO_NMT_internalState_t
  *
+ * ####Heartbeat producer with hardware timer
+ * With #CO_HB_HW_TIMER periodic heartbeat is not transmitted from
+ * CO_NMT_process(), which depends on the period of its caller.
+ * CO_NMT_HBtimerIsr() is called from timer compare interrupt instead, writes
+ * heartbeat into reserved CAN mailbox and returns the time of the next
+ * compare. Heartbeats are then _Producer Heartbeat time_ apart within the
+ * interrupt latency, so consumers may use timeouts close to it. Boot-up
+ * message and heartbeat after leaving operational state are still sent by
+ * CO_NMT_process().
+ *
  * @see #CO_Default_CAN_ID_t
  *
  * ###Status LED diodes
@@ -167,6 +177,14 @@ typedef struct{
     CO_CANmodule_t     *HB_CANdev;      /**< From CO_NMT_init() */
     void              (*pFunctNMT)(CO_NMT_internalState_t state); /**< From CO_NMT_initCallback() or NULL */
     CO_CANtx_t         *HB_TXbuff;      /**< CAN transmit buffer */
+#if CO_HB_HW_TIMER > 0
+    /** _Producer Heartbeat time_ from the last CO_NMT_process(), read by CO_NMT_HBtimerIsr() */
+    volatile uint16_t   HBtimeHw;
+    /** Set by CO_NMT_HBtimerIsr(), when periodic heartbeat is scheduled */
+    volatile bool_t     HBtimerStarted;
+    /** Set by CO_NMT_HBtimerIsr(), if reserved mailbox was still busy */
+    volatile bool_t     HBtxOverflow;
+#endif
 }CO_NMT_t;
 
 
@@ -258,6 +276,26 @@ CO_NMT_reset_cmd_t CO_NMT_process(
         uint16_t               *timerNext_ms);
 
 
+#if CO_HB_HW_TIMER > 0
+/**
+ * Transmit heartbeat from hardware timer interrupt.
+ *
+ * Function must be called from timer compare interrupt, which is more urgent
+ * than CAN interrupts. If _Producer Heartbeat time_ is set and boot-up was
+ * sent, heartbeat is written into reserved mailbox with CO_CANsendReserved().
+ * The first one comes after firstHBTime from CO_NMT_init(), if it is shorter.
+ * Busy mailbox is reported as CO_EM_CAN_TX_OVERFLOW by CO_NMT_process().
+ *
+ * @param NMT This object.
+ *
+ * @return Time to the next call in [microseconds]: _Producer Heartbeat time_
+ * or 1000, if heartbeat is not produced. Timer should add it to the compare
+ * register, so the period does not accumulate interrupt latency.
+ */
+uint32_t CO_NMT_HBtimerIsr(CO_NMT_t *NMT);
+#endif
+
+
 /**
  * Query current NMT state
  *
@@ -0,0 +1,563 @@
+/*
+ * CANopen Network management master with boot-up of slave nodes.
+ *
+ * @file        CO_NMTmaster.c
+ * @ingroup     CO_NMTmaster
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * CANopenNode is free and open source software: you can redistribute
+ * it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Following clarification and special exception to the GNU General Public
+ * License is included to the distribution terms of CANopenNode:
+ *
+ * Linking this library statically or dynamically with other modules is
+ * making a combined work based on this library. Thus, the terms and
+ * conditions of the GNU General Public License cover the whole combination.
+ *
+ * As a special exception, the copyright holders of this library give
+ * you permission to link this library with independent modules to
+ * produce an executable, regardless of the license terms of these
+ * independent modules, and to copy and distribute the resulting
+ * executable under terms of your choice, provided that you also meet,
+ * for each linked independent module, the terms and conditions of the
+ * license of that module. An independent module is a module which is
+ * not derived from or based on this library. If you modify this
+ * library, you may extend this exception to your version of the
+ * library, but you are not obliged to do so. If you do not wish
+ * to do so, delete this exception statement from your version.
+ */
+
+
+#include "CO_driver.h"
+#include "CO_SDO.h"
+#include "CO_Emergency.h"
+#include "CO_NMT_Heartbeat.h"
+#include "CO_HBconsumer.h"
+#include "CO_SDOmaster.h"
+#include "CO_NMTmaster.h"
+
+
+/* Steps of identity check, objects from 0x1000 and 0x1018 */
+#define CO_NMTM_ID_DEVICE_TYPE  0U
+#define CO_NMTM_ID_VENDOR       1U
+#define CO_NMTM_ID_PRODUCT      2U
+#define CO_NMTM_ID_STEPS        3U
+
+#define CO_NMTM_NODE_WORD(nodeId) (((nodeId) >> 5) & 0x03U)
+#define CO_NMTM_NODE_BIT(nodeId)  (1UL << ((nodeId) & 0x1FU))
+
+
+/*
+ * Change state of the slave and inform application. Retries of not responding
+ * slave (between WAIT and IDENTITY) are not reported.
+ */
+static void CO_NMTm_setState(
+        CO_NMTmaster_t         *NMTm,
+        CO_NMTmasterSlave_t    *slave,
+        CO_NMTmaster_slaveState_t state)
+{
+    CO_NMTmaster_slaveState_t prev = slave->state;
+
+    slave->state = state;
+    if(NMTm->pFunctSlave != NULL && state != prev &&
+       !(prev == CO_NMTM_SLAVE_WAIT && state == CO_NMTM_SLAVE_IDENTITY) &&
+       !(prev == CO_NMTM_SLAVE_IDENTITY && state == CO_NMTM_SLAVE_WAIT))
+    {
+        NMTm->pFunctSlave(NMTm->functSlaveObject, slave);
+    }
+}
+
+
+/*
+ * Called from CO_SDOclientQueue_process(), when SDO job of the slave is finished.
+ */
+static void CO_NMTm_jobDone(CO_SDOclientJob_t *job){
+    ((CO_NMTmasterSlave_t*) job->object)->jobBusy = false;
+}
+
+
+/*
+ * Submit SDO job for the slave.
+ */
+static void CO_NMTm_submit(
+        CO_NMTmaster_t         *NMTm,
+        CO_NMTmasterSlave_t    *slave,
+        uint16_t                index,
+        uint8_t                 subIndex,
+        bool_t                  upload,
+        uint8_t                *data,
+        uint32_t                dataSize)
+{
+    CO_SDOclientJob_t *job = &slave->job;
+
+    job->nodeId = slave->nodeId;
+    job->index = index;
+    job->subIndex = subIndex;
+    job->upload = upload;
+    job->blockEnable = 0;
+    job->data = data;
+    job->dataSize = dataSize;
+    job->object = (void*)slave;
+    job->pFunctDone = CO_NMTm_jobDone;
+
+    slave->jobBusy = true;
+    if(CO_SDOclientQueue_submit(NMTm->SDOqueue, job) != CO_ERROR_NO){
+        slave->jobBusy = false;
+        job->result = CO_SDOcli_wrongArguments;
+        job->abortCode = 0;
+    }
+}
+
+
+/*
+ * Submit next identity upload, skip objects, which are not verified.
+ *
+ * @return false, if identity check is complete.
+ */
+static bool_t CO_NMTm_nextIdentity(CO_NMTmaster_t *NMTm, CO_NMTmasterSlave_t *slave){
+    for(; slave->step < CO_NMTM_ID_STEPS; slave->step++){
+        switch(slave->step){
+            case CO_NMTM_ID_DEVICE_TYPE:
+                /* always read, it also verifies SDO communication */
+                CO_NMTm_submit(NMTm, slave, 0x1000U, 0U, true, slave->value, 4U);
+                return true;
+            case CO_NMTM_ID_VENDOR:
+                if(slave->vendorId != 0U){
+                    CO_NMTm_submit(NMTm, slave, 0x1018U, 1U, true, slave->value, 4U);
+                    return true;
+                }
+                break;
+            default:
+                if(slave->productCode != 0U){
+                    CO_NMTm_submit(NMTm, slave, 0x1018U, 2U, true, slave->value, 4U);
+                    return true;
+                }
+                break;
+        }
+    }
+    return false;
+}
+
+
+/*
+ * Submit next configuration download.
+ *
+ * @return false, if configuration is complete.
+ */
+static bool_t CO_NMTm_nextConfig(CO_NMTmaster_t *NMTm, CO_NMTmasterSlave_t *slave){
+    if(slave->config != NULL && slave->step < slave->configCount){
+        const CO_NMTmasterConfig_t *cfg = &slave->config[slave->step];
+
+        CO_NMTm_submit(NMTm, slave, cfg->index, cfg->subIndex, false, cfg->data, cfg->dataSize);
+        return true;
+    }
+    return false;
+}
+
+
+/*
+ * Verify value uploaded in identity step.
+ */
+static bool_t CO_NMTm_identityMatch(const CO_NMTmasterSlave_t *slave){
+    uint32_t expected;
+
+    switch(slave->step){
+        case CO_NMTM_ID_DEVICE_TYPE: expected = slave->deviceType;  break;
+        case CO_NMTM_ID_VENDOR:      expected = slave->vendorId;    break;
+        default:                     expected = slave->productCode; break;
+    }
+    return (slave->job.dataSize == 4U &&
+            (expected == 0U || CO_getUint32(slave->value) == expected)) ? true : false;
+}
+
+
+/*
+ * Send NMT command, if CAN transmit buffer is free.
+ *
+ * @return true, if command was sent.
+ */
+static bool_t CO_NMTm_send(CO_NMTmaster_t *NMTm, uint8_t command, uint8_t nodeId){
+    if(NMTm->CANtxBuff->bufferFull){
+        return false;
+    }
+    NMTm->CANtxBuff->data[0] = command;
+    NMTm->CANtxBuff->data[1] = nodeId;
+    return (CO_CANsend(NMTm->CANdevTx, NMTm->CANtxBuff) == CO_ERROR_NO) ? true : false;
+}
+
+
+/*
+ * Verify, if slave is monitored by heartbeat consumer.
+ */
+static bool_t CO_NMTm_monitored(const CO_NMTmaster_t *NMTm, uint8_t nodeId){
+    uint8_t i;
+
+    if(NMTm->HBcons != NULL){
+        for(i=0U; i<NMTm->HBcons->numberOfMonitoredNodes; i++){
+            if(NMTm->HBcons->monitoredNodes[i].nodeId == nodeId){
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+
+/*
+ * Heartbeat consumer callback, boot slave again after reset or lost heartbeat.
+ * Callback of the application, replaced by CO_NMTmaster_initSlaves(), is
+ * called first.
+ */
+static void CO_NMTm_HBcallback(void *object, uint8_t nodeId, uint8_t idx,
+                               CO_HBconsumer_event_t event, uint8_t NMTstate)
+{
+    CO_NMTmaster_t *NMTm = (CO_NMTmaster_t*) object;
+    uint8_t i;
+
+    if(NMTm->pFunctHBprev != NULL){
+        NMTm->pFunctHBprev(NMTm->functHBprevObject, nodeId, idx, event, NMTstate);
+    }
+    if(event == CO_HBCONS_STATE_CHANGED){
+        return;
+    }
+    for(i=0U; i<NMTm->noOfSlaves; i++){
+        CO_NMTmasterSlave_t *slave = &NMTm->slaves[i];
+
+        if(slave->nodeId == nodeId && slave->state != CO_NMTM_SLAVE_IDLE){
+            slave->restart = true;
+        }
+    }
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_NMTmaster_init(
+        CO_NMTmaster_t         *NMTm,
+        CO_NMTmasterSlave_t     slaves[],
+        uint8_t                 noOfSlaves,
+        CO_HBconsumer_t        *HBcons,
+        CO_SDOclientQueue_t    *SDOqueue,
+        CO_CANmodule_t         *CANdevTx,
+        uint16_t                CANdevTxIdx)
+{
+    uint8_t i;
+
+    /* verify arguments */
+    if(NMTm==NULL || (slaves==NULL && noOfSlaves>0U) || SDOqueue==NULL || CANdevTx==NULL){
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    /* Configure object variables */
+    NMTm->slaves = NULL;
+    NMTm->noOfSlaves = 0U;
+    NMTm->HBcons = HBcons;
+    NMTm->SDOqueue = SDOqueue;
+    NMTm->CANdevTx = CANdevTx;
+    NMTm->retryTime_ms = 500U;
+    NMTm->startDelay_ms = 2000U;
+    NMTm->startTimer = 0U;
+    NMTm->resetPending = false;
+    NMTm->startAllPending = false;
+    NMTm->operationalCount = 0U;
+    NMTm->pFunctSlave = NULL;
+    NMTm->functSlaveObject = NULL;
+    NMTm->pFunctHBprev = NULL;
+    NMTm->functHBprevObject = NULL;
+    for(i=0U; i<4U; i++){
+        NMTm->startPending[i] = 0U;
+    }
+
+    /* configure NMT master CAN transmission */
+    NMTm->CANtxBuff = CO_CANtxBufferInit(
+            CANdevTx,               /* CAN device */
+            CANdevTxIdx,            /* index of specific buffer inside CAN module */
+            0x0000,                 /* CAN identifier */
+            0,                      /* rtr */
+            2,                      /* number of data bytes */
+            0);                     /* synchronous message flag bit */
+
+    if(NMTm->CANtxBuff == NULL){
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    return (noOfSlaves > 0U) ? CO_NMTmaster_initSlaves(NMTm, slaves, noOfSlaves) : CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_NMTmaster_initSlaves(
+        CO_NMTmaster_t         *NMTm,
+        CO_NMTmasterSlave_t     slaves[],
+        uint8_t                 noOfSlaves)
+{
+    uint8_t i;
+
+    /* verify arguments */
+    if(NMTm==NULL || slaves==NULL){
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+    for(i=0U; i<noOfSlaves; i++){
+        if(slaves[i].nodeId < 1U || slaves[i].nodeId > 127U){
+            return CO_ERROR_ILLEGAL_ARGUMENT;
+        }
+    }
+
+    NMTm->slaves = slaves;
+    NMTm->noOfSlaves = noOfSlaves;
+    NMTm->operationalCount = 0U;
+    for(i=0U; i<noOfSlaves; i++){
+        slaves[i].state = CO_NMTM_SLAVE_IDLE;
+        slaves[i].step = 0U;
+        slaves[i].retryTimer = 0U;
+        slaves[i].restart = false;
+        slaves[i].jobBusy = false;
+        slaves[i].job.client = 0xFF;
+        slaves[i].job.next = NULL;
+    }
+
+    /* chain callback of the application, but not own callback again */
+    if(NMTm->HBcons != NULL && NMTm->HBcons->pFunctChanged != CO_NMTm_HBcallback){
+        NMTm->pFunctHBprev = NMTm->HBcons->pFunctChanged;
+        NMTm->functHBprevObject = NMTm->HBcons->functChangedObject;
+        CO_HBconsumer_initCallback(NMTm->HBcons, (void*)NMTm, CO_NMTm_HBcallback);
+    }
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+void CO_NMTmaster_initCallback(
+        CO_NMTmaster_t         *NMTm,
+        void                   *object,
+        void                  (*pFunctSlave)(void *object, CO_NMTmasterSlave_t *slave))
+{
+    if(NMTm != NULL){
+        NMTm->functSlaveObject = object;
+        NMTm->pFunctSlave = pFunctSlave;
+    }
+}
+
+
+/******************************************************************************/
+void CO_NMTmaster_bootNetwork(CO_NMTmaster_t *NMTm){
+    uint8_t i;
+
+    NMTm->resetPending = true;
+    NMTm->startAllPending = false;
+    NMTm->startTimer = 0U;
+    for(i=0U; i<NMTm->noOfSlaves; i++){
+        NMTm->slaves[i].restart = true;
+    }
+}
+
+
+/******************************************************************************/
+void CO_NMTmaster_bootSlave(CO_NMTmaster_t *NMTm, CO_NMTmasterSlave_t *slave){
+    (void)NMTm;
+    slave->restart = true;
+}
+
+
+/******************************************************************************/
+bool_t CO_NMTmaster_process(
+        CO_NMTmaster_t         *NMTm,
+        uint16_t                timeDifference_ms,
+        uint16_t               *timerNext_ms)
+{
+    uint8_t i;
+    uint8_t booting = 0U, ready = 0U, failed = 0U, operational = 0U;
+
+    /* broadcast reset communication first, slaves wait for it */
+    if(NMTm->resetPending &&
+       CO_NMTm_send(NMTm, (uint8_t)CO_NMT_RESET_COMMUNICATION, 0U))
+    {
+        NMTm->resetPending = false;
+    }
+
+    for(i=0U; i<NMTm->noOfSlaves; i++){
+        CO_NMTmasterSlave_t *slave = &NMTm->slaves[i];
+        uint8_t word = CO_NMTM_NODE_WORD(slave->nodeId);
+        uint32_t bit = CO_NMTM_NODE_BIT(slave->nodeId);
+
+        /* SDO transfer is running, wait for its completion */
+        if(slave->jobBusy){
+            booting++;
+            continue;
+        }
+
+        if(slave->restart){
+            slave->restart = false;
+            slave->retryTimer = 0U;
+            NMTm->startPending[word] &= ~bit;
+            CO_NMTm_setState(NMTm, slave, CO_NMTM_SLAVE_WAIT);
+        }
+
+        switch(slave->state){
+            case CO_NMTM_SLAVE_WAIT:
+                if(NMTm->resetPending){
+                    break;
+                }
+                if(slave->retryTimer > timeDifference_ms){
+                    slave->retryTimer -= timeDifference_ms;
+                    if(timerNext_ms != NULL && *timerNext_ms > slave->retryTimer){
+                        *timerNext_ms = slave->retryTimer;
+                    }
+                    break;
+                }
+                slave->retryTimer = 0U;
+                slave->step = CO_NMTM_ID_DEVICE_TYPE;
+                CO_NMTm_setState(NMTm, slave, CO_NMTM_SLAVE_IDENTITY);
+                (void)CO_NMTm_nextIdentity(NMTm, slave);
+                break;
+
+            case CO_NMTM_SLAVE_IDENTITY:
+                if(slave->job.result == CO_SDOcli_endedWithTimeout){
+                    /* slave does not respond (yet), try again later */
+                    slave->retryTimer = NMTm->retryTime_ms;
+                    CO_NMTm_setState(NMTm, slave, CO_NMTM_SLAVE_WAIT);
+                }
+                else if(slave->job.result != CO_SDOcli_ok_communicationEnd ||
+                        !CO_NMTm_identityMatch(slave))
+                {
+                    CO_NMTm_setState(NMTm, slave, CO_NMTM_SLAVE_ERROR_IDENTITY);
+                }
+                else{
+                    slave->step++;
+                    if(!CO_NMTm_nextIdentity(NMTm, slave)){
+                        slave->step = 0U;
+                        CO_NMTm_setState(NMTm, slave, CO_NMTM_SLAVE_CONFIG);
+                        if(!CO_NMTm_nextConfig(NMTm, slave)){
+                            CO_NMTm_setState(NMTm, slave, CO_NMTM_SLAVE_READY);
+                        }
+                    }
+                }
+                break;
+
+            case CO_NMTM_SLAVE_CONFIG:
+                if(slave->job.result == CO_SDOcli_endedWithTimeout){
+                    /* slave was lost during configuration, boot it again */
+                    slave->retryTimer = NMTm->retryTime_ms;
+                    CO_NMTm_setState(NMTm, slave, CO_NMTM_SLAVE_WAIT);
+                }
+                else if(slave->job.result != CO_SDOcli_ok_communicationEnd){
+                    CO_NMTm_setState(NMTm, slave, CO_NMTM_SLAVE_ERROR_CONFIG);
+                }
+                else{
+                    slave->step++;
+                    if(!CO_NMTm_nextConfig(NMTm, slave)){
+                        CO_NMTm_setState(NMTm, slave, CO_NMTM_SLAVE_READY);
+                    }
+                }
+                break;
+
+            case CO_NMTM_SLAVE_STARTING:
+                /* wait until start command is sent and confirmed by heartbeat */
+                if(NMTm->startAllPending || (NMTm->startPending[word] & bit) != 0U){
+                    break;
+                }
+                if(!CO_NMTm_monitored(NMTm, slave->nodeId) ||
+                   (NMTm->HBcons->operationalNodes[word] & bit) != 0U)
+                {
+                    CO_NMTm_setState(NMTm, slave, CO_NMTM_SLAVE_OPERATIONAL);
+                }
+                break;
+
+            default:
+                break;
+        }
+
+        switch(slave->state){
+            case CO_NMTM_SLAVE_WAIT:
+            case CO_NMTM_SLAVE_IDENTITY:
+            case CO_NMTM_SLAVE_CONFIG:      booting++;      break;
+            case CO_NMTM_SLAVE_READY:       ready++;        break;
+            case CO_NMTM_SLAVE_OPERATIONAL: operational++;  break;
+            case CO_NMTM_SLAVE_ERROR_IDENTITY:
+            case CO_NMTM_SLAVE_ERROR_CONFIG: failed++;      break;
+            default:                                        break;
+        }
+    }
+
+    /* Start configured slaves. Broadcast is used, if all slaves are configured
+     * within the batch window, otherwise start commands are sent per node. */
+    if(ready > 0U){
+        bool_t broadcast = false;
+
+        if(NMTm->startTimer < NMTm->startDelay_ms){
+            if(booting == 0U && failed == 0U){
+                broadcast = true;
+                NMTm->startAllPending = true;
+                NMTm->startTimer = NMTm->startDelay_ms;
+            }
+            else{
+                uint16_t remain = NMTm->startDelay_ms - NMTm->startTimer;
+
+                NMTm->startTimer = (timeDifference_ms < remain) ?
+                        (NMTm->startTimer + timeDifference_ms) : NMTm->startDelay_ms;
+                if(timerNext_ms != NULL && NMTm->startTimer < NMTm->startDelay_ms &&
+                   *timerNext_ms > (NMTm->startDelay_ms - NMTm->startTimer))
+                {
+                    *timerNext_ms = NMTm->startDelay_ms - NMTm->startTimer;
+                }
+            }
+        }
+
+        if(broadcast || NMTm->startTimer >= NMTm->startDelay_ms){
+            for(i=0U; i<NMTm->noOfSlaves; i++){
+                CO_NMTmasterSlave_t *slave = &NMTm->slaves[i];
+
+                if(slave->state == CO_NMTM_SLAVE_READY){
+                    if(!broadcast){
+                        NMTm->startPending[CO_NMTM_NODE_WORD(slave->nodeId)] |=
+                                CO_NMTM_NODE_BIT(slave->nodeId);
+                    }
+                    CO_NMTm_setState(NMTm, slave, CO_NMTM_SLAVE_STARTING);
+                }
+            }
+        }
+    }
+
+    /* send start commands, as long as CAN transmit buffer is free */
+    if(NMTm->startAllPending && !NMTm->resetPending &&
+       CO_NMTm_send(NMTm, (uint8_t)CO_NMT_ENTER_OPERATIONAL, 0U))
+    {
+        NMTm->startAllPending = false;
+    }
+    for(i=0U; i<NMTm->noOfSlaves && !NMTm->resetPending && !NMTm->startAllPending; i++){
+        uint8_t nodeId = NMTm->slaves[i].nodeId;
+        uint32_t bit = CO_NMTM_NODE_BIT(nodeId);
+
+        if((NMTm->startPending[CO_NMTM_NODE_WORD(nodeId)] & bit) != 0U){
+            if(!CO_NMTm_send(NMTm, (uint8_t)CO_NMT_ENTER_OPERATIONAL, nodeId)){
+                break;
+            }
+            NMTm->startPending[CO_NMTM_NODE_WORD(nodeId)] &= ~bit;
+        }
+    }
+    if(timerNext_ms != NULL && *timerNext_ms > 1U &&
+       (NMTm->resetPending || NMTm->startAllPending ||
+        (NMTm->startPending[0] | NMTm->startPending[1] |
+         NMTm->startPending[2] | NMTm->startPending[3]) != 0U))
+    {
+        *timerNext_ms = 1U;
+    }
+
+    NMTm->operationalCount = operational;
+
+    return (operational == NMTm->noOfSlaves) ? true : false;
+}
@@ -0,0 +1,306 @@
+/**
+ * CANopen Network management master with boot-up of slave nodes.
+ *
+ * @file        CO_NMTmaster.h
+ * @ingroup     CO_NMTmaster
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * CANopenNode is free and open source software: you can redistribute
+ * it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Following clarification and special exception to the GNU General Public
+ * License is included to the distribution terms of CANopenNode:
+ *
+ * Linking this library statically or dynamically with other modules is
+ * making a combined work based on this library. Thus, the terms and
+ * conditions of the GNU General Public License cover the whole combination.
+ *
+ * As a special exception, the copyright holders of this library give
+ * you permission to link this library with independent modules to
+ * produce an executable, regardless of the license terms of these
+ * independent modules, and to copy and distribute the resulting
+ * executable under terms of your choice, provided that you also meet,
+ * for each linked independent module, the terms and conditions of the
+ * license of that module. An independent module is a module which is
+ * not derived from or based on this library. If you modify this
+ * library, you may extend this exception to your version of the
+ * library, but you are not obliged to do so. If you do not wish
+ * to do so, delete this exception statement from your version.
+ */
+
+
+#ifndef CO_NMT_MASTER_H
+#define CO_NMT_MASTER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_NMTmaster NMT master
+ * @ingroup CO_CANopen
+ * @{
+ *
+ * CANopen Network management master, simplified boot-up procedure from CiA 302-2.
+ *
+ * NMT master brings a list of slave nodes into NMT operational state. After
+ * CO_NMTmaster_bootNetwork() it sends one broadcast _reset communication_
+ * command and then, for each slave in parallel:
+ *  - reads and verifies identity (0x1000 device type, 0x1018,1 vendor ID,
+ *    0x1018,2 product code) with SDO client job,
+ *  - downloads configuration, list of #CO_NMTmasterConfig_t,
+ *  - waits, until other slaves are configured and starts it.
+ *
+ * SDO transfers are executed by @ref CO_SDOmaster queue. Transfers to
+ * different nodes run in parallel, one per SDO client in the queue, so number
+ * of SDO clients determines the speed of network boot-up. Slave, which does
+ * not respond to SDO, is retried after _retryTime_ms_.
+ *
+ * When all slaves are configured, they are started with one broadcast
+ * _start_ command (broadcast reset and start address also nodes, which are not
+ * in the list of slaves). Slave, which is configured after batch window
+ * _startDelay_ms_ expires (or later, after it was reset), is started
+ * individually. NMT commands are sent one per free CAN transmit buffer, so
+ * many individual commands are spread over several CO_NMTmaster_process()
+ * calls.
+ *
+ * NMT master uses the callback of @ref CO_HBconsumer. Callback, which was set
+ * by application with CO_HBconsumer_initCallback() before
+ * CO_NMTmaster_initSlaves(), is still called for all events. If slave is
+ * monitored by heartbeat consumer, it is reported as operational after its first
+ * operational heartbeat and it is booted again after heartbeat timeout or
+ * boot-up message. Slave, which is not monitored, is reported as operational
+ * immediately after the start command was sent.
+ *
+ * NMT commands are not applied to this node, use CO_sendNMTcommand() for that.
+ */
+
+
+/**
+ * State of the slave node in NMT master.
+ */
+typedef enum{
+    CO_NMTM_SLAVE_IDLE          = 0,    /**< Not booted by NMT master */
+    CO_NMTM_SLAVE_WAIT          = 1,    /**< Waiting for SDO response of the node */
+    CO_NMTM_SLAVE_IDENTITY      = 2,    /**< Reading identity */
+    CO_NMTM_SLAVE_CONFIG        = 3,    /**< Downloading configuration */
+    CO_NMTM_SLAVE_READY         = 4,    /**< Configured, waiting for start */
+    CO_NMTM_SLAVE_STARTING      = 5,    /**< Start command sent, waiting for heartbeat */
+    CO_NMTM_SLAVE_OPERATIONAL   = 6,    /**< Slave is NMT operational */
+    CO_NMTM_SLAVE_ERROR_IDENTITY= -1,   /**< Identity does not match, slave is not started */
+    CO_NMTM_SLAVE_ERROR_CONFIG  = -2    /**< Configuration download aborted, slave is not started */
+}CO_NMTmaster_slaveState_t;
+
+
+/**
+ * One SDO download of slave configuration. Data are little-endian and must be
+ * valid during boot-up.
+ */
+typedef struct{
+    uint16_t            index;          /**< Index of object in slave */
+    uint8_t             subIndex;       /**< Subindex of object in slave */
+    uint8_t            *data;           /**< Data to be written */
+    uint32_t            dataSize;       /**< Size of data */
+}CO_NMTmasterConfig_t;
+
+
+/**
+ * Slave node, owned by the application. Members up to configCount are set by
+ * the application, others by NMT master.
+ */
+typedef struct{
+    /** Node-ID of the slave, 1..127 */
+    uint8_t             nodeId;
+    /** Expected device type (0x1000), 0 is not verified */
+    uint32_t            deviceType;
+    /** Expected vendor ID (0x1018,1), 0 is not verified */
+    uint32_t            vendorId;
+    /** Expected product code (0x1018,2), 0 is not verified */
+    uint32_t            productCode;
+    /** Configuration downloaded to slave before start or NULL */
+    const CO_NMTmasterConfig_t *config;
+    /** Number of entries in config */
+    uint16_t            configCount;
+    /** State of the slave */
+    CO_NMTmaster_slaveState_t state;
+    /** Step in identity check or index in config */
+    uint16_t            step;
+    /** Time to the next SDO attempt in CO_NMTM_SLAVE_WAIT state */
+    uint16_t            retryTimer;
+    /** True, if slave must be booted again after running SDO job */
+    bool_t              restart;
+    /** True, if SDO job is in the queue */
+    bool_t              jobBusy;
+    /** Buffer for identity values */
+    uint8_t             value[4];
+    /** SDO client job for this slave */
+    CO_SDOclientJob_t   job;
+}CO_NMTmasterSlave_t;
+
+
+/**
+ * NMT master object.
+ */
+typedef struct{
+    /** From CO_NMTmaster_init() */
+    CO_NMTmasterSlave_t *slaves;
+    /** From CO_NMTmaster_init() */
+    uint8_t             noOfSlaves;
+    /** From CO_NMTmaster_init() */
+    CO_HBconsumer_t    *HBcons;
+    /** From CO_NMTmaster_init() */
+    CO_SDOclientQueue_t *SDOqueue;
+    /** From CO_NMTmaster_init() */
+    CO_CANmodule_t     *CANdevTx;
+    /** CAN transmit buffer inside CANdevTx for NMT commands */
+    CO_CANtx_t         *CANtxBuff;
+    /** Time between SDO attempts to not responding slave. Set to 500 in
+    CO_NMTmaster_init(), can be changed by application. */
+    uint16_t            retryTime_ms;
+    /** Time after the first configured slave, after which configured slaves
+    are started individually, if not all slaves are configured. Set to 2000 in
+    CO_NMTmaster_init(), can be changed by application. */
+    uint16_t            startDelay_ms;
+    /** Timer for startDelay_ms, running while slaves are in READY state */
+    uint16_t            startTimer;
+    /** Broadcast reset communication must be sent */
+    bool_t              resetPending;
+    /** Broadcast start must be sent */
+    bool_t              startAllPending;
+    /** Nodes with pending individual start command, bit per node ID */
+    uint32_t            startPending[4];
+    /** Number of slaves in NMT operational */
+    uint8_t             operationalCount;
+    /** From CO_NMTmaster_initCallback() or NULL */
+    void              (*pFunctSlave)(void *object, CO_NMTmasterSlave_t *slave);
+    /** From CO_NMTmaster_initCallback() */
+    void               *functSlaveObject;
+    /** Previous heartbeat consumer callback, called from NMT master callback */
+    void              (*pFunctHBprev)(void *object, uint8_t nodeId, uint8_t idx,
+                                      CO_HBconsumer_event_t event, uint8_t NMTstate);
+    /** Object of previous heartbeat consumer callback */
+    void               *functHBprevObject;
+}CO_NMTmaster_t;
+
+
+/**
+ * Initialize NMT master object.
+ *
+ * Function must be called in the communication reset section, after
+ * CO_HBconsumer_init() and CO_SDOclientQueue_init().
+ *
+ * @param NMTm This object will be initialized.
+ * @param slaves Array of slaves, configured by application. May be NULL, if
+ * noOfSlaves is 0, slaves are then set later by CO_NMTmaster_initSlaves().
+ * @param noOfSlaves Number of slaves in array.
+ * @param HBcons Heartbeat consumer object or NULL, if slaves are not monitored.
+ * @param SDOqueue SDO client queue used for identity and configuration.
+ * @param CANdevTx CAN device for NMT master transmission.
+ * @param CANdevTxIdx Index of transmit buffer in the above CAN device. Buffer
+ * may be the same as used by CO_sendNMTcommand().
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_NMTmaster_init(
+        CO_NMTmaster_t         *NMTm,
+        CO_NMTmasterSlave_t     slaves[],
+        uint8_t                 noOfSlaves,
+        CO_HBconsumer_t        *HBcons,
+        CO_SDOclientQueue_t    *SDOqueue,
+        CO_CANmodule_t         *CANdevTx,
+        uint16_t                CANdevTxIdx);
+
+
+/**
+ * Set slaves of NMT master object.
+ *
+ * CO_init() initializes NMT master without slaves, application then calls
+ * this function in the communication reset section, after CO_init() and
+ * after own CO_HBconsumer_initCallback(), if any. Slaves are in IDLE state,
+ * until CO_NMTmaster_bootNetwork() or CO_NMTmaster_bootSlave() is called.
+ *
+ * @param NMTm This object.
+ * @param slaves Array of slaves, configured by application.
+ * @param noOfSlaves Number of slaves in array.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_NMTmaster_initSlaves(
+        CO_NMTmaster_t         *NMTm,
+        CO_NMTmasterSlave_t     slaves[],
+        uint8_t                 noOfSlaves);
+
+
+/**
+ * Initialize NMT master callback function.
+ *
+ * Function initializes optional callback function, which is called from
+ * CO_NMTmaster_process(), when state of the slave changes.
+ *
+ * @param NMTm This object.
+ * @param object Pointer to object, which will be passed to pFunctSlave(). Can be NULL.
+ * @param pFunctSlave Pointer to the callback function. Not called if NULL.
+ */
+void CO_NMTmaster_initCallback(
+        CO_NMTmaster_t         *NMTm,
+        void                   *object,
+        void                  (*pFunctSlave)(void *object, CO_NMTmasterSlave_t *slave));
+
+
+/**
+ * Start boot-up of all slaves.
+ *
+ * Broadcast _reset communication_ is sent and all slaves go through boot-up
+ * procedure again. Function is non-blocking, boot-up is executed by
+ * CO_NMTmaster_process().
+ *
+ * @param NMTm This object.
+ */
+void CO_NMTmaster_bootNetwork(CO_NMTmaster_t *NMTm);
+
+
+/**
+ * Start boot-up of one slave, without reset of other nodes.
+ *
+ * @param NMTm This object.
+ * @param slave Slave from the array given to CO_NMTmaster_init().
+ */
+void CO_NMTmaster_bootSlave(CO_NMTmaster_t *NMTm, CO_NMTmasterSlave_t *slave);
+
+
+/**
+ * Process NMT master object.
+ *
+ * Function must be called cyclically from the same thread as
+ * CO_SDOclientQueue_process(), after it.
+ *
+ * @param NMTm This object.
+ * @param timeDifference_ms Time difference from previous function call in [milliseconds].
+ * @param timerNext_ms Return value - info to OS - see CO_process().
+ *
+ * @return True, if all slaves are NMT operational.
+ */
+bool_t CO_NMTmaster_process(
+        CO_NMTmaster_t         *NMTm,
+        uint16_t                timeDifference_ms,
+        uint16_t               *timerNext_ms);
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+/** @} */
+#endif
@@ -52,6 +52,250 @@
 #include "CO_PDO.h"
 #include <string.h>
 
+/* Effective inhibit time of TPDO in microseconds */
+#if CO_TPDO_ADAPTIVE_INHIBIT > 0
+#define CO_TPDO_INHIBIT_US(TPDO) \
+        ((uint32_t)(((uint64_t)(TPDO)->inhibitTime_us * (TPDO)->inhibitScale) >> 8))
+#else
+#define CO_TPDO_INHIBIT_US(TPDO) ((TPDO)->inhibitTime_us)
+#endif
+
+/*
+ * Compile PDO data pointers into copy runs.
+ *
+ * Consecutive bytes, which point to consecutive memory, are merged into one
+ * run, so adjacent OD variables are copied with one move.
+ *
+ * @param mapPointer Pointers to OD data bytes.
+ * @param dataLength Number of used mapPointer.
+ * @param runs Array of CO_PDO_COPY_RUNS runs to build.
+ *
+ * @return Number of runs.
+ */
+static uint8_t CO_PDObuildCopyRuns(
+        uint8_t               **mapPointer,
+        uint8_t                 dataLength,
+        CO_PDOcopyRun_t        *runs)
+{
+    uint8_t i;
+    uint8_t count = 0;
+
+    for(i=0; i<dataLength; i++){
+        if(count > 0 && mapPointer[i] == (runs[count-1].pData + runs[count-1].length)){
+            runs[count-1].length++;
+        }
+        else{
+            runs[count].pData = mapPointer[i];
+            runs[count].offset = i;
+            runs[count].length = 1;
+            count++;
+        }
+    }
+
+    return count;
+}
+
+
+/*
+ * Copy bytes of one run. Fixed size moves are expanded by compiler into
+ * single (unaligned) word accesses.
+ */
+static inline void CO_PDOcopyRun(uint8_t *dst, const uint8_t *src, uint8_t length){
+    switch(length){
+        case 1:  *dst = *src;           break;
+        case 2:  memcpy(dst, src, 2);   break;
+        case 4:  memcpy(dst, src, 4);   break;
+        case 8:  memcpy(dst, src, 8);   break;
+        default: memcpy(dst, src, length); break;
+    }
+}
+
+
+/*
+ * Copy PDO data to OD variables.
+ */
+CO_RAMFUNC static void CO_PDOcopyToOD(const CO_PDOcopyRun_t *runs, uint8_t count, const uint8_t *PDOdata){
+    for(; count>0; count--){
+        CO_PDOcopyRun(runs->pData, &PDOdata[runs->offset], runs->length);
+        runs++;
+    }
+}
+
+
+/*
+ * Copy OD variables to PDO data.
+ */
+CO_RAMFUNC static void CO_PDOcopyFromOD(const CO_PDOcopyRun_t *runs, uint8_t count, uint8_t *PDOdata){
+    for(; count>0; count--){
+        CO_PDOcopyRun(&PDOdata[runs->offset], runs->pData, runs->length);
+        runs++;
+    }
+}
+
+
+#if defined(RPDO_CALLS_EXTENSION) || defined(TPDO_CALLS_EXTENSION)
+/*
+ * Call OD extension functions of mapped objects, resolved at configuration.
+ *
+ * @param SDO SDO object.
+ * @param mapEntry Mapped objects.
+ * @param count Number of mapped objects.
+ * @param reading True for TPDO, false for RPDO.
+ */
+static void CO_PDOcallExtensions(
+        CO_SDO_t               *SDO,
+        const CO_PDOmapEntry_t *mapEntry,
+        uint8_t                 count,
+        bool_t                  reading)
+{
+    if(SDO->ODExtensions == NULL){
+        return;
+    }
+
+    for(; count>0; count--, mapEntry++){
+        CO_OD_extension_t *ext;
+        CO_ODF_arg_t ODF_arg;
+
+        if(mapEntry->entryNo == 0xFFFF) continue;
+        ext = &SDO->ODExtensions[mapEntry->entryNo];
+        if(ext->pODFunc == NULL) continue;
+
+        memset((void*)&ODF_arg, 0, sizeof(CO_ODF_arg_t));
+        ODF_arg.reading = reading;
+        ODF_arg.index = mapEntry->index;
+        ODF_arg.subIndex = mapEntry->subIndex;
+        ODF_arg.object = ext->object;
+        ODF_arg.attribute = mapEntry->attribute;
+        ODF_arg.pFlags = CO_OD_getFlagsPointer(SDO, mapEntry->entryNo, mapEntry->subIndex);
+        ODF_arg.data = SDO->OD[mapEntry->entryNo].pData;
+        ODF_arg.dataLength = mapEntry->length;
+        ext->pODFunc(&ODF_arg);
+    }
+}
+
+
+/*
+ * Store mapped object for CO_PDOcallExtensions().
+ */
+static void CO_PDOsetMapEntry(CO_SDO_t *SDO, CO_PDOmapEntry_t *mapEntry, uint32_t map, uint16_t entryNo){
+    mapEntry->entryNo = entryNo;
+    mapEntry->index = (uint16_t)(map>>16);
+    mapEntry->subIndex = (uint8_t)(map>>8);
+    if(entryNo != 0xFFFF){
+        mapEntry->attribute = CO_OD_getAttribute(SDO, entryNo, mapEntry->subIndex);
+        mapEntry->length = CO_OD_getLength(SDO, entryNo, mapEntry->subIndex);
+    }
+}
+#endif
+
+
+#if CO_PDO_FAST_BOOT > 0
+/*
+ * Calculate CRC32 (IEEE 802.3, bitwise) of PDO mapping. 16 bit CRC is too
+ * weak here, different mapping with the same CRC would keep stale copy runs.
+ *
+ * @param noOfMappedObjects Number of mapped objects.
+ * @param pMap Pointer to first mapped object (mappedObject1).
+ *
+ * @return CRC32 checksum.
+ */
+static uint32_t CO_PDOmapFingerprint(uint8_t noOfMappedObjects, const uint32_t *pMap){
+    const uint8_t *data = (const uint8_t*)pMap;
+    uint32_t crc = 0xFFFFFFFFUL;
+    uint8_t i, bit;
+
+    for(i = 0U; i <= (8U * sizeof(uint32_t)); i++){
+        crc ^= (i == 0U) ? noOfMappedObjects : data[i - 1U];
+        for(bit = 0U; bit < 8U; bit++){
+            crc = (crc >> 1) ^ (0xEDB88320UL & (0UL - (crc & 1UL)));
+        }
+    }
+    return ~crc;
+}
+#endif
+
+
+#if CO_ITM_TRACE > 0
+/*
+ * CAN identifier of PDO for ITM events, the same as in CO_R(T)PDOconfigCom().
+ */
+static uint16_t CO_PDOtraceId(uint32_t COB_ID, uint16_t defaultCOB_ID, uint8_t nodeId){
+    uint16_t ID = (uint16_t)(COB_ID & 0x7FFU);
+
+    if(ID == defaultCOB_ID && defaultCOB_ID != 0U){
+        ID += nodeId;
+    }
+    return ID;
+}
+#endif
+
+
+#if CO_PDO_MPDO > 0
+/*
+ * Queue received MPDO, called from CO_PDO_receive().
+ *
+ * DAM-MPDO for other nodes and MPDO of the other addressing mode are dropped
+ * here, SAM-MPDO is searched in dispatching list by CO_RPDO_process().
+ */
+CO_RAMFUNC static void CO_RPDOmpdoQueue(CO_RPDO_t *RPDO, const uint8_t *data){
+    uint8_t head = RPDO->mpdoHead;
+    uint8_t next = (uint8_t)((head + 1U) % CO_PDO_MPDO_QUEUE);
+    uint8_t nodeId = data[0] & 0x7FU;
+
+    if((data[0] & 0x80U) != 0U){
+        if(RPDO->mpdo != CO_PDO_MPDO_DAM || (nodeId != 0U && nodeId != RPDO->nodeId)){
+            return;
+        }
+    }
+    else if(RPDO->mpdo != CO_PDO_MPDO_SAM){
+        return;
+    }
+
+    if(next == RPDO->mpdoTail){
+        RPDO->mpdoOverflow++;
+        return;
+    }
+    memcpy(&RPDO->mpdoQueue[head][0], data, 8);
+    CO_MEMORY_BARRIER();
+    RPDO->mpdoHead = next;
+}
+#endif
+
+
+#if CO_TPDO_DIRTY_FLAGS > 0
+/*
+ * Mark TPDOs dirty, which map OD entry. May be called from any thread.
+ */
+static void CO_TPDOmarkEntry(CO_SDO_t *SDO, uint16_t entryNo){
+    if(entryNo != 0xFFFF && SDO->ODExtensions != NULL){
+        uint32_t mask = SDO->ODExtensions[entryNo].TPDOmask;
+
+        if(mask != 0U){
+#if CO_OD_ATOMIC > 0
+            CO_ATOMIC_OR32(SDO->pTPDOdirty, mask);
+#else
+            CO_LOCK_OD();
+            *SDO->pTPDOdirty |= mask;
+            CO_UNLOCK_OD();
+#endif
+        }
+    }
+}
+
+
+/*
+ * Mark TPDOs dirty, which map objects written by RPDO.
+ */
+static void CO_RPDOmarkDirty(CO_RPDO_t *RPDO){
+    uint8_t i;
+
+    for(i=0; i<RPDO->dirtyEntryCount; i++){
+        CO_TPDOmarkEntry(RPDO->SDO, RPDO->dirtyEntry[i]);
+    }
+}
+#endif
+
+
 /*
  * Read received message from CAN module.
  *
@@ -61,7 +305,7 @@
  * If new message arrives and previous message wasn't processed yet, then
  * previous message will be lost and overwritten by new message. That's OK with PDOs.
  */
-static void CO_PDO_receive(void *object, const CO_CANrxMsg_t *msg){
+CO_RAMFUNC static void CO_PDO_receive(void *object, const CO_CANrxMsg_t *msg){
     CO_RPDO_t *RPDO;
 
     RPDO = (CO_RPDO_t*)object;   /* this is the correct pointer type of the first argument */
@@ -70,31 +314,67 @@ static void CO_PDO_receive(void *object, const CO_CANrxMsg_t *msg){
         (*RPDO->operatingState == CO_NMT_OPERATIONAL) &&
         (msg->DLC >= RPDO->dataLength))
     {
-        if(RPDO->synchronous && RPDO->SYNC->CANrxToggle) {
-            /* copy data into second buffer and set 'new message' flag */
-            RPDO->CANrxData[1][0] = msg->data[0];
-            RPDO->CANrxData[1][1] = msg->data[1];
-            RPDO->CANrxData[1][2] = msg->data[2];
-            RPDO->CANrxData[1][3] = msg->data[3];
-            RPDO->CANrxData[1][4] = msg->data[4];
-            RPDO->CANrxData[1][5] = msg->data[5];
-            RPDO->CANrxData[1][6] = msg->data[6];
-            RPDO->CANrxData[1][7] = msg->data[7];
-
-            RPDO->CANrxNew[1] = true;
+#if CO_PDO_MPDO > 0
+        if(RPDO->mpdo != 0U) {
+            CO_RPDOmpdoQueue(RPDO, &msg->data[0]);
+        }
+        else
+#endif
+        if(RPDO->immediate && !RPDO->synchronous) {
+            /* copy data directly to Object dictionary */
+#if CO_OD_ATOMIC > 0
+            CO_OD_writeBegin(RPDO->SDO);
+            CO_PDOcopyToOD(RPDO->copyRun, RPDO->copyRunCount, &msg->data[0]);
+            CO_OD_writeEnd(RPDO->SDO);
+#else
+            CO_PDOcopyToOD(RPDO->copyRun, RPDO->copyRunCount, &msg->data[0]);
+#endif
+#if CO_TPDO_DIRTY_FLAGS > 0
+            CO_RPDOmarkDirty(RPDO);
+#endif
+#if CO_CAN_TIMESTAMP > 0
+            RPDO->CANrxTimestamp[0] = CO_CANrxMsg_readTimestamp(msg);
+#endif
+
+#if CO_RPDO_HANDLERS > 0
+            if(RPDO->pFunctHandler != NULL) {
+                RPDO->pFunctHandler(RPDO->handlerObject, RPDO->field, RPDO->fieldCount);
+            }
+#endif
+            if(RPDO->pFunctSignal != NULL) {
+                RPDO->pFunctSignal(RPDO->functSignalObject);
+            }
         }
         else {
-            /* copy data into default buffer and set 'new message' flag */
-            RPDO->CANrxData[0][0] = msg->data[0];
-            RPDO->CANrxData[0][1] = msg->data[1];
-            RPDO->CANrxData[0][2] = msg->data[2];
-            RPDO->CANrxData[0][3] = msg->data[3];
-            RPDO->CANrxData[0][4] = msg->data[4];
-            RPDO->CANrxData[0][5] = msg->data[5];
-            RPDO->CANrxData[0][6] = msg->data[6];
-            RPDO->CANrxData[0][7] = msg->data[7];
+            /* synchronous PDO received after SYNC goes into second buffer */
+            uint8_t bufNo = (RPDO->synchronous && RPDO->SYNC->CANrxToggle) ? 1 : 0;
+
+            /* copy data into buffer and set 'new message' flag */
+#if CO_RPDO_SEQLOCK > 0
+            RPDO->CANrxSeq[bufNo]++;
+            CO_MEMORY_BARRIER();
+#endif
+#if CO_PDO_MAX_SIZE > 8
+            memcpy(&RPDO->CANrxData[bufNo][0], &msg->data[0], RPDO->dataLength);
+#else
+            RPDO->CANrxData[bufNo][0] = msg->data[0];
+            RPDO->CANrxData[bufNo][1] = msg->data[1];
+            RPDO->CANrxData[bufNo][2] = msg->data[2];
+            RPDO->CANrxData[bufNo][3] = msg->data[3];
+            RPDO->CANrxData[bufNo][4] = msg->data[4];
+            RPDO->CANrxData[bufNo][5] = msg->data[5];
+            RPDO->CANrxData[bufNo][6] = msg->data[6];
+            RPDO->CANrxData[bufNo][7] = msg->data[7];
+#endif
+#if CO_RPDO_SEQLOCK > 0
+            CO_MEMORY_BARRIER();
+            RPDO->CANrxSeq[bufNo]++;
+#endif
+#if CO_CAN_TIMESTAMP > 0
+            RPDO->CANrxTimestamp[bufNo] = CO_CANrxMsg_readTimestamp(msg);
+#endif
 
-            RPDO->CANrxNew[0] = true;
+            RPDO->CANrxNew[bufNo] = true;
         }
     }
 }
@@ -124,7 +404,7 @@ static void CO_RPDOconfigCom(CO_RPDO_t* RPDO, uint32_t COB_IDUsedByRPDO){
         /* is used default COB-ID? */
         if(ID == RPDO->defaultCOB_ID) ID += RPDO->nodeId;
         RPDO->valid = true;
-        RPDO->synchronous = (RPDO->RPDOCommPar->transmissionType <= 240) ? true : false;
+        RPDO->synchronous = (RPDO->SYNC != NULL && RPDO->RPDOCommPar->transmissionType <= 240) ? true : false;
     }
     else{
         ID = 0;
@@ -202,6 +482,7 @@ static void CO_TPDOconfigCom(CO_TPDO_t* TPDO, uint32_t COB_IDUsedByTPDO, uint8_t
  * @param pLength Pointer to returning parameter: *add* length of mapped variable.
  * @param pSendIfCOSFlags Pointer to returning parameter: sendIfCOSFlags variable.
  * @param pIsMultibyteVar Pointer to returning parameter: true for multibyte variable.
+ * @param pEntryNo Pointer to returning parameter: entry number in OD, 0xFFFF for dummy entry.
  *
  * @return 0 on success, otherwise SDO abort code.
  */
@@ -211,8 +492,9 @@ static uint32_t CO_PDOfindMap(
         uint8_t                 R_T,
         uint8_t               **ppData,
         uint8_t                *pLength,
-        uint8_t                *pSendIfCOSFlags,
-        uint8_t                *pIsMultibyteVar)
+        CO_PDOcosFlags_t       *pSendIfCOSFlags,
+        uint8_t                *pIsMultibyteVar,
+        uint16_t               *pEntryNo)
 {
     uint16_t entryNo;
     uint16_t index;
@@ -231,8 +513,8 @@ static uint32_t CO_PDOfindMap(
     dataLen >>= 3;    /* new data length is in bytes */
     *pLength += dataLen;
 
-    /* total PDO length can not be more than 8 bytes */
-    if(*pLength > 8) return CO_SDO_AB_MAP_LEN;  /* The number and length of the objects to be mapped would exceed PDO length. */
+    /* total PDO length can not be more than CAN message data */
+    if(*pLength > CO_PDO_MAX_SIZE) return CO_SDO_AB_MAP_LEN;  /* The number and length of the objects to be mapped would exceed PDO length. */
 
     /* is there a reference to dummy entries */
     if(index <=7 && subIndex == 0){
@@ -250,12 +532,14 @@ static uint32_t CO_PDOfindMap(
         /* Data and ODE pointer */
         if(R_T == 0) *ppData = (uint8_t*) &dummyRX;
         else         *ppData = (uint8_t*) &dummyTX;
+        *pEntryNo = 0xFFFF;
 
         return 0;
     }
 
     /* find object in Object Dictionary */
     entryNo = CO_OD_find(SDO, index);
+    *pEntryNo = entryNo;
 
     /* Does object exist in OD? */
     if(entryNo == 0xFFFF || subIndex > SDO->OD[entryNo].maxSubIndex)
@@ -287,7 +571,7 @@ static uint32_t CO_PDOfindMap(
     if(attr&CO_ODA_TPDO_DETECT_COS){
         int16_t i;
         for(i=*pLength-dataLen; i<*pLength; i++){
-            *pSendIfCOSFlags |= 1<<i;
+            *pSendIfCOSFlags |= (CO_PDOcosFlags_t)1<<i;
         }
     }
 
@@ -295,13 +579,72 @@ static uint32_t CO_PDOfindMap(
 }
 
 
+#if CO_PDO_MPDO > 0
+/*
+ * Find object addressed by MPDO multiplexer, see CO_PDOfindMap(). Whole
+ * object is transferred, it may be up to 4 bytes long.
+ *
+ * @param pMap Pointer to returning parameter: PDO mapping parameter of the object.
+ *
+ * @return 0 on success, otherwise SDO abort code.
+ */
+static uint32_t CO_PDOmpdoFind(
+        CO_SDO_t               *SDO,
+        uint16_t                index,
+        uint8_t                 subIndex,
+        uint8_t                 R_T,
+        uint8_t               **ppData,
+        uint8_t                *pLength,
+        uint8_t                *pIsMultibyteVar,
+        uint16_t               *pEntryNo,
+        uint32_t               *pMap)
+{
+    uint16_t entryNo = CO_OD_find(SDO, index);
+    uint16_t length;
+    CO_PDOcosFlags_t dummy = 0;
+
+    if(entryNo == 0xFFFF || subIndex > SDO->OD[entryNo].maxSubIndex)
+        return CO_SDO_AB_NOT_EXIST;   /* Object does not exist in the object dictionary. */
+
+    length = CO_OD_getLength(SDO, entryNo, subIndex);
+    if(length == 0 || length > 4)
+        return CO_SDO_AB_NO_MAP;   /* Object cannot be mapped to the PDO. */
+
+    *pMap = ((uint32_t)index << 16) | ((uint32_t)subIndex << 8) | ((uint32_t)length << 3);
+    *pLength = 0;
+    return CO_PDOfindMap(SDO, *pMap, R_T, ppData, pLength, &dummy, pIsMultibyteVar, pEntryNo);
+}
+
+
+/*
+ * Copy MPDO data to or from OD variable, multibyte values are little endian
+ * in the message.
+ */
+static void CO_PDOmpdoCopy(uint8_t *dst, const uint8_t *src, uint8_t length, uint8_t MBvar){
+#ifdef CO_BIG_ENDIAN
+    if(MBvar){
+        uint8_t i;
+
+        for(i=0; i<length; i++){
+            dst[i] = src[length - 1 - i];
+        }
+        return;
+    }
+#else
+    (void)MBvar;
+#endif
+    memcpy(dst, src, length);
+}
+#endif
+
+
 /*
  * Configure RPDO Mapping parameter.
  *
  * Function is called from communication reset or when parameter changes.
  *
  * Function configures following variables from CO_RPDO_t: _dataLength_ and
- * _mapPointer_.
+ * _copyRun_.
  *
  * @param RPDO RPDO object.
  * @param noOfMappedObjects Number of mapped object (from OD).
@@ -311,15 +654,35 @@ static uint32_t CO_PDOfindMap(
 static uint32_t CO_RPDOconfigMap(CO_RPDO_t* RPDO, uint8_t noOfMappedObjects){
     int16_t i;
     uint8_t length = 0;
+    uint8_t count = noOfMappedObjects;
     uint32_t ret = 0;
     const uint32_t* pMap = &RPDO->RPDOMapPar->mappedObject1;
+    uint8_t* mapPointer[CO_PDO_MAX_SIZE];
+
+#if CO_PDO_MPDO > 0
+    /* MPDO objects are addressed by multiplexer of each message */
+    RPDO->mpdo = (noOfMappedObjects >= CO_PDO_MPDO_SAM) ? noOfMappedObjects : 0U;
+    RPDO->mpdoList = 0xFFFF;
+    if(RPDO->mpdo != 0U){
+        count = 0;
+    }
+    if(RPDO->mpdo == CO_PDO_MPDO_SAM){
+        RPDO->mpdoList = CO_OD_find(RPDO->SDO, CO_PDO_MPDO_DISPATCHER);
+        if(RPDO->mpdoList == 0xFFFF){
+            ret = CO_SDO_AB_NO_MAP;   /* Object cannot be mapped to the PDO. */
+            RPDO->mpdo = 0U;
+            CO_errorReport(RPDO->em, CO_EM_PDO_WRONG_MAPPING, CO_EMC_PROTOCOL_ERROR, (uint32_t)CO_PDO_MPDO_DISPATCHER << 16);
+        }
+    }
+#endif
 
-    for(i=noOfMappedObjects; i>0; i--){
+    for(i=count; i>0; i--){
         int16_t j;
         uint8_t* pData;
-        uint8_t dummy = 0;
+        CO_PDOcosFlags_t dummy = 0;
         uint8_t prevLength = length;
         uint8_t MBvar;
+        uint16_t entryNo;
         uint32_t map = *(pMap++);
 
         /* function do much checking of errors in map */
@@ -330,44 +693,111 @@ static uint32_t CO_RPDOconfigMap(CO_RPDO_t* RPDO, uint8_t noOfMappedObjects){
                 &pData,
                 &length,
                 &dummy,
-                &MBvar);
+                &MBvar,
+                &entryNo);
         if(ret){
             length = 0;
             CO_errorReport(RPDO->em, CO_EM_PDO_WRONG_MAPPING, CO_EMC_PROTOCOL_ERROR, map);
             break;
         }
+#ifdef RPDO_CALLS_EXTENSION
+        CO_PDOsetMapEntry(RPDO->SDO, &RPDO->mapEntry[count - i], map, entryNo);
+#endif
+#if CO_TPDO_DIRTY_FLAGS > 0
+        RPDO->dirtyEntry[count - i] = entryNo;
+#endif
+#if CO_RPDO_HANDLERS > 0
+        {
+            CO_RPDOfield_t *field = &RPDO->field[count - i];
+
+            field->pData = pData;
+            field->index = (uint16_t)(map>>16);
+            field->subIndex = (uint8_t)(map>>8);
+            field->length = length - prevLength;
+        }
+#endif
 
         /* write PDO data pointers */
 #ifdef CO_BIG_ENDIAN
         if(MBvar){
             for(j=length-1; j>=prevLength; j--)
-                RPDO->mapPointer[j] = pData++;
+                mapPointer[j] = pData++;
         }
         else{
             for(j=prevLength; j<length; j++)
-                RPDO->mapPointer[j] = pData++;
+                mapPointer[j] = pData++;
         }
 #else
         for(j=prevLength; j<length; j++){
-            RPDO->mapPointer[j] = pData++;
+            mapPointer[j] = pData++;
         }
 #endif
 
     }
 
     RPDO->dataLength = length;
+    RPDO->copyRunCount = CO_PDObuildCopyRuns(mapPointer, length, RPDO->copyRun);
+#ifdef RPDO_CALLS_EXTENSION
+    RPDO->mapEntryCount = (length != 0) ? count : 0;
+#endif
+#if CO_RPDO_HANDLERS > 0
+    RPDO->fieldCount = (length != 0) ? count : 0;
+#endif
+#if CO_TPDO_DIRTY_FLAGS > 0
+    RPDO->dirtyEntryCount = (length != 0) ? count : 0;
+#endif
+#if CO_PDO_MPDO > 0
+    if(RPDO->mpdo != 0U){
+        /* multiplexer and up to 4 data bytes */
+        RPDO->dataLength = 8;
+    }
+#endif
+#if CO_PDO_FAST_BOOT > 0
+    RPDO->mapFingerprint = CO_PDOmapFingerprint(noOfMappedObjects, &RPDO->RPDOMapPar->mappedObject1);
+    RPDO->mapValid = (ret == 0) ? true : false;
+#endif
 
     return ret;
 }
 
 
+#if CO_TPDO_DIRTY_FLAGS > 0
+/*
+ * Set reverse mapping from OD entries to TPDO and mark TPDO dirty.
+ *
+ * @param TPDO TPDO object.
+ * @param noOfMappedObjects Number of valid mapped objects, 0 clears mapping.
+ */
+static void CO_TPDOreverseMap(CO_TPDO_t* TPDO, uint8_t noOfMappedObjects){
+    if(TPDO->dirtyBit != 0U && TPDO->SDO->ODExtensions != NULL){
+        const uint32_t* pMap = &TPDO->TPDOMapPar->mappedObject1;
+        uint16_t entryNo;
+
+        for(entryNo=0; entryNo<TPDO->SDO->ODSize; entryNo++){
+            TPDO->SDO->ODExtensions[entryNo].TPDOmask &= ~TPDO->dirtyBit;
+        }
+        for(; noOfMappedObjects>0; noOfMappedObjects--){
+            entryNo = CO_OD_find(TPDO->SDO, (uint16_t)(*(pMap++)>>16));
+            if(entryNo != 0xFFFF){
+                TPDO->SDO->ODExtensions[entryNo].TPDOmask |= TPDO->dirtyBit;
+            }
+        }
+        /* verify new mapping once */
+        CO_LOCK_OD();
+        *TPDO->SDO->pTPDOdirty |= TPDO->dirtyBit;
+        CO_UNLOCK_OD();
+    }
+}
+#endif
+
+
 /*
  * Configure TPDO Mapping parameter.
  *
  * Function is called from communication reset or when parameter changes.
  *
  * Function configures following variables from CO_TPDO_t: _dataLength_,
- * _mapPointer_ and _sendIfCOSFlags_.
+ * _copyRun_, _sendIfCOSFlags_ and _sendIfCOSMask_.
  *
  * @param TPDO TPDO object.
  * @param noOfMappedObjects Number of mapped object (from OD).
@@ -377,16 +807,44 @@ static uint32_t CO_RPDOconfigMap(CO_RPDO_t* RPDO, uint8_t noOfMappedObjects){
 static uint32_t CO_TPDOconfigMap(CO_TPDO_t* TPDO, uint8_t noOfMappedObjects){
     int16_t i;
     uint8_t length = 0;
+    uint8_t count = noOfMappedObjects;
     uint32_t ret = 0;
     const uint32_t* pMap = &TPDO->TPDOMapPar->mappedObject1;
+    uint8_t* mapPointer[CO_PDO_MAX_SIZE];
 
     TPDO->sendIfCOSFlags = 0;
 
-    for(i=noOfMappedObjects; i>0; i--){
+#if CO_PDO_MPDO > 0
+    TPDO->mpdo = (noOfMappedObjects >= CO_PDO_MPDO_SAM) ? noOfMappedObjects : 0U;
+    TPDO->mpdoList = 0xFFFF;
+    if(TPDO->mpdo == CO_PDO_MPDO_SAM){
+        /* objects are taken from object scanner list by CO_TPDOsend() */
+        count = 0;
+        TPDO->mpdoScan = 0;
+        TPDO->mpdoBlock = 0;
+        TPDO->mpdoList = CO_OD_find(TPDO->SDO, CO_PDO_MPDO_SCANNER);
+        if(TPDO->mpdoList == 0xFFFF){
+            ret = CO_SDO_AB_NO_MAP;   /* Object cannot be mapped to the PDO. */
+            TPDO->mpdo = 0U;
+            CO_errorReport(TPDO->em, CO_EM_PDO_WRONG_MAPPING, CO_EMC_PROTOCOL_ERROR, (uint32_t)CO_PDO_MPDO_SCANNER << 16);
+        }
+    }
+    else if(TPDO->mpdo == CO_PDO_MPDO_DAM){
+        /* multiplexer is followed by one mapped object */
+        count = 1;
+        for(i=0; i<4; i++){
+            mapPointer[i] = &TPDO->mpdoMux[i];
+        }
+        length = 4;
+    }
+#endif
+
+    for(i=count; i>0; i--){
         int16_t j;
         uint8_t* pData;
         uint8_t prevLength = length;
         uint8_t MBvar;
+        uint16_t entryNo;
         uint32_t map = *(pMap++);
 
         /* function do much checking of errors in map */
@@ -397,84 +855,345 @@ static uint32_t CO_TPDOconfigMap(CO_TPDO_t* TPDO, uint8_t noOfMappedObjects){
                 &pData,
                 &length,
                 &TPDO->sendIfCOSFlags,
-                &MBvar);
+                &MBvar,
+                &entryNo);
         if(ret){
             length = 0;
             CO_errorReport(TPDO->em, CO_EM_PDO_WRONG_MAPPING, CO_EMC_PROTOCOL_ERROR, map);
             break;
         }
+#ifdef TPDO_CALLS_EXTENSION
+        CO_PDOsetMapEntry(TPDO->SDO, &TPDO->mapEntry[count - i], map, entryNo);
+#endif
 
         /* write PDO data pointers */
 #ifdef CO_BIG_ENDIAN
         if(MBvar){
             for(j=length-1; j>=prevLength; j--)
-                TPDO->mapPointer[j] = pData++;
+                mapPointer[j] = pData++;
         }
         else{
             for(j=prevLength; j<length; j++)
-                TPDO->mapPointer[j] = pData++;
+                mapPointer[j] = pData++;
         }
 #else
         for(j=prevLength; j<length; j++){
-            TPDO->mapPointer[j] = pData++;
+            mapPointer[j] = pData++;
         }
 #endif
 
     }
 
+#if CO_PDO_MPDO > 0
+    if(TPDO->mpdo == CO_PDO_MPDO_DAM && ret == 0){
+        if(length > 8){
+            ret = CO_SDO_AB_MAP_LEN;  /* The number and length of the objects to be mapped would exceed PDO length. */
+            length = 0;
+            CO_errorReport(TPDO->em, CO_EM_PDO_WRONG_MAPPING, CO_EMC_PROTOCOL_ERROR, TPDO->TPDOMapPar->mappedObject1);
+        }
+        else{
+            TPDO->mpdoMux[0] = 0x80U | TPDO->mpdoDest;
+            TPDO->mpdoMux[1] = (uint8_t)(TPDO->TPDOMapPar->mappedObject1 >> 16);
+            TPDO->mpdoMux[2] = (uint8_t)(TPDO->TPDOMapPar->mappedObject1 >> 24);
+            TPDO->mpdoMux[3] = (uint8_t)(TPDO->TPDOMapPar->mappedObject1 >> 8);
+        }
+    }
+#endif
+
     TPDO->dataLength = length;
+    TPDO->copyRunCount = CO_PDObuildCopyRuns(mapPointer, length, TPDO->copyRun);
+#ifdef TPDO_CALLS_EXTENSION
+    TPDO->mapEntryCount = (length != 0) ? count : 0;
+#endif
+#if CO_PDO_MPDO > 0
+    if(TPDO->mpdo != 0U && ret == 0){
+        /* multiplexer and up to 4 data bytes, unused bytes stay zero */
+        TPDO->dataLength = 8;
+    }
+#endif
+
+#if CO_TPDO_DIRTY_FLAGS > 0
+    CO_TPDOreverseMap(TPDO, (ret == 0) ? count : 0);
+#endif
+#if CO_PDO_FAST_BOOT > 0
+    TPDO->mapFingerprint = CO_PDOmapFingerprint(noOfMappedObjects, &TPDO->TPDOMapPar->mappedObject1);
+    TPDO->mapValid = (ret == 0) ? true : false;
+#endif
+
+#if CO_PDO_MAX_SIZE <= 8
+    /* byte mask in the order of PDO data */
+    {
+        uint8_t mask[8];
+
+        for(i=0; i<8; i++){
+            mask[i] = (i < length && (TPDO->sendIfCOSFlags & (1U << i))) ? 0xFFU : 0U;
+        }
+        memcpy(&TPDO->sendIfCOSMask, mask, 8);
+    }
+#endif
 
     return ret;
 }
 
 
+#if CO_PDO_SHADOW_MAP > 0
 /*
- * Function for accessing _RPDO communication parameter_ (index 0x1400+) from SDO server.
+ * Check, if mapping is valid for PDO, without changing it.
  *
- * For more information see file CO_SDO.h.
+ * Mapping is compiled into a copy of PDO object on stack, which does not
+ * report emergencies and does not touch reverse mapping.
+ *
+ * @return 0 on success, otherwise SDO abort code.
  */
-static CO_SDO_abortCode_t CO_ODF_RPDOcom(CO_ODF_arg_t *ODF_arg){
-    CO_RPDO_t *RPDO;
-
-    RPDO = (CO_RPDO_t*) ODF_arg->object;
+static uint32_t CO_RPDOcheckMap(const CO_RPDO_t *RPDO, const CO_PDOshadowMap_t *shadow){
+    CO_RPDO_t check = *RPDO;
+    CO_RPDOMapPar_t mapPar;
+    uint32_t *pMap = &mapPar.mappedObject1;
+    uint8_t i;
+
+    mapPar.numberOfMappedObjects = shadow->numberOfMappedObjects;
+    for(i=0; i<8; i++){
+        pMap[i] = shadow->mappedObject[i];
+    }
+    check.em = NULL;
+    check.RPDOMapPar = &mapPar;
 
-    /* Reading Object Dictionary variable */
-    if(ODF_arg->reading){
-        if(ODF_arg->subIndex == 1){
-            uint32_t *value = (uint32_t*) ODF_arg->data;
+    return CO_RPDOconfigMap(&check, mapPar.numberOfMappedObjects);
+}
 
-            /* if default COB ID is used, write default value here */
-            if(((*value)&0xFFFF) == RPDO->defaultCOB_ID && RPDO->defaultCOB_ID)
-                *value += RPDO->nodeId;
 
-            /* If PDO is not valid, set bit 31 */
-            if(!RPDO->valid) *value |= 0x80000000L;
-        }
-        return CO_SDO_AB_NONE;
+/*
+ * The same as above for TPDO.
+ */
+static uint32_t CO_TPDOcheckMap(const CO_TPDO_t *TPDO, const CO_PDOshadowMap_t *shadow){
+    CO_TPDO_t check = *TPDO;
+    CO_TPDOMapPar_t mapPar;
+    uint32_t *pMap = &mapPar.mappedObject1;
+    uint8_t i;
+
+    mapPar.numberOfMappedObjects = shadow->numberOfMappedObjects;
+    for(i=0; i<8; i++){
+        pMap[i] = shadow->mappedObject[i];
     }
+    check.em = NULL;
+    check.TPDOMapPar = &mapPar;
+#if CO_TPDO_DIRTY_FLAGS > 0
+    check.dirtyBit = 0U;
+#endif
 
-    /* Writing Object Dictionary variable */
-    if(RPDO->restrictionFlags & 0x04)
-        return CO_SDO_AB_READONLY;  /* Attempt to write a read only object. */
-    if(*RPDO->operatingState == CO_NMT_OPERATIONAL && (RPDO->restrictionFlags & 0x01))
-        return CO_SDO_AB_DATA_DEV_STATE;   /* Data cannot be transferred or stored to the application because of the present device state. */
+    return CO_TPDOconfigMap(&check, mapPar.numberOfMappedObjects);
+}
 
-    if(ODF_arg->subIndex == 1){   /* COB_ID */
-        uint32_t *value = (uint32_t*) ODF_arg->data;
 
-        /* bits 11...29 must be zero */
-        if(*value & 0x3FFF8000L)
-            return CO_SDO_AB_INVALID_VALUE;  /* Invalid value for parameter (download only). */
+/*
+ * Start shadow as copy of active mapping, if it is not used yet.
+ *
+ * @return CO_SDO_AB_DATA_DEV_STATE, if shadow waits for activation, otherwise 0.
+ */
+static uint32_t CO_PDOshadowOpen(CO_PDOshadowMap_t *shadow, uint8_t noOfMappedObjects, const uint32_t *pMap){
+    uint8_t i;
 
-        /* if default COB-ID is being written, write defaultCOB_ID without nodeId */
-        if(((*value)&0xFFFF) == (RPDO->defaultCOB_ID + RPDO->nodeId)){
-            *value &= 0xC0000000L;
-            *value += RPDO->defaultCOB_ID;
+    if(shadow->state == CO_PDO_SHADOW_PENDING){
+        return CO_SDO_AB_DATA_DEV_STATE;
+    }
+    if(shadow->state == CO_PDO_SHADOW_IDLE){
+        shadow->numberOfMappedObjects = noOfMappedObjects;
+        for(i=0; i<8; i++){
+            shadow->mappedObject[i] = pMap[i];
         }
+        shadow->state = CO_PDO_SHADOW_EDIT;
+    }
 
-        /* if PDO is valid, bits 0..29 can not be changed */
-        if(RPDO->valid && ((*value ^ RPDO->RPDOCommPar->COB_IDUsedByRPDO) & 0x3FFFFFFFL))
-            return CO_SDO_AB_INVALID_VALUE;  /* Invalid value for parameter (download only). */
+    return 0;
+}
+
+
+/*
+ * Validate mapping in shadow and pass it to CO_R(T)PDO_process().
+ *
+ * @param shadow Shadow, numberOfMappedObjects and mappedObject are set.
+ * @param ret Result of CO_R(T)PDOcheckMap().
+ *
+ * @return ret.
+ */
+static uint32_t CO_PDOshadowStage(CO_PDOshadowMap_t *shadow, uint32_t ret){
+    if(ret == 0){
+        /* mapping is written before the state */
+        CO_MEMORY_BARRIER();
+        shadow->state = CO_PDO_SHADOW_PENDING;
+    }
+    else{
+        /* SDO client may correct the mapping */
+        shadow->state = CO_PDO_SHADOW_EDIT;
+    }
+
+    return ret;
+}
+
+
+/*
+ * Write SDO data of mapping parameter into shadow, while PDO is valid.
+ *
+ * Mapped object is verified with CO_PDOfindMap(). Data is replaced with the
+ * active value, so OD keeps the active mapping until CO_R(T)PDO_process().
+ *
+ * @param ODF_arg Argument of mapping parameter ODF, subIndex is 1 to 8.
+ * @param R_T 0 for RPDO map, 1 for TPDO map.
+ *
+ * @return 0 on success, otherwise SDO abort code.
+ */
+static uint32_t CO_PDOshadowWrite(
+        CO_SDO_t               *SDO,
+        CO_ODF_arg_t           *ODF_arg,
+        uint8_t                 R_T,
+        CO_PDOshadowMap_t      *shadow,
+        uint8_t                 noOfMappedObjects,
+        const uint32_t         *pMap)
+{
+    uint32_t *value = (uint32_t*) ODF_arg->data;
+    uint8_t* pData;
+    uint8_t length = 0;
+    CO_PDOcosFlags_t dummy = 0;
+    uint8_t MBvar;
+    uint16_t entryNo;
+    uint32_t ret;
+
+    ret = CO_PDOshadowOpen(shadow, noOfMappedObjects, pMap);
+    if(ret == 0){
+        ret = CO_PDOfindMap(SDO, *value, R_T, &pData, &length, &dummy, &MBvar, &entryNo);
+    }
+    if(ret == 0){
+        shadow->mappedObject[ODF_arg->subIndex - 1] = *value;
+        *value = pMap[ODF_arg->subIndex - 1];
+    }
+
+    return ret;
+}
+
+
+/*
+ * Write mapping from shadow into OD.
+ *
+ * Mapping parameter is in OD RAM, it is const only for the PDO object.
+ */
+static void CO_PDOshadowWriteOD(CO_SDO_t *SDO, const CO_PDOshadowMap_t *shadow, uint8_t *pNoOfMappedObjects, uint32_t *pMap){
+    uint8_t i;
+
+    CO_LOCK_OD();
+#if CO_OD_ATOMIC > 0
+    CO_OD_writeBegin(SDO);
+#else
+    (void)SDO;
+#endif
+    for(i=0; i<8; i++){
+        pMap[i] = shadow->mappedObject[i];
+    }
+    *pNoOfMappedObjects = shadow->numberOfMappedObjects;
+#if CO_OD_ATOMIC > 0
+    CO_OD_writeEnd(SDO);
+#endif
+    CO_UNLOCK_OD();
+}
+
+
+/*
+ * Activate staged RPDO mapping, called from CO_RPDO_process().
+ *
+ * Mapping was validated, so CO_RPDOconfigMap() only compiles it. It runs with
+ * CAN interrupts locked, so receive interrupt sees either old or new mapping.
+ * Buffered messages belong to the old mapping and are dropped.
+ */
+static void CO_RPDOshadowCommit(CO_RPDO_t *RPDO){
+    CO_PDOshadowMap_t *shadow = &RPDO->shadow;
+
+    /* mapping was written before the state */
+    CO_MEMORY_BARRIER();
+    CO_PDOshadowWriteOD(RPDO->SDO, shadow,
+            (uint8_t*)&RPDO->RPDOMapPar->numberOfMappedObjects,
+            (uint32_t*)&RPDO->RPDOMapPar->mappedObject1);
+
+    CO_LOCK_CAN_SEND();
+    CO_RPDOconfigMap(RPDO, shadow->numberOfMappedObjects);
+    RPDO->CANrxNew[0] = RPDO->CANrxNew[1] = false;
+#if CO_PDO_MPDO > 0
+    RPDO->mpdoTail = RPDO->mpdoHead;
+#endif
+    CO_UNLOCK_CAN_SEND();
+
+    shadow->state = CO_PDO_SHADOW_IDLE;
+}
+
+
+/*
+ * Activate staged TPDO mapping, called from CO_TPDO_process().
+ *
+ * CAN interrupts are locked for TPDO stream and SYNC callback.
+ */
+static void CO_TPDOshadowCommit(CO_TPDO_t *TPDO){
+    CO_PDOshadowMap_t *shadow = &TPDO->shadow;
+
+    /* mapping was written before the state */
+    CO_MEMORY_BARRIER();
+    CO_PDOshadowWriteOD(TPDO->SDO, shadow,
+            (uint8_t*)&TPDO->TPDOMapPar->numberOfMappedObjects,
+            (uint32_t*)&TPDO->TPDOMapPar->mappedObject1);
+
+    CO_LOCK_CAN_SEND();
+    CO_TPDOconfigMap(TPDO, shadow->numberOfMappedObjects);
+    CO_UNLOCK_CAN_SEND();
+
+    shadow->state = CO_PDO_SHADOW_IDLE;
+}
+#endif
+
+
+/*
+ * Function for accessing _RPDO communication parameter_ (index 0x1400+) from SDO server.
+ *
+ * For more information see file CO_SDO.h.
+ */
+static CO_SDO_abortCode_t CO_ODF_RPDOcom(CO_ODF_arg_t *ODF_arg){
+    CO_RPDO_t *RPDO;
+
+    RPDO = (CO_RPDO_t*) ODF_arg->object;
+
+    /* Reading Object Dictionary variable */
+    if(ODF_arg->reading){
+        if(ODF_arg->subIndex == 1){
+            uint32_t *value = (uint32_t*) ODF_arg->data;
+
+            /* if default COB ID is used, write default value here */
+            if(((*value)&0xFFFF) == RPDO->defaultCOB_ID && RPDO->defaultCOB_ID)
+                *value += RPDO->nodeId;
+
+            /* If PDO is not valid, set bit 31 */
+            if(!RPDO->valid) *value |= 0x80000000L;
+        }
+        return CO_SDO_AB_NONE;
+    }
+
+    /* Writing Object Dictionary variable */
+    if(RPDO->restrictionFlags & 0x04)
+        return CO_SDO_AB_READONLY;  /* Attempt to write a read only object. */
+    if(*RPDO->operatingState == CO_NMT_OPERATIONAL && (RPDO->restrictionFlags & 0x01))
+        return CO_SDO_AB_DATA_DEV_STATE;   /* Data cannot be transferred or stored to the application because of the present device state. */
+
+    if(ODF_arg->subIndex == 1){   /* COB_ID */
+        uint32_t *value = (uint32_t*) ODF_arg->data;
+
+        /* bits 11...29 must be zero */
+        if(*value & 0x3FFF8000L)
+            return CO_SDO_AB_INVALID_VALUE;  /* Invalid value for parameter (download only). */
+
+        /* if default COB-ID is being written, write defaultCOB_ID without nodeId */
+        if(((*value)&0xFFFF) == (RPDO->defaultCOB_ID + RPDO->nodeId)){
+            *value &= 0xC0000000L;
+            *value += RPDO->defaultCOB_ID;
+        }
+
+        /* if PDO is valid, bits 0..29 can not be changed */
+        if(RPDO->valid && ((*value ^ RPDO->RPDOCommPar->COB_IDUsedByRPDO) & 0x3FFFFFFFL))
+            return CO_SDO_AB_INVALID_VALUE;  /* Invalid value for parameter (download only). */
 
         /* configure RPDO */
         CO_RPDOconfigCom(RPDO, *value);
@@ -487,7 +1206,7 @@ static CO_SDO_abortCode_t CO_ODF_RPDOcom(CO_ODF_arg_t *ODF_arg){
         if(*value >= 241 && *value <= 253)
             return CO_SDO_AB_INVALID_VALUE;  /* Invalid value for parameter (download only). */
 
-        RPDO->synchronous = (*value <= 240) ? true : false;
+        RPDO->synchronous = (RPDO->SYNC != NULL && *value <= 240) ? true : false;
 
         /* Remove old message from second buffer. */
         if(RPDO->synchronous != synchronousPrev) {
@@ -561,6 +1280,7 @@ static CO_SDO_abortCode_t CO_ODF_TPDOcom(CO_ODF_arg_t *ODF_arg){
             return CO_SDO_AB_INVALID_VALUE;  /* Invalid value for parameter (download only). */
         TPDO->CANtxBuff->syncFlag = (*value <= 240) ? 1 : 0;
         TPDO->syncCounter = 255;
+        TPDO->transmissionType = *value;
     }
     else if(ODF_arg->subIndex == 3){   /* Inhibit_Time */
         /* if PDO is valid, value can not be changed */
@@ -568,11 +1288,19 @@ static CO_SDO_abortCode_t CO_ODF_TPDOcom(CO_ODF_arg_t *ODF_arg){
             return CO_SDO_AB_INVALID_VALUE;  /* Invalid value for parameter (download only). */
 
         TPDO->inhibitTimer = 0;
+        TPDO->inhibitTime_us = ((uint32_t) *((uint16_t*) ODF_arg->data)) * 100;
+#if CO_TPDO_CALENDAR > 0
+        TPDO->calReschedule = true;
+#endif
     }
     else if(ODF_arg->subIndex == 5){   /* Event_Timer */
         uint16_t *value = (uint16_t*) ODF_arg->data;
 
         TPDO->eventTimer = ((uint32_t) *value) * 1000;
+        TPDO->eventTime_us = TPDO->eventTimer;
+#if CO_TPDO_CALENDAR > 0
+        TPDO->calReschedule = true;
+#endif
     }
     else if(ODF_arg->subIndex == 6){   /* SYNC start value */
         uint8_t *value = (uint8_t*) ODF_arg->data;
@@ -616,6 +1344,26 @@ static CO_SDO_abortCode_t CO_ODF_RPDOmap(CO_ODF_arg_t *ODF_arg){
         return CO_SDO_AB_READONLY;  /* Attempt to write a read only object. */
     if(*RPDO->operatingState == CO_NMT_OPERATIONAL && (RPDO->restrictionFlags & 0x02))
         return CO_SDO_AB_DATA_DEV_STATE;   /* Data cannot be transferred or stored to the application because of the present device state. */
+#if CO_PDO_SHADOW_MAP > 0
+    if(RPDO->valid){
+        /* new mapping goes into shadow, OD keeps the active one */
+        const uint32_t *pMap = &RPDO->RPDOMapPar->mappedObject1;
+        uint8_t noOfMappedObjects = RPDO->RPDOMapPar->numberOfMappedObjects;
+
+        if(ODF_arg->subIndex == 0){
+            uint8_t *value = (uint8_t*) ODF_arg->data;
+            uint32_t ret = CO_PDOshadowOpen(&RPDO->shadow, noOfMappedObjects, pMap);
+
+            if(ret == 0){
+                ret = CO_RPDO_stageMap(RPDO, *value, RPDO->shadow.mappedObject);
+            }
+            *value = noOfMappedObjects;
+            return (CO_SDO_abortCode_t) ret;
+        }
+        return (CO_SDO_abortCode_t) CO_PDOshadowWrite(
+                RPDO->SDO, ODF_arg, 0, &RPDO->shadow, noOfMappedObjects, pMap);
+    }
+#endif
     if(RPDO->valid)
         return CO_SDO_AB_UNSUPPORTED_ACCESS;  /* Unsupported access to an object. */
 
@@ -623,7 +1371,11 @@ static CO_SDO_abortCode_t CO_ODF_RPDOmap(CO_ODF_arg_t *ODF_arg){
     if(ODF_arg->subIndex == 0){
         uint8_t *value = (uint8_t*) ODF_arg->data;
 
+#if CO_PDO_MPDO > 0
+        if(*value > 8 && *value < CO_PDO_MPDO_SAM)
+#else
         if(*value > 8)
+#endif
             return CO_SDO_AB_MAP_LEN;  /* Number and length of object to be mapped exceeds PDO length. */
 
         /* configure mapping */
@@ -635,8 +1387,9 @@ static CO_SDO_abortCode_t CO_ODF_RPDOmap(CO_ODF_arg_t *ODF_arg){
         uint32_t *value = (uint32_t*) ODF_arg->data;
         uint8_t* pData;
         uint8_t length = 0;
-        uint8_t dummy = 0;
+        CO_PDOcosFlags_t dummy = 0;
         uint8_t MBvar;
+        uint16_t entryNo;
 
         if(RPDO->dataLength)
             return CO_SDO_AB_UNSUPPORTED_ACCESS;  /* Unsupported access to an object. */
@@ -649,7 +1402,8 @@ static CO_SDO_abortCode_t CO_ODF_RPDOmap(CO_ODF_arg_t *ODF_arg){
                &pData,
                &length,
                &dummy,
-               &MBvar);
+               &MBvar,
+               &entryNo);
     }
 
     return CO_SDO_AB_NONE;
@@ -682,6 +1436,26 @@ static CO_SDO_abortCode_t CO_ODF_TPDOmap(CO_ODF_arg_t *ODF_arg){
         return CO_SDO_AB_READONLY;  /* Attempt to write a read only object. */
     if(*TPDO->operatingState == CO_NMT_OPERATIONAL && (TPDO->restrictionFlags & 0x02))
         return CO_SDO_AB_DATA_DEV_STATE;   /* Data cannot be transferred or stored to the application because of the present device state. */
+#if CO_PDO_SHADOW_MAP > 0
+    if(TPDO->valid){
+        /* new mapping goes into shadow, OD keeps the active one */
+        const uint32_t *pMap = &TPDO->TPDOMapPar->mappedObject1;
+        uint8_t noOfMappedObjects = TPDO->TPDOMapPar->numberOfMappedObjects;
+
+        if(ODF_arg->subIndex == 0){
+            uint8_t *value = (uint8_t*) ODF_arg->data;
+            uint32_t ret = CO_PDOshadowOpen(&TPDO->shadow, noOfMappedObjects, pMap);
+
+            if(ret == 0){
+                ret = CO_TPDO_stageMap(TPDO, *value, TPDO->shadow.mappedObject);
+            }
+            *value = noOfMappedObjects;
+            return (CO_SDO_abortCode_t) ret;
+        }
+        return (CO_SDO_abortCode_t) CO_PDOshadowWrite(
+                TPDO->SDO, ODF_arg, 1, &TPDO->shadow, noOfMappedObjects, pMap);
+    }
+#endif
     if(TPDO->valid)
         return CO_SDO_AB_UNSUPPORTED_ACCESS;  /* Unsupported access to an object. */
 
@@ -689,7 +1463,11 @@ static CO_SDO_abortCode_t CO_ODF_TPDOmap(CO_ODF_arg_t *ODF_arg){
     if(ODF_arg->subIndex == 0){
         uint8_t *value = (uint8_t*) ODF_arg->data;
 
+#if CO_PDO_MPDO > 0
+        if(*value > 8 && *value < CO_PDO_MPDO_SAM)
+#else
         if(*value > 8)
+#endif
             return CO_SDO_AB_MAP_LEN;  /* Number and length of object to be mapped exceeds PDO length. */
 
         /* configure mapping */
@@ -701,8 +1479,9 @@ static CO_SDO_abortCode_t CO_ODF_TPDOmap(CO_ODF_arg_t *ODF_arg){
         uint32_t *value = (uint32_t*) ODF_arg->data;
         uint8_t* pData;
         uint8_t length = 0;
-        uint8_t dummy = 0;
+        CO_PDOcosFlags_t dummy = 0;
         uint8_t MBvar;
+        uint16_t entryNo;
 
         if(TPDO->dataLength)
             return CO_SDO_AB_UNSUPPORTED_ACCESS;  /* Unsupported access to an object. */
@@ -715,7 +1494,8 @@ static CO_SDO_abortCode_t CO_ODF_TPDOmap(CO_ODF_arg_t *ODF_arg){
                &pData,
                &length,
                &dummy,
-               &MBvar);
+               &MBvar,
+               &entryNo);
     }
 
     return CO_SDO_AB_NONE;
@@ -740,7 +1520,7 @@ CO_ReturnError_t CO_RPDO_init(
         uint16_t                CANdevRxIdx)
 {
     /* verify arguments */
-    if(RPDO==NULL || em==NULL || SDO==NULL || SYNC==NULL || operatingState==NULL ||
+    if(RPDO==NULL || em==NULL || SDO==NULL || operatingState==NULL ||
         RPDOCommPar==NULL || RPDOMapPar==NULL || CANdevRx==NULL){
         return CO_ERROR_ILLEGAL_ARGUMENT;
     }
@@ -764,14 +1544,108 @@ CO_ReturnError_t CO_RPDO_init(
     RPDO->CANrxNew[0] = RPDO->CANrxNew[1] = false;
     RPDO->CANdevRx = CANdevRx;
     RPDO->CANdevRxIdx = CANdevRxIdx;
+    RPDO->immediate = false;
+    RPDO->functSignalObject = NULL;
+    RPDO->pFunctSignal = NULL;
+#if CO_RPDO_HANDLERS > 0
+    RPDO->handlerObject = NULL;
+    RPDO->pFunctHandler = NULL;
+#endif
+#if CO_RPDO_SEQLOCK > 0
+    RPDO->CANrxSeq[0] = RPDO->CANrxSeq[1] = 0U;
+    RPDO->direct = false;
+#endif
+#if CO_PDO_MPDO > 0
+    RPDO->mpdoHead = RPDO->mpdoTail = 0U;
+    RPDO->mpdoOverflow = 0U;
+    RPDO->mpdoIgnored = 0U;
+#endif
+#if CO_PDO_SHADOW_MAP > 0
+    RPDO->shadow.state = CO_PDO_SHADOW_IDLE;
+#endif
 
-    CO_RPDOconfigMap(RPDO, RPDOMapPar->numberOfMappedObjects);
+#if CO_PDO_FAST_BOOT > 0
+    if(RPDO->mapValid && RPDO->mapFingerprint ==
+        CO_PDOmapFingerprint(RPDOMapPar->numberOfMappedObjects, &RPDOMapPar->mappedObject1))
+    {
+        /* mapping unchanged since last CO_RPDOconfigMap(), keep copy runs */
+    }
+    else
+#endif
+    {
+        CO_RPDOconfigMap(RPDO, RPDOMapPar->numberOfMappedObjects);
+    }
     CO_RPDOconfigCom(RPDO, RPDOCommPar->COB_IDUsedByRPDO);
 
     return CO_ERROR_NO;
 }
 
 
+/******************************************************************************/
+void CO_RPDO_initCallback(
+        CO_RPDO_t              *RPDO,
+        bool_t                  immediate,
+        void                   *object,
+        void                  (*pFunctSignal)(void *object))
+{
+    if(RPDO != NULL){
+        RPDO->immediate = immediate;
+        RPDO->functSignalObject = object;
+        RPDO->pFunctSignal = pFunctSignal;
+    }
+}
+
+
+#if CO_RPDO_HANDLERS > 0
+/******************************************************************************/
+void CO_RPDO_initHandler(
+        CO_RPDO_t              *RPDO,
+        void                   *object,
+        void                  (*pFunctHandler)(void *object, const CO_RPDOfield_t *field, uint8_t count))
+{
+    if(RPDO != NULL){
+        RPDO->handlerObject = object;
+        RPDO->pFunctHandler = pFunctHandler;
+    }
+}
+#endif
+
+
+#if CO_RPDO_SEQLOCK > 0
+/******************************************************************************/
+uint32_t CO_RPDO_readData(const CO_RPDO_t *RPDO, uint8_t *data){
+    uint8_t bufNo;
+    uint32_t seq;
+
+    /* SYNC reception toggles the buffers, take the buffer once */
+    CO_LOCK_CAN_SEND();
+    bufNo = (RPDO->synchronous && !RPDO->SYNC->CANrxToggle) ? 1 : 0;
+    CO_UNLOCK_CAN_SEND();
+
+    for(;;){
+        seq = RPDO->CANrxSeq[bufNo];
+        CO_MEMORY_BARRIER();
+        memcpy(data, &RPDO->CANrxData[bufNo][0], CO_PDO_MAX_SIZE);
+        CO_MEMORY_BARRIER();
+        /* retry, if receive interrupt has written the buffer meanwhile */
+        if((seq & 1U) == 0U && seq == RPDO->CANrxSeq[bufNo]){
+            break;
+        }
+    }
+
+    return seq;
+}
+
+
+/******************************************************************************/
+void CO_RPDO_setDirect(CO_RPDO_t *RPDO, bool_t direct){
+    if(RPDO != NULL){
+        RPDO->direct = direct;
+    }
+}
+#endif
+
+
 /******************************************************************************/
 CO_ReturnError_t CO_TPDO_init(
         CO_TPDO_t              *TPDO,
@@ -803,6 +1677,27 @@ CO_ReturnError_t CO_TPDO_init(
     TPDO->nodeId = nodeId;
     TPDO->defaultCOB_ID = defaultCOB_ID;
     TPDO->restrictionFlags = restrictionFlags;
+#if CO_TPDO_DIRTY_FLAGS > 0
+    TPDO->dirtyBit = (idx_TPDOCommPar >= 0x1800 && idx_TPDOCommPar < 0x1820) ?
+                     (1UL << (idx_TPDOCommPar - 0x1800)) : 0U;
+#endif
+#if CO_TPDO_SYNC_PHASE > 0
+    TPDO->syncPhase = (uint8_t)(nodeId + ((idx_TPDOCommPar >= 0x1800 && idx_TPDOCommPar < 0x1A00) ?
+                      (idx_TPDOCommPar - 0x1800U) : 0U));
+#endif
+#if CO_TPDO_STREAM > 0
+    TPDO->stream = false;
+#endif
+#if CO_TPDO_PRESTAGE > 0
+    TPDO->stageState = CO_TPDO_STAGE_OFF;
+    TPDO->stageLate = false;
+#endif
+#if CO_PDO_MPDO > 0
+    CO_TPDO_setMPDOdest(TPDO, 0U);
+#endif
+#if CO_PDO_SHADOW_MAP > 0
+    TPDO->shadow.state = CO_PDO_SHADOW_IDLE;
+#endif
 
     /* Configure Object dictionary entry at index 0x1800+ and 0x1A00+ */
     CO_OD_configure(SDO, idx_TPDOCommPar, CO_ODF_TPDOcom, (void*)TPDO, 0, 0);
@@ -814,9 +1709,34 @@ CO_ReturnError_t CO_TPDO_init(
     TPDO->syncCounter = 255;
     TPDO->inhibitTimer = 0;
     TPDO->eventTimer = ((uint32_t) TPDOCommPar->eventTimer) * 1000;
+    TPDO->transmissionType = TPDOCommPar->transmissionType;
+    TPDO->inhibitTime_us = ((uint32_t) TPDOCommPar->inhibitTime) * 100;
+#if CO_TPDO_ADAPTIVE_INHIBIT > 0
+    TPDO->inhibitScale = 256U;
+#endif
+    TPDO->eventTime_us = TPDO->eventTimer;
     if(TPDOCommPar->transmissionType>=254) TPDO->sendRequest = 1;
+#if CO_TPDO_CALENDAR > 0
+    TPDO->calPos = CO_TPDO_CAL_NONE;
+    TPDO->calKey = 0U;
+    TPDO->calReschedule = true;
+#endif
 
-    CO_TPDOconfigMap(TPDO, TPDOMapPar->numberOfMappedObjects);
+#if CO_PDO_FAST_BOOT > 0
+    if(TPDO->mapValid && TPDO->mapFingerprint ==
+        CO_PDOmapFingerprint(TPDOMapPar->numberOfMappedObjects, &TPDOMapPar->mappedObject1))
+    {
+        /* mapping unchanged since last CO_TPDOconfigMap(), keep copy runs,
+         * CO_SDO_init() cleared reverse mapping */
+  #if CO_TPDO_DIRTY_FLAGS > 0
+        CO_TPDOreverseMap(TPDO, TPDOMapPar->numberOfMappedObjects);
+  #endif
+    }
+    else
+#endif
+    {
+        CO_TPDOconfigMap(TPDO, TPDOMapPar->numberOfMappedObjects);
+    }
     CO_TPDOconfigCom(TPDO, TPDOCommPar->COB_IDUsedByTPDO, ((TPDOCommPar->transmissionType<=240) ? 1 : 0));
 
     if((TPDOCommPar->transmissionType>240 &&
@@ -829,87 +1749,361 @@ CO_ReturnError_t CO_TPDO_init(
 }
 
 
+#if CO_TPDO_SYNC_PHASE > 0
+/*
+ * Start cyclic synchronous TPDO with automatic phase, if SYNCStartValue is 0.
+ * With SYNC counter, phase is the start value, so it is the same SYNC on all
+ * nodes. Otherwise TPDO is first sent at SYNC number phase + 1 after start.
+ */
+CO_RAMFUNC static void CO_TPDOsyncPhaseStart(CO_TPDO_t *TPDO, const CO_SYNC_t *SYNC){
+    uint8_t start = TPDO->TPDOCommPar->SYNCStartValue;
+    uint8_t period = TPDO->transmissionType;
+
+    if(start == 0U && period > 1U){
+        if(SYNC->counterOverflowValue == 0U){
+            /* decremented by the caller at this SYNC */
+            TPDO->syncCounter = (uint8_t)(TPDO->syncPhase % period) + 1U;
+            return;
+        }
+        if(period > SYNC->counterOverflowValue){
+            period = SYNC->counterOverflowValue;
+        }
+        start = (uint8_t)(TPDO->syncPhase % period) + 1U;
+    }
+    TPDO->syncStart = start;
+    TPDO->syncCounter = (SYNC->counterOverflowValue && start) ? 254 : TPDO->transmissionType;
+}
+#define CO_TPDO_SYNC_START(TPDO)    ((TPDO)->syncStart)
+#else
+#define CO_TPDO_SYNC_START(TPDO)    ((TPDO)->TPDOCommPar->SYNCStartValue)
+#endif
+
+
+/*
+ * Advance SYNC counter of synchronous TPDO at SYNC.
+ *
+ * @return True, if TPDO must be sent at this SYNC.
+ */
+CO_RAMFUNC static bool_t CO_TPDOsyncDue(CO_TPDO_t *TPDO, const CO_SYNC_t *SYNC){
+    /* send synchronous acyclic PDO */
+    if(TPDO->transmissionType == 0){
+        return TPDO->sendRequest ? true : false;
+    }
+
+    /* send synchronous cyclic PDO */
+    /* is the start of synchronous TPDO transmission */
+    if(TPDO->syncCounter == 255){
+#if CO_TPDO_SYNC_PHASE > 0
+        CO_TPDOsyncPhaseStart(TPDO, SYNC);
+#else
+        if(SYNC->counterOverflowValue && TPDO->TPDOCommPar->SYNCStartValue)
+            TPDO->syncCounter = 254;   /* SYNCStartValue is in use */
+        else
+            TPDO->syncCounter = TPDO->transmissionType;
+#endif
+    }
+    /* if the SYNCStartValue is in use, start first TPDO after SYNC with matched SYNCStartValue. */
+    if(TPDO->syncCounter == 254){
+        if(SYNC->counter == CO_TPDO_SYNC_START(TPDO)){
+            TPDO->syncCounter = TPDO->transmissionType;
+            return true;
+        }
+    }
+    /* Send PDO after every N-th Sync */
+    else if(--TPDO->syncCounter == 0){
+        TPDO->syncCounter = TPDO->transmissionType;
+        return true;
+    }
+    return false;
+}
+
+
 /******************************************************************************/
 uint8_t CO_TPDOisCOS(CO_TPDO_t *TPDO){
+#if CO_PDO_MAX_SIZE > 8
+    uint8_t actual[CO_PDO_MAX_SIZE];
+    uint8_t i;
 
-    /* Prepare TPDO data automatically from Object Dictionary variables */
-    uint8_t* pPDOdataByte;
-    uint8_t** ppODdataByte;
+    if(TPDO->sendIfCOSFlags == 0U){
+        return 0;
+    }
 
-    pPDOdataByte = &TPDO->CANtxBuff->data[TPDO->dataLength];
-    ppODdataByte = &TPDO->mapPointer[TPDO->dataLength];
+    /* Gather mapped Object Dictionary variables and compare flagged bytes with the last sent data */
+    CO_PDOcopyFromOD(TPDO->copyRun, TPDO->copyRunCount, actual);
+    for(i=0; i<TPDO->dataLength; i++){
+        if((TPDO->sendIfCOSFlags & ((CO_PDOcosFlags_t)1<<i)) && actual[i] != TPDO->CANtxBuff->data[i]){
+            return 1;
+        }
+    }
+    return 0;
+#else
+    uint64_t actual = 0;
+    uint64_t sent;
 
-    switch(TPDO->dataLength){
-        case 8: if(*(--pPDOdataByte) != **(--ppODdataByte) && (TPDO->sendIfCOSFlags&0x80)) return 1;
-        case 7: if(*(--pPDOdataByte) != **(--ppODdataByte) && (TPDO->sendIfCOSFlags&0x40)) return 1;
-        case 6: if(*(--pPDOdataByte) != **(--ppODdataByte) && (TPDO->sendIfCOSFlags&0x20)) return 1;
-        case 5: if(*(--pPDOdataByte) != **(--ppODdataByte) && (TPDO->sendIfCOSFlags&0x10)) return 1;
-        case 4: if(*(--pPDOdataByte) != **(--ppODdataByte) && (TPDO->sendIfCOSFlags&0x08)) return 1;
-        case 3: if(*(--pPDOdataByte) != **(--ppODdataByte) && (TPDO->sendIfCOSFlags&0x04)) return 1;
-        case 2: if(*(--pPDOdataByte) != **(--ppODdataByte) && (TPDO->sendIfCOSFlags&0x02)) return 1;
-        case 1: if(*(--pPDOdataByte) != **(--ppODdataByte) && (TPDO->sendIfCOSFlags&0x01)) return 1;
+    if(TPDO->sendIfCOSMask == 0U){
+        return 0;
     }
 
-    return 0;
+    /* Gather mapped Object Dictionary variables and compare with the last sent data */
+    CO_PDOcopyFromOD(TPDO->copyRun, TPDO->copyRunCount, (uint8_t*)&actual);
+    memcpy(&sent, &TPDO->CANtxBuff->data[0], 8);
+
+    return ((actual ^ sent) & TPDO->sendIfCOSMask) ? 1 : 0;
+#endif
+}
+
+#if CO_PDO_MPDO > 0
+/*
+ * Send the next object from object scanner list with SAM-MPDO.
+ *
+ * Entries with objects, which do not exist or are not mappable, are skipped.
+ * Object is taken from the list only, if transmit buffer is free.
+ *
+ * @return Same as CO_CANsend(), CO_ERROR_NO if there is nothing to send.
+ */
+static int16_t CO_TPDOsendSAM(CO_TPDO_t *TPDO){
+    CO_SDO_t *SDO = TPDO->SDO;
+    uint8_t *data = &TPDO->CANtxBuff->data[0];
+    uint8_t entries = SDO->OD[TPDO->mpdoList].maxSubIndex;
+    uint8_t n;
+
+    if(TPDO->CANtxBuff->bufferFull){
+        return CO_ERROR_TX_OVERFLOW;
+    }
+    TPDO->sendRequest = 0;
+
+    for(n=0; n<entries; n++){
+        uint32_t scan;
+        uint32_t map;
+        uint16_t index;
+        uint16_t entryNo;
+        uint8_t subIndex;
+        uint8_t block;
+        uint8_t length;
+        uint8_t MBvar;
+        uint8_t *pData;
+
+        if(TPDO->mpdoScan == 0 || TPDO->mpdoScan > entries){
+            TPDO->mpdoScan = 1;
+            TPDO->mpdoBlock = 0;
+        }
+        memcpy(&scan, CO_OD_getDataPointer(SDO, TPDO->mpdoList, TPDO->mpdoScan), sizeof(scan));
+        index = (uint16_t)(scan >> 8);
+        subIndex = (uint8_t)scan + TPDO->mpdoBlock;
+        block = (uint8_t)(scan >> 24);
+
+        if(index != 0 &&
+            CO_PDOmpdoFind(SDO, index, subIndex, 1, &pData, &length, &MBvar, &entryNo, &map) == 0)
+        {
+            /* next subindex of the block or next entry */
+            if(++TPDO->mpdoBlock >= block){
+                TPDO->mpdoBlock = 0;
+                TPDO->mpdoScan++;
+            }
+#ifdef TPDO_CALLS_EXTENSION
+            {
+                CO_PDOmapEntry_t mapEntry;
+
+                CO_PDOsetMapEntry(SDO, &mapEntry, map, entryNo);
+                CO_PDOcallExtensions(SDO, &mapEntry, 1, true);
+            }
+#endif
+            data[0] = TPDO->nodeId;
+            data[1] = (uint8_t)index;
+            data[2] = (uint8_t)(index >> 8);
+            data[3] = subIndex;
+            memset(&data[4], 0, 4);
+            CO_PDOmpdoCopy(&data[4], pData, length, MBvar);
+
+            return CO_CANsend(TPDO->CANdevTx, TPDO->CANtxBuff);
+        }
+
+        /* skip the rest of the entry */
+        TPDO->mpdoBlock = 0;
+        TPDO->mpdoScan++;
+    }
+
+    return CO_ERROR_NO;
 }
+#endif
+
 
-//#define TPDO_CALLS_EXTENSION
 /******************************************************************************/
 int16_t CO_TPDOsend(CO_TPDO_t *TPDO){
-    int16_t i;
-    uint8_t* pPDOdataByte;
-    uint8_t** ppODdataByte;
-
+    CO_PROFILE_TPDO_SENT();
+#if CO_PDO_MPDO > 0
+    if(TPDO->mpdo == CO_PDO_MPDO_SAM){
+        return CO_TPDOsendSAM(TPDO);
+    }
+#endif
+    CO_ITM_EVENT(CO_ITM_TPDO, CO_PDOtraceId(TPDO->TPDOCommPar->COB_IDUsedByTPDO, TPDO->defaultCOB_ID, TPDO->nodeId));
 #ifdef TPDO_CALLS_EXTENSION
-    if(TPDO->SDO->ODExtensions){
-        /* for each mapped OD, check mapping to see if an OD extension is available, and call it if it is */
-        const uint32_t* pMap = &TPDO->TPDOMapPar->mappedObject1;
-        CO_SDO_t *pSDO = TPDO->SDO;
-
-        for(i=TPDO->TPDOMapPar->numberOfMappedObjects; i>0; i--){
-            uint32_t map = *(pMap++);
-            uint16_t index = (uint16_t)(map>>16);
-            uint8_t subIndex = (uint8_t)(map>>8);
-            uint16_t entryNo = CO_OD_find(pSDO, index);
-            if ( entryNo == 0xFFFF ) continue;
-            CO_OD_extension_t *ext = &pSDO->ODExtensions[entryNo];
-            if( ext->pODFunc == NULL) continue;
-            CO_ODF_arg_t ODF_arg;
-            memset((void*)&ODF_arg, 0, sizeof(CO_ODF_arg_t));
-            ODF_arg.reading = true;
-            ODF_arg.index = index;
-            ODF_arg.subIndex = subIndex;
-            ODF_arg.object = ext->object;
-            ODF_arg.attribute = CO_OD_getAttribute(pSDO, entryNo, subIndex);
-            ODF_arg.pFlags = CO_OD_getFlagsPointer(pSDO, entryNo, subIndex);
-            ODF_arg.data = pSDO->OD[entryNo].pData;
-            ODF_arg.dataLength = CO_OD_getLength(pSDO, entryNo, subIndex);
-            ext->pODFunc(&ODF_arg);
-        }
-    }
-#endif
-    i = TPDO->dataLength;
-    pPDOdataByte = &TPDO->CANtxBuff->data[0];
-    ppODdataByte = &TPDO->mapPointer[0];
+    CO_PDOcallExtensions(TPDO->SDO, TPDO->mapEntry, TPDO->mapEntryCount, true);
+#endif
 
     /* Copy data from Object dictionary. */
-    for(; i>0; i--) {
-        *(pPDOdataByte++) = **(ppODdataByte++);
-    }
+    CO_PDOcopyFromOD(TPDO->copyRun, TPDO->copyRunCount, &TPDO->CANtxBuff->data[0]);
 
     TPDO->sendRequest = 0;
 
     return CO_CANsend(TPDO->CANdevTx, TPDO->CANtxBuff);
 }
 
-//#define RPDO_CALLS_EXTENSION
+#if CO_TPDO_DIRTY_FLAGS > 0
+/******************************************************************************/
+void CO_TPDOmarkDirty(CO_SDO_t *SDO, uint16_t index){
+    CO_TPDOmarkEntry(SDO, CO_OD_find(SDO, index));
+}
+#endif
+
+
+#if CO_PDO_MPDO > 0
+/*
+ * Write object addressed by received MPDO into Object Dictionary.
+ *
+ * @return True, if object was written.
+ */
+static bool_t CO_RPDOmpdoWrite(CO_RPDO_t *RPDO, uint16_t index, uint8_t subIndex, const uint8_t *data){
+    uint32_t map;
+    uint16_t entryNo;
+    uint8_t length;
+    uint8_t MBvar;
+    uint8_t *pData;
+
+    if(CO_PDOmpdoFind(RPDO->SDO, index, subIndex, 0, &pData, &length, &MBvar, &entryNo, &map) != 0){
+        return false;
+    }
+
+#if CO_OD_ATOMIC > 0
+    CO_LOCK_OD();
+    CO_OD_writeBegin(RPDO->SDO);
+    CO_PDOmpdoCopy(pData, data, length, MBvar);
+    CO_OD_writeEnd(RPDO->SDO);
+    CO_UNLOCK_OD();
+#else
+    CO_PDOmpdoCopy(pData, data, length, MBvar);
+#endif
+#if CO_TPDO_DIRTY_FLAGS > 0
+    CO_TPDOmarkEntry(RPDO->SDO, entryNo);
+#endif
+
+#ifdef RPDO_CALLS_EXTENSION
+    {
+        CO_PDOmapEntry_t mapEntry;
+
+        CO_PDOsetMapEntry(RPDO->SDO, &mapEntry, map, entryNo);
+        CO_PDOcallExtensions(RPDO->SDO, &mapEntry, 1, false);
+    }
+#endif
+#if CO_RPDO_HANDLERS > 0
+    if(RPDO->pFunctHandler != NULL) {
+        CO_RPDOfield_t field;
+
+        field.pData = pData;
+        field.index = index;
+        field.subIndex = subIndex;
+        field.length = length;
+        RPDO->pFunctHandler(RPDO->handlerObject, &field, 1);
+    }
+#endif
+
+    return true;
+}
+
+
+/*
+ * Write object of received SAM-MPDO, if it is in object dispatching list.
+ *
+ * @return True, if object was written.
+ */
+static bool_t CO_RPDOmpdoDispatch(CO_RPDO_t *RPDO, uint8_t nodeId, uint16_t index, uint8_t subIndex, const uint8_t *data){
+    CO_SDO_t *SDO = RPDO->SDO;
+    uint8_t entries = SDO->OD[RPDO->mpdoList].maxSubIndex;
+    uint8_t n;
+
+    for(n=1; n<=entries; n++){
+        uint64_t entry;
+        uint8_t first;
+        uint8_t block;
+
+        memcpy(&entry, CO_OD_getDataPointer(SDO, RPDO->mpdoList, n), sizeof(entry));
+        first = (uint8_t)(entry >> 8);
+        block = (uint8_t)(entry >> 56);
+        if(block == 0){
+            block = 1;
+        }
+        if((uint8_t)entry == nodeId && (uint16_t)(entry >> 16) == index &&
+            subIndex >= first && (uint8_t)(subIndex - first) < block)
+        {
+            return CO_RPDOmpdoWrite(RPDO, (uint16_t)(entry >> 40),
+                                    (uint8_t)((uint8_t)(entry >> 32) + (subIndex - first)), data);
+        }
+    }
+
+    return false;
+}
+
+
+/*
+ * Write all queued MPDOs into Object Dictionary.
+ */
+static void CO_RPDOmpdoProcess(CO_RPDO_t *RPDO){
+    bool_t written = false;
+
+    while(RPDO->mpdoTail != RPDO->mpdoHead){
+        const uint8_t *data = &RPDO->mpdoQueue[RPDO->mpdoTail][0];
+        uint16_t index;
+        bool_t ok;
+
+        /* message was written before mpdoHead */
+        CO_MEMORY_BARRIER();
+        index = (uint16_t)data[1] | ((uint16_t)data[2] << 8);
+        if((data[0] & 0x80U) != 0U){
+            /* DAM-MPDO, destination was verified by CO_RPDOmpdoQueue() */
+            ok = CO_RPDOmpdoWrite(RPDO, index, data[3], &data[4]);
+        }
+        else{
+            ok = CO_RPDOmpdoDispatch(RPDO, data[0], index, data[3], &data[4]);
+        }
+        if(ok){
+            written = true;
+        }
+        else{
+            RPDO->mpdoIgnored++;
+        }
+        CO_MEMORY_BARRIER();
+        RPDO->mpdoTail = (uint8_t)((RPDO->mpdoTail + 1U) % CO_PDO_MPDO_QUEUE);
+    }
+
+    if(written && RPDO->pFunctSignal != NULL) {
+        RPDO->pFunctSignal(RPDO->functSignalObject);
+    }
+}
+#endif
+
+
 /******************************************************************************/
 void CO_RPDO_process(CO_RPDO_t *RPDO, bool_t syncWas){
 
+#if CO_PDO_SHADOW_MAP > 0
+    if(RPDO->shadow.state == CO_PDO_SHADOW_PENDING){
+        CO_RPDOshadowCommit(RPDO);
+    }
+#endif
     if(!RPDO->valid || !(*RPDO->operatingState == CO_NMT_OPERATIONAL))
     {
         RPDO->CANrxNew[0] = RPDO->CANrxNew[1] = false;
+#if CO_PDO_MPDO > 0
+        RPDO->mpdoTail = RPDO->mpdoHead;
+#endif
+    }
+#if CO_PDO_MPDO > 0
+    else if(RPDO->mpdo != 0U)
+    {
+        /* MPDOs are always processed as asynchronous */
+        CO_RPDOmpdoProcess(RPDO);
     }
+#endif
     else if(!RPDO->synchronous || syncWas)
     {
         uint8_t bufNo = 0;
@@ -919,50 +2113,47 @@ void CO_RPDO_process(CO_RPDO_t *RPDO, bool_t syncWas){
             bufNo = 1;
         }
 
+#if CO_RPDO_SEQLOCK > 0
+        if(RPDO->direct && RPDO->CANrxNew[bufNo]){
+            /* application reads data with CO_RPDO_readData() */
+            RPDO->CANrxNew[bufNo] = false;
+            CO_ITM_EVENT(CO_ITM_RPDO, CO_PDOtraceId(RPDO->RPDOCommPar->COB_IDUsedByRPDO, RPDO->defaultCOB_ID, RPDO->nodeId));
+            if(RPDO->pFunctSignal != NULL) {
+                RPDO->pFunctSignal(RPDO->functSignalObject);
+            }
+            return;
+        }
+#endif
         while(RPDO->CANrxNew[bufNo]){
-            int16_t i;
-            uint8_t* pPDOdataByte;
-            uint8_t** ppODdataByte;
-
-            i = RPDO->dataLength;
-            pPDOdataByte = &RPDO->CANrxData[bufNo][0];
-            ppODdataByte = &RPDO->mapPointer[0];
-
             /* Copy data to Object dictionary. If between the copy operation CANrxNew
              * is set to true by receive thread, then copy the latest data again. */
             RPDO->CANrxNew[bufNo] = false;
-            for(; i>0; i--) {
-                **(ppODdataByte++) = *(pPDOdataByte++);
-            }
+            CO_ITM_EVENT(CO_ITM_RPDO, CO_PDOtraceId(RPDO->RPDOCommPar->COB_IDUsedByRPDO, RPDO->defaultCOB_ID, RPDO->nodeId));
+#if CO_OD_ATOMIC > 0
+            CO_LOCK_OD();
+            CO_OD_writeBegin(RPDO->SDO);
+            CO_PDOcopyToOD(RPDO->copyRun, RPDO->copyRunCount, &RPDO->CANrxData[bufNo][0]);
+            CO_OD_writeEnd(RPDO->SDO);
+            CO_UNLOCK_OD();
+#else
+            CO_PDOcopyToOD(RPDO->copyRun, RPDO->copyRunCount, &RPDO->CANrxData[bufNo][0]);
+#endif
+#if CO_TPDO_DIRTY_FLAGS > 0
+            CO_RPDOmarkDirty(RPDO);
+#endif
 
 #ifdef RPDO_CALLS_EXTENSION
-            if(RPDO->SDO->ODExtensions){
-                /* for each mapped OD, check mapping to see if an OD extension is available, and call it if it is */
-                const uint32_t* pMap = &RPDO->RPDOMapPar->mappedObject1;
-                CO_SDO_t *pSDO = RPDO->SDO;
-
-                for(i=RPDO->RPDOMapPar->numberOfMappedObjects; i>0; i--){
-                    uint32_t map = *(pMap++);
-                    uint16_t index = (uint16_t)(map>>16);
-                    uint8_t subIndex = (uint8_t)(map>>8);
-                    uint16_t entryNo = CO_OD_find(pSDO, index);
-                    if ( entryNo == 0xFFFF ) continue;
-                    CO_OD_extension_t *ext = &pSDO->ODExtensions[entryNo];
-                    if( ext->pODFunc == NULL) continue;
-                    CO_ODF_arg_t ODF_arg;
-                    memset((void*)&ODF_arg, 0, sizeof(CO_ODF_arg_t));
-                    ODF_arg.reading = false;
-                    ODF_arg.index = index;
-                    ODF_arg.subIndex = subIndex;
-                    ODF_arg.object = ext->object;
-                    ODF_arg.attribute = CO_OD_getAttribute(pSDO, entryNo, subIndex);
-                    ODF_arg.pFlags = CO_OD_getFlagsPointer(pSDO, entryNo, subIndex);
-                    ODF_arg.data = pSDO->OD[entryNo].pData;
-                    ODF_arg.dataLength = CO_OD_getLength(pSDO, entryNo, subIndex);
-                    ext->pODFunc(&ODF_arg);
-                }
+            CO_PDOcallExtensions(RPDO->SDO, RPDO->mapEntry, RPDO->mapEntryCount, false);
+#endif
+#if CO_RPDO_HANDLERS > 0
+            if(RPDO->pFunctHandler != NULL) {
+                RPDO->pFunctHandler(RPDO->handlerObject, RPDO->field, RPDO->fieldCount);
             }
 #endif
+
+            if(RPDO->pFunctSignal != NULL) {
+                RPDO->pFunctSignal(RPDO->functSignalObject);
+            }
         }
     }
 }
@@ -973,59 +2164,406 @@ void CO_TPDO_process(
         CO_TPDO_t              *TPDO,
         CO_SYNC_t              *SYNC,
         bool_t                  syncWas,
-        uint32_t                timeDifference_us)
+        uint32_t                timeDifference_us,
+        uint32_t               *timerNext_us)
 {
+#if CO_PDO_SHADOW_MAP > 0
+    if(TPDO->shadow.state == CO_PDO_SHADOW_PENDING){
+        CO_TPDOshadowCommit(TPDO);
+    }
+#endif
+#if CO_TPDO_STREAM > 0
+    if(TPDO->stream){
+        /* sent by CO_TPDOstream_t from CAN transmit interrupt */
+        return;
+    }
+#endif
     if(TPDO->valid && *TPDO->operatingState == CO_NMT_OPERATIONAL){
 
         /* Send PDO by application request or by Event timer */
-        if(TPDO->TPDOCommPar->transmissionType >= 253){
-            if(TPDO->inhibitTimer == 0 && (TPDO->sendRequest || (TPDO->TPDOCommPar->eventTimer && TPDO->eventTimer == 0))){
+        if(TPDO->transmissionType >= 253){
+            if(TPDO->inhibitTimer == 0 && (TPDO->sendRequest || (TPDO->eventTime_us && TPDO->eventTimer == 0))){
                 if(CO_TPDOsend(TPDO) == CO_ERROR_NO){
                     /* successfully sent */
-                    TPDO->inhibitTimer = ((uint32_t) TPDO->TPDOCommPar->inhibitTime) * 100;
-                    TPDO->eventTimer = ((uint32_t) TPDO->TPDOCommPar->eventTimer) * 1000;
+                    TPDO->inhibitTimer = CO_TPDO_INHIBIT_US(TPDO);
+                    TPDO->eventTimer = TPDO->eventTime_us;
                 }
             }
         }
 
+#if CO_TPDO_PRESTAGE > 0
+        /* Synchronous PDOs are sent by CO_TPDO_syncRelease() */
+        else if(TPDO->stageState != CO_TPDO_STAGE_OFF){
+            if(TPDO->stageLate){
+                TPDO->stageLate = false;
+                CO_TPDOsend(TPDO);
+            }
+        }
+#endif
+
         /* Synchronous PDOs */
         else if(SYNC && syncWas){
-            /* send synchronous acyclic PDO */
-            if(TPDO->TPDOCommPar->transmissionType == 0){
-                if(TPDO->sendRequest) CO_TPDOsend(TPDO);
-            }
-            /* send synchronous cyclic PDO */
-            else{
-                /* is the start of synchronous TPDO transmission */
-                if(TPDO->syncCounter == 255){
-                    if(SYNC->counterOverflowValue && TPDO->TPDOCommPar->SYNCStartValue)
-                        TPDO->syncCounter = 254;   /* SYNCStartValue is in use */
-                    else
-                        TPDO->syncCounter = TPDO->TPDOCommPar->transmissionType;
-                }
-                /* if the SYNCStartValue is in use, start first TPDO after SYNC with matched SYNCStartValue. */
-                if(TPDO->syncCounter == 254){
-                    if(SYNC->counter == TPDO->TPDOCommPar->SYNCStartValue){
-                        TPDO->syncCounter = TPDO->TPDOCommPar->transmissionType;
-                        CO_TPDOsend(TPDO);
-                    }
-                }
-                /* Send PDO after every N-th Sync */
-                else if(--TPDO->syncCounter == 0){
-                    TPDO->syncCounter = TPDO->TPDOCommPar->transmissionType;
-                    CO_TPDOsend(TPDO);
-                }
+            if(CO_TPDOsyncDue(TPDO, SYNC)){
+                CO_TPDOsend(TPDO);
             }
         }
 
     }
     else{
         /* Not operational or valid. Force TPDO first send after operational or valid. */
-        if(TPDO->TPDOCommPar->transmissionType>=254) TPDO->sendRequest = 1;
+        if(TPDO->transmissionType>=254) TPDO->sendRequest = 1;
         else                                         TPDO->sendRequest = 0;
     }
 
     /* update timers */
     TPDO->inhibitTimer = (TPDO->inhibitTimer > timeDifference_us) ? (TPDO->inhibitTimer - timeDifference_us) : 0;
     TPDO->eventTimer = (TPDO->eventTimer > timeDifference_us) ? (TPDO->eventTimer - timeDifference_us) : 0;
+
+    /* Calculate, when event driven TPDO may be send and lower timerNext_us if necessary. */
+    if(timerNext_us != NULL && TPDO->valid && *TPDO->operatingState == CO_NMT_OPERATIONAL &&
+            TPDO->transmissionType >= 253)
+    {
+        uint32_t diff = 0xFFFFFFFFUL;
+
+        if(TPDO->sendRequest){
+            diff = TPDO->inhibitTimer;
+        }
+        else if(TPDO->eventTime_us){
+            diff = (TPDO->eventTimer > TPDO->inhibitTimer) ? TPDO->eventTimer : TPDO->inhibitTimer;
+        }
+        if(*timerNext_us > diff){
+            *timerNext_us = diff;
+        }
+    }
+}
+
+
+#if CO_PDO_MPDO > 0
+/******************************************************************************/
+void CO_TPDO_setMPDOdest(CO_TPDO_t *TPDO, uint8_t nodeId){
+    TPDO->mpdoDest = nodeId & 0x7FU;
+    TPDO->mpdoMux[0] = 0x80U | TPDO->mpdoDest;
+}
+#endif
+
+
+#if CO_PDO_SHADOW_MAP > 0
+/*
+ * Copy mapping from application into shadow.
+ *
+ * @return CO_SDO_AB_MAP_LEN or CO_SDO_AB_DATA_DEV_STATE on error, otherwise 0.
+ */
+static uint32_t CO_PDOshadowSet(
+        CO_PDOshadowMap_t      *shadow,
+        uint8_t                 noOfMappedObjects,
+        const uint32_t         *map,
+        const uint8_t          *pNoOfMappedObjects,
+        const uint32_t         *pMap)
+{
+    uint8_t count = noOfMappedObjects;
+    uint8_t i;
+    uint32_t ret;
+
+#if CO_PDO_MPDO > 0
+    if(noOfMappedObjects == CO_PDO_MPDO_SAM){
+        count = 0;
+    }
+    else if(noOfMappedObjects == CO_PDO_MPDO_DAM){
+        count = 1;
+    }
+    else
+#endif
+    if(noOfMappedObjects > 8){
+        return CO_SDO_AB_MAP_LEN;  /* Number and length of object to be mapped exceeds PDO length. */
+    }
+
+    ret = CO_PDOshadowOpen(shadow, *pNoOfMappedObjects, pMap);
+    if(ret == 0){
+        shadow->numberOfMappedObjects = noOfMappedObjects;
+        for(i=0; i<count; i++){
+            shadow->mappedObject[i] = map[i];
+        }
+    }
+
+    return ret;
+}
+
+
+/******************************************************************************/
+uint32_t CO_RPDO_stageMap(CO_RPDO_t *RPDO, uint8_t noOfMappedObjects, const uint32_t *map){
+    uint32_t ret = CO_PDOshadowSet(&RPDO->shadow, noOfMappedObjects, map,
+            &RPDO->RPDOMapPar->numberOfMappedObjects, &RPDO->RPDOMapPar->mappedObject1);
+
+    if(ret == 0){
+        ret = CO_PDOshadowStage(&RPDO->shadow, CO_RPDOcheckMap(RPDO, &RPDO->shadow));
+    }
+
+    return ret;
+}
+
+
+/******************************************************************************/
+uint32_t CO_TPDO_stageMap(CO_TPDO_t *TPDO, uint8_t noOfMappedObjects, const uint32_t *map){
+    uint32_t ret = CO_PDOshadowSet(&TPDO->shadow, noOfMappedObjects, map,
+            &TPDO->TPDOMapPar->numberOfMappedObjects, &TPDO->TPDOMapPar->mappedObject1);
+
+    if(ret == 0){
+        ret = CO_PDOshadowStage(&TPDO->shadow, CO_TPDOcheckMap(TPDO, &TPDO->shadow));
+    }
+
+    return ret;
+}
+#endif
+
+
+#if CO_TPDO_ADAPTIVE_INHIBIT > 0
+/******************************************************************************/
+void CO_TPDO_setInhibitScale(CO_TPDO_t *TPDO, uint16_t scale){
+    TPDO->inhibitScale = (scale < 256U) ? 256U : scale;
+}
+#endif
+
+
+#if CO_TPDO_CALENDAR > 0
+/* True, if deadline of TPDO a is before deadline of TPDO b. */
+static inline bool_t CO_TPDOcalBefore(const CO_TPDO_t *a, const CO_TPDO_t *b){
+    return (int32_t)(a->calDue - b->calDue) < 0;
+}
+
+
+/* Place TPDO at heap position pos. */
+static inline void CO_TPDOcalPlace(CO_TPDOcalendar_t *cal, CO_TPDO_t *TPDO, uint16_t pos){
+    cal->heap[pos] = TPDO;
+    TPDO->calPos = pos;
+}
+
+
+/* Move TPDO from heap position pos towards the top or towards the leaves. */
+static void CO_TPDOcalSift(CO_TPDOcalendar_t *cal, CO_TPDO_t *TPDO, uint16_t pos){
+    /* towards the top */
+    while(pos > 0U){
+        uint16_t parent = (pos - 1U) / 2U;
+
+        if(!CO_TPDOcalBefore(TPDO, cal->heap[parent])){
+            break;
+        }
+        CO_TPDOcalPlace(cal, cal->heap[parent], pos);
+        pos = parent;
+    }
+
+    /* towards the leaves */
+    for(;;){
+        uint16_t child = 2U * pos + 1U;
+
+        if(child >= cal->count){
+            break;
+        }
+        if((child + 1U) < cal->count && CO_TPDOcalBefore(cal->heap[child + 1U], cal->heap[child])){
+            child++;
+        }
+        if(!CO_TPDOcalBefore(cal->heap[child], TPDO)){
+            break;
+        }
+        CO_TPDOcalPlace(cal, cal->heap[child], pos);
+        pos = child;
+    }
+
+    CO_TPDOcalPlace(cal, TPDO, pos);
+}
+
+
+/* Insert TPDO into heap with deadline due or move it to the new deadline. */
+static void CO_TPDOcalSet(CO_TPDOcalendar_t *cal, CO_TPDO_t *TPDO, uint32_t due){
+    uint16_t pos = TPDO->calPos;
+
+    TPDO->calDue = due;
+    if(pos == CO_TPDO_CAL_NONE){
+        if(cal->count >= cal->size){
+            return;
+        }
+        pos = cal->count++;
+    }
+    CO_TPDOcalSift(cal, TPDO, pos);
+}
+
+
+/* Remove TPDO from heap, if it is there. */
+static void CO_TPDOcalRemove(CO_TPDOcalendar_t *cal, CO_TPDO_t *TPDO){
+    uint16_t pos = TPDO->calPos;
+
+    if(pos == CO_TPDO_CAL_NONE){
+        return;
+    }
+    TPDO->calPos = CO_TPDO_CAL_NONE;
+    cal->count--;
+    if(pos < cal->count){
+        /* last element fills the gap */
+        CO_TPDOcalSift(cal, cal->heap[cal->count], pos);
+    }
+}
+
+
+/* Calculate the next deadline of TPDO from its state, same conditions as in
+ * CO_TPDO_process(), and update the heap. */
+static void CO_TPDOcalSchedule(CO_TPDOcalendar_t *cal, CO_TPDO_t *TPDO){
+    uint32_t inhibit, event;
+
+    /* passed (or very old) deadlines are now */
+    inhibit = TPDO->inhibitEnd - cal->now;
+    if(inhibit > CO_TPDO_INHIBIT_US(TPDO)){
+        inhibit = 0;
+        TPDO->inhibitEnd = cal->now;
+    }
+    event = TPDO->eventDue - cal->now;
+    if(event > TPDO->eventTime_us){
+        event = 0;
+        TPDO->eventDue = cal->now;
+    }
+
+    if((TPDO->calKey & 0x02U) == 0U || (!TPDO->sendRequest && TPDO->eventTime_us == 0)){
+        CO_TPDOcalRemove(cal, TPDO);
+    }
+    else if(TPDO->sendRequest){
+        CO_TPDOcalSet(cal, TPDO, cal->now + inhibit);
+    }
+    else{
+        CO_TPDOcalSet(cal, TPDO, cal->now + ((event > inhibit) ? event : inhibit));
+    }
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_TPDOcalendar_init(
+        CO_TPDOcalendar_t      *cal,
+        CO_TPDO_t              *heap[],
+        uint16_t                size)
+{
+    if(cal == NULL || heap == NULL || size >= CO_TPDO_CAL_NONE){
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    cal->now = 0;
+    cal->heap = heap;
+    cal->size = size;
+    cal->count = 0;
+
+    return CO_ERROR_NO;
 }
+
+
+/******************************************************************************/
+void CO_TPDOcalendar_update(CO_TPDOcalendar_t *cal, CO_TPDO_t *TPDO){
+    bool_t active;
+    uint8_t key;
+
+#if CO_PDO_SHADOW_MAP > 0
+    /* CO_TPDO_process() is not called for event driven TPDOs */
+    if(TPDO->shadow.state == CO_PDO_SHADOW_PENDING){
+        CO_TPDOshadowCommit(TPDO);
+    }
+#endif
+    active = TPDO->valid && *TPDO->operatingState == CO_NMT_OPERATIONAL;
+    if(!active){
+        /* Not operational or valid. Force TPDO first send after operational or valid. */
+        TPDO->sendRequest = (TPDO->transmissionType >= 254) ? 1 : 0;
+    }
+    if(TPDO->transmissionType < 253){
+        /* synchronous now, removed from calendar */
+        active = false;
+    }
+#if CO_TPDO_STREAM > 0
+    if(TPDO->stream){
+        /* sent by CO_TPDOstream_t from CAN transmit interrupt */
+        active = false;
+    }
+#endif
+
+    key = (active ? 0x02U : 0U) | (TPDO->sendRequest ? 0x01U : 0U);
+    if(key == TPDO->calKey && !TPDO->calReschedule){
+        return;
+    }
+
+    TPDO->calKey = key;
+    if(TPDO->calReschedule){
+        TPDO->calReschedule = false;
+        TPDO->inhibitEnd = cal->now + TPDO->inhibitTimer;
+        TPDO->eventDue = cal->now + TPDO->eventTimer;
+    }
+    CO_TPDOcalSchedule(cal, TPDO);
+}
+
+
+/******************************************************************************/
+void CO_TPDOcalendar_process(CO_TPDOcalendar_t *cal, uint32_t *timerNext_us){
+    while(cal->count > 0U){
+        CO_TPDO_t *TPDO = cal->heap[0];
+
+        if((int32_t)(TPDO->calDue - cal->now) > 0){
+            break;
+        }
+
+        if(CO_TPDOsend(TPDO) == CO_ERROR_NO){
+            /* successfully sent */
+            TPDO->inhibitEnd = cal->now + CO_TPDO_INHIBIT_US(TPDO);
+            TPDO->eventDue = cal->now + TPDO->eventTime_us;
+            TPDO->calKey &= ~0x01U;
+            CO_TPDOcalSchedule(cal, TPDO);
+        }
+        else{
+            /* CAN buffer is full, retry in the next cycle */
+            CO_TPDOcalSet(cal, TPDO, cal->now + 1U);
+        }
+    }
+
+    if(timerNext_us != NULL && cal->count > 0U){
+        uint32_t diff = cal->heap[0]->calDue - cal->now;
+
+        if(*timerNext_us > diff){
+            *timerNext_us = diff;
+        }
+    }
+}
+#endif /* CO_TPDO_CALENDAR > 0 */
+
+
+#if CO_TPDO_PRESTAGE > 0
+/******************************************************************************/
+void CO_TPDO_stage(CO_TPDO_t *TPDO){
+#if CO_PDO_MPDO > 0
+    if(TPDO->mpdo == CO_PDO_MPDO_SAM){
+        /* each transmission takes the next object, CO_TPDOsend() assembles it */
+        return;
+    }
+#endif
+#ifdef TPDO_CALLS_EXTENSION
+    CO_PDOcallExtensions(TPDO->SDO, TPDO->mapEntry, TPDO->mapEntryCount, true);
+#endif
+    /* CO_TPDO_syncRelease() does not use data during copy */
+    TPDO->stageState = CO_TPDO_STAGE_EMPTY;
+    CO_MEMORY_BARRIER();
+    CO_PDOcopyFromOD(TPDO->copyRun, TPDO->copyRunCount, &TPDO->stageData[0]);
+    CO_MEMORY_BARRIER();
+    TPDO->stageState = CO_TPDO_STAGE_READY;
+}
+
+
+/******************************************************************************/
+CO_RAMFUNC void CO_TPDO_syncRelease(CO_TPDO_t *TPDO, CO_SYNC_t *SYNC){
+    if(TPDO->stageState == CO_TPDO_STAGE_OFF || !TPDO->valid ||
+        *TPDO->operatingState != CO_NMT_OPERATIONAL || TPDO->transmissionType > 240){
+        return;
+    }
+
+    if(CO_TPDOsyncDue(TPDO, SYNC)){
+        if(TPDO->stageState == CO_TPDO_STAGE_READY && !TPDO->CANtxBuff->bufferFull){
+            memcpy(&TPDO->CANtxBuff->data[0], &TPDO->stageData[0], CO_PDO_MAX_SIZE);
+            TPDO->stageState = CO_TPDO_STAGE_EMPTY;
+            TPDO->sendRequest = 0;
+            CO_CANsend(TPDO->CANdevTx, TPDO->CANtxBuff);
+        }
+        else{
+            TPDO->stageLate = true;
+        }
+    }
+}
+#endif
@@ -77,9 +77,131 @@ extern "C" {
  *  - Function CO_TPDO_process() (called by application) sends TPDO if
  *    necessary. There are possible different transmission types, including
  *    automatic detection of Change of State of specific variable.
+ *  - With #CO_RPDO_SEQLOCK, each receive buffer has a sequence counter.
+ *    CO_RPDO_readData() returns a consistent snapshot without locks, and
+ *    application may read RPDO data directly from the buffer instead of from
+ *    Object Dictionary, see CO_RPDO_setDirect().
+ *  - With #CO_TPDO_PRESTAGE, synchronous TPDO may be assembled in advance
+ *    with CO_TPDO_stage(), when application has its inputs ready. SYNC
+ *    callback then calls CO_TPDO_syncRelease(), which sends the staged frame
+ *    at the SYNC edge instead of the next CO_TPDO_process() call.
+ *  - With #CO_TPDO_SYNC_PHASE, cyclic synchronous TPDOs (transmission
+ *    type 2 to 240) without SYNCStartValue start at a SYNC offset derived
+ *    from node-ID and TPDO number. TPDOs with the same transmission type are
+ *    then spread over the SYNC cycles of the period instead of being sent
+ *    all at the same SYNC. If SYNC producer sends the counter, offset is
+ *    taken from the counter, so it is the same on all nodes of the network.
+ *  - With #CO_TPDO_CALENDAR, event and inhibit timers of event driven TPDOs
+ *    are absolute deadlines in CO_TPDOcalendar_t, only due TPDOs are visited.
+ *  - With #CO_RPDO_HANDLERS, application handler receives mapped fields of
+ *    accepted RPDO, see CO_RPDO_initHandler().
+ *  - PDO data length is limited by #CO_PDO_MAX_SIZE. With CAN FD driver,
+ *    eight mapped objects may fill up to 64 bytes of one PDO.
+ *  - With #CO_PDO_MPDO, multiplexed PDOs (CiA 301 MPDO) are selected by
+ *    number of mapped objects #CO_PDO_MPDO_SAM or #CO_PDO_MPDO_DAM. Each
+ *    message carries one object of up to 4 bytes after a multiplexer with
+ *    node-ID, index and subindex, so one COB-ID transfers many objects.
+ *    SAM-MPDO producer sends objects from object scanner list in turn, one
+ *    per transmission event. SAM-MPDO consumer writes objects, which are
+ *    found in object dispatching list. DAM-MPDO producer maps one object,
+ *    DAM-MPDO consumer writes the object with the same index and subindex.
+ *    Received MPDOs are queued in the receive interrupt, so several MPDOs
+ *    between two CO_RPDO_process() calls are not lost. They are processed as
+ *    asynchronous PDOs, immediate mode is not used.
+ *  - With #CO_PDO_SHADOW_MAP, mapping of a valid PDO may be changed without
+ *    invalidating it. While PDO is valid, SDO writes of mapping parameter go
+ *    into a shadow, which starts as copy of the active mapping. Writing the
+ *    number of mapped objects validates the shadow, application may do the
+ *    same with CO_RPDO_stageMap() or CO_TPDO_stageMap(). The next
+ *    CO_RPDO_process() or CO_TPDO_process() activates the new mapping at
+ *    once, till then PDO keeps working with the old one and OD shows it.
  */
 
 
+/**
+ * Maximum length of PDO data in bytes, 8 for classic CAN. It is the size of
+ * CAN message data, see CO_CAN_DATA_SIZE in CO_driver.h.
+ */
+#ifndef CO_PDO_MAX_SIZE
+#define CO_PDO_MAX_SIZE         CO_CAN_DATA_SIZE
+#endif
+
+#if CO_PDO_MAX_SIZE > 64
+#error CO_PDO_MAX_SIZE can not be more than 64
+#endif
+
+/**
+ * Flags with one bit for each byte of PDO data, see sendIfCOSFlags in CO_TPDO_t.
+ */
+#if CO_PDO_MAX_SIZE > 8
+typedef uint64_t CO_PDOcosFlags_t;
+#else
+typedef uint8_t CO_PDOcosFlags_t;
+#endif
+
+/**
+ * Number of CO_PDOcopyRun_t in PDO object. Little endian mapped objects are
+ * contiguous in memory, so runs are not more than mapped objects.
+ */
+#ifdef CO_BIG_ENDIAN
+#define CO_PDO_COPY_RUNS        CO_PDO_MAX_SIZE
+#else
+#define CO_PDO_COPY_RUNS        8
+#endif
+
+
+#if CO_PDO_MPDO > 0
+/** Number of mapped objects of SAM-MPDO (source address mode) */
+#define CO_PDO_MPDO_SAM         0xFEU
+/** Number of mapped objects of DAM-MPDO (destination address mode) */
+#define CO_PDO_MPDO_DAM         0xFFU
+
+/**
+ * Object scanner list of SAM-MPDO producer, UNSIGNED32 array. Each used
+ * entry `0xBBIIIISS` sends objects from index I, subindexes S to S+B-1
+ * (B is block size, 0 is the same as 1). Unused entries are 0.
+ */
+#define CO_PDO_MPDO_SCANNER     0x1FA0U
+
+/**
+ * Object dispatching list of SAM-MPDO consumer, UNSIGNED64 array. Each used
+ * entry `0xBBLLLLllPPPPppNN` writes objects of producer node-ID N from index P,
+ * subindexes p to p+B-1 into local index L, subindexes l to l+B-1.
+ */
+#define CO_PDO_MPDO_DISPATCHER  0x1FD0U
+
+/**
+ * Size of receive queue of each MPDO consumer, one less MPDOs may wait for
+ * CO_RPDO_process().
+ */
+#ifndef CO_PDO_MPDO_QUEUE
+#define CO_PDO_MPDO_QUEUE       8U
+#endif
+#endif
+
+
+#if CO_PDO_SHADOW_MAP > 0
+/** Shadow mapping is not used */
+#define CO_PDO_SHADOW_IDLE      0U
+/** Shadow mapping is being written by SDO */
+#define CO_PDO_SHADOW_EDIT      1U
+/** Shadow mapping is valid, next CO_R(T)PDO_process() activates it */
+#define CO_PDO_SHADOW_PENDING   2U
+
+/**
+ * New mapping of valid PDO, see #CO_PDO_SHADOW_MAP.
+ */
+typedef struct{
+    /** CO_PDO_SHADOW_IDLE, CO_PDO_SHADOW_EDIT or CO_PDO_SHADOW_PENDING */
+    volatile uint8_t    state;
+    /** Number of mapped objects, as in mapping parameter */
+    uint8_t             numberOfMappedObjects;
+    /** Mapped objects, as in mapping parameter */
+    uint32_t            mappedObject[8];
+}CO_PDOshadowMap_t;
+#endif
+
+
 /**
  * RPDO communication parameter. The same as record from Object dictionary (index 0x1400+).
  */
@@ -179,72 +301,316 @@ typedef struct{
 }CO_TPDOMapPar_t;
 
 
+/**
+ * Contiguous part of PDO data, compiled from mapPointer by CO_R(T)PDOconfigMap().
+ * Adjacent mapped OD variables are merged into one run.
+ */
+typedef struct{
+    uint8_t            *pData;          /**< First byte of OD variable(s) */
+    uint8_t             offset;         /**< Position in PDO data */
+    uint8_t             length;         /**< Number of bytes */
+}CO_PDOcopyRun_t;
+
+
+/* Call OD extension functions of mapped objects on each PDO, define globally:
+ * #define RPDO_CALLS_EXTENSION
+ * #define TPDO_CALLS_EXTENSION */
+#if defined(RPDO_CALLS_EXTENSION) || defined(TPDO_CALLS_EXTENSION)
+/**
+ * Mapped object, resolved by CO_R(T)PDOconfigMap() for OD extension calls.
+ */
+typedef struct{
+    uint16_t            entryNo;        /**< From CO_OD_find(), 0xFFFF for dummy entry */
+    uint16_t            index;          /**< Index of mapped object */
+    uint16_t            attribute;      /**< From CO_OD_getAttribute() */
+    uint16_t            length;         /**< From CO_OD_getLength() */
+    uint8_t             subIndex;       /**< Subindex of mapped object */
+}CO_PDOmapEntry_t;
+#endif
+
+
+#if CO_RPDO_HANDLERS > 0
+/**
+ * Mapped field of RPDO, passed to handler from CO_RPDO_initHandler().
+ *
+ * Fields are listed in mapping order. Handler is called after received data
+ * are copied to Object Dictionary, so _pData_ points to decoded value in
+ * native byte order, see CO_RPDO_FIELD().
+ */
+typedef struct{
+    const void         *pData;          /**< OD variable (dummy buffer for dummy entry) */
+    uint16_t            index;          /**< Index of mapped object */
+    uint8_t             subIndex;       /**< Subindex of mapped object */
+    uint8_t             length;         /**< Length of mapped object in bytes */
+}CO_RPDOfield_t;
+
+/**
+ * Read value of RPDO mapped field as _type_, e.g. CO_RPDO_FIELD(int16_t, field[0]).
+ * Size of _type_ must match field length.
+ */
+#define CO_RPDO_FIELD(type, field) (*(const type*)(field).pData)
+#endif
+
+
 /**
  * RPDO object.
+ *
+ * Members used by receive thread and CO_RPDO_process() are placed first.
  */
 typedef struct{
-    CO_EM_t            *em;             /**< From CO_RPDO_init() */
-    CO_SDO_t           *SDO;            /**< From CO_RPDO_init() */
-    CO_SYNC_t          *SYNC;           /**< From CO_RPDO_init() */
-    const CO_RPDOCommPar_t *RPDOCommPar;/**< From CO_RPDO_init() */
-    const CO_RPDOMapPar_t  *RPDOMapPar; /**< From CO_RPDO_init() */
-    uint8_t            *operatingState; /**< From CO_RPDO_init() */
-    uint8_t             nodeId;         /**< From CO_RPDO_init() */
-    uint16_t            defaultCOB_ID;  /**< From CO_RPDO_init() */
-    uint8_t             restrictionFlags;/**< From CO_RPDO_init() */
     /** True, if PDO is enabled and valid */
     bool_t              valid;
-    /** True, if PDO synchronous (transmissionType <= 240) */
+    /** True, if PDO synchronous (transmissionType <= 240) and SYNC is used */
     bool_t              synchronous;
+    /** From CO_RPDO_initCallback(), copy asynchronous PDO inside receive thread */
+    bool_t              immediate;
     /** Data length of the received PDO message. Calculated from mapping */
     uint8_t             dataLength;
-    /** Pointers to 8 data objects, where PDO will be copied */
-    uint8_t            *mapPointer[8];
+    /** Number of used copyRun */
+    uint8_t             copyRunCount;
     /** Variable indicates, if new PDO message received from CAN bus. */
     volatile bool_t     CANrxNew[2];
-    /** 8 data bytes of the received message. */
-    uint8_t             CANrxData[2][8];
+    uint8_t            *operatingState; /**< From CO_RPDO_init() */
+    CO_SYNC_t          *SYNC;           /**< From CO_RPDO_init() */
+    /** Data bytes of the received message. */
+    uint8_t             CANrxData[2][CO_PDO_MAX_SIZE];
+#if CO_RPDO_SEQLOCK > 0
+    /** Sequence counter of each CANrxData buffer, odd while receive
+    interrupt writes the buffer, see CO_RPDO_readData() */
+    volatile uint32_t   CANrxSeq[2];
+    /** From CO_RPDO_setDirect(), CO_RPDO_process() does not copy to OD */
+    bool_t              direct;
+#endif
+#if CO_CAN_TIMESTAMP > 0
+    /** Hardware timestamp of the received message, see CO_CANrxMsg_readTimestamp() */
+    uint16_t            CANrxTimestamp[2];
+#endif
+    /** Copy descriptors built from mapping */
+    CO_PDOcopyRun_t     copyRun[CO_PDO_COPY_RUNS];
+#if CO_PDO_MPDO > 0
+    /** CO_PDO_MPDO_SAM, CO_PDO_MPDO_DAM or 0, built from mapping */
+    uint8_t             mpdo;
+    /** Position of the next MPDO written by receive thread */
+    volatile uint8_t    mpdoHead;
+    /** Position of the next MPDO read by CO_RPDO_process() */
+    volatile uint8_t    mpdoTail;
+    /** Received MPDOs, addressed to this node */
+    uint8_t             mpdoQueue[CO_PDO_MPDO_QUEUE][8];
+    /** Entry of object dispatching list in OD, 0xFFFF if not used */
+    uint16_t            mpdoList;
+    /** MPDOs lost, because queue was full */
+    uint32_t            mpdoOverflow;
+    /** MPDOs not written, because object is not in dispatching list, does
+    not exist or is not mappable */
+    uint32_t            mpdoIgnored;
+#endif
+    /** From CO_RPDO_initCallback() or NULL */
+    void               *functSignalObject;
+    /** From CO_RPDO_initCallback() or NULL */
+    void              (*pFunctSignal)(void *object);
+#if CO_RPDO_HANDLERS > 0
+    /** From CO_RPDO_initHandler() or NULL */
+    void               *handlerObject;
+    /** From CO_RPDO_initHandler() or NULL */
+    void              (*pFunctHandler)(void *object, const CO_RPDOfield_t *field, uint8_t count);
+    /** Mapped fields, built from mapping */
+    CO_RPDOfield_t      field[8];
+    /** Number of used field */
+    uint8_t             fieldCount;
+#endif
+#ifdef RPDO_CALLS_EXTENSION
+    /** Mapped objects for OD extension calls */
+    CO_PDOmapEntry_t    mapEntry[8];
+    /** Number of used mapEntry */
+    uint8_t             mapEntryCount;
+#endif
+#if CO_TPDO_DIRTY_FLAGS > 0
+    /** OD entries of mapped objects, written data mark TPDOs, which map them */
+    uint16_t            dirtyEntry[8];
+    /** Number of used dirtyEntry */
+    uint8_t             dirtyEntryCount;
+#endif
+    /* configuration, used by SDO access and initialization */
+#if CO_PDO_SHADOW_MAP > 0
+    /** New mapping, activated by CO_RPDO_process() */
+    CO_PDOshadowMap_t   shadow;
+#endif
+#if CO_PDO_FAST_BOOT > 0
+    /** CRC32 of mapping from last successful CO_RPDOconfigMap() */
+    uint32_t            mapFingerprint;
+    /** True, if mapFingerprint is valid */
+    bool_t              mapValid;
+#endif
+    CO_EM_t            *em;             /**< From CO_RPDO_init() */
+    CO_SDO_t           *SDO;            /**< From CO_RPDO_init() */
+    const CO_RPDOCommPar_t *RPDOCommPar;/**< From CO_RPDO_init() */
+    const CO_RPDOMapPar_t  *RPDOMapPar; /**< From CO_RPDO_init() */
+    uint8_t             nodeId;         /**< From CO_RPDO_init() */
+    uint8_t             restrictionFlags;/**< From CO_RPDO_init() */
+    uint16_t            defaultCOB_ID;  /**< From CO_RPDO_init() */
     CO_CANmodule_t     *CANdevRx;       /**< From CO_RPDO_init() */
     uint16_t            CANdevRxIdx;    /**< From CO_RPDO_init() */
 }CO_RPDO_t;
 
 
+#if CO_TPDO_PRESTAGE > 0
+/**
+ * State of pre-staged synchronous TPDO, see CO_TPDO_stage().
+ */
+typedef enum{
+    CO_TPDO_STAGE_OFF   = 0,    /**< TPDO is sent by CO_TPDO_process() */
+    CO_TPDO_STAGE_EMPTY = 1,    /**< Sent at SYNC, nothing is staged */
+    CO_TPDO_STAGE_READY = 2     /**< Sent at SYNC, stageData is valid */
+}CO_TPDO_stageState_t;
+#endif
+
+
 /**
  * TPDO object.
+ *
+ * Members used by CO_TPDO_process() on every call are placed first, with
+ * cached copies of the communication parameters, so processing of many TPDOs
+ * stays within a few cache lines and does not touch Object Dictionary.
  */
 typedef struct{
-    CO_EM_t            *em;             /**< From CO_TPDO_init() */
-    CO_SDO_t           *SDO;            /**< From CO_TPDO_init() */
-    const CO_TPDOCommPar_t *TPDOCommPar;/**< From CO_TPDO_init() */
-    const CO_TPDOMapPar_t  *TPDOMapPar; /**< From CO_TPDO_init() */
-    uint8_t            *operatingState; /**< From CO_TPDO_init() */
-    uint8_t             nodeId;         /**< From CO_TPDO_init() */
-    uint16_t            defaultCOB_ID;  /**< From CO_TPDO_init() */
-    uint8_t             restrictionFlags;/**< From CO_TPDO_init() */
     bool_t              valid;          /**< True, if PDO is enabled and valid */
-    /** Data length of the transmitting PDO message. Calculated from mapping */
-    uint8_t             dataLength;
     /** If application set this flag, PDO will be later sent by
     function CO_TPDO_process(). Depends on transmission type. */
     uint8_t             sendRequest;
-    /** Pointers to 8 data objects, where PDO will be copied */
-    uint8_t            *mapPointer[8];
-    /** Each flag bit is connected with one mapPointer. If flag bit
-    is true, CO_TPDO_process() functiuon will send PDO if
-    Change of State is detected on value pointed by that mapPointer */
-    uint8_t             sendIfCOSFlags;
+    /** Copy of _transmission type_ from TPDOCommPar */
+    uint8_t             transmissionType;
     /** SYNC counter used for PDO sending */
     uint8_t             syncCounter;
+#if CO_TPDO_SYNC_PHASE > 0
+    /** Automatic phase of cyclic synchronous TPDO, node-ID + TPDO number */
+    uint8_t             syncPhase;
+    /** SYNCStartValue from TPDOCommPar or from syncPhase, if that is 0 */
+    uint8_t             syncStart;
+#endif
     /** Inhibit timer used for inhibit PDO sending translated to microseconds */
     uint32_t            inhibitTimer;
     /** Event timer used for PDO sending translated to microseconds */
     uint32_t            eventTimer;
-    CO_CANmodule_t     *CANdevTx;       /**< From CO_TPDO_init() */
+    /** _Inhibit time_ from TPDOCommPar in microseconds */
+    uint32_t            inhibitTime_us;
+#if CO_TPDO_ADAPTIVE_INHIBIT > 0
+    /** Multiplier of inhibitTime_us, 256 is 1.0, see CO_TPDO_setInhibitScale() */
+    uint16_t            inhibitScale;
+#endif
+    /** _Event timer_ from TPDOCommPar in microseconds */
+    uint32_t            eventTime_us;
     CO_CANtx_t         *CANtxBuff;      /**< CAN transmit buffer inside CANdev */
+    uint8_t            *operatingState; /**< From CO_TPDO_init() */
+    /** Data length of the transmitting PDO message. Calculated from mapping */
+    uint8_t             dataLength;
+    /** Number of used copyRun */
+    uint8_t             copyRunCount;
+    /** Each flag bit is connected with one byte of PDO data. If flag bit
+    is true, CO_TPDO_process() functiuon will send PDO if
+    Change of State is detected on value mapped to that byte */
+    CO_PDOcosFlags_t    sendIfCOSFlags;
+#if CO_PDO_MAX_SIZE <= 8
+    /** sendIfCOSFlags expanded to byte mask over the PDO data, built by
+    CO_TPDOconfigMap() */
+    uint64_t            sendIfCOSMask;
+#endif
+#if CO_TPDO_DIRTY_FLAGS > 0
+    /** Bit of this TPDO in CO_OD_extension_t TPDOmask, 0 if not used */
+    uint32_t            dirtyBit;
+#endif
+#if CO_TPDO_STREAM > 0
+    /** True, if TPDO belongs to CO_TPDOstream_t, CO_TPDO_process() skips it */
+    volatile bool_t     stream;
+#endif
+#if CO_TPDO_CALENDAR > 0
+    /** Calendar time, when inhibit time ends. Used instead of inhibitTimer */
+    uint32_t            inhibitEnd;
+    /** Calendar time, when event timer expires. Used instead of eventTimer */
+    uint32_t            eventDue;
+    /** Calendar time of the next CO_TPDOcalendar_process() visit */
+    uint32_t            calDue;
+    /** Position in CO_TPDOcalendar_t heap, CO_TPDO_CAL_NONE if not scheduled */
+    uint16_t            calPos;
+    /** State from the last CO_TPDOcalendar_update(): active and sendRequest */
+    uint8_t             calKey;
+    /** Set by Object Dictionary write of inhibit or event time, then
+    inhibitTimer and eventTimer are taken as new relative deadlines */
+    volatile bool_t     calReschedule;
+#endif
+#if CO_TPDO_PRESTAGE > 0
+    /** CO_TPDO_STAGE_OFF, CO_TPDO_STAGE_EMPTY or CO_TPDO_STAGE_READY */
+    volatile uint8_t    stageState;
+    /** True, if frame was due at SYNC, but not staged. Sent by CO_TPDO_process() */
+    volatile bool_t     stageLate;
+    /** Data assembled by CO_TPDO_stage() */
+    uint8_t             stageData[CO_PDO_MAX_SIZE];
+#endif
+    /** Copy descriptors built from mapping */
+    CO_PDOcopyRun_t     copyRun[CO_PDO_COPY_RUNS];
+#if CO_PDO_MPDO > 0
+    /** CO_PDO_MPDO_SAM, CO_PDO_MPDO_DAM or 0, built from mapping */
+    uint8_t             mpdo;
+    /** Multiplexer of DAM-MPDO, first four bytes of PDO data */
+    uint8_t             mpdoMux[4];
+    /** Destination node-ID of DAM-MPDO, see CO_TPDO_setMPDOdest() */
+    uint8_t             mpdoDest;
+    /** Entry of object scanner list of SAM-MPDO in OD, 0xFFFF if not used */
+    uint16_t            mpdoList;
+    /** Subindex of object scanner list, which is sent next */
+    uint8_t             mpdoScan;
+    /** Offset in the block of the above entry, which is sent next */
+    uint8_t             mpdoBlock;
+#endif
+#ifdef TPDO_CALLS_EXTENSION
+    /** Mapped objects for OD extension calls */
+    CO_PDOmapEntry_t    mapEntry[8];
+    /** Number of used mapEntry */
+    uint8_t             mapEntryCount;
+#endif
+    /* configuration, used by SDO access and initialization */
+#if CO_PDO_SHADOW_MAP > 0
+    /** New mapping, activated by CO_TPDO_process() */
+    CO_PDOshadowMap_t   shadow;
+#endif
+#if CO_PDO_FAST_BOOT > 0
+    /** CRC32 of mapping from last successful CO_TPDOconfigMap() */
+    uint32_t            mapFingerprint;
+    /** True, if mapFingerprint is valid */
+    bool_t              mapValid;
+#endif
+    CO_EM_t            *em;             /**< From CO_TPDO_init() */
+    CO_SDO_t           *SDO;            /**< From CO_TPDO_init() */
+    const CO_TPDOCommPar_t *TPDOCommPar;/**< From CO_TPDO_init() */
+    const CO_TPDOMapPar_t  *TPDOMapPar; /**< From CO_TPDO_init() */
+    uint8_t             nodeId;         /**< From CO_TPDO_init() */
+    uint8_t             restrictionFlags;/**< From CO_TPDO_init() */
+    uint16_t            defaultCOB_ID;  /**< From CO_TPDO_init() */
+    CO_CANmodule_t     *CANdevTx;       /**< From CO_TPDO_init() */
     uint16_t            CANdevTxIdx;    /**< From CO_TPDO_init() */
 }CO_TPDO_t;
 
 
+#if CO_TPDO_CALENDAR > 0
+/** TPDO is not in calendar heap, see calPos in CO_TPDO_t */
+#define CO_TPDO_CAL_NONE        0xFFFFU
+
+/**
+ * Deadline calendar of event driven TPDOs (transmission type 253 to 255).
+ *
+ * TPDOs are ordered by calDue in a binary min-heap, so CO_TPDOcalendar_process()
+ * visits only due TPDOs and reads the next deadline from the heap top.
+ * Calendar time is a wrapping microsecond counter, deadlines are compared
+ * as signed differences. Synchronous TPDOs are not in the calendar.
+ */
+typedef struct{
+    uint32_t            now;            /**< Calendar time in microseconds */
+    CO_TPDO_t         **heap;           /**< From CO_TPDOcalendar_init() */
+    uint16_t            size;           /**< From CO_TPDOcalendar_init() */
+    uint16_t            count;          /**< Number of scheduled TPDOs */
+}CO_TPDOcalendar_t;
+#endif
+
+
 /**
  * Initialize RPDO object.
  *
@@ -253,6 +619,7 @@ typedef struct{
  * @param RPDO This object will be initialized.
  * @param em Emergency object.
  * @param SDO SDO server object.
+ * @param SYNC SYNC object. If NULL, synchronous PDO is accepted as asynchronous.
  * @param operatingState Pointer to variable indicating CANopen device NMT internal state.
  * @param nodeId CANopen Node ID of this device. If default COB_ID is used, value will be added.
  * @param defaultCOB_ID Default COB ID for this PDO (without NodeId).
@@ -367,6 +734,106 @@ uint8_t CO_TPDOisCOS(CO_TPDO_t *TPDO);
 int16_t CO_TPDOsend(CO_TPDO_t *TPDO);
 
 
+/**
+ * Initialize RPDO callback function and immediate mode.
+ *
+ * Function initializes optional callback function, which executes after
+ * received PDO data are copied to Object Dictionary variables.
+ *
+ * If _immediate_ is true, asynchronous PDO (transmissionType >= 241) is copied
+ * to Object Dictionary directly inside CAN receive interrupt and callback is
+ * called from there too, so callback must be short and interrupt safe.
+ * CO_RPDO_process() then has nothing to do for this PDO. OD extensions
+ * (RPDO_CALLS_EXTENSION) are not called in immediate mode. Synchronous PDOs
+ * are always copied by CO_RPDO_process().
+ *
+ * Function must be called after CO_RPDO_init().
+ *
+ * @param RPDO This object.
+ * @param immediate Copy asynchronous PDO inside receive thread.
+ * @param object Pointer to object, which will be passed to pFunctSignal(). Can be NULL.
+ * @param pFunctSignal Pointer to the callback function. Not called if NULL.
+ */
+void CO_RPDO_initCallback(
+        CO_RPDO_t              *RPDO,
+        bool_t                  immediate,
+        void                   *object,
+        void                  (*pFunctSignal)(void *object));
+
+
+#if CO_RPDO_HANDLERS > 0
+/**
+ * Initialize typed RPDO handler.
+ *
+ * Handler is called each time RPDO is accepted, after data are copied to
+ * Object Dictionary and before callback from CO_RPDO_initCallback(). It is
+ * called from the same thread as that callback: from CAN receive interrupt in
+ * immediate mode, otherwise from CO_RPDO_process(). Handler receives mapped
+ * fields in mapping order and may read them with CO_RPDO_FIELD(). It is not
+ * called in direct mode (CO_RPDO_setDirect()), where OD is not written.
+ *
+ * Function must be called after CO_RPDO_init().
+ *
+ * @param RPDO This object.
+ * @param object Pointer to object, which will be passed to pFunctHandler(). Can be NULL.
+ * @param pFunctHandler Pointer to the handler. Not called if NULL.
+ */
+void CO_RPDO_initHandler(
+        CO_RPDO_t              *RPDO,
+        void                   *object,
+        void                  (*pFunctHandler)(void *object, const CO_RPDOfield_t *field, uint8_t count));
+#endif
+
+
+#if CO_RPDO_SEQLOCK > 0
+/**
+ * Read consistent snapshot of received RPDO data.
+ *
+ * Function copies data from the receive buffer and repeats the copy, if
+ * receive interrupt has written the buffer meanwhile, so no lock is needed.
+ * For synchronous RPDO, the buffer received before the last SYNC is read, the
+ * same as CO_RPDO_process() uses. Buffer is selected once, inside
+ * CO_LOCK_CAN_SEND(), so SYNC reception can't switch it during the copy.
+ *
+ * @param RPDO This object.
+ * @param data Buffer for #CO_PDO_MAX_SIZE data bytes.
+ *
+ * @return Sequence number of the buffer, 0 if nothing was received. Value
+ * changes with each message received into the buffer.
+ */
+uint32_t CO_RPDO_readData(const CO_RPDO_t *RPDO, uint8_t *data);
+
+
+/**
+ * Set direct read mode.
+ *
+ * If _direct_ is true, CO_RPDO_process() does not copy received data to
+ * Object Dictionary, it only calls the callback from CO_RPDO_initCallback().
+ * Application reads data with CO_RPDO_readData(). Immediate mode has
+ * precedence.
+ *
+ * @param RPDO This object.
+ * @param direct Application reads data from the receive buffer.
+ */
+void CO_RPDO_setDirect(CO_RPDO_t *RPDO, bool_t direct);
+#endif
+
+
+#if CO_TPDO_DIRTY_FLAGS > 0
+/**
+ * Mark TPDOs, which map OD object, for change of state verification.
+ *
+ * Application must call this function after it writes OD variable mapped to
+ * TPDO with change of state detection. May be called from any thread. Objects
+ * written by SDO server and by RPDOs are marked automatically.
+ *
+ * @param SDO SDO server object, which owns Object Dictionary.
+ * @param index Index of written object in Object Dictionary.
+ */
+void CO_TPDOmarkDirty(CO_SDO_t *SDO, uint16_t index);
+#endif
+
+
 /**
  * Process received PDO messages.
  *
@@ -391,12 +858,170 @@ void CO_RPDO_process(CO_RPDO_t *RPDO, bool_t syncWas);
  * @param SYNC SYNC object. Ignored if NULL.
  * @param syncWas True, if CANopen SYNC message was just received or transmitted.
  * @param timeDifference_us Time difference from previous function call in [microseconds].
+ * @param timerNext_us Return value - info to OS - see CO_SYNC_process().
  */
 void CO_TPDO_process(
         CO_TPDO_t              *TPDO,
         CO_SYNC_t              *SYNC,
         bool_t                  syncWas,
-        uint32_t                timeDifference_us);
+        uint32_t                timeDifference_us,
+        uint32_t               *timerNext_us);
+
+
+#if CO_TPDO_PRESTAGE > 0
+/**
+ * Assemble synchronous TPDO for the next SYNC.
+ *
+ * Function copies mapped Object Dictionary variables into TPDO staging buffer
+ * and switches TPDO to pre-staged mode, in which synchronous transmission is
+ * done by CO_TPDO_syncRelease() only. Application calls it, when inputs for
+ * the next SYNC are latched, from the same thread as CO_TPDO_process(). If
+ * TPDO is not staged again before the SYNC, at which it is due, it is sent
+ * late by CO_TPDO_process() with actual Object Dictionary values.
+ *
+ * @param TPDO This object.
+ */
+void CO_TPDO_stage(CO_TPDO_t *TPDO);
+
+
+/**
+ * Send pre-staged synchronous TPDO at SYNC.
+ *
+ * Function must be called from SYNC callback, see CO_SYNC_initCallback(). It
+ * advances SYNC counter of the TPDO in the same way as CO_TPDO_process() and
+ * sends staged data with CO_CANsend(), if TPDO is due at this SYNC. Function
+ * returns immediately for TPDO, which is not pre-staged.
+ *
+ * @param TPDO This object.
+ * @param SYNC SYNC object, counter is already updated.
+ */
+void CO_TPDO_syncRelease(CO_TPDO_t *TPDO, CO_SYNC_t *SYNC);
+#endif
+
+#if CO_PDO_MPDO > 0
+/**
+ * Set destination of DAM-MPDO.
+ *
+ * CO_TPDO_init() sets destination 0, all nodes. Destination is kept on
+ * mapping changes and used from the next transmission, call it from the same
+ * thread as CO_TPDO_process().
+ *
+ * @param TPDO This object.
+ * @param nodeId Node-ID of the consumer, 0 for all nodes.
+ */
+void CO_TPDO_setMPDOdest(CO_TPDO_t *TPDO, uint8_t nodeId);
+#endif
+
+#if CO_PDO_SHADOW_MAP > 0
+/**
+ * Stage new RPDO mapping.
+ *
+ * Mapping is validated and stored in shadow, the next CO_RPDO_process()
+ * writes it into OD and activates it. Messages received before, but not yet
+ * processed, are dropped then. PDO may be valid, restriction flags from
+ * CO_RPDO_init() are not checked. Call it from the same thread as SDO server.
+ *
+ * @param RPDO This object.
+ * @param noOfMappedObjects Number of mapped objects, 0 to 8 or MPDO.
+ * @param map Mapped objects, noOfMappedObjects entries (one for DAM-MPDO,
+ * none for SAM-MPDO). Other subindexes keep their values.
+ *
+ * @return 0 on success, otherwise SDO abort code. CO_SDO_AB_DATA_DEV_STATE,
+ * if previous mapping is not activated yet.
+ */
+uint32_t CO_RPDO_stageMap(CO_RPDO_t *RPDO, uint8_t noOfMappedObjects, const uint32_t *map);
+
+/**
+ * Stage new TPDO mapping.
+ *
+ * The same as CO_RPDO_stageMap(), activated by the next CO_TPDO_process().
+ *
+ * @param TPDO This object.
+ * @param noOfMappedObjects Number of mapped objects, 0 to 8 or MPDO.
+ * @param map Mapped objects, see CO_RPDO_stageMap().
+ *
+ * @return 0 on success, otherwise SDO abort code.
+ */
+uint32_t CO_TPDO_stageMap(CO_TPDO_t *TPDO, uint8_t noOfMappedObjects, const uint32_t *map);
+#endif
+
+#if CO_TPDO_ADAPTIVE_INHIBIT > 0
+/**
+ * Stretch inhibit time of TPDO, see CO_TPDO_ADAPTIVE_INHIBIT.
+ *
+ * Effective inhibit time is _Inhibit time_ from OD multiplied by scale / 256.
+ * New value is used from the next transmission. Single 16-bit write needs no
+ * lock, so function may be called from mainline. CO_TPDO_init() sets scale
+ * to 256.
+ *
+ * @param TPDO This object.
+ * @param scale Multiplier, 256 for inhibit time from OD. Values below 256 are
+ * limited to 256.
+ */
+void CO_TPDO_setInhibitScale(CO_TPDO_t *TPDO, uint16_t scale);
+#endif
+
+#if CO_TPDO_CALENDAR > 0
+/**
+ * Initialize TPDO calendar.
+ *
+ * Function must be called in the communication reset section, before
+ * CO_TPDO_init() of its TPDOs.
+ *
+ * @param cal This object will be initialized.
+ * @param heap Array for the heap, one element for each TPDO.
+ * @param size Size of the above array.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_TPDOcalendar_init(
+        CO_TPDOcalendar_t      *cal,
+        CO_TPDO_t              *heap[],
+        uint16_t                size);
+
+
+/**
+ * Advance calendar time.
+ *
+ * Function must be called once at the beginning of each CO_process_TPDO()
+ * cycle, before CO_TPDOcalendar_update() and CO_TPDOcalendar_process().
+ *
+ * @param cal This object.
+ * @param timeDifference_us Time difference from previous call in [microseconds].
+ */
+static inline void CO_TPDOcalendar_tick(CO_TPDOcalendar_t *cal, uint32_t timeDifference_us){
+    cal->now += timeDifference_us;
+}
+
+
+/**
+ * Update calendar entry of event driven TPDO.
+ *
+ * Function replaces the state part of CO_TPDO_process() for TPDO with
+ * transmission type 253 to 255. It must be called in each cycle, after
+ * sendRequest is updated. It only compares the TPDO state with the state at
+ * the last call and reschedules the TPDO, if state, sendRequest or timing
+ * parameters changed.
+ *
+ * @param cal This object.
+ * @param TPDO TPDO object.
+ */
+void CO_TPDOcalendar_update(CO_TPDOcalendar_t *cal, CO_TPDO_t *TPDO);
+
+
+/**
+ * Send due TPDOs.
+ *
+ * Function sends each TPDO from the heap top, whose deadline expired, and
+ * schedules its next deadline. TPDO, which could not be sent, is retried in
+ * the next cycle.
+ *
+ * @param cal This object.
+ * @param timerNext_us Return value - info to OS - time to the next deadline,
+ * see CO_SYNC_process(). Parameter is ignored if NULL.
+ */
+void CO_TPDOcalendar_process(CO_TPDOcalendar_t *cal, uint32_t *timerNext_us);
+#endif
 
 #ifdef __cplusplus
 }
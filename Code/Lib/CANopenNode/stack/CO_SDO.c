@@ -47,6 +47,7 @@
 #include "CO_driver.h"
 #include "CO_SDO.h"
 #include "crc16-ccitt.h"
+#include <string.h>
 
 
 /* Client command specifier, see DS301 */
@@ -63,8 +64,44 @@
     #error CO_SDO_BUFFER_SIZE must be greater than 7
 #endif
 
+#if CO_SDO_BLOCK_SIZE < 1 || CO_SDO_BLOCK_SIZE > 127
+    #error CO_SDO_BLOCK_SIZE must be in range from 1 to 127
+#endif
+
+#if CO_SDO_BUFFER_POOL > 32
+    #error CO_SDO_BUFFER_POOL must be in range from 0 to 32
+#endif
+
+#if CO_SDO_RX_QUEUE > 128 || (CO_SDO_RX_QUEUE & (CO_SDO_RX_QUEUE - 1)) != 0
+    #error CO_SDO_RX_QUEUE must be 0 or power of two up to 128
+#endif
+
+#if CO_SDO_DOMAIN_PREFETCH > 0 && CO_SDO_ODF_PENDING == 0
+    #error CO_SDO_DOMAIN_PREFETCH requires CO_SDO_ODF_PENDING
+#endif
+
+#if CO_SDO_DOMAIN_PREFETCH > 0 && CO_SDO_BUFFER_SIZE < 14
+    #error CO_SDO_BUFFER_SIZE must be at least 14 with CO_SDO_DOMAIN_PREFETCH
+#endif
+
+
+/* Size of data buffer of SDO server */
+#if CO_SDO_BUFFER_EXT > 0
+    #define CO_SDO_BUFSIZE(SDO)            ((SDO)->bufferSize)
+#else
+    #define CO_SDO_BUFSIZE(SDO)            ((uint16_t)CO_SDO_BUFFER_SIZE)
+#endif
+
+#if CO_SDO_DOMAIN_PREFETCH > 0
+/* Reading of next data of domain upload, see CO_SDO_prefetch() */
+#define CO_SDO_PREFETCH_IDLE           0U  /* No more data or not domain */
+#define CO_SDO_PREFETCH_BUSY           1U  /* OD function returned CO_SDO_AB_PENDING */
+#define CO_SDO_PREFETCH_READY          2U  /* Data are in prefetchData */
+#endif
+
 
 /* Helper functions. **********************************************************/
+#if CO_INLINE_HELPERS == 0
 void CO_memcpy(uint8_t dest[], const uint8_t src[], const uint16_t size){
     uint16_t i;
     for(i = 0; i < size; i++){
@@ -172,6 +209,75 @@ void CO_memcpySwap8(void* dest, const void* src){
     cdest[7] = csrc[0];
 }
 #endif
+#endif /* CO_INLINE_HELPERS == 0 */
+
+
+/*
+ * Take data of received message.
+ *
+ * Message is copied into CANrxData, or segment of block download directly
+ * into the data buffer. Called from CO_SDO_receive() or from
+ * CO_SDO_receiveQueued(), if CANrxNew is not set.
+ *
+ * @param SDO This object.
+ * @param data 8 data bytes of the message.
+ */
+static void CO_SDO_receiveData(CO_SDO_t *SDO, const uint8_t data[]){
+    if(SDO->state != CO_SDO_ST_DOWNLOAD_BL_SUBBLOCK) {
+        /* copy data and set 'new message' flag */
+        SDO->CANrxData[0] = data[0];
+        SDO->CANrxData[1] = data[1];
+        SDO->CANrxData[2] = data[2];
+        SDO->CANrxData[3] = data[3];
+        SDO->CANrxData[4] = data[4];
+        SDO->CANrxData[5] = data[5];
+        SDO->CANrxData[6] = data[6];
+        SDO->CANrxData[7] = data[7];
+
+        SDO->CANrxNew = true;
+    }
+    else {
+        /* block download, copy data directly */
+        uint8_t seqno;
+
+        SDO->CANrxData[0] = data[0];
+        seqno = SDO->CANrxData[0] & 0x7fU;
+        SDO->timeoutTimer = 0;
+
+        /* check correct sequence number. */
+        if(seqno == (SDO->sequence + 1U)) {
+            /* sequence is correct */
+            uint8_t i;
+
+            SDO->sequence++;
+
+            /* copy data */
+            for(i=1; i<8; i++) {
+                SDO->ODF_arg.data[SDO->bufferOffset++] = data[i]; //SDO->ODF_arg.data is equal as SDO->databuffer
+                if(SDO->bufferOffset >= CO_SDO_BUFSIZE(SDO)) {
+                    /* buffer full, break reception */
+                    SDO->state = CO_SDO_ST_DOWNLOAD_BL_SUB_RESP;
+                    SDO->CANrxNew = true;
+                    break;
+                }
+            }
+
+            /* break reception if last segment or block sequence is too large */
+            if(((SDO->CANrxData[0] & 0x80U) == 0x80U) || (SDO->sequence >= SDO->blksize)) {
+                SDO->state = CO_SDO_ST_DOWNLOAD_BL_SUB_RESP;
+                SDO->CANrxNew = true;
+            }
+        }
+        else if((seqno == SDO->sequence) || (SDO->sequence == 0U)){
+            /* Ignore message, if it is duplicate or if sequence didn't started yet. */
+        }
+        else {
+            /* seqno is totally wrong, break reception. */
+            SDO->state = CO_SDO_ST_DOWNLOAD_BL_SUB_RESP;
+            SDO->CANrxNew = true;
+        }
+    }
+}
 
 
 /*
@@ -187,67 +293,42 @@ static void CO_SDO_receive(void *object, const CO_CANrxMsg_t *msg){
 
     SDO = (CO_SDO_t*)object;   /* this is the correct pointer type of the first argument */
 
-    /* WARNING: When doing a SDO block upload and immediately after that
-     * starting another SDO request, this request is dropped. Especially if
-     * processing function has slow response.
-     * See: https://github.com/CANopenNode/CANopenNode/issues/39 */
-
-    /* verify message length and message overflow (previous message was not processed yet) */
-    if((msg->DLC == 8U) && (!SDO->CANrxNew)){
-        if(SDO->state != CO_SDO_ST_DOWNLOAD_BL_SUBBLOCK) {
-            /* copy data and set 'new message' flag */
-            SDO->CANrxData[0] = msg->data[0];
-            SDO->CANrxData[1] = msg->data[1];
-            SDO->CANrxData[2] = msg->data[2];
-            SDO->CANrxData[3] = msg->data[3];
-            SDO->CANrxData[4] = msg->data[4];
-            SDO->CANrxData[5] = msg->data[5];
-            SDO->CANrxData[6] = msg->data[6];
-            SDO->CANrxData[7] = msg->data[7];
+    /* verify message length */
+    if(msg->DLC == 8U){
+#if CO_SDO_RX_QUEUE > 0
+        /* previous message was not processed yet, keep order of messages */
+        if(SDO->CANrxNew || (SDO->CANrxHead != SDO->CANrxTail)){
+            uint8_t head = SDO->CANrxHead;
 
-            SDO->CANrxNew = true;
-        }
-        else {
-            /* block download, copy data directly */
-            uint8_t seqno;
-
-            SDO->CANrxData[0] = msg->data[0];
-            seqno = SDO->CANrxData[0] & 0x7fU;
-            SDO->timeoutTimer = 0;
-
-            /* check correct sequence number. */
-            if(seqno == (SDO->sequence + 1U)) {
-                /* sequence is correct */
+            if((uint8_t)(head - SDO->CANrxTail) < CO_SDO_RX_QUEUE){
+                uint8_t *dest = SDO->CANrxQueue[head & (CO_SDO_RX_QUEUE - 1U)];
                 uint8_t i;
 
-                SDO->sequence++;
-
-                /* copy data */
-                for(i=1; i<8; i++) {
-                    SDO->ODF_arg.data[SDO->bufferOffset++] = msg->data[i]; //SDO->ODF_arg.data is equal as SDO->databuffer
-                    if(SDO->bufferOffset >= CO_SDO_BUFFER_SIZE) {
-                        /* buffer full, break reception */
-                        SDO->state = CO_SDO_ST_DOWNLOAD_BL_SUB_RESP;
-                        SDO->CANrxNew = true;
-                        break;
-                    }
+                for(i=0; i<8; i++) {
+                    dest[i] = msg->data[i];
                 }
-
-                /* break reception if last segment or block sequence is too large */
-                if(((SDO->CANrxData[0] & 0x80U) == 0x80U) || (SDO->sequence >= SDO->blksize)) {
-                    SDO->state = CO_SDO_ST_DOWNLOAD_BL_SUB_RESP;
-                    SDO->CANrxNew = true;
-                }
-            }
-            else if((seqno == SDO->sequence) || (SDO->sequence == 0U)){
-                /* Ignore message, if it is duplicate or if sequence didn't started yet. */
+                CO_MEMORY_BARRIER();
+                SDO->CANrxHead = head + 1U;
             }
-            else {
-                /* seqno is totally wrong, break reception. */
-                SDO->state = CO_SDO_ST_DOWNLOAD_BL_SUB_RESP;
-                SDO->CANrxNew = true;
+
+            /* Optional signal to RTOS, which can resume task, which handles SDO server. */
+            if(SDO->pFunctSignal != NULL) {
+                SDO->pFunctSignal();
             }
+            return;
+        }
+#else
+        /* WARNING: When doing a SDO block upload and immediately after that
+         * starting another SDO request, this request is dropped. Especially if
+         * processing function has slow response. Use CO_SDO_RX_QUEUE.
+         * See: https://github.com/CANopenNode/CANopenNode/issues/39 */
+
+        /* message overflow (previous message was not processed yet) */
+        if(SDO->CANrxNew){
+            return;
         }
+#endif
+        CO_SDO_receiveData(SDO, msg->data);
 
         /* Optional signal to RTOS, which can resume task, which handles SDO server. */
         if(SDO->CANrxNew && SDO->pFunctSignal != NULL) {
@@ -257,6 +338,28 @@ static void CO_SDO_receive(void *object, const CO_CANrxMsg_t *msg){
 }
 
 
+#if CO_SDO_RX_QUEUE > 0
+/*
+ * Take queued messages, until one of them has to be processed.
+ *
+ * Frame stays in the queue, until it is taken, so receive interrupt does not
+ * pass it in the meantime.
+ *
+ * @param SDO This object.
+ */
+static void CO_SDO_receiveQueued(CO_SDO_t *SDO){
+    while(!SDO->CANrxNew && (SDO->CANrxTail != SDO->CANrxHead)){
+        uint8_t tail = SDO->CANrxTail;
+
+        CO_MEMORY_BARRIER();
+        CO_SDO_receiveData(SDO, SDO->CANrxQueue[tail & (CO_SDO_RX_QUEUE - 1U)]);
+        CO_MEMORY_BARRIER();
+        SDO->CANrxTail = tail + 1U;
+    }
+}
+#endif
+
+
 /*
  * Function for accessing _SDO server parameter_ for default SDO (index 0x1200)
  * from SDO server.
@@ -281,6 +384,82 @@ static CO_SDO_abortCode_t CO_ODF_1200(CO_ODF_arg_t *ODF_arg){
 }
 
 
+#if CO_OD_HASH_BITS > 0
+/* Fibonacci hash of OD index to slot in ODhashTable */
+#define CO_OD_HASH(index)   ((uint16_t)((uint16_t)((index) * 40503U) >> (16U - CO_OD_HASH_BITS)))
+
+/*
+ * Build hash table from Object Dictionary.
+ *
+ * If table is too small for the Object Dictionary, it is not used and
+ * CO_OD_find() uses binary search.
+ *
+ * @param SDO SDO object with own Object dictionary.
+ */
+static void CO_OD_buildHash(CO_SDO_t *SDO){
+    uint16_t i;
+
+    SDO->ODhash = NULL;
+    if(SDO->ODSize >= (1U << CO_OD_HASH_BITS)){
+        return;
+    }
+
+    for(i=0U; i<(1U << CO_OD_HASH_BITS); i++){
+        SDO->ODhashTable[i] = 0xFFFFU;
+    }
+    for(i=0U; i<SDO->ODSize; i++){
+        uint16_t slot = CO_OD_HASH(SDO->OD[i].index);
+
+        while(SDO->ODhashTable[slot] != 0xFFFFU){
+            slot = (slot + 1U) & ((1U << CO_OD_HASH_BITS) - 1U);
+        }
+        SDO->ODhashTable[slot] = i;
+    }
+    SDO->ODhash = SDO->ODhashTable;
+}
+#endif
+
+
+#if CO_OD_FLAT_SIZE > 0
+/*
+ * Build flat table of subindex descriptors from Object Dictionary.
+ *
+ * If table is too small for the Object Dictionary, it is not used and
+ * CO_OD_getXXX() functions decode Object Dictionary on each call.
+ *
+ * @param SDO SDO object with own Object dictionary.
+ */
+static void CO_OD_buildFlat(CO_SDO_t *SDO){
+    uint16_t i;
+    uint32_t size = 0U;
+
+    SDO->ODflat = NULL;
+    for(i=0U; i<SDO->ODSize; i++){
+        size += (uint32_t)SDO->OD[i].maxSubIndex + 1U;
+    }
+    if(size > CO_OD_FLAT_SIZE){
+        return;
+    }
+
+    size = 0U;
+    for(i=0U; i<SDO->ODSize; i++){
+        uint16_t sub;
+
+        SDO->ODExtensions[i].flatIdx = (uint16_t)size;
+        for(sub=0U; sub<=SDO->OD[i].maxSubIndex; sub++){
+            CO_OD_subEntry_t *flat = &SDO->ODflatTable[size++];
+
+            flat->pData = CO_OD_getDataPointer(SDO, i, (uint8_t)sub);
+            flat->pFlags = NULL;
+            flat->length = CO_OD_getLength(SDO, i, (uint8_t)sub);
+            flat->attribute = CO_OD_getAttribute(SDO, i, (uint8_t)sub);
+        }
+    }
+    SDO->ODflat = SDO->ODflatTable;
+}
+#endif
+
+
 /******************************************************************************/
 CO_ReturnError_t CO_SDO_init(
         CO_SDO_t               *SDO,
@@ -298,7 +477,7 @@ CO_ReturnError_t CO_SDO_init(
         uint16_t                CANdevTxIdx)
 {
     /* verify arguments */
-    if(SDO==NULL || CANdevRx==NULL || CANdevTx==NULL){
+    if(SDO==NULL || (CANdevRx==NULL) != (CANdevTx==NULL)){
         return CO_ERROR_ILLEGAL_ARGUMENT;
     }
 
@@ -316,7 +495,27 @@ CO_ReturnError_t CO_SDO_init(
             SDO->ODExtensions[i].pODFunc = NULL;
             SDO->ODExtensions[i].object = NULL;
             SDO->ODExtensions[i].flags = NULL;
+#if CO_TPDO_DIRTY_FLAGS > 0
+            SDO->ODExtensions[i].TPDOmask = 0U;
+#endif
+#if CO_OD_NOTIFY > 0
+            SDO->ODExtensions[i].notify = false;
+#endif
         }
+#if CO_OD_HASH_BITS > 0
+        CO_OD_buildHash(SDO);
+#endif
+#if CO_OD_FLAT_SIZE > 0
+        CO_OD_buildFlat(SDO);
+#endif
+#if CO_TPDO_DIRTY_FLAGS > 0
+        SDO->TPDOdirty = 0U;
+        SDO->pTPDOdirty = &SDO->TPDOdirty;
+#endif
+#if CO_OD_ATOMIC > 0
+        SDO->ODsequence = 0U;
+        SDO->pODsequence = &SDO->ODsequence;
+#endif
     }
     /* copy object dictionary from parent */
     else{
@@ -324,13 +523,57 @@ CO_ReturnError_t CO_SDO_init(
         SDO->OD = parentSDO->OD;
         SDO->ODSize = parentSDO->ODSize;
         SDO->ODExtensions = parentSDO->ODExtensions;
+#if CO_OD_HASH_BITS > 0
+        SDO->ODhash = parentSDO->ODhash;
+#endif
+#if CO_OD_FLAT_SIZE > 0
+        SDO->ODflat = parentSDO->ODflat;
+#endif
+#if CO_TPDO_DIRTY_FLAGS > 0
+        SDO->pTPDOdirty = parentSDO->pTPDOdirty;
+#endif
+#if CO_OD_ATOMIC > 0
+        SDO->pODsequence = parentSDO->pODsequence;
+#endif
     }
 
     /* Configure object variables */
     SDO->nodeId = nodeId;
     SDO->state = CO_SDO_ST_IDLE;
     SDO->CANrxNew = false;
+#if CO_SDO_RX_QUEUE > 0
+    SDO->CANrxHead = 0U;
+    SDO->CANrxTail = 0U;
+#endif
+#if CO_SDO_ODF_PENDING > 0
+    SDO->pending = false;
+    SDO->pendingDone = false;
+#endif
     SDO->pFunctSignal = NULL;
+    SDO->pFunctWrite = NULL;
+    SDO->functWriteObject = NULL;
+#if CO_OD_NOTIFY > 0
+    SDO->ODnotify = NULL;
+#endif
+#if CO_SDO_BUFFER_POOL > 0
+    SDO->databuffer = NULL;
+    SDO->bufferPool = NULL;
+#if CO_SDO_BUFFER_EXT > 0
+    SDO->bufferExt = NULL;
+#endif
+#elif CO_SDO_BUFFER_EXT > 0
+    SDO->databuffer = &SDO->databufferOwn[0];
+#endif
+#if CO_SDO_BUFFER_EXT > 0
+    SDO->bufferSize = CO_SDO_BUFFER_SIZE;
+#endif
+#if CO_SDO_DOMAIN_PREFETCH > 0
+    SDO->prefetchData = NULL;
+    SDO->prefetchSplit = 0U;
+    SDO->prefetchLength = 0U;
+    SDO->prefetchLast = false;
+    SDO->prefetchState = CO_SDO_PREFETCH_IDLE;
+#endif
 
 
     /* Configure Object dictionary entry at index 0x1200 */
@@ -338,6 +581,13 @@ CO_ReturnError_t CO_SDO_init(
         CO_OD_configure(SDO, ObjDictIndex_SDOServerParameter, CO_ODF_1200, (void*)&SDO->nodeId, 0U, 0U);
     }
 
+    /* Object Dictionary only, see CO_PRUNE_SDO_SERVER */
+    if(CANdevRx == NULL){
+        SDO->CANdevTx = NULL;
+        SDO->CANtxBuff = NULL;
+        return CO_ERROR_NO;
+    }
+
     if((COB_IDClientToServer & 0x80000000) != 0 || (COB_IDServerToClient & 0x80000000) != 0 ){
         // SDO is invalid
         COB_IDClientToServer = 0;
@@ -367,6 +617,112 @@ CO_ReturnError_t CO_SDO_init(
 }
 
 
+#if CO_SDO_BUFFER_POOL > 0
+/******************************************************************************/
+void CO_SDO_initBufferPool(
+        CO_SDO_t               *SDO,
+        CO_SDObufferPool_t     *bufferPool)
+{
+    if(SDO != NULL){
+        SDO->bufferPool = bufferPool;
+        if(SDO->ownOD && bufferPool != NULL){
+            bufferPool->used = 0U;
+        }
+    }
+}
+
+
+/*
+ * Lease data buffer from pool.
+ *
+ * @param SDO This object.
+ *
+ * @return true, if SDO has data buffer.
+ */
+static bool_t CO_SDO_leaseBuffer(CO_SDO_t *SDO){
+    bool_t ret = false;
+
+    if(SDO->databuffer != NULL){
+        ret = true;
+    }
+#if CO_SDO_BUFFER_EXT > 0
+    else if(SDO->bufferExt != NULL){
+        SDO->databuffer = SDO->bufferExt;
+        ret = true;
+    }
+#endif
+    else if(SDO->bufferPool != NULL){
+        uint8_t i;
+
+        CO_LOCK_OD();
+        for(i=0U; i<CO_SDO_BUFFER_POOL; i++){
+            if((SDO->bufferPool->used & (1UL << i)) == 0U){
+                SDO->bufferPool->used |= 1UL << i;
+                SDO->databuffer = &SDO->bufferPool->buffer[i][0];
+                ret = true;
+                break;
+            }
+        }
+        CO_UNLOCK_OD();
+    }
+
+    return ret;
+}
+
+
+/*
+ * Return data buffer to pool.
+ *
+ * @param SDO This object.
+ */
+static void CO_SDO_releaseBuffer(CO_SDO_t *SDO){
+#if CO_SDO_BUFFER_EXT > 0
+    if(SDO->databuffer == SDO->bufferExt){
+        SDO->databuffer = NULL;
+    }
+#endif
+    if(SDO->databuffer != NULL){
+        uint8_t i = (uint8_t)((SDO->databuffer - &SDO->bufferPool->buffer[0][0]) / CO_SDO_BUFFER_SIZE);
+
+        CO_LOCK_OD();
+        SDO->bufferPool->used &= ~(1UL << i);
+        CO_UNLOCK_OD();
+        SDO->databuffer = NULL;
+    }
+}
+#endif
+
+
+#if CO_SDO_BUFFER_EXT > 0
+/******************************************************************************/
+CO_ReturnError_t CO_SDO_initBuffer(
+        CO_SDO_t               *SDO,
+        uint8_t                *buffer,
+        uint16_t                bufferSize)
+{
+    if(SDO == NULL || SDO->state != CO_SDO_ST_IDLE){
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+    if(buffer == NULL){
+        bufferSize = CO_SDO_BUFFER_SIZE;
+    }
+    else if(bufferSize < ((CO_SDO_DOMAIN_PREFETCH > 0) ? 14U : 7U)){
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+#if CO_SDO_BUFFER_POOL > 0
+    /* buffer is taken by CO_SDO_leaseBuffer() */
+    SDO->bufferExt = buffer;
+#else
+    SDO->databuffer = (buffer != NULL) ? buffer : &SDO->databufferOwn[0];
+#endif
+    SDO->bufferSize = bufferSize;
+
+    return CO_ERROR_NO;
+}
+#endif
+
+
 /******************************************************************************/
 void CO_SDO_initCallback(
         CO_SDO_t               *SDO,
@@ -378,6 +734,142 @@ void CO_SDO_initCallback(
 }
 
 
+/******************************************************************************/
+void CO_SDO_initCallbackWrite(
+        CO_SDO_t               *SDO,
+        void                   *object,
+        void                  (*pFunctWrite)(void *object, const void *ODdata, uint16_t length))
+{
+    if(SDO != NULL){
+        SDO->functWriteObject = object;
+        SDO->pFunctWrite = pFunctWrite;
+    }
+}
+
+
+#if CO_OD_NOTIFY > 0
+/******************************************************************************/
+void CO_SDO_initNotify(
+        CO_SDO_t               *SDO,
+        CO_ODnotify_t          *ODnotify)
+{
+    if(SDO != NULL){
+        SDO->ODnotify = ODnotify;
+        if(SDO->ownOD && ODnotify != NULL){
+            ODnotify->subscriberCount = 0U;
+            ODnotify->queueCount = 0U;
+            ODnotify->overflow = false;
+        }
+    }
+}
+
+
+/*
+ * Queue change of subscribed OD variable, called inside CO_LOCK_OD().
+ *
+ * @param SDO This object.
+ * @param entryNo Sequence number of written entry.
+ * @param subIndex Written subindex.
+ */
+static void CO_OD_notifyPost(CO_SDO_t *SDO, uint16_t entryNo, uint8_t subIndex){
+    CO_ODnotify_t *ODnotify = SDO->ODnotify;
+    uint16_t index = SDO->OD[entryNo].index;
+    uint8_t i;
+
+    if(ODnotify == NULL || SDO->ODExtensions == NULL || !SDO->ODExtensions[entryNo].notify){
+        return;
+    }
+
+    for(i=0U; i<ODnotify->queueCount; i++){
+        if(ODnotify->queue[i].index == index && ODnotify->queue[i].subIndex == subIndex){
+            return;
+        }
+    }
+    if(ODnotify->queueCount < CO_OD_NOTIFY){
+        ODnotify->queue[ODnotify->queueCount].index = index;
+        ODnotify->queue[ODnotify->queueCount].subIndex = subIndex;
+        ODnotify->queueCount++;
+    }
+    else{
+        ODnotify->overflow = true;
+    }
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_OD_subscribe(
+        CO_SDO_t               *SDO,
+        uint16_t                index,
+        void                   *object,
+        void                  (*pFunct)(void *object, uint16_t index, uint8_t subIndex))
+{
+    CO_ODnotify_t *ODnotify;
+    CO_ODsubscriber_t *subscriber;
+    uint16_t entryNo;
+
+    if(SDO == NULL || SDO->ODnotify == NULL || SDO->ODExtensions == NULL || pFunct == NULL){
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+    entryNo = CO_OD_find(SDO, index);
+    if(entryNo == 0xFFFFU){
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+    ODnotify = SDO->ODnotify;
+    if(ODnotify->subscriberCount >= CO_OD_NOTIFY_SUBSCRIBERS){
+        return CO_ERROR_OUT_OF_MEMORY;
+    }
+
+    CO_LOCK_OD();
+    subscriber = &ODnotify->subscriber[ODnotify->subscriberCount];
+    subscriber->index = index;
+    subscriber->object = object;
+    subscriber->pFunct = pFunct;
+    ODnotify->subscriberCount++;
+    SDO->ODExtensions[entryNo].notify = true;
+    CO_UNLOCK_OD();
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+void CO_ODnotify_process(CO_ODnotify_t *ODnotify){
+    CO_ODnotifyEvent_t queue[CO_OD_NOTIFY];
+    uint8_t queueCount;
+    bool_t overflow;
+    uint8_t i, j;
+
+    if(ODnotify == NULL || (ODnotify->queueCount == 0U && !ODnotify->overflow)){
+        return;
+    }
+
+    CO_LOCK_OD();
+    queueCount = ODnotify->queueCount;
+    overflow = ODnotify->overflow;
+    for(i=0U; i<queueCount; i++){
+        queue[i] = ODnotify->queue[i];
+    }
+    ODnotify->queueCount = 0U;
+    ODnotify->overflow = false;
+    CO_UNLOCK_OD();
+
+    for(j=0U; j<ODnotify->subscriberCount; j++){
+        const CO_ODsubscriber_t *subscriber = &ODnotify->subscriber[j];
+
+        if(overflow){
+            subscriber->pFunct(subscriber->object, subscriber->index, CO_OD_NOTIFY_ALL);
+            continue;
+        }
+        for(i=0U; i<queueCount; i++){
+            if(queue[i].index == subscriber->index){
+                subscriber->pFunct(subscriber->object, queue[i].index, queue[i].subIndex);
+            }
+        }
+    }
+}
+#endif
+
+
 /******************************************************************************/
 void CO_OD_configure(
         CO_SDO_t               *SDO,
@@ -406,12 +898,43 @@ void CO_OD_configure(
         else{
             ext->flags = NULL;
         }
+#if CO_OD_FLAT_SIZE > 0
+        if(SDO->ODflat != NULL){
+            uint16_t i;
+            CO_OD_subEntry_t *flat = &SDO->ODflat[ext->flatIdx];
+
+            for(i=0U; i<=maxSubIndex; i++){
+                flat[i].pFlags = (ext->flags != NULL) ? &ext->flags[i] : NULL;
+            }
+        }
+#endif
     }
 }
 
 
 /******************************************************************************/
 uint16_t CO_OD_find(CO_SDO_t *SDO, uint16_t index){
+#if CO_OD_HASH_BITS > 0
+    if(SDO->ODhash != NULL){
+        uint16_t slot = CO_OD_HASH(index);
+        uint16_t n;
+
+        /* linear probing until empty slot */
+        for(n=0U; n<(1U << CO_OD_HASH_BITS); n++){
+            uint16_t entryNo = SDO->ODhash[slot];
+
+            if(entryNo == 0xFFFFU){
+                break;
+            }
+            if(SDO->OD[entryNo].index == index){
+                return entryNo;
+            }
+            slot = (slot + 1U) & ((1U << CO_OD_HASH_BITS) - 1U);
+        }
+        return 0xFFFFU;  /* object does not exist in OD */
+    }
+#endif
+
     /* Fast search in ordered Object Dictionary. If indexes are mixed, this won't work. */
     /* If Object Dictionary has up to 2^N entries, then N is max number of loop passes. */
     uint16_t cur, min, max;
@@ -453,10 +976,15 @@ uint16_t CO_OD_getLength(CO_SDO_t *SDO, uint16_t entryNo, uint8_t subIndex){
     if(entryNo == 0xFFFFU){
         return 0U;
     }
+#if CO_OD_FLAT_SIZE > 0
+    if(SDO->ODflat != NULL){
+        return SDO->ODflat[SDO->ODExtensions[entryNo].flatIdx + subIndex].length;
+    }
+#endif
 
     if(object->maxSubIndex == 0U){    /* Object type is Var */
         if(object->pData == 0){ /* data type is domain */
-            return CO_SDO_BUFFER_SIZE;
+            return CO_SDO_BUFSIZE(SDO);
         }
         else{
             return object->length;
@@ -468,7 +996,7 @@ uint16_t CO_OD_getLength(CO_SDO_t *SDO, uint16_t entryNo, uint8_t subIndex){
         }
         else if(object->pData == 0){
             /* data type is domain */
-            return CO_SDO_BUFFER_SIZE;
+            return CO_SDO_BUFSIZE(SDO);
         }
         else{
             return object->length;
@@ -477,7 +1005,7 @@ uint16_t CO_OD_getLength(CO_SDO_t *SDO, uint16_t entryNo, uint8_t subIndex){
     else{                            /* Object type is Record */
         if(((const CO_OD_entryRecord_t*)(object->pData))[subIndex].pData == 0){
             /* data type is domain */
-            return CO_SDO_BUFFER_SIZE;
+            return CO_SDO_BUFSIZE(SDO);
         }
         else{
             return ((const CO_OD_entryRecord_t*)(object->pData))[subIndex].length;
@@ -493,6 +1021,11 @@ uint16_t CO_OD_getAttribute(CO_SDO_t *SDO, uint16_t entryNo, uint8_t subIndex){
     if(entryNo == 0xFFFFU){
         return 0U;
     }
+#if CO_OD_FLAT_SIZE > 0
+    if(SDO->ODflat != NULL){
+        return SDO->ODflat[SDO->ODExtensions[entryNo].flatIdx + subIndex].attribute;
+    }
+#endif
 
     if(object->maxSubIndex == 0U){   /* Object type is Var */
         return object->attribute;
@@ -527,6 +1060,11 @@ void* CO_OD_getDataPointer(CO_SDO_t *SDO, uint16_t entryNo, uint8_t subIndex){
     if(entryNo == 0xFFFFU){
         return 0;
     }
+#if CO_OD_FLAT_SIZE > 0
+    if(SDO->ODflat != NULL){
+        return SDO->ODflat[SDO->ODExtensions[entryNo].flatIdx + subIndex].pData;
+    }
+#endif
 
     if(object->maxSubIndex == 0U){   /* Object type is Var */
         return object->pData;
@@ -557,6 +1095,11 @@ uint8_t* CO_OD_getFlagsPointer(CO_SDO_t *SDO, uint16_t entryNo, uint8_t subIndex
     if((entryNo == 0xFFFFU) || (SDO->ODExtensions == 0)){
         return 0;
     }
+#if CO_OD_FLAT_SIZE > 0
+    if(SDO->ODflat != NULL){
+        return SDO->ODflat[SDO->ODExtensions[entryNo].flatIdx + subIndex].pFlags;
+    }
+#endif
 
     ext = &SDO->ODExtensions[entryNo];
 
@@ -564,6 +1107,37 @@ uint8_t* CO_OD_getFlagsPointer(CO_SDO_t *SDO, uint16_t entryNo, uint8_t subIndex
 }
 
 
+#if CO_OD_ATOMIC > 0
+/******************************************************************************/
+void CO_OD_read(CO_SDO_t *SDO, void *dest, const void *var, uint16_t length){
+    for(;;){
+        uint32_t seq = *SDO->pODsequence;
+        CO_MEMORY_BARRIER();
+
+        /* writer can not be preempted by this thread, odd is only seen by
+         * truly parallel thread, which then retries */
+        if((seq & 1U) == 0U){
+            memcpy(dest, var, length);
+            CO_MEMORY_BARRIER();
+            if(*SDO->pODsequence == seq){
+                break;
+            }
+        }
+    }
+}
+
+
+/******************************************************************************/
+void CO_OD_write(CO_SDO_t *SDO, void *var, const void *src, uint16_t length){
+    CO_LOCK_OD();
+    CO_OD_writeBegin(SDO);
+    memcpy(var, src, length);
+    CO_OD_writeEnd(SDO);
+    CO_UNLOCK_OD();
+}
+#endif
+
+
 /******************************************************************************/
 uint32_t CO_SDO_initTransfer(CO_SDO_t *SDO, uint16_t index, uint8_t subIndex){
 
@@ -596,6 +1170,9 @@ uint32_t CO_SDO_initTransfer(CO_SDO_t *SDO, uint16_t index, uint8_t subIndex){
     SDO->ODF_arg.dataLength = CO_OD_getLength(SDO, SDO->entryNo, subIndex);
     SDO->ODF_arg.attribute = CO_OD_getAttribute(SDO, SDO->entryNo, subIndex);
     SDO->ODF_arg.pFlags = CO_OD_getFlagsPointer(SDO, SDO->entryNo, subIndex);
+#if CO_SDO_ODF_PENDING > 0
+    SDO->ODF_arg.SDO = (void*)SDO;
+#endif
 
     SDO->ODF_arg.firstSegment = true;
     SDO->ODF_arg.lastSegment = true;
@@ -606,7 +1183,7 @@ uint32_t CO_SDO_initTransfer(CO_SDO_t *SDO, uint16_t index, uint8_t subIndex){
     SDO->ODF_arg.offset = 0U;
 
     /* verify length */
-    if(SDO->ODF_arg.dataLength > CO_SDO_BUFFER_SIZE){
+    if(SDO->ODF_arg.dataLength > CO_SDO_BUFSIZE(SDO)){
         return CO_SDO_AB_DEVICE_INCOMPAT;     /* general internal incompatibility in the device */
     }
 
@@ -620,6 +1197,8 @@ uint32_t CO_SDO_readOD(CO_SDO_t *SDO, uint16_t SDOBufferSize){
     uint8_t *ODdata = (uint8_t*)SDO->ODF_arg.ODdataStorage;
     uint16_t length = SDO->ODF_arg.dataLength;
     CO_OD_extension_t *ext = 0;
+    uint8_t *bufferData = SDO->ODF_arg.data;
+    bool_t firstSegment = SDO->ODF_arg.firstSegment;
 
     /* is object readable? */
     if((SDO->ODF_arg.attribute & CO_ODA_READABLE) == 0)
@@ -651,8 +1230,15 @@ uint32_t CO_SDO_readOD(CO_SDO_t *SDO, uint16_t SDOBufferSize){
             return abortCode;
         }
 
+        /* domain data in application memory, whole rest of data at once */
+        if(SDO->ODF_arg.data != bufferData){
+            if((ODdata != NULL) || (!firstSegment) || (!SDO->ODF_arg.lastSegment) ||
+               (SDO->ODF_arg.dataLength == 0U)){
+                return CO_SDO_AB_DEVICE_INCOMPAT;     /* general internal incompatibility in the device */
+            }
+        }
         /* dataLength (upadted by pODFunc) must be inside limits */
-        if((SDO->ODF_arg.dataLength == 0U) || (SDO->ODF_arg.dataLength > SDOBufferSize)){
+        else if((SDO->ODF_arg.dataLength == 0U) || (SDO->ODF_arg.dataLength > SDOBufferSize)){
             return CO_SDO_AB_DEVICE_INCOMPAT;     /* general internal incompatibility in the device */
         }
     }
@@ -673,97 +1259,519 @@ uint32_t CO_SDO_readOD(CO_SDO_t *SDO, uint16_t SDOBufferSize){
             *(buf2--) = b;
         }
     }
-#endif
+#endif
+
+    return 0U;
+}
+
+
+/******************************************************************************/
+uint32_t CO_SDO_writeOD(CO_SDO_t *SDO, uint16_t length){
+    uint8_t *SDObuffer = SDO->ODF_arg.data;
+    uint8_t *ODdata = (uint8_t*)SDO->ODF_arg.ODdataStorage;
+    bool_t exception_1003 = false;
+#if CO_OD_NOTIFY > 0
+    uint8_t changed = 0U;
+#endif
+
+    /* is object writeable? */
+    if((SDO->ODF_arg.attribute & CO_ODA_WRITEABLE) == 0){
+        return CO_SDO_AB_READONLY;     /* attempt to write a read-only object */
+    }
+
+    /* length of domain data is application specific and not verified */
+    if(ODdata == 0){
+        SDO->ODF_arg.dataLength = length;
+    }
+
+    /* verify length except for domain data type */
+    else if(SDO->ODF_arg.dataLength != length){
+        return CO_SDO_AB_TYPE_MISMATCH;     /* Length of service parameter does not match */
+    }
+
+    /* swap data if processor is not little endian (CANopen is) */
+#ifdef CO_BIG_ENDIAN
+    if((SDO->ODF_arg.attribute & CO_ODA_MB_VALUE) != 0){
+        uint16_t len = SDO->ODF_arg.dataLength;
+        uint8_t *buf1 = SDO->ODF_arg.data;
+        uint8_t *buf2 = buf1 + len - 1;
+
+        len /= 2;
+        while(len--){
+            uint8_t b = *buf1;
+            *(buf1++) = *buf2;
+            *(buf2--) = b;
+        }
+    }
+#endif
+
+    /* call Object dictionary function if registered */
+    SDO->ODF_arg.reading = false;
+    if(SDO->ODExtensions != NULL){
+        CO_OD_extension_t *ext = &SDO->ODExtensions[SDO->entryNo];
+
+        if(ext->pODFunc != NULL){
+            uint32_t abortCode = ext->pODFunc(&SDO->ODF_arg);
+            if(abortCode != 0U){
+#ifdef CO_BIG_ENDIAN
+                /* restore data for repeated call */
+                if(abortCode == CO_SDO_AB_PENDING && (SDO->ODF_arg.attribute & CO_ODA_MB_VALUE) != 0){
+                    uint16_t len = SDO->ODF_arg.dataLength;
+                    uint8_t *buf1 = SDO->ODF_arg.data;
+                    uint8_t *buf2 = buf1 + len - 1;
+
+                    len /= 2;
+                    while(len--){
+                        uint8_t b = *buf1;
+                        *(buf1++) = *buf2;
+                        *(buf2--) = b;
+                    }
+                }
+#endif
+                return abortCode;
+            }
+        }
+    }
+    SDO->ODF_arg.offset += SDO->ODF_arg.dataLength;
+    SDO->ODF_arg.firstSegment = false;
+
+    /* Special exception: 1003,00 is writable from network, but not in OD  */
+    if(SDO->ODF_arg.index == 0x1003 && SDO->ODF_arg.subIndex == 0) {
+        exception_1003 = true;
+    }
+
+    /* copy data from SDO buffer to OD if not domain */
+    if(ODdata != NULL && exception_1003 == false){
+        CO_LOCK_OD();
+#if CO_OD_ATOMIC > 0
+        CO_OD_writeBegin(SDO);
+#endif
+        while(length--){
+#if CO_OD_NOTIFY > 0
+            changed |= (uint8_t)(*ODdata ^ *SDObuffer);
+#endif
+            *(ODdata++) = *(SDObuffer++);
+        }
+#if CO_OD_ATOMIC > 0
+        CO_OD_writeEnd(SDO);
+#endif
+#if CO_TPDO_DIRTY_FLAGS > 0
+        if(SDO->ODExtensions != NULL){
+            *SDO->pTPDOdirty |= SDO->ODExtensions[SDO->entryNo].TPDOmask;
+        }
+#endif
+#if CO_OD_NOTIFY > 0
+        if(changed != 0U){
+            CO_OD_notifyPost(SDO, SDO->entryNo, SDO->ODF_arg.subIndex);
+        }
+#endif
+        CO_UNLOCK_OD();
+
+        if(SDO->pFunctWrite != NULL &&
+           (SDO->ODF_arg.attribute & CO_ODA_MEM_EEPROM) == CO_ODA_MEM_EEPROM
+        ){
+            SDO->pFunctWrite(SDO->functWriteObject, SDO->ODF_arg.ODdataStorage, SDO->ODF_arg.dataLength);
+        }
+    }
+
+    return 0;
+}
+
+
+/******************************************************************************/
+static void CO_SDO_abort(CO_SDO_t *SDO, uint32_t code){
+    if(code == CO_SDO_AB_PENDING){
+        /* OD function can not be deferred here */
+        code = CO_SDO_AB_DEVICE_INCOMPAT;
+    }
+    SDO->CANtxBuff->data[0] = 0x80;
+    SDO->CANtxBuff->data[1] = SDO->ODF_arg.index & 0xFF;
+    SDO->CANtxBuff->data[2] = (SDO->ODF_arg.index>>8) & 0xFF;
+    SDO->CANtxBuff->data[3] = SDO->ODF_arg.subIndex;
+    CO_memcpySwap4(&SDO->CANtxBuff->data[4], &code);
+    SDO->state = CO_SDO_ST_IDLE;
+    SDO->CANrxNew = false;
+#if CO_SDO_RX_QUEUE > 0
+    /* frames received so far belong to aborted transfer */
+    SDO->CANrxTail = SDO->CANrxHead;
+#endif
+    CO_CANsend(SDO->CANdevTx, SDO->CANtxBuff);
+}
+
+
+#if CO_SDO_FAST_EXPEDITED > 0
+/*
+ * Serve expedited upload or download of plain OD variable.
+ *
+ * Variable must have 1 to 4 bytes and no OD extension function. Data are
+ * copied directly between received or transmitted CAN frame and OD.
+ *
+ * @param SDO This object.
+ * @param CCS Client command specifier.
+ * @param index Index of OD object from request.
+ *
+ * @return true, if request was served and response sent. If false, request
+ * must be processed by normal path, which also reports all errors.
+ */
+static bool_t CO_SDO_processExpedited(CO_SDO_t *SDO, uint8_t CCS, uint16_t index){
+    uint8_t subIndex = SDO->CANrxData[3];
+    uint16_t entryNo;
+    uint16_t attribute;
+    uint16_t length;
+    uint8_t *ODdata;
+    uint8_t *txData;
+    uint16_t i;
+#if CO_OD_NOTIFY > 0
+    uint8_t changed = 0U;
+#endif
+
+    if(CCS == CCS_DOWNLOAD_INITIATE){
+        /* expedited only, 1003,00 is written by its extension */
+        if((SDO->CANrxData[0] & 0x02U) == 0U || (index == 0x1003 && subIndex == 0U)){
+            return false;
+        }
+    }
+    else if(CCS != CCS_UPLOAD_INITIATE){
+        return false;
+    }
+
+    entryNo = CO_OD_find(SDO, index);
+    if(entryNo == 0xFFFFU || subIndex > SDO->OD[entryNo].maxSubIndex){
+        return false;
+    }
+    if(SDO->ODExtensions != NULL && SDO->ODExtensions[entryNo].pODFunc != NULL){
+        return false;
+    }
+    ODdata = (uint8_t*)CO_OD_getDataPointer(SDO, entryNo, subIndex);
+    length = CO_OD_getLength(SDO, entryNo, subIndex);
+    attribute = CO_OD_getAttribute(SDO, entryNo, subIndex);
+    if(ODdata == NULL || length == 0U || length > 4U){
+        return false;
+    }
+#ifdef CO_BIG_ENDIAN
+    if((attribute & CO_ODA_MB_VALUE) != 0){
+        return false;
+    }
+#endif
+
+    SDO->entryNo = entryNo;
+    SDO->ODF_arg.index = index;
+    SDO->ODF_arg.subIndex = subIndex;
+    txData = &SDO->CANtxBuff->data[0];
+
+    if(CCS == CCS_DOWNLOAD_INITIATE){
+        /* is size indicated? It must match */
+        if((SDO->CANrxData[0] & 0x01U) != 0U &&
+           (4U - ((SDO->CANrxData[0] >> 2U) & 0x03U)) != length){
+            return false;
+        }
+        if((attribute & CO_ODA_WRITEABLE) == 0U){
+            return false;
+        }
+
+        CO_LOCK_OD();
+#if CO_OD_ATOMIC > 0
+        CO_OD_writeBegin(SDO);
+#endif
+        for(i=0U; i<length; i++){
+#if CO_OD_NOTIFY > 0
+            changed |= (uint8_t)(ODdata[i] ^ SDO->CANrxData[4U+i]);
+#endif
+            ODdata[i] = SDO->CANrxData[4U+i];
+        }
+#if CO_OD_ATOMIC > 0
+        CO_OD_writeEnd(SDO);
+#endif
+#if CO_TPDO_DIRTY_FLAGS > 0
+        if(SDO->ODExtensions != NULL){
+            *SDO->pTPDOdirty |= SDO->ODExtensions[entryNo].TPDOmask;
+        }
+#endif
+#if CO_OD_NOTIFY > 0
+        if(changed != 0U){
+            CO_OD_notifyPost(SDO, entryNo, subIndex);
+        }
+#endif
+        CO_UNLOCK_OD();
+
+        if(SDO->pFunctWrite != NULL && (attribute & CO_ODA_MEM_EEPROM) == CO_ODA_MEM_EEPROM){
+            SDO->pFunctWrite(SDO->functWriteObject, ODdata, length);
+        }
+        txData[0] = 0x60U;
+    }
+    else{
+        if((attribute & CO_ODA_READABLE) == 0U){
+            return false;
+        }
+
+        CO_LOCK_OD();
+        for(i=0U; i<length; i++){
+            txData[4U+i] = ODdata[i];
+        }
+        CO_UNLOCK_OD();
+        txData[0] = 0x43U | ((4U-length) << 2U);
+    }
 
-    return 0U;
+    txData[1] = SDO->CANrxData[1];
+    txData[2] = SDO->CANrxData[2];
+    txData[3] = subIndex;
+    SDO->CANrxNew = false;
+    CO_CANsend(SDO->CANdevTx, SDO->CANtxBuff);
+
+    return true;
 }
+#endif
 
 
+#if CO_SDO_ODF_PENDING > 0
 /******************************************************************************/
-uint32_t CO_SDO_writeOD(CO_SDO_t *SDO, uint16_t length){
-    uint8_t *SDObuffer = SDO->ODF_arg.data;
-    uint8_t *ODdata = (uint8_t*)SDO->ODF_arg.ODdataStorage;
-    bool_t exception_1003 = false;
+void CO_SDO_ODFcomplete(void *SDO){
+    CO_SDO_t *pSDO = (CO_SDO_t*)SDO;
 
-    /* is object writeable? */
-    if((SDO->ODF_arg.attribute & CO_ODA_WRITEABLE) == 0){
-        return CO_SDO_AB_READONLY;     /* attempt to write a read-only object */
+    if(pSDO != NULL){
+        pSDO->pendingDone = true;
+        if(pSDO->pFunctSignal != NULL){
+            pSDO->pFunctSignal();
+        }
     }
+}
 
-    /* length of domain data is application specific and not verified */
-    if(ODdata == 0){
-        SDO->ODF_arg.dataLength = length;
-    }
 
-    /* verify length except for domain data type */
-    else if(SDO->ODF_arg.dataLength != length){
-        return CO_SDO_AB_TYPE_MISMATCH;     /* Length of service parameter does not match */
-    }
+/*
+ * Park transfer, OD function returned CO_SDO_AB_PENDING.
+ *
+ * Received message stays in CANrxData (CANrxNew remains set) and is
+ * processed again after CO_SDO_ODFcomplete().
+ *
+ * @param SDO This object.
+ *
+ * @return 1, SDO server is in transfer state.
+ */
+static int8_t CO_SDO_park(CO_SDO_t *SDO){
+    SDO->pending = true;
+    return 1;
+}
+#endif
 
-    /* swap data if processor is not little endian (CANopen is) */
-#ifdef CO_BIG_ENDIAN
-    if((SDO->ODF_arg.attribute & CO_ODA_MB_VALUE) != 0){
-        uint16_t len = SDO->ODF_arg.dataLength;
-        uint8_t *buf1 = SDO->ODF_arg.data;
-        uint8_t *buf2 = buf1 + len - 1;
 
-        len /= 2;
-        while(len--){
-            uint8_t b = *buf1;
-            *(buf1++) = *buf2;
-            *(buf2--) = b;
+#if CO_SDO_DOMAIN_PREFETCH > 0
+/*
+ * Call OD function for next data of domain upload into prefetchData.
+ *
+ * Data, which are transmitted meanwhile, stay in ODF_arg. If OD function
+ * returns CO_SDO_AB_PENDING, it is called again after CO_SDO_ODFcomplete().
+ *
+ * @param SDO This object.
+ * @param resumed True, if called after CO_SDO_ODFcomplete().
+ *
+ * @return 0 or abort code.
+ */
+static uint32_t CO_SDO_prefetch(CO_SDO_t *SDO, bool_t resumed){
+    uint8_t *data = SDO->ODF_arg.data;
+    uint16_t dataLength = SDO->ODF_arg.dataLength;
+    uint16_t size = (SDO->prefetchData == SDO->databuffer) ?
+                    SDO->prefetchSplit : (CO_SDO_BUFSIZE(SDO) - SDO->prefetchSplit);
+    uint32_t abortCode;
+
+    /* completion may be signalled, before OD function returns */
+    if(!resumed){
+        SDO->pendingDone = false;
+    }
+    SDO->ODF_arg.data = SDO->prefetchData;
+    SDO->ODF_arg.dataLength = size;
+    SDO->ODF_arg.resumed = resumed;
+    abortCode = CO_SDO_readOD(SDO, size);
+    SDO->ODF_arg.resumed = false;
+
+    if(abortCode == CO_SDO_AB_PENDING){
+        SDO->prefetchState = CO_SDO_PREFETCH_BUSY;
+        abortCode = 0U;
+    }
+    else if(abortCode == 0U){
+        SDO->prefetchLength = SDO->ODF_arg.dataLength;
+        SDO->prefetchLast = SDO->ODF_arg.lastSegment;
+        SDO->prefetchState = CO_SDO_PREFETCH_READY;
+
+        /* CRC in order of reading, data read before are added in CO_SDO_ST_UPLOAD_BL_INITIATE */
+        if(SDO->crcEnabled && ((SDO->state == CO_SDO_ST_UPLOAD_BL_INITIATE_2) ||
+                               (SDO->state == CO_SDO_ST_UPLOAD_BL_SUBBLOCK))){
+            SDO->crc = crc16_ccitt(SDO->prefetchData, SDO->prefetchLength, SDO->crc);
         }
     }
-#endif
+    else{
+        SDO->prefetchState = CO_SDO_PREFETCH_IDLE;
+    }
 
-    /* call Object dictionary function if registered */
-    SDO->ODF_arg.reading = false;
-    if(SDO->ODExtensions != NULL){
-        CO_OD_extension_t *ext = &SDO->ODExtensions[SDO->entryNo];
+    /* data being transmitted */
+    SDO->ODF_arg.data = data;
+    SDO->ODF_arg.dataLength = dataLength;
+    SDO->ODF_arg.lastSegment = false;
 
-        if(ext->pODFunc != NULL){
-            uint32_t abortCode = ext->pODFunc(&SDO->ODF_arg);
-            if(abortCode != 0U){
-                return abortCode;
-            }
-        }
+    return abortCode;
+}
+
+
+/*
+ * Continue domain upload with prefetched data and read next data into the
+ * released part of data buffer. prefetchState must be CO_SDO_PREFETCH_READY.
+ *
+ * @param SDO This object.
+ *
+ * @return 0 or abort code.
+ */
+static uint32_t CO_SDO_prefetchSwap(CO_SDO_t *SDO){
+    uint8_t *released = (SDO->prefetchData == SDO->databuffer) ?
+                        &SDO->databuffer[SDO->prefetchSplit] : SDO->databuffer;
+
+    SDO->ODF_arg.data = SDO->prefetchData;
+    SDO->ODF_arg.dataLength = SDO->prefetchLength;
+    SDO->ODF_arg.lastSegment = SDO->prefetchLast;
+    SDO->prefetchData = released;
+    SDO->prefetchState = CO_SDO_PREFETCH_IDLE;
+
+    return SDO->ODF_arg.lastSegment ? 0U : CO_SDO_prefetch(SDO, false);
+}
+
+
+/*
+ * Reverse order of bytes, used for rotation of data in data buffer.
+ */
+static void CO_SDO_reverse(uint8_t *data, uint16_t length){
+    uint16_t i;
+
+    for(i = 0U; i < (length / 2U); i++){
+        uint8_t b = data[i];
+
+        data[i] = data[length - 1U - i];
+        data[length - 1U - i] = b;
     }
-    SDO->ODF_arg.offset += SDO->ODF_arg.dataLength;
-    SDO->ODF_arg.firstSegment = false;
+}
 
-    /* Special exception: 1003,00 is writable from network, but not in OD  */
-    if(SDO->ODF_arg.index == 0x1003 && SDO->ODF_arg.subIndex == 0) {
-        exception_1003 = true;
+
+/*
+ * Make room for the next data of block upload, if sub-block does not fit into
+ * current and prefetched data. If current data are all confirmed, prefetched
+ * data are swapped in. Otherwise current and prefetched data are moved to the
+ * beginning of data buffer and next data are read into the rest of it.
+ * prefetchState must be CO_SDO_PREFETCH_READY.
+ *
+ * @param SDO This object.
+ *
+ * @return 0 or abort code.
+ */
+static uint32_t CO_SDO_prefetchRelease(CO_SDO_t *SDO){
+    uint8_t *buf = SDO->databuffer;
+    uint16_t curLen = SDO->ODF_arg.dataLength;
+    uint16_t len = curLen + SDO->prefetchLength;
+
+    if(curLen == 0U){
+        return CO_SDO_prefetchSwap(SDO);
     }
 
-    /* copy data from SDO buffer to OD if not domain */
-    if(ODdata != NULL && exception_1003 == false){
-        CO_LOCK_OD();
-        while(length--){
-            *(ODdata++) = *(SDObuffer++);
-        }
-        CO_UNLOCK_OD();
+    if(SDO->prefetchData != buf){
+        /* both are moved down in order */
+        memmove(buf, SDO->ODF_arg.data, curLen);
+        memmove(&buf[curLen], SDO->prefetchData, SDO->prefetchLength);
+    }
+    else{
+        /* prefetched data are at the beginning, append current data and
+         * rotate them in front of the prefetched data */
+        memmove(&buf[SDO->prefetchLength], SDO->ODF_arg.data, curLen);
+        CO_SDO_reverse(buf, len);
+        CO_SDO_reverse(buf, curLen);
+        CO_SDO_reverse(&buf[curLen], SDO->prefetchLength);
     }
 
-    return 0;
+    SDO->ODF_arg.data = buf;
+    SDO->ODF_arg.dataLength = len;
+    SDO->ODF_arg.lastSegment = SDO->prefetchLast;
+    SDO->prefetchSplit = len;
+    SDO->prefetchData = &buf[len];
+    SDO->prefetchState = CO_SDO_PREFETCH_IDLE;
+
+    return SDO->ODF_arg.lastSegment ? 0U : CO_SDO_prefetch(SDO, false);
 }
 
 
-/******************************************************************************/
-static void CO_SDO_abort(CO_SDO_t *SDO, uint32_t code){
-    SDO->CANtxBuff->data[0] = 0x80;
-    SDO->CANtxBuff->data[1] = SDO->ODF_arg.index & 0xFF;
-    SDO->CANtxBuff->data[2] = (SDO->ODF_arg.index>>8) & 0xFF;
-    SDO->CANtxBuff->data[3] = SDO->ODF_arg.subIndex;
-    CO_memcpySwap4(&SDO->CANtxBuff->data[4], &code);
-    SDO->state = CO_SDO_ST_IDLE;
-    SDO->CANrxNew = false;
-    CO_CANsend(SDO->CANdevTx, SDO->CANtxBuff);
+/*
+ * Get length of domain upload data in buffer, including prefetched data,
+ * which follow ODF_arg.data.
+ *
+ * @param SDO This object.
+ * @param last Set to true, if OD function has no more data.
+ *
+ * @return Number of bytes.
+ */
+static uint16_t CO_SDO_prefetchWindow(const CO_SDO_t *SDO, bool_t *last){
+    if(SDO->prefetchState == CO_SDO_PREFETCH_READY){
+        *last = SDO->prefetchLast;
+        return SDO->ODF_arg.dataLength + SDO->prefetchLength;
+    }
+    *last = SDO->ODF_arg.lastSegment;
+    return SDO->ODF_arg.dataLength;
 }
+#endif
 
 
 /******************************************************************************/
+#if CO_SDO_BUFFER_POOL > 0 || CO_ITM_TRACE > 0 || CO_SDO_RX_QUEUE > 0
+static int8_t CO_SDO_processTransfer(
+        CO_SDO_t               *SDO,
+        bool_t                  NMTisPreOrOperational,
+        uint16_t                timeDifference_ms,
+        uint16_t                SDOtimeoutTime,
+        uint16_t               *timerNext_ms);
+
+int8_t CO_SDO_process(
+        CO_SDO_t               *SDO,
+        bool_t                  NMTisPreOrOperational,
+        uint16_t                timeDifference_ms,
+        uint16_t                SDOtimeoutTime,
+        uint16_t               *timerNext_ms)
+{
+#if CO_SDO_RX_QUEUE > 0
+    CO_SDO_receiveQueued(SDO);
+#endif
+#if CO_ITM_TRACE > 0
+    CO_SDO_state_t statePrev = SDO->state;
+    bool_t rxNew = SDO->CANrxNew;
+    uint8_t command = SDO->CANrxData[0];
+#endif
+    int8_t ret = CO_SDO_processTransfer(SDO, NMTisPreOrOperational,
+                        timeDifference_ms, SDOtimeoutTime, timerNext_ms);
+
+#if CO_SDO_BUFFER_POOL > 0
+    /* return data buffer on end of transfer or abort */
+#if CO_SDO_DOMAIN_PREFETCH > 0
+    if((SDO->state == CO_SDO_ST_IDLE) && (SDO->prefetchState != CO_SDO_PREFETCH_BUSY)){
+#else
+    if(SDO->state == CO_SDO_ST_IDLE){
+#endif
+        CO_SDO_releaseBuffer(SDO);
+    }
+#endif
+#if CO_ITM_TRACE > 0
+    /* request was processed or state changed by timeout */
+    rxNew = rxNew && !SDO->CANrxNew;
+    if(rxNew || SDO->state != statePrev){
+        CO_ITM_EVENT(CO_ITM_SDO, ((uint16_t)SDO->state << 8) | (rxNew ? command : 0xFFU));
+    }
+#endif
+#if CO_SDO_RX_QUEUE > 0
+    /* frames received during processing, segments go into the buffer now */
+    CO_SDO_receiveQueued(SDO);
+    if(SDO->CANrxNew && timerNext_ms != NULL){
+        *timerNext_ms = 0;
+    }
+#endif
+
+    return ret;
+}
+
+static int8_t CO_SDO_processTransfer(
+#else
 int8_t CO_SDO_process(
+#endif
         CO_SDO_t               *SDO,
         bool_t                  NMTisPreOrOperational,
         uint16_t                timeDifference_ms,
@@ -774,6 +1782,28 @@ int8_t CO_SDO_process(
     bool_t timeoutSubblockDownolad = false;
     bool_t sendResponse = false;
 
+#if CO_SDO_DOMAIN_PREFETCH > 0
+    /* OD function finished reading of next domain data */
+    if((SDO->prefetchState == CO_SDO_PREFETCH_BUSY) && SDO->pendingDone){
+        SDO->pendingDone = false;
+        if(SDO->state == CO_SDO_ST_IDLE){
+            /* transfer was aborted meanwhile */
+            SDO->prefetchState = CO_SDO_PREFETCH_IDLE;
+        }
+        else{
+            uint32_t abortCode;
+
+            /* transmission continues, if it is parked for the data */
+            SDO->pending = false;
+            abortCode = CO_SDO_prefetch(SDO, true);
+            if(abortCode != 0U){
+                CO_SDO_abort(SDO, abortCode);
+                return -1;
+            }
+        }
+    }
+#endif
+
     /* return if idle */
     if((SDO->state == CO_SDO_ST_IDLE) && (!SDO->CANrxNew)){
         return 0;
@@ -783,9 +1813,36 @@ int8_t CO_SDO_process(
     if(!NMTisPreOrOperational){
         SDO->state = CO_SDO_ST_IDLE;
         SDO->CANrxNew = false;
+#if CO_SDO_RX_QUEUE > 0
+        SDO->CANrxTail = SDO->CANrxHead;
+#endif
+#if CO_SDO_ODF_PENDING > 0
+        SDO->pending = false;
+#endif
         return 0;
     }
 
+#if CO_SDO_ODF_PENDING > 0
+    /* transfer parked by OD function */
+    SDO->ODF_arg.resumed = false;
+    if(SDO->pending){
+        if(!SDO->pendingDone){
+            SDO->timeoutTimer += timeDifference_ms;
+            if(SDO->timeoutTimer >= SDOtimeoutTime){
+                SDO->pending = false;
+                SDO->pendingDone = false;
+                CO_SDO_abort(SDO, CO_SDO_AB_TIMEOUT); /* SDO protocol timed out */
+                return -1;
+            }
+            return 1;
+        }
+        /* process the same message again, OD function is called again */
+        SDO->pending = false;
+        SDO->pendingDone = false;
+        SDO->ODF_arg.resumed = true;
+    }
+#endif
+
     /* Is something new to process? */
     if((!SDO->CANtxBuff->bufferFull) && ((SDO->CANrxNew) || (SDO->state == CO_SDO_ST_UPLOAD_BL_SUBBLOCK))){
         uint8_t CCS = SDO->CANrxData[0] >> 5;   /* Client command specifier */
@@ -823,6 +1880,29 @@ int8_t CO_SDO_process(
             /* init ODF_arg */
             index = SDO->CANrxData[2];
             index = index << 8 | SDO->CANrxData[1];
+#if CO_SDO_FAST_EXPEDITED > 0
+            if(CO_SDO_processExpedited(SDO, CCS, index)){
+                return 0;
+            }
+#endif
+#if CO_SDO_DOMAIN_PREFETCH > 0
+            /* data buffer may still be written by reading of aborted transfer */
+            if(SDO->prefetchState == CO_SDO_PREFETCH_BUSY){
+                SDO->ODF_arg.index = index;
+                SDO->ODF_arg.subIndex = SDO->CANrxData[3];
+                CO_SDO_abort(SDO, CO_SDO_AB_DATA_DEV_STATE);
+                return -1;
+            }
+            SDO->prefetchState = CO_SDO_PREFETCH_IDLE;
+#endif
+#if CO_SDO_BUFFER_POOL > 0
+            if(!CO_SDO_leaseBuffer(SDO)){
+                SDO->ODF_arg.index = index;
+                SDO->ODF_arg.subIndex = SDO->CANrxData[3];
+                CO_SDO_abort(SDO, CO_SDO_AB_OUT_OF_MEM);/* Out of memory */
+                return -1;
+            }
+#endif
             abortCode = CO_SDO_initTransfer(SDO, index, SDO->CANrxData[3]);
             if(abortCode != 0U){
                 CO_SDO_abort(SDO, abortCode);
@@ -847,11 +1927,40 @@ int8_t CO_SDO_process(
 
             /* upload */
             else{
-                abortCode = CO_SDO_readOD(SDO, CO_SDO_BUFFER_SIZE);
+#if CO_SDO_DOMAIN_PREFETCH > 0
+                /* domain is read into halves of data buffer */
+                uint16_t readSize = CO_SDO_BUFSIZE(SDO);
+
+                if(SDO->ODF_arg.ODdataStorage == NULL){
+                    readSize /= 2U;
+                    SDO->ODF_arg.dataLength = readSize;
+                }
+                abortCode = CO_SDO_readOD(SDO, readSize);
+#else
+                abortCode = CO_SDO_readOD(SDO, CO_SDO_BUFSIZE(SDO));
+#endif
+#if CO_SDO_ODF_PENDING > 0
+                if(abortCode == CO_SDO_AB_PENDING){
+                    return CO_SDO_park(SDO);
+                }
+#endif
                 if(abortCode != 0U){
                     CO_SDO_abort(SDO, abortCode);
                     return -1;
                 }
+#if CO_SDO_DOMAIN_PREFETCH > 0
+
+                /* read next data of domain, while these are transmitted */
+                if((SDO->ODF_arg.ODdataStorage == NULL) && (!SDO->ODF_arg.lastSegment)){
+                    SDO->prefetchSplit = readSize;
+                    SDO->prefetchData = &SDO->databuffer[readSize];
+                    abortCode = CO_SDO_prefetch(SDO, false);
+                    if(abortCode != 0U){
+                        CO_SDO_abort(SDO, abortCode);
+                        return -1;
+                    }
+                }
+#endif
 
                 /* if data size is large enough set state machine to block upload, otherwise set to normal transfer */
                 if((CCS == CCS_UPLOAD_BLOCK) && (SDO->ODF_arg.dataLength > SDO->CANrxData[5])){
@@ -915,6 +2024,11 @@ int8_t CO_SDO_process(
 
                 /* write data to the Object dictionary */
                 abortCode = CO_SDO_writeOD(SDO, len);
+#if CO_SDO_ODF_PENDING > 0
+                if(abortCode == CO_SDO_AB_PENDING){
+                    return CO_SDO_park(SDO);
+                }
+#endif
                 if(abortCode != 0U){
                     CO_SDO_abort(SDO, abortCode);
                     return -1;
@@ -974,12 +2088,17 @@ int8_t CO_SDO_process(
                     /* empty buffer in domain data type */
                     SDO->ODF_arg.lastSegment = false;
                     abortCode = CO_SDO_writeOD(SDO, SDO->bufferOffset);
+#if CO_SDO_ODF_PENDING > 0
+                    if(abortCode == CO_SDO_AB_PENDING){
+                        return CO_SDO_park(SDO);
+                    }
+#endif
                     if(abortCode != 0U){
                         CO_SDO_abort(SDO, abortCode);
                         return -1;
                     }
 
-                    SDO->ODF_arg.dataLength = CO_SDO_BUFFER_SIZE;
+                    SDO->ODF_arg.dataLength = CO_SDO_BUFSIZE(SDO);
                     SDO->bufferOffset = 0;
                 }
             }
@@ -992,6 +2111,13 @@ int8_t CO_SDO_process(
             if((SDO->CANrxData[0] & 0x01U) != 0U){
                 SDO->ODF_arg.lastSegment = true;
                 abortCode = CO_SDO_writeOD(SDO, SDO->bufferOffset);
+#if CO_SDO_ODF_PENDING > 0
+                if(abortCode == CO_SDO_AB_PENDING){
+                    /* segment is copied again */
+                    SDO->bufferOffset -= len;
+                    return CO_SDO_park(SDO);
+                }
+#endif
                 if(abortCode != 0U){
                     CO_SDO_abort(SDO, abortCode);
                     return -1;
@@ -1022,7 +2148,7 @@ int8_t CO_SDO_process(
             SDO->CANtxBuff->data[3] = SDO->CANrxData[3];
 
             /* blksize */
-            SDO->blksize = (CO_SDO_BUFFER_SIZE > (7*127)) ? 127 : (CO_SDO_BUFFER_SIZE / 7);
+            SDO->blksize = (CO_SDO_BUFSIZE(SDO) > (7*CO_SDO_BLOCK_SIZE)) ? CO_SDO_BLOCK_SIZE : (CO_SDO_BUFSIZE(SDO) / 7);
             SDO->CANtxBuff->data[4] = SDO->blksize;
 
             /* is CRC enabled */
@@ -1081,20 +2207,20 @@ int8_t CO_SDO_process(
                     return -1;
                 }
 
-                SDO->ODF_arg.dataLength = CO_SDO_BUFFER_SIZE;
+                SDO->ODF_arg.dataLength = CO_SDO_BUFSIZE(SDO);
                 SDO->bufferOffset = 0;
             }
 
             /* blksize */
-            len = CO_SDO_BUFFER_SIZE - SDO->bufferOffset;
-            SDO->blksize = (len > (7*127)) ? 127 : (len / 7);
+            len = CO_SDO_BUFSIZE(SDO) - SDO->bufferOffset;
+            SDO->blksize = (len > (7*CO_SDO_BLOCK_SIZE)) ? CO_SDO_BLOCK_SIZE : (len / 7);
             SDO->CANtxBuff->data[2] = SDO->blksize;
 
             /* set next state */
             if(lastSegmentInSubblock) {
                 SDO->state = CO_SDO_ST_DOWNLOAD_BL_END;
             }
-            else if(SDO->bufferOffset >= CO_SDO_BUFFER_SIZE) {
+            else if(SDO->bufferOffset >= CO_SDO_BUFSIZE(SDO)) {
                 CO_SDO_abort(SDO, CO_SDO_AB_DEVICE_INCOMPAT);
                 return -1;
             }
@@ -1204,6 +2330,31 @@ int8_t CO_SDO_process(
             len = SDO->ODF_arg.dataLength - SDO->bufferOffset;
             if(len > 7U) len = 7U;
 
+#if CO_SDO_DOMAIN_PREFETCH > 0
+            /* If data type is domain, continue with prefetched data, wait if they are not read yet. */
+            i = 0U;
+            if((len < 7U) && (SDO->prefetchState != CO_SDO_PREFETCH_IDLE)){
+                if(SDO->prefetchState == CO_SDO_PREFETCH_BUSY){
+                    return CO_SDO_park(SDO);
+                }
+
+                /* rest of the current data */
+                for(; i<len; i++)
+                    SDO->CANtxBuff->data[i+1] = SDO->ODF_arg.data[SDO->bufferOffset++];
+
+                abortCode = CO_SDO_prefetchSwap(SDO);
+                if(abortCode != 0U){
+                    CO_SDO_abort(SDO, abortCode);
+                    return -1;
+                }
+                SDO->bufferOffset = 0U;
+
+                /* re-calculate the length */
+                len = SDO->ODF_arg.dataLength;
+                if(len > (7U - i)) len = 7U - i;
+                len += i;
+            }
+#else
             /* If data type is domain, re-fill the data buffer if neccessary and indicated so. */
             if((SDO->ODF_arg.ODdataStorage == 0) && (len < 7U) && (!SDO->ODF_arg.lastSegment)){
                 /* copy previous data to the beginning */
@@ -1216,7 +2367,7 @@ int8_t CO_SDO_process(
                 SDO->ODF_arg.dataLength = CO_OD_getLength(SDO, SDO->entryNo, SDO->ODF_arg.subIndex) - len;
 
                 /* read next data from Object dictionary function */
-                abortCode = CO_SDO_readOD(SDO, CO_SDO_BUFFER_SIZE);
+                abortCode = CO_SDO_readOD(SDO, CO_SDO_BUFSIZE(SDO));
                 if(abortCode != 0U){
                     CO_SDO_abort(SDO, abortCode);
                     return -1;
@@ -1231,9 +2382,11 @@ int8_t CO_SDO_process(
                 len = SDO->ODF_arg.dataLength;
                 if(len > 7U) len = 7U;
             }
+            i = 0U;
+#endif
 
             /* fill response data bytes */
-            for(i=0U; i<len; i++)
+            for(; i<len; i++)
                 SDO->CANtxBuff->data[i+1] = SDO->ODF_arg.data[SDO->bufferOffset++];
 
             /* first response byte */
@@ -1261,6 +2414,11 @@ int8_t CO_SDO_process(
             if((SDO->CANrxData[0] & 0x04U) != 0U){
                 SDO->crcEnabled = true;
                 SDO->crc = crc16_ccitt(SDO->ODF_arg.data, SDO->ODF_arg.dataLength, 0);
+#if CO_SDO_DOMAIN_PREFETCH > 0
+                if(SDO->prefetchState == CO_SDO_PREFETCH_READY){
+                    SDO->crc = crc16_ccitt(SDO->prefetchData, SDO->prefetchLength, SDO->crc);
+                }
+#endif
             }
             else{
                 SDO->crcEnabled = false;
@@ -1277,8 +2435,13 @@ int8_t CO_SDO_process(
             }
 
             /* verify blksize and if SDO data buffer is large enough */
+#if CO_SDO_DOMAIN_PREFETCH > 0
+            if((SDO->blksize < 1U) || (SDO->blksize > 127U) ||
+               (((SDO->blksize*7U) > CO_SDO_BUFSIZE(SDO)) && (!SDO->ODF_arg.lastSegment))){
+#else
             if((SDO->blksize < 1U) || (SDO->blksize > 127U) ||
                (((SDO->blksize*7U) > SDO->ODF_arg.dataLength) && (!SDO->ODF_arg.lastSegment))){
+#endif
                 CO_SDO_abort(SDO, CO_SDO_AB_BLOCK_SIZE); /* Invalid block size (block mode only). */
                 return -1;
             }
@@ -1350,9 +2513,45 @@ int8_t CO_SDO_process(
                     break;
                 }
 
-                /* move remaining data to the beginning */
-                for(i=ackseq*7, j=0; i<SDO->ODF_arg.dataLength; i++, j++)
-                    SDO->ODF_arg.data[j] = SDO->ODF_arg.data[i];
+#if CO_SDO_DOMAIN_PREFETCH > 0
+                /* skip confirmed data, continue with prefetched data, if all
+                 * current data are confirmed */
+                j = ackseq * 7U;
+                if((j >= SDO->ODF_arg.dataLength) && (SDO->prefetchState == CO_SDO_PREFETCH_READY)){
+                    j -= SDO->ODF_arg.dataLength;
+                    abortCode = CO_SDO_prefetchSwap(SDO);
+                    if(abortCode != 0U){
+                        CO_SDO_abort(SDO, abortCode);
+                        return -1;
+                    }
+                }
+                SDO->ODF_arg.data += j;
+                SDO->ODF_arg.dataLength -= j;
+
+                /* new block size */
+                SDO->blksize = SDO->CANrxData[2];
+
+                /* verify if SDO data buffer is large enough, transmission makes room or waits for data being read */
+                {
+                    bool_t last;
+
+                    if(((SDO->blksize*7U) > CO_SDO_BUFSIZE(SDO)) &&
+                       ((SDO->blksize*7U) > CO_SDO_prefetchWindow(SDO, &last)) && (!last)){
+                        CO_SDO_abort(SDO, CO_SDO_AB_BLOCK_SIZE); /* Invalid block size (block mode only). */
+                        return -1;
+                    }
+                }
+#else
+                /* skip confirmed data, if there is no more data from OD function
+                 * (data may be in application memory), otherwise move remaining
+                 * data to the beginning */
+                if(SDO->ODF_arg.lastSegment){
+                    SDO->ODF_arg.data += ackseq * 7U;
+                }
+                else{
+                    for(i=ackseq*7, j=0; i<SDO->ODF_arg.dataLength; i++, j++)
+                        SDO->ODF_arg.data[j] = SDO->ODF_arg.data[i];
+                }
 
                 /* set remaining data length in buffer */
                 SDO->ODF_arg.dataLength -= ackseq * 7U;
@@ -1368,7 +2567,7 @@ int8_t CO_SDO_process(
                     SDO->ODF_arg.dataLength = CO_OD_getLength(SDO, SDO->entryNo, SDO->ODF_arg.subIndex) - len;
 
                     /* read next data from Object dictionary function */
-                    abortCode = CO_SDO_readOD(SDO, CO_SDO_BUFFER_SIZE);
+                    abortCode = CO_SDO_readOD(SDO, CO_SDO_BUFSIZE(SDO));
                     if(abortCode != 0U){
                         CO_SDO_abort(SDO, abortCode);
                         return -1;
@@ -1389,6 +2588,7 @@ int8_t CO_SDO_process(
                     CO_SDO_abort(SDO, CO_SDO_AB_BLOCK_SIZE); /* Invalid block size (block mode only). */
                     return -1;
                 }
+#endif
 
                 SDO->bufferOffset = 0U;
                 SDO->sequence = 0U;
@@ -1406,6 +2606,55 @@ int8_t CO_SDO_process(
             /* reset timeout */
             SDO->timeoutTimer = 0;
 
+#if CO_SDO_DOMAIN_PREFETCH > 0
+            {
+            /* segments continue in prefetched data, current data are not confirmed yet */
+            bool_t last;
+            uint16_t window = CO_SDO_prefetchWindow(SDO, &last);
+
+            /* sub-block continues behind the window, release confirmed data */
+            if(((uint16_t)(window - SDO->bufferOffset) < 7U) && (!last) &&
+               (SDO->prefetchState == CO_SDO_PREFETCH_READY)){
+                abortCode = CO_SDO_prefetchRelease(SDO);
+                if(abortCode != 0U){
+                    CO_SDO_abort(SDO, abortCode);
+                    return -1;
+                }
+                window = CO_SDO_prefetchWindow(SDO, &last);
+            }
+
+            /* calculate length to be sent */
+            len = window - SDO->bufferOffset;
+            if(len >= 7U){
+                len = 7U;
+            }
+            else if(!last){
+                if(SDO->prefetchState == CO_SDO_PREFETCH_BUSY){
+                    return CO_SDO_park(SDO);
+                }
+                CO_SDO_abort(SDO, CO_SDO_AB_BLOCK_SIZE); /* Invalid block size (block mode only). */
+                return -1;
+            }
+
+            /* fill response data bytes */
+            for(i=0U; i<len; i++, SDO->bufferOffset++){
+                SDO->CANtxBuff->data[i+1] = (SDO->bufferOffset < SDO->ODF_arg.dataLength) ?
+                    SDO->ODF_arg.data[SDO->bufferOffset] :
+                    SDO->prefetchData[SDO->bufferOffset - SDO->ODF_arg.dataLength];
+            }
+
+            /* first response byte */
+            SDO->CANtxBuff->data[0] = ++SDO->sequence;
+
+            /* verify end of transfer */
+            if((SDO->bufferOffset == window) && last){
+                SDO->CANtxBuff->data[0] |= 0x80;
+                SDO->lastLen = len;
+                SDO->blksize = SDO->sequence;
+                SDO->endOfTransfer = true;
+            }
+            }
+#else
             /* calculate length to be sent */
             len = SDO->ODF_arg.dataLength - SDO->bufferOffset;
             if(len > 7U){
@@ -1427,6 +2676,7 @@ int8_t CO_SDO_process(
                 SDO->blksize = SDO->sequence;
                 SDO->endOfTransfer = true;
             }
+#endif
 
             /* send response */
             CO_CANsend(SDO->CANdevTx, SDO->CANtxBuff);
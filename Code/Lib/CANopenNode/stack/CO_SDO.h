@@ -197,7 +197,8 @@ typedef enum{
     CO_SDO_AB_DATA_LOC_CTRL         = 0x08000021UL, /**< 0x08000021, Data cannot be transferred or stored to application because of local control */
     CO_SDO_AB_DATA_DEV_STATE        = 0x08000022UL, /**< 0x08000022, Data cannot be transferred or stored to application because of present device state */
     CO_SDO_AB_DATA_OD               = 0x08000023UL, /**< 0x08000023, Object dictionary not present or dynamic generation fails */
-    CO_SDO_AB_NO_DATA               = 0x08000024UL  /**< 0x08000024, No data available */
+    CO_SDO_AB_NO_DATA               = 0x08000024UL, /**< 0x08000024, No data available */
+    CO_SDO_AB_PENDING               = 0xFFFFFFFFUL  /**< Not sent, OD function completes later, see #CO_SDO_ODF_PENDING */
 }CO_SDO_abortCode_t;
 
 
@@ -294,7 +295,24 @@ typedef enum{
  * 
  * Be aware that accessing the OD directly using CO_OD.h files is more CPU 
  * efficient as CO_OD_find() has to do a search everytime it is called.
- * 
+ *
+ * With #CO_OD_FLAT_SIZE, CO_SDO_init() resolves each subindex into a
+ * CO_OD_subEntry_t descriptor once. CO_OD_getLength(), CO_OD_getAttribute(),
+ * CO_OD_getDataPointer() and CO_OD_getFlagsPointer() then read one array
+ * member instead of decoding the object type on every call.
+ *
+ * With #CO_OD_ATOMIC, application accesses OD variables without
+ * CO_LOCK_OD(). Aligned variables up to 32 bits are read and written with
+ * one access by CO_OD_READ() and CO_OD_WRITE(). Longer variables and arrays
+ * are read by CO_OD_read(), which repeats the copy, if SDO server or RPDO
+ * wrote the OD meanwhile, and written by CO_OD_write().
+ *
+ * \code{.c}
+ * int16_t t = CO_OD_READ(int16_t, OD_temperature[0]);
+ * CO_OD_WRITE(uint32_t, OD_position, pos);
+ * CO_TPDOmarkDirty(CO->SDO[0], 0x6064);
+ * CO_OD_read(CO->SDO[0], &counter, &OD_counter64, sizeof(counter));
+ * \endcode
  */
 
 
@@ -334,6 +352,45 @@ typedef enum{
  *     data, which are longer than #CO_SDO_BUFFER_SIZE. In that case
  *     Object dictionary function is called multiple times between SDO transfer.
  *
+ * ####Domain upload without copy
+ *     If the rest of domain data is contiguous in application memory (flash
+ *     image, trace buffer), Object dictionary function may set ODF_arg->data
+ *     to that memory instead of filling the buffer. This is allowed only on
+ *     the first call (firstSegment is true), with lastSegment set to true.
+ *     dataLength is then not limited by #CO_SDO_BUFFER_SIZE. Segments and
+ *     blocks are sent directly from that memory, which must stay valid and
+ *     unchanged until the end of the transfer.
+ *
+ * ####Deferred completion
+ *     With #CO_SDO_ODF_PENDING, Object dictionary function, which must wait
+ *     for slow device, may start the operation and return CO_SDO_AB_PENDING.
+ *     SDO server then parks the transfer without response and returns from
+ *     CO_SDO_process(). When the operation is finished, application calls
+ *     CO_SDO_ODFcomplete() with ODF_arg->SDO, and SDO server calls the
+ *     function again with the same arguments and ODF_arg->resumed set.
+ *     Function then returns the result of the operation. CO_SDO_AB_PENDING may be returned on upload
+ *     initiate and on segmented or expedited download, elsewhere transfer is
+ *     aborted with CO_SDO_AB_DEVICE_INCOMPAT. Function must not change
+ *     ODF_arg, when returning CO_SDO_AB_PENDING.
+ *
+ * ####Double buffered domain upload
+ *     With #CO_SDO_DOMAIN_PREFETCH, domain is uploaded from two parts of the
+ *     data buffer, which are halves at start. Object dictionary function
+ *     fills one part (dataLength is size of the part), and while its data are
+ *     transmitted, SDO server calls the function again for the next data into
+ *     the other part. The function may start DMA there and return
+ *     CO_SDO_AB_PENDING, segments are transmitted meanwhile. After
+ *     CO_SDO_ODFcomplete() it is called again with ODF_arg->resumed set and
+ *     returns the result as above. Transmission waits, if data of both parts
+ *     are transmitted, before the reading is complete. Sub-block of block
+ *     upload may span both parts, so blksize is limited by the whole data
+ *     buffer. Part, which client has confirmed, is read again. If client
+ *     confirms only some segments of the sub-block, the rest is moved to the
+ *     beginning of data buffer and next data are read behind it, into the
+ *     new second part. Transfer may be aborted, while reading is in
+ *     progress. CO_SDO_ODFcomplete() must then be called anyway, data buffer
+ *     is not used for the next transfer before.
+ *
  * ####Parameter to function:
  *     ODF_arg     - Pointer to CO_ODF_arg_t object filled before function call.
  *
@@ -350,7 +407,9 @@ typedef enum{
  *
  * Size must be at least equal to size of largest variable in @ref CO_SDO_objectDictionary.
  * If data type is domain, data length is not limited to SDO buffer size. If
- * block transfer is implemented, value should be set to 889.
+ * block transfer is implemented, value should be set to 889. With
+ * #CO_SDO_BUFFER_EXT it is the default size, single SDO servers may get
+ * larger buffer.
  *
  * Value can be in range from 7 to 889 bytes.
  */
@@ -359,6 +418,133 @@ typedef enum{
     #endif
 
 
+/**
+ * Maximum number of segments per block in SDO block download.
+ *
+ * Server proposes blksize as smaller of CO_SDO_BLOCK_SIZE and number of
+ * segments, which fit into free part of the SDO buffer. For full size blocks
+ * CO_SDO_BUFFER_SIZE must be at least 7 * CO_SDO_BLOCK_SIZE.
+ *
+ * Value can be in range from 1 to 127.
+ */
+    #ifndef CO_SDO_BLOCK_SIZE
+        #define CO_SDO_BLOCK_SIZE     127
+    #endif
+
+
+/**
+ * Number of received SDO frames, which are queued, while the previous frame
+ * is not processed yet.
+ *
+ * Used by SDO server and SDO client. Without queue, frame is dropped, if it
+ * is received before the mainline finishes the previous one. This happens
+ * with segments of the next sub-block, which follow the block acknowledge
+ * immediately, and with requests sent directly after the end of a block
+ * transfer. Queued frames are processed by CO_SDO_process() (before and
+ * after the state machine) and by CO_SDOclientDownload() or
+ * CO_SDOclientUpload(). Queue holds the frames of the time between two
+ * processing calls, eight frames take about 1 ms at 1 Mbit/s.
+ *
+ * Value must be 0 (no queue) or power of two up to 128.
+ */
+    #ifndef CO_SDO_RX_QUEUE
+        #define CO_SDO_RX_QUEUE       8
+    #endif
+
+
+/**
+ * Number of SDO data buffers shared by SDO servers.
+ *
+ * If nonzero, SDO server has no own data buffer. Buffer of size
+ * #CO_SDO_BUFFER_SIZE is leased from the pool given by CO_SDO_initBufferPool(),
+ * when transfer is initiated, and returned, when server is idle again. If no
+ * buffer is free, request is aborted with CO_SDO_AB_OUT_OF_MEM.
+ *
+ * Value can be in range from 0 to 32.
+ */
+    #ifndef CO_SDO_BUFFER_POOL
+        #define CO_SDO_BUFFER_POOL    0
+    #endif
+
+
+/**
+ * Deferred completion of Object dictionary functions.
+ *
+ * If nonzero, @ref CO_SDO_OD_function may return CO_SDO_AB_PENDING and
+ * finish the operation later, see CO_SDO_ODFcomplete(). Parked SDO server
+ * does not block CO_process(). If not completed within SDO timeout, transfer
+ * is aborted with CO_SDO_AB_TIMEOUT.
+ */
+    #ifndef CO_SDO_ODF_PENDING
+        #define CO_SDO_ODF_PENDING    0
+    #endif
+
+
+/**
+ * Data buffer of other size for single SDO server.
+ *
+ * If nonzero, application may give own data buffer to SDO server with
+ * CO_SDO_initBuffer(), for example 889 bytes for full size blocks on SDO
+ * server used by configuration tool, while other servers keep
+ * #CO_SDO_BUFFER_SIZE. Such server does not lease buffer from the pool
+ * (#CO_SDO_BUFFER_POOL).
+ */
+    #ifndef CO_SDO_BUFFER_EXT
+        #define CO_SDO_BUFFER_EXT     0
+    #endif
+
+
+/**
+ * Double buffered domain upload.
+ *
+ * If nonzero, next data of domain upload are read by Object dictionary
+ * function into the second half of data buffer, while the first half is
+ * transmitted, see @ref CO_SDO_OD_function. Reading from external memory
+ * (SPI flash) may then run by DMA concurrently with the transmission.
+ * Requires #CO_SDO_ODF_PENDING. Data buffer must have at least 14 bytes and
+ * must hold 7 * blksize bytes of the block upload, the same as without
+ * prefetch.
+ */
+    #ifndef CO_SDO_DOMAIN_PREFETCH
+        #define CO_SDO_DOMAIN_PREFETCH 0
+    #endif
+
+
+/**
+ * Lock-free application access to Object Dictionary.
+ *
+ * If nonzero, SDO server and RPDOs increment sequence counter of Object
+ * Dictionary around each write, see CO_OD_read(). RPDO copy in
+ * CO_RPDO_process() is then done inside CO_LOCK_OD(). Application may use
+ * accessors from threads, which are not more urgent than CO_LOCK_OD().
+ */
+    #ifndef CO_OD_ATOMIC
+        #define CO_OD_ATOMIC          0
+    #endif
+
+
+/**
+ * Length of the queue of OD change notifications.
+ *
+ * If nonzero, application may subscribe to OD entries with CO_OD_subscribe().
+ * When SDO server writes a new value into subscribed entry, its index and
+ * subindex are queued, writing the same value queues nothing. CO_process()
+ * delivers the queue once per call, so subscriber is called from mainline
+ * thread after the write, without OD function in the SDO path. Repeated
+ * writes of one subindex before delivery are merged. If queue is full, each
+ * subscriber is called once with #CO_OD_NOTIFY_ALL instead.
+ *
+ * #CO_OD_NOTIFY_SUBSCRIBERS is the maximum number of subscriptions. Value can
+ * be in range from 0 to 255.
+ */
+    #ifndef CO_OD_NOTIFY
+        #define CO_OD_NOTIFY          0
+    #endif
+    #ifndef CO_OD_NOTIFY_SUBSCRIBERS
+        #define CO_OD_NOTIFY_SUBSCRIBERS 8
+    #endif
+
+
 /**
  * Object Dictionary attributes. Bit masks for attribute in CO_OD_entry_t.
  */
@@ -548,8 +734,8 @@ typedef struct{
     /** SDO data buffer contains data, which are exchanged in SDO transfer.
     @ref CO_SDO_OD_function may verify or manipulate that data before (after)
     they are written to (read from) Object dictionary. Data have the same
-    endianes as processor. Pointer must NOT be changed. (Data up to length
-    can be changed.) */
+    endianes as processor. Pointer must NOT be changed (Data up to length
+    can be changed), except by domain upload, see @ref CO_SDO_OD_function. */
     uint8_t            *data;
     /** Pointer to location in object dictionary, where data are stored.
     (informative reference to old data, read only). Data have the same
@@ -583,6 +769,12 @@ typedef struct{
     /** Used by domain data type. In case of multiple segments, this indicates the offset
     into the buffer this segment starts at. */
     uint32_t            offset;
+#if CO_SDO_ODF_PENDING > 0
+    /** SDO server (CO_SDO_t) of the transfer, argument for CO_SDO_ODFcomplete() */
+    void               *SDO;
+    /** True, if function is called again after CO_SDO_ODFcomplete() */
+    bool_t              resumed;
+#endif
 }CO_ODF_arg_t;
 
 
@@ -600,17 +792,125 @@ typedef struct{
     /** Pointer to #CO_SDO_OD_flags_t. If object type is array or record, this
     variable points to array with length equal to number of subindexes. */
     uint8_t            *flags;
+#if CO_TPDO_DIRTY_FLAGS > 0
+    /** Bit per TPDO, which maps this entry. Set by CO_TPDOconfigMap() */
+    uint32_t            TPDOmask;
+#endif
+#if CO_OD_FLAT_SIZE > 0
+    /** Position of subindex 0 of this entry in flat descriptor table */
+    uint16_t            flatIdx;
+#endif
+#if CO_OD_NOTIFY > 0
+    /** True, if entry has subscriber, see CO_OD_subscribe() */
+    bool_t              notify;
+#endif
 }CO_OD_extension_t;
 
 
+#if CO_OD_FLAT_SIZE > 0
+/**
+ * Resolved descriptor of one subindex in Object Dictionary, see #CO_OD_FLAT_SIZE.
+ */
+typedef struct{
+    /** Same as CO_OD_getDataPointer() */
+    void               *pData;
+    /** Same as CO_OD_getFlagsPointer(), NULL if entry has no flags */
+    uint8_t            *pFlags;
+    /** Same as CO_OD_getLength() */
+    uint16_t            length;
+    /** Same as CO_OD_getAttribute() */
+    uint16_t            attribute;
+}CO_OD_subEntry_t;
+#endif
+
+
+#if CO_SDO_BUFFER_POOL > 0
+/**
+ * Pool of SDO data buffers, shared by SDO servers. See #CO_SDO_BUFFER_POOL.
+ */
+typedef struct{
+    /** Data buffers */
+    uint8_t             buffer[CO_SDO_BUFFER_POOL][CO_SDO_BUFFER_SIZE];
+    /** Bit is set for each leased buffer */
+    uint32_t            used;
+}CO_SDObufferPool_t;
+#endif
+
+
+#if CO_OD_NOTIFY > 0
+/** Subindex passed to subscriber, if notifications were lost. All subscribed
+ * variables must then be read again. */
+#define CO_OD_NOTIFY_ALL        0xFFU
+
+/**
+ * Subscription to changes of one OD entry, see CO_OD_subscribe().
+ */
+typedef struct{
+    /** Index of subscribed entry */
+    uint16_t            index;
+    /** From CO_OD_subscribe() */
+    void               *object;
+    /** From CO_OD_subscribe() */
+    void              (*pFunct)(void *object, uint16_t index, uint8_t subIndex);
+}CO_ODsubscriber_t;
+
+
+/**
+ * Changed OD variable waiting for delivery.
+ */
+typedef struct{
+    uint16_t            index;          /**< Index of written entry */
+    uint8_t             subIndex;       /**< Written subindex */
+}CO_ODnotifyEvent_t;
+
+
+/**
+ * OD change notifications, shared by SDO servers. See #CO_OD_NOTIFY.
+ */
+typedef struct{
+    /** Subscriptions from CO_OD_subscribe() */
+    CO_ODsubscriber_t   subscriber[CO_OD_NOTIFY_SUBSCRIBERS];
+    /** Number of used subscriber */
+    uint8_t             subscriberCount;
+    /** Changes since the last CO_ODnotify_process(), written inside CO_LOCK_OD() */
+    CO_ODnotifyEvent_t  queue[CO_OD_NOTIFY];
+    /** Number of used queue */
+    uint8_t             queueCount;
+    /** True, if change did not fit into queue */
+    bool_t              overflow;
+}CO_ODnotify_t;
+#endif
+
+
 /**
  * SDO server object.
  */
 typedef struct{
     /** 8 data bytes of the received message. */
     uint8_t             CANrxData[8];
+#if CO_SDO_BUFFER_POOL > 0
+    /** SDO data buffer of size #CO_SDO_BUFFER_SIZE, leased from bufferPool
+    during transfer, NULL if idle. */
+    uint8_t            *databuffer;
+    /** From CO_SDO_initBufferPool() or NULL */
+    CO_SDObufferPool_t *bufferPool;
+#if CO_SDO_BUFFER_EXT > 0
+    /** From CO_SDO_initBuffer() or NULL, used instead of bufferPool */
+    uint8_t            *bufferExt;
+#endif
+#elif CO_SDO_BUFFER_EXT > 0
+    /** SDO data buffer, databufferOwn or from CO_SDO_initBuffer() */
+    uint8_t            *databuffer;
+    /** Own SDO data buffer of size #CO_SDO_BUFFER_SIZE. */
+    uint8_t             databufferOwn[CO_SDO_BUFFER_SIZE];
+#else
     /** SDO data buffer of size #CO_SDO_BUFFER_SIZE. */
     uint8_t             databuffer[CO_SDO_BUFFER_SIZE];
+#endif
+#if CO_SDO_BUFFER_EXT > 0
+    /** Size of SDO data buffer, see CO_SDO_initBuffer() */
+    uint16_t            bufferSize;
+#endif
     /** Internal flag indicates, that this object has own OD */
     bool_t              ownOD;
     /** Pointer to the @ref CO_SDO_objectDictionary (array) */
@@ -620,6 +920,30 @@ typedef struct{
     /** Pointer to array of CO_OD_extension_t objects. Size of the array is
     equal to ODSize. */
     CO_OD_extension_t  *ODExtensions;
+#if CO_OD_HASH_BITS > 0
+    /** Hash table of entry numbers, 0xFFFF for empty slot. Used if ownOD */
+    uint16_t            ODhashTable[1U << CO_OD_HASH_BITS];
+    /** Pointer to ODhashTable of this or parent SDO object, NULL if not built */
+    const uint16_t     *ODhash;
+#endif
+#if CO_OD_FLAT_SIZE > 0
+    /** Descriptors of all subindexes of all OD entries. Used if ownOD */
+    CO_OD_subEntry_t    ODflatTable[CO_OD_FLAT_SIZE];
+    /** Pointer to ODflatTable of this or parent SDO object, NULL if not built */
+    CO_OD_subEntry_t   *ODflat;
+#endif
+#if CO_TPDO_DIRTY_FLAGS > 0
+    /** Bit per TPDO, set if mapped OD entry was written. Used if ownOD */
+    volatile uint32_t   TPDOdirty;
+    /** Pointer to TPDOdirty of this or parent SDO object */
+    volatile uint32_t  *pTPDOdirty;
+#endif
+#if CO_OD_ATOMIC > 0
+    /** Sequence counter of OD writes, odd during write. Used if ownOD */
+    volatile uint32_t   ODsequence;
+    /** Pointer to ODsequence of this or parent SDO object */
+    volatile uint32_t  *pODsequence;
+#endif
     /** Offset in buffer of next data segment being read/written */
     uint16_t            bufferOffset;
     /** Sequence number of OD entry as returned from CO_OD_find() */
@@ -647,8 +971,42 @@ typedef struct{
     bool_t              endOfTransfer;
     /** Variable indicates, if new SDO message received from CAN bus */
     bool_t              CANrxNew;
+#if CO_SDO_RX_QUEUE > 0
+    /** Frames received while CANrxNew was set, see #CO_SDO_RX_QUEUE */
+    uint8_t             CANrxQueue[CO_SDO_RX_QUEUE][8];
+    /** Queue write counter, incremented by receive interrupt */
+    volatile uint8_t    CANrxHead;
+    /** Queue read counter, incremented by CO_SDO_process() */
+    volatile uint8_t    CANrxTail;
+#endif
+#if CO_SDO_ODF_PENDING > 0
+    /** True, if transfer is parked by OD function, which returned CO_SDO_AB_PENDING */
+    bool_t              pending;
+    /** Set by CO_SDO_ODFcomplete() */
+    volatile bool_t     pendingDone;
+#endif
+#if CO_SDO_DOMAIN_PREFETCH > 0
+    /** Part of data buffer for the next data of domain upload */
+    uint8_t            *prefetchData;
+    /** Data buffer is split into parts [0, prefetchSplit) and [prefetchSplit, size) */
+    uint16_t            prefetchSplit;
+    /** Length of data in prefetchData, if prefetchState is ready */
+    uint16_t            prefetchLength;
+    /** lastSegment from OD function, if prefetchState is ready */
+    bool_t              prefetchLast;
+    /** Reading of next data, CO_SDO_PREFETCH_xxx in CO_SDO.c */
+    uint8_t             prefetchState;
+#endif
     /** From CO_SDO_initCallback() or NULL */
     void              (*pFunctSignal)(void);
+    /** From CO_SDO_initCallbackWrite() or NULL */
+    void              (*pFunctWrite)(void *object, const void *ODdata, uint16_t length);
+    /** From CO_SDO_initCallbackWrite() */
+    void               *functWriteObject;
+#if CO_OD_NOTIFY > 0
+    /** From CO_SDO_initNotify() or NULL */
+    CO_ODnotify_t      *ODnotify;
+#endif
     /** From CO_SDO_init() */
     CO_CANmodule_t     *CANdevTx;
     /** CAN transmit buffer inside CANdev for CAN tx message */
@@ -666,6 +1024,74 @@ typedef union{
 }CO_bytes_t;
 
 
+#if CO_INLINE_HELPERS > 0
+#include <string.h>         /* for 'memcpy' */
+
+/*
+ * Inline versions of the helper functions below, see #CO_INLINE_HELPERS.
+ * Fixed size memcpy() compiles to single (unaligned) loads and stores.
+ */
+static inline void CO_memcpy(uint8_t dest[], const uint8_t src[], const uint16_t size){
+    memcpy(dest, src, size);
+}
+
+static inline uint16_t CO_getUint16(const uint8_t data[]){
+    uint16_t value;
+    memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+static inline uint32_t CO_getUint32(const uint8_t data[]){
+    uint32_t value;
+    memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+static inline void CO_setUint16(uint8_t data[], const uint16_t value){
+    memcpy(data, &value, sizeof(value));
+}
+
+static inline void CO_setUint32(uint8_t data[], const uint32_t value){
+    memcpy(data, &value, sizeof(value));
+}
+
+#ifdef CO_LITTLE_ENDIAN
+static inline void CO_memcpySwap2(void* dest, const void* src){
+    memcpy(dest, src, 2);
+}
+
+static inline void CO_memcpySwap4(void* dest, const void* src){
+    memcpy(dest, src, 4);
+}
+
+static inline void CO_memcpySwap8(void* dest, const void* src){
+    memcpy(dest, src, 8);
+}
+#endif
+#ifdef CO_BIG_ENDIAN
+static inline void CO_memcpySwap2(void* dest, const void* src){
+    uint16_t value;
+    memcpy(&value, src, sizeof(value));
+    value = __builtin_bswap16(value);
+    memcpy(dest, &value, sizeof(value));
+}
+
+static inline void CO_memcpySwap4(void* dest, const void* src){
+    uint32_t value;
+    memcpy(&value, src, sizeof(value));
+    value = __builtin_bswap32(value);
+    memcpy(dest, &value, sizeof(value));
+}
+
+static inline void CO_memcpySwap8(void* dest, const void* src){
+    uint64_t value;
+    memcpy(&value, src, sizeof(value));
+    value = __builtin_bswap64(value);
+    memcpy(dest, &value, sizeof(value));
+}
+#endif
+
+#else
 /**
  * Helper function like memcpy.
  *
@@ -742,6 +1168,7 @@ void CO_memcpySwap4(void* dest, const void* src);
  * @param src Source location.
  */
 void CO_memcpySwap8(void* dest, const void* src);
+#endif
 
 
 /**
@@ -762,7 +1189,8 @@ void CO_memcpySwap8(void* dest, const void* src);
  * @param ODExtensions Pointer to the externally defined array of the same size
  * as ODSize.
  * @param nodeId CANopen Node ID of this device.
- * @param CANdevRx CAN device for SDO server reception.
+ * @param CANdevRx CAN device for SDO server reception. If NULL together with
+ * CANdevTx, object only holds Object Dictionary and must not be processed.
  * @param CANdevRxIdx Index of receive buffer in the above CAN device.
  * @param CANdevTx CAN device for SDO server transmission.
  * @param CANdevTxIdx Index of transmit buffer in the above CAN device.
@@ -785,6 +1213,45 @@ CO_ReturnError_t CO_SDO_init(
         uint16_t                CANdevTxIdx);
 
 
+#if CO_SDO_BUFFER_POOL > 0
+/**
+ * Set pool of data buffers for SDO server.
+ *
+ * Must be called after CO_SDO_init(). All SDO servers may share the same pool.
+ * If SDO is parent object (owns Object dictionary), all buffers in the pool
+ * are marked free.
+ *
+ * @param SDO This object.
+ * @param bufferPool Pool of data buffers.
+ */
+void CO_SDO_initBufferPool(
+        CO_SDO_t               *SDO,
+        CO_SDObufferPool_t     *bufferPool);
+#endif
+
+
+#if CO_SDO_BUFFER_EXT > 0
+/**
+ * Set own data buffer for SDO server, see #CO_SDO_BUFFER_EXT.
+ *
+ * Must be called after CO_SDO_init() (and after CO_SDO_initBufferPool()),
+ * while SDO server is idle. Size must be at least equal to size of the largest
+ * variable, which is transferred by this server, 889 bytes for full size
+ * blocks.
+ *
+ * @param SDO This object.
+ * @param buffer Data buffer, NULL for the default buffer.
+ * @param bufferSize Size of the buffer in bytes, ignored if buffer is NULL.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_SDO_initBuffer(
+        CO_SDO_t               *SDO,
+        uint8_t                *buffer,
+        uint16_t                bufferSize);
+#endif
+
+
 /**
  * Initialize SDOrx callback function.
  *
@@ -800,6 +1267,96 @@ void CO_SDO_initCallback(
         void                  (*pFunctSignal)(void));
 
 
+/**
+ * Initialize SDO write callback function.
+ *
+ * Function initializes optional callback function, which is called after SDO
+ * server wrote new data into object dictionary variable located in EEPROM
+ * memory (#CO_ODA_MEM_EEPROM). It may be used to mark modified range for
+ * storage, see CO_EE_setDirty(). Callback is called from mainline thread.
+ *
+ * @param SDO This object.
+ * @param object Pointer to object, which will be passed to pFunctWrite(). Can be NULL.
+ * @param pFunctWrite Pointer to the callback function. Not called if NULL.
+ * Arguments are object, address of written variable and its length.
+ */
+void CO_SDO_initCallbackWrite(
+        CO_SDO_t               *SDO,
+        void                   *object,
+        void                  (*pFunctWrite)(void *object, const void *ODdata, uint16_t length));
+
+
+#if CO_OD_NOTIFY > 0
+/**
+ * Initialize OD change notifications, see #CO_OD_NOTIFY.
+ *
+ * Function must be called for each SDO server after CO_SDO_init(), all
+ * servers get the same object. SDO server with own OD clears subscriptions
+ * and queue, so subscribers must be added again after each initialization,
+ * as with CO_OD_configure().
+ *
+ * @param SDO This object.
+ * @param ODnotify Notifications, shared by SDO servers.
+ */
+void CO_SDO_initNotify(
+        CO_SDO_t               *SDO,
+        CO_ODnotify_t          *ODnotify);
+
+
+/**
+ * Subscribe to changes of one OD entry.
+ *
+ * pFunct is called from CO_ODnotify_process() for each subindex of the
+ * entry, which SDO server has written with a new value since the previous
+ * call. Writes by RPDO or by application are not notified. One entry may
+ * have several subscribers.
+ *
+ * @param SDO SDO server with OD, for example CO->SDO[0].
+ * @param index Index of object in the Object dictionary.
+ * @param object Pointer to object, which will be passed to pFunct. Can be NULL.
+ * @param pFunct Callback, arguments are object, index and subindex, which is
+ * #CO_OD_NOTIFY_ALL, if notifications were lost.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO, CO_ERROR_ILLEGAL_ARGUMENT (no OD
+ * entry, CO_SDO_initNotify() not called) or CO_ERROR_OUT_OF_MEMORY (more
+ * than #CO_OD_NOTIFY_SUBSCRIBERS).
+ */
+CO_ReturnError_t CO_OD_subscribe(
+        CO_SDO_t               *SDO,
+        uint16_t                index,
+        void                   *object,
+        void                  (*pFunct)(void *object, uint16_t index, uint8_t subIndex));
+
+
+/**
+ * Deliver queued OD change notifications to subscribers.
+ *
+ * Called by CO_process() once per call. Queue is taken inside CO_LOCK_OD(),
+ * subscribers are called outside of it. If nothing was written, function
+ * returns after one comparison.
+ *
+ * @param ODnotify Notifications from CO_SDO_initNotify(), may be NULL.
+ */
+void CO_ODnotify_process(CO_ODnotify_t *ODnotify);
+#endif
+
+
+#if CO_SDO_ODF_PENDING > 0
+/**
+ * Complete deferred OD function.
+ *
+ * Called by application, when operation of @ref CO_SDO_OD_function, which
+ * returned CO_SDO_AB_PENDING, is finished. Next CO_SDO_process() calls the
+ * function again. May be called from any thread, also before the function
+ * returned. Callback from CO_SDO_initCallback() is called.
+ *
+ * @param SDO SDO server, ODF_arg->SDO of the parked transfer or of the
+ * reading of next domain data (#CO_SDO_DOMAIN_PREFETCH).
+ */
+void CO_SDO_ODFcomplete(void *SDO);
+#endif
+
+
 /**
  * Process SDO communication.
  *
@@ -918,6 +1475,82 @@ void* CO_OD_getDataPointer(CO_SDO_t *SDO, uint16_t entryNo, uint8_t subIndex);
 uint8_t* CO_OD_getFlagsPointer(CO_SDO_t *SDO, uint16_t entryNo, uint8_t subIndex);
 
 
+#if CO_OD_ATOMIC > 0
+/**
+ * Read aligned OD variable of _type_ up to 32 bits with single access.
+ *
+ * @param type Type of the variable, e.g. uint16_t.
+ * @param var OD variable, e.g. OD_errorRegister.
+ */
+#define CO_OD_READ(type, var)         (*(const volatile type*)&(var))
+
+/**
+ * Write aligned OD variable of _type_ up to 32 bits with single access.
+ * Use CO_TPDOmarkDirty() afterwards, if variable is mapped to TPDO with
+ * change of state detection.
+ *
+ * @param type Type of the variable, e.g. uint16_t.
+ * @param var OD variable.
+ * @param value New value.
+ */
+#define CO_OD_WRITE(type, var, value) (*(volatile type*)&(var) = (type)(value))
+
+
+/**
+ * Begin write of Object Dictionary, made by CANopen objects.
+ *
+ * Must be called inside CO_LOCK_OD() or from CAN receive interrupt, is
+ * followed by CO_OD_writeEnd().
+ *
+ * @param SDO SDO object.
+ */
+static inline void CO_OD_writeBegin(CO_SDO_t *SDO){
+    (*SDO->pODsequence)++;
+    CO_MEMORY_BARRIER();
+}
+
+
+/**
+ * End write of Object Dictionary, see CO_OD_writeBegin().
+ *
+ * @param SDO SDO object.
+ */
+static inline void CO_OD_writeEnd(CO_SDO_t *SDO){
+    CO_MEMORY_BARRIER();
+    (*SDO->pODsequence)++;
+}
+
+
+/**
+ * Read consistent copy of OD variable or array without lock.
+ *
+ * Function copies _length_ bytes and repeats the copy, if Object Dictionary
+ * was written meanwhile.
+ *
+ * @param SDO SDO object.
+ * @param dest Destination buffer.
+ * @param var OD variable.
+ * @param length Number of bytes.
+ */
+void CO_OD_read(CO_SDO_t *SDO, void *dest, const void *var, uint16_t length);
+
+
+/**
+ * Write OD variable or array longer than 32 bits.
+ *
+ * Copy is short, it is done inside CO_LOCK_OD() and increments sequence
+ * counter for CO_OD_read(). Use CO_TPDOmarkDirty() afterwards, if variable is
+ * mapped to TPDO with change of state detection.
+ *
+ * @param SDO SDO object.
+ * @param var OD variable.
+ * @param src New value.
+ * @param length Number of bytes.
+ */
+void CO_OD_write(CO_SDO_t *SDO, void *var, const void *src, uint16_t length);
+#endif
+
+
 /**
  * Initialize SDO transfer.
  *
@@ -108,6 +108,74 @@
 #define SDO_STATE_BLOCKUPLOAD_BLOCK_END         207
 
 
+/*
+ * Take data of received message.
+ *
+ * Message is copied into CANrxData, or segment of block upload directly
+ * into the buffer. Called from CO_SDOclient_receive() or from
+ * CO_SDOclient_receiveQueued(), if CANrxNew is not set.
+ *
+ * @param SDO_C This object.
+ * @param data 8 data bytes of the message.
+ */
+static void CO_SDOclient_receiveData(CO_SDOclient_t *SDO_C, const uint8_t data[]){
+    if(SDO_C->state != SDO_STATE_BLOCKUPLOAD_INPROGRES) {
+        /* copy data and set 'new message' flag */
+        SDO_C->CANrxData[0] = data[0];
+        SDO_C->CANrxData[1] = data[1];
+        SDO_C->CANrxData[2] = data[2];
+        SDO_C->CANrxData[3] = data[3];
+        SDO_C->CANrxData[4] = data[4];
+        SDO_C->CANrxData[5] = data[5];
+        SDO_C->CANrxData[6] = data[6];
+        SDO_C->CANrxData[7] = data[7];
+
+        SDO_C->CANrxNew = true;
+    }
+    else {
+        /* block upload, copy data directly */
+        uint8_t seqno;
+
+        SDO_C->CANrxData[0] = data[0];
+        seqno = SDO_C->CANrxData[0] & 0x7f;
+        SDO_C->timeoutTimer = 0;
+        SDO_C->timeoutTimerBLOCK = 0;
+
+        /* check correct sequence number. */
+        if(seqno == (SDO_C->block_seqno + 1)) {
+            /* block_seqno is correct */
+            uint8_t i;
+
+            SDO_C->block_seqno++;
+
+            /* copy data, bytes behind the end of buffer may be unused bytes
+             * of the last segment, they are only counted */
+            for(i=1; i<8; i++) {
+                if(SDO_C->dataSizeTransfered < SDO_C->bufferSize) {
+                    SDO_C->buffer[SDO_C->dataSizeTransfered] = data[i];
+                }
+                SDO_C->dataSizeTransfered++;
+            }
+
+            /* break reception if last segment, block sequence is too large or buffer is full */
+            if(((SDO_C->CANrxData[0] & 0x80U) == 0x80U) || (SDO_C->block_seqno >= SDO_C->block_blksize) ||
+               (SDO_C->dataSizeTransfered >= SDO_C->bufferSize)) {
+                SDO_C->state = SDO_STATE_BLOCKUPLOAD_SUB_END;
+                SDO_C->CANrxNew = true;
+            }
+        }
+        else if((seqno == SDO_C->block_seqno) || (SDO_C->block_seqno == 0U)){
+            /* Ignore message, if it is duplicate or if sequence didn't started yet. */
+        }
+        else {
+            /* seqno is totally wrong, break reception. */
+            SDO_C->state = SDO_STATE_BLOCKUPLOAD_SUB_END;
+            SDO_C->CANrxNew = true;
+        }
+    }
+}
+
+
 /*
  * Read received message from CAN module.
  *
@@ -120,63 +188,37 @@ static void CO_SDOclient_receive(void *object, const CO_CANrxMsg_t *msg){
 
     SDO_C = (CO_SDOclient_t*)object;    /* this is the correct pointer type of the first argument */
 
-    /* verify message length and message overflow (previous message was not processed yet) */
-    if((msg->DLC == 8U) && (!SDO_C->CANrxNew) && (SDO_C->state != SDO_STATE_NOTDEFINED)){
-        if(SDO_C->state != SDO_STATE_BLOCKUPLOAD_INPROGRES) {
-            /* copy data and set 'new message' flag */
-            SDO_C->CANrxData[0] = msg->data[0];
-            SDO_C->CANrxData[1] = msg->data[1];
-            SDO_C->CANrxData[2] = msg->data[2];
-            SDO_C->CANrxData[3] = msg->data[3];
-            SDO_C->CANrxData[4] = msg->data[4];
-            SDO_C->CANrxData[5] = msg->data[5];
-            SDO_C->CANrxData[6] = msg->data[6];
-            SDO_C->CANrxData[7] = msg->data[7];
+    /* verify message length and state */
+    if((msg->DLC == 8U) && (SDO_C->state != SDO_STATE_NOTDEFINED)){
+#if CO_SDO_RX_QUEUE > 0
+        /* previous message was not processed yet, keep order of messages */
+        if(SDO_C->CANrxNew || (SDO_C->CANrxHead != SDO_C->CANrxTail)){
+            uint8_t head = SDO_C->CANrxHead;
 
-            SDO_C->CANrxNew = true;
-        }
-        else {
-            /* block upload, copy data directly */
-            uint8_t seqno;
-
-            SDO_C->CANrxData[0] = msg->data[0];
-            seqno = SDO_C->CANrxData[0] & 0x7f;
-            SDO_C->timeoutTimer = 0;
-            SDO_C->timeoutTimerBLOCK = 0;
-
-            /* check correct sequence number. */
-            if(seqno == (SDO_C->block_seqno + 1)) {
-                /* block_seqno is correct */
+            if((uint8_t)(head - SDO_C->CANrxTail) < CO_SDO_RX_QUEUE){
+                uint8_t *dest = SDO_C->CANrxQueue[head & (CO_SDO_RX_QUEUE - 1U)];
                 uint8_t i;
 
-                SDO_C->block_seqno++;
-
-                /* copy data */
-                for(i=1; i<8; i++) {
-                    SDO_C->buffer[SDO_C->dataSizeTransfered++] = msg->data[i];
-                    if(SDO_C->dataSizeTransfered >= SDO_C->bufferSize) {
-                        /* buffer full, break reception */
-                        SDO_C->state = SDO_STATE_BLOCKUPLOAD_SUB_END;
-                        SDO_C->CANrxNew = true;
-                        break;
-                    }
+                for(i=0; i<8; i++) {
+                    dest[i] = msg->data[i];
                 }
-
-                /* break reception if last segment or block sequence is too large */
-                if(((SDO_C->CANrxData[0] & 0x80U) == 0x80U) || (SDO_C->block_seqno >= SDO_C->block_blksize)) {
-                    SDO_C->state = SDO_STATE_BLOCKUPLOAD_SUB_END;
-                    SDO_C->CANrxNew = true;
-                }
-            }
-            else if((seqno == SDO_C->block_seqno) || (SDO_C->block_seqno == 0U)){
-                /* Ignore message, if it is duplicate or if sequence didn't started yet. */
+                CO_MEMORY_BARRIER();
+                SDO_C->CANrxHead = head + 1U;
             }
-            else {
-                /* seqno is totally wrong, break reception. */
-                SDO_C->state = SDO_STATE_BLOCKUPLOAD_SUB_END;
-                SDO_C->CANrxNew = true;
+
+            /* Optional signal to RTOS, which can resume task, which handles SDO client. */
+            if(SDO_C->pFunctSignal != NULL) {
+                SDO_C->pFunctSignal();
             }
+            return;
         }
+#else
+        /* message overflow (previous message was not processed yet) */
+        if(SDO_C->CANrxNew){
+            return;
+        }
+#endif
+        CO_SDOclient_receiveData(SDO_C, msg->data);
 
         /* Optional signal to RTOS, which can resume task, which handles SDO client. */
         if(SDO_C->CANrxNew && SDO_C->pFunctSignal != NULL) {
@@ -186,6 +228,25 @@ static void CO_SDOclient_receive(void *object, const CO_CANrxMsg_t *msg){
 }
 
 
+#if CO_SDO_RX_QUEUE > 0
+/*
+ * Take queued messages, until one of them has to be processed.
+ *
+ * @param SDO_C This object.
+ */
+static void CO_SDOclient_receiveQueued(CO_SDOclient_t *SDO_C){
+    while(!SDO_C->CANrxNew && (SDO_C->CANrxTail != SDO_C->CANrxHead)){
+        uint8_t tail = SDO_C->CANrxTail;
+
+        CO_MEMORY_BARRIER();
+        CO_SDOclient_receiveData(SDO_C, SDO_C->CANrxQueue[tail & (CO_SDO_RX_QUEUE - 1U)]);
+        CO_MEMORY_BARRIER();
+        SDO_C->CANrxTail = tail + 1U;
+    }
+}
+#endif
+
+
 /******************************************************************************/
 CO_ReturnError_t CO_SDOclient_init(
         CO_SDOclient_t         *SDO_C,
@@ -205,9 +266,17 @@ CO_ReturnError_t CO_SDOclient_init(
     /* Configure object variables */
     SDO_C->state = SDO_STATE_NOTDEFINED;
     SDO_C->CANrxNew = false;
+#if CO_SDO_RX_QUEUE > 0
+    SDO_C->CANrxHead = 0U;
+    SDO_C->CANrxTail = 0U;
+#endif
 
     SDO_C->pst    = 21; /*  block transfer */
     SDO_C->block_size_max = 127; /*  block transfer */
+    SDO_C->block_adaptive = false;
+    SDO_C->block_size_adaptive = SDO_C->block_size_max;
+    SDO_C->block_retries = 0;
+    SDO_C->transferTime_ms = 0;
 
     SDO_C->SDO = SDO;
     SDO_C->SDOClientPar = SDOClientPar;
@@ -258,6 +327,9 @@ CO_SDOclient_return_t CO_SDOclient_setup(
     /* Configure object variables */
     SDO_C->state = SDO_STATE_NOTDEFINED;
     SDO_C->CANrxNew = false;
+#if CO_SDO_RX_QUEUE > 0
+    SDO_C->CANrxTail = SDO_C->CANrxHead;
+#endif
 
     /* setup Object Dictionary variables */
     if((COB_IDClientToServer & 0x80000000L) != 0 || (COB_IDServerToClient & 0x80000000L) != 0 || nodeIDOfTheSDOServer == 0){
@@ -320,6 +392,9 @@ static void CO_SDOclient_abort(CO_SDOclient_t *SDO_C, uint32_t code){
     CO_CANsend(SDO_C->CANdevTx, SDO_C->CANtxBuff);
     SDO_C->state = SDO_STATE_NOTDEFINED;
     SDO_C->CANrxNew = false;
+#if CO_SDO_RX_QUEUE > 0
+    SDO_C->CANrxTail = SDO_C->CANrxHead;
+#endif
 }
 
 
@@ -334,6 +409,40 @@ static void CO_SDOTxBufferClear(CO_SDOclient_t *SDO_C) {
 }
 
 
+/*
+ * Get number of segments for next sub-block of block upload.
+ */
+static uint8_t CO_SDOclient_blksize(CO_SDOclient_t *SDO_C){
+    if(SDO_C->block_adaptive && SDO_C->block_size_adaptive < SDO_C->block_size_max){
+        return SDO_C->block_size_adaptive;
+    }
+    return SDO_C->block_size_max;
+}
+
+
+/*
+ * Adapt block size after sub-block. Additive increase after complete
+ * sub-block, multiplicative decrease after lost segments.
+ */
+static void CO_SDOclient_adaptBlksize(CO_SDOclient_t *SDO_C, bool_t complete){
+    uint8_t blksize = CO_SDOclient_blksize(SDO_C);
+
+    if(!complete){
+        SDO_C->block_retries++;
+    }
+    if(SDO_C->block_adaptive){
+        if(complete){
+            blksize = (blksize > (SDO_C->block_size_max - 8)) ?
+                      SDO_C->block_size_max : (blksize + 8);
+        }
+        else{
+            blksize = (blksize > 4) ? (blksize / 2) : 2;
+        }
+        SDO_C->block_size_adaptive = blksize;
+    }
+}
+
+
 /*******************************************************************************
  *
  * DOWNLOAD
@@ -356,6 +465,8 @@ CO_SDOclient_return_t CO_SDOclientDownloadInitiate(
     /* save parameters */
     SDO_C->buffer = dataTx;
     SDO_C->bufferSize = dataSize;
+    SDO_C->block_retries = 0;
+    SDO_C->transferTime_ms = 0;
 
     SDO_C->state = SDO_STATE_DOWNLOAD_INITIATE;
 
@@ -409,6 +520,9 @@ CO_SDOclient_return_t CO_SDOclientDownloadInitiate(
 
     /* empty receive buffer, reset timeout timer and send message */
     SDO_C->CANrxNew = false;
+#if CO_SDO_RX_QUEUE > 0
+    SDO_C->CANrxTail = SDO_C->CANrxHead;
+#endif
     SDO_C->timeoutTimer = 0;
     CO_CANsend(SDO_C->CANdevTx, SDO_C->CANtxBuff);
 
@@ -430,6 +544,8 @@ CO_SDOclient_return_t CO_SDOclientDownload(
         return CO_SDOcli_wrongArguments;
     }
 
+    SDO_C->transferTime_ms += timeDifference_ms;
+
     /* clear abort code */
     *pSDOabortCode = CO_SDO_AB_NONE;
 
@@ -463,6 +579,9 @@ CO_SDOclient_return_t CO_SDOclientDownload(
 
 
 /*  RX data ****************************************************************************************** */
+#if CO_SDO_RX_QUEUE > 0
+    CO_SDOclient_receiveQueued(SDO_C);
+#endif
     if(SDO_C->CANrxNew){
         uint8_t SCS = SDO_C->CANrxData[0]>>5;    /* Client command specifier */
 
@@ -571,6 +690,7 @@ CO_SDOclient_return_t CO_SDOclientDownload(
                     /*  check number of segments */
                     if(SDO_C->CANrxData[1] != SDO_C->block_blksize){
                         /*  NOT all segments transferred successfully */
+                        SDO_C->block_retries++;
                         SDO_C->bufferOffsetACK += SDO_C->CANrxData[1] * 7;
                         SDO_C->bufferOffset = SDO_C->bufferOffsetACK;
                     }
@@ -763,6 +883,8 @@ CO_SDOclient_return_t CO_SDOclientUploadInitiate(
     /* save parameters */
     SDO_C->buffer = dataRx;
     SDO_C->bufferSize = dataRxSize;
+    SDO_C->block_retries = 0;
+    SDO_C->transferTime_ms = 0;
 
     /* prepare CAN tx message */
     CO_SDOTxBufferClear(SDO_C);
@@ -789,9 +911,12 @@ CO_SDOclient_return_t CO_SDOclientUploadInitiate(
         SDO_C->CANtxBuff->data[0] |= 0x04;
 
         /*  set number of segments in block */
-        SDO_C->block_blksize = SDO_C->block_size_max;
+        SDO_C->block_blksize = CO_SDOclient_blksize(SDO_C);
         if ((SDO_C->block_blksize *7) > SDO_C->bufferSize){
-            return CO_SDOcli_wrongArguments;
+            if(!SDO_C->block_adaptive || SDO_C->bufferSize < (2*7)){
+                return CO_SDOcli_wrongArguments;
+            }
+            SDO_C->block_blksize = SDO_C->bufferSize / 7;
         }
 
         SDO_C->CANtxBuff->data[4] = SDO_C->block_blksize;
@@ -808,6 +933,9 @@ CO_SDOclient_return_t CO_SDOclientUploadInitiate(
 
     /* empty receive buffer, reset timeout timer and send message */
     SDO_C->CANrxNew = false;
+#if CO_SDO_RX_QUEUE > 0
+    SDO_C->CANrxTail = SDO_C->CANrxHead;
+#endif
     SDO_C->timeoutTimer = 0;
     SDO_C->timeoutTimerBLOCK =0;
     CO_CANsend(SDO_C->CANdevTx, SDO_C->CANtxBuff);
@@ -833,6 +961,8 @@ CO_SDOclient_return_t CO_SDOclientUpload(
         return CO_SDOcli_wrongArguments;
     }
 
+    SDO_C->transferTime_ms += timeDifference_ms;
+
     /* clear abort code */
     *pSDOabortCode = CO_SDO_AB_NONE;
 
@@ -878,6 +1008,9 @@ CO_SDOclient_return_t CO_SDOclientUpload(
 
 
 /*  RX data ******************************************************************************** */
+#if CO_SDO_RX_QUEUE > 0
+    CO_SDOclient_receiveQueued(SDO_C);
+#endif
     if(SDO_C->CANrxNew){
         uint8_t SCS = SDO_C->CANrxData[0]>>5;    /* Client command specifier */
 
@@ -1076,11 +1209,16 @@ CO_SDOclient_return_t CO_SDOclientUpload(
                     SDO_C->dataSizeTransfered -= tmp32;
 
                     SDO_C->state = SDO_STATE_BLOCKUPLOAD_BLOCK_END;
-                    if (SDO_C->crcEnabled){
+                    if (SDO_C->dataSizeTransfered > SDO_C->bufferSize){
+                        *pSDOabortCode = CO_SDO_AB_OUT_OF_MEM;
+                        SDO_C->state = SDO_STATE_ABORT;
+                    }
+                    else if (SDO_C->crcEnabled){
                         uint16_t tmp16;
                         CO_memcpySwap2(&tmp16, &SDO_C->CANrxData[1]);
 
                         if (tmp16 != crc16_ccitt((unsigned char *)SDO_C->buffer, (unsigned int)SDO_C->dataSizeTransfered, 0)){
+                            CO_SDOclient_adaptBlksize(SDO_C, false);
                             *pSDOabortCode = CO_SDO_AB_CRC;
                             SDO_C->state = SDO_STATE_ABORT;
                         }
@@ -1183,6 +1321,8 @@ CO_SDOclient_return_t CO_SDOclientUpload(
             SDO_C->CANtxBuff->data[0] = (CCS_UPLOAD_BLOCK<<5) | 0x02;
             SDO_C->CANtxBuff->data[1] = SDO_C->block_seqno;
 
+            CO_SDOclient_adaptBlksize(SDO_C, SDO_C->block_seqno >= SDO_C->block_blksize);
+
             /*  set next block size */
             if (SDO_C->dataSize != 0){
                 if(SDO_C->dataSizeTransfered >= SDO_C->dataSize){
@@ -1191,8 +1331,8 @@ CO_SDOclient_return_t CO_SDOclientUpload(
                 }
                 else{
                     tmp32 = ((SDO_C->dataSize - SDO_C->dataSizeTransfered) / 7);
-                    if(tmp32 >= SDO_C->block_size_max){
-                        SDO_C->block_blksize = SDO_C->block_size_max;
+                    if(tmp32 >= CO_SDOclient_blksize(SDO_C)){
+                        SDO_C->block_blksize = CO_SDOclient_blksize(SDO_C);
                     }
                     else{
                         if((SDO_C->dataSize - SDO_C->dataSizeTransfered) % 7 == 0)
@@ -1206,6 +1346,9 @@ CO_SDOclient_return_t CO_SDOclientUpload(
                 }
             }
             else{
+                if(SDO_C->block_adaptive){
+                    SDO_C->block_blksize = CO_SDOclient_blksize(SDO_C);
+                }
                 SDO_C->block_seqno = 0;
                 SDO_C->timeoutTimerBLOCK = 0;
 
@@ -1242,9 +1385,194 @@ CO_SDOclient_return_t CO_SDOclientUpload(
 }
 
 
+/******************************************************************************/
+uint32_t CO_SDOclientThroughput(const CO_SDOclient_t *SDO_C, uint32_t dataSize){
+    if(SDO_C == NULL || SDO_C->transferTime_ms == 0U){
+        return 0U;
+    }
+    return (uint32_t)(((uint64_t)dataSize * 1000U) / SDO_C->transferTime_ms);
+}
+
+
 /******************************************************************************/
 void CO_SDOclientClose(CO_SDOclient_t *SDO_C){
     if(SDO_C != NULL) {
         SDO_C->state = SDO_STATE_NOTDEFINED;
     }
 }
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_SDOclientQueue_init(
+        CO_SDOclientQueue_t    *queue,
+        CO_SDOclient_t         *SDO_C[],
+        uint8_t                 noOfClients)
+{
+    /* verify arguments */
+    if(queue == NULL || SDO_C == NULL || noOfClients == 0 || noOfClients > 32){
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    queue->SDO_C = SDO_C;
+    queue->noOfClients = noOfClients;
+    queue->head = NULL;
+    queue->tail = NULL;
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_SDOclientQueue_submit(
+        CO_SDOclientQueue_t    *queue,
+        CO_SDOclientJob_t      *job)
+{
+    /* verify arguments */
+    if(queue == NULL || job == NULL || job->nodeId < 1 || job->nodeId > 127){
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    job->client = 0xFF;
+    job->result = CO_SDOcli_waitingServerResponse;
+    job->abortCode = 0;
+    job->next = NULL;
+
+    if(queue->tail == NULL){
+        queue->head = job;
+    }
+    else{
+        queue->tail->next = job;
+    }
+    queue->tail = job;
+
+    return CO_ERROR_NO;
+}
+
+
+/*
+ * Start SDO client job on free SDO client.
+ *
+ * @return CO_SDOcli_return_t from initiate function.
+ */
+static CO_SDOclient_return_t CO_SDOclientQueue_start(CO_SDOclient_t *SDO_C, CO_SDOclientJob_t *job){
+    CO_SDOclient_return_t ret;
+
+    ret = CO_SDOclient_setup(SDO_C, 0, 0, job->nodeId);
+    if(ret == CO_SDOcli_ok_communicationEnd){
+        if(job->upload){
+            ret = CO_SDOclientUploadInitiate(SDO_C, job->index, job->subIndex,
+                        job->data, job->dataSize, job->blockEnable ? 1 : 0);
+        }
+        else{
+            ret = CO_SDOclientDownloadInitiate(SDO_C, job->index, job->subIndex,
+                        job->data, job->dataSize, job->blockEnable ? 1 : 0);
+        }
+    }
+
+    return ret;
+}
+
+
+/******************************************************************************/
+uint16_t CO_SDOclientQueue_process(
+        CO_SDOclientQueue_t    *queue,
+        uint16_t                timeDifference_ms,
+        uint16_t                SDOtimeoutTime,
+        uint16_t               *timerNext_ms)
+{
+    CO_SDOclientJob_t *job;
+    CO_SDOclientJob_t *prev = NULL;
+    uint32_t clientBusy = 0;
+    uint32_t nodeBusy[4] = {0, 0, 0, 0};
+    uint16_t count = 0;
+
+    if(queue == NULL){
+        return 0;
+    }
+
+    /* advance running transfers and remember busy clients and nodes */
+    job = queue->head;
+    while(job != NULL){
+        CO_SDOclientJob_t *next = job->next;
+
+        if(job->client != 0xFF){
+            CO_SDOclient_t *SDO_C = queue->SDO_C[job->client];
+            CO_SDOclient_return_t ret;
+
+            if(job->upload){
+                ret = CO_SDOclientUpload(SDO_C, timeDifference_ms, SDOtimeoutTime,
+                            &job->dataSize, &job->abortCode);
+            }
+            else{
+                ret = CO_SDOclientDownload(SDO_C, timeDifference_ms, SDOtimeoutTime,
+                            &job->abortCode);
+            }
+
+            if(ret <= 0){
+                /* finished, remove job from the queue */
+                CO_SDOclientClose(SDO_C);
+                job->result = ret;
+                job->client = 0xFF;
+                if(prev == NULL) queue->head = next;
+                else             prev->next = next;
+                if(queue->tail == job) queue->tail = prev;
+                job->next = NULL;
+                if(job->pFunctDone != NULL){
+                    job->pFunctDone(job);
+                }
+                job = next;
+                continue;
+            }
+
+            clientBusy |= 1UL << job->client;
+            nodeBusy[job->nodeId >> 5] |= 1UL << (job->nodeId & 0x1F);
+        }
+        count++;
+        prev = job;
+        job = next;
+    }
+
+    /* start waiting jobs on free clients, one transfer per node at a time */
+    job = queue->head;
+    prev = NULL;
+    while(job != NULL && (clientBusy != (0xFFFFFFFFUL >> (32 - queue->noOfClients)))){
+        CO_SDOclientJob_t *next = job->next;
+
+        if(job->client == 0xFF && (nodeBusy[job->nodeId >> 5] & (1UL << (job->nodeId & 0x1F))) == 0){
+            uint8_t i;
+            CO_SDOclient_return_t ret;
+
+            for(i=0; (clientBusy & (1UL << i)) != 0; i++);
+
+            ret = CO_SDOclientQueue_start(queue->SDO_C[i], job);
+            if(ret < 0){
+                /* could not be started, remove job from the queue */
+                CO_SDOclientClose(queue->SDO_C[i]);
+                job->result = ret;
+                if(prev == NULL) queue->head = next;
+                else             prev->next = next;
+                if(queue->tail == job) queue->tail = prev;
+                job->next = NULL;
+                count--;
+                if(job->pFunctDone != NULL){
+                    job->pFunctDone(job);
+                }
+                job = next;
+                continue;
+            }
+
+            job->client = i;
+            clientBusy |= 1UL << i;
+            nodeBusy[job->nodeId >> 5] |= 1UL << (job->nodeId & 0x1F);
+        }
+        prev = job;
+        job = next;
+    }
+
+    /* inform OS to call this function again without delay */
+    if(clientBusy != 0 && timerNext_ms != NULL){
+        *timerNext_ms = 0;
+    }
+
+    return count;
+}
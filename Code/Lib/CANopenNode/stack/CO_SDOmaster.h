@@ -149,6 +149,15 @@ typedef struct{
     bool_t              CANrxNew;
     /** 8 data bytes of the received message */
     uint8_t             CANrxData[8];
+#if CO_SDO_RX_QUEUE > 0
+    /** Frames received while CANrxNew was set, see #CO_SDO_RX_QUEUE */
+    uint8_t             CANrxQueue[CO_SDO_RX_QUEUE][8];
+    /** Queue write counter, incremented by receive interrupt */
+    volatile uint8_t    CANrxHead;
+    /** Queue read counter, incremented by CO_SDOclientDownload() or
+    CO_SDOclientUpload() */
+    volatile uint8_t    CANrxTail;
+#endif
     /** From CO_SDOclient_initCallback() or NULL */
     void              (*pFunctSignal)(void);
     /** From CO_SDOclient_init() */
@@ -165,6 +174,17 @@ typedef struct{
     /** Maximum number of segments in one block. Set in CO_SDOclient_init(). Can
     be changed by application to 2 .. 127. */
     uint8_t             block_size_max;
+    /** If true, block upload adapts number of segments in block: it grows
+    after each complete sub-block and halves after lost segments, sub-block
+    timeout or CRC error. Set to false in CO_SDOclient_init(). Can be changed
+    by application. */
+    bool_t              block_adaptive;
+    /** Current block size in adaptive mode, kept between transfers */
+    uint8_t             block_size_adaptive;
+    /** Number of sub-blocks with lost segments in current block transfer */
+    uint16_t            block_retries;
+    /** Duration of current or last transfer in milliseconds */
+    uint32_t            transferTime_ms;
     /** Last sector number */
     uint8_t             block_seqno;
     /** Block size in current transfer */
@@ -350,6 +370,21 @@ CO_SDOclient_return_t CO_SDOclientUpload(
         uint32_t               *pSDOabortCode);
 
 
+/**
+ * Get throughput of current or last SDO client transfer.
+ *
+ * Time is accumulated from timeDifference_ms arguments of CO_SDOclientDownload()
+ * and CO_SDOclientUpload() since the transfer was initiated.
+ *
+ * @param SDO_C This object.
+ * @param dataSize Number of bytes transferred, for example *pDataSize from
+ * CO_SDOclientUpload().
+ *
+ * @return Throughput in bytes per second or 0, if time is not known.
+ */
+uint32_t CO_SDOclientThroughput(const CO_SDOclient_t *SDO_C, uint32_t dataSize);
+
+
 /**
  * Close SDO communication temporary.
  *
@@ -359,6 +394,113 @@ CO_SDOclient_return_t CO_SDOclientUpload(
  */
 void CO_SDOclientClose(CO_SDOclient_t *SDO_C);
 
+
+/**
+ * SDO client job, see CO_SDOclientQueue_submit().
+ *
+ * Job is owned by the application and must be valid until pFunctDone() is
+ * called. Members up to pFunctDone are set by application, others by queue.
+ */
+typedef struct CO_SDOclientJob{
+    /** Node-ID of the SDO server, 1..127 */
+    uint8_t             nodeId;
+    /** Index of object in object dictionary in remote node */
+    uint16_t            index;
+    /** Subindex of object in object dictionary in remote node */
+    uint8_t             subIndex;
+    /** True for upload (read from remote node), false for download */
+    bool_t              upload;
+    /** Try to initiate block transfer */
+    bool_t              blockEnable;
+    /** Data to be written or buffer for data to be read, little-endian */
+    uint8_t            *data;
+    /** By download size of data, by upload size of buffer. On completion of
+    upload it contains size of received data. */
+    uint32_t            dataSize;
+    /** Pointer to object, which will be passed to pFunctDone(). Can be NULL */
+    void               *object;
+    /** Called from CO_SDOclientQueue_process() on completion. Can be NULL */
+    void              (*pFunctDone)(struct CO_SDOclientJob *job);
+    /** Result of the transfer, CO_SDOcli_ok_communicationEnd on success */
+    CO_SDOclient_return_t result;
+    /** SDO abort code, if transfer was aborted */
+    uint32_t            abortCode;
+    /** Index of SDO client, which processes the job, 0xFF if waiting */
+    uint8_t             client;
+    /** Next job in the queue */
+    struct CO_SDOclientJob *next;
+}CO_SDOclientJob_t;
+
+
+/**
+ * Queue of SDO client jobs, processed in parallel by multiple SDO clients.
+ */
+typedef struct{
+    /** From CO_SDOclientQueue_init() */
+    CO_SDOclient_t    **SDO_C;
+    /** From CO_SDOclientQueue_init() */
+    uint8_t             noOfClients;
+    /** First job in the queue or NULL */
+    CO_SDOclientJob_t  *head;
+    /** Last job in the queue or NULL */
+    CO_SDOclientJob_t  *tail;
+}CO_SDOclientQueue_t;
+
+
+/**
+ * Initialize SDO client queue.
+ *
+ * Clients given to the queue must not be used by application directly.
+ *
+ * @param queue This object will be initialized.
+ * @param SDO_C Array of SDO client objects, initialized by CO_SDOclient_init().
+ * @param noOfClients Number of SDO clients in array, 1..32.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_SDOclientQueue_init(
+        CO_SDOclientQueue_t    *queue,
+        CO_SDOclient_t         *SDO_C[],
+        uint8_t                 noOfClients);
+
+
+/**
+ * Add job to the end of SDO client queue.
+ *
+ * Function is non-blocking. Jobs are started in order of submission, on the
+ * first free SDO client, but only one job at a time per SDO server node.
+ * Must be called from the same thread as CO_SDOclientQueue_process().
+ *
+ * @param queue This object.
+ * @param job Job, see CO_SDOclientJob_t.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_SDOclientQueue_submit(
+        CO_SDOclientQueue_t    *queue,
+        CO_SDOclientJob_t      *job);
+
+
+/**
+ * Process SDO client queue.
+ *
+ * Function must be called cyclically. It advances all running transfers,
+ * calls pFunctDone() for finished jobs and starts waiting jobs on free clients.
+ *
+ * @param queue This object.
+ * @param timeDifference_ms Time difference from previous function call in [milliseconds].
+ * @param SDOtimeoutTime Timeout time for SDO communication in milliseconds.
+ * @param timerNext_ms Return value - info to OS - see CO_process(). Set to 0,
+ * if there are running transfers.
+ *
+ * @return Number of jobs in the queue, running or waiting.
+ */
+uint16_t CO_SDOclientQueue_process(
+        CO_SDOclientQueue_t    *queue,
+        uint16_t                timeDifference_ms,
+        uint16_t                SDOtimeoutTime,
+        uint16_t               *timerNext_ms);
+
 #ifdef __cplusplus
 }
 #endif /*__cplusplus*/
@@ -57,7 +57,7 @@
  * message with correct identifier will be received. For more information and
  * description of parameters see file CO_driver.h.
  */
-static void CO_SYNC_receive(void *object, const CO_CANrxMsg_t *msg){
+CO_RAMFUNC static void CO_SYNC_receive(void *object, const CO_CANrxMsg_t *msg){
     CO_SYNC_t *SYNC;
     uint8_t operState;
 
@@ -84,6 +84,13 @@ static void CO_SYNC_receive(void *object, const CO_CANrxMsg_t *msg){
         }
         if(SYNC->CANrxNew) {
             SYNC->CANrxToggle = SYNC->CANrxToggle ? false : true;
+#if CO_CAN_TIMESTAMP > 0
+            SYNC->CANrxTimestamp = CO_CANrxMsg_readTimestamp(msg);
+#endif
+
+            if(SYNC->pFunctSignal != NULL) {
+                SYNC->pFunctSignal(SYNC->functSignalObject, SYNC->counter);
+            }
         }
     }
 }
@@ -139,7 +146,7 @@ static CO_SDO_abortCode_t CO_ODF_1005(CO_ODF_arg_t *ODF_arg){
                         SYNC->COB_ID,           /* CAN identifier */
                         0,                      /* rtr */
                         len,                    /* number of data bytes */
-                        0);                     /* synchronous message flag bit */
+                        CO_CAN_TX_FLAG_CRITICAL); /* SYNC may use reserved mailbox */
                 SYNC->isProducer = true;
             }
             else{
@@ -228,7 +235,7 @@ static CO_SDO_abortCode_t CO_ODF_1019(CO_ODF_arg_t *ODF_arg){
                     SYNC->COB_ID,           /* CAN identifier */
                     0,                      /* rtr */
                     len,                    /* number of data bytes */
-                    0);                     /* synchronous message flag bit */
+                    CO_CAN_TX_FLAG_CRITICAL); /* SYNC may use reserved mailbox */
         }
     }
 
@@ -258,6 +265,9 @@ CO_ReturnError_t CO_SYNC_init(
         return CO_ERROR_ILLEGAL_ARGUMENT;
     }
 
+    SYNC->functSignalObject = NULL;
+    SYNC->pFunctSignal = NULL;
+
     /* Configure object variables */
     SYNC->isProducer = (COB_ID_SYNCMessage&0x40000000L) ? true : false;
     SYNC->COB_ID = COB_ID_SYNCMessage&0x7FF;
@@ -277,6 +287,12 @@ CO_ReturnError_t CO_SYNC_init(
     SYNC->timer = 0;
     SYNC->counter = 0;
     SYNC->receiveError = 0U;
+#if CO_SYNC_HW_TIMER > 0
+    SYNC->txOverflow = false;
+#endif
+#if CO_SYNC_WINDOW_TIMER > 0
+    SYNC->windowClosed = false;
+#endif
 
     SYNC->em = em;
     SYNC->operatingState = operatingState;
@@ -308,17 +324,31 @@ CO_ReturnError_t CO_SYNC_init(
             SYNC->COB_ID,           /* CAN identifier */
             0,                      /* rtr */
             len,                    /* number of data bytes */
-            0);                     /* synchronous message flag bit */
+            CO_CAN_TX_FLAG_CRITICAL); /* SYNC may use reserved mailbox */
 
     return CO_ERROR_NO;
 }
 
 
+/******************************************************************************/
+void CO_SYNC_initCallback(
+        CO_SYNC_t              *SYNC,
+        void                   *object,
+        void                  (*pFunctSignal)(void *object, uint8_t counter))
+{
+    if(SYNC != NULL){
+        SYNC->functSignalObject = object;
+        SYNC->pFunctSignal = pFunctSignal;
+    }
+}
+
+
 /******************************************************************************/
 uint8_t CO_SYNC_process(
         CO_SYNC_t              *SYNC,
         uint32_t                timeDifference_us,
-        uint32_t                ObjDict_synchronousWindowLength)
+        uint32_t                ObjDict_synchronousWindowLength,
+        uint32_t               *timerNext_us)
 {
     uint8_t ret = 0;
     uint32_t timerNew;
@@ -335,6 +365,13 @@ uint8_t CO_SYNC_process(
             SYNC->CANrxNew = false;
         }
 
+#if CO_SYNC_HW_TIMER > 0
+        /* SYNC is produced by CO_SYNC_timerIsr() */
+        if(SYNC->txOverflow){
+            SYNC->txOverflow = false;
+            CO_errorReport(SYNC->em, CO_EM_CAN_TX_OVERFLOW, CO_EMC_CAN_OVERRUN, SYNC->COB_ID);
+        }
+#else
         /* SYNC producer */
         if(SYNC->isProducer && SYNC->periodTime){
             if(SYNC->timer >= SYNC->periodTime){
@@ -344,9 +381,27 @@ uint8_t CO_SYNC_process(
                 SYNC->CANrxToggle = SYNC->CANrxToggle ? false : true;
                 SYNC->CANtxBuff->data[0] = SYNC->counter;
                 CO_CANsend(SYNC->CANdevTx, SYNC->CANtxBuff);
+
+                if(SYNC->pFunctSignal != NULL) {
+                    SYNC->pFunctSignal(SYNC->functSignalObject, SYNC->counter);
+                }
             }
         }
-
+#endif
+
+#if CO_SYNC_WINDOW_TIMER > 0
+        /* window is closed by CO_SYNC_windowTimerIsr() */
+        if(SYNC->windowClosed){
+            SYNC->windowClosed = false;
+            if(ret == 0){
+                ret = 2;
+            }
+        }
+        if(ret == 1){
+            SYNC->curentSyncTimeIsInsideWindow = true;
+        }
+        (void)ObjDict_synchronousWindowLength;
+#else
         /* Synchronous PDOs are allowed only inside time window */
         if(ObjDict_synchronousWindowLength){
             if(SYNC->timer > ObjDict_synchronousWindowLength){
@@ -362,10 +417,35 @@ uint8_t CO_SYNC_process(
         else{
             SYNC->curentSyncTimeIsInsideWindow = true;
         }
+#endif
 
         /* Verify timeout of SYNC */
         if(SYNC->periodTime && SYNC->timer > SYNC->periodTimeoutTime && *SYNC->operatingState == CO_NMT_OPERATIONAL)
             CO_errorReport(SYNC->em, CO_EM_SYNC_TIME_OUT, CO_EMC_COMMUNICATION, SYNC->timer);
+
+        /* Calculate, when SYNC timer reaches next event and lower timerNext_us if necessary. */
+        if(timerNext_us != NULL){
+            uint32_t diff = 0xFFFFFFFFUL;
+
+#if CO_SYNC_HW_TIMER == 0
+            if(SYNC->isProducer && SYNC->periodTime && SYNC->timer < SYNC->periodTime){
+                diff = SYNC->periodTime - SYNC->timer;
+            }
+#endif
+#if CO_SYNC_WINDOW_TIMER == 0
+            if(ObjDict_synchronousWindowLength && SYNC->timer <= ObjDict_synchronousWindowLength){
+                uint32_t diffW = ObjDict_synchronousWindowLength - SYNC->timer + 1U;
+                if(diff > diffW) diff = diffW;
+            }
+#endif
+            if(SYNC->periodTime && SYNC->timer <= SYNC->periodTimeoutTime){
+                uint32_t diffT = SYNC->periodTimeoutTime - SYNC->timer + 1U;
+                if(diff > diffT) diff = diffT;
+            }
+            if(*timerNext_us > diff){
+                *timerNext_us = diff;
+            }
+        }
     }
     else {
         SYNC->CANrxNew = false;
@@ -377,5 +457,47 @@ uint8_t CO_SYNC_process(
         SYNC->receiveError = 0U;
     }
 
+    if(ret != 0){
+        CO_ITM_EVENT(CO_ITM_SYNC, ((uint16_t)ret << 8) | SYNC->counter);
+    }
+
     return ret;
 }
+
+
+#if CO_SYNC_HW_TIMER > 0
+/******************************************************************************/
+CO_RAMFUNC uint32_t CO_SYNC_timerIsr(CO_SYNC_t *SYNC){
+    uint8_t operState = *SYNC->operatingState;
+
+    if(!SYNC->isProducer || SYNC->periodTime == 0U ||
+        (operState != CO_NMT_OPERATIONAL && operState != CO_NMT_PRE_OPERATIONAL)){
+        return 1000U;
+    }
+
+    if(++SYNC->counter > SYNC->counterOverflowValue) SYNC->counter = 1;
+    SYNC->CANtxBuff->data[0] = SYNC->counter;
+    if(CO_CANsendReserved(SYNC->CANdevTx, SYNC->CANtxBuff) != CO_ERROR_NO){
+        SYNC->txOverflow = true;
+    }
+
+    /* rest is the same as for received SYNC */
+    SYNC->CANrxToggle = SYNC->CANrxToggle ? false : true;
+    SYNC->CANrxNew = true;
+    if(SYNC->pFunctSignal != NULL) {
+        SYNC->pFunctSignal(SYNC->functSignalObject, SYNC->counter);
+    }
+
+    return SYNC->periodTime;
+}
+#endif
+
+
+#if CO_SYNC_WINDOW_TIMER > 0
+/******************************************************************************/
+void CO_SYNC_windowTimerIsr(CO_SYNC_t *SYNC){
+    SYNC->curentSyncTimeIsInsideWindow = false;
+    CO_CANclearPendingSyncPDOs(SYNC->CANdevTx);
+    SYNC->windowClosed = true;
+}
+#endif
@@ -78,6 +78,19 @@ extern "C" {
  * transmitted, internal variable CANrxToggle toggles. That variable is then
  * used by synchronous RPDO to determine, which of the two buffers is used for
  * RPDO reception and which for RPDO processing.
+ *
+ * ####SYNC producer with hardware timer
+ * With #CO_SYNC_HW_TIMER SYNC is not transmitted from CO_SYNC_process(), which
+ * depends on the period of its caller. CO_SYNC_timerIsr() is called from timer
+ * compare interrupt instead, transmits SYNC into reserved CAN mailbox and
+ * returns the time of the next compare. CO_SYNC_process() then handles the
+ * transmitted SYNC the same way as received one.
+ *
+ * ####SYNC window with hardware timer
+ * With #CO_SYNC_WINDOW_TIMER window is opened by each SYNC and closed by
+ * CO_SYNC_windowTimerIsr(), which aborts pending synchronous TPDOs at once.
+ * CO_SYNC_process() then does not measure the window and returns 2 on its
+ * next call after the window was closed.
  */
 
 
@@ -116,11 +129,27 @@ typedef struct{
     uint32_t            timer;
     /** Set to nonzero value, if SYNC with wrong data length is received from CAN */
     uint16_t            receiveError;
+#if CO_SYNC_HW_TIMER > 0
+    /** Set by CO_SYNC_timerIsr(), if reserved mailbox was still busy */
+    volatile bool_t     txOverflow;
+#endif
+#if CO_SYNC_WINDOW_TIMER > 0
+    /** Set by CO_SYNC_windowTimerIsr(), cleared by CO_SYNC_process() */
+    volatile bool_t     windowClosed;
+#endif
+#if CO_CAN_TIMESTAMP > 0
+    /** Hardware timestamp of the last received SYNC, see CO_CANrxMsg_readTimestamp() */
+    uint16_t            CANrxTimestamp;
+#endif
     CO_CANmodule_t     *CANdevRx;       /**< From CO_SYNC_init() */
     uint16_t            CANdevRxIdx;    /**< From CO_SYNC_init() */
     CO_CANmodule_t     *CANdevTx;       /**< From CO_SYNC_init() */
     CO_CANtx_t         *CANtxBuff;      /**< CAN transmit buffer inside CANdevTx */
     uint16_t            CANdevTxIdx;    /**< From CO_SYNC_init() */
+    /** From CO_SYNC_initCallback() or NULL */
+    void               *functSignalObject;
+    /** From CO_SYNC_initCallback() or NULL */
+    void              (*pFunctSignal)(void *object, uint8_t counter);
 }CO_SYNC_t;
 
 
@@ -157,6 +186,28 @@ CO_ReturnError_t CO_SYNC_init(
         uint16_t                CANdevTxIdx);
 
 
+/**
+ * Initialize SYNC callback function.
+ *
+ * Function initializes optional callback function, which executes at the
+ * SYNC edge: inside CAN receive interrupt, when valid SYNC is received, or
+ * from CO_SYNC_process(), just after SYNC is transmitted by this (producer)
+ * node. Application may take a timestamp, latch inputs and prepare synchronous
+ * TPDOs there. Callback must be short and interrupt safe.
+ *
+ * Function must be called after CO_SYNC_init().
+ *
+ * @param SYNC This object.
+ * @param object Pointer to object, which will be passed to pFunctSignal(). Can be NULL.
+ * @param pFunctSignal Pointer to the callback function. Not called if NULL.
+ *        Second argument is SYNC counter (zero, if counter is not used).
+ */
+void CO_SYNC_initCallback(
+        CO_SYNC_t              *SYNC,
+        void                   *object,
+        void                  (*pFunctSignal)(void *object, uint8_t counter));
+
+
 /**
  * Process SYNC communication.
  *
@@ -166,6 +217,9 @@ CO_ReturnError_t CO_SYNC_init(
  * @param timeDifference_us Time difference from previous function call in [microseconds].
  * @param ObjDict_synchronousWindowLength _Synchronous window length_ variable from
  * Object dictionary (index 0x1007).
+ * @param timerNext_us Return value - info to OS - maximum delay after function
+ *        should be called next time in [microseconds]. Initial value must be
+ *        set by caller, output will be equal or lower. Parameter is ignored if NULL.
  *
  * @return 0: No special meaning.
  * @return 1: New SYNC message recently received or was just transmitted.
@@ -174,7 +228,43 @@ CO_ReturnError_t CO_SYNC_init(
 uint8_t CO_SYNC_process(
         CO_SYNC_t              *SYNC,
         uint32_t                timeDifference_us,
-        uint32_t                ObjDict_synchronousWindowLength);
+        uint32_t                ObjDict_synchronousWindowLength,
+        uint32_t               *timerNext_us);
+
+
+#if CO_SYNC_HW_TIMER > 0
+/**
+ * Transmit SYNC from hardware timer interrupt.
+ *
+ * Function must be called from timer compare interrupt, which is more urgent
+ * than CAN interrupts. If this node is SYNC producer in operational or
+ * pre-operational state, SYNC is written into reserved mailbox with
+ * CO_CANsendReserved() and SYNC callback is called. Busy mailbox is reported
+ * as CO_EM_CAN_TX_OVERFLOW by CO_SYNC_process().
+ *
+ * @param SYNC This object.
+ *
+ * @return Time to the next call in [microseconds]: _Communication cycle
+ * period_ or 1000, if SYNC is not produced. Timer should add it to the compare
+ * register, so the period does not accumulate interrupt latency.
+ */
+uint32_t CO_SYNC_timerIsr(CO_SYNC_t *SYNC);
+#endif
+
+
+#if CO_SYNC_WINDOW_TIMER > 0
+/**
+ * Close synchronous window from hardware timer interrupt.
+ *
+ * Function must be called from timer compare interrupt, which was armed at
+ * the SYNC edge (SYNC callback) with _Synchronous window length_. It aborts
+ * synchronous TPDOs with CO_CANclearPendingSyncPDOs(). Timer interrupt must
+ * not be preempted by CAN interrupts.
+ *
+ * @param SYNC This object.
+ */
+void CO_SYNC_windowTimerIsr(CO_SYNC_t *SYNC);
+#endif
 
 #ifdef __cplusplus
 }
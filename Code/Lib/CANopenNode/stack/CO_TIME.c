@@ -0,0 +1,411 @@
+/*
+ * CANopen TIME object, producer and consumer with disciplined clock.
+ *
+ * @file        CO_TIME.c
+ * @ingroup     CO_TIME
+ *
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * CANopenNode is free and open source software: you can redistribute
+ * it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Following clarification and special exception to the GNU General Public
+ * License is included to the distribution terms of CANopenNode:
+ *
+ * Linking this library statically or dynamically with other modules is
+ * making a combined work based on this library. Thus, the terms and
+ * conditions of the GNU General Public License cover the whole combination.
+ *
+ * As a special exception, the copyright holders of this library give
+ * you permission to link this library with independent modules to
+ * produce an executable, regardless of the license terms of these
+ * independent modules, and to copy and distribute the resulting
+ * executable under terms of your choice, provided that you also meet,
+ * for each linked independent module, the terms and conditions of the
+ * license of that module. An independent module is a module which is
+ * not derived from or based on this library. If you modify this
+ * library, you may extend this exception to your version of the
+ * library, but you are not obliged to do so. If you do not wish
+ * to do so, delete this exception statement from your version.
+ */
+
+
+#include "CO_driver.h"
+#include "CO_SDO.h"
+#include "CO_Emergency.h"
+#include "CO_NMT_Heartbeat.h"
+#include "CO_TIME.h"
+
+
+/* Microseconds per day */
+#define CO_TIME_DAY_US          86400000000ULL
+/* Without SYNC edge for this time, 0x1013 is updated by CO_TIME_process() */
+#define CO_TIME_SYNC_TIMEOUT_MS 1000U
+/* Shorter interval between received times does not correct the rate */
+#define CO_TIME_MIN_INTERVAL_US 10000U
+
+
+/*
+ * Network time at local time, base must not change during the call.
+ */
+static uint64_t CO_TIME_netAt(const CO_TIME_t *TIME, uint32_t localUs){
+    int32_t d = (int32_t)(localUs - TIME->baseLocalUs);
+
+    return TIME->baseNetUs + (uint64_t)((int64_t)d + ((int64_t)d * TIME->rate_ppb) / 1000000000LL);
+}
+
+
+/*
+ * Network time from TIME message, 6 or 8 bytes.
+ */
+static uint64_t CO_TIME_decode(const uint8_t data[], uint8_t DLC, bool_t *syncRef){
+    uint32_t ms = CO_getUint32(&data[0]) & 0x0FFFFFFFUL;
+    uint16_t days = CO_getUint16(&data[4]);
+    uint64_t netUs = (uint64_t)days * CO_TIME_DAY_US + (uint64_t)ms * 1000U;
+
+    *syncRef = false;
+    if(DLC == 8U){
+        uint16_t ext = CO_getUint16(&data[6]);
+        uint16_t us = ext & 0x3FFU;
+
+        netUs += (us < 1000U) ? us : 999U;
+        *syncRef = (ext & CO_TIME_FLAG_SYNC) != 0U;
+    }
+
+    return netUs;
+}
+
+
+/*
+ * Send TIME message with network time.
+ */
+static void CO_TIME_send(CO_TIME_t *TIME, uint64_t netUs, bool_t syncRef){
+    uint8_t *data = TIME->CANtxBuff->data;
+
+    CO_setUint32(&data[0], (uint32_t)((netUs % CO_TIME_DAY_US) / 1000U));
+    CO_setUint16(&data[4], (uint16_t)(netUs / CO_TIME_DAY_US));
+#if CO_TIME_HIGH_RES > 0
+    CO_setUint16(&data[6], (uint16_t)((netUs % 1000U) | (syncRef ? CO_TIME_FLAG_SYNC : 0U)));
+#else
+    (void)syncRef;
+#endif
+
+    CO_CANsend(TIME->CANdevTx, TIME->CANtxBuff);
+}
+
+
+/*
+ * Read received message from CAN module.
+ *
+ * Function will be called (by CAN receive interrupt) every time, when CAN
+ * message with correct identifier will be received. For more information and
+ * description of parameters see file CO_driver.h.
+ */
+static void CO_TIME_receive(void *object, const CO_CANrxMsg_t *msg){
+    CO_TIME_t *TIME = (CO_TIME_t*)object;
+    uint8_t operState = *TIME->operatingState;
+    uint32_t localUs;
+    uint64_t netUs;
+    bool_t syncRef;
+
+    if((operState != CO_NMT_OPERATIONAL && operState != CO_NMT_PRE_OPERATIONAL)
+        || !TIME->isConsumer || TIME->isProducer || TIME->getLocalUs == NULL
+        || (msg->DLC != 6U && msg->DLC != 8U))
+    {
+        return;
+    }
+
+    localUs = TIME->getLocalUs();
+    netUs = CO_TIME_decode(msg->data, msg->DLC, &syncRef);
+    if(syncRef){
+        if(!TIME->syncSeen){
+            /* SYNC was missed, its local time is not known */
+            TIME->ignored++;
+            return;
+        }
+        localUs = TIME->syncLocalUs;
+    }
+
+    TIME->syncSeen = false;
+    TIME->rxNetUs = netUs;
+    TIME->rxLocalUs = localUs;
+    TIME->CANrxNew = true;
+}
+
+
+/*
+ * Configure producer and consumer from _COB ID TIME_.
+ */
+static void CO_TIME_configure(CO_TIME_t *TIME, uint32_t COB_ID_TIME){
+    TIME->isConsumer = (COB_ID_TIME & 0x80000000UL) ? true : false;
+    TIME->isProducer = (COB_ID_TIME & 0x40000000UL) ? true : false;
+    TIME->COB_ID = (uint16_t)(COB_ID_TIME & 0x7FFU);
+    TIME->txTimer_ms = 0U;
+    TIME->txRequest = false;
+    TIME->txLatched = false;
+
+    CO_CANrxBufferInit(
+            TIME->CANdevRx,         /* CAN device */
+            TIME->CANdevRxIdx,      /* rx buffer index */
+            TIME->COB_ID,           /* CAN identifier */
+            0x7FF,                  /* mask */
+            0,                      /* rtr */
+            (void*)TIME,            /* object passed to receive function */
+            CO_TIME_receive);       /* this function will process received message */
+
+    TIME->CANtxBuff = CO_CANtxBufferInit(
+            TIME->CANdevTx,         /* CAN device */
+            TIME->CANdevTxIdx,      /* index of specific buffer inside CAN module */
+            TIME->COB_ID,           /* CAN identifier */
+            0,                      /* rtr */
+            (CO_TIME_HIGH_RES > 0) ? 8U : 6U, /* number of data bytes */
+            0);                     /* synchronous message flag bit */
+}
+
+
+/*
+ * Function for accessing _COB ID TIME_ (index 0x1012) from SDO server.
+ *
+ * For more information see file CO_SDO.h.
+ */
+static CO_SDO_abortCode_t CO_ODF_1012(CO_ODF_arg_t *ODF_arg){
+    CO_TIME_t *TIME = (CO_TIME_t*) ODF_arg->object;
+    uint32_t value = CO_getUint32(ODF_arg->data);
+
+    if(!ODF_arg->reading){
+        /* only 11-bit CAN identifier is supported */
+        if(value & 0x20000000UL){
+            return CO_SDO_AB_INVALID_VALUE;
+        }
+        CO_TIME_configure(TIME, value);
+    }
+
+    return CO_SDO_AB_NONE;
+}
+
+
+/*
+ * Correct the clock with received network time and its local time.
+ */
+static void CO_TIME_discipline(CO_TIME_t *TIME, uint64_t netUs, uint32_t localUs){
+    uint64_t predicted = CO_TIME_netAt(TIME, localUs);
+    int64_t error = (int64_t)(netUs - predicted);
+    uint32_t interval = localUs - TIME->lastSampleUs;
+
+    CO_LOCK_EMCY();
+    if(!TIME->synchronized || error > CO_TIME_STEP_US || error < -CO_TIME_STEP_US){
+        TIME->baseNetUs = netUs;
+        TIME->baseLocalUs = localUs;
+        TIME->synchronized = true;
+        TIME->steps++;
+    }
+    else{
+        int64_t rate = TIME->rate_ppb;
+
+        /* frequency by quarter, phase by half of the error */
+        if(interval >= CO_TIME_MIN_INTERVAL_US){
+            rate += error * 1000000000LL / (int64_t)interval / 4;
+            if(rate > CO_TIME_RATE_MAX_PPB){
+                rate = CO_TIME_RATE_MAX_PPB;
+            }
+            else if(rate < -CO_TIME_RATE_MAX_PPB){
+                rate = -CO_TIME_RATE_MAX_PPB;
+            }
+        }
+        TIME->baseNetUs = predicted + (uint64_t)(error / 2);
+        TIME->baseLocalUs = localUs;
+        TIME->rate_ppb = (int32_t)rate;
+    }
+    CO_UNLOCK_EMCY();
+
+    if(error > INT32_MAX){
+        error = INT32_MAX;
+    }
+    else if(error < INT32_MIN){
+        error = INT32_MIN;
+    }
+    TIME->lastErrorUs = (int32_t)error;
+    TIME->lastSampleUs = localUs;
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_TIME_init(
+        CO_TIME_t              *TIME,
+        CO_SDO_t               *SDO,
+        uint8_t                *operatingState,
+        uint32_t                COB_ID_TIME,
+        uint32_t               *highResTimeStamp,
+        CO_CANmodule_t         *CANdevRx,
+        uint16_t                CANdevRxIdx,
+        CO_CANmodule_t         *CANdevTx,
+        uint16_t                CANdevTxIdx)
+{
+    /* verify arguments */
+    if(TIME==NULL || SDO==NULL || operatingState==NULL || highResTimeStamp==NULL ||
+        CANdevRx==NULL || CANdevTx==NULL){
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    /* clock, base and rate are kept over communication reset */
+    TIME->operatingState = operatingState;
+    TIME->highResTimeStamp = highResTimeStamp;
+    TIME->syncSeen = false;
+    TIME->syncTimer_ms = CO_TIME_SYNC_TIMEOUT_MS;
+    TIME->CANrxNew = false;
+
+    TIME->CANdevRx = CANdevRx;
+    TIME->CANdevRxIdx = CANdevRxIdx;
+    TIME->CANdevTx = CANdevTx;
+    TIME->CANdevTxIdx = CANdevTxIdx;
+
+    CO_TIME_configure(TIME, COB_ID_TIME);
+
+    /* Configure Object dictionary entry at index 0x1012 */
+    CO_OD_configure(SDO, OD_H1012_COBID_TIME, CO_ODF_1012, (void*)TIME, 0, 0);
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+void CO_TIME_initClock(
+        CO_TIME_t              *TIME,
+        uint32_t              (*getLocalUs)(void))
+{
+    if(TIME != NULL){
+        TIME->getLocalUs = getLocalUs;
+    }
+}
+
+
+/******************************************************************************/
+void CO_TIME_set(CO_TIME_t *TIME, uint64_t netUs){
+    uint32_t localUs = (TIME->getLocalUs != NULL) ? TIME->getLocalUs() : 0U;
+
+    CO_LOCK_EMCY();
+    TIME->baseNetUs = netUs;
+    TIME->baseLocalUs = localUs;
+    TIME->rate_ppb = 0;
+    TIME->synchronized = true;
+    CO_UNLOCK_EMCY();
+}
+
+
+/******************************************************************************/
+void CO_TIME_syncEdge(CO_TIME_t *TIME, uint32_t localUs){
+    uint64_t netUs;
+
+    if(TIME == NULL || TIME->getLocalUs == NULL){
+        return;
+    }
+
+    CO_LOCK_EMCY();
+    netUs = CO_TIME_netAt(TIME, localUs);
+    CO_UNLOCK_EMCY();
+
+    TIME->syncLocalUs = localUs;
+    TIME->syncSeen = true;
+    TIME->syncTimer_ms = 0U;
+    *TIME->highResTimeStamp = (uint32_t)netUs;
+
+    if(TIME->txRequest){
+        TIME->txNetUs = netUs;
+        TIME->txLatched = true;
+        TIME->txRequest = false;
+    }
+}
+
+
+/******************************************************************************/
+uint64_t CO_TIME_getUs64(CO_TIME_t *TIME, uint32_t localUs){
+    uint64_t netUs;
+
+    CO_LOCK_EMCY();
+    netUs = CO_TIME_netAt(TIME, localUs);
+    CO_UNLOCK_EMCY();
+
+    return netUs;
+}
+
+
+/******************************************************************************/
+void CO_TIME_process(CO_TIME_t *TIME, uint16_t timeDifference_ms){
+    uint8_t operState = *TIME->operatingState;
+    uint32_t localUs;
+
+    if(TIME->getLocalUs == NULL){
+        return;
+    }
+    localUs = TIME->getLocalUs();
+
+    /* consumer */
+    if(TIME->CANrxNew){
+        uint64_t netUs;
+        uint32_t sampleUs;
+
+        CO_LOCK_EMCY();
+        netUs = TIME->rxNetUs;
+        sampleUs = TIME->rxLocalUs;
+        TIME->CANrxNew = false;
+        CO_UNLOCK_EMCY();
+
+        CO_TIME_discipline(TIME, netUs, sampleUs);
+    }
+
+    /* 0x1013 follows SYNC edges, if present */
+    if(TIME->syncTimer_ms < CO_TIME_SYNC_TIMEOUT_MS){
+        TIME->syncTimer_ms += timeDifference_ms;
+    }
+    else{
+        *TIME->highResTimeStamp = (uint32_t)CO_TIME_getUs64(TIME, localUs);
+    }
+
+    /* producer */
+    if(!TIME->isProducer || (operState != CO_NMT_OPERATIONAL && operState != CO_NMT_PRE_OPERATIONAL)){
+        TIME->txTimer_ms = 0U;
+        TIME->txRequest = false;
+        TIME->txLatched = false;
+        return;
+    }
+
+    if(TIME->txTimer_ms < CO_TIME_PRODUCER_MS){
+        TIME->txTimer_ms += timeDifference_ms;
+    }
+    if(TIME->txLatched){
+        TIME->txLatched = false;
+        CO_TIME_send(TIME, TIME->txNetUs, true);
+    }
+#if CO_TIME_HIGH_RES > 0
+    else if(TIME->txRequest){
+        /* no SYNC within half of the interval, send time of the message */
+        if(TIME->txTimer_ms >= CO_TIME_PRODUCER_MS / 2U){
+            TIME->txRequest = false;
+            CO_TIME_send(TIME, CO_TIME_getUs64(TIME, localUs), false);
+        }
+    }
+    else if(TIME->txTimer_ms >= CO_TIME_PRODUCER_MS){
+        /* time is latched at the next SYNC edge */
+        TIME->txTimer_ms = 0U;
+        TIME->txRequest = true;
+    }
+#else
+    else if(TIME->txTimer_ms >= CO_TIME_PRODUCER_MS){
+        TIME->txTimer_ms = 0U;
+        CO_TIME_send(TIME, CO_TIME_getUs64(TIME, localUs), false);
+    }
+#endif
+}
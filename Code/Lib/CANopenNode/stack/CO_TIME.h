@@ -0,0 +1,256 @@
+/**
+ * CANopen TIME object, producer and consumer with disciplined clock.
+ *
+ * @file        CO_TIME.h
+ * @ingroup     CO_TIME
+ *
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * CANopenNode is free and open source software: you can redistribute
+ * it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Following clarification and special exception to the GNU General Public
+ * License is included to the distribution terms of CANopenNode:
+ *
+ * Linking this library statically or dynamically with other modules is
+ * making a combined work based on this library. Thus, the terms and
+ * conditions of the GNU General Public License cover the whole combination.
+ *
+ * As a special exception, the copyright holders of this library give
+ * you permission to link this library with independent modules to
+ * produce an executable, regardless of the license terms of these
+ * independent modules, and to copy and distribute the resulting
+ * executable under terms of your choice, provided that you also meet,
+ * for each linked independent module, the terms and conditions of the
+ * license of that module. An independent module is a module which is
+ * not derived from or based on this library. If you modify this
+ * library, you may extend this exception to your version of the
+ * library, but you are not obliged to do so. If you do not wish
+ * to do so, delete this exception statement from your version.
+ */
+
+
+#ifndef CO_TIME_H
+#define CO_TIME_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_TIME TIME
+ * @ingroup CO_CANopen
+ * @{
+ *
+ * CANopen TIME object with network clock in microseconds.
+ *
+ * Network time is microseconds since 1984-01-01, the epoch of TIME_OF_DAY. It
+ * is derived from the local microsecond clock of the application (for example
+ * TIM or DWT based), see CO_TIME_initClock():
+ *
+ * net = baseNet + d + d * rate / 10^9, where d = local - baseLocal
+ *
+ * TIME message contains TIME_OF_DAY in bytes 0 to 5: milliseconds after
+ * midnight (28 bits) and days since 1984-01-01. With #CO_TIME_HIGH_RES
+ * producer sends 8 bytes, bytes 6 and 7 contain UNSIGNED16 with microseconds
+ * of the millisecond (bits 0 to 9) and flag #CO_TIME_FLAG_SYNC. If the flag
+ * is set, time is of the last SYNC, else of the TIME message itself.
+ *
+ * Producer (bit 30 of 0x1012) keeps rate 0 and base from CO_TIME_set(). Every
+ * #CO_TIME_PRODUCER_MS it latches network time at the next SYNC edge and
+ * sends it with the flag. If no SYNC comes within half of the interval, it
+ * sends its current time without the flag.
+ *
+ * Consumer (bit 31 of 0x1012) takes local time of the SYNC edge or of the
+ * reception for each TIME message and compares it with its network time.
+ * Error above #CO_TIME_STEP_US sets the base (step), smaller error is
+ * corrected by half and rate by quarter of the error over the time since the
+ * previous message. Rate is limited to +-#CO_TIME_RATE_MAX_PPB. SYNC edges are
+ * passed with CO_TIME_syncEdge() from the SYNC callback of the application,
+ * because timing of the SYNC receive interrupt is known there. Time
+ * referenced to SYNC does not depend on transmit queue delays of the
+ * producer, it must be sent before the next SYNC.
+ *
+ * Variable at 0x1013 (high resolution time stamp) contains low 32 bits of
+ * network time of the last SYNC, so it can be mapped to synchronous TPDOs.
+ * Without SYNC it is updated by CO_TIME_process().
+ *
+ * Network time may step or move backwards by the correction.
+ */
+
+
+/** Flag in bytes 6 and 7 of TIME: time is of the last SYNC */
+#define CO_TIME_FLAG_SYNC       0x8000U
+
+/** Error of received time, which sets the clock instead of correcting it */
+#ifndef CO_TIME_STEP_US
+#define CO_TIME_STEP_US         1000
+#endif
+
+/** Limit of rate correction in parts per billion (500 ppm) */
+#define CO_TIME_RATE_MAX_PPB    500000L
+
+
+/**
+ * TIME producer and consumer object.
+ */
+typedef struct{
+    uint8_t            *operatingState; /**< From CO_TIME_init() */
+    uint32_t           *highResTimeStamp;/**< From CO_TIME_init(), 0x1013 */
+    /** From CO_TIME_initClock() or NULL, TIME is inactive without clock */
+    uint32_t          (*getLocalUs)(void);
+    bool_t              isConsumer;     /**< From 0x1012, bit 31 */
+    bool_t              isProducer;     /**< From 0x1012, bit 30 */
+    uint16_t            COB_ID;         /**< From 0x1012, bits 0..10 */
+    /** Network time at baseLocalUs in microseconds since 1984-01-01 */
+    uint64_t            baseNetUs;
+    uint32_t            baseLocalUs;    /**< Local time of baseNetUs */
+    int32_t             rate_ppb;       /**< Rate correction of local clock */
+    /** True after the first TIME message (consumer) or CO_TIME_set() */
+    bool_t              synchronized;
+    int32_t             lastErrorUs;    /**< Error of the last received time */
+    uint32_t            steps;          /**< Number of clock steps */
+    uint32_t            ignored;        /**< TIME messages with SYNC flag, but no SYNC */
+    uint32_t            lastSampleUs;   /**< Local time of the previous received time */
+    volatile uint32_t   syncLocalUs;    /**< Local time of the last SYNC edge */
+    volatile bool_t     syncSeen;       /**< SYNC edge since the last TIME message */
+    uint16_t            syncTimer_ms;   /**< Time since the last SYNC edge */
+    volatile bool_t     CANrxNew;       /**< Received time is not processed yet */
+    uint64_t            rxNetUs;        /**< Received network time */
+    uint32_t            rxLocalUs;      /**< Local time of rxNetUs */
+    uint16_t            txTimer_ms;     /**< Producer interval timer */
+    volatile bool_t     txRequest;      /**< Producer waits for SYNC edge */
+    volatile bool_t     txLatched;      /**< txNetUs is latched at SYNC edge */
+    uint64_t            txNetUs;        /**< Network time of the SYNC edge */
+    CO_CANmodule_t     *CANdevRx;       /**< From CO_TIME_init() */
+    uint16_t            CANdevRxIdx;    /**< From CO_TIME_init() */
+    CO_CANmodule_t     *CANdevTx;       /**< From CO_TIME_init() */
+    uint16_t            CANdevTxIdx;    /**< From CO_TIME_init() */
+    CO_CANtx_t         *CANtxBuff;      /**< CAN transmit buffer */
+}CO_TIME_t;
+
+
+/**
+ * Initialize TIME object.
+ *
+ * Function must be called in the communication reset section. Clock is kept
+ * (network time continues), producer and consumer are configured from 0x1012.
+ *
+ * @param TIME This object will be initialized.
+ * @param SDO SDO server object.
+ * @param operatingState Pointer to variable indicating CANopen device NMT internal state.
+ * @param COB_ID_TIME Value of _COB ID TIME_ from Object dictionary (index 0x1012).
+ * @param highResTimeStamp Pointer to _High resolution time stamp_ (index 0x1013).
+ * @param CANdevRx CAN device for TIME reception.
+ * @param CANdevRxIdx Index of receive buffer in the above CAN device.
+ * @param CANdevTx CAN device for TIME transmission.
+ * @param CANdevTxIdx Index of transmit buffer in the above CAN device.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_TIME_init(
+        CO_TIME_t              *TIME,
+        CO_SDO_t               *SDO,
+        uint8_t                *operatingState,
+        uint32_t                COB_ID_TIME,
+        uint32_t               *highResTimeStamp,
+        CO_CANmodule_t         *CANdevRx,
+        uint16_t                CANdevRxIdx,
+        CO_CANmodule_t         *CANdevTx,
+        uint16_t                CANdevTxIdx);
+
+
+/**
+ * Initialize local clock of TIME object.
+ *
+ * @param TIME This object.
+ * @param getLocalUs Pointer to function, which returns free running local
+ * time in microseconds. It is called from CAN receive interrupt and
+ * CO_TIME_process(), so it must be reentrant. NULL disables TIME.
+ */
+void CO_TIME_initClock(
+        CO_TIME_t              *TIME,
+        uint32_t              (*getLocalUs)(void));
+
+
+/**
+ * Set network time, for producer.
+ *
+ * @param TIME This object.
+ * @param netUs Network time in microseconds since 1984-01-01.
+ */
+void CO_TIME_set(CO_TIME_t *TIME, uint64_t netUs);
+
+
+/**
+ * Pass SYNC edge to TIME object.
+ *
+ * Function is called from SYNC callback (see CO_SYNC_initCallback()) in CAN
+ * receive interrupt or by SYNC producer. Consumer takes _localUs_ as local
+ * time of the next TIME message with #CO_TIME_FLAG_SYNC, producer latches its
+ * network time. 0x1013 is set to network time of the edge.
+ *
+ * @param TIME This object.
+ * @param localUs Local time of the SYNC edge from the same clock as
+ * getLocalUs().
+ */
+void CO_TIME_syncEdge(CO_TIME_t *TIME, uint32_t localUs);
+
+
+/**
+ * Get network time in microseconds.
+ *
+ * Function may be called from any context. Before synchronization network
+ * time is the local time.
+ *
+ * @param TIME This object.
+ * @param localUs Local time from the same clock as getLocalUs().
+ *
+ * @return Network time in microseconds since 1984-01-01.
+ */
+uint64_t CO_TIME_getUs64(CO_TIME_t *TIME, uint32_t localUs);
+
+
+/**
+ * Get low 32 bits of network time, for example for CO_trace_process().
+ *
+ * @param TIME This object.
+ * @param localUs Local time from the same clock as getLocalUs().
+ *
+ * @return Network time in microseconds, wraps after 71 minutes.
+ */
+static inline uint32_t CO_TIME_getUs(CO_TIME_t *TIME, uint32_t localUs){
+    return (uint32_t)CO_TIME_getUs64(TIME, localUs);
+}
+
+
+/**
+ * Process TIME object.
+ *
+ * Function is called from CO_process(). It disciplines the clock with the
+ * received time and sends TIME message, if producer.
+ *
+ * @param TIME This object.
+ * @param timeDifference_ms Time difference from previous function call in [milliseconds].
+ */
+void CO_TIME_process(CO_TIME_t *TIME, uint16_t timeDifference_ms);
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+/** @} */
+#endif
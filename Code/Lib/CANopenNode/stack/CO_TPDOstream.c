@@ -0,0 +1,194 @@
+/*
+ * CANopen streaming TPDO group.
+ *
+ * @file        CO_TPDOstream.c
+ * @ingroup     CO_TPDOstream
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * CANopenNode is free and open source software: you can redistribute
+ * it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Following clarification and special exception to the GNU General Public
+ * License is included to the distribution terms of CANopenNode:
+ *
+ * Linking this library statically or dynamically with other modules is
+ * making a combined work based on this library. Thus, the terms and
+ * conditions of the GNU General Public License cover the whole combination.
+ *
+ * As a special exception, the copyright holders of this library give
+ * you permission to link this library with independent modules to
+ * produce an executable, regardless of the license terms of these
+ * independent modules, and to copy and distribute the resulting
+ * executable under terms of your choice, provided that you also meet,
+ * for each linked independent module, the terms and conditions of the
+ * license of that module. An independent module is a module which is
+ * not derived from or based on this library. If you modify this
+ * library, you may extend this exception to your version of the
+ * library, but you are not obliged to do so. If you do not wish
+ * to do so, delete this exception statement from your version.
+ */
+
+
+#include "CO_TPDOstream.h"
+#include <string.h>
+
+#if CO_TPDO_STREAM > 0
+
+/*
+ * Fill free TPDOs of the group from ring buffer and send them, starting with
+ * the TPDO after the last filled one. Called from CAN transmit interrupt and
+ * from producer, with CO_LOCK_CAN_SEND() held, so it is the only reader of
+ * ring buffer.
+ */
+CO_RAMFUNC static void CO_TPDOstream_fill(void *object){
+    CO_TPDOstream_t *stream = (CO_TPDOstream_t*)object;
+    uint8_t i;
+
+    for(i = 0U; i < stream->TPDOcount; i++){
+        CO_TPDO_t *TPDO = stream->TPDO[stream->next];
+        CO_CANtx_t *buffer = TPDO->CANtxBuff;
+        uint8_t samples;
+        uint8_t s;
+        uint8_t *data;
+
+        if(!TPDO->valid || *TPDO->operatingState != CO_NMT_OPERATIONAL ||
+           TPDO->dataLength <= stream->sampleSize)
+        {
+            /* TPDO can not carry samples, try the next one */
+            if(++stream->next >= stream->TPDOcount) stream->next = 0U;
+            continue;
+        }
+        if(buffer->bufferFull){
+            /* still waiting for mailbox, consumer reorders by sequence counter */
+            if(++stream->next >= stream->TPDOcount) stream->next = 0U;
+            continue;
+        }
+
+        samples = (uint8_t)((TPDO->dataLength - 1U) / stream->sampleSize);
+        if((uint16_t)(stream->head - stream->tail) < samples){
+            break;
+        }
+
+        data = &buffer->data[0];
+        *data++ = stream->sequence++;
+        for(s = 0U; s < samples; s++){
+            memcpy(data, &stream->ring[(stream->tail & (stream->ringSize - 1U)) * stream->sampleSize],
+                   stream->sampleSize);
+            data += stream->sampleSize;
+            stream->tail++;
+        }
+        /* unused bytes after the last whole sample */
+        memset(data, 0, (size_t)(&buffer->data[TPDO->dataLength] - data));
+
+        CO_CANsend(stream->CANdevTx, buffer);
+        stream->frames++;
+        if(++stream->next >= stream->TPDOcount) stream->next = 0U;
+    }
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_TPDOstream_init(
+        CO_TPDOstream_t        *stream,
+        CO_CANmodule_t         *CANdevTx,
+        CO_TPDO_t             **TPDO,
+        uint8_t                 TPDOcount,
+        uint8_t                 sampleSize,
+        uint8_t                *ring,
+        uint16_t                ringSize)
+{
+    uint8_t i;
+
+    /* verify arguments */
+    if(stream==NULL || CANdevTx==NULL || TPDO==NULL || TPDOcount==0U ||
+       sampleSize==0U || sampleSize>7U || ring==NULL ||
+       ringSize==0U || (ringSize & (ringSize - 1U))!=0U)
+    {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+    for(i = 0U; i < TPDOcount; i++){
+        if(TPDO[i] == NULL || TPDO[i]->CANdevTx != CANdevTx){
+            return CO_ERROR_ILLEGAL_ARGUMENT;
+        }
+    }
+
+    stream->TPDO = TPDO;
+    stream->TPDOcount = TPDOcount;
+    stream->sampleSize = sampleSize;
+    stream->ring = ring;
+    stream->ringSize = ringSize;
+    stream->head = 0U;
+    stream->tail = 0U;
+    stream->sequence = 0U;
+    stream->next = 0U;
+    stream->frames = 0U;
+    stream->overruns = 0U;
+    stream->CANdevTx = CANdevTx;
+
+    for(i = 0U; i < TPDOcount; i++){
+        TPDO[i]->stream = true;
+        TPDO[i]->sendRequest = 0U;
+    }
+    CO_CANmodule_initTxCallback(CANdevTx, (void*)stream, CO_TPDOstream_fill);
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+bool_t CO_TPDOstream_write(CO_TPDOstream_t *stream, const void *sample){
+    uint16_t head = stream->head;
+
+    if((uint16_t)(head - stream->tail) >= stream->ringSize){
+        stream->overruns++;
+        return false;
+    }
+
+    memcpy(&stream->ring[(head & (stream->ringSize - 1U)) * stream->sampleSize],
+           sample, stream->sampleSize);
+    stream->head = (uint16_t)(head + 1U);
+
+    /* start transmission, if the group is idle */
+    CO_LOCK_CAN_SEND();
+    CO_TPDOstream_fill((void*)stream);
+    CO_UNLOCK_CAN_SEND();
+
+    return true;
+}
+
+
+/******************************************************************************/
+uint16_t CO_TPDOstream_level(const CO_TPDOstream_t *stream){
+    return (uint16_t)(stream->head - stream->tail);
+}
+
+
+/******************************************************************************/
+void CO_TPDOstream_stop(CO_TPDOstream_t *stream){
+    uint8_t i;
+
+    CO_CANmodule_initTxCallback(stream->CANdevTx, NULL, NULL);
+
+    CO_LOCK_CAN_SEND();
+    stream->tail = stream->head;
+    CO_UNLOCK_CAN_SEND();
+
+    for(i = 0U; i < stream->TPDOcount; i++){
+        stream->TPDO[i]->stream = false;
+    }
+}
+
+#endif /* CO_TPDO_STREAM > 0 */
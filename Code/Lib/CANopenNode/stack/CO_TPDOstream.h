@@ -0,0 +1,188 @@
+/**
+ * CANopen streaming TPDO group.
+ *
+ * @file        CO_TPDOstream.h
+ * @ingroup     CO_TPDOstream
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * CANopenNode is free and open source software: you can redistribute
+ * it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Following clarification and special exception to the GNU General Public
+ * License is included to the distribution terms of CANopenNode:
+ *
+ * Linking this library statically or dynamically with other modules is
+ * making a combined work based on this library. Thus, the terms and
+ * conditions of the GNU General Public License cover the whole combination.
+ *
+ * As a special exception, the copyright holders of this library give
+ * you permission to link this library with independent modules to
+ * produce an executable, regardless of the license terms of these
+ * independent modules, and to copy and distribute the resulting
+ * executable under terms of your choice, provided that you also meet,
+ * for each linked independent module, the terms and conditions of the
+ * license of that module. An independent module is a module which is
+ * not derived from or based on this library. If you modify this
+ * library, you may extend this exception to your version of the
+ * library, but you are not obliged to do so. If you do not wish
+ * to do so, delete this exception statement from your version.
+ */
+
+
+#ifndef CO_TPDO_STREAM_H
+#define CO_TPDO_STREAM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "CO_driver.h"
+#include "CO_SDO.h"
+#include "CO_Emergency.h"
+#include "CO_NMT_Heartbeat.h"
+#include "CO_SYNC.h"
+#include "CO_PDO.h"
+
+#if CO_TPDO_STREAM > 0
+
+#if CO_CAN_TX_CALLBACK == 0
+#error CO_TPDO_STREAM requires CO_CAN_TX_CALLBACK
+#endif
+
+/**
+ * @defgroup CO_TPDOstream TPDO stream
+ * @ingroup CO_CANopen
+ * @{
+ *
+ * Streaming of high-rate samples through a group of TPDOs.
+ *
+ * Regular TPDO is sent from CO_process_TPDO(), at most once per call, and
+ * carries one set of Object Dictionary values. Stream takes samples from a
+ * ring buffer, filled by the producer (ADC interrupt, DMA complete callback)
+ * with CO_TPDOstream_write(). Each TPDO of the group has own CAN transmit
+ * buffer, so up to _TPDOcount_ frames wait for a mailbox at the same time. When
+ * a mailbox gets free, CAN transmit interrupt refills the group from the ring
+ * buffer, so frames go out back-to-back at bus speed without a cycle of the
+ * mainline or timer thread.
+ *
+ * Frame layout: byte 0 is sequence counter, incremented by one for each frame
+ * of the stream, followed by as many whole samples, as fit into the PDO data
+ * length (mapping of the TPDO). Mapping describes the layout for the consumer,
+ * for example 0x2110 u8 counter and 0x2111 array of samples, data is taken
+ * from the ring buffer and not from the Object Dictionary. bxCAN transmits the
+ * waiting frame with the lowest identifier first, consumer restores order of
+ * the group frames by sequence counter and detects lost frames.
+ *
+ * TPDOs of the group should use transmission type 254 or 255 with event timer
+ * 0, CO_process_TPDO() does not send them while they belong to the stream.
+ * Stream sends only in NMT operational state and only valid TPDOs. Stream is
+ * initialized in communication reset section after CO_init(), as CO_init()
+ * reinitializes TPDOs and CAN module.
+ */
+
+
+/**
+ * TPDO stream object.
+ */
+typedef struct{
+    CO_TPDO_t         **TPDO;           /**< From CO_TPDOstream_init() */
+    uint8_t             TPDOcount;      /**< From CO_TPDOstream_init() */
+    uint8_t             sampleSize;     /**< From CO_TPDOstream_init() */
+    uint8_t            *ring;           /**< From CO_TPDOstream_init() */
+    uint16_t            ringSize;       /**< From CO_TPDOstream_init(), number of samples */
+    /** Number of samples written, index modulo ringSize. Written by producer only */
+    volatile uint16_t   head;
+    /** Number of samples sent, index modulo ringSize. Written by CAN transmit path only */
+    volatile uint16_t   tail;
+    uint8_t             sequence;       /**< Sequence counter of the next frame */
+    uint8_t             next;           /**< Next TPDO of the group to be filled */
+    uint32_t            frames;         /**< Frames passed to CO_CANsend(), wraps around */
+    uint32_t            overruns;       /**< Samples dropped because ring buffer was full */
+    CO_CANmodule_t     *CANdevTx;       /**< From CO_TPDOstream_init() */
+}CO_TPDOstream_t;
+
+
+/**
+ * Initialize TPDO stream object.
+ *
+ * Function must be called in the communication reset section, after
+ * CO_init(). It marks the TPDOs as streamed and registers CAN transmit
+ * callback of _CANdevTx_ (one stream per CAN module).
+ *
+ * @param stream This object will be initialized.
+ * @param CANdevTx CAN device of the TPDOs.
+ * @param TPDO Array of TPDOs in the group, for example &CO->TPDO[CO_NO_TPDO - 4].
+ * @param TPDOcount Number of TPDOs in the group, 1 or more.
+ * @param sampleSize Size of one sample in bytes, 1..7.
+ * @param ring Ring buffer, ringSize * sampleSize bytes.
+ * @param ringSize Number of samples in ring buffer, power of two.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_TPDOstream_init(
+        CO_TPDOstream_t        *stream,
+        CO_CANmodule_t         *CANdevTx,
+        CO_TPDO_t             **TPDO,
+        uint8_t                 TPDOcount,
+        uint8_t                 sampleSize,
+        uint8_t                *ring,
+        uint16_t                ringSize);
+
+
+/**
+ * Write one sample into the stream.
+ *
+ * Function may be called from one producer context only (interrupt included).
+ * It copies the sample into ring buffer and starts transmission, if a TPDO of
+ * the group is free.
+ *
+ * @param stream This object.
+ * @param sample Pointer to _sampleSize_ bytes.
+ *
+ * @return true, if sample was accepted, false if ring buffer is full
+ * (counted in _overruns_).
+ */
+bool_t CO_TPDOstream_write(CO_TPDOstream_t *stream, const void *sample);
+
+
+/**
+ * Number of samples waiting in the ring buffer.
+ *
+ * @param stream This object.
+ *
+ * @return Samples written and not sent yet.
+ */
+uint16_t CO_TPDOstream_level(const CO_TPDOstream_t *stream);
+
+
+/**
+ * Release TPDOs of the stream.
+ *
+ * TPDOs are again processed by CO_process_TPDO(), samples in the ring buffer
+ * are discarded and CAN transmit callback is cleared.
+ *
+ * @param stream This object.
+ */
+void CO_TPDOstream_stop(CO_TPDOstream_t *stream);
+
+/** @} */
+#endif /* CO_TPDO_STREAM > 0 */
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif
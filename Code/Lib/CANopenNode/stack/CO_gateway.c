@@ -0,0 +1,750 @@
+/*
+ * CANopen ASCII and binary gateway, CiA 309-3 subset.
+ *
+ * @file        CO_gateway.c
+ * @ingroup     CO_gateway
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * CANopenNode is free and open source software: you can redistribute
+ * it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Following clarification and special exception to the GNU General Public
+ * License is included to the distribution terms of CANopenNode:
+ *
+ * Linking this library statically or dynamically with other modules is
+ * making a combined work based on this library. Thus, the terms and
+ * conditions of the GNU General Public License cover the whole combination.
+ *
+ * As a special exception, the copyright holders of this library give
+ * you permission to link this library with independent modules to
+ * produce an executable, regardless of the license terms of these
+ * independent modules, and to copy and distribute the resulting
+ * executable under terms of your choice, provided that you also meet,
+ * for each linked independent module, the terms and conditions of the
+ * license of that module. An independent module is a module which is
+ * not derived from or based on this library. If you modify this
+ * library, you may extend this exception to your version of the
+ * library, but you are not obliged to do so. If you do not wish
+ * to do so, delete this exception statement from your version.
+ */
+
+
+#include "CANopen.h"
+
+#if CO_GATEWAY > 0
+
+#if CO_NO_SDO_CLIENT != 1
+#error CO_GATEWAY requires SDO client, set CO_NO_SDO_CLIENT to 1 in CO_OD.h
+#endif
+
+#include "CO_gateway.h"
+#include "crc16-ccitt.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Maximum number of tokens in ASCII command */
+#define CO_GW_TOKENS        10U
+/* Bytes of binary frame without payload: STX, length, sequence, command, CRC */
+#define CO_GW_BIN_OVERHEAD  6U
+/* Bytes of binary response before data: abort code */
+#define CO_GW_BIN_ABORT     4U
+
+/* Kind of ASCII datatype */
+#define CO_GW_SIGNED        0U
+#define CO_GW_UNSIGNED      1U
+#define CO_GW_HEX           2U
+#define CO_GW_STRING        3U
+#define CO_GW_OCTETS        4U
+
+typedef struct{
+    const char         *name;
+    uint8_t             length;     /* 0 for variable length */
+    uint8_t             kind;
+}CO_GW_datatype_t;
+
+/* Index in this table + 1 is CO_gateway_t::datatype */
+static const CO_GW_datatype_t CO_GW_datatypes[] = {
+    {"b",   1U, CO_GW_UNSIGNED},
+    {"i8",  1U, CO_GW_SIGNED},
+    {"i16", 2U, CO_GW_SIGNED},
+    {"i32", 4U, CO_GW_SIGNED},
+    {"i64", 8U, CO_GW_SIGNED},
+    {"u8",  1U, CO_GW_UNSIGNED},
+    {"u16", 2U, CO_GW_UNSIGNED},
+    {"u32", 4U, CO_GW_UNSIGNED},
+    {"u64", 8U, CO_GW_UNSIGNED},
+    {"x8",  1U, CO_GW_HEX},
+    {"x16", 2U, CO_GW_HEX},
+    {"x32", 4U, CO_GW_HEX},
+    {"x64", 8U, CO_GW_HEX},
+    {"vs",  0U, CO_GW_STRING},
+    {"os",  0U, CO_GW_OCTETS},
+    {"d",   0U, CO_GW_OCTETS}
+};
+#define CO_GW_DATATYPES     (sizeof(CO_GW_datatypes) / sizeof(CO_GW_datatypes[0]))
+
+static const char CO_GW_hexDigits[] = "0123456789ABCDEF";
+
+
+/*
+ * Output of the response, buffered in gw->tx.
+ */
+static void CO_GW_flush(CO_gateway_t *gw){
+    if(gw->txLength != 0U){
+        gw->pFunctWrite(gw->object, gw->tx, gw->txLength);
+        gw->txLength = 0U;
+    }
+}
+
+static void CO_GW_out(CO_gateway_t *gw, const uint8_t *data, uint16_t length){
+    while(length > 0U){
+        uint16_t n = (uint16_t)sizeof(gw->tx) - gw->txLength;
+
+        if(n > length){
+            n = length;
+        }
+        memcpy(&gw->tx[gw->txLength], data, n);
+        gw->txLength += n;
+        data += n;
+        length -= n;
+        if(gw->txLength == sizeof(gw->tx)){
+            CO_GW_flush(gw);
+        }
+    }
+}
+
+static void CO_GW_outStr(CO_gateway_t *gw, const char *str){
+    CO_GW_out(gw, (const uint8_t*)str, (uint16_t)strlen(str));
+}
+
+/* Decimal, or hexadecimal with 0x prefix and _digits_ digits */
+static void CO_GW_outNumber(CO_gateway_t *gw, uint64_t value, uint8_t hexDigits){
+    char buf[22];
+    uint8_t i = sizeof(buf);
+
+    if(hexDigits > 0U){
+        while(hexDigits-- > 0U){
+            buf[--i] = CO_GW_hexDigits[value & 0x0FU];
+            value >>= 4;
+        }
+        buf[--i] = 'x';
+        buf[--i] = '0';
+    }
+    else{
+        do{
+            buf[--i] = (char)('0' + (value % 10U));
+            value /= 10U;
+        }while(value != 0U);
+    }
+    CO_GW_out(gw, (const uint8_t*)&buf[i], (uint16_t)(sizeof(buf) - i));
+}
+
+/* Sequence number of ASCII response */
+static void CO_GW_outSeq(CO_gateway_t *gw){
+    if(gw->seqValid){
+        CO_GW_outStr(gw, "[");
+        CO_GW_outNumber(gw, gw->seq, 0U);
+        CO_GW_outStr(gw, "] ");
+    }
+}
+
+static void CO_GW_outEnd(CO_gateway_t *gw){
+    CO_GW_outStr(gw, "\r\n");
+    CO_GW_flush(gw);
+}
+
+
+/*
+ * Binary response with SDO abort code or gateway error and data.
+ */
+static void CO_GW_binResponse(CO_gateway_t *gw, uint32_t code, const uint8_t *data, uint16_t length){
+    uint8_t head[4 + CO_GW_BIN_ABORT];
+    uint16_t crc;
+    uint8_t i;
+
+    head[0] = CO_GATEWAY_STX;
+    head[1] = (uint8_t)(2U + CO_GW_BIN_ABORT + length);
+    head[2] = (uint8_t)gw->seq;
+    head[3] = gw->binCommand | CO_GATEWAY_BIN_RESPONSE;
+    for(i = 0U; i < CO_GW_BIN_ABORT; i++){
+        head[4U + i] = (uint8_t)(code >> (8U * i));
+    }
+    crc = crc16_ccitt(&head[1], sizeof(head) - 1U, 0U);
+    crc = crc16_ccitt(data, length, crc);
+
+    CO_GW_out(gw, head, sizeof(head));
+    CO_GW_out(gw, data, length);
+    head[0] = (uint8_t)crc;
+    head[1] = (uint8_t)(crc >> 8);
+    CO_GW_out(gw, head, 2U);
+    CO_GW_flush(gw);
+}
+
+
+/*
+ * Response without data: OK, gateway error or SDO abort code.
+ */
+static void CO_GW_response(CO_gateway_t *gw, uint32_t code, bool_t abort){
+    if(gw->binary){
+        CO_GW_binResponse(gw, code, NULL, 0U);
+        return;
+    }
+
+    CO_GW_outSeq(gw);
+    if(code == 0U){
+        CO_GW_outStr(gw, "OK");
+    }
+    else{
+        CO_GW_outStr(gw, "ERROR:");
+        CO_GW_outNumber(gw, code, abort ? 8U : 0U);
+    }
+    CO_GW_outEnd(gw);
+}
+
+
+/*
+ * Value of ASCII read in format of gw->datatype.
+ */
+static void CO_GW_outValue(CO_gateway_t *gw, const uint8_t *data, uint32_t length){
+    const CO_GW_datatype_t *type = &CO_GW_datatypes[gw->datatype - 1U];
+    uint64_t value = 0U;
+    uint32_t i;
+
+    if(type->kind == CO_GW_STRING){
+        CO_GW_out(gw, data, (uint16_t)length);
+        return;
+    }
+    if(type->kind == CO_GW_OCTETS){
+        for(i = 0U; i < length; i++){
+            uint8_t hex[2];
+
+            hex[0] = (uint8_t)CO_GW_hexDigits[data[i] >> 4];
+            hex[1] = (uint8_t)CO_GW_hexDigits[data[i] & 0x0FU];
+            CO_GW_out(gw, hex, 2U);
+        }
+        return;
+    }
+
+    for(i = length; i > 0U; i--){
+        value = (value << 8) | data[i - 1U];
+    }
+    if(type->kind == CO_GW_HEX){
+        CO_GW_outNumber(gw, value, (uint8_t)(length * 2U));
+    }
+    else if(type->kind == CO_GW_SIGNED && (data[length - 1U] & 0x80U) != 0U){
+        /* sign extend and print magnitude */
+        if(length < 8U){
+            value |= ~(uint64_t)0U << (8U * length);
+        }
+        CO_GW_outStr(gw, "-");
+        CO_GW_outNumber(gw, (uint64_t)0U - value, 0U);
+    }
+    else{
+        CO_GW_outNumber(gw, value, 0U);
+    }
+}
+
+
+/*
+ * End of SDO client job, called from CO_SDOclientQueue_process().
+ */
+static void CO_GW_jobDone(CO_SDOclientJob_t *job){
+    CO_gateway_t *gw = (CO_gateway_t*)job->object;
+    uint32_t abortCode = 0U;
+
+    if(job->result != CO_SDOcli_ok_communicationEnd){
+        abortCode = (job->abortCode != 0U) ? job->abortCode : (uint32_t)CO_SDO_AB_GENERAL;
+    }
+    else if(job->upload && gw->datatype != 0U){
+        uint8_t length = CO_GW_datatypes[gw->datatype - 1U].length;
+
+        if(length != 0U && job->dataSize != length){
+            abortCode = (uint32_t)CO_SDO_AB_TYPE_MISMATCH;
+        }
+    }
+    else{
+        ;/* nothing to verify */
+    }
+
+    if(abortCode != 0U || !job->upload){
+        CO_GW_response(gw, abortCode, true);
+    }
+    else if(gw->binary){
+        CO_GW_binResponse(gw, 0U, job->data, (uint16_t)job->dataSize);
+    }
+    else{
+        CO_GW_outSeq(gw);
+        CO_GW_outValue(gw, job->data, job->dataSize);
+        CO_GW_outEnd(gw);
+    }
+
+    gw->busy = false;
+}
+
+
+/*
+ * Submit SDO transfer of gw->data.
+ */
+static void CO_GW_startSDO(CO_gateway_t *gw, uint8_t node, uint16_t index, uint8_t subIndex,
+                           bool_t upload, uint32_t dataSize)
+{
+    CO_SDOclientJob_t *job = &gw->job;
+
+    job->nodeId = node;
+    job->index = index;
+    job->subIndex = subIndex;
+    job->upload = upload;
+    job->blockEnable = false;
+    job->data = gw->data;
+    job->dataSize = dataSize;
+    job->object = gw;
+    job->pFunctDone = CO_GW_jobDone;
+
+    gw->busy = true;
+    if(CO_SDOclientQueue_submit(gw->SDOqueue, job) != CO_ERROR_NO){
+        gw->busy = false;
+        CO_GW_response(gw, CO_GATEWAY_ERROR_STATE, false);
+    }
+}
+
+
+/*
+ * NMT command, node 0 addresses all nodes.
+ */
+static void CO_GW_nmt(CO_gateway_t *gw, uint8_t node, uint8_t command){
+#if CO_NO_NMT_MASTER == 1
+    if(CO_sendNMTcommand(gw->CO, command, node) == 0U){
+        CO_GW_response(gw, 0U, false);
+    }
+    else{
+        CO_GW_response(gw, CO_GATEWAY_ERROR_STATE, false);
+    }
+#else
+    (void)node;
+    (void)command;
+    CO_GW_response(gw, CO_GATEWAY_ERROR_UNSUPPORTED, false);
+#endif
+}
+
+
+/*
+ * Parse number, decimal or hexadecimal with 0x prefix.
+ */
+static bool_t CO_GW_parseU64(const char *token, uint64_t max, uint64_t *value){
+    char *end;
+
+    if(token == NULL || token[0] == '\0' || token[0] == '-'){
+        return false;
+    }
+    *value = strtoull(token, &end, 0);
+    return (*end == '\0') && (*value <= max);
+}
+
+static bool_t CO_GW_parseNumber(const char *token, uint32_t max, uint32_t *value){
+    uint64_t v;
+
+    if(!CO_GW_parseU64(token, max, &v)){
+        return false;
+    }
+    *value = (uint32_t)v;
+    return true;
+}
+
+static uint8_t CO_GW_hexValue(char c){
+    if(c >= '0' && c <= '9'){
+        return (uint8_t)(c - '0');
+    }
+    if(c >= 'a' && c <= 'f'){
+        return (uint8_t)(c - 'a' + 10);
+    }
+    if(c >= 'A' && c <= 'F'){
+        return (uint8_t)(c - 'A' + 10);
+    }
+    return 0xFFU;
+}
+
+
+/*
+ * Encode ASCII value into gw->data, returns length or 0 on error.
+ */
+static uint32_t CO_GW_parseValue(CO_gateway_t *gw, const CO_GW_datatype_t *type, const char *token){
+    uint32_t length = type->length;
+    uint64_t value;
+    uint32_t i;
+
+    if(type->kind == CO_GW_STRING){
+        length = (uint32_t)strlen(token);
+        if(length == 0U || length > CO_GATEWAY_DATA_SIZE){
+            return 0U;
+        }
+        memcpy(gw->data, token, length);
+        return length;
+    }
+    if(type->kind == CO_GW_OCTETS){
+        length = (uint32_t)strlen(token) / 2U;
+        if(length == 0U || length > CO_GATEWAY_DATA_SIZE || token[length * 2U] != '\0'){
+            return 0U;
+        }
+        for(i = 0U; i < length; i++){
+            uint8_t hi = CO_GW_hexValue(token[2U * i]);
+            uint8_t lo = CO_GW_hexValue(token[2U * i + 1U]);
+
+            if(hi > 0x0FU || lo > 0x0FU){
+                return 0U;
+            }
+            gw->data[i] = (uint8_t)((hi << 4) | lo);
+        }
+        return length;
+    }
+
+    if(type->kind == CO_GW_SIGNED && token[0] == '-'){
+        uint64_t min = (uint64_t)1U << (8U * length - 1U);
+
+        if(!CO_GW_parseU64(&token[1], min, &value)){
+            return 0U;
+        }
+        value = (uint64_t)0U - value;
+    }
+    else{
+        uint64_t max = (length == 8U) ? ~(uint64_t)0U : (((uint64_t)1U << (8U * length)) - 1U);
+
+        if(type->kind == CO_GW_SIGNED){
+            max >>= 1;
+        }
+        else if(type->name[0] == 'b'){
+            max = 1U;
+        }
+        else{
+            ;/* full range */
+        }
+        if(!CO_GW_parseU64(token, max, &value)){
+            return 0U;
+        }
+    }
+
+    for(i = 0U; i < length; i++){
+        gw->data[i] = (uint8_t)(value >> (8U * i));
+    }
+    return length;
+}
+
+
+/*
+ * Execute ASCII command in gw->rx, rxLength characters.
+ */
+static void CO_GW_ascii(CO_gateway_t *gw){
+    char *line = (char*)gw->rx;
+    char *tok[CO_GW_TOKENS];
+    uint8_t n = 0U;
+    uint8_t i = 0U;
+    uint8_t nums = 0U;
+    uint32_t num[2];
+    uint32_t node = gw->defaultNode;
+    uint16_t j;
+    const char *cmd;
+
+    gw->binary = false;
+    gw->seqValid = false;
+
+    /* split into tokens, rxLength is smaller than CO_GATEWAY_LINE_SIZE */
+    line[gw->rxLength] = '\0';
+    for(j = 0U; j < gw->rxLength && n < CO_GW_TOKENS; j++){
+        if(line[j] == ' ' || line[j] == '\t'){
+            line[j] = '\0';
+        }
+        else if(j == 0U || line[j - 1U] == '\0'){
+            tok[n++] = &line[j];
+        }
+        else{
+            ;/* inside token */
+        }
+    }
+    if(n == 0U){
+        return;
+    }
+
+    if(tok[0][0] == '['){
+        char *end;
+
+        gw->seq = (uint32_t)strtoul(&tok[0][1], &end, 0);
+        if(end[0] != ']' || end[1] != '\0'){
+            CO_GW_response(gw, CO_GATEWAY_ERROR_SYNTAX, false);
+            return;
+        }
+        gw->seqValid = true;
+        i++;
+    }
+    while(i < n && nums < 2U && CO_GW_parseNumber(tok[i], 127U, &num[nums])){
+        nums++;
+        i++;
+    }
+    if(i >= n){
+        CO_GW_response(gw, CO_GATEWAY_ERROR_SYNTAX, false);
+        return;
+    }
+    cmd = tok[i++];
+
+    if(strcmp(cmd, "set") == 0){
+        uint32_t value;
+
+        if(nums < 2U && (i + 2U) == n && strcmp(tok[i], "node") == 0
+           && CO_GW_parseNumber(tok[i + 1U], 127U, &value) && value != 0U)
+        {
+            gw->defaultNode = (uint8_t)value;
+            CO_GW_response(gw, 0U, false);
+        }
+        else{
+            CO_GW_response(gw, CO_GATEWAY_ERROR_SYNTAX, false);
+        }
+        return;
+    }
+    if(nums > 0U){
+        node = num[nums - 1U];
+    }
+
+    if(strcmp(cmd, "r") == 0 || strcmp(cmd, "read") == 0
+       || strcmp(cmd, "w") == 0 || strcmp(cmd, "write") == 0)
+    {
+        bool_t upload = (cmd[0] == 'r');
+        uint32_t index, subIndex, length = CO_GATEWAY_DATA_SIZE;
+        uint8_t t;
+
+        if(node == 0U || (i + (upload ? 3U : 4U)) > n
+           || (upload && (i + 3U) != n)
+           || !CO_GW_parseNumber(tok[i], 0xFFFFU, &index)
+           || !CO_GW_parseNumber(tok[i + 1U], 0xFFU, &subIndex))
+        {
+            CO_GW_response(gw, CO_GATEWAY_ERROR_SYNTAX, false);
+            return;
+        }
+        for(t = 0U; t < CO_GW_DATATYPES; t++){
+            if(strcmp(tok[i + 2U], CO_GW_datatypes[t].name) == 0){
+                break;
+            }
+        }
+        if(t == CO_GW_DATATYPES){
+            CO_GW_response(gw, CO_GATEWAY_ERROR_UNSUPPORTED, false);
+            return;
+        }
+        gw->datatype = t + 1U;
+
+        if(!upload){
+            char *value = tok[i + 3U];
+
+            if(CO_GW_datatypes[t].kind == CO_GW_STRING){
+                /* visible string is the rest of the line, with spaces */
+                for(j = (uint16_t)(value - line); j < gw->rxLength; j++){
+                    if(line[j] == '\0'){
+                        line[j] = ' ';
+                    }
+                }
+            }
+            else if((i + 4U) != n){
+                CO_GW_response(gw, CO_GATEWAY_ERROR_SYNTAX, false);
+                return;
+            }
+            else{
+                ;/* one token */
+            }
+            length = CO_GW_parseValue(gw, &CO_GW_datatypes[t], value);
+            if(length == 0U){
+                CO_GW_response(gw, CO_GATEWAY_ERROR_SYNTAX, false);
+                return;
+            }
+        }
+        CO_GW_startSDO(gw, (uint8_t)node, (uint16_t)index, (uint8_t)subIndex, upload, length);
+        return;
+    }
+
+    if(strcmp(cmd, "start") == 0 && i == n){
+        CO_GW_nmt(gw, (uint8_t)node, CO_NMT_ENTER_OPERATIONAL);
+    }
+    else if(strcmp(cmd, "stop") == 0 && i == n){
+        CO_GW_nmt(gw, (uint8_t)node, CO_NMT_ENTER_STOPPED);
+    }
+    else if((strcmp(cmd, "preop") == 0 || strcmp(cmd, "preoperational") == 0) && i == n){
+        CO_GW_nmt(gw, (uint8_t)node, CO_NMT_ENTER_PRE_OPERATIONAL);
+    }
+    else if(strcmp(cmd, "reset") == 0 && (i + 1U) == n && strcmp(tok[i], "node") == 0){
+        CO_GW_nmt(gw, (uint8_t)node, CO_NMT_RESET_NODE);
+    }
+    else if(strcmp(cmd, "reset") == 0 && (i + 1U) == n
+            && (strcmp(tok[i], "comm") == 0 || strcmp(tok[i], "communication") == 0))
+    {
+        CO_GW_nmt(gw, (uint8_t)node, CO_NMT_RESET_COMMUNICATION);
+    }
+    else{
+        CO_GW_response(gw, CO_GATEWAY_ERROR_UNSUPPORTED, false);
+    }
+}
+
+
+/*
+ * Execute binary frame in gw->rx, CRC is verified.
+ */
+static void CO_GW_bin(CO_gateway_t *gw){
+    const uint8_t *payload = &gw->rx[4];
+    uint16_t length = (uint16_t)gw->rx[1] - 2U;
+    uint16_t index = (uint16_t)payload[1] | ((uint16_t)payload[2] << 8);
+
+    gw->binary = true;
+    gw->seq = gw->rx[2];
+    gw->binCommand = gw->rx[3];
+    gw->datatype = 0U;
+
+    switch(gw->binCommand){
+        case CO_GATEWAY_BIN_READ:
+            if(length == 4U && payload[0] >= 1U && payload[0] <= 127U){
+                uint32_t size = 255U - 2U - CO_GW_BIN_ABORT;
+
+                if(size > CO_GATEWAY_DATA_SIZE){
+                    size = CO_GATEWAY_DATA_SIZE;
+                }
+                CO_GW_startSDO(gw, payload[0], index, payload[3], true, size);
+                return;
+            }
+            break;
+        case CO_GATEWAY_BIN_WRITE:
+            if(length > 4U && (length - 4U) <= CO_GATEWAY_DATA_SIZE
+               && payload[0] >= 1U && payload[0] <= 127U)
+            {
+                memcpy(gw->data, &payload[4], length - 4U);
+                CO_GW_startSDO(gw, payload[0], index, payload[3], false, length - 4U);
+                return;
+            }
+            break;
+        case CO_GATEWAY_BIN_NMT:
+            if(length == 2U && payload[0] <= 127U){
+                CO_GW_nmt(gw, payload[0], payload[1]);
+                return;
+            }
+            break;
+        default:
+            CO_GW_response(gw, CO_GATEWAY_ERROR_UNSUPPORTED, false);
+            return;
+    }
+    CO_GW_response(gw, CO_GATEWAY_ERROR_SYNTAX, false);
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_gateway_init(
+        CO_gateway_t           *gw,
+        CO_t                   *CO,
+        CO_SDOclientQueue_t    *SDOqueue,
+        uint8_t                 defaultNode,
+        void                   *object,
+        void                  (*pFunctWrite)(void *object, const uint8_t *data, uint16_t length))
+{
+    /* verify arguments */
+    if(gw == NULL || CO == NULL || SDOqueue == NULL || pFunctWrite == NULL
+       || defaultNode == 0U || defaultNode > 127U)
+    {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    gw->CO = CO;
+    gw->SDOqueue = SDOqueue;
+    gw->object = object;
+    gw->pFunctWrite = pFunctWrite;
+    gw->defaultNode = defaultNode;
+    gw->rxLength = 0U;
+    gw->rxOverflow = false;
+    gw->binary = false;
+    gw->seqValid = false;
+    gw->seq = 0U;
+    gw->binCommand = 0U;
+    gw->datatype = 0U;
+    gw->busy = false;
+    gw->txLength = 0U;
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+uint16_t CO_gateway_receive(
+        CO_gateway_t           *gw,
+        const uint8_t          *data,
+        uint16_t                length)
+{
+    uint16_t i;
+
+    for(i = 0U; i < length && !gw->busy; i++){
+        uint8_t c = data[i];
+
+        if(gw->rxLength == 0U && c == CO_GATEWAY_STX){
+            /* start of binary frame */
+            gw->rx[0] = c;
+            gw->rxLength = 1U;
+            gw->rxOverflow = false;
+        }
+        else if(gw->rxLength > 0U && gw->rx[0] == CO_GATEWAY_STX){
+            gw->rx[gw->rxLength++] = c;
+            if(gw->rxLength == 2U && (c < 2U || ((uint16_t)c + 4U) > CO_GATEWAY_LINE_SIZE)){
+                /* invalid length, resynchronize on the next start byte */
+                gw->rxLength = 0U;
+            }
+            else if(gw->rxLength > 2U && gw->rxLength == (uint16_t)gw->rx[1] + 4U){
+                uint16_t n = gw->rx[1];
+                uint16_t crc = (uint16_t)gw->rx[n + 2U] | ((uint16_t)gw->rx[n + 3U] << 8);
+
+                gw->rxLength = 0U;
+                if(crc16_ccitt(&gw->rx[1], n + 1U, 0U) == crc){
+                    CO_GW_bin(gw);
+                }
+            }
+            else{
+                ;/* wait for more */
+            }
+        }
+        else if(c == '\r' || c == '\n'){
+            if(gw->rxOverflow){
+                gw->binary = false;
+                gw->seqValid = false;
+                CO_GW_response(gw, CO_GATEWAY_ERROR_SYNTAX, false);
+            }
+            else if(gw->rxLength > 0U){
+                CO_GW_ascii(gw);
+            }
+            else{
+                ;/* empty line or CR LF */
+            }
+            gw->rxLength = 0U;
+            gw->rxOverflow = false;
+        }
+        else if(gw->rxOverflow){
+            ;/* discard until end of line */
+        }
+        else if(gw->rxLength < (CO_GATEWAY_LINE_SIZE - 1U)){
+            gw->rx[gw->rxLength++] = c;
+        }
+        else{
+            gw->rxOverflow = true;
+        }
+    }
+
+    return i;
+}
+
+
+/******************************************************************************/
+void CO_gateway_discard(CO_gateway_t *gw){
+    gw->rxLength = 0U;
+    gw->rxOverflow = true;
+}
+
+#endif /* CO_GATEWAY > 0 */
@@ -0,0 +1,238 @@
+/**
+ * CANopen ASCII and binary gateway, CiA 309-3 subset.
+ *
+ * @file        CO_gateway.h
+ * @ingroup     CO_gateway
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * CANopenNode is free and open source software: you can redistribute
+ * it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Following clarification and special exception to the GNU General Public
+ * License is included to the distribution terms of CANopenNode:
+ *
+ * Linking this library statically or dynamically with other modules is
+ * making a combined work based on this library. Thus, the terms and
+ * conditions of the GNU General Public License cover the whole combination.
+ *
+ * As a special exception, the copyright holders of this library give
+ * you permission to link this library with independent modules to
+ * produce an executable, regardless of the license terms of these
+ * independent modules, and to copy and distribute the resulting
+ * executable under terms of your choice, provided that you also meet,
+ * for each linked independent module, the terms and conditions of the
+ * license of that module. An independent module is a module which is
+ * not derived from or based on this library. If you modify this
+ * library, you may extend this exception to your version of the
+ * library, but you are not obliged to do so. If you do not wish
+ * to do so, delete this exception statement from your version.
+ */
+
+
+#ifndef CO_GATEWAY_H
+#define CO_GATEWAY_H
+
+#include "CANopen.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_gateway Gateway
+ * @ingroup CO_CANopen
+ * @{
+ *
+ * Gateway from a serial line (host PC, commissioning tool) to the CANopen
+ * network. Enabled with CO_GATEWAY in CO_driver.h, it requires SDO client
+ * (CO_NO_SDO_CLIENT) and uses @ref CO_SDOmaster queue for transfers.
+ *
+ * Received characters are passed to CO_gateway_receive(), responses are
+ * written with the _pFunctWrite_ callback from CO_gateway_init(), for
+ * example into UART transmit DMA, see CO_gatewayUart.h. Commands are
+ * executed one at a time. While SDO transfer is running, CO_gateway_receive()
+ * does not consume new characters, so they stay in the receive buffer.
+ *
+ * ###ASCII commands
+ *
+ * Commands are terminated with CR or LF, tokens are separated with spaces.
+ * Optional sequence number in square brackets is repeated in the response.
+ * Network number is accepted, but ignored, there is only one network.
+ * Node-ID may be omitted, then default node-ID is used.
+ *
+ *     [<seq>] [[<net>] <node>] r[ead] <index> <subindex> <datatype>
+ *     [<seq>] [[<net>] <node>] w[rite] <index> <subindex> <datatype> <value>
+ *     [<seq>] [[<net>] <node>] start | stop | preop[erational]
+ *     [<seq>] [[<net>] <node>] reset node | reset comm[unication]
+ *     [<seq>] [<net>] set node <node>
+ *
+ * Numbers are decimal or hexadecimal with 0x prefix. Datatypes are b, i8,
+ * i16, i32, i64, u8, u16, u32, u64, x8, x16, x32, x64 (unsigned, response
+ * in hexadecimal), vs (visible string, rest of the line) and os or d (octet
+ * string or domain, hexadecimal digits without spaces). Floating point types
+ * are not supported.
+ *
+ * Responses are `[<seq>] OK`, `[<seq>] <value>`, `[<seq>] ERROR:0x<abort>`
+ * with SDO abort code or `[<seq>] ERROR:<code>` with #CO_GATEWAY_ERROR_SYNTAX
+ * and similar gateway error codes.
+ *
+ * ###Binary frames
+ *
+ * Binary frame starts with #CO_GATEWAY_STX instead of the first character of
+ * ASCII command. It avoids formatting of numbers and transfers arbitrary data.
+ *
+ *   Bytes | Description
+ *   ------|-----------------------------------------------------------
+ *     1   | Start byte, #CO_GATEWAY_STX
+ *     1   | Length n of sequence, command and payload, 2..255
+ *     1   | Sequence number, repeated in the response
+ *     1   | Command, #CO_GATEWAY_BIN_READ and similar
+ *    n-2  | Payload
+ *     2   | crc16_ccitt() of length, sequence, command and payload, little endian
+ *
+ * Payload of READ is node-ID, index (2 bytes, little endian) and subindex,
+ * WRITE has data after subindex and NMT has node-ID and NMT command
+ * (#CO_NMT_command_t). Response has the same framing, command with bit 7
+ * set, SDO abort code (4 bytes, little endian, 0 on success, gateway error
+ * code otherwise) and data of READ. Frame with wrong CRC is ignored.
+ */
+
+
+/** Start byte of binary frame */
+#define CO_GATEWAY_STX              0x02U
+/** Binary command: SDO upload */
+#define CO_GATEWAY_BIN_READ         0x40U
+/** Binary command: SDO download */
+#define CO_GATEWAY_BIN_WRITE        0x41U
+/** Binary command: NMT command */
+#define CO_GATEWAY_BIN_NMT          0x42U
+/** Bit of the command in the response */
+#define CO_GATEWAY_BIN_RESPONSE     0x80U
+
+/** Gateway error: command not supported */
+#define CO_GATEWAY_ERROR_UNSUPPORTED 100U
+/** Gateway error: syntax error */
+#define CO_GATEWAY_ERROR_SYNTAX     101U
+/** Gateway error: request not processed in this state */
+#define CO_GATEWAY_ERROR_STATE      102U
+
+
+/**
+ * Gateway object.
+ */
+typedef struct{
+    /** From CO_gateway_init() */
+    CO_t               *CO;
+    /** From CO_gateway_init() */
+    CO_SDOclientQueue_t *SDOqueue;
+    /** From CO_gateway_init() */
+    void               *object;
+    /** From CO_gateway_init() */
+    void              (*pFunctWrite)(void *object, const uint8_t *data, uint16_t length);
+    /** Node-ID, if omitted in ASCII command, see `set node` */
+    uint8_t             defaultNode;
+    /** ASCII command or binary frame, which is received */
+    uint8_t             rx[CO_GATEWAY_LINE_SIZE];
+    /** Number of bytes in rx */
+    uint16_t            rxLength;
+    /** ASCII command is too long, it is discarded until end of line */
+    bool_t              rxOverflow;
+    /** True, if the running or the last command was binary */
+    bool_t              binary;
+    /** Response of ASCII command has sequence number */
+    bool_t              seqValid;
+    /** Sequence number of the running command */
+    uint32_t            seq;
+    /** Binary command of the running request */
+    uint8_t             binCommand;
+    /** Datatype of ASCII read, 0 for binary read */
+    uint8_t             datatype;
+    /** True, while SDO client job is in the queue */
+    volatile bool_t     busy;
+    /** SDO client job of the running command */
+    CO_SDOclientJob_t   job;
+    /** Data of SDO transfer */
+    uint8_t             data[CO_GATEWAY_DATA_SIZE];
+    /** Part of the response, which is not written yet */
+    uint8_t             tx[64];
+    /** Number of bytes in tx */
+    uint16_t            txLength;
+}CO_gateway_t;
+
+
+/**
+ * Initialize gateway object.
+ *
+ * Function must be called in the communication reset section, after
+ * CO_SDOclientQueue_init().
+ *
+ * @param gw This object will be initialized.
+ * @param CO CANopen object, used for NMT commands.
+ * @param SDOqueue SDO client queue, processed by application.
+ * @param defaultNode Node-ID for commands without node-ID, 1..127.
+ * @param object Passed to pFunctWrite().
+ * @param pFunctWrite Writes part of the response to the serial line.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_gateway_init(
+        CO_gateway_t           *gw,
+        CO_t                   *CO,
+        CO_SDOclientQueue_t    *SDOqueue,
+        uint8_t                 defaultNode,
+        void                   *object,
+        void                  (*pFunctWrite)(void *object, const uint8_t *data, uint16_t length));
+
+
+/**
+ * Process received characters.
+ *
+ * Function must be called cyclically from the same thread as
+ * CO_SDOclientQueue_process(). Commands are parsed and started, responses of
+ * finished SDO transfers are written from CO_SDOclientQueue_process().
+ *
+ * @param gw This object.
+ * @param data Received characters.
+ * @param length Number of characters in data.
+ *
+ * @return Number of characters consumed. Others must be passed again in the
+ * next call, after running command is finished.
+ */
+uint16_t CO_gateway_receive(
+        CO_gateway_t           *gw,
+        const uint8_t          *data,
+        uint16_t                length);
+
+
+/**
+ * Discard partially received command.
+ *
+ * Serial line calls it, when received characters were lost, for example by
+ * receive buffer overrun. Characters are then discarded until the end of
+ * line and ERROR:101 (#CO_GATEWAY_ERROR_SYNTAX) is responded, so the host
+ * repeats the command. Binary frame is resynchronized on the next start byte.
+ *
+ * @param gw This object.
+ */
+void CO_gateway_discard(CO_gateway_t *gw);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif
@@ -45,6 +45,7 @@
 
 #include "CO_trace.h"
 #include <stdio.h>
+#include <inttypes.h>
 
 
 /* Different functions for processing value for different data types. */
@@ -58,10 +59,10 @@ static int32_t getValueU32(void *OD_variable) { return           *((int32_t*)  O
 
 /* Different functions for printing points for different data types. */
 static uint32_t printPointCsv(char *s, uint32_t size, uint32_t timeStamp, int32_t value) {
-    return snprintf(s, size, "%lu;%ld\n", timeStamp,             value);
+    return snprintf(s, size, "%" PRIu32 ";%" PRId32 "\n", timeStamp,             value);
 }
 static uint32_t printPointCsvUnsigned(char *s, uint32_t size, uint32_t timeStamp, int32_t value) {
-    return snprintf(s, size, "%lu;%lu\n", timeStamp, (uint32_t)  value);
+    return snprintf(s, size, "%" PRIu32 ";%" PRIu32 "\n", timeStamp, (uint32_t)  value);
 }
 static uint32_t printPointBinary(char *s, uint32_t size, uint32_t timeStamp, int32_t value) {
     if(size < 8) return 0;
@@ -70,22 +71,44 @@ static uint32_t printPointBinary(char *s, uint32_t size, uint32_t timeStamp, int
     return 8;
 }
 static uint32_t printPointSvgStart(char *s, uint32_t size, uint32_t timeStamp, int32_t value) {
-    return snprintf(s, size, "M%lu,%ld", timeStamp,             value);
+    return snprintf(s, size, "M%" PRIu32 ",%" PRId32, timeStamp,             value);
 }
 static uint32_t printPointSvgStartUnsigned(char *s, uint32_t size, uint32_t timeStamp, int32_t value) {
-    return snprintf(s, size, "M%lu,%lu", timeStamp, (uint32_t)  value);
+    return snprintf(s, size, "M%" PRIu32 ",%" PRIu32, timeStamp, (uint32_t)  value);
 }
 static uint32_t printPointSvg(char *s, uint32_t size, uint32_t timeStamp, int32_t value) {
-    return snprintf(s, size, "H%luV%ld", timeStamp,             value);
+    return snprintf(s, size, "H%" PRIu32 "V%" PRId32, timeStamp,             value);
 }
 static uint32_t printPointSvgUnsigned(char *s, uint32_t size, uint32_t timeStamp, int32_t value) {
-    return snprintf(s, size, "H%luV%lu", timeStamp, (uint32_t)  value);
+    return snprintf(s, size, "H%" PRIu32 "V%" PRIu32, timeStamp, (uint32_t)  value);
+}
+
+
+/* Encode unsigned value as little endian base 128 varint, return number of bytes. */
+static uint32_t encodeVarint(uint8_t *s, uint32_t value) {
+    uint32_t len = 0;
+
+    while(value >= 0x80) {
+        s[len++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    s[len++] = (uint8_t)value;
+    return len;
+}
+
+
+/* Encode signed difference with zigzag, so small negative values are short too. */
+static uint32_t encodeVarintSigned(uint8_t *s, uint32_t difference) {
+    uint32_t zigzag = (difference << 1) ^ (((difference & 0x80000000UL) != 0) ? 0xFFFFFFFFUL : 0);
+
+    return encodeVarint(s, zigzag);
 }
 
 
 /* Collection of function pointers for fast processing based on specific data type. */
 /* Rules for the array: There must be groups of six members (I8, I16, I32, U8, U16, U32)
- * in correct order and sequence, so findVariable() finds correct member. */
+ * in correct order and sequence, so findVariable() finds correct member.
+ * Last group (delta binary) has no print functions, see CO_trace_readDelta(). */
 static const CO_trace_dataType_t dataTypes[] = {
     {getValueI8,  printPointCsv,              printPointCsv,         printPointCsv},
     {getValueI16, printPointCsv,              printPointCsv,         printPointCsv},
@@ -104,23 +127,30 @@ static const CO_trace_dataType_t dataTypes[] = {
     {getValueI32, printPointSvgStart,         printPointSvg,         printPointSvg},
     {getValueU8,  printPointSvgStartUnsigned, printPointSvgUnsigned, printPointSvgUnsigned},
     {getValueU16, printPointSvgStartUnsigned, printPointSvgUnsigned, printPointSvgUnsigned},
-    {getValueU32, printPointSvgStartUnsigned, printPointSvgUnsigned, printPointSvgUnsigned}
+    {getValueU32, printPointSvgStartUnsigned, printPointSvgUnsigned, printPointSvgUnsigned},
+    {getValueI8,  NULL,                       NULL,                  NULL},
+    {getValueI16, NULL,                       NULL,                  NULL},
+    {getValueI32, NULL,                       NULL,                  NULL},
+    {getValueU8,  NULL,                       NULL,                  NULL},
+    {getValueU16, NULL,                       NULL,                  NULL},
+    {getValueU32, NULL,                       NULL,                  NULL}
 };
 
 
-/* Find variable in Object Dictionary *****************************************/
-static void findVariable(CO_trace_t *trace) {
+/* Find mapped variable in Object Dictionary, return true on error. ***********/
+/* OdDataPtr is NULL, if map is zero. dtIndex is set to the first group in dataTypes[]. */
+static bool_t mapVariable(CO_SDO_t *SDO, uint32_t map, void **OdDataPtr, int *dtIndex) {
     bool_t err = false;
     uint16_t index;
     uint8_t subIndex;
     uint8_t dataLen;
-    void *OdDataPtr = NULL;
-    int dtIndex = 0;
+
+    *OdDataPtr = NULL;
 
     /* parse mapping */
-    index = (uint16_t) ((*trace->map) >> 16);
-    subIndex = (uint8_t) ((*trace->map) >> 8);
-    dataLen = (uint8_t) (*trace->map);
+    index = (uint16_t) (map >> 16);
+    subIndex = (uint8_t) (map >> 8);
+    dataLen = (uint8_t) map;
     if((dataLen & 0x07) != 0) { /* data length must be byte aligned */
         err = true;
     }
@@ -131,14 +161,14 @@ static void findVariable(CO_trace_t *trace) {
 
     /* find mapped variable, if map available */
     if(!err && (index != 0 || subIndex != 0)) {
-        uint16_t entryNo = CO_OD_find(trace->SDO, index);
+        uint16_t entryNo = CO_OD_find(SDO, index);
 
-        if(index >= 0x1000 && entryNo != 0xFFFF && subIndex <= trace->SDO->OD[entryNo].maxSubIndex) {
-            OdDataPtr = CO_OD_getDataPointer(trace->SDO, entryNo, subIndex);
+        if(index >= 0x1000 && entryNo != 0xFFFF && subIndex <= SDO->OD[entryNo].maxSubIndex) {
+            *OdDataPtr = CO_OD_getDataPointer(SDO, entryNo, subIndex);
         }
 
-        if(OdDataPtr != NULL) {
-            uint16_t len = CO_OD_getLength(trace->SDO, entryNo, subIndex);
+        if(*OdDataPtr != NULL) {
+            uint16_t len = CO_OD_getLength(SDO, entryNo, subIndex);
 
             if(len < dataLen) {
                 dataLen = len;
@@ -149,15 +179,31 @@ static void findVariable(CO_trace_t *trace) {
         }
     }
 
-    /* Get function pointers for correct data type */
+    /* data length selects data type */
     if(!err) {
-        /* first sequence: data length */
         switch(dataLen) {
-            case 1: dtIndex = 0; break;
-            case 2: dtIndex = 1; break;
-            case 4: dtIndex = 2; break;
+            case 1: *dtIndex = 0; break;
+            case 2: *dtIndex = 1; break;
+            case 4: *dtIndex = 2; break;
             default: err = true; break;
         }
+    }
+
+    return err;
+}
+
+
+/* Find variable in Object Dictionary *****************************************/
+static void findVariable(CO_trace_t *trace) {
+    bool_t err;
+    void *OdDataPtr;
+    int dtIndex = 0;
+
+    /* first sequence: data length */
+    err = mapVariable(trace->SDO, *trace->map, &OdDataPtr, &dtIndex);
+
+    /* Get function pointers for correct data type */
+    if(!err) {
         /* second sequence: signed or unsigned */
         if(((*trace->format) & 1) == 1) {
             dtIndex += 3;
@@ -165,7 +211,7 @@ static void findVariable(CO_trace_t *trace) {
         /* third sequence: Output type */
         dtIndex += ((*trace->format) >> 1) * 6;
 
-        if(dtIndex > (sizeof(dataTypes) / sizeof(CO_trace_dataType_t))) {
+        if(dtIndex >= (sizeof(dataTypes) / sizeof(CO_trace_dataType_t))) {
             err = true;
         }
     }
@@ -232,6 +278,11 @@ static CO_SDO_abortCode_t CO_ODF_traceConfig(CO_ODF_arg_t *ODF_arg) {
                         trace->valuePrev = 0;
                         trace->readPtr = 0;
                         trace->writePtr = 0;
+                        trace->archived = false;
+                        trace->held = false;
+                        if(trace->captureState != CO_TRACE_CAPTURE_OFF) {
+                            trace->captureState = CO_TRACE_CAPTURE_ARMED;
+                        }
                         trace->enabled = true;
                     }
                     else {
@@ -289,6 +340,10 @@ static CO_SDO_abortCode_t CO_ODF_trace(CO_ODF_arg_t *ODF_arg) {
                     trace->writePtr = 0;
                     *trace->triggerTime = 0;
                 }
+                /* arm capture again */
+                if(trace->captureState != CO_TRACE_CAPTURE_OFF) {
+                    trace->captureState = CO_TRACE_CAPTURE_ARMED;
+                }
             }
             else {
                 ret = CO_SDO_AB_INVALID_VALUE;
@@ -313,6 +368,12 @@ static CO_SDO_abortCode_t CO_ODF_trace(CO_ODF_arg_t *ODF_arg) {
             else if(trace->readPtr == trace->writePtr) {
                 ret = CO_SDO_AB_NO_DATA;
             }
+            else if(trace->dt->printPoint == NULL) {
+                /* delta binary, points are consumed directly from buffer */
+                ODF_arg->dataLength = CO_trace_readDelta(trace, (uint8_t*) ODF_arg->data,
+                        ODF_arg->dataLength, ODF_arg->firstSegment);
+                ODF_arg->lastSegment = (trace->readPtr == trace->writePtr) ? true : false;
+            }
             else {
                 uint32_t rp, t, v, len, freeLen;
                 char *s;
@@ -410,6 +471,109 @@ static CO_SDO_abortCode_t CO_ODF_trace(CO_ODF_arg_t *ODF_arg) {
 }
 
 
+/* Write point into buffer, it becomes the base of compression. */
+static void writePoint(CO_trace_t *trace, uint32_t timestamp, int32_t val) {
+    trace->timeBuffer[trace->writePtr] = timestamp;
+    trace->valueBuffer[trace->writePtr] = val;
+    if(++trace->writePtr == trace->bufferSize) {
+        trace->writePtr = 0;
+    }
+    if(trace->writePtr == trace->readPtr) {
+        if(++trace->readPtr == trace->bufferSize) {
+            trace->readPtr = 0;
+        }
+    }
+    trace->archived = true;
+    trace->archiveTime = timestamp;
+    trace->archiveValue = val;
+    trace->held = false;
+}
+
+
+/* Value for compression arithmetic, unsigned 32-bit variables are not negative. */
+static int64_t value64(CO_trace_t *trace, int32_t val) {
+    return ((*trace->format & 1) != 0) ? (int64_t)(uint32_t)val : (int64_t)val;
+}
+
+
+/* Open both doors of swinging door compression from archive point towards sample. */
+static void openDoors(CO_trace_t *trace, uint32_t dt, int64_t dv) {
+    trace->upperNum = dv + trace->deadband;
+    trace->upperDen = dt;
+    trace->lowerNum = dv - trace->deadband;
+    trace->lowerDen = dt;
+}
+
+
+/* Decide, if sample is recorded, return true, if point was written. */
+static bool_t compressPoint(CO_trace_t *trace, uint32_t timestamp, int32_t val) {
+    bool_t written = false;
+    int64_t dv;
+    uint32_t dt;
+
+    if(!trace->archived) {
+        writePoint(trace, timestamp, val);
+        return true;
+    }
+
+    dv = value64(trace, val) - value64(trace, trace->archiveValue);
+
+    if(trace->compression == CO_TRACE_COMPRESS_DEADBAND) {
+        if(dv > trace->deadband || dv < -(int64_t)trace->deadband) {
+            writePoint(trace, timestamp, val);
+            return true;
+        }
+        return false;
+    }
+
+    /* swinging door */
+    dt = timestamp - trace->archiveTime;
+    if(dt == 0) {
+        return false;
+    }
+    if(dt > CO_TRACE_SWINGING_DOOR_MAX_TIME) {
+        /* consecutive samples are always a valid line */
+        if(trace->held) {
+            writePoint(trace, trace->heldTime, trace->heldValue);
+        }
+        writePoint(trace, timestamp, val);
+        return true;
+    }
+    if(!trace->held) {
+        openDoors(trace, dt, dv);
+    }
+    else if(dv * trace->upperDen > trace->upperNum * (int64_t)dt
+            || dv * trace->lowerDen < trace->lowerNum * (int64_t)dt) {
+        /* Sample is outside of the corridor, which passes all samples since the
+         * archive point within deadband. Held sample is inside, so line to it
+         * is valid and it becomes the new archive point. */
+        writePoint(trace, trace->heldTime, trace->heldValue);
+        dt = timestamp - trace->archiveTime;
+        dv = value64(trace, val) - value64(trace, trace->archiveValue);
+        openDoors(trace, dt, dv);
+        written = true;
+    }
+    else {
+        int64_t upperNum = dv + trace->deadband;
+        int64_t lowerNum = dv - trace->deadband;
+
+        /* doors only close: upper = min(upper, new), lower = max(lower, new) */
+        if(upperNum * trace->upperDen < trace->upperNum * (int64_t)dt) {
+            trace->upperNum = upperNum;
+            trace->upperDen = dt;
+        }
+        if(lowerNum * trace->lowerDen > trace->lowerNum * (int64_t)dt) {
+            trace->lowerNum = lowerNum;
+            trace->lowerDen = dt;
+        }
+    }
+    trace->held = true;
+    trace->heldTime = timestamp;
+    trace->heldValue = val;
+    return written;
+}
+
+
 /******************************************************************************/
 void CO_trace_init(
         CO_trace_t             *trace,
@@ -437,6 +601,8 @@ void CO_trace_init(
     trace->writePtr = 0;
     trace->readPtr = 0;
     trace->lastTimeStamp = 0;
+    trace->deltaTime = 0;
+    trace->deltaValue = 0;
     trace->map = map;
     trace->format = format;
     trace->trigger = trigger;
@@ -450,6 +616,17 @@ void CO_trace_init(
     *trace->maxValue = 0;
     *trace->triggerTime = 0;
     trace->valuePrev = 0;
+    trace->captureState = CO_TRACE_CAPTURE_OFF;
+    trace->preTrigger = 0;
+    trace->postTrigger = 0;
+    trace->postCount = 0;
+    trace->triggerPtr = 0;
+    trace->compression = CO_TRACE_COMPRESS_DEADBAND;
+    trace->deadband = 0;
+    trace->decimation = 1;
+    trace->decimationCount = 0;
+    trace->archived = false;
+    trace->held = false;
 
     /* set trace->OD_variable and trace->dt, based on 'map' and 'format' */
     findVariable(trace);
@@ -469,17 +646,36 @@ void CO_trace_init(
 
 /******************************************************************************/
 void CO_trace_process(CO_trace_t *trace, uint32_t timestamp) {
-    if(trace->enabled) {
+    if(trace->enabled && trace->captureState != CO_TRACE_CAPTURE_FROZEN) {
+        int32_t val;
+        bool_t triggerPoint = false;
+        bool_t written;
+
+        /* only every n-th call is a sample */
+        if(++trace->decimationCount < trace->decimation) {
+            return;
+        }
+        trace->decimationCount = 0;
 
-        int32_t val = trace->dt->pGetValue(trace->OD_variable);
+        val = trace->dt->pGetValue(trace->OD_variable);
 
         if(val != trace->valuePrev) {
-            /* Verify, if value passed threshold */
+            bool_t triggered = false;
+
+            /* Verify, if value passed threshold, rising or falling edge */
             if((*trace->trigger & 1) != 0 && trace->valuePrev < *trace->threshold && val >= *trace->threshold) {
-                *trace->triggerTime = timestamp;
+                triggered = true;
+            }
+            if((*trace->trigger & 2) != 0 && trace->valuePrev > *trace->threshold && val <= *trace->threshold) {
+                triggered = true;
             }
-            if((*trace->trigger & 2) != 0 && trace->valuePrev < *trace->threshold && val >= *trace->threshold) {
+            if(triggered) {
                 *trace->triggerTime = timestamp;
+                if(trace->captureState == CO_TRACE_CAPTURE_ARMED) {
+                    trace->captureState = CO_TRACE_CAPTURE_TRIGGERED;
+                    trace->postCount = trace->postTrigger;
+                    triggerPoint = true;
+                }
             }
 
             /* Write value and verify min/max */
@@ -493,30 +689,307 @@ void CO_trace_process(CO_trace_t *trace, uint32_t timestamp) {
             if(*trace->maxValue < val) {
                 *trace->maxValue = val;
             }
+        }
 
-            /* write buffers and update pointers */
-            trace->timeBuffer[trace->writePtr] = timestamp;
-            trace->valueBuffer[trace->writePtr] = val;
-            if(++trace->writePtr == trace->bufferSize) {
-                trace->writePtr = 0;
-            }
-            if(trace->writePtr == trace->readPtr) {
-                if(++trace->readPtr == trace->bufferSize) {
-                    trace->readPtr = 0;
-                }
+        /* write buffers and update pointers */
+        if(triggerPoint) {
+            /* trigger point is always recorded, after the held sample */
+            if(trace->held) {
+                writePoint(trace, trace->heldTime, trace->heldValue);
             }
+            trace->triggerPtr = trace->writePtr;
+            writePoint(trace, timestamp, val);
+            written = true;
         }
         else {
+            written = compressPoint(trace, timestamp, val);
+
             /* if buffer is empty, make first record */
-            if(trace->writePtr == trace->readPtr) {
-                /* write buffers and update pointers */
-                trace->timeBuffer[trace->writePtr] = timestamp;
-                trace->valueBuffer[trace->writePtr] = val;
-                if(++trace->writePtr == trace->bufferSize) {
-                    trace->writePtr = 0;
+            if(!written && trace->writePtr == trace->readPtr) {
+                writePoint(trace, timestamp, val);
+            }
+        }
+
+        /* freeze after post-trigger points, keep preTrigger points before trigger */
+        if(written && trace->captureState == CO_TRACE_CAPTURE_TRIGGERED) {
+            if(!triggerPoint) {
+                trace->postCount--;
+            }
+            if(trace->postCount == 0) {
+                uint32_t pre = (trace->triggerPtr >= trace->readPtr) ?
+                               (trace->triggerPtr - trace->readPtr) :
+                               (trace->bufferSize - trace->readPtr + trace->triggerPtr);
+
+                if(pre > trace->preTrigger) {
+                    trace->readPtr = (trace->triggerPtr >= trace->preTrigger) ?
+                                     (trace->triggerPtr - trace->preTrigger) :
+                                     (trace->bufferSize - trace->preTrigger + trace->triggerPtr);
                 }
+                trace->captureState = CO_TRACE_CAPTURE_FROZEN;
             }
         }
         trace->lastTimeStamp = timestamp;
     }
 }
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_trace_setCapture(CO_trace_t *trace, uint32_t preTrigger, uint32_t postTrigger) {
+    /* trigger point must not be overwritten before freeze */
+    if(postTrigger != 0 && (preTrigger >= trace->bufferSize || postTrigger >= (trace->bufferSize - preTrigger - 1U))) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    CO_LOCK_OD();
+    trace->preTrigger = preTrigger;
+    trace->postTrigger = postTrigger;
+    trace->postCount = 0;
+    trace->readPtr = 0;
+    trace->writePtr = 0;
+    *trace->triggerTime = 0;
+    trace->captureState = (postTrigger != 0) ? CO_TRACE_CAPTURE_ARMED : CO_TRACE_CAPTURE_OFF;
+    CO_UNLOCK_OD();
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_trace_setCompression(
+        CO_trace_t             *trace,
+        CO_trace_compression_t  compression,
+        int32_t                 deadband,
+        uint16_t                decimation)
+{
+    if((compression != CO_TRACE_COMPRESS_DEADBAND && compression != CO_TRACE_COMPRESS_SWINGING_DOOR)
+       || deadband < 0 || decimation == 0) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    CO_LOCK_OD();
+    trace->compression = compression;
+    trace->deadband = deadband;
+    trace->decimation = decimation;
+    trace->decimationCount = 0;
+    trace->held = false;
+    CO_UNLOCK_OD();
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+uint32_t CO_trace_readDelta(CO_trace_t *trace, uint8_t *buf, uint32_t size, bool_t absolute) {
+    uint32_t len = 0;
+
+    if(trace->bufferSize == 0 || trace->dt == NULL) {
+        return 0;
+    }
+    if(absolute) {
+        trace->deltaTime = 0;
+        trace->deltaValue = 0;
+    }
+
+    /* each point needs at most 2 * 5 bytes */
+    while((size - len) >= CO_TRACE_DELTA_POINT_MAX) {
+        uint32_t rp, t, v;
+
+        /* CO_trace_process() may move readPtr, if buffer is full */
+        CO_LOCK_OD();
+        rp = trace->readPtr;
+        if(rp == trace->writePtr) {
+            CO_UNLOCK_OD();
+            break;
+        }
+        t = trace->timeBuffer[rp];
+        v = (uint32_t) trace->valueBuffer[rp];
+        if(++rp == trace->bufferSize) {
+            rp = 0;
+        }
+        trace->readPtr = rp;
+        CO_UNLOCK_OD();
+
+        len += encodeVarint(&buf[len], t - trace->deltaTime);
+        len += encodeVarintSigned(&buf[len], v - trace->deltaValue);
+        trace->deltaTime = t;
+        trace->deltaValue = v;
+    }
+
+    return len;
+}
+
+
+/* OD function for accessing _OD_traceGroup_ from SDO server.
+ * For more information see file CO_SDO.h. */
+static CO_SDO_abortCode_t CO_ODF_traceGroup(CO_ODF_arg_t *ODF_arg) {
+    CO_traceGroup_t *traceGroup;
+    CO_SDO_abortCode_t ret = CO_SDO_AB_NONE;
+
+    traceGroup = (CO_traceGroup_t*) ODF_arg->object;
+
+    switch(ODF_arg->subIndex) {
+    case 1:     /* number of records in buffer */
+        if(ODF_arg->reading) {
+            uint32_t wp = traceGroup->writePtr;
+            uint32_t rp = traceGroup->readPtr;
+
+            CO_setUint32(ODF_arg->data, (wp >= rp) ? (wp - rp) : (traceGroup->recordCount - rp + wp));
+        }
+        else {
+            if(CO_getUint32(ODF_arg->data) == 0) {
+                CO_LOCK_OD();
+                traceGroup->readPtr = traceGroup->writePtr;
+                CO_UNLOCK_OD();
+            }
+            else {
+                ret = CO_SDO_AB_INVALID_VALUE;
+            }
+        }
+        break;
+
+    case 2:     /* records */
+        if(ODF_arg->reading) {
+            if(traceGroup->recordCount == 0 || ODF_arg->dataLength < ((1U + traceGroup->channelCount) * 4U)) {
+                ret = CO_SDO_AB_OUT_OF_MEM;
+            }
+            else if(traceGroup->readPtr == traceGroup->writePtr) {
+                ret = CO_SDO_AB_NO_DATA;
+            }
+            else {
+                ODF_arg->dataLength = CO_traceGroup_read(traceGroup, ODF_arg->data, ODF_arg->dataLength);
+                ODF_arg->lastSegment = (traceGroup->readPtr == traceGroup->writePtr) ? true : false;
+            }
+        }
+        break;
+    }
+
+    return ret;
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_traceGroup_init(
+        CO_traceGroup_t        *traceGroup,
+        CO_SDO_t               *SDO,
+        uint8_t                 enabled,
+        CO_traceChannel_t      *channels,
+        const uint32_t         *map,
+        uint32_t                unsignedChannels,
+        uint8_t                 channelCount,
+        uint32_t               *buffer,
+        uint32_t                bufferSize,
+        uint16_t                idx_OD_traceGroup)
+{
+    uint8_t i;
+
+    /* verify arguments, at least two records fit into buffer */
+    if(traceGroup == NULL || SDO == NULL || channels == NULL || map == NULL ||
+       channelCount == 0 || buffer == NULL || bufferSize < (2U * (1U + channelCount))){
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    /* resolve variables once, process only calls pGetValue */
+    for(i = 0; i < channelCount; i++) {
+        void *OdDataPtr;
+        int dtIndex = 0;
+
+        if(!mapVariable(SDO, map[i], &OdDataPtr, &dtIndex) && OdDataPtr != NULL) {
+            if(i < 32 && (unsignedChannels & (1UL << i)) != 0) {
+                dtIndex += 3;
+            }
+            channels[i].pGetValue = dataTypes[dtIndex].pGetValue;
+            channels[i].OD_variable = OdDataPtr;
+        }
+        else {
+            channels[i].pGetValue = NULL;
+            channels[i].OD_variable = NULL;
+        }
+    }
+
+    traceGroup->enabled = (enabled != 0) ? true : false;
+    traceGroup->channels = channels;
+    traceGroup->channelCount = channelCount;
+    traceGroup->buffer = buffer;
+    traceGroup->recordCount = bufferSize / (1U + channelCount);
+    traceGroup->writePtr = 0;
+    traceGroup->readPtr = 0;
+    traceGroup->lastRecord = NULL;
+
+    if(idx_OD_traceGroup != 0) {
+        CO_OD_configure(SDO, idx_OD_traceGroup, CO_ODF_traceGroup, (void*)traceGroup, 0, 0);
+    }
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+void CO_traceGroup_process(CO_traceGroup_t *traceGroup, uint32_t timestamp) {
+    if(traceGroup->enabled) {
+        uint32_t *rec = &traceGroup->buffer[traceGroup->writePtr * (1U + traceGroup->channelCount)];
+        const uint32_t *last = traceGroup->lastRecord;
+        bool_t changed = (last == NULL || traceGroup->writePtr == traceGroup->readPtr) ? true : false;
+        uint8_t i;
+
+        /* sample all channels directly into the next record */
+        for(i = 0; i < traceGroup->channelCount; i++) {
+            const CO_traceChannel_t *ch = &traceGroup->channels[i];
+            uint32_t val = (ch->pGetValue != NULL) ? (uint32_t) ch->pGetValue(ch->OD_variable) : 0;
+
+            rec[1U + i] = val;
+            if(!changed && val != last[1U + i]) {
+                changed = true;
+            }
+        }
+
+        /* commit record, if any value changed or buffer is empty */
+        if(changed) {
+            rec[0] = timestamp;
+            traceGroup->lastRecord = rec;
+            if(++traceGroup->writePtr == traceGroup->recordCount) {
+                traceGroup->writePtr = 0;
+            }
+            if(traceGroup->writePtr == traceGroup->readPtr) {
+                if(++traceGroup->readPtr == traceGroup->recordCount) {
+                    traceGroup->readPtr = 0;
+                }
+            }
+        }
+    }
+}
+
+
+/******************************************************************************/
+uint32_t CO_traceGroup_read(CO_traceGroup_t *traceGroup, uint8_t *buf, uint32_t size) {
+    uint32_t recordWords = 1U + traceGroup->channelCount;
+    uint32_t len = 0;
+
+    if(traceGroup->recordCount == 0) {
+        return 0;
+    }
+
+    while((size - len) >= (recordWords * 4U)) {
+        const uint32_t *rec;
+        uint32_t rp, i;
+
+        /* CO_traceGroup_process() may move readPtr, if buffer is full */
+        CO_LOCK_OD();
+        rp = traceGroup->readPtr;
+        if(rp == traceGroup->writePtr) {
+            CO_UNLOCK_OD();
+            break;
+        }
+        rec = &traceGroup->buffer[rp * recordWords];
+        for(i = 0; i < recordWords; i++) {
+            CO_memcpySwap4(&buf[len], &rec[i]);
+            len += 4U;
+        }
+        if(++rp == traceGroup->recordCount) {
+            rp = 0;
+        }
+        traceGroup->readPtr = rp;
+        CO_UNLOCK_OD();
+    }
+
+    return len;
+}
@@ -75,6 +75,55 @@ extern "C" {
  * buffer, prints a SVG curve into string and sends it as a SDO response. If a
  * SDO request was received from the same device, then no traffic occupies CAN
  * network.
+ *
+ * ###Delta binary format
+ * With output type 3 (format bits 1..7), points are not printed as text.
+ * Each point is time difference to the previous point as unsigned varint
+ * (little endian base 128, bit 7 set in all but the last byte), followed by
+ * value difference as zigzag varint ((d << 1) ^ (d >> 31)). Previous point of
+ * the first point is (0, 0), so it contains absolute values. Slowly changing
+ * signals take two to four bytes per point instead of 8 in binary and about
+ * 15 in CSV. The same format is used by CO_trace_readDelta() for streaming
+ * over other interfaces.
+ *
+ * ###Capture
+ * By default trace buffer is circular and the oldest points are overwritten.
+ * CO_trace_setCapture() switches trace into single shot capture, similar as
+ * in oscilloscope: trace waits for trigger (see _trigger_ and _threshold_),
+ * records _postTrigger_ more points after the trigger point and then freezes.
+ * Frozen buffer contains at most _preTrigger_ points before the trigger point.
+ * Clearing the buffer (write 0 to trace subindex 1) arms the capture again.
+ * For fast transients CO_trace_process() may be called from a timer interrupt
+ * at rates above 1 kHz.
+ *
+ * ###Compression
+ * By default a point is recorded whenever the value changes, so a noisy signal
+ * fills the buffer at sampling rate. CO_trace_setCompression() sets:
+ *  - _decimation_: only every n-th call of CO_trace_process() takes a sample.
+ *    Trigger, minimum and maximum also see only these samples.
+ *  - #CO_TRACE_COMPRESS_DEADBAND: point is recorded, if the value differs from
+ *    the last recorded value by more than _deadband_. Curve is sample and hold,
+ *    as without compression (deadband 0).
+ *  - #CO_TRACE_COMPRESS_SWINGING_DOOR: recorded points are vertices of a
+ *    piecewise linear curve. Sample is held back, while the line from the last
+ *    recorded point passes all samples since then within _deadband_. Ramps
+ *    and slow drifts then take two points instead of one per step. Reader
+ *    must interpolate linearly between points (SVG output still draws steps).
+ *
+ * Trigger point is always recorded. Line between any two consecutive points
+ * in the buffer stays within the deadband, except that the last segment ends
+ * at the last value (_valuePrev_), which may be held back.
+ *
+ * ###Trace group
+ * CO_traceGroup_t samples several variables with one timestamp. Record in its
+ * buffer is one time word followed by one value word for each channel, so
+ * N variables need 1 + N words per point instead of 2 * N with N traces.
+ * Variables are resolved from their PDO-style maps once, in
+ * CO_traceGroup_init(), and CO_traceGroup_process() only calls _pGetValue_ of
+ * each channel. New record is written, if any of the values changed. Records
+ * are read with CO_traceGroup_read() or, if OD entry is available, with SDO
+ * (subindex 1: number of records, write 0 to clear; subindex 2: domain with
+ * records, all words little endian).
  */
 
 
@@ -87,6 +136,39 @@ extern "C" {
 #endif
 
 
+/**
+ * Maximum time between recorded points with swinging door compression, in
+ * timestamp units. Limits the products of slope comparison to 64 bits.
+ */
+#define CO_TRACE_SWINGING_DOOR_MAX_TIME 0x00FFFFFFUL
+
+
+/**
+ * Maximum length of one point in delta binary format.
+ */
+#define CO_TRACE_DELTA_POINT_MAX    10U
+
+
+/**
+ * State of the capture, see CO_trace_setCapture().
+ */
+typedef enum {
+    CO_TRACE_CAPTURE_OFF        = 0,    /**< Continuous recording, no capture */
+    CO_TRACE_CAPTURE_ARMED      = 1,    /**< Recording, waiting for trigger */
+    CO_TRACE_CAPTURE_TRIGGERED  = 2,    /**< Recording post-trigger points */
+    CO_TRACE_CAPTURE_FROZEN     = 3     /**< Capture complete, recording stopped */
+} CO_trace_capture_t;
+
+
+/**
+ * Compression of recorded points, see CO_trace_setCompression().
+ */
+typedef enum {
+    CO_TRACE_COMPRESS_DEADBAND      = 0, /**< Record changes larger than deadband */
+    CO_TRACE_COMPRESS_SWINGING_DOOR = 1  /**< Record vertices of linear curve */
+} CO_trace_compression_t;
+
+
 /**
  *  structure for reading variables and printing points for specific data type.
  */
@@ -114,6 +196,8 @@ typedef struct {
     volatile uint32_t   writePtr;       /**< Location in buffer, which will be next written. */
     volatile uint32_t   readPtr;        /**< Location in buffer, which will be next read. */
     uint32_t            lastTimeStamp;  /**< Last time stamp. If zero, then last point contains last timestamp. */
+    uint32_t            deltaTime;      /**< Time of the previous point in delta binary format. */
+    uint32_t            deltaValue;     /**< Value of the previous point in delta binary format. */
     void               *OD_variable;    /**< Pointer to variable, which is monitored */
     const CO_trace_dataType_t *dt;      /**< Data type specific function pointers. **/
     int32_t             valuePrev;      /**< Previous value of value. */
@@ -125,9 +209,54 @@ typedef struct {
     uint32_t           *triggerTime;    /**< From CO_trace_init(). */
     uint8_t            *trigger;        /**< From CO_trace_init(). */
     int32_t            *threshold;      /**< From CO_trace_init(). */
+    volatile CO_trace_capture_t captureState; /**< State of the capture. */
+    uint32_t            preTrigger;     /**< From CO_trace_setCapture(). */
+    uint32_t            postTrigger;    /**< From CO_trace_setCapture(). */
+    uint32_t            postCount;      /**< Post-trigger points still to be recorded. */
+    uint32_t            triggerPtr;     /**< Location of the trigger point in buffer. */
+    CO_trace_compression_t compression; /**< From CO_trace_setCompression(). */
+    int32_t             deadband;       /**< From CO_trace_setCompression(). */
+    uint16_t            decimation;     /**< From CO_trace_setCompression(). */
+    uint16_t            decimationCount;/**< Calls of CO_trace_process() since the last sample. */
+    bool_t              archived;       /**< True, if archiveTime and archiveValue are valid. */
+    uint32_t            archiveTime;    /**< Time of the last recorded point. */
+    int32_t             archiveValue;   /**< Value of the last recorded point. */
+    bool_t              held;           /**< True, if a sample is held back (swinging door). */
+    uint32_t            heldTime;       /**< Time of the held sample. */
+    int32_t             heldValue;      /**< Value of the held sample. */
+    int64_t             upperNum;       /**< Upper door slope from archive point, numerator. */
+    uint32_t            upperDen;       /**< Upper door slope, denominator (time). */
+    int64_t             lowerNum;       /**< Lower door slope from archive point, numerator. */
+    uint32_t            lowerDen;       /**< Lower door slope, denominator (time). */
 } CO_trace_t;
 
 
+/**
+ * One channel of the trace group.
+ */
+typedef struct {
+    /** Function pointer for getting the value from OD variable. **/
+    int32_t (*pGetValue) (void *OD_variable);
+    /** Pointer to variable, which is monitored */
+    void               *OD_variable;
+} CO_traceChannel_t;
+
+
+/**
+ * Trace group object, several variables with common timestamp.
+ */
+typedef struct {
+    bool_t              enabled;        /**< True, if trace group is enabled. */
+    CO_traceChannel_t  *channels;       /**< From CO_traceGroup_init(). */
+    uint8_t             channelCount;   /**< From CO_traceGroup_init(). */
+    uint32_t           *buffer;         /**< From CO_traceGroup_init(), records of 1 + channelCount words. */
+    uint32_t            recordCount;    /**< Number of records in the above buffer. */
+    volatile uint32_t   writePtr;       /**< Record in buffer, which will be next written. */
+    volatile uint32_t   readPtr;        /**< Record in buffer, which will be next read. */
+    uint32_t           *lastRecord;     /**< Last written record, NULL if none. */
+} CO_traceGroup_t;
+
+
 /**
  * Initialize trace object.
  *
@@ -183,6 +312,125 @@ void CO_trace_init(
  */
 void CO_trace_process(CO_trace_t *trace, uint32_t timestamp);
 
+
+/**
+ * Configure single shot capture.
+ *
+ * Buffer is cleared and capture is armed. Trigger must be enabled in
+ * _trigger_, otherwise capture never completes.
+ *
+ * @param trace This object.
+ * @param preTrigger Maximum number of points kept before the trigger point.
+ * @param postTrigger Number of points recorded after the trigger point. If
+ * zero, capture is disabled and trace records continuously.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT, if
+ * preTrigger + postTrigger + 1 points don't fit into buffer.
+ */
+CO_ReturnError_t CO_trace_setCapture(CO_trace_t *trace, uint32_t preTrigger, uint32_t postTrigger);
+
+
+/**
+ * Configure compression of recorded points.
+ *
+ * Buffer is not cleared, compression continues from the last recorded point.
+ * Settings are kept until CO_trace_init().
+ *
+ * @param trace This object.
+ * @param compression #CO_trace_compression_t.
+ * @param deadband Allowed deviation of the recorded curve from samples, in
+ * units of the variable. 0 with CO_TRACE_COMPRESS_DEADBAND is the default.
+ * @param decimation Only every n-th call of CO_trace_process() is a sample,
+ * 1 is the default.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_trace_setCompression(
+        CO_trace_t             *trace,
+        CO_trace_compression_t  compression,
+        int32_t                 deadband,
+        uint16_t                decimation);
+
+
+/**
+ * Read points from trace buffer in delta binary format.
+ *
+ * Points are removed from the buffer. Function is used for SDO upload with
+ * output type 3 and for streaming. It must not be called from a thread, which
+ * preempts CO_trace_process().
+ *
+ * @param trace This object.
+ * @param buf Output buffer.
+ * @param size Size of the output buffer, points are written, while at least
+ * #CO_TRACE_DELTA_POINT_MAX bytes are free.
+ * @param absolute If true, first point is written with absolute values.
+ * Otherwise it continues from the last point of the previous call.
+ *
+ * @return Number of bytes written to buf.
+ */
+uint32_t CO_trace_readDelta(CO_trace_t *trace, uint8_t *buf, uint32_t size, bool_t absolute);
+
+
+/**
+ * Initialize trace group object.
+ *
+ * Function must be called in the communication reset section. Channel is
+ * disabled (reads zero), if its map is not valid.
+ *
+ * @param traceGroup This object will be initialized.
+ * @param SDO SDO server object.
+ * @param enabled Is trace group enabled.
+ * @param channels Array of channels, filled by this function.
+ * @param map Array of maps, one for each channel. Same structure as in PDO.
+ * @param unsignedChannels Bit n set means, variable of the channel n is unsigned.
+ * @param channelCount Number of channels and number of elements in above arrays.
+ * @param buffer Memory block for storing records.
+ * @param bufferSize Size of the above buffer in words. Must be at least
+ * 2 * (1 + channelCount).
+ * @param idx_OD_traceGroup Index in Object Dictionary or 0, if not used.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_traceGroup_init(
+        CO_traceGroup_t        *traceGroup,
+        CO_SDO_t               *SDO,
+        uint8_t                 enabled,
+        CO_traceChannel_t      *channels,
+        const uint32_t         *map,
+        uint32_t                unsignedChannels,
+        uint8_t                 channelCount,
+        uint32_t               *buffer,
+        uint32_t                bufferSize,
+        uint16_t                idx_OD_traceGroup);
+
+
+/**
+ * Process trace group object.
+ *
+ * Function must be called cyclically, usually from the same thread as
+ * CO_trace_process().
+ *
+ * @param traceGroup This object.
+ * @param timestamp Timestamp.
+ */
+void CO_traceGroup_process(CO_traceGroup_t *traceGroup, uint32_t timestamp);
+
+
+/**
+ * Read records from trace group buffer.
+ *
+ * Records are removed from the buffer. Each record is time and values of all
+ * channels, 4 bytes each, little endian. Function must not be called from a
+ * thread, which preempts CO_traceGroup_process().
+ *
+ * @param traceGroup This object.
+ * @param buf Output buffer.
+ * @param size Size of the output buffer, only whole records are written.
+ *
+ * @return Number of bytes written to buf.
+ */
+uint32_t CO_traceGroup_read(CO_traceGroup_t *traceGroup, uint8_t *buf, uint32_t size);
+
 #ifdef __cplusplus
 }
 #endif /*__cplusplus*/
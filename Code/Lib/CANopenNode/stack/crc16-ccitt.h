@@ -62,9 +62,28 @@ extern "C" {
  * Equation:
  *
  * `x^16 + x^12 + x^5 + 1`
+ *
+ * If CO_USE_OWN_CRC16 is defined, crc16_ccitt() is provided by the target
+ * (for example by hardware CRC unit) and table version from this file is
+ * available as crc16_ccitt_sw() fallback.
+ *
+ * Table version is byte-wise by default (512 bytes of tables). With
+ * #CO_CRC16_SLICE4 it processes 32 bits per iteration with four tables
+ * (2048 bytes), which removes three of four dependent shift/lookup steps.
  */
 
 
+/** Use slice-by-4 table version */
+#ifndef CO_CRC16_SLICE4
+#define CO_CRC16_SLICE4         0
+#endif
+
+/** Compile all table versions with external linkage, for benchmark */
+#ifndef CO_CRC16_BENCHMARK
+#define CO_CRC16_BENCHMARK      0
+#endif
+
+
 /**
  * Calculate CRC sum on block of data.
  *
@@ -83,6 +102,33 @@ unsigned short crc16_ccitt(
         unsigned int            blockLength,
         unsigned short          crc);
 
+#ifdef CO_USE_OWN_CRC16
+/**
+ * Calculate CRC sum on block of data with table, same as crc16_ccitt().
+ *
+ * Fallback for own crc16_ccitt() implementation, for example if hardware is
+ * busy.
+ */
+unsigned short crc16_ccitt_sw(
+        const unsigned char     block[],
+        unsigned int            blockLength,
+        unsigned short          crc);
+#endif
+
+#if CO_CRC16_BENCHMARK > 0
+/** Byte-wise table version, for benchmark */
+unsigned short crc16_ccitt_byte(
+        const unsigned char     block[],
+        unsigned int            blockLength,
+        unsigned short          crc);
+
+/** Slice-by-4 table version, for benchmark */
+unsigned short crc16_ccitt_slice4(
+        const unsigned char     block[],
+        unsigned int            blockLength,
+        unsigned short          crc);
+#endif
+
 #ifdef __cplusplus
 }
 #endif /*__cplusplus*/
@@ -0,0 +1,83 @@
+#!/usr/bin/env python3
+"""
+Check, that device description matches Object Dictionary in CO_OD.c.
+
+Usage: edscheck.py <eds file> <CO_OD.c>
+
+Index lists of the EDS and of the CO_OD[] table must be equal. For arrays
+and records also SubNumber of the EDS must match max sub-index of CO_OD.c
+plus one. Object lists in [MandatoryObjects], [OptionalObjects] and
+[ManufacturerObjects] must list each object once. Exit status is nonzero
+and differences are printed, if files don't match. Run it after CO_OD.c
+or the EDS is changed, then regenerate CO_EDS_image.c with edszip.py.
+"""
+
+import re
+import sys
+
+ENTRY = re.compile(r"^\{0x([0-9A-Fa-f]{4}),\s*0x([0-9A-Fa-f]{2}),\s*0x([0-9A-Fa-f]{2}),")
+SECTION = re.compile(r"^\[([0-9A-Fa-f]{4})\]\s*$")
+LISTS = ("MandatoryObjects", "OptionalObjects", "ManufacturerObjects")
+
+
+def parse_eds(text):
+    objects = {}
+    listed = []
+    section = None
+    for line in text.splitlines():
+        line = line.strip()
+        if line.startswith("["):
+            m = SECTION.match(line)
+            section = int(m.group(1), 16) if m else line[1:-1]
+            if m:
+                objects[section] = 0
+            continue
+        if "=" not in line or line.startswith(";"):
+            continue
+        key, value = [s.strip() for s in line.split("=", 1)]
+        if isinstance(section, int) and key.lower() == "subnumber":
+            objects[section] = int(value, 0)
+        elif section in LISTS and key.lower() != "supportedobjects":
+            listed.append(int(value, 0))
+    return objects, listed
+
+
+def parse_od(text):
+    objects = {}
+    for line in text.splitlines():
+        m = ENTRY.match(line.strip())
+        if m is not None:
+            objects[int(m.group(1), 16)] = int(m.group(2), 16)
+    return objects
+
+
+def main(argv):
+    if len(argv) < 3:
+        sys.stderr.write(__doc__)
+        return 1
+    with open(argv[1]) as f:
+        eds, listed = parse_eds(f.read())
+    with open(argv[2]) as f:
+        od = parse_od(f.read())
+
+    errors = []
+    for index in sorted(set(od) - set(eds)):
+        errors.append("0x%04X is in %s, missing in %s" % (index, argv[2], argv[1]))
+    for index in sorted(set(eds) - set(od)):
+        errors.append("0x%04X is in %s, missing in %s" % (index, argv[1], argv[2]))
+    for index in sorted(set(eds) & set(od)):
+        if od[index] > 0 and eds[index] != od[index] + 1:
+            errors.append("0x%04X has SubNumber=%d, max sub-index in %s is %d"
+                          % (index, eds[index], argv[2], od[index]))
+    if sorted(listed) != sorted(eds):
+        errors.append("object lists of %s don't match its objects" % argv[1])
+
+    for e in errors:
+        sys.stderr.write("edscheck: %s\n" % e)
+    if not errors:
+        print("edscheck: %d objects match" % len(od))
+    return 1 if errors else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
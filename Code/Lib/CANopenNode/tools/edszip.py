@@ -0,0 +1,157 @@
+#!/usr/bin/env python3
+"""
+Compress device description into C source for object 0x1021, see CO_EDS.h.
+
+Usage: edszip.py <eds or xdd file> <C file> [<window bits>]
+
+Image is "EZ", version 1, window bits and size of the file (UNSIGNED32,
+little endian), followed by LZSS stream. Each control byte describes the
+next eight items, LSB first: bit set is one literal byte, bit clear is
+match of two bytes, little endian: bits 0..11 distance - 1, bits 12..15
+length - 3. Length field 15 is followed by one more byte, length is then
+18 + that byte. Window bits (8 to 12, default 10) must not exceed
+CO_EDS_WINDOW of the firmware. Image is verified by decompression before
+it is written.
+"""
+
+import struct
+import sys
+
+MIN_MATCH = 3
+LONG_MATCH = 18
+MAX_MATCH = LONG_MATCH + 255
+CHAIN = 256
+
+HEADER = """/*
+ * Compressed device description for object 0x1021, see CO_EDS.h.
+ *
+ * This file was automatically generated from %s by tools/edszip.py.
+ * DON'T EDIT THIS FILE MANUALLY !!!!
+ */
+
+
+#include "CO_EDS.h"
+
+#if CO_EDS_STORE > 0
+
+/* %d bytes, %d bytes compressed */
+const uint8_t CO_EDS_image[] = {
+"""
+
+FOOTER = """};
+
+const uint32_t CO_EDS_imageSize = sizeof(CO_EDS_image);
+
+#endif
+"""
+
+
+def compress(data, window_bits):
+    window = 1 << window_bits
+    out = bytearray(b"EZ" + bytes([1, window_bits]) + struct.pack("<I", len(data)))
+    heads = {}
+    prev = [0] * len(data)
+    items = []
+    i = 0
+
+    def insert(pos):
+        if pos + MIN_MATCH <= len(data):
+            key = data[pos:pos + MIN_MATCH]
+            prev[pos] = heads.get(key, -1)
+            heads[key] = pos
+
+    while i < len(data):
+        best_len, best_dist = 0, 0
+        if i + MIN_MATCH <= len(data):
+            candidate = heads.get(data[i:i + MIN_MATCH], -1)
+            chain = CHAIN
+            limit = min(MAX_MATCH, len(data) - i)
+            while candidate >= 0 and i - candidate <= window and chain > 0:
+                length = 0
+                while length < limit and data[candidate + length] == data[i + length]:
+                    length += 1
+                if length > best_len:
+                    best_len, best_dist = length, i - candidate
+                    if length == limit:
+                        break
+                candidate = prev[candidate]
+                chain -= 1
+        if best_len >= MIN_MATCH:
+            if best_len < LONG_MATCH:
+                items.append(struct.pack("<H", (best_dist - 1) | ((best_len - MIN_MATCH) << 12)))
+            else:
+                items.append(struct.pack("<HB", (best_dist - 1) | 0xF000, best_len - LONG_MATCH))
+            for pos in range(i, i + best_len):
+                insert(pos)
+            i += best_len
+        else:
+            items.append(data[i:i + 1])
+            insert(i)
+            i += 1
+
+    for group in range(0, len(items), 8):
+        control = 0
+        chunk = items[group:group + 8]
+        for bit, item in enumerate(chunk):
+            if len(item) == 1:
+                control |= 1 << bit
+        out.append(control)
+        for item in chunk:
+            out += item
+    return bytes(out)
+
+
+def decompress(image):
+    if image[:3] != b"EZ\x01":
+        raise ValueError("bad header")
+    size, = struct.unpack_from("<I", image, 4)
+    out = bytearray()
+    pos = 8
+    while len(out) < size:
+        control = image[pos]
+        pos += 1
+        for bit in range(8):
+            if len(out) >= size:
+                break
+            if control & (1 << bit):
+                out.append(image[pos])
+                pos += 1
+            else:
+                word, = struct.unpack_from("<H", image, pos)
+                pos += 2
+                dist = (word & 0x0FFF) + 1
+                length = (word >> 12) + MIN_MATCH
+                if length == LONG_MATCH:
+                    length += image[pos]
+                    pos += 1
+                for _ in range(length):
+                    out.append(out[-dist])
+    return bytes(out)
+
+
+def main(argv):
+    if len(argv) < 3:
+        sys.stderr.write(__doc__)
+        return 1
+    window_bits = int(argv[3]) if len(argv) > 3 else 10
+    if not 8 <= window_bits <= 12:
+        sys.stderr.write("window bits must be 8 to 12\n")
+        return 1
+    with open(argv[1], "rb") as f:
+        data = f.read()
+    image = compress(data, window_bits)
+    if decompress(image) != data:
+        sys.stderr.write("verification failed\n")
+        return 1
+
+    with open(argv[2], "w") as f:
+        f.write(HEADER % (argv[1].replace("\\", "/").split("/")[-1], len(data), len(image)))
+        for line in range(0, len(image), 16):
+            f.write("    " + " ".join("0x%02X," % b for b in image[line:line + 16]) + "\n")
+        f.write(FOOTER)
+    print("%d bytes, %d bytes compressed (%.1f %%)" % (len(data), len(image), 100.0 * len(image) / len(data)))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
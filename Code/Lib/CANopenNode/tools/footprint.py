@@ -0,0 +1,147 @@
+#!/usr/bin/env python3
+"""
+Flash and RAM footprint of CANopenNode from GNU ld link map.
+
+Usage: footprint.py <map file> [<elf file> [<nm>]]
+
+Table 1 sums input sections of each object file, which are kept in the
+output: code (.text), constants (.rodata), initialized data (.data, counted
+in flash and RAM), zeroed data (.bss, COMMON) and objects in SRAM2
+(.bss.sram2, see CO_ATTR_HOT). Functions in .ramfunc (see CO_RAMFUNC) are
+counted as data, they are copied from flash to SRAM2. Discarded sections
+(--gc-sections) are not counted.
+
+If ELF file is given, table 2 lists statically allocated CANopen objects
+(COO_*, CO_OD_* and trace buffers, see CO_USE_GLOBALS) with their sizes, read
+with nm (default arm-atollic-eabi-nm, or 'nm' for the host build).
+
+Map file is generated with linker option -Wl,-Map=<file>.
+"""
+
+import os
+import re
+import subprocess
+import sys
+from collections import OrderedDict
+
+COLUMNS = ("text", "rodata", "data", "bss", "sram2")
+OBJECT_PREFIXES = ("COO_", "CO_OD_")
+SKIP_PREFIXES = (".debug", ".comment", ".ARM.attributes", ".stab", ".note",
+                 ".gnu", ".group")
+
+LINE_FULL = re.compile(r"^ (\S+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*)$")
+LINE_NAME = re.compile(r"^ (\S+)$")
+LINE_REST = re.compile(r"^\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*)$")
+
+
+def classify(section):
+    if section.startswith(SKIP_PREFIXES):
+        return None
+    if section.startswith(".bss.sram2"):
+        return "sram2"
+    if section.startswith((".bss", "COMMON", ".trace_buffers")):
+        return "bss"
+    if section.startswith((".data", ".ramfunc")):
+        return "data"
+    if section.startswith(".rodata"):
+        return "rodata"
+    if section.startswith((".text", ".isr_vector", ".glue", ".vfp11", ".ARM.ex",
+                           ".init", ".fini", ".preinit_array", ".init_array",
+                           ".fini_array", ".eh_frame")):
+        return "text"
+    return None
+
+
+def module_name(path):
+    path = path.strip()
+    m = re.match(r"(.*)\((.*)\)$", path)
+    if m:
+        return os.path.basename(m.group(1)) + "(" + m.group(2) + ")"
+    return os.path.basename(path)
+
+
+def parse_map(file_name):
+    modules = OrderedDict()
+    in_map = False
+    pending = None
+
+    with open(file_name, errors="replace") as f:
+        for line in f:
+            line = line.rstrip("\r\n")
+            if not in_map:
+                in_map = line.startswith("Linker script and memory map")
+                continue
+
+            entry = None
+            m = LINE_FULL.match(line)
+            if m:
+                entry = (m.group(1), int(m.group(3), 16), m.group(4))
+                pending = None
+            elif pending is not None:
+                m = LINE_REST.match(line)
+                if m:
+                    entry = (pending, int(m.group(2), 16), m.group(3))
+                pending = None
+            else:
+                m = LINE_NAME.match(line)
+                if m:
+                    pending = m.group(1)
+
+            if entry is None:
+                continue
+            section, size, path = entry
+            kind = classify(section)
+            if kind is None or size == 0 or path.startswith("0x") or "=" in path:
+                continue
+            sizes = modules.setdefault(module_name(path), dict.fromkeys(COLUMNS, 0))
+            sizes[kind] += size
+
+    return modules
+
+
+def print_modules(modules):
+    print("%-32s %8s %8s %8s %8s %8s %8s %8s" % (("module",) + COLUMNS + ("flash", "ram")))
+    total = dict.fromkeys(COLUMNS, 0)
+    rows = []
+    for name, s in modules.items():
+        flash = s["text"] + s["rodata"] + s["data"]
+        ram = s["data"] + s["bss"] + s["sram2"]
+        rows.append((flash + ram, name, s, flash, ram))
+        for c in COLUMNS:
+            total[c] += s[c]
+    for _, name, s, flash, ram in sorted(rows, key=lambda r: -r[0]):
+        print("%-32s %8d %8d %8d %8d %8d %8d %8d" % ((name,) + tuple(s[c] for c in COLUMNS) + (flash, ram)))
+    flash = total["text"] + total["rodata"] + total["data"]
+    ram = total["data"] + total["bss"] + total["sram2"]
+    print("%-32s %8d %8d %8d %8d %8d %8d %8d" % (("total",) + tuple(total[c] for c in COLUMNS) + (flash, ram)))
+
+
+def print_objects(elf, nm):
+    out = subprocess.run([nm, "-S", "--size-sort", "-t", "d", elf],
+                         check=True, stdout=subprocess.PIPE, universal_newlines=True).stdout
+    objects = []
+    for line in out.splitlines():
+        parts = line.split()
+        if len(parts) != 4:
+            continue
+        size, kind, name = int(parts[1]), parts[2], parts[3]
+        if kind in "bBdDrR" and (name.startswith(OBJECT_PREFIXES) or "trace" in name.lower()):
+            objects.append((size, name, "RAM" if kind in "bBdD" else "flash"))
+    print()
+    print("%-40s %6s %8s" % ("static object", "memory", "size"))
+    for size, name, mem in sorted(objects, reverse=True):
+        print("%-40s %6s %8d" % (name, mem, size))
+
+
+def main(argv):
+    if len(argv) < 2:
+        sys.stderr.write(__doc__)
+        return 1
+    print_modules(parse_map(argv[1]))
+    if len(argv) > 2:
+        print_objects(argv[2], argv[3] if len(argv) > 3 else "arm-atollic-eabi-nm")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
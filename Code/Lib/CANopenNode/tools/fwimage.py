@@ -0,0 +1,45 @@
+#!/usr/bin/env python3
+"""
+Append the program download trailer to application binary, see CO_fwUpdate.h.
+
+Usage: fwimage.py <binary> <image> [<download region size>]
+
+Binary is the raw application image (arm-none-eabi-objcopy -O binary) linked
+below CO_FW_FLASH_ADDRESS. Trailer is "CFW1", crc16_ccitt() of the binary
+and its complement, little endian. Image is written to 0x1F50,1 after
+0x1F51,1 = 3 (clear program) finished, then 0x1F51,1 = 1 starts it.
+Download region size defaults to CO_FW_FLASH_SIZE (0xF000).
+"""
+
+import binascii
+import struct
+import sys
+
+MAGIC = 0x31574643
+TRAILER_SIZE = 8
+
+
+def main(argv):
+    if len(argv) < 3:
+        sys.stderr.write(__doc__)
+        return 1
+    region = int(argv[3], 0) if len(argv) > 3 else 0xF000
+
+    with open(argv[1], "rb") as f:
+        binary = f.read()
+    if len(binary) + TRAILER_SIZE > region:
+        sys.stderr.write("image with trailer is %d bytes, download region has %d\n"
+                         % (len(binary) + TRAILER_SIZE, region))
+        return 1
+
+    # crc16_ccitt() with initial value 0 is CRC-16/XMODEM
+    crc = binascii.crc_hqx(binary, 0)
+    with open(argv[2], "wb") as f:
+        f.write(binary)
+        f.write(struct.pack("<IHH", MAGIC, crc, crc ^ 0xFFFF))
+    print("%s: %d bytes, crc 0x%04X" % (argv[2], len(binary) + TRAILER_SIZE, crc))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -0,0 +1,105 @@
+#!/usr/bin/env python3
+"""
+Timeline of stack events from raw SWO capture, see CO_ITM_TRACE.
+
+Usage: itmtrace.py <swo file> [<first port> [<cpu hz>]]
+
+SWO file contains raw ITM packets, as saved by the debugger probe (for
+example SWV trace log or orbuculum). Events use stimulus ports from first
+port (CO_ITM_PORT, default 8) on, other ports are ignored. Local timestamps
+are used if enabled in ITM (TSENA), time is then printed in microseconds at
+cpu hz (default 80 MHz), otherwise only the order of events is known.
+"""
+
+import sys
+
+EVENTS = ["CAN_RX", "CAN_TX", "SYNC", "RPDO", "TPDO", "SDO"]
+SDO_STATES = {
+    0x00: "IDLE", 0x11: "DOWNLOAD_INITIATE", 0x12: "DOWNLOAD_SEGMENTED",
+    0x14: "DOWNLOAD_BL_INITIATE", 0x15: "DOWNLOAD_BL_SUBBLOCK",
+    0x16: "DOWNLOAD_BL_SUB_RESP", 0x17: "DOWNLOAD_BL_END",
+    0x21: "UPLOAD_INITIATE", 0x22: "UPLOAD_SEGMENTED",
+    0x24: "UPLOAD_BL_INITIATE", 0x25: "UPLOAD_BL_INITIATE_2",
+    0x26: "UPLOAD_BL_SUBBLOCK", 0x27: "UPLOAD_BL_END",
+}
+
+
+def describe(event, value):
+    if event in ("CAN_RX", "RPDO", "TPDO"):
+        return "0x%03X" % value
+    if event == "CAN_TX":
+        return "0x%03X%s" % (value & 0x7FFF, " overflow" if value & 0x8000 else "")
+    if event == "SYNC":
+        kind = {1: "sync", 2: "window end"}.get(value >> 8, "?")
+        return "%s counter %d" % (kind, value & 0xFF)
+    state = SDO_STATES.get(value >> 8, "0x%02X" % (value >> 8))
+    command = "" if (value & 0xFF) == 0xFF else " request 0x%02X" % (value & 0xFF)
+    return state + command
+
+
+def packets(data):
+    """Yield ("ts", delta), ("sw", port, value) and ("overflow",)."""
+    i = 0
+    while i < len(data):
+        header = data[i]
+        i += 1
+        if header == 0x00 or header == 0x80:
+            continue                        # synchronization
+        if header == 0x70:
+            yield ("overflow",)
+            continue
+        if header & 0x0F == 0x00:
+            # local timestamp, one byte or with continuation bytes
+            if header & 0x80 == 0:
+                yield ("ts", (header >> 4) & 0x07)
+                continue
+            delta, shift = 0, 0
+            while i < len(data):
+                byte = data[i]
+                i += 1
+                delta |= (byte & 0x7F) << shift
+                shift += 7
+                if byte & 0x80 == 0:
+                    break
+            yield ("ts", delta)
+            continue
+        if header & 0x03 == 0:
+            # global timestamp or extension, skip continuation bytes
+            while header & 0x80 and i < len(data):
+                header = data[i]
+                i += 1
+            continue
+        size = {1: 1, 2: 2, 3: 4}[header & 0x03]
+        payload = data[i:i + size]
+        i += size
+        if header & 0x04 == 0 and len(payload) == size:
+            yield ("sw", header >> 3, int.from_bytes(payload, "little"))
+
+
+def main():
+    if len(sys.argv) < 2:
+        sys.exit(__doc__.strip())
+    with open(sys.argv[1], "rb") as f:
+        data = f.read()
+    first = int(sys.argv[2], 0) if len(sys.argv) > 2 else 8
+    hz = float(sys.argv[3]) if len(sys.argv) > 3 else 80e6
+
+    cycles = 0
+    pending = []
+    for packet in packets(data):
+        if packet[0] == "overflow":
+            print("%12s  ITM overflow, events lost" % "")
+        elif packet[0] == "ts":
+            # timestamp follows the events it belongs to
+            cycles += packet[1]
+            for event, value in pending:
+                print("%12.1f  %-6s %s" % (cycles * 1e6 / hz, event, describe(event, value)))
+            pending = []
+        elif first <= packet[1] < first + len(EVENTS):
+            pending.append((EVENTS[packet[1] - first], packet[2] & 0xFFFF))
+    for event, value in pending:
+        print("%12s  %-6s %s" % ("", event, describe(event, value)))
+
+
+if __name__ == "__main__":
+    main()
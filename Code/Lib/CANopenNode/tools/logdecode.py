@@ -0,0 +1,106 @@
+#!/usr/bin/env python3
+"""
+Messages from binary log captured on UART, see CO_log.h.
+
+Usage: logdecode.py <elf file> <capture file> [<cpu hz>]
+
+ELF file is the firmware, which produced the log, format strings are read
+from its .co_log section. Capture file contains raw bytes received from the
+UART, for example from `cat /dev/ttyUSB0 > capture.bin`. Time is printed in
+microseconds at cpu hz (default 80 MHz) relative to the first record, DWT
+cycle counter wraps are unwrapped assuming records are less than one wrap
+(53 s at 80 MHz) apart.
+"""
+
+import re
+import struct
+import sys
+
+START = 0xA5
+ARGS_MAX = 4
+FLAG_LOST = 0x10
+CONVERSION = re.compile(r"%([-+ 0#]*\d*(?:\.\d+)?)(?:hh|h|ll|l|z|t|j)?([diuxXc%])")
+
+
+def sections(elf):
+    """Return dictionary of section name: bytes of 32-bit little endian ELF."""
+    if elf[:4] != b"\x7fELF" or elf[4] != 1 or elf[5] != 1:
+        sys.exit("not a 32-bit little endian ELF file")
+    shoff, = struct.unpack_from("<I", elf, 0x20)
+    shentsize, shnum, shstrndx = struct.unpack_from("<HHH", elf, 0x2E)
+    headers = [struct.unpack_from("<IIIIIIIIII", elf, shoff + i * shentsize)
+               for i in range(shnum)]
+    names = headers[shstrndx]
+    result = {}
+    for name, _type, _flags, _addr, offset, size, *_ in headers:
+        start = names[4] + name
+        key = elf[start:elf.index(b"\0", start)].decode()
+        result[key] = elf[offset:offset + size]
+    return result
+
+
+def format_message(fmt, args):
+    """printf() with integer conversions, arguments are uint32_t."""
+    values = iter(args)
+
+    def convert(match):
+        flags, conversion = match.group(1), match.group(2)
+        if conversion == "%":
+            return "%"
+        value = next(values, 0)
+        if conversion in "di":
+            value = value - (1 << 32) if value & 0x80000000 else value
+            conversion = "d"
+        elif conversion == "u":
+            conversion = "d"
+        elif conversion == "c":
+            value = value & 0xFF
+        return ("%" + flags + conversion) % value
+
+    return CONVERSION.sub(convert, fmt)
+
+
+def records(data):
+    """Yield (id, flags, timestamp, args), resynchronize on start byte."""
+    i = 0
+    while i + 8 <= len(data):
+        if data[i] != START or (data[i + 1] & 0x0F) > ARGS_MAX:
+            i += 1
+            continue
+        n = data[i + 1] & 0x0F
+        if i + 8 + 4 * n > len(data):
+            break
+        msg_id, timestamp = struct.unpack_from("<HI", data, i + 2)
+        args = struct.unpack_from("<%dI" % n, data, i + 8)
+        yield msg_id, data[i + 1] & 0xF0, timestamp, args
+        i += 8 + 4 * n
+
+
+def main():
+    if len(sys.argv) < 3:
+        sys.exit(__doc__.strip())
+    with open(sys.argv[1], "rb") as f:
+        strings = sections(f.read()).get(".co_log")
+    if strings is None:
+        sys.exit("no .co_log section in %s" % sys.argv[1])
+    with open(sys.argv[2], "rb") as f:
+        data = f.read()
+    hz = float(sys.argv[3]) if len(sys.argv) > 3 else 80e6
+
+    cycles = None
+    last = 0
+    for msg_id, flags, timestamp, args in records(data):
+        cycles = 0 if cycles is None else cycles + ((timestamp - last) & 0xFFFFFFFF)
+        last = timestamp
+        if flags & FLAG_LOST:
+            print("%12s  records lost" % "")
+        end = strings.find(b"\0", msg_id)
+        if msg_id >= len(strings) or end < 0:
+            text = "unknown message 0x%04X %s" % (msg_id, " ".join("0x%X" % a for a in args))
+        else:
+            text = format_message(strings[msg_id:end].decode(errors="replace"), args)
+        print("%12.1f  %s" % (cycles * 1e6 / hz, text))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,86 @@
+#!/usr/bin/env python3
+"""
+Generate CO_OD.hpp, typed C++ access to Object Dictionary, see CO_ODtyped.hpp.
+
+Usage: odcpp.py <CO_OD.c> <CO_OD.hpp>
+
+Every variable of the CO_OD[] table in CO_OD.c gets CO::ODentry<index,
+subIndex> with its attribute. Subindex 0 of arrays holds no variable and is
+skipped, the same as domains. Run again after CO_OD.c is regenerated.
+"""
+
+import re
+import sys
+
+ENTRY = re.compile(r"^\{0x([0-9A-Fa-f]{4}),\s*0x([0-9A-Fa-f]{2}),\s*0x([0-9A-Fa-f]{2}),\s*(\d+),\s*(.*)\},?\s*$")
+RECORD = re.compile(r"/\*0x([0-9A-Fa-f]{4})\*/\s*const CO_OD_entryRecord_t OD_record\w+\[\d+\]\s*=\s*\{(.*?)\};", re.S)
+RECORD_ITEM = re.compile(r"\{\s*(0|\(void\*\)&([^,]+)),\s*0x([0-9A-Fa-f]{2}),\s*(\d+)\s*\}")
+VAR = re.compile(r"\(void\*\)&(.+)$")
+
+HEADER = """/*
+ * Typed C++ access to CANopen Object Dictionary, see CO_ODtyped.hpp.
+ *
+ * This file was automatically generated from %s by tools/odcpp.py.
+ * DON'T EDIT THIS FILE MANUALLY !!!!
+ */
+
+
+#ifndef CO_OD_HPP
+#define CO_OD_HPP
+
+extern "C" {
+#include "CO_OD.h"
+}
+#include "CO_ODtyped.hpp"
+
+"""
+
+
+def main(argv):
+    if len(argv) < 3:
+        sys.stderr.write(__doc__)
+        return 1
+    with open(argv[1]) as f:
+        source = f.read()
+
+    records = {}
+    for m in RECORD.finditer(source):
+        records[int(m.group(1), 16)] = [(i.group(2), int(i.group(3), 16))
+                                        for i in RECORD_ITEM.finditer(m.group(2))]
+
+    lines = []
+    for line in source.splitlines():
+        m = ENTRY.match(line.strip())
+        if m is None:
+            continue
+        index = int(m.group(1), 16)
+        maxSubIndex = int(m.group(2), 16)
+        attribute = int(m.group(3), 16)
+        var = VAR.match(m.group(5).strip())
+
+        if var is None:
+            continue                                    # domain
+        var = var.group(1).strip()
+        if index in records and var.startswith("OD_record"):
+            for sub, (expr, attr) in enumerate(records[index]):
+                if expr is not None:
+                    lines.append((index, sub, attr, expr.strip()))
+        elif maxSubIndex == 0:
+            # string or octet string is the whole array
+            lines.append((index, 0, attribute, var[:-3] if var.endswith("[0]") else var))
+        else:
+            base = var[:-3]
+            for sub in range(1, maxSubIndex + 1):
+                lines.append((index, sub, attribute, "%s[%d]" % (base, sub - 1)))
+
+    with open(argv[2], "w") as f:
+        f.write(HEADER % argv[1].split("/")[-1])
+        for index, sub, attr, expr in lines:
+            f.write("CO_OD_ENTRY(0x%04X, 0x%02X, 0x%02X, %s)\n" % (index, sub, attr, expr))
+        f.write("\n#endif /* CO_OD_HPP */\n")
+    print("%s: %d variables" % (argv[2], len(lines)))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -0,0 +1,101 @@
+#!/usr/bin/env python3
+"""
+Hotspots from PC sampling histogram of CO_profilePC (OD 0x2144).
+
+Usage: pcprof.py <histogram file> <elf file> [<bucket size> [<nm>]]
+
+Histogram file contains raw data of the uploaded domain 0x2144: UNSIGNED16
+counts, little endian, bucket n covers addresses FLASH_BASE + n * size.
+Bucket size is read from 0x2143,4 (default 512). Symbols are read with nm
+(default arm-atollic-eabi-nm).
+
+Table 1 lists buckets by count with functions, which overlap the bucket.
+Table 2 divides count of each bucket between its functions by overlapped
+size and sums it per function. Resolution of both is one bucket, so small
+functions inside a hot bucket share its samples with their neighbours.
+"""
+
+import struct
+import subprocess
+import sys
+
+FLASH_BASE = 0x08000000
+TOP = 20
+
+
+def read_histogram(file_name):
+    with open(file_name, "rb") as f:
+        data = f.read()
+    if len(data) % 2 != 0:
+        sys.exit("histogram length must be even")
+    return struct.unpack("<%dH" % (len(data) // 2), data)
+
+
+def read_functions(elf_name, nm):
+    out = subprocess.run([nm, "-S", "-C", "--defined-only", elf_name],
+                         check=True, stdout=subprocess.PIPE,
+                         universal_newlines=True).stdout
+    functions = []
+    for line in out.splitlines():
+        fields = line.split(None, 3)
+        if len(fields) != 4 or fields[2] not in "tTwW":
+            continue
+        address = int(fields[0], 16) & ~1
+        size = int(fields[1], 16)
+        if size > 0:
+            functions.append((address, size, fields[3]))
+    functions.sort()
+    return functions
+
+
+def overlaps(functions, start, end):
+    for address, size, name in functions:
+        lo = max(address, start)
+        hi = min(address + size, end)
+        if lo < hi:
+            yield name, hi - lo
+
+
+def main():
+    if len(sys.argv) < 3:
+        sys.exit(__doc__.strip())
+    hist = read_histogram(sys.argv[1])
+    bucket = int(sys.argv[3], 0) if len(sys.argv) > 3 else 512
+    nm = sys.argv[4] if len(sys.argv) > 4 else "arm-atollic-eabi-nm"
+    functions = read_functions(sys.argv[2], nm)
+
+    total = sum(hist)
+    if total == 0:
+        sys.exit("histogram is empty")
+
+    print("%-12s %8s %6s  %s" % ("bucket", "samples", "%", "functions"))
+    order = sorted(range(len(hist)), key=lambda n: hist[n], reverse=True)
+    for n in order[:TOP]:
+        if hist[n] == 0:
+            break
+        start = FLASH_BASE + n * bucket
+        names = [name for name, _ in overlaps(functions, start, start + bucket)]
+        print("0x%08X   %8d %6.2f  %s" % (start, hist[n], 100.0 * hist[n] / total,
+                                          ", ".join(names) or "?"))
+
+    per_function = {}
+    for n, count in enumerate(hist):
+        if count == 0:
+            continue
+        start = FLASH_BASE + n * bucket
+        parts = list(overlaps(functions, start, start + bucket))
+        covered = sum(size for _, size in parts)
+        if covered == 0:
+            parts, covered = [("?", 1)], 1
+        for name, size in parts:
+            per_function[name] = per_function.get(name, 0.0) + count * size / covered
+
+    print()
+    print("%-40s %10s %6s" % ("function", "samples", "%"))
+    for name, count in sorted(per_function.items(), key=lambda x: x[1], reverse=True)[:TOP]:
+        print("%-40s %10.1f %6.2f" % (name[:40], count, 100.0 * count / total))
+    print("%-40s %10d" % ("total", total))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,590 @@
+/*
+ * CAN traffic recorder into external SPI flash for STM32L4.
+ *
+ * @file        CO_CANrecorder.c
+ * @ingroup     CO_CANrecorder
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * CANopenNode is free and open source software: you can redistribute
+ * it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Following clarification and special exception to the GNU General Public
+ * License is included to the distribution terms of CANopenNode:
+ *
+ * Linking this library statically or dynamically with other modules is
+ * making a combined work based on this library. Thus, the terms and
+ * conditions of the GNU General Public License cover the whole combination.
+ *
+ * As a special exception, the copyright holders of this library give
+ * you permission to link this library with independent modules to
+ * produce an executable, regardless of the license terms of these
+ * independent modules, and to copy and distribute the resulting
+ * executable under terms of your choice, provided that you also meet,
+ * for each linked independent module, the terms and conditions of the
+ * license of that module. An independent module is a module which is
+ * not derived from or based on this library. If you modify this
+ * library, you may extend this exception to your version of the
+ * library, but you are not obliged to do so. If you do not wish
+ * to do so, delete this exception statement from your version.
+ */
+
+
+
+#include "spi.h"
+#include "main.h"
+#include "CO_driver.h"
+#include "CO_SDO.h"
+#include "CO_OD.h"
+#include "CO_eeprom.h"
+#include "CO_CANrecorder.h"
+
+#if CO_CAN_RECORDER > 0
+
+#if CO_CAN_RECORDER > 0x8000
+#error CO_CAN_RECORDER must not exceed 0x8000 records
+#endif
+#if CO_EE_BACKEND == CO_EE_BACKEND_SPI
+#error CO_CAN_RECORDER and CO_EE_BACKEND_SPI share hspi3 and its chip select
+#endif
+#if (CO_CAN_REC_FLASH_SIZE & (CO_CAN_REC_FLASH_SIZE - 1)) != 0 || CO_CAN_REC_FLASH_SIZE < (2 * CO_CAN_REC_ERASE_SIZE)
+#error CO_CAN_REC_FLASH_SIZE must be power of two and at least two erase units
+#endif
+#if CO_CAN_REC_ERASE_SIZE != 4096 && CO_CAN_REC_ERASE_SIZE != 65536
+#error CO_CAN_REC_ERASE_SIZE must be 4096 or 65536
+#endif
+
+/* Flash commands, 25-series NOR flash with 24-bit address */
+#define FLASH_CMD_WREN          0x06U
+#define FLASH_CMD_RDSR          0x05U
+#define FLASH_CMD_READ          0x03U
+#define FLASH_CMD_PP            0x02U
+#if CO_CAN_REC_ERASE_SIZE == 4096
+#define FLASH_CMD_ERASE         0x20U
+#else
+#define FLASH_CMD_ERASE         0xD8U
+#endif
+#define FLASH_SR_WIP            0x01U
+
+/* Flash writer states */
+#define CO_CAN_REC_FLASH_IDLE   0U  /* SPI is free */
+#define CO_CAN_REC_FLASH_DMA    1U  /* Page program data is sent by DMA */
+#define CO_CAN_REC_FLASH_BUSY   2U  /* Flash programs or erases */
+#define CO_CAN_REC_FLASH_READ   3U  /* Log is read by DMA for SDO upload */
+
+/* Erase of the whole log */
+#define CO_CAN_REC_ERASE_NONE       0U
+#define CO_CAN_REC_ERASE_REQUEST    1U  /* From CO_CANrecorder_command() */
+#define CO_CAN_REC_ERASE_RUNNING    2U  /* Erase units one by one */
+
+/* Sub-indexes of 0x2146 before filters */
+#define CO_CAN_REC_OD_VALUES    6U
+
+#define CO_CAN_REC_SIZE         ((uint32_t)sizeof(CO_CANrecord_t))
+#define CO_CAN_REC_ADDR(counter) ((counter) & (CO_CAN_REC_FLASH_SIZE - 1U))
+
+
+#ifdef ODL_CANrecorder_arrayLength
+#if ODL_CANrecorder_arrayLength != (CO_CAN_REC_OD_VALUES + CO_CAN_REC_FILTERS)
+#error OD 0x2146 must have 6 + CO_CAN_REC_FILTERS sub-indexes
+#endif
+static CO_SDO_abortCode_t CO_ODF_CANrecorder(CO_ODF_arg_t *ODF_arg);
+static CO_SDO_abortCode_t CO_ODF_CANrecorderData(CO_ODF_arg_t *ODF_arg);
+#endif
+
+
+/*
+ * Compare 11-bit identifier with filter, CO_CAN_REC_ENABLE must be set.
+ */
+static inline bool_t CO_CANrecorder_match(uint32_t ident, uint32_t filter){
+    return (((ident ^ filter) & (filter >> 16) & 0x7FFU) == 0U) ? true : false;
+}
+
+
+/*
+ * Send command with optional 24-bit address, chip select stays active.
+ */
+static bool_t CO_CANrecorder_cmd(uint8_t cmd, bool_t withAddress, uint32_t address){
+    uint8_t buf[4];
+
+    buf[0] = cmd;
+    buf[1] = (uint8_t)(address >> 16);
+    buf[2] = (uint8_t)(address >> 8);
+    buf[3] = (uint8_t)address;
+    HAL_GPIO_WritePin(CO_CAN_REC_CS_PORT, CO_CAN_REC_CS_PIN, GPIO_PIN_RESET);
+    if(HAL_SPI_Transmit(&hspi3, buf, withAddress ? 4U : 1U, CO_CAN_REC_SPI_TIMEOUT) != HAL_OK){
+        HAL_GPIO_WritePin(CO_CAN_REC_CS_PORT, CO_CAN_REC_CS_PIN, GPIO_PIN_SET);
+        return false;
+    }
+    return true;
+}
+
+
+/*
+ * Send write enable and command with address, chip select is released.
+ */
+static bool_t CO_CANrecorder_writeCmd(uint8_t cmd, uint32_t address){
+    if(!CO_CANrecorder_cmd(FLASH_CMD_WREN, false, 0U)){
+        return false;
+    }
+    HAL_GPIO_WritePin(CO_CAN_REC_CS_PORT, CO_CAN_REC_CS_PIN, GPIO_PIN_SET);
+    return CO_CANrecorder_cmd(cmd, true, address);
+}
+
+
+/*
+ * Shorten the log, so it does not contain erased bytes ahead of written.
+ */
+static void CO_CANrecorder_limitLength(CO_CANrecorder_t *rec){
+    uint32_t valid = CO_CAN_REC_FLASH_SIZE - (rec->erased - rec->written);
+
+    if(rec->length > valid){
+        rec->length = valid;
+    }
+}
+
+
+#ifdef ODL_CANrecorder_arrayLength
+/*
+ * Function for accessing _CAN recorder_ (index 0x2146) from SDO server.
+ */
+static CO_SDO_abortCode_t CO_ODF_CANrecorder(CO_ODF_arg_t *ODF_arg){
+    CO_CANrecorder_t *rec = (CO_CANrecorder_t*)ODF_arg->object;
+    uint8_t n = ODF_arg->subIndex;
+    uint32_t value;
+
+    if(n == 0U){
+        return CO_SDO_AB_NONE;
+    }
+
+    if(!ODF_arg->reading){
+        value = CO_getUint32(ODF_arg->data);
+        switch(n){
+            case 1U:
+                if(!CO_CANrecorder_command(rec, value)){
+                    return CO_SDO_AB_INVALID_VALUE;
+                }
+                break;
+            case 2U:
+                CO_LOCK_CAN_SEND();
+                rec->trigger = value;
+                CO_UNLOCK_CAN_SEND();
+                break;
+            case 3U:
+                CO_LOCK_CAN_SEND();
+                rec->postTrigger = value;
+                CO_UNLOCK_CAN_SEND();
+                break;
+            case 4U: case 5U: case 6U:
+                return CO_SDO_AB_READONLY;
+            default:
+                CO_LOCK_CAN_SEND();
+                rec->filter[n - 1U - CO_CAN_REC_OD_VALUES] = value;
+                CO_UNLOCK_CAN_SEND();
+                break;
+        }
+        return CO_SDO_AB_NONE;
+    }
+
+    switch(n){
+        case 1U:  value = rec->state;        break;
+        case 2U:  value = rec->trigger;      break;
+        case 3U:  value = rec->postTrigger;  break;
+        case 4U:  value = rec->length;       break;
+        case 5U:  value = rec->lost;         break;
+        case 6U:  value = rec->errors;       break;
+        default:  value = rec->filter[n - 1U - CO_CAN_REC_OD_VALUES];  break;
+    }
+    CO_setUint32(ODF_arg->data, value);
+
+    return CO_SDO_AB_NONE;
+}
+
+
+#if CO_SDO_DOMAIN_PREFETCH > 0
+/*
+ * Start read of the log by DMA, completed by CO_CANrecorder_process().
+ * Read across the flash end is not started.
+ */
+static bool_t CO_CANrecorder_readStart(CO_CANrecorder_t *rec, void *SDO, uint32_t offset, uint8_t *data, uint16_t length){
+    uint32_t address = CO_CAN_REC_ADDR(rec->written - rec->length + offset);
+
+    if((CO_CAN_REC_FLASH_SIZE - address) < length){
+        return false;
+    }
+    if(!CO_CANrecorder_cmd(FLASH_CMD_READ, true, address)){
+        return false;
+    }
+    if(HAL_SPI_Receive_DMA(&hspi3, data, length) != HAL_OK){
+        HAL_GPIO_WritePin(CO_CAN_REC_CS_PORT, CO_CAN_REC_CS_PIN, GPIO_PIN_SET);
+        return false;
+    }
+    rec->readSDO = SDO;
+    rec->readError = false;
+    rec->flash = CO_CAN_REC_FLASH_READ;
+    return true;
+}
+#endif
+
+
+/*
+ * Function for accessing _CAN recorder data_ (index 0x2147) from SDO server.
+ * Log is read from flash segment by segment.
+ */
+static CO_SDO_abortCode_t CO_ODF_CANrecorderData(CO_ODF_arg_t *ODF_arg){
+    CO_CANrecorder_t *rec = (CO_CANrecorder_t*)ODF_arg->object;
+    uint32_t remaining;
+    uint16_t length = ODF_arg->dataLength;
+    bool_t lastSegment = false;
+
+    if(!ODF_arg->reading){
+        return CO_SDO_AB_READONLY;
+    }
+    if(!CO_CANrecorder_isIdle(rec)){
+        return CO_SDO_AB_DATA_DEV_STATE;
+    }
+
+    if(ODF_arg->firstSegment){
+        if(rec->length == 0U){
+            return CO_SDO_AB_NO_DATA;
+        }
+        ODF_arg->dataLengthTotal = rec->length;
+    }
+
+    remaining = rec->length - ODF_arg->offset;
+    if(remaining <= length){
+        length = (uint16_t)remaining;
+        lastSegment = true;
+    }
+
+#if CO_SDO_DOMAIN_PREFETCH > 0
+    if(ODF_arg->resumed){
+        /* read by DMA is finished */
+        if(rec->readError){
+            return CO_SDO_AB_HW;
+        }
+    }
+    else if(CO_CANrecorder_readStart(rec, ODF_arg->SDO, ODF_arg->offset, ODF_arg->data, length)){
+        return CO_SDO_AB_PENDING;
+    }
+    else if(!CO_CANrecorder_read(rec, ODF_arg->offset, ODF_arg->data, length)){
+        return CO_SDO_AB_HW;
+    }
+#else
+    if(!CO_CANrecorder_read(rec, ODF_arg->offset, ODF_arg->data, length)){
+        return CO_SDO_AB_HW;
+    }
+#endif
+    ODF_arg->dataLength = length;
+    ODF_arg->lastSegment = lastSegment;
+
+    return CO_SDO_AB_NONE;
+}
+#endif
+
+
+/******************************************************************************/
+void CO_CANrecorder_init_1(CO_CANrecorder_t *rec){
+    uint8_t i;
+
+    rec->head = 0U;
+    rec->tail = 0U;
+    rec->state = CO_CAN_REC_STOPPED;
+    for(i = 0U; i < CO_CAN_REC_FILTERS; i++){
+        rec->filter[i] = 0U;
+    }
+    rec->trigger = 0U;
+    rec->postTrigger = 0U;
+    rec->postCount = 0U;
+    rec->lost = 0U;
+    rec->time = 0U;
+    rec->tick = 0U;
+    rec->bitsPerMs = 0U;
+    rec->flash = CO_CAN_REC_FLASH_IDLE;
+    rec->erase = CO_CAN_REC_ERASE_NONE;
+    rec->chunk = 0U;
+    /* previous runs stay readable, new records overwrite them from address 0 */
+    rec->written = 0U;
+    rec->erased = 0U;
+    rec->length = CO_CAN_REC_FLASH_SIZE;
+    rec->errors = 0U;
+#if CO_SDO_DOMAIN_PREFETCH > 0
+    rec->readSDO = NULL;
+    rec->readError = false;
+#endif
+}
+
+
+/******************************************************************************/
+void CO_CANrecorder_init_2(CO_CANrecorder_t *rec, CO_CANmodule_t *CANmodule, CO_SDO_t *SDO){
+    CO_LOCK_CAN_SEND();
+    rec->bitsPerMs = CANmodule->CANbitRate;
+    rec->tick = HAL_GetTick();
+    CANmodule->recorder = (void*)rec;
+    CO_UNLOCK_CAN_SEND();
+
+#ifdef ODL_CANrecorder_arrayLength
+    if(SDO != NULL){
+        CO_OD_configure(SDO, CO_CAN_REC_OD_INDEX, CO_ODF_CANrecorder, (void*)rec, 0, 0U);
+        CO_OD_configure(SDO, CO_CAN_REC_DATA_OD_INDEX, CO_ODF_CANrecorderData, (void*)rec, 0, 0U);
+    }
+#else
+    (void)SDO;
+#endif
+}
+
+
+/******************************************************************************/
+CO_RAMFUNC void CO_CANrecorder_put(CO_CANrecorder_t *rec, uint32_t IR, uint32_t DTR, uint32_t DLR, uint32_t DHR){
+    uint32_t ident = IR >> CAN_RI0R_STID_Pos;
+    uint32_t tick, approx, time;
+    int32_t diff;
+    uint16_t head = rec->head;
+    bool_t match = true;
+    CO_CANrecord_t *r;
+    uint8_t i;
+
+    if(rec->state == CO_CAN_REC_STOPPED || rec->state == CO_CAN_REC_FROZEN){
+        return;
+    }
+
+    for(i = 0U; i < CO_CAN_REC_FILTERS; i++){
+        if((rec->filter[i] & CO_CAN_REC_ENABLE) != 0U){
+            match = CO_CANrecorder_match(ident, rec->filter[i]);
+            if(match){
+                break;
+            }
+        }
+    }
+
+    if(rec->state == CO_CAN_REC_RUNNING && (rec->trigger & CO_CAN_REC_ENABLE) != 0U
+            && CO_CANrecorder_match(ident, rec->trigger)){
+        rec->state = CO_CAN_REC_TRIGGERED;
+        rec->postCount = rec->postTrigger;
+    }
+    else if(!match){
+        return;
+    }
+    else if(rec->state == CO_CAN_REC_TRIGGERED){
+        if(rec->postCount == 0U){
+            rec->state = CO_CAN_REC_FROZEN;
+            return;
+        }
+        rec->postCount--;
+    }
+
+    if((uint16_t)(head - rec->tail) >= CO_CAN_RECORDER){
+        rec->lost++;
+        return;
+    }
+
+    /* extend 16-bit timestamp to the value nearest to the estimate from system tick */
+    tick = HAL_GetTick();
+    approx = rec->time + (tick - rec->tick) * rec->bitsPerMs;
+    time = (approx & 0xFFFF0000UL) | ((DTR & CAN_RDT0R_TIME) >> CAN_RDT0R_TIME_Pos);
+    diff = (int32_t)(time - approx);
+    if(diff > 0x8000){
+        time -= 0x10000UL;
+    }
+    else if(diff < -0x8000){
+        time += 0x10000UL;
+    }
+    rec->time = time;
+    rec->tick = tick;
+
+    r = &rec->ring[head & (CO_CAN_RECORDER - 1U)];
+    r->time = (time & 0x0FFFFFFFUL) | ((DTR & CAN_RDT0R_DLC) << 28);
+    r->ident = IR;
+    r->dataLow = DLR;
+    r->dataHigh = DHR;
+    CO_MEMORY_BARRIER();
+    rec->head = head + 1U;
+}
+
+
+/******************************************************************************/
+bool_t CO_CANrecorder_command(CO_CANrecorder_t *rec, uint32_t command){
+    bool_t ret = true;
+
+    CO_LOCK_CAN_SEND();
+    switch(command){
+        case CO_CAN_REC_CMD_STOP:
+            rec->state = CO_CAN_REC_STOPPED;
+            break;
+        case CO_CAN_REC_CMD_RUN:
+            rec->postCount = rec->postTrigger;
+            rec->state = CO_CAN_REC_RUNNING;
+            break;
+        case CO_CAN_REC_CMD_ERASE:
+            rec->state = CO_CAN_REC_STOPPED;
+            rec->erase = CO_CAN_REC_ERASE_REQUEST;
+            break;
+        default:
+            ret = false;
+            break;
+    }
+    CO_UNLOCK_CAN_SEND();
+
+    return ret;
+}
+
+
+/******************************************************************************/
+void CO_CANrecorder_process(CO_CANrecorder_t *rec){
+    uint32_t pos, pageRecs, ringRecs, chunk;
+    uint16_t count;
+    uint8_t status;
+    bool_t recording;
+
+#if CO_SDO_DOMAIN_PREFETCH > 0
+    if(rec->flash == CO_CAN_REC_FLASH_READ){
+        if(HAL_SPI_GetState(&hspi3) != HAL_SPI_STATE_READY){
+            return;
+        }
+        HAL_GPIO_WritePin(CO_CAN_REC_CS_PORT, CO_CAN_REC_CS_PIN, GPIO_PIN_SET);
+        rec->readError = (hspi3.ErrorCode != HAL_SPI_ERROR_NONE) ? true : false;
+        rec->flash = CO_CAN_REC_FLASH_IDLE;
+        CO_SDO_ODFcomplete(rec->readSDO);
+        return;
+    }
+#endif
+
+    if(rec->flash == CO_CAN_REC_FLASH_DMA){
+        if(HAL_SPI_GetState(&hspi3) != HAL_SPI_STATE_READY){
+            return;
+        }
+        HAL_GPIO_WritePin(CO_CAN_REC_CS_PORT, CO_CAN_REC_CS_PIN, GPIO_PIN_SET);
+        if(hspi3.ErrorCode != HAL_SPI_ERROR_NONE){
+            rec->errors++;
+        }
+        /* records are released also after error, there is no space to keep them */
+        rec->written += (uint32_t)rec->chunk * CO_CAN_REC_SIZE;
+        rec->length += (uint32_t)rec->chunk * CO_CAN_REC_SIZE;
+        CO_CANrecorder_limitLength(rec);
+        CO_MEMORY_BARRIER();
+        rec->tail += rec->chunk;
+        rec->flash = CO_CAN_REC_FLASH_BUSY;
+        return;
+    }
+
+    if(rec->flash == CO_CAN_REC_FLASH_BUSY){
+        if(!CO_CANrecorder_cmd(FLASH_CMD_RDSR, false, 0U)){
+            rec->errors++;
+            return;
+        }
+        status = FLASH_SR_WIP;
+        (void)HAL_SPI_Receive(&hspi3, &status, 1U, CO_CAN_REC_SPI_TIMEOUT);
+        HAL_GPIO_WritePin(CO_CAN_REC_CS_PORT, CO_CAN_REC_CS_PIN, GPIO_PIN_SET);
+        if((status & FLASH_SR_WIP) != 0U){
+            return;
+        }
+        rec->flash = CO_CAN_REC_FLASH_IDLE;
+    }
+
+    if(rec->erase == CO_CAN_REC_ERASE_REQUEST){
+        /* recording is stopped, records of the ring belong to the erased log */
+        rec->tail = rec->head;
+        rec->written = 0U;
+        rec->erased = 0U;
+        rec->length = 0U;
+        rec->lost = 0U;
+        rec->erase = CO_CAN_REC_ERASE_RUNNING;
+    }
+
+    count = (uint16_t)(rec->head - rec->tail);
+    pos = rec->tail & (CO_CAN_RECORDER - 1U);
+    ringRecs = CO_CAN_RECORDER - pos;
+    pageRecs = (CO_CAN_REC_PAGE_SIZE - (rec->written & (CO_CAN_REC_PAGE_SIZE - 1U))) / CO_CAN_REC_SIZE;
+    chunk = count;
+    if(chunk > ringRecs){
+        chunk = ringRecs;
+    }
+    if(chunk > pageRecs){
+        chunk = pageRecs;
+    }
+    recording = (rec->state == CO_CAN_REC_RUNNING || rec->state == CO_CAN_REC_TRIGGERED) ? true : false;
+    if(recording && chunk < pageRecs && chunk < ringRecs){
+        /* wait for the full page */
+        chunk = 0U;
+    }
+
+    if(chunk > 0U && (rec->erased - rec->written) >= chunk * CO_CAN_REC_SIZE){
+        if(!CO_CANrecorder_writeCmd(FLASH_CMD_PP, CO_CAN_REC_ADDR(rec->written))){
+            rec->errors++;
+            return;
+        }
+        if(HAL_SPI_Transmit_DMA(&hspi3, (uint8_t*)&rec->ring[pos], (uint16_t)(chunk * CO_CAN_REC_SIZE)) != HAL_OK){
+            HAL_GPIO_WritePin(CO_CAN_REC_CS_PORT, CO_CAN_REC_CS_PIN, GPIO_PIN_SET);
+            rec->errors++;
+            return;
+        }
+        rec->chunk = (uint16_t)chunk;
+        rec->flash = CO_CAN_REC_FLASH_DMA;
+    }
+    else if((chunk > 0U || rec->erase == CO_CAN_REC_ERASE_RUNNING)
+            && (rec->erased - rec->written) <= (CO_CAN_REC_FLASH_SIZE - CO_CAN_REC_ERASE_SIZE)){
+        /* erase the oldest unit, which holds no unwritten byte */
+        if(!CO_CANrecorder_writeCmd(FLASH_CMD_ERASE, CO_CAN_REC_ADDR(rec->erased))){
+            rec->errors++;
+            return;
+        }
+        HAL_GPIO_WritePin(CO_CAN_REC_CS_PORT, CO_CAN_REC_CS_PIN, GPIO_PIN_SET);
+        rec->erased += CO_CAN_REC_ERASE_SIZE;
+        CO_CANrecorder_limitLength(rec);
+        rec->flash = CO_CAN_REC_FLASH_BUSY;
+    }
+    else if(rec->erase == CO_CAN_REC_ERASE_RUNNING){
+        rec->erase = CO_CAN_REC_ERASE_NONE;
+    }
+}
+
+
+/******************************************************************************/
+bool_t CO_CANrecorder_read(CO_CANrecorder_t *rec, uint32_t offset, uint8_t *data, uint32_t length){
+    uint32_t address = CO_CAN_REC_ADDR(rec->written - rec->length + offset);
+    uint32_t part;
+    HAL_StatusTypeDef status;
+
+    while(length > 0U){
+        /* flash end is not crossed, log continues at address 0 */
+        part = CO_CAN_REC_FLASH_SIZE - address;
+        if(part > length){
+            part = length;
+        }
+        if(!CO_CANrecorder_cmd(FLASH_CMD_READ, true, address)){
+            return false;
+        }
+        status = HAL_SPI_Receive(&hspi3, data, (uint16_t)part, CO_CAN_REC_SPI_TIMEOUT + (part >> 8));
+        HAL_GPIO_WritePin(CO_CAN_REC_CS_PORT, CO_CAN_REC_CS_PIN, GPIO_PIN_SET);
+        if(status != HAL_OK){
+            return false;
+        }
+        data += part;
+        length -= part;
+        address = 0U;
+    }
+
+    return true;
+}
+
+
+/******************************************************************************/
+bool_t CO_CANrecorder_isIdle(const CO_CANrecorder_t *rec){
+    return (rec->state != CO_CAN_REC_RUNNING && rec->state != CO_CAN_REC_TRIGGERED
+            && rec->head == rec->tail && rec->flash == CO_CAN_REC_FLASH_IDLE
+            && rec->erase == CO_CAN_REC_ERASE_NONE) ? true : false;
+}
+
+#endif /* CO_CAN_RECORDER > 0 */
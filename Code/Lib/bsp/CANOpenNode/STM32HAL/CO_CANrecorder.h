@@ -0,0 +1,309 @@
+/**
+ * CAN traffic recorder into external SPI flash for STM32L4.
+ *
+ * @file        CO_CANrecorder.h
+ * @ingroup     CO_CANrecorder
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * CANopenNode is free and open source software: you can redistribute
+ * it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Following clarification and special exception to the GNU General Public
+ * License is included to the distribution terms of CANopenNode:
+ *
+ * Linking this library statically or dynamically with other modules is
+ * making a combined work based on this library. Thus, the terms and
+ * conditions of the GNU General Public License cover the whole combination.
+ *
+ * As a special exception, the copyright holders of this library give
+ * you permission to link this library with independent modules to
+ * produce an executable, regardless of the license terms of these
+ * independent modules, and to copy and distribute the resulting
+ * executable under terms of your choice, provided that you also meet,
+ * for each linked independent module, the terms and conditions of the
+ * license of that module. An independent module is a module which is
+ * not derived from or based on this library. If you modify this
+ * library, you may extend this exception to your version of the
+ * library, but you are not obliged to do so. If you do not wish
+ * to do so, delete this exception statement from your version.
+ */
+
+
+
+#ifndef CO_CAN_RECORDER_H
+#define CO_CAN_RECORDER_H
+
+#include "CO_driver.h"
+#include "CO_SDO.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_CANrecorder CAN traffic recorder
+ * @ingroup CO_driver
+ * @{
+ *
+ * Bus history for analysis of field problems, enabled with CO_CAN_RECORDER.
+ *
+ * CAN receive and transmit complete interrupts pass each frame to
+ * CO_CANrecorder_put(), which stores it as #CO_CANrecord_t into a single
+ * producer, single consumer ring (all CAN interrupts have the same priority).
+ * CO_CANrecorder_process() takes the ring in mainline and programs it into
+ * external NOR flash (25-series, 24-bit address) on hspi3 with DMA, one flash
+ * page at a time, directly from the ring. Flash is used as a circular log,
+ * the oldest erase unit is erased, when the log is full. Interrupt work is
+ * a filter compare and four word stores, SPI and flash wait times are polled
+ * by the next CO_CANrecorder_process() call, so the CANopen tick is not
+ * delayed. Records, which do not fit into the full ring, are counted as lost.
+ *
+ * Flash programs one page in about 1 ms, which is 16 records, more than one
+ * millisecond of 1 Mbit/s traffic. Erase of one unit takes tens of
+ * milliseconds, the ring must hold the traffic meanwhile. Control value
+ * CO_CAN_REC_CMD_ERASE erases the whole log in advance, then recording
+ * erases nothing until the log wraps around.
+ *
+ * Frames are recorded, if no filter is enabled or if any enabled filter
+ * matches their 11-bit (base) identifier. Trigger is compared the same way.
+ * Trigger frame is recorded always, then 0x2146,3 more records are recorded
+ * and recording freezes, so the flash keeps the history before the trigger.
+ * Filter and trigger value is CO_CAN_REC_ENABLE | (mask << 16) | ident.
+ *
+ * ###Object dictionary
+ * If OD contains UNSIGNED32 array 0x2146 (ODL_CANrecorder_arrayLength =
+ * 6 + CO_CAN_REC_FILTERS) and DOMAIN 0x2147, they are served by
+ * CO_CANrecorder_init_2():
+ *  - 0x2146,1: state, CO_CAN_REC_STOPPED to CO_CAN_REC_FROZEN. Write
+ *    CO_CAN_REC_CMD_xxx.
+ *  - 0x2146,2: trigger.
+ *  - 0x2146,3: records after trigger.
+ *  - 0x2146,4: length of the log in bytes, read only.
+ *  - 0x2146,5: lost records, read only.
+ *  - 0x2146,6: flash write errors, read only.
+ *  - 0x2146,7 and up: filters.
+ *  - 0x2147: log from the oldest to the newest record, read only. Upload is
+ *    possible, when recording is stopped or frozen and written into flash,
+ *    otherwise it is aborted with CO_SDO_AB_DATA_DEV_STATE. Use SDO block
+ *    upload. After power on, log is the whole flash in address order, it
+ *    contains records of previous runs and erased records (all 0xFF).
+ *    With #CO_SDO_DOMAIN_PREFETCH, next part of the log is read by DMA into
+ *    the second half of SDO buffer, while the first half is transmitted.
+ *    CO_CANrecorder_process() completes the read.
+ */
+
+
+/** OD index of recorder control and status */
+#define CO_CAN_REC_OD_INDEX         0x2146U
+/** OD index of recorded log */
+#define CO_CAN_REC_DATA_OD_INDEX    0x2147U
+
+/** Size of flash area of the log in bytes, power of two, starts at address 0 */
+#ifndef CO_CAN_REC_FLASH_SIZE
+#define CO_CAN_REC_FLASH_SIZE       0x100000UL
+#endif
+/** Flash erase unit in bytes, 4096 (sector erase 0x20) or 65536 (block erase 0xD8) */
+#ifndef CO_CAN_REC_ERASE_SIZE
+#define CO_CAN_REC_ERASE_SIZE       4096UL
+#endif
+/** Flash program page in bytes */
+#ifndef CO_CAN_REC_PAGE_SIZE
+#define CO_CAN_REC_PAGE_SIZE        256U
+#endif
+/** Number of identifier filters */
+#ifndef CO_CAN_REC_FILTERS
+#define CO_CAN_REC_FILTERS          4U
+#endif
+/** Chip select of the flash. EEPROM is not used on hspi3, see CO_EE_BACKEND. */
+#ifndef CO_CAN_REC_CS_PORT
+#define CO_CAN_REC_CS_PORT          EEP_SS_GPIO_Port
+#define CO_CAN_REC_CS_PIN           EEP_SS_Pin
+#endif
+/** Timeout of short blocking SPI transfers in milliseconds */
+#ifndef CO_CAN_REC_SPI_TIMEOUT
+#define CO_CAN_REC_SPI_TIMEOUT      2U
+#endif
+
+/** Flag in #CO_CANrecord_t ident of transmitted frames (TXRQ bit position) */
+#define CO_CAN_REC_TX               0x00000001UL
+/** Filter or trigger is enabled */
+#define CO_CAN_REC_ENABLE           0x80000000UL
+
+/** Recorder states */
+#define CO_CAN_REC_STOPPED          0U  /**< Nothing is recorded */
+#define CO_CAN_REC_RUNNING          1U  /**< Recording, waits for trigger */
+#define CO_CAN_REC_TRIGGERED        2U  /**< Recording records after trigger */
+#define CO_CAN_REC_FROZEN           3U  /**< Stopped after trigger */
+
+/** Commands written to CO_CAN_REC_OD_INDEX,1 */
+#define CO_CAN_REC_CMD_STOP         0U  /**< Stop recording */
+#define CO_CAN_REC_CMD_RUN          1U  /**< Start recording and arm trigger */
+#define CO_CAN_REC_CMD_ERASE        2U  /**< Stop and erase the whole log */
+
+
+/**
+ * One recorded frame, 16 bytes, stored in flash as is (little endian).
+ */
+typedef struct{
+    /** Bits 0..27: CAN bit time counter at SOF, extended from 16-bit hardware
+     * timestamp with HAL_GetTick(). Bits 28..31: DLC. */
+    uint32_t            time;
+    /** RIR or TIR register: identifier, IDE, RTR and CO_CAN_REC_TX */
+    uint32_t            ident;
+    uint32_t            dataLow;    /**< Data bytes 0..3, RDLR or TDLR */
+    uint32_t            dataHigh;   /**< Data bytes 4..7, RDHR or TDHR */
+}CO_CANrecord_t;
+
+
+/**
+ * Recorder object.
+ */
+typedef struct{
+    /** Records, written by CO_CANrecorder_put() */
+    CO_CANrecord_t      ring[CO_CAN_RECORDER];
+    /** Free running write counter, written only by CAN interrupts */
+    volatile uint16_t   head;
+    /** Free running read counter, written only by CO_CANrecorder_process() */
+    volatile uint16_t   tail;
+    /** CO_CAN_REC_STOPPED ... CO_CAN_REC_FROZEN */
+    volatile uint8_t    state;
+    /** Filters, CO_CAN_REC_ENABLE | (mask << 16) | ident */
+    uint32_t            filter[CO_CAN_REC_FILTERS];
+    /** Trigger, CO_CAN_REC_ENABLE | (mask << 16) | ident */
+    uint32_t            trigger;
+    /** Records after trigger, before freeze */
+    uint32_t            postTrigger;
+    /** Remaining records after trigger */
+    uint32_t            postCount;
+    /** Records lost, because the ring was full */
+    volatile uint32_t   lost;
+    /** Extended bit time of the last record */
+    uint32_t            time;
+    /** HAL_GetTick() of the last record */
+    uint32_t            tick;
+    /** Bits per millisecond, CAN bit rate in kbit/s */
+    uint32_t            bitsPerMs;
+    /** Flash writer state, CO_CAN_REC_FLASH_xxx in CO_CANrecorder.c */
+    uint8_t             flash;
+    /** Erase of the whole log, CO_CAN_REC_ERASE_xxx in CO_CANrecorder.c */
+    volatile uint8_t    erase;
+    /** Records in the running DMA transfer */
+    uint16_t            chunk;
+    /** Free running counter of bytes written, modulo flash size is address */
+    uint32_t            written;
+    /** Free running counter of bytes erased, ahead of written */
+    uint32_t            erased;
+    /** Length of the log in bytes, which ends at written */
+    uint32_t            length;
+    /** Failed SPI transfers */
+    uint32_t            errors;
+#if CO_SDO_DOMAIN_PREFETCH > 0
+    /** SDO server waiting for the read by DMA, see CO_SDO_ODFcomplete() */
+    void               *readSDO;
+    /** True, if the last read by DMA failed */
+    bool_t              readError;
+#endif
+}CO_CANrecorder_t;
+
+
+/**
+ * Initialize recorder at program start.
+ *
+ * Recording is stopped, log is the whole flash.
+ *
+ * @param rec This object will be initialized.
+ */
+void CO_CANrecorder_init_1(CO_CANrecorder_t *rec);
+
+
+/**
+ * Connect recorder to CAN module and serve OD objects 0x2146 and 0x2147.
+ *
+ * Function must be called after each communication reset, after
+ * CO_CANmodule_init(). Recorded data and state are kept.
+ *
+ * @param rec This object.
+ * @param CANmodule CAN module, which frames are recorded.
+ * @param SDO SDO server object, may be NULL, if OD objects are not used.
+ */
+void CO_CANrecorder_init_2(CO_CANrecorder_t *rec, CO_CANmodule_t *CANmodule, CO_SDO_t *SDO);
+
+
+/**
+ * Record one frame, called from CAN interrupts by CO_driver.c.
+ *
+ * @param rec This object.
+ * @param IR RIR or TIR register, CO_CAN_REC_TX for transmitted frame.
+ * @param DTR RDTR or TDTR register with DLC and timestamp.
+ * @param DLR Data bytes 0..3.
+ * @param DHR Data bytes 4..7.
+ */
+void CO_CANrecorder_put(CO_CANrecorder_t *rec, uint32_t IR, uint32_t DTR, uint32_t DLR, uint32_t DHR);
+
+
+/**
+ * Execute command, see CO_CAN_REC_CMD_xxx.
+ *
+ * @param rec This object.
+ * @param command Command.
+ *
+ * @return false, if command is unknown.
+ */
+bool_t CO_CANrecorder_command(CO_CANrecorder_t *rec, uint32_t command);
+
+
+/**
+ * Write recorded frames into flash.
+ *
+ * Function must be called cyclically from mainline, it never waits for the
+ * flash.
+ *
+ * @param rec This object.
+ */
+void CO_CANrecorder_process(CO_CANrecorder_t *rec);
+
+
+/**
+ * Read the log from flash.
+ *
+ * Recording must be stopped or frozen and CO_CANrecorder_isIdle() true.
+ *
+ * @param rec This object.
+ * @param offset Offset in the log, 0 is the oldest record.
+ * @param data Destination.
+ * @param length Number of bytes.
+ *
+ * @return false, if SPI transfer failed.
+ */
+bool_t CO_CANrecorder_read(CO_CANrecorder_t *rec, uint32_t offset, uint8_t *data, uint32_t length);
+
+
+/**
+ * Verify, if recorder does not use flash.
+ *
+ * @param rec This object.
+ *
+ * @return true, if recording is stopped or frozen and all records are in flash.
+ */
+bool_t CO_CANrecorder_isIdle(const CO_CANrecorder_t *rec);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif
@@ -0,0 +1,298 @@
+/*
+ * CAN bus and driver statistics and bus load in the Object Dictionary for STM32L4.
+ *
+ * @file        CO_CANstat.c
+ * @ingroup     CO_CANstat
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * CANopenNode is free and open source software: you can redistribute
+ * it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Following clarification and special exception to the GNU General Public
+ * License is included to the distribution terms of CANopenNode:
+ *
+ * Linking this library statically or dynamically with other modules is
+ * making a combined work based on this library. Thus, the terms and
+ * conditions of the GNU General Public License cover the whole combination.
+ *
+ * As a special exception, the copyright holders of this library give
+ * you permission to link this library with independent modules to
+ * produce an executable, regardless of the license terms of these
+ * independent modules, and to copy and distribute the resulting
+ * executable under terms of your choice, provided that you also meet,
+ * for each linked independent module, the terms and conditions of the
+ * license of that module. An independent module is a module which is
+ * not derived from or based on this library. If you modify this
+ * library, you may extend this exception to your version of the
+ * library, but you are not obliged to do so. If you do not wish
+ * to do so, delete this exception statement from your version.
+ */
+
+
+#include "CO_driver.h"
+#include "CO_SDO.h"
+#include "CO_OD.h"
+#include "CO_CANstat.h"
+
+#if CO_CAN_STATISTICS > 0
+
+#ifdef ODL_CANstatistics_arrayLength
+/*
+ * Function for accessing _CAN statistics_ (index 0x2141) from SDO server.
+ */
+static CO_SDO_abortCode_t CO_ODF_CANstat(CO_ODF_arg_t *ODF_arg){
+    CO_CANmodule_t *CANmodule = (CO_CANmodule_t*) ODF_arg->object;
+    CO_CANstatistics_t stats;
+    uint32_t value;
+
+    if(ODF_arg->subIndex == 0U){
+        return CO_SDO_AB_NONE;
+    }
+
+    if(!ODF_arg->reading){
+        CO_CANresetStatistics(CANmodule);
+        return CO_SDO_AB_NONE;
+    }
+
+    CO_CANgetStatistics(CANmodule, &stats);
+    switch(ODF_arg->subIndex){
+        case 1U:  value = stats.rxFrames;       break;
+        case 2U:  value = stats.rxUnmatched;    break;
+        case 3U:  value = stats.rxOverruns;     break;
+        case 4U:  value = stats.txQueued;       break;
+        case 5U:  value = stats.txSent;         break;
+        case 6U:  value = stats.txAborted;      break;
+        case 7U:  value = stats.txQueueMax;     break;
+        case 8U:  value = stats.busOff;         break;
+        case 9U:  value = stats.TEC;            break;
+        case 10U: value = stats.REC;            break;
+        default:  value = 0U;                   break;
+    }
+    CO_setUint32(ODF_arg->data, value);
+
+    return CO_SDO_AB_NONE;
+}
+#endif
+
+
+/******************************************************************************/
+void CO_CANstat_init(CO_CANmodule_t *CANmodule, CO_SDO_t *SDO){
+#ifdef ODL_CANstatistics_arrayLength
+    if((CANmodule != NULL) && (SDO != NULL)){
+        CO_OD_configure(SDO, CO_CANSTAT_OD_INDEX, CO_ODF_CANstat, (void*)CANmodule, 0, 0U);
+    }
+#else
+    (void)CANmodule;
+    (void)SDO;
+#endif
+}
+
+#endif /* CO_CAN_STATISTICS > 0 */
+
+
+#if CO_CAN_BUSLOAD > 0
+
+/*
+ * Load in per mille of bits in time_ms at bit rate of CAN module.
+ */
+static uint16_t CO_CANbusLoad_calc(const CO_CANbusLoad_t *busLoad, uint32_t bits, uint32_t time_ms){
+    uint64_t capacity = (uint64_t)busLoad->CANmodule->CANbitRate * time_ms;
+    uint64_t load;
+
+    if(capacity == 0U){
+        return 0U;
+    }
+    load = ((uint64_t)bits * 1000U) / capacity;
+
+    /* worst case stuffing may exceed real bus capacity */
+    return (load > 1000U) ? 1000U : (uint16_t)load;
+}
+
+
+#ifdef ODL_busLoad_arrayLength
+/*
+ * Function for accessing _bus load_ (index 0x2142) from SDO server.
+ */
+static CO_SDO_abortCode_t CO_ODF_CANbusLoad(CO_ODF_arg_t *ODF_arg){
+    CO_CANbusLoad_t *busLoad = (CO_CANbusLoad_t*) ODF_arg->object;
+
+    if(!ODF_arg->reading && (ODF_arg->subIndex != 0U)){
+        busLoad->loadPeak = busLoad->loadLast;
+    }
+
+    return CO_SDO_AB_NONE;
+}
+#endif
+
+
+/******************************************************************************/
+void CO_CANbusLoad_init(CO_CANbusLoad_t *busLoad, CO_CANmodule_t *CANmodule, CO_SDO_t *SDO){
+    uint8_t i;
+
+    busLoad->CANmodule = CANmodule;
+    for(i = 0U; i < CO_CAN_BUSLOAD_SUBWINDOWS; i++){
+        busLoad->bits[i] = 0U;
+        busLoad->time_ms[i] = 0U;
+    }
+    busLoad->bitsCurrent = 0U;
+    busLoad->timeCurrent_ms = 0U;
+
+#if CO_TPDO_ADAPTIVE_INHIBIT > 0
+    /* multiplicative increase under load, gradual relax when traffic drops */
+    if(busLoad->loadLast > CO_TPDO_ADAPTIVE_LOAD_HIGH || busLoad->queueMax > CO_TPDO_ADAPTIVE_QUEUE){
+        uint32_t scale = (uint32_t)busLoad->inhibitScale * 2U;
+
+        busLoad->inhibitScale = (scale > CO_TPDO_ADAPTIVE_MAX * 256U) ?
+                (uint16_t)(CO_TPDO_ADAPTIVE_MAX * 256U) : (uint16_t)scale;
+    }
+    else if(busLoad->loadLast < CO_TPDO_ADAPTIVE_LOAD_LOW && busLoad->inhibitScale > 256U){
+        uint16_t scale = busLoad->inhibitScale - busLoad->inhibitScale / 4U;
+
+        busLoad->inhibitScale = (scale < 256U) ? 256U : scale;
+    }
+    busLoad->queueMax = 0U;
+#endif
+    busLoad->index = 0U;
+    busLoad->load = 0U;
+    busLoad->loadLast = 0U;
+    busLoad->loadPeak = 0U;
+#if CO_TPDO_ADAPTIVE_INHIBIT > 0
+    busLoad->queueMax = 0U;
+    busLoad->inhibitScale = 256U;
+#endif
+
+    /* discard frames counted before init */
+    (void)CO_CANbusLoadBits(CANmodule);
+
+#ifdef ODL_busLoad_arrayLength
+    if(SDO != NULL){
+        CO_OD_configure(SDO, CO_CANBUSLOAD_OD_INDEX, CO_ODF_CANbusLoad, (void*)busLoad, 0, 0U);
+    }
+#else
+    (void)SDO;
+#endif
+}
+
+
+/******************************************************************************/
+void CO_CANbusLoad_process(CO_CANbusLoad_t *busLoad, uint16_t timeDifference_ms){
+    uint32_t bitsSum = 0U;
+    uint32_t timeSum = 0U;
+    uint8_t i;
+
+    busLoad->bitsCurrent += CO_CANbusLoadBits(busLoad->CANmodule);
+    busLoad->timeCurrent_ms += timeDifference_ms;
+#if CO_TPDO_ADAPTIVE_INHIBIT > 0
+    if(busLoad->CANmodule->CANtxCount > busLoad->queueMax){
+        busLoad->queueMax = busLoad->CANmodule->CANtxCount;
+    }
+#endif
+    if(busLoad->timeCurrent_ms < CO_CAN_BUSLOAD_SUBWINDOW_MS){
+        return;
+    }
+
+    /* replace the oldest sub-window */
+    busLoad->bits[busLoad->index] = busLoad->bitsCurrent;
+    busLoad->time_ms[busLoad->index] = busLoad->timeCurrent_ms;
+    if(++busLoad->index >= CO_CAN_BUSLOAD_SUBWINDOWS){
+        busLoad->index = 0U;
+    }
+
+    for(i = 0U; i < CO_CAN_BUSLOAD_SUBWINDOWS; i++){
+        bitsSum += busLoad->bits[i];
+        timeSum += busLoad->time_ms[i];
+    }
+    busLoad->load = CO_CANbusLoad_calc(busLoad, bitsSum, timeSum);
+    busLoad->loadLast = CO_CANbusLoad_calc(busLoad, busLoad->bitsCurrent, busLoad->timeCurrent_ms);
+    if(busLoad->loadLast > busLoad->loadPeak){
+        busLoad->loadPeak = busLoad->loadLast;
+    }
+    busLoad->bitsCurrent = 0U;
+    busLoad->timeCurrent_ms = 0U;
+
+#ifdef ODL_busLoad_arrayLength
+    /* may be mapped to TPDO, processed from timer interrupt */
+    CO_LOCK_OD();
+    OD_busLoad[0] = busLoad->load;
+    OD_busLoad[1] = busLoad->loadLast;
+    OD_busLoad[2] = busLoad->loadPeak;
+    CO_UNLOCK_OD();
+#endif
+}
+
+#endif /* CO_CAN_BUSLOAD > 0 */
+
+
+#if CO_CAN_TX_LATENCY > 0
+
+#ifdef ODL_txLatency_arrayLength
+/*
+ * Function for accessing _transmit latency_ (index 0x214B) from SDO server.
+ */
+static CO_SDO_abortCode_t CO_ODF_CANtxLatency(CO_ODF_arg_t *ODF_arg){
+    CO_CANmodule_t *CANmodule = (CO_CANmodule_t*) ODF_arg->object;
+    CO_CANtxLatency_t latency;
+    uint32_t value;
+
+    if(ODF_arg->subIndex == 0U){
+        return CO_SDO_AB_NONE;
+    }
+
+    if(!ODF_arg->reading){
+        if(ODF_arg->subIndex == 1U){
+            value = CO_getUint32(ODF_arg->data);
+            if(value > 0x7FFU){
+                return CO_SDO_AB_VALUE_HIGH;
+            }
+            CANmodule->txLatencySelect = (uint16_t)value;
+        }
+        else{
+            CO_CANresetTxLatency(CANmodule);
+        }
+        return CO_SDO_AB_NONE;
+    }
+
+    (void)CO_CANgetTxLatency(CANmodule, CANmodule->txLatencySelect, &latency);
+    switch(ODF_arg->subIndex){
+        case 1U:  value = CANmodule->txLatencySelect; break;
+        case 2U:  value = latency.count;            break;
+        case 3U:  value = latency.min_us;           break;
+        case 4U:  value = latency.max_us;           break;
+        default:
+            value = ((uint32_t)ODF_arg->subIndex - 5U < CO_CAN_TX_LATENCY_BINS) ?
+                    latency.hist[ODF_arg->subIndex - 5U] : 0U;
+            break;
+    }
+    CO_setUint32(ODF_arg->data, value);
+
+    return CO_SDO_AB_NONE;
+}
+#endif
+
+
+/******************************************************************************/
+void CO_CANtxLatency_init(CO_CANmodule_t *CANmodule, CO_SDO_t *SDO){
+#ifdef ODL_txLatency_arrayLength
+    if((CANmodule != NULL) && (SDO != NULL)){
+        CO_OD_configure(SDO, CO_CANTXLATENCY_OD_INDEX, CO_ODF_CANtxLatency, (void*)CANmodule, 0, 0U);
+    }
+#else
+    (void)CANmodule;
+    (void)SDO;
+#endif
+}
+
+#endif /* CO_CAN_TX_LATENCY > 0 */
@@ -0,0 +1,211 @@
+/**
+ * CAN bus and driver statistics and bus load in the Object Dictionary for STM32L4.
+ *
+ * @file        CO_CANstat.h
+ * @ingroup     CO_CANstat
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * CANopenNode is free and open source software: you can redistribute
+ * it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Following clarification and special exception to the GNU General Public
+ * License is included to the distribution terms of CANopenNode:
+ *
+ * Linking this library statically or dynamically with other modules is
+ * making a combined work based on this library. Thus, the terms and
+ * conditions of the GNU General Public License cover the whole combination.
+ *
+ * As a special exception, the copyright holders of this library give
+ * you permission to link this library with independent modules to
+ * produce an executable, regardless of the license terms of these
+ * independent modules, and to copy and distribute the resulting
+ * executable under terms of your choice, provided that you also meet,
+ * for each linked independent module, the terms and conditions of the
+ * license of that module. An independent module is a module which is
+ * not derived from or based on this library. If you modify this
+ * library, you may extend this exception to your version of the
+ * library, but you are not obliged to do so. If you do not wish
+ * to do so, delete this exception statement from your version.
+ */
+
+
+#ifndef CO_CANSTAT_H
+#define CO_CANSTAT_H
+
+#include "CO_driver.h"
+#include "CO_SDO.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_CANstat CAN statistics
+ * @ingroup CO_driver
+ * @{
+ *
+ * Counters of #CO_CANstatistics_t, collected by CO_driver.c, if
+ * CO_CAN_STATISTICS is nonzero.
+ *
+ * ###Object dictionary
+ * If OD contains UNSIGNED32 array 0x2141 (ODL_CANstatistics_arrayLength = 10),
+ * it is served by CO_CANstat_init(). Sub-indexes are:
+ *  - 1: received frames,
+ *  - 2: received frames without receive buffer,
+ *  - 3: receive FIFO overruns,
+ *  - 4: queued transmit buffers,
+ *  - 5: sent frames,
+ *  - 6: aborted synchronous TPDOs,
+ *  - 7: maximum transmit queue depth,
+ *  - 8: bus-off events,
+ *  - 9: transmit error counter (TEC),
+ *  - 10: receive error counter (REC).
+ *
+ * Each read takes a new snapshot. Writing any value to any sub-index resets
+ * all counters.
+ *
+ * ###Bus load
+ * If CO_CAN_BUSLOAD is nonzero, CO_CANbusLoad_process() calculates bus load
+ * from frame lengths summed by CAN module, see CO_CAN_BUSLOAD. If OD contains
+ * UNSIGNED16 array 0x2142 (ODL_busLoad_arrayLength = 3), results in per mille
+ * are written there:
+ *  - 1: load over the sliding window of CO_CAN_BUSLOAD_SUBWINDOWS *
+ *       CO_CAN_BUSLOAD_SUBWINDOW_MS,
+ *  - 2: load in the last sub-window,
+ *  - 3: peak of sub-windows since init or since written.
+ *
+ * Array is TPDO mappable, so it may be sent by a TPDO with event timer, for
+ * example once per second. Writing any value to any sub-index resets the peak.
+ *
+ * With CO_TPDO_ADAPTIVE_INHIBIT, each completed sub-window also updates
+ * inhibitScale from the load and transmit queue depth, application passes it
+ * to CO_TPDO_setInhibitScale() of event driven TPDOs.
+ *
+ * ###Transmit latency
+ * If CO_CAN_TX_LATENCY is nonzero and OD contains UNSIGNED32 array 0x214B
+ * (ODL_txLatency_arrayLength = 4 + CO_CAN_TX_LATENCY_BINS), it is served by
+ * CO_CANtxLatency_init(). Sub-indexes are:
+ *  - 1: selected 11-bit COB-ID, written by the client,
+ *  - 2: frames measured,
+ *  - 3: minimum latency in microseconds,
+ *  - 4: maximum latency in microseconds,
+ *  - 5 and more: histogram, see CO_CAN_TX_LATENCY.
+ *
+ * Client writes COB-ID of a TPDO or other transmit buffer to sub-index 1 and
+ * reads the others, each read takes a new snapshot. Unknown COB-ID reads
+ * zeros. Writing any value to other sub-index resets latency of all buffers.
+ */
+
+
+/** OD index of CAN statistics */
+#define CO_CANSTAT_OD_INDEX         0x2141U
+/** OD index of bus load */
+#define CO_CANBUSLOAD_OD_INDEX      0x2142U
+/** OD index of transmit latency */
+#define CO_CANTXLATENCY_OD_INDEX    0x214BU
+
+
+#if CO_CAN_BUSLOAD > 0
+/**
+ * Bus load object.
+ */
+typedef struct{
+    /** From CO_CANbusLoad_init() */
+    CO_CANmodule_t     *CANmodule;
+    /** Bits of completed sub-windows, ring buffer */
+    uint32_t            bits[CO_CAN_BUSLOAD_SUBWINDOWS];
+    /** Duration of completed sub-windows in milliseconds */
+    uint16_t            time_ms[CO_CAN_BUSLOAD_SUBWINDOWS];
+    /** Bits of the current sub-window */
+    uint32_t            bitsCurrent;
+    /** Duration of the current sub-window in milliseconds */
+    uint16_t            timeCurrent_ms;
+    /** Index of the oldest sub-window in the ring buffer */
+    uint8_t             index;
+    /** Load over sliding window in per mille */
+    uint16_t            load;
+    /** Load in the last completed sub-window in per mille */
+    uint16_t            loadLast;
+    /** Highest loadLast since init or reset in per mille */
+    uint16_t            loadPeak;
+#if CO_TPDO_ADAPTIVE_INHIBIT > 0
+    /** Highest transmit queue depth in the current sub-window */
+    uint16_t            queueMax;
+    /** Inhibit time multiplier for CO_TPDO_setInhibitScale(), 256 is 1.0 */
+    uint16_t            inhibitScale;
+#endif
+}CO_CANbusLoad_t;
+#endif
+
+
+/**
+ * Serve OD object 0x2141 with statistics of CAN module.
+ *
+ * Function must be called after each communication reset, CO_CANmodule_init()
+ * resets the counters.
+ *
+ * @param CANmodule CAN module, which statistics are served.
+ * @param SDO SDO server object.
+ */
+void CO_CANstat_init(CO_CANmodule_t *CANmodule, CO_SDO_t *SDO);
+
+
+#if CO_CAN_BUSLOAD > 0
+/**
+ * Initialize bus load object and serve OD object 0x2142.
+ *
+ * Function must be called after each communication reset.
+ *
+ * @param busLoad This object will be initialized.
+ * @param CANmodule CAN module, which frames are measured.
+ * @param SDO SDO server object, may be NULL, if OD object is not used.
+ */
+void CO_CANbusLoad_init(CO_CANbusLoad_t *busLoad, CO_CANmodule_t *CANmodule, CO_SDO_t *SDO);
+
+
+/**
+ * Process bus load measurement.
+ *
+ * Function must be called cyclically from mainline, results are updated
+ * once per CO_CAN_BUSLOAD_SUBWINDOW_MS.
+ *
+ * @param busLoad This object.
+ * @param timeDifference_ms Time difference from previous function call in [milliseconds].
+ */
+void CO_CANbusLoad_process(CO_CANbusLoad_t *busLoad, uint16_t timeDifference_ms);
+#endif
+
+
+#if CO_CAN_TX_LATENCY > 0
+/**
+ * Serve OD object 0x214B with transmit latency of CAN module.
+ *
+ * Function must be called after each communication reset, CO_CANmodule_init()
+ * resets the latency and the selected COB-ID.
+ *
+ * @param CANmodule CAN module, which transmit buffers are served.
+ * @param SDO SDO server object.
+ */
+void CO_CANtxLatency_init(CO_CANmodule_t *CANmodule, CO_SDO_t *SDO);
+#endif
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif
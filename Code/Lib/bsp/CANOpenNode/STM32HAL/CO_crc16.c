@@ -0,0 +1,200 @@
+/*
+ * CRC 16 CCITT calculation with STM32L4 hardware CRC unit.
+ *
+ * @file        CO_crc16.c
+ * @ingroup     CO_crc16_ccitt
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * CANopenNode is free and open source software: you can redistribute
+ * it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Following clarification and special exception to the GNU General Public
+ * License is included to the distribution terms of CANopenNode:
+ *
+ * Linking this library statically or dynamically with other modules is
+ * making a combined work based on this library. Thus, the terms and
+ * conditions of the GNU General Public License cover the whole combination.
+ *
+ * As a special exception, the copyright holders of this library give
+ * you permission to link this library with independent modules to
+ * produce an executable, regardless of the license terms of these
+ * independent modules, and to copy and distribute the resulting
+ * executable under terms of your choice, provided that you also meet,
+ * for each linked independent module, the terms and conditions of the
+ * license of that module. An independent module is a module which is
+ * not derived from or based on this library. If you modify this
+ * library, you may extend this exception to your version of the
+ * library, but you are not obliged to do so. If you do not wish
+ * to do so, delete this exception statement from your version.
+ */
+
+
+/*
+ * Own crc16_ccitt() for CANopenNode, enabled with CO_USE_OWN_CRC16 (see
+ * crc16-ccitt.h). CRC unit is configured for 16-bit polynomial 0x1021 without
+ * reflection, initial value is previous CRC, so results are the same as from
+ * table version. Data are fed by 32-bit words, byte order is swapped, as unit
+ * processes most significant bit of the written word first.
+ *
+ * With CO_CRC16_DMA, blocks of CO_CRC16_DMA_THRESHOLD or more bytes are
+ * written into CRC unit by memory to memory DMA on DMA1 channel 1. Call is
+ * still blocking, but data are transferred without CPU load/store per byte.
+ *
+ * CRC unit is not reentrant: if crc16_ccitt() is called from interrupt while
+ * unit is in use, crc16_ccitt_sw() table version is used instead.
+ *
+ * With CO_CRC16_BENCHMARK, CO_crc16_benchmark() compares all variants.
+ */
+
+
+#include "CO_driver.h"
+#include "CO_crc16.h"
+
+#ifdef CO_USE_OWN_CRC16
+
+#define CRC16_DMA_CHANNEL       DMA1_Channel1
+#define CRC16_DMA_TC_FLAG       DMA_ISR_TCIF1
+#define CRC16_DMA_CLEAR_FLAGS   DMA_IFCR_CGIF1
+
+static volatile unsigned char crc16_busy = 0U;
+static unsigned char crc16_initialized = 0U;
+
+
+/*
+ * Enable CRC unit clock and configure polynomial.
+ */
+static void crc16_hwInit(void){
+    __HAL_RCC_CRC_CLK_ENABLE();
+    CRC->POL = 0x1021U;
+    CRC->CR = CRC_CR_POLYSIZE_0;    /* 16-bit polynomial, no reversal */
+#if CO_CRC16_DMA > 0
+    __HAL_RCC_DMA1_CLK_ENABLE();
+#endif
+    crc16_initialized = 1U;
+}
+
+
+#if CO_CRC16_DMA > 0
+/*
+ * Write block into CRC data register by DMA, byte by byte, and wait.
+ */
+static void crc16_dma(const unsigned char block[], unsigned int blockLength){
+    CRC16_DMA_CHANNEL->CCR = 0U;
+    DMA1->IFCR = CRC16_DMA_CLEAR_FLAGS;
+    CRC16_DMA_CHANNEL->CPAR = (uint32_t)&CRC->DR;
+    CRC16_DMA_CHANNEL->CMAR = (uint32_t)block;
+    CRC16_DMA_CHANNEL->CNDTR = blockLength;
+    /* memory to memory, read from memory, memory increment, 8-bit */
+    CRC16_DMA_CHANNEL->CCR = DMA_CCR_MEM2MEM | DMA_CCR_DIR | DMA_CCR_MINC | DMA_CCR_EN;
+    while((DMA1->ISR & CRC16_DMA_TC_FLAG) == 0U){
+    }
+    CRC16_DMA_CHANNEL->CCR = 0U;
+    DMA1->IFCR = CRC16_DMA_CLEAR_FLAGS;
+}
+#endif
+
+
+/******************************************************************************/
+unsigned short crc16_ccitt(
+        const unsigned char     block[],
+        unsigned int            blockLength,
+        unsigned short          crc)
+{
+    uint32_t primask;
+    unsigned int i = 0U;
+
+    /* take the unit, nested call from interrupt uses table */
+    primask = __get_PRIMASK();
+    __disable_irq();
+    if(crc16_busy != 0U){
+        __set_PRIMASK(primask);
+        return crc16_ccitt_sw(block, blockLength, crc);
+    }
+    crc16_busy = 1U;
+    __set_PRIMASK(primask);
+
+    if(crc16_initialized == 0U){
+        crc16_hwInit();
+    }
+    CRC->INIT = crc;
+    CRC->CR |= CRC_CR_RESET;
+
+#if CO_CRC16_DMA > 0
+    if(blockLength >= CO_CRC16_DMA_THRESHOLD){
+        crc16_dma(block, blockLength);
+        i = blockLength;
+    }
+#endif
+
+    for(; (i + 4U) <= blockLength; i += 4U){
+        uint32_t word = (uint32_t)block[i] << 24 | (uint32_t)block[i+1U] << 16 |
+                        (uint32_t)block[i+2U] << 8 | (uint32_t)block[i+3U];
+        CRC->DR = word;
+    }
+    for(; i < blockLength; i++){
+        *(__IO uint8_t*)&CRC->DR = block[i];
+    }
+    crc = (unsigned short)CRC->DR;
+
+    crc16_busy = 0U;
+    return crc;
+}
+
+#endif /* CO_USE_OWN_CRC16 */
+
+
+#if CO_CRC16_BENCHMARK > 0
+/*
+ * Cycles of one crc function call.
+ */
+static uint32_t crc16_measure(
+        unsigned short        (*crcFunction)(const unsigned char[], unsigned int, unsigned short),
+        const uint8_t           block[],
+        uint32_t                length,
+        unsigned short         *crc)
+{
+    uint32_t start = DWT->CYCCNT;
+
+    *crc = crcFunction(block, length, 0U);
+    return DWT->CYCCNT - start;
+}
+
+
+/******************************************************************************/
+void CO_crc16_benchmark(
+        CO_crc16_benchmark_t   *result,
+        const uint8_t           block[],
+        uint32_t                length)
+{
+    unsigned short crcByte, crcSlice4, crcHw;
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    result->length = length;
+    result->cyclesByte = crc16_measure(crc16_ccitt_byte, block, length, &crcByte);
+    result->cyclesSlice4 = crc16_measure(crc16_ccitt_slice4, block, length, &crcSlice4);
+#ifdef CO_USE_OWN_CRC16
+    result->cyclesHw = crc16_measure(crc16_ccitt, block, length, &crcHw);
+#else
+    result->cyclesHw = 0U;
+    crcHw = crcByte;
+#endif
+    result->tableByte = 256U * sizeof(unsigned short);
+    result->tableSlice4 = 4U * 256U * sizeof(unsigned short);
+    result->match = (crcByte == crcSlice4 && crcByte == crcHw) ? true : false;
+}
+#endif
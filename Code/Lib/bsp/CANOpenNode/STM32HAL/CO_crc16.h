@@ -0,0 +1,110 @@
+/**
+ * CRC 16 CCITT options for STM32L4 and CRC benchmark.
+ *
+ * @file        CO_crc16.h
+ * @ingroup     CO_crc16_ccitt
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * CANopenNode is free and open source software: you can redistribute
+ * it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Following clarification and special exception to the GNU General Public
+ * License is included to the distribution terms of CANopenNode:
+ *
+ * Linking this library statically or dynamically with other modules is
+ * making a combined work based on this library. Thus, the terms and
+ * conditions of the GNU General Public License cover the whole combination.
+ *
+ * As a special exception, the copyright holders of this library give
+ * you permission to link this library with independent modules to
+ * produce an executable, regardless of the license terms of these
+ * independent modules, and to copy and distribute the resulting
+ * executable under terms of your choice, provided that you also meet,
+ * for each linked independent module, the terms and conditions of the
+ * license of that module. An independent module is a module which is
+ * not derived from or based on this library. If you modify this
+ * library, you may extend this exception to your version of the
+ * library, but you are not obliged to do so. If you do not wish
+ * to do so, delete this exception statement from your version.
+ */
+
+
+#ifndef CO_CRC16_H
+#define CO_CRC16_H
+
+#include <stdint.h>
+#include "crc16-ccitt.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup CO_crc16_ccitt
+ * @{
+ */
+
+/** Feed hardware CRC unit by DMA1 channel 1 (with CO_USE_OWN_CRC16) */
+#ifndef CO_CRC16_DMA
+#define CO_CRC16_DMA            0
+#endif
+
+/** Minimum length of block in bytes, which is transferred by DMA */
+#ifndef CO_CRC16_DMA_THRESHOLD
+#define CO_CRC16_DMA_THRESHOLD  64U
+#endif
+
+
+#if CO_CRC16_BENCHMARK > 0
+/**
+ * Result of CO_crc16_benchmark(). Cycles are measured with DWT cycle counter
+ * for one call on the same block. Flash cost is the size of constant tables,
+ * code of each variant is below 100 bytes.
+ */
+typedef struct{
+    uint32_t    length;         /**< Length of measured block in bytes */
+    uint32_t    cyclesByte;     /**< Byte-wise table version */
+    uint32_t    cyclesSlice4;   /**< Slice-by-4 table version */
+    uint32_t    cyclesHw;       /**< Hardware CRC unit, 0 without CO_USE_OWN_CRC16 */
+    uint16_t    tableByte;      /**< Flash of byte-wise tables in bytes */
+    uint16_t    tableSlice4;    /**< Flash of slice-by-4 tables in bytes */
+    bool_t      match;          /**< All variants returned the same CRC */
+}CO_crc16_benchmark_t;
+
+
+/**
+ * Measure all CRC variants on the block.
+ *
+ * Call from mainline with interrupts enabled only if their load is
+ * acceptable in results. Divide cycles by length for cycles per byte.
+ *
+ * @param result Results are written here.
+ * @param block Pointer to block of data.
+ * @param length Length of data in bytes.
+ */
+void CO_crc16_benchmark(
+        CO_crc16_benchmark_t   *result,
+        const uint8_t           block[],
+        uint32_t                length);
+#endif
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif
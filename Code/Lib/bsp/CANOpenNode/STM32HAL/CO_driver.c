@@ -52,18 +52,167 @@
 #include "can.h" /* Include HAL interfaces generated by cube MX. */
 #include "CO_driver.h"
 #include "CO_Emergency.h"
+#if CO_CAN_RECORDER > 0
+#include "CO_CANrecorder.h"
+#endif
+
+#if CO_CAN_DATA_SIZE != 8U
+#error bxCAN transmits classic frames with 8 data bytes, CO_CAN_DATA_SIZE must be 8
+#endif
 
 /*-----------------------------------------------------------------------------
  * LOCAL (static) DEFINITIONS
  *----------------------------------------------------------------------------*/
-/*\brief pointer to CO_CanModule used in CubeMX CAN Rx interrupt routine*/
-static CO_CANmodule_t* RxFifo_Callback_CanModule_p = NULL;
-/*\brief TxHeader object used for transmission */
-static CAN_TxHeaderTypeDef TxHeader;
+/*\brief pointers to CO_CanModule used in CubeMX CAN interrupt routines, indexed by CO_CANmoduleIndex() */
+static CO_CANmodule_t* CO_CANmodules[CO_CAN_NO_MODULES];
+/*\brief ident and mask of CO_CANrx_t, which accept only one identifier (11 bit + RTR) */
+#define CO_CAN_RX_MASK_EXACT    ((0x07FFU << 2) | 0x02U)
+/*\brief IDE bit in 16-bit filter; always compared, only standard frames are accepted */
+#define CO_CAN_FILTER16_IDE     0x0008U
+#if CO_CAN_EXT_ID > 0
+/*\brief mask of CO_CANrxExt_t, which accepts only one identifier (29 bit + IDE + RTR) */
+#define CO_CAN_RX_EXT_MASK_EXACT ((0x1FFFFFFFU << CAN_RI0R_EXID_Pos) | CAN_RI0R_IDE | CAN_RI0R_RTR)
+/*\brief flag in CO_CANtx_t ident, which marks 29-bit identifier (29-bit << 2 | RTR << 1) */
+#define CO_CAN_TX_EXT           0x80000000U
+#endif
+/*\brief adds n to CAN statistics counter, see CO_CAN_STATISTICS */
+#if CO_CAN_STATISTICS > 0
+#define CO_CAN_STAT_ADD(CANmodule, counter, n)  ((CANmodule)->stats.counter += (n))
+#else
+#define CO_CAN_STAT_ADD(CANmodule, counter, n)
+#endif
+#if CO_CAN_BUSLOAD > 0
+/*\brief bits after CRC sequence: CRC delimiter, ACK slot and delimiter, EOF and intermission */
+#define CO_CAN_FRAME_TAIL_BITS  13U
+#if CO_CAN_BUSLOAD_EXACT_STUFFING > 0
+/*\brief state of bit stuffing and CRC calculation of one frame */
+typedef struct{
+	uint16_t crc;       /* CRC-15 shift register */
+	uint8_t  last;      /* value of previous bit on the bus */
+	uint8_t  run;       /* number of consecutive equal bits */
+	uint8_t  stuff;     /* number of inserted stuff bits */
+}CO_CANstuff_t;
+#endif
+#endif
+#if CO_CAN_ERROR_IRQ > 0
+/*\brief error and status change interrupts, see CO_CAN_ERROR_IRQ */
+#define CO_CAN_IT_ERRORS        (CAN_IT_ERROR_WARNING | CAN_IT_ERROR_PASSIVE | CAN_IT_BUSOFF | \
+		CAN_IT_LAST_ERROR_CODE | CAN_IT_ERROR | CAN_IT_RX_FIFO0_OVERRUN | CAN_IT_RX_FIFO1_OVERRUN)
+/*\brief error states in CO_CANmodule_t errFlags */
+#define CO_CAN_ERR_WARNING      0x01U
+#define CO_CAN_ERR_TX_PASSIVE   0x02U
+#define CO_CAN_ERR_RX_PASSIVE   0x04U
+#define CO_CAN_ERR_BUS_OFF      0x08U
+#endif
+#if CO_CAN_BUSOFF_RECOVERY > 0
+/*\brief states of bus-off recovery, CO_CANmodule_t busOffState */
+#define CO_CAN_BUSOFF_ACTIVE    0U  /* not bus-off, back-off is cleared after CO_CAN_BUSOFF_STABLE_MS */
+#define CO_CAN_BUSOFF_WAIT      1U  /* bus-off, waits busOffDelay */
+#define CO_CAN_BUSOFF_INIT      2U  /* initialization mode requested */
+#define CO_CAN_BUSOFF_RECOVER   3U  /* bxCAN waits for 128 x 11 recessive bits */
+#endif
+#if CO_CAN_RX_STORM > 0
+/*\brief states of storm protection, CO_CANrx_t stormState */
+#define CO_CAN_STORM_PASS       0U  /* frames take tokens */
+#define CO_CAN_STORM_BLOCKED    1U  /* bucket ran empty in receive interrupt */
+#define CO_CAN_STORM_FILTERED   2U  /* hardware filter removed by CO_CANverifyErrors() */
+/*\brief tokens of one frame and of full bucket */
+#define CO_CAN_STORM_FRAME      1000U
+#define CO_CAN_STORM_FULL       (CO_CAN_RX_STORM_BURST * CO_CAN_STORM_FRAME)
+#endif
 /*-----------------------------------------------------------------------------
  * LOCAL FUNCTION PROTOTYPES
  *----------------------------------------------------------------------------*/
 static void prepareTxHeader(CAN_TxHeaderTypeDef *TxHeader, CO_CANtx_t *buffer);
+static uint8_t CO_CANmoduleIndex(const CAN_TypeDef *Instance);
+static CO_CANmodule_t *CO_CANmoduleGet(const CAN_HandleTypeDef *hcan);
+static uint16_t CO_CANfilter16(uint16_t identOrMask);
+static bool_t CO_CANfilterIsDuplicate(const CO_CANmodule_t *CANmodule, uint16_t index);
+static bool_t CO_CANfilterNeeded(const CO_CANrx_t *buffer);
+static uint32_t CO_CANfilterFifo(uint16_t ident);
+static CO_ReturnError_t CO_CANfilterProgram(CO_CANmodule_t *CANmodule,
+		uint8_t bank, bool_t listMode, bool_t scale32, uint32_t fifo, uint32_t FR1, uint32_t FR2);
+#if CO_CAN_EXT_ID > 0
+static uint16_t CO_CANfilterBanksExt(const CO_CANmodule_t *CANmodule);
+static CO_ReturnError_t CO_CANconfigFiltersExt(CO_CANmodule_t *CANmodule,
+		uint8_t *bank, uint8_t *fmi, uint8_t *filterToRx);
+static void CO_CANinterrupt_RxExt(CO_CANmodule_t *CANmodule, uint32_t fifo,
+		uint32_t filterMatchIndex, uint32_t IR, const CO_CANrxMsg_t *CANmessage);
+#endif
+#if CO_CAN_BRIDGE > 0
+static CO_ReturnError_t CO_CANconfigFiltersBridge(CO_CANmodule_t *CANmodule,
+		uint8_t *bank, uint8_t *fmi, uint8_t *filterToRx);
+static void CO_CANbridgeFill(CO_CANmodule_t *CANmodule);
+static void CO_CANbridgeForward(CO_CANmodule_t *CANmodule, const CO_CANbridgeRoute_t *route,
+		uint32_t RIR, uint32_t RDTR, uint32_t RDLR, uint32_t RDHR);
+static bool_t CO_CANbridgeRx(CO_CANmodule_t *CANmodule, uint32_t fifo,
+		uint32_t RIR, uint32_t RDTR, uint32_t RDLR, uint32_t RDHR);
+#endif
+static CO_ReturnError_t CO_CANconfigFilters(CO_CANmodule_t *CANmodule);
+static void CO_CANrxRange(void *object, const CO_CANrxMsg_t *message);
+static bool_t CO_CANrxDispatch(CO_CANmodule_t *CANmodule, uint32_t fifo,
+		uint32_t filterMatchIndex, uint16_t msg, const CO_CANrxMsg_t *CANmessage);
+#if CO_CAN_RX_STORM > 0
+static bool_t CO_CANrxStormPass(CO_CANmodule_t *CANmodule, CO_CANrx_t *buffer);
+static void CO_CANrxStormProcess(CO_CANmodule_t *CANmodule);
+#endif
+static uint32_t CO_CANtxArbitration(uint32_t ident);
+static void CO_CANtxRank(CO_CANmodule_t *CANmodule);
+static void CO_CANtxPendingSet(CO_CANmodule_t *CANmodule, const CO_CANtx_t *buffer);
+static void CO_CANtxPendingClear(CO_CANmodule_t *CANmodule, uint8_t rank);
+static CO_CANtx_t *CO_CANtxNext(CO_CANmodule_t *CANmodule, bool_t critical);
+static bool_t CO_CANtxMailboxFree(const CO_CANmodule_t *CANmodule);
+static void CO_CANrxSlices(CO_CANmodule_t *CANmodule, uint32_t index,
+		uint16_t ident, const CO_CANrxMsg_t *CANmessage);
+#if CO_CAN_TX_DIRECT > 0
+static void CO_CANtxWriteMailbox(CAN_TypeDef *CANx, uint32_t mailbox, const CO_CANtx_t *buffer);
+#endif
+static bool_t CO_CANtxWrite(CO_CANmodule_t *CANmodule, const CO_CANtx_t *buffer);
+static void CO_CANtxRelease(CO_CANmodule_t *CANmodule, CO_CANtx_t *buffer);
+#if CO_CAN_TX_CRITICAL > 0
+static void CO_CANtxFillCritical(CO_CANmodule_t *CANmodule);
+#endif
+static bool_t CO_CANtxFill(CO_CANmodule_t *CANmodule);
+#if CO_CAN_RX_DISPATCH > 0
+static void CO_CANupdateDispatch(CO_CANmodule_t *CANmodule, uint16_t index,
+		uint16_t oldIdent, uint16_t oldMask, bool_t oldUsed);
+#endif
+static CO_ReturnError_t CO_CANsetBitTiming(CO_CANmodule_t *CANmodule, uint16_t CANbitRate);
+#if CO_CAN_WARM_RESET > 0
+static bool_t CO_CANisRunning(CO_CANmodule_t *CANmodule, uint16_t CANbitRate);
+#endif
+#if CO_CAN_AUTO_BITRATE > 0
+static bool_t CO_CANlistenBitRate(CO_CANmodule_t *CANmodule);
+static CO_ReturnError_t CO_CANdetectBitRate(CO_CANmodule_t *CANmodule);
+#endif
+#if CO_CAN_BUSLOAD > 0
+#if CO_CAN_BUSLOAD_EXACT_STUFFING > 0
+static void CO_CANstuffBits(CO_CANstuff_t *stuff, uint32_t value, uint8_t count, bool_t crc);
+#endif
+static uint8_t CO_CANframeBits(uint32_t IR, uint32_t DTR, uint32_t DLR, uint32_t DHR);
+static void CO_CANbusLoadTx(CO_CANmodule_t *CANmodule, uint32_t mailbox);
+#endif
+#if CO_CAN_RECORDER > 0
+static void CO_CANrecordTx(CO_CANmodule_t *CANmodule, uint32_t mailbox);
+#endif
+#if CO_CAN_TX_LATENCY > 0
+static void CO_CANtxLatencyArm(CO_CANmodule_t *CANmodule, uint32_t mailbox, const CO_CANtx_t *buffer);
+static void CO_CANtxLatencyDone(CO_CANmodule_t *CANmodule, uint32_t mailbox);
+static void CO_CANtxLatencyClear(CO_CANtxLatency_t *latency);
+#endif
+#if CO_CAN_ERROR_IRQ > 0
+static void CO_CANerrorUpdate(CO_CANmodule_t *CANmodule, uint32_t ESR);
+#endif
+#if (CO_CAN_BUSOFF_RECOVERY > 0) || (CO_CAN_TX_LOOPBACK > 0)
+static bool_t CO_CANtxIsPDO(const CO_CANtx_t *buffer);
+#endif
+#if CO_CAN_TX_LOOPBACK > 0
+static bool_t CO_CANtxLoopback(CO_CANmodule_t *CANmodule, const CO_CANtx_t *buffer);
+#endif
+#if CO_CAN_BUSOFF_RECOVERY > 0
+static void CO_CANbusOffFlush(CO_CANmodule_t *CANmodule);
+static void CO_CANbusOffProcess(CO_CANmodule_t *CANmodule, bool_t busOff);
+#endif
 
 /*-----------------------------------------------------------------------------
  * LOCAL FUNCTIONS
@@ -79,217 +228,3366 @@ static void prepareTxHeader(CAN_TxHeaderTypeDef *TxHeader, CO_CANtx_t *buffer);
  *
  * \ingroup CO_driver
  ******************************************************************************/
-void prepareTxHeader(CAN_TxHeaderTypeDef *TxHeader, CO_CANtx_t *buffer)
+CO_RAMFUNC static void prepareTxHeader(CAN_TxHeaderTypeDef *TxHeader, CO_CANtx_t *buffer)
 {
 	/* Map buffer data to the HAL CAN tx header data*/
-	TxHeader->ExtId = 0u;
-	TxHeader->IDE = 0;
+#if CO_CAN_EXT_ID > 0
+	if((buffer->ident & CO_CAN_TX_EXT) != 0U)
+	{
+		TxHeader->ExtId = (buffer->ident >> 2) & 0x1FFFFFFFU;
+		TxHeader->StdId = 0u;
+		TxHeader->IDE = CAN_ID_EXT;
+	}
+	else
+#endif
+	{
+		TxHeader->ExtId = 0u;
+		TxHeader->StdId = ( buffer->ident >> 2 );
+		TxHeader->IDE = CAN_ID_STD;
+	}
 	TxHeader->DLC = buffer->DLC;
-	TxHeader->StdId = ( buffer->ident >> 2 );
 	TxHeader->RTR = ( buffer->ident & 0x2 );
+	TxHeader->TransmitGlobalTime = DISABLE;
+
+#if CO_CAN_TX_DIRECT > 0
+	/* Mailbox register images for direct transmission, HAL IDE and RTR
+	 * values are the same as TIR bits */
+	buffer->TIR = CO_CANtxArbitration(buffer->ident);
+	buffer->TDTR = TxHeader->DLC & CAN_TDT0R_DLC;
+#endif
 }
 
-/*-----------------------------------------------------------------------------
- * GLOBAL FUNCTIONS - see descriptions in header file
- *----------------------------------------------------------------------------*/
+/*!*****************************************************************************
+ * \brief returns index of the CAN peripheral in CO_CANmodules.
+ * \param [in]	Instance CAN peripheral (CAN1 or CAN2)
+ * \return 0 for CAN1, 1 for CAN2
+ *
+ * \ingroup CO_driver
+ ******************************************************************************/
+static uint8_t CO_CANmoduleIndex(const CAN_TypeDef *Instance)
+{
+#if defined(CAN2)
+	return (Instance == CAN2) ? 1U : 0U;
+#else
+	return 0U;
+#endif
+}
 
-//TODO move callbacks to the CO_driver.c and implement callback init routine
+/*!*****************************************************************************
+ * \brief returns CO_CANmodule_t, which was initialized with the HAL handle.
+ * \param [in]	hcan HAL CAN handle from the CubeMX callback
+ * \return pointer to CO_CANmodule_t or NULL if CO_CANmodule_init() was not called yet
+ *
+ * \ingroup CO_driver
+ ******************************************************************************/
+static CO_CANmodule_t *CO_CANmoduleGet(const CAN_HandleTypeDef *hcan)
+{
+	CO_CANmodule_t *CANmodule = CO_CANmodules[CO_CANmoduleIndex(hcan->Instance)];
 
-/* \brief 	Cube MX callbacks for Fifo0 and Fifo1
- * \details It is assumed that only one CANmodule is (CO->CANmodule[0]) is used.
- */
-void HAL_CAN_RxFifo0MsgPendingCallback(CAN_HandleTypeDef *hcan)
+	if((CANmodule != NULL) && (CANmodule->CANbaseAddress == hcan))
+	{
+		return CANmodule;
+	}
+	else
+	{
+		return NULL;
+	}
+}
+
+/*!*****************************************************************************
+ * \brief converts CO_CANrx_t ident or mask to the bxCAN 16-bit filter format.
+ * \details STDID[10:0] is placed in bits 15..5, RTR in bit 4. IDE and EXTID
+ * bits are left zero.
+ * \param [in]	identOrMask ident or mask from CO_CANrx_t (11-bit << 2 | RTR << 1)
+ * \return value for FilterIdLow/High or FilterMaskIdLow/High
+ *
+ * \ingroup CO_driver
+ ******************************************************************************/
+static uint16_t CO_CANfilter16(uint16_t identOrMask)
 {
-	if(RxFifo_Callback_CanModule_p != NULL)
+	uint16_t filter = (uint16_t)(((identOrMask >> 2) & 0x07FFU) << 5);
+
+	if(identOrMask & 0x02U)
 	{
-		CO_CANinterrupt_Rx(RxFifo_Callback_CanModule_p);
+		filter |= 0x0010U;
 	}
 	else
 	{
-		;/*TODO add assert, according to Cube MX driver we should not be here
-		 *but for some reason interrupts get activated as soon as HAL_NVIC_EnableIRQ is called.
-		 *According to Cube CAN docs HAL_CAN_ActivateNotification should be executed to
-		 *activate callbacks.
-		 */
+		;//do nothing
+	}
+	return filter;
+}
+
+/*!*****************************************************************************
+ * \brief checks if rxArray member with lower index has the same ident and mask.
+ * \details Disabled CANopen objects (PDOs, heartbeat consumers) are all
+ * registered with identifier 0. Software search uses the first matching
+ * member, so duplicates don't need own filter.
+ * \param [in]	CANmodule pointer to CO_CANmodule_t object
+ * \param [in]	index index of the member in rxArray
+ * \return true if member does not need own filter
+ *
+ * \ingroup CO_driver
+ ******************************************************************************/
+static bool_t CO_CANfilterIsDuplicate(const CO_CANmodule_t *CANmodule, uint16_t index)
+{
+	const CO_CANrx_t *buffer = &CANmodule->rxArray[index];
+	uint16_t i;
+
+	for(i = 0U; i < index; i++)
+	{
+		const CO_CANrx_t *other = &CANmodule->rxArray[i];
+
+		if(CO_CANfilterNeeded(other) && (other->mask == buffer->mask) &&
+				(((other->ident ^ buffer->ident) & buffer->mask) == 0U))
+		{
+			return true;
+		}
+		else
+		{
+			;//do nothing
+		}
 	}
+	return false;
+}
+
+/*!*****************************************************************************
+ * \brief checks if rxArray member is configured and not blocked.
+ * \details Members blocked by CO_CAN_RX_STORM get no filter.
+ * \param [in]	buffer rxArray member
+ * \return true if member needs filter
+ *
+ * \ingroup CO_driver
+ ******************************************************************************/
+static bool_t CO_CANfilterNeeded(const CO_CANrx_t *buffer)
+{
+#if CO_CAN_RX_STORM > 0
+	return (buffer->pFunct != NULL) && (buffer->stormState == CO_CAN_STORM_PASS);
+#else
+	return buffer->pFunct != NULL;
+#endif
+}
+
+/*!*****************************************************************************
+ * \brief returns receive FIFO for CAN identifier.
+ * \details Time critical objects (NMT, SYNC, EMCY, TIME, PDO) are received
+ * by FIFO0, SDO, heartbeat and LSS by FIFO1, so bulk traffic never delays
+ * time critical frames. See CO_CAN_RX_FIFO1_MIN_ID.
+ * \param [in]	ident ident from CO_CANrx_t (11-bit << 2 | RTR << 1)
+ * \return CAN_RX_FIFO0 or CAN_RX_FIFO1
+ *
+ * \ingroup CO_driver
+ ******************************************************************************/
+static uint32_t CO_CANfilterFifo(uint16_t ident)
+{
+	return ((ident >> 2) >= CO_CAN_RX_FIFO1_MIN_ID) ? CAN_RX_FIFO1 : CAN_RX_FIFO0;
 }
 
-void HAL_CAN_RxFifo1MsgPendingCallback(CAN_HandleTypeDef *hcan)
+/*!*****************************************************************************
+ * \brief programs one filter bank, if it differs from the shadow copy.
+ * \param [in]	CANmodule pointer to CO_CANmodule_t object
+ * \param [in]	bank filter bank number
+ * \param [in]	listMode true for identifier list mode, false for mask mode
+ * \param [in]	scale32 true for 32-bit scale (extended identifiers), false for 16-bit
+ * \param [in]	fifo CAN_RX_FIFO0 or CAN_RX_FIFO1
+ * \param [in]	FR1 first register value (16-bit: low half IdLow, high half
+ * MaskIdLow; 32-bit: identifier)
+ * \param [in]	FR2 second register value (16-bit: low half IdHigh, high half
+ * MaskIdHigh; 32-bit: second identifier or mask)
+ * \return CO_ERROR_NO or CO_ERROR_HAL
+ *
+ * \ingroup CO_driver
+ ******************************************************************************/
+static CO_ReturnError_t CO_CANfilterProgram(CO_CANmodule_t *CANmodule,
+		uint8_t bank, bool_t listMode, bool_t scale32, uint32_t fifo, uint32_t FR1, uint32_t FR2)
 {
-	if(RxFifo_Callback_CanModule_p != NULL)
+	CAN_FilterTypeDef FilterConfig;
+	uint16_t bankBit = (uint16_t)(1U << bank);
+	bool_t wasListMode = (CANmodule->filterListMode & bankBit) != 0U;
+	bool_t wasFifo1 = (CANmodule->filterFifo1 & bankBit) != 0U;
+	bool_t wasScale32 = (CANmodule->filterScale32 & bankBit) != 0U;
+
+	if((bank < CANmodule->filterBanksUsed) && (wasListMode == listMode) &&
+			(wasFifo1 == (fifo == CAN_RX_FIFO1)) && (wasScale32 == scale32) &&
+			(CANmodule->filterFR[bank][0] == FR1) && (CANmodule->filterFR[bank][1] == FR2))
 	{
-		CO_CANinterrupt_Rx(RxFifo_Callback_CanModule_p);
+		/* bank is already configured */
+		return CO_ERROR_NO;
 	}
 	else
 	{
-		;//TODO add assert here
+		;//do nothing
+	}
+
+	FilterConfig.FilterBank = CANmodule->filterBankFirst + bank;
+	FilterConfig.FilterMode = listMode ? CAN_FILTERMODE_IDLIST : CAN_FILTERMODE_IDMASK;
+	if(scale32)
+	{
+		/* HAL writes FR1 = IdHigh:IdLow, FR2 = MaskIdHigh:MaskIdLow */
+		FilterConfig.FilterScale = CAN_FILTERSCALE_32BIT;
+		FilterConfig.FilterIdHigh = FR1 >> 16;
+		FilterConfig.FilterIdLow = FR1 & 0xFFFFU;
+		FilterConfig.FilterMaskIdHigh = FR2 >> 16;
+		FilterConfig.FilterMaskIdLow = FR2 & 0xFFFFU;
+	}
+	else
+	{
+		FilterConfig.FilterScale = CAN_FILTERSCALE_16BIT;
+		FilterConfig.FilterIdLow = FR1 & 0xFFFFU;
+		FilterConfig.FilterMaskIdLow = FR1 >> 16;
+		FilterConfig.FilterIdHigh = FR2 & 0xFFFFU;
+		FilterConfig.FilterMaskIdHigh = FR2 >> 16;
+	}
+	FilterConfig.FilterFIFOAssignment = fifo;
+	FilterConfig.FilterActivation = ENABLE;
+	FilterConfig.SlaveStartFilterBank = CO_CAN_FILTER_BANKS;
+
+	if(HAL_CAN_ConfigFilter(CANmodule->CANbaseAddress, &FilterConfig) != HAL_OK)
+	{
+		return CO_ERROR_HAL;
+	}
+	else
+	{
+		;//do nothing
+	}
+
+	CANmodule->filterFR[bank][0] = FR1;
+	CANmodule->filterFR[bank][1] = FR2;
+	if(listMode)
+	{
+		CANmodule->filterListMode |= bankBit;
 	}
+	else
+	{
+		CANmodule->filterListMode &= (uint16_t)~bankBit;
+	}
+	if(fifo == CAN_RX_FIFO1)
+	{
+		CANmodule->filterFifo1 |= bankBit;
+	}
+	else
+	{
+		CANmodule->filterFifo1 &= (uint16_t)~bankBit;
+	}
+	if(scale32)
+	{
+		CANmodule->filterScale32 |= bankBit;
+	}
+	else
+	{
+		CANmodule->filterScale32 &= (uint16_t)~bankBit;
+	}
+	return CO_ERROR_NO;
 }
 
-void CO_CANsetConfigurationMode(int32_t CANbaseAddress){
-	/* Put CAN module in configuration mode */
-	/* HAL is responsible for that */
+#if CO_CAN_EXT_ID > 0
+/*!*****************************************************************************
+ * \brief returns number of 32-bit filter banks needed by extended receive buffers.
+ * \param [in]	CANmodule pointer to CO_CANmodule_t object
+ * \return two exact identifiers per list bank plus one bank per identifier/mask pair
+ *
+ * \ingroup CO_driver
+ ******************************************************************************/
+static uint16_t CO_CANfilterBanksExt(const CO_CANmodule_t *CANmodule)
+{
+	uint16_t nList = 0U;
+	uint16_t nMask = 0U;
+	uint16_t i;
+
+	for(i = 0U; i < CO_CAN_EXT_RX_SIZE; i++)
+	{
+		const CO_CANrxExt_t *buffer = &CANmodule->rxExt[i];
+
+		if(buffer->pFunct == NULL)
+		{
+			continue;
+		}
+		else if(buffer->mask == CO_CAN_RX_EXT_MASK_EXACT)
+		{
+			nList++;
+		}
+		else
+		{
+			nMask++;
+		}
+	}
+	return (uint16_t)((nList + 1U) / 2U + nMask);
 }
 
-/******************************************************************************/
-CO_ReturnError_t CO_CANsetNormalMode(CO_CANmodule_t *CANmodule){
-	/* Put CAN module in normal mode */
+/*!*****************************************************************************
+ * \brief builds 32-bit FIFO1 filter banks from configured extended receive buffers.
+ * \details Called by CO_CANconfigFilters() after the standard FIFO1 banks.
+ * Exact identifiers are packed two per bank in list mode, identifier/mask pairs
+ * one per bank in mask mode. Filter value has the layout of RIR register, which
+ * is also used by CO_CANrxExt_t. filterToRx holds index in rxExt for these FMI.
+ * \param [in]	CANmodule pointer to CO_CANmodule_t object
+ * \param [in,out]	bank next free filter bank
+ * \param [in,out]	fmi next filter match index in filterToRx
+ * \param [out]	filterToRx FMI to buffer index table under construction
+ * \return CO_ERROR_NO or CO_ERROR_HAL
+ *
+ * \ingroup CO_driver
+ ******************************************************************************/
+static CO_ReturnError_t CO_CANconfigFiltersExt(CO_CANmodule_t *CANmodule,
+		uint8_t *bank, uint8_t *fmi, uint8_t *filterToRx)
+{
+	uint32_t slots[2];
+	uint16_t i;
+	uint8_t pass;
+	uint8_t slot;
+	CO_ReturnError_t ret = CO_ERROR_NO;
 
-	CO_ReturnError_t Error = CO_ERROR_NO;
-	if(HAL_CAN_Start(CANmodule->CANbaseAddress) != HAL_OK)
+	/* pass 0: list mode, pass 1: mask mode */
+	for(pass = 0U; pass < 2U; pass++)
 	{
-		/* Start Error */
-		Error = CO_ERROR_HAL;
+		bool_t listMode = pass == 0U;
+		uint8_t slotsPerBank = listMode ? 2U : 1U;
+
+		slot = 0U;
+		for(i = 0U; i <= CO_CAN_EXT_RX_SIZE; i++)
+		{
+			if(i < CO_CAN_EXT_RX_SIZE)
+			{
+				const CO_CANrxExt_t *buffer = &CANmodule->rxExt[i];
+
+				if((buffer->pFunct == NULL) ||
+						((buffer->mask == CO_CAN_RX_EXT_MASK_EXACT) != listMode))
+				{
+					continue;
+				}
+				else if(listMode)
+				{
+					slots[slot] = buffer->ident;
+				}
+				else
+				{
+					slots[0] = buffer->ident;
+					slots[1] = buffer->mask;
+				}
+				filterToRx[*fmi + slot] = (uint8_t)i;
+				slot++;
+			}
+			else if(slot == 0U)
+			{
+				/* end of array, no partially filled bank */
+				break;
+			}
+			else
+			{
+				/* end of array, free slot of the list bank repeats the identifier */
+				slots[1] = slots[0];
+				filterToRx[*fmi + 1U] = filterToRx[*fmi];
+				slot = slotsPerBank;
+			}
+
+			if(slot == slotsPerBank)
+			{
+				if(CO_CANfilterProgram(CANmodule, *bank, listMode, true, CAN_RX_FIFO1,
+						slots[0], slots[1]) != CO_ERROR_NO)
+				{
+					ret = CO_ERROR_HAL;
+				}
+				else
+				{
+					;//do nothing
+				}
+				(*bank)++;
+				*fmi += slotsPerBank;
+				slot = 0U;
+			}
+			else
+			{
+				;//do nothing
+			}
+		}
+	}
+	return ret;
+}
+#endif
+
+#if CO_CAN_BRIDGE > 0
+/*!*****************************************************************************
+ * \brief builds 16-bit FIFO1 mask filter banks from configured bridge routes.
+ * \details Called by CO_CANconfigFilters() after all other banks, two routes
+ * per bank. filterToRx holds index in bridgeRoute for these FMI.
+ * \param [in]	CANmodule pointer to CO_CANmodule_t object
+ * \param [in,out]	bank next free filter bank
+ * \param [in,out]	fmi next filter match index in filterToRx
+ * \param [out]	filterToRx FMI to buffer index table under construction
+ * \return CO_ERROR_NO or CO_ERROR_HAL
+ *
+ * \ingroup CO_driver
+ ******************************************************************************/
+static CO_ReturnError_t CO_CANconfigFiltersBridge(CO_CANmodule_t *CANmodule,
+		uint8_t *bank, uint8_t *fmi, uint8_t *filterToRx)
+{
+	uint32_t slots[2];
+	uint16_t i;
+	uint8_t slot = 0U;
+	CO_ReturnError_t ret = CO_ERROR_NO;
+
+	for(i = 0U; i <= CO_CAN_BRIDGE; i++)
+	{
+		if(i < CO_CAN_BRIDGE)
+		{
+			const CO_CANbridgeRoute_t *route = &CANmodule->bridgeRoute[i];
+
+			if(route->target == NULL)
+			{
+				continue;
+			}
+			else
+			{
+				/* IdLow/MaskIdLow or IdHigh/MaskIdHigh pair */
+				slots[slot] = ((uint32_t)(CO_CANfilter16(route->mask) | CO_CAN_FILTER16_IDE) << 16) |
+						CO_CANfilter16(route->ident);
+				filterToRx[*fmi + slot] = (uint8_t)i;
+				slot++;
+			}
+		}
+		else if(slot == 0U)
+		{
+			/* end of array, no partially filled bank */
+			break;
+		}
+		else
+		{
+			/* end of array, free slot repeats the route */
+			slots[1] = slots[0];
+			filterToRx[*fmi + 1U] = filterToRx[*fmi];
+			slot = 2U;
+		}
+
+		if(slot == 2U)
+		{
+			if(CO_CANfilterProgram(CANmodule, *bank, false, false, CAN_RX_FIFO1,
+					slots[0], slots[1]) != CO_ERROR_NO)
+			{
+				ret = CO_ERROR_HAL;
+			}
+			else
+			{
+				;//do nothing
+			}
+			(*bank)++;
+			*fmi += 2U;
+			slot = 0U;
+		}
+		else
+		{
+			;//do nothing
+		}
+	}
+	return ret;
+}
+#endif
+
+/*!*****************************************************************************
+ * \brief builds bxCAN acceptance filters from all configured rxArray members.
+ * \details Banks for FIFO0 are placed first, banks for FIFO1 follow. Inside
+ * each FIFO exact identifiers are packed four per bank in 16-bit list mode,
+ * remaining identifier/mask pairs follow two per bank in 16-bit mask mode.
+ * Filter match index (FMI) is numbered separately for each FIFO over its
+ * banks, four per list bank and two per mask bank. filterToRx holds FIFO0
+ * indexes first, FIFO1 indexes start at filterFifo1Start. Free slots repeat
+ * the first identifier of the bank, so they never produce a different FMI.
+ * With CO_CAN_EXT_ID, 32-bit banks of extended receive buffers follow.
+ * With CO_CAN_BRIDGE, mask banks of routes in FIFO1 follow last.
+ * If banks run out, single accept-all filter to FIFO0 is configured and
+ * useCANrxFilters is cleared.
+ * \param [in]	CANmodule pointer to CO_CANmodule_t object
+ * \return CO_ERROR_NO or CO_ERROR_HAL
+ *
+ * \ingroup CO_driver
+ ******************************************************************************/
+static CO_ReturnError_t CO_CANconfigFilters(CO_CANmodule_t *CANmodule)
+{
+	uint8_t filterToRx[CO_CAN_FILTER_NO_FMI];
+	uint16_t slots[4];
+	uint16_t nEntries[4] = {0U, 0U, 0U, 0U};
+	uint16_t banksNeeded = 0U;
+	uint16_t i;
+	uint8_t bank;
+	uint8_t fmi;
+	uint8_t fifo1Start = 0U;
+
+	if(CANmodule->rxFiltersDeferred)
+	{
+		/* buffers are still registered, see CO_CANsetNormalMode() */
+		return CO_ERROR_NO;
+	}
+	else
+	{
+		;//do nothing
+	}
+#if CO_CAN_BRIDGE > 0
+	uint8_t bridgeStart;
+	uint8_t routes = 0U;
+#endif
+	uint8_t slot;
+	uint8_t pass;
+	CO_ReturnError_t ret = CO_ERROR_NO;
+
+	/* count identifiers, which need own filter. Pass is 0..3:
+	 * FIFO0 list, FIFO0 mask, FIFO1 list, FIFO1 mask */
+	for(i = 0U; i < CANmodule->rxSize; i++)
+	{
+		const CO_CANrx_t *buffer = &CANmodule->rxArray[i];
+
+		if(!CO_CANfilterNeeded(buffer) || CO_CANfilterIsDuplicate(CANmodule, i))
+		{
+			continue;
+		}
+		else
+		{
+			pass = (CO_CANfilterFifo(buffer->ident) == CAN_RX_FIFO1) ? 2U : 0U;
+			if(buffer->mask != CO_CAN_RX_MASK_EXACT)
+			{
+				pass++;
+			}
+			else
+			{
+				;//do nothing
+			}
+			nEntries[pass]++;
+		}
+	}
+	banksNeeded = (nEntries[0] + 3U) / 4U + (nEntries[1] + 1U) / 2U +
+			(nEntries[2] + 3U) / 4U + (nEntries[3] + 1U) / 2U;
+#if CO_CAN_EXT_ID > 0
+	banksNeeded += CO_CANfilterBanksExt(CANmodule);
+#endif
+#if CO_CAN_BRIDGE > 0
+	for(i = 0U; i < CO_CAN_BRIDGE; i++)
+	{
+		if(CANmodule->bridgeRoute[i].target != NULL)
+		{
+			routes++;
+		}
+		else
+		{
+			;//do nothing
+		}
+	}
+	banksNeeded += (routes + 1U) / 2U;
+#endif
+
+	if(CANmodule->useCANrxFilters && (banksNeeded <= CO_CAN_FILTER_BANKS))
+	{
+		for(i = 0U; i < CO_CAN_FILTER_NO_FMI; i++)
+		{
+			filterToRx[i] = CO_CAN_FILTER_UNUSED;
+		}
+
+		bank = 0U;
+		fmi = 0U;
+		for(pass = 0U; pass < 4U; pass++)
+		{
+			bool_t listMode = (pass & 1U) == 0U;
+			uint32_t fifo = (pass < 2U) ? CAN_RX_FIFO0 : CAN_RX_FIFO1;
+			uint8_t slotsPerBank = listMode ? 4U : 2U;
+			uint8_t firstIdx = CO_CAN_FILTER_UNUSED;
+
+			if(pass == 2U)
+			{
+				/* FMI numbering restarts for FIFO1 */
+				fifo1Start = fmi;
+			}
+			else
+			{
+				;//do nothing
+			}
+
+			slot = 0U;
+			for(i = 0U; i <= CANmodule->rxSize; i++)
+			{
+				if(i < CANmodule->rxSize)
+				{
+					const CO_CANrx_t *buffer = &CANmodule->rxArray[i];
+					bool_t exact = buffer->mask == CO_CAN_RX_MASK_EXACT;
+
+					if(!CO_CANfilterNeeded(buffer) || (exact != listMode) ||
+							(CO_CANfilterFifo(buffer->ident) != fifo) ||
+							CO_CANfilterIsDuplicate(CANmodule, i))
+					{
+						continue;
+					}
+					else
+					{
+						;//do nothing
+					}
+
+					if(listMode)
+					{
+						slots[slot] = CO_CANfilter16(buffer->ident);
+					}
+					else
+					{
+						slots[slot * 2U] = CO_CANfilter16(buffer->ident);
+						slots[slot * 2U + 1U] = CO_CANfilter16(buffer->mask) | CO_CAN_FILTER16_IDE;
+					}
+					if(slot == 0U)
+					{
+						firstIdx = (uint8_t)i;
+					}
+					else
+					{
+						;//do nothing
+					}
+					filterToRx[fmi + slot] = (uint8_t)i;
+					slot++;
+				}
+				else if(slot == 0U)
+				{
+					/* end of array, no partially filled bank */
+					break;
+				}
+				else
+				{
+					/* end of array, fill the free slots with the first identifier */
+					for(; slot < slotsPerBank; slot++)
+					{
+						if(listMode)
+						{
+							slots[slot] = slots[0];
+						}
+						else
+						{
+							slots[slot * 2U] = slots[0];
+							slots[slot * 2U + 1U] = slots[1];
+						}
+						filterToRx[fmi + slot] = firstIdx;
+					}
+				}
+
+				if(slot == slotsPerBank)
+				{
+					/* list mode: IdLow, MaskIdLow, IdHigh, MaskIdHigh are four identifiers,
+					 * mask mode: IdLow/MaskIdLow and IdHigh/MaskIdHigh are two pairs. */
+					uint32_t FR1 = ((uint32_t)slots[1] << 16) | slots[0];
+					uint32_t FR2 = ((uint32_t)slots[3] << 16) | slots[2];
+
+					if(CO_CANfilterProgram(CANmodule, bank, listMode, false, fifo, FR1, FR2) != CO_ERROR_NO)
+					{
+						ret = CO_ERROR_HAL;
+					}
+					else
+					{
+						;//do nothing
+					}
+					bank++;
+					fmi += slotsPerBank;
+					slot = 0U;
+				}
+				else
+				{
+					;//do nothing
+				}
+			}
+		}
+#if CO_CAN_EXT_ID > 0
+		/* extended identifiers follow in FIFO1 */
+		if(CO_CANconfigFiltersExt(CANmodule, &bank, &fmi, filterToRx) != CO_ERROR_NO)
+		{
+			ret = CO_ERROR_HAL;
+		}
+		else
+		{
+			;//do nothing
+		}
+#endif
+#if CO_CAN_BRIDGE > 0
+		/* routes are the last FIFO1 banks */
+		bridgeStart = fmi;
+		if(CO_CANconfigFiltersBridge(CANmodule, &bank, &fmi, filterToRx) != CO_ERROR_NO)
+		{
+			ret = CO_ERROR_HAL;
+		}
+		else
+		{
+			;//do nothing
+		}
+#endif
+
+		/* disable banks, which were used by previous configuration */
+		for(i = bank; i < CANmodule->filterBanksUsed; i++)
+		{
+			CAN_FilterTypeDef FilterConfig;
+
+			FilterConfig.FilterBank = CANmodule->filterBankFirst + i;
+			FilterConfig.FilterMode = CAN_FILTERMODE_IDMASK;
+			FilterConfig.FilterScale = CAN_FILTERSCALE_16BIT;
+			FilterConfig.FilterIdHigh = 0x0;
+			FilterConfig.FilterIdLow = 0x0;
+			FilterConfig.FilterMaskIdHigh = 0x0;
+			FilterConfig.FilterMaskIdLow = 0x0;
+			FilterConfig.FilterFIFOAssignment = CAN_RX_FIFO0;
+			FilterConfig.FilterActivation = DISABLE;
+			FilterConfig.SlaveStartFilterBank = CO_CAN_FILTER_BANKS;
+
+			if(HAL_CAN_ConfigFilter(CANmodule->CANbaseAddress, &FilterConfig) != HAL_OK)
+			{
+				ret = CO_ERROR_HAL;
+			}
+			else
+			{
+				;//do nothing
+			}
+		}
+
+		CO_LOCK_CAN_SEND();
+		for(i = 0U; i < CO_CAN_FILTER_NO_FMI; i++)
+		{
+			CANmodule->filterToRx[i] = filterToRx[i];
+		}
+		CANmodule->filterFifo1Start = fifo1Start;
+#if CO_CAN_BRIDGE > 0
+		CANmodule->filterBridgeStart = bridgeStart;
+#endif
+		CANmodule->filterBanksUsed = bank;
+		CO_UNLOCK_CAN_SEND();
+	}
+	else
+	{
+		/* not enough hardware filters, accept all and search by software */
+		CAN_FilterTypeDef FilterConfig;
+
+		CANmodule->useCANrxFilters = false;
+#if CO_CAN_BRIDGE > 0
+		CANmodule->filterBridgeStart = CO_CAN_FILTER_NO_FMI;
+#endif
+
+		FilterConfig.FilterBank = CANmodule->filterBankFirst;
+		FilterConfig.FilterMode = CAN_FILTERMODE_IDMASK;
+		FilterConfig.FilterScale = CAN_FILTERSCALE_32BIT;
+		FilterConfig.FilterIdHigh = 0x0;
+		FilterConfig.FilterIdLow = 0x0;
+		FilterConfig.FilterMaskIdHigh = 0x0;
+		FilterConfig.FilterMaskIdLow = 0x0;
+		FilterConfig.FilterFIFOAssignment = CAN_RX_FIFO0;
+		FilterConfig.FilterActivation = ENABLE;
+		FilterConfig.SlaveStartFilterBank = CO_CAN_FILTER_BANKS;
+
+		if(HAL_CAN_ConfigFilter(CANmodule->CANbaseAddress, &FilterConfig) != HAL_OK)
+		{
+			ret = CO_ERROR_HAL;
+		}
+		else
+		{
+			;//do nothing
+		}
+
+		for(i = 1U; i < CANmodule->filterBanksUsed; i++)
+		{
+			FilterConfig.FilterBank = CANmodule->filterBankFirst + i;
+			FilterConfig.FilterActivation = DISABLE;
+			if(HAL_CAN_ConfigFilter(CANmodule->CANbaseAddress, &FilterConfig) != HAL_OK)
+			{
+				ret = CO_ERROR_HAL;
+			}
+			else
+			{
+				;//do nothing
+			}
+		}
+		CANmodule->filterBanksUsed = 0U;
+	}
+
+	return ret;
+}
+
+/*!*****************************************************************************
+ * \brief returns arbitration field of CO_CANtx_t ident in TIR register layout.
+ * \details Unsigned comparison of the result gives the same order as
+ * arbitration on CAN bus: standard frame wins against extended frame with the
+ * same base identifier (IDE), data frame wins against remote frame (RTR).
+ * \param [in]	ident ident from CO_CANtx_t
+ * \return STID/EXID, IDE and RTR bits as in TIR, without TXRQ
+ *
+ * \ingroup CO_driver
+ ******************************************************************************/
+CO_RAMFUNC static uint32_t CO_CANtxArbitration(uint32_t ident)
+{
+#if CO_CAN_EXT_ID > 0
+	if((ident & CO_CAN_TX_EXT) != 0U)
+	{
+		return ((ident & 0x7FFFFFFCU) << 1) | CAN_TI0R_IDE | (ident & CAN_TI0R_RTR);
+	}
+	else
+	{
+		;//do nothing
+	}
+#endif
+	return ((ident & 0x1FFCU) << 19) | (ident & CAN_TI0R_RTR);
+}
+
+/*!*****************************************************************************
+ * \brief orders transmit buffers by priority and rebuilds the pending set.
+ * \details Priority is the same as on CAN bus: lower identifier first, data
+ * frame before remote frame with the same identifier. Called from
+ * CO_CANtxBufferInit(), as identifiers may change at runtime.
+ * \param [in]	CANmodule pointer to CO_CANmodule_t object
+ *
+ * \ingroup CO_driver
+ ******************************************************************************/
+static void CO_CANtxRank(CO_CANmodule_t *CANmodule)
+{
+	uint16_t i;
+	uint16_t j;
+
+	CO_LOCK_CAN_SEND();
+	/* insertion sort of indexes by arbitration field, txSize is small */
+	for(i = 0U; i < CANmodule->txSize; i++)
+	{
+		uint32_t arbitration = CO_CANtxArbitration(CANmodule->txArray[i].ident);
+
+		for(j = i; (j > 0U) &&
+				(CO_CANtxArbitration(CANmodule->txArray[CANmodule->txByRank[j - 1U]].ident) > arbitration); j--)
+		{
+			CANmodule->txByRank[j] = CANmodule->txByRank[j - 1U];
+		}
+		CANmodule->txByRank[j] = (uint8_t)i;
+	}
+
+	for(j = 0U; j < CO_CAN_TX_PENDING_WORDS; j++)
+	{
+		CANmodule->txPending[j] = 0U;
+#if CO_CAN_TX_CRITICAL > 0
+		CANmodule->txCritical[j] = 0U;
+#endif
+	}
+	CANmodule->CANtxCount = 0U;
+	for(i = 0U; i < CANmodule->txSize; i++)
+	{
+		CO_CANtx_t *buffer = &CANmodule->txArray[CANmodule->txByRank[i]];
+
+		buffer->rank = (uint8_t)i;
+#if CO_CAN_TX_CRITICAL > 0
+		if(buffer->critical)
+		{
+			CANmodule->txCritical[i >> 5] |= 0x80000000U >> (i & 0x1FU);
+		}
+		else
+		{
+			;//do nothing
+		}
+#endif
+		if(buffer->bufferFull)
+		{
+			CO_CANtxPendingSet(CANmodule, buffer);
+			CANmodule->CANtxCount++;
+		}
+		else
+		{
+			;//do nothing
+		}
+	}
+	CO_UNLOCK_CAN_SEND();
+}
+
+/*!*****************************************************************************
+ * \brief marks transmit buffer as waiting in the pending set.
+ * \param [in]	CANmodule pointer to CO_CANmodule_t object
+ * \param [in]	buffer transmit buffer
+ *
+ * \ingroup CO_driver
+ ******************************************************************************/
+static void CO_CANtxPendingSet(CO_CANmodule_t *CANmodule, const CO_CANtx_t *buffer)
+{
+	CANmodule->txPending[buffer->rank >> 5] |= 0x80000000U >> (buffer->rank & 0x1FU);
+}
+
+/*!*****************************************************************************
+ * \brief removes transmit buffer from the pending set.
+ * \param [in]	CANmodule pointer to CO_CANmodule_t object
+ * \param [in]	rank rank of the transmit buffer
+ *
+ * \ingroup CO_driver
+ ******************************************************************************/
+CO_RAMFUNC static void CO_CANtxPendingClear(CO_CANmodule_t *CANmodule, uint8_t rank)
+{
+	CANmodule->txPending[rank >> 5] &= ~(0x80000000U >> (rank & 0x1FU));
+}
+
+/*!*****************************************************************************
+ * \brief finds waiting transmit buffer with the highest priority.
+ * \details Lowest set bit rank in the pending set is found with CLZ. Buffers,
+ * which were released without CO_CANsend() (CANopen objects may clear
+ * bufferFull directly), are removed from the set on the way.
+ * \param [in]	CANmodule pointer to CO_CANmodule_t object
+ * \param [in]	critical if true, only buffers from txCritical are searched
+ * \return pointer to CO_CANtx_t or NULL if no message is waiting
+ *
+ * \ingroup CO_driver
+ ******************************************************************************/
+CO_RAMFUNC static CO_CANtx_t *CO_CANtxNext(CO_CANmodule_t *CANmodule, bool_t critical)
+{
+	uint8_t w;
+
+	for(w = 0U; w < CO_CAN_TX_PENDING_WORDS; w++)
+	{
+		uint32_t mask = 0xFFFFFFFFU;
+
+#if CO_CAN_TX_CRITICAL > 0
+		if(critical)
+		{
+			mask = CANmodule->txCritical[w];
+		}
+		else
+		{
+			;//do nothing
+		}
+#else
+		(void)critical;
+#endif
+		while((CANmodule->txPending[w] & mask) != 0U)
+		{
+			uint8_t rank = (uint8_t)((w << 5) + __CLZ(CANmodule->txPending[w] & mask));
+			CO_CANtx_t *buffer = &CANmodule->txArray[CANmodule->txByRank[rank]];
+
+			if(buffer->bufferFull)
+			{
+				return buffer;
+			}
+			else
+			{
+				CO_CANtxPendingClear(CANmodule, rank);
+				if(CANmodule->CANtxCount > 0U)
+				{
+					CANmodule->CANtxCount--;
+				}
+				else
+				{
+					;//do nothing
+				}
+			}
+		}
+	}
+	return NULL;
+}
+
+/*!*****************************************************************************
+ * \brief checks, if any transmit mailbox is free.
+ * \param [in]	CANmodule pointer to CO_CANmodule_t object
+ * \return true if message can be written into mailbox
+ *
+ * \ingroup CO_driver
+ ******************************************************************************/
+CO_RAMFUNC static bool_t CO_CANtxMailboxFree(const CO_CANmodule_t *CANmodule)
+{
+#if CO_CAN_TX_RESERVED > 0
+	/* mailbox 2 is used by CO_CANsendReserved() only */
+	return (CANmodule->CANbaseAddress->Instance->TSR & (CAN_TSR_TME0 | CAN_TSR_TME1)) != 0U;
+#elif CO_CAN_TX_DIRECT > 0
+	return (CANmodule->CANbaseAddress->Instance->TSR & CAN_TSR_TME) != 0U;
+#else
+	return HAL_CAN_GetTxMailboxesFreeLevel(CANmodule->CANbaseAddress) > 0U;
+#endif
+}
+
+#if CO_CAN_TX_DIRECT > 0
+/*!*****************************************************************************
+ * \brief writes mailbox registers with images from CO_CANtxBufferInit().
+ * \param [in]	CANx CAN peripheral
+ * \param [in]	mailbox free transmit mailbox 0..2
+ * \param [in]	buffer transmit buffer
+ *
+ * \ingroup CO_driver
+ ******************************************************************************/
+CO_RAMFUNC static void CO_CANtxWriteMailbox(CAN_TypeDef *CANx, uint32_t mailbox, const CO_CANtx_t *buffer)
+{
+	CANx->sTxMailBox[mailbox].TDTR = buffer->TDTR;
+	CANx->sTxMailBox[mailbox].TDLR = ((uint32_t)buffer->data[3] << 24) |
+			((uint32_t)buffer->data[2] << 16) |
+			((uint32_t)buffer->data[1] << 8) |
+			(uint32_t)buffer->data[0];
+	CANx->sTxMailBox[mailbox].TDHR = ((uint32_t)buffer->data[7] << 24) |
+			((uint32_t)buffer->data[6] << 16) |
+			((uint32_t)buffer->data[5] << 8) |
+			(uint32_t)buffer->data[4];
+	/* identifier register last, it requests transmission */
+	CANx->sTxMailBox[mailbox].TIR = buffer->TIR | CAN_TI0R_TXRQ;
+}
+#endif
+
+/*!*****************************************************************************
+ * \brief writes message into free transmit mailbox and requests transmission.
+ * \details With CO_CAN_TX_DIRECT mailbox registers are written directly with
+ * the images prepared by CO_CANtxBufferInit(), without HAL state checks.
+ * Otherwise HAL_CAN_AddTxMessage() with prepared HAL header is used. Caller
+ * must verify free mailbox with CO_CANtxMailboxFree().
+ * \param [in]	CANmodule pointer to CO_CANmodule_t object
+ * \param [in]	buffer transmit buffer
+ * \return false if message was not accepted
+ *
+ * \ingroup CO_driver
+ ******************************************************************************/
+CO_RAMFUNC static bool_t CO_CANtxWrite(CO_CANmodule_t *CANmodule, const CO_CANtx_t *buffer)
+{
+#if CO_CAN_TX_DIRECT > 0
+	CAN_TypeDef *CANx = CANmodule->CANbaseAddress->Instance;
+#if CO_CAN_TX_RESERVED > 0
+	/* CODE may point to reserved mailbox 2, so choose between 0 and 1 */
+	uint32_t mailbox = ((CANx->TSR & CAN_TSR_TME0) != 0U) ? 0U : 1U;
+#else
+	/* CODE field holds number of the next free mailbox */
+	uint32_t mailbox = (CANx->TSR & CAN_TSR_CODE) >> CAN_TSR_CODE_Pos;
+#endif
+
+	CO_CANtxWriteMailbox(CANx, mailbox, buffer);
+	CANmodule->txMailbox[mailbox] = buffer;
+#if CO_CAN_TX_LATENCY > 0
+	CO_CANtxLatencyArm(CANmodule, mailbox, buffer);
+#endif
+	return true;
+#else
+	uint32_t TxMailboxNum;
+
+	/* header was prepared by CO_CANtxBufferInit() */
+	if(HAL_CAN_AddTxMessage(CANmodule->CANbaseAddress,
+			(CAN_TxHeaderTypeDef*)&buffer->TxHeader,
+			(uint8_t*)&buffer->data[0],
+			&TxMailboxNum) != HAL_OK)
+	{
+		return false;
+	}
+	else
+	{
+		;//do nothing
+	}
+
+	/* HAL returns mailbox as CAN_TX_MAILBOX0..2 bit */
+	CANmodule->txMailbox[31U - __CLZ(TxMailboxNum)] = buffer;
+#if CO_CAN_TX_LATENCY > 0
+	CO_CANtxLatencyArm(CANmodule, 31U - __CLZ(TxMailboxNum), buffer);
+#endif
+	return true;
+#endif
+}
+
+/*!*****************************************************************************
+ * \brief removes buffer, which was copied into mailbox, from the queue.
+ * \param [in]	CANmodule pointer to CO_CANmodule_t object
+ * \param [in]	buffer transmit buffer
+ *
+ * \ingroup CO_driver
+ ******************************************************************************/
+CO_RAMFUNC static void CO_CANtxRelease(CO_CANmodule_t *CANmodule, CO_CANtx_t *buffer)
+{
+	if(buffer->syncFlag)
+	{
+		CANmodule->bufferInhibitFlag = true;
+	}
+	buffer->bufferFull = false;
+	CO_CANtxPendingClear(CANmodule, buffer->rank);
+	CANmodule->CANtxCount--;
+}
+
+#if CO_CAN_TX_CRITICAL > 0
+/*!*****************************************************************************
+ * \brief copies waiting critical message into reserved mailbox 2.
+ * \details Must be called inside CO_LOCK_CAN_SEND(). With CO_SYNC_HW_TIMER or
+ * CO_HB_HW_TIMER, CO_SYNC_timerIsr() and CO_NMT_HBtimerIsr() are more urgent
+ * than the lock, so mailbox 2 is checked and written with all interrupts
+ * disabled.
+ * \param [in]	CANmodule pointer to CO_CANmodule_t object
+ *
+ * \ingroup CO_driver
+ ******************************************************************************/
+CO_RAMFUNC static void CO_CANtxFillCritical(CO_CANmodule_t *CANmodule)
+{
+	CAN_TypeDef *CANx = CANmodule->CANbaseAddress->Instance;
+
+	if((CANmodule->CANtxCount > 0U) && ((CANx->TSR & CAN_TSR_TME2) != 0U))
+	{
+		CO_CANtx_t *buffer = CO_CANtxNext(CANmodule, true);
+
+		if(buffer != NULL)
+		{
+#if (CO_SYNC_HW_TIMER > 0) || (CO_HB_HW_TIMER > 0)
+			uint32_t primask = __get_PRIMASK();
+
+			__disable_irq();
+			if((CANx->TSR & CAN_TSR_TME2) != 0U)
+			{
+				CO_CANtxWriteMailbox(CANx, 2U, buffer);
+				CANmodule->txMailbox[2] = buffer;
+#if CO_CAN_TX_LATENCY > 0
+				CO_CANtxLatencyArm(CANmodule, 2U, buffer);
+#endif
+				CO_CANtxRelease(CANmodule, buffer);
+			}
+			else
+			{
+				;//do nothing
+			}
+			__set_PRIMASK(primask);
+#else
+			CO_CANtxWriteMailbox(CANx, 2U, buffer);
+			CANmodule->txMailbox[2] = buffer;
+#if CO_CAN_TX_LATENCY > 0
+			CO_CANtxLatencyArm(CANmodule, 2U, buffer);
+#endif
+			CO_CANtxRelease(CANmodule, buffer);
+#endif
+		}
+		else
+		{
+			;//do nothing
+		}
+	}
+	else
+	{
+		;//do nothing
+	}
+}
+#endif
+
+#if CO_CAN_BRIDGE > 0
+/*!*****************************************************************************
+ * \brief copies frames forwarded from other CANmodule into free mailboxes.
+ * \details Must be called inside CO_LOCK_CAN_SEND(). Mailbox has no
+ * CO_CANtx_t buffer, so txMailbox stays NULL.
+ * \param [in]	CANmodule pointer to CO_CANmodule_t object
+ *
+ * \ingroup CO_driver
+ ******************************************************************************/
+CO_RAMFUNC static void CO_CANbridgeFill(CO_CANmodule_t *CANmodule)
+{
+	CAN_TypeDef *CANx = CANmodule->CANbaseAddress->Instance;
+
+	while((CANmodule->bridgeHead != CANmodule->bridgeTail) && CO_CANtxMailboxFree(CANmodule))
+	{
+		const CO_CANbridgeFrame_t *frame =
+				&CANmodule->bridgeQueue[CANmodule->bridgeTail & (CO_CAN_BRIDGE_QUEUE - 1U)];
+#if CO_CAN_TX_RESERVED > 0
+		uint32_t mailbox = ((CANx->TSR & CAN_TSR_TME0) != 0U) ? 0U : 1U;
+#else
+		uint32_t mailbox = (CANx->TSR & CAN_TSR_CODE) >> CAN_TSR_CODE_Pos;
+#endif
+
+		CANx->sTxMailBox[mailbox].TDTR = frame->TDTR;
+		CANx->sTxMailBox[mailbox].TDLR = frame->TDLR;
+		CANx->sTxMailBox[mailbox].TDHR = frame->TDHR;
+		CANx->sTxMailBox[mailbox].TIR = frame->TIR | CAN_TI0R_TXRQ;
+		CANmodule->txMailbox[mailbox] = NULL;
+		CANmodule->bridgeTail++;
+	}
+}
+#endif
+
+/*!*****************************************************************************
+ * \brief copies waiting messages into all free transmit mailboxes.
+ * \details Must be called inside CO_LOCK_CAN_SEND(). bxCAN is configured
+ * with TransmitFifoPriority disabled, so mailboxes are transmitted by
+ * identifier priority as well. Frames forwarded by CO_CAN_BRIDGE go first.
+ * \param [in]	CANmodule pointer to CO_CANmodule_t object
+ * \return false if HAL refused the message
+ *
+ * \ingroup CO_driver
+ ******************************************************************************/
+CO_RAMFUNC static bool_t CO_CANtxFill(CO_CANmodule_t *CANmodule)
+{
+#if CO_CAN_TX_CRITICAL > 0
+	CO_CANtxFillCritical(CANmodule);
+#endif
+#if CO_CAN_BRIDGE > 0
+	CO_CANbridgeFill(CANmodule);
+#endif
+	while((CANmodule->CANtxCount > 0U) && CO_CANtxMailboxFree(CANmodule))
+	{
+		CO_CANtx_t *buffer = CO_CANtxNext(CANmodule, false);
+
+		if(buffer == NULL)
+		{
+			/* Clear counter if no more messages */
+			CANmodule->CANtxCount = 0U;
+			break;
+		}
+		else
+		{
+			;//do nothing
+		}
+
+		/* Copy message to CAN buffer */
+		if(!CO_CANtxWrite(CANmodule, buffer))
+		{
+			return false;
+		}
+		else
+		{
+			CO_CANtxRelease(CANmodule, buffer);
+		}
+	}
+	return true;
+}
+
+#if CO_CAN_RX_DISPATCH > 0
+/*!*****************************************************************************
+ * \brief finds the lowest rxArray member from index on, which accepts data
+ * frame with identifier id, with the same rules as CO_CANupdateDispatch().
+ * \param [in]	CANmodule pointer to CO_CANmodule_t object
+ * \param [in]	id 11-bit identifier
+ * \param [in]	index first rxArray member to check
+ * \return rxArray index or CO_CAN_FILTER_UNUSED
+ *
+ * \ingroup CO_driver
+ ******************************************************************************/
+static uint8_t CO_CANdispatchFind(const CO_CANmodule_t *CANmodule, uint16_t id, uint16_t index)
+{
+	for(; index < CANmodule->rxSize; index++)
+	{
+		const CO_CANrx_t *buffer = &CANmodule->rxArray[index];
+
+		if((buffer->pFunct != NULL) && ((buffer->ident & 0x02U) == 0U) &&
+		   ((((uint16_t)(id << 2) ^ buffer->ident) & buffer->mask) == 0U))
+		{
+			return (uint8_t)index;
+		}
+		else
+		{
+			;//do nothing
+		}
+	}
+	return CO_CAN_FILTER_UNUSED;
+}
+
+/*!*****************************************************************************
+ * \brief updates COB-ID dispatch table after rxArray member was configured.
+ * \details Only identifiers accepted by the old or the new configuration of
+ * the member are written, each entry with one byte write, so the table stays
+ * consistent for CAN receive interrupt without a critical section. The lowest
+ * matching index wins, the same as with software search. Members, which
+ * accept only RTR frames, are left to software search.
+ * \param [in]	CANmodule pointer to CO_CANmodule_t object
+ * \param [in]	index rxArray member, already configured
+ * \param [in]	oldIdent ident of the member before configuration
+ * \param [in]	oldMask mask of the member before configuration
+ * \param [in]	oldUsed true, if member was in the table before configuration
+ *
+ * \ingroup CO_driver
+ ******************************************************************************/
+static void CO_CANupdateDispatch(CO_CANmodule_t *CANmodule, uint16_t index,
+		uint16_t oldIdent, uint16_t oldMask, bool_t oldUsed)
+{
+	const CO_CANrx_t *buffer = &CANmodule->rxArray[index];
+	uint16_t id;
+	uint16_t last;
+
+	if(CANmodule->rxSize >= CO_CAN_FILTER_UNUSED)
+	{
+		/* index does not fit into table, software search is used */
+		return;
+	}
+	else
+	{
+		;//do nothing
+	}
+
+	/* identifiers of the old configuration go to the next matching member */
+	if(oldUsed)
+	{
+		/* exact identifier needs no search over the table */
+		id = (oldMask == CO_CAN_RX_MASK_EXACT) ? (uint16_t)(oldIdent >> 2) : 0U;
+		last = (oldMask == CO_CAN_RX_MASK_EXACT) ? id : 0x7FFU;
+		for(; id <= last; id++)
+		{
+			if(((((uint16_t)(id << 2) ^ oldIdent) & oldMask) == 0U) &&
+			        (CANmodule->rxDispatch[id] == index))
+			{
+				CANmodule->rxDispatch[id] = CO_CANdispatchFind(CANmodule, id, index);
+			}
+			else
+			{
+				;//do nothing
+			}
+		}
+	}
+
+	/* identifiers of the new configuration, unless taken by lower member */
+	if((buffer->pFunct != NULL) && ((buffer->ident & 0x02U) == 0U))
+	{
+		id = (buffer->mask == CO_CAN_RX_MASK_EXACT) ? (uint16_t)(buffer->ident >> 2) : 0U;
+		last = (buffer->mask == CO_CAN_RX_MASK_EXACT) ? id : 0x7FFU;
+		for(; id <= last; id++)
+		{
+			if(((((uint16_t)(id << 2) ^ buffer->ident) & buffer->mask) == 0U) &&
+			        (CANmodule->rxDispatch[id] > index))
+			{
+				CANmodule->rxDispatch[id] = (uint8_t)index;
+			}
+			else
+			{
+				;//do nothing
+			}
+		}
+	}
+}
+#endif
+
+/*!*****************************************************************************
+ * \brief passes received message to the other CANopen devices of the module.
+ * \details Searches slices after the one with buffer _index_, which already
+ * got the message, see CO_CANmodule_setRxSlice(). First matching buffer of
+ * each slice gets the message, same as with one device.
+ * \param [in]	CANmodule pointer to CO_CANmodule_t object
+ * \param [in]	index rxArray buffer, which processed the message
+ * \param [in]	ident received identifier in CO_CANrx_t ident layout
+ * \param [in]	CANmessage received message
+ *
+ * \ingroup CO_driver
+ ******************************************************************************/
+CO_RAMFUNC static void CO_CANrxSlices(CO_CANmodule_t *CANmodule, uint32_t index,
+		uint16_t ident, const CO_CANrxMsg_t *CANmessage)
+{
+	uint32_t slice = CANmodule->rxSlice;
+
+	for(index = (index / slice + 1U) * slice; index < CANmodule->rxSize; index++)
+	{
+		const CO_CANrx_t *MsgBuff = &CANmodule->rxArray[index];
+
+		if(((ident ^ MsgBuff->ident) & MsgBuff->mask) == 0U)
+		{
+			if(MsgBuff->pFunct != NULL)
+			{
+				MsgBuff->pFunct(MsgBuff->object, CANmessage);
+			}
+			else
+			{
+				;//do nothing
+			}
+			/* continue with the first buffer of the next slice */
+			index = (index / slice + 1U) * slice - 1U;
+		}
+		else
+		{
+			;//do nothing
+		}
+	}
+}
+
+
+/*!*****************************************************************************
+ * \brief receive function of buffers configured by CO_CANrxBufferInitRange().
+ * \details Passes the message with its offset in the range to the function of
+ * the range. Identifiers of the mask block outside of the range are ignored.
+ * \param [in]	object CO_CANrxRange_t
+ * \param [in]	message received message
+ *
+ * \ingroup CO_driver
+ ******************************************************************************/
+CO_RAMFUNC static void CO_CANrxRange(void *object, const CO_CANrxMsg_t *message)
+{
+	const CO_CANrxRange_t *range = (const CO_CANrxRange_t *)object;
+	uint16_t offset = (uint16_t)((CO_CANrxMsg_readIdent(message) & 0x07FFU) - range->ident);
+
+	if(offset < range->count)
+	{
+		range->pFunct(range->object, message, offset);
+	}
+	else
+	{
+		;//do nothing
+	}
+}
+
+
+/*!*****************************************************************************
+ * \brief finds receive buffer for received standard frame and calls its function.
+ * \details Dispatch table or filter match index points to the buffer, otherwise
+ * (or if filters were reconfigured meanwhile) rxArray is searched. Called from
+ * CO_CANinterrupt_Rx() or, with CO_CAN_RX_RING, from CO_CANrxRingProcess().
+ * \param [in]	CANmodule pointer to CO_CANmodule_t object
+ * \param [in]	fifo CAN_RX_FIFO0 or CAN_RX_FIFO1
+ * \param [in]	filterMatchIndex FMI of received frame
+ * \param [in]	msg received identifier in CO_CANrx_t ident layout
+ * \param [in]	CANmessage received message
+ * \return false, if dispatch table has no buffer for the identifier
+ *
+ * \ingroup CO_driver
+ ******************************************************************************/
+CO_RAMFUNC static bool_t CO_CANrxDispatch(CO_CANmodule_t *CANmodule, uint32_t fifo,
+		uint32_t filterMatchIndex, uint16_t msg, const CO_CANrxMsg_t *CANmessage)
+{
+	bool_t msgMatched = false;
+	CO_CANrx_t *MsgBuff = CANmodule->rxArray; /* receive message buffer from CO_CANmodule_t object. */
+	uint32_t index;
+
+#if CO_CAN_RX_DISPATCH > 0
+	if((msg & 0x02U) == 0U)
+	{
+		/* dispatch table points to the buffer. */
+		index = CANmodule->rxDispatch[CANmessage->ident & 0x7FFU];
+		if(index < CANmodule->rxSize)
+		{
+			MsgBuff = &CANmodule->rxArray[index];
+			/* verify, table may be rebuilt while message was in FIFO */
+			if (((msg ^ MsgBuff->ident) & MsgBuff->mask) == 0)
+			{
+				msgMatched = true;
+			}
+		}
+		else if(CANmodule->rxSize < CO_CAN_FILTER_UNUSED)
+		{
+			/* nobody registered for this identifier */
+			CO_CAN_STAT_ADD(CANmodule, rxUnmatched, 1U);
+			return false;
+		}
+	}
+	else
+#endif
+	if(CANmodule->useCANrxFilters)
+	{
+		/* CAN module filters are used, filter match index points to the buffer. */
+		index = filterMatchIndex;
+		if(fifo == CAN_RX_FIFO1)
+		{
+			index += CANmodule->filterFifo1Start;
+		}
+		if(index < CO_CAN_FILTER_NO_FMI)
+		{
+			index = CANmodule->filterToRx[index];
+			if(index < CANmodule->rxSize)
+			{
+				MsgBuff = &CANmodule->rxArray[index];
+				/* verify, filters may be reconfigured while message was in FIFO */
+				if (((msg ^ MsgBuff->ident) & MsgBuff->mask) == 0)
+				{
+					msgMatched = true;
+				}
+			}
+		}
+	}
+
+	if(!msgMatched)
+	{
+		/* Search rxArray form CANmodule for the same CAN-ID. */
+		MsgBuff = CANmodule->rxArray;
+		for (index = 0; index < CANmodule->rxSize; index++)
+		{
+			if (((msg ^ MsgBuff->ident) & MsgBuff->mask) == 0)
+			{
+				msgMatched = true;
+				break;
+			}
+			MsgBuff++;
+		}
+	}
+
+#if CO_CAN_RX_STORM > 0
+	if(msgMatched && !CO_CANrxStormPass(CANmodule, MsgBuff))
+	{
+		/* blocked, other devices of shared module don't get it either */
+		CO_CAN_STAT_ADD(CANmodule, rxStormDropped, 1U);
+		return true;
+	}
+	else
+	{
+		;//do nothing
+	}
+#endif
+
+	/* Call specific function, which will process the message */
+	if(msgMatched && (MsgBuff != NULL) && (MsgBuff->pFunct != NULL))
+	{
+		MsgBuff->pFunct(MsgBuff->object, CANmessage);
+	}
+	else
+	{
+		CO_CAN_STAT_ADD(CANmodule, rxUnmatched, 1U);
+	}
+	if(msgMatched && (CANmodule->rxSlice < CANmodule->rxSize))
+	{
+		/* module is shared by several CANopen devices */
+		CO_CANrxSlices(CANmodule, index, msg, CANmessage);
+	}
+	else
+	{
+		;//do nothing
+	}
+
+	return true;
+}
+
+
+#if CO_CAN_RX_STORM > 0
+/*!*****************************************************************************
+ * \brief takes one token from the bucket of receive buffer.
+ * \details Bucket is refilled with elapsed time first. If it is empty, buffer
+ * is blocked and CO_CANrxStormProcess() is requested, see CO_CAN_RX_STORM.
+ * Each buffer is served by one receive FIFO, so no lock is needed.
+ * \param [in]	CANmodule pointer to CO_CANmodule_t object
+ * \param [in]	buffer matched rxArray member
+ * \return false, if frame must be dropped
+ *
+ * \ingroup CO_driver
+ ******************************************************************************/
+CO_RAMFUNC static bool_t CO_CANrxStormPass(CO_CANmodule_t *CANmodule, CO_CANrx_t *buffer)
+{
+	uint32_t now;
+	uint32_t elapsed;
+	uint32_t tokens = buffer->stormTokens;
+
+	if(buffer->stormState != CO_CAN_STORM_PASS)
+	{
+		return false;
+	}
+	else
+	{
+		;//do nothing
+	}
+
+	now = HAL_GetTick();
+	elapsed = now - buffer->stormTick;
+	buffer->stormTick = now;
+	if(elapsed >= (CO_CAN_STORM_FULL - tokens) / CO_CAN_RX_STORM_RATE)
+	{
+		tokens = CO_CAN_STORM_FULL;
+	}
+	else
+	{
+		tokens += elapsed * CO_CAN_RX_STORM_RATE;
+	}
+
+	if(tokens < CO_CAN_STORM_FRAME)
+	{
+		buffer->stormTokens = tokens;
+		buffer->stormState = CO_CAN_STORM_BLOCKED;
+		CANmodule->rxStormPending = true;
+		return false;
+	}
+	else
+	{
+		buffer->stormTokens = tokens - CO_CAN_STORM_FRAME;
+		return true;
+	}
+}
+
+
+/*!*****************************************************************************
+ * \brief removes filters of blocked buffers and restores them after hold time.
+ * \details Called from CO_CANverifyErrors(). Filters are rebuilt only, when a
+ * buffer changes its state, see CO_CAN_RX_STORM.
+ * \param [in]	CANmodule pointer to CO_CANmodule_t object
+ *
+ * \ingroup CO_driver
+ ******************************************************************************/
+static void CO_CANrxStormProcess(CO_CANmodule_t *CANmodule)
+{
+	uint32_t now;
+	uint16_t i;
+	bool_t changed = false;
+
+	if(!CANmodule->rxStormPending && (CANmodule->rxStormBlocked == 0U))
+	{
+		return;
+	}
+	else
+	{
+		;//do nothing
+	}
+
+	CANmodule->rxStormPending = false;
+	now = HAL_GetTick();
+	for(i = 0U; i < CANmodule->rxSize; i++)
+	{
+		CO_CANrx_t *buffer = &CANmodule->rxArray[i];
+
+		if(buffer->stormState == CO_CAN_STORM_BLOCKED)
+		{
+			/* stormTick is the time of blocking */
+			buffer->stormState = CO_CAN_STORM_FILTERED;
+			CANmodule->rxStormBlocked++;
+			changed = true;
+			CO_errorReport((CO_EM_t*)CANmodule->em, CO_EM_CAN_RX_STORM, CO_EMC_COMMUNICATION,
+					(uint32_t)(buffer->ident >> 2));
+		}
+		else if((buffer->stormState == CO_CAN_STORM_FILTERED) &&
+				((now - buffer->stormTick) >= CO_CAN_RX_STORM_HOLD_MS))
+		{
+			buffer->stormTokens = CO_CAN_STORM_FULL;
+			buffer->stormTick = now;
+			CO_MEMORY_BARRIER();
+			buffer->stormState = CO_CAN_STORM_PASS;
+			CANmodule->rxStormBlocked--;
+			changed = true;
+		}
+		else
+		{
+			;//do nothing
+		}
+	}
+
+	if(changed)
+	{
+		(void)CO_CANconfigFilters(CANmodule);
+		if(CANmodule->rxStormBlocked == 0U)
+		{
+			CO_errorReset((CO_EM_t*)CANmodule->em, CO_EM_CAN_RX_STORM, 0U);
+		}
+		else
+		{
+			;//do nothing
+		}
+	}
+	else
+	{
+		;//do nothing
+	}
+}
+#endif
+
+
+#if CO_CAN_BRIDGE > 0
+/*!*****************************************************************************
+ * \brief puts received frame into bridge queue of the route target.
+ * \details Identifier is translated by route offset, DLC and data are
+ * copied. Target mailboxes are refilled at once.
+ * \param [in]	CANmodule pointer to CO_CANmodule_t object, which received the frame
+ * \param [in]	route matching route
+ * \param [in]	RIR, RDTR, RDLR, RDHR FIFO mailbox registers
+ *
+ * \ingroup CO_driver
+ ******************************************************************************/
+CO_RAMFUNC static void CO_CANbridgeForward(CO_CANmodule_t *CANmodule, const CO_CANbridgeRoute_t *route,
+		uint32_t RIR, uint32_t RDTR, uint32_t RDLR, uint32_t RDHR)
+{
+	CO_CANmodule_t *target = (CO_CANmodule_t*)route->target;
+	uint32_t ident = ((RIR >> CAN_RI0R_STID_Pos) + (uint32_t)(int32_t)route->offset) & 0x7FFU;
+
+	(void)CANmodule;
+	CO_LOCK_CAN_SEND();
+	if((uint16_t)(target->bridgeHead - target->bridgeTail) < CO_CAN_BRIDGE_QUEUE)
+	{
+		CO_CANbridgeFrame_t *frame = &target->bridgeQueue[target->bridgeHead & (CO_CAN_BRIDGE_QUEUE - 1U)];
+
+		/* RIR and TIR have the same layout of STID and RTR */
+		frame->TIR = (ident << CAN_TI0R_STID_Pos) | (RIR & CAN_RI0R_RTR);
+		frame->TDTR = RDTR & CAN_RDT0R_DLC;
+		frame->TDLR = RDLR;
+		frame->TDHR = RDHR;
+		target->bridgeHead++;
+		CO_CAN_STAT_ADD(CANmodule, rxForwarded, 1U);
+		(void)CO_CANtxFill(target);
+	}
+	else
+	{
+		/* target bus is slower or blocked, drop as with full FIFO */
+		CO_CAN_STAT_ADD(target, txForwardLost, 1U);
+	}
+	CO_UNLOCK_CAN_SEND();
+}
+
+
+/*!*****************************************************************************
+ * \brief forwards received standard frame, if it matches a bridge route.
+ * \details Route FMI points to the route directly, otherwise routes are
+ * searched, because frame matched a receive buffer filter of higher priority
+ * or filters are not used.
+ * \param [in]	CANmodule pointer to CO_CANmodule_t object
+ * \param [in]	fifo CAN_RX_FIFO0 or CAN_RX_FIFO1
+ * \param [in]	RIR, RDTR, RDLR, RDHR FIFO mailbox registers
+ * \return true, if frame was accepted by route filter only and needs no
+ * further processing
+ *
+ * \ingroup CO_driver
+ ******************************************************************************/
+CO_RAMFUNC static bool_t CO_CANbridgeRx(CO_CANmodule_t *CANmodule, uint32_t fifo,
+		uint32_t RIR, uint32_t RDTR, uint32_t RDLR, uint32_t RDHR)
+{
+	const CO_CANbridgeRoute_t *route = NULL;
+	uint16_t msg = (uint16_t)(((RIR >> CAN_RI0R_STID_Pos) << 2) | (RIR & CAN_RI0R_RTR));
+	bool_t routeOnly = false;
+	uint32_t index;
+
+	if(CANmodule->useCANrxFilters && (fifo == CAN_RX_FIFO1))
+	{
+		index = ((RDTR & CAN_RDT0R_FMI) >> CAN_RDT0R_FMI_Pos) + CANmodule->filterFifo1Start;
+		if((index >= CANmodule->filterBridgeStart) && (index < CO_CAN_FILTER_NO_FMI))
+		{
+			const CO_CANbridgeRoute_t *candidate = &CANmodule->bridgeRoute[CANmodule->filterToRx[index] % CO_CAN_BRIDGE];
+
+			/* verify, routes may be reconfigured while message was in FIFO */
+			if((candidate->target != NULL) && (((msg ^ candidate->ident) & candidate->mask) == 0U))
+			{
+				route = candidate;
+				routeOnly = true;
+			}
+			else
+			{
+				;//do nothing
+			}
+		}
+		else
+		{
+			;//do nothing
+		}
+	}
+	else
+	{
+		;//do nothing
+	}
+
+	for(index = 0U; (route == NULL) && (index < CO_CAN_BRIDGE); index++)
+	{
+		const CO_CANbridgeRoute_t *candidate = &CANmodule->bridgeRoute[index];
+
+		if((candidate->target != NULL) && (((msg ^ candidate->ident) & candidate->mask) == 0U))
+		{
+			route = candidate;
+		}
+		else
+		{
+			;//do nothing
+		}
+	}
+
+	if(route != NULL)
+	{
+		CO_CANbridgeForward(CANmodule, route, RIR, RDTR, RDLR, RDHR);
+	}
+	else
+	{
+		;//do nothing
+	}
+	return routeOnly;
+}
+#endif
+
+
+#if CO_CAN_EXT_ID > 0
+/*!*****************************************************************************
+ * \brief finds extended receive buffer for received frame and calls its function.
+ * \details Filter match index points to the buffer, if filters are used,
+ * otherwise (or if filters were reconfigured meanwhile) rxExt is searched.
+ * \param [in]	CANmodule pointer to CO_CANmodule_t object
+ * \param [in]	fifo CAN_RX_FIFO0 or CAN_RX_FIFO1
+ * \param [in]	filterMatchIndex FMI of received frame
+ * \param [in]	IR received identifier in RIR layout (EXID, IDE, RTR)
+ * \param [in]	CANmessage received message
+ *
+ * \ingroup CO_driver
+ ******************************************************************************/
+CO_RAMFUNC static void CO_CANinterrupt_RxExt(CO_CANmodule_t *CANmodule, uint32_t fifo,
+		uint32_t filterMatchIndex, uint32_t IR, const CO_CANrxMsg_t *CANmessage)
+{
+	const CO_CANrxExt_t *MsgBuff = NULL;
+	uint32_t index;
+
+	if(CANmodule->useCANrxFilters)
+	{
+		index = filterMatchIndex;
+		if(fifo == CAN_RX_FIFO1)
+		{
+			index += CANmodule->filterFifo1Start;
+		}
+		if(index < CO_CAN_FILTER_NO_FMI)
+		{
+			index = CANmodule->filterToRx[index];
+			if((index < CO_CAN_EXT_RX_SIZE) && (CANmodule->rxExt[index].pFunct != NULL) &&
+					(((IR ^ CANmodule->rxExt[index].ident) & CANmodule->rxExt[index].mask) == 0U))
+			{
+				MsgBuff = &CANmodule->rxExt[index];
+			}
+		}
+	}
+
+	for(index = 0U; (MsgBuff == NULL) && (index < CO_CAN_EXT_RX_SIZE); index++)
+	{
+		const CO_CANrxExt_t *buffer = &CANmodule->rxExt[index];
+
+		if((buffer->pFunct != NULL) && (((IR ^ buffer->ident) & buffer->mask) == 0U))
+		{
+			MsgBuff = buffer;
+		}
+	}
+
+	if(MsgBuff != NULL)
+	{
+		MsgBuff->pFunct(MsgBuff->object, CANmessage);
+	}
+	else
+	{
+		CO_CAN_STAT_ADD(CANmodule, rxUnmatched, 1U);
+	}
+}
+#endif
+
+/*-----------------------------------------------------------------------------
+ * GLOBAL FUNCTIONS - see descriptions in header file
+ *----------------------------------------------------------------------------*/
+
+/* \brief 	Cube MX callbacks for Fifo0 and Fifo1
+ * \details Callbacks are shared by all CAN peripherals, CANmodule is selected by hcan.
+ */
+CO_RAMFUNC void HAL_CAN_RxFifo0MsgPendingCallback(CAN_HandleTypeDef *hcan)
+{
+	CO_CANmodule_t *CANmodule = CO_CANmoduleGet(hcan);
+
+	if(CANmodule != NULL)
+	{
+		CO_CANinterrupt_Rx(CANmodule, CAN_RX_FIFO0);
+	}
+	else
+	{
+		;/*TODO add assert, according to Cube MX driver we should not be here
+		 *but for some reason interrupts get activated as soon as HAL_NVIC_EnableIRQ is called.
+		 *According to Cube CAN docs HAL_CAN_ActivateNotification should be executed to
+		 *activate callbacks.
+		 */
+	}
+}
+
+CO_RAMFUNC void HAL_CAN_RxFifo1MsgPendingCallback(CAN_HandleTypeDef *hcan)
+{
+	CO_CANmodule_t *CANmodule = CO_CANmoduleGet(hcan);
+
+	if(CANmodule != NULL)
+	{
+		CO_CANinterrupt_Rx(CANmodule, CAN_RX_FIFO1);
+	}
+	else
+	{
+		;//TODO add assert here
+	}
+}
+
+#if CO_CAN_BUSLOAD > 0
+#if CO_CAN_BUSLOAD_EXACT_STUFFING > 0
+/*!*****************************************************************************
+ * \brief sends bits of one frame field through bit stuffing and CRC-15.
+ * \param [in]	stuff state of the frame
+ * \param [in]	value field value, MSB first
+ * \param [in]	count number of bits in the field, 0..32
+ * \param [in]	crc true, if field is covered by CRC (all fields before CRC sequence)
+ *
+ * \ingroup CO_driver
+ ******************************************************************************/
+static void CO_CANstuffBits(CO_CANstuff_t *stuff, uint32_t value, uint8_t count, bool_t crc)
+{
+	while(count > 0U)
+	{
+		uint8_t bit;
+
+		count--;
+		bit = (uint8_t)((value >> count) & 1U);
+		if(crc)
+		{
+			uint16_t feedback = (uint16_t)(bit ^ ((stuff->crc >> 14) & 1U));
+
+			stuff->crc = (uint16_t)((stuff->crc << 1) & 0x7FFFU);
+			if(feedback != 0U)
+			{
+				stuff->crc ^= 0x4599U;
+			}
+		}
+		if(bit == stuff->last)
+		{
+			stuff->run++;
+			if(stuff->run == 5U)
+			{
+				/* complement bit is inserted and starts new run */
+				stuff->stuff++;
+				stuff->last ^= 1U;
+				stuff->run = 1U;
+			}
+		}
+		else
+		{
+			stuff->last = bit;
+			stuff->run = 1U;
+		}
+	}
+}
+#endif
+
+/*!*****************************************************************************
+ * \brief calculates length of data or remote frame on the bus.
+ * \details Parameters are images of bxCAN mailbox registers, TX and RX
+ * mailboxes have the same layout of IDE, RTR, identifier and DLC.
+ * \param [in]	IR identifier register (RIR or TIR)
+ * \param [in]	DTR length register (RDTR or TDTR)
+ * \param [in]	DLR data bytes 0..3
+ * \param [in]	DHR data bytes 4..7
+ * \return frame length in bits, including stuff bits and intermission
+ *
+ * \ingroup CO_driver
+ ******************************************************************************/
+static uint8_t CO_CANframeBits(uint32_t IR, uint32_t DTR, uint32_t DLR, uint32_t DHR)
+{
+	bool_t extended = ((IR & CAN_RI0R_IDE) != 0U) ? true : false;
+	bool_t remote = ((IR & CAN_RI0R_RTR) != 0U) ? true : false;
+	uint8_t DLC = (uint8_t)(DTR & CAN_RDT0R_DLC);
+	uint8_t dataBits;
+	uint8_t stuffedBits;
+
+	if(DLC > 8U)
+	{
+		DLC = 8U;
+	}
+	dataBits = remote ? 0U : (uint8_t)(DLC * 8U);
+	/* SOF, identifier, control field, data and CRC sequence */
+	stuffedBits = (uint8_t)((extended ? 54U : 34U) + dataBits);
+
+#if CO_CAN_BUSLOAD_EXACT_STUFFING > 0
+	{
+		CO_CANstuff_t stuff = {0U, 1U, 0U, 0U};
+		uint8_t i;
+
+		if(extended)
+		{
+			uint32_t ident = (IR >> CAN_RI0R_EXID_Pos) & 0x1FFFFFFFU;
+
+			/* SOF, base ID, SRR, IDE, extended ID, RTR, r1, r0, DLC */
+			CO_CANstuffBits(&stuff, 0U, 1U, true);
+			CO_CANstuffBits(&stuff, ident >> 18, 11U, true);
+			CO_CANstuffBits(&stuff, 3U, 2U, true);
+			CO_CANstuffBits(&stuff, ident, 18U, true);
+			CO_CANstuffBits(&stuff, remote ? 4U : 0U, 3U, true);
+		}
+		else
+		{
+			/* SOF, ID, RTR, IDE, r0 */
+			CO_CANstuffBits(&stuff, 0U, 1U, true);
+			CO_CANstuffBits(&stuff, IR >> CAN_RI0R_STID_Pos, 11U, true);
+			CO_CANstuffBits(&stuff, remote ? 4U : 0U, 3U, true);
+		}
+		CO_CANstuffBits(&stuff, DLC, 4U, true);
+		for(i = 0U; i < (dataBits / 8U); i++)
+		{
+			uint32_t byte = (i < 4U) ? (DLR >> (i * 8U)) : (DHR >> ((i - 4U) * 8U));
+
+			CO_CANstuffBits(&stuff, byte & 0xFFU, 8U, true);
+		}
+		CO_CANstuffBits(&stuff, stuff.crc, 15U, false);
+
+		return (uint8_t)(stuffedBits + stuff.stuff + CO_CAN_FRAME_TAIL_BITS);
+	}
+#else
+	(void)DLR;
+	(void)DHR;
+
+	/* worst case, each stuff bit is also start of the next run */
+	return (uint8_t)(stuffedBits + ((stuffedBits - 1U) / 4U) + CO_CAN_FRAME_TAIL_BITS);
+#endif
+}
+
+/*!*****************************************************************************
+ * \brief adds length of frame in completed transmit mailbox to bus load.
+ * \details Mailbox registers keep the frame after transmission.
+ * \param [in]	CANmodule pointer to CO_CANmodule_t object
+ * \param [in]	mailbox transmit mailbox 0..2
+ *
+ * \ingroup CO_driver
+ ******************************************************************************/
+CO_RAMFUNC static void CO_CANbusLoadTx(CO_CANmodule_t *CANmodule, uint32_t mailbox)
+{
+	const CAN_TxMailBox_TypeDef *TxMailBox = &CANmodule->CANbaseAddress->Instance->sTxMailBox[mailbox];
+
+	CANmodule->busLoadBits += CO_CANframeBits(TxMailBox->TIR, TxMailBox->TDTR,
+			TxMailBox->TDLR, TxMailBox->TDHR);
+}
+#endif
+
+#if CO_CAN_RECORDER > 0
+/*!*****************************************************************************
+ * \brief passes frame in completed transmit mailbox to the recorder.
+ * \details TDTR holds the timestamp of its SOF, TXRQ bit of TIR is clear
+ * after transmission and marks the record as transmitted.
+ * \param [in]	CANmodule pointer to CO_CANmodule_t object
+ * \param [in]	mailbox transmit mailbox 0..2
+ *
+ * \ingroup CO_driver
+ ******************************************************************************/
+CO_RAMFUNC static void CO_CANrecordTx(CO_CANmodule_t *CANmodule, uint32_t mailbox)
+{
+	const CAN_TxMailBox_TypeDef *TxMailBox = &CANmodule->CANbaseAddress->Instance->sTxMailBox[mailbox];
+
+	if(CANmodule->recorder != NULL)
+	{
+		CO_CANrecorder_put((CO_CANrecorder_t*)CANmodule->recorder, TxMailBox->TIR | CO_CAN_REC_TX,
+				TxMailBox->TDTR, TxMailBox->TDLR, TxMailBox->TDHR);
+	}
+	else
+	{
+		;//do nothing
+	}
+}
+#endif
+
+#if CO_CAN_TX_LATENCY > 0
+/*!*****************************************************************************
+ * \brief remembers queue time of buffer, which was copied into mailbox.
+ * \details Buffer may be queued again, before the mailbox is completed, so
+ * its time is kept per mailbox.
+ * \param [in]	CANmodule pointer to CO_CANmodule_t object
+ * \param [in]	mailbox transmit mailbox 0..2
+ * \param [in]	buffer transmit buffer from the queue
+ *
+ * \ingroup CO_driver
+ ******************************************************************************/
+CO_RAMFUNC static void CO_CANtxLatencyArm(CO_CANmodule_t *CANmodule, uint32_t mailbox, const CO_CANtx_t *buffer)
+{
+	CANmodule->txLatencyQueued[mailbox] = buffer->txQueued;
+	CANmodule->txLatencyArmed |= (uint8_t)(1U << mailbox);
+}
+
+/*!*****************************************************************************
+ * \brief adds latency of completed transmit mailbox to its buffer.
+ * \details Must be called before txMailbox is cleared. Mailboxes written by
+ * CO_CANsendReserved() or by bridge are not armed.
+ * \param [in]	CANmodule pointer to CO_CANmodule_t object
+ * \param [in]	mailbox transmit mailbox 0..2
+ *
+ * \ingroup CO_driver
+ ******************************************************************************/
+CO_RAMFUNC static void CO_CANtxLatencyDone(CO_CANmodule_t *CANmodule, uint32_t mailbox)
+{
+	const uint8_t bit = (uint8_t)(1U << mailbox);
+
+	if(((CANmodule->txLatencyArmed & bit) != 0U) && (CANmodule->txMailbox[mailbox] != NULL))
+	{
+		/* txMailbox points into txArray for armed mailboxes */
+		CO_CANtxLatency_t *latency = &((CO_CANtx_t*)CANmodule->txMailbox[mailbox])->latency;
+		uint32_t us = (DWT->CYCCNT - CANmodule->txLatencyQueued[mailbox]) / CANmodule->txLatencyCyclesPerUs;
+		uint32_t units = us / CO_CAN_TX_LATENCY_BIN_US;
+		uint32_t bin = (units == 0U) ? 0U : (32U - __CLZ(units));
+
+		if(bin >= CO_CAN_TX_LATENCY_BINS)
+		{
+			bin = CO_CAN_TX_LATENCY_BINS - 1U;
+		}
+		else
+		{
+			;//do nothing
+		}
+		latency->hist[bin]++;
+		if((latency->count == 0U) || (us < latency->min_us))
+		{
+			latency->min_us = us;
+		}
+		else
+		{
+			;//do nothing
+		}
+		if(us > latency->max_us)
+		{
+			latency->max_us = us;
+		}
+		else
+		{
+			;//do nothing
+		}
+		latency->count++;
+	}
+	else
+	{
+		;//do nothing
+	}
+	CANmodule->txLatencyArmed &= (uint8_t)~bit;
+}
+
+/*!*****************************************************************************
+ * \brief clears transmit latency of one buffer.
+ * \param [out]	latency pointer to CO_CANtxLatency_t object
+ *
+ * \ingroup CO_driver
+ ******************************************************************************/
+static void CO_CANtxLatencyClear(CO_CANtxLatency_t *latency)
+{
+	uint32_t b;
+
+	latency->count = 0U;
+	latency->min_us = 0U;
+	latency->max_us = 0U;
+	for(b = 0U; b < CO_CAN_TX_LATENCY_BINS; b++)
+	{
+		latency->hist[b] = 0U;
+	}
+}
+#endif
+
+/* \brief 	Cube MX callbacks for transmit mailboxes 0, 1 and 2
+ * \details Mailbox is free, so refill mailboxes from CO_CANtx_t buffers.
+ * Here and in the error and abort callbacks below, callbacks of CAN peripheral
+ * without CO_CANmodule_t are ignored.
+ */
+CO_RAMFUNC void HAL_CAN_TxMailbox0CompleteCallback(CAN_HandleTypeDef *hcan)
+{
+	CO_CANmodule_t *CANmodule = CO_CANmoduleGet(hcan);
+
+	if(CANmodule != NULL)
+	{
+#if CO_CAN_TX_LATENCY > 0
+		CO_CANtxLatencyDone(CANmodule, 0U);
+#endif
+		CANmodule->txMailbox[0] = NULL;
+		CO_CAN_STAT_ADD(CANmodule, txSent, 1U);
+#if CO_CAN_BUSLOAD > 0
+		CO_CANbusLoadTx(CANmodule, 0U);
+#endif
+#if CO_CAN_RECORDER > 0
+		CO_CANrecordTx(CANmodule, 0U);
+#endif
+		CO_CANinterrupt_Tx(CANmodule);
+	}
+}
+
+CO_RAMFUNC void HAL_CAN_TxMailbox1CompleteCallback(CAN_HandleTypeDef *hcan)
+{
+	CO_CANmodule_t *CANmodule = CO_CANmoduleGet(hcan);
+
+	if(CANmodule != NULL)
+	{
+#if CO_CAN_TX_LATENCY > 0
+		CO_CANtxLatencyDone(CANmodule, 1U);
+#endif
+		CANmodule->txMailbox[1] = NULL;
+		CO_CAN_STAT_ADD(CANmodule, txSent, 1U);
+#if CO_CAN_BUSLOAD > 0
+		CO_CANbusLoadTx(CANmodule, 1U);
+#endif
+#if CO_CAN_RECORDER > 0
+		CO_CANrecordTx(CANmodule, 1U);
+#endif
+		CO_CANinterrupt_Tx(CANmodule);
+	}
+}
+
+CO_RAMFUNC void HAL_CAN_TxMailbox2CompleteCallback(CAN_HandleTypeDef *hcan)
+{
+	CO_CANmodule_t *CANmodule = CO_CANmoduleGet(hcan);
+
+	if(CANmodule != NULL)
+	{
+#if CO_CAN_TX_LATENCY > 0
+		CO_CANtxLatencyDone(CANmodule, 2U);
+#endif
+		CANmodule->txMailbox[2] = NULL;
+		CO_CAN_STAT_ADD(CANmodule, txSent, 1U);
+#if CO_CAN_BUSLOAD > 0
+		CO_CANbusLoadTx(CANmodule, 2U);
+#endif
+#if CO_CAN_RECORDER > 0
+		CO_CANrecordTx(CANmodule, 2U);
+#endif
+		CO_CANinterrupt_Tx(CANmodule);
+	}
+}
+
+/* \brief 	Transmit mailbox is free without successful transmission
+ * \details Mailbox was aborted by CO_CANclearPendingSyncPDOs() or, without
+ * automatic retransmission, lost arbitration or had an error. Refill
+ * mailboxes from CO_CANtx_t buffers.
+ */
+CO_RAMFUNC static void CO_CANtxAborted(CO_CANmodule_t *CANmodule, uint32_t mailbox)
+{
+	CANmodule->txMailbox[mailbox] = NULL;
+#if CO_CAN_TX_LATENCY > 0
+	CANmodule->txLatencyArmed &= (uint8_t)~(1U << mailbox);
+#endif
+	CO_CAN_STAT_ADD(CANmodule, txAborted, 1U);
+	CO_CANinterrupt_Tx(CANmodule);
+}
+
+/* \brief 	Cube MX callback for CAN errors, see CO_CAN_ERROR_IRQ
+ * \details HAL_CAN_IRQHandler() has already cleared LEC and FIFO overrun
+ * flags and collected them in ErrorCode. With CO_CAN_ERROR_IRQ ErrorCode is
+ * cleared here, otherwise only the mailbox bits are cleared and the rest is
+ * left for CO_CANverifyErrors(). Mailbox,
+ * which completed with arbitration lost or transmit error, is reported only
+ * here (not by HAL_CAN_TxMailboxxAbortCallback()), so this callback is
+ * needed also without CO_CAN_ERROR_IRQ.
+ */
+void HAL_CAN_ErrorCallback(CAN_HandleTypeDef *hcan)
+{
+	CO_CANmodule_t *CANmodule = CO_CANmoduleGet(hcan);
+
+	if(CANmodule != NULL)
+	{
+		uint32_t ErrorCode = hcan->ErrorCode;
+
+		if((ErrorCode & (HAL_CAN_ERROR_TX_ALST0 | HAL_CAN_ERROR_TX_TERR0)) != 0U)
+		{
+			CO_CANtxAborted(CANmodule, 0U);
+		}
+		if((ErrorCode & (HAL_CAN_ERROR_TX_ALST1 | HAL_CAN_ERROR_TX_TERR1)) != 0U)
+		{
+			CO_CANtxAborted(CANmodule, 1U);
+		}
+		if((ErrorCode & (HAL_CAN_ERROR_TX_ALST2 | HAL_CAN_ERROR_TX_TERR2)) != 0U)
+		{
+			CO_CANtxAborted(CANmodule, 2U);
+		}
+#if CO_CAN_ERROR_IRQ > 0
+		CANmodule->errIrqCount++;
+		CO_CANerrorUpdate(CANmodule, hcan->Instance->ESR);
+		if((ErrorCode & (HAL_CAN_ERROR_RX_FOV0 | HAL_CAN_ERROR_RX_FOV1)) != 0U)
+		{
+			CO_CAN_STAT_ADD(CANmodule, rxOverruns, 1U);
+			CO_errorReport((CO_EM_t*)CANmodule->em, CO_EM_CAN_RXB_OVERFLOW, CO_EMC_CAN_OVERRUN, ErrorCode);
+		}
+		else
+		{
+			;//do nothing
+		}
+		(void)HAL_CAN_ResetError(hcan);
+#else
+		/* other bits, e.g. FIFO overrun, are polled by CO_CANverifyErrors() */
+		hcan->ErrorCode &= ~(HAL_CAN_ERROR_TX_ALST0 | HAL_CAN_ERROR_TX_TERR0 |
+		                     HAL_CAN_ERROR_TX_ALST1 | HAL_CAN_ERROR_TX_TERR1 |
+		                     HAL_CAN_ERROR_TX_ALST2 | HAL_CAN_ERROR_TX_TERR2);
+#endif
+	}
+}
+
+/* \brief 	Cube MX callbacks for aborted transmit mailboxes 0, 1 and 2
+ * \details Synchronous TPDO was aborted by CO_CANclearPendingSyncPDOs().
+ */
+CO_RAMFUNC void HAL_CAN_TxMailbox0AbortCallback(CAN_HandleTypeDef *hcan)
+{
+	CO_CANmodule_t *CANmodule = CO_CANmoduleGet(hcan);
+
+	if(CANmodule != NULL)
+	{
+		CO_CANtxAborted(CANmodule, 0U);
+	}
+}
+
+CO_RAMFUNC void HAL_CAN_TxMailbox1AbortCallback(CAN_HandleTypeDef *hcan)
+{
+	CO_CANmodule_t *CANmodule = CO_CANmoduleGet(hcan);
+
+	if(CANmodule != NULL)
+	{
+		CO_CANtxAborted(CANmodule, 1U);
+	}
+}
+
+CO_RAMFUNC void HAL_CAN_TxMailbox2AbortCallback(CAN_HandleTypeDef *hcan)
+{
+	CO_CANmodule_t *CANmodule = CO_CANmoduleGet(hcan);
+
+	if(CANmodule != NULL)
+	{
+		CO_CANtxAborted(CANmodule, 2U);
+	}
+}
+
+void CO_CANsetConfigurationMode(int32_t CANbaseAddress){
+	/* Put CAN module in configuration mode */
+	/* HAL is responsible for that */
+}
+
+/******************************************************************************/
+CO_ReturnError_t CO_CANsetNormalMode(CO_CANmodule_t *CANmodule){
+	/* Put CAN module in normal mode */
+
+	CO_ReturnError_t Error = CO_ERROR_NO;
+
+	/* all buffers are registered, program filter banks once */
+	if(CANmodule->rxFiltersDeferred)
+	{
+		CANmodule->rxFiltersDeferred = false;
+		Error = CO_CANconfigFilters(CANmodule);
+	}
+	else
+	{
+		;//do nothing
+	}
+
+#if CO_CAN_WARM_RESET > 0
+	if(HAL_CAN_GetState(CANmodule->CANbaseAddress) == HAL_CAN_STATE_LISTENING)
+	{
+		/* kept running by warm reset */
+	}
+	else
+#endif
+	if(HAL_CAN_Start(CANmodule->CANbaseAddress) != HAL_OK)
+	{
+		/* Start Error */
+		Error = CO_ERROR_HAL;
+	}
+
+	/* Enable CAN interrupts */
+
+	//    HAL_NVIC_SetPriority(CAN1_TX_IRQn, 1, 0);
+	//    HAL_NVIC_EnableIRQ(CAN1_TX_IRQn);
+	//    HAL_NVIC_SetPriority(CAN1_RX0_IRQn, 1, 0);
+	//    HAL_NVIC_EnableIRQ(CAN1_RX0_IRQn);
+	//    HAL_NVIC_SetPriority(CAN1_RX1_IRQn, 1, 0);
+	//    HAL_NVIC_EnableIRQ(CAN1_RX1_IRQn);
+
+	if(HAL_CAN_ActivateNotification( CANmodule->CANbaseAddress,
+			CAN_IT_RX_FIFO0_MSG_PENDING |
+			CAN_IT_RX_FIFO1_MSG_PENDING |
+#if CO_CAN_ERROR_IRQ > 0
+			CO_CAN_IT_ERRORS |
+#endif
+			CAN_IT_TX_MAILBOX_EMPTY)
+			!= HAL_OK)
+	{
+		/* Notification Error */
+		Error = CO_ERROR_HAL;
+	}
+
+	CANmodule->CANnormal = true;
+	return Error;
+}
+
+/*!*****************************************************************************
+ * \brief writes bit timing for bit rate in kbps into HAL Init structure.
+ * \details Timing is calculated from the current APB1 clock, so CAN keeps
+ * working, if SYSCLK is reduced before communication reset.
+ * \param [in]	CANmodule pointer to CO_CANmodule_t object, HAL handle is configured
+ * \param [in]	CANbitRate bit rate in kbps
+ * \return CO_ERROR_NO or CO_ERROR_ILLEGAL_BAUDRATE
+ *
+ * \ingroup CO_driver
+ ******************************************************************************/
+static CO_ReturnError_t CO_CANsetBitTiming(CO_CANmodule_t *CANmodule, uint16_t CANbitRate)
+{
+	CAN_InitTypeDef *Init = &CANmodule->CANbaseAddress->Init;
+	CO_CANbitTiming_t timing;
+
+	if(CO_CANbitTiming(HAL_RCC_GetPCLK1Freq(), CANbitRate, CO_CAN_SAMPLE_POINT, &timing) != CO_ERROR_NO)
+	{
+		return CO_ERROR_ILLEGAL_BAUDRATE;
+	}
+	else
+	{
+		;//do nothing
+	}
+
+	Init->Prescaler = timing.prescaler;
+	Init->TimeSeg1 = (uint32_t)(timing.timeSeg1 - 1U) << CAN_BTR_TS1_Pos;
+	Init->TimeSeg2 = (uint32_t)(timing.timeSeg2 - 1U) << CAN_BTR_TS2_Pos;
+	Init->SyncJumpWidth = (uint32_t)(timing.sjw - 1U) << CAN_BTR_SJW_Pos;
+
+	return CO_ERROR_NO;
+}
+
+
+#if CO_CAN_WARM_RESET > 0
+/*!*****************************************************************************
+ * \brief verifies, if peripheral may be kept running by CO_CANmodule_init().
+ * \details Peripheral must be started in normal mode with the bit timing of
+ * _CANbitRate_ already in BTR register. Bit timing is written into HAL Init
+ * structure, as by the full initialization.
+ * \param [in]	CANmodule pointer to CO_CANmodule_t object, HAL handle is configured
+ * \param [in]	CANbitRate bit rate in kbps, 0 for automatic detection
+ * \return true, if warm reset is possible
+ *
+ * \ingroup CO_driver
+ ******************************************************************************/
+static bool_t CO_CANisRunning(CO_CANmodule_t *CANmodule, uint16_t CANbitRate)
+{
+	CAN_HandleTypeDef *hcan = CANmodule->CANbaseAddress;
+	const CAN_InitTypeDef *Init = &hcan->Init;
+	const uint32_t mask = CAN_BTR_SILM | CAN_BTR_LBKM | CAN_BTR_SJW | CAN_BTR_TS2 | CAN_BTR_TS1 | CAN_BTR_BRP;
+
+	if((CANbitRate == 0U) || (hcan->Instance == NULL) || (HAL_CAN_GetState(hcan) != HAL_CAN_STATE_LISTENING)
+			|| (CO_CANsetBitTiming(CANmodule, CANbitRate) != CO_ERROR_NO))
+	{
+		return false;
+	}
+	else
+	{
+		;//do nothing
+	}
+
+	return ((hcan->Instance->BTR & mask) == (CAN_MODE_NORMAL | Init->SyncJumpWidth
+			| Init->TimeSeg1 | Init->TimeSeg2 | (Init->Prescaler - 1U))) ? true : false;
+}
+#endif
+
+
+#if CO_CAN_AUTO_BITRATE > 0
+/*!*****************************************************************************
+ * \brief listens on the bus in silent mode with configured bit timing.
+ * \details Single accept-all filter directs all frames to FIFO0, which is
+ * polled. Any receive error (REC increment or last error code) rejects the
+ * bit rate. Frame in FIFO was received with correct CRC, stuffing and form.
+ * \param [in]	CANmodule pointer to CO_CANmodule_t object, HAL handle is configured
+ * \return true, if CO_CAN_AUTO_BITRATE_FRAMES error-free frames were received
+ *
+ * \ingroup CO_driver
+ ******************************************************************************/
+static bool_t CO_CANlistenBitRate(CO_CANmodule_t *CANmodule)
+{
+	CAN_HandleTypeDef *hcan = CANmodule->CANbaseAddress;
+	CAN_FilterTypeDef FilterConfig;
+	CAN_RxHeaderTypeDef RxHeader;
+	uint8_t data[8];
+	uint32_t start;
+	uint32_t esr;
+	uint16_t frames = 0U;
+	bool_t locked = false;
+
+	hcan->Init.Mode = CAN_MODE_SILENT;
+	if(HAL_CAN_Init(hcan) != HAL_OK)
+	{
+		return false;
+	}
+
+	FilterConfig.FilterBank = CANmodule->filterBankFirst;
+	FilterConfig.FilterMode = CAN_FILTERMODE_IDMASK;
+	FilterConfig.FilterScale = CAN_FILTERSCALE_32BIT;
+	FilterConfig.FilterIdLow = 0U;
+	FilterConfig.FilterIdHigh = 0U;
+	FilterConfig.FilterMaskIdLow = 0U;
+	FilterConfig.FilterMaskIdHigh = 0U;
+	FilterConfig.FilterFIFOAssignment = CAN_RX_FIFO0;
+	FilterConfig.FilterActivation = ENABLE;
+	FilterConfig.SlaveStartFilterBank = CO_CAN_FILTER_BANKS;
+	if((HAL_CAN_ConfigFilter(hcan, &FilterConfig) != HAL_OK) || (HAL_CAN_Start(hcan) != HAL_OK))
+	{
+		return false;
+	}
+
+	/* LEC is set to "set by software", hardware overwrites it after each frame */
+	hcan->Instance->ESR = CAN_ESR_LEC;
+	start = HAL_GetTick();
+	while((HAL_GetTick() - start) < CO_CAN_AUTO_BITRATE_LISTEN_MS)
+	{
+		esr = hcan->Instance->ESR;
+		if(((esr & CAN_ESR_REC) != 0U) ||
+				(((esr & CAN_ESR_LEC) != 0U) && ((esr & CAN_ESR_LEC) != CAN_ESR_LEC)))
+		{
+			/* wrong bit rate, don't wait for timeout */
+			break;
+		}
+		else if(HAL_CAN_GetRxFifoFillLevel(hcan, CAN_RX_FIFO0) > 0U)
+		{
+			(void)HAL_CAN_GetRxMessage(hcan, CAN_RX_FIFO0, &RxHeader, data);
+			frames++;
+			if(frames >= CO_CAN_AUTO_BITRATE_FRAMES)
+			{
+				locked = true;
+				break;
+			}
+		}
+		else
+		{
+			;//do nothing
+		}
+	}
+
+	(void)HAL_CAN_Stop(hcan);
+	FilterConfig.FilterActivation = DISABLE;
+	(void)HAL_CAN_ConfigFilter(hcan, &FilterConfig);
+
+	return locked;
+}
+
+
+/*!*****************************************************************************
+ * \brief cycles CO_CAN_AUTO_BITRATE_LIST until bit rate is locked.
+ * \param [in]	CANmodule pointer to CO_CANmodule_t object, HAL handle is configured
+ * \return CO_ERROR_NO and CANmodule->CANbitRate set or CO_ERROR_TIMEOUT
+ *
+ * \ingroup CO_driver
+ ******************************************************************************/
+static CO_ReturnError_t CO_CANdetectBitRate(CO_CANmodule_t *CANmodule)
+{
+	static const uint16_t bitRates[] = {CO_CAN_AUTO_BITRATE_LIST};
+	uint32_t start = HAL_GetTick();
+	uint8_t i;
+
+	for(;;)
+	{
+		for(i = 0U; i < (sizeof(bitRates) / sizeof(bitRates[0])); i++)
+		{
+			if((CO_CANsetBitTiming(CANmodule, bitRates[i]) == CO_ERROR_NO) &&
+					CO_CANlistenBitRate(CANmodule))
+			{
+				CANmodule->CANbitRate = bitRates[i];
+				return CO_ERROR_NO;
+			}
+			else
+			{
+				;//do nothing
+			}
+		}
+
+		if((CO_CAN_AUTO_BITRATE_TIMEOUT_MS != 0U) &&
+				((HAL_GetTick() - start) >= CO_CAN_AUTO_BITRATE_TIMEOUT_MS))
+		{
+			return CO_ERROR_TIMEOUT;
+		}
+		else
+		{
+			;//do nothing
+		}
+	}
+}
+#endif
+
+
+#if CO_CAN_ERROR_IRQ > 0
+/*!*****************************************************************************
+ * \brief reports changes of CAN error state from ESR to CO_EM.
+ * \details Called from HAL_CAN_ErrorCallback() or inside CO_LOCK_CAN_SEND()
+ * from CO_CANverifyErrors().
+ * \param [in]	CANmodule pointer to CO_CANmodule_t object
+ * \param [in]	ESR value of bxCAN error status register
+ *
+ * \ingroup CO_driver
+ ******************************************************************************/
+static void CO_CANerrorUpdate(CO_CANmodule_t *CANmodule, uint32_t ESR)
+{
+	CO_EM_t *em = (CO_EM_t*)CANmodule->em;
+	uint32_t TEC = (ESR & CAN_ESR_TEC) >> CAN_ESR_TEC_Pos;
+	uint32_t REC = (ESR & CAN_ESR_REC) >> CAN_ESR_REC_Pos;
+	uint8_t flags = 0U;
+	uint8_t changed;
+
+	if((ESR & CAN_ESR_EWGF) != 0U)
+	{
+		flags |= CO_CAN_ERR_WARNING;
+	}
+	else
+	{
+		;//do nothing
+	}
+	/* single node without acknowledge gets TX passive before first frame is sent */
+	if((TEC > 127U) && !CANmodule->firstCANtxMessage)
+	{
+		flags |= CO_CAN_ERR_TX_PASSIVE;
+	}
+	else
+	{
+		;//do nothing
+	}
+	if(REC > 127U)
+	{
+		flags |= CO_CAN_ERR_RX_PASSIVE;
+	}
+	else
+	{
+		;//do nothing
+	}
+	if((ESR & CAN_ESR_BOFF) != 0U)
+	{
+		flags |= CO_CAN_ERR_BUS_OFF;
+	}
+	else
+	{
+		;//do nothing
+	}
+
+	CANmodule->errESR = ESR;
+	changed = flags ^ CANmodule->errFlags;
+	CANmodule->errFlags = flags;
+
+	if((changed & CO_CAN_ERR_WARNING) != 0U)
+	{
+		if((flags & CO_CAN_ERR_WARNING) != 0U)
+		{
+			CO_errorReport(em, CO_EM_CAN_BUS_WARNING, CO_EMC_NO_ERROR, ESR);
+		}
+		else
+		{
+			CO_errorReset(em, CO_EM_CAN_BUS_WARNING, ESR);
+		}
+	}
+	else
+	{
+		;//do nothing
+	}
+	if((changed & CO_CAN_ERR_TX_PASSIVE) != 0U)
+	{
+		if((flags & CO_CAN_ERR_TX_PASSIVE) != 0U)
+		{
+			CO_errorReport(em, CO_EM_CAN_TX_BUS_PASSIVE, CO_EMC_CAN_PASSIVE, ESR);
+		}
+		else
+		{
+			CO_errorReset(em, CO_EM_CAN_TX_BUS_PASSIVE, ESR);
+			CO_errorReset(em, CO_EM_CAN_TX_OVERFLOW, ESR);
+		}
+	}
+	else
+	{
+		;//do nothing
+	}
+	if((changed & CO_CAN_ERR_RX_PASSIVE) != 0U)
+	{
+		if((flags & CO_CAN_ERR_RX_PASSIVE) != 0U)
+		{
+			CO_errorReport(em, CO_EM_CAN_RX_BUS_PASSIVE, CO_EMC_CAN_PASSIVE, ESR);
+		}
+		else
+		{
+			CO_errorReset(em, CO_EM_CAN_RX_BUS_PASSIVE, ESR);
+		}
+	}
+	else
+	{
+		;//do nothing
+	}
+	if((changed & CO_CAN_ERR_BUS_OFF) != 0U)
+	{
+		if((flags & CO_CAN_ERR_BUS_OFF) != 0U)
+		{
+			CO_CAN_STAT_ADD(CANmodule, busOff, 1U);
+#if CO_CAN_BUSOFF_RECOVERY == 0
+			CO_errorReport(em, CO_EM_CAN_TX_BUS_OFF, CO_EMC_BUS_OFF_RECOVERED, ESR);
+#endif
+		}
+		else
+		{
+#if CO_CAN_BUSOFF_RECOVERY == 0
+			CO_errorReset(em, CO_EM_CAN_TX_BUS_OFF, ESR);
+#endif
+		}
+	}
+	else
+	{
+		;//do nothing
+	}
+}
+#endif
+
+
+#if (CO_CAN_BUSOFF_RECOVERY > 0) || (CO_CAN_TX_LOOPBACK > 0)
+/*!*****************************************************************************
+ * \brief true, if buffer holds (T)PDO, 11-bit identifier 0x180 to 0x57F.
+ * \details 29-bit identifiers have CO_CAN_TX_EXT set and are out of range.
+ *
+ * \ingroup CO_driver
+ ******************************************************************************/
+static bool_t CO_CANtxIsPDO(const CO_CANtx_t *buffer)
+{
+	uint32_t ident = buffer->ident >> 2;
+
+	return ((ident >= 0x180U) && (ident < 0x580U)) ? true : false;
+}
+#endif
+
+
+#if CO_CAN_TX_LOOPBACK > 0
+/*!*****************************************************************************
+ * \brief passes PDO to the receive buffer of the same module, see CO_CAN_TX_LOOPBACK.
+ * \details Called from CO_CANsend() inside CO_LOCK_CAN_SEND(), so receive
+ * function is not interrupted by CAN receive interrupt. Remote frames and
+ * other objects are not passed.
+ * \param [in]	CANmodule pointer to CO_CANmodule_t object
+ * \param [in]	buffer transmit buffer
+ * \return true, if frame is not transmitted, see CO_CANtxSetLocalOnly()
+ *
+ * \ingroup CO_driver
+ ******************************************************************************/
+CO_RAMFUNC static bool_t CO_CANtxLoopback(CO_CANmodule_t *CANmodule, const CO_CANtx_t *buffer)
+{
+	CO_CANrxMsg_t CANmessage;
+	uint16_t msg = (uint16_t)buffer->ident;
+	uint16_t offset;
+	uint16_t i;
+	bool_t local = false;
+
+	if(!CO_CANtxIsPDO(buffer) || ((msg & 0x02U) != 0U))
+	{
+		return false;
+	}
+	else
+	{
+		;//do nothing
+	}
+
+#if CO_CAN_RX_DISPATCH > 0
+	if(CANmodule->rxSize < CO_CAN_FILTER_UNUSED)
+	{
+		local = (CANmodule->rxDispatch[msg >> 2] < CANmodule->rxSize) ? true : false;
+	}
+	else
+#endif
+	{
+		for(i = 0U; i < CANmodule->rxSize; i++)
+		{
+			const CO_CANrx_t *MsgBuff = &CANmodule->rxArray[i];
+
+			if((MsgBuff->pFunct != NULL) && (((msg ^ MsgBuff->ident) & MsgBuff->mask) == 0U))
+			{
+				local = true;
+				break;
+			}
+			else
+			{
+				;//do nothing
+			}
+		}
+	}
+
+	if(local)
+	{
+		/* same frame as from CO_CANinterrupt_Rx() */
+		CANmessage.ident = (uint32_t)(msg >> 2);
+		CANmessage.DLC = buffer->DLC;
+		for(i = 0U; i < CO_CAN_DATA_SIZE; i++)
+		{
+			CANmessage.data[i] = buffer->data[i];
+		}
+#if CO_CAN_RX_DIRECT == 0
+		CANmessage.RxHeader.StdId = CANmessage.ident;
+		CANmessage.RxHeader.ExtId = 0U;
+		CANmessage.RxHeader.IDE = CAN_ID_STD;
+		CANmessage.RxHeader.RTR = CAN_RTR_DATA;
+		CANmessage.RxHeader.DLC = buffer->DLC;
+		CANmessage.RxHeader.Timestamp = 0U;
+		CANmessage.RxHeader.FilterMatchIndex = CO_CAN_FILTER_NO_FMI;
+#endif
+#if CO_CAN_TIMESTAMP > 0
+		CANmessage.timestamp = 0U;
+#endif
+		/* no filter match index, dispatch table or rxArray finds the buffer */
+		(void)CO_CANrxDispatch(CANmodule, CAN_RX_FIFO0, CO_CAN_FILTER_NO_FMI, msg, &CANmessage);
+		CO_CAN_STAT_ADD(CANmodule, txLoopback, 1U);
+#if CO_CAN_RX_CALLBACK > 0
+		if(CANmodule->pFunctRx != NULL)
+		{
+			CANmodule->pFunctRx(CANmodule->functRxObject, (uint16_t)CANmessage.ident);
+		}
+#endif
+	}
+	else
+	{
+		;//do nothing
+	}
+
+	offset = (uint16_t)((msg >> 2) - CO_CAN_LOOPBACK_FIRST);
+
+	return ((CANmodule->txLocalOnly[offset >> 5] & (1UL << (offset & 31U))) != 0U) ? true : false;
+}
+#endif
+
+
+#if CO_CAN_BUSOFF_RECOVERY > 0
+
+
+/*!*****************************************************************************
+ * \brief discards TPDOs, which were queued before bus-off.
+ * \details Same as CO_CANclearPendingSyncPDOs(), but for all PDOs. Aborted
+ * mailboxes are released and refilled in abort interrupt, after the recovery.
+ * \param [in]	CANmodule pointer to CO_CANmodule_t object
+ *
+ * \ingroup CO_driver
+ ******************************************************************************/
+static void CO_CANbusOffFlush(CO_CANmodule_t *CANmodule)
+{
+	uint32_t abort = 0U;
+	uint8_t m;
+	uint8_t w;
+
+	CO_LOCK_CAN_SEND();
+	for(m = 0U; m < 3U; m++)
+	{
+		const CO_CANtx_t *buffer = CANmodule->txMailbox[m];
+
+		if((buffer != NULL) && CO_CANtxIsPDO(buffer) &&
+				(HAL_CAN_IsTxMessagePending(CANmodule->CANbaseAddress, CAN_TX_MAILBOX0 << m) != 0U))
+		{
+			abort |= CAN_TX_MAILBOX0 << m;
+		}
+		else
+		{
+			;//do nothing
+		}
+	}
+	if(abort != 0U)
+	{
+		(void)HAL_CAN_AbortTxRequest(CANmodule->CANbaseAddress, abort);
+	}
+	else
+	{
+		;//do nothing
+	}
+
+	for(w = 0U; (w < CO_CAN_TX_PENDING_WORDS) && (CANmodule->CANtxCount != 0U); w++)
+	{
+		uint32_t pending = CANmodule->txPending[w];
+
+		while(pending != 0U)
+		{
+			uint8_t bit = (uint8_t)__CLZ(pending);
+			uint8_t rank = (uint8_t)((w << 5) + bit);
+			CO_CANtx_t *buffer = &CANmodule->txArray[CANmodule->txByRank[rank]];
+
+			pending &= ~(0x80000000U >> bit);
+			if(buffer->bufferFull && CO_CANtxIsPDO(buffer))
+			{
+				buffer->bufferFull = false;
+				CO_CANtxPendingClear(CANmodule, rank);
+				CANmodule->CANtxCount--;
+				CO_CAN_STAT_ADD(CANmodule, txAborted, 1U);
+			}
+			else
+			{
+				;//do nothing
+			}
+		}
+	}
+	CO_UNLOCK_CAN_SEND();
+}
+
+
+/*!*****************************************************************************
+ * \brief bus-off recovery state machine, see CO_CAN_BUSOFF_RECOVERY.
+ * \details Called from CO_CANverifyErrors(), never blocks. bxCAN leaves
+ * bus-off (AutoBusOff disabled), when software requests initialization mode
+ * and leaves it; then it waits for 128 x 11 recessive bits by itself.
+ * \param [in]	CANmodule pointer to CO_CANmodule_t object
+ * \param [in]	busOff ESR BOFF bit
+ *
+ * \ingroup CO_driver
+ ******************************************************************************/
+static void CO_CANbusOffProcess(CO_CANmodule_t *CANmodule, bool_t busOff)
+{
+	CAN_TypeDef *CANx = CANmodule->CANbaseAddress->Instance;
+	uint32_t elapsed = HAL_GetTick() - CANmodule->busOffTick;
+
+	switch(CANmodule->busOffState)
+	{
+	case CO_CAN_BUSOFF_ACTIVE:
+		if(busOff)
+		{
+			uint8_t i;
+
+			if(CANmodule->busOffCount < 0xFFU)
+			{
+				CANmodule->busOffCount++;
+			}
+			else
+			{
+				;//do nothing
+			}
+			/* first bus-off is recovered at once, then delay doubles */
+			CANmodule->busOffDelay = 0U;
+			if(CANmodule->busOffCount > 1U)
+			{
+				CANmodule->busOffDelay = CO_CAN_BUSOFF_DELAY_MS;
+				for(i = 2U; (i < CANmodule->busOffCount) &&
+						(CANmodule->busOffDelay < CO_CAN_BUSOFF_DELAY_MAX_MS); i++)
+				{
+					CANmodule->busOffDelay <<= 1;
+				}
+				if(CANmodule->busOffDelay > CO_CAN_BUSOFF_DELAY_MAX_MS)
+				{
+					CANmodule->busOffDelay = CO_CAN_BUSOFF_DELAY_MAX_MS;
+				}
+				else
+				{
+					;//do nothing
+				}
+			}
+			else
+			{
+				;//do nothing
+			}
+			CO_errorReport((CO_EM_t*)CANmodule->em, CO_EM_CAN_TX_BUS_OFF, CO_EMC_BUS_OFF_RECOVERED,
+					CANmodule->busOffCount);
+			CANmodule->busOffTick = HAL_GetTick();
+			CANmodule->busOffState = CO_CAN_BUSOFF_WAIT;
+		}
+		else if((CANmodule->busOffCount != 0U) && (elapsed >= CO_CAN_BUSOFF_STABLE_MS))
+		{
+			CANmodule->busOffCount = 0U;
+		}
+		else
+		{
+			;//do nothing
+		}
+		break;
+
+	case CO_CAN_BUSOFF_WAIT:
+		if(elapsed >= CANmodule->busOffDelay)
+		{
+			CO_CANbusOffFlush(CANmodule);
+			CANx->MCR |= CAN_MCR_INRQ;
+			CANmodule->busOffState = CO_CAN_BUSOFF_INIT;
+		}
+		else
+		{
+			;//do nothing
+		}
+		break;
+
+	case CO_CAN_BUSOFF_INIT:
+		if((CANx->MSR & CAN_MSR_INAK) != 0U)
+		{
+			CANx->MCR &= ~CAN_MCR_INRQ;
+			CANmodule->busOffState = CO_CAN_BUSOFF_RECOVER;
+		}
+		else
+		{
+			;//do nothing
+		}
+		break;
+
+	default: /* CO_CAN_BUSOFF_RECOVER */
+		if(!busOff && ((CANx->MSR & CAN_MSR_INAK) == 0U))
+		{
+			CO_errorReset((CO_EM_t*)CANmodule->em, CO_EM_CAN_TX_BUS_OFF, CANmodule->busOffCount);
+			CANmodule->busOffTick = HAL_GetTick();
+			CANmodule->busOffState = CO_CAN_BUSOFF_ACTIVE;
+		}
+		else
+		{
+			;//do nothing
+		}
+		break;
+	}
+}
+#endif
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_CANmodule_init(
+		CO_CANmodule_t         *CANmodule,
+		CAN_HandleTypeDef      *HALCanObject,
+		CO_CANrx_t              rxArray[],
+		uint16_t                rxSize,
+		CO_CANtx_t              txArray[],
+		uint16_t                txSize,
+		uint16_t                CANbitRate)
+{
+	uint16_t i;
+
+	/* verify arguments */
+	if(CANmodule==NULL || rxArray==NULL || txArray==NULL ||
+			txSize > (CO_CAN_TX_PENDING_WORDS * 32U))
+	{
+		return CO_ERROR_ILLEGAL_ARGUMENT;
+	}
+	else
+	{
+		;//do nothing
+	}
+
+	/* Configure object variables */
+	CANmodule->CANbaseAddress = (CAN_HandleTypeDef*)HALCanObject;
+	CANmodule->CANbitRate = CANbitRate;
+	CANmodule->rxArray = rxArray;
+	CANmodule->rxSize = rxSize;
+	CANmodule->rxSlice = rxSize;
+	CANmodule->txArray = txArray;
+	CANmodule->txSize = txSize;
+	CANmodule->CANnormal = false;
+	/* filters are used, if all buffers fit into filter match indexes */
+	CANmodule->useCANrxFilters = (rxSize <= CO_CAN_FILTER_NO_FMI) ? true : false;
+	CANmodule->rxFiltersDeferred = true;
+	CANmodule->filterListMode = 0U;
+	CANmodule->filterFifo1 = 0U;
+	CANmodule->filterScale32 = 0U;
+	CANmodule->filterFifo1Start = 0U;
+	CANmodule->filterBanksUsed = 0U;
+#if CO_CAN_BRIDGE > 0
+	CANmodule->filterBridgeStart = CO_CAN_FILTER_NO_FMI;
+	CANmodule->bridgeHead = 0U;
+	CANmodule->bridgeTail = 0U;
+	for(i=0U; i<CO_CAN_BRIDGE; i++)
+	{
+		CANmodule->bridgeRoute[i].target = NULL;
+	}
+#endif
+	CANmodule->bufferInhibitFlag = false;
+	CANmodule->txMailbox[0] = NULL;
+	CANmodule->txMailbox[1] = NULL;
+	CANmodule->txMailbox[2] = NULL;
+#if CO_CAN_TX_LATENCY > 0
+	CANmodule->txLatencyArmed = 0U;
+	CANmodule->txLatencyCyclesPerUs = (SystemCoreClock >= 1000000U) ? (SystemCoreClock / 1000000U) : 1U;
+	CANmodule->txLatencySelect = 0U;
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+#if CO_CAN_TX_LOOPBACK > 0
+	for(i = 0U; i < CO_CAN_LOOPBACK_WORDS; i++)
+	{
+		CANmodule->txLocalOnly[i] = 0U;
+	}
+#endif
+	CANmodule->firstCANtxMessage = true;
+	CANmodule->CANtxCount = 0U;
+#if CO_CAN_RX_RING > 0
+	CANmodule->rxRingHead = 0U;
+	CANmodule->rxRingTail = 0U;
+#endif
+#if CO_CAN_RECORDER > 0
+	CANmodule->recorder = NULL;
+#if CO_CAN_RECORDER_ALL > 0
+	/* recorder sees frames of all devices */
+	CANmodule->useCANrxFilters = false;
+#endif
+#endif
+	CANmodule->errOld = 0U;
+	CANmodule->em = NULL;
+#if CO_CAN_ERROR_IRQ > 0
+	CANmodule->errESR = 0U;
+	CANmodule->errIrqCount = 0U;
+	CANmodule->errFlags = 0U;
+#endif
+#if CO_CAN_TX_CALLBACK > 0
+	CANmodule->pFunctTx = NULL;
+	CANmodule->functTxObject = NULL;
+#endif
+#if CO_CAN_RX_CALLBACK > 0
+	CANmodule->pFunctRx = NULL;
+	CANmodule->functRxObject = NULL;
+#endif
+#if CO_CAN_STATISTICS > 0
+	CO_CANresetStatistics(CANmodule);
+	CANmodule->busOffOld = false;
+#endif
+#if CO_CAN_BUSOFF_RECOVERY > 0
+	CANmodule->busOffState = CO_CAN_BUSOFF_ACTIVE;
+	CANmodule->busOffCount = 0U;
+	CANmodule->busOffTick = HAL_GetTick();
+	CANmodule->busOffDelay = 0U;
+#endif
+#if CO_CAN_BUSLOAD > 0
+	CANmodule->busLoadBits = 0U;
+#endif
+#if CO_CAN_RX_STORM > 0
+	CANmodule->rxStormPending = false;
+	CANmodule->rxStormBlocked = 0U;
+#endif
+
+	for(i=0U; i<rxSize; i++)
+	{
+		rxArray[i].ident = 0U;
+		rxArray[i].pFunct = NULL;
+#if CO_CAN_RX_STORM > 0
+		rxArray[i].stormState = CO_CAN_STORM_PASS;
+#endif
+	}
+#if CO_CAN_EXT_ID > 0
+	for(i=0U; i<CO_CAN_EXT_RX_SIZE; i++)
+	{
+		CANmodule->rxExt[i].ident = 0U;
+		CANmodule->rxExt[i].mask = CO_CAN_RX_EXT_MASK_EXACT;
+		CANmodule->rxExt[i].pFunct = NULL;
+	}
+#endif
+
+	for(i=0U; i<txSize; i++)
+	{
+		txArray[i].bufferFull = false;
+#if CO_CAN_TX_CRITICAL > 0
+		txArray[i].critical = false;
+#endif
+#if CO_CAN_TX_LATENCY > 0
+		CO_CANtxLatencyClear(&txArray[i].latency);
+#endif
+	}
+	CO_CANtxRank(CANmodule);
+
+	for(i=0U; i<CO_CAN_FILTER_NO_FMI; i++)
+	{
+		CANmodule->filterToRx[i] = CO_CAN_FILTER_UNUSED;
+	}
+#if CO_CAN_RX_DISPATCH > 0
+	for(i=0U; i<0x800U; i++)
+	{
+		CANmodule->rxDispatch[i] = CO_CAN_FILTER_UNUSED;
+	}
+#endif
+
+	/* Configure CAN module registers */
+	/* Configuration is handled by CubeMX HAL*/
+#if CO_CAN_WARM_RESET > 0
+	if(CO_CANisRunning(CANmodule, CANbitRate))
+	{
+#if defined(CAN2)
+		CANmodule->filterBankFirst = (CANmodule->CANbaseAddress->Instance == CAN2) ? CO_CAN_FILTER_BANKS : 0U;
+#else
+		CANmodule->filterBankFirst = 0U;
+#endif
+		/* mailboxes aborted by CO_CANmodule_disable() belong to old buffers */
+		CANmodule->CANbaseAddress->Instance->TSR = CAN_TSR_RQCP0 | CAN_TSR_RQCP1 | CAN_TSR_RQCP2;
+		CO_CANmodules[CO_CANmoduleIndex(CANmodule->CANbaseAddress->Instance)] = CANmodule;
+
+		return CO_ERROR_NO;
+	}
+	else
+	{
+		/* CO_CANmodule_disable() keeps the peripheral running */
+		(void)HAL_CAN_Stop(CANmodule->CANbaseAddress);
+	}
+#endif
+	CO_CANmodule_disable(CANmodule);
+	HAL_CAN_MspDeInit(CANmodule->CANbaseAddress);
+	HAL_CAN_MspInit(CANmodule->CANbaseAddress); /* NVIC and GPIO */
+
+	if(CANmodule->CANbaseAddress->Instance == NULL)
+	{
+		/* handle was not initialized by CubeMX */
+		CANmodule->CANbaseAddress->Instance = CAN1;
+	}
+	else
+	{
+		;//do nothing
+	}
+#if defined(CAN2)
+	/* CAN2 uses filter banks after SlaveStartFilterBank */
+	CANmodule->filterBankFirst = (CANmodule->CANbaseAddress->Instance == CAN2) ? CO_CAN_FILTER_BANKS : 0U;
+#else
+	CANmodule->filterBankFirst = 0U;
+#endif
+	CANmodule->CANbaseAddress->Init.Mode = CAN_MODE_NORMAL;
+#if CO_CAN_TIMESTAMP > 0
+	/* CAN bit time counter is captured in RDTxR.TIME, transmit global time stays disabled */
+	CANmodule->CANbaseAddress->Init.TimeTriggeredMode = ENABLE;
+#else
+	CANmodule->CANbaseAddress->Init.TimeTriggeredMode = DISABLE;
+#endif
+	CANmodule->CANbaseAddress->Init.AutoBusOff = DISABLE;
+	CANmodule->CANbaseAddress->Init.AutoWakeUp = DISABLE;
+	CANmodule->CANbaseAddress->Init.AutoRetransmission = ENABLE;
+	CANmodule->CANbaseAddress->Init.ReceiveFifoLocked = DISABLE;
+	CANmodule->CANbaseAddress->Init.TransmitFifoPriority = DISABLE;
+
+	/* Can speed configuration. */
+#if CO_CAN_AUTO_BITRATE > 0
+	if(CANbitRate == 0U)
+	{
+		CO_ReturnError_t ret = CO_CANdetectBitRate(CANmodule);
+
+		if(ret != CO_ERROR_NO)
+		{
+			return ret;
+		}
+		CANbitRate = CANmodule->CANbitRate;
+		CANmodule->CANbaseAddress->Init.Mode = CAN_MODE_NORMAL;
+	}
+#endif
+	if(CO_CANsetBitTiming(CANmodule, CANbitRate) != CO_ERROR_NO)
+	{
+		return  CO_ERROR_ILLEGAL_BAUDRATE;
+	}
+
+	if (HAL_CAN_Init(CANmodule->CANbaseAddress) != HAL_OK)
+	{
+		//_Error_Handler(__FILE__, __LINE__);
+		return CO_ERROR_HAL;
+	}
+
+	/* connect CubeMX callbacks of this CAN peripheral to the CANmodule */
+	CO_CANmodules[CO_CANmoduleIndex(CANmodule->CANbaseAddress->Instance)] = CANmodule;
+
+	return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_CANbitTiming(
+		uint32_t                clock_Hz,
+		uint16_t                CANbitRate,
+		uint16_t                samplePoint,
+		CO_CANbitTiming_t      *timing)
+{
+	uint32_t bitRate_Hz = (uint32_t)CANbitRate * 1000U;
+	uint32_t bestRateErr = 0xFFFFFFFFU;
+	uint32_t bestSpErr = 0xFFFFFFFFU;
+	uint32_t tq;
+
+	if((timing == NULL) || (bitRate_Hz == 0U) || (samplePoint < 500U) || (samplePoint > 950U))
+	{
+		return CO_ERROR_ILLEGAL_ARGUMENT;
+	}
+	else
+	{
+		;//do nothing
+	}
+
+	for(tq = 25U; tq >= 8U; tq--)
+	{
+		uint32_t brp = (clock_Hz + (bitRate_Hz * tq) / 2U) / (bitRate_Hz * tq);
+		uint32_t actual_Hz;
+		uint32_t rateErr;
+		uint32_t spErr;
+		uint32_t seg1;
+		uint32_t seg2;
+
+		if((brp < 1U) || (brp > 1024U))
+		{
+			continue;
+		}
+		else
+		{
+			;//do nothing
+		}
+
+		/* bit rate error in ppm */
+		actual_Hz = clock_Hz / (brp * tq);
+		rateErr = (actual_Hz > bitRate_Hz) ? (actual_Hz - bitRate_Hz) : (bitRate_Hz - actual_Hz);
+		rateErr = (uint32_t)(((uint64_t)rateErr * 1000000U) / bitRate_Hz);
+
+		/* sample point is at the end of sync segment (1 tq) plus seg1 */
+		seg1 = (tq * samplePoint + 500U) / 1000U - 1U;
+		if(seg1 > 16U)
+		{
+			seg1 = 16U;
+		}
+		else if(seg1 < 1U)
+		{
+			seg1 = 1U;
+		}
+		else
+		{
+			;//do nothing
+		}
+		seg2 = tq - 1U - seg1;
+		if(seg2 > 8U)
+		{
+			seg2 = 8U;
+			seg1 = tq - 1U - seg2;
+		}
+		else if(seg2 < 1U)
+		{
+			seg2 = 1U;
+			seg1 = tq - 1U - seg2;
+		}
+		else
+		{
+			;//do nothing
+		}
+		if(seg1 > 16U)
+		{
+			continue;
+		}
+		else
+		{
+			;//do nothing
+		}
+		spErr = ((1U + seg1) * 1000U > samplePoint * tq) ?
+				((1U + seg1) * 1000U - samplePoint * tq) : (samplePoint * tq - (1U + seg1) * 1000U);
+		spErr = (spErr * 1000U) / tq;
+
+		if((rateErr < bestRateErr) || ((rateErr == bestRateErr) && (spErr < bestSpErr)))
+		{
+			bestRateErr = rateErr;
+			bestSpErr = spErr;
+			timing->prescaler = (uint16_t)brp;
+			timing->timeSeg1 = (uint8_t)seg1;
+			timing->timeSeg2 = (uint8_t)seg2;
+			timing->sjw = (uint8_t)((CO_CAN_SJW < 1U) ? 1U : (CO_CAN_SJW > 4U) ? 4U : CO_CAN_SJW);
+			if(timing->sjw > seg2)
+			{
+				timing->sjw = (uint8_t)seg2;
+			}
+			else
+			{
+				;//do nothing
+			}
+			timing->samplePoint = (uint16_t)(((1U + seg1) * 1000U) / tq);
+		}
+		else
+		{
+			;//do nothing
+		}
 	}
 
-	/* Enable CAN interrupts */
+	return (bestRateErr <= CO_CAN_BITRATE_TOLERANCE_PPM) ? CO_ERROR_NO : CO_ERROR_ILLEGAL_BAUDRATE;
+}
 
-	//    HAL_NVIC_SetPriority(CAN1_TX_IRQn, 1, 0);
-	//    HAL_NVIC_EnableIRQ(CAN1_TX_IRQn);
-	//    HAL_NVIC_SetPriority(CAN1_RX0_IRQn, 1, 0);
-	//    HAL_NVIC_EnableIRQ(CAN1_RX0_IRQn);
-	//    HAL_NVIC_SetPriority(CAN1_RX1_IRQn, 1, 0);
-	//    HAL_NVIC_EnableIRQ(CAN1_RX1_IRQn);
 
-	if(HAL_CAN_ActivateNotification( CANmodule->CANbaseAddress,
-			CAN_IT_RX_FIFO0_MSG_PENDING |
-			CAN_IT_RX_FIFO1_MSG_PENDING |
-			CAN_IT_TX_MAILBOX_EMPTY)
-			!= HAL_OK)
+#if CO_CAN_TX_CALLBACK > 0
+/******************************************************************************/
+void CO_CANmodule_initTxCallback(
+		CO_CANmodule_t         *CANmodule,
+		void                   *object,
+		void                  (*pFunct)(void *object))
+{
+	if(CANmodule != NULL)
 	{
-		/* Notification Error */
-		Error = CO_ERROR_HAL;
+		CO_LOCK_CAN_SEND();
+		CANmodule->functTxObject = object;
+		CANmodule->pFunctTx = pFunct;
+		CO_UNLOCK_CAN_SEND();
+	}
+	else
+	{
+		;//do nothing
 	}
-
-	CANmodule->CANnormal = true;
-	return Error;
 }
+#endif
 
+
+#if CO_CAN_RX_CALLBACK > 0
 /******************************************************************************/
-CO_ReturnError_t CO_CANmodule_init(
+void CO_CANmodule_initRxCallback(
 		CO_CANmodule_t         *CANmodule,
-		CAN_HandleTypeDef      *HALCanObject,
-		CO_CANrx_t              rxArray[],
-		uint16_t                rxSize,
-		CO_CANtx_t              txArray[],
-		uint16_t                txSize,
-		uint16_t                CANbitRate)
+		void                   *object,
+		void                  (*pFunct)(void *object, uint16_t ident))
 {
-	uint16_t i;
-
-	/* verify arguments */
-	if(CANmodule==NULL || rxArray==NULL || txArray==NULL)
+	if(CANmodule != NULL)
 	{
-		return CO_ERROR_ILLEGAL_ARGUMENT;
+		CO_LOCK_CAN_SEND();
+		CANmodule->functRxObject = object;
+		CANmodule->pFunctRx = pFunct;
+		CO_UNLOCK_CAN_SEND();
 	}
 	else
 	{
 		;//do nothing
 	}
+}
+#endif
 
-	RxFifo_Callback_CanModule_p = CANmodule;
-
-	/* Configure object variables */
-	CANmodule->CANbaseAddress = (CAN_HandleTypeDef*)HALCanObject;
-	CANmodule->rxArray = rxArray;
-	CANmodule->rxSize = rxSize;
-	CANmodule->txArray = txArray;
-	CANmodule->txSize = txSize;
-	CANmodule->CANnormal = false;
-	CANmodule->useCANrxFilters = false;
-	CANmodule->bufferInhibitFlag = false;
-	CANmodule->firstCANtxMessage = true;
-	CANmodule->CANtxCount = 0U;
-	CANmodule->errOld = 0U;
-	CANmodule->em = NULL;
 
-	for(i=0U; i<rxSize; i++)
+/******************************************************************************/
+CO_ReturnError_t CO_CANmodule_setRxSlice(CO_CANmodule_t *CANmodule, uint16_t rxSlice)
+{
+	if((CANmodule == NULL) || (rxSlice == 0U) || ((CANmodule->rxSize % rxSlice) != 0U))
 	{
-		rxArray[i].ident = 0U;
-		rxArray[i].pFunct = NULL;
+		return CO_ERROR_ILLEGAL_ARGUMENT;
 	}
-
-	for(i=0U; i<txSize; i++)
+	else
 	{
-		txArray[i].bufferFull = false;
+		;//do nothing
 	}
 
-	/* Configure CAN module registers */
-	/* Configuration is handled by CubeMX HAL*/
-	CO_CANmodule_disable(CANmodule);
-	HAL_CAN_MspDeInit(CANmodule->CANbaseAddress);
-	HAL_CAN_MspInit(CANmodule->CANbaseAddress); /* NVIC and GPIO */
+	CANmodule->rxSlice = rxSlice;
+	return CO_ERROR_NO;
+}
 
-	CANmodule->CANbaseAddress->Instance = CAN1;
-	CANmodule->CANbaseAddress->Init.Mode = CAN_MODE_NORMAL;
-	CANmodule->CANbaseAddress->Init.SyncJumpWidth = CAN_SJW_1TQ;
-	CANmodule->CANbaseAddress->Init.TimeTriggeredMode = DISABLE;
-	CANmodule->CANbaseAddress->Init.AutoBusOff = DISABLE;
-	CANmodule->CANbaseAddress->Init.AutoWakeUp = DISABLE;
-	CANmodule->CANbaseAddress->Init.AutoRetransmission = ENABLE;
-	CANmodule->CANbaseAddress->Init.ReceiveFifoLocked = DISABLE;
-	CANmodule->CANbaseAddress->Init.TransmitFifoPriority = DISABLE;
-	CANmodule->CANbaseAddress->Init.TimeSeg2 = CAN_BS2_2TQ;
-	CANmodule->CANbaseAddress->Init.TimeSeg1 = CAN_BS1_13TQ;
 
-	/* Can speed configuration. */
-	/* Based on the values obtained from http://bittiming.can-wiki.info */
-	/* Assuming CAN clock is 80 MHz */
-
-	/*
-    Bit	rate	Acurracy	Prescaler   nr. timequanta  Seg.1	Seg.2	Sample point  CAN_BUS_TIME
-    1000		0.0000		5			16				13		2		87.5		  0x001c0004
-    500		    0.0000		10			16				13		2		87.5		  0x001c0009
-    250		 	0.0000		20			16				13		2		87.5		  0x001c0013
-    125		    0.0000		40			16				13		2		87.5		  0x001c0027
-    100		 	0.0000		50			16				13		2		87.5		  0x001c0031
-    50 		 	0.0000		100			16				13		2		87.5		  0x001c0063
-    20 		 	0.0000		250			16				13		2		87.5		  0x0007018f
-    10 		 	0.0000		500			16				13		2		87.5		  0x001c01f3
-	 */
-
-	uint32_t Prescaler = 500;
-
-	switch(CANbitRate) {
-	case 1000:
-		Prescaler = 5;
-		break;
-	case 500:
-		Prescaler = 10;
-		break;
-	case 250:
-		Prescaler = 20;
-		break;
-	case 125:
-		Prescaler = 40;
-		break;
-	case 100:
-		Prescaler = 50;
-		break;
-	case 50:
-		Prescaler = 100;
-		break;
-	case 20:
-		Prescaler = 250;
-		break;
-	case 10:
-		Prescaler = 500;
-		break;
+#if CO_CAN_BRIDGE > 0
+/******************************************************************************/
+CO_ReturnError_t CO_CANbridgeRoute(
+		CO_CANmodule_t         *CANmodule,
+		uint16_t                index,
+		CO_CANmodule_t         *target,
+		uint16_t                ident,
+		uint16_t                mask,
+		bool_t                  rtr,
+		int16_t                 offset)
+{
+	CO_CANbridgeRoute_t *route;
 
-	default :
-		return  CO_ERROR_ILLEGAL_BAUDRATE;
+	if((CANmodule == NULL) || (index >= CO_CAN_BRIDGE) || (target == CANmodule))
+	{
+		return CO_ERROR_ILLEGAL_ARGUMENT;
 	}
-
-	CANmodule->CANbaseAddress->Init.Prescaler = Prescaler;
-
-	if (HAL_CAN_Init(CANmodule->CANbaseAddress) != HAL_OK)
+	else
 	{
-		//_Error_Handler(__FILE__, __LINE__);
-		return CO_ERROR_HAL;
+		;//do nothing
 	}
 
-	return CO_ERROR_NO;
+	route = &CANmodule->bridgeRoute[index];
+	CO_LOCK_CAN_SEND();
+	/* same alignment as CO_CANrxBufferInit(), RTR is always compared */
+	route->ident = (uint16_t)(((ident & 0x07FFU) << 2) | (rtr ? 0x02U : 0U));
+	route->mask = (uint16_t)(((mask & 0x07FFU) << 2) | 0x02U);
+	route->offset = offset;
+	route->target = target;
+	CO_UNLOCK_CAN_SEND();
+
+	/* route gets its own filter bank in FIFO1 */
+	return CO_CANconfigFilters(CANmodule);
 }
+#endif
 
 
 /******************************************************************************/
@@ -299,15 +3597,47 @@ void CO_CANmodule_disable(CO_CANmodule_t *CANmodule){
 	HAL_CAN_DeactivateNotification(CANmodule->CANbaseAddress ,
 			CAN_IT_RX_FIFO0_MSG_PENDING |
 			CAN_IT_RX_FIFO1_MSG_PENDING |
+#if CO_CAN_ERROR_IRQ > 0
+			CO_CAN_IT_ERRORS |
+#endif
 			CAN_IT_TX_MAILBOX_EMPTY);
+#if CO_CAN_WARM_RESET > 0
+	/* peripheral stays on the bus for the next CO_CANmodule_init() */
+	(void)HAL_CAN_AbortTxRequest(CANmodule->CANbaseAddress,
+			CAN_TX_MAILBOX0 | CAN_TX_MAILBOX1 | CAN_TX_MAILBOX2);
+#else
 	HAL_CAN_Stop(CANmodule->CANbaseAddress);
+#endif
 }
 
 
 /******************************************************************************/
 uint16_t CO_CANrxMsg_readIdent(const CO_CANrxMsg_t *rxMsg){
-	return (uint16_t) rxMsg->RxHeader.StdId;
+	return (uint16_t) rxMsg->ident;
+}
+
+
+#if CO_CAN_EXT_ID > 0
+/******************************************************************************/
+uint32_t CO_CANrxMsg_readIdentExt(const CO_CANrxMsg_t *rxMsg){
+	return rxMsg->ident & 0x1FFFFFFFU;
+}
+#endif
+
+
+#if CO_CAN_TIMESTAMP > 0
+/******************************************************************************/
+uint16_t CO_CANrxMsg_readTimestamp(const CO_CANrxMsg_t *rxMsg){
+	return rxMsg->timestamp;
+}
+
+
+/******************************************************************************/
+uint32_t CO_CANtimestampDiff_us(const CO_CANmodule_t *CANmodule, uint16_t from, uint16_t to){
+	/* one bit time is 1000 / CANbitRate microseconds */
+	return ((uint32_t)(uint16_t)(to - from) * 1000U) / CANmodule->CANbitRate;
 }
+#endif
 
 
 /******************************************************************************/
@@ -325,10 +3655,27 @@ CO_ReturnError_t CO_CANrxBufferInit(
 	if((CANmodule!=NULL) && (object!=NULL) && (pFunct!=NULL) && (index < CANmodule->rxSize)){
 		/* buffer, which will be configured */
 		CO_CANrx_t *buffer = &CANmodule->rxArray[index];
+#if CO_CAN_RX_DISPATCH > 0
+		uint16_t oldIdent = buffer->ident;
+		uint16_t oldMask = buffer->mask;
+		bool_t oldUsed = ((buffer->pFunct != NULL) && ((buffer->ident & 0x02U) == 0U)) ? true : false;
+#endif
 
 		/* Configure object variables */
 		buffer->object = object;
 		buffer->pFunct = pFunct;
+#if CO_CAN_RX_STORM > 0
+		if(buffer->stormState == CO_CAN_STORM_PASS)
+		{
+			/* blocked buffer keeps its hold time */
+			buffer->stormTokens = CO_CAN_STORM_FULL;
+			buffer->stormTick = HAL_GetTick();
+		}
+		else
+		{
+			;//do nothing
+		}
+#endif
 
 		/* CAN identifier and CAN mask, bit aligned with CAN module. Different on different microcontrollers. */
 		buffer->ident = (ident & 0x07FF) << 2;
@@ -339,36 +3686,11 @@ CO_ReturnError_t CO_CANrxBufferInit(
 		buffer->mask = (mask & 0x07FF) << 2;
 		buffer->mask |= 0x02;
 
-		/* Set CAN hardware module filter and mask. */
-		if(CANmodule->useCANrxFilters)
-		{
-			/* TODO Configure CAN module hardware filters */
-		}
-		else
-		{
-			/*no hardware filters*/
-			CAN_FilterTypeDef FilterConfig;
-
-			FilterConfig.FilterBank = 0;
-			FilterConfig.FilterMode = CAN_FILTERMODE_IDMASK;
-			FilterConfig.FilterScale = CAN_FILTERSCALE_32BIT;
-			FilterConfig.FilterIdHigh = 0x0;
-			FilterConfig.FilterIdLow = 0x0;
-			FilterConfig.FilterMaskIdHigh = 0x0;
-			FilterConfig.FilterMaskIdLow = 0x0;
-			FilterConfig.FilterFIFOAssignment = CAN_RX_FIFO0;
-			FilterConfig.FilterActivation = ENABLE;
-			FilterConfig.SlaveStartFilterBank = 14;
-
-			if(HAL_CAN_ConfigFilter(CANmodule->CANbaseAddress, &FilterConfig)!=HAL_OK)
-			{
-				return CO_ERROR_HAL;
-			}
-			else
-			{
-				;//do nothing
-			}
-		}
+		/* Set CAN hardware module filters and masks. */
+		ret = CO_CANconfigFilters(CANmodule);
+#if CO_CAN_RX_DISPATCH > 0
+		CO_CANupdateDispatch(CANmodule, index, oldIdent, oldMask, oldUsed);
+#endif
 	}
 	else
 	{
@@ -378,6 +3700,43 @@ CO_ReturnError_t CO_CANrxBufferInit(
 }
 
 
+/******************************************************************************/
+CO_ReturnError_t CO_CANrxBufferInitRange(
+		CO_CANmodule_t         *CANmodule,
+		uint16_t                index,
+		CO_CANrxRange_t        *range,
+		uint16_t                ident,
+		uint16_t                count,
+		void                   *object,
+		void                  (*pFunct)(void *object, const CO_CANrxMsg_t *message, uint16_t offset))
+{
+	uint16_t mask = 0x07FFU;
+
+	if((range == NULL) || (object == NULL) || (pFunct == NULL) ||
+			(ident > 0x07FFU) || (count == 0U) || (count > (0x0800U - ident)))
+	{
+		return CO_ERROR_ILLEGAL_ARGUMENT;
+	}
+	else
+	{
+		;//do nothing
+	}
+
+	/* smallest aligned block of identifiers, which contains the range */
+	while(((ident ^ (uint16_t)(ident + count - 1U)) & mask) != 0U)
+	{
+		mask = (uint16_t)(mask << 1) & 0x07FFU;
+	}
+
+	range->ident = ident;
+	range->count = count;
+	range->object = object;
+	range->pFunct = pFunct;
+
+	return CO_CANrxBufferInit(CANmodule, index, ident & mask, mask, false, (void*)range, CO_CANrxRange);
+}
+
+
 /******************************************************************************/
 CO_CANtx_t *CO_CANtxBufferInit(
 		CO_CANmodule_t         *CANmodule,
@@ -401,16 +3760,132 @@ CO_CANtx_t *CO_CANtxBufferInit(
 
 		buffer->DLC = noOfBytes;
 		buffer->bufferFull = false;
+#if CO_CAN_TX_LATENCY > 0
+		/* identifier may change, latency of the old one is not valid */
+		CO_CANtxLatencyClear(&buffer->latency);
+#endif
+#if CO_CAN_TX_CRITICAL > 0
+		buffer->syncFlag = ((syncFlag & 0x01U) != 0U) ? true : false;
+		buffer->critical = ((syncFlag & CO_CAN_TX_FLAG_CRITICAL) != 0U) ? true : false;
+#else
+		buffer->syncFlag = syncFlag;
+#endif
+
+		/* HAL header does not change until next CO_CANtxBufferInit() */
+		prepareTxHeader(&buffer->TxHeader, buffer);
+
+		/* identifier changed, update transmit priority */
+		CO_CANtxRank(CANmodule);
+	}
+
+	return buffer;
+}
+
+#if CO_CAN_EXT_ID > 0
+/******************************************************************************/
+CO_ReturnError_t CO_CANrxBufferInitExt(
+		CO_CANmodule_t         *CANmodule,
+		uint16_t                index,
+		uint32_t                ident,
+		uint32_t                mask,
+		bool_t                  rtr,
+		void                   *object,
+		void                  (*pFunct)(void *object, const CO_CANrxMsg_t *message))
+{
+	CO_ReturnError_t ret = CO_ERROR_NO;
+
+	if((CANmodule!=NULL) && (index < CO_CAN_EXT_RX_SIZE)){
+		/* buffer, which will be configured */
+		CO_CANrxExt_t *buffer = &CANmodule->rxExt[index];
+
+		/* release buffer before it is changed, interrupt may read it */
+		CO_LOCK_CAN_SEND();
+		buffer->pFunct = NULL;
+		CO_UNLOCK_CAN_SEND();
+
+		/* CAN identifier and CAN mask in RIR register layout */
+		buffer->object = object;
+		buffer->ident = ((ident & 0x1FFFFFFFU) << CAN_RI0R_EXID_Pos) | CAN_RI0R_IDE;
+		if (rtr)
+		{
+			buffer->ident |= CAN_RI0R_RTR;
+		}
+		buffer->mask = ((mask & 0x1FFFFFFFU) << CAN_RI0R_EXID_Pos) | CAN_RI0R_IDE | CAN_RI0R_RTR;
+		buffer->pFunct = pFunct;
+
+		/* Set CAN hardware module filters and masks. */
+		ret = CO_CANconfigFilters(CANmodule);
+	}
+	else
+	{
+		ret = CO_ERROR_ILLEGAL_ARGUMENT;
+	}
+	return ret;
+}
+
+
+/******************************************************************************/
+CO_CANtx_t *CO_CANtxBufferInitExt(
+		CO_CANmodule_t         *CANmodule,
+		uint16_t                index,
+		uint32_t                ident,
+		bool_t                  rtr,
+		uint8_t                 noOfBytes,
+		bool_t                  syncFlag)
+{
+	CO_CANtx_t *buffer = NULL;
+
+	if((CANmodule != NULL) && (index < CANmodule->txSize)){
+		/* get specific buffer */
+		buffer = &CANmodule->txArray[index];
+
+		/* CAN identifier with extended flag, RTR at the same position as standard */
+		buffer->ident = CO_CAN_TX_EXT | ((ident & 0x1FFFFFFFU) << 2);
+		if (rtr) buffer->ident |= 0x02;
+
+		buffer->DLC = noOfBytes;
+		buffer->bufferFull = false;
+#if CO_CAN_TX_LATENCY > 0
+		/* identifier may change, latency of the old one is not valid */
+		CO_CANtxLatencyClear(&buffer->latency);
+#endif
+#if CO_CAN_TX_CRITICAL > 0
+		buffer->syncFlag = ((syncFlag & 0x01U) != 0U) ? true : false;
+		buffer->critical = ((syncFlag & CO_CAN_TX_FLAG_CRITICAL) != 0U) ? true : false;
+#else
 		buffer->syncFlag = syncFlag;
+#endif
+
+		prepareTxHeader(&buffer->TxHeader, buffer);
+
+		/* identifier changed, update transmit priority */
+		CO_CANtxRank(CANmodule);
 	}
 
 	return buffer;
 }
+#endif
 
 /******************************************************************************/
 CO_ReturnError_t CO_CANsend(CO_CANmodule_t *CANmodule, CO_CANtx_t *buffer)
 {
 	CO_ReturnError_t err = CO_ERROR_NO;
+#if CO_CAN_TX_LOOPBACK > 0
+	bool_t localOnly;
+
+	/* local receive buffers get the frame now, before it is queued */
+	CO_LOCK_CAN_SEND();
+	localOnly = CO_CANtxLoopback(CANmodule, buffer);
+	CO_UNLOCK_CAN_SEND();
+	if(localOnly)
+	{
+		return CO_ERROR_NO;
+	}
+	else
+	{
+		;/*do nothing*/
+	}
+#endif
 
 	/* Verify overflow */
 	if(buffer->bufferFull){
@@ -420,40 +3895,68 @@ CO_ReturnError_t CO_CANsend(CO_CANmodule_t *CANmodule, CO_CANtx_t *buffer)
 		}
 		err = CO_ERROR_TX_OVERFLOW;
 	}
+	CO_ITM_EVENT(CO_ITM_CAN_TX, ((buffer->ident >> 2) & 0x7FFFU) | ((err != CO_ERROR_NO) ? 0x8000U : 0U));
 
-	uint32_t TxMailboxNum;
-	/* if CAN TX buffer is free, send message */
 	CO_LOCK_CAN_SEND();
+	/* Put message into queue. If it is already there, only data was updated. */
+	if(!buffer->bufferFull)
+	{
+		buffer->bufferFull = true;
+#if CO_CAN_TX_LATENCY > 0
+		buffer->txQueued = DWT->CYCCNT;
+#endif
+		CO_CANtxPendingSet(CANmodule, buffer);
+		CANmodule->CANtxCount++;
+		CO_CAN_STAT_ADD(CANmodule, txQueued, 1U);
+#if CO_CAN_STATISTICS > 0
+		if(CANmodule->CANtxCount > CANmodule->stats.txQueueMax)
+		{
+			CANmodule->stats.txQueueMax = CANmodule->CANtxCount;
+		}
+#endif
+	}
+	else
+	{
+		;/*do nothing*/
+	}
+
+	/* Copy waiting messages into all free mailboxes, highest priority first.
+	 * If no mailbox is free, message will be sent from TX interrupt. */
+	if(!CO_CANtxFill(CANmodule))
+	{
+		err = CO_ERROR_HAL;
+	}
+	else
+	{
+		;/*do nothing*/
+	}
+	CO_UNLOCK_CAN_SEND();
 
-	prepareTxHeader(&TxHeader, buffer);
+	return err;
+}
 
-	if ((CANmodule->CANtxCount == 0) &&
-			(HAL_CAN_GetTxMailboxesFreeLevel(CANmodule->CANbaseAddress) > 0 )) {
-		CANmodule->bufferInhibitFlag = buffer->syncFlag;
 
-		if( HAL_CAN_AddTxMessage(CANmodule->CANbaseAddress,
-				&TxHeader,
-				&buffer->data[0],
-				&TxMailboxNum)
-				!= HAL_OK)
-		{
-			err = CO_ERROR_HAL;
-		}
-		else
-		{
-			;/*do nothing*/
-		}
+#if CO_CAN_TX_RESERVED > 0
+/******************************************************************************/
+CO_RAMFUNC CO_ReturnError_t CO_CANsendReserved(CO_CANmodule_t *CANmodule, const CO_CANtx_t *buffer)
+{
+	CAN_TypeDef *CANx = CANmodule->CANbaseAddress->Instance;
+
+	if((CANx->TSR & CAN_TSR_TME2) == 0U)
+	{
+		return CO_ERROR_TX_OVERFLOW;
 	}
-	/* if no buffer is free, message will be sent in the task */
 	else
 	{
-		buffer->bufferFull = true;
-		CANmodule->CANtxCount++;
+		;/*do nothing*/
 	}
-	CO_UNLOCK_CAN_SEND();
 
-	return err;
+	CO_CANtxWriteMailbox(CANx, 2U, buffer);
+	CANmodule->txMailbox[2] = buffer;
+
+	return CO_ERROR_NO;
 }
+#endif
 
 
 /******************************************************************************/
@@ -462,35 +3965,48 @@ void CO_CANclearPendingSyncPDOs(CO_CANmodule_t *CANmodule)
 	uint32_t tpdoDeleted = 0U;
 
 	CO_LOCK_CAN_SEND();
-	/* Abort message from CAN module, if there is synchronous TPDO.
-	 * Take special care with this functionality. */
-	/* TODO */
-
-	/*
-      if ((state = HAL_CAN_IsTxMessagePending(CANmodule->CANbaseAddress) && (CANmodule->bufferInhibitFlag))
-      {
-    	HAL_CAN_AbortTxRequest(CANmodule->);
-      }
-	 */
-
-	if(/*messageIsOnCanBuffer && */CANmodule->bufferInhibitFlag){
-		/* clear TXREQ */
+	/* Abort messages from CAN module, if there are synchronous TPDOs.
+	 * bufferInhibitFlag is cleared by any transmit complete interrupt, so
+	 * each mailbox is checked. */
+	{
+		uint32_t abort = 0U;
+		uint8_t m;
+
+		for(m = 0U; m < 3U; m++){
+			const CO_CANtx_t *buffer = CANmodule->txMailbox[m];
+
+			if((buffer != NULL) && buffer->syncFlag &&
+					(HAL_CAN_IsTxMessagePending(CANmodule->CANbaseAddress, CAN_TX_MAILBOX0 << m) != 0U)){
+				abort |= CAN_TX_MAILBOX0 << m;
+			}
+		}
+		if(abort != 0U){
+			/* mailboxes are released in abort interrupt */
+			(void)HAL_CAN_AbortTxRequest(CANmodule->CANbaseAddress, abort);
+			tpdoDeleted = 1U;
+		}
 		CANmodule->bufferInhibitFlag = false;
-		tpdoDeleted = 1U;
 	}
 	/* delete also pending synchronous TPDOs in TX buffers */
 	if(CANmodule->CANtxCount != 0U){
-		uint16_t i;
-		CO_CANtx_t *buffer = &CANmodule->txArray[0];
-		for(i = CANmodule->txSize; i > 0U; i--){
-			if(buffer->bufferFull){
-				if(buffer->syncFlag){
+		uint8_t w;
+		for(w = 0U; w < CO_CAN_TX_PENDING_WORDS; w++){
+			/* visit only waiting buffers */
+			uint32_t pending = CANmodule->txPending[w];
+			while(pending != 0U){
+				uint8_t bit = (uint8_t)__CLZ(pending);
+				uint8_t rank = (uint8_t)((w << 5) + bit);
+				CO_CANtx_t *buffer = &CANmodule->txArray[CANmodule->txByRank[rank]];
+
+				pending &= ~(0x80000000U >> bit);
+				if(buffer->bufferFull && buffer->syncFlag){
 					buffer->bufferFull = false;
+					CO_CANtxPendingClear(CANmodule, rank);
 					CANmodule->CANtxCount--;
+					CO_CAN_STAT_ADD(CANmodule, txAborted, 1U);
 					tpdoDeleted = 2U;
 				}
 			}
-			buffer++;
 		}
 	}
 	CO_UNLOCK_CAN_SEND();
@@ -504,18 +4020,60 @@ void CO_CANclearPendingSyncPDOs(CO_CANmodule_t *CANmodule)
 
 /******************************************************************************/
 void CO_CANverifyErrors(CO_CANmodule_t *CANmodule){
+#if CO_CAN_RX_STORM > 0
+	CO_CANrxStormProcess(CANmodule);
+#endif
+#if CO_CAN_ERROR_IRQ > 0
+	/* states are entered in HAL_CAN_ErrorCallback(), leaving them has no interrupt */
+	if(CANmodule->errFlags != 0U)
+	{
+		CO_LOCK_CAN_SEND();
+		CO_CANerrorUpdate(CANmodule, CANmodule->CANbaseAddress->Instance->ESR);
+		CO_UNLOCK_CAN_SEND();
+	}
+	else
+	{
+		;//do nothing
+	}
+#if CO_CAN_BUSOFF_RECOVERY > 0
+	CO_CANbusOffProcess(CANmodule, ((CANmodule->errFlags & CO_CAN_ERR_BUS_OFF) != 0U) ? true : false);
+#endif
+#else
 	CO_EM_t* em = (CO_EM_t*)CANmodule->em;
 	uint32_t HalCanErrorCode = CANmodule->CANbaseAddress->ErrorCode;
 
+#if CO_CAN_STATISTICS > 0
+	/* bus-off interrupt is not enabled, so count transitions of ESR BOFF */
+	bool_t busOff = ((CANmodule->CANbaseAddress->Instance->ESR & CAN_ESR_BOFF) != 0U) ? true : false;
+	if(busOff && !CANmodule->busOffOld)
+	{
+		CANmodule->stats.busOff++;
+	}
+	else
+	{
+		;//do nothing
+	}
+	CANmodule->busOffOld = busOff;
+#endif
+#if CO_CAN_BUSOFF_RECOVERY > 0
+	/* bus-off is reported and reset by the recovery state machine */
+	CO_CANbusOffProcess(CANmodule,
+			((CANmodule->CANbaseAddress->Instance->ESR & CAN_ESR_BOFF) != 0U) ? true : false);
+#endif
+
 	if(CANmodule->errOld != HalCanErrorCode)
 	{
 		CANmodule->errOld = HalCanErrorCode;
 		if(HalCanErrorCode & HAL_CAN_ERROR_BOF)
 		{                               /* bus off */
+#if CO_CAN_BUSOFF_RECOVERY == 0
 			CO_errorReport(em, CO_EM_CAN_TX_BUS_OFF, CO_EMC_BUS_OFF_RECOVERED, HalCanErrorCode);
+#endif
 		}
 		else{                                               /* not bus off */
+#if CO_CAN_BUSOFF_RECOVERY == 0
 			CO_errorReset(em, CO_EM_CAN_TX_BUS_OFF, HalCanErrorCode);
+#endif
 
 			if(HalCanErrorCode & HAL_CAN_ERROR_EWG)
 			{     											/* bus warning */
@@ -569,135 +4127,536 @@ void CO_CANverifyErrors(CO_CANmodule_t *CANmodule){
 			//do nothing
 		}
 	}
+#endif /* CO_CAN_ERROR_IRQ */
 }
 
-/*Interrupt handlers*/
+#if CO_CAN_STATISTICS > 0
 /******************************************************************************/
-void CO_CANinterrupt_Rx(const CO_CANmodule_t *CANmodule)
+void CO_CANgetStatistics(CO_CANmodule_t *CANmodule, CO_CANstatistics_t *stats)
 {
-	/* receive interrupt */
+	uint32_t ESR = CANmodule->CANbaseAddress->Instance->ESR;
 
-	static CO_CANrxMsg_t CANmessage;
-	bool_t msgMatched = false;
-	CO_CANrx_t *MsgBuff = CANmodule->rxArray; /* receive message buffer from CO_CANmodule_t object. */
-	HAL_CAN_GetRxMessage(CANmodule->CANbaseAddress, CAN_RX_FIFO0, &CANmessage.RxHeader, &CANmessage.data[0]);
+	CO_LOCK_CAN_SEND();
+	*stats = CANmodule->stats;
+	CO_UNLOCK_CAN_SEND();
 
-	/*dirty hack, consider change to a pointer here*/
-	CANmessage.DLC = (uint8_t)CANmessage.RxHeader.DLC;
-	CANmessage.ident = CANmessage.RxHeader.StdId;
+	stats->TEC = (uint8_t)((ESR & CAN_ESR_TEC) >> CAN_ESR_TEC_Pos);
+	stats->REC = (uint8_t)((ESR & CAN_ESR_REC) >> CAN_ESR_REC_Pos);
+}
 
-	uint32_t index;
-	/* Search rxArray form CANmodule for the same CAN-ID. */
-	for (index = 0; index < CANmodule->rxSize; index++)
+
+/******************************************************************************/
+void CO_CANresetStatistics(CO_CANmodule_t *CANmodule)
+{
+	CO_LOCK_CAN_SEND();
+	CANmodule->stats.rxFrames = 0U;
+	CANmodule->stats.rxUnmatched = 0U;
+	CANmodule->stats.rxOverruns = 0U;
+	CANmodule->stats.txQueued = 0U;
+	CANmodule->stats.txSent = 0U;
+	CANmodule->stats.txAborted = 0U;
+	CANmodule->stats.txQueueMax = 0U;
+	CANmodule->stats.busOff = 0U;
+#if CO_CAN_BRIDGE > 0
+	CANmodule->stats.rxForwarded = 0U;
+	CANmodule->stats.txForwardLost = 0U;
+#endif
+	CANmodule->stats.TEC = 0U;
+	CANmodule->stats.REC = 0U;
+	CO_UNLOCK_CAN_SEND();
+}
+#endif
+
+#if CO_CAN_TX_LATENCY > 0
+/******************************************************************************/
+bool_t CO_CANgetTxLatency(CO_CANmodule_t *CANmodule, uint16_t ident, CO_CANtxLatency_t *latency)
+{
+	uint16_t i;
+
+	for(i = 0U; i < CANmodule->txSize; i++)
 	{
-		uint16_t msg = (((uint16_t)(CANmessage.RxHeader.StdId << 2)) | (uint16_t)(CANmessage.RxHeader.RTR));
-		if (((msg ^ MsgBuff->ident) & MsgBuff->mask) == 0)
+		const CO_CANtx_t *buffer = &CANmodule->txArray[i];
+
+		/* standard identifier, RTR bit ignored */
+		if((buffer->ident >> 2) == (uint32_t)ident)
 		{
-			msgMatched = true;
-			break;
+			CO_LOCK_CAN_SEND();
+			*latency = buffer->latency;
+			CO_UNLOCK_CAN_SEND();
+			return true;
+		}
+		else
+		{
+			;//do nothing
 		}
-		MsgBuff++;
 	}
+	CO_CANtxLatencyClear(latency);
 
-	/* Call specific function, which will process the message */
-	if(msgMatched && (MsgBuff != NULL) && (MsgBuff->pFunct != NULL))
+	return false;
+}
+
+
+/******************************************************************************/
+void CO_CANresetTxLatency(CO_CANmodule_t *CANmodule)
+{
+	uint16_t i;
+
+	for(i = 0U; i < CANmodule->txSize; i++)
+	{
+		CO_LOCK_CAN_SEND();
+		CO_CANtxLatencyClear(&CANmodule->txArray[i].latency);
+		CO_UNLOCK_CAN_SEND();
+	}
+}
+#endif
+
+
+#if CO_CAN_TX_LOOPBACK > 0
+/******************************************************************************/
+CO_ReturnError_t CO_CANtxSetLocalOnly(CO_CANmodule_t *CANmodule, uint16_t ident, bool_t localOnly)
+{
+	uint16_t offset = (uint16_t)(ident - CO_CAN_LOOPBACK_FIRST);
+	uint32_t bit;
+
+	if((CANmodule == NULL) || (ident < CO_CAN_LOOPBACK_FIRST) || (offset >= (CO_CAN_LOOPBACK_WORDS * 32U)))
+	{
+		return CO_ERROR_ILLEGAL_ARGUMENT;
+	}
+	else
 	{
-		MsgBuff->pFunct(MsgBuff->object, &CANmessage);
-	}
-
-	//TODO filters handing
-
-	//        if(CANmodule->useCANrxFilters){
-	//            /* CAN module filters are used. Message with known 11-bit identifier has */
-	//           /* been received */
-	//            index = rcvMsg;  /* get index of the received message here. Or something similar */
-	//            if(index < CANmodule->rxSize){
-	//                buffer = &CANmodule->rxArray[index];
-	//                /* verify also RTR */
-	//                if(( RxHeader.RTR ) == CAN_RTR_DATA){
-	//                    msgMatched = true;
-	//                }
-	//                if((( RxHeader. rcvMsgIdent ^ buffer->ident) & buffer->mask) == 0U){
-	//                    msgMatched = true;
-	//                }
-	//            }
-	//        }
-	//        else{
-	//            /* CAN module filters are not used, message with any standard 11-bit identifier */
-	//            /* has been received. Search rxArray form CANmodule for the same CAN-ID. */
-	//            buffer = &CANmodule->rxArray[0];
-	//            for(index = CANmodule->rxSize; index > 0U; index--){
-	//                if(((rcvMsgIdent ^ buffer->ident) & buffer->mask) == 0U){
-	//                    msgMatched = true;
-	//                    break;
-	//                }
-	//                buffer++;
-	//            }
-	//        }
+		;//do nothing
+	}
 
-	/*CubeMx HAL is responsible for clearing interrupt flags and all the dirty work. */
+	bit = 1UL << (offset & 31U);
+	CO_LOCK_CAN_SEND();
+	if(localOnly)
+	{
+		CANmodule->txLocalOnly[offset >> 5] |= bit;
+	}
+	else
+	{
+		CANmodule->txLocalOnly[offset >> 5] &= ~bit;
+	}
+	CO_UNLOCK_CAN_SEND();
+
+	return CO_ERROR_NO;
 }
+#endif
+
+#if CO_CAN_BUSLOAD > 0
+/******************************************************************************/
+uint32_t CO_CANbusLoadBits(CO_CANmodule_t *CANmodule)
+{
+	uint32_t bits;
+
+	CO_LOCK_CAN_SEND();
+	bits = CANmodule->busLoadBits;
+	CANmodule->busLoadBits = 0U;
+	CO_UNLOCK_CAN_SEND();
 
+	return bits;
+}
+#endif
 
-void CO_CANpolling_Tx(CO_CANmodule_t *CANmodule)
+/*Interrupt handlers*/
+/******************************************************************************/
+CO_RAMFUNC void CO_CANinterrupt_Rx(CO_CANmodule_t *CANmodule, uint32_t fifo)
 {
-	if (HAL_CAN_GetTxMailboxesFreeLevel((CAN_HandleTypeDef*)CANmodule->CANbaseAddress) > 0)
+	/* receive interrupt */
+
+	CO_CANrxMsg_t CANmessage;
+	CO_PROFILE_BEGIN(profileStart);
+	CAN_TypeDef *CANx = CANmodule->CANbaseAddress->Instance;
+	volatile uint32_t *RFxR = (fifo == CAN_RX_FIFO1) ? &CANx->RF1R : &CANx->RF0R;
+#if CO_CAN_RX_DIRECT > 0
+	const CAN_FIFOMailBox_TypeDef *FIFOMailBox = &CANx->sFIFOMailBox[fifo];
+#endif
+
+	/* report FIFO overrun to CO_CANverifyErrors(), overrun interrupt is not
+	 * enabled, so HAL_CAN_IRQHandler does not handle it. With CO_CAN_ERROR_IRQ
+	 * it is reported here, if direct handler runs before HAL_CAN_IRQHandler. */
+	if((*RFxR & CAN_RF0R_FOVR0) != 0U)
 	{
-		/* First CAN message (bootup) was sent successfully */
-		CANmodule->firstCANtxMessage = false;
-		/* Clear flag from previous message */
-		CANmodule->bufferInhibitFlag = false;
-		/* Are there any new messages waiting to be send */
-		if(CANmodule->CANtxCount > 0U)
-		{
-			uint16_t i;             /* index of transmitting message */
+#if CO_CAN_ERROR_IRQ > 0
+		CO_errorReport((CO_EM_t*)CANmodule->em, CO_EM_CAN_RXB_OVERFLOW, CO_EMC_CAN_OVERRUN, fifo);
+#else
+		CANmodule->CANbaseAddress->ErrorCode |= (fifo == CAN_RX_FIFO1) ?
+				HAL_CAN_ERROR_RX_FOV1 : HAL_CAN_ERROR_RX_FOV0;
+#endif
+		*RFxR = CAN_RF0R_FOVR0;
+		CO_CAN_STAT_ADD(CANmodule, rxOverruns, 1U);
+	}
+	else
+	{
+		;//do nothing
+	}
 
-			/* first buffer */
-			CO_CANtx_t *buffer = &CANmodule->txArray[0];
-			/* search through whole array of pointers to transmit message buffers. */
-			for(i = CANmodule->txSize; i > 0U; i--)
-			{
-				/* if message buffer is full, send it. */
-				if(buffer->bufferFull)
-				{
+	/* Read all messages, which are waiting in the hardware FIFO. */
+#if CO_CAN_RX_DIRECT > 0
+	while((*RFxR & CAN_RF0R_FMP0) != 0U)
+#else
+	while(HAL_CAN_GetRxFifoFillLevel(CANmodule->CANbaseAddress, fifo) > 0U)
+#endif
+	{
+		uint32_t filterMatchIndex;
+		uint16_t msg;
 
-					/* Copy message to CAN buffer */
-					CANmodule->bufferInhibitFlag = buffer->syncFlag;
+#if CO_CAN_RX_DIRECT > 0
+		uint32_t RIR = FIFOMailBox->RIR;
+		uint32_t RDTR = FIFOMailBox->RDTR;
+		uint32_t RDLR = FIFOMailBox->RDLR;
+		uint32_t RDHR = FIFOMailBox->RDHR;
 
-					uint32_t TxMailboxNum;
+		/* release the output mailbox */
+		*RFxR = CAN_RF0R_RFOM0;
+		CO_CAN_STAT_ADD(CANmodule, rxFrames, 1U);
+#if CO_CAN_BUSLOAD > 0
+		CANmodule->busLoadBits += CO_CANframeBits(RIR, RDTR, RDLR, RDHR);
+#endif
+#if CO_CAN_RECORDER > 0
+		if(CANmodule->recorder != NULL)
+		{
+			CO_CANrecorder_put((CO_CANrecorder_t*)CANmodule->recorder, RIR, RDTR, RDLR, RDHR);
+		}
+		else
+		{
+			;//do nothing
+		}
+#endif
 
-					prepareTxHeader(&TxHeader, buffer);
-					if( HAL_CAN_AddTxMessage(CANmodule->CANbaseAddress,
-							&TxHeader,
-							&buffer->data[0],
-							&TxMailboxNum) != HAL_OK)
-					{
-						;//do nothing
-					}
-					else
-					{
-						buffer->bufferFull = false;
-						CANmodule->CANtxCount--;
-					}
+#if CO_CAN_EXT_ID == 0
+		if((RIR & CAN_RI0R_IDE) != 0U)
+		{
+			/* extended frames are not used by CANopen */
+			CO_CAN_STAT_ADD(CANmodule, rxUnmatched, 1U);
+			continue;
+		}
+		else
+		{
+			;//do nothing
+		}
+#endif
+#if CO_CAN_BRIDGE > 0
+		/* forward before local processing, frame of route filter goes nowhere else */
+		if(((RIR & CAN_RI0R_IDE) == 0U) && CO_CANbridgeRx(CANmodule, fifo, RIR, RDTR, RDLR, RDHR))
+		{
+			continue;
+		}
+		else
+		{
+			;//do nothing
+		}
+#endif
 
-					break;                      /* exit for loop */
-				}
-				else
-				{
-					/*do nothing*/;
-				}
-				buffer++;
-			}/* end of for loop */
+		CANmessage.ident = (RIR & CAN_RI0R_STID) >> CAN_RI0R_STID_Pos;
+		CANmessage.DLC = (uint8_t)(RDTR & CAN_RDT0R_DLC);
+		CANmessage.data[0] = (uint8_t)RDLR;
+		CANmessage.data[1] = (uint8_t)(RDLR >> 8);
+		CANmessage.data[2] = (uint8_t)(RDLR >> 16);
+		CANmessage.data[3] = (uint8_t)(RDLR >> 24);
+		CANmessage.data[4] = (uint8_t)RDHR;
+		CANmessage.data[5] = (uint8_t)(RDHR >> 8);
+		CANmessage.data[6] = (uint8_t)(RDHR >> 16);
+		CANmessage.data[7] = (uint8_t)(RDHR >> 24);
+		filterMatchIndex = (RDTR & CAN_RDT0R_FMI) >> CAN_RDT0R_FMI_Pos;
+#if CO_CAN_TIMESTAMP > 0
+		CANmessage.timestamp = (uint16_t)((RDTR & CAN_RDT0R_TIME) >> CAN_RDT0R_TIME_Pos);
+#endif
+#if CO_CAN_EXT_ID > 0
+		if((RIR & CAN_RI0R_IDE) != 0U)
+		{
+			/* CO_CANrxExt_t ident has the layout of RIR */
+			CANmessage.ident = RIR >> CAN_RI0R_EXID_Pos;
+			CO_CANinterrupt_RxExt(CANmodule, fifo, filterMatchIndex,
+					RIR & (CAN_RI0R_EXID | CAN_RI0R_STID | CAN_RI0R_IDE | CAN_RI0R_RTR), &CANmessage);
+			continue;
+		}
+		else
+		{
+			;//do nothing
+		}
+#endif
+		/* RTR bit has the same position as in CO_CANrx_t ident */
+		msg = (uint16_t)((CANmessage.ident << 2) | (RIR & CAN_RI0R_RTR));
+#else
+		if(HAL_CAN_GetRxMessage(CANmodule->CANbaseAddress, fifo, &CANmessage.RxHeader, &CANmessage.data[0]) != HAL_OK)
+		{
+			break;
+		}
+		else
+		{
+			CO_CAN_STAT_ADD(CANmodule, rxFrames, 1U);
+		}
+#if CO_CAN_BUSLOAD > 0
+		/* HAL IDE and RTR values are the same as RIR bits */
+		CANmodule->busLoadBits += CO_CANframeBits(
+				((CANmessage.RxHeader.IDE == CAN_ID_EXT) ?
+						(CANmessage.RxHeader.ExtId << CAN_RI0R_EXID_Pos) :
+						(CANmessage.RxHeader.StdId << CAN_RI0R_STID_Pos)) |
+						CANmessage.RxHeader.IDE | CANmessage.RxHeader.RTR,
+				CANmessage.RxHeader.DLC,
+				(uint32_t)CANmessage.data[0] | ((uint32_t)CANmessage.data[1] << 8) |
+						((uint32_t)CANmessage.data[2] << 16) | ((uint32_t)CANmessage.data[3] << 24),
+				(uint32_t)CANmessage.data[4] | ((uint32_t)CANmessage.data[5] << 8) |
+						((uint32_t)CANmessage.data[6] << 16) | ((uint32_t)CANmessage.data[7] << 24));
+#endif
+#if CO_CAN_RECORDER > 0
+		if(CANmodule->recorder != NULL)
+		{
+			/* HAL IDE and RTR values are the same as RIR bits */
+			CO_CANrecorder_put((CO_CANrecorder_t*)CANmodule->recorder,
+					((CANmessage.RxHeader.IDE == CAN_ID_EXT) ?
+							(CANmessage.RxHeader.ExtId << CAN_RI0R_EXID_Pos) :
+							(CANmessage.RxHeader.StdId << CAN_RI0R_STID_Pos)) |
+							CANmessage.RxHeader.IDE | CANmessage.RxHeader.RTR,
+					CANmessage.RxHeader.DLC | (CANmessage.RxHeader.Timestamp << CAN_RDT0R_TIME_Pos),
+					(uint32_t)CANmessage.data[0] | ((uint32_t)CANmessage.data[1] << 8) |
+							((uint32_t)CANmessage.data[2] << 16) | ((uint32_t)CANmessage.data[3] << 24),
+					(uint32_t)CANmessage.data[4] | ((uint32_t)CANmessage.data[5] << 8) |
+							((uint32_t)CANmessage.data[6] << 16) | ((uint32_t)CANmessage.data[7] << 24));
+		}
+		else
+		{
+			;//do nothing
+		}
+#endif
 
-			/* Clear counter if no more messages */
-			if(i == 0U)
+		/*dirty hack, consider change to a pointer here*/
+		CANmessage.DLC = (uint8_t)CANmessage.RxHeader.DLC;
+		CANmessage.ident = CANmessage.RxHeader.StdId;
+		filterMatchIndex = CANmessage.RxHeader.FilterMatchIndex;
+#if CO_CAN_TIMESTAMP > 0
+		CANmessage.timestamp = (uint16_t)CANmessage.RxHeader.Timestamp;
+#endif
+		if(CANmessage.RxHeader.IDE == CAN_ID_EXT)
+		{
+#if CO_CAN_EXT_ID > 0
+			/* HAL IDE and RTR values are the same as RIR bits */
+			CANmessage.ident = CANmessage.RxHeader.ExtId;
+			CO_CANinterrupt_RxExt(CANmodule, fifo, filterMatchIndex,
+					(CANmessage.RxHeader.ExtId << CAN_RI0R_EXID_Pos) | CAN_RI0R_IDE | CANmessage.RxHeader.RTR,
+					&CANmessage);
+#else
+			/* extended frames are not used by CANopen */
+			CO_CAN_STAT_ADD(CANmodule, rxUnmatched, 1U);
+#endif
+			continue;
+		}
+		else
+		{
+			;//do nothing
+		}
+		msg = (((uint16_t)(CANmessage.RxHeader.StdId << 2)) | (uint16_t)(CANmessage.RxHeader.RTR));
+#endif
+		CO_ITM_EVENT(CO_ITM_CAN_RX, msg >> 2);
+		CO_PROFILE_RX(msg >> 2);
+
+#if CO_CAN_RX_RING > 0
+		{
+			uint16_t head = CANmodule->rxRingHead;
+
+			if((uint16_t)(head - CANmodule->rxRingTail) < CO_CAN_RX_RING)
 			{
-				CANmodule->CANtxCount = 0U;
+				CO_CANrxRing_t *entry = &CANmodule->rxRing[head & (CO_CAN_RX_RING - 1U)];
+
+				entry->msg = CANmessage;
+				entry->ident = msg;
+				entry->fifo = (uint8_t)fifo;
+				entry->filterMatchIndex = (uint8_t)filterMatchIndex;
+				CO_MEMORY_BARRIER();
+				CANmodule->rxRingHead = head + 1U;
 			}
 			else
 			{
-				/*do nothing*/;
+				/* ring is full, frame is lost as with FIFO overrun */
+#if CO_CAN_ERROR_IRQ > 0
+				CO_errorReport((CO_EM_t*)CANmodule->em, CO_EM_CAN_RXB_OVERFLOW, CO_EMC_CAN_OVERRUN, fifo);
+#else
+				CANmodule->CANbaseAddress->ErrorCode |= (fifo == CAN_RX_FIFO1) ?
+						HAL_CAN_ERROR_RX_FOV1 : HAL_CAN_ERROR_RX_FOV0;
+#endif
+				CO_CAN_STAT_ADD(CANmodule, rxOverruns, 1U);
 			}
 		}
+#else
+		if(!CO_CANrxDispatch(CANmodule, fifo, filterMatchIndex, msg, &CANmessage))
+		{
+			continue;
+		}
+#endif
+#if CO_CAN_RX_CALLBACK > 0
+		if(CANmodule->pFunctRx != NULL)
+		{
+			CANmodule->pFunctRx(CANmodule->functRxObject, (uint16_t)(CANmessage.ident & 0x7FFU));
+		}
+#endif
+	}
+
+	/*CubeMx HAL is responsible for clearing interrupt flags and all the dirty work. */
+
+	CO_PROFILE_END(CO_PROFILE_CAN_RX, profileStart);
+}
+
+
+#if CO_CAN_RX_RING > 0
+/******************************************************************************/
+uint16_t CO_CANrxRingProcess(CO_CANmodule_t *CANmodule, uint16_t maxFrames)
+{
+	uint16_t tail = CANmodule->rxRingTail;
+	uint16_t count = 0U;
+
+	while((count < maxFrames) && (tail != CANmodule->rxRingHead))
+	{
+		const CO_CANrxRing_t *entry = &CANmodule->rxRing[tail & (CO_CAN_RX_RING - 1U)];
+
+		/* entry is complete, after head was read */
+		CO_MEMORY_BARRIER();
+		(void)CO_CANrxDispatch(CANmodule, entry->fifo, entry->filterMatchIndex,
+				entry->ident, &entry->msg);
+		CO_MEMORY_BARRIER();
+		tail++;
+		CANmodule->rxRingTail = tail;
+		count++;
+	}
+
+	return count;
+}
+#endif
+
+
+#if CO_CAN_RX_DIRECT > 0
+/******************************************************************************/
+CO_RAMFUNC bool_t CO_CANirqHandler_Rx(CAN_HandleTypeDef *hcan, uint32_t fifo)
+{
+	CO_CANmodule_t *CANmodule = CO_CANmoduleGet(hcan);
+
+	if(CANmodule != NULL)
+	{
+		CO_CANinterrupt_Rx(CANmodule, fifo);
+		return true;
+	}
+	else
+	{
+		/* not initialized yet, let HAL_CAN_IRQHandler handle interrupt */
+		return false;
+	}
+}
+#endif
+
+
+/******************************************************************************/
+CO_RAMFUNC void CO_CANinterrupt_Tx(CO_CANmodule_t *CANmodule)
+{
+	CO_LOCK_CAN_SEND();
+
+	/* First CAN message (bootup) was sent successfully */
+	CANmodule->firstCANtxMessage = false;
+	/* Clear flag from previous message */
+	CANmodule->bufferInhibitFlag = false;
+
+	/* Refill all free mailboxes with messages waiting to be send */
+	CO_CANtxFill(CANmodule);
+
+#if CO_CAN_TX_CALLBACK > 0
+	if(CANmodule->pFunctTx != NULL)
+	{
+		CANmodule->pFunctTx(CANmodule->functTxObject);
+	}
+#endif
+
+	CO_UNLOCK_CAN_SEND();
+}
+
+
+/******************************************************************************/
+void CO_CANpolling_Tx(CO_CANmodule_t *CANmodule)
+{
+	/* Messages are sent from the mailbox complete interrupt. Polling only
+	 * restarts transmission, if interrupt was missed. */
+	if (HAL_CAN_GetTxMailboxesFreeLevel((CAN_HandleTypeDef*)CANmodule->CANbaseAddress) > 0)
+	{
+		CO_CANinterrupt_Tx(CANmodule);
 	}
 }
+
+
+#if CO_EM_LOCK_FREE > 0
+/******************************************************************************/
+uint8_t CO_atomicFetchOr8(volatile uint8_t *p, uint8_t mask)
+{
+	uint8_t old;
+
+	do {
+		old = __LDREXB(p);
+	} while (__STREXB((uint8_t)(old | mask), p) != 0U);
+
+	return old;
+}
+
+
+/******************************************************************************/
+uint8_t CO_atomicFetchAnd8(volatile uint8_t *p, uint8_t mask)
+{
+	uint8_t old;
+
+	do {
+		old = __LDREXB(p);
+	} while (__STREXB((uint8_t)(old & mask), p) != 0U);
+
+	return old;
+}
+
+
+/******************************************************************************/
+uint8_t CO_atomicExchange8(volatile uint8_t *p, uint8_t value)
+{
+	uint8_t old;
+
+	do {
+		old = __LDREXB(p);
+	} while (__STREXB(value, p) != 0U);
+
+	return old;
+}
+
+
+/******************************************************************************/
+bool_t CO_atomicCompareExchange8(volatile uint8_t *p, uint8_t expected, uint8_t value)
+{
+	do {
+		if (__LDREXB(p) != expected)
+		{
+			__CLREX();
+			return false;
+		}
+	} while (__STREXB(value, p) != 0U);
+
+	return true;
+}
+
+
+/******************************************************************************/
+uint32_t CO_atomicFetchOr32(volatile uint32_t *p, uint32_t mask)
+{
+	uint32_t old;
+
+	do {
+		old = __LDREXW(p);
+	} while (__STREXW(old | mask, p) != 0U);
+
+	return old;
+}
+
+
+/******************************************************************************/
+uint32_t CO_atomicFetchAnd32(volatile uint32_t *p, uint32_t mask)
+{
+	uint32_t old;
+
+	do {
+		old = __LDREXW(p);
+	} while (__STREXW(old & mask, p) != 0U);
+
+	return old;
+}
+#endif
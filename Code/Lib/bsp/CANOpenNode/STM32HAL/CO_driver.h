@@ -136,10 +136,103 @@ extern "C" {
  * then sent by CAN TX interrupt as soon as CAN module is freed. Until message is
  * not copied to CAN module, its contents must not change. There may be multiple
  * _bufferFull_ flags in CO_CANtx_t array set to true. In that case messages with
- * lower index inside array will be sent first.
+ * lower CAN identifier will be sent first, all three bxCAN mailboxes are used
+ * (two with #CO_CAN_TX_RESERVED).
  */
 
 
+/**
+ * CMSIS-RTOS2 threads.
+ *
+ * If nonzero, timer and mainline thread are RTOS threads, created by
+ * task_rtosStart() in task.c, which wait for thread flags set from CAN receive
+ * interrupt (see CO_CAN_RX_CALLBACK). Critical sections then use BASEPRI at
+ * #CO_RTOS_SYSCALL_PRIORITY, the same as kernel critical sections of the
+ * Cortex-M port, so they also block thread switches.
+ */
+#ifndef CO_RTOS
+#define CO_RTOS                 0
+#endif
+
+/**
+ * Most urgent NVIC priority, from which RTOS functions may be called
+ * (configMAX_SYSCALL_INTERRUPT_PRIORITY >> (8 - __NVIC_PRIO_BITS) in FreeRTOS).
+ * All interrupts, which call CANopenNode functions, must run at this priority
+ * or lower with #CO_RTOS.
+ */
+#ifndef CO_RTOS_SYSCALL_PRIORITY
+#define CO_RTOS_SYSCALL_PRIORITY 5
+#endif
+
+#if CO_RTOS > 0
+#ifndef CO_LOCK_BASEPRI
+#define CO_LOCK_BASEPRI         1
+#endif
+#ifndef CO_LOCK_CAN_PRIORITY
+#define CO_LOCK_CAN_PRIORITY    CO_RTOS_SYSCALL_PRIORITY
+#endif
+#ifndef CO_LOCK_OD_PRIORITY
+#define CO_LOCK_OD_PRIORITY     CO_RTOS_SYSCALL_PRIORITY
+#endif
+#if (CO_LOCK_BASEPRI == 0) || (CO_LOCK_CAN_PRIORITY < CO_RTOS_SYSCALL_PRIORITY)
+#error CO_RTOS needs CO_LOCK_BASEPRI and CAN interrupts at CO_RTOS_SYSCALL_PRIORITY or lower
+#endif
+#endif
+
+
+/**
+ * Object Dictionary mirror for an application on another core, see
+ * CO_ODmirror.h.
+ *
+ * If nonzero, task.c keeps PDO mapped variables in a CO_ODmirrorShared_t,
+ * which is placed with #CO_OD_MIRROR_ATTR in memory seen by both cores at the
+ * same address (non-cacheable for a core with data cache). Stack and driver
+ * run alone on one core, application on the other core only reads RPDO and
+ * writes TPDO variables in the mirror. #CO_OD_MIRROR_SIGNAL() is the doorbell
+ * to the other core, for example on STM32H7 HAL_HSEM_FastTake() and
+ * HAL_HSEM_Release() of a semaphore with notification interrupt enabled on
+ * the receiving core. Without it, the other core polls the doorbell counters.
+ * #CO_OD_MIRROR_ENTRIES is the maximum number of mapped variables.
+ */
+#ifndef CO_OD_MIRROR
+#define CO_OD_MIRROR            0
+#endif
+#ifndef CO_OD_MIRROR_ENTRIES
+#define CO_OD_MIRROR_ENTRIES    64U
+#endif
+#ifndef CO_OD_MIRROR_ATTR
+#define CO_OD_MIRROR_ATTR
+#endif
+#ifndef CO_OD_MIRROR_SIGNAL
+#define CO_OD_MIRROR_SIGNAL(direction)
+#endif
+
+/**
+ * Critical sections with BASEPRI.
+ *
+ * If nonzero, CO_LOCK_xxx() macros mask only interrupts with priority of
+ * #CO_LOCK_CAN_PRIORITY or #CO_LOCK_OD_PRIORITY and lower, instead of all
+ * interrupts with PRIMASK.
+ */
+#ifndef CO_LOCK_BASEPRI
+#define CO_LOCK_BASEPRI         0
+#endif
+
+/** NVIC preemption priority of CAN1 TX/RX0/RX1 interrupts, see can.c */
+#ifndef CO_LOCK_CAN_PRIORITY
+#define CO_LOCK_CAN_PRIORITY    1
+#endif
+
+/**
+ * BASEPRI priority of OD lock. CAN receive interrupt writes OD variables of
+ * immediate RPDOs (also by RPDO handlers) and TPDO dirty flags, so OD lock must
+ * mask CAN interrupts too, default is #CO_LOCK_CAN_PRIORITY.
+ */
+#ifndef CO_LOCK_OD_PRIORITY
+#define CO_LOCK_OD_PRIORITY     CO_LOCK_CAN_PRIORITY
+#endif
+
+
 /**
  * @name Critical sections
  * CANopenNode is designed to run in different threads, as described in README.
@@ -172,9 +265,55 @@ extern "C" {
  * After presence of SYNC message on CANopen bus, CANrx should be temporary
  * disabled until all receive PDOs are processed. See also CO_SYNC.h file and
  * CO_SYNC_initCallback() function.
+ *
+ * ####STM32 mapping.
+ * CAN receive and transmit thread are CAN1/CAN2 interrupts (NVIC priority 1).
+ * Timer thread is TIM6 interrupt (priority 2) if TASK_REALTIME_ISR is set in
+ * task.h, otherwise it runs in mainline after CO_process(). Mainline is the
+ * main() loop. Sections are protected by masking all interrupts with PRIMASK,
+ * which blocks both timer and CAN threads. Macros may be nested, previous
+ * PRIMASK state is restored. Sections are short (copy of up to 8 bytes or
+ * one OD variable), so they do not add measurable latency to the PDO path.
+ *
+ * With #CO_LOCK_BASEPRI, each lock domain raises BASEPRI only to the priority
+ * of the interrupts, which share its resource: CAN send, EMCY and OD to CAN
+ * interrupt priority. OD lock must mask CAN interrupts, because immediate
+ * RPDOs are copied into OD variables in CAN receive interrupt, and it then
+ * masks the timer thread too. Interrupts with more urgent priority
+ * (numerically lower, e.g. 0 for SysTick or motor control) are never delayed
+ * by the stack, but they must not call any CANopenNode function.
+ *
+ * With #CO_RTOS, timer and mainline thread are RTOS threads and both lock
+ * domains are at #CO_RTOS_SYSCALL_PRIORITY. RTOS functions, which enter kernel
+ * critical section, clear BASEPRI on exit, so they must not be called inside
+ * CO_LOCK_xxx() sections.
  * @{
  */
 
+#define CO_LOCK_BASEPRI_VALUE(priority) ((uint32_t)(priority) << (8U - __NVIC_PRIO_BITS))
+
+#if CO_LOCK_BASEPRI > 0
+#if CO_LOCK_CAN_PRIORITY < 1 || CO_LOCK_OD_PRIORITY < 1 || CO_LOCK_OD_PRIORITY > CO_LOCK_CAN_PRIORITY
+#error CO_LOCK_CAN_PRIORITY and CO_LOCK_OD_PRIORITY must be 1 or more, OD lock must mask CAN interrupts
+#endif
+
+/* BASEPRI is only raised, so nested sections keep the most restrictive level */
+#define CO_LOCK_BASEPRI_ENTER(priority) {                                     \
+		uint32_t PrevBasepri = __get_BASEPRI();                               \
+		__set_BASEPRI_MAX(CO_LOCK_BASEPRI_VALUE(priority));
+
+#define CO_LOCK_BASEPRI_EXIT()      __set_BASEPRI(PrevBasepri);               \
+		}
+
+#define CO_LOCK_CAN_SEND()      CO_LOCK_BASEPRI_ENTER(CO_LOCK_CAN_PRIORITY)
+#define CO_UNLOCK_CAN_SEND()    CO_LOCK_BASEPRI_EXIT()
+
+#define CO_LOCK_EMCY()          CO_LOCK_BASEPRI_ENTER(CO_LOCK_CAN_PRIORITY)  /**< Lock critical section in CO_errorReport() or CO_errorReset() */
+#define CO_UNLOCK_EMCY()        CO_LOCK_BASEPRI_EXIT()                       /**< Unlock critical section in CO_errorReport() or CO_errorReset() */
+
+#define CO_LOCK_OD()            CO_LOCK_BASEPRI_ENTER(CO_LOCK_OD_PRIORITY)   /**< Lock critical section when accessing Object Dictionary */
+#define CO_UNLOCK_OD()          CO_LOCK_BASEPRI_EXIT()                       /**< Unlock critical section when accessing Object Dictionary */
+#else
 #define CO_LOCK_CAN_SEND()   { 							                  \
 		uint32_t PrevPrimask= __get_PRIMASK();   \
 		__disable_irq();
@@ -187,9 +326,34 @@ extern "C" {
 
 #define CO_LOCK_OD()            CO_LOCK_CAN_SEND()   /**< Lock critical section when accessing Object Dictionary */
 #define CO_UNLOCK_OD()          CO_UNLOCK_CAN_SEND() /**< Unlock critical section when accessing Object Dictionary */
+#endif
+
+/** Memory barrier between writing data and publishing it to other thread */
+#define CO_MEMORY_BARRIER()     __DMB()
+/** Atomic `*p |= mask` on volatile uint32_t, LDREX/STREX loop without lock */
+#define CO_ATOMIC_OR32(p, mask) {                                             \
+		uint32_t coAtomicValue;                                               \
+		do{                                                                   \
+			coAtomicValue = __LDREXW(p) | (uint32_t)(mask);                   \
+		}while(__STREXW(coAtomicValue, p) != 0U);                             \
+	}
 /** @} */
 
 
+/**
+ * Lock-free emergency buffer.
+ *
+ * If nonzero, CO_errorReport() and CO_errorReset() don't use CO_LOCK_EMCY().
+ * Error status bits are changed and slots in emergency buffer are reserved by
+ * LDREX/STREX loops (CO_atomicFetchOr8(), CO_atomicCompareExchange8()), so
+ * error reporting from CAN interrupt does not mask interrupts. Buffer has
+ * multiple producers and single consumer, CO_EM_process().
+ */
+#ifndef CO_EM_LOCK_FREE
+#define CO_EM_LOCK_FREE         0
+#endif
+
+
 /**
  * @defgroup CO_dataTypes Data types
  * @{
@@ -230,40 +394,1451 @@ typedef enum{
 
 
 /**
- * CAN receive message structure as aligned in CAN module. It is different in
- * different microcontrollers. It usually contains other variables.
+ * Number of bxCAN acceptance filter banks available to CANmodule.
+ *
+ * STM32L4 has 14 filter banks for CAN1 (SlaveStartFilterBank). Each bank in
+ * 16-bit scale holds four exact identifiers (list mode) or two identifier/mask
+ * pairs (mask mode). If registered receive buffers do not fit into banks,
+ * driver falls back to single accept-all filter and software search.
+ */
+#ifndef CO_CAN_FILTER_BANKS
+#define CO_CAN_FILTER_BANKS     14U
+#endif
+
+/**
+ * Number of CAN peripherals, which may be used by CO_CANmodule_t objects at
+ * the same time. Each peripheral (CAN1, CAN2) may own one CANmodule.
+ */
+#if defined(CAN2)
+#define CO_CAN_NO_MODULES       2U
+#else
+#define CO_CAN_NO_MODULES       1U
+#endif
+
+/** Number of filter match indexes (FMI), four per bank in 16-bit list mode. */
+#define CO_CAN_FILTER_NO_FMI    (CO_CAN_FILTER_BANKS * 4U)
+
+/**
+ * Extended (29-bit) CAN identifiers.
+ *
+ * If nonzero, CO_CANmodule_t contains CO_CAN_EXT_RX_SIZE receive buffers for
+ * extended frames, configured by CO_CANrxBufferInitExt(), and transmit buffers
+ * may be configured with extended identifier by CO_CANtxBufferInitExt(). Both
+ * are intended for application streams on mixed (J1939/CANopen) networks,
+ * CANopen objects keep standard identifiers. Extended receive buffers get 32-bit
+ * filter banks assigned to FIFO1 (two exact identifiers or one identifier/mask
+ * pair per bank) and are dispatched by filter match index.
+ */
+#ifndef CO_CAN_EXT_ID
+#define CO_CAN_EXT_ID           0
+#endif
+
+/** Number of receive buffers for extended frames, see CO_CAN_EXT_ID. */
+#ifndef CO_CAN_EXT_RX_SIZE
+#define CO_CAN_EXT_RX_SIZE      4U
+#endif
+
+/**
+ * Size of data field of CO_CANrxMsg_t and CO_CANtx_t in bytes.
+ *
+ * It limits the length of PDO data (CO_PDO_MAX_SIZE). Driver for CAN FD
+ * controller (FDCAN) may set it up to 64 bytes, DLC of the messages then holds
+ * number of data bytes, not the coded DLC. PDO frames, which do not match CAN FD
+ * data length (12, 16, 20, 24, 32, 48, 64), are padded by the driver. bxCAN
+ * transmits classic frames only, so this driver requires 8.
+ */
+#ifndef CO_CAN_DATA_SIZE
+#define CO_CAN_DATA_SIZE        8U
+#endif
+
+/** If nonzero, CAN FD frames longer than 8 bytes are sent with bit rate switch. */
+#ifndef CO_CAN_FD_BRS
+#define CO_CAN_FD_BRS           1
+#endif
+
+/**
+ * Lowest CAN identifier, which is received by FIFO1 if hardware filters are used.
+ *
+ * Default routes SDO (0x580..0x67F), heartbeat (0x700..0x77F) and LSS to
+ * FIFO1, NMT, SYNC, EMCY, TIME and PDOs to FIFO0. Set to 0x800 to receive
+ * all messages by FIFO0. With CO_CAN_EXT_ID default is 0x800, so all standard
+ * frames go to FIFO0 and FIFO1 receives only extended frames.
+ */
+#ifndef CO_CAN_RX_FIFO1_MIN_ID
+#if CO_CAN_EXT_ID > 0
+#define CO_CAN_RX_FIFO1_MIN_ID  0x800U
+#else
+#define CO_CAN_RX_FIFO1_MIN_ID  0x580U
+#endif
+#endif
+
+/** Value in CO_CANmodule_t::filterToRx for FMI without receive buffer. */
+#define CO_CAN_FILTER_UNUSED    0xFFU
+
+/**
+ * Direct COB-ID dispatch table for CO_CANinterrupt_Rx().
+ *
+ * If nonzero, CO_CANmodule_t contains 2048 bytes table, which maps 11-bit
+ * identifier of received data frame to the index of the first matching rxArray
+ * member. CO_CANrxBufferInit() updates only entries of the configured
+ * member, without a critical section. Reception time is then
+ * independent of number of receive buffers and of hardware filter
+ * availability. RTR frames and buffers with rxSize >= 255 use software search.
+ */
+#ifndef CO_CAN_RX_DISPATCH
+#define CO_CAN_RX_DISPATCH      0
+#endif
+
+/**
+ * Receive storm protection.
+ *
+ * If nonzero, each rxArray member has token bucket, which is filled with
+ * CO_CAN_RX_STORM_RATE frames per second up to CO_CAN_RX_STORM_BURST frames.
+ * Each frame dispatched to the member takes one token. If bucket is empty,
+ * member is blocked: its frames are dropped without calling its function,
+ * CO_CANverifyErrors() removes its hardware filter and reports
+ * CO_EM_CAN_RX_STORM with 11-bit identifier as info code. After
+ * CO_CAN_RX_STORM_HOLD_MS filter is restored with full bucket, emergency is
+ * reset, when no member is blocked. So a babbling node costs at most one
+ * burst of interrupts per hold time.
+ *
+ * Rate applies to the member, so a range or mask member (heartbeat
+ * consumers, LSS) shares one budget for all its identifiers. Without
+ * hardware filters (accept all) blocked frames still enter the FIFO, they
+ * are dropped right after the search or, with CO_CAN_RX_DISPATCH, after
+ * one table lookup.
+ */
+#ifndef CO_CAN_RX_STORM
+#define CO_CAN_RX_STORM         0
+#endif
+#ifndef CO_CAN_RX_STORM_RATE
+#define CO_CAN_RX_STORM_RATE    2000U
+#endif
+#ifndef CO_CAN_RX_STORM_BURST
+#define CO_CAN_RX_STORM_BURST   64U
+#endif
+#ifndef CO_CAN_RX_STORM_HOLD_MS
+#define CO_CAN_RX_STORM_HOLD_MS 1000U
+#endif
+
+
+/**
+ * Number of 32-bit words in the transmit pending set.
+ *
+ * Each transmit buffer owns one bit, ordered by CAN identifier, so the waiting
+ * message with the highest priority is found with CLZ instruction. txSize in
+ * CO_CANmodule_init() must not be larger than 32 * CO_CAN_TX_PENDING_WORDS.
+ */
+#ifndef CO_CAN_TX_PENDING_WORDS
+#define CO_CAN_TX_PENDING_WORDS 1U
+#endif
+
+
+/**
+ * SYNC producer driven by hardware timer.
+ *
+ * If nonzero, CO_SYNC_process() does not transmit SYNC. Application calls
+ * CO_SYNC_timerIsr() from a timer compare interrupt with the highest priority,
+ * which writes SYNC directly into the reserved transmit mailbox, see
+ * CO_CAN_TX_RESERVED. Jitter of the SYNC edge is then the interrupt latency
+ * plus arbitration of one frame already on the bus, instead of CO_process()
+ * period and the transmit queue.
+ */
+#ifndef CO_SYNC_HW_TIMER
+#define CO_SYNC_HW_TIMER        0
+#endif
+
+
+/**
+ * Heartbeat producer driven by hardware timer.
+ *
+ * If nonzero, CO_NMT_process() does not transmit periodic heartbeat.
+ * Application calls CO_NMT_HBtimerIsr() from a timer compare interrupt with
+ * the highest priority, which writes heartbeat directly into the reserved
+ * transmit mailbox, see CO_CAN_TX_RESERVED. Heartbeat period then does not
+ * depend on CO_process() period and the transmit queue. With
+ * #CO_SYNC_HW_TIMER both share the mailbox, so their compares must be offset
+ * by more than one frame.
+ */
+#ifndef CO_HB_HW_TIMER
+#define CO_HB_HW_TIMER          0
+#endif
+
+
+/**
+ * SYNC window closed by hardware timer.
+ *
+ * If nonzero, application arms a timer compare at each SYNC edge with
+ * _Synchronous window length_ (0x1007) and calls CO_SYNC_windowTimerIsr()
+ * on expiry. Synchronous TPDOs are then aborted with
+ * CO_CANclearPendingSyncPDOs() with timer accuracy, not when CO_SYNC_process()
+ * polls the window. Timer interrupt must not be interrupted by CAN interrupts,
+ * so #CO_LOCK_BASEPRI can not be used.
+ */
+#ifndef CO_SYNC_WINDOW_TIMER
+#define CO_SYNC_WINDOW_TIMER    0
+#endif
+
+#if (CO_SYNC_WINDOW_TIMER > 0) && (CO_LOCK_BASEPRI > 0)
+#error CO_SYNC_WINDOW_TIMER aborts from timer interrupt, which CO_LOCK_BASEPRI does not mask
+#endif
+
+
+/**
+ * Reserved transmit mailbox for critical frames.
+ *
+ * If nonzero, transmit buffers configured with #CO_CAN_TX_FLAG_CRITICAL in
+ * _syncFlag_ argument of CO_CANtxBufferInit() (SYNC, EMCY and heartbeat) are
+ * also transmitted from mailbox 2, which bulk frames never occupy. Critical
+ * frame then waits at most for one frame, which is already on the bus, even
+ * if mailboxes 0 and 1 hold low priority frames, which keep losing
+ * arbitration. With #CO_SYNC_HW_TIMER the mailbox is shared with
+ * CO_SYNC_timerIsr(), which reports overflow, if critical frame is still
+ * waiting there at SYNC time.
+ */
+#ifndef CO_CAN_TX_CRITICAL
+#define CO_CAN_TX_CRITICAL      0
+#endif
+
+/** Flag for _syncFlag_ argument of CO_CANtxBufferInit(), see #CO_CAN_TX_CRITICAL */
+#if CO_CAN_TX_CRITICAL > 0
+#define CO_CAN_TX_FLAG_CRITICAL 0x02U
+#else
+#define CO_CAN_TX_FLAG_CRITICAL 0U
+#endif
+
+
+/**
+ * Reserved transmit mailbox.
+ *
+ * If nonzero, transmit queue uses mailboxes 0 and 1 only. Mailbox 2 is free
+ * for CO_CANsendReserved() and critical frames, see #CO_CAN_TX_CRITICAL, so
+ * the frame written there waits only for arbitration. Requires
+ * CO_CAN_TX_DIRECT.
+ */
+#ifndef CO_CAN_TX_RESERVED
+#define CO_CAN_TX_RESERVED      ((CO_SYNC_HW_TIMER > 0) || (CO_HB_HW_TIMER > 0) || (CO_CAN_TX_CRITICAL > 0))
+#endif
+
+
+/**
+ * Direct register transmission.
+ *
+ * If nonzero, CO_CANsend() and CAN TX interrupt write transmit mailbox
+ * registers (TIR, TDTR, TDLR, TDHR) directly with images prepared in
+ * CO_CANtxBufferInit(), bypassing HAL_CAN_AddTxMessage() and its state checks.
+ * HAL is still used for initialization and interrupt handling.
+ */
+#ifndef CO_CAN_TX_DIRECT
+#define CO_CAN_TX_DIRECT        CO_CAN_TX_RESERVED
+#endif
+
+#if (CO_CAN_TX_RESERVED > 0) && (CO_CAN_TX_DIRECT == 0)
+#error CO_CAN_TX_RESERVED requires CO_CAN_TX_DIRECT
+#endif
+#if (CO_CAN_TX_CRITICAL > 0) && (CO_CAN_TX_RESERVED == 0)
+#error CO_CAN_TX_CRITICAL requires CO_CAN_TX_RESERVED
+#endif
+
+
+/**
+ * Direct register reception.
+ *
+ * If nonzero, CO_CANinterrupt_Rx() reads FIFO mailbox registers (RIR, RDTR,
+ * RDLR, RDHR) directly into lean CO_CANrxMsg_t without HAL receive header.
+ * CAN1_RX0_IRQHandler and CAN1_RX1_IRQHandler must call CO_CANirqHandler_Rx()
+ * before HAL_CAN_IRQHandler(). HAL is still used for initialization.
+ */
+#ifndef CO_CAN_RX_DIRECT
+#define CO_CAN_RX_DIRECT        0
+#endif
+
+
+/**
+ * Deferred reception through frame ring.
+ *
+ * If nonzero, CO_CANinterrupt_Rx() only copies standard frames from hardware
+ * FIFO into a single producer, single consumer ring with CO_CAN_RX_RING
+ * entries (power of two). Receive buffers are processed later in batches by
+ * CO_CANrxRingProcess(), called from the timer thread. Interrupt time is then
+ * short and constant, so back to back frames at 1 Mbit/s do not overrun the
+ * 3-frame hardware FIFO, even if higher priority interrupts delay it. Frame,
+ * which does not fit into full ring, is counted as FIFO overrun. Extended
+ * frames (#CO_CAN_EXT_ID) are still processed inside interrupt.
+ */
+#ifndef CO_CAN_RX_RING
+#define CO_CAN_RX_RING          0
+#endif
+
+
+/**
+ * Warm CAN reset.
+ *
+ * If nonzero, CO_CANmodule_disable() only deactivates CAN interrupts and
+ * aborts pending transmit mailboxes, peripheral stays on the bus. Next
+ * CO_CANmodule_init() then skips HAL_CAN_MspDeInit(), HAL_CAN_MspInit() and
+ * HAL_CAN_Init(), if the bit timing did not change, and only rebuilds filters
+ * and software buffers. NMT reset communication then takes microseconds
+ * instead of milliseconds. Changed bit rate (LSS) takes the full path.
+ */
+#ifndef CO_CAN_WARM_RESET
+#define CO_CAN_WARM_RESET       0
+#endif
+#if (CO_CAN_RX_RING & (CO_CAN_RX_RING - 1)) != 0
+#error CO_CAN_RX_RING must be power of two
+#endif
+
+
+/**
+ * CAN-to-CAN bridge.
+ *
+ * If nonzero, each CO_CANmodule_t holds CO_CAN_BRIDGE routes, configured by
+ * CO_CANbridgeRoute(). Route forwards received standard frames with
+ * identifier in ident/mask range to the other CANmodule, optionally with
+ * translated identifier. Routes get 16-bit mask filter banks in FIFO1 after
+ * the banks of the receive buffers. Frame with route FMI is copied from FIFO
+ * registers into the transmit queue of the target module inside receive
+ * interrupt and is not passed to any receive buffer. Frame, which matched a
+ * receive buffer filter (list mode and lower banks win in bxCAN), is received
+ * locally and forwarded by software match of the routes.
+ *
+ * Target queue holds CO_CAN_BRIDGE_QUEUE mailbox images (power of two).
+ * Forwarded frames get free mailboxes before CO_CANsend() buffers, bus
+ * arbitration then orders all mailboxes by identifier. Frame, which does not
+ * fit into full queue, is dropped and counted in CO_CANstatistics_t. Needs
+ * CO_CAN_RX_DIRECT and CO_CAN_TX_DIRECT.
+ */
+#ifndef CO_CAN_BRIDGE
+#define CO_CAN_BRIDGE           0
+#endif
+#ifndef CO_CAN_BRIDGE_QUEUE
+#define CO_CAN_BRIDGE_QUEUE     8U
+#endif
+#if (CO_CAN_BRIDGE > 0) && ((CO_CAN_RX_DIRECT == 0) || (CO_CAN_TX_DIRECT == 0))
+#error CO_CAN_BRIDGE needs CO_CAN_RX_DIRECT and CO_CAN_TX_DIRECT
+#endif
+#if (CO_CAN_BRIDGE_QUEUE & (CO_CAN_BRIDGE_QUEUE - 1)) != 0
+#error CO_CAN_BRIDGE_QUEUE must be power of two
+#endif
+
+
+/**
+ * Hardware receive timestamps.
+ *
+ * If nonzero, CAN peripheral runs in time triggered communication mode (TTCM)
+ * and each received message carries 16-bit value of the CAN bit time counter,
+ * captured at the sample point of SOF bit. Timestamp is kept by SYNC and RPDO
+ * objects, see CO_CANrxMsg_readTimestamp() and CO_CANtimestampDiff_us().
+ */
+#ifndef CO_CAN_TIMESTAMP
+#define CO_CAN_TIMESTAMP        0
+#endif
+
+
+/**
+ * Dirty flag driven TPDO change of state.
+ *
+ * If nonzero, CO_process_TPDO() verifies change of state only for TPDOs, which
+ * map an OD entry written by SDO or marked by CO_TPDOmarkDirty(). Application
+ * must call CO_TPDOmarkDirty() after it writes a TPDO mapped variable.
+ * TPDOs with OD index above 0x181F are always verified.
+ */
+#ifndef CO_TPDO_DIRTY_FLAGS
+#define CO_TPDO_DIRTY_FLAGS     0
+#endif
+
+
+/**
+ * Streaming TPDO groups.
+ *
+ * If nonzero, CO_TPDOstream.c is compiled. Stream sends samples from a producer
+ * ring buffer through a group of TPDOs, refilled from CAN transmit interrupt
+ * (see CO_CAN_TX_CALLBACK) instead of CO_process_TPDO() once per cycle.
+ */
+#ifndef CO_TPDO_STREAM
+#define CO_TPDO_STREAM          0
+#endif
+
+/**
+ * Transmit complete callback.
+ *
+ * If nonzero, function registered by CO_CANmodule_initTxCallback() is called
+ * from CAN transmit interrupt, after free mailboxes were refilled. Enabled by
+ * CO_TPDO_STREAM.
+ */
+#ifndef CO_CAN_TX_CALLBACK
+#define CO_CAN_TX_CALLBACK      CO_TPDO_STREAM
+#endif
+
+/**
+ * Receive callback.
+ *
+ * If nonzero, function registered by CO_CANmodule_initRxCallback() is called
+ * from CAN receive interrupt, after each standard frame was processed by its
+ * receive buffer. Enabled by CO_RTOS, where it wakes up the thread, which
+ * processes the message.
+ */
+#ifndef CO_CAN_RX_CALLBACK
+#define CO_CAN_RX_CALLBACK      CO_RTOS
+#endif
+
+
+/**
+ * Pre-staged synchronous TPDOs.
+ *
+ * If nonzero, synchronous TPDO, which was assembled with CO_TPDO_stage(), is
+ * sent by CO_TPDO_syncRelease() from SYNC callback, so it enters transmit
+ * queue at the SYNC edge instead of at the next CO_process_TPDO() call.
+ * SYNC callback runs in CAN receive interrupt. With #CO_SYNC_HW_TIMER it runs
+ * in timer interrupt, which is not masked by #CO_LOCK_BASEPRI locks.
+ */
+#ifndef CO_TPDO_PRESTAGE
+#define CO_TPDO_PRESTAGE        0
+#endif
+
+
+/**
+ * Automatic phase of cyclic synchronous TPDOs.
+ *
+ * If nonzero, TPDO with transmission type 2 to 240 and SYNCStartValue 0
+ * starts at SYNC offset node-ID + TPDO number modulo transmission type, see
+ * CO_PDO.h. TPDOs of the network with the same period are spread over its
+ * SYNC cycles, which flattens bus load per SYNC. With SYNC counter the offset
+ * is aligned to the counter, otherwise to the first SYNC after start.
+ */
+#ifndef CO_TPDO_SYNC_PHASE
+#define CO_TPDO_SYNC_PHASE      0
+#endif
+
+
+/**
+ * Sequence counters in RPDO receive buffers.
+ *
+ * If nonzero, CAN receive interrupt increments a sequence counter of the RPDO
+ * buffer before and after it writes the data. CO_RPDO_readData() returns a
+ * consistent snapshot without locks, CO_RPDO_process() copies the snapshot to
+ * Object Dictionary. With CO_RPDO_setDirect() the copy to Object Dictionary
+ * is skipped.
+ */
+#ifndef CO_RPDO_SEQLOCK
+#define CO_RPDO_SEQLOCK         0
+#endif
+
+#if (CO_TPDO_PRESTAGE > 0) && (CO_SYNC_HW_TIMER > 0) && (CO_LOCK_BASEPRI > 0)
+#error CO_TPDO_PRESTAGE sends from SYNC timer interrupt, which CO_LOCK_BASEPRI does not mask
+#endif
+
+
+/**
+ * Deadline calendar of event driven TPDOs.
+ *
+ * If nonzero, CO_process_TPDO() keeps event timer and inhibit time of TPDOs
+ * as absolute deadlines in a min-heap, see CO_TPDOcalendar_t. Only TPDOs,
+ * whose deadline expired, are processed, and heap top gives timerNext_us
+ * for the tickless scheduler. Timer work then does not grow with the number
+ * of TPDOs with long event timers.
+ */
+#ifndef CO_TPDO_CALENDAR
+#define CO_TPDO_CALENDAR        0
+#endif
+
+
+/**
+ * Multiplexed PDOs.
+ *
+ * If nonzero, PDO mapping with 0xFE (SAM-MPDO) or 0xFF (DAM-MPDO) mapped
+ * objects transfers one object per message with index and subindex in the
+ * message, see CO_PDO.h. SAM-MPDO uses object scanner list 0x1FA0 and object
+ * dispatching list 0x1FD0 from OD. Each RPDO has a receive queue of
+ * CO_PDO_MPDO_QUEUE messages.
+ */
+#ifndef CO_PDO_MPDO
+#define CO_PDO_MPDO             0
+#endif
+
+
+/**
+ * Shadow PDO mapping.
+ *
+ * If nonzero, mapping parameter of a valid PDO may be written by SDO or with
+ * CO_RPDO_stageMap() and CO_TPDO_stageMap(). New mapping is validated in a
+ * shadow and activated by the next CO_RPDO_process() or CO_TPDO_process(),
+ * PDO is not invalidated meanwhile, see CO_PDO.h.
+ */
+#ifndef CO_PDO_SHADOW_MAP
+#define CO_PDO_SHADOW_MAP       0
+#endif
+
+
+/**
+ * Adaptive inhibit time of event driven TPDOs.
+ *
+ * If nonzero, inhibit time from OD is multiplied by scale from
+ * CO_TPDO_setInhibitScale(). With #CO_CAN_BUSLOAD, CO_CANbusLoad_process()
+ * calculates the scale from measured bus load and transmit queue depth:
+ * above CO_TPDO_ADAPTIVE_LOAD_HIGH per mille or with more than
+ * CO_TPDO_ADAPTIVE_QUEUE waiting frames the scale is doubled, up to
+ * CO_TPDO_ADAPTIVE_MAX times the OD value, below CO_TPDO_ADAPTIVE_LOAD_LOW
+ * it is relaxed by one quarter per sub-window back to the OD value.
+ * TPDOs with zero inhibit time are not affected.
+ */
+#ifndef CO_TPDO_ADAPTIVE_INHIBIT
+#define CO_TPDO_ADAPTIVE_INHIBIT 0
+#endif
+#ifndef CO_TPDO_ADAPTIVE_LOAD_HIGH
+#define CO_TPDO_ADAPTIVE_LOAD_HIGH 700U
+#endif
+#ifndef CO_TPDO_ADAPTIVE_LOAD_LOW
+#define CO_TPDO_ADAPTIVE_LOAD_LOW 500U
+#endif
+#ifndef CO_TPDO_ADAPTIVE_QUEUE
+#define CO_TPDO_ADAPTIVE_QUEUE  4U
+#endif
+#ifndef CO_TPDO_ADAPTIVE_MAX
+#define CO_TPDO_ADAPTIVE_MAX    8U
+#endif
+
+
+/**
+ * Typed RPDO application handlers.
+ *
+ * If nonzero, CO_RPDO_initHandler() attaches a handler to RPDO, which is
+ * called with the list of mapped fields each time the PDO is accepted, see
+ * CO_RPDOfield_t. Application then does not poll mapped OD variables.
+ */
+#ifndef CO_RPDO_HANDLERS
+#define CO_RPDO_HANDLERS        0
+#endif
+
+
+/**
+ * Hashed Object Dictionary lookup.
+ *
+ * If nonzero, CO_SDO_init() builds hash table with 2^CO_OD_HASH_BITS entries,
+ * which resolves OD index to entry number for CO_OD_find() in constant time.
+ * Order of indexes in OD is then not important. Table should have at least
+ * twice as many entries as the OD (CO_OD_NoOfElements), maximum is 15.
+ */
+#ifndef CO_OD_HASH_BITS
+#define CO_OD_HASH_BITS         0
+#endif
+
+
+/**
+ * Expedited SDO fast path.
+ *
+ * If nonzero, CO_SDO_process() serves expedited upload and download of OD
+ * variables with 1 to 4 bytes and without OD extension function directly
+ * between the CAN frame and the variable. ODF_arg and data buffer are not
+ * prepared, and no buffer is leased from the pool (#CO_SDO_BUFFER_POOL).
+ * Other requests and all errors take the normal path.
+ */
+#ifndef CO_SDO_FAST_EXPEDITED
+#define CO_SDO_FAST_EXPEDITED   0
+#endif
+
+
+/**
+ * SDO buffer size.
+ *
+ * Overrides default of CO_SDO.h. 889 bytes hold one full SDO block of 127
+ * segments, so block download and upload run with maximum blksize, see
+ * #CO_SDO_BLOCK_SIZE. Smaller buffer saves RAM and limits blksize to the
+ * number of segments, which fit into it.
+ */
+#ifndef CO_SDO_BUFFER_SIZE
+#define CO_SDO_BUFFER_SIZE      889
+#endif
+
+
+/**
+ * Deferred completion of SDO Object dictionary functions.
+ *
+ * Overrides default of CO_SDO.h. _Store parameters_ and _Restore default
+ * parameters_ of CO_eeprom.c then confirm the SDO write only after the data
+ * are written to eeprom or flash, so power loss after the response does not
+ * lose them.
+ */
+#ifndef CO_SDO_ODF_PENDING
+#define CO_SDO_ODF_PENDING      1
+#endif
+
+
+/**
+ * Concise DCF.
+ *
+ * If nonzero, CO_DCF.c is compiled. Server writes all entries of a Concise
+ * DCF, downloaded into 0x1F22 with one SDO block transfer, through the OD
+ * write path. Master builds the DCF for the SDO client queue.
+ */
+#ifndef CO_DCF
+#define CO_DCF                  0
+#endif
+
+
+/**
+ * Store EDS.
+ *
+ * If nonzero, CO_EDS.c is compiled. Device description is linked into flash
+ * as compressed image (tools/edszip.py) and read from 0x1021 with one SDO
+ * block upload, decompressed on the fly.
+ */
+#ifndef CO_EDS_STORE
+#define CO_EDS_STORE            0
+#endif
+
+
+/**
+ * TIME object, see CO_TIME.h, objects are set by CO_NO_TIME in CO_OD.h.
+ *
+ * - CO_TIME_HIGH_RES: if nonzero, producer sends 8 bytes: TIME_OF_DAY and
+ *   UNSIGNED16 with microseconds of the millisecond and flag for time of the
+ *   last SYNC. Consumer accepts 6 and 8 bytes anyway. Set to 0, if other
+ *   consumers accept only standard length 6.
+ * - CO_TIME_PRODUCER_MS: interval of TIME messages from producer.
+ */
+#ifndef CO_TIME_HIGH_RES
+#define CO_TIME_HIGH_RES        1
+#endif
+#ifndef CO_TIME_PRODUCER_MS
+#define CO_TIME_PRODUCER_MS     1000U
+#endif
+
+
+/**
+ * Compile time pruning of unused services.
+ *
+ * Product profile sets the services, which are not part of the device. Pruned
+ * service has no object, no CAN receive or transmit buffer and is not
+ * initialized or processed by CANopen.c, so its code is dropped by the linker
+ * (--gc-sections). Objects in CO_OD.h stay as plain variables.
+ *
+ * - CO_PRUNE_SYNC: no SYNC producer and consumer, CO->SYNC is NULL. Synchronous
+ *   RPDOs are then accepted on reception, synchronous TPDOs are not sent. Same
+ *   as CO_NO_SYNC 0 in CO_OD.h.
+ * - CO_PRUNE_HB_CONS: no Heartbeat consumer, CO->HBcons is NULL. Same as
+ *   empty array 0x1016 in CO_OD.h.
+ * - CO_PRUNE_SDO_SERVER: no SDO server on CAN, for locked down products.
+ *   CO->SDO[0] still holds Object Dictionary for the application and
+ *   other objects, but is never processed.
+ */
+#ifndef CO_PRUNE_SYNC
+#define CO_PRUNE_SYNC           0
+#endif
+#ifndef CO_PRUNE_HB_CONS
+#define CO_PRUNE_HB_CONS        0
+#endif
+#ifndef CO_PRUNE_SDO_SERVER
+#define CO_PRUNE_SDO_SERVER     0
+#endif
+
+
+/**
+ * Flat table of Object Dictionary subindex descriptors.
+ *
+ * If nonzero, CO_SDO_init() resolves data pointer, length, attribute and flags
+ * pointer of each subindex into a table with CO_OD_FLAT_SIZE members (12 bytes
+ * each), so CO_OD_getLength() and similar are a single array read. Size must
+ * be at least the sum of (maxSubIndex + 1) over all OD entries, otherwise the
+ * table is not used.
+ */
+#ifndef CO_OD_FLAT_SIZE
+#define CO_OD_FLAT_SIZE         0
+#endif
+
+
+/**
+ * Inline byte order helpers.
+ *
+ * If nonzero, CO_memcpy(), CO_getUint16(), CO_getUint32(), CO_setUint16(),
+ * CO_setUint32() and CO_memcpySwap2/4/8() are static inline functions in
+ * CO_SDO.h. Cortex-M4 is little endian and supports unaligned word access, so
+ * they become single load and store instructions instead of byte loops.
+ */
+#ifndef CO_INLINE_HELPERS
+#define CO_INLINE_HELPERS       1
+#endif
+
+
+/**
+ * Keep PDO mapping over communication reset.
+ *
+ * If nonzero, each RPDO and TPDO keeps CRC32 of its mapping parameter from the
+ * last successful CO_RPDOconfigMap() or CO_TPDOconfigMap(). If mapping is
+ * unchanged on next CO_init(), copy descriptors are reused and Object
+ * Dictionary is not searched again. PDO objects must persist between
+ * CO_init() calls (CO_USE_GLOBALS or single calloc).
+ */
+#ifndef CO_PDO_FAST_BOOT
+#define CO_PDO_FAST_BOOT        0
+#endif
+
+
+/**
+ * Heartbeat consumer with timer wheel.
+ *
+ * If nonzero, CO_HBconsumer_process() does not scan all monitored nodes. Each
+ * node is kept in a timer wheel slot of its heartbeat deadline. Reception only
+ * stores time stamp, node is rescheduled, when its old deadline is reached.
+ * NMT state changes are passed from reception through event queue. Work per
+ * call is proportional to expired deadlines and state changes.
+ */
+#ifndef CO_HB_TIMER_WHEEL
+#define CO_HB_TIMER_WHEEL       0
+#endif
+
+
+/**
+ * Heartbeat consumer with one receive buffer.
+ *
+ * If nonzero, heartbeats of all node IDs are received by one CO_CANrx_t
+ * (CO_CANrxBufferInitRange()) with one mask filter, instead of one buffer and
+ * one filter per monitored node. Node ID selects monitored node through a
+ * table of 128 bytes. Heartbeats of nodes, which are not monitored, pass the
+ * hardware filter and are dropped in the receive interrupt.
+ */
+#ifndef CO_HB_CONS_RANGE
+#define CO_HB_CONS_RANGE        0
+#endif
+
+
+/**
+ * Emergency messages ordered by priority.
+ *
+ * If nonzero, CO_EM_process() moves reported emergencies from internal buffer
+ * into pending list, which is sent by priority (CO_EM_PRIORITY()), older
+ * first within the same priority. Repeated report or reset of the same error
+ * status bit updates pending message instead of adding new one. Inhibit time
+ * is respected as before.
+ */
+#ifndef CO_EM_PRIORITY_QUEUE
+#define CO_EM_PRIORITY_QUEUE    0
+#endif
+
+
+/**
+ * Error status bits as word-wide bitset.
+ *
+ * If nonzero, CO_errorReport(), CO_errorReset() and CO_isError() work on
+ * 32-bit words of CO_EM_t (CO_EM_STATUS_WORDS), with CO_EM_LOCK_FREE by
+ * CO_atomicFetchOr32() and CO_atomicFetchAnd32(). CO_EM_process() derives
+ * the error register from two masked words (CO_EM_REG_xxx_MASK) and copies
+ * the bitset into Object Dictionary array 0x2100 only when it has changed.
+ */
+#ifndef CO_EM_BITSET
+#define CO_EM_BITSET            0
+#endif
+
+
+/**
+ * Cycle counter instrumentation of the hot paths.
+ *
+ * If nonzero, CO_CANinterrupt_Rx(), CO_process(), CO_process_SYNC_RPDO(),
+ * CO_process_TPDO() and task_oneMs() are measured with DWT cycle counter.
+ * Count, min, max and average cycles of each #CO_profileStage_t are
+ * collected by CO_profile.c and are readable over SDO, see CO_profile_init().
+ */
+#ifndef CO_PROFILE
+#define CO_PROFILE              0
+#endif
+
+/**
+ * Worst case execution time capture, needs CO_PROFILE.
+ *
+ * If nonzero, each new maximum of a stage is stored with a snapshot of the
+ * context, which caused it: CAN-ID of the last received frame, frames
+ * received and TPDOs sent during the stage, SDO server state and HAL tick.
+ * CO_PROFILE_BEGIN() then also takes the counters of CO_profileContext.
+ * Readable and resettable over SDO, see CO_profile_init().
+ */
+#ifndef CO_PROFILE_WCET
+#define CO_PROFILE_WCET         0
+#endif
+
+/**
+ * Measured stages, see CO_PROFILE.
+ */
+typedef enum{
+	CO_PROFILE_CAN_RX           = 0,    /**< CO_CANinterrupt_Rx(), one call per FIFO interrupt */
+	CO_PROFILE_PROCESS          = 1,    /**< CO_process() */
+	CO_PROFILE_SYNC_RPDO        = 2,    /**< CO_process_SYNC_RPDO() */
+	CO_PROFILE_TPDO             = 3,    /**< CO_process_TPDO() */
+	CO_PROFILE_ONE_MS           = 4,    /**< task_oneMs() without communication reset */
+	CO_PROFILE_STAGES           = 5     /**< Number of stages */
+}CO_profileStage_t;
+
+#if CO_PROFILE > 0
+void CO_profile_record(CO_profileStage_t stage, uint32_t cycles);
+#if CO_PROFILE_WCET > 0
+/**
+ * Counters for context of worst case, each written from one execution context.
+ */
+typedef struct{
+	volatile uint16_t   rxIdent;        /**< CAN-ID of the last received standard frame */
+	volatile uint16_t   rxFrames;       /**< Received standard frames, free running */
+	volatile uint16_t   tpdoSent;       /**< CO_TPDOsend() calls, free running */
+}CO_profileContext_t;
+
+/**
+ * Start of measured stage for CO_PROFILE_WCET.
+ */
+typedef struct{
+	uint32_t            cycles;         /**< DWT->CYCCNT */
+	uint16_t            rxFrames;       /**< CO_profileContext.rxFrames */
+	uint16_t            tpdoSent;       /**< CO_profileContext.tpdoSent */
+}CO_profileMark_t;
+
+extern CO_profileContext_t CO_profileContext;
+void CO_profile_recordWcet(CO_profileStage_t stage, const CO_profileMark_t *start);
+/** Start of measured stage, must be the last declaration in the block */
+#define CO_PROFILE_BEGIN(start)         const CO_profileMark_t start = {DWT->CYCCNT, \
+		CO_profileContext.rxFrames, CO_profileContext.tpdoSent}
+/** End of measured stage */
+#define CO_PROFILE_END(stage, start)    CO_profile_recordWcet(stage, &(start))
+/** Standard frame received, called from CAN receive interrupt */
+#define CO_PROFILE_RX(ident)            do{CO_profileContext.rxIdent = (uint16_t)(ident); \
+		CO_profileContext.rxFrames++;}while(0)
+/** TPDO is sent */
+#define CO_PROFILE_TPDO_SENT()          CO_profileContext.tpdoSent++
+#else
+/** Start of measured stage, must be the last declaration in the block */
+#define CO_PROFILE_BEGIN(start)         const uint32_t start = DWT->CYCCNT
+/** End of measured stage */
+#define CO_PROFILE_END(stage, start)    CO_profile_record(stage, DWT->CYCCNT - (start))
+#define CO_PROFILE_RX(ident)
+#define CO_PROFILE_TPDO_SENT()
+#endif
+#else
+#define CO_PROFILE_BEGIN(start)
+#define CO_PROFILE_END(stage, start)
+#define CO_PROFILE_RX(ident)
+#define CO_PROFILE_TPDO_SENT()
+#endif
+
+
+/**
+ * Statistical PC sampling profiler.
+ *
+ * If nonzero, high priority timer interrupt (TIM16, TASK_PC_SAMPLE_HZ) takes
+ * the stacked program counter of the interrupted code into a histogram of
+ * CO_PROFILE_PC_BUCKETS buckets of (1 << CO_PROFILE_PC_BUCKET_SHIFT) bytes
+ * from FLASH_BASE. Histogram is started, stopped and uploaded over SDO, see
+ * CO_profilePC_init().
+ */
+#ifndef CO_PROFILE_PC
+#define CO_PROFILE_PC           0
+#endif
+#ifndef CO_PROFILE_PC_BUCKET_SHIFT
+#define CO_PROFILE_PC_BUCKET_SHIFT  9U
+#endif
+#ifndef CO_PROFILE_PC_BUCKETS
+#define CO_PROFILE_PC_BUCKETS   256U
+#endif
+
+
+/**
+ * ITM event tracing of the stack.
+ *
+ * If nonzero, each #CO_ITMevent_t writes one 16 bit value into ITM
+ * stimulus port CO_ITM_PORT + event, so SWO viewer shows a timeline of stack
+ * activity with the port as event type. One event is 3 bytes on SWO.
+ * Ports are enabled by debugger (ITM TER), disabled ports cost one register
+ * read. Event is dropped, if stimulus FIFO is full, stack never waits for SWO.
+ * If zero, events compile to nothing. tools/itmtrace.py prints the timeline
+ * from a raw SWO capture.
+ */
+#ifndef CO_ITM_TRACE
+#define CO_ITM_TRACE            0
+#endif
+/** First ITM stimulus port of stack events, ports 0...7 are left to printf */
+#ifndef CO_ITM_PORT
+#define CO_ITM_PORT             8U
+#endif
+
+/**
+ * Traced events, see CO_ITM_TRACE. Value of each event is described here.
+ */
+typedef enum{
+	CO_ITM_CAN_RX               = 0,    /**< CO_CANinterrupt_Rx(), 16 bit: CAN-ID of received standard frame */
+	CO_ITM_CAN_TX               = 1,    /**< CO_CANsend(), 16 bit: CAN-ID, bit 15 set on TX overflow */
+	CO_ITM_SYNC                 = 2,    /**< CO_SYNC_process(), 16 bit: return value (1 SYNC, 2 window end) << 8 | SYNC counter */
+	CO_ITM_RPDO                 = 3,    /**< CO_RPDO_process(), 16 bit: CAN-ID of RPDO written into OD */
+	CO_ITM_TPDO                 = 4,    /**< CO_TPDOsend(), 16 bit: CAN-ID of TPDO */
+	CO_ITM_SDO                  = 5,    /**< CO_SDO_process(), 16 bit: new #CO_SDO_state_t << 8 | command byte of processed request or 0xFF */
+	CO_ITM_EVENTS               = 6     /**< Number of events */
+}CO_ITMevent_t;
+
+#if CO_ITM_TRACE > 0
+/** Write event into its stimulus port, if port is enabled and its FIFO has space */
+#define CO_ITM_EVENT(event, value)                                            \
+		do{                                                                   \
+			const uint32_t itmPort = CO_ITM_PORT + (uint32_t)(event);         \
+			if(((ITM->TER & (1UL << itmPort)) != 0U) &&                       \
+					(ITM->PORT[itmPort].u32 != 0U))                           \
+			{                                                                 \
+				ITM->PORT[itmPort].u16 = (uint16_t)(value);                   \
+			}                                                                 \
+		}while(0)
+#else
+#define CO_ITM_EVENT(event, value)
+#endif
+
+
+/**
+ * Micro-benchmark of the stack hot paths.
+ *
+ * If nonzero, CO_bench_run() from CO_bench.c measures OD search, PDO, SDO and
+ * CRC functions with synthetic messages. Time is DWT cycle count here and
+ * nanoseconds in socketCAN host build, see CO_BENCH_TIME_UNIT.
+ */
+#ifndef CO_BENCH
+#define CO_BENCH                0
+#endif
+
+#if CO_BENCH > 0
+/** Enable time stamp source of CO_BENCH_TIME() */
+#define CO_BENCH_TIME_INIT()    do{ CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk; \
+                                    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk; }while(0)
+/** Time stamp for CO_bench.c */
+#define CO_BENCH_TIME()         (DWT->CYCCNT)
+/** Unit of CO_BENCH_TIME() */
+#define CO_BENCH_TIME_UNIT      "cycles"
+#endif
+
+
+/**
+ * CAN bus and driver statistics.
+ *
+ * If nonzero, CAN module counts received, unmatched and overrun frames,
+ * queued, sent and aborted transmit buffers and bus-off events in
+ * #CO_CANstatistics_t. Values are read with CO_CANgetStatistics() and are
+ * readable over SDO, see CO_CANstat_init().
+ */
+#ifndef CO_CAN_STATISTICS
+#define CO_CAN_STATISTICS       0
+#endif
+
+
+/**
+ * Transmit latency per transmit buffer.
+ *
+ * If nonzero, CO_CANsend() stores DWT cycle counter, when it queues a
+ * transmit buffer, and transmit complete interrupt adds the time from queueing
+ * to the end of transmission to #CO_CANtxLatency_t of the buffer. Time
+ * includes waiting in the software queue, in the mailbox for arbitration and
+ * the frame itself. Frames aborted in mailbox and frames sent with
+ * CO_CANsendReserved() are not counted.
+ *
+ * Histogram bin 0 counts latencies below CO_CAN_TX_LATENCY_BIN_US, each next
+ * bin doubles the limit, the last one takes the rest. Values are read with
+ * CO_CANgetTxLatency() and are readable over SDO, see CO_CANtxLatency_init().
+ */
+#ifndef CO_CAN_TX_LATENCY
+#define CO_CAN_TX_LATENCY       0
+#endif
+#ifndef CO_CAN_TX_LATENCY_BINS
+#define CO_CAN_TX_LATENCY_BINS  8U
+#endif
+#ifndef CO_CAN_TX_LATENCY_BIN_US
+#define CO_CAN_TX_LATENCY_BIN_US 125U
+#endif
+
+
+/**
+ * Local loopback of PDOs.
+ *
+ * If nonzero, CO_CANsend() passes a standard data frame in the PDO range
+ * (0x180 to 0x57F), which has a receive buffer in the same CANmodule, to that
+ * buffer through CO_CANrxDispatch(), as if it was received. This connects
+ * TPDOs and RPDOs of CANopen devices sharing the module (see
+ * CO_CANmodule_setRxSlice()) or of a self-test setup without waiting for the
+ * bus. Receive function is called inside CO_LOCK_CAN_SEND(), so it does not
+ * overlap with CAN receive interrupt. Frame is transmitted too, unless its
+ * identifier was set with CO_CANtxSetLocalOnly(). Frames of the local
+ * identifiers never occupy mailboxes and bus bandwidth. Looped back frames
+ * have timestamp 0 with #CO_CAN_TIMESTAMP.
+ */
+#ifndef CO_CAN_TX_LOOPBACK
+#define CO_CAN_TX_LOOPBACK      0
+#endif
+
+/** First identifier of the loopback range */
+#define CO_CAN_LOOPBACK_FIRST   0x180U
+/** Words of local only bitmap, one bit per identifier 0x180 to 0x57F */
+#define CO_CAN_LOOPBACK_WORDS   (0x400U / 32U)
+
+
+/**
+ * Bus load measurement.
+ *
+ * If CO_CAN_BUSLOAD is nonzero, CAN module sums length in bits of all
+ * received and successfully transmitted frames, including fixed fields, CRC,
+ * ACK, EOF and intermission. CO_CANbusLoad_process() in CO_CANstat.c divides
+ * it by the bit rate over a sliding window of CO_CAN_BUSLOAD_SUBWINDOWS
+ * sub-windows of CO_CAN_BUSLOAD_SUBWINDOW_MS each.
+ *
+ * With CO_CAN_BUSLOAD_EXACT_STUFFING == 0, stuff bits are the worst case
+ * for the frame length, (stuffed bits - 1) / 4, so result is an upper bound.
+ * With 1, stuff bits are counted from the actual identifier, data and CRC of
+ * each frame, which costs about 100 bit iterations per frame in the CAN
+ * interrupt. Error frames and overload frames are not counted.
+ */
+#ifndef CO_CAN_BUSLOAD
+#define CO_CAN_BUSLOAD          0
+#endif
+#ifndef CO_CAN_BUSLOAD_EXACT_STUFFING
+#define CO_CAN_BUSLOAD_EXACT_STUFFING 0
+#endif
+#ifndef CO_CAN_BUSLOAD_SUBWINDOW_MS
+#define CO_CAN_BUSLOAD_SUBWINDOW_MS 100U
+#endif
+#ifndef CO_CAN_BUSLOAD_SUBWINDOWS
+#define CO_CAN_BUSLOAD_SUBWINDOWS 10U
+#endif
+
+
+/**
+ * CAN traffic recorder.
+ *
+ * If nonzero, CAN interrupts copy each received and each transmitted frame
+ * with its hardware timestamp into the ring of CO_CANrecorder_t with
+ * CO_CAN_RECORDER records (power of two). CO_CANrecorder_process() writes the
+ * ring in background into external SPI flash on hspi3, see CO_CANrecorder.h.
+ * Needs CO_CAN_TIMESTAMP.
+ *
+ * With CO_CAN_RECORDER_ALL, hardware filters accept all frames, so frames of
+ * other devices are recorded too. Receive buffers are then matched by
+ * software, see useCANrxFilters.
+ */
+#ifndef CO_CAN_RECORDER
+#define CO_CAN_RECORDER         0
+#endif
+#ifndef CO_CAN_RECORDER_ALL
+#define CO_CAN_RECORDER_ALL     1
+#endif
+#if (CO_CAN_RECORDER & (CO_CAN_RECORDER - 1)) != 0
+#error CO_CAN_RECORDER must be power of two
+#endif
+#if (CO_CAN_RECORDER > 0) && (CO_CAN_TIMESTAMP == 0)
+#error CO_CAN_RECORDER needs CO_CAN_TIMESTAMP
+#endif
+
+
+/**
+ * Trace streaming over UART.
+ *
+ * If nonzero, CO_traceStream.c sends points of CANopen traces in delta binary
+ * format (see CO_trace_readDelta()) over UART with DMA, see
+ * CO_traceStream_init(). CO_TRACE_STREAM_BUF_SIZE is the size of each of two
+ * transmit buffers in bytes.
+ */
+#ifndef CO_TRACE_STREAM
+#define CO_TRACE_STREAM         0
+#endif
+
+
+/**
+ * Static allocation of stack objects.
+ *
+ * CO_init() uses objects defined statically in CANopen.c, so RAM usage is
+ * known after linking and is listed per object by CANopenNode/tools/
+ * footprint.py from the link map. Define CO_USE_MALLOC to allocate them with
+ * calloc() instead, then CO_delete() frees them.
+ */
+#if !defined(CO_USE_MALLOC) && !defined(CO_USE_GLOBALS)
+#define CO_USE_GLOBALS
+#endif
+
+/**
+ * Section of static objects used by CAN receive interrupt and timer thread:
+ * CAN module with receive and transmit arrays, SYNC, RPDOs and TPDOs. Default
+ * is .sram2 output section of the linker script (16 KB SRAM2 at 0x10000000),
+ * which is a separate bus matrix slave, so the CAN interrupt does not wait
+for DMA transfers into SRAM1 (trace stream, logging).
+ * Define CO_ATTR_HOT empty to keep them in .bss.
+ */
+#ifndef CO_ATTR_HOT
+#define CO_ATTR_HOT             __attribute__((section(".bss.sram2")))
+#endif
+
+/**
+ * Section of functions on the CAN receive and transmit interrupt path:
+ * CO_CANinterrupt_Rx(), HAL CAN callbacks with transmit queue helpers, CAN1
+ * interrupt handlers, CO_SYNC_receive(), CO_PDO_receive() and PDO copy
+ * routines. Default is .ramfunc output section of the linker script, which is
+ * copied from flash to SRAM2 by startup code and executes without flash wait
+ * states (4 at 80 MHz) and independent of ART cache hits. Linker script also
+ * places HAL_CAN_IRQHandler() there. Calls between flash and SRAM2 go through
+ * linker generated long branch veneers.
+ * Define CO_RAMFUNC empty to keep the functions in flash.
+ */
+#ifndef CO_RAMFUNC
+#define CO_RAMFUNC              __attribute__((section(".ramfunc")))
+#endif
+
+
+/**
+ * Static trace buffers.
+ *
+ * With CO_USE_GLOBALS, CO_init() uses CO_TRACE_BUFFER_SIZE_FIXED points for
+ * each trace instead of size from OD 0x2301+ (8 bytes per point). Buffers
+ * are placed into .trace_buffers section (NOLOAD in linker script), which is
+ * not cleared by startup code, so signal history before a fault or reset can
+ * be read by debugger before CO_init() runs again.
+ */
+#ifndef CO_TRACE_BUFFER_SIZE_FIXED
+#define CO_TRACE_BUFFER_SIZE_FIXED 512
+#endif
+#ifndef CO_TRACE_BUFFER_ATTR
+#define CO_TRACE_BUFFER_ATTR    __attribute__((section(".trace_buffers")))
+#endif
+#ifndef CO_TRACE_STREAM_BUF_SIZE
+#define CO_TRACE_STREAM_BUF_SIZE 256U
+#endif
+
+
+/**
+ * Gateway to host PC over UART, CiA 309-3 ASCII commands and binary frames.
+ *
+ * If nonzero, CO_gateway.c drives SDO client and NMT commands from a serial
+ * line and CO_gatewayUart.c connects it to UART with circular receive DMA
+ * and transmit DMA, see CO_gatewayUart_init(). Requires CO_NO_SDO_CLIENT.
+ * CO_GATEWAY_LINE_SIZE is the maximum length of ASCII command or binary
+ * frame, CO_GATEWAY_DATA_SIZE is the maximum size of SDO data.
+ * CO_GATEWAY_UART_RX_SIZE and CO_GATEWAY_UART_TX_SIZE are sizes of UART ring
+ * buffers, transmit buffer must hold the longest response.
+ */
+#ifndef CO_GATEWAY
+#define CO_GATEWAY              0
+#endif
+#ifndef CO_GATEWAY_LINE_SIZE
+#define CO_GATEWAY_LINE_SIZE    128U
+#endif
+#ifndef CO_GATEWAY_DATA_SIZE
+#define CO_GATEWAY_DATA_SIZE    128U
+#endif
+#ifndef CO_GATEWAY_UART_RX_SIZE
+#define CO_GATEWAY_UART_RX_SIZE 256U
+#endif
+#ifndef CO_GATEWAY_UART_TX_SIZE
+#define CO_GATEWAY_UART_TX_SIZE 512U
+#endif
+
+
+/**
+ * Binary log over UART, see CO_log.h.
+ *
+ * If nonzero, CO_LOG0() to CO_LOG4() macros write records into a lock-free
+ * ring of CO_LOG_BUF_SIZE bytes (power of two) from any context, including
+ * interrupts, and CO_log.c drains it with transmit DMA. Format strings stay
+ * in the .co_log section of the ELF file and are resolved on the host by
+ * CANopenNode/tools/logdecode.py. UART is the same as for CO_TRACE_STREAM and
+ * CO_GATEWAY, only one of them may be enabled.
+ */
+#ifndef CO_LOG
+#define CO_LOG                  0
+#endif
+#ifndef CO_LOG_BUF_SIZE
+#define CO_LOG_BUF_SIZE         1024U
+#endif
+
+
+/**
+ * Program download over SDO into internal flash, objects 0x1F50, 0x1F51,
+ * 0x1F56 and 0x1F57 (CiA 302-3).
+ *
+ * If nonzero, CO_fwUpdate.c programs the image into download region at
+ * CO_FW_FLASH_ADDRESS, CO_FW_FLASH_SIZE bytes, while it is received and
+ * copies it over the application after CRC verification. Both must be
+ * multiples of FLASH_PAGE_SIZE. Default splits 120 kB below the EEPROM
+ * region into two halves, FLASH region in the linker script must then be
+ * reduced to 60K. CO_FW_SWAP_DELAY_MS is the time between start program
+ * command and the copy, in which SDO response is sent.
+ */
+#ifndef CO_FW_UPDATE
+#define CO_FW_UPDATE            0
+#endif
+#ifndef CO_FW_FLASH_ADDRESS
+#define CO_FW_FLASH_ADDRESS     0x0800F000UL
+#endif
+#ifndef CO_FW_FLASH_SIZE
+#define CO_FW_FLASH_SIZE        0x0000F000UL
+#endif
+#ifndef CO_FW_SWAP_DELAY_MS
+#define CO_FW_SWAP_DELAY_MS     100U
+#endif
+
+
+/**
+ * CAN bit timing.
+ *
+ * CO_CANmodule_init() calculates prescaler and time segments at runtime from
+ * HAL_RCC_GetPCLK1Freq(), see CO_CANbitTiming(). CO_CAN_SAMPLE_POINT is the
+ * target sample point in per mille (CiA 301 recommends 875), longer lines may
+ * use lower value. CO_CAN_SJW is the resynchronization jump width in time
+ * quanta (1..4, limited to phase segment 2). Bit rate, which differs from
+ * the requested more than CO_CAN_BITRATE_TOLERANCE_PPM due to CAN clock, is
+ * rejected.
+ */
+#ifndef CO_CAN_SAMPLE_POINT
+#define CO_CAN_SAMPLE_POINT     875U
+#endif
+#ifndef CO_CAN_SJW
+#define CO_CAN_SJW              1U
+#endif
+#ifndef CO_CAN_BITRATE_TOLERANCE_PPM
+#define CO_CAN_BITRATE_TOLERANCE_PPM 1000U
+#endif
+
+
+/**
+ * Automatic bit rate detection.
+ *
+ * If nonzero, CO_CANmodule_init() with CANbitRate 0 listens on the bus in
+ * bxCAN silent mode and tries bit rates from CO_CAN_AUTO_BITRATE_LIST. Silent
+ * mode never drives the bus (no acknowledge, no error frames), so the node
+ * does not disturb running network with wrong bit rate. Bit rate is locked,
+ * when CO_CAN_AUTO_BITRATE_FRAMES frames are received without receive error.
+ * Bit rate, at which receive error is detected, is left immediately, silent
+ * bit rate is left after CO_CAN_AUTO_BITRATE_LISTEN_MS. Detection is blocking
+ * and returns CO_ERROR_TIMEOUT after CO_CAN_AUTO_BITRATE_TIMEOUT_MS
+ * (0 = wait forever). Detected value is stored in CANmodule->CANbitRate.
+ */
+#ifndef CO_CAN_AUTO_BITRATE
+#define CO_CAN_AUTO_BITRATE     0
+#endif
+#ifndef CO_CAN_AUTO_BITRATE_LIST
+#define CO_CAN_AUTO_BITRATE_LIST 1000U, 500U, 250U, 125U, 100U, 50U, 20U, 10U
+#endif
+#ifndef CO_CAN_AUTO_BITRATE_FRAMES
+#define CO_CAN_AUTO_BITRATE_FRAMES 2U
+#endif
+#ifndef CO_CAN_AUTO_BITRATE_LISTEN_MS
+#define CO_CAN_AUTO_BITRATE_LISTEN_MS 1100U
+#endif
+#ifndef CO_CAN_AUTO_BITRATE_TIMEOUT_MS
+#define CO_CAN_AUTO_BITRATE_TIMEOUT_MS 0U
+#endif
+
+/**
+ * Bus-off recovery.
+ *
+ * bxCAN runs with AutoBusOff disabled, so it stays in bus-off until software
+ * requests recovery. If CO_CAN_BUSOFF_RECOVERY is nonzero,
+ * CO_CANverifyErrors() runs recovery state machine on register ESR BOFF:
+ * first bus-off is recovered at once, bxCAN then waits for 128 x 11
+ * recessive bits and goes back to error active (0.2 ms at 1 Mbit/s). Each
+ * further bus-off doubles the delay before recovery is started, from
+ * CO_CAN_BUSOFF_DELAY_MS up to CO_CAN_BUSOFF_DELAY_MAX_MS, so a node with
+ * faulty transceiver does not flood the bus with error frames. Back-off is
+ * cleared, when node stays out of bus-off for CO_CAN_BUSOFF_STABLE_MS.
+ *
+ * TPDOs (identifiers 0x180 to 0x57F) waiting in transmit buffers or mailboxes
+ * are discarded, when recovery starts. Their data is old, TPDOs are sent again
+ * with fresh values on the next event or SYNC. Other messages (emergency,
+ * heartbeat, SDO) are kept. CO_EM_CAN_TX_BUS_OFF is reported at bus-off and
+ * reset after recovery.
+ */
+#ifndef CO_CAN_BUSOFF_RECOVERY
+#define CO_CAN_BUSOFF_RECOVERY  0
+#endif
+#ifndef CO_CAN_BUSOFF_DELAY_MS
+#define CO_CAN_BUSOFF_DELAY_MS  10U
+#endif
+#ifndef CO_CAN_BUSOFF_DELAY_MAX_MS
+#define CO_CAN_BUSOFF_DELAY_MAX_MS 1000U
+#endif
+#ifndef CO_CAN_BUSOFF_STABLE_MS
+#define CO_CAN_BUSOFF_STABLE_MS 5000U
+#endif
+
+/**
+ * Event driven CAN error handling.
+ *
+ * If nonzero, bxCAN error and status change interrupts (EWG, EPV, BOF, LEC)
+ * and FIFO overrun interrupts are enabled. HAL_CAN_ErrorCallback() in
+ * CO_driver.c records ESR with TEC and REC in CANmodule->errESR and reports
+ * CAN errors to CO_EM at once, TX or RX passive is decided from TEC and REC.
+ * bxCAN has no interrupt for leaving warning, passive or bus-off state, so
+ * CO_CANverifyErrors() reads ESR only while one of these states is active,
+ * otherwise it does not touch CAN registers. LEC interrupt is raised for each
+ * error frame, so noisy bus costs one short interrupt per error frame.
+ * CAN1_SCE_IRQn must be enabled at CAN priority (see can.c).
+ */
+#ifndef CO_CAN_ERROR_IRQ
+#define CO_CAN_ERROR_IRQ        0
+#endif
+
+
+/**
+ * CAN receive message structure as aligned in CAN module. It is different in
+ * different microcontrollers. It usually contains other variables.
+ */
+typedef struct{
+#if CO_CAN_RX_DIRECT == 0
+	CAN_RxHeaderTypeDef RxHeader;       /**< HAL receive header */
+#endif
+	/** CAN identifier. It must be read through CO_CANrxMsg_readIdent() function. */
+	uint32_t            ident;          /* Standard or extended (CO_CANrxMsg_readIdentExt()) identifier */
+	uint8_t             DLC;            /* Data length code (bits 0...3) */
+	uint8_t             data[CO_CAN_DATA_SIZE]; /**< 8 data bytes, see CO_CAN_DATA_SIZE */
+#if CO_CAN_TIMESTAMP > 0
+	/** CAN bit time counter at SOF. It must be read through CO_CANrxMsg_readTimestamp(). */
+	uint16_t            timestamp;
+#endif
+}CO_CANrxMsg_t;
+
+
+/**
+ * Received message object
+ */
+typedef struct{
+	uint16_t            ident;          /**< Standard CAN Identifier (bits 0..10) + RTR (bit 11) */
+	uint16_t            mask;           /**< Standard Identifier mask with same alignment as ident */
+	void               *object;         /**< From CO_CANrxBufferInit() */
+	void              (*pFunct)(void *object, const CO_CANrxMsg_t *message);  /**< From CO_CANrxBufferInit() */
+#if CO_CAN_RX_STORM > 0
+	uint32_t            stormTokens;    /**< Token bucket in 1/1000 frame, see CO_CAN_RX_STORM */
+	uint32_t            stormTick;      /**< HAL_GetTick() at the last refill or at blocking */
+	volatile uint8_t    stormState;     /**< CO_CAN_STORM_xxx in CO_driver.c */
+#endif
+}CO_CANrx_t;
+
+
+/**
+ * Range of received identifiers, which share one CO_CANrx_t, see
+ * CO_CANrxBufferInitRange(). Owned by the CANopen object.
+ */
+typedef struct{
+	uint16_t            ident;          /**< First 11-bit identifier of the range */
+	uint16_t            count;          /**< Number of identifiers */
+	void               *object;         /**< From CO_CANrxBufferInitRange() */
+	/** From CO_CANrxBufferInitRange(), offset is identifier - ident */
+	void              (*pFunct)(void *object, const CO_CANrxMsg_t *message, uint16_t offset);
+}CO_CANrxRange_t;
+
+
+#if CO_CAN_EXT_ID > 0
+/**
+ * Received extended message object, see CO_CAN_EXT_ID
+ */
+typedef struct{
+	uint32_t            ident;          /**< EXID (bits 3..31) + IDE (bit 2) + RTR (bit 1), as RIR register */
+	uint32_t            mask;           /**< Identifier mask with same alignment as ident */
+	void               *object;         /**< From CO_CANrxBufferInitExt() */
+	void              (*pFunct)(void *object, const CO_CANrxMsg_t *message);  /**< From CO_CANrxBufferInitExt() */
+}CO_CANrxExt_t;
+#endif
+
+
+#if CO_CAN_TX_LATENCY > 0
+/**
+ * Transmit latency of one transmit buffer, see CO_CAN_TX_LATENCY.
+ */
+typedef struct{
+	uint32_t            count;          /**< Measured frames */
+	uint32_t            min_us;         /**< Minimum latency in microseconds */
+	uint32_t            max_us;         /**< Maximum latency in microseconds */
+	/** Number of frames, bin b counts latencies below CO_CAN_TX_LATENCY_BIN_US << b */
+	uint32_t            hist[CO_CAN_TX_LATENCY_BINS];
+}CO_CANtxLatency_t;
+#endif
+
+
+/**
+ * Transmit message object.
+ */
+typedef struct{
+	uint32_t            ident;          /**< CAN identifier as aligned in CAN module, bit 31 marks extended identifier */
+	uint8_t             DLC ;           /**< Length of CAN message. (DLC may also be part of ident) */
+	uint8_t             data[CO_CAN_DATA_SIZE]; /**< 8 data bytes, see CO_CAN_DATA_SIZE */
+	volatile bool_t     bufferFull;     /**< True if previous message is still in buffer */
+	/** Synchronous PDO messages has this flag set. It prevents them to be sent outside the synchronous window */
+	volatile bool_t     syncFlag;
+#if CO_CAN_TX_CRITICAL > 0
+	/** Frame may use reserved mailbox 2, see #CO_CAN_TX_FLAG_CRITICAL */
+	bool_t              critical;
+#endif
+	/** Priority of the buffer inside CO_CANmodule_t, 0 for the lowest identifier */
+	uint8_t             rank;
+	/** HAL transmit header, prepared by CO_CANtxBufferInit() */
+	CAN_TxHeaderTypeDef TxHeader;
+#if CO_CAN_TX_DIRECT > 0
+	uint32_t            TIR;            /**< Mailbox identifier register image, without TXRQ */
+	uint32_t            TDTR;           /**< Mailbox length register image */
+#endif
+#if CO_CAN_TX_LATENCY > 0
+	uint32_t            txQueued;       /**< DWT->CYCCNT, when CO_CANsend() queued the buffer */
+	CO_CANtxLatency_t   latency;        /**< Read with CO_CANgetTxLatency() */
+#endif
+}CO_CANtx_t;
+
+
+#if CO_CAN_RX_RING > 0
+/**
+ * Received frame in the ring, see CO_CAN_RX_RING.
+ */
+typedef struct{
+	CO_CANrxMsg_t       msg;            /**< Frame, as passed to receive buffer */
+	uint16_t            ident;          /**< Identifier + RTR, aligned as CO_CANrx_t ident */
+	uint8_t             fifo;           /**< Receive FIFO */
+	uint8_t             filterMatchIndex; /**< Filter match index from the FIFO */
+}CO_CANrxRing_t;
+#endif
+
+
+#if CO_CAN_BRIDGE > 0
+/**
+ * Forwarding route, see CO_CAN_BRIDGE and CO_CANbridgeRoute().
  */
 typedef struct{
-	/** CAN identifier. It must be read through CO_CANrxMsg_readIdent() function. */
-	CAN_RxHeaderTypeDef RxHeader;
-	uint32_t            ident;          /* Standard Identifier */
-	uint8_t             DLC;            /* Data length code (bits 0...3) */
-	uint8_t             data[8];        /**< 8 data bytes */
-}CO_CANrxMsg_t;
+	uint16_t            ident;          /**< Identifier + RTR, aligned as CO_CANrx_t ident */
+	uint16_t            mask;           /**< Identifier mask with same alignment as ident */
+	int16_t             offset;         /**< Added to 11-bit identifier of forwarded frame */
+	void               *target;         /**< Target CO_CANmodule_t or NULL, if route is unused */
+}CO_CANbridgeRoute_t;
 
 
 /**
- * Received message object
+ * Forwarded frame in the queue of target module, mailbox register images.
  */
 typedef struct{
-	uint16_t            ident;          /**< Standard CAN Identifier (bits 0..10) + RTR (bit 11) */
-	uint16_t            mask;           /**< Standard Identifier mask with same alignment as ident */
-	void               *object;         /**< From CO_CANrxBufferInit() */
-	void              (*pFunct)(void *object, const CO_CANrxMsg_t *message);  /**< From CO_CANrxBufferInit() */
-}CO_CANrx_t;
+	uint32_t            TIR;            /**< Identifier register image, without TXRQ */
+	uint32_t            TDTR;           /**< Length register image */
+	uint32_t            TDLR;           /**< Data bytes 0..3 */
+	uint32_t            TDHR;           /**< Data bytes 4..7 */
+}CO_CANbridgeFrame_t;
+#endif
 
 
 /**
- * Transmit message object.
+ * CAN bus and driver statistics, see CO_CAN_STATISTICS.
+ *
+ * Counters wrap around. Each counter is written from a single context or
+ * inside CO_LOCK_CAN_SEND(), so update takes no additional lock.
  */
 typedef struct{
-	uint32_t            ident;          /**< CAN identifier as aligned in CAN module */
-	uint8_t             DLC ;           /**< Length of CAN message. (DLC may also be part of ident) */
-	uint8_t             data[8];        /**< 8 data bytes */
-	volatile bool_t     bufferFull;     /**< True if previous message is still in buffer */
-	/** Synchronous PDO messages has this flag set. It prevents them to be sent outside the synchronous window */
-	volatile bool_t     syncFlag;
-}CO_CANtx_t;
+	uint32_t             rxFrames;       /**< Standard frames read from receive FIFOs */
+	uint32_t             rxUnmatched;    /**< Received frames without matching receive buffer */
+	uint32_t             rxOverruns;     /**< Receive FIFO overruns, each means at least one lost frame */
+	uint32_t             txQueued;       /**< Transmit buffers queued by CO_CANsend() */
+	uint32_t             txSent;         /**< Transmit mailboxes completed */
+	uint32_t             txAborted;      /**< Synchronous TPDOs deleted or aborted in mailbox by CO_CANclearPendingSyncPDOs() */
+	uint32_t             txQueueMax;     /**< Maximum number of transmit buffers waiting for a mailbox */
+	uint32_t             busOff;         /**< Transitions into bus-off state */
+#if CO_CAN_RX_STORM > 0
+	uint32_t             rxStormDropped; /**< Received frames dropped by storm protection, see CO_CAN_RX_STORM */
+#endif
+#if CO_CAN_BRIDGE > 0
+	uint32_t             rxForwarded;    /**< Received frames forwarded to other CANmodule, see CO_CAN_BRIDGE */
+	uint32_t             txForwardLost;  /**< Frames from other CANmodule dropped, because bridge queue was full */
+#endif
+#if CO_CAN_TX_LOOPBACK > 0
+	uint32_t             txLoopback;     /**< Frames passed to local receive buffers by CO_CANsend(), see CO_CAN_TX_LOOPBACK */
+#endif
+	uint8_t              TEC;            /**< Transmit error counter, read by CO_CANgetStatistics() */
+	uint8_t              REC;            /**< Receive error counter, read by CO_CANgetStatistics() */
+}CO_CANstatistics_t;
 
 
 /**
@@ -273,6 +1848,9 @@ typedef struct{
 	CAN_HandleTypeDef   *CANbaseAddress; /**< From CO_CANmodule_init() */
 	CO_CANrx_t          *rxArray;        /**< From CO_CANmodule_init() */
 	uint16_t             rxSize;         /**< From CO_CANmodule_init() */
+	/** Number of rxArray buffers of one CANopen device, see
+	 * CO_CANmodule_setRxSlice(). Equal to rxSize, if module is not shared. */
+	uint16_t             rxSlice;
 	CO_CANtx_t          *txArray;        /**< From CO_CANmodule_init() */
 	uint16_t             txSize;         /**< From CO_CANmodule_init() */
 	volatile bool_t      CANnormal;      /**< CAN module is in normal mode */
@@ -281,20 +1859,151 @@ typedef struct{
 	 * they won't be used. In this case will be *all* received CAN messages
 	 * processed by software. */
 	volatile bool_t      useCANrxFilters;
+	/** Set by CO_CANmodule_init(), filter banks are programmed once by
+	 * CO_CANsetNormalMode() after all buffers are registered */
+	bool_t               rxFiltersDeferred;
+	/** Index of rxArray member for each filter match index (FMI), valid if
+	 * useCANrxFilters is true. Built by CO_CANrxBufferInit(). */
+	volatile uint8_t     filterToRx[CO_CAN_FILTER_NO_FMI];
+	/** Shadow of FR1 and FR2 registers of the programmed filter banks */
+	uint32_t             filterFR[CO_CAN_FILTER_BANKS][2];
+	/** Bit per filter bank, set if bank is in identifier list mode */
+	uint16_t             filterListMode;
+	/** Bit per filter bank, set if bank is assigned to FIFO1 */
+	uint16_t             filterFifo1;
+	/** Bit per filter bank, set if bank is in 32-bit scale (extended identifiers) */
+	uint16_t             filterScale32;
+	/** Index in filterToRx, where FMI of FIFO1 starts */
+	volatile uint8_t     filterFifo1Start;
+	/** Number of programmed filter banks, 0 if single accept-all filter is used */
+	uint8_t              filterBanksUsed;
+	/** First filter bank of the CAN peripheral, CO_CAN_FILTER_BANKS for CAN2 */
+	uint8_t              filterBankFirst;
+#if CO_CAN_BRIDGE > 0
+	/** Index in filterToRx, where FMI of routes start. filterToRx then holds
+	 * index in bridgeRoute. CO_CAN_FILTER_NO_FMI, if routes have no filters. */
+	volatile uint8_t     filterBridgeStart;
+	/** Routes from CO_CANbridgeRoute() */
+	CO_CANbridgeRoute_t  bridgeRoute[CO_CAN_BRIDGE];
+	/** Frames forwarded from other CANmodule, written inside CO_LOCK_CAN_SEND() */
+	CO_CANbridgeFrame_t  bridgeQueue[CO_CAN_BRIDGE_QUEUE];
+	/** Free running write counter of bridgeQueue */
+	uint16_t             bridgeHead;
+	/** Free running read counter of bridgeQueue */
+	uint16_t             bridgeTail;
+#endif
+#if CO_CAN_RX_DISPATCH > 0
+	/** Index of rxArray member for each 11-bit identifier of data frame or
+	 * CO_CAN_FILTER_UNUSED. Built by CO_CANrxBufferInit(). */
+	volatile uint8_t     rxDispatch[0x800];
+#endif
+#if CO_CAN_TX_CALLBACK > 0
+	/** From CO_CANmodule_initTxCallback() or NULL */
+	void               (*pFunctTx)(void *object);
+	/** From CO_CANmodule_initTxCallback() */
+	void                *functTxObject;
+#endif
+#if CO_CAN_RX_CALLBACK > 0
+	/** From CO_CANmodule_initRxCallback() or NULL */
+	void               (*pFunctRx)(void *object, uint16_t ident);
+	/** From CO_CANmodule_initRxCallback() */
+	void                *functRxObject;
+#endif
+#if CO_CAN_EXT_ID > 0
+	/** Receive buffers for extended frames, see CO_CANrxBufferInitExt() */
+	CO_CANrxExt_t        rxExt[CO_CAN_EXT_RX_SIZE];
+#endif
+#if CO_CAN_RX_STORM > 0
+	/** Set by receive interrupt, when it blocks a member of rxArray */
+	volatile bool_t      rxStormPending;
+	/** Number of blocked rxArray members, written by CO_CANverifyErrors() */
+	uint16_t             rxStormBlocked;
+#endif
+#if CO_CAN_RX_RING > 0
+	/** Frames written by CO_CANinterrupt_Rx(), see CO_CAN_RX_RING */
+	CO_CANrxRing_t       rxRing[CO_CAN_RX_RING];
+	/** Free running write counter, written only by CO_CANinterrupt_Rx() */
+	volatile uint16_t    rxRingHead;
+	/** Free running read counter, written only by CO_CANrxRingProcess() */
+	volatile uint16_t    rxRingTail;
+#endif
 	/** If flag is true, then message in transmitt buffer is synchronous PDO
 	 * message, which will be aborted, if CO_clearPendingSyncPDOs() function
 	 * will be called by application. This may be necessary if Synchronous
 	 * window time was expired. */
 	volatile bool_t      bufferInhibitFlag;
+	/** Transmit buffer, which was written into each of the three mailboxes,
+	 * NULL after transmit complete or abort interrupt. Used to abort exactly
+	 * the mailboxes with synchronous PDOs. */
+	const CO_CANtx_t    *txMailbox[3];
 	/** Equal to 1, when the first transmitted message (bootup message) is in CAN TX buffers */
 	volatile bool_t      firstCANtxMessage;
 	/** Number of messages in transmit buffer, which are waiting to be copied to the CAN module */
 	volatile uint16_t    CANtxCount;
+	/** Set of waiting transmit buffers. Bit (31 - rank % 32) in word (rank / 32)
+	 * is set, if buffer with that rank is waiting. */
+	volatile uint32_t    txPending[CO_CAN_TX_PENDING_WORDS];
+	/** Index in txArray for each rank */
+	uint8_t              txByRank[CO_CAN_TX_PENDING_WORDS * 32U];
+#if CO_CAN_TX_CRITICAL > 0
+	/** Ranks of critical transmit buffers, same layout as txPending */
+	uint32_t             txCritical[CO_CAN_TX_PENDING_WORDS];
+#endif
 	uint32_t             errOld;         /**< Previous state of CAN errors */
 	void                *em;             /**< Emergency object */
+	uint16_t             CANbitRate;     /**< From CO_CANmodule_init(), in kbps */
+#if CO_CAN_STATISTICS > 0
+	CO_CANstatistics_t   stats;          /**< Counters, read with CO_CANgetStatistics() */
+	bool_t               busOffOld;      /**< Bus-off state at previous CO_CANverifyErrors() */
+#endif
+#if CO_CAN_ERROR_IRQ > 0
+	volatile uint32_t    errESR;         /**< ESR at the last error interrupt or poll: LEC, flags, TEC, REC */
+	volatile uint32_t    errIrqCount;    /**< Number of error interrupts */
+	uint8_t              errFlags;       /**< Error states reported to CO_EM, CO_CAN_ERR_xxx in CO_driver.c */
+#endif
+#if CO_CAN_BUSOFF_RECOVERY > 0
+	uint8_t              busOffState;    /**< Recovery state, see CO_CAN_BUSOFF_RECOVERY */
+	uint8_t              busOffCount;    /**< Bus-off events since the bus was stable */
+	uint32_t             busOffTick;     /**< HAL_GetTick() at the last state change */
+	uint32_t             busOffDelay;    /**< Back-off delay of the current bus-off, in ms */
+#endif
+#if CO_CAN_BUSLOAD > 0
+	/** Bits of received and transmitted frames since CO_CANbusLoadBits() */
+	volatile uint32_t    busLoadBits;
+#endif
+#if CO_CAN_RECORDER > 0
+	/** CO_CANrecorder_t from CO_CANrecorder_init_2() or NULL */
+	void                *recorder;
+#endif
+#if CO_CAN_TX_LATENCY > 0
+	/** txQueued of the buffer in each mailbox, valid if bit in txLatencyArmed is set */
+	uint32_t             txLatencyQueued[3];
+	/** Bit per mailbox, set when queued buffer is copied into the mailbox */
+	uint8_t              txLatencyArmed;
+	/** DWT cycles per microsecond, from SystemCoreClock at CO_CANmodule_init() */
+	uint32_t             txLatencyCyclesPerUs;
+	/** 11-bit identifier selected over SDO, see CO_CANtxLatency_init() */
+	uint16_t             txLatencySelect;
+#endif
+#if CO_CAN_TX_LOOPBACK > 0
+	/** Bit per identifier from CO_CAN_LOOPBACK_FIRST, set by CO_CANtxSetLocalOnly() */
+	uint32_t             txLocalOnly[CO_CAN_LOOPBACK_WORDS];
+#endif
 }CO_CANmodule_t;
 
 
+/**
+ * bxCAN bit timing, result of CO_CANbitTiming().
+ */
+typedef struct{
+	uint16_t             prescaler;      /**< Length of time quantum in CAN clock cycles, 1..1024 */
+	uint8_t              timeSeg1;       /**< Propagation and phase segment 1 in time quanta, 1..16 */
+	uint8_t              timeSeg2;       /**< Phase segment 2 in time quanta, 1..8 */
+	uint8_t              sjw;            /**< Resynchronization jump width in time quanta, 1..4 */
+	uint16_t             samplePoint;    /**< Resulting sample point in per mille */
+}CO_CANbitTiming_t;
+
+
 /**
  * Endianes.
  *
@@ -315,6 +2024,10 @@ void CO_CANsetConfigurationMode(int32_t CANbaseAddress);
 /**
  * Request CAN normal (operational) mode and *wait* until it is set.
  *
+ * Hardware filters of receive buffers, registered since CO_CANmodule_init(),
+ * are programmed here at once. Later CO_CANrxBufferInit() calls program them
+ * immediately.
+ *
  * @param CANmodule This object.
  */
 CO_ReturnError_t CO_CANsetNormalMode(CO_CANmodule_t *CANmodule);
@@ -328,14 +2041,19 @@ CO_ReturnError_t CO_CANsetNormalMode(CO_CANmodule_t *CANmodule);
  *
  * @param CANmodule This object will be initialized.
  * @param CANbaseAddress CAN module base address. In CUBEMX HAL context it is address of the @CAN_HandleTypeDef object.
+ * Its Instance (CAN1 or CAN2) selects the peripheral. CubeMX callbacks of that
+ * peripheral are dispatched to this CANmodule.
  * @param rxArray Array for handling received CAN messages
  * @param rxSize Size of the above array. Must be equal to number of receiving CAN objects.
  * @param txArray Array for handling transmitting CAN messages
- * @param txSize Size of the above array. Must be equal to number of transmitting CAN objects.
- * @param CANbitRate Valid values are (in kbps): 10, 20, 50, 125, 250, 500, 800, 1000.
- * If value is illegal, bitrate defaults to 125.
+ * @param txSize Size of the above array. Must be equal to number of transmitting CAN objects
+ * and not larger than 32 * CO_CAN_TX_PENDING_WORDS.
+ * @param CANbitRate Bit rate in kbps, see CO_CANbitTiming(). Standard CiA values
+ * are 10, 20, 50, 125, 250, 500, 800 and 1000. With CO_CAN_AUTO_BITRATE, value
+ * 0 detects bit rate of the bus.
  *
- * Return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ * Return #CO_ReturnError_t: CO_ERROR_NO, CO_ERROR_ILLEGAL_ARGUMENT,
+ * CO_ERROR_ILLEGAL_BAUDRATE, CO_ERROR_HAL or CO_ERROR_TIMEOUT.
  */
 CO_ReturnError_t CO_CANmodule_init(
 		CO_CANmodule_t         *CANmodule,
@@ -347,6 +2065,69 @@ CO_ReturnError_t CO_CANmodule_init(
 		uint16_t                CANbitRate);
 
 
+/**
+ * Calculate bxCAN bit timing.
+ *
+ * From 8 to 25 time quanta per bit, combination with the smallest bit rate
+ * error and then with sample point closest to samplePoint is selected. With
+ * equal error, more time quanta are preferred.
+ *
+ * @param clock_Hz CAN peripheral clock (APB1) in Hz.
+ * @param CANbitRate Bit rate in kbps.
+ * @param samplePoint Target sample point in per mille, 500..950.
+ * @param timing Result.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO, CO_ERROR_ILLEGAL_ARGUMENT or
+ * CO_ERROR_ILLEGAL_BAUDRATE, if bit rate can not be reached within
+ * CO_CAN_BITRATE_TOLERANCE_PPM.
+ */
+CO_ReturnError_t CO_CANbitTiming(
+		uint32_t                clock_Hz,
+		uint16_t                CANbitRate,
+		uint16_t                samplePoint,
+		CO_CANbitTiming_t      *timing);
+
+
+#if CO_CAN_TX_CALLBACK > 0
+/**
+ * Initialize transmit complete callback.
+ *
+ * Function is called from CAN transmit interrupt (and from CO_CANpolling_Tx())
+ * inside CO_LOCK_CAN_SEND(), after waiting messages were copied into free
+ * mailboxes. It may call CO_CANsend() to keep mailboxes busy. Callback is
+ * cleared by CO_CANmodule_init().
+ *
+ * @param CANmodule This object.
+ * @param object Pointer to object, which will be passed to pFunct.
+ * @param pFunct Pointer to the callback function or NULL.
+ */
+void CO_CANmodule_initTxCallback(
+		CO_CANmodule_t         *CANmodule,
+		void                   *object,
+		void                  (*pFunct)(void *object));
+#endif
+
+
+#if CO_CAN_RX_CALLBACK > 0
+/**
+ * Initialize receive callback.
+ *
+ * Function is called from CAN receive interrupt for each received standard
+ * frame, after it was passed to its receive buffer. It must be short, e.g. set RTOS thread flags. Callback is cleared by
+ * CO_CANmodule_init().
+ *
+ * @param CANmodule This object.
+ * @param object Pointer to object, which will be passed to pFunct.
+ * @param pFunct Pointer to the callback function or NULL. _ident_ is 11-bit
+ * CAN identifier of the received frame.
+ */
+void CO_CANmodule_initRxCallback(
+		CO_CANmodule_t         *CANmodule,
+		void                   *object,
+		void                  (*pFunct)(void *object, uint16_t ident));
+#endif
+
+
 /**
  * Switch off CANmodule. Call at program exit.
  *
@@ -355,13 +2136,95 @@ CO_ReturnError_t CO_CANmodule_init(
 void CO_CANmodule_disable(CO_CANmodule_t *CANmodule);
 
 
+/**
+ * Share CAN module between several CANopen devices.
+ *
+ * rxArray is divided into consecutive slices of _rxSlice_ buffers, one for
+ * each device. Received message is then processed by the first matching
+ * buffer in each slice, so broadcast messages (NMT, SYNC) reach all devices.
+ * Call after CO_CANmodule_init(), which sets one slice of rxSize.
+ *
+ * @param CANmodule CAN module object.
+ * @param rxSlice Number of buffers of one device, rxSize must be multiple of it.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_CANmodule_setRxSlice(CO_CANmodule_t *CANmodule, uint16_t rxSlice);
+
+
+#if CO_CAN_BRIDGE > 0
+/**
+ * Configure forwarding route to other CANmodule, see CO_CAN_BRIDGE.
+ *
+ * Received standard frames with identifier, which matches _ident_ and _mask_,
+ * are transmitted by _target_ with identifier (ident + offset) & 0x7FF, DLC
+ * and data unchanged. Function reconfigures hardware filters of _CANmodule_.
+ * Routes are cleared by CO_CANmodule_init(), so call it after CO_CANmodule_init()
+ * and CO_CANrxBufferInit() of both modules, e.g. after CO_init().
+ *
+ * @param CANmodule CAN module object, which receives the frames.
+ * @param index Index of the route, 0 to CO_CAN_BRIDGE - 1.
+ * @param target CAN module object, which transmits the frames, or NULL to
+ * remove the route. It must be different from _CANmodule_.
+ * @param ident 11-bit standard CAN identifier.
+ * @param mask 11-bit mask for identifier, bits set to 0 are not compared.
+ * @param rtr If true, route forwards remote frames, otherwise data frames.
+ * @param offset Translation of the identifier, 0 for none.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO, CO_ERROR_ILLEGAL_ARGUMENT or CO_ERROR_HAL.
+ */
+CO_ReturnError_t CO_CANbridgeRoute(
+		CO_CANmodule_t         *CANmodule,
+		uint16_t                index,
+		CO_CANmodule_t         *target,
+		uint16_t                ident,
+		uint16_t                mask,
+		bool_t                  rtr,
+		int16_t                 offset);
+#endif
+
+
 /**
  * Read CAN identifier from received message
  *
  * @param rxMsg Pointer to received message
  * @return 11-bit CAN standard identifier.
  */
-//uint16_t CO_CANrxMsg_readIdent(const CO_CANrxMsg_t *rxMsg);
+uint16_t CO_CANrxMsg_readIdent(const CO_CANrxMsg_t *rxMsg);
+
+
+#if CO_CAN_TIMESTAMP > 0
+/**
+ * Read hardware timestamp from received message
+ *
+ * @param rxMsg Pointer to received message
+ * @return CAN bit time counter at SOF, wraps after 65536 bit times.
+ */
+uint16_t CO_CANrxMsg_readTimestamp(const CO_CANrxMsg_t *rxMsg);
+
+
+/**
+ * Convert difference of two hardware timestamps to microseconds
+ *
+ * @param CANmodule This object.
+ * @param from Older timestamp.
+ * @param to Newer timestamp, less than 65536 bit times after _from_.
+ * @return Time difference in [microseconds].
+ */
+uint32_t CO_CANtimestampDiff_us(const CO_CANmodule_t *CANmodule, uint16_t from, uint16_t to);
+#endif
+
+
+#if CO_CAN_EXT_ID > 0
+/**
+ * Read extended CAN identifier from received message
+ *
+ * @param rxMsg Pointer to received message, passed to function registered by
+ * CO_CANrxBufferInitExt().
+ * @return 29-bit CAN extended identifier.
+ */
+uint32_t CO_CANrxMsg_readIdentExt(const CO_CANrxMsg_t *rxMsg);
+#endif
 
 
 /**
@@ -384,8 +2247,14 @@ void CO_CANmodule_disable(CO_CANmodule_t *CANmodule);
  * @param pFunct Pointer to function, which will be called, if received CAN
  * message matches the identifier. It must be fast function.
  *
+ * Hardware acceptance filters are rebuilt from the whole _rxArray_ on each call.
+ * Exact identifiers (mask 0x7FF) are packed four per bank in 16-bit list mode,
+ * other identifier/mask pairs two per bank in 16-bit mask mode. Only filter
+ * banks, which changed, are reprogrammed. If there is not enough filter banks,
+ * single accept-all filter is used and messages are searched by software.
+ *
  * Return #CO_ReturnError_t: CO_ERROR_NO CO_ERROR_ILLEGAL_ARGUMENT or
- * CO_ERROR_OUT_OF_MEMORY (not enough masks for configuration).
+ * CO_ERROR_HAL (filter configuration failed).
  */
 CO_ReturnError_t CO_CANrxBufferInit(
 		CO_CANmodule_t         *CANmodule,
@@ -397,6 +2266,38 @@ CO_ReturnError_t CO_CANrxBufferInit(
 		void                  (*pFunct)(void *object, const CO_CANrxMsg_t *message));
 
 
+/**
+ * Configure CAN message receive buffer for a range of identifiers.
+ *
+ * One buffer and one hardware filter (mask mode) serve identifiers from
+ * ident to ident + count - 1, for example heartbeats of all nodes. Mask
+ * selects the smallest aligned block of identifiers, which contains the
+ * range. Received message with identifier from the block, but outside of the
+ * range, is consumed by the buffer and ignored, so the block must not cover
+ * identifiers of buffers with higher index.
+ *
+ * @param CANmodule This object.
+ * @param index Index of the specific buffer in _rxArray_.
+ * @param range Range object, must exist as long as the buffer is used.
+ * @param ident First 11-bit standard CAN identifier of the range.
+ * @param count Number of identifiers, 1 to 0x800 - ident.
+ * @param object CANopen object, argument to pFunct.
+ * @param pFunct Function, which will be called with received message and
+ * its offset (identifier - ident) in the range. It must be fast function.
+ *
+ * Return #CO_ReturnError_t: CO_ERROR_NO CO_ERROR_ILLEGAL_ARGUMENT or
+ * CO_ERROR_HAL (filter configuration failed).
+ */
+CO_ReturnError_t CO_CANrxBufferInitRange(
+		CO_CANmodule_t         *CANmodule,
+		uint16_t                index,
+		CO_CANrxRange_t        *range,
+		uint16_t                ident,
+		uint16_t                count,
+		void                   *object,
+		void                  (*pFunct)(void *object, const CO_CANrxMsg_t *message, uint16_t offset));
+
+
 /**
  * Configure CAN message transmit buffer.
  *
@@ -410,6 +2311,7 @@ CO_ReturnError_t CO_CANrxBufferInit(
  * @param noOfBytes Length of CAN message in bytes (0 to 8 bytes).
  * @param syncFlag This flag bit is used for synchronous TPDO messages. If it is set,
  * message will not be sent, if curent time is outside synchronous window.
+ * May be or-ed with #CO_CAN_TX_FLAG_CRITICAL.
  *
  * @return Pointer to CAN transmit message buffer. 8 bytes data array inside
  * buffer should be written, before CO_CANsend() function is called.
@@ -424,6 +2326,68 @@ CO_CANtx_t *CO_CANtxBufferInit(
 		bool_t                  syncFlag);
 
 
+#if CO_CAN_EXT_ID > 0
+/**
+ * Configure CAN receive buffer for extended frames.
+ *
+ * Same as CO_CANrxBufferInit(), but for buffer in _rxExt_ from
+ * CO_CANmodule_t. Exact identifiers (mask 0x1FFFFFFF) are packed two per bank
+ * in 32-bit list mode, other identifier/mask pairs one per bank in 32-bit mask
+ * mode, all assigned to FIFO1. Inside _pFunct_ identifier is read with
+ * CO_CANrxMsg_readIdentExt(). CO_CANmodule_init() clears all extended buffers,
+ * so application registers them in communication reset section after CO_init().
+ *
+ * @param CANmodule This object.
+ * @param index Index of the specific buffer in _rxExt_, 0..CO_CAN_EXT_RX_SIZE-1.
+ * @param ident 29-bit extended CAN Identifier.
+ * @param mask 29-bit mask for identifier.
+ * @param rtr If true, 'Remote Transmit Request' messages will be accepted.
+ * @param object CANopen object, argument to pFunct.
+ * @param pFunct Pointer to function, which will be called from CAN receive
+ * interrupt, if received extended frame matches the identifier. NULL
+ * releases the buffer.
+ *
+ * Return #CO_ReturnError_t: CO_ERROR_NO CO_ERROR_ILLEGAL_ARGUMENT or
+ * CO_ERROR_HAL (filter configuration failed).
+ */
+CO_ReturnError_t CO_CANrxBufferInitExt(
+		CO_CANmodule_t         *CANmodule,
+		uint16_t                index,
+		uint32_t                ident,
+		uint32_t                mask,
+		bool_t                  rtr,
+		void                   *object,
+		void                  (*pFunct)(void *object, const CO_CANrxMsg_t *message));
+
+
+/**
+ * Configure CAN transmit buffer with extended identifier.
+ *
+ * Same as CO_CANtxBufferInit(), but for 29-bit identifier. Buffer takes part
+ * in transmit priority with its full arbitration field, standard frame wins
+ * against extended frame with the same base identifier, as on the CAN bus.
+ *
+ * @param CANmodule This object.
+ * @param index Index of the specific buffer in _txArray_.
+ * @param ident 29-bit extended CAN Identifier.
+ * @param rtr If true, 'Remote Transmit Request' messages will be transmitted.
+ * @param noOfBytes Length of CAN message in bytes (0 to 8 bytes).
+ * @param syncFlag This flag bit is used for synchronous TPDO messages.
+ * May be or-ed with #CO_CAN_TX_FLAG_CRITICAL.
+ *
+ * @return Pointer to CAN transmit message buffer or zero in case of wrong
+ * arguments.
+ */
+CO_CANtx_t *CO_CANtxBufferInitExt(
+		CO_CANmodule_t         *CANmodule,
+		uint16_t                index,
+		uint32_t                ident,
+		bool_t                  rtr,
+		uint8_t                 noOfBytes,
+		bool_t                  syncFlag);
+#endif
+
+
 /**
  * Send CAN message.
  *
@@ -437,6 +2401,26 @@ CO_CANtx_t *CO_CANtxBufferInit(
 CO_ReturnError_t CO_CANsend(CO_CANmodule_t *CANmodule, CO_CANtx_t *buffer);
 
 
+#if CO_CAN_TX_RESERVED > 0
+/**
+ * Send CAN message through the reserved transmit mailbox 2.
+ *
+ * Message is written into mailbox registers at once, without transmit queue,
+ * so it only waits for arbitration. Transmit queue never uses mailbox 2, so
+ * function does not use CO_LOCK_CAN_SEND() and may be called from interrupt,
+ * which is more urgent than CAN interrupts, see CO_SYNC_timerIsr(). Only one
+ * thread may use the function.
+ *
+ * @param CANmodule This object.
+ * @param buffer Pointer to transmit buffer, returned by CO_CANtxBufferInit().
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_TX_OVERFLOW, if previous
+ * reserved message is still not transmitted.
+ */
+CO_ReturnError_t CO_CANsendReserved(CO_CANmodule_t *CANmodule, const CO_CANtx_t *buffer);
+#endif
+
+
 /**
  * Clear all synchronous TPDOs from CAN module transmit buffers.
  *
@@ -449,6 +2433,10 @@ CO_ReturnError_t CO_CANsend(CO_CANmodule_t *CANmodule, CO_CANtx_t *buffer);
  * when it is called. Function should be called by the stack in the moment,
  * when SYNC time was just passed out of synchronous window.
  *
+ * Mailboxes, which still hold synchronous TPDO, are aborted with
+ * HAL_CAN_AbortTxRequest(). Frame, which is already being transmitted, is
+ * completed by bxCAN. Abort interrupt then refills the mailbox.
+ *
  * @param CANmodule This object.
  */
 void CO_CANclearPendingSyncPDOs(CO_CANmodule_t *CANmodule);
@@ -457,35 +2445,214 @@ void CO_CANclearPendingSyncPDOs(CO_CANmodule_t *CANmodule);
 /**
  * Verify all errors of CAN module.
  *
- * Function is called directly from CO_EM_process() function.
+ * Function is called directly from CO_EM_process() function. With
+ * CO_CAN_BUSOFF_RECOVERY it also runs bus-off recovery, so it must be called
+ * cyclically, also in NMT stopped state.
  *
  * @param CANmodule This object.
  */
 void CO_CANverifyErrors(CO_CANmodule_t *CANmodule);
 
+#if CO_CAN_STATISTICS > 0
+/**
+ * Get snapshot of CAN bus and driver statistics.
+ *
+ * Counters are copied consistently, TEC and REC are read from the error
+ * status register (ESR) at the time of the call.
+ *
+ * @param CANmodule This object.
+ * @param stats Pointer to the copy of statistics.
+ */
+void CO_CANgetStatistics(CO_CANmodule_t *CANmodule, CO_CANstatistics_t *stats);
+
+
+/**
+ * Reset all CAN statistics counters to zero.
+ *
+ * @param CANmodule This object.
+ */
+void CO_CANresetStatistics(CO_CANmodule_t *CANmodule);
+#endif
+
+#if CO_CAN_TX_LATENCY > 0
+/**
+ * Get snapshot of transmit latency of a transmit buffer.
+ *
+ * @param CANmodule This object.
+ * @param ident 11-bit CAN identifier of the transmit buffer.
+ * @param latency Pointer to the copy of latency, cleared if buffer is not found.
+ *
+ * @return True, if transmit buffer with ident exists.
+ */
+bool_t CO_CANgetTxLatency(CO_CANmodule_t *CANmodule, uint16_t ident, CO_CANtxLatency_t *latency);
+
+
+/**
+ * Reset transmit latency of all transmit buffers.
+ *
+ * @param CANmodule This object.
+ */
+void CO_CANresetTxLatency(CO_CANmodule_t *CANmodule);
+#endif
+
+#if CO_CAN_TX_LOOPBACK > 0
+/**
+ * Keep frames of an identifier inside the CANmodule, see CO_CAN_TX_LOOPBACK.
+ *
+ * CO_CANsend() then passes the frame to the local receive buffer only, it is
+ * not transmitted, if nothing outside of the device consumes it. Setting is
+ * kept over CO_CANtxBufferInit() and is cleared by CO_CANmodule_init(), so it
+ * is set again after each communication reset.
+ *
+ * @param CANmodule This object.
+ * @param ident 11-bit CAN identifier, 0x180 to 0x57F.
+ * @param localOnly True to stop transmission, false to transmit again.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_CANtxSetLocalOnly(CO_CANmodule_t *CANmodule, uint16_t ident, bool_t localOnly);
+#endif
+
+#if CO_CAN_BUSLOAD > 0
+/**
+ * Take bits of frames on the bus, see CO_CAN_BUSLOAD.
+ *
+ * @param CANmodule This object.
+ *
+ * @return Sum of frame lengths in bits since previous call. Counter is cleared.
+ */
+uint32_t CO_CANbusLoadBits(CO_CANmodule_t *CANmodule);
+#endif
+
 /**
  * Receives CAN messages.
  *
  * \detail Function must be called directly from high priority CAN interrupt.
- * e.g. CAN1_TX0_IRQHandler for CubeMx HAL libs.
+ * e.g. HAL_CAN_RxFifo0MsgPendingCallback for CubeMx HAL libs. All messages
+ * waiting in the hardware FIFO are processed in one call.
+ *
+ * @param CANmodule This object.
+ * @param fifo Receive FIFO, CAN_RX_FIFO0 or CAN_RX_FIFO1.
+ */
+void CO_CANinterrupt_Rx(CO_CANmodule_t *CANmodule, uint32_t fifo);
+
+#if CO_CAN_RX_RING > 0
+/**
+ * Processes frames from the receive ring, see CO_CAN_RX_RING.
+ *
+ * \details Function passes frames, stored by CO_CANinterrupt_Rx(), to their
+ * receive buffers, in order of reception. It must be called from single
+ * thread, cyclically, before CO_process_SYNC_RPDO(). Receive functions of
+ * CANopen objects run inside it instead of inside interrupt.
  *
  * @param CANmodule This object.
+ * @param maxFrames Maximum number of frames processed in one call, remaining
+ * frames stay in the ring.
+ * @return Number of processed frames.
+ */
+uint16_t CO_CANrxRingProcess(CO_CANmodule_t *CANmodule, uint16_t maxFrames);
+#endif
+
+#if CO_CAN_RX_DIRECT > 0
+/**
+ * Receive interrupt handler for direct register reception.
+ *
+ * \details Function must be called at the beginning of CAN1_RX0_IRQHandler
+ * and CAN1_RX1_IRQHandler (USER CODE section). If it returns true, all received
+ * messages were processed and HAL_CAN_IRQHandler() must be skipped.
+ *
+ * @param hcan HAL CAN handle, which generated interrupt.
+ * @param fifo Receive FIFO, CAN_RX_FIFO0 or CAN_RX_FIFO1.
+ * @return true if interrupt was handled.
  */
-void CO_CANinterrupt_Rx(const CO_CANmodule_t *CANmodule);
+bool_t CO_CANirqHandler_Rx(CAN_HandleTypeDef *hcan, uint32_t fifo);
+#endif
 
 /**
  * Transmits CAN messages.
  *
- * \details Originally function must be called directly from high priority CAN interrupt.
- * e.g. CAN1_RX0_IRQHandler for CubeMx HAL libs.
- * But in the case of CubeMX HAL, transmission is done by polling.
- * So for correct operation
+ * \details Function is called from HAL_CAN_TxMailboxXCompleteCallback() for
+ * CubeMx HAL libs, when transmit mailbox gets free. It copies waiting
+ * messages from CO_CANtx_t buffers into all free mailboxes.
  *
  * @param CANmodule This object.
  */
+void CO_CANinterrupt_Tx(CO_CANmodule_t *CANmodule);
 
+/**
+ * Transmits CAN messages by polling.
+ *
+ * \details Transmission is done by CO_CANinterrupt_Tx() from CAN TX interrupt.
+ * Function may be called cyclically to restart transmission, if interrupt was
+ * not generated (e.g. CAN_IT_TX_MAILBOX_EMPTY disabled).
+ *
+ * @param CANmodule This object.
+ */
 void CO_CANpolling_Tx(CO_CANmodule_t *CANmodule);
 
+#if CO_EM_LOCK_FREE > 0
+/**
+ * Atomic OR on byte variable.
+ *
+ * @param p Variable.
+ * @param mask Bits to set.
+ *
+ * @return Previous value.
+ */
+uint8_t CO_atomicFetchOr8(volatile uint8_t *p, uint8_t mask);
+
+/**
+ * Atomic AND on byte variable.
+ *
+ * @param p Variable.
+ * @param mask Bits to keep.
+ *
+ * @return Previous value.
+ */
+uint8_t CO_atomicFetchAnd8(volatile uint8_t *p, uint8_t mask);
+
+/**
+ * Atomic exchange of byte variable.
+ *
+ * @param p Variable.
+ * @param value New value.
+ *
+ * @return Previous value.
+ */
+uint8_t CO_atomicExchange8(volatile uint8_t *p, uint8_t value);
+
+/**
+ * Atomic compare and exchange of byte variable.
+ *
+ * @param p Variable.
+ * @param expected Value is written only, if variable is equal to expected.
+ * @param value New value.
+ *
+ * @return True, if value was written.
+ */
+bool_t CO_atomicCompareExchange8(volatile uint8_t *p, uint8_t expected, uint8_t value);
+
+/**
+ * Atomic OR on 32-bit variable.
+ *
+ * @param p Variable.
+ * @param mask Bits to set.
+ *
+ * @return Previous value.
+ */
+uint32_t CO_atomicFetchOr32(volatile uint32_t *p, uint32_t mask);
+
+/**
+ * Atomic AND on 32-bit variable.
+ *
+ * @param p Variable.
+ * @param mask Bits to keep.
+ *
+ * @return Previous value.
+ */
+uint32_t CO_atomicFetchAnd32(volatile uint32_t *p, uint32_t mask);
+#endif
+
 #ifdef __cplusplus
 }
 #endif /*__cplusplus*/
@@ -46,18 +46,592 @@
  */
 
 
+#include <stddef.h>
+#include <string.h>
 #include <CO_eeprom.h>
 #include "CO_driver.h"
 #include "CO_SDO.h"
 #include "CO_Emergency.h"
 #include "crc16-ccitt.h"
+#if CO_EE_BACKEND == CO_EE_BACKEND_I2C
+#include "i2c.h"
+#elif CO_EE_BACKEND == CO_EE_BACKEND_SPI
+#include "spi.h"
+#include "main.h"
+#endif
 
-/*EEPROM driver is not the part of this demonstration code*/
-//#include "bsp_eeprom.h"
+
+/* Addresses of stored blocks */
+#define EE_ADDR_EEPROM      0U
+#define EE_SLOT_SIZE(ee)    (sizeof(CO_EE_header_t) + (((ee)->OD_ROMSize + 3U) & ~3U))
+#define EE_ADDR_HEADER(ee, slot) ((((ee)->OD_EEPROMSize + 3U) & ~3U) + ((uint32_t)(slot) * EE_SLOT_SIZE(ee)))
+#define EE_ADDR_ROM(ee, slot) (EE_ADDR_HEADER(ee, slot) + sizeof(CO_EE_header_t))
+
+#define EE_SIZE             CO_EE_SIZE
+
+#if CO_EE_BACKEND == CO_EE_BACKEND_FLASH
+#define EE_FLASH_MAGIC      0x31454543UL    /* page header, "CEE1" */
+#define EE_FLASH_RECORD     8U              /* size of one record */
+#endif
+
+#if (CO_EE_BACKEND == CO_EE_BACKEND_I2C || CO_EE_BACKEND == CO_EE_BACKEND_SPI) && CO_EE_DMA > 0
+#define EE_USE_DMA
+#endif
+
+/* Values for CO_EE_t transfer */
+#define EE_TRANSFER_NONE    0U
+#define EE_TRANSFER_READ    1U
+#define EE_TRANSFER_WRITE   2U
+
+/* Values for CO_EE_t storeState */
+#define EE_STORE_IDLE       0U
+#define EE_STORE_ROM        1U
+#define EE_STORE_HEADER     2U
 
 
 static CO_SDO_abortCode_t CO_ODF_1010(CO_ODF_arg_t *ODF_arg);
 static CO_SDO_abortCode_t CO_ODF_1011(CO_ODF_arg_t *ODF_arg);
+#if CO_EE_DIRTY_RANGES > 0
+static void CO_EE_SDOwritten(void *object, const void *ODdata, uint16_t length);
+#endif
+static bool_t EE_init(CO_EE_t *ee);
+static void EE_readBlock(CO_EE_t *ee, uint8_t *data, uint32_t addr, uint32_t len);
+static bool_t EE_isWriteInProcess(CO_EE_t *ee);
+static bool_t EE_startWrite(CO_EE_t *ee, const uint8_t *data, uint32_t addr, uint32_t len);
+static bool_t EE_startRead(CO_EE_t *ee, uint8_t *data, uint32_t addr, uint32_t len);
+
+#ifdef EE_USE_DMA
+/* Object for HAL callbacks, which have no user argument */
+static CO_EE_t *EE_object = NULL;
+#endif
+
+
+#if CO_EE_BACKEND == CO_EE_BACKEND_FLASH
+/*
+ * Address of the page in the flash ring.
+ */
+static uint32_t EE_flashPageAddress(uint8_t page){
+    return CO_EE_FLASH_ADDRESS + ((uint32_t)page * CO_EE_FLASH_PAGE_SIZE);
+}
+
+
+/*
+ * Erase one page of the flash ring. Flash must be unlocked.
+ */
+static bool_t EE_flashErase(uint8_t page){
+    FLASH_EraseInitTypeDef erase;
+    uint32_t pageError;
+
+    erase.TypeErase = FLASH_TYPEERASE_PAGES;
+    erase.Banks = FLASH_BANK_1;
+    erase.Page = (EE_flashPageAddress(page) - FLASH_BASE) / FLASH_PAGE_SIZE;
+    erase.NbPages = CO_EE_FLASH_PAGE_SIZE / FLASH_PAGE_SIZE;
+
+    return (HAL_FLASHEx_Erase(&erase, &pageError) == HAL_OK) ? true : false;
+}
+
+
+/*
+ * Program one double word. Flash must be unlocked.
+ */
+static bool_t EE_flashProgram(uint32_t addr, uint32_t low, uint32_t high){
+    uint64_t dw = ((uint64_t)high << 32) | low;
+
+    return (HAL_FLASH_Program(FLASH_TYPEPROGRAM_DOUBLEWORD, addr, dw) == HAL_OK) ? true : false;
+}
+
+
+/*
+ * Build table of the latest records from the active page.
+ */
+static void EE_flashScan(CO_EE_t *ee){
+    uint32_t base = EE_flashPageAddress(ee->flashPage);
+    uint32_t offset;
+    uint16_t i;
+
+    for(i=0U; i<CO_EE_FLASH_WORDS; i++){
+        ee->flashWordOffset[i] = 0U;
+    }
+
+    for(offset=EE_FLASH_RECORD; offset<CO_EE_FLASH_PAGE_SIZE; offset+=EE_FLASH_RECORD){
+        uint32_t low = *((const volatile uint32_t*)(base + offset));
+        uint32_t high = *((const volatile uint32_t*)(base + offset + 4U));
+        uint16_t word = (uint16_t)low;
+
+        if(low == 0xFFFFFFFFUL && high == 0xFFFFFFFFUL){
+            break;  /* end of log */
+        }
+        /* skip records with broken address */
+        if((uint16_t)(low >> 16) == (uint16_t)~word && word < CO_EE_FLASH_WORDS){
+            ee->flashWordOffset[word] = (uint16_t)offset;
+        }
+    }
+    ee->flashWriteOffset = offset;
+}
+
+
+/*
+ * Copy the latest records into the next page in the ring. Header of the new
+ * page is written last, so old page stays valid until copy is complete.
+ */
+static bool_t EE_flashCopy(CO_EE_t *ee){
+    uint8_t next = (uint8_t)((ee->flashPage + 1U) % CO_EE_FLASH_PAGES);
+    uint32_t src = EE_flashPageAddress(ee->flashPage);
+    uint32_t dst = EE_flashPageAddress(next);
+    uint32_t offset = EE_FLASH_RECORD;
+    uint16_t i;
+
+    if(!EE_flashErase(next)){
+        return false;
+    }
+    for(i=0U; i<CO_EE_FLASH_WORDS; i++){
+        if(ee->flashWordOffset[i] != 0U){
+            const volatile uint32_t *rec = (const volatile uint32_t*)(src + ee->flashWordOffset[i]);
+
+            if(!EE_flashProgram(dst + offset, rec[0], rec[1])){
+                return false;
+            }
+            ee->flashWordOffset[i] = (uint16_t)offset;
+            offset += EE_FLASH_RECORD;
+        }
+    }
+    if(!EE_flashProgram(dst, EE_FLASH_MAGIC, ee->flashEraseCount + 1U)){
+        return false;
+    }
+
+    ee->flashPage = next;
+    ee->flashEraseCount++;
+    ee->flashWriteOffset = offset;
+    return true;
+}
+
+
+/*
+ * Read virtual word, 0xFFFFFFFF if never written.
+ */
+static uint32_t EE_flashReadWord(CO_EE_t *ee, uint16_t word){
+    uint16_t offset = ee->flashWordOffset[word];
+
+    if(offset == 0U){
+        return 0xFFFFFFFFUL;
+    }
+    return *((const volatile uint32_t*)(EE_flashPageAddress(ee->flashPage) + offset + 4U));
+}
+
+
+/*
+ * Append record for virtual word, if value differs. Flash must be unlocked.
+ */
+static bool_t EE_flashWriteWord(CO_EE_t *ee, uint16_t word, uint32_t value){
+    uint32_t addr;
+
+    if(EE_flashReadWord(ee, word) == value){
+        return true;
+    }
+    if((ee->flashWriteOffset + EE_FLASH_RECORD) > CO_EE_FLASH_PAGE_SIZE){
+        if(!EE_flashCopy(ee)){
+            return false;
+        }
+    }
+
+    addr = EE_flashPageAddress(ee->flashPage) + ee->flashWriteOffset;
+    if(!EE_flashProgram(addr, ((uint32_t)(uint16_t)~word << 16) | word, value)){
+        return false;
+    }
+    ee->flashWordOffset[word] = (uint16_t)ee->flashWriteOffset;
+    ee->flashWriteOffset += EE_FLASH_RECORD;
+    return true;
+}
+
+
+/*
+ * Find the valid page with the highest erase counter. Initialize empty flash.
+ */
+static bool_t EE_init(CO_EE_t *ee){
+    bool_t found = false;
+    bool_t ret = true;
+    uint8_t page;
+
+    for(page=0U; page<CO_EE_FLASH_PAGES; page++){
+        const volatile uint32_t *hdr = (const volatile uint32_t*)EE_flashPageAddress(page);
+
+        if(hdr[0] == EE_FLASH_MAGIC &&
+            (!found || (int32_t)(hdr[1] - ee->flashEraseCount) > 0)
+        ){
+            ee->flashPage = page;
+            ee->flashEraseCount = hdr[1];
+            found = true;
+        }
+    }
+
+    if(!found){
+        ee->flashPage = 0U;
+        ee->flashEraseCount = 0U;
+        HAL_FLASH_Unlock();
+        __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_ALL_ERRORS);
+        ret = EE_flashErase(0U) && EE_flashProgram(EE_flashPageAddress(0U), EE_FLASH_MAGIC, 0U);
+        HAL_FLASH_Lock();
+    }
+
+    EE_flashScan(ee);
+    return ret;
+}
+
+
+static void EE_readBlock(CO_EE_t *ee, uint8_t *data, uint32_t addr, uint32_t len){
+    while(len > 0U){
+        uint32_t value = EE_flashReadWord(ee, (uint16_t)(addr / 4U));
+        uint32_t shift = (addr % 4U) * 8U;
+
+        do{
+            *data++ = (uint8_t)(value >> shift);
+            shift += 8U;
+            addr++;
+            len--;
+        }while(len > 0U && shift < 32U);
+    }
+}
+
+
+static bool_t EE_writeBlock(CO_EE_t *ee, const uint8_t *data, uint32_t addr, uint32_t len){
+    bool_t ret = true;
+
+    HAL_FLASH_Unlock();
+    __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_ALL_ERRORS);
+    while(len > 0U && ret){
+        uint16_t word = (uint16_t)(addr / 4U);
+        uint32_t value = EE_flashReadWord(ee, word);
+        uint32_t shift = (addr % 4U) * 8U;
+
+        /* modify only bytes inside the block */
+        do{
+            value &= ~((uint32_t)0xFFU << shift);
+            value |= (uint32_t)*data++ << shift;
+            shift += 8U;
+            addr++;
+            len--;
+        }while(len > 0U && shift < 32U);
+
+        ret = EE_flashWriteWord(ee, word, value);
+    }
+    HAL_FLASH_Lock();
+
+    return ret;
+}
+
+
+static bool_t EE_isWriteInProcess(CO_EE_t *ee){
+    (void)ee;
+    return false;
+}
+
+
+/* records are programmed by CPU, function returns after write */
+static bool_t EE_startWrite(CO_EE_t *ee, const uint8_t *data, uint32_t addr, uint32_t len){
+    return EE_writeBlock(ee, data, addr, len);
+}
+
+
+static bool_t EE_startRead(CO_EE_t *ee, uint8_t *data, uint32_t addr, uint32_t len){
+    EE_readBlock(ee, data, addr, len);
+    return true;
+}
+
+#elif CO_EE_BACKEND == CO_EE_BACKEND_I2C
+static bool_t EE_init(CO_EE_t *ee){
+    (void)ee;
+    return (HAL_I2C_IsDeviceReady(&hi2c1, CO_EE_I2C_DEV_ADDRESS, 3U, CO_EE_EXT_TIMEOUT) == HAL_OK) ? true : false;
+}
+
+
+static void EE_readBlock(CO_EE_t *ee, uint8_t *data, uint32_t addr, uint32_t len){
+    (void)ee;
+    (void)HAL_I2C_Mem_Read(&hi2c1, CO_EE_I2C_DEV_ADDRESS, (uint16_t)addr, I2C_MEMADD_SIZE_16BIT,
+                           data, (uint16_t)len, CO_EE_EXT_TIMEOUT);
+}
+
+
+/* eeprom does not acknowledge its address during internal write cycle */
+static bool_t EE_isWriteInProcess(CO_EE_t *ee){
+    (void)ee;
+    return (HAL_I2C_IsDeviceReady(&hi2c1, CO_EE_I2C_DEV_ADDRESS, 1U, 1U) != HAL_OK) ? true : false;
+}
+
+
+static bool_t EE_startWrite(CO_EE_t *ee, const uint8_t *data, uint32_t addr, uint32_t len){
+    HAL_StatusTypeDef status;
+
+#ifdef EE_USE_DMA
+    ee->transfer = EE_TRANSFER_WRITE;
+    status = HAL_I2C_Mem_Write_DMA(&hi2c1, CO_EE_I2C_DEV_ADDRESS, (uint16_t)addr, I2C_MEMADD_SIZE_16BIT,
+                                   (uint8_t*)data, (uint16_t)len);
+    if(status != HAL_OK){
+        ee->transfer = EE_TRANSFER_NONE;
+    }
+#else
+    (void)ee;
+    status = HAL_I2C_Mem_Write(&hi2c1, CO_EE_I2C_DEV_ADDRESS, (uint16_t)addr, I2C_MEMADD_SIZE_16BIT,
+                               (uint8_t*)data, (uint16_t)len, CO_EE_EXT_TIMEOUT);
+#endif
+    return (status == HAL_OK) ? true : false;
+}
+
+
+static bool_t EE_startRead(CO_EE_t *ee, uint8_t *data, uint32_t addr, uint32_t len){
+#ifdef EE_USE_DMA
+    ee->transfer = EE_TRANSFER_READ;
+    if(HAL_I2C_Mem_Read_DMA(&hi2c1, CO_EE_I2C_DEV_ADDRESS, (uint16_t)addr, I2C_MEMADD_SIZE_16BIT,
+                            data, (uint16_t)len) != HAL_OK
+    ){
+        ee->transfer = EE_TRANSFER_NONE;
+        return false;
+    }
+#else
+    EE_readBlock(ee, data, addr, len);
+#endif
+    return true;
+}
+
+
+#ifdef EE_USE_DMA
+/* HAL callbacks, called from I2C1 and DMA1 interrupts */
+void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c){
+    if(hi2c == &hi2c1 && EE_object != NULL){
+        EE_object->transfer = EE_TRANSFER_NONE;
+    }
+}
+
+
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c){
+    if(hi2c == &hi2c1 && EE_object != NULL){
+        EE_object->transfer = EE_TRANSFER_NONE;
+    }
+}
+
+
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c){
+    if(hi2c == &hi2c1 && EE_object != NULL){
+        EE_object->transferError = true;
+        EE_object->transfer = EE_TRANSFER_NONE;
+    }
+}
+#endif
+
+#elif CO_EE_BACKEND == CO_EE_BACKEND_SPI
+#define EE_SPI_WREN     0x06U   /* write enable */
+#define EE_SPI_RDSR     0x05U   /* read status register */
+#define EE_SPI_READ     0x03U
+#define EE_SPI_WRITE    0x02U
+#define EE_SPI_SR_WIP   0x01U   /* write in process bit */
+
+/*
+ * Send command with 16-bit address, chip select stays active.
+ */
+static void EE_spiCommand(uint8_t cmd, uint32_t addr, uint16_t size){
+    uint8_t buf[3];
+
+    buf[0] = cmd;
+    buf[1] = (uint8_t)(addr >> 8);
+    buf[2] = (uint8_t)addr;
+    HAL_GPIO_WritePin(EEP_SS_GPIO_Port, EEP_SS_Pin, GPIO_PIN_RESET);
+    (void)HAL_SPI_Transmit(&hspi3, buf, size, CO_EE_EXT_TIMEOUT);
+}
+
+
+static bool_t EE_init(CO_EE_t *ee){
+    (void)ee;
+    HAL_GPIO_WritePin(EEP_SS_GPIO_Port, EEP_SS_Pin, GPIO_PIN_SET);
+    return true;
+}
+
+
+static void EE_readBlock(CO_EE_t *ee, uint8_t *data, uint32_t addr, uint32_t len){
+    (void)ee;
+    EE_spiCommand(EE_SPI_READ, addr, 3U);
+    (void)HAL_SPI_Receive(&hspi3, data, (uint16_t)len, CO_EE_EXT_TIMEOUT);
+    HAL_GPIO_WritePin(EEP_SS_GPIO_Port, EEP_SS_Pin, GPIO_PIN_SET);
+}
+
+
+static bool_t EE_isWriteInProcess(CO_EE_t *ee){
+    uint8_t status = EE_SPI_SR_WIP;
+
+    (void)ee;
+    EE_spiCommand(EE_SPI_RDSR, 0U, 1U);
+    (void)HAL_SPI_Receive(&hspi3, &status, 1U, CO_EE_EXT_TIMEOUT);
+    HAL_GPIO_WritePin(EEP_SS_GPIO_Port, EEP_SS_Pin, GPIO_PIN_SET);
+
+    return ((status & EE_SPI_SR_WIP) != 0U) ? true : false;
+}
+
+
+static bool_t EE_startWrite(CO_EE_t *ee, const uint8_t *data, uint32_t addr, uint32_t len){
+    HAL_StatusTypeDef status;
+
+    EE_spiCommand(EE_SPI_WREN, 0U, 1U);
+    HAL_GPIO_WritePin(EEP_SS_GPIO_Port, EEP_SS_Pin, GPIO_PIN_SET);
+
+    /* command and address are short, data are sent by DMA */
+    EE_spiCommand(EE_SPI_WRITE, addr, 3U);
+#ifdef EE_USE_DMA
+    ee->transfer = EE_TRANSFER_WRITE;
+    status = HAL_SPI_Transmit_DMA(&hspi3, (uint8_t*)data, (uint16_t)len);
+    if(status != HAL_OK){
+        ee->transfer = EE_TRANSFER_NONE;
+        HAL_GPIO_WritePin(EEP_SS_GPIO_Port, EEP_SS_Pin, GPIO_PIN_SET);
+    }
+#else
+    (void)ee;
+    status = HAL_SPI_Transmit(&hspi3, (uint8_t*)data, (uint16_t)len, CO_EE_EXT_TIMEOUT);
+    HAL_GPIO_WritePin(EEP_SS_GPIO_Port, EEP_SS_Pin, GPIO_PIN_SET);
+#endif
+    return (status == HAL_OK) ? true : false;
+}
+
+
+static bool_t EE_startRead(CO_EE_t *ee, uint8_t *data, uint32_t addr, uint32_t len){
+#ifdef EE_USE_DMA
+    EE_spiCommand(EE_SPI_READ, addr, 3U);
+    ee->transfer = EE_TRANSFER_READ;
+    if(HAL_SPI_Receive_DMA(&hspi3, data, (uint16_t)len) != HAL_OK){
+        ee->transfer = EE_TRANSFER_NONE;
+        HAL_GPIO_WritePin(EEP_SS_GPIO_Port, EEP_SS_Pin, GPIO_PIN_SET);
+        return false;
+    }
+#else
+    EE_readBlock(ee, data, addr, len);
+#endif
+    return true;
+}
+
+
+#ifdef EE_USE_DMA
+/*
+ * End of SPI DMA transfer, called from SPI3 and DMA2 interrupts.
+ */
+static void EE_spiDone(SPI_HandleTypeDef *hspi, bool_t error){
+    if(hspi == &hspi3 && EE_object != NULL){
+        HAL_GPIO_WritePin(EEP_SS_GPIO_Port, EEP_SS_Pin, GPIO_PIN_SET);
+        if(error){
+            EE_object->transferError = true;
+        }
+        EE_object->transfer = EE_TRANSFER_NONE;
+    }
+}
+
+
+/* HAL callbacks. Receive in full duplex master mode finishes as TxRx. */
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi){
+    EE_spiDone(hspi, false);
+}
+
+
+void HAL_SPI_RxCpltCallback(SPI_HandleTypeDef *hspi){
+    EE_spiDone(hspi, false);
+}
+
+
+void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi){
+    EE_spiDone(hspi, false);
+}
+
+
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi){
+    EE_spiDone(hspi, true);
+}
+#endif
+
+#else
+static bool_t EE_init(CO_EE_t *ee){
+    (void)ee;
+    return true;
+}
+
+
+/* no storage, reads as erased eeprom */
+static void EE_readBlock(CO_EE_t *ee, uint8_t *data, uint32_t addr, uint32_t len){
+    (void)ee;
+    (void)addr;
+    while(len-- > 0U){
+        *data++ = 0xFFU;
+    }
+}
+
+
+static bool_t EE_isWriteInProcess(CO_EE_t *ee){
+    (void)ee;
+    return false;
+}
+
+
+static bool_t EE_startWrite(CO_EE_t *ee, const uint8_t *data, uint32_t addr, uint32_t len){
+    (void)ee;
+    (void)data;
+    (void)addr;
+    (void)len;
+    return true;
+}
+
+
+static bool_t EE_startRead(CO_EE_t *ee, uint8_t *data, uint32_t addr, uint32_t len){
+    EE_readBlock(ee, data, addr, len);
+    return true;
+}
+#endif
+
+
+/*
+ * Calculate CRC of the block stored in eeprom.
+ */
+static uint16_t EE_getCrc(CO_EE_t *ee, uint32_t addr, uint32_t len){
+    uint8_t buf[CO_EE_PAGE_SIZE];
+    uint16_t crc = 0U;
+
+    while(len > 0U){
+        uint32_t l = (len > CO_EE_PAGE_SIZE) ? CO_EE_PAGE_SIZE : len;
+
+        EE_readBlock(ee, buf, addr, l);
+        crc = crc16_ccitt(buf, l, crc);
+        addr += l;
+        len -= l;
+    }
+    return crc;
+}
+
+
+/*
+ * Calculate CRC of header members before headerCrc.
+ */
+static uint16_t EE_headerCrc(const CO_EE_header_t *header){
+    return crc16_ccitt((const unsigned char*)header,
+                       (unsigned int)offsetof(CO_EE_header_t, headerCrc), 0U);
+}
+
+
+/*
+ * Read header of the slot and verify it.
+ */
+static bool_t EE_readHeader(CO_EE_t *ee, uint8_t slot, CO_EE_header_t *header){
+    EE_readBlock(ee, (uint8_t*)header, EE_ADDR_HEADER(ee, slot), sizeof(CO_EE_header_t));
+
+    return (header->signature == CO_EE_SIGNATURE &&
+            header->headerCrc == EE_headerCrc(header)) ? true : false;
+}
+
+
+/*
+ * Prepare header for the store into the slot, which is not current.
+ */
+static void EE_prepareHeader(CO_EE_t *ee, uint32_t length){
+    ee->storeHeader.signature = CO_EE_SIGNATURE;
+    ee->storeHeader.version = CO_EE_VERSION;
+    ee->storeHeader.sequence = ee->romSequence + 1U;
+    ee->storeHeader.length = length;
+    ee->storeHeader.crc = 0U;
+    ee->storeHeader.headerCrc = 0U;
+    ee->storeOffset = 0U;
+}
+
 
 /**
  * OD function for accessing _Store parameters_ (index 0x1010) from SDO server.
@@ -74,24 +648,45 @@ static CO_SDO_abortCode_t CO_ODF_1010(CO_ODF_arg_t *ODF_arg){
     value = CO_getUint32(ODF_arg->data);
 
     if(!ODF_arg->reading){
-        /* don't change the old value */
-        CO_memcpy(ODF_arg->data, (const uint8_t*)ODF_arg->ODdataStorage, 4U);
-
         if(ODF_arg->subIndex == 1U){
             if(value == 0x65766173UL){
-
-                /* write ee->OD_ROMAddress, ee->OD_ROMSize to eeprom (blocking function) */
-                //bsp_eeprom_write(ee->OD_ROMAddress, , ee->OD_ROMSize);
-                /* verify data */
-
-                if(0/*error*/){
+                /* write ee->OD_ROMAddress, ee->OD_ROMSize to the other slot in
+                 * background, CRC is calculated from queued data, header is written last */
+#if CO_SDO_ODF_PENDING > 0
+                if(ODF_arg->resumed){
+                    /* SDO response after the snapshot is written */
+                    if(ee->storeState != EE_STORE_IDLE || ee->queueCount > 0U){
+                        return CO_SDO_AB_PENDING;
+                    }
+                    if(ee->storeError){
+                        ret = CO_SDO_AB_HW;
+                    }
+                }
+                else
+#endif
+                if(!ee->OD_EEPROMWriteEnable){
                     ret = CO_SDO_AB_HW;
                 }
+                else if(ee->storeState != EE_STORE_IDLE){
+                    ret = CO_SDO_AB_DATA_DEV_STATE;
+                }
+                else{
+                    EE_prepareHeader(ee, ee->OD_ROMSize);
+                    ee->storeState = EE_STORE_ROM;
+#if CO_SDO_ODF_PENDING > 0
+                    ee->storeSDO = ODF_arg->SDO;
+                    ee->storeError = false;
+                    return CO_SDO_AB_PENDING;
+#endif
+                }
             }
             else{
                 ret = CO_SDO_AB_DATA_TRANSF;
             }
         }
+
+        /* don't change the old value */
+        CO_memcpy(ODF_arg->data, (const uint8_t*)ODF_arg->ODdataStorage, 4U);
     }
 
     return ret;
@@ -117,8 +712,34 @@ static CO_SDO_abortCode_t CO_ODF_1011(CO_ODF_arg_t *ODF_arg){
 
         if(ODF_arg->subIndex >= 1U){
             if(value == 0x64616F6CUL){
-                /* Clear the eeprom */
-
+                /* write newer header without image, defaults are used after reset */
+#if CO_SDO_ODF_PENDING > 0
+                if(ODF_arg->resumed){
+                    /* SDO response after the header is written */
+                    if(ee->storeState != EE_STORE_IDLE || ee->queueCount > 0U){
+                        return CO_SDO_AB_PENDING;
+                    }
+                    if(ee->storeError){
+                        ret = CO_SDO_AB_HW;
+                    }
+                }
+                else
+#endif
+                if(!ee->OD_EEPROMWriteEnable){
+                    ret = CO_SDO_AB_HW;
+                }
+                else if(ee->storeState != EE_STORE_IDLE){
+                    ret = CO_SDO_AB_DATA_DEV_STATE;
+                }
+                else{
+                    EE_prepareHeader(ee, 0U);
+                    ee->storeState = EE_STORE_HEADER;
+#if CO_SDO_ODF_PENDING > 0
+                    ee->storeSDO = ODF_arg->SDO;
+                    ee->storeError = false;
+                    return CO_SDO_AB_PENDING;
+#endif
+                }
             }
             else{
                 ret = CO_SDO_AB_DATA_TRANSF;
@@ -138,14 +759,17 @@ CO_ReturnError_t CO_EE_init_1(
         uint8_t                *OD_ROMAddress,
         uint32_t                OD_ROMSize)
 {
+    CO_ReturnError_t ret = CO_ERROR_NO;
+    uint32_t firstWordRAM, firstWordEE, lastWordEE;
+    CO_EE_header_t header[2];
+    bool_t valid[2];
+    uint8_t i;
+
     /* verify arguments */
-    if(ee==NULL || OD_EEPROMAddress==NULL || OD_ROMAddress==NULL){
+    if(ee==NULL || OD_EEPROMAddress==NULL || OD_ROMAddress==NULL || OD_EEPROMSize<8U){
         return CO_ERROR_ILLEGAL_ARGUMENT;
     }
 
-    /* Configure eeprom */
-
-
     /* configure object variables */
     ee->OD_EEPROMAddress = OD_EEPROMAddress;
     ee->OD_EEPROMSize = OD_EEPROMSize;
@@ -153,12 +777,96 @@ CO_ReturnError_t CO_EE_init_1(
     ee->OD_ROMSize = OD_ROMSize;
     ee->OD_EEPROMCurrentIndex = 0U;
     ee->OD_EEPROMWriteEnable = false;
+    ee->queueHead = 0U;
+    ee->queueCount = 0U;
+    ee->queueBusy = false;
+    ee->transfer = EE_TRANSFER_NONE;
+    ee->transferError = false;
+    ee->readLen = 0U;
+    ee->storeState = EE_STORE_IDLE;
+#if CO_SDO_ODF_PENDING > 0
+    ee->storeSDO = NULL;
+    ee->storeError = false;
+#endif
+    ee->romSlot = 1U;
+    ee->romSequence = 0U;
+    ee->em = NULL;
+#ifdef EE_USE_DMA
+    EE_object = ee;
+#endif
+#if CO_EE_DIRTY_RANGES > 0
+    {
+        uint32_t i;
+
+        for(i=0U; i<CO_EE_DIRTY_WORDS; i++){
+            ee->dirtyPages[i] = 0U;
+        }
+        ee->scanTimer = 0U;
+    }
+    if(OD_EEPROMSize > (CO_EE_DIRTY_WORDS * 32U * CO_EE_PAGE_SIZE)){
+        return CO_ERROR_OUT_OF_MEMORY;
+    }
+#endif
+
+    if(CO_EE_REQUIRED_SIZE(OD_EEPROMSize, OD_ROMSize) > EE_SIZE){
+        return CO_ERROR_OUT_OF_MEMORY;
+    }
+
+    /* Configure eeprom */
+    if(!EE_init(ee)){
+        return CO_ERROR_DATA_CORRUPT;
+    }
 
     /* read the CO_OD_EEPROM from EEPROM, first verify, if data are OK */
+    CO_memcpy((uint8_t*)&firstWordRAM, OD_EEPROMAddress, 4U);
+    EE_readBlock(ee, (uint8_t*)&firstWordEE, EE_ADDR_EEPROM, 4U);
+    EE_readBlock(ee, (uint8_t*)&lastWordEE, EE_ADDR_EEPROM + OD_EEPROMSize - 4U, 4U);
+    if(firstWordRAM == firstWordEE && firstWordRAM == lastWordEE){
+        EE_readBlock(ee, OD_EEPROMAddress, EE_ADDR_EEPROM, OD_EEPROMSize);
+    }
+    else{
+        ret = CO_ERROR_DATA_CORRUPT;
+    }
+    ee->OD_EEPROMWriteEnable = true;
+
+    /* read headers of both OD_ROM slots, next store must be newer than both */
+    for(i=0U; i<2U; i++){
+        valid[i] = EE_readHeader(ee, i, &header[i]);
+    }
+    if(valid[0] || valid[1]){
+        /* newest valid slot first, older slot is a fall-back after torn store */
+        uint8_t slot = (valid[1] && (!valid[0] ||
+                        (int32_t)(header[1].sequence - header[0].sequence) > 0)) ? 1U : 0U;
+        bool_t loaded = false;
 
-    /* read the CO_OD_ROM from EEPROM and verify CRC */
+        ee->romSequence = header[slot].sequence;
+        for(i=0U; i<2U && !loaded; i++, slot ^= 1U){
+            const CO_EE_header_t *h = &header[slot];
 
-    return CO_ERROR_NO;
+            if(!valid[slot] || h->version != CO_EE_VERSION){
+                continue;
+            }
+            /* restored default parameters */
+            if(h->length == 0U){
+                loaded = true;
+            }
+            /* verify CRC before OD_ROM is overwritten, so defaults stay intact */
+            else if(h->length == OD_ROMSize &&
+                    EE_getCrc(ee, EE_ADDR_ROM(ee, slot), OD_ROMSize) == h->crc)
+            {
+                EE_readBlock(ee, OD_ROMAddress, EE_ADDR_ROM(ee, slot), OD_ROMSize);
+                loaded = true;
+            }
+            if(loaded){
+                ee->romSlot = slot;
+            }
+        }
+        if(!loaded){
+            ret = CO_ERROR_CRC;
+        }
+    }
+
+    return ret;
 }
 
 
@@ -169,62 +877,278 @@ void CO_EE_init_2(
         CO_SDO_t               *SDO,
         CO_EM_t                *em)
 {
+    ee->em = em;
     CO_OD_configure(SDO, OD_H1010_STORE_PARAM_FUNC, CO_ODF_1010, (void*)ee, 0, 0U);
     CO_OD_configure(SDO, OD_H1011_REST_PARAM_FUNC,  CO_ODF_1011, (void*)ee, 0, 0U);
+#if CO_EE_DIRTY_RANGES > 0
+    CO_SDO_initCallbackWrite(SDO, (void*)ee, CO_EE_SDOwritten);
+#endif
     if(eeStatus != CO_ERROR_NO){
         CO_errorReport(em, CO_EM_NON_VOLATILE_MEMORY, CO_EMC_HARDWARE, (uint32_t)eeStatus);
     }
 }
 
+
+#if CO_EE_DIRTY_RANGES > 0
+/*
+ * SDO server wrote variable from OD_EEPROM, see CO_SDO_initCallbackWrite().
+ */
+static void CO_EE_SDOwritten(void *object, const void *ODdata, uint16_t length){
+    CO_EE_setDirty((CO_EE_t*)object, ODdata, length);
+}
+
+
+/******************************************************************************/
+void CO_EE_setDirty(CO_EE_t *ee, const void *data, uint32_t length){
+    const uint8_t *start = (const uint8_t*)data;
+
+    if(ee != NULL && length > 0U && start >= ee->OD_EEPROMAddress &&
+       start < &ee->OD_EEPROMAddress[ee->OD_EEPROMSize]
+    ){
+        uint32_t first = (uint32_t)(start - ee->OD_EEPROMAddress);
+        uint32_t last = first + length - 1U;
+        uint32_t page;
+
+        if(last >= ee->OD_EEPROMSize){
+            last = ee->OD_EEPROMSize - 1U;
+        }
+
+        CO_LOCK_OD();
+        for(page = first / CO_EE_PAGE_SIZE; page <= last / CO_EE_PAGE_SIZE; page++){
+            ee->dirtyPages[page / 32U] |= 1UL << (page % 32U);
+        }
+        CO_UNLOCK_OD();
+    }
+}
+
+
 /*
- * Read one byte of data from eeprom.
- *
- * @param Addr Address in eeprom.
- *
- * @return Data byte read.
+ * Get and clear the first modified page, -1 if none.
  */
-static uint8_t EE_readByte(uint16_t Addr)
-{
-	uint8_t ReadBuffer[1];
-	//platform dependent, not the part of demo
-	//bsp_eeprom_read(Addr, &ReadBuffer[1], 1u);
-	return ReadBuffer[0];
+static int32_t EE_takeDirtyPage(CO_EE_t *ee){
+    int32_t page = -1;
+    uint32_t i;
+
+    CO_LOCK_OD();
+    for(i=0U; i<CO_EE_DIRTY_WORDS; i++){
+        uint32_t map = ee->dirtyPages[i];
+
+        if(map != 0U){
+            uint32_t bit = 0U;
+
+            while((map & 1UL) == 0U){
+                map >>= 1;
+                bit++;
+            }
+            ee->dirtyPages[i] &= ~(1UL << bit);
+            page = (int32_t)((i * 32U) + bit);
+            break;
+        }
+    }
+    CO_UNLOCK_OD();
+
+    return page;
 }
+#endif
+
 
 /*
- * Write one byte of data to eeprom. It triggers write, but it does not wait for
- * write cycle to complete. Before next write cycle, EE_isWriteInProcess must
- * be checked.
- *
- * @param Data Data byte to be written.
- * @param Dddr Address in eeprom, where data will be written.
+ * Copy up to one page of data into the write queue, page boundary is not
+ * crossed. Return number of bytes queued, 0 if queue is full.
+ */
+static uint32_t EE_queuePage(CO_EE_t *ee, uint32_t addr, const uint8_t *data, uint32_t len){
+    CO_EE_page_t *page;
+    uint32_t l;
+
+    if(ee->queueCount >= CO_EE_QUEUE_SIZE){
+        return 0U;
+    }
+    l = CO_EE_PAGE_SIZE - (addr % CO_EE_PAGE_SIZE);
+    if(l > len){
+        l = len;
+    }
+
+    page = &ee->queue[(ee->queueHead + ee->queueCount) % CO_EE_QUEUE_SIZE];
+    page->addr = addr;
+    page->len = l;
+
+    /* consistent copy of OD variables */
+    CO_LOCK_OD();
+    CO_memcpy(page->data, data, (uint16_t)l);
+    CO_UNLOCK_OD();
+
+    ee->queueCount++;
+    return l;
+}
+
+
+/*
+ * Write the oldest page from queue, one page at a time.
+ */
+static void EE_processQueue(CO_EE_t *ee){
+    if(ee->queueBusy && !EE_isWriteInProcess(ee)){
+        /* page is written, release it */
+        ee->queueBusy = false;
+        ee->queueHead = (uint8_t)((ee->queueHead + 1U) % CO_EE_QUEUE_SIZE);
+        ee->queueCount--;
+    }
+
+    if(!ee->queueBusy && ee->queueCount > 0U && !EE_isWriteInProcess(ee)){
+        CO_EE_page_t *page = &ee->queue[ee->queueHead];
+
+        if(EE_startWrite(ee, page->data, page->addr, page->len)){
+            ee->queueBusy = true;
+        }
+        else{
+            /* drop the page, it will be found by background compare */
+            ee->queueHead = (uint8_t)((ee->queueHead + 1U) % CO_EE_QUEUE_SIZE);
+            ee->queueCount--;
+            CO_errorReport(ee->em, CO_EM_NON_VOLATILE_MEMORY, CO_EMC_HARDWARE, 0U);
+#if CO_SDO_ODF_PENDING > 0
+            ee->storeError = true;
+#endif
+        }
+    }
+}
+
+
+/*
+ * Queue next part of OD_ROM block into the other slot and header at the end.
+ */
+static void EE_processStore(CO_EE_t *ee){
+    uint8_t slot = ee->romSlot ^ 1U;
+
+    if(ee->storeState == EE_STORE_ROM){
+        uint32_t l = EE_queuePage(ee, EE_ADDR_ROM(ee, slot) + ee->storeOffset,
+                                  &ee->OD_ROMAddress[ee->storeOffset],
+                                  ee->OD_ROMSize - ee->storeOffset);
+
+        if(l > 0U){
+            const CO_EE_page_t *page = &ee->queue[(ee->queueHead + ee->queueCount - 1U) % CO_EE_QUEUE_SIZE];
+
+            ee->storeHeader.crc = crc16_ccitt(page->data, l, ee->storeHeader.crc);
+            ee->storeOffset += l;
+            if(ee->storeOffset >= ee->OD_ROMSize){
+                ee->storeOffset = 0U;
+                ee->storeState = EE_STORE_HEADER;
+            }
+        }
+    }
+    else if(ee->storeState == EE_STORE_HEADER){
+        if(ee->storeOffset == 0U){
+            ee->storeHeader.headerCrc = EE_headerCrc(&ee->storeHeader);
+        }
+        ee->storeOffset += EE_queuePage(ee, EE_ADDR_HEADER(ee, slot) + ee->storeOffset,
+                                        (const uint8_t*)&ee->storeHeader + ee->storeOffset,
+                                        sizeof(ee->storeHeader) - ee->storeOffset);
+        if(ee->storeOffset >= sizeof(ee->storeHeader)){
+            /* header is queued, the slot becomes current */
+            ee->romSlot = slot;
+            ee->romSequence = ee->storeHeader.sequence;
+            ee->storeState = EE_STORE_IDLE;
+        }
+    }
+}
+
+
+/*
+ * Length of OD_EEPROM page, which starts at index.
  */
-static void EE_writeByteNoWait(uint8_t Data, uint32_t Addr){
-	//platform dependent, not the part of the demo
-	//bsp_eeprom_write(Addr, &Data, 1u);
-	;
+static uint32_t EE_pageLength(CO_EE_t *ee, uint32_t index){
+    uint32_t len = CO_EE_PAGE_SIZE - (index % CO_EE_PAGE_SIZE);
+
+    if(len > (ee->OD_EEPROMSize - index)){
+        len = ee->OD_EEPROMSize - index;
+    }
+    return len;
+}
+
+
+/******************************************************************************/
+bool_t CO_EE_isBusy(CO_EE_t *ee){
+    if(ee == NULL){
+        return false;
+    }
+    return (ee->storeState != EE_STORE_IDLE || ee->queueCount > 0U ||
+            ee->transfer != EE_TRANSFER_NONE) ? true : false;
 }
 
+
 /******************************************************************************/
 void CO_EE_process(CO_EE_t *ee){
-    if((ee != 0) && (ee->OD_EEPROMWriteEnable)){ //&& !isWriteInProcess()){
-        uint32_t i;
-        uint8_t RAMdata, eeData;
+    uint32_t i;
+
+    /* wait for DMA transfer */
+    if((ee == 0) || (!ee->OD_EEPROMWriteEnable) || (ee->transfer != EE_TRANSFER_NONE)){
+        return;
+    }
+    if(ee->transferError){
+        ee->transferError = false;
+        CO_errorReport(ee->em, CO_EM_NON_VOLATILE_MEMORY, CO_EMC_HARDWARE, 0U);
+#if CO_SDO_ODF_PENDING > 0
+        ee->storeError = true;
+#endif
+    }
+
+    EE_processQueue(ee);
+    if(ee->transfer != EE_TRANSFER_NONE){
+        return;
+    }
 
-        /* verify next word */
-        if(++ee->OD_EEPROMCurrentIndex == ee->OD_EEPROMSize){
-            ee->OD_EEPROMCurrentIndex = 0U;
+    /* finished background compare, queue page if data are different */
+    if(ee->readLen > 0U){
+        i = ee->readIndex;
+        if(memcmp(ee->readData, &ee->OD_EEPROMAddress[i], ee->readLen) == 0 ||
+           EE_queuePage(ee, EE_ADDR_EEPROM + i, &ee->OD_EEPROMAddress[i], ee->readLen) > 0U
+        ){
+            ee->readLen = 0U;
         }
+        return;
+    }
 
-        i = ee->OD_EEPROMCurrentIndex;
+    /* store parameters */
+    if(ee->storeState != EE_STORE_IDLE){
+        EE_processStore(ee);
+        return;
+    }
+#if CO_SDO_ODF_PENDING > 0
+    /* snapshot or header is written, SDO server sends response to 1010 or 1011 */
+    if(ee->storeSDO != NULL && ee->queueCount == 0U){
+        CO_SDO_ODFcomplete(ee->storeSDO);
+        ee->storeSDO = NULL;
+    }
+#endif
+
+#if CO_EE_DIRTY_RANGES > 0
+    /* modified page next, without compare */
+    if(ee->queueCount < CO_EE_QUEUE_SIZE){
+        int32_t page = EE_takeDirtyPage(ee);
 
-        /* read eeprom */
-        RAMdata = ee->OD_EEPROMAddress[i];
-        eeData = EE_readByte(i);
+        if(page >= 0){
+            i = (uint32_t)page * CO_EE_PAGE_SIZE;
+            (void)EE_queuePage(ee, EE_ADDR_EEPROM + i, &ee->OD_EEPROMAddress[i], EE_pageLength(ee, i));
+            return;
+        }
+    }
+    if(++ee->scanTimer < CO_EE_SCAN_PERIOD){
+        return;
+    }
+    ee->scanTimer = 0U;
+#endif
+
+    /* read next page for compare, when bus is free */
+    if(ee->queueCount == 0U && !EE_isWriteInProcess(ee)){
+        i = ee->OD_EEPROMCurrentIndex;
+        ee->readIndex = i;
+        ee->readLen = EE_pageLength(ee, i);
+        if(!EE_startRead(ee, ee->readData, EE_ADDR_EEPROM + i, ee->readLen)){
+            ee->readLen = 0U;
+        }
 
-        /* if bytes in EEPROM and in RAM are different, then write to EEPROM */
-        if(eeData != RAMdata){
-            EE_writeByteNoWait(RAMdata, i);
+        i += ee->readLen > 0U ? ee->readLen : CO_EE_PAGE_SIZE - (i % CO_EE_PAGE_SIZE);
+        if(i >= ee->OD_EEPROMSize){
+            i = 0U;
         }
+        ee->OD_EEPROMCurrentIndex = i;
     }
 }
@@ -63,9 +63,197 @@ extern "C" {
  * @{
  *
  * Storage of nonvolatile CANopen variables into the eeprom.
+ *
+ * OD_EEPROM block is stored continuously by CO_EE_process(), OD_ROM block is
+ * stored on request with _Store parameters_ (index 0x1010) and protected by
+ * CRC. Both blocks are kept in the same address space:
+ *  - OD_EEPROM at address 0,
+ *  - OD_ROM snapshot slot A after OD_EEPROM, aligned to 4,
+ *  - OD_ROM snapshot slot B after slot A.
+ *
+ * Each slot is a CO_EE_header_t followed by the OD_ROM image. Store writes
+ * into the slot, which doesn't hold the current snapshot, and the header is
+ * written last with incremented sequence number. At startup the newest slot
+ * with valid header is verified by CRC and loaded, otherwise the older slot is
+ * used. So torn write (reset or power loss during store) keeps the previous
+ * parameters. Header carries #CO_EE_VERSION, so snapshot from firmware with
+ * different OD layout is not loaded.
+ *
+ * Backend is selected with #CO_EE_BACKEND:
+ *  - CO_EE_BACKEND_FLASH emulates eeprom in internal flash. Flash area is a
+ *    ring of #CO_EE_FLASH_PAGES pages, reserved in the linker script. Active
+ *    page is a log of double-word records (virtual word address and 32-bit
+ *    value). New value is appended, erased flash is never rewritten. When the
+ *    page is full, the latest records are copied into the next page in the
+ *    ring and the old page is released, so erase cycles are spread over all
+ *    pages. Page header contains erase counter and is written last, so power
+ *    loss during copy leaves the previous page valid. Note: page erase stalls
+ *    instruction fetch for about 22 ms on single bank devices.
+ *  - CO_EE_BACKEND_I2C uses external eeprom (24xx series) on hi2c1.
+ *  - CO_EE_BACKEND_SPI uses external eeprom (25xx series) on hspi3, chip
+ *    select is EEP_SS pin.
+ *
+ * Writes are batched by #CO_EE_PAGE_SIZE: CO_EE_process() compares one page
+ * of OD_EEPROM per call and writes it with one operation, if it differs.
+ *
+ * With #CO_EE_DIRTY_RANGES, pages of OD_EEPROM written by SDO server or marked
+ * by CO_EE_setDirty() are written first, without compare. Other pages are
+ * compared in background only once per #CO_EE_SCAN_PERIOD calls, which still
+ * stores variables, which application changes directly.
+ *
+ * CO_EE_process() never waits for the eeprom. Pages are copied into a write
+ * queue of #CO_EE_QUEUE_SIZE entries and one page is written at a time. With
+ * #CO_EE_DMA, external eeprom is accessed by HAL DMA transfers, which finish
+ * in HAL completion callbacks, and end of the eeprom write cycle is polled by
+ * the next calls. _Store parameters_ and _Restore default parameters_ are
+ * also executed in background, use CO_EE_isBusy() before reset. With
+ * #CO_SDO_ODF_PENDING, SDO response to both is sent after the snapshot or the
+ * header is written, or the transfer is aborted with CO_SDO_AB_HW, if a write
+ * failed meanwhile. Hardware errors are reported with
+ * CO_EM_NON_VOLATILE_MEMORY emergency.
  */
 
 
+#define CO_EE_BACKEND_NONE     0   /**< Nothing is stored */
+#define CO_EE_BACKEND_FLASH    1   /**< Emulated eeprom in internal flash */
+#define CO_EE_BACKEND_I2C      2   /**< External I2C eeprom on hi2c1 */
+#define CO_EE_BACKEND_SPI      3   /**< External SPI eeprom on hspi3 */
+
+/** Storage backend, one of CO_EE_BACKEND_xxx */
+#ifndef CO_EE_BACKEND
+#define CO_EE_BACKEND          CO_EE_BACKEND_FLASH
+#endif
+
+/** Number of bytes compared and written by one CO_EE_process() call. For
+ * external eeprom it must divide the device page size. */
+#ifndef CO_EE_PAGE_SIZE
+#define CO_EE_PAGE_SIZE        32U
+#endif
+
+/** Start of flash area for CO_EE_BACKEND_FLASH. Must match EEPROM region in
+ * the linker script. */
+#ifndef CO_EE_FLASH_ADDRESS
+#define CO_EE_FLASH_ADDRESS    0x0801E000UL
+#endif
+
+/** Size of one flash page in the ring, multiple of FLASH_PAGE_SIZE */
+#ifndef CO_EE_FLASH_PAGE_SIZE
+#define CO_EE_FLASH_PAGE_SIZE  4096U
+#endif
+
+/** Number of flash pages in the ring, 2 or more */
+#ifndef CO_EE_FLASH_PAGES
+#define CO_EE_FLASH_PAGES      2U
+#endif
+
+/** Number of 32-bit words in emulated eeprom. All words must fit into one
+ * flash page after copy, the rest of the page is free for new records. Must
+ * hold OD_EEPROM and both OD_ROM slots, see #CO_EE_REQUIRED_SIZE. */
+#ifndef CO_EE_FLASH_WORDS
+#define CO_EE_FLASH_WORDS      448U
+#endif
+
+/** Version of OD_ROM snapshot, stored in CO_EE_header_t. Increment it, when
+ * OD_ROM layout changes without change of its size. */
+#ifndef CO_EE_VERSION
+#define CO_EE_VERSION          1U
+#endif
+
+/** Size of external eeprom in bytes */
+#ifndef CO_EE_EXT_SIZE
+#define CO_EE_EXT_SIZE         4096U
+#endif
+
+/** I2C device address (8-bit form) of external eeprom */
+#ifndef CO_EE_I2C_DEV_ADDRESS
+#define CO_EE_I2C_DEV_ADDRESS  0xA0U
+#endif
+
+/** Timeout for external eeprom operations in milliseconds */
+#ifndef CO_EE_EXT_TIMEOUT
+#define CO_EE_EXT_TIMEOUT      10U
+#endif
+
+/** Number of pages in write queue */
+#ifndef CO_EE_QUEUE_SIZE
+#define CO_EE_QUEUE_SIZE       4U
+#endif
+
+/** If 1, external eeprom is accessed with DMA (hi2c1 DMA1 channels 6/7,
+ * hspi3 DMA2 channels 2/1). Internal flash is always programmed by CPU. */
+#ifndef CO_EE_DMA
+#define CO_EE_DMA              1
+#endif
+
+/** If 1, modified pages of OD_EEPROM are tracked, see CO_EE_setDirty() */
+#ifndef CO_EE_DIRTY_RANGES
+#define CO_EE_DIRTY_RANGES     1
+#endif
+
+/** Number of 32-bit words in map of modified pages. OD_EEPROM must be smaller
+ * than CO_EE_DIRTY_WORDS * 32 * CO_EE_PAGE_SIZE. */
+#ifndef CO_EE_DIRTY_WORDS
+#define CO_EE_DIRTY_WORDS      1U
+#endif
+
+/** With CO_EE_DIRTY_RANGES, number of CO_EE_process() calls between two
+ * background page compares */
+#ifndef CO_EE_SCAN_PERIOD
+#define CO_EE_SCAN_PERIOD      100U
+#endif
+
+#if CO_EE_BACKEND == CO_EE_BACKEND_FLASH
+#if (CO_EE_FLASH_PAGES < 2U)
+#error CO_EE_FLASH_PAGES must be 2 or more
+#endif
+#if ((CO_EE_FLASH_WORDS * 8U) + 8U) >= CO_EE_FLASH_PAGE_SIZE
+#error CO_EE_FLASH_WORDS does not fit into CO_EE_FLASH_PAGE_SIZE
+#endif
+#endif
+
+
+/** Value of CO_EE_header_t signature */
+#define CO_EE_SIGNATURE        0x4F43U
+
+/**
+ * Header of OD_ROM snapshot slot, stored before OD_ROM image.
+ */
+typedef struct{
+    uint16_t     signature;             /**< CO_EE_SIGNATURE */
+    uint16_t     version;               /**< CO_EE_VERSION */
+    uint32_t     sequence;              /**< Incremented by each store, newest slot is used */
+    uint32_t     length;                /**< Size of stored OD_ROM image, 0 after restore defaults */
+    uint16_t     crc;                   /**< crc16_ccitt() of stored OD_ROM image */
+    uint16_t     headerCrc;             /**< crc16_ccitt() of previous members */
+}CO_EE_header_t;
+
+
+/** Size of eeprom in bytes, available for OD_EEPROM and OD_ROM slots */
+#if CO_EE_BACKEND == CO_EE_BACKEND_FLASH
+#define CO_EE_SIZE             (CO_EE_FLASH_WORDS * 4U)
+#else
+#define CO_EE_SIZE             CO_EE_EXT_SIZE
+#endif
+
+/** Bytes used by OD_EEPROM followed by two OD_ROM slots (A/B), each with its
+ * own CO_EE_header_t. Must not exceed #CO_EE_SIZE, else CO_EE_init_1() returns
+ * CO_ERROR_OUT_OF_MEMORY. Application can check it at compile time with
+ * sizeof(CO_OD_EEPROM) and sizeof(CO_OD_ROM). */
+#define CO_EE_REQUIRED_SIZE(OD_EEPROMSize, OD_ROMSize) \
+    ((((uint32_t)(OD_EEPROMSize) + 3U) & ~3U) + \
+     (2U * (sizeof(CO_EE_header_t) + (((uint32_t)(OD_ROMSize) + 3U) & ~3U))))
+
+
+/**
+ * Page of data in write queue.
+ */
+typedef struct{
+    uint32_t     addr;                  /**< Address in eeprom */
+    uint32_t     len;                   /**< Number of bytes, up to CO_EE_PAGE_SIZE */
+    uint8_t      data[CO_EE_PAGE_SIZE]; /**< Copy of data */
+}CO_EE_page_t;
+
+
 /**
  * Eeprom object.
  */
@@ -76,6 +264,36 @@ typedef struct{
     uint32_t     OD_ROMSize;            /**< From CO_EE_init_1() */
     uint32_t     OD_EEPROMCurrentIndex; /**< Internal variable controls the OD_EEPROM vrite */
     bool_t       OD_EEPROMWriteEnable;  /**< Writing to EEPROM is enabled */
+#if CO_EE_DIRTY_RANGES > 0
+    uint32_t     dirtyPages[CO_EE_DIRTY_WORDS]; /**< Map of modified OD_EEPROM pages */
+    uint16_t     scanTimer;             /**< Counts calls to the next background compare */
+#endif
+    CO_EE_page_t queue[CO_EE_QUEUE_SIZE]; /**< Write queue */
+    uint8_t      queueHead;             /**< Index of the oldest page in queue */
+    uint8_t      queueCount;            /**< Number of pages in queue */
+    bool_t       queueBusy;             /**< Write of the oldest page was started */
+    volatile uint8_t transfer;          /**< DMA transfer in progress, cleared in HAL callback */
+    volatile bool_t  transferError;     /**< Set in HAL error callback */
+    uint8_t      readData[CO_EE_PAGE_SIZE]; /**< Data read for background compare */
+    uint32_t     readIndex;             /**< Index in OD_EEPROM of readData */
+    uint32_t     readLen;               /**< Length of readData, 0 if no read */
+    uint8_t      storeState;            /**< Background store of OD_ROM or header */
+    uint32_t     storeOffset;           /**< Number of bytes already queued by store */
+    CO_EE_header_t storeHeader;         /**< Header, which is written at the end of store */
+#if CO_SDO_ODF_PENDING > 0
+    void        *storeSDO;              /**< SDO server waiting for store, see CO_SDO_ODFcomplete() */
+    bool_t       storeError;            /**< Write failed since store was started */
+#endif
+    uint8_t      romSlot;               /**< Slot of the current OD_ROM snapshot, 0 or 1 */
+    uint32_t     romSequence;           /**< Sequence number of the newest valid header */
+    CO_EM_t     *em;                    /**< From CO_EE_init_2() */
+#if CO_EE_BACKEND == CO_EE_BACKEND_FLASH
+    uint8_t      flashPage;             /**< Active page in the flash ring */
+    uint32_t     flashEraseCount;       /**< Number of page copies, from page header */
+    uint32_t     flashWriteOffset;      /**< Offset of the next free record in active page */
+    /** Offset of the latest record for each virtual word in active page, 0 if none */
+    uint16_t     flashWordOffset[CO_EE_FLASH_WORDS];
+#endif
 }CO_EE_t;
 
 
@@ -88,8 +306,10 @@ typedef struct{
  * @param OD_ROMAddress Address of OD_ROM structure from object dictionary.
  * @param OD_ROMSize Size of OD_ROM structure from object dictionary.
  *
- * @return #CO_ReturnError_t: CO_ERROR_NO, CO_ERROR_DATA_CORRUPT (Data in eeprom corrupt) or
- * CO_ERROR_CRC (CRC from MBR does not match the CRC of OD_ROM block in eeprom).
+ * @return #CO_ReturnError_t: CO_ERROR_NO, CO_ERROR_ILLEGAL_ARGUMENT,
+ * CO_ERROR_OUT_OF_MEMORY (blocks don't fit into eeprom), CO_ERROR_DATA_CORRUPT
+ * (Data in eeprom corrupt) or CO_ERROR_CRC (OD_ROM snapshot exists, but no slot
+ * has valid CRC, version and length). Erased eeprom is not an error.
  */
 CO_ReturnError_t CO_EE_init_1(
         CO_EE_t                *ee,
@@ -114,11 +334,39 @@ void CO_EE_init_2(
         CO_EM_t                *em);
 
 
+#if CO_EE_DIRTY_RANGES > 0
+/**
+ * Mark range of OD_EEPROM as modified.
+ *
+ * Function should be called by application after it writes variable from
+ * OD_EEPROM. Range is then stored by the next CO_EE_process() calls. SDO
+ * server calls it automatically, see CO_SDO_initCallbackWrite(). Ranges
+ * outside OD_EEPROM are ignored.
+ *
+ * @param ee This object.
+ * @param data Address of modified variable.
+ * @param length Length of modified variable in bytes.
+ */
+void CO_EE_setDirty(CO_EE_t *ee, const void *data, uint32_t length);
+#endif
+
+
+/**
+ * Check, if eeprom has unfinished writes.
+ *
+ * @param ee This object.
+ *
+ * @return True, if store, restore or write queue is not finished yet.
+ */
+bool_t CO_EE_isBusy(CO_EE_t *ee);
+
+
 /**
  * Process eeprom object.
  *
  * Function must be called cyclically. It strores variables from OD_EEPROM data
- * block into eeprom byte by byte (only if values are different).
+ * block into eeprom page by page (only if values are different). It also
+ * executes store and restore requests. Function does not block.
  *
  * @param ee This object.
  */
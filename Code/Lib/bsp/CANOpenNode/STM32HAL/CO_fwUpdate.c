@@ -0,0 +1,367 @@
+/*
+ * CANopen program download into internal flash for STM32L4, CiA 302-3.
+ *
+ * @file        CO_fwUpdate.c
+ * @ingroup     CO_fwUpdate
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * CANopenNode is free and open source software: you can redistribute
+ * it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Following clarification and special exception to the GNU General Public
+ * License is included to the distribution terms of CANopenNode:
+ *
+ * Linking this library statically or dynamically with other modules is
+ * making a combined work based on this library. Thus, the terms and
+ * conditions of the GNU General Public License cover the whole combination.
+ *
+ * As a special exception, the copyright holders of this library give
+ * you permission to link this library with independent modules to
+ * produce an executable, regardless of the license terms of these
+ * independent modules, and to copy and distribute the resulting
+ * executable under terms of your choice, provided that you also meet,
+ * for each linked independent module, the terms and conditions of the
+ * license of that module. An independent module is a module which is
+ * not derived from or based on this library. If you modify this
+ * library, you may extend this exception to your version of the
+ * library, but you are not obliged to do so. If you do not wish
+ * to do so, delete this exception statement from your version.
+ */
+
+
+#include <string.h>
+#include "CO_driver.h"
+
+#if CO_FW_UPDATE > 0
+
+#include "CO_fwUpdate.h"
+#include "crc16-ccitt.h"
+
+/* Program control 0x1F51 commands */
+#define FW_STOP_PROGRAM     0U
+#define FW_START_PROGRAM    1U
+#define FW_RESET_PROGRAM    2U
+#define FW_CLEAR_PROGRAM    3U
+
+#define FW_PAGES            (CO_FW_FLASH_SIZE / FLASH_PAGE_SIZE)
+
+/* Load addresses of initialized data and RAM functions, from linker script */
+extern uint32_t _sidata, _sdata, _edata;
+extern uint32_t _siramfunc, _sramfunc, _eramfunc;
+
+
+/*
+ * Copy _length_ bytes of download region over the application and reset.
+ * Runs from RAM with interrupts disabled and flash unlocked, it must not call
+ * any function in flash.
+ */
+__attribute__((section(".ramfunc"), noinline, noreturn))
+static void CO_fwUpdate_copy(uint32_t length){
+    const volatile uint32_t *src = (const volatile uint32_t*)CO_FW_FLASH_ADDRESS;
+    volatile uint32_t *dst = (volatile uint32_t*)FLASH_BASE;
+    uint32_t offset;
+
+    for(offset = 0U; offset < length; offset += FLASH_PAGE_SIZE){
+        FLASH->CR = (FLASH->CR & ~FLASH_CR_PNB_Msk)
+                  | ((offset / FLASH_PAGE_SIZE) << FLASH_CR_PNB_Pos) | FLASH_CR_PER;
+        FLASH->CR |= FLASH_CR_STRT;
+        while((FLASH->SR & FLASH_SR_BSY) != 0U){
+            ;
+        }
+        FLASH->CR &= ~(FLASH_CR_PER | FLASH_CR_PNB_Msk);
+    }
+
+    FLASH->CR |= FLASH_CR_PG;
+    for(offset = 0U; offset < length; offset += 8U){
+        dst[(offset / 4U)] = src[(offset / 4U)];
+        __ISB();
+        dst[(offset / 4U) + 1U] = src[(offset / 4U) + 1U];
+        while((FLASH->SR & FLASH_SR_BSY) != 0U){
+            ;
+        }
+    }
+    FLASH->CR &= ~FLASH_CR_PG;
+
+    /* NVIC_SystemReset() is not always inlined */
+    __DSB();
+    SCB->AIRCR = (0x5FAUL << SCB_AIRCR_VECTKEY_Pos)
+               | (SCB->AIRCR & SCB_AIRCR_PRIGROUP_Msk) | SCB_AIRCR_SYSRESETREQ_Msk;
+    __DSB();
+    for(;;){
+        ;
+    }
+}
+
+
+/*
+ * Erase one page of download region.
+ */
+static bool_t CO_fwUpdate_erase(uint16_t page){
+    FLASH_EraseInitTypeDef erase;
+    uint32_t pageError;
+    bool_t ok;
+
+    erase.TypeErase = FLASH_TYPEERASE_PAGES;
+    erase.Banks = FLASH_BANK_1;
+    erase.Page = (CO_FW_FLASH_ADDRESS - FLASH_BASE) / FLASH_PAGE_SIZE + page;
+    erase.NbPages = 1U;
+
+    HAL_FLASH_Unlock();
+    __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_ALL_ERRORS);
+    ok = (HAL_FLASHEx_Erase(&erase, &pageError) == HAL_OK) ? true : false;
+    HAL_FLASH_Lock();
+
+    return ok;
+}
+
+
+/*
+ * Program carry at _offset_ in download region. Flash must be unlocked.
+ */
+static CO_SDO_abortCode_t CO_fwUpdate_program(CO_fwUpdate_t *fw, uint32_t offset){
+    uint64_t dw;
+
+    memcpy(&dw, fw->carry, sizeof(dw));
+    if(HAL_FLASH_Program(FLASH_TYPEPROGRAM_DOUBLEWORD, CO_FW_FLASH_ADDRESS + offset, dw) != HAL_OK){
+        *fw->flashStatus = CO_FW_STATUS_WRITE;
+        return CO_SDO_AB_HW;
+    }
+    return CO_SDO_AB_NONE;
+}
+
+
+/*
+ * Verify trailer and vector table of downloaded image.
+ */
+static CO_SDO_abortCode_t CO_fwUpdate_verify(CO_fwUpdate_t *fw){
+    const uint8_t *image = (const uint8_t*)CO_FW_FLASH_ADDRESS;
+    const uint32_t *vector = (const uint32_t*)CO_FW_FLASH_ADDRESS;
+    const uint8_t *trailer;
+    uint32_t length;
+    uint32_t magic;
+    uint16_t crc;
+
+    if(fw->length < (8U + CO_FW_TRAILER_SIZE)){
+        *fw->flashStatus = CO_FW_STATUS_FORMAT;
+        return CO_SDO_AB_DATA_SHORT;
+    }
+    length = fw->length - CO_FW_TRAILER_SIZE;
+    if(length > (CO_FW_FLASH_ADDRESS - FLASH_BASE)){
+        *fw->flashStatus = CO_FW_STATUS_ADDRESS;
+        return CO_SDO_AB_DATA_LONG;
+    }
+
+    trailer = &image[length];
+    magic = (uint32_t)trailer[0] | ((uint32_t)trailer[1] << 8)
+          | ((uint32_t)trailer[2] << 16) | ((uint32_t)trailer[3] << 24);
+    crc = crc16_ccitt(image, length, 0U);
+    if(magic != CO_FW_TRAILER_MAGIC
+       || ((uint16_t)trailer[4] | ((uint16_t)trailer[5] << 8)) != crc
+       || ((uint16_t)trailer[6] | ((uint16_t)trailer[7] << 8)) != (uint16_t)~crc
+       || vector[0] < SRAM1_BASE || vector[0] > (SRAM1_BASE + SRAM1_SIZE_MAX)
+       || vector[1] < FLASH_BASE || vector[1] >= CO_FW_FLASH_ADDRESS)
+    {
+        *fw->flashStatus = CO_FW_STATUS_FORMAT;
+        return CO_SDO_AB_DATA_TRANSF;
+    }
+
+    fw->imageLength = length;
+    *fw->programId = crc;
+    *fw->flashStatus = CO_FW_STATUS_OK;
+    return CO_SDO_AB_NONE;
+}
+
+
+/*
+ * Function for accessing _Program data_ (index 0x1F50) from SDO server.
+ */
+static CO_SDO_abortCode_t CO_ODF_1F50(CO_ODF_arg_t *ODF_arg){
+    CO_fwUpdate_t *fw = (CO_fwUpdate_t*)ODF_arg->object;
+    CO_SDO_abortCode_t ret = CO_SDO_AB_NONE;
+    uint16_t i;
+
+    if(ODF_arg->reading || ODF_arg->subIndex != 1U){
+        return CO_SDO_AB_NONE;
+    }
+
+    if(ODF_arg->firstSegment){
+        if(!fw->cleared){
+            *fw->flashStatus = CO_FW_STATUS_NOT_CLEARED;
+            return CO_SDO_AB_DATA_DEV_STATE;
+        }
+        if(ODF_arg->dataLengthTotal > CO_FW_FLASH_SIZE){
+            *fw->flashStatus = CO_FW_STATUS_ADDRESS;
+            return CO_SDO_AB_OUT_OF_MEM;
+        }
+        fw->cleared = false;
+        fw->length = 0U;
+        *fw->flashStatus = CO_FW_STATUS_BUSY;
+    }
+    else if((*fw->flashStatus & CO_FW_STATUS_BUSY) == 0U){
+        /* download failed before */
+        return CO_SDO_AB_DATA_DEV_STATE;
+    }
+    else{
+        ;/* next part of the image */
+    }
+
+    if((fw->length + ODF_arg->dataLength) > CO_FW_FLASH_SIZE){
+        *fw->flashStatus = CO_FW_STATUS_ADDRESS;
+        return CO_SDO_AB_OUT_OF_MEM;
+    }
+
+    HAL_FLASH_Unlock();
+    __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_ALL_ERRORS);
+    for(i = 0U; i < ODF_arg->dataLength && ret == CO_SDO_AB_NONE; i++){
+        fw->carry[fw->length & 7U] = ODF_arg->data[i];
+        fw->length++;
+        if((fw->length & 7U) == 0U){
+            ret = CO_fwUpdate_program(fw, fw->length - 8U);
+        }
+    }
+    if(ret == CO_SDO_AB_NONE && ODF_arg->lastSegment && (fw->length & 7U) != 0U){
+        /* pad the last double word with erased value */
+        memset(&fw->carry[fw->length & 7U], 0xFF, 8U - (fw->length & 7U));
+        ret = CO_fwUpdate_program(fw, fw->length & ~7UL);
+    }
+    HAL_FLASH_Lock();
+
+    if(ret == CO_SDO_AB_NONE && ODF_arg->lastSegment){
+        ret = CO_fwUpdate_verify(fw);
+    }
+
+    return ret;
+}
+
+
+/*
+ * Function for accessing _Program control_ (index 0x1F51) from SDO server.
+ */
+static CO_SDO_abortCode_t CO_ODF_1F51(CO_ODF_arg_t *ODF_arg){
+    CO_fwUpdate_t *fw = (CO_fwUpdate_t*)ODF_arg->object;
+
+    if(ODF_arg->reading || ODF_arg->subIndex != 1U){
+        return CO_SDO_AB_NONE;
+    }
+
+    switch(ODF_arg->data[0]){
+        case FW_STOP_PROGRAM:
+            break;
+        case FW_START_PROGRAM:
+        case FW_RESET_PROGRAM:
+            if(fw->imageLength == 0U || fw->erasing){
+                *fw->flashStatus = CO_FW_STATUS_NO_PROGRAM;
+                return CO_SDO_AB_DATA_DEV_STATE;
+            }
+            fw->swap = true;
+            fw->swapTimer = 0U;
+            break;
+        case FW_CLEAR_PROGRAM:
+            fw->erasing = true;
+            fw->erasePage = 0U;
+            fw->cleared = false;
+            fw->imageLength = 0U;
+            *fw->programId = 0U;
+            *fw->flashStatus = CO_FW_STATUS_BUSY;
+            break;
+        default:
+            return CO_SDO_AB_INVALID_VALUE;
+    }
+
+    return CO_SDO_AB_NONE;
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_fwUpdate_init(
+        CO_fwUpdate_t          *fw,
+        CO_SDO_t               *SDO)
+{
+    uint32_t dataEnd = (uint32_t)&_sidata + ((uint32_t)&_edata - (uint32_t)&_sdata);
+    uint32_t ramfuncEnd = (uint32_t)&_siramfunc + ((uint32_t)&_eramfunc - (uint32_t)&_sramfunc);
+    uint16_t entry1F51 = CO_OD_find(SDO, 0x1F51U);
+    uint16_t entry1F56 = CO_OD_find(SDO, 0x1F56U);
+    uint16_t entry1F57 = CO_OD_find(SDO, 0x1F57U);
+
+    /* verify arguments */
+    if(fw == NULL || entry1F51 == 0xFFFFU || entry1F56 == 0xFFFFU || entry1F57 == 0xFFFFU
+       || CO_OD_find(SDO, 0x1F50U) == 0xFFFFU)
+    {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+    /* download region must not overlap the running application */
+    if((CO_FW_FLASH_ADDRESS % FLASH_PAGE_SIZE) != 0U || (CO_FW_FLASH_SIZE % FLASH_PAGE_SIZE) != 0U
+       || dataEnd > CO_FW_FLASH_ADDRESS || ramfuncEnd > CO_FW_FLASH_ADDRESS)
+    {
+        return CO_ERROR_PARAMETERS;
+    }
+
+    fw->programControl = (uint8_t*)CO_OD_getDataPointer(SDO, entry1F51, 1U);
+    fw->programId = (uint32_t*)CO_OD_getDataPointer(SDO, entry1F56, 1U);
+    fw->flashStatus = (uint32_t*)CO_OD_getDataPointer(SDO, entry1F57, 1U);
+    fw->length = 0U;
+    fw->imageLength = 0U;
+    fw->erasePage = 0U;
+    fw->erasing = false;
+    fw->cleared = false;
+    fw->swap = false;
+    fw->swapTimer = 0U;
+
+    /* application is running */
+    *fw->programControl = FW_START_PROGRAM;
+    *fw->programId = 0U;
+    *fw->flashStatus = CO_FW_STATUS_NO_PROGRAM;
+
+    CO_OD_configure(SDO, 0x1F50U, CO_ODF_1F50, (void*)fw, 0, 0);
+    CO_OD_configure(SDO, 0x1F51U, CO_ODF_1F51, (void*)fw, 0, 0);
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+void CO_fwUpdate_process(
+        CO_fwUpdate_t          *fw,
+        uint16_t                timeDifference_ms)
+{
+    if(fw->erasing){
+        /* one page per call, CPU stalls on flash access during erase */
+        if(!CO_fwUpdate_erase(fw->erasePage)){
+            fw->erasing = false;
+            *fw->flashStatus = CO_FW_STATUS_WRITE;
+        }
+        else if(++fw->erasePage >= FW_PAGES){
+            fw->erasing = false;
+            fw->cleared = true;
+            *fw->flashStatus = CO_FW_STATUS_OK;
+        }
+        else{
+            ;/* next page in next call */
+        }
+    }
+
+    if(fw->swap){
+        fw->swapTimer += timeDifference_ms;
+        if(fw->swapTimer >= CO_FW_SWAP_DELAY_MS){
+            __disable_irq();
+            HAL_FLASH_Unlock();
+            __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_ALL_ERRORS);
+            CO_fwUpdate_copy((fw->imageLength + CO_FW_TRAILER_SIZE + 7U) & ~7UL);
+        }
+    }
+}
+
+#endif /* CO_FW_UPDATE > 0 */
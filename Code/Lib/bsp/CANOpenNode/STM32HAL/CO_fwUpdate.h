@@ -0,0 +1,178 @@
+/**
+ * CANopen program download into internal flash for STM32L4, CiA 302-3.
+ *
+ * @file        CO_fwUpdate.h
+ * @ingroup     CO_fwUpdate
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * CANopenNode is free and open source software: you can redistribute
+ * it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Following clarification and special exception to the GNU General Public
+ * License is included to the distribution terms of CANopenNode:
+ *
+ * Linking this library statically or dynamically with other modules is
+ * making a combined work based on this library. Thus, the terms and
+ * conditions of the GNU General Public License cover the whole combination.
+ *
+ * As a special exception, the copyright holders of this library give
+ * you permission to link this library with independent modules to
+ * produce an executable, regardless of the license terms of these
+ * independent modules, and to copy and distribute the resulting
+ * executable under terms of your choice, provided that you also meet,
+ * for each linked independent module, the terms and conditions of the
+ * license of that module. An independent module is a module which is
+ * not derived from or based on this library. If you modify this
+ * library, you may extend this exception to your version of the
+ * library, but you are not obliged to do so. If you do not wish
+ * to do so, delete this exception statement from your version.
+ */
+
+
+#ifndef CO_FW_UPDATE_H
+#define CO_FW_UPDATE_H
+
+#include "CO_driver.h"
+#include "CO_SDO.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_fwUpdate Program download
+ * @ingroup CO_driver
+ * @{
+ *
+ * New application is downloaded over SDO into download region of internal
+ * flash (#CO_FW_FLASH_ADDRESS, #CO_FW_FLASH_SIZE) and copied over the running
+ * application after verification. Enabled with CO_FW_UPDATE in CO_driver.h.
+ *
+ * Objects, CiA 302-3:
+ *  - 0x1F51,1 program control: 3 (clear program) erases download region,
+ *    one flash page per CO_fwUpdate_process() call; 1 (start program) or
+ *    2 (reset program) copies verified image and resets the device; 0 (stop
+ *    program) is accepted and ignored, there is no bootloader to stay in.
+ *  - 0x1F50,1 program data (domain): image, written into erased download
+ *    region as segments or blocks arrive. Each full double word is
+ *    programmed immediately, so no image buffer is needed. With block
+ *    transfer flash is programmed between blocks, while SDO client waits for
+ *    the block acknowledge.
+ *  - 0x1F56,1 program software identification: CRC of the verified image,
+ *    0 if there is none.
+ *  - 0x1F57,1 flash status identification: bit 0 is set while erase or
+ *    download is in progress, bits 1..7 are #CO_FW_STATUS_OK and similar.
+ *
+ * Image is the binary of the application (vector table at offset 0) followed
+ * by 8 byte trailer: #CO_FW_TRAILER_MAGIC, crc16_ccitt() of the binary and
+ * its complement, all little endian. Image with wrong trailer or with vector
+ * table outside of flash and RAM is rejected at the end of the download.
+ *
+ * There is only one flash bank, so the copy runs from RAM with interrupts
+ * disabled, erases the application pages and programs them from download
+ * region. It takes about 1.5 s for 60 kB and is not safe against power loss
+ * during that time. Application in linker script must end below
+ * #CO_FW_FLASH_ADDRESS, CO_fwUpdate_init() verifies that.
+ */
+
+
+/** Last word of the image trailer, "CFW1" */
+#define CO_FW_TRAILER_MAGIC         0x31574643UL
+/** Size of the image trailer */
+#define CO_FW_TRAILER_SIZE          8U
+
+/** Flash status 0x1F57: erase or download in progress */
+#define CO_FW_STATUS_BUSY           0x01UL
+/** Flash status 0x1F57: no error */
+#define CO_FW_STATUS_OK             (0UL << 1)
+/** Flash status 0x1F57: no valid program */
+#define CO_FW_STATUS_NO_PROGRAM     (1UL << 1)
+/** Flash status 0x1F57: data format error, wrong trailer or CRC */
+#define CO_FW_STATUS_FORMAT         (3UL << 1)
+/** Flash status 0x1F57: flash not cleared before write */
+#define CO_FW_STATUS_NOT_CLEARED    (4UL << 1)
+/** Flash status 0x1F57: flash write error */
+#define CO_FW_STATUS_WRITE          (5UL << 1)
+/** Flash status 0x1F57: image does not fit into download region */
+#define CO_FW_STATUS_ADDRESS        (6UL << 1)
+
+
+/**
+ * Program download object.
+ */
+typedef struct{
+    /** OD variable 0x1F51,1 */
+    uint8_t            *programControl;
+    /** OD variable 0x1F56,1 */
+    uint32_t           *programId;
+    /** OD variable 0x1F57,1 */
+    uint32_t           *flashStatus;
+    /** Bytes downloaded into region, full double words are programmed */
+    uint32_t            length;
+    /** Length of verified image without trailer, 0 if there is none */
+    uint32_t            imageLength;
+    /** Next page of download region to be erased */
+    uint16_t            erasePage;
+    /** True, while download region is erased */
+    bool_t              erasing;
+    /** True, if download region is erased and no data are written */
+    bool_t              cleared;
+    /** Bytes of the next double word, (length % 8) are valid */
+    uint8_t             carry[8];
+    /** True, if image is copied after swapTimer expires */
+    bool_t              swap;
+    /** Time since start program command, SDO response is sent meanwhile */
+    uint16_t            swapTimer;
+}CO_fwUpdate_t;
+
+
+/**
+ * Initialize program download.
+ *
+ * Function must be called in the communication reset section.
+ *
+ * @param fw This object will be initialized.
+ * @param SDO SDO server object.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO, CO_ERROR_ILLEGAL_ARGUMENT or
+ * CO_ERROR_PARAMETERS, if running application overlaps download region.
+ */
+CO_ReturnError_t CO_fwUpdate_init(
+        CO_fwUpdate_t          *fw,
+        CO_SDO_t               *SDO);
+
+
+/**
+ * Process program download.
+ *
+ * Function must be called cyclically from the same thread as SDO server.
+ * It erases download region and starts the copy of the new application,
+ * which does not return.
+ *
+ * @param fw This object.
+ * @param timeDifference_ms Time difference from previous function call in [milliseconds].
+ */
+void CO_fwUpdate_process(
+        CO_fwUpdate_t          *fw,
+        uint16_t                timeDifference_ms);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif
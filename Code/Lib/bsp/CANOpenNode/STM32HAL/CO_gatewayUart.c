@@ -0,0 +1,229 @@
+/*
+ * CANopen gateway over UART with DMA for STM32L4.
+ *
+ * @file        CO_gatewayUart.c
+ * @ingroup     CO_gatewayUart
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * CANopenNode is free and open source software: you can redistribute
+ * it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Following clarification and special exception to the GNU General Public
+ * License is included to the distribution terms of CANopenNode:
+ *
+ * Linking this library statically or dynamically with other modules is
+ * making a combined work based on this library. Thus, the terms and
+ * conditions of the GNU General Public License cover the whole combination.
+ *
+ * As a special exception, the copyright holders of this library give
+ * you permission to link this library with independent modules to
+ * produce an executable, regardless of the license terms of these
+ * independent modules, and to copy and distribute the resulting
+ * executable under terms of your choice, provided that you also meet,
+ * for each linked independent module, the terms and conditions of the
+ * license of that module. An independent module is a module which is
+ * not derived from or based on this library. If you modify this
+ * library, you may extend this exception to your version of the
+ * library, but you are not obliged to do so. If you do not wish
+ * to do so, delete this exception statement from your version.
+ */
+
+
+#include "CO_driver.h"
+
+#if CO_GATEWAY > 0
+
+#include "CO_gatewayUart.h"
+
+#if CO_TRACE_STREAM > 0
+#error CO_traceStream.c uses the same HAL_UART_TxCpltCallback(), disable CO_TRACE_STREAM or CO_GATEWAY
+#endif
+
+/* Object, which is served by HAL_UART_TxCpltCallback() */
+static CO_gatewayUart_t *CO_gatewayUartObj = NULL;
+
+
+/*
+ * Start DMA transmission of contiguous part of tx, interrupts must be disabled.
+ */
+static void CO_gatewayUart_start(CO_gatewayUart_t *uart){
+    uint16_t head = uart->txHead;
+    uint16_t tail = uart->txTail;
+
+    if(uart->txSending == 0U && head != tail){
+        uint16_t length = (head > tail) ? (head - tail) : (CO_GATEWAY_UART_TX_SIZE - tail);
+
+        if(HAL_UART_Transmit_DMA(uart->huart, &uart->tx[tail], length) == HAL_OK){
+            uart->txSending = length;
+        }
+    }
+}
+
+
+/*
+ * Start circular receive DMA from the beginning of rx.
+ */
+static bool_t CO_gatewayUart_startRx(CO_gatewayUart_t *uart){
+    uart->rxTail = 0U;
+    uart->rxWraps = 0U;
+    uart->rxWritten = 0U;
+    uart->rxRead = 0U;
+    return HAL_UART_Receive_DMA(uart->huart, uart->rx, CO_GATEWAY_UART_RX_SIZE) == HAL_OK;
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_gatewayUart_init(
+        CO_gatewayUart_t       *uart,
+        UART_HandleTypeDef     *huart,
+        CO_gateway_t           *gw)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    /* verify arguments */
+    if(uart == NULL || huart == NULL || gw == NULL || huart->hdmarx == NULL
+       || huart->hdmarx->Init.Mode != DMA_CIRCULAR)
+    {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    /* stop previous transfers, buffers are reused */
+    __disable_irq();
+    CO_gatewayUartObj = NULL;
+    __set_PRIMASK(primask);
+    (void)HAL_UART_Abort(huart);
+
+    uart->huart = huart;
+    uart->gw = gw;
+    uart->txHead = 0U;
+    uart->txTail = 0U;
+    uart->txSending = 0U;
+    uart->txOverflow = 0U;
+    uart->rxOverrun = 0U;
+
+    CO_gatewayUartObj = uart;
+
+    return CO_gatewayUart_startRx(uart) ? CO_ERROR_NO : CO_ERROR_HAL;
+}
+
+
+/******************************************************************************/
+void CO_gatewayUart_write(void *object, const uint8_t *data, uint16_t length){
+    CO_gatewayUart_t *uart = (CO_gatewayUart_t*)object;
+    uint16_t head = uart->txHead;
+    uint32_t primask;
+
+    while(length > 0U){
+        uint16_t next = (head + 1U < CO_GATEWAY_UART_TX_SIZE) ? (head + 1U) : 0U;
+
+        if(next == uart->txTail){
+            uart->txOverflow += length;
+            break;
+        }
+        uart->tx[head] = *data++;
+        head = next;
+        length--;
+    }
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    uart->txHead = head;
+    CO_gatewayUart_start(uart);
+    __set_PRIMASK(primask);
+}
+
+
+/******************************************************************************/
+void CO_gatewayUart_process(CO_gatewayUart_t *uart){
+    UART_HandleTypeDef *huart = uart->huart;
+    uint32_t wraps, written;
+    uint16_t head;
+
+    if(huart->RxState == HAL_UART_STATE_READY){
+        /* reception was aborted by error, characters in rx are lost */
+        uart->rxOverrun++;
+        CO_gateway_discard(uart->gw);
+        if(!CO_gatewayUart_startRx(uart)){
+            return;
+        }
+    }
+
+    /* consistent pair of pass counter and DMA counter */
+    do{
+        wraps = uart->rxWraps;
+        head = CO_GATEWAY_UART_RX_SIZE - (uint16_t)__HAL_DMA_GET_COUNTER(huart->hdmarx);
+    }while(wraps != uart->rxWraps);
+    if(head >= CO_GATEWAY_UART_RX_SIZE){
+        head = 0U;
+    }
+    written = wraps * CO_GATEWAY_UART_RX_SIZE + head;
+    if((int32_t)(written - uart->rxWritten) < 0){
+        /* counter was reloaded, HAL_UART_RxCpltCallback() is pending */
+        written += CO_GATEWAY_UART_RX_SIZE;
+    }
+    uart->rxWritten = written;
+
+    if(written - uart->rxRead >= CO_GATEWAY_UART_RX_SIZE){
+        /* DMA has overwritten characters, which were not consumed yet */
+        uart->rxOverrun++;
+        uart->rxRead = written;
+        uart->rxTail = head;
+        CO_gateway_discard(uart->gw);
+    }
+
+    while(uart->rxTail != head){
+        uint16_t end = (head > uart->rxTail) ? head : CO_GATEWAY_UART_RX_SIZE;
+        uint16_t length = end - uart->rxTail;
+        uint16_t consumed = CO_gateway_receive(uart->gw, &uart->rx[uart->rxTail], length);
+
+        uart->rxRead += consumed;
+        uart->rxTail += consumed;
+        if(uart->rxTail >= CO_GATEWAY_UART_RX_SIZE){
+            uart->rxTail = 0U;
+        }
+        if(consumed < length){
+            /* command is running, keep the rest in rx */
+            break;
+        }
+    }
+}
+
+
+/******************************************************************************/
+void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart){
+    CO_gatewayUart_t *uart = CO_gatewayUartObj;
+
+    /* circular DMA has reached the end of rx and continues from the start */
+    if((uart != NULL) && (huart == uart->huart)){
+        uart->rxWraps++;
+    }
+}
+
+
+/******************************************************************************/
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart){
+    CO_gatewayUart_t *uart = CO_gatewayUartObj;
+
+    if((uart != NULL) && (huart == uart->huart) && (uart->txSending != 0U)){
+        uint16_t tail = uart->txTail + uart->txSending;
+
+        uart->txTail = (tail < CO_GATEWAY_UART_TX_SIZE) ? tail : 0U;
+        uart->txSending = 0U;
+        CO_gatewayUart_start(uart);
+    }
+}
+
+#endif /* CO_GATEWAY > 0 */
@@ -0,0 +1,159 @@
+/**
+ * CANopen gateway over UART with DMA for STM32L4.
+ *
+ * @file        CO_gatewayUart.h
+ * @ingroup     CO_gatewayUart
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * CANopenNode is free and open source software: you can redistribute
+ * it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Following clarification and special exception to the GNU General Public
+ * License is included to the distribution terms of CANopenNode:
+ *
+ * Linking this library statically or dynamically with other modules is
+ * making a combined work based on this library. Thus, the terms and
+ * conditions of the GNU General Public License cover the whole combination.
+ *
+ * As a special exception, the copyright holders of this library give
+ * you permission to link this library with independent modules to
+ * produce an executable, regardless of the license terms of these
+ * independent modules, and to copy and distribute the resulting
+ * executable under terms of your choice, provided that you also meet,
+ * for each linked independent module, the terms and conditions of the
+ * license of that module. An independent module is a module which is
+ * not derived from or based on this library. If you modify this
+ * library, you may extend this exception to your version of the
+ * library, but you are not obliged to do so. If you do not wish
+ * to do so, delete this exception statement from your version.
+ */
+
+
+#ifndef CO_GATEWAY_UART_H
+#define CO_GATEWAY_UART_H
+
+#include "CO_driver.h"
+#include "CO_gateway.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_gatewayUart Gateway UART
+ * @ingroup CO_driver
+ * @{
+ *
+ * Serial line of @ref CO_gateway. Enabled with CO_GATEWAY in CO_driver.h.
+ *
+ * Receive DMA runs in circular mode over a ring buffer and is never stopped,
+ * so there is no interrupt per character. CO_gatewayUart_process() reads the
+ * DMA counter and passes new characters to CO_gateway_receive(). Receive,
+ * which was aborted by overrun error, is restarted there.
+ *
+ * While gateway command is running, characters stay in rx. Passes of DMA over
+ * rx are counted in HAL_UART_RxCpltCallback(), so characters, which DMA has
+ * overwritten before they were consumed, are detected. They are dropped
+ * together with the partial line, see CO_gateway_discard(), and counted in
+ * rxOverrun.
+ *
+ * Responses are copied into transmit ring buffer by CO_gatewayUart_write().
+ * Contiguous part of the ring is sent by DMA, next part is started from
+ * HAL_UART_TxCpltCallback(). Bytes, which do not fit into the ring, are
+ * dropped and counted.
+ */
+
+
+/**
+ * Gateway UART object.
+ */
+typedef struct{
+    /** From CO_gatewayUart_init() */
+    UART_HandleTypeDef *huart;
+    /** From CO_gatewayUart_init() */
+    CO_gateway_t       *gw;
+    /** Next character in rx, which is not consumed by gateway */
+    uint16_t            rxTail;
+    /** Number of completed DMA passes over rx, from HAL_UART_RxCpltCallback() */
+    volatile uint32_t   rxWraps;
+    /** Number of characters written by DMA since reception was started */
+    uint32_t            rxWritten;
+    /** Number of characters consumed since reception was started */
+    uint32_t            rxRead;
+    /** Number of receive overruns, unread characters were lost */
+    uint32_t            rxOverrun;
+    /** Next free byte in tx, written by mainline */
+    volatile uint16_t   txHead;
+    /** First byte in tx, which is not transmitted yet */
+    volatile uint16_t   txTail;
+    /** Length of running DMA transmission, 0 if idle */
+    volatile uint16_t   txSending;
+    /** Number of response bytes dropped, because tx was full */
+    uint32_t            txOverflow;
+    /** Receive ring buffer, written by circular DMA */
+    uint8_t             rx[CO_GATEWAY_UART_RX_SIZE];
+    /** Transmit ring buffer */
+    uint8_t             tx[CO_GATEWAY_UART_TX_SIZE];
+}CO_gatewayUart_t;
+
+
+/**
+ * Initialize gateway UART and start reception.
+ *
+ * UART must be configured with circular receive DMA (hdmarx) and transmit
+ * DMA (hdmatx). Function must be called after CO_gateway_init() with
+ * CO_gatewayUart_write() and this object as arguments.
+ *
+ * @param uart This object will be initialized.
+ * @param huart UART handle, for example huart1.
+ * @param gw Gateway object.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO, CO_ERROR_ILLEGAL_ARGUMENT or
+ * CO_ERROR_HAL, if receive DMA could not be started.
+ */
+CO_ReturnError_t CO_gatewayUart_init(
+        CO_gatewayUart_t       *uart,
+        UART_HandleTypeDef     *huart,
+        CO_gateway_t           *gw);
+
+
+/**
+ * Write response to UART, pFunctWrite of CO_gateway_init().
+ *
+ * @param object CO_gatewayUart_t object.
+ * @param data Data to be transmitted.
+ * @param length Number of bytes.
+ */
+void CO_gatewayUart_write(void *object, const uint8_t *data, uint16_t length);
+
+
+/**
+ * Process received characters.
+ *
+ * Function must be called cyclically from the same thread as
+ * CO_SDOclientQueue_process(), for example after CO_process().
+ *
+ * @param uart This object.
+ */
+void CO_gatewayUart_process(CO_gatewayUart_t *uart);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif
@@ -0,0 +1,208 @@
+/*
+ * Non-blocking binary log over UART with DMA for STM32L4.
+ *
+ * @file        CO_log.c
+ * @ingroup     CO_log
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * CANopenNode is free and open source software: you can redistribute
+ * it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Following clarification and special exception to the GNU General Public
+ * License is included to the distribution terms of CANopenNode:
+ *
+ * Linking this library statically or dynamically with other modules is
+ * making a combined work based on this library. Thus, the terms and
+ * conditions of the GNU General Public License cover the whole combination.
+ *
+ * As a special exception, the copyright holders of this library give
+ * you permission to link this library with independent modules to
+ * produce an executable, regardless of the license terms of these
+ * independent modules, and to copy and distribute the resulting
+ * executable under terms of your choice, provided that you also meet,
+ * for each linked independent module, the terms and conditions of the
+ * license of that module. An independent module is a module which is
+ * not derived from or based on this library. If you modify this
+ * library, you may extend this exception to your version of the
+ * library, but you are not obliged to do so. If you do not wish
+ * to do so, delete this exception statement from your version.
+ */
+
+
+
+#include <string.h>
+#include "CO_driver.h"
+#include "CO_log.h"
+
+#if CO_LOG > 0
+
+#if (CO_TRACE_STREAM > 0) || (CO_GATEWAY > 0)
+#error CO_log.c uses the same HAL_UART_TxCpltCallback(), disable CO_TRACE_STREAM and CO_GATEWAY or CO_LOG
+#endif
+
+/* Size of the ring in 32-bit words */
+#define CO_LOG_WORDS (CO_LOG_BUF_SIZE / 4U)
+
+#if (CO_LOG_WORDS & (CO_LOG_WORDS - 1U)) != 0 || CO_LOG_WORDS < 8U
+#error CO_LOG_BUF_SIZE must be power of two, at least 32
+#endif
+
+/*
+ * Ring of records. Indexes are free running word counters, position in buf
+ * is index modulo CO_LOG_WORDS. head is reserved by writers, scan is the end
+ * of committed records found by CO_log_start(), tail is the end of records
+ * transmitted and cleared. Header word of free space is zero, writer stores
+ * it last, so nonzero header means the whole record is written.
+ */
+static struct{
+    UART_HandleTypeDef *huart;
+    volatile uint32_t   head;
+    volatile uint32_t   scan;
+    volatile uint32_t   tail;
+    /* words transmitted by DMA from tail, 0 if line is idle */
+    volatile uint32_t   sending;
+    volatile uint32_t   lost;
+    volatile uint32_t   lostReported;
+    uint32_t            buf[CO_LOG_WORDS];
+}CO_logRing;
+
+
+/*
+ * Find committed records and start DMA transmission of their contiguous part,
+ * interrupts must be disabled.
+ */
+static void CO_log_start(void){
+    uint32_t head = CO_logRing.head;
+    uint32_t scan = CO_logRing.scan;
+    uint32_t tail = CO_logRing.tail;
+    uint32_t start, length;
+
+    while(scan != head){
+        uint32_t header = CO_logRing.buf[scan & (CO_LOG_WORDS - 1U)];
+
+        if((header & 0xFFU) != CO_LOG_START){
+            break;
+        }
+        scan += 2U + ((header >> 8) & 0x0FU);
+    }
+    CO_logRing.scan = scan;
+
+    if(CO_logRing.sending != 0U || CO_logRing.huart == NULL || scan == tail){
+        return;
+    }
+
+    /* records may wrap, send up to the end of buf, rest with the next DMA */
+    start = tail & (CO_LOG_WORDS - 1U);
+    length = scan - tail;
+    if(length > (CO_LOG_WORDS - start)){
+        length = CO_LOG_WORDS - start;
+    }
+    if(HAL_UART_Transmit_DMA(CO_logRing.huart, (uint8_t *)&CO_logRing.buf[start],
+                             (uint16_t)(length * 4U)) == HAL_OK){
+        CO_logRing.sending = length;
+    }
+}
+
+
+/******************************************************************************/
+void CO_log_init(UART_HandleTypeDef *huart){
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    if(CO_logRing.sending != 0U){
+        (void)HAL_UART_AbortTransmit(CO_logRing.huart);
+    }
+    (void)memset(CO_logRing.buf, 0, sizeof(CO_logRing.buf));
+    CO_logRing.head = 0U;
+    CO_logRing.scan = 0U;
+    CO_logRing.tail = 0U;
+    CO_logRing.sending = 0U;
+    CO_logRing.lost = 0U;
+    CO_logRing.lostReported = 0U;
+    CO_logRing.huart = huart;
+    __set_PRIMASK(primask);
+
+    /* time stamps */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+
+/******************************************************************************/
+void CO_log_write(uint32_t fmt, const uint32_t *arg, uint32_t n){
+    uint32_t words = 2U + n;
+    uint32_t head, lost, i;
+    uint32_t header = CO_LOG_START | (n << 8) | ((fmt & 0xFFFFU) << 16);
+    uint32_t timestamp = DWT->CYCCNT;
+
+    /* reserve space, nested writer retries with the new head */
+    do{
+        head = __LDREXW(&CO_logRing.head);
+        if((head - CO_logRing.tail + words) > CO_LOG_WORDS){
+            __CLREX();
+            CO_logRing.lost++;
+            return;
+        }
+    }while(__STREXW(head + words, &CO_logRing.head) != 0U);
+
+    /* lost records are reported approximately, race only delays the flag */
+    lost = CO_logRing.lost;
+    if(lost != CO_logRing.lostReported){
+        CO_logRing.lostReported = lost;
+        header |= (uint32_t)CO_LOG_FLAG_LOST << 8;
+    }
+
+    CO_logRing.buf[(head + 1U) & (CO_LOG_WORDS - 1U)] = timestamp;
+    for(i = 0U; i < n; i++){
+        CO_logRing.buf[(head + 2U + i) & (CO_LOG_WORDS - 1U)] = arg[i];
+    }
+    /* commit */
+    __DMB();
+    CO_logRing.buf[head & (CO_LOG_WORDS - 1U)] = header;
+}
+
+
+/******************************************************************************/
+void CO_log_process(void){
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    CO_log_start();
+    __set_PRIMASK(primask);
+}
+
+
+/******************************************************************************/
+uint32_t CO_log_getLost(void){
+    return CO_logRing.lost;
+}
+
+
+/******************************************************************************/
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart){
+    uint32_t sending = CO_logRing.sending;
+
+    if((huart == CO_logRing.huart) && (sending != 0U)){
+        /* transmitted words become free space with zero headers */
+        (void)memset(&CO_logRing.buf[CO_logRing.tail & (CO_LOG_WORDS - 1U)], 0, sending * 4U);
+        __DMB();
+        CO_logRing.tail += sending;
+        CO_logRing.sending = 0U;
+        CO_log_start();
+    }
+}
+
+#endif /* CO_LOG > 0 */
@@ -0,0 +1,174 @@
+/**
+ * Non-blocking binary log over UART with DMA for STM32L4.
+ *
+ * @file        CO_log.h
+ * @ingroup     CO_log
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * CANopenNode is free and open source software: you can redistribute
+ * it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Following clarification and special exception to the GNU General Public
+ * License is included to the distribution terms of CANopenNode:
+ *
+ * Linking this library statically or dynamically with other modules is
+ * making a combined work based on this library. Thus, the terms and
+ * conditions of the GNU General Public License cover the whole combination.
+ *
+ * As a special exception, the copyright holders of this library give
+ * you permission to link this library with independent modules to
+ * produce an executable, regardless of the license terms of these
+ * independent modules, and to copy and distribute the resulting
+ * executable under terms of your choice, provided that you also meet,
+ * for each linked independent module, the terms and conditions of the
+ * license of that module. An independent module is a module which is
+ * not derived from or based on this library. If you modify this
+ * library, you may extend this exception to your version of the
+ * library, but you are not obliged to do so. If you do not wish
+ * to do so, delete this exception statement from your version.
+ */
+
+
+#ifndef CO_LOG_H
+#define CO_LOG_H
+
+#include "CO_driver.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_log Binary log
+ * @ingroup CO_driver
+ * @{
+ *
+ * Debug messages, which do not disturb timing. Enabled with CO_LOG in
+ * CO_driver.h, otherwise CO_LOG0() to CO_LOG4() expand to nothing.
+ *
+ * Macro places its format string into .co_log section, which is not loaded
+ * into the target (INFO in linker script), and calls CO_log_write() with the
+ * offset of the string and up to four 32-bit arguments. CO_log_write()
+ * reserves space in the ring with LDREX/STREX and writes the record without
+ * locks, so it may be called from mainline and from interrupts of any
+ * priority. If the ring is full, record is dropped and the next record has
+ * #CO_LOG_FLAG_LOST set.
+ *
+ * CO_log_process() is called from mainline and starts DMA, if line is idle.
+ * HAL_UART_TxCpltCallback() frees transmitted part of the ring and continues
+ * with the next committed records, so the line stays busy as long as there
+ * are records. Records are transmitted in the order of reservation, record
+ * reserved by an interrupted writer holds back later ones until it is
+ * completed.
+ *
+ * ###Record
+ *
+ *   Bytes | Description
+ *   ------|-----------------------------------------------------------
+ *     1   | Start byte, #CO_LOG_START
+ *     1   | Bits 0..3: number of arguments n, 0..4, bits 4..7: flags
+ *     2   | Offset of format string in .co_log section, little endian
+ *     4   | DWT cycle counter at CO_log_write(), little endian
+ *    4*n  | Arguments, little endian
+ *
+ * Format strings may use integer conversions only (d, i, u, x, X, c),
+ * arguments are converted to uint32_t. Decoder is CANopenNode/tools/
+ * logdecode.py, which reads format strings from the ELF file.
+ */
+
+
+/** Start byte of the record */
+#define CO_LOG_START                0xA5U
+/** Maximum number of arguments of one record */
+#define CO_LOG_ARGS_MAX             4U
+/** Flag in the second byte: records were dropped before this one */
+#define CO_LOG_FLAG_LOST            0x10U
+
+/** Attributes of format strings */
+#define CO_LOG_ATTR                 __attribute__((section(".co_log"), used))
+
+
+#if CO_LOG > 0
+/** Common part of CO_LOG0() to CO_LOG4() */
+#define CO_LOG_(fmt, n, ...) do{                                               \
+        static const char CO_LOG_ATTR coLogFmt[] = fmt;                        \
+        const uint32_t coLogArg[CO_LOG_ARGS_MAX] = {__VA_ARGS__};              \
+        CO_log_write((uint32_t)(uintptr_t)coLogFmt, coLogArg, n);              \
+    }while(0)
+
+/** Log message without arguments */
+#define CO_LOG0(fmt)                CO_LOG_(fmt, 0U, 0U)
+/** Log message with one argument */
+#define CO_LOG1(fmt, a)             CO_LOG_(fmt, 1U, (uint32_t)(a))
+/** Log message with two arguments */
+#define CO_LOG2(fmt, a, b)          CO_LOG_(fmt, 2U, (uint32_t)(a), (uint32_t)(b))
+/** Log message with three arguments */
+#define CO_LOG3(fmt, a, b, c)       CO_LOG_(fmt, 3U, (uint32_t)(a), (uint32_t)(b), (uint32_t)(c))
+/** Log message with four arguments */
+#define CO_LOG4(fmt, a, b, c, d)    CO_LOG_(fmt, 4U, (uint32_t)(a), (uint32_t)(b), (uint32_t)(c), (uint32_t)(d))
+#else
+#define CO_LOG0(fmt)
+#define CO_LOG1(fmt, a)
+#define CO_LOG2(fmt, a, b)
+#define CO_LOG3(fmt, a, b, c)
+#define CO_LOG4(fmt, a, b, c, d)
+#endif
+
+
+/**
+ * Initialize log.
+ *
+ * UART must be configured with transmit DMA (hdmatx linked). Records, which
+ * are not transmitted yet, are discarded. Function also starts DWT cycle
+ * counter for time stamps. It may be called once, before the first record.
+ *
+ * @param huart UART handle, for example huart1.
+ */
+void CO_log_init(UART_HandleTypeDef *huart);
+
+
+/**
+ * Write one record, use CO_LOG0() to CO_LOG4() macros instead.
+ *
+ * @param fmt Address of format string in .co_log section.
+ * @param arg Arguments.
+ * @param n Number of arguments, 0 to #CO_LOG_ARGS_MAX.
+ */
+void CO_log_write(uint32_t fmt, const uint32_t *arg, uint32_t n);
+
+
+/**
+ * Start transmission of committed records, if UART is idle.
+ *
+ * Function must be called cyclically from mainline, for example after
+ * CO_process(). Records written only from interrupts are transmitted after
+ * the next call.
+ */
+void CO_log_process(void);
+
+
+/**
+ * Number of records dropped because the ring was full.
+ */
+uint32_t CO_log_getLost(void);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif
@@ -0,0 +1,384 @@
+/*
+ * Cycle counter profiling of CANopenNode hot paths for STM32L4.
+ *
+ * @file        CO_profile.c
+ * @ingroup     CO_profile
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * CANopenNode is free and open source software: you can redistribute
+ * it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Following clarification and special exception to the GNU General Public
+ * License is included to the distribution terms of CANopenNode:
+ *
+ * Linking this library statically or dynamically with other modules is
+ * making a combined work based on this library. Thus, the terms and
+ * conditions of the GNU General Public License cover the whole combination.
+ *
+ * As a special exception, the copyright holders of this library give
+ * you permission to link this library with independent modules to
+ * produce an executable, regardless of the license terms of these
+ * independent modules, and to copy and distribute the resulting
+ * executable under terms of your choice, provided that you also meet,
+ * for each linked independent module, the terms and conditions of the
+ * license of that module. An independent module is a module which is
+ * not derived from or based on this library. If you modify this
+ * library, you may extend this exception to your version of the
+ * library, but you are not obliged to do so. If you do not wish
+ * to do so, delete this exception statement from your version.
+ */
+
+
+#include <string.h>
+#include "CO_driver.h"
+#include "CO_SDO.h"
+#include "CO_OD.h"
+#include "CO_profile.h"
+
+#if CO_PROFILE > 0
+
+/* Number of OD sub-indexes for one stage: count, min, max, average */
+#define CO_PROFILE_OD_VALUES    4U
+
+static CO_profileStat_t CO_profileStats[CO_PROFILE_STAGES];
+
+#if CO_PROFILE_WCET > 0
+CO_profileContext_t CO_profileContext;
+static CO_profileWcet_t CO_profileWcet[CO_PROFILE_STAGES];
+static CO_SDO_t *CO_profileSDO;
+#endif
+
+#ifdef ODL_profile_arrayLength
+static CO_SDO_abortCode_t CO_ODF_profile(CO_ODF_arg_t *ODF_arg);
+#endif
+#ifdef ODL_worstCase_arrayLength
+static CO_SDO_abortCode_t CO_ODF_profileWcet(CO_ODF_arg_t *ODF_arg);
+#endif
+
+
+/*
+ * Clear statistics of one stage, interrupts must be disabled.
+ */
+static void CO_profile_clear(CO_profileStat_t *stat){
+    stat->count = 0U;
+    stat->min = 0xFFFFFFFFU;
+    stat->max = 0U;
+    stat->sum = 0U;
+}
+
+
+#ifdef ODL_profile_arrayLength
+/*
+ * Function for accessing _Profile_ (index 0x2140) from SDO server.
+ */
+static CO_SDO_abortCode_t CO_ODF_profile(CO_ODF_arg_t *ODF_arg){
+    CO_profileStat_t stat;
+    uint32_t avg;
+    uint32_t value;
+    uint8_t stage;
+
+    if(ODF_arg->subIndex == 0U){
+        return CO_SDO_AB_NONE;
+    }
+
+    stage = (uint8_t)((ODF_arg->subIndex - 1U) / CO_PROFILE_OD_VALUES);
+    if(stage >= (uint8_t)CO_PROFILE_STAGES){
+        return CO_SDO_AB_NONE;
+    }
+
+    if(!ODF_arg->reading){
+        CO_profile_reset((CO_profileStage_t)stage);
+        return CO_SDO_AB_NONE;
+    }
+
+    avg = CO_profile_get((CO_profileStage_t)stage, &stat);
+    switch((ODF_arg->subIndex - 1U) % CO_PROFILE_OD_VALUES){
+        case 0U:  value = stat.count;                          break;
+        case 1U:  value = (stat.count != 0U) ? stat.min : 0U;  break;
+        case 2U:  value = stat.max;                            break;
+        default:  value = avg;                                 break;
+    }
+    CO_setUint32(ODF_arg->data, value);
+
+    return CO_SDO_AB_NONE;
+}
+#endif
+
+
+#ifdef ODL_worstCase_arrayLength
+/*
+ * Function for accessing _Worst case_ (index 0x214A) from SDO server.
+ */
+static CO_SDO_abortCode_t CO_ODF_profileWcet(CO_ODF_arg_t *ODF_arg){
+    CO_profileWcet_t wcet;
+    uint32_t value;
+    uint8_t stage;
+
+    if(ODF_arg->subIndex == 0U){
+        return CO_SDO_AB_NONE;
+    }
+
+    stage = (uint8_t)((ODF_arg->subIndex - 1U) / CO_PROFILE_OD_VALUES);
+    if(stage >= (uint8_t)CO_PROFILE_STAGES){
+        return CO_SDO_AB_NONE;
+    }
+
+    if(!ODF_arg->reading){
+        CO_profile_reset((CO_profileStage_t)stage);
+        return CO_SDO_AB_NONE;
+    }
+
+    CO_profile_getWcet((CO_profileStage_t)stage, &wcet);
+    switch((ODF_arg->subIndex - 1U) % CO_PROFILE_OD_VALUES){
+        case 0U:  value = wcet.cycles;                                          break;
+        case 1U:  value = wcet.tick;                                            break;
+        case 2U:  value = ((uint32_t)wcet.rxFrames << 16) | wcet.rxIdent;       break;
+        default:  value = ((uint32_t)wcet.tpdoSent << 16) | wcet.sdoState;      break;
+    }
+    CO_setUint32(ODF_arg->data, value);
+
+    return CO_SDO_AB_NONE;
+}
+#endif
+
+
+/******************************************************************************/
+void CO_profile_init(CO_SDO_t *SDO){
+    uint8_t i;
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+#if CO_PROFILE_WCET > 0
+    CO_profileSDO = SDO;
+#endif
+    for(i = 0U; i < (uint8_t)CO_PROFILE_STAGES; i++){
+        CO_profile_reset((CO_profileStage_t)i);
+    }
+
+    if(SDO != NULL){
+#ifdef ODL_profile_arrayLength
+        CO_OD_configure(SDO, CO_PROFILE_OD_INDEX, CO_ODF_profile, NULL, 0, 0U);
+#endif
+#ifdef ODL_worstCase_arrayLength
+        CO_OD_configure(SDO, CO_PROFILE_WCET_OD_INDEX, CO_ODF_profileWcet, NULL, 0, 0U);
+#endif
+    }
+}
+
+
+/******************************************************************************/
+void CO_profile_record(CO_profileStage_t stage, uint32_t cycles){
+    CO_profileStat_t *stat = &CO_profileStats[stage];
+
+    stat->count++;
+    stat->sum += cycles;
+    if(cycles < stat->min){
+        stat->min = cycles;
+    }
+    if(cycles > stat->max){
+        stat->max = cycles;
+    }
+}
+
+
+#if CO_PROFILE_WCET > 0
+/******************************************************************************/
+void CO_profile_recordWcet(CO_profileStage_t stage, const CO_profileMark_t *start){
+    const uint32_t cycles = DWT->CYCCNT - start->cycles;
+
+    if(cycles > CO_profileStats[stage].max){
+        CO_profileWcet_t *wcet = &CO_profileWcet[stage];
+
+        wcet->cycles = cycles;
+        wcet->tick = HAL_GetTick();
+        wcet->rxIdent = CO_profileContext.rxIdent;
+        wcet->rxFrames = (uint16_t)(CO_profileContext.rxFrames - start->rxFrames);
+        wcet->tpdoSent = (uint16_t)(CO_profileContext.tpdoSent - start->tpdoSent);
+        wcet->sdoState = (CO_profileSDO != NULL) ? (uint8_t)CO_profileSDO->state : 0U;
+    }
+    CO_profile_record(stage, cycles);
+}
+#endif
+
+
+/******************************************************************************/
+void CO_profile_reset(CO_profileStage_t stage){
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    CO_profile_clear(&CO_profileStats[stage]);
+#if CO_PROFILE_WCET > 0
+    memset(&CO_profileWcet[stage], 0, sizeof(CO_profileWcet_t));
+#endif
+    __set_PRIMASK(primask);
+}
+
+
+/******************************************************************************/
+uint32_t CO_profile_get(CO_profileStage_t stage, CO_profileStat_t *stat){
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    *stat = CO_profileStats[stage];
+    __set_PRIMASK(primask);
+
+    return (stat->count != 0U) ? (uint32_t)(stat->sum / stat->count) : 0U;
+}
+
+
+/******************************************************************************/
+void CO_profile_getWcet(CO_profileStage_t stage, CO_profileWcet_t *wcet){
+#if CO_PROFILE_WCET > 0
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    *wcet = CO_profileWcet[stage];
+    __set_PRIMASK(primask);
+#else
+    (void)stage;
+    memset(wcet, 0, sizeof(CO_profileWcet_t));
+#endif
+}
+
+#endif /* CO_PROFILE > 0 */
+
+
+#if CO_PROFILE_PC > 0
+
+#if (CO_PROFILE_PC_BUCKETS * 2U) > 0xFFFFU
+#error CO_PROFILE_PC_BUCKETS is too large for one SDO domain upload
+#endif
+
+/* Histogram, written only by CO_profilePC_sample() while sampling */
+static volatile uint16_t CO_profilePCHist[CO_PROFILE_PC_BUCKETS];
+static volatile uint32_t CO_profilePCSamples;
+static volatile uint32_t CO_profilePCOutside;
+static volatile bool_t CO_profilePCRunning;
+
+#ifdef ODL_PCSampling_arrayLength
+static CO_SDO_abortCode_t CO_ODF_profilePC(CO_ODF_arg_t *ODF_arg);
+static CO_SDO_abortCode_t CO_ODF_profilePCHist(CO_ODF_arg_t *ODF_arg);
+
+
+/*
+ * Function for accessing _PC sampling_ (index 0x2143) from SDO server.
+ */
+static CO_SDO_abortCode_t CO_ODF_profilePC(CO_ODF_arg_t *ODF_arg){
+    uint32_t value;
+
+    if(ODF_arg->subIndex == 0U){
+        return CO_SDO_AB_NONE;
+    }
+
+    if(!ODF_arg->reading){
+        if(ODF_arg->subIndex != 1U){
+            return CO_SDO_AB_READONLY;
+        }
+        switch(CO_getUint32(ODF_arg->data)){
+            case 0U:  CO_profilePC_start(false);  break;
+            case 1U:  CO_profilePC_start(true);   break;
+            case 2U:  CO_profilePC_clear();       break;
+            default:  return CO_SDO_AB_INVALID_VALUE;
+        }
+        return CO_SDO_AB_NONE;
+    }
+
+    switch(ODF_arg->subIndex){
+        case 1U:  value = CO_profilePCRunning ? 1U : 0U;       break;
+        case 2U:  value = CO_profilePCSamples;                 break;
+        case 3U:  value = CO_profilePCOutside;                 break;
+        default:  value = 1UL << CO_PROFILE_PC_BUCKET_SHIFT;   break;
+    }
+    CO_setUint32(ODF_arg->data, value);
+
+    return CO_SDO_AB_NONE;
+}
+
+
+/*
+ * Function for accessing _PC histogram_ (index 0x2144) from SDO server.
+ */
+static CO_SDO_abortCode_t CO_ODF_profilePCHist(CO_ODF_arg_t *ODF_arg){
+    if(!ODF_arg->reading){
+        return CO_SDO_AB_READONLY;
+    }
+
+    /* histogram must not change during the transfer, it is sent in place */
+    CO_profilePC_start(false);
+    ODF_arg->data = (uint8_t*)CO_profilePCHist;
+    ODF_arg->dataLength = (uint16_t)sizeof(CO_profilePCHist);
+    ODF_arg->lastSegment = true;
+
+    return CO_SDO_AB_NONE;
+}
+#endif
+
+
+/******************************************************************************/
+void CO_profilePC_init(CO_SDO_t *SDO){
+#ifdef ODL_PCSampling_arrayLength
+    if(SDO != NULL){
+        CO_OD_configure(SDO, CO_PROFILE_PC_OD_INDEX, CO_ODF_profilePC, NULL, 0, 0U);
+        CO_OD_configure(SDO, CO_PROFILE_PC_HIST_OD_INDEX, CO_ODF_profilePCHist, NULL, 0, 0U);
+    }
+#else
+    (void)SDO;
+#endif
+}
+
+
+/******************************************************************************/
+void CO_profilePC_sample(uint32_t pc){
+    uint32_t bucket;
+
+    if(!CO_profilePCRunning){
+        return;
+    }
+
+    CO_profilePCSamples++;
+    bucket = (pc - FLASH_BASE) >> CO_PROFILE_PC_BUCKET_SHIFT;
+    if(bucket >= CO_PROFILE_PC_BUCKETS){
+        CO_profilePCOutside++;
+    }
+    else if(++CO_profilePCHist[bucket] == 0xFFFFU){
+        /* keep the ratios, next sample would overflow */
+        CO_profilePCRunning = false;
+    }
+}
+
+
+/******************************************************************************/
+void CO_profilePC_start(bool_t start){
+    CO_profilePCRunning = start;
+}
+
+
+/******************************************************************************/
+void CO_profilePC_clear(void){
+    uint32_t primask = __get_PRIMASK();
+    uint16_t i;
+
+    __disable_irq();
+    for(i = 0U; i < CO_PROFILE_PC_BUCKETS; i++){
+        CO_profilePCHist[i] = 0U;
+    }
+    CO_profilePCSamples = 0U;
+    CO_profilePCOutside = 0U;
+    __set_PRIMASK(primask);
+}
+
+#endif /* CO_PROFILE_PC > 0 */
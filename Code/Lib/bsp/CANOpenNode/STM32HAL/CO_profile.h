@@ -0,0 +1,250 @@
+/**
+ * Cycle counter profiling of CANopenNode hot paths for STM32L4.
+ *
+ * @file        CO_profile.h
+ * @ingroup     CO_profile
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * CANopenNode is free and open source software: you can redistribute
+ * it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Following clarification and special exception to the GNU General Public
+ * License is included to the distribution terms of CANopenNode:
+ *
+ * Linking this library statically or dynamically with other modules is
+ * making a combined work based on this library. Thus, the terms and
+ * conditions of the GNU General Public License cover the whole combination.
+ *
+ * As a special exception, the copyright holders of this library give
+ * you permission to link this library with independent modules to
+ * produce an executable, regardless of the license terms of these
+ * independent modules, and to copy and distribute the resulting
+ * executable under terms of your choice, provided that you also meet,
+ * for each linked independent module, the terms and conditions of the
+ * license of that module. An independent module is a module which is
+ * not derived from or based on this library. If you modify this
+ * library, you may extend this exception to your version of the
+ * library, but you are not obliged to do so. If you do not wish
+ * to do so, delete this exception statement from your version.
+ */
+
+
+#ifndef CO_PROFILE_H
+#define CO_PROFILE_H
+
+#include "CO_driver.h"
+#include "CO_SDO.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_profile Profiling
+ * @ingroup CO_driver
+ * @{
+ *
+ * Execution time of stages from #CO_profileStage_t, measured with Cortex-M4
+ * DWT cycle counter (CPU clock). Enabled with CO_PROFILE in CO_driver.h.
+ *
+ * Each stage is recorded from one execution context only (CAN interrupt,
+ * mainline or timer interrupt), so recording needs no lock. Snapshot and
+ * reset briefly disable interrupts.
+ *
+ * ###Object dictionary
+ * If OD contains UNSIGNED32 array 0x2140 (ODL_profile_arrayLength = 20), it
+ * is served by CO_profile_init(). Sub-index 1 + 4 * stage + n contains:
+ *  - n = 0: number of calls,
+ *  - n = 1: minimum cycles,
+ *  - n = 2: maximum cycles,
+ *  - n = 3: average cycles.
+ *
+ * Writing any value to a sub-index resets statistics of its stage.
+ *
+ * ###Worst case
+ * With CO_PROFILE_WCET, each new maximum of a stage also stores the context
+ * of that call. If OD contains UNSIGNED32 array 0x214A
+ * (ODL_worstCase_arrayLength = 20), sub-index 1 + 4 * stage + n contains:
+ *  - n = 0: maximum cycles,
+ *  - n = 1: HAL tick in milliseconds, when maximum was recorded,
+ *  - n = 2: bits 16..31: standard frames received during the call, bits
+ *    0..15: CAN-ID of the last frame received before the end of the call,
+ *  - n = 3: bits 16..31: TPDOs sent during the call, bits 0..7: SDO server
+ *    state (CO_SDO_state_t) at the end of the call.
+ *
+ * Writing any value to a sub-index resets statistics and worst case of its
+ * stage. Frame counts of the CAN receive stage include the frames of that
+ * interrupt, so they show how many frames one FIFO interrupt drained.
+ *
+ * ###PC sampling
+ * With CO_PROFILE_PC, CO_profilePC_sample() is called from TIM16 interrupt
+ * with the program counter stacked on interrupt entry. It adds one count to
+ * the bucket of that address, so the histogram shows where CPU time goes in
+ * application, HAL and stack code, without instrumentation. Samples inside
+ * interrupts of the same priority (0) and inside sections with interrupts
+ * disabled by PRIMASK are not taken, they are accounted to the code after the
+ * section. Sampling stops by itself, when any bucket is full.
+ *
+ * If OD contains UNSIGNED32 array 0x2143 (ODL_PCSampling_arrayLength = 4)
+ * and DOMAIN 0x2144, they are served by CO_profilePC_init():
+ *  - 0x2143,1: control, reads 1 while sampling; write 1 starts, 0 stops,
+ *    2 clears histogram and counters.
+ *  - 0x2143,2: number of samples, read only.
+ *  - 0x2143,3: samples outside of histogram (code in RAM), read only.
+ *  - 0x2143,4: bucket size in bytes, read only. Bucket n starts at
+ *    FLASH_BASE + n * size.
+ *  - 0x2144: histogram, array of UNSIGNED16 counts, little endian. Upload
+ *    stops sampling and is sent directly from the histogram, it is best read
+ *    with SDO block upload. tools/pcprof.py maps buckets to ELF symbols.
+ */
+
+
+/** OD index of profiling results */
+#define CO_PROFILE_OD_INDEX         0x2140U
+/** OD index of worst case context */
+#define CO_PROFILE_WCET_OD_INDEX    0x214AU
+/** OD index of PC sampling control and counters */
+#define CO_PROFILE_PC_OD_INDEX      0x2143U
+/** OD index of PC sampling histogram */
+#define CO_PROFILE_PC_HIST_OD_INDEX 0x2144U
+
+
+/**
+ * Statistics of one stage.
+ */
+typedef struct{
+    uint32_t            count;      /**< Number of recorded calls */
+    uint32_t            min;        /**< Minimum cycles, 0xFFFFFFFF if count is 0 */
+    uint32_t            max;        /**< Maximum cycles */
+    uint64_t            sum;        /**< Sum of cycles of all calls */
+}CO_profileStat_t;
+
+
+/**
+ * Context of the longest call of one stage, see CO_PROFILE_WCET.
+ */
+typedef struct{
+    uint32_t            cycles;     /**< Duration in CPU cycles, 0 if not recorded */
+    uint32_t            tick;       /**< HAL_GetTick() at the end of the call */
+    uint16_t            rxIdent;    /**< CAN-ID of the last received frame */
+    uint16_t            rxFrames;   /**< Frames received during the call */
+    uint16_t            tpdoSent;   /**< TPDOs sent during the call */
+    uint8_t             sdoState;   /**< SDO server state at the end of the call */
+}CO_profileWcet_t;
+
+
+/**
+ * Enable DWT cycle counter, reset statistics and serve OD objects 0x2140
+ * and 0x214A.
+ *
+ * Function may be called after each communication reset, statistics are
+ * then reset too.
+ *
+ * @param SDO SDO server object, may be NULL, if OD objects are not used.
+ * Its state is also recorded in worst case context.
+ */
+void CO_profile_init(CO_SDO_t *SDO);
+
+
+/**
+ * Record one call of a stage, see CO_PROFILE_END().
+ *
+ * @param stage Measured stage.
+ * @param cycles Duration in CPU cycles.
+ */
+void CO_profile_record(CO_profileStage_t stage, uint32_t cycles);
+
+
+/**
+ * Record one call of a stage with worst case context, see CO_PROFILE_END().
+ *
+ * @param stage Measured stage.
+ * @param start Cycle counter and context counters at the start of the call.
+ */
+#if CO_PROFILE_WCET > 0
+void CO_profile_recordWcet(CO_profileStage_t stage, const CO_profileMark_t *start);
+#endif
+
+
+/**
+ * Reset statistics and worst case of one stage.
+ *
+ * @param stage Measured stage.
+ */
+void CO_profile_reset(CO_profileStage_t stage);
+
+
+/**
+ * Copy consistent statistics of one stage.
+ *
+ * @param stage Measured stage.
+ * @param stat Statistics are written here.
+ *
+ * @return Average cycles, 0 if there was no call.
+ */
+uint32_t CO_profile_get(CO_profileStage_t stage, CO_profileStat_t *stat);
+
+
+/**
+ * Copy consistent worst case context of one stage.
+ *
+ * @param stage Measured stage.
+ * @param wcet Context is written here, all zero without CO_PROFILE_WCET.
+ */
+void CO_profile_getWcet(CO_profileStage_t stage, CO_profileWcet_t *wcet);
+
+
+/**
+ * Serve OD objects 0x2143 and 0x2144 of PC sampling.
+ *
+ * Function may be called after each communication reset, histogram and
+ * sampling state are kept.
+ *
+ * @param SDO SDO server object, may be NULL, if OD objects are not used.
+ */
+void CO_profilePC_init(CO_SDO_t *SDO);
+
+
+/**
+ * Add one PC sample, called from sampling timer interrupt.
+ *
+ * Sample is ignored, while sampling is stopped.
+ *
+ * @param pc Program counter from the exception stack frame.
+ */
+void CO_profilePC_sample(uint32_t pc);
+
+
+/**
+ * Start or stop PC sampling.
+ *
+ * @param start True starts sampling, false stops it.
+ */
+void CO_profilePC_start(bool_t start);
+
+
+/**
+ * Clear PC histogram and counters. Sampling state is not changed.
+ */
+void CO_profilePC_clear(void);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif
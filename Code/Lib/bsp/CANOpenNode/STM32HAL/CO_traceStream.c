@@ -0,0 +1,178 @@
+/*
+ * Streaming of CANopen trace over UART with DMA for STM32L4.
+ *
+ * @file        CO_traceStream.c
+ * @ingroup     CO_traceStream
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * CANopenNode is free and open source software: you can redistribute
+ * it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Following clarification and special exception to the GNU General Public
+ * License is included to the distribution terms of CANopenNode:
+ *
+ * Linking this library statically or dynamically with other modules is
+ * making a combined work based on this library. Thus, the terms and
+ * conditions of the GNU General Public License cover the whole combination.
+ *
+ * As a special exception, the copyright holders of this library give
+ * you permission to link this library with independent modules to
+ * produce an executable, regardless of the license terms of these
+ * independent modules, and to copy and distribute the resulting
+ * executable under terms of your choice, provided that you also meet,
+ * for each linked independent module, the terms and conditions of the
+ * license of that module. An independent module is a module which is
+ * not derived from or based on this library. If you modify this
+ * library, you may extend this exception to your version of the
+ * library, but you are not obliged to do so. If you do not wish
+ * to do so, delete this exception statement from your version.
+ */
+
+
+#include "CO_driver.h"
+#include "crc16-ccitt.h"
+#include "CO_traceStream.h"
+
+#if CO_TRACE_STREAM > 0
+
+/* Maximum payload of one packet, length is one byte */
+#define CO_TRACE_STREAM_PAYLOAD_MAX 255U
+
+/* Object, which is served by HAL_UART_TxCpltCallback() */
+static CO_traceStream_t *CO_traceStreamObj = NULL;
+
+
+/*
+ * Start DMA transmission of filled buffer, interrupts must be disabled.
+ */
+static void CO_traceStream_start(CO_traceStream_t *stream){
+    uint8_t idx = stream->fill;
+
+    if(!stream->busy && (stream->length[idx] != 0U)){
+        stream->fill = idx ^ 1U;
+        if(HAL_UART_Transmit_DMA(stream->huart, stream->buf[idx], stream->length[idx]) == HAL_OK){
+            stream->busy = true;
+        }
+        else{
+            /* drop buffer, try again with the next one */
+            stream->length[idx] = 0U;
+        }
+    }
+}
+
+
+/*
+ * Fill buffer with packets, round robin over traces.
+ */
+static uint16_t CO_traceStream_fill(CO_traceStream_t *stream, uint8_t *buf){
+    uint16_t len = 0U;
+    uint8_t empty = 0U;
+
+    while((empty < stream->traceCount)
+          && ((CO_TRACE_STREAM_BUF_SIZE - len) >= (CO_TRACE_STREAM_OVERHEAD + CO_TRACE_DELTA_POINT_MAX))){
+        uint8_t *packet = &buf[len];
+        uint32_t space = CO_TRACE_STREAM_BUF_SIZE - len - CO_TRACE_STREAM_OVERHEAD;
+        uint32_t payload;
+        uint16_t crc;
+        uint8_t traceNo = stream->traceNext;
+
+        if(++stream->traceNext >= stream->traceCount){
+            stream->traceNext = 0U;
+        }
+        if(space > CO_TRACE_STREAM_PAYLOAD_MAX){
+            space = CO_TRACE_STREAM_PAYLOAD_MAX;
+        }
+
+        payload = CO_trace_readDelta(stream->trace[traceNo], &packet[3], space, true);
+        if(payload == 0U){
+            empty++;
+            continue;
+        }
+        empty = 0U;
+
+        packet[0] = CO_TRACE_STREAM_START;
+        packet[1] = traceNo;
+        packet[2] = (uint8_t)payload;
+        crc = crc16_ccitt(&packet[1], payload + 2U, 0U);
+        packet[payload + 3U] = (uint8_t)crc;
+        packet[payload + 4U] = (uint8_t)(crc >> 8);
+        len += (uint16_t)(payload + CO_TRACE_STREAM_OVERHEAD);
+    }
+
+    return len;
+}
+
+
+/******************************************************************************/
+void CO_traceStream_init(
+        CO_traceStream_t       *stream,
+        UART_HandleTypeDef     *huart,
+        CO_trace_t * const     *trace,
+        uint8_t                 traceCount)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    /* stop previous transmission, buffers are reused */
+    __disable_irq();
+    CO_traceStreamObj = NULL;
+    __set_PRIMASK(primask);
+    if(stream->busy){
+        (void)HAL_UART_AbortTransmit(stream->huart);
+    }
+
+    stream->huart = huart;
+    stream->trace = trace;
+    stream->traceCount = traceCount;
+    stream->traceNext = 0U;
+    stream->fill = 0U;
+    stream->busy = false;
+    stream->length[0] = 0U;
+    stream->length[1] = 0U;
+
+    CO_traceStreamObj = stream;
+}
+
+
+/******************************************************************************/
+void CO_traceStream_process(CO_traceStream_t *stream){
+    uint8_t idx = stream->fill;
+    uint32_t primask;
+
+    /* interrupt changes fill only, if length[fill] is nonzero */
+    if(stream->length[idx] == 0U){
+        stream->length[idx] = CO_traceStream_fill(stream, stream->buf[idx]);
+    }
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    CO_traceStream_start(stream);
+    __set_PRIMASK(primask);
+}
+
+
+/******************************************************************************/
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart){
+    CO_traceStream_t *stream = CO_traceStreamObj;
+
+    if((stream != NULL) && (huart == stream->huart) && stream->busy){
+        /* buffer, which was transmitted, is free, continue with the other one */
+        stream->length[stream->fill ^ 1U] = 0U;
+        stream->busy = false;
+        CO_traceStream_start(stream);
+    }
+}
+
+#endif /* CO_TRACE_STREAM > 0 */
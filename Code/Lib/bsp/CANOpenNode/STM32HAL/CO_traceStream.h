@@ -0,0 +1,147 @@
+/**
+ * Streaming of CANopen trace over UART with DMA for STM32L4.
+ *
+ * @file        CO_traceStream.h
+ * @ingroup     CO_traceStream
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * CANopenNode is free and open source software: you can redistribute
+ * it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Following clarification and special exception to the GNU General Public
+ * License is included to the distribution terms of CANopenNode:
+ *
+ * Linking this library statically or dynamically with other modules is
+ * making a combined work based on this library. Thus, the terms and
+ * conditions of the GNU General Public License cover the whole combination.
+ *
+ * As a special exception, the copyright holders of this library give
+ * you permission to link this library with independent modules to
+ * produce an executable, regardless of the license terms of these
+ * independent modules, and to copy and distribute the resulting
+ * executable under terms of your choice, provided that you also meet,
+ * for each linked independent module, the terms and conditions of the
+ * license of that module. An independent module is a module which is
+ * not derived from or based on this library. If you modify this
+ * library, you may extend this exception to your version of the
+ * library, but you are not obliged to do so. If you do not wish
+ * to do so, delete this exception statement from your version.
+ */
+
+
+#ifndef CO_TRACE_STREAM_H
+#define CO_TRACE_STREAM_H
+
+#include "CO_driver.h"
+#include "CO_trace.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_traceStream Trace streaming
+ * @ingroup CO_driver
+ * @{
+ *
+ * Points recorded by CO_trace_process() are sent over UART instead of being
+ * printed during SDO upload. Enabled with CO_TRACE_STREAM in CO_driver.h.
+ *
+ * CO_traceStream_process() is called from mainline. It fills one of two
+ * buffers with packets, while the other buffer is transmitted by DMA. Next
+ * buffer is started from HAL_UART_TxCpltCallback(), so the line stays busy
+ * as long as there are points. Points, which are streamed, are removed from
+ * trace buffer and are not available for SDO upload any more.
+ *
+ * ###Packet
+ *
+ *   Bytes | Description
+ *   ------|-----------------------------------------------------------
+ *     1   | Start byte, #CO_TRACE_STREAM_START
+ *     1   | Trace number, 0 for the first trace
+ *     1   | Payload length n, 1..255
+ *     n   | Points in delta binary format, first point is absolute
+ *     2   | crc16_ccitt() of trace number, length and payload, little endian
+ *
+ * Each packet is decoded independently, receiver resynchronizes on the
+ * start byte with valid CRC.
+ */
+
+
+/** Start byte of the packet */
+#define CO_TRACE_STREAM_START       0xA5U
+/** Bytes of the packet without payload */
+#define CO_TRACE_STREAM_OVERHEAD    5U
+
+
+/**
+ * Trace stream object.
+ */
+typedef struct{
+    /** From CO_traceStream_init() */
+    UART_HandleTypeDef *huart;
+    /** From CO_traceStream_init() */
+    CO_trace_t * const *trace;
+    /** From CO_traceStream_init() */
+    uint8_t             traceCount;
+    /** Trace, which is read first in the next buffer */
+    uint8_t             traceNext;
+    /** Buffer, which is filled next. The other one may be transmitted. */
+    volatile uint8_t    fill;
+    /** True, while DMA transmits buffer (fill ^ 1) */
+    volatile bool_t     busy;
+    /** Number of bytes in each buffer, 0 if buffer is free */
+    volatile uint16_t   length[2];
+    /** Transmit buffers */
+    uint8_t             buf[2][CO_TRACE_STREAM_BUF_SIZE];
+}CO_traceStream_t;
+
+
+/**
+ * Initialize trace stream.
+ *
+ * UART must be configured with transmit DMA (hdmatx linked). Function must
+ * be called after each communication reset, because traces are reinitialized.
+ *
+ * @param stream This object will be initialized.
+ * @param huart UART handle, for example huart1.
+ * @param trace Array of trace objects, usually CO->trace.
+ * @param traceCount Number of traces in array.
+ */
+void CO_traceStream_init(
+        CO_traceStream_t       *stream,
+        UART_HandleTypeDef     *huart,
+        CO_trace_t * const     *trace,
+        uint8_t                 traceCount);
+
+
+/**
+ * Process trace stream.
+ *
+ * Function must be called cyclically from the same thread as SDO server,
+ * for example after CO_process().
+ *
+ * @param stream This object.
+ */
+void CO_traceStream_process(CO_traceStream_t *stream);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif
@@ -0,0 +1,603 @@
+/*
+ * CAN module object for Linux socketCAN.
+ *
+ * @file        CO_driver.c
+ * @ingroup     CO_driver
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * CANopenNode is free and open source software: you can redistribute
+ * it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Following clarification and special exception to the GNU General Public
+ * License is included to the distribution terms of CANopenNode:
+ *
+ * Linking this library statically or dynamically with other modules is
+ * making a combined work based on this library. Thus, the terms and
+ * conditions of the GNU General Public License cover the whole combination.
+ *
+ * As a special exception, the copyright holders of this library give
+ * you permission to link this library with independent modules to
+ * produce an executable, regardless of the license terms of these
+ * independent modules, and to copy and distribute the resulting
+ * executable under terms of your choice, provided that you also meet,
+ * for each linked independent module, the terms and conditions of the
+ * license of that module. An independent module is a module which is
+ * not derived from or based on this library. If you modify this
+ * library, you may extend this exception to your version of the
+ * library, but you are not obliged to do so. If you do not wish
+ * to do so, delete this exception statement from your version.
+ */
+
+
+#define _GNU_SOURCE     /* PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP */
+
+#include "CO_driver.h"
+#include "CO_Emergency.h"
+
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <linux/can.h>
+#include <linux/can/raw.h>
+
+#if CO_CAN_DATA_SIZE > 64U
+#error CO_CAN_DATA_SIZE can not be more than 64
+#endif
+
+#if CO_CAN_DATA_SIZE > 8U
+/* CAN FD socket, classic frames are written and read with CAN_MTU */
+typedef struct canfd_frame CO_CANframe_t;
+#define CO_CAN_FRAME_LEN(frame) (frame).len
+#else
+typedef struct can_frame CO_CANframe_t;
+#define CO_CAN_FRAME_LEN(frame) (frame).can_dlc
+#endif
+#include <linux/can/error.h>
+
+
+pthread_mutex_t CO_CAN_SEND_mutex = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+pthread_mutex_t CO_EMCY_mutex = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+pthread_mutex_t CO_OD_mutex = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+
+
+/******************************************************************************/
+void CO_CANsetConfigurationMode(int32_t CANbaseAddress){
+    (void)CANbaseAddress;
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_CANsetNormalMode(CO_CANmodule_t *CANmodule){
+    CANmodule->CANnormal = true;
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_CANmodule_init(
+        CO_CANmodule_t         *CANmodule,
+        int32_t                 CANbaseAddress,
+        CO_CANrx_t              rxArray[],
+        uint16_t                rxSize,
+        CO_CANtx_t              txArray[],
+        uint16_t                txSize,
+        uint16_t                CANbitRate)
+{
+    struct sockaddr_can addr;
+    can_err_mask_t errMask = CAN_ERR_CRTL | CAN_ERR_BUSOFF | CAN_ERR_RESTARTED;
+    int enable = 1;
+    uint16_t i;
+
+    /* verify arguments */
+    if(CANmodule==NULL || rxArray==NULL || txArray==NULL || CANbaseAddress < 0){
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    /* Configure object variables */
+    CANmodule->CANbaseAddress = CANbaseAddress;
+    CANmodule->rxArray = rxArray;
+    CANmodule->rxSize = rxSize;
+    CANmodule->rxSlice = rxSize;
+    CANmodule->txArray = txArray;
+    CANmodule->txSize = txSize;
+    CANmodule->CANnormal = false;
+    CANmodule->useCANrxFilters = false;
+    CANmodule->bufferInhibitFlag = false;
+    CANmodule->firstCANtxMessage = true;
+    CANmodule->CANtxCount = 0U;
+    CANmodule->errState = 0U;
+    CANmodule->errOld = 0U;
+    CANmodule->rxDropped = 0U;
+    CANmodule->rxDroppedOld = 0U;
+    CANmodule->em = NULL;
+    CANmodule->CANbitRate = CANbitRate;
+    CANmodule->txSink = NULL;
+
+    for(i=0U; i<rxSize; i++){
+        rxArray[i].ident = 0U;
+        rxArray[i].mask = 0xFFFFU;
+        rxArray[i].object = NULL;
+        rxArray[i].pFunct = NULL;
+    }
+    for(i=0U; i<txSize; i++){
+        txArray[i].bufferFull = false;
+    }
+
+    /* no interface, transmitted frames are discarded and nothing is received */
+    CANmodule->fd = -1;
+    if(CANbaseAddress == 0){
+        return CO_ERROR_NO;
+    }
+
+    /* nonblocking raw socket, frames are read by CO_CANrxProcess() */
+    CANmodule->fd = socket(PF_CAN, SOCK_RAW | SOCK_NONBLOCK, CAN_RAW);
+    if(CANmodule->fd < 0){
+        return CO_ERROR_SYSCALL;
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    addr.can_family = AF_CAN;
+    addr.can_ifindex = CANbaseAddress;
+    if(bind(CANmodule->fd, (struct sockaddr*)&addr, sizeof(addr)) != 0
+#if CO_CAN_DATA_SIZE > 8U
+       || setsockopt(CANmodule->fd, SOL_CAN_RAW, CAN_RAW_FD_FRAMES, &enable, sizeof(enable)) != 0
+#endif
+       || setsockopt(CANmodule->fd, SOL_CAN_RAW, CAN_RAW_ERR_FILTER, &errMask, sizeof(errMask)) != 0
+       || setsockopt(CANmodule->fd, SOL_SOCKET, SO_RXQ_OVFL, &enable, sizeof(enable)) != 0)
+    {
+        close(CANmodule->fd);
+        CANmodule->fd = -1;
+        return CO_ERROR_SYSCALL;
+    }
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+void CO_CANmodule_disable(CO_CANmodule_t *CANmodule){
+    CANmodule->CANnormal = false;
+    if(CANmodule->fd >= 0){
+        close(CANmodule->fd);
+        CANmodule->fd = -1;
+    }
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_CANmodule_setRxSlice(CO_CANmodule_t *CANmodule, uint16_t rxSlice){
+    if(CANmodule==NULL || rxSlice==0U || (CANmodule->rxSize % rxSlice) != 0U){
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+    CANmodule->rxSlice = rxSlice;
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+uint16_t CO_CANrxMsg_readIdent(const CO_CANrxMsg_t *rxMsg){
+    return (uint16_t) rxMsg->ident;
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_CANrxBufferInit(
+        CO_CANmodule_t         *CANmodule,
+        uint16_t                index,
+        uint16_t                ident,
+        uint16_t                mask,
+        bool_t                  rtr,
+        void                   *object,
+        void                  (*pFunct)(void *object, const CO_CANrxMsg_t *message))
+{
+    CO_CANrx_t *buffer;
+
+    if((CANmodule==NULL) || (object==NULL) || (pFunct==NULL) || (index >= CANmodule->rxSize)){
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    /* buffer, which will be configured */
+    buffer = &CANmodule->rxArray[index];
+
+    /* Configure object variables, same alignment as CO_CANrxMsg_readIdent() */
+    buffer->object = object;
+    buffer->pFunct = pFunct;
+    buffer->ident = ident & 0x07FFU;
+    if(rtr){
+        buffer->ident |= 0x0800U;
+    }
+    buffer->mask = (mask & 0x07FFU) | 0x0800U;
+
+    return CO_ERROR_NO;
+}
+
+
+/*
+ * Receive function of buffers configured by CO_CANrxBufferInitRange().
+ */
+static void CO_CANrxRange(void *object, const CO_CANrxMsg_t *message){
+    const CO_CANrxRange_t *range = (const CO_CANrxRange_t *)object;
+    uint16_t offset = (uint16_t)((CO_CANrxMsg_readIdent(message) & 0x07FFU) - range->ident);
+
+    if(offset < range->count){
+        range->pFunct(range->object, message, offset);
+    }
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_CANrxBufferInitRange(
+        CO_CANmodule_t         *CANmodule,
+        uint16_t                index,
+        CO_CANrxRange_t        *range,
+        uint16_t                ident,
+        uint16_t                count,
+        void                   *object,
+        void                  (*pFunct)(void *object, const CO_CANrxMsg_t *message, uint16_t offset))
+{
+    uint16_t mask = 0x07FFU;
+
+    if((range == NULL) || (object == NULL) || (pFunct == NULL) ||
+       (ident > 0x07FFU) || (count == 0U) || (count > (0x0800U - ident))){
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    /* smallest aligned block of identifiers, which contains the range */
+    while(((ident ^ (uint16_t)(ident + count - 1U)) & mask) != 0U){
+        mask = (uint16_t)(mask << 1) & 0x07FFU;
+    }
+
+    range->ident = ident;
+    range->count = count;
+    range->object = object;
+    range->pFunct = pFunct;
+
+    return CO_CANrxBufferInit(CANmodule, index, ident & mask, mask, false, (void*)range, CO_CANrxRange);
+}
+
+
+/******************************************************************************/
+CO_CANtx_t *CO_CANtxBufferInit(
+        CO_CANmodule_t         *CANmodule,
+        uint16_t                index,
+        uint16_t                ident,
+        bool_t                  rtr,
+        uint8_t                 noOfBytes,
+        bool_t                  syncFlag)
+{
+    CO_CANtx_t *buffer;
+
+    if((CANmodule == NULL) || (index >= CANmodule->txSize) || (noOfBytes > 8U)){
+        return NULL;
+    }
+
+    /* get specific buffer */
+    buffer = &CANmodule->txArray[index];
+
+    buffer->ident = (uint32_t)ident & CAN_SFF_MASK;
+    if(rtr){
+        buffer->ident |= CAN_RTR_FLAG;
+    }
+    buffer->DLC = noOfBytes;
+    buffer->bufferFull = false;
+    buffer->syncFlag = syncFlag;
+
+    return buffer;
+}
+
+
+/*
+ * Write buffer to the socket, CO_LOCK_CAN_SEND() must be held.
+ * Return false, if socket buffer is full.
+ */
+static bool_t CO_CANwrite(CO_CANmodule_t *CANmodule, CO_CANtx_t *buffer){
+    CO_CANframe_t frame;
+    size_t size = CAN_MTU;
+
+    if(CANmodule->fd < 0){
+        if(CANmodule->txSink != NULL){
+            CANmodule->txSink(buffer);
+        }
+        CANmodule->firstCANtxMessage = false;
+        return true;
+    }
+
+    memset(&frame, 0, sizeof(frame));
+    frame.can_id = buffer->ident;
+    CO_CAN_FRAME_LEN(frame) = buffer->DLC;
+    memcpy(frame.data, buffer->data, buffer->DLC);
+#if CO_CAN_DATA_SIZE > 8U
+    if(buffer->DLC > 8U){
+        /* CAN FD data length, unused bytes are zero padding */
+        static const uint8_t fdLength[] = {12U, 16U, 20U, 24U, 32U, 48U, 64U};
+        uint8_t i = 0U;
+
+        while(fdLength[i] < buffer->DLC){
+            i++;
+        }
+        frame.len = fdLength[i];
+        frame.flags = (CO_CAN_FD_BRS > 0) ? CANFD_BRS : 0U;
+        size = CANFD_MTU;
+    }
+#endif
+
+    if(write(CANmodule->fd, &frame, size) != (ssize_t)size){
+        return false;
+    }
+    CANmodule->firstCANtxMessage = false;
+    return true;
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_CANsend(CO_CANmodule_t *CANmodule, CO_CANtx_t *buffer){
+    CO_ReturnError_t err = CO_ERROR_NO;
+
+    /* Verify overflow */
+    if(buffer->bufferFull){
+        if(!CANmodule->firstCANtxMessage){
+            /* don't set error, if bootup message is still on buffers */
+            CO_errorReport((CO_EM_t*)CANmodule->em, CO_EM_CAN_TX_OVERFLOW, CO_EMC_CAN_OVERRUN, buffer->ident);
+        }
+        err = CO_ERROR_TX_OVERFLOW;
+    }
+
+    CO_LOCK_CAN_SEND();
+    /* Message is written in order, older waiting messages first */
+    if(CANmodule->CANtxCount == 0U && CO_CANwrite(CANmodule, buffer)){
+        if(buffer->bufferFull){
+            buffer->bufferFull = false;
+        }
+    }
+    else if(!buffer->bufferFull){
+        /* ENOBUFS or EAGAIN, wait for CO_CANpolling_Tx() */
+        if(errno != ENOBUFS && errno != EAGAIN && CANmodule->CANtxCount == 0U){
+            err = CO_ERROR_SYSCALL;
+        }
+        buffer->bufferFull = true;
+        CANmodule->CANtxCount++;
+    }
+    CO_UNLOCK_CAN_SEND();
+
+    return err;
+}
+
+
+/******************************************************************************/
+void CO_CANpolling_Tx(CO_CANmodule_t *CANmodule){
+    CO_LOCK_CAN_SEND();
+    if(CANmodule->CANtxCount > 0U){
+        uint16_t i;
+
+        for(i = 0U; i < CANmodule->txSize; i++){
+            CO_CANtx_t *buffer = &CANmodule->txArray[i];
+
+            if(buffer->bufferFull){
+                if(!CO_CANwrite(CANmodule, buffer)){
+                    break;
+                }
+                buffer->bufferFull = false;
+                CANmodule->CANtxCount--;
+            }
+        }
+    }
+    CO_UNLOCK_CAN_SEND();
+}
+
+
+/******************************************************************************/
+void CO_CANclearPendingSyncPDOs(CO_CANmodule_t *CANmodule){
+    uint32_t tpdoDeleted = 0U;
+
+    CO_LOCK_CAN_SEND();
+    /* delete pending synchronous TPDOs in TX buffers */
+    if(CANmodule->CANtxCount != 0U){
+        uint16_t i;
+
+        for(i = 0U; i < CANmodule->txSize; i++){
+            CO_CANtx_t *buffer = &CANmodule->txArray[i];
+
+            if(buffer->bufferFull && buffer->syncFlag){
+                buffer->bufferFull = false;
+                CANmodule->CANtxCount--;
+                tpdoDeleted = 2U;
+            }
+        }
+    }
+    CO_UNLOCK_CAN_SEND();
+
+    if(tpdoDeleted != 0U){
+        CO_errorReport((CO_EM_t*)CANmodule->em, CO_EM_TPDO_OUTSIDE_WINDOW, CO_EMC_COMMUNICATION, tpdoDeleted);
+    }
+}
+
+
+/******************************************************************************/
+void CO_CANverifyErrors(CO_CANmodule_t *CANmodule){
+    CO_EM_t* em = (CO_EM_t*)CANmodule->em;
+    uint32_t errState = CANmodule->errState;
+    uint32_t rxDropped = CANmodule->rxDropped;
+
+    if(CANmodule->errOld != errState){
+        CANmodule->errOld = errState;
+
+        if(errState & CO_CAN_ERRSTATE_BUS_OFF){
+            CO_errorReport(em, CO_EM_CAN_TX_BUS_OFF, CO_EMC_BUS_OFF_RECOVERED, errState);
+        }
+        else{
+            CO_errorReset(em, CO_EM_CAN_TX_BUS_OFF, errState);
+
+            if(errState & CO_CAN_ERRSTATE_WARNING){
+                CO_errorReport(em, CO_EM_CAN_BUS_WARNING, CO_EMC_NO_ERROR, errState);
+            }
+            else{
+                CO_errorReset(em, CO_EM_CAN_BUS_WARNING, errState);
+            }
+
+            if(errState & CO_CAN_ERRSTATE_PASSIVE){
+                if(!CANmodule->firstCANtxMessage){
+                    CO_errorReport(em, CO_EM_CAN_TX_BUS_PASSIVE, CO_EMC_CAN_PASSIVE, errState);
+                }
+            }
+            else if(CO_isError(em, CO_EM_CAN_TX_BUS_PASSIVE)){
+                CO_errorReset(em, CO_EM_CAN_TX_BUS_PASSIVE, errState);
+                CO_errorReset(em, CO_EM_CAN_TX_OVERFLOW, errState);
+            }
+        }
+    }
+
+    /* controller or socket receive queue overflow */
+    if((errState & CO_CAN_ERRSTATE_RX_OVERFLOW) || rxDropped != CANmodule->rxDroppedOld){
+        CO_errorReport(em, CO_EM_CAN_RXB_OVERFLOW, CO_EMC_CAN_OVERRUN, rxDropped);
+        CANmodule->rxDroppedOld = rxDropped;
+        __atomic_fetch_and(&CANmodule->errState, ~CO_CAN_ERRSTATE_RX_OVERFLOW, __ATOMIC_RELAXED);
+    }
+}
+
+
+/*
+ * Update errState from socketCAN error frame.
+ */
+static void CO_CANerrorFrame(CO_CANmodule_t *CANmodule, const struct can_frame *frame){
+    uint32_t errState = CANmodule->errState & CO_CAN_ERRSTATE_RX_OVERFLOW;
+
+    if(frame->can_id & CAN_ERR_BUSOFF){
+        errState |= CO_CAN_ERRSTATE_BUS_OFF;
+    }
+    if(frame->can_id & CAN_ERR_CRTL){
+        if(frame->data[1] & (CAN_ERR_CRTL_RX_WARNING | CAN_ERR_CRTL_TX_WARNING)){
+            errState |= CO_CAN_ERRSTATE_WARNING;
+        }
+        if(frame->data[1] & (CAN_ERR_CRTL_RX_PASSIVE | CAN_ERR_CRTL_TX_PASSIVE)){
+            errState |= CO_CAN_ERRSTATE_PASSIVE;
+        }
+        if(frame->data[1] & (CAN_ERR_CRTL_RX_OVERFLOW)){
+            errState |= CO_CAN_ERRSTATE_RX_OVERFLOW;
+        }
+    }
+    /* CAN_ERR_RESTARTED or CAN_ERR_CRTL_ACTIVE clear the state */
+    CANmodule->errState = errState;
+}
+
+
+/******************************************************************************/
+void CO_CANrxProcess(CO_CANmodule_t *CANmodule){
+    while(CANmodule->fd >= 0){
+        CO_CANframe_t frame;
+        char ctrl[CMSG_SPACE(sizeof(uint32_t))];
+        struct iovec iov = { &frame, sizeof(frame) };
+        struct msghdr msg;
+        struct cmsghdr *cmsg;
+        CO_CANrxMsg_t rcvMsg;
+        ssize_t size;
+
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = ctrl;
+        msg.msg_controllen = sizeof(ctrl);
+
+        size = recvmsg(CANmodule->fd, &msg, 0);
+        if(size != (ssize_t)CAN_MTU && size != (ssize_t)sizeof(frame)){
+            break;      /* EAGAIN, no more frames */
+        }
+
+        /* counter of frames dropped by the socket */
+        for(cmsg = CMSG_FIRSTHDR(&msg); cmsg != NULL; cmsg = CMSG_NXTHDR(&msg, cmsg)){
+            if(cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SO_RXQ_OVFL){
+                memcpy(&CANmodule->rxDropped, CMSG_DATA(cmsg), sizeof(uint32_t));
+            }
+        }
+
+        if(frame.can_id & CAN_ERR_FLAG){
+            CO_CANerrorFrame(CANmodule, (const struct can_frame*)&frame);
+            continue;
+        }
+        if(frame.can_id & CAN_EFF_FLAG){
+            continue;   /* CANopen uses standard frames only */
+        }
+
+        rcvMsg.ident = frame.can_id & CAN_SFF_MASK;
+        if(frame.can_id & CAN_RTR_FLAG){
+            rcvMsg.ident |= 0x0800U;
+        }
+        rcvMsg.DLC = CO_CAN_FRAME_LEN(frame);
+        if(rcvMsg.DLC > CO_CAN_DATA_SIZE){
+            rcvMsg.DLC = CO_CAN_DATA_SIZE;
+        }
+        memcpy(rcvMsg.data, frame.data, rcvMsg.DLC);
+
+        CO_CANrxDispatch(CANmodule, &rcvMsg);
+    }
+}
+
+
+/******************************************************************************/
+void CO_CANrxDispatch(CO_CANmodule_t *CANmodule, const CO_CANrxMsg_t *rcvMsg){
+    uint16_t index;
+
+    /* search rxArray the same way as without hardware filters, first
+     * matching buffer in each slice (CANopen device) gets the message */
+    for(index = 0U; index < CANmodule->rxSize; index++){
+        CO_CANrx_t *buffer = &CANmodule->rxArray[index];
+
+        if(((rcvMsg->ident ^ buffer->ident) & buffer->mask) == 0U){
+            if(buffer->pFunct != NULL){
+                buffer->pFunct(buffer->object, rcvMsg);
+            }
+            /* continue at the start of the next slice */
+            index = (uint16_t)((index / CANmodule->rxSlice + 1U) * CANmodule->rxSlice - 1U);
+        }
+    }
+}
+
+
+/******************************************************************************/
+uint8_t CO_atomicFetchOr8(volatile uint8_t *p, uint8_t mask){
+    return __atomic_fetch_or(p, mask, __ATOMIC_SEQ_CST);
+}
+
+
+/******************************************************************************/
+uint8_t CO_atomicFetchAnd8(volatile uint8_t *p, uint8_t mask){
+    return __atomic_fetch_and(p, mask, __ATOMIC_SEQ_CST);
+}
+
+
+/******************************************************************************/
+uint8_t CO_atomicExchange8(volatile uint8_t *p, uint8_t value){
+    return __atomic_exchange_n(p, value, __ATOMIC_SEQ_CST);
+}
+
+
+/******************************************************************************/
+bool_t CO_atomicCompareExchange8(volatile uint8_t *p, uint8_t expected, uint8_t value){
+    return __atomic_compare_exchange_n(p, &expected, value, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST) ? true : false;
+}
+
+
+/******************************************************************************/
+uint32_t CO_atomicFetchOr32(volatile uint32_t *p, uint32_t mask){
+    return __atomic_fetch_or(p, mask, __ATOMIC_SEQ_CST);
+}
+
+
+/******************************************************************************/
+uint32_t CO_atomicFetchAnd32(volatile uint32_t *p, uint32_t mask){
+    return __atomic_fetch_and(p, mask, __ATOMIC_SEQ_CST);
+}
@@ -0,0 +1,615 @@
+/**
+ * CAN module object for Linux socketCAN.
+ *
+ * @file        CO_driver.h
+ * @ingroup     CO_driver
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * CANopenNode is free and open source software: you can redistribute
+ * it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Following clarification and special exception to the GNU General Public
+ * License is included to the distribution terms of CANopenNode:
+ *
+ * Linking this library statically or dynamically with other modules is
+ * making a combined work based on this library. Thus, the terms and
+ * conditions of the GNU General Public License cover the whole combination.
+ *
+ * As a special exception, the copyright holders of this library give
+ * you permission to link this library with independent modules to
+ * produce an executable, regardless of the license terms of these
+ * independent modules, and to copy and distribute the resulting
+ * executable under terms of your choice, provided that you also meet,
+ * for each linked independent module, the terms and conditions of the
+ * license of that module. An independent module is a module which is
+ * not derived from or based on this library. If you modify this
+ * library, you may extend this exception to your version of the
+ * library, but you are not obliged to do so. If you do not wish
+ * to do so, delete this exception statement from your version.
+ */
+
+
+#ifndef CO_DRIVER_H
+#define CO_DRIVER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Include processor header file */
+#include <stddef.h>         /* for 'NULL' */
+#include <stdint.h>         /* for 'int8_t' to 'uint64_t' */
+#include <stdbool.h>        /* for 'true', 'false' */
+#include <pthread.h>
+
+
+/**
+ * @defgroup CO_driver Driver
+ * @ingroup CO_CANopen
+ * @{
+ *
+ * Linux socketCAN specific code for CANopenNode, used for host simulation.
+ *
+ * API is the same as in STM32HAL/CO_driver.h, so the stack, application
+ * Object Dictionary and PDO configuration are built unchanged. CAN module is
+ * a raw CAN socket bound to one interface, usually virtual (vcan). Socket is
+ * nonblocking, CO_CANrxProcess() reads all waiting frames and is called from
+ * a thread, which waits for _fd_ with epoll. It replaces CAN receive
+ * interrupt. Messages are searched in _rxArray_ by software.
+ *
+ * CO_CANsend() writes frame to the socket directly. If socket buffer is full,
+ * buffer stays _bufferFull_ and is written by CO_CANpolling_Tx().
+ *
+ * Critical sections are recursive mutexes, so nested locks behave as nested
+ * PRIMASK sections on the microcontroller.
+ */
+
+
+/**
+ * @name Critical sections
+ * @{
+ */
+extern pthread_mutex_t CO_CAN_SEND_mutex;  /**< Used by CO_LOCK_CAN_SEND() */
+extern pthread_mutex_t CO_EMCY_mutex;      /**< Used by CO_LOCK_EMCY() */
+extern pthread_mutex_t CO_OD_mutex;        /**< Used by CO_LOCK_OD() */
+
+#define CO_LOCK_CAN_SEND()      pthread_mutex_lock(&CO_CAN_SEND_mutex)
+#define CO_UNLOCK_CAN_SEND()    pthread_mutex_unlock(&CO_CAN_SEND_mutex)
+
+#define CO_LOCK_EMCY()          pthread_mutex_lock(&CO_EMCY_mutex)    /**< Lock critical section in CO_errorReport() or CO_errorReset() */
+#define CO_UNLOCK_EMCY()        pthread_mutex_unlock(&CO_EMCY_mutex)  /**< Unlock critical section in CO_errorReport() or CO_errorReset() */
+
+#define CO_LOCK_OD()            pthread_mutex_lock(&CO_OD_mutex)      /**< Lock critical section when accessing Object Dictionary */
+#define CO_UNLOCK_OD()          pthread_mutex_unlock(&CO_OD_mutex)    /**< Unlock critical section when accessing Object Dictionary */
+
+#define CO_MEMORY_BARRIER()     __sync_synchronize()
+#define CO_ATOMIC_OR32(p, mask) (void)__sync_fetch_and_or((p), (uint32_t)(mask))
+/** @} */
+
+
+/**
+ * Stack options, which depend on the driver. Optimizations for bxCAN and
+ * Cortex-M are disabled, defaults are the same as in STM32HAL/CO_driver.h.
+ */
+#ifndef CO_EM_LOCK_FREE
+#define CO_EM_LOCK_FREE         0
+#endif
+#ifndef CO_CAN_TX_PENDING_WORDS
+#define CO_CAN_TX_PENDING_WORDS 1U
+#endif
+#ifndef CO_CAN_TIMESTAMP
+#define CO_CAN_TIMESTAMP        0
+#endif
+#ifndef CO_CAN_DATA_SIZE
+#define CO_CAN_DATA_SIZE        8U
+#endif
+#ifndef CO_CAN_FD_BRS
+#define CO_CAN_FD_BRS           1
+#endif
+#ifndef CO_TPDO_DIRTY_FLAGS
+#define CO_TPDO_DIRTY_FLAGS     0
+#endif
+#ifndef CO_OD_HASH_BITS
+#define CO_OD_HASH_BITS         0
+#endif
+#ifndef CO_SDO_FAST_EXPEDITED
+#define CO_SDO_FAST_EXPEDITED   0
+#endif
+#ifndef CO_SDO_BUFFER_SIZE
+#define CO_SDO_BUFFER_SIZE      889
+#endif
+#ifndef CO_DCF
+#define CO_DCF                  0
+#endif
+#ifndef CO_EDS_STORE
+#define CO_EDS_STORE            0
+#endif
+#ifndef CO_TIME_HIGH_RES
+#define CO_TIME_HIGH_RES        1
+#endif
+#ifndef CO_TIME_PRODUCER_MS
+#define CO_TIME_PRODUCER_MS     1000U
+#endif
+#ifndef CO_OD_FLAT_SIZE
+#define CO_OD_FLAT_SIZE         0
+#endif
+#ifndef CO_INLINE_HELPERS
+#define CO_INLINE_HELPERS       1
+#endif
+#ifndef CO_PDO_FAST_BOOT
+#define CO_PDO_FAST_BOOT        0
+#endif
+#ifndef CO_HB_TIMER_WHEEL
+#define CO_HB_TIMER_WHEEL       0
+#endif
+#ifndef CO_HB_CONS_RANGE
+#define CO_HB_CONS_RANGE        0
+#endif
+#ifndef CO_OD_MIRROR
+#define CO_OD_MIRROR            0
+#endif
+#ifndef CO_OD_MIRROR_ENTRIES
+#define CO_OD_MIRROR_ENTRIES    64U
+#endif
+#ifndef CO_OD_MIRROR_ATTR
+#define CO_OD_MIRROR_ATTR
+#endif
+#ifndef CO_OD_MIRROR_SIGNAL
+#define CO_OD_MIRROR_SIGNAL(direction)
+#endif
+#ifndef CO_EM_PRIORITY_QUEUE
+#define CO_EM_PRIORITY_QUEUE    0
+#endif
+#ifndef CO_EM_BITSET
+#define CO_EM_BITSET            0
+#endif
+#ifndef CO_GATEWAY
+#define CO_GATEWAY              0
+#endif
+#ifndef CO_GATEWAY_LINE_SIZE
+#define CO_GATEWAY_LINE_SIZE    128U
+#endif
+#ifndef CO_GATEWAY_DATA_SIZE
+#define CO_GATEWAY_DATA_SIZE    128U
+#endif
+#define CO_PROFILE              0
+#define CO_PROFILE_BEGIN(start)
+#define CO_PROFILE_END(stage, start)
+#define CO_PROFILE_RX(ident)
+#define CO_PROFILE_TPDO_SENT()
+#define CO_ITM_TRACE            0
+#define CO_ITM_EVENT(event, value)
+#define CO_CAN_STATISTICS       0
+#define CO_CAN_BUSLOAD          0
+#define CO_CAN_AUTO_BITRATE     0
+#define CO_TRACE_STREAM         0
+#define CO_RAMFUNC
+#define CO_TPDO_STREAM          0
+#define CO_CAN_TX_CALLBACK      0
+#define CO_TPDO_PRESTAGE        0
+#ifndef CO_TPDO_SYNC_PHASE
+#define CO_TPDO_SYNC_PHASE      0
+#endif
+#ifndef CO_TPDO_CALENDAR
+#define CO_TPDO_CALENDAR        0
+#endif
+#ifndef CO_PDO_MPDO
+#define CO_PDO_MPDO             0
+#endif
+#ifndef CO_PDO_SHADOW_MAP
+#define CO_PDO_SHADOW_MAP       0
+#endif
+#define CO_RPDO_SEQLOCK         0
+#ifndef CO_RPDO_HANDLERS
+#define CO_RPDO_HANDLERS        0
+#endif
+#ifndef CO_TPDO_ADAPTIVE_INHIBIT
+#define CO_TPDO_ADAPTIVE_INHIBIT 0
+#endif
+#define CO_SYNC_HW_TIMER        0
+#define CO_HB_HW_TIMER          0
+#ifndef CO_PRUNE_SYNC
+#define CO_PRUNE_SYNC           0
+#endif
+#ifndef CO_PRUNE_HB_CONS
+#define CO_PRUNE_HB_CONS        0
+#endif
+#ifndef CO_PRUNE_SDO_SERVER
+#define CO_PRUNE_SDO_SERVER     0
+#endif
+#define CO_SYNC_WINDOW_TIMER    0
+#define CO_CAN_TX_RESERVED      0
+#define CO_CAN_TX_CRITICAL      0
+#define CO_CAN_TX_FLAG_CRITICAL 0U
+#ifndef CO_TRACE_BUFFER_SIZE_FIXED
+#define CO_TRACE_BUFFER_SIZE_FIXED 512
+#endif
+#ifndef CO_BENCH
+#define CO_BENCH                0
+#endif
+#if CO_BENCH > 0
+#include <time.h>
+/** Time stamp for CO_bench.c in nanoseconds from monotonic clock */
+static inline uint32_t CO_benchTime(void){
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000U + (uint64_t)ts.tv_nsec);
+}
+#define CO_BENCH_TIME_INIT()
+#define CO_BENCH_TIME()         CO_benchTime()
+#define CO_BENCH_TIME_UNIT      "ns"
+#endif
+
+
+/**
+ * @defgroup CO_dataTypes Data types
+ * @{
+ *
+ * According to Misra C
+ */
+/* int8_t to uint64_t are defined in stdint.h */
+typedef unsigned char           bool_t;     /**< bool_t */
+typedef float                   float32_t;  /**< float32_t */
+typedef long double             float64_t;  /**< float64_t */
+typedef char                    char_t;     /**< char_t */
+typedef unsigned char           oChar_t;    /**< oChar_t */
+typedef unsigned char           domain_t;   /**< domain_t */
+/** @} */
+
+
+/**
+ * Return values of some CANopen functions. If function was executed
+ * successfully it returns 0 otherwise it returns <0.
+ */
+typedef enum{
+    CO_ERROR_NO                 =  0,   /**< Operation completed successfully */
+    CO_ERROR_ILLEGAL_ARGUMENT   = -1,   /**< Error in function arguments */
+    CO_ERROR_OUT_OF_MEMORY      = -2,   /**< Memory allocation failed */
+    CO_ERROR_TIMEOUT            = -3,   /**< Function timeout */
+    CO_ERROR_ILLEGAL_BAUDRATE   = -4,   /**< Illegal baudrate passed to function CO_CANmodule_init() */
+    CO_ERROR_RX_OVERFLOW        = -5,   /**< Previous message was not processed yet */
+    CO_ERROR_RX_PDO_OVERFLOW    = -6,   /**< previous PDO was not processed yet */
+    CO_ERROR_RX_MSG_LENGTH      = -7,   /**< Wrong receive message length */
+    CO_ERROR_RX_PDO_LENGTH      = -8,   /**< Wrong receive PDO length */
+    CO_ERROR_TX_OVERFLOW        = -9,   /**< Previous message is still waiting, buffer full */
+    CO_ERROR_TX_PDO_WINDOW      = -10,  /**< Synchronous TPDO is outside window */
+    CO_ERROR_TX_UNCONFIGURED    = -11,  /**< Transmit buffer was not configured properly */
+    CO_ERROR_PARAMETERS         = -12,  /**< Error in function parameters */
+    CO_ERROR_DATA_CORRUPT       = -13,  /**< Stored data are corrupt */
+    CO_ERROR_CRC                = -14,  /**< CRC does not match */
+    CO_ERROR_HAL                = -15,  /**< HAL error, here socket error */
+    CO_ERROR_SYSCALL            = -16   /**< Linux system call failed */
+}CO_ReturnError_t;
+
+
+/**
+ * CAN receive message structure.
+ */
+typedef struct{
+    /** CAN identifier. It must be read through CO_CANrxMsg_readIdent() function. */
+    uint32_t            ident;
+    uint8_t             DLC;            /**< Length of CAN message */
+    uint8_t             data[CO_CAN_DATA_SIZE]; /**< 8 data bytes, see CO_CAN_DATA_SIZE */
+}CO_CANrxMsg_t;
+
+
+/**
+ * Received message object
+ */
+typedef struct{
+    uint16_t            ident;          /**< Standard CAN Identifier (bits 0..10) + RTR (bit 11) */
+    uint16_t            mask;           /**< Standard Identifier mask with same alignment as ident */
+    void               *object;         /**< From CO_CANrxBufferInit() */
+    void              (*pFunct)(void *object, const CO_CANrxMsg_t *message);  /**< From CO_CANrxBufferInit() */
+}CO_CANrx_t;
+
+
+/**
+ * Range of received identifiers, see STM32HAL/CO_driver.h.
+ */
+typedef struct{
+    uint16_t            ident;          /**< First 11-bit identifier of the range */
+    uint16_t            count;          /**< Number of identifiers */
+    void               *object;         /**< From CO_CANrxBufferInitRange() */
+    /** From CO_CANrxBufferInitRange(), offset is identifier - ident */
+    void              (*pFunct)(void *object, const CO_CANrxMsg_t *message, uint16_t offset);
+}CO_CANrxRange_t;
+
+
+/**
+ * Transmit message object.
+ */
+typedef struct{
+    uint32_t            ident;          /**< socketCAN identifier, with CAN_RTR_FLAG */
+    uint8_t             DLC;            /**< Length of CAN message */
+    uint8_t             data[CO_CAN_DATA_SIZE]; /**< 8 data bytes, see CO_CAN_DATA_SIZE */
+    volatile bool_t     bufferFull;     /**< True if previous message is still in buffer */
+    /** Synchronous PDO messages has this flag set. It prevents them to be sent outside the synchronous window */
+    volatile bool_t     syncFlag;
+}CO_CANtx_t;
+
+
+/**
+ * CAN module object.
+ */
+typedef struct{
+    int32_t             CANbaseAddress; /**< From CO_CANmodule_init(), interface index */
+    int                 fd;             /**< CAN_RAW socket, -1 if closed */
+    CO_CANrx_t         *rxArray;        /**< From CO_CANmodule_init() */
+    uint16_t            rxSize;         /**< From CO_CANmodule_init() */
+    uint16_t            rxSlice;        /**< From CO_CANmodule_setRxSlice(), rxSize by default */
+    CO_CANtx_t         *txArray;        /**< From CO_CANmodule_init() */
+    uint16_t            txSize;         /**< From CO_CANmodule_init() */
+    volatile bool_t     CANnormal;      /**< CAN module is in normal mode */
+    /** Always false, messages are searched by software */
+    volatile bool_t     useCANrxFilters;
+    /** Not used, synchronous TPDOs are never held by the socket */
+    volatile bool_t     bufferInhibitFlag;
+    /** Equal to 1, when the first transmitted message (bootup message) is not written yet */
+    volatile bool_t     firstCANtxMessage;
+    /** Number of messages in transmit buffer, which are waiting to be written to the socket */
+    volatile uint16_t   CANtxCount;
+    /** CAN error state from error frames, CO_CAN_ERRSTATE_xxx */
+    volatile uint32_t   errState;
+    uint32_t            errOld;         /**< errState at previous CO_CANverifyErrors() */
+    uint32_t            rxDropped;      /**< Frames dropped by the socket (SO_RXQ_OVFL) */
+    uint32_t            rxDroppedOld;   /**< rxDropped at previous CO_CANverifyErrors() */
+    void               *em;             /**< Emergency object */
+    uint16_t            CANbitRate;     /**< From CO_CANmodule_init(), in kbps, informative */
+    /** If not NULL and there is no socket, transmitted frames are passed to
+     * it instead of being discarded. Set after CO_CANmodule_init(), used by
+     * replay, see CO_replay.h. */
+    void              (*txSink)(const CO_CANtx_t *buffer);
+}CO_CANmodule_t;
+
+
+/**
+ * @name CAN error state bits in errState, from socketCAN error frames
+ * @{
+ */
+#define CO_CAN_ERRSTATE_WARNING     0x01U   /**< TX or RX error warning */
+#define CO_CAN_ERRSTATE_PASSIVE     0x02U   /**< TX or RX error passive */
+#define CO_CAN_ERRSTATE_BUS_OFF     0x04U   /**< Bus off */
+#define CO_CAN_ERRSTATE_RX_OVERFLOW 0x08U   /**< Controller RX overflow, cleared by CO_CANverifyErrors() */
+/** @} */
+
+
+/**
+ * Endianes.
+ *
+ * Depending on processor or compiler architecture, one of the two macros must
+ * be defined: CO_LITTLE_ENDIAN or CO_BIG_ENDIAN. CANopen itself is little endian.
+ */
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define CO_BIG_ENDIAN
+#else
+#define CO_LITTLE_ENDIAN
+#endif
+
+
+/**
+ * Request CAN configuration (stopped) mode.
+ *
+ * Nothing to do for socketCAN, interface is configured with ip link.
+ *
+ * @param CANbaseAddress CAN interface index.
+ */
+void CO_CANsetConfigurationMode(int32_t CANbaseAddress);
+
+
+/**
+ * Request CAN normal (operational) mode.
+ *
+ * @param CANmodule This object.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO.
+ */
+CO_ReturnError_t CO_CANsetNormalMode(CO_CANmodule_t *CANmodule);
+
+
+/**
+ * Initialize CAN module object.
+ *
+ * Function opens CAN_RAW socket and binds it to the interface. It must be
+ * called in the communication reset section with CAN module in
+ * Configuration mode.
+ *
+ * @param CANmodule This object will be initialized.
+ * @param CANbaseAddress CAN interface index, from if_nametoindex(). If 0, no
+ * socket is opened, transmitted frames are discarded. Used by benchmark.
+ * @param rxArray Array for handling received CAN messages
+ * @param rxSize Size of the above array. Must be equal to number of receiving CAN objects.
+ * @param txArray Array for handling transmitting CAN messages
+ * @param txSize Size of the above array. Must be equal to number of transmitting CAN objects.
+ * @param CANbitRate Bit rate in kbps. Informative only, bit rate of the
+ * interface is set with ip link and is ignored by vcan.
+ *
+ * Return #CO_ReturnError_t: CO_ERROR_NO, CO_ERROR_ILLEGAL_ARGUMENT or
+ * CO_ERROR_SYSCALL.
+ */
+CO_ReturnError_t CO_CANmodule_init(
+        CO_CANmodule_t         *CANmodule,
+        int32_t                 CANbaseAddress,
+        CO_CANrx_t              rxArray[],
+        uint16_t                rxSize,
+        CO_CANtx_t              txArray[],
+        uint16_t                txSize,
+        uint16_t                CANbitRate);
+
+
+/**
+ * Close CAN socket. Call at program exit.
+ *
+ * @param CANmodule CAN module object.
+ */
+void CO_CANmodule_disable(CO_CANmodule_t *CANmodule);
+
+
+/**
+ * Share CAN module between several CANopen devices, each with _rxSlice_
+ * consecutive rxArray buffers. Received message is processed by the first
+ * matching buffer in each slice. Call after CO_CANmodule_init().
+ *
+ * @param CANmodule CAN module object.
+ * @param rxSlice Number of buffers of one device, rxSize must be multiple of it.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_CANmodule_setRxSlice(CO_CANmodule_t *CANmodule, uint16_t rxSlice);
+
+
+/**
+ * Read CAN identifier from received message
+ *
+ * @param rxMsg Pointer to received message
+ * @return 11-bit CAN standard identifier.
+ */
+uint16_t CO_CANrxMsg_readIdent(const CO_CANrxMsg_t *rxMsg);
+
+
+/**
+ * Configure CAN message receive buffer.
+ *
+ * See STM32HAL/CO_driver.h. There are no hardware filters, received message
+ * (rcvMsg) is accepted, if (((rcvMsgId ^ ident) & mask) == 0).
+ *
+ * Return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_CANrxBufferInit(
+        CO_CANmodule_t         *CANmodule,
+        uint16_t                index,
+        uint16_t                ident,
+        uint16_t                mask,
+        bool_t                  rtr,
+        void                   *object,
+        void                  (*pFunct)(void *object, const CO_CANrxMsg_t *message));
+
+
+/**
+ * Configure CAN message receive buffer for a range of identifiers.
+ *
+ * See STM32HAL/CO_driver.h.
+ *
+ * Return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_CANrxBufferInitRange(
+        CO_CANmodule_t         *CANmodule,
+        uint16_t                index,
+        CO_CANrxRange_t        *range,
+        uint16_t                ident,
+        uint16_t                count,
+        void                   *object,
+        void                  (*pFunct)(void *object, const CO_CANrxMsg_t *message, uint16_t offset));
+
+
+/**
+ * Configure CAN message transmit buffer.
+ *
+ * See STM32HAL/CO_driver.h.
+ *
+ * @return Pointer to CAN transmit message buffer or NULL in case of wrong arguments.
+ */
+CO_CANtx_t *CO_CANtxBufferInit(
+        CO_CANmodule_t         *CANmodule,
+        uint16_t                index,
+        uint16_t                ident,
+        bool_t                  rtr,
+        uint8_t                 noOfBytes,
+        bool_t                  syncFlag);
+
+
+/**
+ * Send CAN message.
+ *
+ * @param CANmodule This object.
+ * @param buffer Pointer to transmit buffer, returned by CO_CANtxBufferInit().
+ * Data bytes must be written in buffer before function call.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO, CO_ERROR_TX_OVERFLOW or
+ * CO_ERROR_SYSCALL.
+ */
+CO_ReturnError_t CO_CANsend(CO_CANmodule_t *CANmodule, CO_CANtx_t *buffer);
+
+
+/**
+ * Clear all synchronous TPDOs, which wait in transmit buffers.
+ *
+ * @param CANmodule This object.
+ */
+void CO_CANclearPendingSyncPDOs(CO_CANmodule_t *CANmodule);
+
+
+/**
+ * Verify all errors of CAN module.
+ *
+ * Function is called directly from CO_EM_process() function.
+ *
+ * @param CANmodule This object.
+ */
+void CO_CANverifyErrors(CO_CANmodule_t *CANmodule);
+
+
+/**
+ * Read and process all received CAN frames.
+ *
+ * Replaces CAN receive interrupt. Function is called, when _fd_ is readable,
+ * usually from thread, which waits with epoll. Error frames update _errState_.
+ *
+ * @param CANmodule This object.
+ */
+void CO_CANrxProcess(CO_CANmodule_t *CANmodule);
+
+
+/**
+ * Pass one received frame to matching receive buffers.
+ *
+ * This is the software part of CO_CANinterrupt_Rx() on the target, called
+ * by CO_CANrxProcess() for each data frame. It may be called directly to
+ * inject frames without socket, see CO_replay.h.
+ *
+ * @param CANmodule This object.
+ * @param rcvMsg Received frame, ident with RTR in bit 11.
+ */
+void CO_CANrxDispatch(CO_CANmodule_t *CANmodule, const CO_CANrxMsg_t *rcvMsg);
+
+
+/**
+ * Write transmit buffers, which did not fit into socket buffer.
+ *
+ * @param CANmodule This object.
+ */
+void CO_CANpolling_Tx(CO_CANmodule_t *CANmodule);
+
+
+/**
+ * @name Atomic operations on byte, see STM32HAL/CO_driver.h
+ * @{
+ */
+uint8_t CO_atomicFetchOr8(volatile uint8_t *p, uint8_t mask);
+uint8_t CO_atomicFetchAnd8(volatile uint8_t *p, uint8_t mask);
+uint8_t CO_atomicExchange8(volatile uint8_t *p, uint8_t value);
+bool_t CO_atomicCompareExchange8(volatile uint8_t *p, uint8_t expected, uint8_t value);
+uint32_t CO_atomicFetchOr32(volatile uint32_t *p, uint32_t mask);
+uint32_t CO_atomicFetchAnd32(volatile uint32_t *p, uint32_t mask);
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+/** @} */
+#endif
@@ -0,0 +1,574 @@
+/*
+ * CANopen bus load generator and latency harness for Linux socketCAN.
+ *
+ * @file        CO_loadgen.c
+ * @ingroup     CO_driver
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * CANopenNode is free and open source software: you can redistribute
+ * it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Following clarification and special exception to the GNU General Public
+ * License is included to the distribution terms of CANopenNode:
+ *
+ * Linking this library statically or dynamically with other modules is
+ * making a combined work based on this library. Thus, the terms and
+ * conditions of the GNU General Public License cover the whole combination.
+ *
+ * As a special exception, the copyright holders of this library give
+ * you permission to link this library with independent modules to
+ * produce an executable, regardless of the license terms of these
+ * independent modules, and to copy and distribute the resulting
+ * executable under terms of your choice, provided that you also meet,
+ * for each linked independent module, the terms and conditions of the
+ * license of that module. An independent module is a module which is
+ * not derived from or based on this library. If you modify this
+ * library, you may extend this exception to your version of the
+ * library, but you are not obliged to do so. If you do not wish
+ * to do so, delete this exception statement from your version.
+ */
+
+/*
+ * Usage: canopen_loadgen [options] <CAN interface> <node-ID>
+ *   -p <Hz>   RPDO1 echo requests, default 100
+ *   -b <Hz>   additional RPDO2 frames without echo, default 0
+ *   -s <Hz>   SYNC messages, default 0
+ *   -o <Hz>   SDO uploads of 0x1008, default 0, started only if previous ended
+ *   -t <s>    duration, default 10
+ *   -n        don't configure the device
+ *
+ * Device runs with echo, TASK_ECHO on the target or 'canopen_sim -e 1'. Before
+ * the test the generator switches device into pre-operational, maps all 8
+ * bytes of 0x6200 into RPDO1 and of 0x6000 into TPDO1, sets TPDO1 inhibit
+ * time to 0 and starts the device.
+ *
+ * RPDO1 carries 16-bit sequence number, TPDO1 returns it with device reception
+ * time in bytes 4..7. Latency is time from write() to kernel receive time
+ * stamp of the echo (SO_TIMESTAMPNS), so it includes the bus time of both
+ * frames. Requests without echo until the end of the test are drops. Device
+ * jitter compares intervals of device reception times with intervals of the
+ * requests. USB-CAN adapters are used through their socketCAN driver
+ * (gs_usb, slcan with slcand, ...).
+ */
+
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+#include <net/if.h>
+#include <sys/socket.h>
+#include <linux/can.h>
+#include <linux/can/raw.h>
+
+
+#define LG_SDO_TIMEOUT_NS       1000000000LL
+#define LG_DRAIN_NS             200000000LL
+#define LG_HIST_BUCKETS         10U
+
+static const uint32_t lg_histLimitUs[LG_HIST_BUCKETS - 1U] = {
+    100U, 200U, 500U, 1000U, 2000U, 5000U, 10000U, 20000U, 50000U
+};
+
+/* one periodic stream of frames */
+typedef struct{
+    int64_t             period;         /* ns, 0 if disabled */
+    int64_t             next;           /* CLOCK_MONOTONIC ns */
+    uint32_t            sent;
+}lg_stream_t;
+
+/* statistics of echoed RPDOs */
+typedef struct{
+    uint32_t            echoed;
+    uint32_t            unexpected;     /* echo without request, duplicated or late */
+    uint32_t            hist[LG_HIST_BUCKETS];
+    int64_t             min;
+    int64_t             max;
+    int64_t             sum;
+    uint16_t            lastSeq;
+    int64_t             lastSent;
+    uint32_t            lastDevUs;
+    int64_t             jitterMax;
+    int64_t             jitterSum;
+    uint32_t            jitterCount;
+}lg_latency_t;
+
+/* segmented SDO upload client */
+typedef struct{
+    int64_t             period;
+    int64_t             next;
+    int                 active;
+    uint8_t             toggle;
+    int64_t             start;
+    uint32_t            bytes;
+    uint32_t            transfers;
+    uint32_t            aborts;
+    uint32_t            timeouts;
+    uint64_t            bytesTotal;
+    int64_t             timeSum;
+}lg_sdo_t;
+
+static int lg_fd;
+static uint8_t lg_nodeId;
+static uint32_t lg_txOverruns = 0U;
+static uint32_t lg_emcy = 0U;
+static int64_t *lg_sentAt;              /* CLOCK_REALTIME ns of each sequence, 0 if not pending */
+
+
+static int64_t lg_now(clockid_t clk){
+    struct timespec ts;
+
+    clock_gettime(clk, &ts);
+    return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+
+static int lg_send(uint32_t ident, uint8_t dlc, const uint8_t *data){
+    struct can_frame frame;
+
+    memset(&frame, 0, sizeof(frame));
+    frame.can_id = ident;
+    frame.can_dlc = dlc;
+    if(dlc > 0U){
+        memcpy(frame.data, data, dlc);
+    }
+    if(write(lg_fd, &frame, sizeof(frame)) != (ssize_t)sizeof(frame)){
+        lg_txOverruns++;
+        return -1;
+    }
+    return 0;
+}
+
+
+/* Read one frame, if available. Return 1 with kernel time stamp, 0 if none. */
+static int lg_receive(struct can_frame *frame, int64_t *stamp){
+    char ctrl[CMSG_SPACE(sizeof(struct timespec))];
+    struct iovec iov = { frame, sizeof(*frame) };
+    struct msghdr msg;
+    struct cmsghdr *cmsg;
+
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = ctrl;
+    msg.msg_controllen = sizeof(ctrl);
+    if(recvmsg(lg_fd, &msg, MSG_DONTWAIT) != (ssize_t)sizeof(*frame)){
+        return 0;
+    }
+
+    *stamp = lg_now(CLOCK_REALTIME);
+    for(cmsg = CMSG_FIRSTHDR(&msg); cmsg != NULL; cmsg = CMSG_NXTHDR(&msg, cmsg)){
+        if(cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SO_TIMESTAMPNS){
+            struct timespec ts;
+
+            memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+            *stamp = (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+        }
+    }
+    return 1;
+}
+
+
+/* Wait for frame or timeout in ns */
+static void lg_wait(int64_t timeout){
+    struct pollfd pfd = { lg_fd, POLLIN, 0 };
+    struct timespec ts;
+
+    if(timeout < 0){
+        timeout = 0;
+    }
+    ts.tv_sec = (time_t)(timeout / 1000000000LL);
+    ts.tv_nsec = (long)(timeout % 1000000000LL);
+    (void)ppoll(&pfd, 1, &ts, NULL);
+}
+
+
+/* Blocking expedited SDO download, used for device configuration. */
+static int lg_sdoDownload(uint16_t index, uint8_t subIndex, uint32_t value, uint8_t len){
+    static const uint8_t cmd[5] = {0U, 0x2FU, 0x2BU, 0x27U, 0x23U};
+    uint8_t data[8];
+    int64_t end;
+
+    data[0] = cmd[len];
+    data[1] = (uint8_t)index;
+    data[2] = (uint8_t)(index >> 8);
+    data[3] = subIndex;
+    data[4] = (uint8_t)value;
+    data[5] = (uint8_t)(value >> 8);
+    data[6] = (uint8_t)(value >> 16);
+    data[7] = (uint8_t)(value >> 24);
+    if(lg_send(0x600U + lg_nodeId, 8U, data) != 0){
+        return -1;
+    }
+
+    end = lg_now(CLOCK_MONOTONIC) + LG_SDO_TIMEOUT_NS;
+    while(lg_now(CLOCK_MONOTONIC) < end){
+        struct can_frame frame;
+        int64_t stamp;
+
+        lg_wait(end - lg_now(CLOCK_MONOTONIC));
+        while(lg_receive(&frame, &stamp)){
+            if(frame.can_id == 0x580U + lg_nodeId && frame.can_dlc == 8U
+               && frame.data[1] == data[1] && frame.data[2] == data[2] && frame.data[3] == subIndex)
+            {
+                if(frame.data[0] == 0x60U){
+                    return 0;
+                }
+                fprintf(stderr, "SDO download %04X:%02X aborted %02X%02X%02X%02X\n", index, subIndex,
+                        frame.data[7], frame.data[6], frame.data[5], frame.data[4]);
+                return -1;
+            }
+        }
+    }
+    fprintf(stderr, "SDO download %04X:%02X timeout\n", index, subIndex);
+    return -1;
+}
+
+
+/* Map 8 bytes of 0x6200 to RPDO1 and 0x6000 to TPDO1, inhibit time 0. */
+static int lg_configure(void){
+    uint8_t nmt[2] = {0x80U, lg_nodeId};
+    uint32_t rpdo = 0x200U + lg_nodeId;
+    uint32_t tpdo = 0x180U + lg_nodeId;
+    int err = 0;
+    uint8_t i;
+
+    lg_send(0x000U, 2U, nmt);
+    usleep(50000);
+
+    err |= lg_sdoDownload(0x1400U, 1U, 0x80000000UL | rpdo, 4U);
+    err |= lg_sdoDownload(0x1600U, 0U, 0U, 1U);
+    for(i = 1U; i <= 8U; i++){
+        err |= lg_sdoDownload(0x1600U, i, 0x62000008UL | ((uint32_t)i << 8), 4U);
+    }
+    err |= lg_sdoDownload(0x1600U, 0U, 8U, 1U);
+    err |= lg_sdoDownload(0x1400U, 1U, rpdo, 4U);
+
+    err |= lg_sdoDownload(0x1800U, 1U, 0x80000000UL | tpdo, 4U);
+    err |= lg_sdoDownload(0x1800U, 3U, 0U, 2U);
+    err |= lg_sdoDownload(0x1A00U, 0U, 0U, 1U);
+    for(i = 1U; i <= 8U; i++){
+        err |= lg_sdoDownload(0x1A00U, i, 0x60000008UL | ((uint32_t)i << 8), 4U);
+    }
+    err |= lg_sdoDownload(0x1A00U, 0U, 8U, 1U);
+    err |= lg_sdoDownload(0x1800U, 1U, tpdo, 4U);
+
+    nmt[0] = 0x01U;
+    lg_send(0x000U, 2U, nmt);
+    usleep(50000);
+    return err;
+}
+
+
+/* Echo of RPDO1 received in TPDO1 */
+static void lg_echo(lg_latency_t *lat, const struct can_frame *frame, int64_t stamp){
+    uint16_t seq = (uint16_t)(frame->data[0] | ((uint16_t)frame->data[1] << 8));
+    uint32_t devUs = (uint32_t)frame->data[4] | ((uint32_t)frame->data[5] << 8)
+                   | ((uint32_t)frame->data[6] << 16) | ((uint32_t)frame->data[7] << 24);
+    int64_t sent = lg_sentAt[seq];
+    int64_t latency;
+    uint32_t latencyUs, b;
+
+    if(frame->can_dlc < 8U || sent == 0){
+        lat->unexpected++;
+        return;
+    }
+    lg_sentAt[seq] = 0;
+
+    latency = stamp - sent;
+    if(lat->echoed == 0U || latency < lat->min){
+        lat->min = latency;
+    }
+    if(latency > lat->max){
+        lat->max = latency;
+    }
+    lat->sum += latency;
+    latencyUs = (uint32_t)(latency / 1000);
+    for(b = 0U; b < LG_HIST_BUCKETS - 1U && latencyUs >= lg_histLimitUs[b]; b++){
+    }
+    lat->hist[b]++;
+
+    /* distance of device reception times against distance of requests */
+    if(lat->echoed > 0U && seq == (uint16_t)(lat->lastSeq + 1U)){
+        int64_t jitter = (int64_t)(uint32_t)(devUs - lat->lastDevUs) * 1000 - (sent - lat->lastSent);
+
+        if(jitter < 0){
+            jitter = -jitter;
+        }
+        if(jitter > lat->jitterMax){
+            lat->jitterMax = jitter;
+        }
+        lat->jitterSum += jitter;
+        lat->jitterCount++;
+    }
+    lat->lastSeq = seq;
+    lat->lastSent = sent;
+    lat->lastDevUs = devUs;
+    lat->echoed++;
+}
+
+
+static void lg_sdoStart(lg_sdo_t *sdo, int64_t now){
+    uint8_t data[8] = {0x40U, 0x08U, 0x10U, 0x00U, 0U, 0U, 0U, 0U};
+
+    if(lg_send(0x600U + lg_nodeId, 8U, data) == 0){
+        sdo->active = 1;
+        sdo->toggle = 0U;
+        sdo->start = now;
+        sdo->bytes = 0U;
+    }
+}
+
+
+static void lg_sdoEnd(lg_sdo_t *sdo, int64_t now){
+    sdo->active = 0;
+    sdo->transfers++;
+    sdo->bytesTotal += sdo->bytes;
+    sdo->timeSum += now - sdo->start;
+}
+
+
+/* SDO server response of the running upload */
+static void lg_sdoResponse(lg_sdo_t *sdo, const struct can_frame *frame, int64_t now){
+    uint8_t scs = frame->data[0];
+    uint8_t data[8] = {0U};
+
+    if(!sdo->active || frame->can_dlc != 8U){
+        return;
+    }
+    if(scs == 0x80U){
+        sdo->active = 0;
+        sdo->aborts++;
+    }
+    else if((scs & 0xE0U) == 0x40U){
+        if((scs & 0x02U) != 0U){
+            /* expedited */
+            sdo->bytes = ((scs & 0x01U) != 0U) ? (4U - ((scs >> 2) & 0x03U)) : 4U;
+            lg_sdoEnd(sdo, now);
+        }
+        else{
+            data[0] = 0x60U;
+            lg_send(0x600U + lg_nodeId, 8U, data);
+        }
+    }
+    else if((scs & 0xE0U) == 0x00U){
+        sdo->bytes += 7U - ((scs >> 1) & 0x07U);
+        if((scs & 0x01U) != 0U){
+            lg_sdoEnd(sdo, now);
+        }
+        else{
+            sdo->toggle ^= 0x10U;
+            data[0] = 0x60U | sdo->toggle;
+            lg_send(0x600U + lg_nodeId, 8U, data);
+        }
+    }
+}
+
+
+/* Send frames of the stream, which are due. Return nonzero, if frame is due. */
+static int lg_due(lg_stream_t *s, int64_t now){
+    if(s->period == 0 || now < s->next){
+        return 0;
+    }
+    s->next += s->period;
+    /* don't catch up after long stall */
+    if(now - s->next > 100 * s->period){
+        s->next = now + s->period;
+    }
+    return 1;
+}
+
+
+static int64_t lg_period(const char *rate){
+    double hz = strtod(rate, NULL);
+
+    return (hz > 0.0) ? (int64_t)(1e9 / hz) : 0;
+}
+
+
+static void lg_report(const lg_stream_t *pdo, const lg_stream_t *bulk, const lg_stream_t *sync,
+                      const lg_sdo_t *sdo, const lg_latency_t *lat, double seconds)
+{
+    uint32_t b;
+
+    printf("duration %.1f s, tx overruns %u, emergency messages %u\n", seconds, lg_txOverruns, lg_emcy);
+    printf("SYNC sent %u, RPDO2 sent %u\n", sync->sent, bulk->sent);
+    printf("RPDO1 sent %u, echoed %u, dropped %u, unexpected %u\n",
+           pdo->sent, lat->echoed, pdo->sent - lat->echoed, lat->unexpected);
+    if(lat->echoed > 0U){
+        printf("latency us: min %.1f avg %.1f max %.1f\n", lat->min / 1000.0,
+               (double)lat->sum / lat->echoed / 1000.0, lat->max / 1000.0);
+        for(b = 0U; b < LG_HIST_BUCKETS; b++){
+            if(b < LG_HIST_BUCKETS - 1U){
+                printf("  < %6u us %10u %6.2f %%\n", lg_histLimitUs[b], lat->hist[b],
+                       100.0 * lat->hist[b] / lat->echoed);
+            }
+            else{
+                printf(" >= %6u us %10u %6.2f %%\n", lg_histLimitUs[b - 1U], lat->hist[b],
+                       100.0 * lat->hist[b] / lat->echoed);
+            }
+        }
+    }
+    if(lat->jitterCount > 0U){
+        printf("device reception jitter us: avg %.1f max %.1f\n",
+               (double)lat->jitterSum / lat->jitterCount / 1000.0, lat->jitterMax / 1000.0);
+    }
+    if(sdo->period != 0){
+        printf("SDO uploads %u, aborts %u, timeouts %u, %.0f bytes/s",
+               sdo->transfers, sdo->aborts, sdo->timeouts, sdo->bytesTotal / seconds);
+        if(sdo->transfers > 0U){
+            printf(", avg transfer %.1f us", (double)sdo->timeSum / sdo->transfers / 1000.0);
+        }
+        printf("\n");
+    }
+}
+
+
+int main(int argc, char *argv[]){
+    lg_stream_t pdo = {0}, bulk = {0}, sync = {0};
+    lg_sdo_t sdo;
+    lg_latency_t lat;
+    struct sockaddr_can addr;
+    double seconds = 10.0;
+    int configure = 1;
+    int enable = 1;
+    int64_t start, end, drainEnd, now;
+    uint16_t seq = 0U;
+    int opt;
+
+    memset(&sdo, 0, sizeof(sdo));
+    memset(&lat, 0, sizeof(lat));
+    pdo.period = lg_period("100");
+
+    while((opt = getopt(argc, argv, "p:b:s:o:t:n")) != -1){
+        switch(opt){
+            case 'p': pdo.period = lg_period(optarg); break;
+            case 'b': bulk.period = lg_period(optarg); break;
+            case 's': sync.period = lg_period(optarg); break;
+            case 'o': sdo.period = lg_period(optarg); break;
+            case 't': seconds = strtod(optarg, NULL); break;
+            case 'n': configure = 0; break;
+            default:
+                fprintf(stderr, "Usage: %s [-p Hz] [-b Hz] [-s Hz] [-o Hz] [-t s] [-n] <CAN interface> <node-ID>\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if(argc - optind < 2){
+        fprintf(stderr, "Usage: %s [-p Hz] [-b Hz] [-s Hz] [-o Hz] [-t s] [-n] <CAN interface> <node-ID>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    lg_nodeId = (uint8_t)strtoul(argv[optind + 1], NULL, 0);
+
+    lg_sentAt = calloc(0x10000U, sizeof(*lg_sentAt));
+    lg_fd = socket(PF_CAN, SOCK_RAW | SOCK_NONBLOCK, CAN_RAW);
+    if(lg_sentAt == NULL || lg_fd < 0){
+        perror("socket");
+        return EXIT_FAILURE;
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.can_family = AF_CAN;
+    addr.can_ifindex = (int)if_nametoindex(argv[optind]);
+    if(addr.can_ifindex == 0 || bind(lg_fd, (struct sockaddr*)&addr, sizeof(addr)) != 0
+       || setsockopt(lg_fd, SOL_SOCKET, SO_TIMESTAMPNS, &enable, sizeof(enable)) != 0)
+    {
+        perror(argv[optind]);
+        return EXIT_FAILURE;
+    }
+
+    if(configure && lg_configure() != 0){
+        return EXIT_FAILURE;
+    }
+
+    start = lg_now(CLOCK_MONOTONIC);
+    end = start + (int64_t)(seconds * 1e9);
+    drainEnd = end + LG_DRAIN_NS;
+    pdo.next = bulk.next = sync.next = sdo.next = start;
+
+    for(now = start; now < drainEnd; now = lg_now(CLOCK_MONOTONIC)){
+        struct can_frame frame;
+        int64_t stamp, next = drainEnd;
+
+        if(now < end){
+            uint8_t data[8] = {0U};
+
+            while(lg_due(&sync, now)){
+                if(lg_send(0x080U, 0U, NULL) == 0){
+                    sync.sent++;
+                }
+            }
+            while(lg_due(&bulk, now)){
+                if(lg_send(0x300U + lg_nodeId, 8U, data) == 0){
+                    bulk.sent++;
+                }
+            }
+            while(lg_due(&pdo, now)){
+                data[0] = (uint8_t)seq;
+                data[1] = (uint8_t)(seq >> 8);
+                lg_sentAt[seq] = lg_now(CLOCK_REALTIME);
+                if(lg_send(0x200U + lg_nodeId, 8U, data) == 0){
+                    pdo.sent++;
+                    seq++;
+                }
+                else{
+                    lg_sentAt[seq] = 0;
+                }
+            }
+            if(sdo.period != 0 && now >= sdo.next){
+                sdo.next += sdo.period;
+                if(now - sdo.next > 100 * sdo.period){
+                    sdo.next = now + sdo.period;
+                }
+                if(!sdo.active){
+                    lg_sdoStart(&sdo, now);
+                }
+            }
+            if(sdo.active && now - sdo.start > LG_SDO_TIMEOUT_NS){
+                sdo.active = 0;
+                sdo.timeouts++;
+            }
+
+            next = end;
+            if(pdo.period != 0 && pdo.next < next) next = pdo.next;
+            if(bulk.period != 0 && bulk.next < next) next = bulk.next;
+            if(sync.period != 0 && sync.next < next) next = sync.next;
+            if(sdo.period != 0 && sdo.next < next) next = sdo.next;
+        }
+
+        lg_wait(next - now);
+        while(lg_receive(&frame, &stamp)){
+            if(frame.can_id == 0x180U + lg_nodeId){
+                lg_echo(&lat, &frame, stamp);
+            }
+            else if(frame.can_id == 0x580U + lg_nodeId){
+                lg_sdoResponse(&sdo, &frame, lg_now(CLOCK_MONOTONIC));
+            }
+            else if(frame.can_id == 0x080U + lg_nodeId){
+                lg_emcy++;
+            }
+        }
+    }
+
+    lg_report(&pdo, &bulk, &sync, &sdo, &lat, seconds);
+    close(lg_fd);
+    free(lg_sentAt);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,320 @@
+/*
+ * Host simulation of CANopen device on Linux socketCAN.
+ *
+ * @file        CO_main.c
+ * @ingroup     CO_driver
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * CANopenNode is free and open source software: you can redistribute
+ * it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Following clarification and special exception to the GNU General Public
+ * License is included to the distribution terms of CANopenNode:
+ *
+ * Linking this library statically or dynamically with other modules is
+ * making a combined work based on this library. Thus, the terms and
+ * conditions of the GNU General Public License cover the whole combination.
+ *
+ * As a special exception, the copyright holders of this library give
+ * you permission to link this library with independent modules to
+ * produce an executable, regardless of the license terms of these
+ * independent modules, and to copy and distribute the resulting
+ * executable under terms of your choice, provided that you also meet,
+ * for each linked independent module, the terms and conditions of the
+ * license of that module. An independent module is a module which is
+ * not derived from or based on this library. If you modify this
+ * library, you may extend this exception to your version of the
+ * library, but you are not obliged to do so. If you do not wish
+ * to do so, delete this exception statement from your version.
+ */
+
+/*
+ * Usage: canopen_sim [-e echo mode] <CAN interface> [node-ID] [bit rate kbit/s]
+ *        canopen_sim --bench [iterations]
+ *        canopen_sim --replay <log file> [node-ID] [bit rate kbit/s]
+ *
+ * Process simulates one device with the application Object Dictionary. It
+ * replaces Scheduler/task.c, which depends on TIM6 and bxCAN:
+ *  - Main thread is the mainline, CO_process() every millisecond with the
+ *    measured time difference, SDO, NMT, heartbeat and emergency.
+ *  - Realtime thread waits with epoll on CAN socket and 1 ms timerfd. CAN
+ *    frames are processed as in CAN receive interrupt, timer events run
+ *    SYNC, RPDO, TPDO and trace sampling, as task_realTime().
+ *
+ * Many devices are simulated by many processes on the same vcan interface:
+ *   ip link add dev vcan0 type vcan && ip link set up vcan0
+ *   for i in $(seq 1 127); do ./canopen_sim vcan0 $i & done
+ * Node-ID 255 starts device without node-ID, it then waits for LSS master.
+ *
+ * With -e 1 or -e 2, RPDO1 is echoed into TPDO1 as with TASK_ECHO, for
+ * latency measurement with canopen_loadgen.
+ *
+ * With --bench, CO_bench_run() is executed once without CAN interface and
+ * results are printed, see CO_bench.h.
+ *
+ * With --replay, recorded traffic is replayed without CAN interface with
+ * virtual time, transmitted frames are printed, see CO_replay.h.
+ */
+
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+#include <time.h>
+#include <pthread.h>
+#include <net/if.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+
+#include "CANopen.h"
+#include "CO_OD.h"
+#include "task_echo.h"
+#include "CO_replay.h"
+#if CO_BENCH > 0
+#include "CO_bench.h"
+#endif
+
+
+/* realtime thread period */
+#define SIM_PERIOD_US       1000U
+
+static volatile sig_atomic_t sim_end = 0;
+static volatile bool_t sim_rtRun = false;
+static uint8_t sim_nodeId;
+static uint16_t sim_bitRate;
+static uint8_t sim_echo = 0U;
+
+
+/* Time in microseconds from monotonic clock */
+static uint32_t sim_getTimeUs(void){
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000U + (uint64_t)ts.tv_nsec / 1000U);
+}
+
+
+static void sim_signal(int sig){
+    (void)sig;
+    sim_end = 1;
+}
+
+
+/* Realtime thread: CAN reception and timer thread of the device */
+static void *sim_realTime(void *arg){
+    CO_CANmodule_t *CANmodule = CO->CANmodule[0];
+    struct itimerspec period;
+    struct epoll_event ev;
+    uint32_t lastUs = sim_getTimeUs();
+    int epfd, tfd;
+
+    (void)arg;
+    epfd = epoll_create1(0);
+    tfd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK);
+    if(epfd < 0 || tfd < 0){
+        perror("realtime thread");
+        exit(EXIT_FAILURE);
+    }
+
+    period.it_interval.tv_sec = 0;
+    period.it_interval.tv_nsec = SIM_PERIOD_US * 1000;
+    period.it_value = period.it_interval;
+    timerfd_settime(tfd, 0, &period, NULL);
+
+    ev.events = EPOLLIN;
+    ev.data.fd = CANmodule->fd;
+    epoll_ctl(epfd, EPOLL_CTL_ADD, CANmodule->fd, &ev);
+    ev.data.fd = tfd;
+    epoll_ctl(epfd, EPOLL_CTL_ADD, tfd, &ev);
+
+    while(sim_rtRun){
+        if(epoll_wait(epfd, &ev, 1, 100) != 1){
+            continue;
+        }
+
+        if(ev.data.fd == CANmodule->fd){
+            /* replaces CAN receive interrupt */
+            CO_CANrxProcess(CANmodule);
+        }
+        else{
+            uint64_t expirations;
+            uint32_t timeUs = sim_getTimeUs();
+
+            if(read(tfd, &expirations, sizeof(expirations)) != sizeof(expirations)){
+                continue;
+            }
+            if(CANmodule->CANnormal){
+                bool_t syncWas;
+
+                syncWas = CO_process_SYNC_RPDO(CO, timeUs - lastUs, NULL);
+                CO_process_TPDO(CO, syncWas, timeUs - lastUs, NULL);
+#if CO_NO_TRACE > 0
+                {
+                    uint8_t i;
+
+                    for(i = 0U; i < CO_NO_TRACE; i++){
+                        CO_trace_process(CO->trace[i], timeUs);
+                    }
+                }
+#endif
+                CO_CANpolling_Tx(CANmodule);
+            }
+            lastUs = timeUs;
+        }
+    }
+
+    close(tfd);
+    close(epfd);
+    return NULL;
+}
+
+
+#if CO_BENCH > 0
+/* Run benchmark without CAN interface and print results */
+static int sim_bench(uint16_t iterations){
+    static CO_bench_t bench;
+    uint32_t i;
+
+    if(CO_init(0, 2U, 250U) != CO_ERROR_NO){
+        fprintf(stderr, "CO_init failed\n");
+        return EXIT_FAILURE;
+    }
+    CO_CANsetNormalMode(CO->CANmodule[0]);
+
+    CO_bench_run(&bench, CO, iterations);
+
+    printf("%-22s %10s %10s %10s %10s\n", "item [" CO_BENCH_TIME_UNIT "]", "count", "min", "avg", "max");
+    for(i = 0U; i < (uint32_t)CO_BENCH_ITEMS; i++){
+        const CO_bench_stat_t *s = &bench.stat[i];
+
+        if(s->count == 0U){
+            printf("%-22s %10s\n", CO_bench_name((CO_bench_item_t)i), "-");
+            continue;
+        }
+        printf("%-22s %10u %10u %10u %10u\n", CO_bench_name((CO_bench_item_t)i),
+               s->count, s->min, (uint32_t)(s->sum / s->count), s->max);
+    }
+    printf("SDO upload %u bytes, %u errors\n", bench.sdoBytes, bench.errors);
+
+    CO_delete(0);
+    return (bench.errors == 0U) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+#endif
+
+
+int main(int argc, char *argv[]){
+    CO_NMT_reset_cmd_t reset = CO_RESET_NOT;
+    int32_t ifindex;
+
+#if CO_BENCH > 0
+    if(argc > 1 && strcmp(argv[1], "--bench") == 0){
+        return sim_bench((argc > 2) ? (uint16_t)strtoul(argv[2], NULL, 0) : 1000U);
+    }
+#endif
+    if(argc > 2 && strcmp(argv[1], "--replay") == 0){
+        return CO_replay_run(argv[2], (argc > 3) ? (uint8_t)strtoul(argv[3], NULL, 0) : 2U,
+                             (argc > 4) ? (uint16_t)strtoul(argv[4], NULL, 0) : 250U);
+    }
+    if(argc > 2 && strcmp(argv[1], "-e") == 0){
+        sim_echo = (uint8_t)strtoul(argv[2], NULL, 0);
+        argv[2] = argv[0];
+        argv += 2;
+        argc -= 2;
+    }
+    if(argc < 2){
+        fprintf(stderr, "Usage: %s [-e echo mode] <CAN interface> [node-ID] [bit rate kbit/s]\n"
+                        "       %s --bench [iterations]\n"
+                        "       %s --replay <log file> [node-ID] [bit rate kbit/s]\n", argv[0], argv[0], argv[0]);
+        return EXIT_FAILURE;
+    }
+    ifindex = (int32_t)if_nametoindex(argv[1]);
+    if(ifindex == 0){
+        perror(argv[1]);
+        return EXIT_FAILURE;
+    }
+    sim_nodeId = (argc > 2) ? (uint8_t)strtoul(argv[2], NULL, 0) : 2U;
+    sim_bitRate = (argc > 3) ? (uint16_t)strtoul(argv[3], NULL, 0) : 250U;
+
+    signal(SIGINT, sim_signal);
+    signal(SIGTERM, sim_signal);
+
+    while(reset != CO_RESET_QUIT && !sim_end){
+        pthread_t rtThread;
+        uint32_t lastUs, remainderUs = 0U;
+        struct timespec next;
+        CO_ReturnError_t err;
+
+        /* communication reset */
+        err = CO_init(ifindex, sim_nodeId, sim_bitRate);
+        if(err != CO_ERROR_NO){
+            fprintf(stderr, "CO_init failed: %d\n", (int)err);
+            return EXIT_FAILURE;
+        }
+        task_echo_init(CO, sim_echo, sim_getTimeUs);
+        CO_CANsetNormalMode(CO->CANmodule[0]);
+
+        sim_rtRun = true;
+        if(pthread_create(&rtThread, NULL, sim_realTime, NULL) != 0){
+            perror("pthread_create");
+            return EXIT_FAILURE;
+        }
+
+        /* mainline, every millisecond */
+        reset = CO_RESET_NOT;
+        lastUs = sim_getTimeUs();
+        clock_gettime(CLOCK_MONOTONIC, &next);
+        while(reset == CO_RESET_NOT && !sim_end){
+            uint32_t timeUs;
+            uint16_t timeDifference_ms;
+
+            next.tv_nsec += SIM_PERIOD_US * 1000;
+            if(next.tv_nsec >= 1000000000L){
+                next.tv_nsec -= 1000000000L;
+                next.tv_sec++;
+            }
+            clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+
+            /* pass measured time, so late calls don't slow down CANopen timers */
+            timeUs = sim_getTimeUs();
+            remainderUs += timeUs - lastUs;
+            lastUs = timeUs;
+            timeDifference_ms = (uint16_t)(remainderUs / 1000U);
+            remainderUs -= (uint32_t)timeDifference_ms * 1000U;
+
+            reset = CO_process(CO, timeDifference_ms, NULL);
+        }
+
+        sim_rtRun = false;
+        pthread_join(rtThread, NULL);
+
+#if CO_NO_LSS_SERVER == 1
+        /* node-ID and bit rate configured by LSS master */
+        if(CO->LSSslave->pendingNodeID != 0U){
+            sim_nodeId = CO->LSSslave->pendingNodeID;
+        }
+        if(CO->LSSslave->pendingBitRate != 0U){
+            sim_bitRate = CO->LSSslave->pendingBitRate;
+        }
+#endif
+        CO_delete(ifindex);
+    }
+
+    return EXIT_SUCCESS;
+}
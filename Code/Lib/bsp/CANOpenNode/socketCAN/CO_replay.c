@@ -0,0 +1,394 @@
+/*
+ * Replay of recorded CAN traffic into the host build.
+ *
+ * @file        CO_replay.c
+ * @ingroup     CO_driver
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * CANopenNode is free and open source software: you can redistribute
+ * it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Following clarification and special exception to the GNU General Public
+ * License is included to the distribution terms of CANopenNode:
+ *
+ * Linking this library statically or dynamically with other modules is
+ * making a combined work based on this library. Thus, the terms and
+ * conditions of the GNU General Public License cover the whole combination.
+ *
+ * As a special exception, the copyright holders of this library give
+ * you permission to link this library with independent modules to
+ * produce an executable, regardless of the license terms of these
+ * independent modules, and to copy and distribute the resulting
+ * executable under terms of your choice, provided that you also meet,
+ * for each linked independent module, the terms and conditions of the
+ * license of that module. An independent module is a module which is
+ * not derived from or based on this library. If you modify this
+ * library, you may extend this exception to your version of the
+ * library, but you are not obliged to do so. If you do not wish
+ * to do so, delete this exception statement from your version.
+ */
+
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "CO_replay.h"
+#include "crc16-ccitt.h"
+
+
+/* Flags in ident of the recorder log, see CO_CANrecord_t */
+#define CO_REPLAY_REC_TX        0x00000001UL
+#define CO_REPLAY_REC_RTR       0x00000002UL
+#define CO_REPLAY_REC_IDE       0x00000004UL
+#define CO_REPLAY_REC_SIZE      16U
+#define CO_REPLAY_REC_TIME_MASK 0x0FFFFFFFUL
+
+
+/* One frame of the log */
+typedef struct{
+    uint64_t            timeUs;         /* relative to the first frame */
+    CO_CANrxMsg_t       msg;
+}CO_replay_frame_t;
+
+/* Statistics of one stage */
+typedef struct{
+    uint32_t            count;
+    uint32_t            min;
+    uint32_t            max;
+    uint64_t            sum;
+}CO_replay_stat_t;
+
+/* State of the running replay */
+typedef struct{
+    CO_replay_frame_t  *frame;
+    uint32_t            frameCount;
+    uint32_t            skipped;        /* extended, error and own transmitted frames */
+    uint64_t            timeUs;         /* virtual time */
+    uint32_t            txCount;
+    uint16_t            txCrc;
+    CO_replay_stat_t    stat[CO_REPLAY_STAGES];
+}CO_replay_t;
+
+static CO_replay_t CO_replay;
+
+static const char *const CO_replay_stageName[CO_REPLAY_STAGES] = {
+    "rx dispatch", "SYNC, RPDO", "TPDO", "CO_process"
+};
+
+
+/* Host time in nanoseconds */
+static uint32_t CO_replay_time(void){
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000U + (uint64_t)ts.tv_nsec);
+}
+
+
+static void CO_replay_stat(CO_replay_stage_t stage, uint32_t start){
+    CO_replay_stat_t *s = &CO_replay.stat[stage];
+    uint32_t t = CO_replay_time() - start;
+
+    if(s->count == 0U || t < s->min){
+        s->min = t;
+    }
+    if(t > s->max){
+        s->max = t;
+    }
+    s->sum += t;
+    s->count++;
+}
+
+
+/* CANmodule->txSink, prints transmitted frame in candump log format */
+static void CO_replay_tx(const CO_CANtx_t *buffer){
+    bool_t rtr = (buffer->ident & 0x40000000UL) != 0U;   /* CAN_RTR_FLAG */
+    uint8_t header[3];
+    uint8_t i;
+
+    printf("(%llu.%06llu) replay %03X#", (unsigned long long)(CO_replay.timeUs / 1000000U),
+           (unsigned long long)(CO_replay.timeUs % 1000000U), (unsigned)(buffer->ident & 0x7FFU));
+    if(rtr){
+        printf("R");
+    }
+    else{
+        for(i = 0U; i < buffer->DLC; i++){
+            printf("%02X", buffer->data[i]);
+        }
+    }
+    printf("\n");
+
+    /* CRC of identifier, RTR, DLC and data, time is not included */
+    header[0] = (uint8_t)buffer->ident;
+    header[1] = (uint8_t)((buffer->ident >> 8) & 0x07U) | (rtr ? 0x08U : 0U);
+    header[2] = buffer->DLC;
+    CO_replay.txCrc = crc16_ccitt(header, sizeof(header), CO_replay.txCrc);
+    if(!rtr){
+        CO_replay.txCrc = crc16_ccitt(buffer->data, buffer->DLC, CO_replay.txCrc);
+    }
+    CO_replay.txCount++;
+}
+
+
+/* Add frame to the log, return false if out of memory */
+static bool_t CO_replay_add(uint64_t timeUs, const CO_CANrxMsg_t *msg, uint32_t *size){
+    if(CO_replay.frameCount == *size){
+        CO_replay_frame_t *f;
+
+        *size = (*size == 0U) ? 1024U : *size * 2U;
+        f = realloc(CO_replay.frame, *size * sizeof(CO_replay_frame_t));
+        if(f == NULL){
+            return false;
+        }
+        CO_replay.frame = f;
+    }
+    CO_replay.frame[CO_replay.frameCount].timeUs = timeUs;
+    CO_replay.frame[CO_replay.frameCount].msg = *msg;
+    CO_replay.frameCount++;
+    return true;
+}
+
+
+/* Parse one line of candump log into msg, return false if skipped */
+static bool_t CO_replay_parseLine(const char *line, uint64_t *timeUs, CO_CANrxMsg_t *msg){
+    unsigned long long sec, usec;
+    char frame[300];
+    char *p;
+    unsigned long ident;
+
+    if(sscanf(line, " (%llu.%llu) %*s %299s", &sec, &usec, frame) != 3){
+        return false;
+    }
+    *timeUs = sec * 1000000U + usec;
+
+    ident = strtoul(frame, &p, 16);
+    if(*p != '#' || (p - frame) != 3 || ident > 0x7FFU){
+        return false;   /* extended or error frame */
+    }
+    p++;
+    memset(msg, 0, sizeof(*msg));
+    msg->ident = (uint32_t)ident;
+    if(*p == 'R'){
+        msg->ident |= 0x0800U;
+        msg->DLC = (p[1] >= '0' && p[1] <= '8') ? (uint8_t)(p[1] - '0') : 0U;
+        return true;
+    }
+    if(*p == '#'){
+        p += 2;         /* CAN FD, skip flags */
+    }
+    while(p[0] != 0 && p[1] != 0 && msg->DLC < CO_CAN_DATA_SIZE){
+        char byte[3] = {p[0], p[1], 0};
+
+        msg->data[msg->DLC++] = (uint8_t)strtoul(byte, NULL, 16);
+        p += 2;
+    }
+    return true;
+}
+
+
+/* Read candump log or binary recorder log */
+static bool_t CO_replay_load(FILE *f, uint16_t bitRate){
+    uint32_t size = 0U;
+    uint64_t first = 0U;
+    int c;
+
+    /* candump log starts with time stamp in parentheses */
+    do{
+        c = fgetc(f);
+    }while(c == ' ' || c == '\t' || c == '\r' || c == '\n');
+    rewind(f);
+
+    if(c == '('){
+        char line[512];
+
+        while(fgets(line, sizeof(line), f) != NULL){
+            CO_CANrxMsg_t msg;
+            uint64_t timeUs;
+
+            if(!CO_replay_parseLine(line, &timeUs, &msg)){
+                if(line[strspn(line, " \t\r\n")] != 0){
+                    CO_replay.skipped++;
+                }
+                continue;
+            }
+            if(CO_replay.frameCount == 0U){
+                first = timeUs;
+            }
+            /* log is in time order, but don't go back on clock jumps */
+            timeUs = (timeUs < first) ? 0U : timeUs - first;
+            if(CO_replay.frameCount > 0U && timeUs < CO_replay.frame[CO_replay.frameCount - 1U].timeUs){
+                timeUs = CO_replay.frame[CO_replay.frameCount - 1U].timeUs;
+            }
+            if(!CO_replay_add(timeUs, &msg, &size)){
+                return false;
+            }
+        }
+    }
+    else{
+        uint8_t r[CO_REPLAY_REC_SIZE];
+        uint64_t bits = 0U;
+        uint32_t last = 0U;
+        bool_t started = false;
+
+        if(bitRate == 0U){
+            return false;
+        }
+        while(fread(r, 1U, sizeof(r), f) == sizeof(r)){
+            uint32_t time = (uint32_t)r[0] | ((uint32_t)r[1] << 8) | ((uint32_t)r[2] << 16) | ((uint32_t)r[3] << 24);
+            uint32_t ident = (uint32_t)r[4] | ((uint32_t)r[5] << 8) | ((uint32_t)r[6] << 16) | ((uint32_t)r[7] << 24);
+            CO_CANrxMsg_t msg;
+
+            if(time == 0xFFFFFFFFUL && ident == 0xFFFFFFFFUL){
+                continue;       /* erased */
+            }
+            /* bit time counter wraps in 28 bits */
+            if(started){
+                bits += (time - last) & CO_REPLAY_REC_TIME_MASK;
+            }
+            last = time;
+            started = true;
+
+            if((ident & (CO_REPLAY_REC_TX | CO_REPLAY_REC_IDE)) != 0U){
+                CO_replay.skipped++;
+                continue;
+            }
+            memset(&msg, 0, sizeof(msg));
+            msg.ident = ident >> 21;
+            if((ident & CO_REPLAY_REC_RTR) != 0U){
+                msg.ident |= 0x0800U;
+            }
+            msg.DLC = (uint8_t)(time >> 28);
+            if(msg.DLC > 8U){
+                msg.DLC = 8U;
+            }
+            if((ident & CO_REPLAY_REC_RTR) == 0U){
+                memcpy(msg.data, &r[8], msg.DLC);
+            }
+            if(!CO_replay_add(bits * 1000U / bitRate, &msg, &size)){
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+
+/******************************************************************************/
+int CO_replay_run(const char *fileName, uint8_t nodeId, uint16_t bitRate){
+    CO_NMT_reset_cmd_t reset = CO_RESET_NOT;
+    uint64_t endUs;
+    uint32_t next = 0U;
+    uint32_t i;
+    FILE *f;
+
+    memset(&CO_replay, 0, sizeof(CO_replay));
+    CO_replay.txCrc = 0xFFFFU;
+
+    f = fopen(fileName, "rb");
+    if(f == NULL){
+        perror(fileName);
+        return EXIT_FAILURE;
+    }
+    if(!CO_replay_load(f, bitRate)){
+        fprintf(stderr, "%s: can't load log\n", fileName);
+        fclose(f);
+        free(CO_replay.frame);
+        return EXIT_FAILURE;
+    }
+    fclose(f);
+    endUs = ((CO_replay.frameCount > 0U) ? CO_replay.frame[CO_replay.frameCount - 1U].timeUs : 0U)
+          + CO_REPLAY_TAIL_MS * 1000U;
+
+    while(reset != CO_RESET_APP && reset != CO_RESET_QUIT && CO_replay.timeUs < endUs){
+        if(CO_init(0, nodeId, bitRate) != CO_ERROR_NO){
+            fprintf(stderr, "CO_init failed\n");
+            free(CO_replay.frame);
+            return EXIT_FAILURE;
+        }
+        CO->CANmodule[0]->txSink = CO_replay_tx;
+        CO_CANsetNormalMode(CO->CANmodule[0]);
+
+        /* one iteration is one millisecond of virtual time, boot-up first */
+        reset = CO_RESET_NOT;
+        while(reset == CO_RESET_NOT && CO_replay.timeUs < endUs){
+            uint32_t start;
+
+            /* as task_realTime() */
+            if(CO->CANmodule[0]->CANnormal){
+                bool_t syncWas;
+
+                start = CO_replay_time();
+                syncWas = CO_process_SYNC_RPDO(CO, 1000U, NULL);
+                CO_replay_stat(CO_REPLAY_SYNC_RPDO, start);
+
+                start = CO_replay_time();
+                CO_process_TPDO(CO, syncWas, 1000U, NULL);
+                CO_replay_stat(CO_REPLAY_TPDO, start);
+#if CO_NO_TRACE > 0
+                for(i = 0U; i < CO_NO_TRACE; i++){
+                    CO_trace_process(CO->trace[i], (uint32_t)CO_replay.timeUs);
+                }
+#endif
+            }
+
+            /* as task_oneMs() */
+            start = CO_replay_time();
+            reset = CO_process(CO, 1U, NULL);
+            CO_replay_stat(CO_REPLAY_PROCESS, start);
+
+            CO_replay.timeUs += 1000U;
+
+            /* frames received until the next millisecond, as CAN interrupt */
+            while(next < CO_replay.frameCount && CO_replay.frame[next].timeUs < CO_replay.timeUs){
+                start = CO_replay_time();
+                CO_CANrxDispatch(CO->CANmodule[0], &CO_replay.frame[next].msg);
+                CO_replay_stat(CO_REPLAY_RX, start);
+                next++;
+            }
+        }
+
+#if CO_NO_LSS_SERVER == 1
+        /* node-ID configured by LSS master */
+        if(CO->LSSslave->pendingNodeID != 0U){
+            nodeId = CO->LSSslave->pendingNodeID;
+        }
+#endif
+        CO_delete(0);
+    }
+
+    fflush(stdout);
+    fprintf(stderr, "%u frames replayed, %u skipped, %u transmitted, CRC 0x%04X, %llu ms\n",
+            next, CO_replay.skipped, CO_replay.txCount, CO_replay.txCrc,
+            (unsigned long long)(CO_replay.timeUs / 1000U));
+    fprintf(stderr, "%-22s %10s %10s %10s %10s\n", "stage [ns]", "count", "min", "avg", "max");
+    for(i = 0U; i < (uint32_t)CO_REPLAY_STAGES; i++){
+        const CO_replay_stat_t *s = &CO_replay.stat[i];
+
+        if(s->count == 0U){
+            fprintf(stderr, "%-22s %10s\n", CO_replay_stageName[i], "-");
+            continue;
+        }
+        fprintf(stderr, "%-22s %10u %10u %10u %10u\n", CO_replay_stageName[i],
+                s->count, s->min, (uint32_t)(s->sum / s->count), s->max);
+    }
+
+    free(CO_replay.frame);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,127 @@
+/**
+ * Replay of recorded CAN traffic into the host build.
+ *
+ * @file        CO_replay.h
+ * @ingroup     CO_driver
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * CANopenNode is free and open source software: you can redistribute
+ * it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Following clarification and special exception to the GNU General Public
+ * License is included to the distribution terms of CANopenNode:
+ *
+ * Linking this library statically or dynamically with other modules is
+ * making a combined work based on this library. Thus, the terms and
+ * conditions of the GNU General Public License cover the whole combination.
+ *
+ * As a special exception, the copyright holders of this library give
+ * you permission to link this library with independent modules to
+ * produce an executable, regardless of the license terms of these
+ * independent modules, and to copy and distribute the resulting
+ * executable under terms of your choice, provided that you also meet,
+ * for each linked independent module, the terms and conditions of the
+ * license of that module. An independent module is a module which is
+ * not derived from or based on this library. If you modify this
+ * library, you may extend this exception to your version of the
+ * library, but you are not obliged to do so. If you do not wish
+ * to do so, delete this exception statement from your version.
+ */
+
+
+#ifndef CO_REPLAY_H
+#define CO_REPLAY_H
+
+#include "CANopen.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_replay Replay
+ * @ingroup CO_driver
+ * @{
+ *
+ * Deterministic replay of recorded bus traffic for performance regression.
+ *
+ * CO_replay_run() feeds frames from a log with their original timing into
+ * CO_CANrxDispatch(), the same path as CO_CANrxProcess() takes for socket
+ * frames, and drives the device with a virtual clock in 1 ms ticks. Each
+ * tick runs CO_process_SYNC_RPDO(), CO_process_TPDO() and trace, as
+ * task_realTime(), then CO_process(), as task_oneMs(), then dispatches frames
+ * with time stamp within the tick. Boot-up is transmitted at time 0, before
+ * the first frame of the log. Result depends only on the log and on the
+ * code, so two builds may be compared bit exact.
+ *
+ * Log is one of:
+ *  - candump log, as written by 'candump -l' or 'candump -L':
+ *    "(1436509052.249713) vcan0 181#0102", RTR "701#R", CAN FD "181##1..".
+ *  - Binary log of the target recorder, uploaded from CO_CAN_REC_DATA_OD_INDEX,
+ *    see STM32HAL/CO_CANrecorder.h. Time is converted with the bit rate.
+ *    Frames transmitted by the recording device are skipped, erased records
+ *    (all 0xFF) too.
+ * Extended frames and error frames are skipped.
+ *
+ * Frames transmitted by the device are written to stdout in candump log
+ * format with virtual time, interface name "replay", so the output of two
+ * builds is compared with diff. Summary with CRC of transmitted frames and
+ * host time of each stage (count, min, avg, max in nanoseconds) is written
+ * to stderr. Host time shows relative cost of the stages, cycles on the
+ * target are measured with CO_PROFILE.
+ */
+
+
+/** Virtual time after the last frame, so responses are transmitted */
+#ifndef CO_REPLAY_TAIL_MS
+#define CO_REPLAY_TAIL_MS           1000U
+#endif
+
+
+/**
+ * Stages of the replay profile.
+ */
+typedef enum{
+    CO_REPLAY_RX            = 0,    /**< CO_CANrxDispatch(), one call per frame */
+    CO_REPLAY_SYNC_RPDO     = 1,    /**< CO_process_SYNC_RPDO() */
+    CO_REPLAY_TPDO          = 2,    /**< CO_process_TPDO() */
+    CO_REPLAY_PROCESS       = 3,    /**< CO_process() */
+    CO_REPLAY_STAGES        = 4
+}CO_replay_stage_t;
+
+
+/**
+ * Replay log file into a device without CAN interface.
+ *
+ * Function initializes the device with CO_init(), runs it until
+ * #CO_REPLAY_TAIL_MS after the last frame and deletes it. Communication
+ * reset is executed as in the simulation, application reset ends replay.
+ *
+ * @param fileName Log file, candump log or binary recorder log.
+ * @param nodeId Node-ID of the replayed device.
+ * @param bitRate Bit rate in kbit/s, for time of binary recorder log.
+ *
+ * @return 0 on success, otherwise error is printed to stderr.
+ */
+int CO_replay_run(const char *fileName, uint8_t nodeId, uint16_t bitRate);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif
@@ -0,0 +1,587 @@
+/*
+ * Host test of CANopen stack modules on virtual CAN bus.
+ *
+ * @file        CO_test.c
+ * @ingroup     CO_driver
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * CANopenNode is free and open source software: you can redistribute
+ * it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Following clarification and special exception to the GNU General Public
+ * License is included to the distribution terms of CANopenNode:
+ *
+ * Linking this library statically or dynamically with other modules is
+ * making a combined work based on this library. Thus, the terms and
+ * conditions of the GNU General Public License cover the whole combination.
+ *
+ * As a special exception, the copyright holders of this library give
+ * you permission to link this library with independent modules to
+ * produce an executable, regardless of the license terms of these
+ * independent modules, and to copy and distribute the resulting
+ * executable under terms of your choice, provided that you also meet,
+ * for each linked independent module, the terms and conditions of the
+ * license of that module. An independent module is a module which is
+ * not derived from or based on this library. If you modify this
+ * library, you may extend this exception to your version of the
+ * library, but you are not obliged to do so. If you do not wish
+ * to do so, delete this exception statement from your version.
+ */
+
+/*
+ * Usage: canopen_test, built and run with 'make test'.
+ *
+ * Devices are connected with virtual bus without CAN interface. Each device
+ * has own CAN module without socket, transmitted frames are collected by
+ * txSink and dispatched to all online modules with CO_CANrxDispatch(), as
+ * received frames from socket. Time is virtual, in 1 ms steps, so result
+ * depends on the code only.
+ *
+ * Tests:
+ *  - NMT master boots two slaves in parallel with three SDO clients: device
+ *    type is read and configuration is downloaded, slave, which is offline
+ *    at start, is retried, both are started with one broadcast. Heartbeat
+ *    consumer callback of the application is still called and slave is booted
+ *    again with individual start after its boot-up.
+ *  - SDO block download and upload of 889 bytes, each in one block of 127
+ *    segments with CRC, needs CO_SDO_BUFFER_SIZE of 889 bytes.
+ *  - SDO upload of domain, which spans several SDO buffers, segmented and
+ *    block with CRC, with CO_SDO_DOMAIN_PREFETCH. OD function reads the
+ *    domain directly or it completes reading later, as with DMA. In block
+ *    upload a segment is lost, client confirms part of the sub-block and
+ *    requests the full blksize again.
+ *
+ * Exit status is the number of failed tests.
+ */
+
+
+#include <stdio.h>
+#include <string.h>
+
+#include "CANopen.h"
+/* not enabled in the application Object Dictionary */
+#include "CO_SDOmaster.h"
+#include "CO_NMTmaster.h"
+
+#if CO_SDO_DOMAIN_PREFETCH == 0 || CO_SDO_ODF_PENDING == 0
+#error CO_test.c requires CO_SDO_DOMAIN_PREFETCH and CO_SDO_ODF_PENDING, see Makefile
+#endif
+
+#define TEST_RX_SIZE            4U
+#define TEST_TX_SIZE            4U
+#define TEST_MODULES            4U
+#define TEST_BUS_FRAMES         256U
+#define TEST_SDO_TIMEOUT_MS     100U
+
+#define TEST_NMTM_CLIENTS       3U
+#define TEST_NMTM_SLAVES        2U
+#define TEST_DEVICE_TYPE        0x00020191UL
+#define TEST_CONFIG_INDEX       0x2000U
+#define TEST_BLOCK_INDEX        0x2001U
+#define TEST_BLOCK_SIZE         (127U * 7U)
+#define TEST_BLOCK_NODE         4U
+#define TEST_DOMAIN_INDEX       0x2002U
+#define TEST_DOMAIN_SIZE        3000U
+#define TEST_DOMAIN_DELAY_MS    3U
+
+#define TEST_CHECK(cond) test_check((cond) ? true : false, #cond, __LINE__)
+
+
+/* CAN module of one device on the virtual bus */
+typedef struct{
+    CO_CANmodule_t      CANmodule;
+    CO_CANrx_t          rxArray[TEST_RX_SIZE];
+    CO_CANtx_t          txArray[TEST_TX_SIZE];
+    bool_t              online;
+}test_can_t;
+
+/* Slave device with SDO server, NMT slave and heartbeat producer */
+typedef struct{
+    test_can_t          can;
+    uint8_t             nodeId;
+    uint8_t             NMTstate;
+    uint8_t             startCount;     /* start commands addressed to this node */
+    uint32_t            deviceType;
+    uint32_t            config;         /* written by NMT master */
+    uint8_t             block[TEST_BLOCK_SIZE]; /* full size SDO block */
+    uint16_t            domainDelay_ms; /* reading of domain completes later */
+    uint16_t            domainTimer;
+    uint16_t            domainReads;
+    CO_OD_entry_t       OD[4];
+    CO_OD_extension_t   ODExtensions[4];
+    CO_SDO_t            SDO;
+    CO_CANtx_t         *HBtx;
+}test_slave_t;
+
+
+static test_can_t *test_modules[TEST_MODULES];
+static uint8_t test_moduleCount;
+static CO_CANrxMsg_t test_frames[TEST_BUS_FRAMES];
+static uint16_t test_frameHead, test_frameTail;
+static uint16_t test_identCount[0x800];
+static uint16_t test_dropIdent, test_dropNo;
+static uint32_t test_timeMs;
+static int test_failed;
+
+
+static void test_check(bool_t ok, const char *cond, int line){
+    if(!ok){
+        fprintf(stderr, "CO_test.c:%d: %u ms: failed: %s\n", line, test_timeMs, cond);
+        test_failed++;
+    }
+}
+
+
+/* CANmodule->txSink, frame is dispatched by test_busDeliver() */
+static void test_txSink(const CO_CANtx_t *buffer){
+    CO_CANrxMsg_t *msg = &test_frames[test_frameHead % TEST_BUS_FRAMES];
+
+    memset(msg, 0, sizeof(*msg));
+    msg->ident = buffer->ident & 0x7FFU;
+    msg->DLC = buffer->DLC;
+    memcpy(msg->data, buffer->data, buffer->DLC);
+    test_identCount[msg->ident]++;
+    if(msg->ident == test_dropIdent && test_identCount[msg->ident] == test_dropNo){
+        return; /* lost on the bus */
+    }
+    test_frameHead++;
+    TEST_CHECK((uint16_t)(test_frameHead - test_frameTail) <= TEST_BUS_FRAMES);
+}
+
+
+static void test_canInit(test_can_t *can){
+    (void)CO_CANmodule_init(&can->CANmodule, 0, can->rxArray, TEST_RX_SIZE,
+                            can->txArray, TEST_TX_SIZE, 250U);
+    can->CANmodule.txSink = test_txSink;
+    (void)CO_CANsetNormalMode(&can->CANmodule);
+    can->online = true;
+    test_modules[test_moduleCount++] = can;
+}
+
+
+/* Dispatch frames, also frames transmitted from receive functions */
+static void test_busDeliver(void){
+    while(test_frameTail != test_frameHead){
+        CO_CANrxMsg_t msg = test_frames[test_frameTail % TEST_BUS_FRAMES];
+        uint8_t i;
+
+        test_frameTail++;
+        for(i = 0U; i < test_moduleCount; i++){
+            if(test_modules[i]->online){
+                CO_CANrxDispatch(&test_modules[i]->CANmodule, &msg);
+            }
+        }
+    }
+}
+
+
+/*******************************************************************************
+ * Slave devices
+ ******************************************************************************/
+static void test_slaveHeartbeat(test_slave_t *slave){
+    slave->HBtx->data[0] = slave->NMTstate;
+    (void)CO_CANsend(&slave->can.CANmodule, slave->HBtx);
+}
+
+
+/* NMT command received by slave */
+static void test_slaveNMT(void *object, const CO_CANrxMsg_t *msg){
+    test_slave_t *slave = (test_slave_t*)object;
+
+    if(msg->DLC != 2U || (msg->data[1] != 0U && msg->data[1] != slave->nodeId)){
+        return;
+    }
+    switch(msg->data[0]){
+        case CO_NMT_ENTER_OPERATIONAL:
+            slave->NMTstate = CO_NMT_OPERATIONAL;
+            if(msg->data[1] != 0U){
+                slave->startCount++;
+            }
+            test_slaveHeartbeat(slave);
+            break;
+        case CO_NMT_RESET_NODE:
+        case CO_NMT_RESET_COMMUNICATION:
+            slave->NMTstate = CO_NMT_INITIALIZING;
+            test_slaveHeartbeat(slave);
+            slave->NMTstate = CO_NMT_PRE_OPERATIONAL;
+            break;
+        default:
+            break;
+    }
+}
+
+
+static uint8_t test_domainByte(uint32_t offset){
+    return (uint8_t)(offset * 7U + 3U + (offset >> 8));
+}
+
+
+/* Domain in slow memory, read directly or completed after domainDelay_ms */
+static CO_SDO_abortCode_t test_slaveDomain(CO_ODF_arg_t *ODF_arg){
+    test_slave_t *slave = (test_slave_t*)ODF_arg->object;
+    uint32_t rest = TEST_DOMAIN_SIZE - ODF_arg->offset;
+    uint16_t i;
+
+    if(!ODF_arg->reading){
+        return CO_SDO_AB_READONLY;
+    }
+    if(slave->domainDelay_ms > 0U && !ODF_arg->resumed){
+        slave->domainTimer = slave->domainDelay_ms;
+        return CO_SDO_AB_PENDING;
+    }
+
+    if(ODF_arg->firstSegment){
+        ODF_arg->dataLengthTotal = TEST_DOMAIN_SIZE;
+    }
+    ODF_arg->lastSegment = rest <= ODF_arg->dataLength;
+    if(ODF_arg->lastSegment){
+        ODF_arg->dataLength = (uint16_t)rest;
+    }
+    for(i = 0U; i < ODF_arg->dataLength; i++){
+        ODF_arg->data[i] = test_domainByte(ODF_arg->offset + i);
+    }
+    slave->domainReads++;
+
+    return CO_SDO_AB_NONE;
+}
+
+
+static void test_slaveInit(test_slave_t *slave, uint8_t nodeId){
+    memset(slave, 0, sizeof(*slave));
+    slave->nodeId = nodeId;
+    slave->NMTstate = CO_NMT_PRE_OPERATIONAL;
+    slave->deviceType = TEST_DEVICE_TYPE;
+    slave->OD[0] = (CO_OD_entry_t){0x1000U, 0U, CO_ODA_MEM_ROM | CO_ODA_READABLE | CO_ODA_MB_VALUE,
+                                   4U, (void*)&slave->deviceType};
+    slave->OD[1] = (CO_OD_entry_t){TEST_CONFIG_INDEX, 0U, CO_ODA_MEM_RAM | CO_ODA_READABLE | CO_ODA_WRITEABLE | CO_ODA_MB_VALUE,
+                                   4U, (void*)&slave->config};
+    slave->OD[2] = (CO_OD_entry_t){TEST_BLOCK_INDEX, 0U, CO_ODA_MEM_RAM | CO_ODA_READABLE | CO_ODA_WRITEABLE,
+                                   TEST_BLOCK_SIZE, (void*)&slave->block[0]};
+    slave->OD[3] = (CO_OD_entry_t){TEST_DOMAIN_INDEX, 0U, CO_ODA_MEM_RAM | CO_ODA_READABLE, 0U, NULL};
+
+    test_canInit(&slave->can);
+    (void)CO_SDO_init(&slave->SDO, CO_CAN_ID_RSDO + nodeId, CO_CAN_ID_TSDO + nodeId, 0U, NULL,
+                      slave->OD, 4U, slave->ODExtensions, nodeId,
+                      &slave->can.CANmodule, 0U, &slave->can.CANmodule, 0U);
+    CO_OD_configure(&slave->SDO, TEST_DOMAIN_INDEX, test_slaveDomain, (void*)slave, NULL, 0U);
+    (void)CO_CANrxBufferInit(&slave->can.CANmodule, 1U, CO_CAN_ID_NMT_SERVICE, 0x7FFU, false,
+                             (void*)slave, test_slaveNMT);
+    slave->HBtx = CO_CANtxBufferInit(&slave->can.CANmodule, 1U, CO_CAN_ID_HEARTBEAT + nodeId,
+                                     false, 1U, false);
+}
+
+
+static void test_slaveProcess(test_slave_t *slave){
+    uint16_t timerNext_ms = 1000U;
+
+    if(slave->can.online){
+        if(slave->domainTimer > 0U && --slave->domainTimer == 0U){
+            CO_SDO_ODFcomplete(&slave->SDO);
+        }
+        (void)CO_SDO_process(&slave->SDO, true, 1U, 1000U, &timerNext_ms);
+    }
+}
+
+
+/*******************************************************************************
+ * NMT master boots slaves
+ ******************************************************************************/
+static test_can_t test_masterCan;
+static CO_OD_extension_t test_masterODExtensions[1];
+static const CO_OD_entry_t test_masterOD[1] = {
+    {0x1000U, 0U, CO_ODA_MEM_ROM | CO_ODA_READABLE, 4U, NULL}
+};
+static CO_SDO_t test_masterSDO;
+static CO_SDOclientPar_t test_clientPar[TEST_NMTM_CLIENTS];
+static CO_SDOclient_t test_client[TEST_NMTM_CLIENTS];
+static CO_SDOclient_t *test_clients[TEST_NMTM_CLIENTS];
+static CO_SDOclientQueue_t test_queue;
+static CO_HBconsumer_t test_HBcons;
+static CO_NMTmaster_t test_NMTm;
+static CO_NMTmasterSlave_t test_nmtmSlaves[TEST_NMTM_SLAVES];
+static CO_NMTmasterConfig_t test_nmtmConfig[TEST_NMTM_SLAVES];
+static uint8_t test_nmtmConfigData[TEST_NMTM_SLAVES][4];
+static test_slave_t test_slave[TEST_NMTM_SLAVES];
+static uint8_t test_hbCalls;
+
+
+/* heartbeat consumer callback of the application, set before NMT master */
+static void test_appHBcallback(void *object, uint8_t nodeId, uint8_t idx,
+                               CO_HBconsumer_event_t event, uint8_t NMTstate)
+{
+    (void)nodeId; (void)idx; (void)event; (void)NMTstate;
+    (*(uint8_t*)object)++;
+}
+
+
+/* Number of SDO transfers running at the same time */
+static uint8_t test_running(const CO_SDOclientQueue_t *queue){
+    const CO_SDOclientJob_t *job;
+    uint8_t n = 0U;
+
+    for(job = queue->head; job != NULL; job = job->next){
+        if(job->client != 0xFFU){
+            n++;
+        }
+    }
+    return n;
+}
+
+
+/* Run master and slaves until all slaves are operational or timeout */
+static bool_t test_nmtmRun(uint32_t timeoutMs, uint8_t *maxRunning){
+    uint32_t end = test_timeMs + timeoutMs;
+    bool_t done = false;
+
+    while(!done && test_timeMs < end){
+        uint16_t timerNext_ms = 1000U;
+        uint8_t i, n;
+
+        for(i = 0U; i < TEST_NMTM_SLAVES; i++){
+            test_slaveProcess(&test_slave[i]);
+        }
+        test_busDeliver();
+        (void)CO_SDOclientQueue_process(&test_queue, 1U, TEST_SDO_TIMEOUT_MS, &timerNext_ms);
+        done = CO_NMTmaster_process(&test_NMTm, 1U, &timerNext_ms);
+        test_busDeliver();
+
+        n = test_running(&test_queue);
+        if(maxRunning != NULL && n > *maxRunning){
+            *maxRunning = n;
+        }
+        test_timeMs++;
+    }
+    return done;
+}
+
+
+static void test_nmtmBoot(void){
+    uint8_t maxRunning = 0U;
+    uint8_t i;
+
+    test_canInit(&test_masterCan);
+    (void)CO_SDO_init(&test_masterSDO, 0U, 0U, 0U, NULL, test_masterOD, 1U,
+                      test_masterODExtensions, 1U, NULL, 0U, NULL, 0U);
+    for(i = 0U; i < TEST_NMTM_CLIENTS; i++){
+        test_clientPar[i].maxSubIndex = 3U;
+        test_clients[i] = &test_client[i];
+        TEST_CHECK(CO_SDOclient_init(&test_client[i], &test_masterSDO, &test_clientPar[i],
+                   &test_masterCan.CANmodule, i, &test_masterCan.CANmodule, 1U + i) == CO_ERROR_NO);
+    }
+    TEST_CHECK(CO_SDOclientQueue_init(&test_queue, test_clients, TEST_NMTM_CLIENTS) == CO_ERROR_NO);
+
+    /* CO_init() initializes NMT master without slaves */
+    TEST_CHECK(CO_NMTmaster_init(&test_NMTm, NULL, 0U, &test_HBcons, &test_queue,
+                                 &test_masterCan.CANmodule, 0U) == CO_ERROR_NO);
+    CO_HBconsumer_initCallback(&test_HBcons, (void*)&test_hbCalls, test_appHBcallback);
+
+    for(i = 0U; i < TEST_NMTM_SLAVES; i++){
+        uint8_t nodeId = (uint8_t)(2U + i);
+
+        test_slaveInit(&test_slave[i], nodeId);
+        CO_setUint32(test_nmtmConfigData[i], 0x11223300UL + nodeId);
+        test_nmtmConfig[i] = (CO_NMTmasterConfig_t){TEST_CONFIG_INDEX, 0U, test_nmtmConfigData[i], 4U};
+        test_nmtmSlaves[i].nodeId = nodeId;
+        test_nmtmSlaves[i].deviceType = TEST_DEVICE_TYPE;
+        test_nmtmSlaves[i].config = &test_nmtmConfig[i];
+        test_nmtmSlaves[i].configCount = 1U;
+    }
+    TEST_CHECK(CO_NMTmaster_initSlaves(&test_NMTm, test_nmtmSlaves, TEST_NMTM_SLAVES) == CO_ERROR_NO);
+    test_NMTm.retryTime_ms = 50U;
+
+    /* second slave does not respond first, it is retried and it does not
+     * delay the first slave */
+    test_slave[1].can.online = false;
+    CO_NMTmaster_bootNetwork(&test_NMTm);
+    TEST_CHECK(!test_nmtmRun(TEST_SDO_TIMEOUT_MS / 2U, &maxRunning));
+    TEST_CHECK(test_nmtmSlaves[0].state == CO_NMTM_SLAVE_READY);
+    TEST_CHECK(!test_nmtmRun(2U * TEST_SDO_TIMEOUT_MS, &maxRunning));
+    TEST_CHECK(test_nmtmSlaves[1].state == CO_NMTM_SLAVE_WAIT ||
+               test_nmtmSlaves[1].state == CO_NMTM_SLAVE_IDENTITY);
+    test_slave[1].can.online = true;
+
+    TEST_CHECK(test_nmtmRun(1000U, &maxRunning));
+    TEST_CHECK(maxRunning >= 2U);
+    for(i = 0U; i < TEST_NMTM_SLAVES; i++){
+        TEST_CHECK(test_nmtmSlaves[i].state == CO_NMTM_SLAVE_OPERATIONAL);
+        TEST_CHECK(test_slave[i].NMTstate == CO_NMT_OPERATIONAL);
+        TEST_CHECK(test_slave[i].config == 0x11223300UL + test_slave[i].nodeId);
+        TEST_CHECK(test_slave[i].startCount == 0U);
+    }
+
+    /* boot-up of the slave, application callback is chained */
+    test_hbCalls = 0U;
+    test_slave[0].NMTstate = CO_NMT_PRE_OPERATIONAL;
+    test_HBcons.pFunctChanged(test_HBcons.functChangedObject, test_slave[0].nodeId, 0U,
+                              CO_HBCONS_BOOTUP, CO_NMT_INITIALIZING);
+    TEST_CHECK(test_hbCalls == 1U);
+    TEST_CHECK(test_nmtmRun(1000U, NULL));
+    TEST_CHECK(test_slave[0].NMTstate == CO_NMT_OPERATIONAL);
+    TEST_CHECK(test_slave[0].startCount == 1U);
+
+    printf("NMT master boot-up of %u slaves: %u ms, %u parallel SDO transfers\n",
+           TEST_NMTM_SLAVES, test_timeMs, maxRunning);
+}
+
+
+/*******************************************************************************
+ * SDO block transfer
+ ******************************************************************************/
+static test_slave_t test_blockSlave;
+static uint8_t test_blockData[TEST_BLOCK_SIZE];
+static uint8_t test_blockRx[TEST_BLOCK_SIZE];
+
+
+/* Run SDO client of the master and block slave until transfer ends */
+static CO_SDOclient_return_t test_sdoRun(CO_SDOclient_t *client, bool_t upload,
+                                         uint32_t *pDataSize, uint32_t *pAbortCode)
+{
+    CO_SDOclient_return_t ret;
+    uint32_t end = test_timeMs + 2000U;
+
+    do{
+        test_slaveProcess(&test_blockSlave);
+        test_busDeliver();
+        ret = upload ? CO_SDOclientUpload(client, 1U, TEST_SDO_TIMEOUT_MS, pDataSize, pAbortCode)
+                     : CO_SDOclientDownload(client, 1U, TEST_SDO_TIMEOUT_MS, pAbortCode);
+        test_busDeliver();
+        test_timeMs++;
+    }while(ret > 0 && test_timeMs < end);
+    CO_SDOclientClose(client);
+
+    return ret;
+}
+
+
+static void test_sdoBlock(void){
+    CO_SDOclient_t *client = &test_client[0];
+    uint16_t RSDO = CO_CAN_ID_RSDO + TEST_BLOCK_NODE;
+    uint16_t TSDO = CO_CAN_ID_TSDO + TEST_BLOCK_NODE;
+    uint32_t abortCode = 0U;
+    uint32_t size = 0U;
+    uint32_t start, downloadMs;
+    uint16_t i;
+
+    /* client of NMT master test is free now */
+    test_slaveInit(&test_blockSlave, TEST_BLOCK_NODE);
+    for(i = 0U; i < TEST_BLOCK_SIZE; i++){
+        test_blockData[i] = (uint8_t)(i * 7U + (i >> 8));
+    }
+    TEST_CHECK(CO_SDOclient_setup(client, 0U, 0U, TEST_BLOCK_NODE) == CO_SDOcli_ok_communicationEnd);
+
+    /* initiate, 127 segments and end with CRC, server confirms each */
+    memset(test_identCount, 0, sizeof(test_identCount));
+    start = test_timeMs;
+    TEST_CHECK(CO_SDOclientDownloadInitiate(client, TEST_BLOCK_INDEX, 0U, test_blockData,
+                                            TEST_BLOCK_SIZE, 1U) == CO_SDOcli_ok_communicationEnd);
+    TEST_CHECK(test_sdoRun(client, false, NULL, &abortCode) == CO_SDOcli_ok_communicationEnd);
+    downloadMs = test_timeMs - start;
+    TEST_CHECK(abortCode == 0U);
+    TEST_CHECK(test_identCount[RSDO] == 1U + 127U + 1U);
+    TEST_CHECK(test_identCount[TSDO] == 3U);
+    TEST_CHECK(memcmp(test_blockSlave.block, test_blockData, TEST_BLOCK_SIZE) == 0);
+
+    /* initiate, start, 127 segments, acknowledge and end with CRC */
+    memset(test_identCount, 0, sizeof(test_identCount));
+    start = test_timeMs;
+    TEST_CHECK(CO_SDOclientUploadInitiate(client, TEST_BLOCK_INDEX, 0U, test_blockRx,
+                                          TEST_BLOCK_SIZE, 1U) == CO_SDOcli_ok_communicationEnd);
+    TEST_CHECK(test_sdoRun(client, true, &size, &abortCode) == CO_SDOcli_ok_communicationEnd);
+    TEST_CHECK(abortCode == 0U);
+    TEST_CHECK(size == TEST_BLOCK_SIZE);
+    TEST_CHECK(test_identCount[TSDO] == 1U + 127U + 1U);
+    TEST_CHECK(test_identCount[RSDO] == 4U);
+    TEST_CHECK(memcmp(test_blockRx, test_blockData, TEST_BLOCK_SIZE) == 0);
+
+    printf("SDO block transfer of %u bytes: download %u ms, upload %u ms\n",
+           TEST_BLOCK_SIZE, downloadMs, test_timeMs - start);
+}
+
+
+/*******************************************************************************
+ * SDO upload of domain with prefetch
+ ******************************************************************************/
+static uint8_t test_domainRx[TEST_DOMAIN_SIZE];
+
+
+/* Upload domain from block slave, segment dropNo is lost, if nonzero. Return
+ * duration of the transfer. */
+static uint32_t test_domainUpload(bool_t block, uint16_t delay_ms, uint16_t dropNo){
+    CO_SDOclient_t *client = &test_client[0];
+    uint16_t TSDO = CO_CAN_ID_TSDO + TEST_BLOCK_NODE;
+    uint32_t abortCode = 0U;
+    uint32_t size = 0U;
+    uint32_t start = test_timeMs;
+    uint32_t i;
+
+    memset(test_domainRx, 0, sizeof(test_domainRx));
+    memset(test_identCount, 0, sizeof(test_identCount));
+    test_blockSlave.domainDelay_ms = delay_ms;
+    test_blockSlave.domainReads = 0U;
+    test_dropIdent = TSDO;
+    test_dropNo = dropNo;
+
+    TEST_CHECK(CO_SDOclientUploadInitiate(client, TEST_DOMAIN_INDEX, 0U, test_domainRx,
+                                          TEST_DOMAIN_SIZE, block ? 1U : 0U) == CO_SDOcli_ok_communicationEnd);
+    TEST_CHECK(test_sdoRun(client, true, &size, &abortCode) == CO_SDOcli_ok_communicationEnd);
+    TEST_CHECK(abortCode == 0U);
+    TEST_CHECK(size == TEST_DOMAIN_SIZE);
+    TEST_CHECK(test_blockSlave.domainReads > (TEST_DOMAIN_SIZE / CO_SDO_BUFFER_SIZE));
+    TEST_CHECK(test_identCount[TSDO] >= dropNo);
+    for(i = 0U; i < TEST_DOMAIN_SIZE; i++){
+        if(test_domainRx[i] != test_domainByte(i)){
+            TEST_CHECK(test_domainRx[i] == test_domainByte(i));
+            break;
+        }
+    }
+    test_dropNo = 0U;
+
+    return test_timeMs - start;
+}
+
+
+static void test_sdoDomain(void){
+    uint32_t segmentedMs, blockMs;
+
+    /* direct and deferred reading of the domain */
+    segmentedMs = test_domainUpload(false, 0U, 0U);
+    segmentedMs += test_domainUpload(false, TEST_DOMAIN_DELAY_MS, 0U);
+    blockMs = test_domainUpload(true, 0U, 0U);
+    blockMs += test_domainUpload(true, TEST_DOMAIN_DELAY_MS, 0U);
+
+    /* segment is lost, client confirms part of the sub-block and requests
+     * 127 segments again. Lost in the second half of the first sub-block,
+     * rest is rotated in front of prefetched data, lost in the second
+     * sub-block, rest is moved down with prefetched data. */
+    (void)test_domainUpload(true, 0U, 1U + 70U);
+    (void)test_domainUpload(true, TEST_DOMAIN_DELAY_MS, 1U + 127U + 60U);
+
+    printf("SDO domain upload of %u bytes with prefetch: segmented %u ms, block %u ms\n",
+           TEST_DOMAIN_SIZE, segmentedMs / 2U, blockMs / 2U);
+}
+
+
+/******************************************************************************/
+int main(void){
+    test_nmtmBoot();
+    test_sdoBlock();
+    test_sdoDomain();
+
+    if(test_failed > 0){
+        fprintf(stderr, "%d checks failed\n", test_failed);
+    }
+    return test_failed;
+}
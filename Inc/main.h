@@ -72,6 +72,8 @@
 /* #define USE_FULL_ASSERT    1U */
 
 /* USER CODE BEGIN Private defines */
+/* also called after wake-up from Stop2 mode, see TASK_STOP2 */
+void SystemClock_Config(void);
 
 /* USER CODE END Private defines */
 
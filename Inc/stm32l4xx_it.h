@@ -59,8 +59,10 @@ void SysTick_Handler(void);
 void CAN1_TX_IRQHandler(void);
 void CAN1_RX0_IRQHandler(void);
 void CAN1_RX1_IRQHandler(void);
+void CAN1_SCE_IRQHandler(void);
 void USART1_IRQHandler(void);
 void SPI3_IRQHandler(void);
+void TIM6_DAC_IRQHandler(void);
 
 #ifdef __cplusplus
 }
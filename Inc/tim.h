@@ -48,6 +48,7 @@
 #include "main.h"
 
 /* USER CODE BEGIN Includes */
+#include "CO_driver.h"
 
 /* USER CODE END Includes */
 
@@ -62,6 +63,21 @@ extern void _Error_Handler(char *, int);
 void MX_TIM6_Init(void);
 
 /* USER CODE BEGIN Prototypes */
+extern TIM_HandleTypeDef htim7;
+
+void MX_TIM7_Init(uint32_t rate_Hz);
+
+#if CO_PROFILE_PC > 0
+extern TIM_HandleTypeDef htim16;
+
+void MX_TIM16_Init(uint32_t rate_Hz);
+#endif
+
+#if (CO_SYNC_HW_TIMER > 0) || (CO_SYNC_WINDOW_TIMER > 0) || (CO_HB_HW_TIMER > 0)
+extern TIM_HandleTypeDef htim2;
+
+void MX_TIM2_Init(void);
+#endif
 
 /* USER CODE END Prototypes */
 
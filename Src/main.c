@@ -48,6 +48,7 @@
 
 /* USER CODE BEGIN Includes */
 #include "task.h"
+#include "task_boot.h"
 /* USER CODE END Includes */
 
 /* Private variables ---------------------------------------------------------*/
@@ -77,7 +78,7 @@ void SystemClock_Config(void);
 int main(void)
 {
   /* USER CODE BEGIN 1 */
-
+  task_boot_start();
   /* USER CODE END 1 */
 
   /* MCU Configuration----------------------------------------------------------*/
@@ -86,25 +87,28 @@ int main(void)
   HAL_Init();
 
   /* USER CODE BEGIN Init */
-
+  task_boot_mark(TASK_BOOT_HAL);
   /* USER CODE END Init */
 
   /* Configure the system clock */
   SystemClock_Config();
 
   /* USER CODE BEGIN SysInit */
-
+  task_boot_mark(TASK_BOOT_CLOCK);
   /* USER CODE END SysInit */
 
   /* Initialize all configured peripherals */
   MX_GPIO_Init();
   MX_CAN1_Init();
-  MX_SPI3_Init();
   MX_TIM6_Init();
-  MX_USART1_UART_Init();
-  MX_I2C1_Init();
   /* USER CODE BEGIN 2 */
+  /* SPI3, USART1 and I2C1 are initialized by task_coldStart() */
+  task_boot_mark(TASK_BOOT_PERIPH);
   task_coldStart();
+#if CO_RTOS > 0
+  /* CANopen threads take over the loop below */
+  task_rtosStart();
+#endif
   /* USER CODE END 2 */
 
   /* Infinite loop */
@@ -115,13 +119,14 @@ int main(void)
   /* USER CODE END WHILE */
 
   /* USER CODE BEGIN 3 */
-	static uint32_t PreviousTicks = 0U;
-	uint32_t CurrentTicks = HAL_GetTick();
-	if((CurrentTicks - PreviousTicks) >= 1u)
+	if(task_timerElapsed())
 	 {
-			PreviousTicks = HAL_GetTick();
 			task_oneMs();
 	 }
+	else
+	 {
+			task_sleep();
+	 }
   }
   /* USER CODE END 3 */
 
@@ -43,7 +43,9 @@
 #include "gpio.h"
 
 /* USER CODE BEGIN 0 */
-
+/* DMA for CO_eeprom.c (CO_EE_BACKEND_SPI) */
+DMA_HandleTypeDef hdma_spi3_tx;
+DMA_HandleTypeDef hdma_spi3_rx;
 /* USER CODE END 0 */
 
 SPI_HandleTypeDef hspi3;
@@ -101,7 +103,43 @@ void HAL_SPI_MspInit(SPI_HandleTypeDef* spiHandle)
     HAL_NVIC_SetPriority(SPI3_IRQn, 0, 0);
     HAL_NVIC_EnableIRQ(SPI3_IRQn);
   /* USER CODE BEGIN SPI3_MspInit 1 */
-
+    __HAL_RCC_DMA2_CLK_ENABLE();
+
+    /* SPI3_TX Init */
+    hdma_spi3_tx.Instance = DMA2_Channel2;
+    hdma_spi3_tx.Init.Request = DMA_REQUEST_3;
+    hdma_spi3_tx.Init.Direction = DMA_MEMORY_TO_PERIPH;
+    hdma_spi3_tx.Init.PeriphInc = DMA_PINC_DISABLE;
+    hdma_spi3_tx.Init.MemInc = DMA_MINC_ENABLE;
+    hdma_spi3_tx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    hdma_spi3_tx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+    hdma_spi3_tx.Init.Mode = DMA_NORMAL;
+    hdma_spi3_tx.Init.Priority = DMA_PRIORITY_LOW;
+    if (HAL_DMA_Init(&hdma_spi3_tx) != HAL_OK)
+    {
+      _Error_Handler(__FILE__, __LINE__);
+    }
+    __HAL_LINKDMA(spiHandle,hdmatx,hdma_spi3_tx);
+    HAL_NVIC_SetPriority(DMA2_Channel2_IRQn, 3, 0);
+    HAL_NVIC_EnableIRQ(DMA2_Channel2_IRQn);
+
+    /* SPI3_RX Init */
+    hdma_spi3_rx.Instance = DMA2_Channel1;
+    hdma_spi3_rx.Init.Request = DMA_REQUEST_3;
+    hdma_spi3_rx.Init.Direction = DMA_PERIPH_TO_MEMORY;
+    hdma_spi3_rx.Init.PeriphInc = DMA_PINC_DISABLE;
+    hdma_spi3_rx.Init.MemInc = DMA_MINC_ENABLE;
+    hdma_spi3_rx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    hdma_spi3_rx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+    hdma_spi3_rx.Init.Mode = DMA_NORMAL;
+    hdma_spi3_rx.Init.Priority = DMA_PRIORITY_LOW;
+    if (HAL_DMA_Init(&hdma_spi3_rx) != HAL_OK)
+    {
+      _Error_Handler(__FILE__, __LINE__);
+    }
+    __HAL_LINKDMA(spiHandle,hdmarx,hdma_spi3_rx);
+    HAL_NVIC_SetPriority(DMA2_Channel1_IRQn, 3, 0);
+    HAL_NVIC_EnableIRQ(DMA2_Channel1_IRQn);
   /* USER CODE END SPI3_MspInit 1 */
   }
 }
@@ -127,7 +165,10 @@ void HAL_SPI_MspDeInit(SPI_HandleTypeDef* spiHandle)
     /* SPI3 interrupt Deinit */
     HAL_NVIC_DisableIRQ(SPI3_IRQn);
   /* USER CODE BEGIN SPI3_MspDeInit 1 */
-
+    HAL_DMA_DeInit(spiHandle->hdmatx);
+    HAL_DMA_DeInit(spiHandle->hdmarx);
+    HAL_NVIC_DisableIRQ(DMA2_Channel2_IRQn);
+    HAL_NVIC_DisableIRQ(DMA2_Channel1_IRQn);
   /* USER CODE END SPI3_MspDeInit 1 */
   }
 } 
@@ -36,12 +36,36 @@
 #include "stm32l4xx_it.h"
 
 /* USER CODE BEGIN 0 */
-
+#include "CO_driver.h"
+
+extern I2C_HandleTypeDef hi2c1;
+extern DMA_HandleTypeDef hdma_i2c1_tx;
+extern DMA_HandleTypeDef hdma_i2c1_rx;
+extern DMA_HandleTypeDef hdma_spi3_tx;
+extern DMA_HandleTypeDef hdma_spi3_rx;
+extern DMA_HandleTypeDef hdma_usart1_tx;
+extern DMA_HandleTypeDef hdma_usart1_rx;
+extern TIM_HandleTypeDef htim7;
+#if CO_SYNC_HW_TIMER > 0
+extern void task_syncTimer(void);
+#endif
+#if CO_SYNC_WINDOW_TIMER > 0
+extern void task_syncWindowTimer(void);
+#endif
+#if CO_HB_HW_TIMER > 0
+extern void task_heartbeatTimer(void);
+#endif
+#if CO_PROFILE_PC > 0
+#include "CO_profile.h"
+
+void TIM16_sample(const uint32_t *frame);
+#endif
 /* USER CODE END 0 */
 
 /* External variables --------------------------------------------------------*/
 extern CAN_HandleTypeDef hcan1;
 extern SPI_HandleTypeDef hspi3;
+extern TIM_HandleTypeDef htim6;
 extern UART_HandleTypeDef huart1;
 
 /******************************************************************************/
@@ -214,7 +238,12 @@ void CAN1_TX_IRQHandler(void)
 void CAN1_RX0_IRQHandler(void)
 {
   /* USER CODE BEGIN CAN1_RX0_IRQn 0 */
-
+#if CO_CAN_RX_DIRECT > 0
+  if(CO_CANirqHandler_Rx(&hcan1, CAN_RX_FIFO0))
+  {
+    return;
+  }
+#endif
   /* USER CODE END CAN1_RX0_IRQn 0 */
   HAL_CAN_IRQHandler(&hcan1);
   /* USER CODE BEGIN CAN1_RX0_IRQn 1 */
@@ -228,7 +257,12 @@ void CAN1_RX0_IRQHandler(void)
 void CAN1_RX1_IRQHandler(void)
 {
   /* USER CODE BEGIN CAN1_RX1_IRQn 0 */
-
+#if CO_CAN_RX_DIRECT > 0
+  if(CO_CANirqHandler_Rx(&hcan1, CAN_RX_FIFO1))
+  {
+    return;
+  }
+#endif
   /* USER CODE END CAN1_RX1_IRQn 0 */
   HAL_CAN_IRQHandler(&hcan1);
   /* USER CODE BEGIN CAN1_RX1_IRQn 1 */
@@ -236,6 +270,20 @@ void CAN1_RX1_IRQHandler(void)
   /* USER CODE END CAN1_RX1_IRQn 1 */
 }
 
+/**
+* @brief This function handles CAN1 SCE interrupt.
+*/
+void CAN1_SCE_IRQHandler(void)
+{
+  /* USER CODE BEGIN CAN1_SCE_IRQn 0 */
+
+  /* USER CODE END CAN1_SCE_IRQn 0 */
+  HAL_CAN_IRQHandler(&hcan1);
+  /* USER CODE BEGIN CAN1_SCE_IRQn 1 */
+
+  /* USER CODE END CAN1_SCE_IRQn 1 */
+}
+
 /**
 * @brief This function handles USART1 global interrupt.
 */
@@ -264,7 +312,152 @@ void SPI3_IRQHandler(void)
   /* USER CODE END SPI3_IRQn 1 */
 }
 
+/**
+* @brief This function handles TIM6 global interrupt, DAC channel1 and channel2 underrun error interrupts.
+*/
+void TIM6_DAC_IRQHandler(void)
+{
+  /* USER CODE BEGIN TIM6_DAC_IRQn 0 */
+
+  /* USER CODE END TIM6_DAC_IRQn 0 */
+  HAL_TIM_IRQHandler(&htim6);
+  /* USER CODE BEGIN TIM6_DAC_IRQn 1 */
+
+  /* USER CODE END TIM6_DAC_IRQn 1 */
+}
+
 /* USER CODE BEGIN 1 */
+/**
+* @brief This function handles DMA1 channel4 global interrupt (USART1_TX).
+*/
+void DMA1_Channel4_IRQHandler(void)
+{
+  HAL_DMA_IRQHandler(&hdma_usart1_tx);
+}
+
+/**
+* @brief This function handles DMA1 channel5 global interrupt (USART1_RX).
+*/
+void DMA1_Channel5_IRQHandler(void)
+{
+  HAL_DMA_IRQHandler(&hdma_usart1_rx);
+}
+
+/**
+* @brief This function handles DMA1 channel6 global interrupt (I2C1_TX).
+*/
+void DMA1_Channel6_IRQHandler(void)
+{
+  HAL_DMA_IRQHandler(&hdma_i2c1_tx);
+}
+
+/**
+* @brief This function handles DMA1 channel7 global interrupt (I2C1_RX).
+*/
+void DMA1_Channel7_IRQHandler(void)
+{
+  HAL_DMA_IRQHandler(&hdma_i2c1_rx);
+}
+
+/**
+* @brief This function handles I2C1 event interrupt.
+*/
+void I2C1_EV_IRQHandler(void)
+{
+  HAL_I2C_EV_IRQHandler(&hi2c1);
+}
+
+/**
+* @brief This function handles I2C1 error interrupt.
+*/
+void I2C1_ER_IRQHandler(void)
+{
+  HAL_I2C_ER_IRQHandler(&hi2c1);
+}
+
+/**
+* @brief This function handles DMA2 channel1 global interrupt (SPI3_RX).
+*/
+void DMA2_Channel1_IRQHandler(void)
+{
+  HAL_DMA_IRQHandler(&hdma_spi3_rx);
+}
+
+/**
+* @brief This function handles DMA2 channel2 global interrupt (SPI3_TX).
+*/
+void DMA2_Channel2_IRQHandler(void)
+{
+  HAL_DMA_IRQHandler(&hdma_spi3_tx);
+}
+
+#if defined(TIM7)
+/**
+* @brief This function handles TIM7 global interrupt (trace sampling).
+*/
+void TIM7_IRQHandler(void)
+{
+  HAL_TIM_IRQHandler(&htim7);
+}
+#endif
+
+#if CO_PROFILE_PC > 0
+/**
+* @brief This function handles TIM1 update and TIM16 global interrupt (PC sampling).
+*/
+__attribute__((naked)) void TIM1_UP_TIM16_IRQHandler(void)
+{
+  /* exception stack frame of the interrupted code, MSP or PSP by EXC_RETURN */
+  __asm volatile(
+    "tst   lr, #4      \n"
+    "ite   eq          \n"
+    "mrseq r0, msp     \n"
+    "mrsne r0, psp     \n"
+    "b     TIM16_sample\n"
+  );
+}
+
+/* frame[6] is the stacked PC, also with extended (FPU) frame */
+void TIM16_sample(const uint32_t *frame)
+{
+  TIM16->SR = ~TIM_SR_UIF;
+  CO_profilePC_sample(frame[6]);
+}
+#endif
+
+#if (CO_SYNC_HW_TIMER > 0) || (CO_SYNC_WINDOW_TIMER > 0) || (CO_HB_HW_TIMER > 0)
+/**
+* @brief This function handles TIM2 global interrupt (SYNC producer and window,
+* heartbeat producer).
+*/
+void TIM2_IRQHandler(void)
+{
+  /* HAL_TIM_IRQHandler() is bypassed, only enabled compares are served */
+  uint32_t flags = TIM2->SR & TIM2->DIER;
+
+#if CO_SYNC_HW_TIMER > 0
+  if ((flags & TIM_SR_CC1IF) != 0U)
+  {
+    TIM2->SR = ~TIM_SR_CC1IF;
+    task_syncTimer();
+  }
+#endif
+#if CO_SYNC_WINDOW_TIMER > 0
+  if ((flags & TIM_SR_CC2IF) != 0U)
+  {
+    TIM2->SR = ~TIM_SR_CC2IF;
+    task_syncWindowTimer();
+  }
+#endif
+#if CO_HB_HW_TIMER > 0
+  if ((flags & TIM_SR_CC3IF) != 0U)
+  {
+    TIM2->SR = ~TIM_SR_CC3IF;
+    task_heartbeatTimer();
+  }
+#endif
+}
+#endif
 
 /* USER CODE END 1 */
 /************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
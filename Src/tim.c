@@ -80,6 +80,10 @@ void HAL_TIM_Base_MspInit(TIM_HandleTypeDef* tim_baseHandle)
   /* USER CODE END TIM6_MspInit 0 */
     /* TIM6 clock enable */
     __HAL_RCC_TIM6_CLK_ENABLE();
+
+    /* TIM6 interrupt Init */
+    HAL_NVIC_SetPriority(TIM6_DAC_IRQn, 2, 0);
+    HAL_NVIC_EnableIRQ(TIM6_DAC_IRQn);
   /* USER CODE BEGIN TIM6_MspInit 1 */
 
   /* USER CODE END TIM6_MspInit 1 */
@@ -96,6 +100,9 @@ void HAL_TIM_Base_MspDeInit(TIM_HandleTypeDef* tim_baseHandle)
   /* USER CODE END TIM6_MspDeInit 0 */
     /* Peripheral clock disable */
     __HAL_RCC_TIM6_CLK_DISABLE();
+
+    /* TIM6 interrupt Deinit */
+    HAL_NVIC_DisableIRQ(TIM6_DAC_IRQn);
   /* USER CODE BEGIN TIM6_MspDeInit 1 */
 
   /* USER CODE END TIM6_MspDeInit 1 */
@@ -103,7 +110,117 @@ void HAL_TIM_Base_MspDeInit(TIM_HandleTypeDef* tim_baseHandle)
 } 
 
 /* USER CODE BEGIN 1 */
+#if defined(TIM7)
+TIM_HandleTypeDef htim7;
+
+/* TIM7 init function, trace sampling timer, 1 MHz counter */
+void MX_TIM7_Init(uint32_t rate_Hz)
+{
+  TIM_MasterConfigTypeDef sMasterConfig;
+
+  /* HAL_TIM_Base_MspInit() handles TIM6 only */
+  __HAL_RCC_TIM7_CLK_ENABLE();
+
+  htim7.Instance = TIM7;
+  htim7.Init.Prescaler = (HAL_RCC_GetPCLK1Freq() / 1000000U) - 1U;
+  htim7.Init.CounterMode = TIM_COUNTERMODE_UP;
+  htim7.Init.Period = (1000000U / rate_Hz) - 1U;
+  htim7.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
+  if (HAL_TIM_Base_Init(&htim7) != HAL_OK)
+  {
+    _Error_Handler(__FILE__, __LINE__);
+  }
+
+  sMasterConfig.MasterOutputTrigger = TIM_TRGO_RESET;
+  sMasterConfig.MasterSlaveMode = TIM_MASTERSLAVEMODE_DISABLE;
+  if (HAL_TIMEx_MasterConfigSynchronization(&htim7, &sMasterConfig) != HAL_OK)
+  {
+    _Error_Handler(__FILE__, __LINE__);
+  }
 
+  /* same priority as TIM6, trace is not preempted by the timer thread */
+  HAL_NVIC_SetPriority(TIM7_IRQn, 2, 0);
+  HAL_NVIC_EnableIRQ(TIM7_IRQn);
+}
+#endif
+
+#if CO_PROFILE_PC > 0
+TIM_HandleTypeDef htim16;
+
+/* TIM16 init function, PC sampling timer, 1 MHz counter */
+void MX_TIM16_Init(uint32_t rate_Hz)
+{
+  /* HAL_TIM_Base_MspInit() handles TIM6 only */
+  __HAL_RCC_TIM16_CLK_ENABLE();
+
+  htim16.Instance = TIM16;
+  htim16.Init.Prescaler = (HAL_RCC_GetPCLK2Freq() / 1000000U) - 1U;
+  htim16.Init.CounterMode = TIM_COUNTERMODE_UP;
+  htim16.Init.Period = (1000000U / rate_Hz) - 1U;
+  htim16.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+  htim16.Init.RepetitionCounter = 0U;
+  htim16.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
+  if (HAL_TIM_Base_Init(&htim16) != HAL_OK)
+  {
+    _Error_Handler(__FILE__, __LINE__);
+  }
+
+  /* highest priority, so CAN and timer interrupts are sampled too */
+  HAL_NVIC_SetPriority(TIM1_UP_TIM16_IRQn, 0, 0);
+  HAL_NVIC_EnableIRQ(TIM1_UP_TIM16_IRQn);
+}
+#endif
+
+#if (CO_SYNC_HW_TIMER > 0) || (CO_SYNC_WINDOW_TIMER > 0) || (CO_HB_HW_TIMER > 0)
+TIM_HandleTypeDef htim2;
+
+/* TIM2 init function, SYNC timer, free running 32-bit 1 MHz counter,
+ * channel 1 compare is moved by SYNC period in TIM2_IRQHandler(),
+ * channel 2 compare closes SYNC window, channel 3 compare is moved by
+ * heartbeat period, half a millisecond after SYNC */
+void MX_TIM2_Init(void)
+{
+  TIM_OC_InitTypeDef sConfigOC;
+
+  /* HAL_TIM_Base_MspInit() handles TIM6 only */
+  __HAL_RCC_TIM2_CLK_ENABLE();
+
+  htim2.Instance = TIM2;
+  htim2.Init.Prescaler = (HAL_RCC_GetPCLK1Freq() / 1000000U) - 1U;
+  htim2.Init.CounterMode = TIM_COUNTERMODE_UP;
+  htim2.Init.Period = 0xFFFFFFFFU;
+  htim2.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+  htim2.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
+  if (HAL_TIM_OC_Init(&htim2) != HAL_OK)
+  {
+    _Error_Handler(__FILE__, __LINE__);
+  }
+
+  sConfigOC.OCMode = TIM_OCMODE_TIMING;
+  sConfigOC.Pulse = 1000U;
+  sConfigOC.OCPolarity = TIM_OCPOLARITY_HIGH;
+  sConfigOC.OCFastMode = TIM_OCFAST_DISABLE;
+  if (HAL_TIM_OC_ConfigChannel(&htim2, &sConfigOC, TIM_CHANNEL_1) != HAL_OK)
+  {
+    _Error_Handler(__FILE__, __LINE__);
+  }
+  if (HAL_TIM_OC_ConfigChannel(&htim2, &sConfigOC, TIM_CHANNEL_2) != HAL_OK)
+  {
+    _Error_Handler(__FILE__, __LINE__);
+  }
+  /* SYNC and heartbeat share reserved mailbox, periods are whole milliseconds */
+  sConfigOC.Pulse = 1500U;
+  if (HAL_TIM_OC_ConfigChannel(&htim2, &sConfigOC, TIM_CHANNEL_3) != HAL_OK)
+  {
+    _Error_Handler(__FILE__, __LINE__);
+  }
+
+  /* above CAN interrupts, SYNC edge, window and heartbeat are not delayed by
+   * CANopen processing */
+  HAL_NVIC_SetPriority(TIM2_IRQn, 0, 0);
+  HAL_NVIC_EnableIRQ(TIM2_IRQn);
+}
+#endif
 /* USER CODE END 1 */
 
 /**
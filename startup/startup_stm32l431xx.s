@@ -61,6 +61,15 @@ defined in linker script */
 .word	_sbss
 /* end address for the .bss section. defined in linker script */
 .word	_ebss
+/* start address for the initialization values of the .ramfunc section.
+defined in linker script */
+.word	_siramfunc
+/* start and end address for the .ramfunc section. defined in linker script */
+.word	_sramfunc
+.word	_eramfunc
+/* start and end address for the .sram2 section. defined in linker script */
+.word	_ssram2
+.word	_esram2
 
 .equ  BootRAM,        0xF1E0F85F
 /**
@@ -94,6 +103,21 @@ LoopCopyDataInit:
 	adds	r2, r0, r1
 	cmp	r2, r3
 	bcc	CopyDataInit
+	movs	r1, #0
+	b	LoopCopyRamfunc
+/* Copy the SRAM2 functions from flash. */
+CopyRamfunc:
+	ldr	r3, =_siramfunc
+	ldr	r3, [r3, r1]
+	str	r3, [r0, r1]
+	adds	r1, r1, #4
+
+LoopCopyRamfunc:
+	ldr	r0, =_sramfunc
+	ldr	r3, =_eramfunc
+	adds	r2, r0, r1
+	cmp	r2, r3
+	bcc	CopyRamfunc
 	ldr	r2, =_sbss
 	b	LoopFillZerobss
 /* Zero fill the bss segment. */
@@ -105,6 +129,17 @@ LoopFillZerobss:
 	ldr	r3, = _ebss
 	cmp	r2, r3
 	bcc	FillZerobss
+	ldr	r2, =_ssram2
+	b	LoopFillZerosram2
+/* Zero fill the CANopen objects in SRAM2. */
+FillZerosram2:
+	movs	r3, #0
+	str	r3, [r2], #4
+
+LoopFillZerosram2:
+	ldr	r3, = _esram2
+	cmp	r2, r3
+	bcc	FillZerosram2
 
 /* Call the clock system intitialization function.*/
     bl  SystemInit